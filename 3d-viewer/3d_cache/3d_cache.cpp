@@ -25,11 +25,16 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <algorithm>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <utility>
 
 #include <wx/datetime.h>
 #include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
 #include <wx/log.h>
 #include <wx/stdpaths.h>
 
@@ -49,7 +54,9 @@
 
 #include <advanced_config.h>
 #include <common.h>     // For ExpandEnvVarSubstitutions
+#include <core/thread_pool.h>
 #include <filename_resolver.h>
+#include <memory_accounting.h>
 #include <paths.h>
 #include <pgm_base.h>
 #include <project.h>
@@ -61,6 +68,7 @@
 #define MASK_3D_CACHE "3D_CACHE"
 
 static std::mutex mutex3D_cache;
+static std::mutex mutex3D_cacheFile;
 
 
 static bool isSHA1Same( const unsigned char* shaA, const unsigned char* shaB ) noexcept
@@ -75,6 +83,142 @@ static bool isSHA1Same( const unsigned char* shaA, const unsigned char* shaB ) n
 }
 
 
+/**
+ * Estimate the memory used by a model: the render data itself, and about as much for the scene
+ * graph it was made from, if loaded, which holds the same coordinates, normals and indices.
+ */
+static size_t modelMemorySize( const S3DMODEL* aModel, bool aWithScene )
+{
+    size_t size = sizeof( S3DMODEL ) + aModel->m_MaterialsSize * sizeof( SMATERIAL );
+
+    for( unsigned int i = 0; i < aModel->m_MeshesSize; ++i )
+    {
+        const SMESH& mesh = aModel->m_Meshes[i];
+        size_t       vertexSize = 2 * sizeof( SFVEC3F );
+
+        if( mesh.m_Texcoords )
+            vertexSize += sizeof( SFVEC2F );
+
+        if( mesh.m_Color )
+            vertexSize += sizeof( SFVEC3F );
+
+        size += sizeof( SMESH ) + mesh.m_VertexSize * vertexSize
+                + mesh.m_FaceIdxSize * sizeof( unsigned int );
+    }
+
+    return aWithScene ? 2 * size : size;
+}
+
+
+/**
+ * The render data cache files (".3dm") hold the S3DMODEL of a model file as is, so that it
+ * is read in one go and used in place, without parsing or per mesh allocations.
+ *
+ * The file starts with a RENDER_CACHE_HEADER, followed by a RENDER_CACHE_MESH per mesh, the
+ * materials and then the positions, normals, texture coordinates, colors and indices of the
+ * meshes.  It is named from the path of the model file and checked against its size,
+ * modification time and a hash of its first and last blocks, which are cheap to read compared
+ * to hashing the whole file.  The data is in host byte order; the cache files aren't meant to
+ * be shared between machines.
+ */
+static const char     RENDER_CACHE_MAGIC[8] = { 'K', 'I', '3', 'D', 'M', 'D', 'L', 0 };
+static const uint32_t RENDER_CACHE_VERSION = 1;
+static const size_t   RENDER_CACHE_HASH_BLOCK = 65536;
+
+enum RENDER_CACHE_MESH_FLAGS : uint32_t
+{
+    RCM_TEXCOORDS = 1,
+    RCM_COLORS = 2
+};
+
+
+struct RENDER_CACHE_HEADER
+{
+    char          magic[8];
+    uint32_t      version;
+    uint32_t      meshCount;
+    uint32_t      materialCount;
+    uint32_t      reserved;
+    uint64_t      sourceSize;
+    int64_t       sourceTime;       // modification time in ms
+    unsigned char sourceHash[20];   // hash of the first and last blocks of the source
+    uint32_t      padding;
+    uint64_t      dataSize;         // size of the data after the header
+};
+
+
+struct RENDER_CACHE_MESH
+{
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t materialIdx;
+    uint32_t flags;
+};
+
+
+static void getDigest( boost::uuids::detail::sha1& aBlock, unsigned char* aSHA1Sum )
+{
+    unsigned int digest[5];
+    aBlock.get_digest( digest );
+
+    // ensure MSB order
+    for( int i = 0; i < 5; ++i )
+    {
+        int idx = i << 2;
+        unsigned int tmp = digest[i];
+        aSHA1Sum[idx+3] = tmp & 0xff;
+        tmp >>= 8;
+        aSHA1Sum[idx+2] = tmp & 0xff;
+        tmp >>= 8;
+        aSHA1Sum[idx+1] = tmp & 0xff;
+        tmp >>= 8;
+        aSHA1Sum[idx] = tmp & 0xff;
+    }
+}
+
+
+/**
+ * Read the size, modification time and hash of the first and last blocks of \a aFileName
+ * into \a aHeader.
+ */
+static bool getSourceInfo( const wxString& aFileName, RENDER_CACHE_HEADER& aHeader )
+{
+    wxFFile file( aFileName, wxT( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    wxFileOffset length = file.Length();
+
+    if( length < 0 )
+        return false;
+
+    boost::uuids::detail::sha1 dblock;
+    std::vector<char>          block( RENDER_CACHE_HASH_BLOCK );
+
+    size_t bsize = file.Read( block.data(), block.size() );
+    dblock.process_bytes( block.data(), bsize );
+
+    if( (size_t) length > 2 * RENDER_CACHE_HASH_BLOCK )
+    {
+        file.Seek( -(wxFileOffset) RENDER_CACHE_HASH_BLOCK, wxFromEnd );
+        bsize = file.Read( block.data(), block.size() );
+        dblock.process_bytes( block.data(), bsize );
+    }
+    else if( (size_t) length > RENDER_CACHE_HASH_BLOCK )
+    {
+        bsize = file.Read( block.data(), block.size() );
+        dblock.process_bytes( block.data(), bsize );
+    }
+
+    aHeader.sourceSize = length;
+    aHeader.sourceTime = wxFileName( aFileName ).GetModificationTime().GetValue().GetValue();
+    getDigest( dblock, aHeader.sourceHash );
+
+    return true;
+}
+
+
 static bool checkTag( const char* aTag, void* aPluginMgrPtr )
 {
     if( nullptr == aTag || nullptr == aPluginMgrPtr )
@@ -129,11 +273,19 @@ public:
     void SetSHA1( const unsigned char* aSHA1Sum );
     const wxString GetCacheBaseName();
 
+    void FreeRenderData();
+
     wxDateTime    modTime;      // file modification time
     unsigned char sha1sum[20];
     std::string   pluginInfo;   // PluginName:Version string
+    wxString      fileName;     // full path of the model file
     SCENEGRAPH*   sceneData;
     S3DMODEL*     renderData;
+    std::unique_ptr<char[]> renderBuffer; // data of renderData when read from its cache file
+    size_t        memorySize;   // estimated memory used by the scene and render data
+    uint64_t      lastUse;      // sequence number of the last request of the model
+    bool          evicted;      // the data was freed to limit the cache memory
+    std::mutex    lock;         // held while the data is loaded
 
 private:
     // prohibit assignment and default copy constructor
@@ -148,6 +300,9 @@ S3D_CACHE_ENTRY::S3D_CACHE_ENTRY()
 {
     sceneData = nullptr;
     renderData = nullptr;
+    memorySize = 0;
+    lastUse = 0;
+    evicted = false;
     memset( sha1sum, 0, 20 );
 }
 
@@ -156,8 +311,22 @@ S3D_CACHE_ENTRY::~S3D_CACHE_ENTRY()
 {
     delete sceneData;
 
-    if( nullptr != renderData )
+    FreeRenderData();
+}
+
+
+void S3D_CACHE_ENTRY::FreeRenderData()
+{
+    // the render data read from a cache file lives in its buffer
+    if( renderBuffer )
+    {
+        renderBuffer.reset();
+        renderData = nullptr;
+    }
+    else if( nullptr != renderData )
+    {
         S3D::Destroy3DModel( &renderData );
+    }
 }
 
 
@@ -189,11 +358,18 @@ S3D_CACHE::S3D_CACHE()
     m_FNResolver = new FILENAME_RESOLVER;
     m_project = nullptr;
     m_Plugins = new S3D_PLUGIN_MANAGER;
+
+    m_memoryAccount = std::make_unique<MEMORY_ACCOUNT>(
+            [this]( MEMORY_REPORT& aReport )
+            {
+                aReport.Add( MEMORY_CATEGORY::MODELS_3D, m_memoryUsed.load() );
+            } );
 }
 
 
 S3D_CACHE::~S3D_CACHE()
 {
+    m_memoryAccount.reset();
     FlushCache();
 
     delete m_FNResolver;
@@ -202,7 +378,7 @@ S3D_CACHE::~S3D_CACHE()
 
 
 SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePath,
-                             S3D_CACHE_ENTRY** aCachePtr )
+                             S3D_CACHE_ENTRY** aCachePtr, bool aRenderData )
 {
     if( aCachePtr )
         *aCachePtr = nullptr;
@@ -217,131 +393,386 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePa
         return nullptr;
     }
 
-    // check cache if file is already loaded
-    std::lock_guard<std::mutex> lock( mutex3D_cache );
+    // check cache if file is already loaded.  The cache lock only guards the map; the data
+    // of an entry is loaded under the lock of that entry so that different files load in
+    // parallel and the callers asking for a file which is being loaded wait for it.
+    S3D_CACHE_ENTRY*             ep = nullptr;
+    std::unique_lock<std::mutex> entryLock;
+
+    {
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+        std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString >::iterator mi;
+        mi = m_CacheMap.find( full3Dpath );
+
+        if( mi == m_CacheMap.end() )
+        {
+            // a cache item does not exist; create it locked, before anyone else can find it
+            ep = new S3D_CACHE_ENTRY;
+            ep->fileName = full3Dpath;
+            m_CacheList.push_back( ep );
+            m_CacheMap.emplace( full3Dpath, ep );
 
-    std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString >::iterator mi;
-    mi = m_CacheMap.find( full3Dpath );
+            entryLock = std::unique_lock<std::mutex>( ep->lock );
+        }
+        else
+        {
+            ep = mi->second;
+        }
+
+        ep->lastUse = ++m_useCount;
+    }
 
-    if( mi != m_CacheMap.end() )
+    if( !entryLock.owns_lock() )
     {
-        wxFileName fname( full3Dpath );
+        entryLock = std::unique_lock<std::mutex>( ep->lock );
 
-        if( fname.FileExists() )    // Only check if file exists. If not, it will
-        {                           // use the same model in cache.
-            bool       reload = ADVANCED_CFG::GetCfg().m_Skip3DModelMemoryCache;
-            wxDateTime fmdate = fname.GetModificationTime();
+        if( !ep->evicted )
+        {
+            if( aCachePtr )
+                *aCachePtr = ep;
 
-            if( fmdate != mi->second->modTime )
+            // the entry only holds the render data read from its cache file
+            if( !aRenderData && !ep->sceneData && ep->renderData )
             {
-                unsigned char hashSum[20];
-                getSHA1( full3Dpath, hashSum );
-                mi->second->modTime = fmdate;
-
-                if( !isSHA1Same( hashSum, mi->second->sha1sum ) )
-                {
-                    mi->second->SetSHA1( hashSum );
-                    reload = true;
-                }
+                checkCache( full3Dpath, ep );
+                updateMemorySize( ep );
+                return ep->sceneData;
             }
 
-            if( reload )
-            {
-                if( nullptr != mi->second->sceneData )
-                {
-                    S3D::DestroyNode( mi->second->sceneData );
-                    mi->second->sceneData = nullptr;
-                }
+            return checkModified( ep );
+        }
+
+        // the data was freed by trimCache(), read it again, usually from the cache file
+        ep->evicted = false;
+    }
+
+    if( aCachePtr )
+        *aCachePtr = ep;
+
+    // the renderers only need the render data, which is much faster to read
+    if( aRenderData && loadRenderCache( ep ) )
+        return nullptr;
 
-                if( nullptr != mi->second->renderData )
-                    S3D::Destroy3DModel( &mi->second->renderData );
+    // search the Filename->Cachename map
+    return checkCache( full3Dpath, ep );
+}
+
+
+SCENEGRAPH* S3D_CACHE::checkModified( S3D_CACHE_ENTRY* aCacheItem )
+{
+    const wxString& full3Dpath = aCacheItem->fileName;
+
+    wxFileName fname( full3Dpath );
 
-                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath,
-                                                                mi->second->pluginInfo );
+    if( fname.FileExists() )    // Only check if file exists. If not, it will
+    {                           // use the same model in cache.
+        bool       reload = ADVANCED_CFG::GetCfg().m_Skip3DModelMemoryCache;
+        wxDateTime fmdate = fname.GetModificationTime();
+
+        if( fmdate != aCacheItem->modTime )
+        {
+            unsigned char hashSum[20];
+            getSHA1( full3Dpath, hashSum );
+            aCacheItem->modTime = fmdate;
+
+            if( !isSHA1Same( hashSum, aCacheItem->sha1sum ) )
+            {
+                aCacheItem->SetSHA1( hashSum );
+                reload = true;
             }
         }
 
-        if( nullptr != aCachePtr )
-            *aCachePtr = mi->second;
+        if( reload )
+        {
+            if( nullptr != aCacheItem->sceneData )
+            {
+                S3D::DestroyNode( aCacheItem->sceneData );
+                aCacheItem->sceneData = nullptr;
+            }
 
-        return mi->second->sceneData;
+            aCacheItem->FreeRenderData();
+            aCacheItem->sceneData = m_Plugins->Load3DModel( full3Dpath, aCacheItem->pluginInfo );
+            updateMemorySize( aCacheItem );
+        }
     }
 
-    // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return aCacheItem->sceneData;
 }
 
 
-SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile, const wxString& aBasePath )
+void S3D_CACHE::updateMemorySize( S3D_CACHE_ENTRY* aCacheItem )
 {
-    return load( aModelFile, aBasePath );
+    size_t size = 0;
+
+    if( aCacheItem->renderData )
+        size = modelMemorySize( aCacheItem->renderData, aCacheItem->sceneData != nullptr );
+
+    m_memoryUsed -= aCacheItem->memorySize;
+    m_memoryUsed += size;
+    aCacheItem->memorySize = size;
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+wxString S3D_CACHE::renderCacheName( const wxString& aFileName ) const
 {
-    if( aCachePtr )
-        *aCachePtr = nullptr;
+    boost::uuids::detail::sha1 dblock;
+    unsigned char              sha1sum[20];
+    wxScopedCharBuffer         name = aFileName.ToUTF8();
 
-    unsigned char    sha1sum[20];
-    S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-    m_CacheList.push_back( ep );
-    wxFileName fname( aFileName );
-    ep->modTime = fname.GetModificationTime();
+    dblock.process_bytes( name.data(), name.length() );
+    getDigest( dblock, sha1sum );
 
-    if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
+    return m_CacheDir + sha1ToWXString( sha1sum ) + wxT( ".3dm" );
+}
+
+
+bool S3D_CACHE::loadRenderCache( S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache || m_CacheDir.empty() )
+        return false;
+
+    wxString cachename = renderCacheName( aCacheItem->fileName );
+
+    if( !wxFileName::FileExists( cachename ) )
+        return false;
+
+    RENDER_CACHE_HEADER source;
+    RENDER_CACHE_HEADER header;
+
+    if( !getSourceInfo( aCacheItem->fileName, source ) )
+        return false;
+
+    wxFFile file( cachename, wxT( "rb" ) );
+
+    if( !file.IsOpened() || file.Read( &header, sizeof( header ) ) != sizeof( header ) )
+        return false;
+
+    if( memcmp( header.magic, RENDER_CACHE_MAGIC, sizeof( header.magic ) ) != 0
+            || header.version != RENDER_CACHE_VERSION
+            || header.sourceSize != source.sourceSize
+            || header.sourceTime != source.sourceTime
+            || !isSHA1Same( header.sourceHash, source.sourceHash )
+            || file.Length() != (wxFileOffset) ( sizeof( header ) + header.dataSize )
+            || header.dataSize < header.meshCount * sizeof( RENDER_CACHE_MESH )
+                                         + header.materialCount * sizeof( SMATERIAL ) )
     {
-        // just in case we can't get a hash digest (for example, on access issues)
-        // or we do not have a configured cache file directory, we create an
-        // entry to prevent further attempts at loading the file
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] stale render cache file '%s'" ),
+                    cachename );
+        return false;
+    }
+
+    // The S3DMODEL and its meshes go in front of the file data in the same buffer
+    size_t                  prefixSize = sizeof( S3DMODEL ) + header.meshCount * sizeof( SMESH );
+    std::unique_ptr<char[]> buffer( new char[prefixSize + header.dataSize] );
+    char*                   data = buffer.get() + prefixSize;
+
+    if( file.Read( data, header.dataSize ) != header.dataSize )
+        return false;
+
+    const RENDER_CACHE_MESH* meshes = reinterpret_cast<const RENDER_CACHE_MESH*>( data );
+    size_t                   offset = header.meshCount * sizeof( RENDER_CACHE_MESH );
 
-        if( m_CacheMap.emplace( aFileName, ep ).second == false )
+    S3DMODEL* model = new( buffer.get() ) S3DMODEL;
+    model->m_MeshesSize = header.meshCount;
+    model->m_Meshes = reinterpret_cast<SMESH*>( buffer.get() + sizeof( S3DMODEL ) );
+    model->m_MaterialsSize = header.materialCount;
+    model->m_Materials = reinterpret_cast<SMATERIAL*>( data + offset );
+    offset += header.materialCount * sizeof( SMATERIAL );
+
+    auto take =
+            [&]( size_t aSize ) -> char*
+            {
+                if( aSize > header.dataSize - offset )
+                    return nullptr;
+
+                char* ptr = data + offset;
+                offset += aSize;
+                return ptr;
+            };
+
+    for( uint32_t i = 0; i < header.meshCount; ++i )
+    {
+        const RENDER_CACHE_MESH& src = meshes[i];
+        SMESH*                   mesh = new( &model->m_Meshes[i] ) SMESH;
+        size_t                   count = src.vertexCount;
+
+        mesh->m_VertexSize = src.vertexCount;
+        mesh->m_FaceIdxSize = src.indexCount;
+        mesh->m_MaterialIdx = src.materialIdx;
+        mesh->m_Positions = reinterpret_cast<SFVEC3F*>( take( count * sizeof( SFVEC3F ) ) );
+        mesh->m_Normals = reinterpret_cast<SFVEC3F*>( take( count * sizeof( SFVEC3F ) ) );
+        mesh->m_Texcoords = nullptr;
+        mesh->m_Color = nullptr;
+
+        if( src.flags & RCM_TEXCOORDS )
+            mesh->m_Texcoords = reinterpret_cast<SFVEC2F*>( take( count * sizeof( SFVEC2F ) ) );
+
+        if( src.flags & RCM_COLORS )
+            mesh->m_Color = reinterpret_cast<SFVEC3F*>( take( count * sizeof( SFVEC3F ) ) );
+
+        mesh->m_FaceIdx = reinterpret_cast<unsigned int*>(
+                take( (size_t) src.indexCount * sizeof( unsigned int ) ) );
+
+        if( !mesh->m_Positions || !mesh->m_Normals || !mesh->m_FaceIdx
+                || ( ( src.flags & RCM_TEXCOORDS ) && !mesh->m_Texcoords )
+                || ( ( src.flags & RCM_COLORS ) && !mesh->m_Color )
+                || src.materialIdx >= header.materialCount )
         {
-            wxLogTrace( MASK_3D_CACHE,
-                        wxT( "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'" ),
-                        __FILE__, __FUNCTION__, __LINE__, aFileName );
+            wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] damaged render cache file '%s'" ),
+                        cachename );
+            return false;
+        }
+    }
+
+    aCacheItem->FreeRenderData();
+    aCacheItem->renderBuffer = std::move( buffer );
+    aCacheItem->renderData = model;
+    aCacheItem->modTime = wxFileName( aCacheItem->fileName ).GetModificationTime();
+    updateMemorySize( aCacheItem );
+
+    return true;
+}
+
+
+bool S3D_CACHE::saveRenderCache( S3D_CACHE_ENTRY* aCacheItem )
+{
+    const S3DMODEL* model = aCacheItem->renderData;
+
+    if( !model || ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache || m_CacheDir.empty() )
+        return false;
+
+    RENDER_CACHE_HEADER header;
+    memset( &header, 0, sizeof( header ) );
+
+    if( !getSourceInfo( aCacheItem->fileName, header ) )
+        return false;
+
+    memcpy( header.magic, RENDER_CACHE_MAGIC, sizeof( header.magic ) );
+    header.version = RENDER_CACHE_VERSION;
+    header.meshCount = model->m_MeshesSize;
+    header.materialCount = model->m_MaterialsSize;
+
+    std::vector<RENDER_CACHE_MESH> meshes( model->m_MeshesSize );
+
+    header.dataSize = meshes.size() * sizeof( RENDER_CACHE_MESH )
+                      + model->m_MaterialsSize * sizeof( SMATERIAL );
+
+    for( unsigned int i = 0; i < model->m_MeshesSize; ++i )
+    {
+        const SMESH&       mesh = model->m_Meshes[i];
+        RENDER_CACHE_MESH& dst = meshes[i];
+        size_t             vertexSize = 2 * sizeof( SFVEC3F );
+
+        dst.vertexCount = mesh.m_VertexSize;
+        dst.indexCount = mesh.m_FaceIdxSize;
+        dst.materialIdx = mesh.m_MaterialIdx;
+        dst.flags = 0;
 
-            m_CacheList.pop_back();
-            delete ep;
+        if( mesh.m_Texcoords )
+        {
+            dst.flags |= RCM_TEXCOORDS;
+            vertexSize += sizeof( SFVEC2F );
         }
-        else
+
+        if( mesh.m_Color )
         {
-            if( aCachePtr )
-                *aCachePtr = ep;
+            dst.flags |= RCM_COLORS;
+            vertexSize += sizeof( SFVEC3F );
         }
 
-        return nullptr;
+        header.dataSize += mesh.m_VertexSize * vertexSize
+                           + mesh.m_FaceIdxSize * sizeof( unsigned int );
     }
 
-    if( m_CacheMap.emplace( aFileName, ep ).second == false )
+    // Write to a temporary file first so that a failed write doesn't leave a damaged file
+    wxString cachename = renderCacheName( aCacheItem->fileName );
+    wxString tempname = cachename + wxT( ".tmp" );
+    bool     ok;
+
     {
-        wxLogTrace( MASK_3D_CACHE,
-                    wxT( "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'" ),
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
+        wxFFile file( tempname, wxT( "wb" ) );
 
-        m_CacheList.pop_back();
-        delete ep;
-        return nullptr;
+        if( !file.IsOpened() )
+            return false;
+
+        ok = file.Write( &header, sizeof( header ) ) == sizeof( header );
+        ok &= file.Write( meshes.data(), meshes.size() * sizeof( RENDER_CACHE_MESH ) )
+                        == meshes.size() * sizeof( RENDER_CACHE_MESH );
+        ok &= file.Write( model->m_Materials, model->m_MaterialsSize * sizeof( SMATERIAL ) )
+                        == model->m_MaterialsSize * sizeof( SMATERIAL );
+
+        for( unsigned int i = 0; ok && i < model->m_MeshesSize; ++i )
+        {
+            const SMESH& mesh = model->m_Meshes[i];
+            size_t       vec3Size = mesh.m_VertexSize * sizeof( SFVEC3F );
+
+            ok &= file.Write( mesh.m_Positions, vec3Size ) == vec3Size;
+            ok &= file.Write( mesh.m_Normals, vec3Size ) == vec3Size;
+
+            if( mesh.m_Texcoords )
+            {
+                size_t vec2Size = mesh.m_VertexSize * sizeof( SFVEC2F );
+                ok &= file.Write( mesh.m_Texcoords, vec2Size ) == vec2Size;
+            }
+
+            if( mesh.m_Color )
+                ok &= file.Write( mesh.m_Color, vec3Size ) == vec3Size;
+
+            size_t indexSize = mesh.m_FaceIdxSize * sizeof( unsigned int );
+            ok &= file.Write( mesh.m_FaceIdx, indexSize ) == indexSize;
+        }
+
+        ok &= file.Close();
     }
 
-    if( aCachePtr )
-        *aCachePtr = ep;
+    if( !ok || !wxRenameFile( tempname, cachename, true ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] cannot write render cache file '%s'" ),
+                    cachename );
+        wxRemoveFile( tempname );
+        return false;
+    }
+
+    return true;
+}
+
+
+SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile, const wxString& aBasePath )
+{
+    return load( aModelFile, aBasePath );
+}
 
-    ep->SetSHA1( sha1sum );
 
-    wxString bname = ep->GetCacheBaseName();
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    unsigned char sha1sum[20];
+    wxFileName    fname( aFileName );
+    aCacheItem->modTime = fname.GetModificationTime();
+
+    if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
+    {
+        // just in case we can't get a hash digest (for example, on access issues)
+        // or we do not have a configured cache file directory, we keep the empty
+        // entry to prevent further attempts at loading the file
+        return nullptr;
+    }
+
+    aCacheItem->SetSHA1( sha1sum );
+
+    wxString bname = aCacheItem->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
     if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && wxFileName::FileExists( cachename )
-        && loadCacheData( ep ) )
-        return ep->sceneData;
+        && loadCacheData( aCacheItem ) )
+        return aCacheItem->sceneData;
 
-    ep->sceneData = m_Plugins->Load3DModel( aFileName, ep->pluginInfo );
+    aCacheItem->sceneData = m_Plugins->Load3DModel( aFileName, aCacheItem->pluginInfo );
 
-    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && nullptr != ep->sceneData )
-        saveCacheData( ep );
+    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && nullptr != aCacheItem->sceneData )
+        saveCacheData( aCacheItem );
 
-    return ep->sceneData;
+    return aCacheItem->sceneData;
 }
 
 
@@ -380,22 +811,7 @@ bool S3D_CACHE::getSHA1( const wxString& aFileName, unsigned char* aSHA1Sum )
         dblock.process_bytes( block, bsize );
 
     fclose( fp );
-    unsigned int digest[5];
-    dblock.get_digest( digest );
-
-    // ensure MSB order
-    for( int i = 0; i < 5; ++i )
-    {
-        int idx = i << 2;
-        unsigned int tmp = digest[i];
-        aSHA1Sum[idx+3] = tmp & 0xff;
-        tmp >>= 8;
-        aSHA1Sum[idx+2] = tmp & 0xff;
-        tmp >>= 8;
-        aSHA1Sum[idx+1] = tmp & 0xff;
-        tmp >>= 8;
-        aSHA1Sum[idx] = tmp & 0xff;
-    }
+    getDigest( dblock, aSHA1Sum );
 
     return true;
 }
@@ -490,6 +906,9 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
         }
     }
 
+    // the node names written to cache files are numbered from a global sequence
+    std::lock_guard<std::mutex> lock( mutex3D_cacheFile );
+
     return S3D::WriteCache( fname.ToUTF8(), true, (SGNODE*)aCacheItem->sceneData,
                             aCacheItem->pluginInfo.c_str() );
 }
@@ -618,6 +1037,7 @@ void S3D_CACHE::FlushCache( bool closePlugins )
 
     m_CacheList.clear();
     m_CacheMap.clear();
+    m_memoryUsed = 0;
 
     if( closePlugins )
         ClosePlugins();
@@ -634,7 +1054,15 @@ void S3D_CACHE::ClosePlugins()
 S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName, const wxString& aBasePath )
 {
     S3D_CACHE_ENTRY* cp = nullptr;
-    SCENEGRAPH*      sp = load( aModelFileName, aBasePath,&cp );
+    SCENEGRAPH*      sp = load( aModelFileName, aBasePath, &cp, true );
+
+    if( cp )
+    {
+        std::lock_guard<std::mutex> lock( cp->lock );
+
+        if( cp->renderData )
+            return cp->renderData;
+    }
 
     if( !sp )
         return nullptr;
@@ -648,20 +1076,108 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName, const wxString& a
         return nullptr;
     }
 
+    std::lock_guard<std::mutex> lock( cp->lock );
+
     if( cp->renderData )
         return cp->renderData;
 
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
+    updateMemorySize( cp );
+
+    if( mp )
+        saveRenderCache( cp );
 
     return mp;
 }
 
+
+void S3D_CACHE::PreloadModels( const std::vector<std::pair<wxString, wxString>>& aModels )
+{
+    // Models are read again on each request when the memory cache is disabled
+    if( ADVANCED_CFG::GetCfg().m_Skip3DModelMemoryCache )
+        return;
+
+    std::vector<std::pair<wxString, wxString>> models;
+    std::set<std::pair<wxString, wxString>>    seen;
+
+    for( const std::pair<wxString, wxString>& model : aModels )
+    {
+        if( seen.insert( model ).second )
+            models.push_back( model );
+    }
+
+    uint64_t lastUse;
+
+    {
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
+        lastUse = m_useCount;
+    }
+
+    ParallelForEachIndex( models.size(),
+                          [&]( size_t aIndex )
+                          {
+                              GetModel( models[aIndex].first, models[aIndex].second );
+                          } );
+
+    // The models which weren't requested since are not needed by the caller
+    trimCache( lastUse );
+}
+
+
+void S3D_CACHE::trimCache( uint64_t aLastUse )
+{
+    size_t maxSize = (size_t) ADVANCED_CFG::GetCfg().m_3DModelMemoryCacheSize * 1024 * 1024;
+
+    if( maxSize == 0 || m_memoryUsed <= maxSize )
+        return;
+
+    std::lock_guard<std::mutex>   lock( mutex3D_cache );
+    std::vector<S3D_CACHE_ENTRY*> unused;
+
+    for( S3D_CACHE_ENTRY* ep : m_CacheList )
+    {
+        if( ep->lastUse <= aLastUse )
+            unused.push_back( ep );
+    }
+
+    std::sort( unused.begin(), unused.end(),
+               []( const S3D_CACHE_ENTRY* aLhs, const S3D_CACHE_ENTRY* aRhs )
+               {
+                   return aLhs->lastUse < aRhs->lastUse;
+               } );
+
+    for( S3D_CACHE_ENTRY* ep : unused )
+    {
+        if( m_memoryUsed <= maxSize )
+            break;
+
+        // skip the entries which are being loaded
+        std::unique_lock<std::mutex> entryLock( ep->lock, std::try_to_lock );
+
+        if( !entryLock.owns_lock() || ep->memorySize == 0 )
+            continue;
+
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] freeing unused model '%s'" ),
+                    ep->GetCacheBaseName() );
+
+        if( ep->sceneData )
+        {
+            S3D::DestroyNode( ep->sceneData );
+            ep->sceneData = nullptr;
+        }
+
+        ep->FreeRenderData();
+        updateMemorySize( ep );
+        ep->evicted = true;
+    }
+}
+
 void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
 {
     wxDir         dir;
     wxString      fileSpec = wxT( "*.3dc" );
-    wxArrayString fileList; // Holds list of ".3dc" files found in cache directory
+    wxArrayString fileList; // Holds list of cache files found in cache directory
     size_t        numFilesFound = 0;
 
     wxFileName thisFile;
@@ -677,8 +1193,10 @@ void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
     {
         thisFile.SetPath( m_CacheDir ); // Set the base path to the cache folder
 
-        // Get a list of all the ".3dc" files in the cache directory
-        numFilesFound = dir.GetAllFiles( m_CacheDir, &fileList, fileSpec );
+        // Get a list of all the ".3dc" and ".3dm" files in the cache directory
+        dir.GetAllFiles( m_CacheDir, &fileList, fileSpec );
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dm" ) );
+        numFilesFound = fileList.GetCount();
 
         for( unsigned int i = 0; i < numFilesFound; i++ )
         {
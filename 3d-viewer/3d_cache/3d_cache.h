@@ -32,8 +32,11 @@
 #include "3d_info.h"
 #include <core/typeinfo.h>
 #include "string_utils.h"
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -43,6 +46,7 @@ class  S3D_CACHE_ENTRY;
 class  SCENEGRAPH;
 class  FILENAME_RESOLVER;
 class  S3D_PLUGIN_MANAGER;
+class  MEMORY_ACCOUNT;
 
 
 /**
@@ -127,6 +131,18 @@ public:
      */
     S3DMODEL* GetModel( const wxString& aModelFileName, const wxString& aBasePath );
 
+    /**
+     * Load the render data of several models in parallel, so that the following calls to
+     * GetModel() for them return the data from memory.
+     *
+     * The models are the ones needed by the caller: the least recently used other models are
+     * then freed while the cache holds more than the "3DModelMemoryCacheSize" advanced setting.
+     * The freed models are read again from their cache file when requested.
+     *
+     * @param aModels is the list of model file names and of the paths to search them from.
+     */
+    void PreloadModels( const std::vector<std::pair<wxString, wxString>>& aModels );
+
     /**
      * Delete up old cache files in cache directory.
      *
@@ -138,16 +154,16 @@ public:
 
 private:
     /**
-     * Find or create cache entry for file name
+     * Fill a new cache entry for file name.
      *
-     * Searches the cache list for the given filename and retrieves the cache data; a cache
-     * entry is created if one does not already exist.
+     * Retrieves the scene data from the cache file of \a aFileName if there is one, or else
+     * loads it through the plugins.  The caller must hold the lock of \a aCacheItem.
      *
-     * @param aFileName  is the file name (full or partial path).
-     * @param aCachePtr is an optional return address for cache entry pointer.
+     * @param aFileName  is the file name (full path).
+     * @param aCacheItem is the new cache entry of \a aFileName.
      * @return SCENEGRAPH object associated with file name or NULL on error.
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = nullptr );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
 
     /**
      * Calculate the SHA1 hash of the given file.
@@ -164,8 +180,39 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
-    // the real load function (can supply a cache entry pointer to member functions)
-    SCENEGRAPH* load( const wxString& aModelFile, const wxString& aBasePath, S3D_CACHE_ENTRY** aCachePtr = nullptr );
+    /**
+     * Free the data of the least recently used models until the cache memory fits the limit.
+     *
+     * @param aLastUse is the use sequence number up to which models may be freed.
+     */
+    void trimCache( uint64_t aLastUse );
+
+    /**
+     * The real load function (can supply a cache entry pointer to member functions).
+     *
+     * @param aRenderData is true when only the render data of the model is needed.  It then
+     *                    may be read from its render cache file, without any scene data.
+     */
+    SCENEGRAPH* load( const wxString& aModelFile, const wxString& aBasePath,
+                      S3D_CACHE_ENTRY** aCachePtr = nullptr, bool aRenderData = false );
+
+    /**
+     * Reload the scene data of a loaded model if its file was modified.  The caller must hold
+     * the lock of \a aCacheItem.
+     */
+    SCENEGRAPH* checkModified( S3D_CACHE_ENTRY* aCacheItem );
+
+    /// update the estimated memory used by the data of \a aCacheItem
+    void updateMemorySize( S3D_CACHE_ENTRY* aCacheItem );
+
+    /// @return the name of the render cache file of the model file \a aFileName
+    wxString renderCacheName( const wxString& aFileName ) const;
+
+    // load render data from a render cache file
+    bool loadRenderCache( S3D_CACHE_ENTRY* aCacheItem );
+
+    // save render data to a render cache file
+    bool saveRenderCache( S3D_CACHE_ENTRY* aCacheItem );
 
     /// cache entries
     std::list< S3D_CACHE_ENTRY* > m_CacheList;
@@ -173,6 +220,12 @@ private:
     /// mapping of file names to cache names and data
     std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString > m_CacheMap;
 
+    /// estimated memory used by the loaded models
+    std::atomic<size_t> m_memoryUsed = 0;
+
+    /// sequence number of the last model request
+    uint64_t            m_useCount = 0;
+
     FILENAME_RESOLVER*  m_FNResolver;
 
     S3D_PLUGIN_MANAGER* m_Plugins;
@@ -180,6 +233,8 @@ private:
     PROJECT*            m_project;
     wxString            m_CacheDir;
     wxString            m_ConfigDir;       /// base configuration path for 3D items
+
+    std::unique_ptr<MEMORY_ACCOUNT> m_memoryAccount;
 };
 
 #endif  // CACHE_3D_H
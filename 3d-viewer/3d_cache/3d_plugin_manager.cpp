@@ -371,6 +371,8 @@ void S3D_PLUGIN_MANAGER::addExtensionMap( KICAD_PLUGIN_LDR_3D* aPlugin )
     if( nullptr == aPlugin )
         return;
 
+    m_PluginLocks.try_emplace( aPlugin );
+
     int nExt = aPlugin->GetNExtensions();
 
     wxLogTrace( MASK_3D_PLUGINMGR, wxT( "%s:%s:%d * [INFO] adding %d extensions" ),
@@ -425,6 +427,8 @@ SCENEGRAPH* S3D_PLUGIN_MANAGER::Load3DModel( const wxString& aFileName, std::str
 
     while( sL != items.second )
     {
+        std::lock_guard<std::mutex> lock( m_PluginLocks.at( sL->second ) );
+
         if( sL->second->CanRender() )
         {
             SCENEGRAPH* sp = sL->second->Load( aFileName.ToUTF8() );
@@ -32,6 +32,7 @@
 
 #include <map>
 #include <list>
+#include <mutex>
 #include <string>
 #include <wx/string.h>
 
@@ -53,6 +54,13 @@ public:
      */
     std::list< wxString > const* GetFileFilters( void ) const noexcept;
 
+    /**
+     * Load \a aFileName through the first plugin which can read it.
+     *
+     * Models can be loaded from several threads at once.  The calls to each plugin are
+     * serialized since a plugin may keep parser state between them, so only files of
+     * different formats are actually parsed at the same time.
+     */
     SCENEGRAPH* Load3DModel( const wxString& aFileName, std::string& aPluginInfo );
 
     /**
@@ -94,6 +102,9 @@ private:
     /// mapping of extensions to available plugins
     std::multimap< const wxString, KICAD_PLUGIN_LDR_3D* > m_ExtMap;
 
+    /// locks serializing the calls to each plugin
+    std::map< const KICAD_PLUGIN_LDR_3D*, std::mutex > m_PluginLocks;
+
     /// list of file filters
     std::list< wxString > m_FileFilters;
 };
@@ -47,6 +47,7 @@
 #include <vector>
 #include <thread>
 #include <core/arraydim.h>
+#include <core/thread_pool.h>
 #include <algorithm>
 #include <atomic>
 #include <wx/log.h>
@@ -259,31 +260,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( aStatusReporter )
         aStatusReporter->Report( _( "Create tracks and vias" ) );
 
-    // Create tracks as objects and add it to container
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
-
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
-
-        for( const PCB_TRACK* track : trackList )
-        {
-            // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( layer ) )
-                continue;
-
-            // Skip vias annulus when not flashed on this layer
-            if( track->Type() == PCB_VIA_T
-                    && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
-            {
-                continue;
-            }
-
-            // Add object item to layer container
-            createTrack( track, layerContainer );
-        }
-    }
-
     // Create VIAS and THTs objects and add it to holes containers
     for( PCB_LAYER_ID layer : layer_ids )
     {
@@ -352,17 +328,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
                         m_TH_IDs.Add( new FILLED_CIRCLE_2D( via_center, hole_inner_radius, *track ) );
                 }
             }
-
-            if( cfg.differentiate_plated_copper && layer == F_Cu )
-            {
-                track->TransformShapeToPolygon( *m_frontPlatedCopperPolys, F_Cu, 0, maxError,
-                                                ERROR_INSIDE );
-            }
-            else if( cfg.differentiate_plated_copper && layer == B_Cu )
-            {
-                track->TransformShapeToPolygon( *m_backPlatedCopperPolys, B_Cu, 0, maxError,
-                                                ERROR_INSIDE );
-            }
         }
     }
 
@@ -448,38 +413,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
     }
 
-    // Creates vertical outline contours of the tracks and add it to the poly of the layer
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
-
-            // ADD TRACKS
-            unsigned int nTracks = trackList.size();
-
-            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-            {
-                const PCB_TRACK *track = trackList[trackIdx];
-
-                if( !track->IsOnLayer( layer ) )
-                    continue;
-
-                // Skip vias annulus when not flashed on this layer
-                if( track->Type() == PCB_VIA_T
-                        && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
-                {
-                    continue;
-                }
-
-                // Add the track/via contour
-                track->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-            }
-        }
-    }
-
     // Add holes of footprints
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
@@ -543,158 +476,172 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
     }
 
-    // Add footprints PADs objects to containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
+    // Build the items of each copper layer.  They only go in the containers and contours of
+    // their own layer (or in the plated copper of the outer layers), so the layers are built
+    // in parallel.
+    bool buildLayerPolys = cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL;
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+    auto buildCopperLayer =
+            [&]( PCB_LAYER_ID layer )
+            {
+                wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
 
-        // ADD PADS
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            addPads( footprint, layerContainer, layer, cfg.differentiate_plated_copper, false );
+                BVH_CONTAINER_2D* layerContainer = m_layerMap.at( layer );
+                SHAPE_POLY_SET*   layerPoly = nullptr;
+                SHAPE_POLY_SET*   platedCopperPolys = nullptr;
 
-            // Micro-wave footprints may have items on copper layers
-            addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
-        }
-    }
+                if( buildLayerPolys )
+                {
+                    wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
 
-    // Add footprints PADs poly contours (vertical outlines)
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+                    layerPoly = m_layers_poly.at( layer );
+                }
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                if( cfg.differentiate_plated_copper && layer == F_Cu )
+                    platedCopperPolys = m_frontPlatedCopperPolys;
+                else if( cfg.differentiate_plated_copper && layer == B_Cu )
+                    platedCopperPolys = m_backPlatedCopperPolys;
 
-            // Add pads to polygon list
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                // Note: NPTH pads are not drawn on copper layers when the pad has same shape as
-                // its hole
-                footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE,
-                                                   true, cfg.differentiate_plated_copper, false );
+                // ADD TRACKS
+                for( const PCB_TRACK* track : trackList )
+                {
+                    // NOTE: Vias can be on multiple layers
+                    if( !track->IsOnLayer( layer ) )
+                        continue;
 
-                transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError, ERROR_INSIDE );
-            }
-        }
+                    if( platedCopperPolys )
+                    {
+                        track->TransformShapeToPolygon( *platedCopperPolys, layer, 0, maxError,
+                                                        ERROR_INSIDE );
+                    }
 
-        if( cfg.differentiate_plated_copper )
-        {
-            // ADD PLATED PADS contours
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                footprint->TransformPadsToPolySet( *m_frontPlatedPadAndGraphicPolys, F_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
+                    // Skip vias annulus when not flashed on this layer
+                    if( track->Type() == PCB_VIA_T
+                            && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
+                    {
+                        continue;
+                    }
 
-                footprint->TransformPadsToPolySet( *m_backPlatedPadAndGraphicPolys, B_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
-            }
-        }
-    }
+                    // Add object item to layer container
+                    createTrack( track, layerContainer );
 
-    // Add graphic item on copper layers to object containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
+                    // Add the track/via contour
+                    if( layerPoly )
+                    {
+                        track->TransformShapeToPolygon( *layerPoly, layer, 0, maxError,
+                                                        ERROR_INSIDE );
+                    }
+                }
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+                // ADD PADS
+                for( FOOTPRINT* footprint : m_board->Footprints() )
+                {
+                    addPads( footprint, layerContainer, layer, cfg.differentiate_plated_copper,
+                             false );
 
-        // Add graphic items on copper layers (texts and other graphics)
-        for( BOARD_ITEM* item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( layer ) )
-                continue;
+                    // Micro-wave footprints may have items on copper layers
+                    addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
 
-            switch( item->Type() )
-            {
-            case PCB_SHAPE_T:
-                addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXT_T:
-                addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXTBOX_T:
-                addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                break;
-
-            case PCB_DIM_ALIGNED_T:
-            case PCB_DIM_CENTER_T:
-            case PCB_DIM_RADIAL_T:
-            case PCB_DIM_ORTHOGONAL_T:
-            case PCB_DIM_LEADER_T:
-                addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                break;
-
-            default:
-                wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-                break;
-            }
+                    if( layerPoly )
+                    {
+                        // Note: NPTH pads are not drawn on copper layers when the pad has same
+                        // shape as its hole
+                        footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError,
+                                                           ERROR_INSIDE, true,
+                                                           cfg.differentiate_plated_copper,
+                                                           false );
+
+                        transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError,
+                                                    ERROR_INSIDE );
+                    }
+                }
 
-            // add also this shape to the plated copper polygon list if required
-            if( cfg.differentiate_plated_copper )
-            {
-                if( layer == F_Cu )
-                    item->TransformShapeToPolygon( *m_frontPlatedCopperPolys, F_Cu,
-                                                    0, maxError, ERROR_INSIDE );
-                else if( layer == B_Cu )
-                    item->TransformShapeToPolygon( *m_backPlatedCopperPolys, B_Cu,
-                                                    0, maxError, ERROR_INSIDE );
-            }
-        }
-    }
+                // Add graphic items on copper layers (texts and other graphics)
+                for( BOARD_ITEM* item : m_board->Drawings() )
+                {
+                    if( !item->IsOnLayer( layer ) )
+                        continue;
 
-    // Add graphic item on copper layers to poly contours (vertical outlines)
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+                    switch( item->Type() )
+                    {
+                    case PCB_SHAPE_T:
+                        addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                        if( layerPoly )
+                        {
+                            item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError,
+                                                           ERROR_INSIDE );
+                        }
 
-            // Add graphic items on copper layers (texts and other )
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
+                        break;
 
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
+                    case PCB_TEXT_T:
+                        addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
 
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+                        if( layerPoly )
+                        {
+                            PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
 
-                    text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                            text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
+                        }
 
-                case PCB_TEXTBOX_T:
-                {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+                        break;
 
-                    textbox->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                    case PCB_TEXTBOX_T:
+                        addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
 
-                default:
-                    wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                                item->Type() );
-                    break;
+                        if( layerPoly )
+                        {
+                            PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+
+                            textbox->TransformTextToPolySet( *layerPoly, 0, maxError,
+                                                             ERROR_INSIDE );
+                        }
+
+                        break;
+
+                    case PCB_DIM_ALIGNED_T:
+                    case PCB_DIM_CENTER_T:
+                    case PCB_DIM_RADIAL_T:
+                    case PCB_DIM_ORTHOGONAL_T:
+                    case PCB_DIM_LEADER_T:
+                        addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
+                        break;
+
+                    default:
+                        wxLogTrace( m_logTrace,
+                                    wxT( "createLayers: item type: %d not implemented" ),
+                                    item->Type() );
+                        break;
+                    }
+
+                    // add also this shape to the plated copper polygon list if required
+                    if( platedCopperPolys )
+                    {
+                        item->TransformShapeToPolygon( *platedCopperPolys, layer, 0, maxError,
+                                                       ERROR_INSIDE );
+                    }
                 }
-            }
+            };
+
+    ParallelForEachIndex( layer_ids.size(),
+                          [&]( size_t aIndex )
+                          {
+                              buildCopperLayer( layer_ids[aIndex] );
+                          } );
+
+    // ADD PLATED PADS contours
+    if( buildLayerPolys && cfg.differentiate_plated_copper )
+    {
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            footprint->TransformPadsToPolySet( *m_frontPlatedPadAndGraphicPolys, F_Cu, 0, maxError,
+                                               ERROR_INSIDE, true, false, true );
+
+            footprint->TransformPadsToPolySet( *m_backPlatedPadAndGraphicPolys, B_Cu, 0, maxError,
+                                               ERROR_INSIDE, true, false, true );
         }
     }
-
     if( cfg.show_zones )
     {
         if( aStatusReporter )
@@ -773,10 +720,10 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     // End Build Copper layers
 
     // This will make a union of all added contours
-    m_TH_ODPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_NPTH_ODPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_viaTH_ODPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_viaAnnuliPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+    m_TH_ODPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+    m_NPTH_ODPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+    m_viaTH_ODPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+    m_viaAnnuliPolys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
 
     // Build Tech layers
     // Based on:
@@ -1001,7 +948,7 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
             }
 
             // This will make a union of all added contours
-            layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
+            layerPoly->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
         }
     }
     // End Build Tech layers
@@ -1075,10 +1022,10 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         if( hasB_Cu && m_backPlatedCopperPolys->OutlineCount() )
             m_backPlatedPadAndGraphicPolys->Append( *m_backPlatedCopperPolys );
 
-        m_frontPlatedPadAndGraphicPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
-        m_backPlatedPadAndGraphicPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
-        m_frontPlatedCopperPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
-        m_backPlatedCopperPolys->Simplify( SHAPE_POLY_SET::PM_FAST );
+        m_frontPlatedPadAndGraphicPolys->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+        m_backPlatedPadAndGraphicPolys->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+        m_frontPlatedCopperPolys->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+        m_backPlatedCopperPolys->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
 
         // ADD PLATED PADS
         for( FOOTPRINT* footprint : m_board->Footprints() )
@@ -1172,12 +1119,12 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         {
             // found
             SHAPE_POLY_SET *polyLayer = m_layerHoleOdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            polyLayer->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
 
             wxASSERT( m_layerHoleIdPolys.find( layer ) != m_layerHoleIdPolys.end() );
 
             polyLayer = m_layerHoleIdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            polyLayer->ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
         }
     }
 
@@ -27,17 +27,20 @@
  * @file  3d_model.cpp
  */
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 #include <gal/opengl/kiglew.h>    // Must be included first
 
 #include "3d_model.h"
 #include "../common_ogl/ogl_utils.h"
 #include "../3d_math.h"
+#include <glm/gtc/type_ptr.hpp>
 #include <utility>
 #include <wx/debug.h>
 #include <wx/log.h>
 #include <chrono>
 #include <memory>
+#include <unordered_map>
 
 
 /*
@@ -87,6 +90,119 @@ void MODEL_3D::MakeBbox( const BBOX_3D& aBox, unsigned int aIdxOffset, VERTEX* a
 }
 
 
+std::vector<GLuint> MODEL_3D::Decimate( const std::vector<VERTEX>& aVertices,
+                                        const std::vector<GLuint>& aIndices,
+                                        const BBOX_3D& aBBox, unsigned int aGridSize )
+{
+    const SFVEC3F extent = aBBox.Max() - aBBox.Min();
+    const float   cell_size = std::max( { extent.x, extent.y, extent.z } ) / aGridSize;
+
+    if( cell_size <= FLT_EPSILON )
+        return aIndices;
+
+    // the cluster of each vertex
+    std::unordered_map<uint64_t, unsigned int> cluster_map;
+    std::vector<unsigned int>                  vertex_cluster( aVertices.size() );
+
+    for( unsigned int vtx_i = 0; vtx_i < aVertices.size(); ++vtx_i )
+    {
+        const SFVEC3F cell = ( aVertices[vtx_i].m_pos - aBBox.Min() ) / cell_size;
+        const uint64_t key = ( (uint64_t) std::clamp( (int) cell.x, 0, 0x1FFFFF ) << 42 )
+                             | ( (uint64_t) std::clamp( (int) cell.y, 0, 0x1FFFFF ) << 21 )
+                             | (uint64_t) std::clamp( (int) cell.z, 0, 0x1FFFFF );
+
+        const unsigned int next_cluster = cluster_map.size();
+
+        vertex_cluster[vtx_i] = cluster_map.try_emplace( key, next_cluster ).first->second;
+    }
+
+    // quadric of the planes of the triangles around each cluster, weighted by their area:
+    // aa, ab, ac, ad, bb, bc, bd, cc, cd, dd
+    std::vector<std::array<float, 10>> quadrics( cluster_map.size() );
+
+    for( unsigned int idx_i = 0; idx_i + 2 < aIndices.size(); idx_i += 3 )
+    {
+        const SFVEC3F& p0 = aVertices[aIndices[idx_i]].m_pos;
+        const SFVEC3F  cross = glm::cross( aVertices[aIndices[idx_i + 1]].m_pos - p0,
+                                           aVertices[aIndices[idx_i + 2]].m_pos - p0 );
+        const float    length = glm::length( cross );
+
+        if( length <= FLT_EPSILON )
+            continue;
+
+        const SFVEC3F n = cross / length;
+        const float   d = -glm::dot( n, p0 );
+        const float   w = length * 0.5f;
+
+        const std::array<float, 10> q = { n.x * n.x, n.x * n.y, n.x * n.z, n.x * d,
+                                          n.y * n.y, n.y * n.z, n.y * d,
+                                          n.z * n.z, n.z * d,
+                                          d * d };
+
+        for( unsigned int k = 0; k < 3; ++k )
+        {
+            std::array<float, 10>& cluster_q = quadrics[vertex_cluster[aIndices[idx_i + k]]];
+
+            for( unsigned int j = 0; j < 10; ++j )
+                cluster_q[j] += w * q[j];
+        }
+    }
+
+    // the vertex representing each cluster
+    std::vector<GLuint> cluster_vertex( cluster_map.size(), 0 );
+    std::vector<float>  cluster_error( cluster_map.size(), std::numeric_limits<float>::max() );
+
+    for( unsigned int vtx_i = 0; vtx_i < aVertices.size(); ++vtx_i )
+    {
+        const unsigned int           cluster = vertex_cluster[vtx_i];
+        const std::array<float, 10>& q = quadrics[cluster];
+        const SFVEC3F&               v = aVertices[vtx_i].m_pos;
+
+        const float error = q[0] * v.x * v.x + 2 * q[1] * v.x * v.y + 2 * q[2] * v.x * v.z
+                            + 2 * q[3] * v.x + q[4] * v.y * v.y + 2 * q[5] * v.y * v.z
+                            + 2 * q[6] * v.y + q[7] * v.z * v.z + 2 * q[8] * v.z + q[9];
+
+        if( error < cluster_error[cluster] )
+        {
+            cluster_error[cluster] = error;
+            cluster_vertex[cluster] = vtx_i;
+        }
+    }
+
+    // keep the triangles which don't collapse
+    std::vector<GLuint> decimated;
+
+    for( unsigned int idx_i = 0; idx_i + 2 < aIndices.size(); idx_i += 3 )
+    {
+        const GLuint a = cluster_vertex[vertex_cluster[aIndices[idx_i]]];
+        const GLuint b = cluster_vertex[vertex_cluster[aIndices[idx_i + 1]]];
+        const GLuint c = cluster_vertex[vertex_cluster[aIndices[idx_i + 2]]];
+
+        if( a == b || b == c || a == c )
+            continue;
+
+        decimated.push_back( a );
+        decimated.push_back( b );
+        decimated.push_back( c );
+    }
+
+    return decimated;
+}
+
+
+unsigned int MODEL_3D::GetLodLevel( float aScreenSize )
+{
+    // use the coarsest level whose cells are still below a pixel
+    for( unsigned int lod = LOD_LEVELS - 1; lod > 0; --lod )
+    {
+        if( aScreenSize <= lod_grid_size[lod] )
+            return lod;
+    }
+
+    return 0;
+}
+
+
 MODEL_3D::MODEL_3D( const S3DMODEL& a3DModel, MATERIAL_MODE aMaterialMode )
 {
     wxLogTrace( m_logTrace, wxT( "MODEL_3D::MODEL_3D %u meshes %u materials" ),
@@ -143,6 +259,9 @@ MODEL_3D::MODEL_3D( const S3DMODEL& a3DModel, MATERIAL_MODE aMaterialMode )
     {
         std::vector<VERTEX> m_vertices;
         std::vector<GLuint> m_indices;
+
+        // decimated indices of the levels of detail above 0, empty if not worth it
+        std::vector<GLuint> m_lod_indices[LOD_LEVELS];
     };
 
     std::vector<MESH_GROUP> mesh_groups( m_materials.size() );
@@ -270,9 +389,32 @@ MODEL_3D::MODEL_3D( const S3DMODEL& a3DModel, MATERIAL_MODE aMaterialMode )
 
     // generate geometry for the outer bounding box
     if( m_model_bbox.IsInitialized() )
+    {
         MakeBbox( m_model_bbox, 0, &bbox_tmp_vertices[0], &bbox_tmp_indices[0],
                   { 0.0f, 1.0f, 0.0f, 1.0f } );
 
+        // generate the levels of detail, which only keep the levels that save enough triangles
+        for( MESH_GROUP& mg : mesh_groups )
+        {
+            const std::vector<GLuint>* prev_indices = &mg.m_indices;
+
+            for( unsigned int lod = 1; lod < LOD_LEVELS; ++lod )
+            {
+                if( prev_indices->size() < lod_min_triangles * 3 )
+                    break;
+
+                std::vector<GLuint> lod_indices = Decimate( mg.m_vertices, *prev_indices,
+                                                            m_model_bbox, lod_grid_size[lod] );
+
+                if( lod_indices.size() * 4 > prev_indices->size() * 3 )
+                    continue;
+
+                mg.m_lod_indices[lod] = std::move( lod_indices );
+                prev_indices = &mg.m_lod_indices[lod];
+            }
+        }
+    }
+
     // create bounding box buffers
     glGenBuffers( 1, &m_bbox_vertex_buffer );
     glBindBuffer( GL_ARRAY_BUFFER, m_bbox_vertex_buffer );
@@ -308,6 +450,9 @@ MODEL_3D::MODEL_3D( const S3DMODEL& a3DModel, MATERIAL_MODE aMaterialMode )
     {
         total_vertex_count += mg.m_vertices.size();
         total_index_count += mg.m_indices.size();
+
+        for( const std::vector<GLuint>& lod_indices : mg.m_lod_indices )
+            total_index_count += lod_indices.size();
     }
 
     wxLogTrace( m_logTrace, wxT( "  total %u vertices, %u indices" ),
@@ -344,29 +489,46 @@ MODEL_3D::MODEL_3D( const S3DMODEL& a3DModel, MATERIAL_MODE aMaterialMode )
         MATERIAL&   mat = m_materials[mg_i];
         uintptr_t   tmp_idx_ptr = reinterpret_cast<uintptr_t>( tmp_idx.get() );
 
-        if( m_index_buffer_type == GL_UNSIGNED_SHORT )
+        for( unsigned int lod = 0; lod < LOD_LEVELS; ++lod )
         {
-            GLushort* idx_out = reinterpret_cast<GLushort*>( tmp_idx_ptr + idx_offset );
+            const std::vector<GLuint>& indices = lod == 0 ? mg.m_indices : mg.m_lod_indices[lod];
 
-            for( GLuint idx : mg.m_indices )
-                *idx_out++ = static_cast<GLushort>( idx + prev_vtx_count );
-        }
-        else if( m_index_buffer_type == GL_UNSIGNED_INT )
-        {
-            GLuint* idx_out = reinterpret_cast<GLuint*>( tmp_idx_ptr + idx_offset );
+            // the levels not generated use the level below
+            if( lod > 0 && indices.empty() )
+            {
+                mat.m_lod_idx_buffer_offset[lod] = mat.m_lod_idx_buffer_offset[lod - 1];
+                mat.m_lod_idx_count[lod] = mat.m_lod_idx_count[lod - 1];
+                continue;
+            }
 
-            for( GLuint idx : mg.m_indices )
-                *idx_out++ = static_cast<GLuint>( idx + prev_vtx_count );
+            if( m_index_buffer_type == GL_UNSIGNED_SHORT )
+            {
+                GLushort* idx_out = reinterpret_cast<GLushort*>( tmp_idx_ptr + idx_offset );
+
+                for( GLuint idx : indices )
+                    *idx_out++ = static_cast<GLushort>( idx + prev_vtx_count );
+            }
+            else if( m_index_buffer_type == GL_UNSIGNED_INT )
+            {
+                GLuint* idx_out = reinterpret_cast<GLuint*>( tmp_idx_ptr + idx_offset );
+
+                for( GLuint idx : indices )
+                    *idx_out++ = static_cast<GLuint>( idx + prev_vtx_count );
+            }
+
+            mat.m_lod_idx_buffer_offset[lod] = idx_offset;
+            mat.m_lod_idx_count[lod] = indices.size();
+
+            idx_offset += indices.size() * idx_size;
         }
 
         glBufferSubData( GL_ARRAY_BUFFER, vtx_offset, mg.m_vertices.size() * sizeof( VERTEX ),
                          mg.m_vertices.data() );
 
-        mat.m_render_idx_buffer_offset = idx_offset;
-        mat.m_render_idx_count = mg.m_indices.size();
+        mat.m_render_idx_buffer_offset = mat.m_lod_idx_buffer_offset[0];
+        mat.m_render_idx_count = mat.m_lod_idx_count[0];
 
         prev_vtx_count += mg.m_vertices.size();
-        idx_offset += mg.m_indices.size() * idx_size;
         vtx_offset += mg.m_vertices.size() * sizeof( VERTEX );
     }
 
@@ -425,26 +587,7 @@ void MODEL_3D::Draw( bool aTransparent, float aOpacity, bool aUseSelectedMateria
     if( !glBindBuffer )
         throw std::runtime_error( "The OpenGL context no longer exists: unable to draw" );
 
-    glBindBuffer( GL_ARRAY_BUFFER, m_vertex_buffer );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_index_buffer );
-
-    glVertexPointer( 3, GL_FLOAT, sizeof( VERTEX ),
-                     reinterpret_cast<const void*>( offsetof( VERTEX, m_pos ) ) );
-
-    glNormalPointer( GL_BYTE, sizeof( VERTEX ),
-                     reinterpret_cast<const void*>( offsetof( VERTEX, m_nrm ) ) );
-
-    glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( VERTEX ),
-                    reinterpret_cast<const void*>( m_materialMode == MATERIAL_MODE::CAD_MODE
-                                                         ? offsetof( VERTEX, m_cad_color )
-                                                         : offsetof( VERTEX, m_color ) ) );
-
-    glTexCoordPointer( 2, GL_FLOAT, sizeof( VERTEX ),
-                       reinterpret_cast<const void*>( offsetof( VERTEX, m_tex_uv ) ) );
-
-    const SFVEC4F param = SFVEC4F( 1.0f, 1.0f, 1.0f, aOpacity );
-
-    glTexEnvfv( GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, (const float*)&param.x );
+    bindBuffers( aOpacity );
 
     std::vector<const MODEL_3D::MATERIAL *> materialsToRender;
 
@@ -528,28 +671,97 @@ void MODEL_3D::Draw( bool aTransparent, float aOpacity, bool aUseSelectedMateria
 
     for( const MODEL_3D::MATERIAL* mat : materialsToRender )
     {
-        switch( m_materialMode )
-        {
-        case MATERIAL_MODE::NORMAL:
-            OglSetMaterial( *mat, aOpacity, aUseSelectedMaterial, aSelectionColor );
-            break;
+        setMaterial( *mat, aOpacity, aUseSelectedMaterial, aSelectionColor );
+
+        glDrawElements( GL_TRIANGLES, mat->m_render_idx_count, m_index_buffer_type,
+                        reinterpret_cast<const void*>(
+                                static_cast<uintptr_t>( mat->m_render_idx_buffer_offset ) ) );
+    }
+}
+
+
+void MODEL_3D::DrawOpaqueInstances( const std::vector<glm::mat4>& aModelViewMatrices,
+                                    unsigned int aLod, bool aUseSelectedMaterial,
+                                    const SFVEC3F& aSelectionColor ) const
+{
+    if( aModelViewMatrices.empty() )
+        return;
+
+    if( !glBindBuffer )
+        throw std::runtime_error( "The OpenGL context no longer exists: unable to draw" );
 
-        case MATERIAL_MODE::DIFFUSE_ONLY:
-            OglSetDiffuseMaterial( mat->m_Diffuse, aOpacity, aUseSelectedMaterial, aSelectionColor );
-            break;
+    wxASSERT( aLod < LOD_LEVELS );
 
-        case MATERIAL_MODE::CAD_MODE:
-            OglSetDiffuseMaterial( MaterialDiffuseToColorCAD( mat->m_Diffuse ), aOpacity,
-                                   aUseSelectedMaterial, aSelectionColor );
-            break;
+    bindBuffers( 1.0f );
 
-        default:
-            break;
+    for( const MODEL_3D::MATERIAL& mat : m_materials )
+    {
+        if( mat.m_render_idx_count == 0 )
+            continue;
+
+        if( mat.IsTransparent() && m_materialMode != MATERIAL_MODE::DIFFUSE_ONLY )
+            continue;
+
+        setMaterial( mat, 1.0f, aUseSelectedMaterial, aSelectionColor );
+
+        for( const glm::mat4& modelviewMatrix : aModelViewMatrices )
+        {
+            glLoadMatrixf( glm::value_ptr( modelviewMatrix ) );
+
+            glDrawElements( GL_TRIANGLES, mat.m_lod_idx_count[aLod], m_index_buffer_type,
+                            reinterpret_cast<const void*>(
+                                    static_cast<uintptr_t>( mat.m_lod_idx_buffer_offset[aLod] ) ) );
         }
+    }
+}
 
-        glDrawElements( GL_TRIANGLES, mat->m_render_idx_count, m_index_buffer_type,
-                        reinterpret_cast<const void*>(
-                                static_cast<uintptr_t>( mat->m_render_idx_buffer_offset ) ) );
+
+void MODEL_3D::bindBuffers( float aOpacity ) const
+{
+    glBindBuffer( GL_ARRAY_BUFFER, m_vertex_buffer );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_index_buffer );
+
+    glVertexPointer( 3, GL_FLOAT, sizeof( VERTEX ),
+                     reinterpret_cast<const void*>( offsetof( VERTEX, m_pos ) ) );
+
+    glNormalPointer( GL_BYTE, sizeof( VERTEX ),
+                     reinterpret_cast<const void*>( offsetof( VERTEX, m_nrm ) ) );
+
+    glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( VERTEX ),
+                    reinterpret_cast<const void*>( m_materialMode == MATERIAL_MODE::CAD_MODE
+                                                         ? offsetof( VERTEX, m_cad_color )
+                                                         : offsetof( VERTEX, m_color ) ) );
+
+    glTexCoordPointer( 2, GL_FLOAT, sizeof( VERTEX ),
+                       reinterpret_cast<const void*>( offsetof( VERTEX, m_tex_uv ) ) );
+
+    const SFVEC4F param = SFVEC4F( 1.0f, 1.0f, 1.0f, aOpacity );
+
+    glTexEnvfv( GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, (const float*)&param.x );
+}
+
+
+void MODEL_3D::setMaterial( const MATERIAL& aMaterial, float aOpacity, bool aUseSelectedMaterial,
+                            const SFVEC3F& aSelectionColor ) const
+{
+    switch( m_materialMode )
+    {
+    case MATERIAL_MODE::NORMAL:
+        OglSetMaterial( aMaterial, aOpacity, aUseSelectedMaterial, aSelectionColor );
+        break;
+
+    case MATERIAL_MODE::DIFFUSE_ONLY:
+        OglSetDiffuseMaterial( aMaterial.m_Diffuse, aOpacity, aUseSelectedMaterial,
+                               aSelectionColor );
+        break;
+
+    case MATERIAL_MODE::CAD_MODE:
+        OglSetDiffuseMaterial( MaterialDiffuseToColorCAD( aMaterial.m_Diffuse ), aOpacity,
+                               aUseSelectedMaterial, aSelectionColor );
+        break;
+
+    default:
+        break;
     }
 }
 
@@ -76,6 +76,23 @@ public:
                const glm::mat4 *aModelWorldMatrix,
                const SFVEC3F *aCameraWorldPos ) const;
 
+    /// Number of levels of detail of the models, the level 0 being the full model
+    static constexpr unsigned int LOD_LEVELS = 3;
+
+    /**
+     * @return the level of detail to draw the model with when it covers \a aScreenSize pixels.
+     */
+    static unsigned int GetLodLevel( float aScreenSize );
+
+    /**
+     * Render the opaque meshes of the model once for each of \a aModelViewMatrices.
+     *
+     * The buffers and every material are only set once for all the placements, which is what
+     * dominates the rendering of boards with many copies of the same model.
+     */
+    void DrawOpaqueInstances( const std::vector<glm::mat4>& aModelViewMatrices, unsigned int aLod,
+                              bool aUseSelectedMaterial, const SFVEC3F& aSelectionColor ) const;
+
     /**
      * Return true if have opaque meshes to render.
      */
@@ -146,6 +163,10 @@ private:
         unsigned int m_render_idx_buffer_offset = 0;
         unsigned int m_render_idx_count = 0;
 
+        ///< index ranges of each level of detail, the level 0 being the one above
+        unsigned int m_lod_idx_buffer_offset[LOD_LEVELS] = {};
+        unsigned int m_lod_idx_count[LOD_LEVELS] = {};
+
         BBOX_3D m_bbox; ///< bounding box for this material group, used for transparent material ordering
 
         MATERIAL( const SMATERIAL& aOther ) : SMATERIAL( aOther ) { }
@@ -154,6 +175,12 @@ private:
 
     std::vector<MATERIAL> m_materials;
 
+    /// Bind the buffers of the model and set the vertex arrays to them.
+    void bindBuffers( float aOpacity ) const;
+
+    void setMaterial( const MATERIAL& aMaterial, float aOpacity, bool aUseSelectedMaterial,
+                      const SFVEC3F& aSelectionColor ) const;
+
     // a model can consist of transparent and opaque parts.  remember which
     // ones are present during initial buffer and data setup.  use it later
     // during rendering.
@@ -171,6 +198,23 @@ private:
 
     static void MakeBbox( const BBOX_3D& aBox, unsigned int aIdxOffset, VERTEX* aVtxOut,
                           GLuint* aIdxOut, const glm::vec4& aColor );
+
+    /**
+     * Decimate the triangles \a aIndices by clustering \a aVertices in cubic cells, \a aGridSize
+     * of them over the largest dimension of \a aBBox.
+     *
+     * The vertices of a cell are all replaced by the one with the smallest quadric error of the
+     * triangles around the cell, so the decimated triangles still index \a aVertices.
+     */
+    static std::vector<GLuint> Decimate( const std::vector<VERTEX>& aVertices,
+                                         const std::vector<GLuint>& aIndices,
+                                         const BBOX_3D& aBBox, unsigned int aGridSize );
+
+    ///< Cells of the decimation grid of each level of detail, over the largest model dimension
+    static constexpr unsigned int lod_grid_size[LOD_LEVELS] = { 0, 96, 24 };
+
+    ///< Material groups with fewer triangles are not decimated
+    static constexpr unsigned int lod_min_triangles = 256;
 };
 
 #endif // _MODEL_3D_H_
@@ -931,6 +931,8 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
 #endif
 
     // Go for all footprints
+    std::vector<std::pair<wxString, wxString>> models;
+
     for( const FOOTPRINT* footprint : m_boardAdapter.GetBoard()->Footprints() )
     {
         wxString                libraryName = footprint->GetFPID().GetLibNickname();
@@ -956,35 +958,53 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
 
         for( const FP_3DMODEL& fp_model : footprint->Models() )
         {
-            if( fp_model.m_Show && !fp_model.m_Filename.empty() )
+            // Check if the fp_model is not present in our cache map
+            // (Not already loaded in memory)
+            if( fp_model.m_Show && !fp_model.m_Filename.empty()
+                    && m_3dModelMap.find( fp_model.m_Filename ) == m_3dModelMap.end() )
             {
-                if( aStatusReporter )
-                {
-                    // Display the short filename of the 3D fp_model loaded:
-                    // (the full name is usually too long to be displayed)
-                    wxFileName fn( fp_model.m_Filename );
-                    aStatusReporter->Report( wxString::Format( _( "Loading %s..." ),
-                                                               fn.GetFullName() ) );
-                }
+                models.emplace_back( fp_model.m_Filename, footprintBasePath );
+            }
+        }
+    }
 
-                // Check if the fp_model is not present in our cache map
-                // (Not already loaded in memory)
-                if( m_3dModelMap.find( fp_model.m_Filename ) == m_3dModelMap.end() )
-                {
-                    // It is not present, try get it from cache
-                    const S3DMODEL* modelPtr =
-                            m_boardAdapter.Get3dCacheManager()->GetModel( fp_model.m_Filename, footprintBasePath );
+    if( models.empty() )
+        return;
 
-                    // only add it if the return is not NULL
-                    if( modelPtr )
-                    {
-                        MATERIAL_MODE materialMode = m_boardAdapter.m_Cfg->m_Render.material_mode;
-                        MODEL_3D*     model        = new MODEL_3D( *modelPtr, materialMode );
+    if( aStatusReporter )
+    {
+        aStatusReporter->Report( wxString::Format( _( "Loading %d 3D models..." ),
+                                                   (int) models.size() ) );
+    }
 
-                        m_3dModelMap[ fp_model.m_Filename ] = model;
-                    }
-                }
-            }
+    // Read the model files in parallel; the OpenGL models are then built from memory
+    S3D_CACHE* cacheMgr = m_boardAdapter.Get3dCacheManager();
+
+    cacheMgr->PreloadModels( models );
+
+    for( const std::pair<wxString, wxString>& fp_model : models )
+    {
+        if( m_3dModelMap.find( fp_model.first ) != m_3dModelMap.end() )
+            continue;
+
+        if( aStatusReporter )
+        {
+            // Display the short filename of the 3D fp_model loaded:
+            // (the full name is usually too long to be displayed)
+            wxFileName fn( fp_model.first );
+            aStatusReporter->Report( wxString::Format( _( "Loading %s..." ), fn.GetFullName() ) );
+        }
+
+        // It is not present, try get it from cache
+        const S3DMODEL* modelPtr = cacheMgr->GetModel( fp_model.first, fp_model.second );
+
+        // only add it if the return is not NULL
+        if( modelPtr )
+        {
+            MATERIAL_MODE materialMode = m_boardAdapter.m_Cfg->m_Render.material_mode;
+            MODEL_3D*     model        = new MODEL_3D( *modelPtr, materialMode );
+
+            m_3dModelMap[ fp_model.first ] = model;
         }
     }
 }
@@ -34,6 +34,7 @@
 #include <3d_math.h>
 #include <glm/geometric.hpp>
 #include <math/util.h>      // for KiROUND
+#include <tuple>
 #include <utility>
 #include <vector>
 #include <wx/log.h>
@@ -1069,10 +1070,7 @@ void RENDER_3D_OPENGL::renderOpaqueModels( const glm::mat4 &aCameraViewMatrix )
         if( !renderList.empty() )
         {
             MODEL_3D::BeginDrawMulti( false );
-
-            for( const MODELTORENDER& mtr : renderList )
-                renderModel( aCameraViewMatrix, mtr, selColor, nullptr );
-
+            renderOpaqueModelList( aCameraViewMatrix, renderList, selColor );
             MODEL_3D::EndDrawMulti();
         }
     }
@@ -1083,10 +1081,7 @@ void RENDER_3D_OPENGL::renderOpaqueModels( const glm::mat4 &aCameraViewMatrix )
     if( !renderList.empty() )
     {
         MODEL_3D::BeginDrawMulti( true );
-
-        for( const MODELTORENDER& mtr : renderList )
-            renderModel( aCameraViewMatrix, mtr, selColor, nullptr );
-
+        renderOpaqueModelList( aCameraViewMatrix, renderList, selColor );
         MODEL_3D::EndDrawMulti();
     }
 
@@ -1094,6 +1089,52 @@ void RENDER_3D_OPENGL::renderOpaqueModels( const glm::mat4 &aCameraViewMatrix )
 }
 
 
+void RENDER_3D_OPENGL::renderOpaqueModelList( const glm::mat4& aCameraViewMatrix,
+                                              const std::list<MODELTORENDER>& aRenderList,
+                                              const SFVEC3F& aSelColor )
+{
+    // The bounding boxes are drawn after each model
+    if( m_boardAdapter.m_Cfg->m_Render.show_model_bbox )
+    {
+        for( const MODELTORENDER& mtr : aRenderList )
+            renderModel( aCameraViewMatrix, mtr, aSelColor, nullptr );
+
+        return;
+    }
+
+    // The level of detail follows the size of the model on screen.  The perspective projections
+    // have a -1 at [2][3], which divides by the depth.
+    const glm::mat4& projection = m_camera.GetProjectionMatrix();
+    const bool       perspective = projection[2][3] != 0.0f;
+    const float      pixelsPerUnit = projection[1][1] * m_windowSize.y * 0.5f;
+
+    std::map<std::tuple<const MODEL_3D*, unsigned int, bool>, std::vector<glm::mat4>> instances;
+
+    for( const MODELTORENDER& mtr : aRenderList )
+    {
+        const glm::mat4 modelviewMatrix = aCameraViewMatrix * mtr.m_modelWorldMat;
+        const BBOX_3D&  bBox = mtr.m_model->GetBBox();
+
+        const glm::vec4 center = modelviewMatrix * glm::vec4( bBox.GetCenter(), 1.0f );
+        const glm::vec4 extent = modelviewMatrix * glm::vec4( bBox.Max() - bBox.Min(), 0.0f );
+
+        float screenSize = glm::length( SFVEC3F( extent ) ) * pixelsPerUnit;
+
+        if( perspective )
+            screenSize /= std::max( -center.z, FLT_EPSILON );
+
+        instances[{ mtr.m_model, MODEL_3D::GetLodLevel( screenSize ), mtr.m_isSelected }]
+                .push_back( modelviewMatrix );
+    }
+
+    for( const auto& [key, modelviewMatrices] : instances )
+    {
+        std::get<0>( key )->DrawOpaqueInstances( modelviewMatrices, std::get<1>( key ),
+                                                 std::get<2>( key ), aSelColor );
+    }
+}
+
+
 void RENDER_3D_OPENGL::renderTransparentModels( const glm::mat4 &aCameraViewMatrix )
 {
     EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_boardAdapter.m_Cfg->m_Render;
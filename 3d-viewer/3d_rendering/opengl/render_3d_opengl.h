@@ -156,6 +156,15 @@ private:
     void renderModel( const glm::mat4 &aCameraViewMatrix, const MODELTORENDER &aModelToRender,
                       const SFVEC3F &aSelColor, const SFVEC3F *aCameraWorldPos );
 
+    /**
+     * Render the opaque \a aRenderList grouping the placements of the same model, so each model
+     * and material is only set up once.  Each placement uses the level of detail matching its
+     * size on screen.
+     */
+    void renderOpaqueModelList( const glm::mat4& aCameraViewMatrix,
+                                const std::list<MODELTORENDER>& aRenderList,
+                                const SFVEC3F& aSelColor );
+
 
     void get3dModelsSelected( std::list<MODELTORENDER> &aDstRenderList, bool aGetTop, bool aGetBot,
                               bool aRenderTransparentOnly, bool aRenderSelectedOnly );
@@ -104,6 +104,15 @@ void POST_SHADER::SetPixelData( unsigned int x, unsigned int y, const SFVEC3F& a
 }
 
 
+void POST_SHADER::SetPixelColor( unsigned int x, unsigned int y, const SFVEC3F& aColor )
+{
+    wxASSERT( x < m_size.x );
+    wxASSERT( y < m_size.y );
+
+    m_color[ x + y * m_size.x ] = aColor;
+}
+
+
 void POST_SHADER::destroy_buffers()
 {
     delete[] m_normals;
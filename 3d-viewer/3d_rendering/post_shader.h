@@ -59,6 +59,8 @@ public:
                        const SFVEC3F& aColor, const SFVEC3F& aHitPosition,
                        float aDepth, float aShadowAttFactor );
 
+    void SetPixelColor( unsigned int x, unsigned int y, const SFVEC3F& aColor );
+
     const SFVEC3F& GetColorAtNotProtected( const SFVEC2I& aPos ) const;
 
     void DebugBuffersOutputAsImages() const;
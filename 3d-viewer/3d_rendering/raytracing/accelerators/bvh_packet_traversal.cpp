@@ -29,6 +29,18 @@
 
 #include "bvh_pbrt.h"
 
+#include <algorithm>
+
+// The ranged traversal tests the node boxes against 4 rays at once, with the SIMD instructions
+// the build targets.  The rays of a packet are stored as structure of arrays for this.
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define BVH_PACKET_SSE2
+#elif defined( __aarch64__ ) && defined( __ARM_NEON )
+#include <arm_neon.h>
+#define BVH_PACKET_NEON
+#endif
+
 
 #define BVH_RANGED_TRAVERSAL
 //#define BVH_PARTITION_TRAVERSAL
@@ -44,41 +56,168 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                        unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+#ifdef BVH_RANGED_TRAVERSAL
+
+#define PACKET_LANES 4
+#define PACKET_GROUPS ( RAYPACKET_RAYS_PER_PACKET / PACKET_LANES )
+
+
+struct alignas( 16 ) PACKET_SOA
+{
+    float ox[RAYPACKET_RAYS_PER_PACKET];
+    float oy[RAYPACKET_RAYS_PER_PACKET];
+    float oz[RAYPACKET_RAYS_PER_PACKET];
+    float ix[RAYPACKET_RAYS_PER_PACKET];
+    float iy[RAYPACKET_RAYS_PER_PACKET];
+    float iz[RAYPACKET_RAYS_PER_PACKET];
+    float tHit[RAYPACKET_RAYS_PER_PACKET];  ///< Distance of the closest hit of each ray
+};
+
+
+/**
+ * Slab test of the rays \a aGroup * 4 to \a aGroup * 4 + 3 against \a aBBox.
+ *
+ * @return a bit mask of the rays hitting the box in front of their closest hit.
+ */
+static inline unsigned int boxHitMask( const PACKET_SOA& aRays, const BBOX_3D& aBBox,
+                                       unsigned int aGroup )
+{
+    const unsigned int i = aGroup * PACKET_LANES;
+    const SFVEC3F&     bmin = aBBox.Min();
+    const SFVEC3F&     bmax = aBBox.Max();
+
+#if defined( BVH_PACKET_SSE2 )
+    const __m128 ox = _mm_load_ps( &aRays.ox[i] );
+    const __m128 oy = _mm_load_ps( &aRays.oy[i] );
+    const __m128 oz = _mm_load_ps( &aRays.oz[i] );
+    const __m128 ix = _mm_load_ps( &aRays.ix[i] );
+    const __m128 iy = _mm_load_ps( &aRays.iy[i] );
+    const __m128 iz = _mm_load_ps( &aRays.iz[i] );
+
+    const __m128 tx0 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( bmin.x ), ox ), ix );
+    const __m128 tx1 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( bmax.x ), ox ), ix );
+    const __m128 ty0 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( bmin.y ), oy ), iy );
+    const __m128 ty1 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( bmax.y ), oy ), iy );
+    const __m128 tz0 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( bmin.z ), oz ), iz );
+    const __m128 tz1 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( bmax.z ), oz ), iz );
+
+    const __m128 tNear = _mm_max_ps( _mm_max_ps( _mm_min_ps( tx0, tx1 ), _mm_min_ps( ty0, ty1 ) ),
+                                     _mm_min_ps( tz0, tz1 ) );
+    const __m128 tFar = _mm_min_ps( _mm_min_ps( _mm_max_ps( tx0, tx1 ), _mm_max_ps( ty0, ty1 ) ),
+                                    _mm_max_ps( tz0, tz1 ) );
+
+    const __m128 hit = _mm_and_ps( _mm_cmpge_ps( tFar, _mm_max_ps( tNear, _mm_setzero_ps() ) ),
+                                   _mm_cmplt_ps( tNear, _mm_load_ps( &aRays.tHit[i] ) ) );
+
+    return (unsigned int) _mm_movemask_ps( hit );
+#elif defined( BVH_PACKET_NEON )
+    const float32x4_t ox = vld1q_f32( &aRays.ox[i] );
+    const float32x4_t oy = vld1q_f32( &aRays.oy[i] );
+    const float32x4_t oz = vld1q_f32( &aRays.oz[i] );
+    const float32x4_t ix = vld1q_f32( &aRays.ix[i] );
+    const float32x4_t iy = vld1q_f32( &aRays.iy[i] );
+    const float32x4_t iz = vld1q_f32( &aRays.iz[i] );
+
+    const float32x4_t tx0 = vmulq_f32( vsubq_f32( vdupq_n_f32( bmin.x ), ox ), ix );
+    const float32x4_t tx1 = vmulq_f32( vsubq_f32( vdupq_n_f32( bmax.x ), ox ), ix );
+    const float32x4_t ty0 = vmulq_f32( vsubq_f32( vdupq_n_f32( bmin.y ), oy ), iy );
+    const float32x4_t ty1 = vmulq_f32( vsubq_f32( vdupq_n_f32( bmax.y ), oy ), iy );
+    const float32x4_t tz0 = vmulq_f32( vsubq_f32( vdupq_n_f32( bmin.z ), oz ), iz );
+    const float32x4_t tz1 = vmulq_f32( vsubq_f32( vdupq_n_f32( bmax.z ), oz ), iz );
+
+    const float32x4_t tNear = vmaxq_f32( vmaxq_f32( vminq_f32( tx0, tx1 ), vminq_f32( ty0, ty1 ) ),
+                                         vminq_f32( tz0, tz1 ) );
+    const float32x4_t tFar = vminq_f32( vminq_f32( vmaxq_f32( tx0, tx1 ), vmaxq_f32( ty0, ty1 ) ),
+                                        vmaxq_f32( tz0, tz1 ) );
+
+    const uint32x4_t hit = vandq_u32( vcgeq_f32( tFar, vmaxq_f32( tNear, vdupq_n_f32( 0.0f ) ) ),
+                                      vcltq_f32( tNear, vld1q_f32( &aRays.tHit[i] ) ) );
+
+    static const uint32_t laneBits[PACKET_LANES] = { 1, 2, 4, 8 };
+
+    return vaddvq_u32( vandq_u32( hit, vld1q_u32( laneBits ) ) );
+#else
+    unsigned int mask = 0;
+
+    for( unsigned int lane = 0; lane < PACKET_LANES; ++lane )
+    {
+        const unsigned int r = i + lane;
+
+        const float tx0 = ( bmin.x - aRays.ox[r] ) * aRays.ix[r];
+        const float tx1 = ( bmax.x - aRays.ox[r] ) * aRays.ix[r];
+        const float ty0 = ( bmin.y - aRays.oy[r] ) * aRays.iy[r];
+        const float ty1 = ( bmax.y - aRays.oy[r] ) * aRays.iy[r];
+        const float tz0 = ( bmin.z - aRays.oz[r] ) * aRays.iz[r];
+        const float tz1 = ( bmax.z - aRays.oz[r] ) * aRays.iz[r];
+
+        const float tNear = std::max( std::max( std::min( tx0, tx1 ), std::min( ty0, ty1 ) ),
+                                      std::min( tz0, tz1 ) );
+        const float tFar = std::min( std::min( std::max( tx0, tx1 ), std::max( ty0, ty1 ) ),
+                                     std::max( tz0, tz1 ) );
+
+        if( tFar >= std::max( tNear, 0.0f ) && tNear < aRays.tHit[r] )
+            mask |= 1 << lane;
+    }
+
+    return mask;
+#endif
+}
+
+
+static inline unsigned int lowestBit( unsigned int aMask )
+{
+    return ( aMask & 1 ) ? 0 : ( aMask & 2 ) ? 1 : ( aMask & 4 ) ? 2 : 3;
+}
+
+
+static inline unsigned int highestBit( unsigned int aMask )
 {
-    float hitT;
+    return ( aMask & 8 ) ? 3 : ( aMask & 4 ) ? 2 : ( aMask & 2 ) ? 1 : 0;
+}
+
 
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT )
-      && ( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit ) )
-        return ia;
+static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const PACKET_SOA& aRays,
+                                        const BBOX_3D& aBBox, unsigned int ia )
+{
+    unsigned int group = ia / PACKET_LANES;
+    unsigned int mask = boxHitMask( aRays, aBBox, group ) & ( ~0u << ( ia % PACKET_LANES ) );
+
+    if( mask )
+        return group * PACKET_LANES + lowestBit( mask );
 
     if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
         return RAYPACKET_RAYS_PER_PACKET;
 
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    for( ++group; group < PACKET_GROUPS; ++group )
     {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT )
-          && ( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit ) )
-            return i;
+        mask = boxHitMask( aRays, aBBox, group );
+
+        if( mask )
+            return group * PACKET_LANES + lowestBit( mask );
     }
 
     return RAYPACKET_RAYS_PER_PACKET;
 }
 
 
-#ifdef BVH_RANGED_TRAVERSAL
-
-static inline unsigned int getLastHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                       unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+static inline unsigned int getLastHit( const PACKET_SOA& aRays, const BBOX_3D& aBBox,
+                                       unsigned int ia )
 {
-    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
+    const unsigned int firstGroup = ia / PACKET_LANES;
+
+    for( unsigned int group = PACKET_GROUPS - 1; group >= firstGroup; --group )
     {
-        float hitT;
+        unsigned int mask = boxHitMask( aRays, aBBox, group );
 
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT )
-          && ( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit ) )
-            return ie + 1;
+        // Only the rays after ia
+        if( group == firstGroup )
+            mask &= ~0u << ( ia % PACKET_LANES + 1 );
+
+        if( mask )
+            return group * PACKET_LANES + highestBit( mask ) + 1;
+
+        if( group == 0 )
+            break;
     }
 
     return ia + 1;
@@ -97,6 +236,21 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
     if( &m_nodes[0] == nullptr )
         return false;
 
+    PACKET_SOA rays;
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        const RAY& ray = aRayPacket.m_ray[i];
+
+        rays.ox[i] = ray.m_Origin.x;
+        rays.oy[i] = ray.m_Origin.y;
+        rays.oz[i] = ray.m_Origin.z;
+        rays.ix[i] = ray.m_InvDir.x;
+        rays.iy[i] = ray.m_InvDir.y;
+        rays.iz[i] = ray.m_InvDir.z;
+        rays.tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+    }
+
     bool anyHit = false;
     int todoOffset = 0, nodeNum = 0;
     StackNode todo[MAX_TODOS];
@@ -107,7 +261,7 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        ia = getFirstHit( aRayPacket, rays, curCell->bounds, ia );
 
         if( ia < RAYPACKET_RAYS_PER_PACKET )
         {
@@ -121,8 +275,7 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
             }
             else
             {
-                const unsigned int ie = getLastHit( aRayPacket, curCell->bounds, ia,
-                                                    aHitInfoPacket );
+                const unsigned int ie = getLastHit( rays, curCell->bounds, ia );
 
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
@@ -140,6 +293,7 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
                                 anyHit |= hit;
                                 aHitInfoPacket[i].m_hitresult |= hit;
                                 aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                                rays.tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
                             }
                         }
                     }
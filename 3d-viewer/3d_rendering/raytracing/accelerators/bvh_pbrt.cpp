@@ -72,6 +72,7 @@
 
 #include <boost/range/algorithm/nth_element.hpp>
 #include <boost/range/algorithm/partition.hpp>
+#include <core/thread_pool.h>
 #include <cstdlib>
 #include <vector>
 
@@ -130,6 +131,14 @@ struct BVHBuildNode
 };
 
 
+/// The nodes created by the build of a subtree, which may run on another thread.
+struct BVHBuildState
+{
+    int              totalNodes = 0;
+    std::list<void*> nodesToFree;
+};
+
+
 struct MortonPrimitive
 {
     int primitiveIndex;
@@ -275,17 +284,30 @@ BVH_PBRT::BVH_PBRT( const CONTAINER_3D_BASE& aObjectContainer, int aMaxPrimsInNo
     BVHBuildNode *root;
 
     if( m_splitMethod == SPLITMETHOD::HLBVH )
+    {
         root = HLBVHBuild( primitiveInfo, &totalNodes, orderedPrims );
+    }
     else
-        root = recursiveBuild( primitiveInfo, 0, m_primitives.size(), &totalNodes, orderedPrims );
+    {
+        BVHBuildState state;
+
+        orderedPrims.resize( m_primitives.size() );
+        root = recursiveBuild( primitiveInfo, 0, m_primitives.size(), state, orderedPrims );
+
+        totalNodes = state.totalNodes;
+        m_nodesToFree.splice( m_nodesToFree.end(), state.nodesToFree );
+    }
 
     wxASSERT( m_primitives.size() == orderedPrims.size() );
 
     m_primitives.swap( orderedPrims );
 
     // Compute representation of depth-first traversal of BVH tree
-    m_nodes = static_cast<LinearBVHNode*>( malloc( sizeof( LinearBVHNode ) * totalNodes ) );
-    m_nodesToFree.push_back( m_nodes );
+    // The nodes are 32 bytes, align them so that no node straddles a cache line
+    void* nodesBuffer = malloc( sizeof( LinearBVHNode ) * totalNodes + 63 );
+    m_nodesToFree.push_back( nodesBuffer );
+    m_nodes = reinterpret_cast<LinearBVHNode*>( ( reinterpret_cast<uintptr_t>( nodesBuffer ) + 63 )
+                                                & ~static_cast<uintptr_t>( 63 ) );
 
     for( int i = 0; i < totalNodes; ++i )
     {
@@ -424,10 +446,12 @@ struct BucketInfo
 
 
 BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiveInfo,
-                                         int start, int end, int* totalNodes,
+                                         int start, int end, BVHBuildState& aState,
                                          CONST_VECTOR_OBJECT& orderedPrims )
 {
-    wxASSERT( totalNodes != nullptr );
+    // Nodes with fewer primitives aren't worth building their children on different threads
+    const int parallelBuildPrimitives = 4096;
+
     wxASSERT( start >= 0 );
     wxASSERT( end   >= 0 );
     wxASSERT( start != end );
@@ -435,11 +459,11 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
     wxASSERT( start <= (int)primitiveInfo.size() );
     wxASSERT( end   <= (int)primitiveInfo.size() );
 
-    (*totalNodes)++;
+    aState.totalNodes++;
 
     // !TODO: implement a memory arena
     BVHBuildNode *node = static_cast<BVHBuildNode *>( malloc( sizeof( BVHBuildNode ) ) );
-    m_nodesToFree.push_back( node );
+    aState.nodesToFree.push_back( node );
 
     node->bounds.Reset();
     node->firstPrimOffset = 0;
@@ -460,16 +484,14 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
     if( nPrimitives == 1 )
     {
         // Create leaf _BVHBuildNode_
-        int firstPrimOffset = orderedPrims.size();
-
         for( int i = start; i < end; ++i )
         {
             int primitiveNr = primitiveInfo[i].primitiveNumber;
             wxASSERT( primitiveNr < (int)m_primitives.size() );
-            orderedPrims.push_back( m_primitives[ primitiveNr ] );
+            orderedPrims[i] = m_primitives[ primitiveNr ];
         }
 
-        node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
+        node->InitLeaf( start, nPrimitives, bounds );
     }
     else
     {
@@ -489,8 +511,6 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
                   centroidBounds.Min()[dim] ) < (FLT_EPSILON + FLT_EPSILON) )
         {
             // Create leaf _BVHBuildNode_
-            const int firstPrimOffset = orderedPrims.size();
-
             for( int i = start; i < end; ++i )
             {
                 int primitiveNr = primitiveInfo[i].primitiveNumber;
@@ -501,10 +521,10 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
 
                 wxASSERT( obj != nullptr );
 
-                orderedPrims.push_back( obj );
+                orderedPrims[i] = obj;
             }
 
-            node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
+            node->InitLeaf( start, nPrimitives, bounds );
         }
         else
         {
@@ -644,18 +664,16 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
                     else
                     {
                         // Create leaf _BVHBuildNode_
-                        const int firstPrimOffset = orderedPrims.size();
-
                         for( int i = start; i < end; ++i )
                         {
                             const int primitiveNr = primitiveInfo[i].primitiveNumber;
 
                             wxASSERT( primitiveNr < (int)m_primitives.size() );
 
-                            orderedPrims.push_back( m_primitives[ primitiveNr ] );
+                            orderedPrims[i] = m_primitives[ primitiveNr ];
                         }
 
-                        node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
+                        node->InitLeaf( start, nPrimitives, bounds );
 
                         return node;
                     }
@@ -664,10 +682,36 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
             }
             }
 
-            node->InitInterior( dim, recursiveBuild( primitiveInfo, start, mid, totalNodes,
-                                                     orderedPrims ),
-                                recursiveBuild( primitiveInfo, mid, end, totalNodes,
-                                                orderedPrims) );
+            if( nPrimitives < parallelBuildPrimitives )
+            {
+                node->InitInterior( dim, recursiveBuild( primitiveInfo, start, mid, aState,
+                                                         orderedPrims ),
+                                    recursiveBuild( primitiveInfo, mid, end, aState,
+                                                    orderedPrims ) );
+            }
+            else
+            {
+                // The children cover disjoint ranges of primitiveInfo and orderedPrims
+                BVHBuildState childStates[2];
+                BVHBuildNode* children[2];
+
+                ParallelForEachIndex( 2,
+                        [&]( size_t ii )
+                        {
+                            children[ii] = recursiveBuild( primitiveInfo,
+                                                           ii == 0 ? start : mid,
+                                                           ii == 0 ? mid : end,
+                                                           childStates[ii], orderedPrims );
+                        } );
+
+                for( BVHBuildState& childState : childStates )
+                {
+                    aState.totalNodes += childState.totalNodes;
+                    aState.nodesToFree.splice( aState.nodesToFree.end(), childState.nodesToFree );
+                }
+
+                node->InitInterior( dim, children[0], children[1] );
+            }
         }
     }
 
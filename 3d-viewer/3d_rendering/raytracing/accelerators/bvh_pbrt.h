@@ -76,6 +76,7 @@
 
 // Forward Declarations
 struct BVHBuildNode;
+struct BVHBuildState;
 struct BVHPrimitiveInfo;
 struct MortonPrimitive;
 
@@ -121,8 +122,13 @@ public:
     bool IntersectP( const RAY& aRay, float aMaxDistance ) const override;
 
 private:
+    /**
+     * Build the subtree of the primitives \a start to \a end, whose objects are stored at the
+     * same indexes of \a orderedPrims.  The subtrees of the large nodes are built in parallel.
+     */
     BVHBuildNode* recursiveBuild( std::vector<BVHPrimitiveInfo>& primitiveInfo, int start,
-                                  int end, int* totalNodes, CONST_VECTOR_OBJECT& orderedPrims );
+                                  int end, BVHBuildState& aState,
+                                  CONST_VECTOR_OBJECT& orderedPrims );
 
     BVHBuildNode* HLBVHBuild( const std::vector<BVHPrimitiveInfo>& primitiveInfo,
                               int* totalNodes, CONST_VECTOR_OBJECT& orderedPrims );
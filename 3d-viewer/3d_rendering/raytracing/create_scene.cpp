@@ -950,7 +950,7 @@ void RENDER_3D_RAYTRACE::Reload( REPORTER* aStatusReporter, REPORTER* aWarningRe
 
     // Create an accelerator
     delete m_accelerator;
-    m_accelerator = new BVH_PBRT( m_objectContainer, 8, SPLITMETHOD::MIDDLE );
+    m_accelerator = new BVH_PBRT( m_objectContainer, 8, SPLITMETHOD::SAH );
 
     if( aStatusReporter )
     {
@@ -1206,6 +1206,53 @@ void RENDER_3D_RAYTRACE::load3DModels( CONTAINER_3D& aDstContainer, bool aSkipMa
         return;
     }
 
+    // Read the model files of all shown footprints in parallel first
+    std::map<const FOOTPRINT*, wxString>       basePaths;
+    std::vector<std::pair<wxString, wxString>> models;
+
+    for( FOOTPRINT* fp : m_boardAdapter.GetBoard()->Footprints() )
+    {
+        if( fp->Models().empty()
+          || !m_boardAdapter.IsFootprintShown( (FOOTPRINT_ATTR_T) fp->GetAttributes() ) )
+        {
+            continue;
+        }
+
+        wxString libraryName = fp->GetFPID().GetLibNickname();
+        wxString footprintBasePath = wxEmptyString;
+
+        if( m_boardAdapter.GetBoard()->GetProject() )
+        {
+            try
+            {
+                // FindRow() can throw an exception
+                const FP_LIB_TABLE_ROW* fpRow =
+                    PROJECT_PCB::PcbFootprintLibs( m_boardAdapter.GetBoard()->GetProject() )
+                            ->FindRow( libraryName, false );
+
+                if( fpRow )
+                    footprintBasePath = fpRow->GetFullURI( true );
+            }
+            catch( ... )
+            {
+                // Do nothing if the libraryName is not found in lib table
+            }
+        }
+
+        for( const FP_3DMODEL& model : fp->Models() )
+        {
+            if( ( static_cast<float>( model.m_Opacity ) > FLT_EPSILON )
+              && ( model.m_Show && !model.m_Filename.empty() ) )
+            {
+                models.emplace_back( model.m_Filename, footprintBasePath );
+            }
+        }
+
+        basePaths[fp] = footprintBasePath;
+    }
+
+    m_boardAdapter.Get3dCacheManager()->PreloadModels( models );
+
     // Go for all footprints
     for( FOOTPRINT* fp : m_boardAdapter.GetBoard()->Footprints() )
     {
@@ -1250,26 +1297,7 @@ void RENDER_3D_RAYTRACE::load3DModels( CONTAINER_3D& aDstContainer, bool aSkipMa
             auto       sM       = fp->Models().begin();
             auto       eM       = fp->Models().end();
 
-            wxString                libraryName = fp->GetFPID().GetLibNickname();
-
-            wxString                footprintBasePath = wxEmptyString;
-            if( m_boardAdapter.GetBoard()->GetProject() )
-            {
-                try
-                {
-                    // FindRow() can throw an exception
-                    const FP_LIB_TABLE_ROW* fpRow =
-                        PROJECT_PCB::PcbFootprintLibs( m_boardAdapter.GetBoard()->GetProject() )
-                                ->FindRow( libraryName, false );
-
-                    if( fpRow )
-                        footprintBasePath = fpRow->GetFullURI( true );
-                }
-                catch( ... )
-                {
-                    // Do nothing if the libraryName is not found in lib table
-                }
-            }
+            const wxString& footprintBasePath = basePaths[fp];
 
             while( sM != eM )
             {
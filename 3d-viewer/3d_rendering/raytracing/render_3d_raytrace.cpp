@@ -35,6 +35,7 @@
 #include "3d_fastmath.h"
 #include "3d_math.h"
 #include "../common_ogl/ogl_utils.h"
+#include <core/thread_pool.h>
 #include <core/profile.h>        // To use GetRunningMicroSecs or another profiling utility
 #include <wx/log.h>
 
@@ -66,6 +67,7 @@ RENDER_3D_RAYTRACE::RENDER_3D_RAYTRACE( EDA_3D_CANVAS* aCanvas, BOARD_ADAPTER& a
     m_renderState = RT_RENDER_STATE_MAX; // Set to an initial invalid state
     m_renderStartTime = 0;
     m_blockRenderProgressCount = 0;
+    m_nextBlock = 0;
 }
 
 
@@ -126,13 +128,22 @@ void RENDER_3D_RAYTRACE::restartRenderState()
 
     m_renderState = RT_RENDER_STATE_TRACING;
     m_blockRenderProgressCount = 0;
+    m_nextBlock = 0;
 
     m_postShaderSsao.InitFrame();
 
-    m_blockPositionsWasProcessed.resize( m_blockPositions.size() );
+    m_blockHits.resize( m_blockPositions.size() );
 
-    // Mark the blocks not processed yet
-    std::fill( m_blockPositionsWasProcessed.begin(), m_blockPositionsWasProcessed.end(), 0 );
+    if( m_boardAdapter.m_Cfg->m_Render.raytrace_anti_aliasing )
+    {
+        m_firstHitColors.resize( m_realBufferSize.x * m_realBufferSize.y );
+        m_firstHitNodes.resize( m_realBufferSize.x * m_realBufferSize.y );
+    }
+    else
+    {
+        m_firstHitColors = std::vector<SFVEC3F>();
+        m_firstHitNodes = std::vector<unsigned int>();
+    }
 }
 
 
@@ -163,6 +174,7 @@ bool RENDER_3D_RAYTRACE::Redraw( bool aIsMoving, REPORTER* aStatusReporter,
         // revert to preview mode the first time the Redraw is called
         m_oldWindowsSize = m_windowSize;
         initializeBlockPositions();
+        initPbo();
     }
 
     std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
@@ -187,6 +199,7 @@ bool RENDER_3D_RAYTRACE::Redraw( bool aIsMoving, REPORTER* aStatusReporter,
         requestRedraw = true;
 
         initializeBlockPositions();
+        initPbo();
     }
 
 
@@ -283,6 +296,55 @@ bool RENDER_3D_RAYTRACE::Redraw( bool aIsMoving, REPORTER* aStatusReporter,
 }
 
 
+void RENDER_3D_RAYTRACE::RenderOffscreen( const wxSize& aSize, std::vector<uint8_t>& aRGBA,
+                                          REPORTER* aStatusReporter,
+                                          REPORTER* aWarningReporter )
+{
+    // Nothing here needs an OpenGL context: the frame is traced in memory
+    m_is_opengl_initialized = true;
+
+    if( m_reloadRequested )
+        Reload( aStatusReporter, aWarningReporter, false );
+
+    // The traced buffer is a little smaller than the window, so the window is grown until the
+    // buffer covers aSize, and the frame is then cropped to it
+    wxSize windowSize = aSize;
+
+    do
+    {
+        m_windowSize = windowSize;
+        initializeBlockPositions();
+        windowSize.IncBy( RAYPACKET_DIM );
+    } while( m_realBufferSize.x < (unsigned int) aSize.x
+             || m_realBufferSize.y < (unsigned int) aSize.y );
+
+    m_oldWindowsSize = m_windowSize;
+    m_camera.SetCurWindowSize( m_windowSize );
+
+    std::vector<GLubyte> frame( m_realBufferSize.x * m_realBufferSize.y * 4, 0 );
+
+    m_renderState = RT_RENDER_STATE_MAX;
+
+    while( m_renderState != RT_RENDER_STATE_FINISH )
+        render( frame.data(), nullptr );
+
+    const unsigned int xOffset = ( m_realBufferSize.x - aSize.x ) / 2;
+    const unsigned int yOffset = ( m_realBufferSize.y - aSize.y ) / 2;
+    const size_t       rowBytes = (size_t) aSize.x * 4;
+
+    aRGBA.resize( rowBytes * aSize.y );
+
+    // The frame is stored bottom row first, the way glDrawPixels() takes it
+    for( int y = 0; y < aSize.y; ++y )
+    {
+        const unsigned int srcY = yOffset + aSize.y - 1 - y;
+        const GLubyte*     src = &frame[( srcY * m_realBufferSize.x + xOffset ) * 4];
+
+        std::copy( src, src + rowBytes, aRGBA.begin() + rowBytes * y );
+    }
+}
+
+
 void RENDER_3D_RAYTRACE::render( GLubyte* ptrPBO, REPORTER* aStatusReporter )
 {
     if( ( m_renderState == RT_RENDER_STATE_FINISH ) || ( m_renderState >= RT_RENDER_STATE_MAX ) )
@@ -314,6 +376,7 @@ void RENDER_3D_RAYTRACE::render( GLubyte* ptrPBO, REPORTER* aStatusReporter )
     switch( m_renderState )
     {
     case RT_RENDER_STATE_TRACING:
+    case RT_RENDER_STATE_ANTI_ALIASING:
         renderTracing( ptrPBO, aStatusReporter );
         break;
 
@@ -345,30 +408,38 @@ void RENDER_3D_RAYTRACE::renderTracing( GLubyte* ptrPBO, REPORTER* aStatusReport
 {
     m_isPreview = false;
 
+    // The whole frame is first traced without anti-aliasing, so that a complete image is shown
+    // early, then the anti-aliasing pass refines it block by block
+    const bool antiAliasing = m_renderState == RT_RENDER_STATE_ANTI_ALIASING;
+    const bool refine = !m_firstHitColors.empty();
+
     auto startTime = std::chrono::steady_clock::now();
-    bool breakLoop = false;
+    std::atomic<bool> breakLoop( false );
 
     std::atomic<size_t> numBlocksRendered( 0 );
-    std::atomic<size_t> currentBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
 
     size_t parallelThreadCount = std::min<size_t>(
             std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
             m_blockPositions.size() );
 
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-    {
-        std::thread t = std::thread( [&]()
-        {
-            for( size_t iBlock = currentBlock.fetch_add( 1 );
-                 iBlock < m_blockPositions.size() && !breakLoop;
-                 iBlock = currentBlock.fetch_add( 1 ) )
+    // The blocks are taken from m_nextBlock by whichever thread is free, and a block once taken
+    // is always finished, so the next call continues where this one stopped
+    ParallelForEachIndex( parallelThreadCount,
+            [&]( size_t )
             {
-                if( !m_blockPositionsWasProcessed[iBlock] )
+                while( !breakLoop )
                 {
-                    renderBlockTracing( ptrPBO, iBlock );
+                    const size_t iBlock = m_nextBlock.fetch_add( 1 );
+
+                    if( iBlock >= m_blockPositions.size() )
+                        break;
+
+                    if( antiAliasing )
+                        renderBlockAntiAliasing( ptrPBO, iBlock );
+                    else
+                        renderBlockTracing( ptrPBO, iBlock );
+
                     numBlocksRendered++;
-                    m_blockPositionsWasProcessed[iBlock] = 1;
 
                     // Check if it spend already some time render and request to exit
                     // to display the progress
@@ -376,32 +447,38 @@ void RENDER_3D_RAYTRACE::renderTracing( GLubyte* ptrPBO, REPORTER* aStatusReport
                             std::chrono::steady_clock::now() - startTime ).count() > 150 )
                         breakLoop = true;
                 }
-            }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
-    }
-
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            } );
 
     m_blockRenderProgressCount += numBlocksRendered;
 
     if( aStatusReporter )
+    {
+        const size_t total = m_blockPositions.size() * ( refine ? 2 : 1 );
+        const size_t done = m_blockRenderProgressCount
+                            + ( antiAliasing ? m_blockPositions.size() : 0 );
+
         aStatusReporter->Report( wxString::Format( _( "Rendering: %.0f %%" ),
-                                                   (float) ( m_blockRenderProgressCount * 100 )
-                                                   / (float) m_blockPositions.size() ) );
+                                                   (float) ( done * 100 ) / (float) total ) );
+    }
 
-    // Check if it finish the rendering and if should continue to a post processing
+    // Check if it finish the rendering and if should continue to a refinement or post processing
     // or mark it as finished
     if( m_blockRenderProgressCount >= m_blockPositions.size() )
     {
-        if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
+        if( refine && !antiAliasing )
+        {
+            m_renderState = RT_RENDER_STATE_ANTI_ALIASING;
+            m_blockRenderProgressCount = 0;
+            m_nextBlock = 0;
+        }
+        else if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
+        {
             m_renderState = RT_RENDER_STATE_POST_PROCESS_SHADE;
+        }
         else
+        {
             m_renderState = RT_RENDER_STATE_FINISH;
+        }
     }
 }
 
@@ -639,16 +716,12 @@ void RENDER_3D_RAYTRACE::renderBlockTracing( GLubyte* ptrPBO, signed int iBlock
     // Calculate background gradient color
     SFVEC3F bgColor[RAYPACKET_DIM];// Store a vertical gradient color
 
-    for( unsigned int y = 0; y < RAYPACKET_DIM; ++y )
-    {
-        const float posYfactor = (float) ( blockPosI.y + y ) / (float) m_windowSize.y;
+    blockBackgroundColors( blockPosI, bgColor );
 
-        bgColor[y] = m_backgroundColorTop * SFVEC3F(posYfactor) +
-                     m_backgroundColorBottom * ( SFVEC3F(1.0f) - SFVEC3F(posYfactor) );
-    }
+    m_blockHits[iBlock] = m_accelerator->Intersect( blockPacket, hitPacket_X0Y0 );
 
     // Intersect ray packets (calculate the intersection with rays and objects)
-    if( !m_accelerator->Intersect( blockPacket, hitPacket_X0Y0 ) )
+    if( !m_blockHits[iBlock] )
     {
         // If block is empty then set shades and continue
         if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
@@ -698,79 +771,19 @@ void RENDER_3D_RAYTRACE::renderBlockTracing( GLubyte* ptrPBO, signed int iBlock
     renderRayPackets( bgColor, blockPacket.m_ray, hitPacket_X0Y0,
                       m_boardAdapter.m_Cfg->m_Render.raytrace_shadows, hitColor_X0Y0 );
 
-    if( m_boardAdapter.m_Cfg->m_Render.raytrace_anti_aliasing )
+    // Keep what the anti-aliasing pass needs from the first hits
+    if( !m_firstHitColors.empty() )
     {
-        SFVEC3F hitColor_AA_X1Y1[RAYPACKET_RAYS_PER_PACKET];
-
-        // Intersect one blockPosI + (0.5, 0.5) used for anti aliasing calculation
-        HITINFO_PACKET hitPacket_AA_X1Y1[RAYPACKET_RAYS_PER_PACKET];
-        HITINFO_PACKET_init( hitPacket_AA_X1Y1 );
-
-        RAYPACKET blockPacket_AA_X1Y1( m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.5f, 0.5f ),
-                                       SFVEC2F( DISP_FACTOR, DISP_FACTOR ) );
-
-        if( !m_accelerator->Intersect( blockPacket_AA_X1Y1, hitPacket_AA_X1Y1 ) )
+        for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
         {
-            // Missed all the package
-            for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
-            {
-                const SFVEC3F& outColor = bgColor[y];
+            const unsigned int yConst = blockPos.x + ( ( y + blockPos.y ) * m_realBufferSize.x );
 
-                for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
-                    hitColor_AA_X1Y1[i] = outColor;
+            for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
+            {
+                m_firstHitColors[yConst + x] = hitColor_X0Y0[i];
+                m_firstHitNodes[yConst + x] = hitPacket_X0Y0[i].m_HitInfo.m_acc_node_info;
             }
         }
-        else
-        {
-            renderRayPackets( bgColor, blockPacket_AA_X1Y1.m_ray, hitPacket_AA_X1Y1,
-                              m_boardAdapter.m_Cfg->m_Render.raytrace_shadows, hitColor_AA_X1Y1 );
-        }
-
-        SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-        {
-            SFVEC3F color_average = ( hitColor_X0Y0[i] + hitColor_AA_X1Y1[i] ) * SFVEC3F( 0.5f );
-
-            hitColor_AA_X1Y0[i] = color_average;
-            hitColor_AA_X0Y1[i] = color_average;
-            hitColor_AA_X0Y1_half[i] = color_average;
-        }
-
-        RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
-        RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
-
-        RAYPACKET_InitRays_with2DDisplacement(
-                m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.5f - DISP_FACTOR, DISP_FACTOR ),
-                SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y0 );
-
-        RAYPACKET_InitRays_with2DDisplacement(
-                m_camera, (SFVEC2F) blockPosI + SFVEC2F( DISP_FACTOR, 0.5f - DISP_FACTOR ),
-                SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X0Y1 );
-
-        RAYPACKET_InitRays_with2DDisplacement(
-                m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR ),
-                SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y1_half );
-
-        renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1, blockRayPck_AA_X1Y0,
-                                hitColor_AA_X1Y0 );
-
-        renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1, blockRayPck_AA_X0Y1,
-                                hitColor_AA_X0Y1 );
-
-        renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1,
-                                blockRayPck_AA_X1Y1_half, hitColor_AA_X0Y1_half );
-
-        // Average the result
-        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-        {
-            hitColor_X0Y0[i] = ( hitColor_X0Y0[i] + hitColor_AA_X1Y1[i] + hitColor_AA_X1Y0[i] +
-                                 hitColor_AA_X0Y1[i] + hitColor_AA_X0Y1_half[i] ) *
-                    SFVEC3F( 1.0f / 5.0f );
-        }
     }
 
     // Copy results to the next stage
@@ -833,6 +846,142 @@ void RENDER_3D_RAYTRACE::renderBlockTracing( GLubyte* ptrPBO, signed int iBlock
 }
 
 
+void RENDER_3D_RAYTRACE::renderBlockAntiAliasing( GLubyte* ptrPBO, signed int iBlock )
+{
+    // The blocks which missed everything are already final
+    if( !m_blockHits[iBlock] )
+        return;
+
+    const SFVEC2UI& blockPos = m_blockPositions[iBlock];
+    const SFVEC2I blockPosI = SFVEC2I( blockPos.x + m_xoffset, blockPos.y + m_yoffset );
+
+    SFVEC3F bgColor[RAYPACKET_DIM];
+
+    blockBackgroundColors( blockPosI, bgColor );
+
+    // Restore the first hits traced by renderBlockTracing()
+    HITINFO_PACKET hitPacket_X0Y0[RAYPACKET_RAYS_PER_PACKET];
+    SFVEC3F        hitColor_X0Y0[RAYPACKET_RAYS_PER_PACKET];
+
+    for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
+    {
+        const unsigned int yConst = blockPos.x + ( ( y + blockPos.y ) * m_realBufferSize.x );
+
+        for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
+        {
+            hitColor_X0Y0[i] = m_firstHitColors[yConst + x];
+            hitPacket_X0Y0[i].m_HitInfo.m_acc_node_info = m_firstHitNodes[yConst + x];
+        }
+    }
+
+    SFVEC3F hitColor_AA_X1Y1[RAYPACKET_RAYS_PER_PACKET];
+
+    // Intersect one blockPosI + (0.5, 0.5) used for anti aliasing calculation
+    HITINFO_PACKET hitPacket_AA_X1Y1[RAYPACKET_RAYS_PER_PACKET];
+    HITINFO_PACKET_init( hitPacket_AA_X1Y1 );
+
+    RAYPACKET blockPacket_AA_X1Y1( m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.5f, 0.5f ),
+                                   SFVEC2F( DISP_FACTOR, DISP_FACTOR ) );
+
+    if( !m_accelerator->Intersect( blockPacket_AA_X1Y1, hitPacket_AA_X1Y1 ) )
+    {
+        // Missed all the package
+        for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
+        {
+            const SFVEC3F& outColor = bgColor[y];
+
+            for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
+                hitColor_AA_X1Y1[i] = outColor;
+        }
+    }
+    else
+    {
+        renderRayPackets( bgColor, blockPacket_AA_X1Y1.m_ray, hitPacket_AA_X1Y1,
+                          m_boardAdapter.m_Cfg->m_Render.raytrace_shadows, hitColor_AA_X1Y1 );
+    }
+
+    SFVEC3F hitColor_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+    SFVEC3F hitColor_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+    SFVEC3F hitColor_AA_X0Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        SFVEC3F color_average = ( hitColor_X0Y0[i] + hitColor_AA_X1Y1[i] ) * SFVEC3F( 0.5f );
+
+        hitColor_AA_X1Y0[i] = color_average;
+        hitColor_AA_X0Y1[i] = color_average;
+        hitColor_AA_X0Y1_half[i] = color_average;
+    }
+
+    RAY blockRayPck_AA_X1Y0[RAYPACKET_RAYS_PER_PACKET];
+    RAY blockRayPck_AA_X0Y1[RAYPACKET_RAYS_PER_PACKET];
+    RAY blockRayPck_AA_X1Y1_half[RAYPACKET_RAYS_PER_PACKET];
+
+    RAYPACKET_InitRays_with2DDisplacement(
+            m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.5f - DISP_FACTOR, DISP_FACTOR ),
+            SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y0 );
+
+    RAYPACKET_InitRays_with2DDisplacement(
+            m_camera, (SFVEC2F) blockPosI + SFVEC2F( DISP_FACTOR, 0.5f - DISP_FACTOR ),
+            SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X0Y1 );
+
+    RAYPACKET_InitRays_with2DDisplacement(
+            m_camera, (SFVEC2F) blockPosI + SFVEC2F( 0.25f - DISP_FACTOR, 0.25f - DISP_FACTOR ),
+            SFVEC2F( DISP_FACTOR, DISP_FACTOR ), blockRayPck_AA_X1Y1_half );
+
+    renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1, blockRayPck_AA_X1Y0,
+                            hitColor_AA_X1Y0 );
+
+    renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1, blockRayPck_AA_X0Y1,
+                            hitColor_AA_X0Y1 );
+
+    renderAntiAliasPackets( bgColor, hitPacket_X0Y0, hitPacket_AA_X1Y1,
+                            blockRayPck_AA_X1Y1_half, hitColor_AA_X0Y1_half );
+
+    // Average the result
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        hitColor_X0Y0[i] = ( hitColor_X0Y0[i] + hitColor_AA_X1Y1[i] + hitColor_AA_X1Y0[i] +
+                             hitColor_AA_X0Y1[i] + hitColor_AA_X0Y1_half[i] ) *
+                SFVEC3F( 1.0f / 5.0f );
+    }
+
+    // Replace the colors of the first pass
+    GLubyte* ptr = &ptrPBO[( blockPos.x + ( blockPos.y * m_realBufferSize.x ) ) * 4];
+
+    const uint32_t ptrInc = ( m_realBufferSize.x - RAYPACKET_DIM ) * 4;
+    const bool     postProcessing = m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing;
+
+    for( unsigned int y = 0, i = 0; y < RAYPACKET_DIM; ++y )
+    {
+        for( unsigned int x = 0; x < RAYPACKET_DIM; ++x, ++i )
+        {
+            if( postProcessing )
+                m_postShaderSsao.SetPixelColor( blockPos.x + x, blockPos.y + y, hitColor_X0Y0[i] );
+
+            renderFinalColor( ptr, hitColor_X0Y0[i], !postProcessing );
+            ptr += 4;
+        }
+
+        ptr += ptrInc;
+    }
+}
+
+
+void RENDER_3D_RAYTRACE::blockBackgroundColors( const SFVEC2I& aBlockPos,
+                                                SFVEC3F* aBgColorY ) const
+{
+    // Vertical gradient
+    for( unsigned int y = 0; y < RAYPACKET_DIM; ++y )
+    {
+        const float posYfactor = (float) ( aBlockPos.y + y ) / (float) m_windowSize.y;
+
+        aBgColorY[y] = m_backgroundColorTop * SFVEC3F(posYfactor) +
+                       m_backgroundColorBottom * ( SFVEC3F(1.0f) - SFVEC3F(posYfactor) );
+    }
+}
+
+
 void RENDER_3D_RAYTRACE::postProcessShading( GLubyte* /* ptrPBO */, REPORTER* aStatusReporter )
 {
     if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
@@ -842,17 +991,8 @@ void RENDER_3D_RAYTRACE::postProcessShading( GLubyte* /* ptrPBO */, REPORTER* aS
 
         m_postShaderSsao.SetShadowsEnabled( m_boardAdapter.m_Cfg->m_Render.raytrace_shadows );
 
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
-                     y = nextBlock.fetch_add( 1 ) )
+        ParallelForEachIndex( m_realBufferSize.y,
+                [&]( size_t y )
                 {
                     SFVEC3F* ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
 
@@ -861,16 +1001,7 @@ void RENDER_3D_RAYTRACE::postProcessShading( GLubyte* /* ptrPBO */, REPORTER* aS
                         *ptr = m_postShaderSsao.Shade( SFVEC2I( x, y ) );
                         ptr++;
                     }
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                } );
 
         m_postShaderSsao.SetShadedBuffer( m_shaderBuffer );
 
@@ -890,17 +1021,8 @@ void RENDER_3D_RAYTRACE::postProcessBlurFinish( GLubyte* ptrPBO, REPORTER* /* aS
     if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
     {
         // Now blurs the shader result and compute the final color
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
-                     y = nextBlock.fetch_add( 1 ) )
+        ParallelForEachIndex( m_realBufferSize.y,
+                [&]( size_t y )
                 {
                     GLubyte* ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
 
@@ -922,16 +1044,7 @@ void RENDER_3D_RAYTRACE::postProcessBlurFinish( GLubyte* ptrPBO, REPORTER* /* aS
 
                         ptr += 4;
                     }
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                } );
 
         // Debug code
         //m_postShaderSsao.DebugBuffersOutputAsImages();
@@ -1928,8 +2041,6 @@ void RENDER_3D_RAYTRACE::initializeBlockPositions()
     // Create m_shader buffer
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
-
-    initPbo();
 }
 
 
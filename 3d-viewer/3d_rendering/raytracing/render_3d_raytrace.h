@@ -34,6 +34,7 @@
 #include "material.h"
 #include <plugins/3dapi/c3dmodel.h>
 
+#include <atomic>
 #include <map>
 
 /// Vector of materials
@@ -45,6 +46,7 @@ typedef std::map< const S3DMODEL* , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
+    RT_RENDER_STATE_ANTI_ALIASING,
     RT_RENDER_STATE_POST_PROCESS_SHADE,
     RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH,
     RT_RENDER_STATE_FINISH,
@@ -73,6 +75,17 @@ public:
 
     BOARD_ITEM *IntersectBoardItem( const RAY& aRay );
 
+    /**
+     * Trace a complete frame of \a aSize pixels without OpenGL, for the renders made without
+     * a window.
+     *
+     * The camera is set to the size of the frame and the board is loaded first if needed.
+     *
+     * @param aRGBA receives the RGBA pixels of the frame, top row first.
+     */
+    void RenderOffscreen( const wxSize& aSize, std::vector<uint8_t>& aRGBA,
+                          REPORTER* aStatusReporter, REPORTER* aWarningReporter );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
@@ -87,6 +100,13 @@ private:
     void postProcessShading( GLubyte* ptrPBO, REPORTER* aStatusReporter );
     void postProcessBlurFinish( GLubyte* ptrPBO, REPORTER* aStatusReporter );
     void renderBlockTracing( GLubyte* ptrPBO , signed int iBlock );
+
+    /**
+     * Refine the block \a iBlock traced by renderBlockTracing() with the anti-aliasing rays.
+     */
+    void renderBlockAntiAliasing( GLubyte* ptrPBO, signed int iBlock );
+
+    void blockBackgroundColors( const SFVEC2I& aBlockPos, SFVEC3F* aBgColorY ) const;
     void renderFinalColor( GLubyte* ptrPBO, const SFVEC3F& rgbColor,
                            bool applyColorSpaceConversion );
 
@@ -159,6 +179,9 @@ private:
     /// Save the number of blocks progress of the render
     size_t m_blockRenderProgressCount;
 
+    /// Next block to be rendered by the current tracing pass
+    std::atomic<size_t> m_nextBlock;
+
     POST_SHADER_SSAO m_postShaderSsao;
 
     std::list<LIGHT*> m_lights;
@@ -189,8 +212,12 @@ private:
     ///< Encode Morton code positions.
     std::vector< SFVEC2UI > m_blockPositions;
 
-    ///< Flag if a position was already processed (cleared each new render).
-    std::vector< int > m_blockPositionsWasProcessed;
+    ///< Flag if a block hit any object on the first tracing pass.
+    std::vector< uint8_t > m_blockHits;
+
+    ///< Color and BVH node of the first hits, kept for the anti-aliasing pass.
+    std::vector< SFVEC3F >      m_firstHitColors;
+    std::vector< unsigned int > m_firstHitNodes;
 
     ///< Encode the Morton code positions (on fast preview mode).
     std::vector< SFVEC2UI > m_blockPositionsFast;
@@ -171,6 +171,8 @@ set( sourceFileHeader
 
 #include <${outHeaderFile}>
 
+#include <cstring>
+
 using namespace ${enum};
 
 #define TOKDEF(x)    { #x, T_##x }
@@ -257,9 +259,11 @@ class ${exportMacro}${LEXERCLASS} : public DSNLEXER
 {
     /// Auto generated lexer keywords table and length:
     static const KEYWORD  keywords[];
-    static const KEYWORD_MAP keywords_hash;
     static const unsigned keyword_count;
 
+    /// Auto generated keyword lookup, a switch on the length and the first character.
+    static int lookup_keyword( const char* aToken, size_t aLength );
+
 public:
     /**
      * Constructor ( const std::string&, const wxString& )
@@ -268,7 +272,7 @@ public:
      *   If left empty, then _(\"clipboard\") is used.
      */
     ${LEXERCLASS}( const std::string& aSExpression, const wxString& aSource = wxEmptyString ) :
-        DSNLEXER( keywords, keyword_count, &keywords_hash, aSExpression, aSource )
+        DSNLEXER( keywords, keyword_count, &lookup_keyword, aSExpression, aSource )
     {
     }
 
@@ -282,7 +286,7 @@ public:
      * @param aFilename is the name of the opened file, needed for error reporting.
      */
     ${LEXERCLASS}( FILE* aFile, const wxString& aFilename ) :
-        DSNLEXER( keywords, keyword_count, &keywords_hash, aFile, aFilename )
+        DSNLEXER( keywords, keyword_count, &lookup_keyword, aFile, aFilename )
     {
     }
 
@@ -298,7 +302,7 @@ public:
      *  STRING_LINE_READER or FILE_LINE_READER.  No ownership is taken of aLineReader.
      */
     ${LEXERCLASS}( LINE_READER* aLineReader ) :
-        DSNLEXER( keywords, keyword_count, &keywords_hash, aLineReader )
+        DSNLEXER( keywords, keyword_count, &lookup_keyword, aLineReader )
     {
     }
 
@@ -416,28 +420,64 @@ const char* ${LEXERCLASS}::TokenName( T aTok )
 )
 
 
-file( APPEND "${outCppFile}"
-"
+# The keyword lookup switches on the length of a token and then on its first character, which
+# leaves at most a few keywords to compare it with.  Unlike a hashtable it costs nothing to
+# build when the program starts, and nothing to hash each token.
+set( maxLength 0 )
 
-const KEYWORD_MAP ${LEXERCLASS}::keywords_hash({
-"
-)
+foreach( token ${tokens} )
+    string( LENGTH "${token}" tokenLength )
 
-set( TOKEN_NUM 0 )
+    if( tokenLength GREATER maxLength )
+        set( maxLength ${tokenLength} )
+    endif()
+endforeach()
 
-math( EXPR tokensAfter "${tokensAfter} - 1" )
+set( lookupSource "
 
-foreach( token ${tokens} )
-    file(APPEND "${outCppFile}" "    { \"${token}\", ${TOKEN_NUM} }" )
+int ${LEXERCLASS}::lookup_keyword( const char* aToken, size_t aLength )
+{
+    switch( aLength )
+    {
+" )
 
-    if( TOKEN_NUM EQUAL tokensAfter )
-        file( APPEND "${outCppFile}" "\n" )
-    else( TOKEN_NUM EQUAL tokensAfter )
-        file( APPEND "${outCppFile}" ",\n" )
-    endif()
+foreach( length RANGE 1 ${maxLength} )
+    set( firstChar "" )
+
+    # tokens are sorted, so the ones sharing a first character are next to each other
+    foreach( token ${tokens} )
+        string( LENGTH "${token}" tokenLength )
+
+        if( tokenLength EQUAL length )
+            string( SUBSTRING "${token}" 0 1 tokenFirstChar )
 
-    math( EXPR TOKEN_NUM "${TOKEN_NUM} + 1" )
+            if( firstChar STREQUAL "" )
+                string( APPEND lookupSource
+                        "    case ${length}:\n        switch( aToken[0] )\n        {\n" )
+            elseif( NOT tokenFirstChar STREQUAL firstChar )
+                string( APPEND lookupSource "            break;\n" )
+            endif()
+
+            if( NOT tokenFirstChar STREQUAL firstChar )
+                string( APPEND lookupSource "        case '${tokenFirstChar}':\n" )
+                set( firstChar "${tokenFirstChar}" )
+            endif()
+
+            string( APPEND lookupSource
+                    "            if( !memcmp( aToken, \"${token}\", ${length} ) )\n"
+                    "                return T_${token};\n" )
+        endif()
+    endforeach()
+
+    if( NOT firstChar STREQUAL "" )
+        string( APPEND lookupSource "            break;\n        }\n        break;\n" )
+    endif()
 endforeach()
 
-file( APPEND "${outCppFile}"
-"});")
+string( APPEND lookupSource "    }
+
+    return T_SYMBOL;
+}
+" )
+
+file( APPEND "${outCppFile}" "${lookupSource}" )
@@ -72,6 +72,9 @@ static const wxChar HoleWallThickness[] = wxT( "HoleWallPlatingThickness" );
 static const wxChar CoroutineStackSize[] = wxT( "CoroutineStackSize" );
 static const wxChar ShowRouterDebugGraphics[] = wxT( "ShowRouterDebugGraphics" );
 static const wxChar EnableRouterDump[] = wxT( "EnableRouterDump" );
+static const wxChar RouterIndexGridSize[] = wxT( "RouterIndexGridSize" );
+static const wxChar ParallelRouter[] = wxT( "ParallelRouter" );
+static const wxChar IncrementalRouterSync[] = wxT( "IncrementalRouterSync" );
 static const wxChar HyperZoom[] = wxT( "HyperZoom" );
 static const wxChar CompactFileSave[] = wxT( "CompactSave" );
 static const wxChar DrawArcAccuracy[] = wxT( "DrawArcAccuracy" );
@@ -109,6 +112,46 @@ static const wxChar OcePluginAngularDeflection[] = wxT( "OcePluginAngularDeflect
 static const wxChar TriangulateSimplificationLevel[] = wxT( "TriangulateSimplificationLevel" );
 static const wxChar TriangulateMinimumArea[] = wxT( "TriangulateMinimumArea" );
 static const wxChar EnableCacheFriendlyFracture[] = wxT( "EnableCacheFriendlyFracture" );
+static const wxChar EnableRegionZoneRefill[] = wxT( "EnableRegionZoneRefill" );
+static const wxChar ZoneFillTileSize[] = wxT( "ZoneFillTileSize" );
+static const wxChar SkipUnchangedZoneFills[] = wxT( "SkipUnchangedZoneFills" );
+static const wxChar BackgroundZoneFill[] = wxT( "BackgroundZoneFill" );
+static const wxChar IncrementalRatsnest[] = wxT( "IncrementalRatsnest" );
+static const wxChar AsyncRatsnest[] = wxT( "AsyncRatsnest" );
+static const wxChar LocalRatsnestBudget[] = wxT( "LocalRatsnestBudget" );
+static const wxChar IncrementalDRC[] = wxT( "IncrementalDRC" );
+static const wxChar MemoizeDRCConstraints[] = wxT( "MemoizeDRCConstraints" );
+static const wxChar ConcurrentDRCProviders[] = wxT( "ConcurrentDRCProviders" );
+static const wxChar CacheDRCShapes[] = wxT( "CacheDRCShapes" );
+static const wxChar CacheDRCRulePrograms[] = wxT( "CacheDRCRulePrograms" );
+static const wxChar ParallelERC[] = wxT( "ParallelERC" );
+static const wxChar CacheZoneTriangulation[] = wxT( "CacheZoneTriangulation" );
+static const wxChar EnableConvexInflateFastPath[] = wxT( "EnableConvexInflateFastPath" );
+static const wxChar CacheInflatedOutlines[] = wxT( "CacheInflatedOutlines" );
+static const wxChar ParallelBoardLoad[] = wxT( "ParallelBoardLoad" );
+static const wxChar BoardSnapshots[] = wxT( "BoardSnapshots" );
+static const wxChar ParallelBoardSave[] = wxT( "ParallelBoardSave" );
+static const wxChar LazyFootprintLibraries[] = wxT( "LazyFootprintLibraries" );
+static const wxChar ParallelSchematicLoad[] = wxT( "ParallelSchematicLoad" );
+static const wxChar LazySymbolLibraries[] = wxT( "LazySymbolLibraries" );
+static const wxChar ParallelAltiumImport[] = wxT( "ParallelAltiumImport" );
+static const wxChar StreamingEagleImport[] = wxT( "StreamingEagleImport" );
+static const wxChar LibraryTimestampCacheMs[] = wxT( "LibraryTimestampCacheMs" );
+static const wxChar DeferPythonInit[] = wxT( "DeferPythonInit" );
+static const wxChar PreloadKifaces[] = wxT( "PreloadKifaces" );
+static const wxChar IncrementalBoardSave[] = wxT( "IncrementalBoardSave" );
+static const wxChar ParallelViewUpdate[] = wxT( "ParallelViewUpdate" );
+static const wxChar UncachedNetnameLayers[] = wxT( "UncachedNetnameLayers" );
+static const wxChar ZoneFillProxies[] = wxT( "ZoneFillProxies" );
+static const wxChar StrokeGlyphAtlas[] = wxT( "StrokeGlyphAtlas" );
+static const wxChar LazyLodGroups[] = wxT( "LazyLodGroups" );
+static const wxChar ShowRenderStatistics[] = wxT( "ShowRenderStatistics" );
+static const wxChar CairoTiledRendering[] = wxT( "CairoTiledRendering" );
+static const wxChar GroupColorTable[] = wxT( "GroupColorTable" );
+static const wxChar ViewUpdateTimeBudget[] = wxT( "ViewUpdateTimeBudget" );
+static const wxChar ModelMemoryCacheSize3D[] = wxT( "3DModelMemoryCacheSize" );
+static const wxChar UndoMemoryLimit[] = wxT( "UndoMemoryLimit" );
+static const wxChar PerfTraceFile[] = wxT( "PerfTraceFile" );
 } // namespace KEYS
 
 
@@ -198,6 +241,9 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_CoroutineStackSize        = AC_STACK::default_stack;
     m_ShowRouterDebugGraphics   = false;
     m_EnableRouterDump          = false;
+    m_RouterIndexGridSize       = 0.0;
+    m_ParallelRouter            = true;
+    m_IncrementalRouterSync     = true;
     m_HyperZoom                 = false;
     m_DrawArcAccuracy           = 10.0;
     m_DrawArcCenterMaxAngle     = 50.0;
@@ -261,6 +307,47 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_EnableCacheFriendlyFracture = true;
 
+    m_EnableRegionZoneRefill = true;
+    m_ZoneFillTileSize = 30.0;
+    m_SkipUnchangedZoneFills = true;
+    m_BackgroundZoneFill = false;
+
+    m_IncrementalRatsnest = true;
+    m_AsyncRatsnest = false;
+    m_LocalRatsnestBudget = 15;
+    m_IncrementalDRC = false;
+    m_MemoizeDRCConstraints = true;
+    m_ConcurrentDRCProviders = true;
+    m_CacheDRCShapes = true;
+    m_CacheDRCRulePrograms = true;
+    m_ParallelERC = true;
+    m_CacheZoneTriangulation = true;
+    m_EnableConvexInflateFastPath = true;
+    m_CacheInflatedOutlines = true;
+    m_ParallelBoardLoad = true;
+    m_BoardSnapshots = true;
+    m_ParallelBoardSave = true;
+    m_LazyFootprintLibraries = true;
+    m_ParallelSchematicLoad = true;
+    m_LazySymbolLibraries = true;
+    m_ParallelAltiumImport = true;
+    m_StreamingEagleImport = true;
+    m_LibraryTimestampCacheMs = 5000;
+    m_DeferPythonInit = true;
+    m_PreloadKifaces = true;
+    m_IncrementalBoardSave = true;
+    m_ParallelViewUpdate = true;
+    m_UncachedNetnameLayers = true;
+    m_ZoneFillProxies = true;
+    m_StrokeGlyphAtlas = true;
+    m_LazyLodGroups = true;
+    m_ShowRenderStatistics = false;
+    m_CairoTiledRendering = true;
+    m_GroupColorTable = true;
+    m_ViewUpdateTimeBudget = 40.0;
+    m_3DModelMemoryCacheSize = 2048;
+    m_UndoMemoryLimit = 1024;
+
     loadFromConfigFile();
 }
 
@@ -341,6 +428,17 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::EnableRouterDump,
                                                 &m_EnableRouterDump, m_EnableRouterDump ) );
 
+    configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::RouterIndexGridSize,
+                                                  &m_RouterIndexGridSize, m_RouterIndexGridSize,
+                                                  0.0, 100.0 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelRouter,
+                                                &m_ParallelRouter, m_ParallelRouter ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalRouterSync,
+                                                &m_IncrementalRouterSync,
+                                                m_IncrementalRouterSync ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::HyperZoom,
                                                 &m_HyperZoom, m_HyperZoom ) );
 
@@ -477,6 +575,148 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                 &m_EnableCacheFriendlyFracture,
                                                 m_EnableCacheFriendlyFracture ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::EnableRegionZoneRefill,
+                                                &m_EnableRegionZoneRefill,
+                                                m_EnableRegionZoneRefill ) );
+
+    configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::ZoneFillTileSize,
+                                                  &m_ZoneFillTileSize,
+                                                  m_ZoneFillTileSize, 0.0, 1000.0 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::SkipUnchangedZoneFills,
+                                                &m_SkipUnchangedZoneFills,
+                                                m_SkipUnchangedZoneFills ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::BackgroundZoneFill,
+                                                &m_BackgroundZoneFill, m_BackgroundZoneFill ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalRatsnest,
+                                                &m_IncrementalRatsnest, m_IncrementalRatsnest ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::AsyncRatsnest,
+                                                &m_AsyncRatsnest, m_AsyncRatsnest ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::LocalRatsnestBudget,
+                                               &m_LocalRatsnestBudget, m_LocalRatsnestBudget,
+                                               0, 1000 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalDRC,
+                                                &m_IncrementalDRC, m_IncrementalDRC ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::MemoizeDRCConstraints,
+                                                &m_MemoizeDRCConstraints,
+                                                m_MemoizeDRCConstraints ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ConcurrentDRCProviders,
+                                                &m_ConcurrentDRCProviders,
+                                                m_ConcurrentDRCProviders ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CacheDRCShapes,
+                                                &m_CacheDRCShapes, m_CacheDRCShapes ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CacheDRCRulePrograms,
+                                                &m_CacheDRCRulePrograms,
+                                                m_CacheDRCRulePrograms ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelERC,
+                                                &m_ParallelERC, m_ParallelERC ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CacheZoneTriangulation,
+                                                &m_CacheZoneTriangulation,
+                                                m_CacheZoneTriangulation ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::EnableConvexInflateFastPath,
+                                                &m_EnableConvexInflateFastPath,
+                                                m_EnableConvexInflateFastPath ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CacheInflatedOutlines,
+                                                &m_CacheInflatedOutlines,
+                                                m_CacheInflatedOutlines ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardLoad,
+                                                &m_ParallelBoardLoad, m_ParallelBoardLoad ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::BoardSnapshots,
+                                                &m_BoardSnapshots, m_BoardSnapshots ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelBoardSave,
+                                                &m_ParallelBoardSave, m_ParallelBoardSave ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::LazyFootprintLibraries,
+                                                &m_LazyFootprintLibraries,
+                                                m_LazyFootprintLibraries ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelSchematicLoad,
+                                                &m_ParallelSchematicLoad,
+                                                m_ParallelSchematicLoad ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::LazySymbolLibraries,
+                                                &m_LazySymbolLibraries, m_LazySymbolLibraries ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelAltiumImport,
+                                                &m_ParallelAltiumImport,
+                                                m_ParallelAltiumImport ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::StreamingEagleImport,
+                                                &m_StreamingEagleImport,
+                                                m_StreamingEagleImport ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::LibraryTimestampCacheMs,
+                                               &m_LibraryTimestampCacheMs,
+                                               m_LibraryTimestampCacheMs, 0, 3600000 ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DeferPythonInit,
+                                                &m_DeferPythonInit, m_DeferPythonInit ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::PreloadKifaces,
+                                                &m_PreloadKifaces, m_PreloadKifaces ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalBoardSave,
+                                                &m_IncrementalBoardSave,
+                                                m_IncrementalBoardSave ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ParallelViewUpdate,
+                                                &m_ParallelViewUpdate, m_ParallelViewUpdate ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::UncachedNetnameLayers,
+                                                &m_UncachedNetnameLayers,
+                                                m_UncachedNetnameLayers ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneFillProxies,
+                                                &m_ZoneFillProxies, m_ZoneFillProxies ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::StrokeGlyphAtlas,
+                                                &m_StrokeGlyphAtlas, m_StrokeGlyphAtlas ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::LazyLodGroups,
+                                                &m_LazyLodGroups, m_LazyLodGroups ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowRenderStatistics,
+                                                &m_ShowRenderStatistics,
+                                                m_ShowRenderStatistics ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CairoTiledRendering,
+                                                &m_CairoTiledRendering,
+                                                m_CairoTiledRendering ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::GroupColorTable,
+                                                &m_GroupColorTable, m_GroupColorTable ) );
+
+    configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::ViewUpdateTimeBudget,
+                                                  &m_ViewUpdateTimeBudget,
+                                                  m_ViewUpdateTimeBudget, 0.0, 1000.0 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ModelMemoryCacheSize3D,
+                                               &m_3DModelMemoryCacheSize, m_3DModelMemoryCacheSize,
+                                               0, 1000000 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::UndoMemoryLimit,
+                                               &m_UndoMemoryLimit, m_UndoMemoryLimit,
+                                               0, 1000000 ) );
+
+    configParams.push_back( new PARAM_CFG_WXSTRING( true, AC_KEYS::PerfTraceFile,
+                                                    &m_PerfTraceFile, m_PerfTraceFile ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     wxString traceMasks;
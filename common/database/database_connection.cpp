@@ -339,11 +339,13 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
 
     if( m_cache->Get( tableName, cacheEntry ) )
     {
-        if( cacheEntry.count( aWhere.second ) )
+        auto row = cacheEntry->find( aWhere.second );
+
+        if( row != cacheEntry->end() )
         {
             wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s` - cache hit" ),
                         tableName, aWhere.second );
-            aResult = cacheEntry.at( aWhere.second );
+            aResult = row->second;
             return true;
         }
     }
@@ -356,11 +358,13 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
 
         if( m_cache->Get( tableName, cacheEntry ) )
         {
-            if( cacheEntry.count( aWhere.second ) )
+            auto row = cacheEntry->find( aWhere.second );
+
+            if( row != cacheEntry->end() )
             {
                 wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s` - cache hit" ),
                             tableName, aWhere.second );
-                aResult = cacheEntry.at( aWhere.second );
+                aResult = row->second;
                 return true;
             }
         }
@@ -540,7 +544,7 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
 
     timer.Stop();
 
-    DB_CACHE_TYPE::CACHE_VALUE cacheEntry;
+    std::map<std::string, ROW> rows;
 
     auto handleException =
             [&]( std::runtime_error& aException, const std::string& aExtraContext = "" )
@@ -549,42 +553,42 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
         std::string extra = aExtraContext.empty() ? "" : ": " + aExtraContext;
         wxLogTrace( traceDatabase,
                     wxT( "Exception while parsing result %d from selectAllAndCache: %s%s" ),
-                    cacheEntry.size(), m_lastError, extra );
+                    rows.size(), m_lastError, extra );
     };
 
-    while( results.next() )
+    // The names and types of the columns are the same for all the rows
+    std::vector<std::pair<std::string, int>> columns;
+
+    try
     {
-        short columnCount = 0;
-        ROW result;
+        short columnCount = results.columns();
 
-        try
-        {
-            columnCount = results.columns();
-        }
-        catch( nanodbc::database_error& e )
+        for( short j = 0; j < columnCount; ++j )
         {
-            handleException( e );
-            return false;
+            columns.emplace_back( toUTF8( results.column_name( j ) ),
+                                  results.column_datatype( j ) );
         }
+    }
+    catch( std::runtime_error& e )
+    {
+        handleException( e, fmt::format( "column index {}", columns.size() ) );
+        return false;
+    }
 
-        for( short j = 0; j < columnCount; ++j )
+    while( results.next() )
+    {
+        ROW result;
+
+        for( short j = 0; j < (short) columns.size(); ++j )
         {
-            std::string column;
-            std::string columnExtraDbgInfo;
-            int datatype = SQL_UNKNOWN_TYPE;
+            const auto& [column, datatype] = columns[j];
 
-            try
-            {
-                column = toUTF8( results.column_name( j ) );
-                datatype = results.column_datatype( j );
-                columnExtraDbgInfo = fmt::format( "column index {}, name '{}', type {}", j, column,
-                                                  datatype );
-            }
-            catch( nanodbc::index_range_error& e )
-            {
-                handleException( e, columnExtraDbgInfo );
-                return false;
-            }
+            auto columnExtraDbgInfo =
+                    [&]()
+                    {
+                        return fmt::format( "column index {}, name '{}', type {}", j, column,
+                                            datatype );
+                    };
 
             switch( datatype )
             {
@@ -605,7 +609,7 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
                 }
                 catch( std::runtime_error& e )
                 {
-                    handleException( e, columnExtraDbgInfo );
+                    handleException( e, columnExtraDbgInfo() );
                     return false;
                 }
                 break;
@@ -620,7 +624,7 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
                 }
                 catch( std::runtime_error& e )
                 {
-                    handleException( e, columnExtraDbgInfo );
+                    handleException( e, columnExtraDbgInfo() );
                     return false;
                 }
             }
@@ -629,13 +633,13 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
 
         wxASSERT( result.count( aKey ) );
         std::string keyStr = std::any_cast<std::string>( result.at( aKey ) );
-        cacheEntry[keyStr] = result;
+        rows[keyStr] = std::move( result );
     }
 
     wxLogTrace( traceDatabase, wxT( "selectAllAndCache from %s completed in %0.1f ms" ), aTable,
                 timer.msecs() );
 
-    m_cache->Put( aTable, cacheEntry );
+    m_cache->Put( aTable, std::make_shared<const std::map<std::string, ROW>>( std::move( rows ) ) );
     return true;
 }
 
@@ -681,9 +685,9 @@ bool DATABASE_CONNECTION::SelectAll( const std::string& aTable, const std::strin
 
     wxLogTrace( traceDatabase, wxT( "SelectAll: `%s` - returning cached results" ), aTable );
 
-    aResults.reserve( cacheEntry.size() );
+    aResults.reserve( cacheEntry->size() );
 
-    for( auto &[ key, row ] : cacheEntry )
+    for( auto &[ key, row ] : *cacheEntry )
         aResults.emplace_back( row );
 
     return true;
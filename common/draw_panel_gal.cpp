@@ -24,10 +24,13 @@
  * or you may write to the Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
+#include <advanced_config.h>
 #include <confirm.h>
 #include <eda_draw_frame.h>
 #include <kiface_base.h>
+#include <layer_ids.h>
 #include <macros.h>
+#include <paths.h>
 #include <scoped_set_reset.h>
 #include <settings/app_settings.h>
 #include <trace_helpers.h>
@@ -42,6 +45,7 @@
 #include <gal/opengl/opengl_gal.h>
 #include <gal/cairo/cairo_gal.h>
 #include <math/vector2wx.h>
+#include <preview_items/preview_utils.h>
 
 
 #include <tool/tool_dispatcher.h>
@@ -55,6 +59,12 @@
 
 #include <pgm_base.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <functional>
+
 EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWindowId,
                                         const wxPoint& aPosition, const wxSize& aSize,
                                         KIGFX::GAL_DISPLAY_OPTIONS& aOptions, GAL_TYPE aGalType ) :
@@ -234,6 +244,9 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
     PROF_TIMER cntRedraw("view-redraw-rects");
 
     bool isDirty = false;
+    bool showStatistics = ADVANCED_CFG::GetCfg().m_ShowRenderStatistics;
+
+    m_view->CollectStatistics( showStatistics );
 
     cntTotal.Start();
     try
@@ -242,7 +255,9 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
 
         try
         {
-            m_view->UpdateItems();
+            // Large updates are spread over several frames, showing the previous graphics of
+            // the items until they are updated
+            m_view->UpdateItems( ADVANCED_CFG::GetCfg().m_ViewUpdateTimeBudget );
         }
         catch( std::out_of_range& err )
         {
@@ -262,6 +277,10 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
             KIGFX::GAL_DRAWING_CONTEXT ctx( m_gal );
             cntCtx.Stop();
 
+            // The statistics are drawn on the overlay, so it has to be redrawn with them
+            if( showStatistics )
+                m_view->MarkTargetDirty( KIGFX::TARGET_OVERLAY );
+
             if( m_view->IsTargetDirty( KIGFX::TARGET_OVERLAY )
                 && !m_gal->HasTarget( KIGFX::TARGET_OVERLAY ) )
             {
@@ -298,6 +317,9 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
                 isDirty = true;
             }
 
+            if( showStatistics )
+                drawStatistics();
+
             m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
 
             cntCtxDestroy.Start();
@@ -338,12 +360,132 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
         );
     }
 
+    if( showStatistics && isDirty )
+    {
+        m_statistics.m_frameTime = cntTotal.msecs();
+        m_statistics.m_updateTime = cntUpd.msecs();
+        m_statistics.m_redrawTime = cntRedraw.msecs();
+        m_statistics.m_endTime = cntCtxDestroy.msecs();
+
+        logStatistics();
+    }
+
+    // Carry on with the items left for the next frames
+    if( m_view->HasPendingUpdates() )
+        m_needIdleRefresh = true;
+
     m_lastRepaintEnd = wxGetLocalTimeMillis();
 
     return true;
 }
 
 
+void EDA_DRAW_PANEL_GAL::drawStatistics()
+{
+    const KIGFX::VIEW::REDRAW_STATISTICS& viewStats = m_view->GetStatistics();
+    KIGFX::GAL_STATISTICS                 galStats = m_gal->GetStatistics();
+    std::vector<wxString>                 lines;
+
+    // The times of the GAL and of the whole frame are the ones of the previous frame, which
+    // is finished
+    lines.push_back( wxString::Format( wxT( "Frame %.1f ms: update %.1f, redraw %.1f, end %.1f "
+                                            "(flush %.1f, composite %.1f, swap %.1f)" ),
+                                       m_statistics.m_frameTime, m_statistics.m_updateTime,
+                                       m_statistics.m_redrawTime, m_statistics.m_endTime,
+                                       galStats.m_flushTime, galStats.m_compositeTime,
+                                       galStats.m_swapTime ) );
+
+    if( galStats.m_cachedCapacity > 0 )
+    {
+        const double mb = KIGFX::VERTEX_SIZE / ( 1024.0 * 1024.0 );
+
+        lines.push_back( wxString::Format( wxT( "Cache: %u of %u vertices (%.1f of %.1f MB), "
+                                                "%u defragmentations" ),
+                                           galStats.m_cachedVertices, galStats.m_cachedCapacity,
+                                           galStats.m_cachedVertices * mb,
+                                           galStats.m_cachedCapacity * mb,
+                                           galStats.m_defragmentations ) );
+        lines.push_back( wxString::Format( wxT( "Non-cached: %u vertices" ),
+                                           galStats.m_nonCachedVertices ) );
+    }
+
+    // The layers drawing the most, which are the ones worth looking at
+    std::vector<std::pair<unsigned int, int>> layers;
+
+    for( const auto& [layer, count] : viewStats.m_layerItems )
+    {
+        auto it = viewStats.m_layerVertices.find( layer );
+        layers.emplace_back( it != viewStats.m_layerVertices.end() ? it->second : 0, layer );
+    }
+
+    std::sort( layers.begin(), layers.end(), std::greater<>() );
+
+    const size_t MAX_LAYERS = 10;
+
+    for( size_t ii = 0; ii < layers.size() && ii < MAX_LAYERS; ii++ )
+    {
+        int      layer = layers[ii].second;
+        wxString name = layer < PCB_LAYER_ID_COUNT ? LayerName( layer )
+                                                   : wxString::Format( wxT( "%d" ), layer );
+
+        lines.push_back( wxString::Format( wxT( "%s: %u items, %u vertices" ), name,
+                                           viewStats.m_layerItems.at( layer ), layers[ii].first ) );
+    }
+
+    m_gal->SetTarget( KIGFX::TARGET_OVERLAY );
+    m_gal->SetLayerDepth( m_gal->GetMinDepth() );
+
+    VECTOR2D origin = m_view->ToWorld( VECTOR2D( 0.0, 0.0 ) );
+
+    KIGFX::PREVIEW::DrawTextNextToCursor( m_view, origin, { -1, -1 }, lines, true );
+    KIGFX::PREVIEW::DrawTextNextToCursor( m_view, origin, { -1, -1 }, lines, false );
+}
+
+
+void EDA_DRAW_PANEL_GAL::logStatistics()
+{
+    if( !m_statisticsLog )
+    {
+        wxFileName fn( PATHS::GetUserCachePath(), wxT( "render_statistics.log" ) );
+
+        if( !PATHS::EnsurePathExists( fn.GetPath() ) )
+            return;
+
+        m_statisticsLog = std::make_unique<wxFFile>( fn.GetFullPath(), wxT( "a" ) );
+    }
+
+    if( !m_statisticsLog->IsOpened() )
+        return;
+
+    const KIGFX::VIEW::REDRAW_STATISTICS& viewStats = m_view->GetStatistics();
+    KIGFX::GAL_STATISTICS                 galStats = m_gal->GetStatistics();
+    unsigned int                          items = 0;
+    unsigned int                          vertices = 0;
+
+    for( const auto& [layer, count] : viewStats.m_layerItems )
+        items += count;
+
+    for( const auto& [layer, count] : viewStats.m_layerVertices )
+        vertices += count;
+
+    // One tab separated line per frame: the times in ms, then the items and vertices drawn,
+    // then the state of the cache
+    m_statisticsLog->Write( wxString::Format( wxT( "%lld\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f"
+                                                   "\t%.2f\t%u\t%u\t%u\t%u\t%u\t%u\n" ),
+                                              wxGetLocalTimeMillis().GetValue(),
+                                              m_statistics.m_frameTime,
+                                              m_statistics.m_updateTime,
+                                              m_statistics.m_redrawTime,
+                                              m_statistics.m_endTime, galStats.m_flushTime,
+                                              galStats.m_compositeTime, galStats.m_swapTime,
+                                              items, vertices, galStats.m_nonCachedVertices,
+                                              galStats.m_cachedVertices,
+                                              galStats.m_cachedCapacity,
+                                              galStats.m_defragmentations ) );
+    m_statisticsLog->Flush();
+}
+
+
 void EDA_DRAW_PANEL_GAL::onSize( wxSizeEvent& aEvent )
 {
     // If we get a second wx update call before the first finishes, don't crash
@@ -624,6 +766,10 @@ void EDA_DRAW_PANEL_GAL::onIdle( wxIdleEvent& aEvent )
     {
         m_needIdleRefresh = false;
         Refresh();
+
+        // The update of the view isn't finished yet
+        if( m_needIdleRefresh && m_view->HasPendingUpdates() )
+            aEvent.RequestMore();
     }
 
     aEvent.Skip();
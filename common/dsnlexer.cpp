@@ -52,7 +52,7 @@ void DSNLEXER::init()
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    const KEYWORD_MAP* aKeywordMap,
+                    KEYWORD_LOOKUP aKeywordLookup,
                     FILE* aFile, const wxString& aFilename ) :
     iOwnReaders( true ),
     start( nullptr ),
@@ -61,7 +61,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
     reader( nullptr ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
-    keywordsLookup( aKeywordMap )
+    keywordsLookup( aKeywordLookup )
 {
     FILE_LINE_READER* fileReader = new FILE_LINE_READER( aFile, aFilename );
     PushReader( fileReader );
@@ -70,7 +70,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    const KEYWORD_MAP* aKeywordMap,
+                    KEYWORD_LOOKUP aKeywordLookup,
                     const std::string& aClipboardTxt, const wxString& aSource ) :
     iOwnReaders( true ),
     start( nullptr ),
@@ -79,7 +79,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
     reader( nullptr ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
-    keywordsLookup( aKeywordMap )
+    keywordsLookup( aKeywordLookup )
 {
     STRING_LINE_READER* stringReader = new STRING_LINE_READER( aClipboardTxt, aSource.IsEmpty() ?
                                         wxString( FMT_CLIPBOARD ) : aSource );
@@ -89,7 +89,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
 
 
 DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
-                    const KEYWORD_MAP* aKeywordMap,
+                    KEYWORD_LOOKUP aKeywordLookup,
                     LINE_READER* aLineReader ) :
     iOwnReaders( false ),
     start( nullptr ),
@@ -98,7 +98,7 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount,
     reader( nullptr ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
-    keywordsLookup( aKeywordMap )
+    keywordsLookup( aKeywordLookup )
 {
     if( aLineReader )
         PushReader( aLineReader );
@@ -229,12 +229,7 @@ LINE_READER* DSNLEXER::PopReader()
 int DSNLEXER::findToken( const std::string& tok ) const
 {
     if( keywordsLookup != nullptr )
-    {
-        KEYWORD_MAP::const_iterator it = keywordsLookup->find( tok.c_str() );
-
-        if( it != keywordsLookup->end() )
-            return it->second;
-    }
+        return keywordsLookup( tok.data(), tok.size() );
 
     return DSN_SYMBOL;      // not a keyword, some arbitrary symbol.
 }
@@ -613,6 +608,18 @@ L_read:
 
             while( head<limit )
             {
+                // Copy the run of plain characters up to the next escape or delimiter in one
+                // go; only escape sequences are decoded character by character.
+                const char* run = head;
+
+                while( head < limit && *head != '\\' && *head != '"' )
+                    ++head;
+
+                curText.append( run, head );
+
+                if( head >= limit )
+                    break;  // throw exception at L_unterminated
+
                 // ESCAPE SEQUENCES:
                 if( *head =='\\' )
                 {
@@ -679,16 +686,12 @@ L_read:
                     curText += c;
                 }
 
-                else if( *head == '"' )     // end of the non-specctraMode DSN_STRING
+                else    // *head == '"', the end of the non-specctraMode DSN_STRING
                 {
                     curTok = DSN_STRING;
                     ++head;                 // omit this trailing double quote
                     goto exit;
                 }
-
-                else
-                    curText += *head++;
-
             }   // while
 
             // L_unterminated:
@@ -768,11 +771,11 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.assign( cur, head );
 
     if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
     {
@@ -798,6 +801,62 @@ exit:   // single point of exit, no returns elsewhere please.
 }
 
 
+void DSNLEXER::SkipSection()
+{
+    wxASSERT( !specctraMode );
+
+    const char* cur = next;
+    int         depth = 1;
+
+    prevTok = curTok;
+
+    while( depth > 0 )
+    {
+        if( cur >= limit )
+        {
+            if( readLine() == 0 )
+            {
+                curTok = DSN_EOF;
+                next = start;
+                Unexpected( DSN_EOF );
+            }
+
+            cur = start;
+            continue;
+        }
+
+        switch( *cur++ )
+        {
+        case '(':
+            depth++;
+            break;
+
+        case ')':
+            depth--;
+            break;
+
+        case '"':
+            // Quoted strings don't span lines; a backslash escapes the next character
+            while( cur < limit && *cur != '"' )
+                cur += ( *cur == '\\' && cur + 1 < limit ) ? 2 : 1;
+
+            if( cur < limit )
+                ++cur;
+
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    curText = ")";
+    curTok = DSN_RIGHT;
+    curOffset = cur - 1 - start;
+    next = cur;
+}
+
+
 wxArrayString* DSNLEXER::ReadCommentLines()
 {
     wxArrayString*  ret = nullptr;
@@ -522,6 +522,7 @@ void EDA_BASE_FRAME::AddStandardHelpMenu( wxMenuBar* aMenuBar )
     helpMenu->Add( ACTIONS::getInvolved );
     helpMenu->Add( ACTIONS::donate );
     helpMenu->Add( ACTIONS::reportBug );
+    helpMenu->Add( ACTIONS::showMemoryUsage );
 
     helpMenu->AppendSeparator();
     helpMenu->Add( ACTIONS::about );
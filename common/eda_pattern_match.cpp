@@ -26,11 +26,67 @@
 #include <limits>
 #include <wx/log.h>
 #include <wx/tokenzr.h>
+#include <wx/wxcrt.h>
 #include <algorithm>
 
 // Helper to make the code cleaner when we want this operation
 #define CLAMPED_VAL_INT_MAX( x ) std::min( x, static_cast<size_t>( std::numeric_limits<int>::max() ) )
 
+SEARCH_TRIGRAMS::SEARCH_TRIGRAMS( const std::vector<SEARCH_TERM>& aTerms ) :
+        m_bits()
+{
+    for( const SEARCH_TERM& term : aTerms )
+        Add( term.Text );
+}
+
+
+void SEARCH_TRIGRAMS::Add( const wxString& aText )
+{
+    const size_t bitCount = m_bits.size() * 64;
+    uint32_t     c0 = 0;
+    uint32_t     c1 = 0;
+    size_t       count = 0;
+
+    for( wxUniChar ch : aText )
+    {
+        uint32_t c2 = static_cast<uint32_t>( wxTolower( ch.GetValue() ) );
+
+        if( ++count >= 3 )
+        {
+            uint32_t hash = ( c0 * 0x9E3779B1u ) ^ ( c1 * 0x85EBCA77u ) ^ ( c2 * 0xC2B2AE3Du );
+            size_t   bit = ( hash ^ ( hash >> 15 ) ) % bitCount;
+
+            m_bits[bit / 64] |= uint64_t( 1 ) << ( bit % 64 );
+        }
+
+        c0 = c1;
+        c1 = c2;
+    }
+}
+
+
+bool SEARCH_TRIGRAMS::IsEmpty() const
+{
+    return std::all_of( m_bits.begin(), m_bits.end(),
+                        []( uint64_t aWord )
+                        {
+                            return aWord == 0;
+                        } );
+}
+
+
+bool SEARCH_TRIGRAMS::Contains( const SEARCH_TRIGRAMS& aOther ) const
+{
+    for( size_t ii = 0; ii < m_bits.size(); ++ii )
+    {
+        if( ( aOther.m_bits[ii] & ~m_bits[ii] ) != 0 )
+            return false;
+    }
+
+    return true;
+}
+
+
 bool EDA_PATTERN_MATCH_SUBSTR::SetPattern( const wxString& aPattern )
 {
     m_pattern = aPattern;
@@ -418,6 +474,22 @@ EDA_COMBINED_MATCHER::EDA_COMBINED_MATCHER( const wxString& aPattern,
         AddMatcher( aPattern, std::make_unique<EDA_PATTERN_MATCH_SUBSTR>() );
         break;
     }
+
+    // A wildcard pattern without wildcards is matched as a literal substring, so any text it
+    // matches holds all its trigrams.  Regular expressions and relations can match without.
+    bool literal = !aPattern.Contains( wxS( "*" ) ) && !aPattern.Contains( wxS( "?" ) );
+
+    for( const std::unique_ptr<EDA_PATTERN_MATCH>& matcher : m_matchers )
+    {
+        if( dynamic_cast<EDA_PATTERN_MATCH_WILDCARD*>( matcher.get() ) )
+            continue;
+
+        if( !dynamic_cast<EDA_PATTERN_MATCH_SUBSTR*>( matcher.get() ) )
+            literal = false;
+    }
+
+    if( literal )
+        m_literalTrigrams.Add( aPattern );
 }
 
 
@@ -499,6 +571,16 @@ int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms )
 }
 
 
+int EDA_COMBINED_MATCHER::ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms,
+                                      const SEARCH_TRIGRAMS& aTermTrigrams )
+{
+    if( !m_literalTrigrams.IsEmpty() && !aTermTrigrams.Contains( m_literalTrigrams ) )
+        return 0;
+
+    return ScoreTerms( aWeightedTerms );
+}
+
+
 wxString const& EDA_COMBINED_MATCHER::GetPattern() const
 {
     return m_pattern;
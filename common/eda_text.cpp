@@ -93,6 +93,8 @@ EDA_TEXT::EDA_TEXT( const EDA_IU_SCALE& aIuScale, const wxString& aText ) :
         m_text( aText ),
         m_IuScale( aIuScale ),
         m_render_cache_font( nullptr ),
+        m_shape_cache_font( nullptr ),
+        m_shape_cache_pen_width( 0 ),
         m_bounding_box_cache_valid( false ),
         m_bounding_box_cache_line( -1 ),
         m_bounding_box_cache_inverted( false )
@@ -130,6 +132,14 @@ EDA_TEXT::EDA_TEXT( const EDA_TEXT& aText ) :
 
     m_render_cache.clear();
 
+    // The cached shape is never modified, so copies can share it
+    m_shape_cache = aText.m_shape_cache;
+    m_shape_cache_text = aText.m_shape_cache_text;
+    m_shape_cache_font = aText.m_shape_cache_font;
+    m_shape_cache_angle = aText.m_shape_cache_angle;
+    m_shape_cache_pos = aText.m_shape_cache_pos;
+    m_shape_cache_pen_width = aText.m_shape_cache_pen_width;
+
     for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aText.m_render_cache )
     {
         if( KIFONT::OUTLINE_GLYPH* outline = dynamic_cast<KIFONT::OUTLINE_GLYPH*>( glyph.get() ) )
@@ -166,6 +176,14 @@ EDA_TEXT& EDA_TEXT::operator=( const EDA_TEXT& aText )
 
     m_render_cache.clear();
 
+    // The cached shape is never modified, so copies can share it
+    m_shape_cache = aText.m_shape_cache;
+    m_shape_cache_text = aText.m_shape_cache_text;
+    m_shape_cache_font = aText.m_shape_cache_font;
+    m_shape_cache_angle = aText.m_shape_cache_angle;
+    m_shape_cache_pos = aText.m_shape_cache_pos;
+    m_shape_cache_pen_width = aText.m_shape_cache_pen_width;
+
     for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aText.m_render_cache )
     {
         if( KIFONT::OUTLINE_GLYPH* outline = dynamic_cast<KIFONT::OUTLINE_GLYPH*>( glyph.get() ) )
@@ -500,6 +518,38 @@ const KIFONT::METRICS& EDA_TEXT::getFontMetrics() const
 void EDA_TEXT::ClearRenderCache()
 {
     m_render_cache.clear();
+    m_shape_cache.reset();
+}
+
+
+size_t EDA_TEXT::GetRenderCacheMemoryUsage() const
+{
+    size_t size = m_render_cache.capacity() * sizeof( void* );
+
+    for( const std::unique_ptr<KIFONT::GLYPH>& glyph : m_render_cache )
+    {
+        if( glyph->IsOutline() )
+        {
+            const auto* outline = static_cast<const KIFONT::OUTLINE_GLYPH*>( glyph.get() );
+
+            size += sizeof( KIFONT::OUTLINE_GLYPH ) + outline->GetMemoryUsage()
+                    + outline->GetTriangulationMemoryUsage();
+        }
+        else if( glyph->IsStroke() )
+        {
+            const auto* stroke = static_cast<const KIFONT::STROKE_GLYPH*>( glyph.get() );
+
+            size += sizeof( KIFONT::STROKE_GLYPH );
+
+            for( const std::vector<VECTOR2D>& pointList : *stroke )
+                size += sizeof( pointList ) + pointList.capacity() * sizeof( VECTOR2D );
+        }
+    }
+
+    if( m_shape_cache )
+        size += m_shape_cache->Shapes().size() * sizeof( SHAPE_SEGMENT );
+
+    return size;
 }
 
 
@@ -1000,6 +1050,26 @@ std::shared_ptr<SHAPE_COMPOUND> EDA_TEXT::GetEffectiveTextShape( bool aTriangula
     {
         attrs.m_Angle = GetDrawRotation();
 
+        if( aTriangulate )
+        {
+            if( m_shape_cache
+                    && m_shape_cache_font == font
+                    && m_shape_cache_text == shownText
+                    && m_shape_cache_angle == attrs.m_Angle
+                    && m_shape_cache_pos == drawPos
+                    && m_shape_cache_pen_width == penWidth )
+            {
+                return m_shape_cache;
+            }
+
+            m_shape_cache = shape;
+            m_shape_cache_font = font;
+            m_shape_cache_text = shownText;
+            m_shape_cache_angle = attrs.m_Angle;
+            m_shape_cache_pos = drawPos;
+            m_shape_cache_pen_width = penWidth;
+        }
+
         if( font->IsOutline() )
             cache = GetRenderCache( font, shownText, VECTOR2I() );
     }
@@ -26,6 +26,7 @@
 #include <math/util.h>      // for KiROUND
 #include <macros.h>
 #include <charconv>
+#include <limits>
 #include <wx/translation.h>
 
 
@@ -166,44 +167,186 @@ std::string EDA_UNIT_UTILS::FormatAngle( const EDA_ANGLE& aAngle )
 }
 
 
-std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+/**
+ * @return the number of decimal places of a millimetre in \a aIuScale, or -1 if its internal
+ *         units aren't a power of ten fractions of a millimetre.
+ */
+static int iuDecimalPlaces( const EDA_IU_SCALE& aIuScale )
 {
-    std::string buf;
-    double engUnits = aValue;
+    double scale = 1.0;
+
+    for( int places = 0; places <= 9; ++places, scale *= 10.0 )
+    {
+        if( aIuScale.IU_PER_MM == scale )
+            return places;
+    }
+
+    return -1;
+}
+
 
-    engUnits /= aIuScale.IU_PER_MM;
+static const int64_t s_powersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000,
+                                         100000000, 1000000000 };
 
-    if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+
+/**
+ * Append \a aValue in millimetres to \a aBuf, which must have room for 24 characters.
+ *
+ * Internal units which are a power of ten fractions of a millimetre are written exactly
+ * from the integer, giving the same text as the "%.10g" formatting of the millimetre
+ * value (which never needs an exponent or more than 10 digits for an int).
+ *
+ * @return the end of the formatted value.
+ */
+static char* formatInternalUnits( char* aBuf, const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    int places = iuDecimalPlaces( aIuScale );
+
+    if( places < 0 )
     {
-        buf = fmt::format( "{:.10f}", engUnits );
+        std::string buf;
+        double      engUnits = aValue;
+
+        engUnits /= aIuScale.IU_PER_MM;
 
-        // remove trailing zeros
-        while( !buf.empty() && buf[buf.size() - 1] == '0' )
+        if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
         {
-            buf.pop_back();
+            buf = fmt::format( "{:.10f}", engUnits );
+
+            // remove trailing zeros
+            while( !buf.empty() && buf[buf.size() - 1] == '0' )
+            {
+                buf.pop_back();
+            }
+
+            // if the value was really small
+            // we may have just stripped all the zeros after the decimal
+            if( buf[buf.size() - 1] == '.' )
+            {
+                buf.pop_back();
+            }
         }
-
-        // if the value was really small
-        // we may have just stripped all the zeros after the decimal
-        if( buf[buf.size() - 1] == '.' )
+        else
         {
-            buf.pop_back();
+            buf = fmt::format( "{:.10g}", engUnits );
         }
+
+        return std::copy( buf.begin(), buf.end(), aBuf );
     }
-    else
+
+    char*   p = aBuf;
+    int64_t value = aValue;
+
+    if( value < 0 )
     {
-        buf = fmt::format( "{:.10g}", engUnits );
+        *p++ = '-';
+        value = -value;
     }
 
-    return buf;
+    int64_t scale = s_powersOfTen[places];
+    int64_t frac = value % scale;
+
+    p = std::to_chars( p, aBuf + 24, value / scale ).ptr;
+
+    if( frac )
+    {
+        *p++ = '.';
+
+        // Fractional digits, without the trailing zeros
+        for( ; frac && places > 0; --places )
+        {
+            scale /= 10;
+            *p++ = '0' + frac / scale;
+            frac %= scale;
+        }
+    }
+
+    return p;
+}
+
+
+std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
+{
+    char buf[24];
+
+    return std::string( buf, formatInternalUnits( buf, aIuScale, aValue ) );
 }
 
 
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                  const VECTOR2I&     aPoint )
 {
-    return FormatInternalUnits( aIuScale, aPoint.x ) + " "
-           + FormatInternalUnits( aIuScale, aPoint.y );
+    char  buf[50];
+    char* p = formatInternalUnits( buf, aIuScale, aPoint.x );
+
+    *p++ = ' ';
+
+    return std::string( buf, formatInternalUnits( p, aIuScale, aPoint.y ) );
+}
+
+
+bool EDA_UNIT_UTILS::ParseInternalUnitsExact( std::string_view aInput,
+                                              const EDA_IU_SCALE& aIuScale, int& aOut )
+{
+    int places = iuDecimalPlaces( aIuScale );
+
+    if( places < 0 )
+        return false;
+
+    const char* p = aInput.data();
+    const char* end = p + aInput.size();
+    bool        negative = false;
+    bool        anyDigits = false;
+    int64_t     value = 0;
+
+    if( p < end && ( *p == '-' || *p == '+' ) )
+        negative = *p++ == '-';
+
+    for( ; p < end && *p >= '0' && *p <= '9'; ++p )
+    {
+        value = value * 10 + ( *p - '0' );
+        anyDigits = true;
+
+        // Allow for the magnitude of INT_MIN; the final range check catches everything else
+        if( value > int64_t( std::numeric_limits<int>::max() ) + 1 )
+            return false;
+    }
+
+    int fracDigits = 0;
+
+    if( p < end && *p == '.' )
+    {
+        for( ++p; p < end && *p >= '0' && *p <= '9'; ++p )
+        {
+            anyDigits = true;
+
+            // Digits past the internal unit resolution need rounding; leave that to the caller
+            if( fracDigits == places )
+            {
+                if( *p != '0' )
+                    return false;
+
+                continue;
+            }
+
+            value = value * 10 + ( *p - '0' );
+            fracDigits++;
+        }
+    }
+
+    if( !anyDigits || p != end )
+        return false;
+
+    value *= s_powersOfTen[places - fracDigits];
+
+    if( negative )
+        value = -value;
+
+    if( value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max() )
+        return false;
+
+    aOut = static_cast<int>( value );
+    return true;
 }
 
 
@@ -134,8 +134,15 @@ FONT::FONT()
 }
 
 
+// Board files are parsed in parallel, and their text items all look up their font
+static std::mutex s_defaultFontMutex;
+static std::mutex s_fontMapMutex;
+
+
 FONT* FONT::getDefaultFont()
 {
+    std::lock_guard<std::mutex> lock( s_defaultFontMutex );
+
     if( !s_defaultFont )
         s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
 
@@ -150,6 +157,8 @@ FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic )
 
     std::tuple<wxString, bool, bool> key = { aFontName, aBold, aItalic };
 
+    std::lock_guard<std::mutex> lock( s_fontMapMutex );
+
     FONT* font = nullptr;
 
     if( s_fontMap.find( key ) != s_fontMap.end() )
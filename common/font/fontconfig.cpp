@@ -21,11 +21,16 @@
 
 
 #include <font/fontconfig.h>
+#include <wx/filename.h>
 #include <wx/log.h>
 #include <trace_helpers.h>
 #include <string_utils.h>
 #include <macros.h>
 #include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <nlohmann/json.hpp>
+#include <paths.h>
 #include <reporter.h>
 
 #ifdef __WIN32__
@@ -35,8 +40,11 @@
 
 using namespace fontconfig;
 
-static FONTCONFIG* g_config = nullptr;
-static bool        g_fcInitSuccess = false;
+static std::once_flag g_fcInitOnce;
+static bool           g_fcInitSuccess = false;
+
+/// Bump when the meaning of the cached matches changes
+static const int FONT_MATCH_CACHE_VERSION = 1;
 
 REPORTER* FONTCONFIG::s_reporter = nullptr;
 
@@ -57,6 +65,7 @@ wxString FONTCONFIG::Version()
 
 FONTCONFIG::FONTCONFIG()
 {
+    loadMatchCache();
 };
 
 
@@ -96,15 +105,141 @@ static void bootstrapFc()
 }
 
 
+/**
+ * Initialize fontconfig the first time it is needed.  This scans the fonts of the system when
+ * its own cache is missing or outdated, which is slow with thousands of fonts.
+ */
+static bool initFc()
+{
+    std::call_once( g_fcInitOnce, bootstrapFc );
+    return g_fcInitSuccess;
+}
+
+
 FONTCONFIG* Fontconfig()
 {
-    if( !g_config )
+    // Never deleted: the fonts may be used until the program exits
+    static FONTCONFIG* config = new FONTCONFIG();
+
+    return config;
+}
+
+
+static wxFileName matchCacheFileName()
+{
+    return wxFileName( PATHS::GetUserCachePath(), wxT( "font_matches.json" ) );
+}
+
+
+static long long fileModTime( const wxString& aFile )
+{
+    wxFileName fn( aFile );
+
+    if( !fn.FileExists() )
+        return -1;
+
+    return static_cast<long long>( fn.GetModificationTime().GetTicks() );
+}
+
+
+void FONTCONFIG::loadMatchCache()
+{
+    std::ifstream stream( matchCacheFileName().GetFullPath().fn_str() );
+
+    if( !stream.is_open() )
+        return;
+
+    try
+    {
+        nlohmann::json cache;
+        stream >> cache;
+
+        if( cache.value( "version", 0 ) != FONT_MATCH_CACHE_VERSION )
+            return;
+
+        for( const nlohmann::json& entry : cache.at( "matches" ) )
+        {
+            FONT_MATCH match;
+            match.m_file = wxString::FromUTF8( entry.at( "file" ).get<std::string>() );
+            match.m_faceIndex = entry.at( "index" ).get<int>();
+            match.m_modTime = entry.at( "mtime" ).get<long long>();
+
+            m_matchCache[entry.at( "key" ).get<std::string>()] = match;
+        }
+    }
+    catch( ... )
+    {
+        // A damaged cache only means the fonts are looked up again
+        m_matchCache.clear();
+    }
+}
+
+
+void FONTCONFIG::saveMatchCache()
+{
+    nlohmann::json matches = nlohmann::json::array();
+
+    for( const auto& [key, match] : m_matchCache )
+    {
+        matches.push_back( { { "key", key },
+                             { "file", std::string( match.m_file.utf8_str() ) },
+                             { "index", match.m_faceIndex },
+                             { "mtime", match.m_modTime } } );
+    }
+
+    nlohmann::json cache = { { "version", FONT_MATCH_CACHE_VERSION }, { "matches", matches } };
+    std::ofstream  stream( matchCacheFileName().GetFullPath().fn_str() );
+
+    if( stream.is_open() )
+        stream << std::setw( 2 ) << cache << std::endl;
+}
+
+
+bool FONTCONFIG::findCachedMatch( const std::string& aKey, wxString& aFontFile, int& aFaceIndex )
+{
+    std::lock_guard<std::mutex> lock( m_matchCacheMutex );
+
+    auto it = m_matchCache.find( aKey );
+
+    if( it == m_matchCache.end() )
+        return false;
+
+    FONT_MATCH& match = it->second;
+
+    if( !match.m_checked )
     {
-        bootstrapFc();
-        g_config = new FONTCONFIG();
+        long long modTime = fileModTime( match.m_file );
+
+        // The font was updated or removed: find it again
+        if( modTime < 0 || modTime != match.m_modTime )
+        {
+            m_matchCache.erase( it );
+            return false;
+        }
+
+        match.m_checked = true;
     }
 
-    return g_config;
+    aFontFile = match.m_file;
+    aFaceIndex = match.m_faceIndex;
+    return true;
+}
+
+
+void FONTCONFIG::addCachedMatch( const std::string& aKey, const wxString& aFontFile,
+                                 int aFaceIndex )
+{
+    std::lock_guard<std::mutex> lock( m_matchCacheMutex );
+
+    FONT_MATCH& match = m_matchCache[aKey];
+
+    match.m_file = aFontFile;
+    match.m_faceIndex = aFaceIndex;
+    match.m_modTime = fileModTime( aFontFile );
+    match.m_checked = true;
+
+    // New matches are rare, as each font is only looked up once per machine
+    saveMatchCache();
 }
 
 
@@ -201,7 +336,14 @@ FONTCONFIG::FF_RESULT FONTCONFIG::FindFont( const wxString &aFontName, wxString
 {
     FF_RESULT retval = FF_RESULT::FF_ERROR;
 
-    if( !g_fcInitSuccess )
+    // Only exact matches are cached: a missing font may be installed later
+    std::string matchKey = std::string( aFontName.utf8_str() ) + ( aBold ? "|b" : "|" )
+                           + ( aItalic ? "|i" : "|" );
+
+    if( findCachedMatch( matchKey, aFontFile, aFaceIndex ) )
+        return FF_RESULT::FF_OK;
+
+    if( !initFc() )
         return retval;
 
     // If the original font name contains any of these, then it is bold, regardless
@@ -352,15 +494,21 @@ FONTCONFIG::FF_RESULT FONTCONFIG::FindFont( const wxString &aFontName, wxString
     }
 
     FcPatternDestroy( pat );
+
+    if( retval == FF_RESULT::FF_OK )
+        addCachedMatch( matchKey, aFontFile, aFaceIndex );
+
     return retval;
 }
 
 
 void FONTCONFIG::ListFonts( std::vector<std::string>& aFonts, const std::string& aDesiredLang )
 {
-    if( !g_fcInitSuccess )
+    if( !initFc() )
         return;
 
+    std::lock_guard<std::mutex> lock( m_fontInfoMutex );
+
     // be sure to cache bust if the language changed
     if( m_fontInfoCache.empty() || m_fontCacheLastLang != aDesiredLang )
     {
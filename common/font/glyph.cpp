@@ -33,6 +33,10 @@ STROKE_GLYPH::STROKE_GLYPH( const STROKE_GLYPH& aGlyph )
         push_back( pointList );
 
     m_boundingBox = aGlyph.m_boundingBox;
+    m_fontGlyph = aGlyph.m_fontGlyph;
+    m_origin = aGlyph.m_origin;
+    m_xAxis = aGlyph.m_xAxis;
+    m_yAxis = aGlyph.m_yAxis;
 }
 
 
@@ -88,24 +92,42 @@ std::unique_ptr<GLYPH> STROKE_GLYPH::Transform( const VECTOR2D& aGlyphSize, cons
     glyph->m_boundingBox.SetEnd( end );
     glyph->m_boundingBox.Offset( aOffset );
 
+    auto transform =
+            [&]( VECTOR2D& point )
+            {
+                point *= aGlyphSize;
+
+                if( aTilt != 0.0 )
+                    point.x -= point.y * aTilt;
+
+                point += aOffset;
+
+                if( aMirror )
+                    point.x = aOrigin.x - ( point.x - aOrigin.x );
+
+                if( !aAngle.IsZero() )
+                    RotatePoint( point, aOrigin, aAngle );
+            };
+
     for( std::vector<VECTOR2D>& pointList : *glyph )
     {
         for( VECTOR2D& point : pointList )
-        {
-            point *= aGlyphSize;
-
-            if( aTilt != 0.0 )
-                point.x -= point.y * aTilt;
+            transform( point );
+    }
 
-            point += aOffset;
+    // The transform is affine, so it is composed with the one from the font glyph by mapping
+    // the origin and the ends of the unit vectors
+    VECTOR2D origin = m_origin;
+    VECTOR2D xEnd = m_origin + m_xAxis;
+    VECTOR2D yEnd = m_origin + m_yAxis;
 
-            if( aMirror )
-                point.x = aOrigin.x - ( point.x - aOrigin.x );
+    transform( origin );
+    transform( xEnd );
+    transform( yEnd );
 
-            if( !aAngle.IsZero() )
-                RotatePoint( point, aOrigin, aAngle );
-        }
-    }
+    glyph->m_origin = origin;
+    glyph->m_xAxis = xEnd - origin;
+    glyph->m_yAxis = yEnd - origin;
 
     return glyph;
 }
@@ -114,6 +136,7 @@ std::unique_ptr<GLYPH> STROKE_GLYPH::Transform( const VECTOR2D& aGlyphSize, cons
 void STROKE_GLYPH::Move( const VECTOR2I& aOffset )
 {
     m_boundingBox.Offset( aOffset );
+    m_origin += aOffset;
 
     for( std::vector<VECTOR2D>& pointList : *this )
     {
@@ -32,7 +32,10 @@
 #include FT_GLYPH_H
 #include FT_BBOX_H
 #include <trigo.h>
+#include <trace_helpers.h>
 #include <core/utf8.h>
+#include <wx/filename.h>
+#include <wx/log.h>
 
 using namespace KIFONT;
 
@@ -41,7 +44,9 @@ FT_Library OUTLINE_FONT::m_freeType = nullptr;
 std::mutex OUTLINE_FONT::m_freeTypeMutex;
 
 OUTLINE_FONT::OUTLINE_FONT() :
-        m_face(NULL),
+        m_face( nullptr ),
+        m_faceLoaded( false ),
+        m_faceIndex( 0 ),
         m_faceSize( 16 ),
         m_fakeBold( false ),
         m_fakeItal( false )
@@ -72,21 +77,36 @@ OUTLINE_FONT* OUTLINE_FONT::LoadFont( const wxString& aFontName, bool aBold, boo
     if( retval == fc::FF_RESULT::FF_MISSING_ITAL || retval == fc::FF_RESULT::FF_MISSING_BOLD_ITAL )
         font->SetFakeItal();
 
-    if( font->loadFace( fontFile, faceIndex ) != 0 )
+    // The face itself is loaded when first used
+    if( !wxFileName::FileExists( fontFile ) )
         return nullptr;
 
     font->m_fontName = aFontName;       // Keep asked-for name, even if we substituted.
     font->m_fontFileName = fontFile;
+    font->m_faceIndex = faceIndex;
 
     return font.release();
 }
 
 
-FT_Error OUTLINE_FONT::loadFace( const wxString& aFontFileName, int aFaceIndex )
+const FT_Face& OUTLINE_FONT::GetFace() const
 {
     std::lock_guard<std::mutex> guard( m_freeTypeMutex );
 
-    FT_Error e = FT_New_Face( m_freeType, aFontFileName.mb_str( wxConvUTF8 ), aFaceIndex, &m_face );
+    loadFace();
+    return m_face;
+}
+
+
+FT_Error OUTLINE_FONT::loadFace() const
+{
+    if( m_faceLoaded )
+        return m_face ? 0 : FT_Err_Cannot_Open_Resource;
+
+    m_faceLoaded = true;
+
+    FT_Error e = FT_New_Face( m_freeType, m_fontFileName.mb_str( wxConvUTF8 ), m_faceIndex,
+                              &m_face );
 
     if( !e )
     {
@@ -99,6 +119,11 @@ FT_Error OUTLINE_FONT::loadFace( const wxString& aFontFileName, int aFaceIndex )
         // 0 = vertical device resolution ( 0 = same as horizontal )
         FT_Set_Char_Size( m_face, 0, faceSize(), GLYPH_RESOLUTION, 0 );
     }
+    else
+    {
+        m_face = nullptr;
+        wxLogTrace( traceFonts, wxS( "Unable to load font file '%s'" ), m_fontFileName );
+    }
 
     return e;
 }
@@ -110,10 +135,11 @@ FT_Error OUTLINE_FONT::loadFace( const wxString& aFontFileName, int aFaceIndex )
  */
 double OUTLINE_FONT::GetInterline( double aGlyphHeight, const METRICS& aFontMetrics ) const
 {
-    double glyphToFontHeight = 1.0;
+    double  glyphToFontHeight = 1.0;
+    FT_Face face = GetFace();
 
-    if( GetFace()->units_per_EM )
-        glyphToFontHeight = GetFace()->height / GetFace()->units_per_EM;
+    if( face && face->units_per_EM )
+        glyphToFontHeight = face->height / face->units_per_EM;
 
     return aFontMetrics.GetInterline( aGlyphHeight * glyphToFontHeight );
 }
@@ -273,6 +299,23 @@ struct GLYPH_CACHE_KEY {
     }
 };
 
+
+/**
+ * A glyph of a given size and style, as placed at the origin of its text.
+ */
+struct GLYPH_SHAPE_KEY {
+    GLYPH_CACHE_KEY glyph;
+    VECTOR2I        size;
+    bool            subscript;
+    bool            superscript;
+
+    bool operator==(const GLYPH_SHAPE_KEY& rhs ) const
+    {
+        return glyph == rhs.glyph && size == rhs.size && subscript == rhs.subscript
+                   && superscript == rhs.superscript;
+    }
+};
+
 namespace std
 {
     template <>
@@ -286,9 +329,35 @@ namespace std
                         ^ hash<int>()( k.mirror ) ^ hash<int>()( k.angle.AsTenthsOfADegree() );
         }
     };
+
+    template <>
+    struct hash<GLYPH_SHAPE_KEY>
+    {
+        std::size_t operator()( const GLYPH_SHAPE_KEY& k ) const
+        {
+            return hash<GLYPH_CACHE_KEY>()( k.glyph ) ^ ( hash<int>()( k.size.x ) << 1 )
+                        ^ ( hash<int>()( k.size.y ) << 2 ) ^ ( hash<int>()( k.subscript ) << 3 )
+                        ^ ( hash<int>()( k.superscript ) << 4 );
+        }
+    };
 }
 
 
+// The caches below are shared by all the fonts, and guarded by m_freeTypeMutex like FreeType.
+
+// GLYPH_DATA is a collection of all outlines in the glyph; for example the 'o' glyph
+// generally contains 2 contours, one for the glyph outline and one for the hole
+static std::unordered_map<GLYPH_CACHE_KEY, GLYPH_DATA> s_glyphCache;
+
+// Triangulated glyphs at the origin of their text, which only have to be copied and moved to
+// their place.  So texts repeated all over a board or a schematic only build each distinct
+// glyph once.
+static std::unordered_map<GLYPH_SHAPE_KEY, std::shared_ptr<const OUTLINE_GLYPH>> s_glyphShapeCache;
+
+// Glyph shapes depend on the text size, so drop them all once too many sizes were used
+static constexpr size_t GLYPH_SHAPE_CACHE_MAX_SIZE = 32768;
+
+
 VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
                                                 std::vector<std::unique_ptr<GLYPH>>* aGlyphs,
                                                 const wxString& aText, const VECTOR2I& aSize,
@@ -296,6 +365,9 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
                                                 bool aMirror, const VECTOR2I& aOrigin,
                                                 TEXT_STYLE_FLAGS aTextStyle ) const
 {
+    if( loadFace() != 0 )
+        return aPosition;
+
     VECTOR2D glyphSize = aSize;
     FT_Face  face = m_face;
     double   scaler = faceSize();
@@ -329,10 +401,6 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
     if( aGlyphs )
         aGlyphs->reserve( glyphCount );
 
-    // GLYPH_DATA is a collection of all outlines in the glyph; for example the 'o' glyph
-    // generally contains 2 contours, one for the glyph outline and one for the hole
-    static std::unordered_map<GLYPH_CACHE_KEY, GLYPH_DATA> s_glyphCache;
-
     for( unsigned int i = 0; i < glyphCount; i++ )
     {
         // Don't process glyphs that were already included in a previous cluster
@@ -343,124 +411,40 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
         {
             GLYPH_CACHE_KEY key = { face, glyphInfo[i].codepoint, scaler, m_fakeItal, m_fakeBold,
                                     aMirror, aAngle };
-            GLYPH_DATA&     glyphData = s_glyphCache[ key ];
-
-            if( glyphData.m_Contours.empty() )
-            {
-                if( m_fakeItal )
-                {
-                    FT_Matrix matrix;
-                    // Create a 12 degree slant
-                    const float angle = (float)( -M_PI * 12.0f ) / 180.0f;
-                    matrix.xx = (FT_Fixed) ( cos( angle ) * 0x10000L );
-                    matrix.xy = (FT_Fixed) ( -sin( angle ) * 0x10000L );
-                    matrix.yx = (FT_Fixed) ( 0 * 0x10000L );  // Don't rotate in the y direction
-                    matrix.yy = (FT_Fixed) ( 1 * 0x10000L );
-
-                    FT_Set_Transform( face, &matrix, nullptr );
-                }
-
-                FT_Load_Glyph( face, glyphInfo[i].codepoint, FT_LOAD_NO_BITMAP );
+            GLYPH_SHAPE_KEY shapeKey = { key, aSize, IsSubscript( aTextStyle ),
+                                         IsSuperscript( aTextStyle ) };
 
-                if( m_fakeBold )
-                    FT_Outline_Embolden( &face->glyph->outline, 1 << 6 );
+            std::shared_ptr<const OUTLINE_GLYPH> shape;
+            auto it = s_glyphShapeCache.find( shapeKey );
 
-                OUTLINE_DECOMPOSER decomposer( face->glyph->outline );
-
-                if( !decomposer.OutlineToSegments( &glyphData.m_Contours ) )
-                {
-                    double  hb_advance = glyphPos[i].x_advance * GLYPH_SIZE_SCALER;
-                    BOX2D   tofuBox( { scaler * 0.03, 0.0 },
-                                     { hb_advance - scaler * 0.02, scaler * 0.72 } );
-
-                    glyphData.m_Contours.clear();
-
-                    CONTOUR outline;
-                    outline.m_Winding = 1;
-                    outline.m_Orientation = FT_ORIENTATION_TRUETYPE;
-                    outline.m_Points.push_back( tofuBox.GetPosition() );
-                    outline.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
-                    outline.m_Points.push_back( tofuBox.GetSize() );
-                    outline.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
-                    glyphData.m_Contours.push_back( outline );
-
-                    CONTOUR hole;
-                    tofuBox.Move( { scaler * 0.06, scaler * 0.06 } );
-                    tofuBox.SetSize( { tofuBox.GetWidth() - scaler * 0.06,
-                                       tofuBox.GetHeight() - scaler * 0.06 } );
-                    hole.m_Winding = 1;
-                    hole.m_Orientation = FT_ORIENTATION_NONE;
-                    hole.m_Points.push_back( tofuBox.GetPosition() );
-                    hole.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
-                    hole.m_Points.push_back( tofuBox.GetSize() );
-                    hole.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
-                    glyphData.m_Contours.push_back( hole );
-                }
+            if( it != s_glyphShapeCache.end() )
+            {
+                shape = it->second;
             }
-
-            std::unique_ptr<OUTLINE_GLYPH> glyph = std::make_unique<OUTLINE_GLYPH>();
-            std::vector<SHAPE_LINE_CHAIN>  holes;
-
-            for( CONTOUR& c : glyphData.m_Contours )
+            else
             {
-                std::vector<VECTOR2D> points = c.m_Points;
-                SHAPE_LINE_CHAIN      shape;
-
-                shape.ReservePoints( points.size() );
-
-                for( const VECTOR2D& v : points )
-                {
-                    VECTOR2D pt( v + cursor );
+                shape = buildGlyphShape( s_glyphCache[ key ], glyphInfo[i].codepoint,
+                                         glyphPos[i].x_advance * GLYPH_SIZE_SCALER, scaler,
+                                         scaleFactor, aAngle, aMirror, aTextStyle );
 
-                    if( IsSubscript( aTextStyle ) )
-                        pt.y += m_subscriptVerticalOffset * scaler;
-                    else if( IsSuperscript( aTextStyle ) )
-                        pt.y += m_superscriptVerticalOffset * scaler;
+                if( s_glyphShapeCache.size() >= GLYPH_SHAPE_CACHE_MAX_SIZE )
+                    s_glyphShapeCache.clear();
 
-                    pt *= scaleFactor;
-                    pt += aPosition;
-
-                    if( aMirror )
-                        pt.x = aOrigin.x - ( pt.x - aOrigin.x );
+                s_glyphShapeCache.emplace( shapeKey, shape );
+            }
 
-                    if( !aAngle.IsZero() )
-                        RotatePoint( pt, aOrigin, aAngle );
+            // The shape was built as if the cursor was at the origin of the text, so the glyph
+            // only has to be moved by where the origin of the glyph ends up
+            VECTOR2D offset( VECTOR2D( cursor ) * scaleFactor + aPosition );
 
-                    shape.Append( pt.x, pt.y );
-                }
+            if( aMirror )
+                offset.x = aOrigin.x - ( offset.x - aOrigin.x );
 
-                shape.SetClosed( true );
+            if( !aAngle.IsZero() )
+                RotatePoint( offset, aOrigin, aAngle );
 
-                if( contourIsHole( c ) )
-                    holes.push_back( std::move( shape ) );
-                else
-                    glyph->AddOutline( std::move( shape ) );
-            }
-
-            for( SHAPE_LINE_CHAIN& hole : holes )
-            {
-                if( hole.PointCount() )
-                {
-                    for( int ii = 0; ii < glyph->OutlineCount(); ++ii )
-                    {
-                        if( glyph->Outline( ii ).PointInside( hole.GetPoint( 0 ) ) )
-                        {
-                            glyph->AddHole( std::move( hole ), ii );
-                            break;
-                        }
-                    }
-                }
-            }
-
-            if( glyphData.m_TriangulationData.empty() )
-            {
-                glyph->CacheTriangulation( false, false );
-                glyphData.m_TriangulationData = glyph->GetTriangulationData();
-            }
-            else
-            {
-                glyph->CacheTriangulation( glyphData.m_TriangulationData );
-            }
+            std::unique_ptr<OUTLINE_GLYPH> glyph = std::make_unique<OUTLINE_GLYPH>( *shape );
+            glyph->Move( VECTOR2I( KiROUND( offset.x ), KiROUND( offset.y ) ) );
 
             aGlyphs->push_back( std::move( glyph ) );
         }
@@ -486,6 +470,132 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
 }
 
 
+std::shared_ptr<const OUTLINE_GLYPH>
+OUTLINE_FONT::buildGlyphShape( GLYPH_DATA& aGlyphData, unsigned int aCodepoint,
+                               double aAdvance, double aScaler,
+                               const VECTOR2D& aScaleFactor, const EDA_ANGLE& aAngle,
+                               bool aMirror, TEXT_STYLE_FLAGS aTextStyle ) const
+{
+    FT_Face face = m_face;
+
+    if( aGlyphData.m_Contours.empty() )
+    {
+        if( m_fakeItal )
+        {
+            FT_Matrix matrix;
+            // Create a 12 degree slant
+            const float angle = (float)( -M_PI * 12.0f ) / 180.0f;
+            matrix.xx = (FT_Fixed) ( cos( angle ) * 0x10000L );
+            matrix.xy = (FT_Fixed) ( -sin( angle ) * 0x10000L );
+            matrix.yx = (FT_Fixed) ( 0 * 0x10000L );  // Don't rotate in the y direction
+            matrix.yy = (FT_Fixed) ( 1 * 0x10000L );
+
+            FT_Set_Transform( face, &matrix, nullptr );
+        }
+
+        FT_Load_Glyph( face, aCodepoint, FT_LOAD_NO_BITMAP );
+
+        if( m_fakeBold )
+            FT_Outline_Embolden( &face->glyph->outline, 1 << 6 );
+
+        OUTLINE_DECOMPOSER decomposer( face->glyph->outline );
+
+        if( !decomposer.OutlineToSegments( &aGlyphData.m_Contours ) )
+        {
+            BOX2D tofuBox( { aScaler * 0.03, 0.0 }, { aAdvance - aScaler * 0.02, aScaler * 0.72 } );
+
+            aGlyphData.m_Contours.clear();
+
+            CONTOUR outline;
+            outline.m_Winding = 1;
+            outline.m_Orientation = FT_ORIENTATION_TRUETYPE;
+            outline.m_Points.push_back( tofuBox.GetPosition() );
+            outline.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
+            outline.m_Points.push_back( tofuBox.GetSize() );
+            outline.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
+            aGlyphData.m_Contours.push_back( outline );
+
+            CONTOUR hole;
+            tofuBox.Move( { aScaler * 0.06, aScaler * 0.06 } );
+            tofuBox.SetSize( { tofuBox.GetWidth() - aScaler * 0.06,
+                               tofuBox.GetHeight() - aScaler * 0.06 } );
+            hole.m_Winding = 1;
+            hole.m_Orientation = FT_ORIENTATION_NONE;
+            hole.m_Points.push_back( tofuBox.GetPosition() );
+            hole.m_Points.push_back( { tofuBox.GetSize().x, tofuBox.GetPosition().y } );
+            hole.m_Points.push_back( tofuBox.GetSize() );
+            hole.m_Points.push_back( { tofuBox.GetPosition().x, tofuBox.GetSize().y } );
+            aGlyphData.m_Contours.push_back( hole );
+        }
+    }
+
+    std::shared_ptr<OUTLINE_GLYPH> glyph = std::make_shared<OUTLINE_GLYPH>();
+    std::vector<SHAPE_LINE_CHAIN>  holes;
+
+    for( CONTOUR& c : aGlyphData.m_Contours )
+    {
+        std::vector<VECTOR2D> points = c.m_Points;
+        SHAPE_LINE_CHAIN      shape;
+
+        shape.ReservePoints( points.size() );
+
+        for( const VECTOR2D& v : points )
+        {
+            VECTOR2D pt( v );
+
+            if( IsSubscript( aTextStyle ) )
+                pt.y += m_subscriptVerticalOffset * aScaler;
+            else if( IsSuperscript( aTextStyle ) )
+                pt.y += m_superscriptVerticalOffset * aScaler;
+
+            pt *= aScaleFactor;
+
+            if( aMirror )
+                pt.x = -pt.x;
+
+            if( !aAngle.IsZero() )
+                RotatePoint( pt, aAngle );
+
+            shape.Append( pt.x, pt.y );
+        }
+
+        shape.SetClosed( true );
+
+        if( contourIsHole( c ) )
+            holes.push_back( std::move( shape ) );
+        else
+            glyph->AddOutline( std::move( shape ) );
+    }
+
+    for( SHAPE_LINE_CHAIN& hole : holes )
+    {
+        if( hole.PointCount() )
+        {
+            for( int ii = 0; ii < glyph->OutlineCount(); ++ii )
+            {
+                if( glyph->Outline( ii ).PointInside( hole.GetPoint( 0 ) ) )
+                {
+                    glyph->AddHole( std::move( hole ), ii );
+                    break;
+                }
+            }
+        }
+    }
+
+    if( aGlyphData.m_TriangulationData.empty() )
+    {
+        glyph->CacheTriangulation( false, false );
+        aGlyphData.m_TriangulationData = glyph->GetTriangulationData();
+    }
+    else
+    {
+        glyph->CacheTriangulation( aGlyphData.m_TriangulationData );
+    }
+
+    return glyph;
+}
+
+
 #undef OUTLINEFONT_RENDER_AS_PIXELS
 #ifdef OUTLINEFONT_RENDER_AS_PIXELS
 /*
@@ -173,6 +173,7 @@ void STROKE_FONT::loadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
             }
 
             glyph->Finalize();
+            glyph->SetIsFontGlyph();
 
             // Compute the bounding box of the glyph
             buildGlyphBoundingBox( glyph, glyphWidth );
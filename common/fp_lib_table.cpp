@@ -24,7 +24,9 @@
  */
 
 
+#include <advanced_config.h>
 #include <kiface_base.h>
+#include <core/thread_pool.h>
 #include <env_vars.h>
 #include <footprint_info.h>
 #include <lib_id.h>
@@ -273,11 +275,46 @@ long long FP_LIB_TABLE::GenerateTimestamp( const wxString* aNickname )
 
         wxCHECK( row && row->plugin, hash );
 
-        return row->plugin->GetLibraryTimestamp( row->GetFullURI( true ) ) +
-                wxHashTable::MakeKey( *aNickname );
+        std::map<wxString, long long> timestamps = GenerateTimestamps( { *aNickname } );
+
+        // Not caught by GenerateTimestamps(), so the caller sees the error
+        if( !timestamps.count( *aNickname ) )
+        {
+            return row->plugin->GetLibraryTimestamp( row->GetFullURI( true ) ) +
+                    wxHashTable::MakeKey( *aNickname );
+        }
+
+        return timestamps[*aNickname];
     }
 
-    for( const wxString& nickname : GetLogicalLibs() )
+    for( const auto& [nickname, timestamp] : GenerateTimestamps( GetLogicalLibs() ) )
+        hash += timestamp;
+
+    return hash;
+}
+
+
+std::map<wxString, long long>
+FP_LIB_TABLE::GenerateTimestamps( const std::vector<wxString>& aNicknames )
+{
+    struct LIBRARY
+    {
+        wxString                nickname;
+        const FP_LIB_TABLE_ROW* row;
+        wxString                uri;
+        long long               timestamp = 0;
+        bool                    valid = false;
+    };
+
+    using CLOCK = std::chrono::steady_clock;
+
+    std::vector<LIBRARY>      libs;
+    std::vector<size_t>       toStat;
+    CLOCK::time_point         now = CLOCK::now();
+    std::chrono::milliseconds lifetime( ADVANCED_CFG::GetCfg().m_LibraryTimestampCacheMs );
+
+    // Find the rows first: that may instantiate their plugins, which isn't thread safe
+    for( const wxString& nickname : aNicknames )
     {
         const FP_LIB_TABLE_ROW* row = nullptr;
 
@@ -292,11 +329,71 @@ long long FP_LIB_TABLE::GenerateTimestamp( const wxString* aNickname )
 
         wxCHECK2( row && row->plugin, continue );
 
-        hash += row->plugin->GetLibraryTimestamp( row->GetFullURI( true ) ) +
-                wxHashTable::MakeKey( nickname );
+        libs.push_back( { nickname, row, row->GetFullURI( true ) } );
     }
 
-    return hash;
+    {
+        std::lock_guard<std::mutex> lock( m_timestampsMutex );
+
+        for( size_t ii = 0; ii < libs.size(); ++ii )
+        {
+            auto it = m_timestamps.find( libs[ii].nickname );
+
+            if( it != m_timestamps.end() && it->second.m_uri == libs[ii].uri
+                    && now - it->second.m_time < lifetime )
+            {
+                libs[ii].timestamp = it->second.m_timestamp;
+                libs[ii].valid = true;
+            }
+            else
+            {
+                toStat.push_back( ii );
+            }
+        }
+    }
+
+    // Libraries on network file systems can take a long time each to stat
+    ParallelForEachIndex( toStat.size(),
+            [&]( size_t ii )
+            {
+                LIBRARY& lib = libs[toStat[ii]];
+
+                try
+                {
+                    lib.timestamp = lib.row->plugin->GetLibraryTimestamp( lib.uri )
+                                    + wxHashTable::MakeKey( lib.nickname );
+                    lib.valid = true;
+                }
+                catch( ... )
+                {
+                    // Skip libraries which can't be read, as for ones which can't be found.
+                }
+            } );
+
+    std::map<wxString, long long> timestamps;
+    std::lock_guard<std::mutex>   lock( m_timestampsMutex );
+
+    for( const LIBRARY& lib : libs )
+    {
+        if( lib.valid )
+            timestamps[lib.nickname] = lib.timestamp;
+    }
+
+    for( size_t ii : toStat )
+    {
+        if( libs[ii].valid && lifetime.count() > 0 )
+            m_timestamps[libs[ii].nickname] = { libs[ii].uri, libs[ii].timestamp, now };
+    }
+
+    return timestamps;
+}
+
+
+void FP_LIB_TABLE::invalidateTimestamp( const wxString& aNickname )
+{
+    std::lock_guard<std::mutex> lock( m_timestampsMutex );
+
+    m_timestamps.erase( aNickname );
 }
 
 
@@ -431,6 +528,7 @@ FP_LIB_TABLE::SAVE_T FP_LIB_TABLE::FootprintSave( const wxString& aNickname,
             return SAVE_SKIPPED;
     }
 
+    invalidateTimestamp( aNickname );
     row->plugin->FootprintSave( row->GetFullURI( true ), aFootprint, row->GetProperties() );
 
     return SAVE_OK;
@@ -441,6 +539,7 @@ void FP_LIB_TABLE::FootprintDelete( const wxString& aNickname, const wxString& a
 {
     const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
     wxASSERT( row->plugin );
+    invalidateTimestamp( aNickname );
     return row->plugin->FootprintDelete( row->GetFullURI( true ), aFootprintName,
                                          row->GetProperties() );
 }
@@ -458,6 +557,7 @@ void FP_LIB_TABLE::FootprintLibDelete( const wxString& aNickname )
 {
     const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
     wxASSERT( row->plugin );
+    invalidateTimestamp( aNickname );
     row->plugin->DeleteLibrary( row->GetFullURI( true ), row->GetProperties() );
 }
 
@@ -466,6 +566,7 @@ void FP_LIB_TABLE::FootprintLibCreate( const wxString& aNickname )
 {
     const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
     wxASSERT( row->plugin );
+    invalidateTimestamp( aNickname );
     row->plugin->CreateLibrary( row->GetFullURI( true ), row->GetProperties() );
 }
 
@@ -37,7 +37,9 @@
 #include <math/vector2wx.h>
 #include <math/util.h> // for KiROUND
 #include <trigo.h>
+#include <advanced_config.h>
 #include <bitmap_base.h>
+#include <core/thread_pool.h>
 
 #include <algorithm>
 #include <cmath>
@@ -55,6 +57,7 @@ CAIRO_GAL_BASE::CAIRO_GAL_BASE( GAL_DISPLAY_OPTIONS& aDisplayOptions ) : GAL( aD
     m_isElementAdded = false;
     m_groupCounter = 0;
     m_currentGroup = nullptr;
+    m_isBatchingGroups = false;
 
     m_lineWidth = 1.0;
     m_lineWidthInPixels = 1.0;
@@ -829,58 +832,81 @@ void CAIRO_GAL_BASE::EndGroup()
 
 
 void CAIRO_GAL_BASE::DrawGroup( int aGroupNumber )
+{
+    if( m_isBatchingGroups )
+    {
+        m_groupBatch.push_back( aGroupNumber );
+        return;
+    }
+
+    storePath();
+
+    GROUP_STATE state = { m_isFillEnabled, m_isStrokeEnabled, m_fillColor, m_strokeColor };
+
+    drawGroup( m_currentContext, aGroupNumber, state );
+
+    m_isFillEnabled = state.m_IsFillEnabled;
+    m_isStrokeEnabled = state.m_IsStrokeEnabled;
+    m_fillColor = state.m_FillColor;
+    m_strokeColor = state.m_StrokeColor;
+}
+
+
+void CAIRO_GAL_BASE::drawGroup( cairo_t* aContext, int aGroupNumber, GROUP_STATE& aState ) const
 {
     // This method implements a small Virtual Machine - all stored commands
     // are executed; nested calling is also possible
 
-    storePath();
+    auto group = m_groups.find( aGroupNumber );
 
-    for( auto it = m_groups[aGroupNumber].begin(); it != m_groups[aGroupNumber].end(); ++it )
+    if( group == m_groups.end() )
+        return;
+
+    for( auto it = group->second.begin(); it != group->second.end(); ++it )
     {
         switch( it->m_Command )
         {
         case CMD_SET_FILL:
-            m_isFillEnabled = it->m_Argument.BoolArg;
+            aState.m_IsFillEnabled = it->m_Argument.BoolArg;
             break;
 
         case CMD_SET_STROKE:
-            m_isStrokeEnabled = it->m_Argument.BoolArg;
+            aState.m_IsStrokeEnabled = it->m_Argument.BoolArg;
             break;
 
         case CMD_SET_FILLCOLOR:
-            m_fillColor = COLOR4D( it->m_Argument.DblArg[0], it->m_Argument.DblArg[1],
-                                   it->m_Argument.DblArg[2], it->m_Argument.DblArg[3] );
+            aState.m_FillColor = COLOR4D( it->m_Argument.DblArg[0], it->m_Argument.DblArg[1],
+                                          it->m_Argument.DblArg[2], it->m_Argument.DblArg[3] );
             break;
 
         case CMD_SET_STROKECOLOR:
-            m_strokeColor = COLOR4D( it->m_Argument.DblArg[0], it->m_Argument.DblArg[1],
-                                     it->m_Argument.DblArg[2], it->m_Argument.DblArg[3] );
+            aState.m_StrokeColor = COLOR4D( it->m_Argument.DblArg[0], it->m_Argument.DblArg[1],
+                                            it->m_Argument.DblArg[2], it->m_Argument.DblArg[3] );
             break;
 
         case CMD_SET_LINE_WIDTH:
         {
             // Make lines appear at least 1 pixel wide, no matter of zoom
             double x = 1.0, y = 1.0;
-            cairo_device_to_user_distance( m_currentContext, &x, &y );
+            cairo_device_to_user_distance( aContext, &x, &y );
             double minWidth = std::min( fabs( x ), fabs( y ) );
-            cairo_set_line_width( m_currentContext,
-                                  std::max( it->m_Argument.DblArg[0], minWidth ) );
+            cairo_set_line_width( aContext, std::max( it->m_Argument.DblArg[0], minWidth ) );
             break;
         }
 
 
         case CMD_STROKE_PATH:
-            cairo_set_source_rgba( m_currentContext, m_strokeColor.r, m_strokeColor.g,
-                                   m_strokeColor.b, m_strokeColor.a );
-            cairo_append_path( m_currentContext, it->m_CairoPath );
-            cairo_stroke( m_currentContext );
+            cairo_set_source_rgba( aContext, aState.m_StrokeColor.r, aState.m_StrokeColor.g,
+                                   aState.m_StrokeColor.b, aState.m_StrokeColor.a );
+            cairo_append_path( aContext, it->m_CairoPath );
+            cairo_stroke( aContext );
             break;
 
         case CMD_FILL_PATH:
-            cairo_set_source_rgba( m_currentContext, m_fillColor.r, m_fillColor.g, m_fillColor.b,
-                                   m_strokeColor.a );
-            cairo_append_path( m_currentContext, it->m_CairoPath );
-            cairo_fill( m_currentContext );
+            cairo_set_source_rgba( aContext, aState.m_FillColor.r, aState.m_FillColor.g,
+                                   aState.m_FillColor.b, aState.m_StrokeColor.a );
+            cairo_append_path( aContext, it->m_CairoPath );
+            cairo_fill( aContext );
             break;
 
             /*
@@ -889,38 +915,172 @@ void CAIRO_GAL_BASE::DrawGroup( int aGroupNumber )
             cairo_matrix_init( &matrix, it->argument.DblArg[0], it->argument.DblArg[1],
                                it->argument.DblArg[2], it->argument.DblArg[3],
                                it->argument.DblArg[4], it->argument.DblArg[5] );
-            cairo_transform( m_currentContext, &matrix );
+            cairo_transform( aContext, &matrix );
             break;
             */
 
         case CMD_ROTATE:
-            cairo_rotate( m_currentContext, it->m_Argument.DblArg[0] );
+            cairo_rotate( aContext, it->m_Argument.DblArg[0] );
             break;
 
         case CMD_TRANSLATE:
-            cairo_translate( m_currentContext, it->m_Argument.DblArg[0], it->m_Argument.DblArg[1] );
+            cairo_translate( aContext, it->m_Argument.DblArg[0], it->m_Argument.DblArg[1] );
             break;
 
         case CMD_SCALE:
-            cairo_scale( m_currentContext, it->m_Argument.DblArg[0], it->m_Argument.DblArg[1] );
+            cairo_scale( aContext, it->m_Argument.DblArg[0], it->m_Argument.DblArg[1] );
             break;
 
         case CMD_SAVE:
-            cairo_save( m_currentContext );
+            cairo_save( aContext );
             break;
 
         case CMD_RESTORE:
-            cairo_restore( m_currentContext );
+            cairo_restore( aContext );
             break;
 
         case CMD_CALL_GROUP:
-            DrawGroup( it->m_Argument.IntArg );
+            drawGroup( aContext, it->m_Argument.IntArg, aState );
             break;
         }
     }
 }
 
 
+void CAIRO_GAL_BASE::BeginGroupBatch()
+{
+    if( !ADVANCED_CFG::GetCfg().m_CairoTiledRendering || m_isGrouping || !m_currentContext )
+        return;
+
+    storePath();
+    m_isBatchingGroups = true;
+}
+
+
+void CAIRO_GAL_BASE::EndGroupBatch()
+{
+    if( !m_isBatchingGroups )
+        return;
+
+    m_isBatchingGroups = false;
+
+    if( !drawGroupBatchTiled() )
+    {
+        for( int group : m_groupBatch )
+            DrawGroup( group );
+    }
+
+    m_groupBatch.clear();
+}
+
+
+bool CAIRO_GAL_BASE::drawGroupBatchTiled()
+{
+    // A few groups are quicker to draw than to hand out to the threads
+    static const size_t MIN_TILED_BATCH = 64;
+
+    // No band is made shorter than this, or the groups crossing several bands are mostly
+    // rasterized several times for nothing
+    static const int MIN_TILE_HEIGHT = 64;
+
+    cairo_surface_t* target = cairo_get_target( m_currentContext );
+
+    // Only plain image surfaces can be split in tiles; the printing surfaces and the pushed
+    // groups are drawn as they have always been
+    if( m_groupBatch.size() < MIN_TILED_BATCH
+            || cairo_get_group_target( m_currentContext ) != target
+            || cairo_surface_get_type( target ) != CAIRO_SURFACE_TYPE_IMAGE
+            || cairo_image_surface_get_format( target ) != GAL_FORMAT )
+    {
+        return false;
+    }
+
+    int width = cairo_image_surface_get_width( target );
+    int height = cairo_image_surface_get_height( target );
+    int stride = cairo_image_surface_get_stride( target );
+    int threads = std::max<int>( 1, GetKiCadThreadPool().get_thread_count() );
+    int tileCount = std::min( threads, height / MIN_TILE_HEIGHT );
+
+    if( tileCount < 2 )
+        return false;
+
+    storePath();
+    cairo_surface_flush( target );
+
+    unsigned char* data = cairo_image_surface_get_data( target );
+    int            tileHeight = ( height + tileCount - 1 ) / tileCount;
+
+    cairo_matrix_t matrix;
+    cairo_get_matrix( m_currentContext, &matrix );
+
+    std::vector<GROUP_STATE> states( tileCount, { m_isFillEnabled, m_isStrokeEnabled, m_fillColor,
+                                                  m_strokeColor } );
+    cairo_antialias_t        antialias = cairo_get_antialias( m_currentContext );
+    cairo_operator_t         op = cairo_get_operator( m_currentContext );
+    double                   lineWidth = cairo_get_line_width( m_currentContext );
+    cairo_line_cap_t         lineCap = cairo_get_line_cap( m_currentContext );
+    cairo_line_join_t        lineJoin = cairo_get_line_join( m_currentContext );
+    cairo_fill_rule_t        fillRule = cairo_get_fill_rule( m_currentContext );
+    double                   tolerance = cairo_get_tolerance( m_currentContext );
+    cairo_matrix_t           finalMatrix = matrix;
+    double                   finalLineWidth = lineWidth;
+
+    // Each tile is a band of the target's own pixels, drawn through a context of its own with
+    // the state of the main context, so the tiles don't need to be composited afterwards
+    ParallelForEachIndex( tileCount,
+            [&]( size_t aTile )
+            {
+                int y0 = (int) aTile * tileHeight;
+                int h = std::min( tileHeight, height - y0 );
+
+                if( h <= 0 )
+                    return;
+
+                cairo_surface_t* surface = cairo_image_surface_create_for_data(
+                        data + (size_t) y0 * stride, GAL_FORMAT, width, h, stride );
+                cairo_t*         context = cairo_create( surface );
+
+                cairo_matrix_t tileMatrix;
+                cairo_matrix_init_translate( &tileMatrix, 0.0, -y0 );
+                cairo_matrix_multiply( &tileMatrix, &matrix, &tileMatrix );
+                cairo_set_matrix( context, &tileMatrix );
+
+                cairo_set_antialias( context, antialias );
+                cairo_set_operator( context, op );
+                cairo_set_line_width( context, lineWidth );
+                cairo_set_line_cap( context, lineCap );
+                cairo_set_line_join( context, lineJoin );
+                cairo_set_fill_rule( context, fillRule );
+                cairo_set_tolerance( context, tolerance );
+
+                for( int group : m_groupBatch )
+                    drawGroup( context, group, states[aTile] );
+
+                // The first band isn't translated, so its matrix is the one of the main context
+                if( aTile == 0 )
+                {
+                    cairo_get_matrix( context, &finalMatrix );
+                    finalLineWidth = cairo_get_line_width( context );
+                }
+
+                cairo_destroy( context );
+                cairo_surface_destroy( surface );
+            } );
+
+    cairo_surface_mark_dirty( target );
+
+    cairo_set_matrix( m_currentContext, &finalMatrix );
+    cairo_set_line_width( m_currentContext, finalLineWidth );
+
+    m_isFillEnabled = states[0].m_IsFillEnabled;
+    m_isStrokeEnabled = states[0].m_IsStrokeEnabled;
+    m_fillColor = states[0].m_FillColor;
+    m_strokeColor = states[0].m_StrokeColor;
+
+    return true;
+}
+
+
 void CAIRO_GAL_BASE::ChangeGroupColor( int aGroupNumber, const COLOR4D& aNewColor )
 {
     storePath();
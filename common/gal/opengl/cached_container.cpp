@@ -59,7 +59,14 @@ CACHED_CONTAINER::CACHED_CONTAINER( unsigned int aSize ) :
         m_maxIndex( 0 )
 {
     // In the beginning there is only free space
-    m_freeChunks.insert( std::make_pair( aSize, 0 ) );
+    resetFreeChunks( 0, aSize );
+
+    m_memoryAccount = std::make_unique<MEMORY_ACCOUNT>(
+            [this]( MEMORY_REPORT& aReport )
+            {
+                aReport.Add( MEMORY_CATEGORY::VERTEX_BUFFERS,
+                             static_cast<size_t>( m_currentSize ) * VERTEX_SIZE );
+            } );
 }
 
 
@@ -90,7 +97,6 @@ void CACHED_CONTAINER::FinishItem()
 
         // Add the not used memory back to the pool
         addFreeChunk( itemOffset + itemSize, m_chunkSize - itemSize );
-        // mergeFreeChunks();   // veery slow and buggy
 
         m_maxIndex = std::max( itemOffset + itemSize, m_maxIndex );
     }
@@ -204,8 +210,7 @@ void CACHED_CONTAINER::Clear()
     m_items.clear();
 
     // Now there is only free space left
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, 0 ) );
+    resetFreeChunks( 0, m_freeSpace );
 }
 
 
@@ -217,13 +222,15 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
     unsigned int itemSize = m_item->GetSize();
 
     // Find a free space chunk >= aSize
-    FREE_CHUNK_MAP::iterator newChunk = m_freeChunks.lower_bound( aSize );
+    FREE_CHUNK_MAP::iterator newChunk = m_freeChunks.lower_bound( CHUNK( aSize, 0 ) );
 
     // Is there enough space to store vertices?
     if( newChunk == m_freeChunks.end() )
     {
         bool result;
 
+        m_defragmentCount++;
+
         // Would it be enough to double the current space?
         if( aSize < m_freeSpace + m_currentSize )
         {
@@ -239,7 +246,7 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
         if( !result )
             return false;
 
-        newChunk = m_freeChunks.lower_bound( aSize );
+        newChunk = m_freeChunks.lower_bound( CHUNK( aSize, 0 ) );
         assert( newChunk != m_freeChunks.end() );
     }
 
@@ -250,19 +257,20 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
     assert( newChunkSize >= aSize );
     assert( newChunkOffset < m_currentSize );
 
+    // Remove the new allocated chunk from the free space pool.  This has to come first, as the
+    // previous chunk may be merged with it when freed.
+    removeFreeChunk( newChunk );
+
     // Check if the item was previously stored in the container
     if( itemSize > 0 )
     {
         // The item was reallocated, so we have to copy all the old data to the new place
         memcpy( &m_vertices[newChunkOffset], &m_vertices[m_chunkOffset], itemSize * VERTEX_SIZE );
-
-        // Free the space used by the previous chunk
-        addFreeChunk( m_chunkOffset, m_chunkSize );
     }
 
-    // Remove the new allocated chunk from the free space pool
-    m_freeChunks.erase( newChunk );
-    m_freeSpace -= newChunkSize;
+    // Free the space used by the previous chunk
+    if( m_chunkSize > 0 )
+        addFreeChunk( m_chunkOffset, m_chunkSize );
 
     m_chunkSize = newChunkSize;
     m_chunkOffset = newChunkOffset;
@@ -334,67 +342,61 @@ void CACHED_CONTAINER::defragment( VERTEX* aTarget )
 }
 
 
-void CACHED_CONTAINER::mergeFreeChunks()
+void CACHED_CONTAINER::addFreeChunk( unsigned int aOffset, unsigned int aSize )
 {
-    if( m_freeChunks.size() <= 1 ) // There are no chunks that can be merged
-        return;
-
-#ifdef KICAD_GAL_PROFILE
-    PROF_TIMER totalTime;
-#endif /* KICAD_GAL_PROFILE */
+    assert( aOffset + aSize <= m_currentSize );
+    assert( aSize > 0 );
 
-    // Reversed free chunks map - this one stores chunk size with its offset as the key
-    std::list<CHUNK> freeChunks;
+    m_freeSpace += aSize;
 
-    FREE_CHUNK_MAP::const_iterator it, it_end;
+    // Merge the chunk with its free neighbours.  Otherwise the free space breaks up into
+    // pieces too small for the items being redrawn, e.g. while dragging, and every item which
+    // doesn't fit makes the whole container be defragmented and grown.
+    auto next = m_freeChunkOffsets.lower_bound( aOffset );
 
-    for( it = m_freeChunks.begin(), it_end = m_freeChunks.end(); it != it_end; ++it )
+    if( next != m_freeChunkOffsets.end() && next->first == aOffset + aSize )
     {
-        freeChunks.emplace_back( it->second, it->first );
+        aSize += next->second;
+        m_freeChunks.erase( CHUNK( next->second, next->first ) );
+        next = m_freeChunkOffsets.erase( next );
     }
 
-    m_freeChunks.clear();
-    freeChunks.sort();
-
-    std::list<CHUNK>::const_iterator itf, itf_end;
-    unsigned int                     offset = freeChunks.front().first;
-    unsigned int                     size = freeChunks.front().second;
-    freeChunks.pop_front();
-
-    for( itf = freeChunks.begin(), itf_end = freeChunks.end(); itf != itf_end; ++itf )
+    if( next != m_freeChunkOffsets.begin() )
     {
-        if( itf->first == offset + size )
-        {
-            // These chunks can be merged, so just increase the current chunk size and go on
-            size += itf->second;
-        }
-        else
+        auto prev = std::prev( next );
+
+        if( prev->first + prev->second == aOffset )
         {
-            // These chunks cannot be merged
-            // So store the previous one
-            m_freeChunks.insert( std::make_pair( size, offset ) );
-            // and let's check the next chunk
-            offset = itf->first;
-            size = itf->second;
+            aOffset = prev->first;
+            aSize += prev->second;
+            m_freeChunks.erase( CHUNK( prev->second, prev->first ) );
+            m_freeChunkOffsets.erase( prev );
         }
     }
 
-    // Add the last one
-    m_freeChunks.insert( std::make_pair( size, offset ) );
+    m_freeChunks.insert( CHUNK( aSize, aOffset ) );
+    m_freeChunkOffsets[aOffset] = aSize;
+}
 
-#if CACHED_CONTAINER_TEST > 0
-    test();
-#endif
+
+void CACHED_CONTAINER::removeFreeChunk( FREE_CHUNK_MAP::iterator aChunk )
+{
+    m_freeSpace -= getChunkSize( *aChunk );
+    m_freeChunkOffsets.erase( getChunkOffset( *aChunk ) );
+    m_freeChunks.erase( aChunk );
 }
 
 
-void CACHED_CONTAINER::addFreeChunk( unsigned int aOffset, unsigned int aSize )
+void CACHED_CONTAINER::resetFreeChunks( unsigned int aOffset, unsigned int aSize )
 {
-    assert( aOffset + aSize <= m_currentSize );
-    assert( aSize > 0 );
+    m_freeChunks.clear();
+    m_freeChunkOffsets.clear();
 
-    m_freeChunks.insert( std::make_pair( aSize, aOffset ) );
-    m_freeSpace += aSize;
+    if( aSize > 0 )
+    {
+        m_freeChunks.insert( CHUNK( aSize, aOffset ) );
+        m_freeChunkOffsets[aOffset] = aSize;
+    }
 }
 
 
@@ -223,8 +223,7 @@ bool CACHED_CONTAINER_GPU::defragmentResize( unsigned int aNewSize )
     KI_TRACE( traceGalProfile, "VBO size %d used %d\n", m_currentSize, AllItemsSize() );
 
     // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+    resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
 
     return true;
 }
@@ -290,8 +289,7 @@ bool CACHED_CONTAINER_GPU::defragmentResizeMemcpy( unsigned int aNewSize )
     KI_TRACE( traceGalProfile, "VBO size %d used: %d \n", m_currentSize, AllItemsSize() );
 
     // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+    resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
 
     return true;
 }
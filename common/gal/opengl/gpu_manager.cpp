@@ -59,6 +59,7 @@ GPU_MANAGER::GPU_MANAGER( VERTEX_CONTAINER* aContainer ) :
         m_container( aContainer ),
         m_shader( nullptr ),
         m_shaderAttrib( 0 ),
+        m_colorSlotAttrib( -1 ),
         m_enableDepthTest( true )
 {
 }
@@ -73,6 +74,7 @@ void GPU_MANAGER::SetShader( SHADER& aShader )
 {
     m_shader = &aShader;
     m_shaderAttrib = m_shader->GetAttribute( "a_shaderParams" );
+    m_colorSlotAttrib = m_shader->GetAttribute( "a_colorSlot" );
 
     if( m_shaderAttrib == -1 )
     {
@@ -170,6 +172,13 @@ void GPU_CACHED_MANAGER::EndDrawing()
         glEnableVertexAttribArray( m_shaderAttrib );
         glVertexAttribPointer( m_shaderAttrib, SHADER_STRIDE, GL_FLOAT, GL_FALSE, VERTEX_SIZE,
                                (GLvoid*) SHADER_OFFSET );
+
+        if( m_colorSlotAttrib != -1 )
+        {
+            glEnableVertexAttribArray( m_colorSlotAttrib );
+            glVertexAttribPointer( m_colorSlotAttrib, 1, GL_FLOAT, GL_FALSE, VERTEX_SIZE,
+                                   (GLvoid*) COLOR_SLOT_OFFSET );
+        }
     }
 
     PROF_TIMER cntDraw( "gl-draw-elements" );
@@ -233,6 +242,10 @@ void GPU_CACHED_MANAGER::EndDrawing()
     if( m_shader != nullptr )
     {
         glDisableVertexAttribArray( m_shaderAttrib );
+
+        if( m_colorSlotAttrib != -1 )
+            glDisableVertexAttribArray( m_colorSlotAttrib );
+
         m_shader->Deactivate();
     }
 
@@ -302,6 +315,14 @@ void GPU_NONCACHED_MANAGER::EndDrawing()
         glEnableVertexAttribArray( m_shaderAttrib );
         glVertexAttribPointer( m_shaderAttrib, SHADER_STRIDE, GL_FLOAT, GL_FALSE, VERTEX_SIZE,
                                shaders );
+
+        if( m_colorSlotAttrib != -1 )
+        {
+            GLfloat* slots = (GLfloat*) ( vertices ) + COLOR_SLOT_OFFSET / sizeof( GLfloat );
+
+            glEnableVertexAttribArray( m_colorSlotAttrib );
+            glVertexAttribPointer( m_colorSlotAttrib, 1, GL_FLOAT, GL_FALSE, VERTEX_SIZE, slots );
+        }
     }
 
     glDrawArrays( GL_TRIANGLES, 0, m_container->GetSize() );
@@ -317,6 +338,10 @@ void GPU_NONCACHED_MANAGER::EndDrawing()
     if( m_shader != nullptr )
     {
         glDisableVertexAttribArray( m_shaderAttrib );
+
+        if( m_colorSlotAttrib != -1 )
+            glDisableVertexAttribArray( m_colorSlotAttrib );
+
         m_shader->Deactivate();
     }
 
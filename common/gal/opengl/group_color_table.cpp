@@ -0,0 +1,141 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gal/opengl/group_color_table.h>
+
+#include <algorithm>
+
+using namespace KIGFX;
+
+
+// Rows of a new table; it doubles in height when it is full
+static constexpr int INITIAL_HEIGHT = 16;
+
+
+GROUP_COLOR_TABLE::GROUP_COLOR_TABLE()
+{
+    Clear();
+}
+
+
+unsigned int GROUP_COLOR_TABLE::Allocate()
+{
+    if( !m_freeSlots.empty() )
+    {
+        unsigned int slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+
+    if( m_nextSlot >= (unsigned int) ( WIDTH * m_height ) )
+    {
+        if( m_height >= MAX_HEIGHT )
+            return 0;
+
+        m_height = std::min( 2 * m_height, MAX_HEIGHT );
+        m_pixels.resize( (size_t) WIDTH * m_height * 4, 0 );
+        MarkAllDirty();
+    }
+
+    return m_nextSlot++;
+}
+
+
+void GROUP_COLOR_TABLE::Free( unsigned int aSlot )
+{
+    if( aSlot == 0 || aSlot >= m_nextSlot )
+        return;
+
+    setTexel( aSlot, 0, 0, 0, 0 );
+    m_freeSlots.push_back( aSlot );
+}
+
+
+void GROUP_COLOR_TABLE::SetColor( unsigned int aSlot, const COLOR4D& aColor )
+{
+    if( aSlot == 0 || aSlot >= m_nextSlot )
+        return;
+
+    unsigned char r = aColor.r * 255.0;
+    unsigned char g = aColor.g * 255.0;
+    unsigned char b = aColor.b * 255.0;
+    unsigned char a = aColor.a * 255.0;
+
+    // An empty texel stands for the vertex colors; a fully transparent black draws nothing
+    // whatever its red component is
+    if( r == 0 && g == 0 && b == 0 && a == 0 )
+        r = 1;
+
+    setTexel( aSlot, r, g, b, a );
+}
+
+
+void GROUP_COLOR_TABLE::Clear()
+{
+    m_height = INITIAL_HEIGHT;
+    m_pixels.assign( (size_t) WIDTH * m_height * 4, 0 );
+    m_freeSlots.clear();
+    m_nextSlot = 1;
+    MarkAllDirty();
+}
+
+
+bool GROUP_COLOR_TABLE::GetDirtyRows( int& aFirst, int& aLast ) const
+{
+    if( m_dirtyLast < m_dirtyFirst )
+        return false;
+
+    aFirst = m_dirtyFirst;
+    aLast = m_dirtyLast;
+    return true;
+}
+
+
+void GROUP_COLOR_TABLE::ClearDirtyRows()
+{
+    m_dirtyFirst = m_height;
+    m_dirtyLast = -1;
+}
+
+
+void GROUP_COLOR_TABLE::MarkAllDirty()
+{
+    m_dirtyFirst = 0;
+    m_dirtyLast = m_height - 1;
+}
+
+
+void GROUP_COLOR_TABLE::setTexel( unsigned int aSlot, unsigned char aR, unsigned char aG,
+                                  unsigned char aB, unsigned char aA )
+{
+    unsigned char* texel = &m_pixels[(size_t) aSlot * 4];
+    int            row = aSlot / WIDTH;
+
+    texel[0] = aR;
+    texel[1] = aG;
+    texel[2] = aB;
+    texel[3] = aA;
+
+    m_dirtyFirst = std::min( m_dirtyFirst, row );
+    m_dirtyLast = std::max( m_dirtyLast, row );
+}
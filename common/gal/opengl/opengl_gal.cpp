@@ -35,6 +35,7 @@
 #include <advanced_config.h>
 #include <build_version.h>
 #include <gal/opengl/opengl_gal.h>
+#include <gal/opengl/stroke_glyph_atlas.h>
 #include <gal/opengl/utils.h>
 #include <gal/definitions.h>
 #include <gal/opengl/gl_context_mgr.h>
@@ -78,8 +79,15 @@ static const int glAttributes[] = { WX_GL_RGBA, WX_GL_DOUBLEBUFFER, WX_GL_DEPTH_
 wxGLContext* OPENGL_GAL::m_glMainContext = nullptr;
 int          OPENGL_GAL::m_instanceCounter = 0;
 GLuint       OPENGL_GAL::g_fontTexture = 0;
+GLuint       OPENGL_GAL::g_strokeGlyphTexture = 0;
 bool         OPENGL_GAL::m_isBitmapFontLoaded = false;
 
+// Shared like its texture, which holds a copy of its pixels
+static STROKE_GLYPH_ATLAS g_strokeGlyphAtlas;
+
+// The group color table of each GAL is bound to the fourth texturing unit for drawing
+static const GLint GROUP_COLOR_TEXTURE_UNIT = 4;
+
 namespace KIGFX
 {
 class GL_BITMAP_CACHE
@@ -353,6 +361,9 @@ OPENGL_GAL::OPENGL_GAL( const KIGFX::VC_SETTINGS& aVcSettings, GAL_DISPLAY_OPTIO
     m_isInitialized = false;
     m_isGrouping = false;
     m_groupCounter = 0;
+    m_useGroupColors = false;
+    m_groupColorTexture = 0;
+    m_groupColorTextureHeight = 0;
 
     // Connect the native cursor handler
     Connect( wxEVT_SET_CURSOR, wxSetCursorEventHandler( OPENGL_GAL::onSetNativeCursor ), nullptr,
@@ -404,6 +415,7 @@ OPENGL_GAL::OPENGL_GAL( const KIGFX::VC_SETTINGS& aVcSettings, GAL_DISPLAY_OPTIO
     ufm_screenPixelSize = 1;
     ufm_pixelSizeMultiplier = 1;
     ufm_antialiasingOffset = 1;
+    ufm_groupColorTextureSize = 1;
     m_swapInterval  = 0;
 }
 
@@ -417,6 +429,9 @@ OPENGL_GAL::~OPENGL_GAL()
     gluDeleteTess( m_tesselator );
     ClearCache();
 
+    if( m_groupColorTexture )
+        glDeleteTextures( 1, &m_groupColorTexture );
+
     delete m_compositor;
 
     if( m_isInitialized )
@@ -447,6 +462,12 @@ OPENGL_GAL::~OPENGL_GAL()
             m_isBitmapFontLoaded = false;
         }
 
+        if( g_strokeGlyphTexture )
+        {
+            glDeleteTextures( 1, &g_strokeGlyphTexture );
+            g_strokeGlyphTexture = 0;
+        }
+
         GL_CONTEXT_MANAGER::Get().UnlockCtx( m_glMainContext );
         GL_CONTEXT_MANAGER::Get().DestroyCtx( m_glMainContext );
         m_glMainContext = nullptr;
@@ -657,9 +678,47 @@ void OPENGL_GAL::BeginDrawing()
             glActiveTexture( GL_TEXTURE0 );
         }
 
+        // The stroke glyph atlas is kept bound to the third texturing unit, and its texture is
+        // filled by updateStrokeGlyphTexture() as glyphs are added to it
+        const GLint STROKE_GLYPH_TEXTURE_UNIT = 3;
+
+        glActiveTexture( GL_TEXTURE0 + STROKE_GLYPH_TEXTURE_UNIT );
+
+        if( !g_strokeGlyphTexture )
+        {
+            glGenTextures( 1, &g_strokeGlyphTexture );
+            glBindTexture( GL_TEXTURE_2D, g_strokeGlyphTexture );
+            glTexImage2D( GL_TEXTURE_2D, 0, GL_LUMINANCE8, STROKE_GLYPH_ATLAS::ATLAS_SIZE,
+                          STROKE_GLYPH_ATLAS::ATLAS_SIZE, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE,
+                          nullptr );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+            checkGlError( "creating stroke glyph atlas", __FILE__, __LINE__ );
+
+            g_strokeGlyphAtlas.MarkAllDirty();
+        }
+        else
+        {
+            glBindTexture( GL_TEXTURE_2D, g_strokeGlyphTexture );
+        }
+
+        glActiveTexture( GL_TEXTURE0 );
+
+        // The factor from texture coordinates to the distance units of the atlas
+        const double glyphDistanceScale = STROKE_GLYPH_ATLAS::ATLAS_SIZE
+                                          * STROKE_GLYPH_ATLAS::CELL_EXTENT
+                                          / STROKE_GLYPH_ATLAS::CELL_SIZE
+                                          / STROKE_GLYPH_ATLAS::MAX_DISTANCE;
+
         // Set shader parameter
         GLint ufm_fontTexture = m_shader->AddParameter( "u_fontTexture" );
         GLint ufm_fontTextureWidth = m_shader->AddParameter( "u_fontTextureWidth" );
+        GLint ufm_glyphTexture = m_shader->AddParameter( "u_glyphTexture" );
+        GLint ufm_glyphDistanceScale = m_shader->AddParameter( "u_glyphDistanceScale" );
+        GLint ufm_groupColorTexture = m_shader->AddParameter( "u_groupColorTexture" );
+        ufm_groupColorTextureSize = m_shader->AddParameter( "u_groupColorTextureSize" );
         ufm_worldPixelSize = m_shader->AddParameter( "u_worldPixelSize" );
         ufm_screenPixelSize = m_shader->AddParameter( "u_screenPixelSize" );
         ufm_pixelSizeMultiplier = m_shader->AddParameter( "u_pixelSizeMultiplier" );
@@ -668,6 +727,9 @@ void OPENGL_GAL::BeginDrawing()
         m_shader->Use();
         m_shader->SetParameter( ufm_fontTexture, (int) FONT_TEXTURE_UNIT );
         m_shader->SetParameter( ufm_fontTextureWidth, (int) font_image.width );
+        m_shader->SetParameter( ufm_glyphTexture, (int) STROKE_GLYPH_TEXTURE_UNIT );
+        m_shader->SetParameter( ufm_glyphDistanceScale, (float) glyphDistanceScale );
+        m_shader->SetParameter( ufm_groupColorTexture, (int) GROUP_COLOR_TEXTURE_UNIT );
         m_shader->Deactivate();
         checkGlError( "setting bitmap font sampler as shader parameter", __FILE__, __LINE__ );
 
@@ -714,9 +776,19 @@ void OPENGL_GAL::EndDrawing()
     PROF_TIMER cntSwap("gl-swap");
 
     cntTotal.Start();
+
+    // Glyphs drawn since BeginDrawing() may have been added to the atlas
+    updateStrokeGlyphTexture();
+
+    // Group colors may have been changed since the last frame
+    updateGroupColorTexture();
+
     // Cached & non-cached containers are rendered to the same buffer
     m_compositor->SetBuffer( m_mainBuffer );
 
+    m_statistics.m_nonCachedVertices = m_nonCachedManager->GetContainer().GetUsedSize()
+                                       + m_overlayManager->GetContainer().GetUsedSize();
+
     cntEndNoncached.Start();
     m_nonCachedManager->EndDrawing();
     cntEndNoncached.Stop();
@@ -754,6 +826,11 @@ void OPENGL_GAL::EndDrawing()
 
     cntTotal.Stop();
 
+    m_statistics.m_flushTime = cntEndNoncached.msecs() + cntEndCached.msecs()
+                               + cntEndOverlay.msecs();
+    m_statistics.m_compositeTime = cntComposite.msecs();
+    m_statistics.m_swapTime = cntSwap.msecs();
+
     KI_TRACE( traceGalProfile, "Timing: %s %s %s %s %s %s\n", cntTotal.to_string(),
               cntEndCached.to_string(), cntEndNoncached.to_string(), cntEndOverlay.to_string(),
               cntComposite.to_string(), cntSwap.to_string() );
@@ -1972,6 +2049,12 @@ int OPENGL_GAL::BeginGroup()
     int                          groupNumber = getNewGroupNumber();
     m_groups.insert( std::make_pair( groupNumber, newItem ) );
 
+    if( m_useGroupColors )
+    {
+        newItem->SetColorSlot( m_groupColors.Allocate() );
+        m_cachedManager->ColorSlot( newItem->GetColorSlot() );
+    }
+
     return groupNumber;
 }
 
@@ -1979,6 +2062,7 @@ int OPENGL_GAL::BeginGroup()
 void OPENGL_GAL::EndGroup()
 {
     m_cachedManager->FinishItem();
+    m_cachedManager->ColorSlot( 0 );
     m_isGrouping = false;
 }
 
@@ -1996,7 +2080,13 @@ void OPENGL_GAL::ChangeGroupColor( int aGroupNumber, const COLOR4D& aNewColor )
 {
     auto group = m_groups.find( aGroupNumber );
 
-    if( group != m_groups.end() )
+    if( group == m_groups.end() )
+        return;
+
+    // Groups with a color slot are recolored by the shader, without touching their vertices
+    if( group->second->GetColorSlot() )
+        m_groupColors.SetColor( group->second->GetColorSlot(), aNewColor );
+    else
         m_cachedManager->ChangeItemColor( *group->second, aNewColor );
 }
 
@@ -2012,8 +2102,43 @@ void OPENGL_GAL::ChangeGroupDepth( int aGroupNumber, int aDepth )
 
 void OPENGL_GAL::DeleteGroup( int aGroupNumber )
 {
+    auto group = m_groups.find( aGroupNumber );
+
+    if( group == m_groups.end() )
+        return;
+
+    m_groupColors.Free( group->second->GetColorSlot() );
+
     // Frees memory in the container as well
-    m_groups.erase( aGroupNumber );
+    m_groups.erase( group );
+}
+
+
+unsigned int OPENGL_GAL::GetGroupVertexCount( int aGroupNumber ) const
+{
+    auto group = m_groups.find( aGroupNumber );
+
+    if( group != m_groups.end() )
+        return group->second->GetSize();
+
+    return 0;
+}
+
+
+GAL_STATISTICS OPENGL_GAL::GetStatistics() const
+{
+    GAL_STATISTICS statistics = m_statistics;
+
+    if( m_isInitialized )
+    {
+        const auto& cache = static_cast<const CACHED_CONTAINER&>( m_cachedManager->GetContainer() );
+
+        statistics.m_cachedVertices = cache.GetUsedSize();
+        statistics.m_cachedCapacity = cache.GetSize();
+        statistics.m_defragmentations = cache.GetDefragmentCount();
+    }
+
+    return statistics;
 }
 
 
@@ -2022,6 +2147,7 @@ void OPENGL_GAL::ClearCache()
     m_bitmapCache = std::make_unique<GL_BITMAP_CACHE>();
 
     m_groups.clear();
+    m_groupColors.Clear();
 
     if( m_isInitialized )
         m_cachedManager->Clear();
@@ -2743,6 +2869,14 @@ void OPENGL_GAL::init()
     m_overlayManager->SetShader( *m_shader );
     m_tempManager->SetShader( *m_shader );
 
+    // Group colors are read by the vertex shader, which some old drivers can't sample
+    // textures from
+    int maxVertexTextureUnits = 0;
+    glGetIntegerv( GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS, &maxVertexTextureUnits );
+
+    m_useGroupColors = ADVANCED_CFG::GetCfg().m_GroupColorTable && maxVertexTextureUnits > 0
+                       && maxTextureSize >= GROUP_COLOR_TABLE::WIDTH;
+
     m_isInitialized = true;
 }
 
@@ -2879,7 +3013,11 @@ void OPENGL_GAL::DrawGlyphs( const std::vector<std::unique_ptr<KIFONT::GLYPH>>&
         }
     }
 
-    if( allGlyphsAreStroke )
+    if( allGlyphsAreStroke && drawGlyphsFromAtlas( aGlyphs ) )
+    {
+        return;
+    }
+    else if( allGlyphsAreStroke )
     {
         // Optimized path for stroke fonts that pre-reserves line quads.
         int lineQuadCount = 0;
@@ -2962,3 +3100,174 @@ void OPENGL_GAL::DrawGlyphs( const std::vector<std::unique_ptr<KIFONT::GLYPH>>&
             DrawGlyph( *aGlyphs[i], i, aGlyphs.size() );
     }
 }
+
+
+bool OPENGL_GAL::drawGlyphsFromAtlas( const std::vector<std::unique_ptr<KIFONT::GLYPH>>& aGlyphs )
+{
+    if( !ADVANCED_CFG::GetCfg().m_StrokeGlyphAtlas )
+        return false;
+
+    struct GLYPH_QUAD
+    {
+        const STROKE_GLYPH_ATLAS::CELL* m_cell;
+        VECTOR2D                        m_origin;
+        VECTOR2D                        m_xAxis;
+        VECTOR2D                        m_yAxis;
+        float                           m_halfWidth;
+    };
+
+    std::vector<GLYPH_QUAD> quads;
+    quads.reserve( aGlyphs.size() );
+
+    for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aGlyphs )
+    {
+        const auto& strokeGlyph = static_cast<const KIFONT::STROKE_GLYPH&>( *glyph );
+        const KIFONT::STROKE_GLYPH* fontGlyph = strokeGlyph.GetFontGlyph();
+
+        if( !fontGlyph )
+            return false;
+
+        GLYPH_QUAD quad;
+        strokeGlyph.GetFontTransform( quad.m_origin, quad.m_xAxis, quad.m_yAxis );
+
+        // The distance field only keeps the pen round if the glyph is rotated, mirrored or
+        // scaled uniformly; italic and stretched text are drawn from their segments
+        const double scale = quad.m_xAxis.EuclideanNorm();
+        const double epsilon = 1e-3;
+
+        if( scale <= 0.0
+                || std::abs( quad.m_yAxis.EuclideanNorm() - scale ) > scale * epsilon
+                || std::abs( quad.m_xAxis.Dot( quad.m_yAxis ) ) > scale * scale * epsilon )
+        {
+            return false;
+        }
+
+        // Leave some of the distance field for antialiasing the edges
+        const double halfWidth = std::max( m_lineWidth, 0.0f ) / 2.0 / scale;
+
+        if( halfWidth > 0.8 * STROKE_GLYPH_ATLAS::MAX_DISTANCE )
+            return false;
+
+        quad.m_halfWidth = halfWidth / STROKE_GLYPH_ATLAS::MAX_DISTANCE;
+        quad.m_cell = g_strokeGlyphAtlas.GetCell( fontGlyph );
+
+        if( !quad.m_cell )
+            return false;
+
+        quads.push_back( quad );
+    }
+
+    m_currentManager->Color( m_strokeColor );
+    m_currentManager->Reserve( 6 * quads.size() );
+
+    for( const GLYPH_QUAD& quad : quads )
+    {
+        auto vertex =
+                [&]( double aX, double aY )
+                {
+                    const VECTOR2D pt( aX, aY );
+                    const VECTOR2D tex = quad.m_cell->TextureCoords( pt );
+                    const VECTOR2D pos = quad.m_origin + quad.m_xAxis * pt.x
+                                         + quad.m_yAxis * pt.y;
+
+                    m_currentManager->Shader( SHADER_STROKE_GLYPH, tex.x, tex.y,
+                                              quad.m_halfWidth );
+                    m_currentManager->Vertex( pos.x, pos.y, m_layerDepth );
+                };
+
+        const VECTOR2D& lo = quad.m_cell->m_quadMin;
+        const VECTOR2D& hi = quad.m_cell->m_quadMax;
+
+        vertex( lo.x, lo.y );
+        vertex( hi.x, lo.y );
+        vertex( hi.x, hi.y );
+
+        vertex( lo.x, lo.y );
+        vertex( hi.x, hi.y );
+        vertex( lo.x, hi.y );
+    }
+
+    return true;
+}
+
+
+void OPENGL_GAL::updateGroupColorTexture()
+{
+    int firstRow, lastRow;
+
+    if( !m_useGroupColors )
+        return;
+
+    bool      dirty = m_groupColors.GetDirtyRows( firstRow, lastRow );
+    const int width = GROUP_COLOR_TABLE::WIDTH;
+    const int height = m_groupColors.GetHeight();
+
+    glActiveTexture( GL_TEXTURE0 + GROUP_COLOR_TEXTURE_UNIT );
+
+    if( !m_groupColorTexture )
+    {
+        glGenTextures( 1, &m_groupColorTexture );
+        glBindTexture( GL_TEXTURE_2D, m_groupColorTexture );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+    }
+    else
+    {
+        glBindTexture( GL_TEXTURE_2D, m_groupColorTexture );
+    }
+
+    // The table grew (or the texture is new), so the whole texture is allocated again
+    if( height != m_groupColorTextureHeight )
+    {
+        glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                      m_groupColors.GetPixels().data() );
+        m_groupColorTextureHeight = height;
+
+        m_shader->Use();
+        m_shader->SetParameter( ufm_groupColorTextureSize, VECTOR2D( width, height ) );
+        m_shader->Deactivate();
+    }
+    else if( dirty )
+    {
+        glTexSubImage2D( GL_TEXTURE_2D, 0, 0, firstRow, width, lastRow - firstRow + 1, GL_RGBA,
+                         GL_UNSIGNED_BYTE, &m_groupColors.GetPixels()[firstRow * width * 4] );
+    }
+
+    glActiveTexture( GL_TEXTURE0 );
+    checkGlError( "updating group color table", __FILE__, __LINE__ );
+
+    m_groupColors.ClearDirtyRows();
+}
+
+
+void OPENGL_GAL::updateStrokeGlyphTexture()
+{
+    int firstRow, lastRow;
+
+    if( !g_strokeGlyphTexture )
+        return;
+
+    const int STROKE_GLYPH_TEXTURE_UNIT = 3;
+    const int width = STROKE_GLYPH_ATLAS::ATLAS_SIZE;
+
+    // The antialiasing passes bind their own textures to the same unit, so the atlas has to be
+    // bound again for every frame
+    glActiveTexture( GL_TEXTURE0 + STROKE_GLYPH_TEXTURE_UNIT );
+    glBindTexture( GL_TEXTURE_2D, g_strokeGlyphTexture );
+
+    if( g_strokeGlyphAtlas.GetDirtyRows( firstRow, lastRow ) )
+    {
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+        glTexSubImage2D( GL_TEXTURE_2D, 0, 0, firstRow, width, lastRow - firstRow + 1,
+                         GL_LUMINANCE, GL_UNSIGNED_BYTE,
+                         &g_strokeGlyphAtlas.GetPixels()[firstRow * width] );
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+        checkGlError( "updating stroke glyph atlas", __FILE__, __LINE__ );
+
+        g_strokeGlyphAtlas.ClearDirtyRows();
+    }
+
+    glActiveTexture( GL_TEXTURE0 );
+}
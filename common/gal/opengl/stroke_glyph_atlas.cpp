@@ -0,0 +1,187 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gal/opengl/stroke_glyph_atlas.h>
+#include <font/glyph.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace KIGFX;
+
+
+static constexpr int    CELLS_PER_ROW = STROKE_GLYPH_ATLAS::ATLAS_SIZE
+                                        / STROKE_GLYPH_ATLAS::CELL_SIZE;
+static constexpr double TEXEL_EXTENT = STROKE_GLYPH_ATLAS::CELL_EXTENT
+                                       / STROKE_GLYPH_ATLAS::CELL_SIZE;
+
+
+STROKE_GLYPH_ATLAS::STROKE_GLYPH_ATLAS() :
+        m_cellCount( 0 ),
+        m_dirtyFirst( ATLAS_SIZE ),
+        m_dirtyLast( -1 )
+{
+}
+
+
+const STROKE_GLYPH_ATLAS::CELL*
+STROKE_GLYPH_ATLAS::GetCell( const KIFONT::STROKE_GLYPH* aFontGlyph )
+{
+    auto it = m_cells.find( aFontGlyph );
+
+    if( it != m_cells.end() )
+        return it->second.get();
+
+    if( m_cellCount >= CELLS_PER_ROW * CELLS_PER_ROW )
+        return nullptr;
+
+    VECTOR2D bbMin( std::numeric_limits<double>::max(), std::numeric_limits<double>::max() );
+    VECTOR2D bbMax( std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() );
+
+    for( const std::vector<VECTOR2D>& pointList : *aFontGlyph )
+    {
+        for( const VECTOR2D& point : pointList )
+        {
+            bbMin.x = std::min( bbMin.x, point.x );
+            bbMin.y = std::min( bbMin.y, point.y );
+            bbMax.x = std::max( bbMax.x, point.x );
+            bbMax.y = std::max( bbMax.y, point.y );
+        }
+    }
+
+    // The drawn area stays one texel inside the cell, so it never samples a neighbouring cell
+    const double maxSize = CELL_EXTENT - 2.0 * ( MAX_DISTANCE + TEXEL_EXTENT );
+    std::unique_ptr<CELL> cell;
+
+    if( bbMin.x <= bbMax.x && bbMax.x - bbMin.x <= maxSize && bbMax.y - bbMin.y <= maxSize )
+    {
+        int cellX = ( m_cellCount % CELLS_PER_ROW ) * CELL_SIZE;
+        int cellY = ( m_cellCount / CELLS_PER_ROW ) * CELL_SIZE;
+
+        cell = std::make_unique<CELL>();
+        cell->m_origin = ( bbMin + bbMax ) / 2.0 - VECTOR2D( CELL_EXTENT, CELL_EXTENT ) / 2.0;
+        cell->m_texture = VECTOR2D( cellX, cellY ) / (double) ATLAS_SIZE;
+
+        // Nothing is drawn farther than MAX_DISTANCE from the strokes
+        cell->m_quadMin = bbMin - VECTOR2D( MAX_DISTANCE, MAX_DISTANCE );
+        cell->m_quadMax = bbMax + VECTOR2D( MAX_DISTANCE, MAX_DISTANCE );
+
+        fillCell( *aFontGlyph, cell->m_origin, cellX, cellY );
+        m_cellCount++;
+    }
+
+    return m_cells.emplace( aFontGlyph, std::move( cell ) ).first->second.get();
+}
+
+
+void STROKE_GLYPH_ATLAS::fillCell( const KIFONT::STROKE_GLYPH& aGlyph, const VECTOR2D& aOrigin,
+                                   int aCellX, int aCellY )
+{
+    if( m_pixels.empty() )
+        m_pixels.resize( ATLAS_SIZE * ATLAS_SIZE, 255 );
+
+    std::vector<double> distances( CELL_SIZE * CELL_SIZE, MAX_DISTANCE );
+
+    auto addSegment =
+            [&]( const VECTOR2D& aA, const VECTOR2D& aB )
+            {
+                // Only the texels within MAX_DISTANCE of the segment can get closer to it
+                VECTOR2D lo( std::min( aA.x, aB.x ) - MAX_DISTANCE,
+                             std::min( aA.y, aB.y ) - MAX_DISTANCE );
+                VECTOR2D hi( std::max( aA.x, aB.x ) + MAX_DISTANCE,
+                             std::max( aA.y, aB.y ) + MAX_DISTANCE );
+
+                int x0 = std::max( 0, (int) std::floor( ( lo.x - aOrigin.x ) / TEXEL_EXTENT ) );
+                int y0 = std::max( 0, (int) std::floor( ( lo.y - aOrigin.y ) / TEXEL_EXTENT ) );
+                int x1 = std::min( CELL_SIZE - 1,
+                                   (int) std::ceil( ( hi.x - aOrigin.x ) / TEXEL_EXTENT ) );
+                int y1 = std::min( CELL_SIZE - 1,
+                                   (int) std::ceil( ( hi.y - aOrigin.y ) / TEXEL_EXTENT ) );
+
+                VECTOR2D d = aB - aA;
+                double   lenSq = d.SquaredEuclideanNorm();
+
+                for( int y = y0; y <= y1; y++ )
+                {
+                    for( int x = x0; x <= x1; x++ )
+                    {
+                        VECTOR2D p = aOrigin + VECTOR2D( x + 0.5, y + 0.5 ) * TEXEL_EXTENT;
+                        double   t = 0.0;
+
+                        if( lenSq > 0.0 )
+                            t = std::clamp( ( p - aA ).Dot( d ) / lenSq, 0.0, 1.0 );
+
+                        double& dist = distances[y * CELL_SIZE + x];
+                        dist = std::min( dist, ( p - ( aA + d * t ) ).EuclideanNorm() );
+                    }
+                }
+            };
+
+    for( const std::vector<VECTOR2D>& pointList : aGlyph )
+    {
+        if( pointList.size() == 1 )
+            addSegment( pointList[0], pointList[0] );
+
+        for( size_t i = 1; i < pointList.size(); i++ )
+            addSegment( pointList[i - 1], pointList[i] );
+    }
+
+    for( int y = 0; y < CELL_SIZE; y++ )
+    {
+        unsigned char* row = &m_pixels[( aCellY + y ) * ATLAS_SIZE + aCellX];
+
+        for( int x = 0; x < CELL_SIZE; x++ )
+            row[x] = (unsigned char) std::lround( distances[y * CELL_SIZE + x] / MAX_DISTANCE
+                                                  * 255.0 );
+    }
+
+    m_dirtyFirst = std::min( m_dirtyFirst, aCellY );
+    m_dirtyLast = std::max( m_dirtyLast, aCellY + CELL_SIZE - 1 );
+}
+
+
+bool STROKE_GLYPH_ATLAS::GetDirtyRows( int& aFirst, int& aLast ) const
+{
+    aFirst = m_dirtyFirst;
+    aLast = m_dirtyLast;
+
+    return m_dirtyFirst <= m_dirtyLast;
+}
+
+
+void STROKE_GLYPH_ATLAS::ClearDirtyRows()
+{
+    m_dirtyFirst = ATLAS_SIZE;
+    m_dirtyLast = -1;
+}
+
+
+void STROKE_GLYPH_ATLAS::MarkAllDirty()
+{
+    if( m_pixels.empty() )
+        return;
+
+    m_dirtyFirst = 0;
+    m_dirtyLast = ATLAS_SIZE - 1;
+}
@@ -38,7 +38,8 @@ using namespace KIGFX;
 VERTEX_ITEM::VERTEX_ITEM( const VERTEX_MANAGER& aManager ) :
         m_manager( aManager ),
         m_offset( 0 ),
-        m_size( 0 )
+        m_size( 0 ),
+        m_colorSlot( 0 )
 {
     // As the item is created, we are going to modify it, so call to SetItem() is needed
     m_manager.SetItem( *this );
@@ -43,6 +43,7 @@ using namespace KIGFX;
 VERTEX_MANAGER::VERTEX_MANAGER( bool aCached ) :
         m_noTransform( true ),
         m_transform( 1.0f ),
+        m_colorSlot( 0.0f ),
         m_reserved( nullptr ),
         m_reservedSpace( 0 )
 {
@@ -293,6 +294,8 @@ void VERTEX_MANAGER::putVertex( VERTEX& aTarget, GLfloat aX, GLfloat aY, GLfloat
     {
         aTarget.shader[j] = m_shader[j];
     }
+
+    aTarget.colorSlot = m_colorSlot;
 }
 
 void VERTEX_MANAGER::EnableDepthTest( bool aEnabled )
@@ -35,6 +35,7 @@ const float SHADER_FILLED_CIRCLE        = 2.0;
 const float SHADER_STROKED_CIRCLE       = 3.0;
 const float SHADER_FONT                 = 4.0;
 const float SHADER_LINE_A               = 5.0;
+const float SHADER_STROKE_GLYPH         = 11.0;
 
 varying vec4 v_shaderParams;
 varying vec2 v_circleCoords;
@@ -45,6 +46,10 @@ uniform float u_worldPixelSize;
 // Needed to reconstruct the mipmap level / texel derivative
 uniform int u_fontTextureWidth;
 
+// Stroke glyph distance fields, and the factor from texture coordinates to field units
+uniform sampler2D u_glyphTexture;
+uniform float u_glyphDistanceScale;
+
 void filledCircle( vec2 aCoord )
 {
     if( dot( aCoord, aCoord ) < 1.0 )
@@ -143,6 +148,24 @@ void main()
 
         gl_FragColor = vec4( gl_Color.rgb, alpha );
     }
+    else if( mode == SHADER_STROKE_GLYPH )
+    {
+        vec2 tex           = v_shaderParams.yz;
+
+        // Glyphs are only scaled uniformly, so one derivative gives the pixel size
+        float pixel        = length( dFdx( tex ) ) * u_glyphDistanceScale;
+        float dist         = texture2D( u_glyphTexture, tex ).r;
+
+        // Keep hairlines one pixel wide, as the line shaders do
+        float halfWidth    = max( v_shaderParams[3], 0.5 * pixel );
+        float alpha        = 1.0 - smoothstep( halfWidth - 0.5 * pixel, halfWidth + 0.5 * pixel,
+                                               dist );
+
+        if( alpha <= 0.0 )
+            discard;
+
+        gl_FragColor = vec4( gl_Color.rgb, alpha * gl_Color.a );
+    }
     else
     {
         // Simple pass-through
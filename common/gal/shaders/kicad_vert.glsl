@@ -41,6 +41,7 @@ const float SHADER_LINE_F               = 10.0;
 const float MIN_WIDTH = 1.0;
 
 attribute vec4 a_shaderParams;
+attribute float a_colorSlot;
 varying vec4 v_shaderParams;
 varying vec2 v_circleCoords;
 
@@ -50,6 +51,10 @@ uniform float u_pixelSizeMultiplier;
 uniform float u_minLinePixelWidth;
 uniform vec2 u_antialiasingOffset;
 
+// Colors overriding the vertex colors of cached groups, one texel per group color slot
+uniform sampler2D u_groupColorTexture;
+uniform vec2 u_groupColorTextureSize;
+
 
 float roundr( float f, float r )
 {
@@ -61,6 +66,23 @@ vec4 roundv( vec4 x, vec2 t)
     return vec4( roundr(x.x, t.x), roundr(x.y, t.y), x.z, x.w );
 }
 
+vec4 groupColor()
+{
+    if( a_colorSlot > 0.0 )
+    {
+        vec2 texel = vec2( mod( a_colorSlot, u_groupColorTextureSize.x ),
+                           floor( a_colorSlot / u_groupColorTextureSize.x ) );
+        vec4 color = texture2DLod( u_groupColorTexture,
+                                   ( texel + 0.5 ) / u_groupColorTextureSize, 0.0 );
+
+        // An empty texel leaves the vertex color
+        if( color != vec4( 0.0 ) )
+            return color;
+    }
+
+    return gl_Color;
+}
+
 void computeLineCoords( bool posture, vec2 vs, vec2 vp, vec2 texcoord, vec2 dir, float lineWidth, bool endV )
 {
     float lineLength = length(vs);
@@ -110,7 +132,7 @@ void computeLineCoords( bool posture, vec2 vs, vec2 vp, vec2 texcoord, vec2 dir,
     v_shaderParams[1] = aspect;
 
     gl_TexCoord[0].st = vec2(aspect * texcoord.x, texcoord.y);
-    gl_FrontColor = gl_Color;
+    gl_FrontColor = groupColor();
 }
 
 
@@ -167,7 +189,7 @@ void computeCircleCoords( float mode, float vertexIndex, float radius, float lin
     delta.y *= u_screenPixelSize.y;
 
     gl_Position = center + delta + adjust;
-    gl_FrontColor = gl_Color;
+    gl_FrontColor = groupColor();
 }
 
 
@@ -201,7 +223,7 @@ void main()
     {
         // Pass through the coordinates like in the fixed pipeline
         gl_Position = ftransform();
-        gl_FrontColor = gl_Color;
+        gl_FrontColor = groupColor();
 
     }
 
@@ -86,6 +86,39 @@ size_t hash_fp_item( const EDA_ITEM* aItem, int aFlags )
         for( PCB_LAYER_ID layer : via->GetLayerSet().Seq() )
             hash_combine( ret, via->FlashLayer( layer ) );
 
+        if( aFlags & HASH_POS )
+            hash_combine( ret, via->GetPosition().x, via->GetPosition().y );
+
+        if( aFlags & HASH_NET )
+            hash_combine( ret, via->GetNetCode() );
+
+        break;
+    }
+
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    {
+        const PCB_TRACK* track = static_cast<const PCB_TRACK*>( aItem );
+
+        ret = hash_board_item( track, aFlags );
+        hash_combine( ret, track->Type() );
+        hash_combine( ret, track->GetWidth() );
+
+        if( aFlags & HASH_POS )
+        {
+            hash_combine( ret, track->GetStart().x, track->GetStart().y );
+            hash_combine( ret, track->GetEnd().x, track->GetEnd().y );
+
+            if( track->Type() == PCB_ARC_T )
+            {
+                const PCB_ARC* arc = static_cast<const PCB_ARC*>( track );
+                hash_combine( ret, arc->GetMid().x, arc->GetMid().y );
+            }
+        }
+
+        if( aFlags & HASH_NET )
+            hash_combine( ret, track->GetNetCode() );
+
         break;
     }
 
@@ -29,6 +29,7 @@
 #include <kicad_curl/kicad_curl_easy.h>
 #include <curl/curl.h>
 
+#include <core/thread_pool.h>
 #include <http_lib/http_lib_connection.h>
 
 const char* const traceHTTPLib = "KICAD_HTTP_LIB";
@@ -308,15 +309,24 @@ bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory,
 
     std::string res = "";
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    curl->SetURL( m_source.root_url
-                    + fmt::format( http_endpoint_parts + "/category/{}.json", aCategory.id ) );
-
     try
     {
-        curl->Perform();
+        auto prefetched = m_prefetchedCategories.find( aCategory.id );
 
-        res = curl->GetBuffer();
+        if( prefetched == m_prefetchedCategories.end() )
+        {
+            res = fetchCategory( aCategory );
+        }
+        else
+        {
+            PREFETCHED_CATEGORY fetched = std::move( prefetched->second );
+            m_prefetchedCategories.erase( prefetched );
+
+            if( !fetched.m_error.empty() )
+                throw std::runtime_error( fetched.m_error );
+
+            res = std::move( fetched.m_response );
+        }
 
         nlohmann::json response = nlohmann::json::parse( res );
         std::string    key = "";
@@ -366,6 +376,54 @@ bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory,
 }
 
 
+std::string HTTP_LIB_CONNECTION::fetchCategory( const HTTP_LIB_CATEGORY& aCategory )
+{
+    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
+    curl->SetURL( m_source.root_url
+                    + fmt::format( http_endpoint_parts + "/category/{}.json", aCategory.id ) );
+
+    curl->Perform();
+
+    return curl->GetBuffer();
+}
+
+
+void HTTP_LIB_CONNECTION::PrefetchCategories( const std::vector<HTTP_LIB_CATEGORY>& aCategories )
+{
+    // Responses which weren't used by now are outdated
+    m_prefetchedCategories.clear();
+
+    if( !IsValidEndpoint() || aCategories.size() < 2 )
+        return;
+
+    std::vector<PREFETCHED_CATEGORY> fetched( aCategories.size() );
+
+    // The requests mostly wait for the server, so they are made on several threads; the
+    // responses are parsed by SelectAll() on the calling thread
+    ParallelForEachIndex( aCategories.size(),
+            [&]( size_t aIndex )
+            {
+                try
+                {
+                    fetched[aIndex].m_response = fetchCategory( aCategories[aIndex] );
+                }
+                catch( const std::exception& e )
+                {
+                    fetched[aIndex].m_error = e.what();
+
+                    if( fetched[aIndex].m_error.empty() )
+                        fetched[aIndex].m_error = "unknown error";
+                }
+            } );
+
+    for( size_t ii = 0; ii < aCategories.size(); ++ii )
+        m_prefetchedCategories[aCategories[ii].id] = std::move( fetched[ii] );
+
+    wxLogTrace( traceHTTPLib, wxT( "PrefetchCategories: fetched %zu categories" ),
+                aCategories.size() );
+}
+
+
 bool HTTP_LIB_CONNECTION::checkServerResponse( std::unique_ptr<KICAD_CURL_EASY>& aCurl )
 {
     int statusCode = aCurl->GetResponseStatusCode();
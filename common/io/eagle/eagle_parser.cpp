@@ -30,6 +30,7 @@
 #include <string_utils.h>
 #include <richio.h>
 #include <wx/log.h>
+#include <wx/mstream.h>
 #include <wx/regex.h>
 
 #include <functional>
@@ -396,6 +397,176 @@ NODE_MAP MapChildren( wxXmlNode* aCurrentNode )
 }
 
 
+/**
+ * @return the offset just past the first \a aEnd at or after \a aPos in \a aText.
+ */
+static size_t skipPast( std::string_view aText, size_t aPos, std::string_view aEnd )
+{
+    size_t end = aText.find( aEnd, aPos );
+
+    if( end == std::string_view::npos )
+        throw XML_PARSER_ERROR( wxString::Format( "missing '%s'", std::string( aEnd ) ) );
+
+    return end + aEnd.size();
+}
+
+
+/**
+ * @return the offset just past the tag starting at \a aPos, minding quoted attribute values
+ *         and the bracketed internal subset of a doctype.
+ */
+static size_t skipTag( std::string_view aText, size_t aPos )
+{
+    char quote = 0;
+    int  brackets = 0;
+
+    for( size_t ii = aPos + 1; ii < aText.size(); ++ii )
+    {
+        char c = aText[ii];
+
+        if( quote )
+        {
+            if( c == quote )
+                quote = 0;
+        }
+        else if( c == '"' || c == '\'' )
+        {
+            quote = c;
+        }
+        else if( c == '[' )
+        {
+            brackets++;
+        }
+        else if( c == ']' )
+        {
+            brackets--;
+        }
+        else if( c == '>' && brackets <= 0 )
+        {
+            return ii + 1;
+        }
+    }
+
+    throw XML_PARSER_ERROR( "unterminated tag" );
+}
+
+
+/**
+ * Scan the content of an element from \a aPos to the end tag which closes it, or to the end
+ * of \a aText for the content of a document, collecting the elements directly inside it.
+ */
+static void scanXmlContent( std::string_view aText, size_t aPos,
+                            std::vector<XML_ELEMENT_SPAN>& aChildren )
+{
+    int    depth = 0;
+    size_t childStart = 0;
+
+    for( ;; )
+    {
+        size_t lt = aText.find( '<', aPos );
+
+        if( lt == std::string_view::npos )
+        {
+            if( depth > 0 )
+                throw XML_PARSER_ERROR( "unterminated element" );
+
+            return;
+        }
+
+        if( aText.compare( lt, 4, "<!--" ) == 0 )
+        {
+            aPos = skipPast( aText, lt + 4, "-->" );
+        }
+        else if( aText.compare( lt, 9, "<![CDATA[" ) == 0 )
+        {
+            aPos = skipPast( aText, lt + 9, "]]>" );
+        }
+        else if( aText.compare( lt, 2, "<?" ) == 0 )
+        {
+            aPos = skipPast( aText, lt + 2, "?>" );
+        }
+        else if( aText.compare( lt, 2, "<!" ) == 0 )
+        {
+            aPos = skipTag( aText, lt );
+        }
+        else if( aText.compare( lt, 2, "</" ) == 0 )
+        {
+            aPos = skipTag( aText, lt );
+
+            // The end tag of the element whose content this is
+            if( depth == 0 )
+                return;
+
+            if( --depth == 0 )
+                aChildren.back().text = aText.substr( childStart, aPos - childStart );
+        }
+        else
+        {
+            aPos = skipTag( aText, lt );
+
+            if( depth == 0 )
+            {
+                size_t nameEnd = aText.find_first_of( " \t\r\n/>", lt + 1 );
+
+                childStart = lt;
+                aChildren.push_back( { std::string( aText.substr( lt + 1, nameEnd - lt - 1 ) ),
+                                       aText.substr( lt, aPos - lt ) } );
+            }
+
+            // Empty elements have no end tag
+            if( aText[aPos - 2] != '/' )
+                depth++;
+        }
+    }
+}
+
+
+XML_ELEMENT_SPAN FindXmlRootElement( std::string_view aDocument )
+{
+    std::vector<XML_ELEMENT_SPAN> elements;
+
+    scanXmlContent( aDocument, 0, elements );
+
+    if( elements.empty() )
+        throw XML_PARSER_ERROR( "no root element" );
+
+    return elements.front();
+}
+
+
+std::vector<XML_ELEMENT_SPAN> SplitXmlChildren( std::string_view aElement )
+{
+    std::vector<XML_ELEMENT_SPAN> children;
+
+    if( aElement.empty() )
+        return children;
+
+    size_t start = aElement.find( '<' );
+
+    if( start == std::string_view::npos )
+        throw XML_PARSER_ERROR( "not an element" );
+
+    size_t pos = skipTag( aElement, start );
+
+    if( aElement[pos - 2] != '/' )
+        scanXmlContent( aElement, pos, children );
+
+    return children;
+}
+
+
+std::unique_ptr<wxXmlDocument> ParseXmlElement( std::string_view aElement )
+{
+    wxMemoryInputStream            stream( aElement.data(), aElement.size() );
+    std::unique_ptr<wxXmlDocument> doc = std::make_unique<wxXmlDocument>();
+
+    if( !doc->Load( stream ) || !doc->GetRoot() )
+        throw XML_PARSER_ERROR( "malformed element" );
+
+    return doc;
+}
+
+
 VECTOR2I ConvertArcCenter( const VECTOR2I& aStart, const VECTOR2I& aEnd, double aAngle )
 {
     // Eagle give us start and end.
@@ -31,7 +31,9 @@
 
 #include <map>
 #include <memory>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <wx/xml/xml.h>
 #include <wx/string.h>
@@ -365,6 +367,44 @@ public:
  */
 NODE_MAP MapChildren( wxXmlNode* aCurrentNode );
 
+/**
+ * The extent of an element in the text of an XML document, from the start of its start tag to
+ * the end of its end tag.
+ */
+struct XML_ELEMENT_SPAN
+{
+    std::string      name;
+    std::string_view text;
+};
+
+/**
+ * Find the root element of the XML document \a aDocument without building a document tree.
+ *
+ * @throw XML_PARSER_ERROR if the document has no root element or its markup is malformed.
+ */
+XML_ELEMENT_SPAN FindXmlRootElement( std::string_view aDocument );
+
+/**
+ * Find the elements directly inside \a aElement, the text of an element as found by
+ * FindXmlRootElement() or by an earlier call, without building a document tree.
+ *
+ * With ParseXmlElement(), this lets the sections of a large file be parsed, converted and
+ * released one at a time instead of holding the tree of the whole file in memory.
+ *
+ * @return the child elements in document order; none if \a aElement is empty.
+ * @throw XML_PARSER_ERROR if the markup is malformed.
+ */
+std::vector<XML_ELEMENT_SPAN> SplitXmlChildren( std::string_view aElement );
+
+/**
+ * Parse \a aElement, the UTF-8 text of a single element, into a document of its own.
+ *
+ * Different elements can be parsed from several threads at once.
+ *
+ * @throw XML_PARSER_ERROR if the element isn't well formed.
+ */
+std::unique_ptr<wxXmlDocument> ParseXmlElement( std::string_view aElement );
+
 ///< Convert an Eagle curve end to a KiCad center for S_ARC
 VECTOR2I ConvertArcCenter( const VECTOR2I& aStart, const VECTOR2I& aEnd, double aAngle );
 
@@ -19,6 +19,7 @@
 
 #include <fmt/format.h>
 
+#include <core/thread_pool.h>
 #include <kiid.h>
 #include <io/kicad/kicad_io_utils.h>
 #include <richio.h>
@@ -61,8 +62,13 @@ void FormatUuid( OUTPUTFORMATTER* aOut, const KIID& aUuid, char aSuffix )
  *   (and a sub list)
  *  )
  * )
+ *
+ * prettify() can also format a part of a text which starts \a aListDepth lists deep, right after
+ * the end of a list (or at the start of the text).  Unless it is the \a aLast part, it must end
+ * right before a list starts or ends.  Prettifying the consecutive parts of a text this way gives
+ * the same result as prettifying the whole text at once.
  */
-void Prettify( std::string& aSource, char aQuoteChar )
+static void prettify( std::string& aSource, char aQuoteChar, int aListDepth, bool aLast )
 {
     // Configuration
     const char indentChar = '\t';
@@ -83,8 +89,8 @@ void Prettify( std::string& aSource, char aQuoteChar )
     auto cursor = aSource.begin();
     auto seek = cursor;
 
-    int  listDepth = 0;
-    char lastNonWhitespace = 0;
+    int  listDepth = aListDepth;
+    char lastNonWhitespace = aListDepth > 0 ? ')' : 0;
     bool inQuote = false;
     bool hasInsertedSpace = false;
     bool inMultiLineList = false;
@@ -105,8 +111,9 @@ void Prettify( std::string& aSource, char aQuoteChar )
                 while( seek != aSource.end() && isWhitespace( *seek ) )
                     seek++;
 
+                // The next part starts with a list
                 if( seek == aSource.end() )
-                    return (char)0;
+                    return aLast ? (char)0 : '(';
 
                 return *seek;
             };
@@ -230,9 +237,90 @@ void Prettify( std::string& aSource, char aQuoteChar )
     }
 
     // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
-    formatted += '\n';
+    if( aLast )
+        formatted += '\n';
 
     aSource = std::move( formatted );
 }
 
+
+void Prettify( std::string& aSource, char aQuoteChar )
+{
+    prettify( aSource, aQuoteChar, 0, true );
+}
+
+
+void PrettifyInParallel( std::string& aSource, char aQuoteChar, size_t aPartSize )
+{
+    // Cut the text after the top level lists which end at least aPartSize after the previous
+    // cut and are followed by another list or the end of the outer list.  Track the quotes the
+    // same way as prettify() does, so that parens in strings don't count.
+    std::vector<size_t> cuts = { 0 };
+    size_t              pendingCut = 0;
+    int                 listDepth = 0;
+    bool                inQuote = false;
+    int                 backslashCount = 0;
+
+    for( size_t ii = 0; ii < aSource.size(); ++ii )
+    {
+        char c = aSource[ii];
+
+        if( ( c == ' ' || c == '\t' || c == '\n' || c == '\r' ) && !inQuote )
+            continue;
+
+        if( pendingCut && ( c == '(' || c == ')' ) )
+            cuts.push_back( pendingCut );
+
+        pendingCut = 0;
+
+        if( c == '(' && !inQuote )
+        {
+            listDepth++;
+        }
+        else if( c == ')' && !inQuote )
+        {
+            if( listDepth > 0 )
+                listDepth--;
+
+            if( listDepth == 1 && backslashCount == 0 && ii + 1 - cuts.back() >= aPartSize )
+                pendingCut = ii + 1;
+        }
+        else
+        {
+            if( c == '\\' )
+                backslashCount++;
+            else if( c == aQuoteChar && ( backslashCount & 1 ) == 0 )
+                inQuote = !inQuote;
+
+            if( c != '\\' )
+                backslashCount = 0;
+        }
+    }
+
+    // The last part (with the closing paren of the outer list) is prettified with the others
+    if( cuts.size() < 3 || listDepth != 0 || inQuote )
+    {
+        Prettify( aSource, aQuoteChar );
+        return;
+    }
+
+    cuts.push_back( aSource.size() );
+
+    std::vector<std::string> parts( cuts.size() - 1 );
+
+    ParallelForEachIndex( parts.size(),
+            [&]( size_t aPart )
+            {
+                std::string& part = parts[aPart];
+
+                part.assign( aSource, cuts[aPart], cuts[aPart + 1] - cuts[aPart] );
+                prettify( part, aQuoteChar, aPart == 0 ? 0 : 1, aPart == parts.size() - 1 );
+            } );
+
+    aSource.clear();
+
+    for( const std::string& part : parts )
+        aSource += part;
+}
+
 } // namespace KICAD_FORMAT
@@ -20,6 +20,8 @@
 
 #include <cli/exit_codes.h>
 #include <jobs/job_dispatcher.h>
+#include <perf_trace.h>
+#include <string_utils.h>
 #include <reporter.h>
 #include <wx/debug.h>
 
@@ -43,6 +45,8 @@ int JOB_DISPATCHER::RunJob( JOB* job )
 {
     if( m_jobHandlers.count( job->GetType() ) )
     {
+        SCOPED_TRACE_ZONE traceZone( "Job", From_UTF8( job->GetType().c_str() ) );
+
         return m_jobHandlers[job->GetType()]( job );
     }
 
@@ -0,0 +1,99 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jobs/job_export_cache.h>
+
+#include <build_version.h>
+#include <functional>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/textfile.h>
+
+
+JOB_EXPORT_CACHE::JOB_EXPORT_CACHE( const wxString& aOutputDirectory )
+{
+    m_fileName = wxFileName( aOutputDirectory, wxS( ".kicad_export_hashes" ) ).GetFullPath();
+}
+
+
+void JOB_EXPORT_CACHE::Load()
+{
+    m_lastHashes.clear();
+    m_hashes.clear();
+
+    wxTextFile file( m_fileName );
+
+    if( !file.Exists() || !file.Open() )
+        return;
+
+    // One item per line: the hash, a tab and the item name
+    for( size_t ii = 0; ii < file.GetLineCount(); ++ii )
+    {
+        wxString name;
+        wxString hash = file[ii].BeforeFirst( '\t', &name );
+
+        if( !hash.IsEmpty() && !name.IsEmpty() )
+            m_lastHashes[name] = hash.ToStdString();
+    }
+
+    // The items which are not exported again keep their hash, so exporting a single item
+    // does not invalidate the others
+    m_hashes = m_lastHashes;
+}
+
+
+bool JOB_EXPORT_CACHE::Save() const
+{
+    wxFFile file( m_fileName, wxS( "wb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    std::string content;
+
+    for( const auto& [name, hash] : m_hashes )
+        content += hash + '\t' + std::string( name.utf8_str() ) + '\n';
+
+    return file.Write( content.data(), content.size() ) == content.size();
+}
+
+
+std::string JOB_EXPORT_CACHE::Hash( const wxString& aOptions, const std::string& aContent )
+{
+    std::string prefix( ( GetBuildVersion() + wxS( "\n" ) + aOptions + wxS( "\n" ) ).utf8_str() );
+
+    // std::hash is only stable for a given build, which is fine as the build version is hashed
+    size_t hash = std::hash<std::string>{}( prefix + aContent );
+
+    return std::to_string( hash );
+}
+
+
+bool JOB_EXPORT_CACHE::IsUpToDate( const wxString& aName, const std::string& aHash ) const
+{
+    auto it = m_lastHashes.find( aName );
+
+    return it != m_lastHashes.end() && it->second == aHash;
+}
+
+
+void JOB_EXPORT_CACHE::SetHash( const wxString& aName, const std::string& aHash )
+{
+    m_hashes[aName] = aHash;
+}
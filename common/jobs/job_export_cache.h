@@ -0,0 +1,73 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_EXPORT_CACHE_H
+#define JOB_EXPORT_CACHE_H
+
+#include <kicommon.h>
+#include <map>
+#include <string>
+#include <wx/string.h>
+
+/**
+ * The content hashes of the items of a library exported by a job, kept in the output
+ * directory so that the next export can skip the items which did not change.
+ *
+ * The hashes are only compared with hashes made by the same build: the build version is
+ * part of the hashed content, so a new version exports everything again.
+ */
+class KICOMMON_API JOB_EXPORT_CACHE
+{
+public:
+    JOB_EXPORT_CACHE( const wxString& aOutputDirectory );
+
+    /**
+     * Read the hashes of the last export.  A missing or unreadable file is an empty cache.
+     */
+    void Load();
+
+    /**
+     * Write the hashes of the items of this export.
+     *
+     * @return true if the file was written.
+     */
+    bool Save() const;
+
+    /**
+     * @return the hash of \a aContent, prefixed with the build version and \a aOptions.
+     */
+    static std::string Hash( const wxString& aOptions, const std::string& aContent );
+
+    /**
+     * @return true if \a aName was exported from the same content by the last export.
+     */
+    bool IsUpToDate( const wxString& aName, const std::string& aHash ) const;
+
+    /**
+     * Record the hash of \a aName for the next export.
+     */
+    void SetHash( const wxString& aName, const std::string& aHash );
+
+private:
+    wxString                        m_fileName;
+    std::map<wxString, std::string> m_lastHashes;
+    std::map<wxString, std::string> m_hashes;
+};
+
+#endif
@@ -34,6 +34,7 @@ JOB_EXPORT_PCB_DRILL::JOB_EXPORT_PCB_DRILL( bool aIsCli ) :
     m_zeroFormat( ZEROS_FORMAT::DECIMAL ),
     m_mapFormat( MAP_FORMAT::PDF ),
     m_gerberPrecision( 5 ),
-    m_generateMap( false )
+    m_generateMap( false ),
+    m_optimizeHoleOrder( false )
 {
 }
\ No newline at end of file
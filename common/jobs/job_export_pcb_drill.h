@@ -87,6 +87,9 @@ public:
     int m_gerberPrecision;
 
     bool m_generateMap;
+
+    /// Order the holes of each tool to shorten the drill travel instead of by position
+    bool m_optimizeHoleOrder;
 };
 
 #endif
@@ -40,6 +40,9 @@ public:
 
     bool m_blackAndWhite;
     LSEQ m_printMaskLayer;
+
+    /// Skip the footprints whose content did not change since the last export
+    bool m_skipUnchanged;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_PCB_BENCHMARK_H
+#define JOB_PCB_BENCHMARK_H
+
+#include <kicommon.h>
+#include <wx/string.h>
+#include "job.h"
+
+
+/**
+ * Run the board through a fixed pipeline: load, connectivity, ratsnest, zone fill, DRC, gerber
+ * plot, STEP export and save, and report the resources used by each stage.
+ */
+class KICOMMON_API JOB_PCB_BENCHMARK : public JOB
+{
+public:
+    JOB_PCB_BENCHMARK( bool aIsCli );
+
+    wxString m_filename;
+
+    /// The JSON report
+    wxString m_outputFile;
+
+    /// The directory receiving the DRC report, plots, STEP model and saved board, or empty to
+    /// write them to a temporary directory which is removed afterwards
+    wxString m_outputDir;
+
+    /// The number of times the whole pipeline is run, the board being loaded again each time
+    int m_iterations;
+
+    bool m_skipStep;
+};
+
+#endif
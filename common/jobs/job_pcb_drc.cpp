@@ -29,6 +29,7 @@ JOB_PCB_DRC::JOB_PCB_DRC( bool aIsCli ) :
     m_severity( RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING ),
     m_format( OUTPUT_FORMAT::REPORT ),
     m_exitCodeViolations( false ),
-    m_parity( true )
+    m_parity( true ),
+    m_profile( false )
 {
 }
\ No newline at end of file
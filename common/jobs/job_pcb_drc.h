@@ -21,6 +21,7 @@
 #ifndef JOB_PCB_DRC_H
 #define JOB_PCB_DRC_H
 
+#include <vector>
 #include <kicommon.h>
 #include <layer_ids.h>
 #include <wx/string.h>
@@ -35,6 +36,11 @@ public:
     wxString m_filename;
     wxString m_outputFile;
 
+    /// All the boards to check when several were given.  They are checked one after the other
+    /// in the same kiface session, and m_outputFile is then the directory receiving the
+    /// report of each of them.
+    std::vector<wxString> m_filenames;
+
     bool m_reportAllTrackErrors;
 
     enum class UNITS
@@ -58,6 +64,9 @@ public:
 
     bool m_exitCodeViolations;
     bool m_parity;
+
+    /// Add the time and work counters of each DRC test provider to the report
+    bool m_profile;
 };
 
 #endif
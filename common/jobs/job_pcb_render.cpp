@@ -0,0 +1,38 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jobs/job_pcb_render.h>
+
+
+JOB_PCB_RENDER::JOB_PCB_RENDER( bool aIsCli ) :
+    JOB( "render", aIsCli ),
+    m_filename(),
+    m_outputFile(),
+    m_sides( { SIDE::TOP } ),
+    m_quality( QUALITY::BASIC ),
+    m_width( 1600 ),
+    m_height( 900 ),
+    m_zoom( 1.0 ),
+    m_rotX( 0.0 ),
+    m_rotY( 0.0 ),
+    m_rotZ( 0.0 ),
+    m_perspective( false ),
+    m_preset()
+{
+}
@@ -0,0 +1,78 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_PCB_RENDER_H
+#define JOB_PCB_RENDER_H
+
+#include <vector>
+#include <kicommon.h>
+#include <wx/string.h>
+#include "job.h"
+
+
+class KICOMMON_API JOB_PCB_RENDER : public JOB
+{
+public:
+    JOB_PCB_RENDER( bool aIsCli );
+
+    enum class SIDE
+    {
+        TOP,
+        BOTTOM,
+        LEFT,
+        RIGHT,
+        FRONT,
+        BACK
+    };
+
+    enum class QUALITY
+    {
+        BASIC,  ///< Shadows only, the fastest
+        HIGH,   ///< Every raytracing effect
+        USER    ///< The raytracing options of the 3D viewer settings
+    };
+
+    wxString m_filename;
+
+    /// The image file; its extension (png or jpg) selects the format.  When several sides are
+    /// rendered, the name of each side is appended to the name of the file.
+    wxString m_outputFile;
+
+    /// The camera presets to render, one image each
+    std::vector<SIDE> m_sides;
+
+    QUALITY m_quality;
+
+    int m_width;
+    int m_height;
+
+    double m_zoom;
+
+    /// Extra rotation of the camera around the board X, Y and Z axes, in degrees
+    double m_rotX;
+    double m_rotY;
+    double m_rotZ;
+
+    bool m_perspective;
+
+    /// The 3D viewer layer preset to render, or empty for the current one
+    wxString m_preset;
+};
+
+#endif
@@ -28,6 +28,7 @@ JOB_SYM_EXPORT_SVG::JOB_SYM_EXPORT_SVG( bool aIsCli ) :
     m_outputDirectory(),
     m_blackAndWhite( false ),
     m_includeHiddenPins( false ),
-    m_includeHiddenFields( false )
+    m_includeHiddenFields( false ),
+    m_skipUnchanged( false )
 {
 }
\ No newline at end of file
@@ -41,6 +41,9 @@ public:
 
     bool m_includeHiddenPins;
     bool m_includeHiddenFields;
+
+    /// Skip the symbols whose content did not change since the last export
+    bool m_skipUnchanged;
 };
 
 #endif
\ No newline at end of file
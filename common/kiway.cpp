@@ -749,8 +749,44 @@ void KIWAY::OnKiCadExit()
 }
 
 
+void KIWAY::PreloadKiFACEs( const std::vector<FACE_T>& aFaceIds )
+{
+#ifndef KICAD_WIN32_VERIFY_CODESIGN
+    // Without code signing checks, which KiFACE() runs before loading a DSO
+    if( m_preload.valid() )
+        return;
+
+    std::vector<wxString> dsoNames;
+
+    for( FACE_T faceId : aFaceIds )
+    {
+        if( !m_kiface[faceId] )
+            dsoNames.push_back( dso_search_path( faceId ) );
+    }
+
+    // The DSOs are loaded one at a time, because their static initializers register with the
+    // same global registries.  The loader lock keeps KiFACE() from seeing a DSO half loaded.
+    m_preload = std::async( std::launch::async,
+            [dsoNames]()
+            {
+                for( const wxString& dsoName : dsoNames )
+                {
+                    wxDynamicLibrary dso;
+
+                    // Keep this reference, so the DSO stays loaded until KiFACE() takes its own
+                    if( dso.Load( dsoName, wxDL_VERBATIM | wxDL_NOW | wxDL_GLOBAL | wxDL_QUIET ) )
+                        dso.Detach();
+                }
+            } );
+#endif
+}
+
+
 void KIWAY::OnKiwayEnd()
 {
+    if( m_preload.valid() )
+        m_preload.wait();
+
     for( KIFACE* i : m_kiface )
     {
         if( i )
@@ -200,6 +200,7 @@ LIB_TREE_NODE_ITEM::LIB_TREE_NODE_ITEM( LIB_TREE_NODE* aParent, LIB_TREE_ITEM* a
     aItem->GetChooserFields( m_Fields );
 
     m_SearchTerms = aItem->GetSearchTerms();
+    m_SearchTrigrams = SEARCH_TRIGRAMS( m_SearchTerms );
 
     m_IsRoot = aItem->IsRoot();
 
@@ -230,6 +231,7 @@ void LIB_TREE_NODE_ITEM::Update( LIB_TREE_ITEM* aItem )
     aItem->GetChooserFields( m_Fields );
 
     m_SearchTerms = aItem->GetSearchTerms();
+    m_SearchTrigrams = SEARCH_TRIGRAMS( m_SearchTerms );
 
     m_IsRoot = aItem->IsRoot();
     m_Children.clear();
@@ -245,7 +247,7 @@ void LIB_TREE_NODE_ITEM::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxSt
     // aMatcher test is additive, but if we don't match the given term at all, it nulls out
     if( aMatcher )
     {
-        int currentScore = aMatcher->ScoreTerms( m_SearchTerms );
+        int currentScore = aMatcher->ScoreTerms( m_SearchTerms, m_SearchTrigrams );
 
         // This is a hack: the second phase of search in the adapter will look for a tokenized
         // LIB_ID and send the lib part down here.  While we generally want to prune ourselves
@@ -72,6 +72,7 @@ TREE_NODE* newNode( LIBEVAL::COMPILER* compiler, int op, const T_TOKEN_VALUE& va
     t2->isTerminal   = false;
     t2->srcPos       = compiler->GetSourcePos();
     t2->uop          = nullptr;
+    t2->jump         = nullptr;
 
     libeval_dbg(10, " ostr %p nstr %p nnode %p op %d", value.str, t2->value.str, t2, t2->op );
 
@@ -161,6 +162,19 @@ wxString UOP::Format() const
     }
         break;
 
+    case TR_UOP_JUMP_IF_FALSE:
+        str = wxString::Format( "JUMP IF FALSE [%d]", (int) m_target );
+        break;
+
+    case TR_UOP_JUMP_IF_TRUE:
+        str = wxString::Format( "JUMP IF TRUE [%d]", (int) m_target );
+        break;
+
+    case TR_UOP_COMPARE_VAR:
+        str = wxString::Format( "%s VAR [%p] STR [%ls]", formatOpName( m_compareOp ).c_str(),
+                                m_ref.get(), m_value->AsString() );
+        break;
+
     case TR_OP_METHOD_CALL:
         str = wxString::Format( "MCALL" );
         break;
@@ -187,6 +201,88 @@ UCODE::~UCODE()
 }
 
 
+void UCODE::AddOp( UOP* uop )
+{
+    size_t count = m_ucode.size();
+
+    auto isConstant =
+            []( const UOP* aOp, VAR_TYPE_T aType )
+            {
+                return aOp->m_op == TR_UOP_PUSH_VALUE && aOp->m_value
+                        && aOp->m_value->GetType() == aType;
+            };
+
+    auto numericConstant =
+            [&]( size_t aIdx )
+            {
+                return isConstant( m_ucode[aIdx], VT_NUMERIC );
+            };
+
+    // Fold operators on numeric constants.  (Operators on strings, and the boolean operators
+    // which have already emitted their short-circuit jumps, are left alone.)
+    auto fold =
+            [&]( size_t aArgCount )
+            {
+                CONTEXT ctx;
+
+                for( size_t ii = count - aArgCount; ii < count; ++ii )
+                    ctx.Push( m_ucode[ii]->m_value.get() );
+
+                uop->Exec( &ctx );
+
+                std::unique_ptr<VALUE> result = std::make_unique<VALUE>();
+                result->Set( *ctx.Pop() );
+
+                for( size_t ii = count - aArgCount; ii < count; ++ii )
+                    delete m_ucode[ii];
+
+                m_ucode.resize( count - aArgCount );
+                delete uop;
+
+                m_ucode.push_back( new UOP( TR_UOP_PUSH_VALUE, std::move( result ) ) );
+            };
+
+    if( uop->m_op & TR_OP_BINARY_MASK )
+    {
+        if( uop->m_op != TR_OP_BOOL_AND && uop->m_op != TR_OP_BOOL_OR && count >= 2
+                && numericConstant( count - 2 ) && numericConstant( count - 1 ) )
+        {
+            fold( 2 );
+            return;
+        }
+
+        if( ( uop->m_op == TR_OP_EQUAL || uop->m_op == TR_OP_NOT_EQUAL ) && count >= 2 )
+        {
+            UOP* var = m_ucode[count - 2];
+            UOP* str = m_ucode[count - 1];
+
+            if( var->m_op == TR_UOP_PUSH_VAR && var->m_ref && var->m_ref->HasStringRef()
+                    && isConstant( str, VT_STRING ) )
+            {
+                UOP* compare = new UOP( TR_UOP_COMPARE_VAR, std::move( var->m_ref ) );
+                compare->m_value = std::move( str->m_value );
+                compare->m_compareOp = uop->m_op;
+
+                delete var;
+                delete str;
+                delete uop;
+
+                m_ucode.resize( count - 2 );
+                m_ucode.push_back( compare );
+                return;
+            }
+        }
+    }
+    else if( ( uop->m_op & TR_OP_UNARY_MASK ) && count >= 1 && numericConstant( count - 1 ) )
+    {
+        fold( 1 );
+        return;
+    }
+
+    m_ucode.push_back( uop );
+}
+
+
 wxString UCODE::Dump() const
 {
     wxString rv;
@@ -1088,6 +1184,14 @@ bool COMPILER::generateUCode( UCODE* aCode, CONTEXT* aPreflightContext )
             }
             else if( node->leaf[1] && !node->leaf[1]->isVisited )
             {
+                // The left side of a boolean operator may decide its result on its own
+                if( node->op == TR_OP_BOOL_AND || node->op == TR_OP_BOOL_OR )
+                {
+                    node->jump = new UOP( node->op == TR_OP_BOOL_AND ? TR_UOP_JUMP_IF_FALSE
+                                                                     : TR_UOP_JUMP_IF_TRUE );
+                    aCode->AddOp( node->jump );
+                }
+
                 stack.push_back( node->leaf[1] );
                 node->leaf[1]->isVisited = true;
             }
@@ -1103,6 +1207,12 @@ bool COMPILER::generateUCode( UCODE* aCode, CONTEXT* aPreflightContext )
             node->uop = nullptr;
         }
 
+        if( node->jump )
+        {
+            node->jump->SetTarget( aCode->GetOpCount() );
+            node->jump = nullptr;
+        }
+
         stack.pop_back();
     }
 
@@ -1137,6 +1247,35 @@ void UOP::Exec( CONTEXT* ctx )
         m_func( ctx, m_ref.get() );
         return;
 
+    case TR_UOP_COMPARE_VAR:
+    {
+        const wxString* str = m_ref->GetStringRef( ctx );
+        double          result = 0.0;
+
+        // An undefined value is neither equal nor not equal to anything
+        if( str )
+        {
+            bool equal;
+
+            if( m_value->StringIsWildcard() )
+                equal = WildCompareString( m_value->AsString(), *str, false );
+            else
+                equal = str->IsSameAs( m_value->AsString(), false );
+
+            result = ( equal == ( m_compareOp == TR_OP_EQUAL ) ) ? 1 : 0;
+        }
+
+        VALUE* rp = ctx->AllocValue();
+        rp->Set( result );
+        ctx->Push( rp );
+        return;
+    }
+
+    case TR_UOP_JUMP_IF_FALSE:
+    case TR_UOP_JUMP_IF_TRUE:
+        // Not taken; the value stays on the stack for the boolean operator
+        return;
+
     default:
         break;
     }
@@ -1247,14 +1386,48 @@ void UOP::Exec( CONTEXT* ctx )
 }
 
 
+bool UOP::ShortCircuits( CONTEXT* ctx )
+{
+    // Evaluate everything when checking a rule, so that errors on the right side are reported
+    if( ctx->HasErrorCallback() )
+        return false;
+
+    VALUE* arg1 = ctx->Pop();
+    bool   isTrue = arg1 && arg1->AsDouble() != 0.0;
+
+    if( isTrue == ( m_op == TR_UOP_JUMP_IF_TRUE ) )
+    {
+        VALUE* rp = ctx->AllocValue();
+        rp->Set( isTrue ? 1.0 : 0.0 );
+        ctx->Push( rp );
+        return true;
+    }
+
+    ctx->Push( arg1 );
+    return false;
+}
+
+
 VALUE* UCODE::Run( CONTEXT* ctx )
 {
     static VALUE g_false( 0 );
 
     try
     {
-        for( UOP* op : m_ucode )
-            op->Exec( ctx );
+        for( size_t ii = 0; ii < m_ucode.size(); )
+        {
+            UOP* op = m_ucode[ii++];
+
+            if( op->m_op == TR_UOP_JUMP_IF_FALSE || op->m_op == TR_UOP_JUMP_IF_TRUE )
+            {
+                if( op->ShortCircuits( ctx ) )
+                    ii = op->m_target;
+            }
+            else
+            {
+                op->Exec( ctx );
+            }
+        }
     }
     catch(...)
     {
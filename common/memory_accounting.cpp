@@ -0,0 +1,134 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <memory_accounting.h>
+
+#include <mutex>
+#include <set>
+
+#include <wx/filename.h>
+#include <wx/intl.h>
+
+
+namespace
+{
+
+struct ACCOUNTS
+{
+    std::mutex                m_mutex;
+    std::set<MEMORY_ACCOUNT*> m_accounts;
+};
+
+
+// Never destroyed: static objects may still hold accounts while the program exits
+ACCOUNTS& accounts()
+{
+    static ACCOUNTS* accounts = new ACCOUNTS;
+    return *accounts;
+}
+
+} // namespace
+
+
+MEMORY_REPORT::MEMORY_REPORT()
+{
+    m_bytes.fill( 0 );
+}
+
+
+size_t MEMORY_REPORT::GetTotal() const
+{
+    size_t total = 0;
+
+    for( size_t bytes : m_bytes )
+        total += bytes;
+
+    return total;
+}
+
+
+wxString MEMORY_REPORT::GetCategoryName( MEMORY_CATEGORY aCategory )
+{
+    switch( aCategory )
+    {
+    case MEMORY_CATEGORY::ZONE_FILLS:      return _( "Zone fills" );
+    case MEMORY_CATEGORY::TRIANGULATION:   return _( "Polygon triangulation" );
+    case MEMORY_CATEGORY::MODELS_3D:       return _( "3D models" );
+    case MEMORY_CATEGORY::UNDO_HISTORY:    return _( "Undo history" );
+    case MEMORY_CATEGORY::VERTEX_BUFFERS:  return _( "Vertex buffers" );
+    case MEMORY_CATEGORY::FOOTPRINT_CACHE: return _( "Footprint library cache" );
+    case MEMORY_CATEGORY::TEXT_CACHE:      return _( "Text render cache" );
+    default:                               return wxEmptyString;
+    }
+}
+
+
+wxString MEMORY_REPORT::Format() const
+{
+    wxString out;
+
+    for( size_t ii = 0; ii < m_bytes.size(); ++ii )
+    {
+        MEMORY_CATEGORY category = static_cast<MEMORY_CATEGORY>( ii );
+
+        out += wxString::Format( wxT( "%s: %s\n" ), GetCategoryName( category ),
+                                 wxFileName::GetHumanReadableSize( wxULongLong( m_bytes[ii] ) ) );
+    }
+
+    out += wxString::Format( wxT( "%s: %s\n" ), _( "Total" ),
+                             wxFileName::GetHumanReadableSize( wxULongLong( GetTotal() ) ) );
+
+    return out;
+}
+
+
+MEMORY_ACCOUNT::MEMORY_ACCOUNT( COLLECTOR aCollector ) :
+        m_collector( std::move( aCollector ) )
+{
+    ACCOUNTS&                   state = accounts();
+    std::lock_guard<std::mutex> lock( state.m_mutex );
+
+    state.m_accounts.insert( this );
+}
+
+
+MEMORY_ACCOUNT::~MEMORY_ACCOUNT()
+{
+    ACCOUNTS&                   state = accounts();
+    std::lock_guard<std::mutex> lock( state.m_mutex );
+
+    state.m_accounts.erase( this );
+}
+
+
+MEMORY_REPORT MEMORY_ACCOUNT::Collect()
+{
+    ACCOUNTS&                   state = accounts();
+    std::lock_guard<std::mutex> lock( state.m_mutex );
+    MEMORY_REPORT               report;
+
+    for( MEMORY_ACCOUNT* account : state.m_accounts )
+        account->m_collector( report );
+
+    return report;
+}
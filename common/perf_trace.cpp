@@ -0,0 +1,271 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <perf_trace.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <wx/ffile.h>
+
+
+std::atomic<bool> PERF_TRACE::s_enabled( false );
+
+
+namespace
+{
+
+/// Beyond this count the events are dropped, so a forgotten trace can't exhaust the memory
+constexpr size_t MAX_EVENTS = 4000000;
+
+
+struct TRACE_EVENT
+{
+    const char* m_name;
+    std::string m_detail;
+    int64_t     m_start;
+    int64_t     m_duration;     ///< -1 for a counter
+    int64_t     m_value;
+};
+
+
+struct THREAD_EVENTS
+{
+    std::mutex               m_mutex;
+    std::vector<TRACE_EVENT> m_events;
+    std::string              m_name;
+    int                      m_id = 0;
+};
+
+
+struct TRACE_STATE
+{
+    std::mutex                                  m_mutex;
+    std::vector<std::shared_ptr<THREAD_EVENTS>> m_threads;
+    std::atomic<size_t>                         m_eventCount = 0;
+};
+
+
+// Never destroyed: threads may still record events while the program exits
+TRACE_STATE& traceState()
+{
+    static TRACE_STATE* state = new TRACE_STATE;
+    return *state;
+}
+
+
+THREAD_EVENTS& threadEvents()
+{
+    thread_local std::shared_ptr<THREAD_EVENTS> events;
+
+    if( !events )
+    {
+        TRACE_STATE&                state = traceState();
+        std::lock_guard<std::mutex> lock( state.m_mutex );
+
+        events = std::make_shared<THREAD_EVENTS>();
+        events->m_id = static_cast<int>( state.m_threads.size() ) + 1;
+        state.m_threads.push_back( events );
+    }
+
+    return *events;
+}
+
+
+void addEvent( TRACE_EVENT&& aEvent )
+{
+    if( traceState().m_eventCount++ >= MAX_EVENTS )
+        return;
+
+    THREAD_EVENTS&              events = threadEvents();
+    std::lock_guard<std::mutex> lock( events.m_mutex );
+
+    events.m_events.push_back( std::move( aEvent ) );
+}
+
+
+void appendJsonString( std::string& aOut, const std::string& aString )
+{
+    aOut += '"';
+
+    for( char c : aString )
+    {
+        switch( c )
+        {
+        case '"':  aOut += "\\\""; break;
+        case '\\': aOut += "\\\\"; break;
+        case '\n': aOut += "\\n";  break;
+        case '\t': aOut += "\\t";  break;
+
+        default:
+            if( static_cast<unsigned char>( c ) < 0x20 )
+            {
+                char buf[8];
+                snprintf( buf, sizeof( buf ), "\\u%04x", c );
+                aOut += buf;
+            }
+            else
+            {
+                aOut += c;
+            }
+
+            break;
+        }
+    }
+
+    aOut += '"';
+}
+
+} // namespace
+
+
+void PERF_TRACE::Start()
+{
+    TRACE_STATE&                state = traceState();
+    std::lock_guard<std::mutex> lock( state.m_mutex );
+
+    for( const std::shared_ptr<THREAD_EVENTS>& thread : state.m_threads )
+    {
+        std::lock_guard<std::mutex> threadLock( thread->m_mutex );
+        thread->m_events.clear();
+    }
+
+    state.m_eventCount = 0;
+    s_enabled = true;
+}
+
+
+bool PERF_TRACE::Write( const wxString& aFileName )
+{
+    s_enabled = false;
+
+    wxFFile file( aFileName, wxS( "wb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    TRACE_STATE&                state = traceState();
+    std::lock_guard<std::mutex> lock( state.m_mutex );
+    std::string                 out = "{\"traceEvents\":[\n";
+    bool                        first = true;
+
+    auto beginEvent =
+            [&]()
+            {
+                if( !first )
+                    out += ",\n";
+
+                first = false;
+            };
+
+    for( const std::shared_ptr<THREAD_EVENTS>& thread : state.m_threads )
+    {
+        std::lock_guard<std::mutex> threadLock( thread->m_mutex );
+        std::string                 tid = std::to_string( thread->m_id );
+
+        if( !thread->m_name.empty() )
+        {
+            beginEvent();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid
+                   + ",\"args\":{\"name\":";
+            appendJsonString( out, thread->m_name );
+            out += "}}";
+        }
+
+        for( const TRACE_EVENT& event : thread->m_events )
+        {
+            beginEvent();
+            out += "{\"name\":";
+            appendJsonString( out, event.m_name );
+
+            if( event.m_duration >= 0 )
+            {
+                out += ",\"ph\":\"X\",\"ts\":" + std::to_string( event.m_start )
+                       + ",\"dur\":" + std::to_string( event.m_duration );
+            }
+            else
+            {
+                out += ",\"ph\":\"C\",\"ts\":" + std::to_string( event.m_start );
+            }
+
+            out += ",\"pid\":1,\"tid\":" + tid + ",\"args\":{";
+
+            if( event.m_duration < 0 )
+            {
+                out += "\"value\":" + std::to_string( event.m_value );
+            }
+            else if( !event.m_detail.empty() )
+            {
+                out += "\"detail\":";
+                appendJsonString( out, event.m_detail );
+            }
+
+            out += "}}";
+        }
+
+        // Flush the events of each thread, so the whole trace is never held twice
+        if( file.Write( out.data(), out.size() ) != out.size() )
+            return false;
+
+        out.clear();
+    }
+
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return file.Write( out.data(), out.size() ) == out.size() && file.Close();
+}
+
+
+void PERF_TRACE::Counter( const char* aName, int64_t aValue )
+{
+    if( IsEnabled() )
+        addEvent( { aName, std::string(), Now(), -1, aValue } );
+}
+
+
+void PERF_TRACE::SetThreadName( const wxString& aName )
+{
+    THREAD_EVENTS&              events = threadEvents();
+    std::lock_guard<std::mutex> lock( events.m_mutex );
+
+    events.m_name = aName.ToStdString( wxConvUTF8 );
+}
+
+
+int64_t PERF_TRACE::Now()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - epoch ).count();
+}
+
+
+void PERF_TRACE::AddZone( const char* aName, std::string&& aDetail, int64_t aStart,
+                          int64_t aEnd )
+{
+    addEvent( { aName, std::move( aDetail ), aStart, aEnd - aStart, 0 } );
+}
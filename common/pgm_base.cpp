@@ -49,12 +49,14 @@
 #include <common.h>
 #include <confirm.h>
 #include <core/arraydim.h>
+#include <font/fontconfig.h>
 #include <id.h>
 #include <kicad_curl/kicad_curl.h>
 #include <kiplatform/policy.h>
 #include <macros.h>
 #include <notifications_manager.h>
 #include <paths.h>
+#include <perf_trace.h>
 #include <pgm_base.h>
 #include <policy_keys.h>
 #include <python_scripting.h>
@@ -135,6 +137,7 @@ PGM_BASE::PGM_BASE()
     m_argvUtf8 = nullptr;
     m_splash = nullptr;
     m_PropertyGridInitialized = false;
+    m_python_deferred = false;
 
     setLanguageId( wxLANGUAGE_DEFAULT );
 
@@ -161,6 +164,9 @@ PGM_BASE::~PGM_BASE()
 
 void PGM_BASE::Destroy()
 {
+    if( !ADVANCED_CFG::GetCfg().m_PerfTraceFile.IsEmpty() && PERF_TRACE::IsEnabled() )
+        PERF_TRACE::Write( ADVANCED_CFG::GetCfg().m_PerfTraceFile );
+
     KICAD_CURL::Cleanup();
 
 #ifdef KICAD_USE_SENTRY
@@ -178,6 +184,18 @@ wxApp& PGM_BASE::App()
 }
 
 
+void PGM_BASE::StartPythonScripting()
+{
+    if( !m_python_deferred || m_python_scripting )
+        return;
+
+    // The interpreter keeps the thread it was started on as its main thread
+    wxCHECK_RET( wxIsMainThread(), wxT( "Python must be started from the main thread" ) );
+
+    m_python_scripting = std::make_unique<SCRIPTING>();
+}
+
+
 void PGM_BASE::SetTextEditor( const wxString& aFileName )
 {
     m_text_editor = aFileName;
@@ -585,7 +603,13 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     // Create the python scripting stuff
     // Skip it fot applications that do not use it
     if( !aSkipPyInit )
-        m_python_scripting = std::make_unique<SCRIPTING>();
+    {
+        // Python takes seconds to start, so unless asked otherwise, do it when it's first used
+        if( ADVANCED_CFG::GetCfg().m_DeferPythonInit )
+            m_python_deferred = true;
+        else
+            m_python_scripting = std::make_unique<SCRIPTING>();
+    }
 
     // TODO(JE): Remove this if apps are refactored to not assume Prj() always works
     // Need to create a project early for now (it can have an empty path for the moment)
@@ -599,9 +623,30 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
         wxToolTip::SetAutoPop( 10000 );
     }
 
+    // Initializing fontconfig and listing the fonts can take seconds on systems with many
+    // fonts, so do it before the first outline text or font list needs them
+    if( !aHeadless && !aIsUnitTest )
+    {
+        fontconfig::FONTCONFIG* fc = Fontconfig();     // Reads the font match cache
+        std::string             lang( GetLanguageTag().utf8_str() );
+
+        ScheduleTask( TASK_PRIORITY::BACKGROUND,
+                      [fc, lang]()
+                      {
+                          std::vector<std::string> fonts;
+                          fc->ListFonts( fonts, lang );
+                      } );
+    }
+
     if( ADVANCED_CFG::GetCfg().m_UpdateUIEventInterval != 0 )
         wxUpdateUIEvent::SetUpdateInterval( ADVANCED_CFG::GetCfg().m_UpdateUIEventInterval );
 
+    if( !ADVANCED_CFG::GetCfg().m_PerfTraceFile.IsEmpty() )
+    {
+        PERF_TRACE::Start();
+        PERF_TRACE::SetThreadName( wxS( "Main" ) );
+    }
+
     // Now the application can safely start, show the splash screen
     if( !aHeadless )
         ShowSplash();
@@ -40,6 +40,7 @@
 #include <eda_text.h> // for IsGotoPageHref
 #include <font/font.h>
 #include <core/ignore.h>
+#include <core/thread_pool.h>
 #include <macros.h>
 #include <trigo.h>
 #include <string_utils.h>
@@ -539,6 +540,9 @@ int PDF_PLOTTER::startPdfObject(int handle)
     wxASSERT( m_outputFile );
     wxASSERT( !m_workFile );
 
+    // We are between two objects: a good time to write the pages compressed meanwhile
+    writePendingStreams( GetKiCadThreadPool().get_thread_count() );
+
     if( handle < 0)
         handle = allocPdfObject();
 
@@ -560,29 +564,22 @@ int PDF_PLOTTER::startPdfStream( int handle )
 {
     wxASSERT( m_outputFile );
     wxASSERT( !m_workFile );
-    handle = startPdfObject( handle );
 
-    // This is guaranteed to be handle+1 but needs to be allocated since
-    // you could allocate more object during stream preparation
-    m_streamLengthHandle = allocPdfObject();
+    // The object itself is written once its content is compressed, in writePendingStreams()
+    if( handle < 0 )
+        handle = allocPdfObject();
 
-    if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
-    {
-        fprintf( m_outputFile,
-                 "<< /Length %d 0 R >>\n" // Length is deferred
-                 "stream\n", handle + 1 );
-    }
-    else
-    {
-        fprintf( m_outputFile,
-                 "<< /Length %d 0 R /Filter /FlateDecode >>\n" // Length is deferred
-                 "stream\n", handle + 1 );
-    }
+    m_streamHandle = handle;
 
     // Open a temporary file to accumulate the stream
     m_workFilename = wxFileName::CreateTempFileName( "" );
     m_workFile = wxFopen( m_workFilename, wxT( "w+b" ) );
     wxASSERT( m_workFile );
+
+    // The content is written in a lot of tiny pieces
+    if( m_workFile )
+        setvbuf( m_workFile, nullptr, _IOFBF, 1 << 20 );
+
     return handle;
 }
 
@@ -599,11 +596,11 @@ void PDF_PLOTTER::closePdfStream()
         return;
     }
 
-    // Rewind the file, read in the page stream and DEFLATE it
+    // Rewind the file and read in the page stream
     fseek( m_workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
+    std::string content( stream_len, '\0' );
 
-    int rc = fread( inbuf, 1, stream_len, m_workFile );
+    int rc = fread( content.data(), 1, stream_len, m_workFile );
     wxASSERT( rc == stream_len );
     ignore_unused( rc );
 
@@ -612,45 +609,75 @@ void PDF_PLOTTER::closePdfStream()
     m_workFile = nullptr;
     ::wxRemoveFile( m_workFilename );
 
-    unsigned out_count;
+    bool compress = !ADVANCED_CFG::GetCfg().m_DebugPDFWriter;
 
-    if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
-    {
-        out_count = stream_len;
-        fwrite( inbuf, out_count, 1, m_outputFile );
-    }
-    else
+    // DEFLATE the stream on the thread pool, while the next page is plotted
+    auto deflate =
+            [compress, content = std::move( content )]() -> std::string
+            {
+                if( !compress )
+                    return content;
+
+                // NULL means memos owns the memory, but provide a hint on optimum size needed.
+                wxMemoryOutputStream memos( nullptr, std::max<size_t>( 2000, content.size() ) );
+
+                {
+                    /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
+                     * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
+                     * stream! (a DEFLATE stream would be generated with -15 instead of 15)
+                     * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
+                     *                    8, Z_DEFAULT_STRATEGY );
+                     */
+
+                    wxZlibOutputStream zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+
+                    zos.Write( content.data(), content.size() );
+                }   // flush the zip stream using zos destructor
+
+                wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+
+                return std::string( static_cast<const char*>( sb->GetBufferStart() ),
+                                    sb->Tell() );
+            };
+
+    m_pendingStreams.push_back( { m_streamHandle, compress,
+                                  GetKiCadThreadPool().submit( std::move( deflate ) ) } );
+}
+
+
+void PDF_PLOTTER::writePendingStreams( size_t aMaxPending )
+{
+    wxASSERT( m_outputFile );
+    wxASSERT( !m_workFile );
+
+    // The xref table gives the offset of each object, so they don't need to be in order
+    while( !m_pendingStreams.empty() )
     {
-        // NULL means memos owns the memory, but provide a hint on optimum size needed.
-        wxMemoryOutputStream    memos( nullptr, std::max( 2000l, stream_len ) ) ;
+        PENDING_STREAM& stream = m_pendingStreams.front();
 
+        if( m_pendingStreams.size() <= aMaxPending
+                && stream.m_content.wait_for( std::chrono::seconds( 0 ) )
+                           != std::future_status::ready )
         {
-            /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
-             * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
-             * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-             * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-             *                    8, Z_DEFAULT_STRATEGY );
-             */
+            break;
+        }
 
-            wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+        std::string content = stream.m_content.get();
 
-            zos.Write( inbuf, stream_len );
-        }   // flush the zip stream using zos destructor
+        m_xrefTable[stream.m_handle] = ftell( m_outputFile );
+        fprintf( m_outputFile,
+                 "%d 0 obj\n"
+                 "<< /Length %u%s >>\n"
+                 "stream\n",
+                 stream.m_handle, (unsigned) content.size(),
+                 stream.m_compressed ? " /Filter /FlateDecode" : "" );
 
-        wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+        fwrite( content.data(), 1, content.size(), m_outputFile );
+        fputs( "\nendstream\n"
+               "endobj\n", m_outputFile );
 
-        out_count = sb->Tell();
-        fwrite( sb->GetBufferStart(), 1, out_count, m_outputFile );
+        m_pendingStreams.pop_front();
     }
-
-    delete[] inbuf;
-    fputs( "\nendstream\n", m_outputFile );
-    closePdfObject();
-
-    // Writing the deferred length as an indirect object
-    startPdfObject( m_streamLengthHandle );
-    fprintf( m_outputFile, "%u\n", out_count );
-    closePdfObject();
 }
 
 
@@ -1508,6 +1535,9 @@ function ShM(aEntries) {
 
     closePdfObject();
 
+    // All the pages must be in the file before the xref table
+    writePendingStreams( 0 );
+
     /* Emit the xref table (format is crucial to the byte, each entry must
        be 20 bytes long, and object zero must be done in that way). Also
        the offset must be kept along for the trailer */
@@ -1645,8 +1675,8 @@ void PDF_PLOTTER::Text( const VECTOR2I&        aPos,
     }
 
     // Plot the stroked text (if requested)
-    PLOTTER::Text( aPos, aColor, aText, aOrient, aSize, aH_justify, aV_justify, aWidth, aItalic,
-                   aBold, aMultilineAllowed, aFont, aFontMetrics );
+    plotChainedText( aPos, aText, aOrient, aSize, aH_justify, aV_justify, aWidth, aItalic, aBold,
+                     aFont, aFontMetrics, aData );
 }
 
 
@@ -27,7 +27,9 @@
  * @brief KiCad: specialized plotter for PS files format
  */
 
+#include <callback_gal.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <font/font.h>
 #include <macros.h>
 #include <math/util.h>      // for KiROUND
 #include <string_utils.h>
@@ -273,6 +275,70 @@ void PSLIKE_PLOTTER::FlashRegularPolygon( const VECTOR2I& aShapePos, int aRadius
 }
 
 
+void PSLIKE_PLOTTER::plotChainedText( const VECTOR2I& aPos, const wxString& aText,
+                                      const EDA_ANGLE& aOrient, const VECTOR2I& aSize,
+                                      enum GR_TEXT_H_ALIGN_T aH_justify,
+                                      enum GR_TEXT_V_ALIGN_T aV_justify, int aWidth,
+                                      bool aItalic, bool aBold, KIFONT::FONT* aFont,
+                                      const KIFONT::METRICS& aFontMetrics, void* aData )
+{
+    int penWidth = aWidth;
+
+    if( penWidth == 0 && aBold ) // Use default values if aWidth == 0
+        penWidth = GetPenSizeForBold( std::min( aSize.x, aSize.y ) );
+
+    if( penWidth < 0 )
+        penWidth = -penWidth;
+
+    KIGFX::GAL_DISPLAY_OPTIONS empty_opts;
+
+    CALLBACK_GAL callback_gal( empty_opts,
+            // Stroke callback
+            [&]( const VECTOR2I& aPt1, const VECTOR2I& aPt2 )
+            {
+                if( m_currentPenWidth != penWidth )
+                {
+                    // The line width can't be changed inside a path
+                    PenFinish();
+                    SetCurrentLineWidth( penWidth );
+                }
+
+                if( m_penState != 'D' || m_penLastpos != aPt1 )
+                    MoveTo( aPt1 );
+
+                LineTo( aPt2 );
+            },
+            // Polygon callback
+            [&]( const SHAPE_LINE_CHAIN& aPoly )
+            {
+                PenFinish();
+                PlotPoly( aPoly, FILL_T::FILLED_SHAPE, 0, aData );
+            } );
+
+    TEXT_ATTRIBUTES attributes;
+    attributes.m_Angle = aOrient;
+    attributes.m_StrokeWidth = penWidth;
+    attributes.m_Italic = aItalic;
+    attributes.m_Bold = aBold;
+    attributes.m_Halign = aH_justify;
+    attributes.m_Valign = aV_justify;
+    attributes.m_Size = aSize;
+
+    // if Size.x is < 0, the text is mirrored (we have no other param to know a text is mirrored)
+    if( attributes.m_Size.x < 0 )
+    {
+        attributes.m_Size.x = -attributes.m_Size.x;
+        attributes.m_Mirrored = true;
+    }
+
+    if( !aFont )
+        aFont = KIFONT::FONT::GetFont();
+
+    aFont->Draw( &callback_gal, aText, aPos, attributes, aFontMetrics );
+    PenFinish();
+}
+
+
 std::string PSLIKE_PLOTTER::encodeStringForPlotter( const wxString& aUnicode )
 {
     // Write on a std::string a string escaped for postscript/PDF
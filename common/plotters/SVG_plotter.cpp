@@ -87,12 +87,17 @@
  */
 
 #include <core/base64.h>
+#include <convert_basic_shapes_to_polygon.h>
 #include <eda_shape.h>
 #include <string_utils.h>
 #include <font/font.h>
+#include <geometry/shape_poly_set.h>
 #include <macros.h>
 #include <trigo.h>
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <cstdint>
 #include <wx/mstream.h>
 
@@ -162,6 +167,53 @@ static wxString XmlEsc( const wxString& aStr, bool isAttribute = false )
 }
 
 
+void SVG_PLOTTER::appendCoord( std::string& aOut, double aValue ) const
+{
+    static const int64_t powersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+
+    int    places = std::min<int>( m_precision, 7 );
+    double scaled = aValue * powersOfTen[places];
+
+    if( !std::isfinite( scaled ) || std::abs( scaled ) > 1e15 )
+    {
+        char buf[64];
+        int  len = snprintf( buf, sizeof( buf ), "%.*f", places, aValue );
+        aOut.append( buf, std::clamp( len, 0, (int) sizeof( buf ) - 1 ) );
+        return;
+    }
+
+    // Same value as "%.*f", but without the trailing zeros and much faster than printf
+    char    buf[32];
+    char*   p = buf;
+    int64_t value = std::llround( scaled );
+
+    if( value < 0 )
+    {
+        *p++ = '-';
+        value = -value;
+    }
+
+    int64_t scale = powersOfTen[places];
+    int64_t frac = value % scale;
+
+    p = std::to_chars( p, buf + sizeof( buf ), value / scale ).ptr;
+
+    if( frac )
+    {
+        *p++ = '.';
+
+        for( ; frac && places > 0; --places )
+        {
+            scale /= 10;
+            *p++ = '0' + frac / scale;
+            frac %= scale;
+        }
+    }
+
+    aOut.append( buf, p );
+}
+
+
 SVG_PLOTTER::SVG_PLOTTER()
 {
     m_graphics_changed = true;
@@ -594,25 +646,171 @@ void SVG_PLOTTER::PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFi
         break;
     }
 
-    VECTOR2D pos = userToDeviceCoordinates( aCornerList[0] );
-    fprintf( m_outputFile, "d=\"M %.*f,%.*f\n", m_precision, pos.x, m_precision, pos.y );
+    // Zones and pads have a lot of corners: format them all at once
+    std::string path = "d=\"M";
 
-    for( unsigned ii = 1; ii < aCornerList.size() - 1; ii++ )
-    {
-        pos = userToDeviceCoordinates( aCornerList[ii] );
-        fprintf( m_outputFile, "%.*f,%.*f\n", m_precision, pos.x, m_precision, pos.y );
-    }
+    auto appendPoint =
+            [&]( const VECTOR2I& aPoint )
+            {
+                VECTOR2D pos = userToDeviceCoordinates( aPoint );
+
+                path += ' ';
+                appendCoord( path, pos.x );
+                path += ',';
+                appendCoord( path, pos.y );
+            };
+
+    path.reserve( aCornerList.size() * 16 + 16 );
+
+    for( unsigned ii = 0; ii < aCornerList.size() - 1; ii++ )
+        appendPoint( aCornerList[ii] );
 
     // If the corner list ends where it begins, then close the poly
     if( aCornerList.front() == aCornerList.back() )
     {
-        fprintf( m_outputFile, "Z\" /> \n" );
+        path += " Z\" />\n";
     }
     else
     {
-        pos = userToDeviceCoordinates( aCornerList.back() );
-        fprintf( m_outputFile, "%.*f,%.*f\n\" /> \n", m_precision, pos.x, m_precision, pos.y );
+        appendPoint( aCornerList.back() );
+        path += "\" />\n";
     }
+
+    fwrite( path.data(), 1, path.size(), m_outputFile );
+}
+
+
+void SVG_PLOTTER::flashOutlines( const VECTOR2I& aPadPos, const SHAPE_POLY_SET& aOutlines )
+{
+    // The shape is defined relative to the pad position, so it is the same for all the pads of
+    // the same size and orientation
+    VECTOR2D    origin = userToDeviceCoordinates( aPadPos );
+    std::string shape;
+
+    for( int ii = 0; ii < aOutlines.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN& outline = aOutlines.COutline( ii );
+
+        if( outline.PointCount() < 2 )
+            continue;
+
+        shape += "<path d=\"M";
+
+        for( int jj = 0; jj < outline.PointCount(); ++jj )
+        {
+            VECTOR2D pos = userToDeviceCoordinates( outline.CPoint( jj ) ) - origin;
+
+            shape += ' ';
+            appendCoord( shape, pos.x );
+            shape += ',';
+            appendCoord( shape, pos.y );
+        }
+
+        shape += " Z\" />\n";
+    }
+
+    if( shape.empty() )
+        return;
+
+    auto [it, inserted] = m_padShapes.emplace( std::move( shape ), (int) m_padShapes.size() );
+
+    if( inserted )
+    {
+        m_defs += "<g id=\"pad" + std::to_string( it->second ) + "\" fill-rule=\"evenodd\">\n";
+        m_defs += it->first;
+        m_defs += "</g>\n";
+    }
+
+    // The fill color and opacity are inherited from the group of the current style
+    setFillMode( FILL_T::FILLED_SHAPE );
+    SetCurrentLineWidth( 0 );
+
+    if( m_graphics_changed )
+        setSVGPlotStyle( GetCurrentLineWidth() );
+
+    std::string use = "<use xlink:href=\"#pad" + std::to_string( it->second ) + "\" x=\"";
+
+    appendCoord( use, origin.x );
+    use += "\" y=\"";
+    appendCoord( use, origin.y );
+    use += "\" />\n";
+
+    fwrite( use.data(), 1, use.size(), m_outputFile );
+}
+
+
+void SVG_PLOTTER::FlashPadRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                void* aData )
+{
+    if( aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadRect( aPadPos, aSize, aPadOrient, aTraceMode, aData );
+        return;
+    }
+
+    SHAPE_POLY_SET outline;
+    TransformRoundChamferedRectToPolygon( outline, aPadPos, aSize, aPadOrient, 0, 0.0, 0, 0,
+                                          GetPlotterArcHighDef(), ERROR_INSIDE );
+
+    flashOutlines( aPadPos, outline );
+}
+
+
+void SVG_PLOTTER::FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                     int aCornerRadius, const EDA_ANGLE& aOrient,
+                                     OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadRoundRect( aPadPos, aSize, aCornerRadius, aOrient, aTraceMode,
+                                           aData );
+        return;
+    }
+
+    SHAPE_POLY_SET outline;
+    TransformRoundChamferedRectToPolygon( outline, aPadPos, aSize, aOrient, aCornerRadius, 0.0, 0,
+                                          0, GetPlotterArcHighDef(), ERROR_INSIDE );
+
+    flashOutlines( aPadPos, outline );
+}
+
+
+void SVG_PLOTTER::FlashPadCustom( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                  const EDA_ANGLE& aOrient, SHAPE_POLY_SET* aPolygons,
+                                  OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadCustom( aPadPos, aSize, aOrient, aPolygons, aTraceMode, aData );
+        return;
+    }
+
+    flashOutlines( aPadPos, *aPolygons );
+}
+
+
+void SVG_PLOTTER::FlashPadTrapez( const VECTOR2I& aPadPos, const VECTOR2I* aCorners,
+                                  const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                  void* aData )
+{
+    if( aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadTrapez( aPadPos, aCorners, aPadOrient, aTraceMode, aData );
+        return;
+    }
+
+    SHAPE_POLY_SET outline;
+    outline.NewOutline();
+
+    for( int ii = 0; ii < 4; ii++ )
+    {
+        VECTOR2I corner = aCorners[ii];
+        RotatePoint( corner, aPadOrient );
+        outline.Append( corner + aPadPos );
+    }
+
+    flashOutlines( aPadPos, outline );
 }
 
 
@@ -656,12 +854,13 @@ void SVG_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double
                  "<image x=\"%f\" y=\"%f\" xlink:href=\"data:image/png;base64,",
                  userToDeviceSize( start.x ), userToDeviceSize( start.y ) );
 
-        for( size_t i = 0; i < encoded.size(); i++ )
+        for( size_t i = 0; i < encoded.size(); i += 64 )
         {
-            fprintf( m_outputFile, "%c", static_cast<char>( encoded[i] ) );
+            fwrite( encoded.data() + i, 1, std::min<size_t>( 64, encoded.size() - i ),
+                    m_outputFile );
 
-            if( ( i % 64 )  == 63 )
-                fprintf( m_outputFile, "\n" );
+            if( i + 64 <= encoded.size() )
+                fputs( "\n", m_outputFile );
         }
 
         fprintf( m_outputFile, "\"\npreserveAspectRatio=\"none\" width=\"%.*f\" height=\"%.*f\" />",
@@ -697,9 +896,13 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
         if( m_graphics_changed )
             setSVGPlotStyle( GetCurrentLineWidth() );
 
-        fprintf( m_outputFile, "<path d=\"M%.*f %.*f\n",
-                 m_precision, pos_dev.x,
-                 m_precision, pos_dev.y );
+        std::string cmd = "<path d=\"M";
+
+        appendCoord( cmd, pos_dev.x );
+        cmd += ' ';
+        appendCoord( cmd, pos_dev.y );
+        cmd += '\n';
+        fwrite( cmd.data(), 1, cmd.size(), m_outputFile );
     }
     else if( m_penState != plume || pos != m_penLastpos )
     {
@@ -708,9 +911,14 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
 
         VECTOR2D pos_dev = userToDeviceCoordinates( pos );
 
-        fprintf( m_outputFile, "L%.*f %.*f\n",
-                 m_precision, pos_dev.x,
-                 m_precision, pos_dev.y );
+        // A move inside a path starts a new subpath (see plotChainedText())
+        std::string cmd( 1, plume == 'U' ? 'M' : 'L' );
+
+        appendCoord( cmd, pos_dev.x );
+        cmd += ' ';
+        appendCoord( cmd, pos_dev.y );
+        cmd += '\n';
+        fwrite( cmd.data(), 1, cmd.size(), m_outputFile );
     }
 
     m_penState    = plume;
@@ -718,10 +926,23 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
 }
 
 
+bool SVG_PLOTTER::OpenFile( const wxString& aFullFilename )
+{
+    if( !PLOTTER::OpenFile( aFullFilename ) )
+        return false;
+
+    setvbuf( m_outputFile, nullptr, _IOFBF, 1 << 20 );
+    return true;
+}
+
+
 bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
 {
     wxASSERT( m_outputFile );
 
+    m_padShapes.clear();
+    m_defs.clear();
+
     static const char*  header[] =
     {
         "<?xml version=\"1.0\" standalone=\"no\"?>\n",
@@ -778,7 +999,17 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
 
 bool SVG_PLOTTER::EndPlot()
 {
-    fputs( "</g> \n</svg>\n", m_outputFile );
+    fputs( "</g> \n", m_outputFile );
+
+    // The pad shapes used in the file
+    if( !m_defs.empty() )
+    {
+        fputs( "<defs>\n", m_outputFile );
+        fwrite( m_defs.data(), 1, m_defs.size(), m_outputFile );
+        fputs( "</defs>\n", m_outputFile );
+    }
+
+    fputs( "</svg>\n", m_outputFile );
     fclose( m_outputFile );
     m_outputFile = nullptr;
 
@@ -860,8 +1091,8 @@ void SVG_PLOTTER::Text( const VECTOR2I&        aPos,
     fprintf( m_outputFile, "<g class=\"stroked-text\"><desc>%s</desc>\n",
              TO_UTF8( XmlEsc( aText ) ) );
 
-    PLOTTER::Text( aPos, aColor, aText, aOrient, aSize, aH_justify, aV_justify, aWidth, aItalic,
-                   aBold, aMultilineAllowed, aFont, aFontMetrics );
+    plotChainedText( aPos, aText, aOrient, aSize, aH_justify, aV_justify, aWidth, aItalic, aBold,
+                     aFont, aFontMetrics, aData );
 
     fputs( "</g>", m_outputFile );
 }
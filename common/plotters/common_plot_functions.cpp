@@ -32,6 +32,7 @@
 #include <drawing_sheet/ds_draw_item.h>
 #include <title_block.h>
 #include <wx/filename.h>
+#include <mutex>
 
 
 wxString GetDefaultPlotExtension( PLOT_FORMAT aFormat )
@@ -55,6 +56,11 @@ void PlotDrawingSheet( PLOTTER* plotter, const PROJECT* aProject, const TITLE_BL
                        const wxString& aSheetPath, const wxString& aFilename, COLOR4D aColor,
                        bool aIsFirstPage )
 {
+    // The draw items are built from the drawing sheet model shared by all the plotters, and
+    // the layers of a board can be plotted in parallel
+    static std::mutex           modelMutex;
+    std::lock_guard<std::mutex> lock( modelMutex );
+
     /* Note: Page sizes values are given in mils
      */
     double           iusPerMil = plotter->GetIUsPerDecimil() * 10.0;
@@ -131,6 +131,22 @@ const void* PROPERTY_MANAGER::TypeCast( const void* aSource, TYPE_ID aBase, TYPE
 }
 
 
+const TYPE_CAST_BASE* PROPERTY_MANAGER::GetTypeCast( TYPE_ID aBase, TYPE_ID aTarget ) const
+{
+    if( aBase == aTarget )
+        return nullptr;
+
+    auto classDesc = m_classes.find( aBase );
+
+    if( classDesc == m_classes.end() )
+        return nullptr;
+
+    auto converter = classDesc->second.m_typeCasts.find( aTarget );
+
+    return converter == classDesc->second.m_typeCasts.end() ? nullptr : converter->second.get();
+}
+
+
 PROPERTY_BASE& PROPERTY_MANAGER::AddProperty( PROPERTY_BASE* aProperty, const wxString& aGroup )
 {
     const wxString& name = aProperty->Name();
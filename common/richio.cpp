@@ -23,9 +23,12 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
+#include <advanced_config.h>
 #include <kiplatform/io.h>
 #include <core/ignore.h>
 #include <richio.h>
@@ -33,8 +36,11 @@
 #include <io/kicad/kicad_io_utils.h>
 
 #include <wx/file.h>
+#include <wx/ffile.h>
 #include <wx/translation.h>
 
+#include <zlib.h>
+
 
 // Fall back to getc() when getc_unlocked() is not available on the target platform.
 #if !defined( HAVE_FGETC_NOLOCK )
@@ -131,6 +137,25 @@ wxString SafeReadFile( const wxString& aFilePath, const wxString& aReadType )
 }
 
 
+bool IsGzipFileName( const wxString& aFileName )
+{
+    return aFileName.Lower().EndsWith( wxS( ".gz" ) );
+}
+
+
+/**
+ * Open \a aFileName with zlib, which needs a wide file name to handle every path on Windows.
+ */
+static gzFile openGzipFile( const wxString& aFileName, const char* aMode )
+{
+#ifdef _WIN32
+    return gzopen_w( aFileName.wc_str(), aMode );
+#else
+    return gzopen( aFileName.fn_str(), aMode );
+#endif
+}
+
+
 //-----<LINE_READER>------------------------------------------------------
 
 LINE_READER::LINE_READER( unsigned aMaxLineLength ) :
@@ -225,6 +250,79 @@ FILE_LINE_READER::~FILE_LINE_READER()
 }
 
 
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aStartingLineNumber,
+                                                  unsigned aMaxLineLength ) :
+        LINE_READER( aMaxLineLength ),
+        m_data( nullptr ),
+        m_size( 0 ),
+        m_pos( 0 ),
+        m_handle( nullptr ),
+        m_mapped( false )
+{
+    m_data = KIPLATFORM::IO::MapFile( aFileName, m_size, m_handle );
+
+    if( m_data )
+    {
+        m_mapped = true;
+    }
+    else
+    {
+        // Empty, or on a file system which doesn't support mapping
+        wxFFile file( aFileName, wxT( "rb" ) );
+
+        if( !file.IsOpened() )
+        {
+            wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                             aFileName.GetData() );
+            THROW_IO_ERROR( msg );
+        }
+
+        m_fallback.resize( std::max<wxFileOffset>( 0, file.Length() ) );
+        m_fallback.resize( file.Read( m_fallback.data(), m_fallback.size() ) );
+
+        m_data = m_fallback.data();
+        m_size = m_fallback.size();
+    }
+
+    m_source  = aFileName;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    if( m_mapped )
+        KIPLATFORM::IO::UnmapFile( m_data, m_size, m_handle );
+}
+
+
+char* MAPPED_FILE_LINE_READER::ReadLine()
+{
+    const char* start = m_data + m_pos;
+    const char* nl = static_cast<const char*>( memchr( start, '\n', m_size - m_pos ) );
+    size_t      new_length = nl ? nl - start + 1 : m_size - m_pos;   // include the newline
+
+    if( new_length >= m_maxLineLength )
+        THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+    if( new_length + 1 > m_capacity )   // +1 for terminating nul
+        expandCapacity( new_length + 1 );
+
+    memcpy( m_line, start, new_length );
+    m_pos += new_length;
+
+    m_length = new_length;
+    m_line[m_length] = 0;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return m_length ? m_line : nullptr;
+}
+
+
 long int FILE_LINE_READER::FileLength()
 {
     fseek( m_fp, 0, SEEK_END );
@@ -275,6 +373,111 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+/// The size of the blocks a compressed file is decompressed and compressed in.
+static const size_t GZIP_CHUNK_SIZE = 1024 * 1024;
+
+
+GZIP_FILE_LINE_READER::GZIP_FILE_LINE_READER( const wxString& aFileName,
+                                              unsigned aStartingLineNumber,
+                                              unsigned aMaxLineLength ) :
+        LINE_READER( aMaxLineLength ),
+        m_file( nullptr ),
+        m_chunk( GZIP_CHUNK_SIZE ),
+        m_pos( 0 ),
+        m_end( 0 )
+{
+    m_file = openGzipFile( aFileName, "rb" );
+
+    if( !m_file )
+    {
+        wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                         aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    gzbuffer( m_file, GZIP_CHUNK_SIZE / 4 );
+
+    m_source  = aFileName;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+GZIP_FILE_LINE_READER::~GZIP_FILE_LINE_READER()
+{
+    if( m_file )
+        gzclose( m_file );
+}
+
+
+bool GZIP_FILE_LINE_READER::fill()
+{
+    int count = gzread( m_file, m_chunk.data(), (unsigned) m_chunk.size() );
+
+    if( count < 0 )
+    {
+        int         errnum = Z_OK;
+        const char* msg = gzerror( m_file, &errnum );
+
+        THROW_IO_ERROR( wxString::Format( _( "Error reading %s: %s" ), m_source,
+                                          wxString::FromUTF8( msg ) ) );
+    }
+
+    m_pos = 0;
+    m_end = count;
+
+    return count > 0;
+}
+
+
+void GZIP_FILE_LINE_READER::Rewind()
+{
+    if( gzrewind( m_file ) != 0 )
+        THROW_IO_ERROR( wxString::Format( _( "Error reading %s." ), m_source ) );
+
+    m_pos = 0;
+    m_end = 0;
+    m_lineNum = 0;
+}
+
+
+char* GZIP_FILE_LINE_READER::ReadLine()
+{
+    m_length = 0;
+
+    for( ;; )
+    {
+        if( m_pos == m_end && !fill() )
+            break;
+
+        const char* start = m_chunk.data() + m_pos;
+        const char* nl = static_cast<const char*>( memchr( start, '\n', m_end - m_pos ) );
+        size_t      count = nl ? nl - start + 1 : m_end - m_pos;   // include the newline
+
+        if( m_length + count >= m_maxLineLength )
+            THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+        // A line can span several chunks, so grow geometrically
+        if( m_length + count + 1 > m_capacity )   // +1 for terminating nul
+            expandCapacity( std::max<size_t>( m_length + count + 1, m_capacity * 2 ) );
+
+        memcpy( m_line + m_length, start, count );
+        m_length += count;
+        m_pos += count;
+
+        if( nl )
+            break;
+    }
+
+    m_line[m_length] = 0;
+
+    // m_lineNum is incremented even if there was no line read, because this
+    // leads to better error reporting when we hit an end of file.
+    ++m_lineNum;
+
+    return m_length ? m_line : nullptr;
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
@@ -583,6 +786,132 @@ void FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 }
 
 
+/// The number of compressed blocks which may wait for the worker before the formatter waits too.
+static const size_t GZIP_MAX_QUEUED_BLOCKS = 4;
+
+
+GZIP_FILE_OUTPUTFORMATTER::GZIP_FILE_OUTPUTFORMATTER( const wxString& aFileName,
+                                                      char aQuoteChar ) :
+        OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
+        m_filename( aFileName ),
+        m_done( false )
+{
+    // Level 6 is zlib's default; higher levels cost far more time than they save space
+    m_file = openGzipFile( aFileName, "wb6" );
+
+    if( !m_file )
+        THROW_IO_ERROR( strerror( errno ) );
+
+    gzbuffer( m_file, GZIP_CHUNK_SIZE / 4 );
+
+    m_block.reserve( GZIP_CHUNK_SIZE );
+    m_worker = std::thread( &GZIP_FILE_OUTPUTFORMATTER::compress, this );
+}
+
+
+GZIP_FILE_OUTPUTFORMATTER::~GZIP_FILE_OUTPUTFORMATTER()
+{
+    try
+    {
+        GZIP_FILE_OUTPUTFORMATTER::Finish();
+    }
+    catch( ... )
+    {}
+}
+
+
+void GZIP_FILE_OUTPUTFORMATTER::compress()
+{
+    for( ;; )
+    {
+        std::string block;
+
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+
+            m_cond.wait( lock, [&]() { return m_done || !m_queue.empty(); } );
+
+            if( m_queue.empty() )
+                return;
+
+            block = std::move( m_queue.front() );
+            m_queue.pop_front();
+        }
+
+        m_cond.notify_all();
+
+        // Keep draining the queue after an error so the formatter is never left waiting
+        if( m_error.IsEmpty() && !block.empty()
+                && gzwrite( m_file, block.data(), (unsigned) block.size() ) == 0 )
+        {
+            int                         errnum = Z_OK;
+            const char*                 msg = gzerror( m_file, &errnum );
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            m_error = wxString::Format( _( "Error writing %s: %s" ), m_filename,
+                                        errnum == Z_ERRNO ? strerror( errno ) : msg );
+        }
+    }
+}
+
+
+void GZIP_FILE_OUTPUTFORMATTER::submit()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    if( !m_error.IsEmpty() )
+        THROW_IO_ERROR( m_error );
+
+    m_cond.wait( lock, [&]() { return m_queue.size() < GZIP_MAX_QUEUED_BLOCKS; } );
+
+    m_queue.push_back( std::move( m_block ) );
+    lock.unlock();
+    m_cond.notify_all();
+
+    m_block = std::string();
+    m_block.reserve( GZIP_CHUNK_SIZE );
+}
+
+
+bool GZIP_FILE_OUTPUTFORMATTER::Finish()
+{
+    if( !m_file )
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( !m_block.empty() )
+            m_queue.push_back( std::move( m_block ) );
+
+        m_done = true;
+    }
+
+    m_cond.notify_all();
+    m_worker.join();
+
+    int result = gzclose( m_file );
+    m_file = nullptr;
+
+    if( !m_error.IsEmpty() )
+        THROW_IO_ERROR( m_error );
+
+    if( result != Z_OK )
+        THROW_IO_ERROR( wxString::Format( _( "Error writing %s." ), m_filename ) );
+
+    return true;
+}
+
+
+void GZIP_FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
+{
+    m_block.append( aOutBuf, aCount );
+
+    if( m_block.size() >= GZIP_CHUNK_SIZE )
+        submit();
+}
+
+
 PRETTIFIED_FILE_OUTPUTFORMATTER::PRETTIFIED_FILE_OUTPUTFORMATTER( const wxString& aFileName,
                                                                   const wxChar* aMode,
                                                                   char aQuoteChar ) :
@@ -611,7 +940,10 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
     if( !m_fp )
         return false;
 
-    KICAD_FORMAT::Prettify( m_buf );
+    if( ADVANCED_CFG::GetCfg().m_ParallelBoardSave )
+        KICAD_FORMAT::PrettifyInParallel( m_buf );
+    else
+        KICAD_FORMAT::Prettify( m_buf );
 
     if( fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
         THROW_IO_ERROR( strerror( errno ) );
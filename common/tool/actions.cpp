@@ -994,6 +994,13 @@ TOOL_ACTION ACTIONS::reportBug( TOOL_ACTION_ARGS()
         .Tooltip( _( "Report a problem with KiCad" ) )
         .Icon( BITMAPS::bug ) );
 
+TOOL_ACTION ACTIONS::showMemoryUsage( TOOL_ACTION_ARGS()
+        .Name( "common.SuiteControl.showMemoryUsage" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Memory Usage..." ) )
+        .Tooltip( _( "Show the approximate memory held by the caches" ) )
+        .Icon( BITMAPS::info ) );
+
 TOOL_ACTION ACTIONS::ddAddLibrary( TOOL_ACTION_ARGS()
         .Name( "common.Control.ddaddLibrary" )
         .Scope( AS_GLOBAL ) );
@@ -40,7 +40,10 @@
 #include <id.h>
 #include <kiface_base.h>
 #include <dialogs/dialog_configure_paths.h>
+#include <dialogs/html_message_box.h>
 #include <eda_doc.h>
+#include <memory_accounting.h>
+#include <wx/filename.h>
 #include <wx/msgdlg.h>
 
 #define URL_GET_INVOLVED wxS( "https://kicad.org/contribute/" )
@@ -336,6 +339,40 @@ int COMMON_CONTROL::ReportBug( const TOOL_EVENT& aEvent )
 }
 
 
+int COMMON_CONTROL::ShowMemoryUsage( const TOOL_EVENT& aEvent )
+{
+    MEMORY_REPORT report = MEMORY_ACCOUNT::Collect();
+    wxString      html = wxT( "<table>" );
+
+    auto addRow =
+            [&]( const wxString& aName, size_t aBytes )
+            {
+                wxString size = wxFileName::GetHumanReadableSize( wxULongLong( aBytes ) );
+
+                html += wxString::Format( wxT( "<tr><td>%s</td><td align=\"right\">%s</td></tr>" ),
+                                          aName, size );
+            };
+
+    for( size_t ii = 0; ii < static_cast<size_t>( MEMORY_CATEGORY::COUNT ); ++ii )
+    {
+        MEMORY_CATEGORY category = static_cast<MEMORY_CATEGORY>( ii );
+        addRow( MEMORY_REPORT::GetCategoryName( category ), report.Get( category ) );
+    }
+
+    addRow( wxT( "<b>" ) + _( "Total" ) + wxT( "</b>" ), report.GetTotal() );
+    html += wxT( "</table><p>" );
+    html += _( "The sizes are estimates of the memory held by the caches of all the open "
+               "documents." );
+    html += wxT( "</p>" );
+
+    HTML_MESSAGE_BOX dlg( m_frame, _( "Memory Usage" ) );
+    dlg.AddHTML_Text( html );
+    dlg.ShowModal();
+
+    return 0;
+}
+
+
 void COMMON_CONTROL::setTransitions()
 {
     Go( &COMMON_CONTROL::OpenPreferences,    ACTIONS::openPreferences.MakeEvent() );
@@ -354,6 +391,7 @@ void COMMON_CONTROL::setTransitions()
     Go( &COMMON_CONTROL::GetInvolved,        ACTIONS::getInvolved.MakeEvent() );
     Go( &COMMON_CONTROL::Donate,             ACTIONS::donate.MakeEvent() );
     Go( &COMMON_CONTROL::ReportBug,          ACTIONS::reportBug.MakeEvent() );
+    Go( &COMMON_CONTROL::ShowMemoryUsage,    ACTIONS::showMemoryUsage.MakeEvent() );
     Go( &COMMON_CONTROL::About,              ACTIONS::about.MakeEvent() );
 }
 
@@ -55,6 +55,7 @@ const wxChar* const traceSchSheetPaths = wxT( "KICAD_SCH_SHEET_PATHS" );
 const wxChar* const traceEnvVars = wxT( "KICAD_ENV_VARS" );
 const wxChar* const traceGalProfile = wxT( "KICAD_GAL_PROFILE" );
 const wxChar* const traceKiCad2Step = wxT( "KICAD2STEP" );
+const wxChar* const traceConnectivity = wxT( "KICAD_CONNECTIVITY" );
 
 
 wxString dump( const wxArrayString& aArray )
@@ -39,7 +39,13 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <gal/painter.h>
 
+#include <advanced_config.h>
 #include <core/profile.h>
+#include <core/thread_pool.h>
+#include <perf_trace.h>
+
+#include <algorithm>
+#include <unordered_set>
 
 #ifdef KICAD_GAL_PROFILE
 #include <wx/log.h>
@@ -137,6 +143,26 @@ private:
         newGroups[m_groupsSize++] = { aLayer, aGroup };
     }
 
+    /**
+     * Return the group id of the simplified proxy of the item on the given layer, or -1 if it
+     * has none.  Proxy groups are stored together with the regular ones, under a key outside
+     * of the range of the layer numbers.
+     *
+     * @see VIEW_ITEM::ViewGetProxyScale
+     */
+    int getProxyGroup( int aLayer ) const
+    {
+        return getGroup( aLayer + VIEW::VIEW_MAX_LAYERS );
+    }
+
+    /**
+     * Set the group id of the simplified proxy of the item on the given layer.
+     */
+    void setProxyGroup( int aLayer, int aGroup )
+    {
+        setGroup( aLayer + VIEW::VIEW_MAX_LAYERS, aGroup );
+    }
+
 
     /**
      * Remove all of the stored group ids. Forces recaching of the item.
@@ -172,12 +198,20 @@ private:
         for( int i = 0; i < m_groupsSize; ++i )
         {
             int orig_layer = m_groups[i].first;
+            int proxy_offset = 0;
+
+            if( orig_layer >= VIEW::VIEW_MAX_LAYERS )
+            {
+                proxy_offset = VIEW::VIEW_MAX_LAYERS;
+                orig_layer -= proxy_offset;
+            }
+
             int new_layer = orig_layer;
 
             if( aReorderMap.count( orig_layer ) )
                 new_layer = aReorderMap.at( orig_layer );
 
-            m_groups[i].first = new_layer;
+            m_groups[i].first = new_layer + proxy_offset;
         }
     }
 
@@ -316,6 +350,70 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 {
     int layers[VIEW_MAX_LAYERS], layers_count;
 
+    addItemData( aItem, aDrawPriority, layers, layers_count );
+
+    const BOX2I& bbox = aItem->m_viewPrivData->m_bbox;
+
+    for( int i = 0; i < layers_count; ++i )
+    {
+        VIEW_LAYER& l = m_layers[layers[i]];
+        l.items->Insert( aItem, bbox );
+        MarkTargetDirty( l.target );
+    }
+
+    SetVisible( aItem, true );
+    Update( aItem, KIGFX::INITIAL_ADD );
+}
+
+
+void VIEW::AddItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    // Repacking the trees of the layers costs about as much as inserting every item they
+    // already hold, so it's only worth it for batches which are large compared to the view
+    const size_t MIN_BULK_ITEMS = 64;
+
+    if( aItems.size() < MIN_BULK_ITEMS || aItems.size() * 4 < m_allItems->size() )
+    {
+        for( VIEW_ITEM* item : aItems )
+            VIEW::Add( item );
+
+        return;
+    }
+
+    std::vector<std::vector<std::pair<VIEW_ITEM*, BOX2I>>> layerItems( m_layers.size() );
+
+    m_allItems->reserve( m_allItems->size() + aItems.size() );
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        int layers[VIEW_MAX_LAYERS], layers_count;
+
+        addItemData( item, -1, layers, layers_count );
+
+        for( int i = 0; i < layers_count; ++i )
+            layerItems[layers[i]].emplace_back( item, item->m_viewPrivData->m_bbox );
+    }
+
+    for( size_t layer = 0; layer < layerItems.size(); ++layer )
+    {
+        if( layerItems[layer].empty() )
+            continue;
+
+        VIEW_LAYER& l = m_layers[layer];
+        l.items->BulkInsert( layerItems[layer] );
+        MarkTargetDirty( l.target );
+    }
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        SetVisible( item, true );
+        Update( item, KIGFX::INITIAL_ADD );
+    }
+}
+
+
+void VIEW::addItemData( VIEW_ITEM* aItem, int aDrawPriority, int aLayers[], int& aCount )
+{
     if( aDrawPriority < 0 )
         aDrawPriority = m_nextDrawPriority++;
 
@@ -328,26 +426,25 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 
     aItem->m_viewPrivData->m_view = this;
     aItem->m_viewPrivData->m_drawPriority = aDrawPriority;
-    const BOX2I bbox = aItem->ViewBBox();
-    aItem->m_viewPrivData->m_bbox = bbox;
+    aItem->m_viewPrivData->m_bbox = aItem->ViewBBox();
+
+    int layers[VIEW_MAX_LAYERS], layers_count;
 
     aItem->ViewGetLayers( layers, layers_count );
     aItem->viewPrivData()->saveLayers( layers, layers_count );
 
     m_allItems->push_back( aItem );
 
+    // Only pass on the valid layers
+    aCount = 0;
+
     for( int i = 0; i < layers_count; ++i )
     {
         wxCHECK2_MSG( layers[i] >= 0 && static_cast<unsigned>( layers[i] ) < m_layers.size(),
                       continue, wxS( "Invalid layer" ) );
 
-        VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Insert( aItem, bbox );
-        MarkTargetDirty( l.target );
+        aLayers[aCount++] = layers[i];
     }
-
-    SetVisible( aItem, true );
-    Update( aItem, KIGFX::INITIAL_ADD );
 }
 
 
@@ -364,26 +461,75 @@ void VIEW::Remove( VIEW_ITEM* aItem )
             aItem->m_viewPrivData->clearUpdateFlags();
         }
 
-        int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
-        aItem->m_viewPrivData->getLayers( layers, layers_count );
-        const BOX2I* bbox = &aItem->m_viewPrivData->m_bbox;
+        removeItemData( aItem );
+    }
+}
 
-        for( int i = 0; i < layers_count; ++i )
-        {
-            VIEW_LAYER& l = m_layers[layers[i]];
-            l.items->Remove( aItem, bbox );
-            MarkTargetDirty( l.target );
 
-            // Clear the GAL cache
-            int prevGroup = aItem->m_viewPrivData->getGroup( layers[i] );
+void VIEW::RemoveItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    std::unordered_set<VIEW_ITEM*> removed;
 
-            if( prevGroup >= 0 )
-                m_gal->DeleteGroup( prevGroup );
+    for( VIEW_ITEM* item : aItems )
+    {
+        if( item && item->m_viewPrivData )
+        {
+            wxCHECK2( item->m_viewPrivData->m_view == this, continue );
+            removed.insert( item );
         }
+    }
+
+    if( removed.empty() )
+        return;
+
+    // Compact the item list in a single pass rather than searching it for each item
+    auto newEnd = std::remove_if( m_allItems->begin(), m_allItems->end(),
+                                  [&]( VIEW_ITEM* aItem )
+                                  {
+                                      if( !removed.count( aItem ) )
+                                          return false;
+
+                                      aItem->m_viewPrivData->clearUpdateFlags();
+                                      return true;
+                                  } );
+
+    m_allItems->erase( newEnd, m_allItems->end() );
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        // Skip duplicates and items which weren't in the view
+        if( removed.erase( item ) )
+            removeItemData( item );
+    }
+}
+
+
+void VIEW::removeItemData( VIEW_ITEM* aItem )
+{
+    int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
+    aItem->m_viewPrivData->getLayers( layers, layers_count );
+    const BOX2I* bbox = &aItem->m_viewPrivData->m_bbox;
+
+    for( int i = 0; i < layers_count; ++i )
+    {
+        VIEW_LAYER& l = m_layers[layers[i]];
+        l.items->Remove( aItem, bbox );
+        MarkTargetDirty( l.target );
+
+        // Clear the GAL cache
+        int prevGroup = aItem->m_viewPrivData->getGroup( layers[i] );
 
-        aItem->m_viewPrivData->deleteGroups();
-        aItem->m_viewPrivData->m_view = nullptr;
+        if( prevGroup >= 0 )
+            m_gal->DeleteGroup( prevGroup );
+
+        int proxyGroup = aItem->m_viewPrivData->getProxyGroup( layers[i] );
+
+        if( proxyGroup >= 0 )
+            m_gal->DeleteGroup( proxyGroup );
     }
+
+    aItem->m_viewPrivData->deleteGroups();
+    aItem->m_viewPrivData->m_view = nullptr;
 }
 
 
@@ -729,10 +875,14 @@ struct VIEW::UPDATE_COLOR_VISITOR
         // Obtain the color that should be used for coloring the item
         const COLOR4D color = painter->GetSettings()->GetColor( aItem, layer );
         int           group = aItem->viewPrivData()->getGroup( layer );
+        int           proxyGroup = aItem->viewPrivData()->getProxyGroup( layer );
 
         if( group >= 0 )
             gal->ChangeGroupColor( group, color );
 
+        if( proxyGroup >= 0 )
+            gal->ChangeGroupColor( proxyGroup, color );
+
         return true;
     }
 
@@ -783,9 +933,13 @@ void VIEW::UpdateAllLayersColor()
             {
                 const COLOR4D color = m_painter->GetSettings()->GetColor( item, layers[i] );
                 int           group = viewData->getGroup( layers[i] );
+                int           proxyGroup = viewData->getProxyGroup( layers[i] );
 
                 if( group >= 0 )
                     m_gal->ChangeGroupColor( group, color );
+
+                if( proxyGroup >= 0 )
+                    m_gal->ChangeGroupColor( proxyGroup, color );
             }
         }
     }
@@ -806,10 +960,14 @@ struct VIEW::UPDATE_DEPTH_VISITOR
     bool operator()( VIEW_ITEM* aItem )
     {
         int group = aItem->viewPrivData()->getGroup( layer );
+        int proxyGroup = aItem->viewPrivData()->getProxyGroup( layer );
 
         if( group >= 0 )
             gal->ChangeGroupDepth( group, depth );
 
+        if( proxyGroup >= 0 )
+            gal->ChangeGroupDepth( proxyGroup, depth );
+
         return true;
     }
 
@@ -915,9 +1073,13 @@ void VIEW::UpdateAllLayersOrder()
             for( int i = 0; i < layers_count; ++i )
             {
                 int group = viewData->getGroup( layers[i] );
+                int proxyGroup = viewData->getProxyGroup( layers[i] );
 
                 if( group >= 0 )
                     m_gal->ChangeGroupDepth( group, m_layers[layers[i]].renderingOrder );
+
+                if( proxyGroup >= 0 )
+                    m_gal->ChangeGroupDepth( proxyGroup, m_layers[layers[i]].renderingOrder );
             }
         }
     }
@@ -1012,11 +1174,21 @@ void VIEW::redrawRect( const BOX2I& aRect )
             else if( l->hasNegatives )
                 m_gal->StartNegativesLayer();
 
+            // Items of cached layers are only drawn from their groups, which the GAL may
+            // draw all at once
+            bool batchGroups = IsCached( l->id );
+
+            if( batchGroups )
+                m_gal->BeginGroupBatch();
+
             l->items->Query( aRect, drawFunc );
 
             if( m_useDrawPriority )
                 drawFunc.deferredDraw();
 
+            if( batchGroups )
+                m_gal->EndGroupBatch();
+
             if( l->diffLayer )
                 m_gal->EndDiffLayer();
             else if( l->hasNegatives )
@@ -1050,15 +1222,36 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
         int group = viewData->getGroup( aLayer );
 
         if( group >= 0 )
+        {
+            int proxyGroup = viewData->getProxyGroup( aLayer );
+
+            if( proxyGroup >= 0 && m_scale < aItem->ViewGetProxyScale( aLayer, this ) )
+                group = proxyGroup;
+
             m_gal->DrawGroup( group );
+
+            if( m_collectStatistics )
+            {
+                m_statistics.m_layerItems[aLayer]++;
+                m_statistics.m_layerVertices[aLayer] += m_gal->GetGroupVertexCount( group );
+            }
+        }
         else
-            Update( aItem );
+        {
+            // The group is made by the next UpdateItems(), e.g. for a layer left out because
+            // its LOD hid it then
+            Update( aItem, REPAINT );
+            m_hasDeferredGroups = true;
+        }
     }
     else
     {
         // Immediate mode
         if( !m_painter->Draw( aItem, aLayer ) )
             aItem->ViewDraw( aLayer, this );  // Alternative drawing method
+
+        if( m_collectStatistics )
+            m_statistics.m_layerItems[aLayer]++;
     }
 }
 
@@ -1109,7 +1302,13 @@ struct VIEW::RECACHE_ITEM_VISITOR
         if( group >= 0 )
             gal->DeleteGroup( group );
 
+        int proxyGroup = viewData->getProxyGroup( layer );
+
+        if( proxyGroup >= 0 )
+            gal->DeleteGroup( proxyGroup );
+
         viewData->setGroup( layer, -1 );
+        viewData->setProxyGroup( layer, -1 );
         view->Update( aItem );
 
         return true;
@@ -1157,10 +1356,20 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
+    SCOPED_TRACE_ZONE traceZone( "View redraw" );
+
 #ifdef KICAD_GAL_PROFILE
     PROF_TIMER totalRealTime;
 #endif /* KICAD_GAL_PROFILE */
 
+    PROF_TIMER redrawTime;
+
+    if( m_collectStatistics )
+    {
+        m_statistics.m_layerItems.clear();
+        m_statistics.m_layerVertices.clear();
+    }
+
     VECTOR2D screenSize = m_gal->GetScreenPixelSize();
     BOX2D    rect( ToWorld( VECTOR2D( 0, 0 ) ),
                    ToWorld( screenSize ) - ToWorld( VECTOR2D( 0, 0 ) ) );
@@ -1181,6 +1390,9 @@ void VIEW::Redraw()
     // All targets were redrawn, so nothing is dirty
     MarkClean();
 
+    if( m_collectStatistics )
+        m_statistics.m_redrawTime = redrawTime.msecs();
+
 #ifdef KICAD_GAL_PROFILE
     totalRealTime.Stop();
     wxLogTrace( traceGalProfile, wxS( "VIEW::Redraw(): %.1f ms" ), totalRealTime.msecs() );
@@ -1245,6 +1457,8 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
     int layers[VIEW_MAX_LAYERS], layers_count;
     aItem->ViewGetLayers( layers, layers_count );
 
+    bool lazyLod = ADVANCED_CFG::GetCfg().m_LazyLodGroups;
+
     // Iterate through layers used by the item and recache it immediately
     for( int i = 0; i < layers_count; ++i )
     {
@@ -1253,9 +1467,18 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         if( IsCached( layerId ) )
         {
             if( aUpdateFlags & ( GEOMETRY | LAYERS | REPAINT ) )
-                updateItemGeometry( aItem, layerId );
+            {
+                // A layer the item isn't shown on at this zoom level is only drawn into its
+                // group once it is, see draw()
+                if( lazyLod && aItem->ViewGetLOD( layerId, this ) >= m_scale )
+                    deleteItemGroups( aItem, layerId );
+                else
+                    updateItemGeometry( aItem, layerId );
+            }
             else if( aUpdateFlags & COLOR )
+            {
                 updateItemColor( aItem, layerId );
+            }
         }
 
         // Mark those layers as dirty, so the VIEW will be refreshed
@@ -1293,10 +1516,35 @@ void VIEW::updateItemColor( VIEW_ITEM* aItem, int aLayer )
     // Obtain the color that should be used for coloring the item on the specific layerId
     const COLOR4D color = m_painter->GetSettings()->GetColor( aItem, aLayer );
     int group = viewData->getGroup( aLayer );
+    int proxyGroup = viewData->getProxyGroup( aLayer );
 
     // Change the color, only if it has group assigned
     if( group >= 0 )
         m_gal->ChangeGroupColor( group, color );
+
+    if( proxyGroup >= 0 )
+        m_gal->ChangeGroupColor( proxyGroup, color );
+}
+
+
+void VIEW::deleteItemGroups( VIEW_ITEM* aItem, int aLayer )
+{
+    VIEW_ITEM_DATA* viewData = aItem->viewPrivData();
+
+    if( !viewData )
+        return;
+
+    int group = viewData->getGroup( aLayer );
+    int proxyGroup = viewData->getProxyGroup( aLayer );
+
+    if( group >= 0 )
+        m_gal->DeleteGroup( group );
+
+    if( proxyGroup >= 0 )
+        m_gal->DeleteGroup( proxyGroup );
+
+    viewData->setGroup( aLayer, -1 );
+    viewData->setProxyGroup( aLayer, -1 );
 }
 
 
@@ -1327,6 +1575,29 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
         aItem->ViewDraw( aLayer, this ); // Alternative drawing method
 
     m_gal->EndGroup();
+
+    // Cache the simplified proxy drawn instead of the item when zoomed out
+    int proxyGroup = viewData->getProxyGroup( aLayer );
+
+    if( proxyGroup >= 0 )
+    {
+        m_gal->DeleteGroup( proxyGroup );
+        viewData->setProxyGroup( aLayer, -1 );
+    }
+
+    if( aItem->ViewGetProxyScale( aLayer, this ) > 0.0 )
+    {
+        proxyGroup = m_gal->BeginGroup();
+
+        bool drawn = m_painter->DrawProxy( aItem, aLayer );
+
+        m_gal->EndGroup();
+
+        if( drawn )
+            viewData->setProxyGroup( aLayer, proxyGroup );
+        else
+            m_gal->DeleteGroup( proxyGroup );
+    }
 }
 
 
@@ -1379,6 +1650,14 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
                 m_gal->DeleteGroup( prevGroup );
                 viewData->setGroup( l.id, -1 );
             }
+
+            int proxyGroup = viewData->getProxyGroup( layers[i] );
+
+            if( proxyGroup >= 0 )
+            {
+                m_gal->DeleteGroup( proxyGroup );
+                viewData->setProxyGroup( l.id, -1 );
+            }
         }
     }
 
@@ -1432,11 +1711,42 @@ void VIEW::RecacheAllItems()
 }
 
 
-void VIEW::UpdateItems()
+void VIEW::prepareItems()
+{
+    // Below this, preparing the items on the thread pool costs more than it saves
+    const size_t MIN_PARALLEL_ITEMS = 256;
+
+    if( !m_painter || !ADVANCED_CFG::GetCfg().m_ParallelViewUpdate )
+        return;
+
+    std::vector<const VIEW_ITEM*> items;
+
+    for( VIEW_ITEM* item : *m_allItems )
+    {
+        VIEW_ITEM_DATA* vpd = item->viewPrivData();
+
+        if( vpd && ( vpd->m_requiredUpdate & ( GEOMETRY | LAYERS | REPAINT | INITIAL_ADD ) ) )
+            items.push_back( item );
+    }
+
+    if( items.size() < MIN_PARALLEL_ITEMS )
+        return;
+
+    ParallelForEachIndex( items.size(),
+            [&]( size_t aIndex )
+            {
+                m_painter->PrepareItem( items[aIndex] );
+            } );
+}
+
+
+void VIEW::UpdateItems( double aTimeBudget )
 {
     if( !m_gal->IsVisible() || !m_gal->IsInitialized() )
         return;
 
+    m_hasDeferredGroups = false;
+
     unsigned int cntGeomUpdate = 0;
     bool         anyUpdated = false;
 
@@ -1501,23 +1811,84 @@ void VIEW::UpdateItems()
 
     if( anyUpdated )
     {
+        // The items left by a previous call were already prepared with the others
+        if( !m_hasPendingUpdates )
+            prepareItems();
+
         GAL_UPDATE_CONTEXT ctx( m_gal );
 
-        for( VIEW_ITEM* item : *m_allItems.get() )
+        if( aTimeBudget > 0.0 )
+        {
+            updateItemsWithinBudget( aTimeBudget );
+        }
+        else
         {
-            if( item->viewPrivData() && item->viewPrivData()->m_requiredUpdate != NONE )
+            for( VIEW_ITEM* item : *m_allItems.get() )
             {
-                invalidateItem( item, item->viewPrivData()->m_requiredUpdate );
-                item->viewPrivData()->m_requiredUpdate = NONE;
+                if( item->viewPrivData() && item->viewPrivData()->m_requiredUpdate != NONE )
+                {
+                    invalidateItem( item, item->viewPrivData()->m_requiredUpdate );
+                    item->viewPrivData()->m_requiredUpdate = NONE;
+                }
             }
+
+            m_hasPendingUpdates = false;
         }
     }
+    else
+    {
+        m_hasPendingUpdates = false;
+    }
 
     KI_TRACE( traceGalProfile, wxS( "View update: total items %u, geom %u anyUpdated %u\n" ), cntTotal,
               cntGeomUpdate, (unsigned) anyUpdated );
 }
 
 
+void VIEW::updateItemsWithinBudget( double aTimeBudget )
+{
+    // Reading the clock for every item would cost about as much as updating the small ones
+    const int TIME_CHECK_INTERVAL = 32;
+
+    PROF_TIMER timer;
+    BOX2D      viewport = GetViewport();
+    BOX2I      viewporti( viewport.GetPosition(), viewport.GetSize() );
+    int        count = 0;
+
+    if( viewport.GetWidth() > std::numeric_limits<int>::max()
+            || viewport.GetHeight() > std::numeric_limits<int>::max() )
+    {
+        viewporti.SetMaximum();
+    }
+
+    m_hasPendingUpdates = false;
+
+    // The items in the viewport are updated first, as the other ones aren't drawn anyway
+    for( int pass = 0; pass < 2 && !m_hasPendingUpdates; ++pass )
+    {
+        for( VIEW_ITEM* item : *m_allItems )
+        {
+            VIEW_ITEM_DATA* viewData = item->viewPrivData();
+
+            if( !viewData || viewData->m_requiredUpdate == NONE )
+                continue;
+
+            if( pass == 0 && !viewporti.Intersects( viewData->m_bbox ) )
+                continue;
+
+            if( ++count % TIME_CHECK_INTERVAL == 0 && timer.msecs() > aTimeBudget )
+            {
+                m_hasPendingUpdates = true;
+                break;
+            }
+
+            invalidateItem( item, viewData->m_requiredUpdate );
+            viewData->m_requiredUpdate = NONE;
+        }
+    }
+}
+
+
 void VIEW::UpdateAllItems( int aUpdateFlags )
 {
     for( VIEW_ITEM* item : *m_allItems )
@@ -36,6 +36,7 @@
 #include <wx/graphics.h>
 #include <wx/image.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>   // used only for debug
 #include <ctime>    // used for representation of x axes involving date
@@ -473,6 +474,10 @@ void mpFXY::Plot( wxDC& dc, mpWindow& w )
 
     dc.SetClippingRegion( startPx, minYpx, endPx - startPx + 1, maxYpx - minYpx + 1 );
 
+    // Don't enumerate the points which can't change the drawing
+    SetVisibleRange( m_scaleX->TransformFromPlot( w.p2x( startPx ) ),
+                     m_scaleX->TransformFromPlot( w.p2x( endPx ) ), endPx - startPx );
+
     if( !m_continuous )
     {
         bool first = true;
@@ -2459,18 +2464,182 @@ void mpFXYVector::Rewind()
 {
     m_index = 0;
     m_sweepWindow = std::numeric_limits<size_t>::max();
+    m_visibleOnly = false;
+    m_decimating = false;
 }
 
 
 void mpFXYVector::SetSweepWindow( int aSweepIdx )
 {
+    if( m_visibleOnly && m_sweepCount == 1 )
+    {
+        m_index = m_visibleBegin;
+        m_sweepWindow = m_visibleEnd;
+        m_decimating = !m_decimated.empty();
+        m_decimatedIndex = 0;
+        return;
+    }
+
     m_index = aSweepIdx * m_sweepSize;
     m_sweepWindow = ( aSweepIdx + 1 ) * m_sweepSize;
 }
 
 
+void mpFXYVector::SetVisibleRange( double aMinX, double aMaxX, int aPixels )
+{
+    m_visibleOnly = false;
+    m_decimated.clear();
+
+    if( !m_increasingX || m_xs.empty() || m_sweepCount != 1 || aPixels <= 0
+            || !std::isfinite( aMinX ) || !std::isfinite( aMaxX ) )
+    {
+        return;
+    }
+
+    if( aMinX > aMaxX )
+        std::swap( aMinX, aMaxX );
+
+    // Keep one point past each side, for the lines leaving the view
+    auto   first = std::lower_bound( m_xs.begin(), m_xs.end(), aMinX );
+    auto   last = std::upper_bound( first, m_xs.end(), aMaxX );
+    size_t begin = first - m_xs.begin();
+    size_t end = last - m_xs.begin();
+
+    if( begin > 0 )
+        begin--;
+
+    if( end < m_xs.size() )
+        end++;
+
+    m_visibleOnly = true;
+    m_visibleBegin = begin;
+    m_visibleEnd = end;
+
+    // Use the largest blocks which still hold no more than a pixel column of points
+    size_t perPixel = ( end - begin ) / aPixels;
+    int    level = -1;
+
+    while( level + 1 < (int) m_minMax.size() && ( DECIMATION_BLOCK << ( level + 1 ) ) <= perPixel )
+        level++;
+
+    if( level < 0 )
+        return;
+
+    const std::vector<MIN_MAX>& blocks = m_minMax[level];
+    size_t                      blockSize = DECIMATION_BLOCK << level;
+
+    m_decimated.reserve( 2 * ( ( end - begin ) / blockSize + 2 ) );
+    m_decimated.push_back( begin );
+
+    for( size_t ii = begin / blockSize; ii < blocks.size() && ii * blockSize < end; ++ii )
+    {
+        size_t lo = std::min( blocks[ii].m_min, blocks[ii].m_max );
+        size_t hi = std::max( blocks[ii].m_min, blocks[ii].m_max );
+
+        // The points must stay in order; the first block can start before the view
+        if( lo > m_decimated.back() && lo < end )
+            m_decimated.push_back( lo );
+
+        if( hi > m_decimated.back() && hi < end )
+            m_decimated.push_back( hi );
+    }
+
+    if( end - 1 > m_decimated.back() )
+        m_decimated.push_back( end - 1 );
+}
+
+
+void mpFXYVector::updateMinMax( size_t aFirst )
+{
+    if( !m_increasingX )
+    {
+        m_minMax.clear();
+        return;
+    }
+
+    size_t count = m_xs.size();
+    size_t first = aFirst / DECIMATION_BLOCK;
+
+    for( size_t level = 0; ; ++level )
+    {
+        size_t blockSize = DECIMATION_BLOCK << level;
+        size_t size = ( count + blockSize - 1 ) / blockSize;
+
+        // A single block can't spare any point
+        if( size < 2 )
+        {
+            m_minMax.resize( level );
+            break;
+        }
+
+        if( level == m_minMax.size() )
+        {
+            m_minMax.emplace_back();
+            first = 0;
+        }
+
+        std::vector<MIN_MAX>& blocks = m_minMax[level];
+        blocks.resize( size );
+
+        for( size_t ii = first; ii < size; ++ii )
+        {
+            MIN_MAX mm;
+
+            if( level == 0 )
+            {
+                size_t start = ii * blockSize;
+                size_t stop = std::min( count, start + blockSize );
+
+                mm = { start, start };
+
+                for( size_t jj = start + 1; jj < stop; ++jj )
+                {
+                    if( m_ys[jj] < m_ys[mm.m_min] )
+                        mm.m_min = jj;
+
+                    if( m_ys[jj] > m_ys[mm.m_max] )
+                        mm.m_max = jj;
+                }
+            }
+            else
+            {
+                const std::vector<MIN_MAX>& children = m_minMax[level - 1];
+
+                mm = children[2 * ii];
+
+                if( 2 * ii + 1 < children.size() )
+                {
+                    const MIN_MAX& other = children[2 * ii + 1];
+
+                    if( m_ys[other.m_min] < m_ys[mm.m_min] )
+                        mm.m_min = other.m_min;
+
+                    if( m_ys[other.m_max] > m_ys[mm.m_max] )
+                        mm.m_max = other.m_max;
+                }
+            }
+
+            blocks[ii] = mm;
+        }
+
+        first /= 2;
+    }
+}
+
+
 bool mpFXYVector::GetNextXY( double& x, double& y )
 {
+    if( m_decimating )
+    {
+        if( m_decimatedIndex >= m_decimated.size() )
+            return false;
+
+        size_t index = m_decimated[m_decimatedIndex++];
+        x = m_xs[index];
+        y = m_ys[index];
+        return true;
+    }
+
     if( m_index >= m_xs.size() || m_index >= m_sweepWindow )
     {
         return false;
@@ -2488,6 +2657,8 @@ void mpFXYVector::Clear()
 {
     m_xs.clear();
     m_ys.clear();
+    m_minMax.clear();
+    m_increasingX = true;
 }
 
 
@@ -2501,6 +2672,10 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
     m_xs    = xs;
     m_ys    = ys;
 
+    m_increasingX = std::is_sorted( m_xs.begin(), m_xs.end() );
+    m_minMax.clear();
+    updateMinMax( 0 );
+
     // Update internal variables for the bounding box.
     if( xs.size() > 0 )
     {
@@ -2537,6 +2712,46 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
 }
 
 
+void mpFXYVector::AppendData( const std::vector<double>& xs, const std::vector<double>& ys )
+{
+    if( xs.size() != ys.size() || xs.empty() )
+        return;
+
+    if( m_xs.empty() )
+    {
+        mpFXYVector::SetData( xs, ys );
+        return;
+    }
+
+    size_t first = m_xs.size();
+
+    m_increasingX = m_increasingX && xs.front() >= m_xs.back()
+                    && std::is_sorted( xs.begin(), xs.end() );
+
+    m_xs.insert( m_xs.end(), xs.begin(), xs.end() );
+    m_ys.insert( m_ys.end(), ys.begin(), ys.end() );
+    updateMinMax( first );
+
+    for( const double x : xs )
+    {
+        if( x < m_minX )
+            m_minX = x;
+
+        if( x > m_maxX )
+            m_maxX = x;
+    }
+
+    for( const double y : ys )
+    {
+        if( y < m_minY )
+            m_minY = y;
+
+        if( y > m_maxY )
+            m_maxY = y;
+    }
+}
+
+
 void mpFXY::SetScale( mpScaleBase* scaleX, mpScaleBase* scaleY )
 {
     m_scaleX    = scaleX;
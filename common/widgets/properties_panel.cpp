@@ -362,20 +362,66 @@ bool PROPERTIES_PANEL::extractValueAndWritability( const SELECTION& aSelection,
     bool              different = false;
     wxVariant         commonVal;
 
+    // Ints, enums and strings are compared straight from their getters, and only the common
+    // value is converted to a wxVariant.  Bools go through the wxVariant to keep their type.
+    bool     readStrings = aProperty->TypeHash() == TYPE_HASH( wxString );
+    bool     readInts = !readStrings
+                        && ( aProperty->HasChoices() || aProperty->TypeHash() == TYPE_HASH( int ) );
+    bool     haveTypedValue = false;
+    int      commonInt = 0;
+    wxString commonString;
+
     aWritable = true;
 
     for( EDA_ITEM* item : aSelection )
     {
-        if( !propMgr.IsAvailableFor( TYPE_HASH( *item ), aProperty, item ) )
+        TYPE_ID itemType = TYPE_HASH( *item );
+
+        if( !propMgr.IsAvailableFor( itemType, aProperty, item ) )
             return false;
 
         if( aProperty->IsHiddenFromPropertiesManager() )
             return false;
 
         // If read-only for any of the selection, read-only for the whole selection.
-        if( !propMgr.IsWriteableFor( TYPE_HASH( *item ), aProperty, item ) )
+        if( !propMgr.IsWriteableFor( itemType, aProperty, item ) )
             aWritable = false;
 
+        if( readInts || readStrings )
+        {
+            const void* object = propMgr.TypeCast( static_cast<const INSPECTABLE*>( item ),
+                                                   itemType, aProperty->OwnerHash() );
+            int         intValue = 0;
+            wxString    stringValue;
+
+            if( object && readInts && aProperty->GetInt( object, intValue ) )
+            {
+                if( haveTypedValue && intValue != commonInt )
+                    different = true;
+
+                commonInt = intValue;
+                haveTypedValue = true;
+                continue;
+            }
+            else if( object && readStrings && aProperty->GetString( object, stringValue ) )
+            {
+                if( haveTypedValue && stringValue != commonString )
+                    different = true;
+                else
+                    commonString = std::move( stringValue );
+
+                haveTypedValue = true;
+                continue;
+            }
+
+            // Not readable without the wxAny getter after all; go on with wxVariants
+            if( haveTypedValue && !different )
+                aValue = readInts ? wxVariant( commonInt ) : wxVariant( commonString );
+
+            readInts = false;
+            readStrings = false;
+        }
+
         wxVariant value;
 
         if( getItemValue( item, aProperty, value ) )
@@ -398,6 +444,14 @@ bool PROPERTIES_PANEL::extractValueAndWritability( const SELECTION& aSelection,
         }
     }
 
+    if( haveTypedValue && ( readInts || readStrings ) )
+    {
+        if( different )
+            aValue.MakeNull();
+        else
+            aValue = readInts ? wxVariant( commonInt ) : wxVariant( commonString );
+    }
+
     return true;
 }
 
@@ -24,6 +24,7 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <core/profile.h>
 #include <core/kicad_algo.h>
 #include <common.h>
@@ -66,6 +67,24 @@ static const wxChar DanglingProfileMask[] = wxT( "CONN_PROFILE" );
 static const wxChar ConnTrace[] = wxT( "CONN" );
 
 
+/**
+ * The markers created by the ERC checks of the subgraph being checked by this thread, when
+ * RunERC() checks the subgraphs in parallel.  They are added to their screens once all the
+ * subgraphs are checked, in the order of the subgraphs, so the markers come out as if the
+ * checks had been run one after the other.
+ */
+static thread_local std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>* t_ercMarkers = nullptr;
+
+
+static void addErcMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+{
+    if( t_ercMarkers )
+        t_ercMarkers->emplace_back( aScreen, aMarker );
+    else
+        aScreen->Append( aMarker );
+}
+
+
 void CONNECTION_SUBGRAPH::RemoveItem( SCH_ITEM* aItem )
 {
     m_items.erase( aItem );
@@ -703,92 +722,166 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
     PROF_TIMER update_items( "updateItemConnectivity" );
 
     m_sheetList = aSheetList;
-    std::set<SCH_ITEM*> dirty_items;
 
-    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    // What the update of each sheet adds to the graph, merged in the sheet order afterwards so
+    // the graph doesn't depend on the order the sheets were processed in
+    struct SHEET_UPDATE
     {
-        std::vector<SCH_ITEM*> items;
+        std::vector<SCH_ITEM*>                           m_items;
+        std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>> m_globalPowerPins;
+        std::vector<SCH_ITEM*>                           m_dirtyItems;
+    };
 
-        // Store current unit value, to replace it after calculations
-        std::vector<std::pair<SCH_SYMBOL*, int>> symbolsChanged;
+    std::vector<SHEET_UPDATE> updates( aSheetList.size() );
 
-        for( SCH_ITEM* item : sheet.LastScreen()->Items() )
-        {
-            if( item->IsConnectable() && ( aUnconditional || item->IsConnectivityDirty() ) )
+    // The paths to the same screen share its items, which hold the connections of all those
+    // paths.  They are updated one after the other, while different screens are independent.
+    std::vector<std::vector<size_t>>        screenSheets;
+    std::unordered_map<SCH_SCREEN*, size_t> screenIndex;
+
+    for( size_t ii = 0; ii < aSheetList.size(); ++ii )
+    {
+        auto [it, inserted] = screenIndex.emplace( aSheetList[ii].LastScreen(),
+                                                   screenSheets.size() );
+
+        if( inserted )
+            screenSheets.emplace_back();
+
+        screenSheets[it->second].push_back( ii );
+    }
+
+    std::mutex                       changedItemMutex;
+    std::function<void( SCH_ITEM* )> lockedChangedItemHandler =
+            [&]( SCH_ITEM* aItem )
             {
-                wxLogTrace( ConnTrace, wxT( "Adding item %s to connectivity graph update" ),
-                            item->GetTypeDesc() );
-                items.push_back( item );
-                dirty_items.insert( item );
+                std::lock_guard<std::mutex> lock( changedItemMutex );
+                ( *aChangedItemHandler )( aItem );
+            };
 
-                // Add any symbol dirty pins to the dirty_items list
-                if( item->Type() == SCH_SYMBOL_T )
-                {
-                    SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+    std::function<void( SCH_ITEM* )>* changedItemHandler =
+            aChangedItemHandler ? &lockedChangedItemHandler : nullptr;
+
+    auto updateSheet =
+            [&]( size_t aSheetIndex )
+            {
+                const SCH_SHEET_PATH& sheet = aSheetList[aSheetIndex];
+                SHEET_UPDATE&         update = updates[aSheetIndex];
+                std::vector<SCH_ITEM*> items;
 
-                    for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
+                // Store current unit value, to replace it after calculations
+                std::vector<std::pair<SCH_SYMBOL*, int>> symbolsChanged;
+
+                for( SCH_ITEM* item : sheet.LastScreen()->Items() )
+                {
+                    if( item->IsConnectable() && ( aUnconditional || item->IsConnectivityDirty() ) )
                     {
-                        if( pin->IsConnectivityDirty() )
+                        wxLogTrace( ConnTrace, wxT( "Adding item %s to connectivity graph update" ),
+                                    item->GetTypeDesc() );
+                        items.push_back( item );
+                        update.m_dirtyItems.push_back( item );
+
+                        // Add any symbol dirty pins to the dirty_items list
+                        if( item->Type() == SCH_SYMBOL_T )
                         {
-                            dirty_items.insert( pin );
+                            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+                            for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
+                            {
+                                if( pin->IsConnectivityDirty() )
+                                {
+                                    update.m_dirtyItems.push_back( pin );
+                                }
+                            }
                         }
                     }
-                }
-            }
-            // If the symbol isn't dirty, look at the pins
-            // TODO: remove symbols from connectivity graph and only use pins
-            else if( item->Type() == SCH_SYMBOL_T )
-            {
-                SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+                    // If the symbol isn't dirty, look at the pins
+                    // TODO: remove symbols from connectivity graph and only use pins
+                    else if( item->Type() == SCH_SYMBOL_T )
+                    {
+                        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
 
-                for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
-                {
-                    if( pin->IsConnectivityDirty() )
+                        for( SCH_PIN* pin : symbol->GetPins( &sheet ) )
+                        {
+                            if( pin->IsConnectivityDirty() )
+                            {
+                                items.push_back( pin );
+                                update.m_dirtyItems.push_back( pin );
+                            }
+                        }
+                    }
+                    else if( item->Type() == SCH_SHEET_T )
                     {
-                        items.push_back( pin );
-                        dirty_items.insert( pin );
+                        SCH_SHEET* sheet = static_cast<SCH_SHEET*>( item );
+
+                        for( SCH_SHEET_PIN* pin : sheet->GetPins() )
+                        {
+                            if( pin->IsConnectivityDirty() )
+                            {
+                                items.push_back( pin );
+                                update.m_dirtyItems.push_back( pin );
+                            }
+                        }
                     }
-                }
-            }
-            else if( item->Type() == SCH_SHEET_T )
-            {
-                SCH_SHEET* sheet = static_cast<SCH_SHEET*>( item );
 
-                for( SCH_SHEET_PIN* pin : sheet->GetPins() )
-                {
-                    if( pin->IsConnectivityDirty() )
+                    // Ensure the hierarchy info stored in the SCH_SCREEN (such as symbol units)
+                    // reflects the current SCH_SHEET_PATH
+                    if( item->Type() == SCH_SYMBOL_T )
                     {
-                        items.push_back( pin );
-                        dirty_items.insert( pin );
+                        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+                        int new_unit = symbol->GetUnitSelection( &sheet );
+
+                        // Store the initial unit value so we can restore it after calculations
+                        if( symbol->GetUnit() != new_unit )
+                            symbolsChanged.push_back( { symbol, symbol->GetUnit() } );
+
+                        symbol->UpdateUnit( new_unit );
                     }
                 }
-            }
 
-            // Ensure the hierarchy info stored in the SCH_SCREEN (such as symbol units) reflects
-            // the current SCH_SHEET_PATH
-            if( item->Type() == SCH_SYMBOL_T )
-            {
-                SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
-                int new_unit = symbol->GetUnitSelection( &sheet );
+                update.m_items.reserve( items.size() );
 
-                // Store the initial unit value so we can restore it after calculations
-                if( symbol->GetUnit() != new_unit )
-                    symbolsChanged.push_back( { symbol, symbol->GetUnit() } );
+                updateItemConnectivity( sheet, items, update.m_items, update.m_globalPowerPins );
 
-                symbol->UpdateUnit( new_unit );
-            }
-        }
+                // UpdateDanglingState() also adds connected items for SCH_TEXT
+                sheet.LastScreen()->TestDanglingEnds( &sheet, changedItemHandler );
+
+                // Restore the m_unit member variables where we had to change them
+                for( const auto& [ symbol, originalUnit ] : symbolsChanged )
+                    symbol->UpdateUnit( originalUnit );
+            };
+
+    auto updateScreen =
+            [&]( size_t aScreenIndex )
+            {
+                for( size_t sheetIndex : screenSheets[aScreenIndex] )
+                    updateSheet( sheetIndex );
+            };
+
+    // Only a full recalculation has enough work to be worth spreading over the thread pool
+    if( aUnconditional )
+    {
+        ParallelForEachIndex( screenSheets.size(), updateScreen );
+    }
+    else
+    {
+        for( size_t ii = 0; ii < screenSheets.size(); ++ii )
+            updateScreen( ii );
+    }
 
-        m_items.reserve( m_items.size() + items.size() );
+    std::set<SCH_ITEM*> dirty_items;
+    size_t              itemCount = m_items.size();
 
-        updateItemConnectivity( sheet, items );
+    for( const SHEET_UPDATE& update : updates )
+        itemCount += update.m_items.size();
 
-        // UpdateDanglingState() also adds connected items for SCH_TEXT
-        sheet.LastScreen()->TestDanglingEnds( &sheet, aChangedItemHandler );
+    m_items.reserve( itemCount );
 
-        // Restore the m_unit member variables where we had to change them
-        for( const auto& [ symbol, originalUnit ] : symbolsChanged )
-            symbol->UpdateUnit( originalUnit );
+    for( const SHEET_UPDATE& update : updates )
+    {
+        m_items.insert( m_items.end(), update.m_items.begin(), update.m_items.end() );
+        m_global_power_pins.insert( m_global_power_pins.end(), update.m_globalPowerPins.begin(),
+                                    update.m_globalPowerPins.end() );
+        dirty_items.insert( update.m_dirtyItems.begin(), update.m_dirtyItems.end() );
     }
 
     // Restore the danlging states of items in the current SCH_SCREEN to match the current
@@ -822,6 +915,13 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
     std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> retvals;
     std::set<CONNECTION_SUBGRAPH*> subgraphs;
 
+    // m_items is only compacted once at the end: erasing each item from it as it is found is
+    // quadratic when a change touches a large net
+    std::unordered_set<SCH_ITEM*>  removedItems;
+
+    // The changed items often share a net, which only needs to be scanned once
+    std::set<wxString>             scannedNets;
+
     auto traverse_subgraph = [&retvals, &subgraphs]( CONNECTION_SUBGRAPH* aSubgraph )
     {
         // Find the primary subgraph on this sheet
@@ -857,15 +957,26 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
                         aItem->GetTypeDesc(), item_sg->m_code, item_sg );
         }
 
-        std::vector<CONNECTION_SUBGRAPH*> sg_to_scan = GetAllSubgraphs( item_sg->GetNetName() );
+        std::vector<CONNECTION_SUBGRAPH*> sg_to_scan;
+        wxString                          netName = item_sg->GetNetName();
 
-        if( sg_to_scan.empty() )
+        if( scannedNets.insert( netName ).second )
         {
-            wxLogTrace( ConnTrace, wxT( "Item %s in subgraph %ld with net %s has no neighbors" ),
-                        aItem->GetTypeDesc(), item_sg->m_code, item_sg->GetNetName() );
-            sg_to_scan.push_back( item_sg );
+            sg_to_scan = GetAllSubgraphs( netName );
+
+            if( sg_to_scan.empty() )
+            {
+                wxLogTrace( ConnTrace,
+                            wxT( "Item %s in subgraph %ld with net %s has no neighbors" ),
+                            aItem->GetTypeDesc(), item_sg->m_code, netName );
+            }
         }
 
+        // The other subgraphs of an already scanned net have been collected; only this one
+        // may be missing if it isn't registered under its net name
+        if( sg_to_scan.empty() )
+            sg_to_scan.push_back( item_sg );
+
         wxLogTrace( ConnTrace,
                     wxT( "Removing all item %s connections from subgraph %ld with net %s: Found "
                          "%zu subgraphs" ),
@@ -890,7 +1001,7 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
             }
         }
 
-        alg::delete_matching( m_items, aItem );
+        removedItems.insert( aItem );
     };
 
     for( SCH_ITEM* item : aItems )
@@ -918,7 +1029,13 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
     removeSubgraphs( subgraphs );
 
     for( const auto& [path, item] : retvals )
-        alg::delete_matching( m_items, item );
+        removedItems.insert( item );
+
+    alg::delete_if( m_items,
+                    [&]( SCH_ITEM* aItem )
+                    {
+                        return removedItems.count( aItem ) > 0;
+                    } );
 
     return retvals;
 }
@@ -1101,7 +1218,10 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
 
 
 void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
-                                               const std::vector<SCH_ITEM*>& aItemList )
+                                               const std::vector<SCH_ITEM*>& aItemList,
+                                               std::vector<SCH_ITEM*>& aGraphItems,
+                                               std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>&
+                                                       aGlobalPowerPins )
 {
     wxLogTrace( wxT( "Updating connectivity for sheet %s with %zu items" ),
                 aSheet.Last()->GetFileName(), aItemList.size() );
@@ -1119,7 +1239,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
         if( aPin->IsGlobalPower() )
         {
             aConn->SetName( name );
-            m_global_power_pins.emplace_back( std::make_pair( aSheet, aPin ) );
+            aGlobalPowerPins.emplace_back( std::make_pair( aSheet, aPin ) );
         }
     };
 
@@ -1137,7 +1257,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                 pin->ClearConnectedItems( aSheet );
 
                 connection_map[ pin->GetTextPos() ].push_back( pin );
-                m_items.emplace_back( pin );
+                aGraphItems.emplace_back( pin );
             }
         }
         else if( item->Type() == SCH_SYMBOL_T )
@@ -1146,7 +1266,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
 
             for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
             {
-                m_items.emplace_back( pin );
+                aGraphItems.emplace_back( pin );
                 SCH_CONNECTION* conn = pin->InitializeConnection( aSheet, this );
                 updatePin( pin, conn );
                 connection_map[ pin->GetPosition() ].push_back( pin );
@@ -1154,7 +1274,7 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
         }
         else
         {
-            m_items.emplace_back( item );
+            aGraphItems.emplace_back( item );
             SCH_CONNECTION* conn = item->InitializeConnection( aSheet, this );
 
             // Set bus/net property here so that the propagation code uses it
@@ -1205,8 +1325,6 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
         // Pre-scan to see if we have a bus at this location
         SCH_LINE* busLine = aSheet.LastScreen()->GetBus( it.first );
 
-        std::mutex update_mutex;
-
         auto update_lambda = [&]( SCH_ITEM* connected_item ) -> size_t
         {
             // Bus entries are special: they can have connection points in the
@@ -1245,7 +1363,6 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
                         else
                             bus_entry->m_connected_bus_items[1] = busLine;
 
-                        std::lock_guard<std::mutex> lock( update_mutex );
                         bus_entry->AddConnectionTo( aSheet, busLine );
                         busLine->AddConnectionTo( aSheet, bus_entry );
                     }
@@ -1315,15 +1432,9 @@ void CONNECTION_GRAPH::updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
             return 1;
         };
 
-        thread_pool& tp = GetKiCadThreadPool();
-
-        tp.push_loop( connection_vec.size(),
-                [&]( const int a, const int b)
-                {
-                    for( int ii = a; ii < b; ++ii )
-                        update_lambda( connection_vec[ii] );
-                });
-        tp.wait_for_tasks();
+        // Only a few items meet at a point; the sheets are updated in parallel instead
+        for( SCH_ITEM* connected_item : connection_vec )
+            update_lambda( connected_item );
     }
 }
 
@@ -3122,6 +3233,7 @@ int CONNECTION_GRAPH::RunERC()
     // We don't want to run many ERC checks more than once on a given screen even though it may
     // represent multiple sheets with multiple subgraphs.  We can tell these apart by drivers.
     std::set<SCH_ITEM*> seenDriverInstances;
+    std::vector<CONNECTION_SUBGRAPH*> checkedSubgraphs;
 
     for( CONNECTION_SUBGRAPH* subgraph : m_subgraphs )
     {
@@ -3157,46 +3269,44 @@ int CONNECTION_GRAPH::RunERC()
         }
 
         subgraph->ResolveDrivers( false );
+        checkedSubgraphs.push_back( subgraph );
+    }
 
-        if( settings.IsTestEnabled( ERCE_BUS_TO_NET_CONFLICT ) )
-        {
-            if( !ercCheckBusToNetConflicts( subgraph ) )
-                error_count++;
-        }
+    // The drivers of all the subgraphs are resolved now, so the remaining checks only read the
+    // graph and can be run on several subgraphs at once.
+    if( ADVANCED_CFG::GetCfg().m_ParallelERC && checkedSubgraphs.size() > 1 )
+    {
+        std::vector<std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>> markers;
+        std::vector<int> errors( checkedSubgraphs.size(), 0 );
+        thread_pool&     tp = GetKiCadThreadPool();
 
-        if( settings.IsTestEnabled( ERCE_BUS_ENTRY_CONFLICT ) )
-        {
-            if( !ercCheckBusToBusEntryConflicts( subgraph ) )
-                error_count++;
-        }
+        markers.resize( checkedSubgraphs.size() );
 
-        if( settings.IsTestEnabled( ERCE_BUS_TO_BUS_CONFLICT ) )
-        {
-            if( !ercCheckBusToBusConflicts( subgraph ) )
-                error_count++;
-        }
+        tp.parallelize_loop( 0, checkedSubgraphs.size(),
+                [&]( size_t aStart, size_t aEnd )
+                {
+                    for( size_t ii = aStart; ii < aEnd; ++ii )
+                    {
+                        t_ercMarkers = &markers[ii];
+                        errors[ii] = ercCheckSubgraph( checkedSubgraphs[ii] );
+                    }
 
-        if( settings.IsTestEnabled( ERCE_WIRE_DANGLING ) )
-        {
-            if( !ercCheckFloatingWires( subgraph ) )
-                error_count++;
-        }
+                    t_ercMarkers = nullptr;
+                } ).wait();
 
-        if( settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED )
-                || settings.IsTestEnabled( ERCE_NOCONNECT_NOT_CONNECTED )
-                || settings.IsTestEnabled( ERCE_PIN_NOT_CONNECTED ) )
+        for( size_t ii = 0; ii < checkedSubgraphs.size(); ++ii )
         {
-            if( !ercCheckNoConnects( subgraph ) )
-                error_count++;
-        }
+            for( const auto& [ screen, marker ] : markers[ii] )
+                screen->Append( marker );
 
-        if( settings.IsTestEnabled( ERCE_LABEL_NOT_CONNECTED )
-                || settings.IsTestEnabled( ERCE_GLOBLABEL ) )
-        {
-            if( !ercCheckLabels( subgraph ) )
-                error_count++;
+            error_count += errors[ii];
         }
     }
+    else
+    {
+        for( CONNECTION_SUBGRAPH* subgraph : checkedSubgraphs )
+            error_count += ercCheckSubgraph( subgraph );
+    }
 
     // Hierarchical sheet checking is done at the schematic level
     if( settings.IsTestEnabled( ERCE_HIERACHICAL_LABEL )
@@ -3218,6 +3328,54 @@ int CONNECTION_GRAPH::RunERC()
 }
 
 
+int CONNECTION_GRAPH::ercCheckSubgraph( const CONNECTION_SUBGRAPH* aSubgraph )
+{
+    ERC_SETTINGS& settings = m_schematic->ErcSettings();
+    int           error_count = 0;
+
+    if( settings.IsTestEnabled( ERCE_BUS_TO_NET_CONFLICT ) )
+    {
+        if( !ercCheckBusToNetConflicts( aSubgraph ) )
+            error_count++;
+    }
+
+    if( settings.IsTestEnabled( ERCE_BUS_ENTRY_CONFLICT ) )
+    {
+        if( !ercCheckBusToBusEntryConflicts( aSubgraph ) )
+            error_count++;
+    }
+
+    if( settings.IsTestEnabled( ERCE_BUS_TO_BUS_CONFLICT ) )
+    {
+        if( !ercCheckBusToBusConflicts( aSubgraph ) )
+            error_count++;
+    }
+
+    if( settings.IsTestEnabled( ERCE_WIRE_DANGLING ) )
+    {
+        if( !ercCheckFloatingWires( aSubgraph ) )
+            error_count++;
+    }
+
+    if( settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED )
+            || settings.IsTestEnabled( ERCE_NOCONNECT_NOT_CONNECTED )
+            || settings.IsTestEnabled( ERCE_PIN_NOT_CONNECTED ) )
+    {
+        if( !ercCheckNoConnects( aSubgraph ) )
+            error_count++;
+    }
+
+    if( settings.IsTestEnabled( ERCE_LABEL_NOT_CONNECTED )
+            || settings.IsTestEnabled( ERCE_GLOBLABEL ) )
+    {
+        if( !ercCheckLabels( aSubgraph ) )
+            error_count++;
+    }
+
+    return error_count;
+}
+
+
 bool CONNECTION_GRAPH::ercCheckMultipleDrivers( const CONNECTION_SUBGRAPH* aSubgraph )
 {
     wxCHECK( aSubgraph, false );
@@ -3357,7 +3515,7 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
         ercItem->SetItems( net_item, bus_item );
 
         SCH_MARKER* marker = new SCH_MARKER( ercItem, net_item->GetPosition() );
-        screen->Append( marker );
+        addErcMarker( screen, marker );
 
         return false;
     }
@@ -3425,7 +3583,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
             ercItem->SetItems( label, port );
 
             SCH_MARKER* marker = new SCH_MARKER( ercItem, label->GetPosition() );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             return false;
         }
@@ -3530,7 +3688,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
         ercItem->SetErrorMessage( msg );
 
         SCH_MARKER* marker = new SCH_MARKER( ercItem, bus_entry->GetPosition() );
-        screen->Append( marker );
+        addErcMarker( screen, marker );
 
         return false;
     }
@@ -3645,7 +3803,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
             }
 
             SCH_MARKER* marker = new SCH_MARKER( ercItem, pos );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             ok = false;
         }
@@ -3659,7 +3817,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
             ercItem->SetItemsSheetPaths( sheet );
 
             SCH_MARKER* marker = new SCH_MARKER( ercItem, aSubgraph->m_no_connect->GetPosition() );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             ok = false;
         }
@@ -3753,7 +3911,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
             ercItem->SetItems( pin );
 
             SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetTransformedPosition() );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             ok = false;
         }
@@ -3779,7 +3937,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem,
                                                          testPin->GetTransformedPosition() );
-                    screen->Append( marker );
+                    addErcMarker( screen, marker );
 
                     ok = false;
                 }
@@ -3821,7 +3979,7 @@ bool CONNECTION_GRAPH::ercCheckFloatingWires( const CONNECTION_SUBGRAPH* aSubgra
                            wires.size() > 3 ? wires[3] : nullptr );
 
         SCH_MARKER* marker = new SCH_MARKER( ercItem, wires[0]->GetPosition() );
-        screen->Append( marker );
+        addErcMarker( screen, marker );
 
         return false;
     }
@@ -3875,7 +4033,7 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph )
             ercItem->SetItems( aText );
 
             SCH_MARKER* marker = new SCH_MARKER( ercItem, aText->GetPosition() );
-            aSubgraph->m_sheet.LastScreen()->Append( marker );
+            addErcMarker( aSubgraph->m_sheet.LastScreen(), marker );
         }
     };
 
@@ -489,13 +489,19 @@ private:
      * checks to ensure that the items should actually connect, the items are
      * linked together using ConnectedItems().
      *
-     * As a side effect, items are loaded into m_items for BuildConnectionGraph().
+     * The items to load into m_items for BuildConnectionGraph() are returned rather than added,
+     * so different sheets can be updated at the same time.
      *
      * @param aSheet is the path to the sheet of all items in the list.
      * @param aItemList is a list of items to consider.
+     * @param aGraphItems receives the items to add to m_items.
+     * @param aGlobalPowerPins receives the pins to add to m_global_power_pins.
      */
     void updateItemConnectivity( const SCH_SHEET_PATH& aSheet,
-                                 const std::vector<SCH_ITEM*>& aItemList );
+                                 const std::vector<SCH_ITEM*>& aItemList,
+                                 std::vector<SCH_ITEM*>& aGraphItems,
+                                 std::vector<std::pair<SCH_SHEET_PATH, SCH_PIN*>>&
+                                         aGlobalPowerPins );
 
     /**
      * Generate the connection graph (after all item connectivity has been updated).
@@ -622,6 +628,16 @@ private:
      */
     bool ercCheckMultipleDrivers( const CONNECTION_SUBGRAPH* aSubgraph );
 
+    /**
+     * Run the checks of a subgraph which only read the graph once its drivers are resolved.
+     *
+     * These are run for several subgraphs at once on the thread pool: the markers they create
+     * are kept aside and added to their screens by RunERC() afterwards.
+     *
+     * @return the number of checks which failed.
+     */
+    int ercCheckSubgraph( const CONNECTION_SUBGRAPH* aSubgraph );
+
     bool ercCheckNetclassConflicts( const std::vector<CONNECTION_SUBGRAPH*>& subgraphs );
 
     /**
@@ -20,6 +20,8 @@
 
 #include "eeschema_jobs_handler.h"
 #include <common.h>
+#include <core/thread_pool.h>
+#include <set>
 #include <pgm_base.h>
 #include <cli/exit_codes.h>
 #include <sch_plotter.h>
@@ -29,6 +31,7 @@
 #include <jobs/job_export_sch_netlist.h>
 #include <jobs/job_export_sch_plot.h>
 #include <jobs/job_sch_erc.h>
+#include <jobs/job_export_cache.h>
 #include <jobs/job_sym_export_svg.h>
 #include <jobs/job_sym_upgrade.h>
 #include <schematic.h>
@@ -46,6 +49,7 @@
 #include <plotters/plotters_pslike.h>
 #include <drawing_sheet/ds_data_model.h>
 #include <reporter.h>
+#include <richio.h>
 #include <string_utils.h>
 
 #include <settings/settings_manager.h>
@@ -657,9 +661,108 @@ int EESCHEMA_JOBS_HANDLER::JobExportPythonBom( JOB* aJob )
 }
 
 
-int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG*         aSvgJob,
-                                           KIGFX::SCH_RENDER_SETTINGS* aRenderSettings,
-                                           LIB_SYMBOL*                 symbol )
+/**
+ * @return the name of the SVG file of \a aUnit and \a aBodyStyle of \a aSymbol.
+ */
+static wxFileName symbolSvgFileName( const JOB_SYM_EXPORT_SVG* aSvgJob,
+                                     const LIB_SYMBOL* aSymbol, int aUnit, int aBodyStyle )
+{
+    wxString   filename;
+    wxFileName fn;
+    size_t     forbidden_char;
+
+    fn.SetPath( aSvgJob->m_outputDirectory );
+    fn.SetExt( FILEEXT::SVGFileExtension );
+
+    filename = aSymbol->GetName().Lower();
+
+    while( wxString::npos
+           != ( forbidden_char = filename.find_first_of(
+                        wxFileName::GetForbiddenChars( wxPATH_DOS ) ) ) )
+    {
+        filename = filename.replace( forbidden_char, 1, wxS( '_' ) );
+    }
+
+    //simplify the name if its single unit
+    if( aSymbol->GetUnitCount() > 1 )
+        filename += wxString::Format( "_%d", aUnit );
+
+    if( aBodyStyle == 2 )
+        filename += wxS( "_demorgan" );
+
+    fn.SetName( filename );
+    return fn;
+}
+
+
+/**
+ * Plot \a aUnit and \a aBodyStyle of \a aSymbol to \a aFileName.
+ *
+ * This only reads the symbols, so the files of a library are plotted in parallel.
+ */
+static bool plotSymbolSvg( const JOB_SYM_EXPORT_SVG* aSvgJob, COLOR_SETTINGS* aColors,
+                           LIB_SYMBOL* aSymbol, LIB_SYMBOL* aSymbolToPlot, int aUnit,
+                           int aBodyStyle, const wxString& aFileName )
+{
+    // Each plot has its own render settings, as the plotter may change them
+    KIGFX::SCH_RENDER_SETTINGS renderSettings;
+    renderSettings.LoadColors( aColors );
+    renderSettings.SetDefaultPenWidth( DEFAULT_LINE_WIDTH_MILS * schIUScale.IU_PER_MILS );
+
+    // Get the symbol bounding box to fit the plot page to it
+    BOX2I     symbolBB = aSymbol->Flatten()->GetUnitBoundingBox( aUnit, aBodyStyle,
+                                                                 !aSvgJob->m_includeHiddenFields );
+    PAGE_INFO pageInfo( PAGE_INFO::Custom );
+    pageInfo.SetHeightMils( schIUScale.IUToMils( symbolBB.GetHeight() * 1.2 ) );
+    pageInfo.SetWidthMils( schIUScale.IUToMils( symbolBB.GetWidth() * 1.2 ) );
+
+    SVG_PLOTTER* plotter = new SVG_PLOTTER();
+    plotter->SetRenderSettings( &renderSettings );
+    plotter->SetPageSettings( pageInfo );
+    plotter->SetColorMode( !aSvgJob->m_blackAndWhite );
+
+    VECTOR2I     plot_offset = symbolBB.GetCenter();
+    const double scale = 1.0;
+
+    // Currently, plot units are in decimal
+    plotter->SetViewport( plot_offset, schIUScale.IU_PER_MILS / 10, scale, false );
+
+    plotter->SetCreator( wxT( "Eeschema-SVG" ) );
+
+    if( !plotter->OpenFile( aFileName ) )
+    {
+        delete plotter;
+        return false;
+    }
+
+    plotter->StartPlot( wxT( "1" ) );
+
+    bool      background = true;
+    TRANSFORM temp; // Uses default transform
+    VECTOR2I  plotPos;
+
+    plotPos.x = pageInfo.GetWidthIU( schIUScale.IU_PER_MILS ) / 2;
+    plotPos.y = pageInfo.GetHeightIU( schIUScale.IU_PER_MILS ) / 2;
+
+    // note, we want the fields from the original symbol pointer (in case of non-alias)
+    aSymbolToPlot->Plot( plotter, aUnit, aBodyStyle, background, plotPos, temp, false );
+    aSymbol->PlotLibFields( plotter, aUnit, aBodyStyle, background, plotPos, temp, false,
+                            aSvgJob->m_includeHiddenFields );
+
+    aSymbolToPlot->Plot( plotter, aUnit, aBodyStyle, !background, plotPos, temp, false );
+    aSymbol->PlotLibFields( plotter, aUnit, aBodyStyle, !background, plotPos, temp, false,
+                            aSvgJob->m_includeHiddenFields );
+
+    plotter->EndPlot();
+    delete plotter;
+
+    return true;
+}
+
+
+int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, COLOR_SETTINGS* aColors,
+                                           LIB_SYMBOL* symbol,
+                                           std::vector<SYMBOL_SVG_PLOT>& aPlots )
 {
     wxASSERT( symbol != nullptr );
 
@@ -681,116 +784,36 @@ int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG*         aSvgJob,
         }
     }
 
-    if( aSvgJob->m_includeHiddenPins )
-    {
-        // horrible hack, TODO overhaul the Plot method to handle this
-        for( LIB_ITEM& item : symbolToPlot->GetDrawItems() )
-        {
-            if( item.Type() != LIB_PIN_T )
-                continue;
-
-            LIB_PIN& pin = static_cast<LIB_PIN&>( item );
-            pin.SetVisible( true );
-        }
-    }
+    thread_pool& tp = GetKiCadThreadPool();
 
     // iterate from unit 1, unit 0 would be "all units" which we don't want
     for( int unit = 1; unit < symbol->GetUnitCount() + 1; unit++ )
     {
         for( int bodyStyle = 1; bodyStyle < ( symbol->HasAlternateBodyStyle() ? 2 : 1 ) + 1; ++bodyStyle )
         {
-            wxString   filename;
-            wxFileName fn;
-            size_t     forbidden_char;
-
-            fn.SetPath( aSvgJob->m_outputDirectory );
-            fn.SetExt( FILEEXT::SVGFileExtension );
+            wxString fileName = symbolSvgFileName( aSvgJob, symbol, unit, bodyStyle ).GetFullPath();
 
-            filename = symbol->GetName().Lower();
-
-            while( wxString::npos
-                   != ( forbidden_char = filename.find_first_of(
-                                wxFileName::GetForbiddenChars( wxPATH_DOS ) ) ) )
-            {
-                filename = filename.replace( forbidden_char, 1, wxS( '_' ) );
-            }
-
-            //simplify the name if its single unit
             if( symbol->GetUnitCount() > 1 )
             {
-                filename += wxString::Format( "_%d", unit );
-
-                if( bodyStyle == 2 )
-                    filename += wxS( "_demorgan" );
-
-                fn.SetName( filename );
                 m_reporter->Report( wxString::Format( _( "Plotting symbol '%s' unit %d to '%s'\n" ),
-                                                      symbol->GetName(), unit, fn.GetFullPath() ),
+                                                      symbol->GetName(), unit, fileName ),
                                     RPT_SEVERITY_ACTION );
             }
             else
             {
-                if( bodyStyle == 2 )
-                    filename += wxS( "_demorgan" );
-
-                fn.SetName( filename );
                 m_reporter->Report( wxString::Format( _( "Plotting symbol '%s' to '%s'\n" ),
-                                                      symbol->GetName(), fn.GetFullPath() ),
+                                                      symbol->GetName(), fileName ),
                                     RPT_SEVERITY_ACTION );
             }
 
-            // Get the symbol bounding box to fit the plot page to it
-            BOX2I     symbolBB = symbol->Flatten()->GetUnitBoundingBox( unit, bodyStyle, !aSvgJob->m_includeHiddenFields );
-            PAGE_INFO pageInfo( PAGE_INFO::Custom );
-            pageInfo.SetHeightMils( schIUScale.IUToMils( symbolBB.GetHeight() * 1.2 ) );
-            pageInfo.SetWidthMils( schIUScale.IUToMils( symbolBB.GetWidth() * 1.2 ) );
-
-            SVG_PLOTTER* plotter = new SVG_PLOTTER();
-            plotter->SetRenderSettings( aRenderSettings );
-            plotter->SetPageSettings( pageInfo );
-            plotter->SetColorMode( !aSvgJob->m_blackAndWhite );
-
-            VECTOR2I     plot_offset = symbolBB.GetCenter();
-            const double scale = 1.0;
-
-            // Currently, plot units are in decimal
-            plotter->SetViewport( plot_offset, schIUScale.IU_PER_MILS / 10, scale, false );
-
-            plotter->SetCreator( wxT( "Eeschema-SVG" ) );
-
-            if( !plotter->OpenFile( fn.GetFullPath() ) )
-            {
-                m_reporter->Report(
-                        wxString::Format( _( "Unable to open destination '%s'" ) + wxS( "\n" ),
-                                                      fn.GetFullPath() ),
-                                    RPT_SEVERITY_ERROR );
-
-                delete plotter;
-                return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
-            }
-
-            LOCALE_IO toggle;
-
-            plotter->StartPlot( wxT( "1" ) );
-
-            bool      background = true;
-            TRANSFORM temp; // Uses default transform
-            VECTOR2I  plotPos;
-
-            plotPos.x = pageInfo.GetWidthIU( schIUScale.IU_PER_MILS ) / 2;
-            plotPos.y = pageInfo.GetHeightIU( schIUScale.IU_PER_MILS ) / 2;
-
-            // note, we want the fields from the original symbol pointer (in case of non-alias)
-            symbolToPlot->Plot( plotter, unit, bodyStyle, background, plotPos, temp, false );
-            symbol->PlotLibFields( plotter, unit, bodyStyle, background, plotPos, temp, false,
-                                   aSvgJob->m_includeHiddenFields );
-
-            symbolToPlot->Plot( plotter, unit, bodyStyle, !background, plotPos, temp, false );
-            symbol->PlotLibFields( plotter, unit, bodyStyle, !background, plotPos, temp, false,
-                                   aSvgJob->m_includeHiddenFields );
-
-            plotter->EndPlot();
-            delete plotter;
+            aPlots.push_back( { symbol->GetName(), fileName,
+                                tp.submit(
+                                        [=]() -> bool
+                                        {
+                                            return plotSymbolSvg( aSvgJob, aColors, symbol,
+                                                                  symbolToPlot, unit, bodyStyle,
+                                                                  fileName );
+                                        } ) } );
         }
     }
 
@@ -840,31 +863,138 @@ int EESCHEMA_JOBS_HANDLER::JobSymExportSvg( JOB* aJob )
         wxFileName::Mkdir( svgJob->m_outputDirectory );
     }
 
-    KIGFX::SCH_RENDER_SETTINGS renderSettings;
+    // The color theme is loaded once here, the plots running in parallel only read it
     COLOR_SETTINGS* cs = Pgm().GetSettingsManager().GetColorSettings( svgJob->m_colorTheme );
-    renderSettings.LoadColors( cs );
-    renderSettings.SetDefaultPenWidth( DEFAULT_LINE_WIDTH_MILS * schIUScale.IU_PER_MILS );
 
-    int exitCode = CLI::EXIT_CODES::OK;
+    JOB_EXPORT_CACHE cache( svgJob->m_outputDirectory );
+    wxString         options = wxString::Format( wxS( "%s %d %d %d" ), svgJob->m_colorTheme,
+                                                 svgJob->m_blackAndWhite ? 1 : 0,
+                                                 svgJob->m_includeHiddenPins ? 1 : 0,
+                                                 svgJob->m_includeHiddenFields ? 1 : 0 );
+
+    if( svgJob->m_skipUnchanged )
+        cache.Load();
+
+    // The plots use the C locale, which is process wide: set it here for all of them
+    LOCALE_IO                    toggle;
+    std::vector<SYMBOL_SVG_PLOT> plots;
+    std::map<wxString, std::string> hashes;
+    int                          exitCode = CLI::EXIT_CODES::OK;
+
+    auto showHiddenPins =
+            [&]( LIB_SYMBOL* aSymbol )
+            {
+                // horrible hack, TODO overhaul the Plot method to handle this
+                // The root symbol is shared by its aliases, so this is done for all the symbols
+                // before the first plot starts
+                LIB_SYMBOL_SPTR root = aSymbol->IsAlias() ? aSymbol->GetRootSymbol() : nullptr;
+
+                for( LIB_ITEM& item : ( root ? root.get() : aSymbol )->GetDrawItems() )
+                {
+                    if( item.Type() != LIB_PIN_T )
+                        continue;
+
+                    LIB_PIN& pin = static_cast<LIB_PIN&>( item );
+                    pin.SetVisible( true );
+                }
+            };
+
+    auto exportSymbol =
+            [&]( LIB_SYMBOL* aSymbol ) -> int
+            {
+                if( svgJob->m_skipUnchanged )
+                {
+                    // Aliases are plotted with the draw items of their root symbol
+                    STRING_FORMATTER formatter;
+                    SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( aSymbol, formatter );
+
+                    if( aSymbol->IsAlias() )
+                    {
+                        if( LIB_SYMBOL_SPTR parent = aSymbol->GetRootSymbol() )
+                            SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( parent.get(), formatter );
+                    }
+
+                    std::string hash = JOB_EXPORT_CACHE::Hash( options, formatter.GetString() );
+                    bool        upToDate = cache.IsUpToDate( aSymbol->GetName(), hash );
+
+                    for( int unit = 1; upToDate && unit < aSymbol->GetUnitCount() + 1; unit++ )
+                    {
+                        for( int bodyStyle = 1;
+                             bodyStyle < ( aSymbol->HasAlternateBodyStyle() ? 2 : 1 ) + 1;
+                             ++bodyStyle )
+                        {
+                            if( !symbolSvgFileName( svgJob, aSymbol, unit, bodyStyle )
+                                         .FileExists() )
+                            {
+                                upToDate = false;
+                            }
+                        }
+                    }
+
+                    if( upToDate )
+                        return CLI::EXIT_CODES::OK;
+
+                    hashes[aSymbol->GetName()] = hash;
+                }
+
+                return doSymExportSvg( svgJob, cs, aSymbol, plots );
+            };
 
     if( symbol )
     {
-        exitCode = doSymExportSvg( svgJob, &renderSettings, symbol );
+        if( svgJob->m_includeHiddenPins )
+            showHiddenPins( symbol );
+
+        exitCode = exportSymbol( symbol );
     }
     else
     {
         // Just plot all the symbols we can
+        schLibrary.ParseAll();
+
         const LIB_SYMBOL_MAP& libSymMap = schLibrary.GetSymbolMap();
 
+        if( svgJob->m_includeHiddenPins )
+        {
+            for( const std::pair<const wxString, LIB_SYMBOL*>& entry : libSymMap )
+                showHiddenPins( entry.second );
+        }
+
         for( const std::pair<const wxString, LIB_SYMBOL*>& entry : libSymMap )
         {
-            exitCode = doSymExportSvg( svgJob, &renderSettings, entry.second );
+            exitCode = exportSymbol( entry.second );
 
             if( exitCode != CLI::EXIT_CODES::OK )
                 break;
         }
     }
 
+    // Wait for all the plots, as they use the library
+    for( SYMBOL_SVG_PLOT& plot : plots )
+    {
+        if( plot.m_result.get() )
+            continue;
+
+        m_reporter->Report( wxString::Format( _( "Unable to open destination '%s'" ) + wxS( "\n" ),
+                                              plot.m_fileName ),
+                            RPT_SEVERITY_ERROR );
+
+        hashes.erase( plot.m_symbolName );
+        exitCode = CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    if( svgJob->m_skipUnchanged )
+    {
+        for( const auto& [name, hash] : hashes )
+            cache.SetHash( name, hash );
+
+        if( !cache.Save() )
+        {
+            m_reporter->Report( _( "Unable to save the symbol hashes" ) + wxS( "\n" ),
+                                RPT_SEVERITY_WARNING );
+        }
+    }
+
     return exitCode;
 }
 
@@ -964,6 +1094,9 @@ int EESCHEMA_JOBS_HANDLER::JobSchErc( JOB* aJob )
     if( !ercJob )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
+    if( ercJob->m_filenames.size() > 1 )
+        return doBatchSchErc( ercJob );
+
     SCHEMATIC* sch = EESCHEMA_HELPERS::LoadSchematic( ercJob->m_filename, SCH_IO_MGR::SCH_KICAD, true );
 
     if( sch == nullptr )
@@ -972,8 +1105,6 @@ int EESCHEMA_JOBS_HANDLER::JobSchErc( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
     }
 
-    sch->Prj().ApplyTextVars( aJob->GetVarOverrides() );
-
     if( ercJob->m_outputFile.IsEmpty() )
     {
         wxFileName fn = sch->GetFileName();
@@ -987,9 +1118,90 @@ int EESCHEMA_JOBS_HANDLER::JobSchErc( JOB* aJob )
         ercJob->m_outputFile = fn.GetFullName();
     }
 
+    return doSchErc( ercJob, sch, ercJob->m_outputFile );
+}
+
+
+int EESCHEMA_JOBS_HANDLER::doBatchSchErc( JOB_SCH_ERC* aErcJob )
+{
+    // The kifaces, the global symbol library table and the settings are loaded once for all
+    // the schematics, which are checked one after the other.
+    std::set<wxString> reports;
+    int                exitCode = CLI::EXIT_CODES::SUCCESS;
+
+    auto addResult =
+            [&]( int aResult )
+            {
+                // Keep the first hard error, which outranks rule violations
+                if( aResult != CLI::EXIT_CODES::SUCCESS
+                        && ( exitCode == CLI::EXIT_CODES::SUCCESS
+                             || exitCode == CLI::EXIT_CODES::ERR_RC_VIOLATIONS ) )
+                {
+                    exitCode = aResult;
+                }
+            };
+
+    if( !aErcJob->m_outputFile.IsEmpty() && !wxFileName::DirExists( aErcJob->m_outputFile )
+            && !wxFileName::Mkdir( aErcJob->m_outputFile, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to create output directory %s\n" ),
+                                              aErcJob->m_outputFile ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    for( wxString filename : aErcJob->m_filenames )
+    {
+        wxFileName reportFn( aErcJob->m_outputFile, wxFileName( filename ).GetName() );
+
+        if( aErcJob->m_format == JOB_SCH_ERC::OUTPUT_FORMAT::JSON )
+            reportFn.SetExt( FILEEXT::JsonFileExtension );
+        else
+            reportFn.SetExt( FILEEXT::ReportFileExtension );
+
+        if( !reports.insert( reportFn.GetFullPath() ).second )
+        {
+            m_reporter->Report( wxString::Format( _( "Skipping %s: another schematic has the "
+                                                     "same report file %s\n" ),
+                                                  filename, reportFn.GetFullPath() ),
+                                RPT_SEVERITY_ERROR );
+            addResult( CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT );
+            continue;
+        }
+
+        m_reporter->Report( wxString::Format( _( "Loading schematic %s\n" ), filename ),
+                            RPT_SEVERITY_INFO );
+
+        // The schematic is freed before the next one is loaded, as loading a schematic
+        // replaces the active project
+        std::unique_ptr<SCHEMATIC> sch( EESCHEMA_HELPERS::LoadSchematic( filename,
+                                                                         SCH_IO_MGR::SCH_KICAD,
+                                                                         true ) );
+
+        if( !sch )
+        {
+            m_reporter->Report( wxString::Format( _( "Failed to load schematic file %s\n" ),
+                                                  filename ),
+                                RPT_SEVERITY_ERROR );
+            addResult( CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE );
+            continue;
+        }
+
+        addResult( doSchErc( aErcJob, sch.get(), reportFn.GetFullPath() ) );
+    }
+
+    return exitCode;
+}
+
+
+int EESCHEMA_JOBS_HANDLER::doSchErc( JOB_SCH_ERC* aErcJob, SCHEMATIC* aSch,
+                                     const wxString& aOutputFile )
+{
+    aSch->Prj().ApplyTextVars( aErcJob->GetVarOverrides() );
+
     EDA_UNITS units;
 
-    switch( ercJob->m_units )
+    switch( aErcJob->m_units )
     {
     case JOB_SCH_ERC::UNITS::INCHES:
         units = EDA_UNITS::INCHES;
@@ -1003,43 +1215,43 @@ int EESCHEMA_JOBS_HANDLER::JobSchErc( JOB* aJob )
     }
 
     std::shared_ptr<SHEETLIST_ERC_ITEMS_PROVIDER> markersProvider =
-            std::make_shared<SHEETLIST_ERC_ITEMS_PROVIDER>( sch );
+            std::make_shared<SHEETLIST_ERC_ITEMS_PROVIDER>( aSch );
 
-    ERC_TESTER ercTester( sch );
+    ERC_TESTER ercTester( aSch );
 
     m_reporter->Report( _( "Running ERC...\n" ), RPT_SEVERITY_INFO );
 
-    std::unique_ptr<DS_PROXY_VIEW_ITEM> drawingSheet( getDrawingSheetProxyView( sch ) );
+    std::unique_ptr<DS_PROXY_VIEW_ITEM> drawingSheet( getDrawingSheetProxyView( aSch ) );
     ercTester.RunTests( drawingSheet.get(), nullptr, m_kiway->KiFACE( KIWAY::FACE_CVPCB ),
-                        &sch->Prj(), m_progressReporter );
+                        &aSch->Prj(), m_progressReporter );
 
-    markersProvider->SetSeverities( ercJob->m_severity );
+    markersProvider->SetSeverities( aErcJob->m_severity );
 
     m_reporter->Report(
             wxString::Format( _( "Found %d violations\n" ), markersProvider->GetCount() ),
             RPT_SEVERITY_INFO );
 
-    ERC_REPORT reportWriter( sch, units );
+    ERC_REPORT reportWriter( aSch, units );
 
     bool wroteReport = false;
 
-    if( ercJob->m_format == JOB_SCH_ERC::OUTPUT_FORMAT::JSON )
-        wroteReport = reportWriter.WriteJsonReport( ercJob->m_outputFile );
+    if( aErcJob->m_format == JOB_SCH_ERC::OUTPUT_FORMAT::JSON )
+        wroteReport = reportWriter.WriteJsonReport( aOutputFile );
     else
-        wroteReport = reportWriter.WriteTextReport( ercJob->m_outputFile );
+        wroteReport = reportWriter.WriteTextReport( aOutputFile );
 
     if( !wroteReport )
     {
         m_reporter->Report(
-                wxString::Format( _( "Unable to save ERC report to %s\n" ), ercJob->m_outputFile ),
+                wxString::Format( _( "Unable to save ERC report to %s\n" ), aOutputFile ),
                 RPT_SEVERITY_INFO );
         return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
     }
 
-    m_reporter->Report( wxString::Format( _( "Saved ERC Report to %s\n" ), ercJob->m_outputFile ),
+    m_reporter->Report( wxString::Format( _( "Saved ERC Report to %s\n" ), aOutputFile ),
                         RPT_SEVERITY_INFO );
 
-    if( ercJob->m_exitCodeViolations )
+    if( aErcJob->m_exitCodeViolations )
     {
         if( markersProvider->GetCount() > 0 )
         {
@@ -21,7 +21,9 @@
 #ifndef EESCHEMA_JOBS_HANDLER_H
 #define EESCHEMA_JOBS_HANDLER_H
 
+#include <future>
 #include <jobs/job_dispatcher.h>
+#include <vector>
 #include <wx/string.h>
 
 namespace KIGFX
@@ -29,9 +31,11 @@ namespace KIGFX
 class SCH_RENDER_SETTINGS;
 };
 
+class COLOR_SETTINGS;
 class KIWAY;
 class SCHEMATIC;
 class JOB_SYM_EXPORT_SVG;
+class JOB_SCH_ERC;
 class LIB_SYMBOL;
 class DS_PROXY_VIEW_ITEM;
 
@@ -67,8 +71,32 @@ public:
 
 private:
 
-    int doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, KIGFX::SCH_RENDER_SETTINGS* aRenderSettings,
-                        LIB_SYMBOL* symbol );
+    /// A symbol file plotted on the thread pool
+    struct SYMBOL_SVG_PLOT
+    {
+        wxString          m_symbolName;
+        wxString          m_fileName;
+        std::future<bool> m_result;
+    };
+
+    /**
+     * Queue the plots of the units and body styles of \a symbol on the thread pool.
+     *
+     * @param aPlots receives the plots of the symbol files.
+     */
+    int doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, COLOR_SETTINGS* aColors, LIB_SYMBOL* symbol,
+                        std::vector<SYMBOL_SVG_PLOT>& aPlots );
+
+    /**
+     * Run the ERC of \a aErcJob on \a aSch and write its report to \a aOutputFile.
+     */
+    int doSchErc( JOB_SCH_ERC* aErcJob, SCHEMATIC* aSch, const wxString& aOutputFile );
+
+    /**
+     * Check each of the schematics of \a aErcJob in turn, writing their reports to the output
+     * directory.  Returns the first hard error, or else whether any schematic had violations.
+     */
+    int doBatchSchErc( JOB_SCH_ERC* aErcJob );
 
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( SCHEMATIC* aSch );
 };
@@ -51,6 +51,7 @@
 #include <sim/sim_lib_mgr.h>
 #include <progress_reporter.h>
 #include <kiway.h>
+#include <core/thread_pool.h>
 
 
 /* ERC tests :
@@ -667,15 +668,23 @@ int ERC_TESTER::TestNoConnectPins()
 
 int ERC_TESTER::TestPinToPin()
 {
-    int errors = 0;
+    std::vector<const std::vector<CONNECTION_SUBGRAPH*>*> nets;
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
+    for( const auto& [ key, subgraphs ] : m_nets )
+        nets.push_back( &subgraphs );
+
+    // The nets are checked independently, on the thread pool.  The markers of each net are kept
+    // aside and added to their screens afterwards, in the order of the nets.
+    std::vector<std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>> markers( nets.size() );
+
+    auto checkNet = [&]( const std::vector<CONNECTION_SUBGRAPH*>& aSubgraphs,
+                         std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>& aMarkers )
     {
         std::vector<ERC_SCH_PIN_CONTEXT>           pins;
         std::unordered_map<EDA_ITEM*, SCH_SCREEN*> pinToScreenMap;
         bool has_noconnect = false;
 
-        for( CONNECTION_SUBGRAPH* subgraph: net.second )
+        for( CONNECTION_SUBGRAPH* subgraph: aSubgraphs )
         {
             if( subgraph->GetNoConnect() )
                 has_noconnect = true;
@@ -783,8 +792,7 @@ int ERC_TESTER::TestPinToPin()
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem,
                                                          refPin.Pin()->GetTransformedPosition() );
-                    pinToScreenMap[refPin.Pin()]->Append( marker );
-                    errors++;
+                    aMarkers.emplace_back( pinToScreenMap[refPin.Pin()], marker );
                 }
             }
         }
@@ -803,10 +811,37 @@ int ERC_TESTER::TestPinToPin()
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem,
                                                      needsDriver.Pin()->GetTransformedPosition() );
-                pinToScreenMap[needsDriver.Pin()]->Append( marker );
-                errors++;
+                aMarkers.emplace_back( pinToScreenMap[needsDriver.Pin()], marker );
             }
         }
+    };
+
+    if( ADVANCED_CFG::GetCfg().m_ParallelERC && nets.size() > 1 )
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+
+        tp.parallelize_loop( 0, nets.size(),
+                [&]( size_t aStart, size_t aEnd )
+                {
+                    for( size_t ii = aStart; ii < aEnd; ++ii )
+                        checkNet( *nets[ii], markers[ii] );
+                } ).wait();
+    }
+    else
+    {
+        for( size_t ii = 0; ii < nets.size(); ++ii )
+            checkNet( *nets[ii], markers[ii] );
+    }
+
+    int errors = 0;
+
+    for( const std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>& netMarkers : markers )
+    {
+        for( const auto& [ screen, marker ] : netMarkers )
+        {
+            screen->Append( marker );
+            errors++;
+        }
     }
 
     return errors;
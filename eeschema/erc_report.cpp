@@ -32,6 +32,7 @@
 #include <macros.h>
 #include <nlohmann/json.hpp>
 #include <rc_json_schema.h>
+#include <rc_json_writer.h>
 
 
 ERC_REPORT::ERC_REPORT( SCHEMATIC* aSchematic, EDA_UNITS aReportUnits ) :
@@ -42,11 +43,25 @@ ERC_REPORT::ERC_REPORT( SCHEMATIC* aSchematic, EDA_UNITS aReportUnits ) :
 
 
 wxString ERC_REPORT::GetTextReport()
+{
+    wxString report;
+
+    writeTextReport(
+            [&]( const wxString& aText )
+            {
+                report << aText;
+            } );
+
+    return report;
+}
+
+
+void ERC_REPORT::writeTextReport( const std::function<void( const wxString& )>& aWrite )
 {
     UNITS_PROVIDER unitsProvider( schIUScale, m_reportUnits );
 
-    wxString msg = wxString::Format( _( "ERC report (%s, Encoding UTF8)\n" ),
-                                     GetISO8601CurrentDateTime() );
+    aWrite( wxString::Format( _( "ERC report (%s, Encoding UTF8)\n" ),
+                              GetISO8601CurrentDateTime() ) );
 
     std::map<KIID, EDA_ITEM*> itemMap;
 
@@ -61,7 +76,7 @@ wxString ERC_REPORT::GetTextReport()
 
     for( unsigned i = 0; i < sheetList.size(); i++ )
     {
-        msg << wxString::Format( _( "\n***** Sheet %s\n" ), sheetList[i].PathHumanReadable() );
+        aWrite( wxString::Format( _( "\n***** Sheet %s\n" ), sheetList[i].PathHumanReadable() ) );
 
         for( SCH_ITEM* aItem : sheetList[i].LastScreen()->Items().OfType( SCH_MARKER_T ) )
         {
@@ -81,14 +96,12 @@ wxString ERC_REPORT::GetTextReport()
             default: break;
             }
 
-            msg << marker->GetRCItem()->ShowReport( &unitsProvider, severity, itemMap );
+            aWrite( marker->GetRCItem()->ShowReport( &unitsProvider, severity, itemMap ) );
         }
     }
 
-    msg << wxString::Format( _( "\n ** ERC messages: %d  Errors %d  Warnings %d\n" ), total_count,
-                             err_count, warn_count );
-
-    return msg;
+    aWrite( wxString::Format( _( "\n ** ERC messages: %d  Errors %d  Warnings %d\n" ),
+                              total_count, err_count, warn_count ) );
 }
 
 
@@ -99,10 +112,17 @@ bool ERC_REPORT::WriteTextReport( const wxString& aFullFileName )
     if( !file.IsOpened() )
         return false;
 
-    file.Write( GetTextReport() );
+    bool ok = true;
+
+    // Written as it is built, so that a huge report is not held in memory
+    writeTextReport(
+            [&]( const wxString& aText )
+            {
+                ok &= file.Write( aText );
+            } );
 
     // wxFFile dtor will close the file.
-    return true;
+    return ok;
 }
 
 
@@ -110,30 +130,40 @@ bool ERC_REPORT::WriteJsonReport( const wxString& aFullFileName )
 {
     std::ofstream jsonFileStream( aFullFileName.fn_str() );
 
+    if( !jsonFileStream.is_open() )
+        return false;
+
     UNITS_PROVIDER            unitsProvider( pcbIUScale, m_reportUnits );
     std::map<KIID, EDA_ITEM*> itemMap;
+    wxFileName                fn( m_sch->GetFileName() );
 
-    RC_JSON::ERC_REPORT reportHead;
-    wxFileName          fn( m_sch->GetFileName() );
-    reportHead.$schema = "https://schemas.kicad.org/erc.v1.json";
-    reportHead.source = fn.GetFullName();
-    reportHead.date = GetISO8601CurrentDateTime();
-    reportHead.kicad_version = GetMajorMinorPatchVersion();
-    reportHead.coordinate_units = EDA_UNIT_UTILS::GetLabel( m_reportUnits );
-
-    int            err_count = 0;
-    int            warn_count = 0;
-    int            total_count = 0;
     SCH_SHEET_LIST sheetList = m_sch->GetSheets();
     sheetList.FillItemMap( itemMap );
 
     ERC_SETTINGS& settings = m_sch->ErcSettings();
 
+    // The violations are serialized one at a time as they are written, so that the report of
+    // a schematic with a huge number of violations is never held in memory as a whole.
+    // Members are in alphabetical order, as nlohmann::json would write them.
+    RC_JSON::STREAM_WRITER writer( jsonFileStream );
+
+    writer.BeginObject();
+    writer.Member( "$schema", wxString( "https://schemas.kicad.org/erc.v1.json" ) );
+    writer.Member( "coordinate_units", EDA_UNIT_UTILS::GetLabel( m_reportUnits ) );
+    writer.Member( "date", GetISO8601CurrentDateTime() );
+    writer.Member( "kicad_version", GetMajorMinorPatchVersion() );
+
+    writer.Key( "sheets" );
+    writer.BeginArray();
+
     for( unsigned i = 0; i < sheetList.size(); i++ )
     {
-        RC_JSON::ERC_SHEET jsonSheet;
-        jsonSheet.path = sheetList[i].PathHumanReadable();
-        jsonSheet.uuid_path = sheetList[i].Path().AsString();
+        writer.BeginObject();
+        writer.Member( "path", sheetList[i].PathHumanReadable() );
+        writer.Member( "uuid_path", sheetList[i].Path().AsString() );
+
+        writer.Key( "violations" );
+        writer.BeginArray();
 
         for( SCH_ITEM* aItem : sheetList[i].LastScreen()->Items().OfType( SCH_MARKER_T ) )
         {
@@ -144,29 +174,23 @@ bool ERC_REPORT::WriteJsonReport( const wxString& aFullFileName )
             if( marker->GetMarkerType() != MARKER_BASE::MARKER_ERC )
                 continue;
 
-            total_count++;
-
-            switch( severity )
-            {
-            case RPT_SEVERITY_ERROR: err_count++; break;
-            case RPT_SEVERITY_WARNING: warn_count++; break;
-            default: break;
-            }
-
             RC_JSON::VIOLATION violation;
             marker->GetRCItem()->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
 
-            jsonSheet.violations.push_back( violation );
+            writer.Value( violation );
         }
 
-        reportHead.sheets.push_back( jsonSheet );
+        writer.EndArray();
+        writer.EndObject();
     }
 
+    writer.EndArray();
+    writer.Member( "source", fn.GetFullName() );
+    writer.EndObject();
+    writer.Finish();
 
-    nlohmann::json saveJson = nlohmann::json( reportHead );
-    jsonFileStream << std::setw( 4 ) << saveJson << std::endl;
     jsonFileStream.flush();
     jsonFileStream.close();
 
-    return true;
-}
\ No newline at end of file
+    return !jsonFileStream.fail();
+}
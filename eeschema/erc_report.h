@@ -20,6 +20,7 @@
 #ifndef ERC_REPORT_H
 #define ERC_REPORT_H
 
+#include <functional>
 #include <memory>
 #include <eda_units.h>
 #include <wx/string.h>
@@ -53,6 +54,12 @@ public:
      */
     bool WriteJsonReport( const wxString& aFullFileName );
 
+private:
+    /**
+     * Build the text report piece by piece, handing each piece to \a aWrite.
+     */
+    void writeTextReport( const std::function<void( const wxString& )>& aWrite );
+
 private:
     SCHEMATIC*                         m_sch;
     EDA_UNITS                          m_reportUnits;
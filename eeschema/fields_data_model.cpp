@@ -17,6 +17,9 @@
  * You should have received a copy of the GNU General Public License along
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <limits>
+#include <unordered_map>
+
 #include <wx/string.h>
 #include <wx/debug.h>
 #include <wx/grid.h>
@@ -381,35 +384,39 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::unitMatch( const SCH_REFERENCE& lhRef,
 }
 
 
-bool FIELDS_EDITOR_GRID_DATA_MODEL::groupMatch( const SCH_REFERENCE& lhRef,
-                                                const SCH_REFERENCE& rhRef )
-
+bool FIELDS_EDITOR_GRID_DATA_MODEL::groupKey( const SCH_REFERENCE& aRef, int aRefCol,
+                                              wxString& aKey )
 {
-    int  refCol = GetFieldNameCol( GetCanonicalFieldName( REFERENCE_FIELD ) );
-    bool matchFound = false;
+    bool grouped = false;
+
+    aKey.clear();
+
+    // Each value is prefixed with its length so that different values can't give the same key
+    auto addValue =
+            [&]( const wxString& aValue )
+            {
+                aKey << (unsigned long) aValue.length() << ':' << aValue;
+                grouped = true;
+            };
 
-    if( refCol == -1 )
+    if( aRefCol == -1 )
         return false;
 
     // First check the reference column.  This can be done directly out of the
     // SCH_REFERENCEs as the references can't be edited in the grid.
-    if( m_cols[refCol].m_group )
+    if( m_cols[aRefCol].m_group )
     {
         // if we're grouping by reference, then only the prefix must match
-        if( lhRef.GetRef() != rhRef.GetRef() )
-            return false;
-
-        matchFound = true;
+        addValue( aRef.GetRef() );
     }
 
-    const KIID& lhRefID = lhRef.GetSymbol()->m_Uuid;
-    const KIID& rhRefID = rhRef.GetSymbol()->m_Uuid;
+    const KIID& refID = aRef.GetSymbol()->m_Uuid;
 
     // Now check all the other columns.
     for( size_t i = 0; i < m_cols.size(); ++i )
     {
         //Handled already
-        if( (int) i == refCol )
+        if( (int) i == aRefCol )
             continue;
 
         if( !m_cols[i].m_group )
@@ -419,33 +426,18 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::groupMatch( const SCH_REFERENCE& lhRef,
         // to get the actual current value, otherwise we need to pull it out of the
         // store so the refresh can regroup based on values that haven't been applied
         // to the schematic yet.
-        wxString lh, rh;
-
         if( IsTextVar( m_cols[i].m_fieldName )
-            || IsTextVar( m_dataStore[lhRefID][m_cols[i].m_fieldName] ) )
+            || IsTextVar( m_dataStore[refID][m_cols[i].m_fieldName] ) )
         {
-            lh = getFieldShownText( lhRef, m_cols[i].m_fieldName );
+            addValue( getFieldShownText( aRef, m_cols[i].m_fieldName ) );
         }
         else
-            lh = m_dataStore[lhRefID][m_cols[i].m_fieldName];
-
-        if( IsTextVar( m_cols[i].m_fieldName )
-            || IsTextVar( m_dataStore[rhRefID][m_cols[i].m_fieldName] ) )
         {
-            rh = getFieldShownText( rhRef, m_cols[i].m_fieldName );
+            addValue( m_dataStore[refID][m_cols[i].m_fieldName] );
         }
-        else
-            rh = m_dataStore[rhRefID][m_cols[i].m_fieldName];
-
-        wxString fieldName = m_cols[i].m_fieldName;
-
-        if( lh != rh )
-            return false;
-
-        matchFound = true;
     }
 
-    return matchFound;
+    return grouped;
 }
 
 
@@ -548,6 +540,26 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
 
     m_rows.clear();
 
+    int refCol = GetFieldNameCol( GetCanonicalFieldName( REFERENCE_FIELD ) );
+
+    // The rows by the reference of their first symbol and by its group key, to find the row of
+    // a symbol without comparing it to every row
+    std::unordered_map<wxString, size_t> unitRows;
+    std::unordered_map<wxString, size_t> groupRows;
+
+    auto addRow =
+            [&]( const SCH_REFERENCE& aRef )
+            {
+                m_rows.emplace_back( DATA_MODEL_ROW( aRef, GROUP_SINGLETON ) );
+
+                // An unannotated symbol can't be matched as a unit of another one
+                if( aRef.GetRefNumber() != wxT( "?" ) )
+                {
+                    unitRows.emplace( aRef.GetRef() + wxT( '\n' ) + aRef.GetRefNumber(),
+                                      m_rows.size() - 1 );
+                }
+            };
+
     for( unsigned i = 0; i < m_symbolsList.GetCount(); ++i )
     {
         SCH_REFERENCE ref = m_symbolsList[i];
@@ -570,38 +582,54 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
             continue;
         }
 
-        bool matchFound = false;
-
-        // Performance optimization for ungrouped case to skip the N^2 for loop
+        // Performance optimization for ungrouped case to skip the group keys
         if( !m_groupingEnabled && !ref.IsMultiUnit() )
         {
-            m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
+            addRow( ref );
             continue;
         }
 
-        // See if we already have a row which this symbol fits into
-        for( DATA_MODEL_ROW& row : m_rows )
+        // See if we already have a row which this symbol fits into.  The rows are matched on
+        // their first reference, and the first row matching either as a unit or as a group is
+        // used, so look up both and take the earliest.
+        const size_t noRow = std::numeric_limits<size_t>::max();
+        size_t       unitRow = noRow;
+        size_t       groupRow = noRow;
+        wxString     refGroupKey;
+        bool         refGrouped = m_groupingEnabled && groupKey( ref, refCol, refGroupKey );
+
+        if( ref.GetRefNumber() != wxT( "?" ) )
         {
-            // all group members must have identical refs so just use the first one
-            SCH_REFERENCE rowRef = row.m_Refs[0];
+            auto it = unitRows.find( ref.GetRef() + wxT( '\n' ) + ref.GetRefNumber() );
 
-            if( unitMatch( ref, rowRef ) )
-            {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                break;
-            }
-            else if( m_groupingEnabled && groupMatch( ref, rowRef ) )
-            {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                row.m_Flag = GROUP_COLLAPSED;
-                break;
-            }
+            if( it != unitRows.end() )
+                unitRow = it->second;
         }
 
-        if( !matchFound )
-            m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
+        if( refGrouped )
+        {
+            auto it = groupRows.find( refGroupKey );
+
+            if( it != groupRows.end() )
+                groupRow = it->second;
+        }
+
+        if( unitRow != noRow && unitRow <= groupRow )
+        {
+            m_rows[unitRow].m_Refs.push_back( ref );
+        }
+        else if( groupRow != noRow )
+        {
+            m_rows[groupRow].m_Refs.push_back( ref );
+            m_rows[groupRow].m_Flag = GROUP_COLLAPSED;
+        }
+        else
+        {
+            addRow( ref );
+
+            if( refGrouped )
+                groupRows.emplace( refGroupKey, m_rows.size() - 1 );
+        }
     }
 
     if( GetView() )
@@ -257,7 +257,14 @@ private:
     static bool cmp( const DATA_MODEL_ROW& lhGroup, const DATA_MODEL_ROW& rhGroup,
                      FIELDS_EDITOR_GRID_DATA_MODEL* dataModel, int sortCol, bool ascending );
     bool        unitMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
-    bool        groupMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
+
+    /**
+     * Build the key of the group of \a aRef from the values of the grouped columns.  Two
+     * references belong to the same group when their keys are equal.
+     *
+     * @return false if no column is grouped, in which case nothing is grouped.
+     */
+    bool        groupKey( const SCH_REFERENCE& aRef, int aRefCol, wxString& aKey );
 
     // Helper functions to deal with translating wxGrid values to and from
     // named field values like ${DNP}
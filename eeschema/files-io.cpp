@@ -37,6 +37,7 @@
 #include <kiplatform/app.h>
 #include <lockfile.h>
 #include <pgm_base.h>
+#include <perf_trace.h>
 #include <core/profile.h>
 #include <project/project_file.h>
 #include <project_rescue.h>
@@ -268,7 +269,9 @@ bool SCH_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
         try
         {
             {
-                wxBusyCursor busy;
+                wxBusyCursor      busy;
+                SCOPED_TRACE_ZONE traceZone( "Load schematic", fullFileName );
+
                 Schematic().SetRoot( pi->LoadSchematicFile( fullFileName, &Schematic() ) );
                 // Make ${SHEETNAME} work on the root sheet until we properly support
                 // naming the root sheet
@@ -53,7 +53,54 @@ bool NETLIST_EXPORTER_KICAD::WriteNetlist( const wxString& aOutFileName, unsigne
 
 void NETLIST_EXPORTER_KICAD::Format( OUTPUTFORMATTER* aOut, int aCtl )
 {
-    std::unique_ptr<XNODE> xroot( makeRoot( aCtl ) );
+    // This writes the same text as formatting the tree of makeRoot(), but the symbols and the
+    // nets, which are most of a netlist, are formatted and freed one at a time rather than all
+    // built first.
+    //
+    // XNODE::Format() closes a node with ")\n" when it has a next sibling and with ")" when it
+    // is the last one, and its parent prints a "\n" before the first child.  Printing a "\n"
+    // before each node gives the same result without linking the nodes together.
+    auto formatNode =
+            [&]( XNODE* aNode, int aNestLevel )
+            {
+                std::unique_ptr<XNODE> owned( aNode );
 
-    xroot->Format( aOut, 0 );
+                aOut->Print( 0, "\n" );
+                owned->Format( aOut, aNestLevel );
+            };
+
+    auto formatChild =
+            [&]( XNODE* aNode )
+            {
+                formatNode( aNode, 2 );
+            };
+
+    aOut->Print( 0, "(export (version %s)", aOut->Quotew( wxT( "E" ) ).c_str() );
+
+    if( aCtl & GNL_HEADER )
+        formatNode( makeDesignHeader(), 1 );
+
+    if( aCtl & GNL_SYMBOLS )
+    {
+        aOut->Print( 0, "\n" );
+        aOut->Print( 1, "(components" );
+        makeSymbolNodes( aCtl, formatChild );
+        aOut->Print( 0, ")" );
+    }
+
+    if( aCtl & GNL_PARTS )
+        formatNode( makeLibParts(), 1 );
+
+    if( aCtl & GNL_LIBRARIES )
+        formatNode( makeLibraries(), 1 );   // must follow makeLibParts()
+
+    if( aCtl & GNL_NETS )
+    {
+        aOut->Print( 0, "\n" );
+        aOut->Print( 1, "(nets" );
+        makeNetNodes( aCtl, formatChild );
+        aOut->Print( 0, ")" );
+    }
+
+    aOut->Print( 0, ")" );
 }
@@ -243,6 +243,19 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
 {
     XNODE* xcomps = node( wxT( "components" ) );
 
+    makeSymbolNodes( aCtl,
+                     [&]( XNODE* aNode )
+                     {
+                         xcomps->AddChild( aNode );
+                     } );
+
+    return xcomps;
+}
+
+
+void NETLIST_EXPORTER_XML::makeSymbolNodes( unsigned aCtl,
+                                            const std::function<void( XNODE* )>& aOnNode )
+{
     m_referencesAlreadyFound.Clear();
     m_libParts.clear();
 
@@ -304,8 +317,7 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
             // not always look best, but it will allow faster execution under XSL processing
             // systems which do sequential searching within an element.
 
-            XNODE* xcomp;  // current symbol being constructed
-            xcomps->AddChild( xcomp = node( wxT( "comp" ) ) );
+            XNODE* xcomp = node( wxT( "comp" ) );  // current symbol being constructed
 
             xcomp->AddAttribute( wxT( "ref" ), symbol->GetRef( &sheet ) );
             addSymbolFields( xcomp, symbol, &sheet );
@@ -433,12 +445,12 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
             // Output the primary UUID
             uuid = symbol->m_Uuid.AsString();
             xunits->AddChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, uuid ) );
+
+            aOnNode( xcomp );
         }
     }
 
     m_schematic->SetCurrentSheet( currentSheet );
-
-    return xcomps;
 }
 
 
@@ -667,7 +679,21 @@ XNODE* NETLIST_EXPORTER_XML::makeLibParts()
 
 XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
 {
-    XNODE*      xnets = node( wxT( "nets" ) );      // auto_ptr if exceptions ever get used.
+    XNODE* xnets = node( wxT( "nets" ) );      // auto_ptr if exceptions ever get used.
+
+    makeNetNodes( aCtl,
+                  [&]( XNODE* aNode )
+                  {
+                      xnets->AddChild( aNode );
+                  } );
+
+    return xnets;
+}
+
+
+void NETLIST_EXPORTER_XML::makeNetNodes( unsigned aCtl,
+                                         const std::function<void( XNODE* )>& aOnNode )
+{
     wxString    netCodeTxt;
     wxString    netName;
     wxString    ref;
@@ -808,7 +834,7 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
             {
                 netCodeTxt.Printf( wxT( "%d" ), i + 1 );
 
-                xnets->AddChild( xnet = node( wxT( "net" ) ) );
+                xnet = node( wxT( "net" ) );
                 xnet->AddAttribute( wxT( "code" ), netCodeTxt );
                 xnet->AddAttribute( wxT( "name" ), net_record->m_Name );
 
@@ -831,12 +857,13 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
 
             xnode->AddAttribute( wxT( "pintype" ), pinType );
         }
+
+        if( added )
+            aOnNode( xnet );
     }
 
     for( NET_RECORD* record : nets )
         delete record;
-
-    return xnets;
 }
 
 
@@ -26,6 +26,8 @@
 #ifndef NETLIST_EXPORT_XML_H
 #define NETLIST_EXPORT_XML_H
 
+#include <functional>
+
 #include <netlist_exporter_base.h>
 
 #include <project.h>
@@ -105,6 +107,12 @@ protected:
      */
     XNODE* makeSymbols( unsigned aCtl );
 
+    /**
+     * Build the "comp" node of each schematic symbol, in the order of makeSymbols(), and pass
+     * it to \a aOnNode, which takes ownership of it.
+     */
+    void makeSymbolNodes( unsigned aCtl, const std::function<void( XNODE* )>& aOnNode );
+
     /**
      * Fill out a project "design" header into an XML node.
      * @return the design header
@@ -123,6 +131,12 @@ protected:
      */
     XNODE* makeListOfNets( unsigned aCtl );
 
+    /**
+     * Build the "net" node of each net, in the order of makeListOfNets(), and pass it to
+     * \a aOnNode, which takes ownership of it.
+     */
+    void makeNetNodes( unsigned aCtl, const std::function<void( XNODE* )>& aOnNode );
+
     /**
      * Fill out an XML node with a list of used libraries and returns it.
      * Must have called makeGenericLibParts() before this function.
@@ -201,6 +201,34 @@ bool SCH_IO_DATABASE::TestConnection( wxString* aErrorMsg )
 }
 
 
+bool SCH_IO_DATABASE::sameRow( const DATABASE_CONNECTION::ROW& aRow,
+                               const DATABASE_CONNECTION::ROW& aOther )
+{
+    if( aRow.size() != aOther.size() )
+        return false;
+
+    try
+    {
+        for( auto it = aRow.begin(), other = aOther.begin(); it != aRow.end(); ++it, ++other )
+        {
+            // The connection reads all the values as strings
+            if( it->first != other->first
+                || std::any_cast<std::string>( it->second )
+                           != std::any_cast<std::string>( other->second ) )
+            {
+                return false;
+            }
+        }
+    }
+    catch( const std::bad_any_cast& )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
 void SCH_IO_DATABASE::cacheLib()
 {
     long long currentTimestampSeconds = wxDateTime::Now().GetValue().GetValue() / 1000;
@@ -211,6 +239,10 @@ void SCH_IO_DATABASE::cacheLib()
         return;
     }
 
+    // The symbols only need to be built again from the rows which changed, unless the library
+    // table, and so the symbols they are made from, changed too
+    bool rebuildAll = m_libTable->GetModifyHash() != m_cacheModifyHash;
+
     for( const DATABASE_LIB_TABLE& table : m_settings->m_Tables )
     {
         std::vector<DATABASE_CONNECTION::ROW> results;
@@ -236,10 +268,20 @@ void SCH_IO_DATABASE::cacheLib()
             wxString    name( fmt::format( "{}{}", prefix,
                                            std::any_cast<std::string>( result[table.key_col] ) ) );
 
+            auto cachedRow = m_nameToRowCache.find( name );
+
+            if( !rebuildAll && cachedRow != m_nameToRowCache.end()
+                && sameRow( cachedRow->second, result ) && m_nameToSymbolcache.count( name ) )
+            {
+                continue;
+            }
+
             std::unique_ptr<LIB_SYMBOL> symbol = loadSymbolFromRow( name, table, result );
 
             if( symbol )
                 m_nameToSymbolcache[symbol->GetName()] = std::move( symbol );
+
+            m_nameToRowCache[name] = std::move( result );
         }
     }
 
@@ -260,6 +302,9 @@ void SCH_IO_DATABASE::ensureSettings( const wxString& aSettingsPath )
 
                     THROW_IO_ERROR( msg );
                 }
+
+                // The field mappings may have changed, so all the symbols must be built again
+                m_nameToRowCache.clear();
             };
 
     if( !m_settings && !aSettingsPath.IsEmpty() )
@@ -99,6 +99,10 @@ private:
 
     static std::optional<bool> boolFromAny( const std::any& aVal );
 
+    /// @return true if \a aRow and \a aOther have the same columns and values.
+    static bool sameRow( const DATABASE_CONNECTION::ROW& aRow,
+                         const DATABASE_CONNECTION::ROW& aOther );
+
     SYMBOL_LIB_TABLE* m_libTable;
 
     std::unique_ptr<DATABASE_LIB_SETTINGS> m_settings;
@@ -112,6 +116,9 @@ private:
 
     std::map<wxString, std::unique_ptr<LIB_SYMBOL>> m_nameToSymbolcache;
 
+    /// The rows the cached symbols were built from, to only rebuild those which changed
+    std::map<wxString, DATABASE_CONNECTION::ROW> m_nameToRowCache;
+
     long long m_cacheTimestamp;
 
     int m_cacheModifyHash;
@@ -70,24 +70,34 @@ void SCH_IO_HTTP_LIB::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
             ( aProperties
               && aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
-    for(const HTTP_LIB_CATEGORY& category : m_conn->getCategories() )
+    std::vector<HTTP_LIB_CATEGORY> categories = m_conn->getCategories();
+
+    auto isCategoryCached =
+            [&]( const HTTP_LIB_CATEGORY& aCategory )
+            {
+                auto cached = m_cachedCategories.find( aCategory.id );
+
+                return cached != m_cachedCategories.end()
+                       && std::difftime( std::time( nullptr ), cached->second.lastCached )
+                                  < m_settings->m_Source.timeout_categories;
+            };
+
+    // Download the outdated categories all at once rather than one after the other
+    std::vector<HTTP_LIB_CATEGORY> outdatedCategories;
+
+    for( const HTTP_LIB_CATEGORY& category : categories )
     {
-        bool refresh_cache = true;
+        if( !isCategoryCached( category ) )
+            outdatedCategories.push_back( category );
+    }
 
-        std::vector<HTTP_LIB_PART> found_parts;
+    m_conn->PrefetchCategories( outdatedCategories );
 
-         // Check if there is already a part in our cache, if not fetch it
-        if( m_cachedCategories.find( category.id ) != m_cachedCategories.end() )
-        {
-            // check if it's outdated, if so re-fetch
-            if( std::difftime( std::time( nullptr ), m_cachedCategories[category.id].lastCached )
-                < m_settings->m_Source.timeout_categories )
-            {
-                refresh_cache = false;
-            }
-        }
+    for(const HTTP_LIB_CATEGORY& category : categories )
+    {
+        std::vector<HTTP_LIB_PART> found_parts;
 
-        if( refresh_cache )
+        if( !isCategoryCached( category ) )
         {
             if( !m_conn->SelectAll( category, found_parts ) )
             {
@@ -145,7 +155,11 @@ LIB_SYMBOL* SCH_IO_HTTP_LIB::LoadSymbol( const wxString&        aLibraryPath,
 
     std::vector<HTTP_LIB_CATEGORY> categories = m_conn->getCategories();
 
-    std::tuple relations = m_conn->getCachedParts()[partName];
+    std::tuple<std::string, std::string> relations;
+    auto cachedPart = m_conn->getCachedParts().find( partName );
+
+    if( cachedPart != m_conn->getCachedParts().end() )
+        relations = cachedPart->second;
 
     // get the matching category
     for( const HTTP_LIB_CATEGORY& categoryIter : categories )
@@ -21,6 +21,7 @@
  */
 
 #include <algorithm>
+#include <set>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code.
@@ -33,6 +34,7 @@
 #include <advanced_config.h>
 #include <base_units.h>
 #include <build_version.h>
+#include <core/thread_pool.h>
 #include <ee_selection.h>
 #include <font/fontconfig.h>
 #include <io/kicad/kicad_io_utils.h>
@@ -152,6 +154,7 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
     }
 
     m_currentPath.push( m_path );
+    m_prefetched.clear();
     init( aSchematic, aProperties );
 
     if( aAppendToMe == nullptr )
@@ -185,6 +188,9 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
 
     m_currentPath.pop(); // Clear the path stack for next call to Load
 
+    // Sheets which were parsed ahead but turned out not to be needed
+    m_prefetched.clear();
+
     return sheet;
 }
 
@@ -253,24 +259,55 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
         }
         else
         {
-            aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+            auto prefetched = m_prefetched.find( fileName.GetFullPath() );
 
-            try
+            if( prefetched != m_prefetched.end() )
             {
-                loadFile( fileName.GetFullPath(), aSheet );
+                // Take the screen over from the placeholder sheet it was parsed on
+                aSheet->SetScreen( prefetched->second.m_sheet->GetScreen() );
+                prefetched->second.m_sheet.reset();
+
+                for( SCH_ITEM* aItem : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
+                    aItem->SetParent( aSheet );
+
+                if( !prefetched->second.m_error.IsEmpty() )
+                {
+                    if( !m_error.IsEmpty() )
+                        m_error += "\n";
+
+                    m_error += prefetched->second.m_error;
+                }
+
+                m_prefetched.erase( prefetched );
             }
-            catch( const IO_ERROR& ioe )
+            else
             {
-                // If there is a problem loading the root sheet, there is no recovery.
-                if( aSheet == m_rootSheet )
-                    throw;
+                aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+                aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
 
-                // For all subsheets, queue up the error message for the caller.
-                if( !m_error.IsEmpty() )
-                    m_error += "\n";
+                try
+                {
+                    loadFile( fileName.GetFullPath(), aSheet );
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    // If there is a problem loading the root sheet, there is no recovery.
+                    if( aSheet == m_rootSheet )
+                        throw;
+
+                    // For all subsheets, queue up the error message for the caller.
+                    if( !m_error.IsEmpty() )
+                        m_error += "\n";
 
-                m_error += ioe.What();
+                    m_error += ioe.What();
+                }
+
+                // Parse the rest of the hierarchy ahead of the recursion below
+                if( m_currentSheetPath.size() == 1
+                        && ADVANCED_CFG::GetCfg().m_ParallelSchematicLoad )
+                {
+                    prefetchHierarchy( aSheet->GetScreen(), fileName.GetPath() );
+                }
             }
 
             if( fileName.FileExists() )
@@ -307,29 +344,137 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
 }
 
 
+bool SCH_IO_KICAD_SEXPR::CanReadSchematicFile( const wxString& aFileName ) const
+{
+    // A compressed schematic is named for the file it holds, e.g. "name.kicad_sch.gz"
+    if( IsGzipFileName( aFileName ) )
+        return SCH_IO::CanReadSchematicFile( aFileName.BeforeLast( '.' ) );
+
+    return SCH_IO::CanReadSchematicFile( aFileName );
+}
+
+
 void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
 {
-    FILE_LINE_READER reader( aFileName );
+    auto parse =
+            [&]( auto& reader )
+            {
+                size_t lineCount = 0;
 
-    size_t lineCount = 0;
+                if( m_progressReporter )
+                {
+                    m_progressReporter->Report( wxString::Format( _( "Loading %s..." ),
+                                                                  aFileName ) );
 
-    if( m_progressReporter )
-    {
-        m_progressReporter->Report( wxString::Format( _( "Loading %s..." ), aFileName ) );
+                    if( !m_progressReporter->KeepRefreshing() )
+                        THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        if( !m_progressReporter->KeepRefreshing() )
-            THROW_IO_ERROR( _( "Open cancelled by user." ) );
+                    while( reader.ReadLine() )
+                        lineCount++;
 
-        while( reader.ReadLine() )
-            lineCount++;
+                    reader.Rewind();
+                }
+
+                SCH_IO_KICAD_SEXPR_PARSER parser( &reader, m_progressReporter, lineCount,
+                                                  m_rootSheet, m_appending );
 
-        reader.Rewind();
+                parser.ParseSchematic( aSheet );
+            };
+
+    // Compressed sheets are decompressed as they are parsed
+    if( IsGzipFileName( aFileName ) )
+    {
+        GZIP_FILE_LINE_READER reader( aFileName );
+        parse( reader );
     }
+    else
+    {
+        MAPPED_FILE_LINE_READER reader( aFileName );
+        parse( reader );
+    }
+}
 
-    SCH_IO_KICAD_SEXPR_PARSER parser( &reader, m_progressReporter, lineCount, m_rootSheet,
-                                      m_appending );
 
-    parser.ParseSchematic( aSheet );
+void SCH_IO_KICAD_SEXPR::prefetchHierarchy( SCH_SCREEN* aScreen, const wxString& aPath )
+{
+    // The screens of a level of the hierarchy and the paths their sheet files are relative to
+    std::vector<std::pair<SCH_SCREEN*, wxString>> level = { { aScreen, aPath } };
+    std::set<wxString>                            seen = { aScreen->GetFileName() };
+
+    while( !level.empty() )
+    {
+        std::vector<wxString> fileNames;
+
+        for( const auto& [screen, path] : level )
+        {
+            for( SCH_ITEM* aItem : screen->Items().OfType( SCH_SHEET_T ) )
+            {
+                wxFileName  fileName = static_cast<SCH_SHEET*>( aItem )->GetFileName();
+                SCH_SCREEN* existing = nullptr;
+
+                if( !fileName.IsAbsolute() )
+                    fileName.MakeAbsolute( path );
+
+                // Missing files and the ones already in the schematic are left to
+                // loadHierarchy(), which reports or reuses them.
+                if( !seen.insert( fileName.GetFullPath() ).second || !fileName.FileExists()
+                        || m_rootSheet->SearchHierarchy( fileName.GetFullPath(), &existing ) )
+                {
+                    continue;
+                }
+
+                fileNames.push_back( fileName.GetFullPath() );
+            }
+        }
+
+        if( m_progressReporter && !m_progressReporter->KeepRefreshing() )
+            THROW_IO_ERROR( _( "Open cancelled by user." ) );
+
+        std::vector<PREFETCHED_SHEET> parsed( fileNames.size() );
+
+        for( size_t ii = 0; ii < fileNames.size(); ++ii )
+        {
+            parsed[ii].m_sheet = std::make_unique<SCH_SHEET>( m_schematic );
+            parsed[ii].m_sheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+            parsed[ii].m_sheet->GetScreen()->SetFileName( fileNames[ii] );
+        }
+
+        ParallelForEachIndex( fileNames.size(),
+                [&]( size_t ii )
+                {
+                    try
+                    {
+                        std::unique_ptr<LINE_READER> reader;
+
+                        if( IsGzipFileName( fileNames[ii] ) )
+                            reader = std::make_unique<GZIP_FILE_LINE_READER>( fileNames[ii] );
+                        else
+                            reader = std::make_unique<MAPPED_FILE_LINE_READER>( fileNames[ii] );
+
+                        SCH_IO_KICAD_SEXPR_PARSER parser( reader.get(), nullptr, 0, m_rootSheet,
+                                                          m_appending );
+
+                        parser.ParseSchematic( parsed[ii].m_sheet.get() );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        parsed[ii].m_error = ioe.What();
+                    }
+                    catch( const std::exception& e )
+                    {
+                        parsed[ii].m_error = e.what();
+                    }
+                } );
+
+        level.clear();
+
+        for( size_t ii = 0; ii < fileNames.size(); ++ii )
+        {
+            level.emplace_back( parsed[ii].m_sheet->GetScreen(),
+                                wxFileName( fileNames[ii] ).GetPath() );
+            m_prefetched[fileNames[ii]] = std::move( parsed[ii] );
+        }
+    }
 }
 
 
@@ -361,12 +506,20 @@ void SCH_IO_KICAD_SEXPR::SaveSchematicFile( const wxString& aFileName, SCH_SHEET
     // works properly.
     wxASSERT( fn.IsAbsolute() );
 
-    PRETTIFIED_FILE_OUTPUTFORMATTER formatter( fn.GetFullPath() );
+    std::unique_ptr<OUTPUTFORMATTER> formatter;
+
+    if( IsGzipFileName( aFileName ) )
+        formatter = std::make_unique<GZIP_FILE_OUTPUTFORMATTER>( fn.GetFullPath() );
+    else
+        formatter = std::make_unique<PRETTIFIED_FILE_OUTPUTFORMATTER>( fn.GetFullPath() );
 
-    m_out = &formatter;     // no ownership
+    m_out = formatter.get();     // no ownership
 
     Format( aSheet );
 
+    formatter->Finish();
+    m_out = nullptr;
+
     if( aSheet->GetScreen() )
         aSheet->GetScreen()->SetFileExists( true );
 }
@@ -1471,13 +1624,8 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( wxArrayString&    aSymbolNameList,
 
     cacheLib( aLibraryPath, aProperties );
 
-    const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
-
-    for( LIB_SYMBOL_MAP::const_iterator it = symbols.begin();  it != symbols.end();  ++it )
-    {
-        if( !powerSymbolsOnly || it->second->IsPower() )
-            aSymbolNameList.Add( it->first );
-    }
+    for( const wxString& name : m_cache->GetSymbolNames( powerSymbolsOnly ) )
+        aSymbolNameList.Add( name );
 }
 
 
@@ -1491,6 +1639,7 @@ void SCH_IO_KICAD_SEXPR::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolLi
                               aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
     cacheLib( aLibraryPath, aProperties );
+    m_cache->ParseAll();
 
     const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
 
@@ -1510,23 +1659,20 @@ LIB_SYMBOL* SCH_IO_KICAD_SEXPR::LoadSymbol( const wxString& aLibraryPath,
 
     cacheLib( aLibraryPath, aProperties );
 
-    LIB_SYMBOL_MAP::const_iterator it = m_cache->m_symbols.find( aSymbolName );
+    LIB_SYMBOL* symbol = m_cache->GetSymbol( aSymbolName );
 
     // We no longer escape '/' in symbol names, but we used to.
-    if( it == m_cache->m_symbols.end() && aSymbolName.Contains( '/' ) )
-        it = m_cache->m_symbols.find( EscapeString( aSymbolName, CTX_LEGACY_LIBID ) );
+    if( !symbol && aSymbolName.Contains( '/' ) )
+        symbol = m_cache->GetSymbol( EscapeString( aSymbolName, CTX_LEGACY_LIBID ) );
 
-    if( it == m_cache->m_symbols.end() && aSymbolName.Contains( wxT( "{slash}" ) ) )
+    if( !symbol && aSymbolName.Contains( wxT( "{slash}" ) ) )
     {
         wxString unescaped = aSymbolName;
         unescaped.Replace( wxT( "{slash}" ), wxT( "/" ) );
-        it = m_cache->m_symbols.find( unescaped );
+        symbol = m_cache->GetSymbol( unescaped );
     }
 
-    if( it == m_cache->m_symbols.end() )
-        return nullptr;
-
-    return it->second;
+    return symbol;
 }
 
 
@@ -1636,6 +1782,8 @@ void SCH_IO_KICAD_SEXPR::GetAvailableSymbolFields( std::vector<wxString>& aNames
     if( !m_cache )
         return;
 
+    m_cache->ParseAll();
+
     const LIB_SYMBOL_MAP& symbols = m_cache->m_symbols;
 
     std::set<wxString> fieldNames;
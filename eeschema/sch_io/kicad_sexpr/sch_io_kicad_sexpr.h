@@ -23,6 +23,7 @@
 #ifndef SCH_IO_KICAD_SEXPR_H_
 #define SCH_IO_KICAD_SEXPR_H_
 
+#include <map>
 #include <memory>
 #include <sch_io/sch_io.h>
 #include <sch_io/sch_io_mgr.h>
@@ -81,6 +82,11 @@ public:
                                       { FILEEXT::KiCadSymbolLibFileExtension } );
     }
 
+    /**
+     * Also accept gzip compressed schematics, e.g. "name.kicad_sch.gz".
+     */
+    bool CanReadSchematicFile( const wxString& aFileName ) const override;
+
     /**
      * The property used internally by the plugin to enable cache buffering which prevents
      * the library file from being written every time the cache is changed.  This is useful
@@ -140,6 +146,12 @@ private:
     void loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SCH_SHEET* aSheet );
     void loadFile( const wxString& aFileName, SCH_SHEET* aSheet );
 
+    /**
+     * Parse the sheet files below \a aScreen, which was loaded from \a aPath, breadth first
+     * and a level of the hierarchy at a time on the thread pool, for loadHierarchy() to pick up.
+     */
+    void prefetchHierarchy( SCH_SCREEN* aScreen, const wxString& aPath );
+
     void saveSymbol( SCH_SYMBOL* aSymbol, const SCHEMATIC& aSchematic, int aNestLevel,
                      bool aForClipboard, const SCH_SHEET_PATH* aRelativePath = nullptr );
     void saveField( SCH_FIELD* aField, int aNestLevel );
@@ -173,6 +185,15 @@ protected:
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
     SCH_IO_KICAD_SEXPR_LIB_CACHE* m_cache;
 
+    /// A sheet file parsed by prefetchHierarchy(), on a placeholder sheet.
+    struct PREFETCHED_SHEET
+    {
+        std::unique_ptr<SCH_SHEET> m_sheet;
+        wxString                   m_error;
+    };
+
+    std::map<wxString, PREFETCHED_SHEET> m_prefetched;   ///< By full file name.
+
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aProperties = nullptr );
 };
@@ -19,7 +19,11 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <functional>
+
 #include <wx/log.h>
+#include <advanced_config.h>
 #include <base_units.h>
 #include <build_version.h>
 #include <lib_shape.h>
@@ -67,17 +71,300 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Load()
     wxLogTrace( traceSchLegacyPlugin, "Loading sexpr symbol library file '%s'",
                 m_libFileName.GetFullPath() );
 
-    FILE_LINE_READER reader( m_libFileName.GetFullPath() );
+    std::unique_ptr<MAPPED_FILE_LINE_READER> reader =
+            std::make_unique<MAPPED_FILE_LINE_READER>( m_libFileName.GetFullPath() );
 
-    SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+    size_t headerEnd = 0;
+    int    version = 0;
+
+    m_unparsed.clear();
+    m_mappedFile.reset();
+
+    if( ADVANCED_CFG::GetCfg().m_LazySymbolLibraries
+            && indexSymbols( reader->Contents(), headerEnd ) )
+    {
+        // Only parse the header now, the symbols are parsed from the mapped file when needed
+        STRING_LINE_READER header( std::string( reader->Contents().substr( 0, headerEnd ) ) + ")",
+                                   m_libFileName.GetFullPath() );
+
+        SCH_IO_KICAD_SEXPR_PARSER parser( &header );
+
+        parser.ParseLib( m_symbols );
+        version = parser.GetParsedRequiredVersion();
+        m_mappedFile = std::move( reader );
+    }
+    else
+    {
+        SCH_IO_KICAD_SEXPR_PARSER parser( reader.get() );
+
+        parser.ParseLib( m_symbols );
+        version = parser.GetParsedRequiredVersion();
+    }
 
-    parser.ParseLib( m_symbols );
     IncrementModifyHash();
 
     // Remember the file modification time of library file when the cache snapshot was made,
     // so that in a networked environment we will reload the cache as needed.
     m_fileModTime = GetLibModificationTime();
-    SetFileFormatVersionAtLoad( parser.GetParsedRequiredVersion() );
+    SetFileFormatVersionAtLoad( version );
+}
+
+
+bool SCH_IO_KICAD_SEXPR_LIB_CACHE::indexSymbols( std::string_view aText, size_t& aHeaderEnd )
+{
+    auto isTokenEnd =
+            []( char c )
+            {
+                return isspace( static_cast<unsigned char>( c ) ) || c == '(' || c == ')';
+            };
+
+    // Read the bare or quoted token at aPos.  Quoted tokens with escapes other than \" and
+    // \\ are left to the parser.
+    auto readToken =
+            [&]( size_t& aPos, std::string& aToken ) -> bool
+            {
+                aToken.clear();
+
+                while( aPos < aText.size() && isspace( static_cast<unsigned char>( aText[aPos] ) ) )
+                    ++aPos;
+
+                if( aPos >= aText.size() )
+                    return false;
+
+                if( aText[aPos] != '"' )
+                {
+                    while( aPos < aText.size() && !isTokenEnd( aText[aPos] ) )
+                        aToken += aText[aPos++];
+
+                    return !aToken.empty();
+                }
+
+                for( ++aPos; aPos < aText.size() && aText[aPos] != '"'; ++aPos )
+                {
+                    if( aText[aPos] == '\\' )
+                    {
+                        if( ++aPos >= aText.size()
+                                || ( aText[aPos] != '"' && aText[aPos] != '\\' ) )
+                        {
+                            return false;
+                        }
+                    }
+
+                    aToken += aText[aPos];
+                }
+
+                if( aPos >= aText.size() )
+                    return false;
+
+                ++aPos;     // the closing quote
+                return true;
+            };
+
+    auto symbolName =
+            []( const std::string& aToken )
+            {
+                wxString name = wxString::FromUTF8( aToken );
+                name.Replace( wxS( "{slash}" ), wxT( "/" ) );
+                return name;
+            };
+
+    int         depth = 0;
+    bool        inSymbol = false;
+    wxString    name;
+    SYMBOL_TEXT entry;
+    std::string token;
+
+    aHeaderEnd = 0;
+
+    for( size_t ii = 0; ii < aText.size(); ++ii )
+    {
+        char c = aText[ii];
+
+        if( c == '"' )
+        {
+            for( ++ii; ii < aText.size() && aText[ii] != '"'; ++ii )
+            {
+                if( aText[ii] == '\\' )
+                    ++ii;
+            }
+        }
+        else if( c == '(' )
+        {
+            ++depth;
+
+            if( depth != 2 && !( depth == 3 && inSymbol ) )
+                continue;
+
+            size_t pos = ii + 1;
+            size_t keywordEnd = pos;
+
+            while( keywordEnd < aText.size() && !isTokenEnd( aText[keywordEnd] ) )
+                ++keywordEnd;
+
+            std::string_view keyword = aText.substr( pos, keywordEnd - pos );
+
+            if( depth == 2 && keyword == "symbol" )
+            {
+                pos = keywordEnd;
+
+                // Names which the parser would turn into another library item name
+                if( !readToken( pos, token ) || token.find( ':' ) != std::string::npos )
+                    return false;
+
+                if( !aHeaderEnd )
+                    aHeaderEnd = ii;
+
+                inSymbol = true;
+                name = symbolName( token );
+                entry = SYMBOL_TEXT();
+                entry.m_offset = ii;
+            }
+            else if( depth == 3 && keyword == "power" )
+            {
+                entry.m_isPower = true;
+            }
+            else if( depth == 3 && keyword == "extends" )
+            {
+                pos = keywordEnd;
+
+                if( !readToken( pos, token ) )
+                    return false;
+
+                entry.m_parent = symbolName( token );
+            }
+        }
+        else if( c == ')' )
+        {
+            if( depth == 2 && inSymbol )
+            {
+                entry.m_length = ii + 1 - entry.m_offset;
+                m_unparsed[name] = entry;
+                inSymbol = false;
+            }
+
+            if( --depth == 0 )
+                break;
+        }
+    }
+
+    // Libraries without symbols or which don't end properly are left to the parser
+    if( depth != 0 || m_unparsed.empty() )
+    {
+        m_unparsed.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR_LIB_CACHE::parseSymbol( const wxString& aName )
+{
+    auto it = m_unparsed.find( aName );
+
+    if( it == m_unparsed.end() )
+        return nullptr;
+
+    SYMBOL_TEXT text = it->second;
+    m_unparsed.erase( it );
+
+    // A derived symbol needs its parent to be parsed first
+    if( !text.m_parent.IsEmpty() )
+        parseSymbol( text.m_parent );
+
+    std::string_view          contents = m_mappedFile->Contents();
+    std::string               symbolText( contents.substr( text.m_offset, text.m_length ) );
+    STRING_LINE_READER        reader( symbolText, m_libFileName.GetFullPath() );
+    SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+
+    LIB_SYMBOL* symbol = parser.ParseSymbol( m_symbols, m_fileFormatVersionAtLoad );
+
+    if( symbol )
+        m_symbols[symbol->GetName()] = symbol;
+
+    return symbol;
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::ParseAll()
+{
+    if( m_unparsed.empty() )
+    {
+        m_mappedFile.reset();
+        return;
+    }
+
+    LOCALE_IO toggle;
+
+    while( !m_unparsed.empty() )
+    {
+        wxString name = m_unparsed.begin()->first;
+        parseSymbol( name );
+    }
+
+    m_mappedFile.reset();
+}
+
+
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR_LIB_CACHE::GetSymbol( const wxString& aName )
+{
+    LIB_SYMBOL* symbol = SCH_IO_LIB_CACHE::GetSymbol( aName );
+
+    if( !symbol && m_unparsed.count( aName ) )
+    {
+        LOCALE_IO toggle;
+        symbol = parseSymbol( aName );
+    }
+
+    return symbol;
+}
+
+
+void SCH_IO_KICAD_SEXPR_LIB_CACHE::AddSymbol( const LIB_SYMBOL* aSymbol )
+{
+    // The symbol may replace, or be the parent of, symbols which haven't been parsed yet
+    ParseAll();
+
+    SCH_IO_LIB_CACHE::AddSymbol( aSymbol );
+}
+
+
+std::vector<wxString> SCH_IO_KICAD_SEXPR_LIB_CACHE::GetSymbolNames( bool aPowerSymbolsOnly ) const
+{
+    std::vector<wxString> names;
+
+    // Derived symbols are power symbols when their root symbol is one
+    std::function<bool( const SYMBOL_TEXT&, int )> isPower =
+            [&]( const SYMBOL_TEXT& aText, int aDepth ) -> bool
+            {
+                if( aText.m_parent.IsEmpty() || aDepth > 16 )
+                    return aText.m_isPower;
+
+                auto parsed = m_symbols.find( aText.m_parent );
+
+                if( parsed != m_symbols.end() )
+                    return parsed->second->IsPower();
+
+                auto unparsed = m_unparsed.find( aText.m_parent );
+
+                return unparsed != m_unparsed.end() && isPower( unparsed->second, aDepth + 1 );
+            };
+
+    for( const auto& [name, symbol] : m_symbols )
+    {
+        if( !aPowerSymbolsOnly || symbol->IsPower() )
+            names.push_back( name );
+    }
+
+    for( const auto& [name, text] : m_unparsed )
+    {
+        if( !aPowerSymbolsOnly || isPower( text, 0 ) )
+            names.push_back( name );
+    }
+
+    std::sort( names.begin(), names.end(), LibSymbolMapSort() );
+
+    return names;
 }
 
 
@@ -86,6 +373,8 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::Save( const std::optional<bool>& aOpt )
     if( !m_isModified )
         return;
 
+    ParseAll();
+
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
     // Write through symlinks, don't replace them.
@@ -522,6 +811,9 @@ void SCH_IO_KICAD_SEXPR_LIB_CACHE::saveTextBox( LIB_TEXTBOX* aTextBox, OUTPUTFOR
 
 void SCH_IO_KICAD_SEXPR_LIB_CACHE::DeleteSymbol( const wxString& aSymbolName )
 {
+    // The symbols derived from it may not have been parsed yet
+    ParseAll();
+
     LIB_SYMBOL_MAP::iterator it = m_symbols.find( aSymbolName );
 
     if( it == m_symbols.end() )
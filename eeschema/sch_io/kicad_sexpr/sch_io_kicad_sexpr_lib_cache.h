@@ -22,9 +22,15 @@
 #ifndef SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 #define SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 
+#include <map>
+#include <memory>
+#include <string_view>
+#include <vector>
+
 #include "sch_io/sch_io_lib_cache.h"
 
 class FILE_LINE_READER;
+class MAPPED_FILE_LINE_READER;
 class LIB_FIELD;
 class LIB_ITEM;
 class LIB_PIN;
@@ -49,10 +55,29 @@ public:
     /// Save the entire library to file m_libFileName;
     void Save( const std::optional<bool>& aOpt = std::nullopt ) override;
 
+    /**
+     * Load the library file.  With lazy symbol libraries enabled, the file is only scanned for
+     * the extent of each of its symbols and they are parsed from the mapped file on demand.
+     */
     void Load() override;
 
+    /**
+     * Parse the symbols which haven't been parsed yet, and release the library file.
+     */
+    void ParseAll();
+
+    void AddSymbol( const LIB_SYMBOL* aSymbol ) override;
+
     void DeleteSymbol( const wxString& aName ) override;
 
+    LIB_SYMBOL* GetSymbol( const wxString& aName ) override;
+
+    /**
+     * Return the names of the symbols of the library, without parsing the ones which haven't
+     * been parsed yet.
+     */
+    std::vector<wxString> GetSymbolNames( bool aPowerSymbolsOnly ) const;
+
     static void SaveSymbol( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& aFormatter,
                             int aNestLevel = 0, const wxString& aLibName = wxEmptyString );
 
@@ -62,8 +87,29 @@ public:
 private:
     friend SCH_IO_KICAD_SEXPR;
 
+    /// Where a symbol which hasn't been parsed yet is in the library file.
+    struct SYMBOL_TEXT
+    {
+        size_t   m_offset = 0;
+        size_t   m_length = 0;
+        wxString m_parent;             ///< The symbol it extends, if any.
+        bool     m_isPower = false;
+    };
+
+    /**
+     * Find the symbols of \a aText and the end of its header.
+     *
+     * @return false if the library has to be parsed as a whole instead.
+     */
+    bool indexSymbols( std::string_view aText, size_t& aHeaderEnd );
+
+    LIB_SYMBOL* parseSymbol( const wxString& aName );
+
     int m_fileFormatVersionAtLoad;
 
+    std::unique_ptr<MAPPED_FILE_LINE_READER>          m_mappedFile;
+    std::map<wxString, SYMBOL_TEXT, LibSymbolMapSort> m_unparsed;
+
     static void saveSymbolDrawItem( LIB_ITEM* aItem, OUTPUTFORMATTER& aFormatter,
                                     int aNestLevel );
     static void saveField( LIB_FIELD* aField, OUTPUTFORMATTER& aFormatter, int aNestLevel );
@@ -35,6 +35,7 @@
 #include <wx/tokenzr.h>
 
 #include <base_units.h>
+#include <eda_units.h>
 #include <lib_id.h>
 #include <lib_shape.h>
 #include <lib_pin.h>
@@ -592,24 +593,31 @@ LIB_ITEM* SCH_IO_KICAD_SEXPR_PARSER::ParseDrawItem()
 
 int SCH_IO_KICAD_SEXPR_PARSER::parseInternalUnits()
 {
-    auto retval = parseDouble() * schIUScale.IU_PER_MM;
-
     // Schematic internal units are represented as integers.  Any values that are
     // larger or smaller than the schematic units represent undefined behavior for
     // the system.  Limit values to the largest that can be displayed on the screen.
     constexpr double int_limit = std::numeric_limits<int>::max() * 0.7071; // 0.7071 = roughly 1/sqrt(2)
 
+    int value;
+
+    // Values written by the formatter are plain decimals which convert exactly without
+    // going through a double.
+    if( EDA_UNIT_UTILS::ParseInternalUnitsExact( CurStr(), schIUScale, value )
+            && value >= -int_limit && value <= int_limit )
+    {
+        return value;
+    }
+
+    auto retval = parseDouble() * schIUScale.IU_PER_MM;
+
     return KiROUND( Clamp<double>( -int_limit, retval, int_limit ) );
 }
 
 
 int SCH_IO_KICAD_SEXPR_PARSER::parseInternalUnits( const char* aExpected )
 {
-    auto retval = parseDouble( aExpected ) * schIUScale.IU_PER_MM;
-
-    constexpr double int_limit = std::numeric_limits<int>::max() * 0.7071;
-
-    return KiROUND( Clamp<double>( -int_limit, retval, int_limit ) );
+    NeedNUMBER( aExpected );
+    return parseInternalUnits();
 }
 
 
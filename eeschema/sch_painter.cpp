@@ -2476,33 +2476,69 @@ void SCH_PAINTER::draw( const SCH_SYMBOL* aSymbol, int aLayer )
     LIB_PINS  originalPins;
     originalSymbol->GetPins( originalPins, unit, bodyStyle );
 
-    // Copy the source so we can re-orient and translate it.
-    LIB_SYMBOL tempSymbol( *originalSymbol );
+    // Draw a copy of the source, re-oriented and translated.  The symbol keeps the copy until
+    // it is moved, rotated or gets another library symbol, rather than it being made again for
+    // each layer and each redraw.
+    std::unique_ptr<LIB_SYMBOL> tempSymbolOwner;
+    LIB_SYMBOL*                 tempSymbol = nullptr;
+
+    if( aSymbol->GetLibSymbolRef() )
+        tempSymbol = aSymbol->GetDrawCache();
+
+    if( !tempSymbol )
+    {
+        tempSymbolOwner = std::make_unique<LIB_SYMBOL>( *originalSymbol );
+        tempSymbol = tempSymbolOwner.get();
+
+        OrientAndMirrorSymbolItems( tempSymbol, aSymbol->GetOrientation() );
+
+        for( LIB_ITEM& tempItem : tempSymbol->GetDrawItems() )
+        {
+            tempItem.MoveTo( tempItem.GetPosition()
+                             + (VECTOR2I) mapCoords( aSymbol->GetPosition() ) );
+        }
+
+        if( aSymbol->GetLibSymbolRef() )
+            aSymbol->SetDrawCache( std::move( tempSymbolOwner ) );
+    }
+
     LIB_PINS tempPins;
-    tempSymbol.GetPins( tempPins, unit, bodyStyle );
+    tempSymbol->GetPins( tempPins, unit, bodyStyle );
 
-    tempSymbol.SetFlags( aSymbol->GetFlags() );
+    // These can be changed on the symbol without replacing its library symbol
+    tempSymbol->SetShowPinNames( originalSymbol->ShowPinNames() );
+    tempSymbol->SetShowPinNumbers( originalSymbol->ShowPinNumbers() );
 
-    OrientAndMirrorSymbolItems( &tempSymbol, aSymbol->GetOrientation() );
+    tempSymbol->ClearFlags();
+    tempSymbol->SetFlags( aSymbol->GetFlags() );
 
-    for( LIB_ITEM& tempItem : tempSymbol.GetDrawItems() )
+    // The texts with variables are expanded for this draw only, so a kept copy still has them
+    std::vector<std::pair<EDA_TEXT*, wxString>> expandedTexts;
+
+    for( LIB_ITEM& tempItem : tempSymbol->GetDrawItems() )
     {
+        tempItem.ClearFlags();
         tempItem.SetFlags( aSymbol->GetFlags() );     // SELECTED, HIGHLIGHTED, BRIGHTENED,
-        tempItem.MoveTo( tempItem.GetPosition() + (VECTOR2I) mapCoords( aSymbol->GetPosition() ) );
 
         if( tempItem.Type() == LIB_TEXT_T )
         {
             LIB_TEXT* textItem = static_cast<LIB_TEXT*>( &tempItem );
 
             if( textItem->HasTextVars() )
+            {
+                expandedTexts.emplace_back( textItem, textItem->GetText() );
                 textItem->SetText( expandLibItemTextVars( textItem->GetText(), aSymbol ) );
+            }
         }
         else if( tempItem.Type() == LIB_TEXTBOX_T )
         {
             LIB_TEXTBOX* textboxItem = static_cast<LIB_TEXTBOX*>( &tempItem );
 
             if( textboxItem->HasTextVars() )
+            {
+                expandedTexts.emplace_back( textboxItem, textboxItem->GetText() );
                 textboxItem->SetText( expandLibItemTextVars( textboxItem->GetText(), aSymbol ) );
+            }
         }
     }
 
@@ -2528,7 +2564,11 @@ void SCH_PAINTER::draw( const SCH_SYMBOL* aSymbol, int aLayer )
         tempPin->SetOperatingPoint( symbolPin->GetOperatingPoint() );
     }
 
-    draw( &tempSymbol, aLayer, false, aSymbol->GetUnit(), aSymbol->GetBodyStyle(), aSymbol->GetDNP() );
+    draw( tempSymbol, aLayer, false, aSymbol->GetUnit(), aSymbol->GetBodyStyle(),
+          aSymbol->GetDNP() );
+
+    for( auto& [text, source] : expandedTexts )
+        text->SetText( source );
 
     for( unsigned i = 0; i < tempPins.size(); ++i )
     {
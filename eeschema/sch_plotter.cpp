@@ -146,9 +146,7 @@ void SCH_PLOTTER::createPDFFile( const SCH_PLOT_SETTINGS& aPlotSettings,
 
     for( unsigned i = 0; i < sheetList.size(); i++ )
     {
-        m_schematic->SetCurrentSheet( sheetList[i] );
-        m_schematic->CurrentSheet().UpdateAllScreenReferences();
-        m_schematic->SetSheetNumberAndCount();
+        setCurrentSheet( sheetList[i] );
 
         SCH_SCREEN* screen = m_schematic->CurrentSheet().LastScreen();
         wxString    sheetName = sheetList[i].Last()->GetFields()[SHEETNAME].GetShownText( false );
@@ -322,9 +320,7 @@ void SCH_PLOTTER::createPSFiles( const SCH_PLOT_SETTINGS& aPlotSettings,
 
     for( unsigned i = 0; i < sheetList.size(); i++ )
     {
-        m_schematic->SetCurrentSheet( sheetList[i] );
-        m_schematic->CurrentSheet().UpdateAllScreenReferences();
-        m_schematic->SetSheetNumberAndCount();
+        setCurrentSheet( sheetList[i] );
 
         SCH_SCREEN* screen = m_schematic->CurrentSheet().LastScreen();
         PAGE_INFO   actualPage = screen->GetPageSettings();
@@ -491,9 +487,7 @@ void SCH_PLOTTER::createSVGFiles( const SCH_PLOT_SETTINGS& aPlotSettings,
     {
         SCH_SCREEN* screen;
 
-        m_schematic->SetCurrentSheet( sheetList[i] );
-        m_schematic->CurrentSheet().UpdateAllScreenReferences();
-        m_schematic->SetSheetNumberAndCount();
+        setCurrentSheet( sheetList[i] );
 
         screen = m_schematic->CurrentSheet().LastScreen();
 
@@ -670,9 +664,7 @@ void SCH_PLOTTER::createHPGLFiles( const SCH_PLOT_SETTINGS& aPlotSettings,
 
     for( unsigned i = 0; i < sheetList.size(); i++ )
     {
-        m_schematic->SetCurrentSheet( sheetList[i] );
-        m_schematic->CurrentSheet().UpdateAllScreenReferences();
-        m_schematic->SetSheetNumberAndCount();
+        setCurrentSheet( sheetList[i] );
 
         screen = m_schematic->CurrentSheet().LastScreen();
 
@@ -858,9 +850,7 @@ void SCH_PLOTTER::createDXFFiles( const SCH_PLOT_SETTINGS& aPlotSettings,
 
     for( unsigned i = 0; i < sheetList.size(); i++ )
     {
-        m_schematic->SetCurrentSheet( sheetList[i] );
-        m_schematic->CurrentSheet().UpdateAllScreenReferences();
-        m_schematic->SetSheetNumberAndCount();
+        setCurrentSheet( sheetList[i] );
 
         SCH_SCREEN* screen = m_schematic->CurrentSheet().LastScreen();
         VECTOR2I    plot_offset;
@@ -978,6 +968,25 @@ bool SCH_PLOTTER::plotOneSheetDXF( const wxString& aFileName, SCH_SCREEN* aScree
 }
 
 
+void SCH_PLOTTER::setCurrentSheet( const SCH_SHEET_PATH& aSheet )
+{
+    m_schematic->SetCurrentSheet( aSheet );
+
+    SCH_SHEET_PATH& sheet = m_schematic->CurrentSheet();
+    auto            it = m_virtualPageNumbers.find( sheet.Path() );
+    int             number = it != m_virtualPageNumbers.end()
+                                     ? it->second
+                                     : (int) m_virtualPageNumbers.size() + 1;
+
+    sheet.UpdateAllScreenReferences();
+
+    // Same as SCHEMATIC::SetSheetNumberAndCount(), from the numbers found when starting the plot
+    sheet.SetVirtualPageNumber( number );
+    sheet.LastScreen()->SetVirtualPageNumber( number );
+    sheet.LastScreen()->SetPageNumber( sheet.GetPageNumber() );
+}
+
+
 void SCH_PLOTTER::restoreEnvironment( PDF_PLOTTER* aPlotter, SCH_SHEET_PATH& aOldsheetpath )
 {
     if( aPlotter )
@@ -1041,6 +1050,14 @@ void SCH_PLOTTER::Plot( PLOT_FORMAT aPlotFormat, const SCH_PLOT_SETTINGS& aPlotS
 
     m_colorSettings = settingsMgr.GetColorSettings( aPlotSettings.m_theme );
 
+    // The page numbers and count don't change while plotting, so find them once here rather
+    // than walking the whole hierarchy again for each plotted sheet
+    m_schematic->SetSheetNumberAndCount();
+    m_virtualPageNumbers.clear();
+
+    for( const SCH_SHEET_PATH& sheet : m_schematic->GetSheets() )
+        m_virtualPageNumbers.emplace( sheet.Path(), (int) m_virtualPageNumbers.size() + 1 );
+
     switch( aPlotFormat )
     {
     default:
@@ -27,6 +27,8 @@
 #ifndef SCH_PLOTTER_H
 #define SCH_PLOTTER_H
 
+#include <map>
+
 #include <wx/string.h>
 #include <wx/gdicmn.h>
 #include <page_info.h>
@@ -192,6 +194,11 @@ protected:
                           RENDER_SETTINGS*         aRenderSettings,
                           const SCH_PLOT_SETTINGS& aPlotSettings );
 
+    /**
+     * Make \a aSheet the current sheet and update its symbol references and page numbers.
+     */
+    void setCurrentSheet( const SCH_SHEET_PATH& aSheet );
+
     /**
      * Everything done, close the plot and restore the environment.
      *
@@ -218,6 +225,9 @@ private:
     SCHEMATIC*      m_schematic;
     COLOR_SETTINGS* m_colorSettings;
     wxString        m_lastOutputFilePath;
+
+    /// The virtual page number of each sheet path of the schematic being plotted.
+    std::map<KIID_PATH, int> m_virtualPageNumbers;
 };
 
 #endif
@@ -33,7 +33,9 @@
 
 #include <wx/regex.h>
 #include <algorithm>
+#include <map>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <string_utils.h>
@@ -402,12 +404,12 @@ void SCH_REFERENCE_LIST::ReannotateDuplicates( const SCH_REFERENCE_LIST& aAdditi
 }
 
 
-void SCH_REFERENCE_LIST::AnnotateByOptions( ANNOTATE_ORDER_T             aSortOption,
-                                            ANNOTATE_ALGO_T              aAlgoOption,
-                                            int                          aStartNumber,
-                                            SCH_MULTI_UNIT_REFERENCE_MAP aLockedUnitMap,
-                                            const SCH_REFERENCE_LIST&    aAdditionalRefs,
-                                            bool                         aStartAtCurrent )
+void SCH_REFERENCE_LIST::AnnotateByOptions( ANNOTATE_ORDER_T                    aSortOption,
+                                            ANNOTATE_ALGO_T                     aAlgoOption,
+                                            int                                 aStartNumber,
+                                            const SCH_MULTI_UNIT_REFERENCE_MAP& aLockedUnitMap,
+                                            const SCH_REFERENCE_LIST&           aAdditionalRefs,
+                                            bool                                aStartAtCurrent )
 {
     switch( aSortOption )
     {
@@ -445,7 +447,7 @@ void SCH_REFERENCE_LIST::AnnotateByOptions( ANNOTATE_ORDER_T             aSortOp
 
 
 void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int aStartNumber,
-                                   SCH_MULTI_UNIT_REFERENCE_MAP aLockedUnitMap,
+                                   const SCH_MULTI_UNIT_REFERENCE_MAP& aLockedUnitMap,
                                    const SCH_REFERENCE_LIST& aAdditionalRefs, bool aStartAtCurrent )
 {
     if ( m_flatList.size() == 0 )
@@ -479,6 +481,166 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         AddItem( additionalRef ); //add to this container
     }
 
+    // The numbers used by the annotated references of each prefix, kept up to date as the
+    // symbols are annotated, so that the free numbers are found without scanning the whole
+    // list for each symbol.  The runs of consecutive numbers in use are skipped at once.
+    struct PREFIX_NUMBERS
+    {
+        std::map<int, std::vector<size_t>> m_refs;  ///< The references using each number.
+        std::map<int, int>                 m_runs;  ///< The last number of each run, by first.
+    };
+
+    std::vector<PREFIX_NUMBERS> prefixNumbers;
+    std::vector<size_t>         prefixOf( m_flatList.size() );
+
+    // The references of each symbol, to find the other instances and units of a symbol
+    std::unordered_map<const SCH_SYMBOL*, std::vector<size_t>> symbolRefs;
+
+    auto addNumber =
+            [&]( size_t aIndex )
+            {
+                PREFIX_NUMBERS&      numbers = prefixNumbers[prefixOf[aIndex]];
+                int                  number = m_flatList[aIndex].m_numRef;
+                std::vector<size_t>& refs = numbers.m_refs[number];
+
+                refs.push_back( aIndex );
+
+                if( refs.size() > 1 )
+                    return;
+
+                int  last = number;
+                auto next = numbers.m_runs.find( number + 1 );
+
+                if( next != numbers.m_runs.end() )
+                {
+                    last = next->second;
+                    numbers.m_runs.erase( next );
+                }
+
+                auto prev = numbers.m_runs.lower_bound( number );
+
+                if( prev != numbers.m_runs.begin() && std::prev( prev )->second == number - 1 )
+                    std::prev( prev )->second = last;
+                else
+                    numbers.m_runs[number] = last;
+            };
+
+    auto removeNumber =
+            [&]( size_t aIndex )
+            {
+                PREFIX_NUMBERS& numbers = prefixNumbers[prefixOf[aIndex]];
+                int             number = m_flatList[aIndex].m_numRef;
+                auto            refs = numbers.m_refs.find( number );
+
+                if( refs == numbers.m_refs.end() )
+                    return;
+
+                alg::delete_matching( refs->second, aIndex );
+
+                if( !refs->second.empty() )
+                    return;
+
+                numbers.m_refs.erase( refs );
+
+                auto run = std::prev( numbers.m_runs.upper_bound( number ) );
+                int  first = run->first;
+                int  last = run->second;
+
+                numbers.m_runs.erase( run );
+
+                if( first < number )
+                    numbers.m_runs[first] = number - 1;
+
+                if( number < last )
+                    numbers.m_runs[number + 1] = last;
+            };
+
+    // The first number >= aMinValue not used by the prefix of the reference at aIndex
+    auto firstFreeNumber =
+            [&]( size_t aIndex, int aMinValue ) -> int
+            {
+                const std::map<int, int>& runs = prefixNumbers[prefixOf[aIndex]].m_runs;
+                auto                      run = runs.upper_bound( aMinValue );
+
+                if( run != runs.begin() && std::prev( run )->second >= aMinValue )
+                    return std::prev( run )->second + 1;
+
+                return aMinValue;
+            };
+
+    // Same as FindFirstUnusedReference(), from the numbers in use
+    auto firstUnusedReference =
+            [&]( size_t aIndex, int aMinValue, const std::vector<int>& aRequiredUnits ) -> int
+            {
+                const SCH_REFERENCE&                      ref = m_flatList[aIndex];
+                const std::map<int, std::vector<size_t>>& refs =
+                        prefixNumbers[prefixOf[aIndex]].m_refs;
+
+                int minFreeNumber = aMinValue;
+
+                for( auto it = refs.lower_bound( minFreeNumber );
+                     it != refs.end() && it->first == minFreeNumber; ++it, ++minFreeNumber )
+                {
+                    auto isNumberInUse =
+                            [&]() -> bool
+                            {
+                                for( int unit : aRequiredUnits )
+                                {
+                                    for( size_t other : it->second )
+                                    {
+                                        const SCH_REFERENCE& otherRef = m_flatList[other];
+
+                                        if( otherRef.CompareLibName( ref )
+                                            || otherRef.CompareValue( ref )
+                                            || otherRef.GetUnit() == unit )
+                                        {
+                                            return true;
+                                        }
+                                    }
+                                }
+
+                                return false;
+                            };
+
+                    if( !isNumberInUse() )
+                        return minFreeNumber;
+                }
+
+                return minFreeNumber;
+            };
+
+    {
+        // Prefixes are compared without case, see SCH_REFERENCE::CompareRef()
+        std::unordered_map<wxString, size_t> prefixIds;
+
+        for( size_t ii = 0; ii < m_flatList.size(); ii++ )
+        {
+            auto [it, added] = prefixIds.emplace( m_flatList[ii].m_ref.Lower(),
+                                                  prefixNumbers.size() );
+
+            if( added )
+                prefixNumbers.emplace_back();
+
+            prefixOf[ii] = it->second;
+            symbolRefs[m_flatList[ii].GetSymbol()].push_back( ii );
+
+            // New references will be reannotated, so their numbers are free
+            if( !m_flatList[ii].m_isNew )
+                addNumber( ii );
+        }
+    }
+
+    // The locked lists holding each symbol, in the order of aLockedUnitMap
+    std::unordered_map<const SCH_SYMBOL*,
+                       std::vector<std::pair<const SCH_REFERENCE*, const SCH_REFERENCE_LIST*>>>
+            lockedRefs;
+
+    for( const SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( const SCH_REFERENCE& lockedRef : pair.second )
+            lockedRefs[lockedRef.GetSymbol()].emplace_back( &lockedRef, &pair.second );
+    }
+
     int LastReferenceNumber = 0;
 
     /* calculate index of the first symbol with the same reference prefix
@@ -506,25 +668,19 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             continue;
 
         // Check whether this symbol is in aLockedUnitMap.
-        SCH_REFERENCE_LIST* lockedList = nullptr;
+        const SCH_REFERENCE_LIST* lockedList = nullptr;
+        auto                      locked = lockedRefs.find( ref_unit.GetSymbol() );
 
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+        if( locked != lockedRefs.end() )
         {
-            unsigned n_refs = pair.second.GetCount();
-
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
+            for( const auto& [lockedRef, list] : locked->second )
             {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( ref_unit ) )
+                if( lockedRef->IsSameInstance( ref_unit ) )
                 {
-                    lockedList = &pair.second;
+                    lockedList = list;
                     break;
                 }
             }
-
-            if( lockedList != nullptr )
-                break;
         }
 
         if(  ( m_flatList[first].CompareRef( ref_unit ) != 0 )
@@ -551,11 +707,10 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         {
             if( ref_unit.m_isNew )
             {
-                std::vector<int> idList;
-                GetRefsInUse( first, idList, minRefId );
-                LastReferenceNumber = createFirstFreeRefId( idList, minRefId );
+                LastReferenceNumber = firstFreeNumber( ii, minRefId );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = wxString::Format( "%d", LastReferenceNumber );
+                addNumber( ii );
             }
 
             ref_unit.m_flag  = 1;
@@ -572,16 +727,17 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
             if( ref_unit.m_isNew )
             {
-                LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+                LastReferenceNumber = firstUnusedReference( ii, minRefId, units );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = wxString::Format( "%d", LastReferenceNumber );
                 ref_unit.m_isNew = false;
                 ref_unit.m_flag = 1;
+                addNumber( ii );
             }
 
             for( unsigned lockedRefI = 0; lockedRefI < n_refs; ++lockedRefI )
             {
-                SCH_REFERENCE& lockedRef = ( *lockedList )[lockedRefI];
+                const SCH_REFERENCE& lockedRef = ( *lockedList )[lockedRefI];
 
                 if( lockedRef.IsSameInstance( ref_unit ) )
                 {
@@ -598,10 +754,15 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                 if( lockedRef.CompareLibName( ref_unit ) != 0 )
                     continue;
 
+                auto candidates = symbolRefs.find( lockedRef.GetSymbol() );
+
+                if( candidates == symbolRefs.end() )
+                    continue;
+
                 // Find the matching symbol
-                for( unsigned jj = ii + 1; jj < m_flatList.size(); jj++ )
+                for( size_t jj : candidates->second )
                 {
-                    if( !lockedRef.IsSameInstance( m_flatList[jj] ) )
+                    if( jj <= ii || !lockedRef.IsSameInstance( m_flatList[jj] ) )
                         continue;
 
                     wxString ref_candidate = buildFullReference( ref_unit, lockedRef.m_unit );
@@ -611,10 +772,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     // multiunits symbols have duplicate references)
                     if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
                     {
+                        if( !m_flatList[jj].m_isNew )
+                            removeNumber( jj );
+
                         m_flatList[jj].m_numRef = ref_unit.m_numRef;
                         m_flatList[jj].m_numRefStr = ref_unit.m_numRefStr;
                         m_flatList[jj].m_isNew = false;
                         m_flatList[jj].m_flag = 1;
+                        addNumber( jj );
 
                         // lock this new full reference
                         inUseRefs.insert( ref_candidate );
@@ -629,10 +794,11 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             // know what group this might belong to, so just find the first unused reference for
             // this specific unit. The other units will be annotated in the following passes.
             std::vector<int> units = { ref_unit.GetUnit() };
-            LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+            LastReferenceNumber = firstUnusedReference( ii, minRefId, units );
             ref_unit.m_numRef = LastReferenceNumber;
             ref_unit.m_isNew = false;
             ref_unit.m_flag = 1;
+            addNumber( ii );
         }
     }
 
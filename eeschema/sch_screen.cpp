@@ -1492,10 +1492,41 @@ std::vector<VECTOR2I> SCH_SCREEN::GetConnections() const
 }
 
 
+std::vector<VECTOR2I> SCH_SCREEN::GetConnectionsOnSegment( const VECTOR2I& aStart,
+                                                           const VECTOR2I& aEnd ) const
+{
+    std::vector<VECTOR2I> retval;
+    BOX2I                 bbox( aStart );
+
+    bbox.Merge( aEnd );
+
+    for( SCH_ITEM* item : Items().Overlapping( bbox ) )
+    {
+        // Avoid items that are changing
+        if( item->GetEditFlags() & ( IS_MOVING | IS_DELETED ) )
+            continue;
+
+        for( const VECTOR2I& pt : item->GetConnectionPoints() )
+        {
+            if( IsPointOnSegment( aStart, aEnd, pt ) )
+                retval.push_back( pt );
+        }
+    }
+
+    std::sort( retval.begin(), retval.end(),
+               []( const VECTOR2I& a, const VECTOR2I& b ) -> bool
+               {
+                   return a.x < b.x || ( a.x == b.x && a.y < b.y );
+               } );
+    retval.erase( std::unique( retval.begin(), retval.end() ), retval.end() );
+
+    return retval;
+}
+
+
 std::vector<VECTOR2I> SCH_SCREEN::GetNeededJunctions( const std::deque<EDA_ITEM*>& aItems ) const
 {
     std::vector<VECTOR2I> pts;
-    std::vector<VECTOR2I> connections = GetConnections();
 
     for( const EDA_ITEM* edaItem : aItems )
     {
@@ -1513,10 +1544,10 @@ std::vector<VECTOR2I> SCH_SCREEN::GetNeededJunctions( const std::deque<EDA_ITEM*
         {
             SCH_LINE* line = (SCH_LINE*) item;
 
-            for( const VECTOR2I& pt : connections )
+            for( const VECTOR2I& pt : GetConnectionsOnSegment( line->GetStartPoint(),
+                                                               line->GetEndPoint() ) )
             {
-                if( IsPointOnSegment( line->GetStartPoint(), line->GetEndPoint(), pt ) )
-                    pts.push_back( pt );
+                pts.push_back( pt );
             }
         }
     }
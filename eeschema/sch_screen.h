@@ -455,6 +455,17 @@ public:
      */
     std::vector<VECTOR2I> GetConnections() const;
 
+    /**
+     * Collect the unique connection points of the schematic which lie on a segment.
+     *
+     * This is the same as filtering GetConnections(), but only looks at the items the R-tree
+     * finds around the segment.
+     *
+     * @return vector of connections
+     */
+    std::vector<VECTOR2I> GetConnectionsOnSegment( const VECTOR2I& aStart,
+                                                   const VECTOR2I& aEnd ) const;
+
     /**
      * Return the unique set of points belonging to aItems where a junction is needed.
      *
@@ -301,6 +301,22 @@ KIID_PATH SCH_SHEET_PATH::Path() const
 }
 
 
+bool SCH_SHEET_PATH::IsPath( const KIID_PATH& aPath ) const
+{
+    if( aPath.size() != m_sheets.size() )
+        return false;
+
+    // The paths to a reused sheet share their ends, so compare from the root
+    for( size_t ii = 0; ii < m_sheets.size(); ++ii )
+    {
+        if( aPath[ii] != m_sheets[ii]->m_Uuid )
+            return false;
+    }
+
+    return true;
+}
+
+
 wxString SCH_SHEET_PATH::PathHumanReadable( bool aUseShortRootName,
                                             bool aStripTrailingSeparator ) const
 {
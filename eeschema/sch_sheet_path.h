@@ -289,6 +289,11 @@ public:
      */
     KIID_PATH Path() const;
 
+    /**
+     * @return true if \a aPath is the #KIID_PATH of this sheet path, without building it.
+     */
+    bool IsPath( const KIID_PATH& aPath ) const;
+
     /**
      * Return the sheet path in a human readable form made from the sheet names.
      *
@@ -359,6 +359,9 @@ void SCH_SYMBOL::UpdatePins()
 
     m_pinMap.clear();
 
+    // The library symbol may have changed
+    m_drawCache.reset();
+
     if( !m_part )
         return;
 
@@ -452,6 +455,23 @@ void SCH_SYMBOL::UpdatePins()
 }
 
 
+LIB_SYMBOL* SCH_SYMBOL::GetDrawCache() const
+{
+    if( m_drawCache && m_drawCacheTransform == m_transform && m_drawCachePos == m_pos )
+        return m_drawCache.get();
+
+    return nullptr;
+}
+
+
+void SCH_SYMBOL::SetDrawCache( std::unique_ptr<LIB_SYMBOL> aSymbol ) const
+{
+    m_drawCache = std::move( aSymbol );
+    m_drawCacheTransform = m_transform;
+    m_drawCachePos = m_pos;
+}
+
+
 void SCH_SYMBOL::SetUnit( int aUnit )
 {
     UpdateUnit( aUnit );
@@ -748,20 +768,31 @@ void SCH_SYMBOL::AddHierarchicalReference( const SCH_SYMBOL_INSTANCE& aInstance
 }
 
 
+const SCH_SYMBOL_INSTANCE* SCH_SYMBOL::findInstance( const SCH_SHEET_PATH* aSheet ) const
+{
+    // This is called for every symbol of every sheet by the netlisters and the annotation, so
+    // avoid building the KIID_PATH of aSheet for each instance compared
+    for( const SCH_SYMBOL_INSTANCE& instance : m_instanceReferences )
+    {
+        if( aSheet->IsPath( instance.m_Path ) )
+            return &instance;
+    }
+
+    return nullptr;
+}
+
+
 const wxString SCH_SYMBOL::GetRef( const SCH_SHEET_PATH* sheet, bool aIncludeUnit ) const
 {
-    KIID_PATH path = sheet->Path();
-    wxString  ref;
-    wxString  subRef;
+    wxString ref;
+    wxString subRef;
 
-    for( const SCH_SYMBOL_INSTANCE& instance : m_instanceReferences )
+    if( const SCH_SYMBOL_INSTANCE* instance = findInstance( sheet ) )
     {
-        if( instance.m_Path == path )
-        {
-            ref = instance.m_Reference;
-            subRef = SubReference( instance.m_Unit );
-            break;
-        }
+        ref = instance->m_Reference;
+
+        if( aIncludeUnit )
+            subRef = SubReference( instance->m_Unit );
     }
 
     // If it was not found in m_Paths array, then see if it is in m_Field[REFERENCE] -- if so,
@@ -827,13 +858,8 @@ void SCH_SYMBOL::SetRef( const SCH_SHEET_PATH* sheet, const wxString& ref )
 
 bool SCH_SYMBOL::IsAnnotated( const SCH_SHEET_PATH* aSheet )
 {
-    KIID_PATH path = aSheet->Path();
-
-    for( const SCH_SYMBOL_INSTANCE& instance : m_instanceReferences )
-    {
-        if( instance.m_Path == path )
-            return instance.m_Reference.Last() != '?';
-    }
+    if( const SCH_SYMBOL_INSTANCE* instance = findInstance( aSheet ) )
+        return instance->m_Reference.Last() != '?';
 
     return false;
 }
@@ -877,13 +903,8 @@ wxString SCH_SYMBOL::SubReference( int aUnit, bool aAddSeparator ) const
 
 int SCH_SYMBOL::GetUnitSelection( const SCH_SHEET_PATH* aSheet ) const
 {
-    KIID_PATH path = aSheet->Path();
-
-    for( const SCH_SYMBOL_INSTANCE& instance : m_instanceReferences )
-    {
-        if( instance.m_Path == path )
-            return instance.m_Unit;
-    }
+    if( const SCH_SYMBOL_INSTANCE* instance = findInstance( aSheet ) )
+        return instance->m_Unit;
 
     // If it was not found in m_Paths array, then use m_unit.  This will happen if we load a
     // version 1 schematic file.
@@ -262,6 +262,21 @@ public:
      */
     void UpdatePins();
 
+    /**
+     * Return the copy of the library symbol, oriented and placed like this symbol, which the
+     * painter kept from a previous draw.
+     *
+     * @return nullptr if there is no such copy or if the symbol was moved, rotated or mirrored
+     *         since it was made.
+     */
+    LIB_SYMBOL* GetDrawCache() const;
+
+    /**
+     * Keep \a aSymbol, a copy of the library symbol oriented and placed like this symbol, for
+     * the next draws.  It is dropped when the library symbol changes.
+     */
+    void SetDrawCache( std::unique_ptr<LIB_SYMBOL> aSymbol ) const;
+
     /**
      * Change the unit number to \a aUnit
      *
@@ -913,6 +928,11 @@ public:
 private:
     BOX2I doGetBoundingBox( bool aIncludePins, bool aIncludeFields ) const;
 
+    /**
+     * @return the instance of this symbol in \a aSheet, or nullptr if there is none.
+     */
+    const SCH_SYMBOL_INSTANCE* findInstance( const SCH_SHEET_PATH* aSheet ) const;
+
     bool doIsConnected( const VECTOR2I& aPosition ) const override;
 
     void Init( const VECTOR2I& pos = VECTOR2I( 0, 0 ) );
@@ -945,6 +965,10 @@ private:
     std::vector<std::unique_ptr<SCH_PIN>>  m_pins;      ///< a SCH_PIN for every LIB_PIN (all units)
     std::unordered_map<LIB_PIN*, SCH_PIN*> m_pinMap;    ///< library pin pointer : SCH_PIN's index
 
+    mutable std::unique_ptr<LIB_SYMBOL>    m_drawCache; ///< m_part as drawn, see GetDrawCache()
+    mutable TRANSFORM                      m_drawCacheTransform;
+    mutable VECTOR2I                       m_drawCachePos;
+
     bool        m_isInNetlist;            ///< True if the symbol should appear in the netlist
     bool        m_excludedFromSim;        ///< True to exclude from simulation.
     bool        m_excludedFromBOM;        ///< True to exclude from bill of materials export.
@@ -94,8 +94,12 @@ void SCH_VIEW::ResizeSheetWorkingArea( const SCH_SCREEN* aScreen )
 
 void SCH_VIEW::DisplaySheet( const SCH_SCREEN *aScreen )
 {
+    std::vector<VIEW_ITEM*> items;
+
     for( SCH_ITEM* item : aScreen->Items() )
-        Add( item );
+        items.push_back( item );
+
+    AddItems( items );
 
     m_drawingSheet.reset( new DS_PROXY_VIEW_ITEM( schIUScale, &aScreen->GetPageSettings(),
                                                   &aScreen->Schematic()->Prj(),
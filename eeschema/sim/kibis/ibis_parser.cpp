@@ -33,6 +33,8 @@
 #include "ibis_parser.h"
 
 #include <sstream>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring> //for memcmp
 #include <iterator>
 #include <locale_io.h> // KiCad header
@@ -810,10 +812,25 @@ bool IbisParser::ParseFile( std::string& aFileName )
         return false;
     }
 
-    std::ostringstream ss;
-    ss << ibisFile.rdbuf();
-    const std::string& s = ss.str();
-    m_buffer = std::vector<char>( s.begin(), s.end() );
+    // Read the file straight into the buffer; DDR files are several megabytes
+    ibisFile.seekg( 0, std::ios::end );
+    std::streamoff fileSize = ibisFile.tellg();
+    ibisFile.seekg( 0, std::ios::beg );
+
+    if( fileSize > 0 )
+    {
+        m_buffer.resize( fileSize );
+        ibisFile.read( m_buffer.data(), fileSize );
+        m_buffer.resize( ibisFile.gcount() );
+    }
+    else
+    {
+        std::ostringstream ss;
+        ss << ibisFile.rdbuf();
+        const std::string& s = ss.str();
+        m_buffer = std::vector<char>( s.begin(), s.end() );
+    }
+
     m_buffer.push_back( 0 );
 
     long size = m_buffer.size();
@@ -926,41 +943,57 @@ bool IbisParser::readDvdt( std::string& aString, dvdt& aDest )
 
 
 bool IbisParser::parseDouble( double& aDest, std::string& aStr, bool aAllowModifiers )
+{
+    return parseDouble( aDest, aStr.c_str(), aStr.size(), aAllowModifiers );
+}
+
+
+bool IbisParser::parseDouble( double& aDest, const char* aStr, size_t aLength,
+                              bool aAllowModifiers )
 {
     // "  an entry of the C matrix could be given as 1.23e-12 or as 1.23p or 1.23pF."
     // Kibis: This implementation will also allow 1.23e-3n
 
     skipWhitespaces();
-    bool status = true;
-    bool converted = false;
-
-    std::string str = aStr;
 
-    double result;
-    size_t size = 0;
+    if( aLength == 2 && aStr[0] == 'N' && aStr[1] == 'A' )
+    {
+        aDest = nan( NAN_NA );
+        return true;
+    }
 
+    // Table values are short, so they are copied to a terminated string on the stack.  Unlike
+    // std::stod(), strtod() doesn't throw at each value which isn't a number.
+    char        shortStr[64];
+    std::string longStr;
+    const char* str = shortStr;
 
-    if( str == "NA" )
+    if( aLength < sizeof( shortStr ) )
     {
-        result = nan( NAN_NA );
+        memcpy( shortStr, aStr, aLength );
+        shortStr[aLength] = 0;
     }
     else
     {
-        try
-        {
-            result = std::stod( str, &size );
-            converted = true;
-        }
-        catch( ... )
-        {
-            result = nan( NAN_INVALID );
-            status = false;
-        }
+        longStr.assign( aStr, aLength );
+        str = longStr.c_str();
+    }
+
+    char* end = nullptr;
+    errno = 0;
+
+    double result = strtod( str, &end );
+    size_t size = end - str;
+
+    if( size == 0 || errno == ERANGE )
+    {
+        aDest = nan( NAN_INVALID );
+        return false;
     }
 
-    if( converted && ( size < str.length() ) )
+    if( size < aLength )
     {
-        switch( static_cast<char>( str.at( size ) ) )
+        switch( str[size] )
         {
         case 'T': result *= 1e12; break;
         case 'G': result *= 1e9; break;
@@ -979,7 +1012,7 @@ bool IbisParser::parseDouble( double& aDest, std::string& aStr, bool aAllowModif
 
     aDest = result;
 
-    return status;
+    return true;
 }
 
 
@@ -1042,11 +1075,21 @@ void IbisParser::printLine()
 bool IbisParser::readDouble( double& aDest )
 {
     bool status = true;
-    std::string str;
 
-    if( readWord( str ) )
+    // Same as readWord(), without building a string for each value of the tables
+    skipWhitespaces();
+
+    int startIndex = m_lineIndex;
+
+    while( ( !isspace( m_buffer[m_lineOffset + m_lineIndex] ) ) && ( m_lineIndex < m_lineLength ) )
     {
-        if( !parseDouble( aDest, str, true ) )
+        m_lineIndex++;
+    }
+
+    if( m_lineIndex > startIndex )
+    {
+        if( !parseDouble( aDest, &m_buffer[m_lineOffset + startIndex], m_lineIndex - startIndex,
+                          true ) )
         {
             Report( _( "Failed to read a double." ), RPT_SEVERITY_WARNING );
             status = false;
@@ -1835,9 +1878,8 @@ bool IbisParser::readModelSelector()
     return status;
 }
 
-bool IbisParser::readNumericSubparam( std::string aSubparam, double& aDest )
+bool IbisParser::readNumericSubparam( const std::string& aSubparam, double& aDest )
 {
-    std::string paramName;
     bool     status = true;
 
     if( aSubparam.size() >= (size_t)m_lineLength )
@@ -1846,20 +1888,12 @@ bool IbisParser::readNumericSubparam( std::string aSubparam, double& aDest )
         return false;
     }
 
-    int old_index = m_lineIndex;
-    m_lineIndex = 0;
-
-
-    for( size_t i = 0; i < aSubparam.size(); i++ )
-    {
-        paramName += m_buffer[m_lineOffset + m_lineIndex++];
-    }
-
-    if( strcmp( paramName.c_str(), aSubparam.c_str() ) )
-    {
-        m_lineIndex = old_index;
+    // Most lines are table rows: compare in place, before moving the cursor
+    if( memcmp( &m_buffer[m_lineOffset], aSubparam.c_str(), aSubparam.size() ) )
         return false;
-    }
+
+    int old_index = m_lineIndex;
+    m_lineIndex = aSubparam.size();
 
     skipWhitespaces();
 
@@ -2173,17 +2207,17 @@ bool IbisParser::readTableLine( std::vector<std::string>& aDest )
 
     while( m_lineIndex < m_lineLength )
     {
-        std::string str;
+        int startIndex = m_lineIndex;
 
         while( ( !isspace( m_buffer[m_lineOffset + m_lineIndex] ) )
                && ( m_lineIndex < m_lineLength ) )
         {
-            str += m_buffer[m_lineOffset + m_lineIndex++];
+            m_lineIndex++;
         }
 
-        if( str.size() > 0 )
+        if( m_lineIndex > startIndex )
         {
-            aDest.push_back( str );
+            aDest.emplace_back( &m_buffer[m_lineOffset + startIndex], m_lineIndex - startIndex );
         }
         while( isspace( m_buffer[m_lineOffset + m_lineIndex] ) && ( m_lineIndex < m_lineLength ) )
         {
@@ -744,6 +744,17 @@ private:
      */
     bool parseDouble( double& aDest, std::string& aStr, bool aAllowModifiers = false );
 
+    /** @brief Parse a double according to the ibis standard
+     *
+     * @param aDest Where the double should be stored
+     * @param aStr The characters to parse, which don't need to be null terminated
+     * @param aLength The number of characters to parse
+     * @param aAllowModifiers Allows modifiers ( p for pico, f for femto, k for kilo, ... )
+     * @return True in case of success
+     */
+    bool parseDouble( double& aDest, const char* aStr, size_t aLength,
+                      bool aAllowModifiers = false );
+
     /** @brief Parse the current line
      *
      * @return True in case of success
@@ -778,7 +789,7 @@ private:
     bool storeString( std::string& aDest, bool aMultiline );
     bool readTableLine( std::vector<std::string>& aDest );
 
-    bool readNumericSubparam( std::string aSubparam, double& aDest );
+    bool readNumericSubparam( const std::string& aSubparam, double& aDest );
     bool readIVtableEntry( IVtable& aTable );
     bool readVTtableEntry( VTtable& aTable );
     bool readTypMinMaxValue( TypMinMaxValue& aDest );
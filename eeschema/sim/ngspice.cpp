@@ -66,7 +66,8 @@ NGSPICE::NGSPICE() :
         m_ngSpice_Running( nullptr ),
         m_ngSpice_LockRealloc( nullptr ),
         m_ngSpice_UnlockRealloc( nullptr ),
-        m_error( false )
+        m_error( false ),
+        m_streamedPoints( 0 )
 {
     init_dll();
 }
@@ -244,6 +245,43 @@ std::vector<double> NGSPICE::GetGainVector( const std::string& aName, int aMaxLe
 }
 
 
+std::vector<double> NGSPICE::GetGainVectorTail( const std::string& aName, size_t aStart,
+                                                int aMaxLen )
+{
+    LOCALE_IO            c_locale;       // ngspice works correctly only with C locale
+    std::vector<double>  data;
+    NGSPICE_LOCK_REALLOC lock( this );
+
+    if( aMaxLen == 0 )
+        return data;
+
+    if( vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() ) )
+    {
+        if( vi->v_length <= 0 || aStart >= (size_t) vi->v_length )
+            return data;
+
+        size_t end = vi->v_length;
+
+        if( aMaxLen > 0 )
+            end = std::min( end, aStart + aMaxLen );
+
+        data.reserve( end - aStart );
+
+        if( vi->v_realdata )
+        {
+            data.assign( vi->v_realdata + aStart, vi->v_realdata + end );
+        }
+        else if( vi->v_compdata )
+        {
+            for( size_t i = aStart; i < end; i++ )
+                data.push_back( hypot( vi->v_compdata[i].cx_real, vi->v_compdata[i].cx_imag ) );
+        }
+    }
+
+    return data;
+}
+
+
 std::vector<double> NGSPICE::GetPhaseVector( const std::string& aName, int aMaxLen )
 {
     LOCALE_IO            c_locale;       // ngspice works correctly only with C locale
@@ -327,6 +365,7 @@ bool NGSPICE::LoadNetlist( const std::string& aNetlist )
 bool NGSPICE::Run()
 {
     LOCALE_IO toggle;               // ngspice works correctly only with C locale
+    m_streamedPoints = 0;
     return Command( "bg_run" );     // bg_* commands execute in a separate thread
 }
 
@@ -508,7 +547,7 @@ void NGSPICE::init_dll()
         m_ngSpice_UnlockRealloc = (ngSpice_UnlockRealloc) m_dll.GetSymbol( "ngSpice_UnlockRealloc" );
     }
 
-    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, nullptr, nullptr,
+    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, &cbSendData, &cbSendInitData,
                     &cbBGThreadRunning, this );
 
     // Load a custom spinit file, to fix the problem with loading .cm files
@@ -688,6 +727,27 @@ int NGSPICE::cbSendStat( char *aWhat, int aId, void* aUser )
 }
 
 
+int NGSPICE::cbSendData( pvecvaluesall aData, int aCount, int aId, void* aUser )
+{
+    // Called from the simulation thread for every computed point; the values themselves are
+    // read from the vectors when the plots are refreshed.
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( aUser );
+    sim->m_streamedPoints++;
+
+    return 0;
+}
+
+
+int NGSPICE::cbSendInitData( pvecinfoall aData, int aId, void* aUser )
+{
+    // Sent when a simulation sets up its vectors
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( aUser );
+    sim->m_streamedPoints = 0;
+
+    return 0;
+}
+
+
 int NGSPICE::cbBGThreadRunning( NG_BOOL aFinished, int aId, void* aUser )
 {
     NGSPICE* sim = reinterpret_cast<NGSPICE*>( aUser );
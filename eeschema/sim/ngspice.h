@@ -33,6 +33,8 @@
 
 #include <wx/dynlib.h>
 
+#include <atomic>
+
 #include <ngspice/sharedspice.h>
 
 #include <enum_vector.h>
@@ -49,6 +51,12 @@
 class wxDynamicLibrary;
 
 
+/**
+ * Interface to the ngspice shared library.
+ *
+ * The library keeps its circuits, plots and vectors in global state, so all NGSPICE objects of
+ * a process drive the same simulator and only one analysis can run at a time.
+ */
 class NGSPICE : public SPICE_SIMULATOR
 {
 public:
@@ -102,6 +110,13 @@ public:
     ///< @copydoc SPICE_SIMULATOR::GetPhaseVector()
     std::vector<double> GetPhaseVector( const std::string& aName, int aMaxLen = -1 ) override final;
 
+    ///< @copydoc SPICE_SIMULATOR::GetGainVectorTail()
+    std::vector<double> GetGainVectorTail( const std::string& aName, size_t aStart,
+                                           int aMaxLen = -1 ) override final;
+
+    ///< @copydoc SPICE_SIMULATOR::StreamedPointCount()
+    size_t StreamedPointCount() const override final { return m_streamedPoints; }
+
     std::vector<std::string> GetSettingCommands() const override final;
 
     ///< @copydoc SPICE_SIMULATOR::GetNetlist()
@@ -181,6 +196,8 @@ private:
     // Callback functions
     static int cbSendChar( char* what, int aId, void* aUser );
     static int cbSendStat( char* what, int aId, void* aUser );
+    static int cbSendData( pvecvaluesall aData, int aCount, int aId, void* aUser );
+    static int cbSendInitData( pvecinfoall aData, int aId, void* aUser );
     static int cbBGThreadRunning( NG_BOOL aFinished, int aId, void* aUser );
     static int cbControlledExit( int aStatus, NG_BOOL aImmediate, NG_BOOL aExitOnQuit, int aId,
                                  void* aUser );
@@ -194,6 +211,9 @@ private:
     static bool m_initialized;      ///< Ngspice should be initialized only once.
 
     std::string m_netlist;          ///< Current netlist
+
+    ///< Points sent by ngspice since the current simulation started.
+    std::atomic<size_t> m_streamedPoints;
 };
 
 #endif /* NGSPICE_H */
@@ -29,6 +29,9 @@
 #include <kiway.h>
 #include "sim_lib_mgr.h"
 
+#include <map>
+#include <mutex>
+
 std::string SPICE_GENERATOR_KIBIS::ModelName( const SPICE_ITEM& aItem ) const
 {
     return fmt::format( "{}.{}", aItem.refName, aItem.baseModelName );
@@ -75,6 +78,34 @@ std::string SPICE_GENERATOR_KIBIS::IbisDevice( const SPICE_ITEM& aItem, const PR
     if( reporter.HasMessage() )
         THROW_IO_ERROR( msg );
 
+    // Generating a driver parses the whole IBIS file and simulates its waveforms, so the
+    // devices are kept for as long as the file and all their inputs stay the same
+    static std::mutex                         s_devicesMutex;
+    static std::map<std::string, std::string> s_devices;
+
+    wxFileName  fn( path );
+    std::string key = fmt::format( "{}\n{}\n{}\n{}\n{}\n{}\n{}\n{}\n{}",
+                                   path.ToStdString(),
+                                   fn.GetModificationTime().IsValid()
+                                           ? fn.GetModificationTime().GetTicks() : 0,
+                                   fn.GetSize().ToString().ToStdString(), ibisCompName,
+                                   ibisPinName, ibisModelName, diffMode,
+                                   static_cast<int>( m_model.GetType() ), aItem.modelName );
+
+    for( int ii = 0; ii < m_model.GetParamCount(); ++ii )
+    {
+        const SIM_MODEL::PARAM& param = m_model.GetParam( ii );
+        key += fmt::format( "\n{}={}", param.info.name, param.value );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( s_devicesMutex );
+        auto                        it = s_devices.find( key );
+
+        if( it != s_devices.end() )
+            return it->second;
+    }
+
     KIBIS kibis( std::string( path.c_str() ) );
     kibis.m_cacheDir = std::string( aCacheDir.c_str() );
     kibis.m_reporter = &aReporter;
@@ -221,6 +252,17 @@ std::string SPICE_GENERATOR_KIBIS::IbisDevice( const SPICE_ITEM& aItem, const PR
         return "";
     }
 
+    if( !result.empty() )
+    {
+        std::lock_guard<std::mutex> lock( s_devicesMutex );
+
+        // Each edit of a parameter adds a device; don't let them pile up
+        if( s_devices.size() >= 1000 )
+            s_devices.clear();
+
+        s_devices[key] = result;
+    }
+
     return result;
 }
 
@@ -167,6 +167,20 @@ public:
         mpFXYVector::SetData( aX, aY );
     }
 
+    /**
+     * Append points to the data set of the trace.  aX and aY need to have the same length.
+     */
+    void AppendData( const std::vector<double>& aX, const std::vector<double>& aY ) override
+    {
+        for( auto& [ idx, cursor ] : m_cursors )
+        {
+            if( cursor )
+                cursor->Update();
+        }
+
+        mpFXYVector::AppendData( aX, aY );
+    }
+
     const std::vector<double>& GetDataX() const { return m_xs; }
     const std::vector<double>& GetDataY() const { return m_ys; }
 
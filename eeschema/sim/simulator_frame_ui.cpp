@@ -514,7 +514,8 @@ SIMULATOR_FRAME_UI::SIMULATOR_FRAME_UI( SIMULATOR_FRAME* aSimulatorFrame,
         m_schematicFrame( aSchematicFrame ),
         m_darkMode( true ),
         m_plotNumber( 0 ),
-        m_refreshTimer( this, ID_SIM_REFRESH )
+        m_refreshTimer( this, ID_SIM_REFRESH ),
+        m_refreshedPoints( 0 )
 {
     // Get the previous size and position of windows:
     LoadSettings( m_schematicFrame->eeconfig() );
@@ -563,7 +564,14 @@ SIMULATOR_FRAME_UI::SIMULATOR_FRAME_UI( SIMULATOR_FRAME* aSimulatorFrame,
     Bind( wxEVT_TIMER,
             [&]( wxTimerEvent& aEvent )
             {
-                OnSimRefresh( false );
+                size_t points = simulator()->StreamedPointCount();
+
+                // Nothing to show until the simulator sends new points
+                if( points != m_refreshedPoints )
+                {
+                    m_refreshedPoints = points;
+                    OnSimRefresh( false );
+                }
 
                 if( m_simulatorFrame->GetSimulator()->IsRunning() )
                     m_refreshTimer.Start( REFRESH_INTERVAL, wxTIMER_ONE_SHOT );
@@ -1743,6 +1751,36 @@ void SIMULATOR_FRAME_UI::updateTrace( const wxString& aVectorName, int aTraceTyp
 }
 
 
+void SIMULATOR_FRAME_UI::appendTraceData( TRACE* aTrace, const wxString& aVectorName )
+{
+    wxString simVectorName = aVectorName;
+
+    if( aTrace->GetType() & SPT_POWER )
+        simVectorName = simVectorName.AfterFirst( '(' ).BeforeLast( ')' ) + wxS( ":power" );
+
+    wxString xAxisName( simulator()->GetXAxis( ST_TRAN ) );
+
+    if( xAxisName.IsEmpty() )
+        return;
+
+    size_t              start = aTrace->GetDataX().size();
+    std::vector<double> data_x = simulator()->GetGainVectorTail( (const char*) xAxisName.c_str(),
+                                                                 start );
+
+    if( data_x.empty() )
+        return;
+
+    std::vector<double> data_y =
+            simulator()->GetGainVectorTail( (const char*) simVectorName.c_str(), start,
+                                            (int) data_x.size() );
+
+    // The simulator may not have written all the vectors of its last point yet
+    data_x.resize( data_y.size() );
+
+    aTrace->AppendData( data_x, data_y );
+}
+
+
 void SIMULATOR_FRAME_UI::updateSignalsGrid()
 {
     SIM_PLOT_TAB* plotTab = dynamic_cast<SIM_PLOT_TAB*>( GetCurrentSimTab() );
@@ -2635,9 +2673,19 @@ void SIMULATOR_FRAME_UI::onPlotCursorUpdate( wxCommandEvent& aEvent )
 void SIMULATOR_FRAME_UI::OnSimUpdate()
 {
     if( SIM_PLOT_TAB* plotTab = dynamic_cast<SIM_PLOT_TAB*>( GetCurrentSimTab() ) )
+    {
+        // Transient traces are extended while the simulation runs, so they must start empty
+        if( plotTab->GetSimType() == ST_TRAN )
+        {
+            for( const auto& [ name, trace ] : plotTab->GetTraces() )
+                trace->SetData( {}, {} );
+        }
+
         plotTab->ResetScales( true );
+    }
 
     m_simConsole->Clear();
+    m_refreshedPoints = 0;
 
     // Do not export netlist, it is already stored in the simulator
     applyTuners();
@@ -2801,7 +2849,12 @@ void SIMULATOR_FRAME_UI::OnSimRefresh( bool aFinal )
         {
             std::vector<double> data_x;
 
-            if( !info.Vector.IsEmpty() )
+            if( info.Vector.IsEmpty() )
+                continue;
+
+            if( !aFinal && simType == ST_TRAN && !info.ClearData && !trace->GetDataX().empty() )
+                appendTraceData( trace, info.Vector );
+            else
                 updateTrace( info.Vector, info.TraceType, plotTab, &data_x, info.ClearData );
         }
 
@@ -243,6 +243,15 @@ private:
     void updateTrace( const wxString& aVectorName, int aTraceType, SIM_PLOT_TAB* aPlotTab,
                       std::vector<double>* aDataX = nullptr, bool aClearData = false );
 
+    /**
+     * Extend a transient analysis trace with the values computed since it was last updated,
+     * rather than replacing all of its data.
+     *
+     * @param aTrace is the trace to extend.
+     * @param aVectorName is the SPICE vector name, such as "I(Net-C1-Pad1)".
+     */
+    void appendTraceData( TRACE* aTrace, const wxString& aVectorName );
+
     /**
      * Rebuild the list of signals available from the netlist.
      *
@@ -342,6 +351,7 @@ private:
     bool                         m_darkMode;
     unsigned int                 m_plotNumber;
     wxTimer                      m_refreshTimer;
+    size_t                       m_refreshedPoints;   ///< Simulated points at last refresh
 };
 
 #endif // SIMULATOR_FRAME_UI_H
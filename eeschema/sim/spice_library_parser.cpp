@@ -34,6 +34,12 @@
 #include <pegtl.hpp>
 #include <pegtl/contrib/parse_tree.hpp>
 
+#include <wx/filename.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
 
 namespace SIM_LIBRARY_SPICE_PARSER
 {
@@ -131,8 +137,55 @@ void SPICE_LIBRARY_PARSER::readFallbacks( const wxString& aFilePath, REPORTER& a
 }
 
 
-void SPICE_LIBRARY_PARSER::parseFile( const wxString &aFilePath, REPORTER& aReporter )
+/**
+ * The model and include statements of a library file, in file order, as found by the grammar.
+ *
+ * Running the grammar over a large vendor library takes much longer than creating its models,
+ * so the statements are kept for the whole session and found again while the file's
+ * modification time and size stay the same.
+ */
+struct SPICE_LIBRARY_FILE
+{
+    struct UNIT
+    {
+        bool        m_isInclude;
+        std::string m_name;     ///< The model name, or the path of the included file
+        std::string m_text;     ///< The model statement
+    };
+
+    wxDateTime        m_modTime;
+    wxULongLong       m_size;
+    std::vector<UNIT> m_units;
+};
+
+
+static std::mutex                                                     s_libraryFilesMutex;
+static std::map<wxString, std::shared_ptr<const SPICE_LIBRARY_FILE>> s_libraryFiles;
+
+
+static std::shared_ptr<const SPICE_LIBRARY_FILE> readLibraryFile( const wxString& aFilePath,
+                                                                  REPORTER&       aReporter )
 {
+    wxFileName  fn( aFilePath );
+    wxDateTime  modTime = fn.GetModificationTime();
+    wxULongLong size = fn.GetSize();
+
+    if( modTime.IsValid() && size != wxInvalidSize )
+    {
+        std::lock_guard<std::mutex> lock( s_libraryFilesMutex );
+        auto                        it = s_libraryFiles.find( aFilePath );
+
+        if( it != s_libraryFiles.end() && it->second->m_modTime == modTime
+                && it->second->m_size == size )
+        {
+            return it->second;
+        }
+    }
+
+    auto file = std::make_shared<SPICE_LIBRARY_FILE>();
+    file->m_modTime = modTime;
+    file->m_size = size;
+
     try
     {
         tao::pegtl::string_input<> in( SafeReadFile( aFilePath, wxS( "r" ) ).ToStdString(),
@@ -146,37 +199,12 @@ void SPICE_LIBRARY_PARSER::parseFile( const wxString &aFilePath, REPORTER& aRepo
         {
             if( node->is_type<SIM_LIBRARY_SPICE_PARSER::modelUnit>() )
             {
-                std::string model = node->string();
-                std::string modelName = node->children.at( 0 )->string();
-
-                try
-                {
-                    m_library.m_models.push_back( SIM_MODEL_SPICE::Create( m_library, model ) );
-                    m_library.m_modelNames.emplace_back( modelName );
-                }
-                catch( const IO_ERROR& e )
-                {
-                   aReporter.Report( e.What(), RPT_SEVERITY_ERROR );
-                }
-                catch( ... )
-                {
-                   aReporter.Report( wxString::Format( _( "Cannot create sim model from %s" ),
-                                                       model ),
-                                     RPT_SEVERITY_ERROR );
-                }
+                file->m_units.push_back( { false, node->children.at( 0 )->string(),
+                                           node->string() } );
             }
             else if( node->is_type<SIM_LIBRARY_SPICE_PARSER::dotInclude>() )
             {
-                wxString lib = m_library.m_pathResolver( node->children.at( 0 )->string(), aFilePath );
-
-                try
-                {
-                    parseFile( lib, aReporter );
-                }
-                catch( const IO_ERROR& e )
-                {
-                    aReporter.Report( e.What(), RPT_SEVERITY_ERROR );
-                }
+                file->m_units.push_back( { true, node->children.at( 0 )->string(), "" } );
             }
             else if( node->is_type<SIM_LIBRARY_SPICE_PARSER::unknownLine>() )
             {
@@ -191,10 +219,65 @@ void SPICE_LIBRARY_PARSER::parseFile( const wxString &aFilePath, REPORTER& aRepo
     catch( const IO_ERROR& e )
     {
         aReporter.Report( e.What(), RPT_SEVERITY_ERROR );
+        return nullptr;
     }
     catch( const tao::pegtl::parse_error& e )
     {
         aReporter.Report( e.what(), RPT_SEVERITY_ERROR );
+        return nullptr;
+    }
+
+    // Files which can't be dated must be read again each time
+    if( modTime.IsValid() && size != wxInvalidSize )
+    {
+        std::lock_guard<std::mutex> lock( s_libraryFilesMutex );
+        s_libraryFiles[aFilePath] = file;
+    }
+
+    return file;
+}
+
+
+void SPICE_LIBRARY_PARSER::parseFile( const wxString &aFilePath, REPORTER& aReporter )
+{
+    std::shared_ptr<const SPICE_LIBRARY_FILE> file = readLibraryFile( aFilePath, aReporter );
+
+    if( !file )
+        return;
+
+    for( const SPICE_LIBRARY_FILE::UNIT& unit : file->m_units )
+    {
+        if( !unit.m_isInclude )
+        {
+            try
+            {
+                m_library.m_models.push_back( SIM_MODEL_SPICE::Create( m_library, unit.m_text ) );
+                m_library.m_modelNames.emplace_back( unit.m_name );
+            }
+            catch( const IO_ERROR& e )
+            {
+               aReporter.Report( e.What(), RPT_SEVERITY_ERROR );
+            }
+            catch( ... )
+            {
+               aReporter.Report( wxString::Format( _( "Cannot create sim model from %s" ),
+                                                   unit.m_text ),
+                                 RPT_SEVERITY_ERROR );
+            }
+        }
+        else
+        {
+            wxString lib = m_library.m_pathResolver( unit.m_name, aFilePath );
+
+            try
+            {
+                parseFile( lib, aReporter );
+            }
+            catch( const IO_ERROR& e )
+            {
+                aReporter.Report( e.What(), RPT_SEVERITY_ERROR );
+            }
+        }
     }
 }
 
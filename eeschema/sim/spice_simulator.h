@@ -149,6 +149,25 @@ public:
      */
     virtual std::vector<double> GetPhaseVector( const std::string& aName, int aMaxLen = -1 ) = 0;
 
+    /**
+     * Return the magnitude values of a vector from its value \a aStart on, so plots can be
+     * extended while the simulation runs without copying the values they already show.
+     *
+     * @param aName is the vector named in Spice convention (e.g. V(3), I(R1)).
+     * @param aStart is the index of the first returned value.
+     * @param aMaxLen is max count of returned values.
+     * if -1 (default) all available values are returned.
+     * @return Requested values. It might be empty if there is no vector with requested name.
+     */
+    virtual std::vector<double> GetGainVectorTail( const std::string& aName, size_t aStart,
+                                                   int aMaxLen = -1 ) = 0;
+
+    /**
+     * @return the number of points computed since the current simulation started.  It changes
+     *         while the simulation runs, as each point is sent by the simulator.
+     */
+    virtual size_t StreamedPointCount() const = 0;
+
     /**
      * Return current SPICE netlist used by the simulator.
      *
@@ -18,6 +18,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <thread>
 
 #include <core/wx_stl_compat.h>
@@ -65,38 +67,80 @@ bool SYMBOL_ASYNC_LOADER::Join()
         if( !m_returns[ii].valid() )
             continue;
 
-        m_returns[ii].wait();
+        m_returns[ii].get();
+    }
 
-        const std::vector<LOADED_PAIR>& ret = m_returns[ii].get();
+    std::lock_guard<std::mutex> lock( m_loadedMutex );
 
-        if( m_output && !ret.empty() )
+    if( m_output )
+    {
+        for( const LOADED_PAIR& pair : m_loaded )
         {
-            for( const LOADED_PAIR& pair : ret )
-            {
-                // Don't show libraries that had no power symbols
-                if( m_onlyPowerSymbols && pair.second.empty() )
-                    continue;
-
-                // *Do* show empty libraries in the normal case
+            if( isWanted( pair ) )
                 m_output->insert( pair );
-            }
         }
     }
 
+    m_loaded.clear();
+
     return true;
 }
 
 
+std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::TakeLoaded()
+{
+    std::vector<LOADED_PAIR> loaded;
+
+    {
+        std::lock_guard<std::mutex> lock( m_loadedMutex );
+        loaded.swap( m_loaded );
+    }
+
+    loaded.erase( std::remove_if( loaded.begin(), loaded.end(),
+                                  [&]( const LOADED_PAIR& aPair )
+                                  {
+                                      return !isWanted( aPair );
+                                  } ),
+                  loaded.end() );
+
+    return loaded;
+}
+
+
+bool SYMBOL_ASYNC_LOADER::isWanted( const LOADED_PAIR& aPair ) const
+{
+    // Don't show libraries that had no power symbols, but *do* show empty libraries in the
+    // normal case
+    return !m_onlyPowerSymbols || !aPair.second.empty();
+}
+
+
 bool SYMBOL_ASYNC_LOADER::Done()
 {
     return m_nextLibrary.load() >= m_nicknames.size();
 }
 
 
-std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::worker()
+bool SYMBOL_ASYNC_LOADER::Finished()
 {
-    std::vector<LOADED_PAIR> ret;
+    for( std::future<void>& ret : m_returns )
+    {
+        if( ret.valid() && ret.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+            return false;
+    }
+
+    return true;
+}
+
 
+void SYMBOL_ASYNC_LOADER::Abort()
+{
+    m_nextLibrary.store( m_nicknames.size() );
+}
+
+
+void SYMBOL_ASYNC_LOADER::worker()
+{
     bool onlyPower = m_onlyPowerSymbols;
 
     for( size_t libraryIndex = m_nextLibrary++; libraryIndex < m_nicknames.size();
@@ -115,7 +159,9 @@ std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::worker()
         try
         {
             m_table->LoadSymbolLib( pair.second, nickname, onlyPower );
-            ret.emplace_back( std::move( pair ) );
+
+            std::lock_guard<std::mutex> lock( m_loadedMutex );
+            m_loaded.emplace_back( std::move( pair ) );
         }
         catch( const IO_ERROR& ioe )
         {
@@ -134,6 +180,4 @@ std::vector<SYMBOL_ASYNC_LOADER::LOADED_PAIR> SYMBOL_ASYNC_LOADER::worker()
             m_errors += msg;
         }
     }
-
-    return ret;
 }
@@ -65,6 +65,18 @@ public:
     ///< Return true if loading is done
     bool Done();
 
+    ///< Return true if all the threads have finished, so Join() won't wait
+    bool Finished();
+
+    ///< Don't start loading any more libraries; the ones already loading are finished
+    void Abort();
+
+    /**
+     * Return the libraries which finished loading since the last call, so they can be used
+     * while the others are still loading.  They are not added to the output map by Join().
+     */
+    std::vector<std::pair<wxString, std::vector<LIB_SYMBOL*>>> TakeLoaded();
+
     ///< Returns a string containing any errors generated during the load
     const wxString& GetErrors() const { return m_errors; }
 
@@ -72,8 +84,11 @@ public:
     typedef std::pair<wxString, std::vector<LIB_SYMBOL*>> LOADED_PAIR;
 
 private:
-    ///< Worker job that loads libraries and returns a list of pairs of <nickname, loaded parts>
-    std::vector<LOADED_PAIR> worker();
+    ///< Worker job that loads libraries into m_loaded
+    void worker();
+
+    ///< Check if a loaded library should be shown
+    bool isWanted( const LOADED_PAIR& aPair ) const;
 
     ///<  list of libraries to load
     std::vector<wxString> m_nicknames;
@@ -95,7 +110,11 @@ private:
     wxString            m_errors;
     std::mutex          m_errorMutex;
 
-    std::vector<std::future<std::vector<LOADED_PAIR>>> m_returns;
+    ///< Libraries loaded and not yet taken, as pairs of <nickname, loaded parts>
+    std::vector<LOADED_PAIR> m_loaded;
+    std::mutex               m_loadedMutex;
+
+    std::vector<std::future<void>> m_returns;
 };
 
 #endif
@@ -52,7 +52,8 @@ SYMBOL_TREE_MODEL_ADAPTER::Create( EDA_BASE_FRAME* aParent, LIB_TABLE* aLibs )
 
 SYMBOL_TREE_MODEL_ADAPTER::SYMBOL_TREE_MODEL_ADAPTER( EDA_BASE_FRAME* aParent, LIB_TABLE* aLibs ) :
         LIB_TREE_MODEL_ADAPTER( aParent, "pinned_symbol_libs" ),
-        m_libs( (SYMBOL_LIB_TABLE*) aLibs )
+        m_libs( (SYMBOL_LIB_TABLE*) aLibs ),
+        m_loaderFrame( nullptr )
 {
     // Symbols may have different value from name
     m_availableColumns.emplace_back( wxT( "Value" ) );
@@ -60,7 +61,79 @@ SYMBOL_TREE_MODEL_ADAPTER::SYMBOL_TREE_MODEL_ADAPTER( EDA_BASE_FRAME* aParent, L
 
 
 SYMBOL_TREE_MODEL_ADAPTER::~SYMBOL_TREE_MODEL_ADAPTER()
-{}
+{
+    // Don't wait for the libraries which haven't started loading yet
+    if( m_loader )
+        m_loader->Abort();
+}
+
+
+void SYMBOL_TREE_MODEL_ADAPTER::addLoadedLibrary( const wxString& aNickname,
+                                                  const std::vector<LIB_SYMBOL*>& aSymbols,
+                                                  SCH_BASE_FRAME* aFrame )
+{
+    COMMON_SETTINGS* cfg = Pgm().GetCommonSettings();
+    PROJECT_FILE&    project = aFrame->Prj().GetProjectFile();
+
+    auto addFunc =
+            [&]( const wxString& aLibName, const std::vector<LIB_SYMBOL*>& aSymbolList,
+                 const wxString& aDescription )
+            {
+                std::vector<LIB_TREE_ITEM*> treeItems( aSymbolList.begin(), aSymbolList.end() );
+                bool pinned = alg::contains( cfg->m_Session.pinned_symbol_libs, aLibName )
+                              || alg::contains( project.m_PinnedSymbolLibs, aLibName );
+
+                DoAddLibrary( aLibName, aDescription, treeItems, pinned, false );
+            };
+
+    SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( aNickname );
+
+    wxCHECK( row, /* void */ );
+
+    if( !row->GetIsVisible() )
+        return;
+
+    std::vector<wxString> additionalColumns;
+    row->GetAvailableSymbolFields( additionalColumns );
+
+    for( const wxString& column : additionalColumns )
+        addColumnIfNecessary( column );
+
+    if( row->SupportsSubLibraries() )
+    {
+        std::vector<wxString> subLibraries;
+        row->GetSubLibraryNames( subLibraries );
+
+        wxString parentDesc = m_libs->GetDescription( aNickname );
+
+        for( const wxString& lib : subLibraries )
+        {
+            wxString suffix = lib.IsEmpty() ? wxString( wxT( "" ) )
+                                            : wxString::Format( wxT( " - %s" ), lib );
+            wxString name = wxString::Format( wxT( "%s%s" ), aNickname, suffix );
+            wxString desc;
+
+            if( !parentDesc.IsEmpty() )
+                desc = wxString::Format( wxT( "%s (%s)" ), parentDesc, lib );
+
+            UTF8 utf8Lib( lib );
+
+            std::vector<LIB_SYMBOL*> symbols;
+
+            std::copy_if( aSymbols.begin(), aSymbols.end(), std::back_inserter( symbols ),
+                          [&utf8Lib]( LIB_SYMBOL* aSym )
+                          {
+                              return utf8Lib == aSym->GetLibId().GetSubLibraryName();
+                          } );
+
+            addFunc( name, symbols, desc );
+        }
+    }
+    else
+    {
+        addFunc( aNickname, aSymbols, m_libs->GetDescription( aNickname ) );
+    }
+}
 
 
 bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNicknames,
@@ -92,6 +165,10 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
         if( progressReporter && !progressReporter->KeepRefreshing() )
             break;
 
+        // Build the tree of the libraries already loaded while the others are still loading
+        for( const auto& [libNickname, libSymbols] : loader.TakeLoaded() )
+            addLoadedLibrary( libNickname, libSymbols, aFrame );
+
         wxMilliSleep( PROGRESS_INTERVAL_MILLIS );
     }
 
@@ -115,91 +192,91 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
         dlg.ShowModal();
     }
 
-    if( loadedSymbolMap.size() > 0 )
-    {
-        COMMON_SETTINGS* cfg = Pgm().GetCommonSettings();
-        PROJECT_FILE&    project = aFrame->Prj().GetProjectFile();
-
-        auto addFunc =
-                [&]( const wxString& aLibName, const std::vector<LIB_SYMBOL*>& aSymbolList,
-                     const wxString& aDescription )
-                {
-                    std::vector<LIB_TREE_ITEM*> treeItems( aSymbolList.begin(), aSymbolList.end() );
-                    bool pinned = alg::contains( cfg->m_Session.pinned_symbol_libs, aLibName )
-                                  || alg::contains( project.m_PinnedSymbolLibs, aLibName );
+    // The libraries which finished after the last pass of the loop above
+    for( const auto& [libNickname, libSymbols] : loadedSymbolMap )
+        addLoadedLibrary( libNickname, libSymbols, aFrame );
 
-                    DoAddLibrary( aLibName, aDescription, treeItems, pinned, false );
-                };
+    KIID::CreateNilUuids( false );
 
-        for( const auto& [libNickname, libSymbols] : loadedSymbolMap )
-        {
-            SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( libNickname );
+    m_tree.AssignIntrinsicRanks();
 
-            wxCHECK2( row, continue );
+    if( progressReporter )
+    {
+        // Force immediate deletion of the APP_PROGRESS_DIALOG.  Do not use Destroy(), or Destroy()
+        // followed by wxSafeYield() because on Windows, APP_PROGRESS_DIALOG has some side effects
+        // on the event loop manager.
+        // One in particular is the call of ShowModal() following SYMBOL_TREE_MODEL_ADAPTER
+        // creating a APP_PROGRESS_DIALOG (which has incorrect modal behaviour).
+        progressReporter.reset();
+        m_show_progress = false;
+    }
 
-            if( !row->GetIsVisible() )
-                continue;
+    return !cancelled;
+}
 
-            std::vector<wxString> additionalColumns;
-            row->GetAvailableSymbolFields( additionalColumns );
 
-            for( const wxString& column : additionalColumns )
-                addColumnIfNecessary( column );
+void SYMBOL_TREE_MODEL_ADAPTER::StartAddingLibraries( const std::vector<wxString>& aNicknames,
+                                                      SCH_BASE_FRAME* aFrame )
+{
+    wxCHECK( !m_loader, /* void */ );
 
-            if( row->SupportsSubLibraries() )
-            {
-                std::vector<wxString> subLibraries;
-                row->GetSubLibraryNames( subLibraries );
+    if( aNicknames.empty() )
+        return;
 
-                wxString parentDesc = m_libs->GetDescription( libNickname );
+    // KIID generation is left enabled here: it is a global switch, and the rest of the
+    // application keeps running while these libraries load.
+    m_loaderFrame = aFrame;
+    m_loader = std::make_unique<SYMBOL_ASYNC_LOADER>( aNicknames, m_libs, GetFilter() != nullptr,
+                                                      &m_loaderOutput );
+    m_loader->Start();
+}
 
-                for( const wxString& lib : subLibraries )
-                {
-                    wxString suffix = lib.IsEmpty() ? wxString( wxT( "" ) )
-                                                    : wxString::Format( wxT( " - %s" ), lib );
-                    wxString name = wxString::Format( wxT( "%s%s" ), libNickname, suffix );
-                    wxString desc;
 
-                    if( !parentDesc.IsEmpty() )
-                        desc = wxString::Format( wxT( "%s (%s)" ), parentDesc, lib );
+bool SYMBOL_TREE_MODEL_ADAPTER::AddFinishedLibraries()
+{
+    if( !m_loader )
+        return false;
 
-                    UTF8 utf8Lib( lib );
+    bool added = false;
 
-                    std::vector<LIB_SYMBOL*> symbols;
+    for( const auto& [libNickname, libSymbols] : m_loader->TakeLoaded() )
+    {
+        addLoadedLibrary( libNickname, libSymbols, m_loaderFrame );
+        added = true;
+    }
 
-                    std::copy_if( libSymbols.begin(), libSymbols.end(),
-                                  std::back_inserter( symbols ),
-                                  [&utf8Lib]( LIB_SYMBOL* aSym )
-                                  {
-                                      return utf8Lib == aSym->GetLibId().GetSubLibraryName();
-                                  } );
+    if( m_loader->Finished() )
+    {
+        m_loader->Join();
 
-                    addFunc( name, symbols, desc );
-                }
-            }
-            else
-            {
-                addFunc( libNickname, libSymbols, m_libs->GetDescription( libNickname ) );
-            }
+        for( const auto& [libNickname, libSymbols] : m_loaderOutput )
+        {
+            addLoadedLibrary( libNickname, libSymbols, m_loaderFrame );
+            added = true;
         }
-    }
 
-    KIID::CreateNilUuids( false );
+        wxString errors = m_loader->GetErrors();
 
-    m_tree.AssignIntrinsicRanks();
+        m_loaderOutput.clear();
+        m_loader.reset();
 
-    if( progressReporter )
-    {
-        // Force immediate deletion of the APP_PROGRESS_DIALOG.  Do not use Destroy(), or Destroy()
-        // followed by wxSafeYield() because on Windows, APP_PROGRESS_DIALOG has some side effects
-        // on the event loop manager.
-        // One in particular is the call of ShowModal() following SYMBOL_TREE_MODEL_ADAPTER
-        // creating a APP_PROGRESS_DIALOG (which has incorrect modal behaviour).
-        progressReporter.reset();
-        m_show_progress = false;
+        if( !errors.IsEmpty() )
+        {
+            HTML_MESSAGE_BOX dlg( m_loaderFrame, _( "Load Error" ) );
+
+            dlg.MessageSet( _( "Errors loading symbols:" ) );
+
+            errors.Replace( "\n", "<BR>" );
+
+            dlg.AddHTML_Text( errors );
+            dlg.ShowModal();
+        }
     }
 
-    return !cancelled;
+    if( added )
+        m_tree.AssignIntrinsicRanks();
+
+    return added;
 }
 
 
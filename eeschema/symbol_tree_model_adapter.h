@@ -22,9 +22,15 @@
 #ifndef SYMBOL_TREE_MODEL_ADAPTER_H
 #define SYMBOL_TREE_MODEL_ADAPTER_H
 
+#include <memory>
+#include <unordered_map>
+
+#include <core/wx_stl_compat.h>
 #include <lib_tree_model_adapter.h>
 
+class LIB_SYMBOL;
 class LIB_TABLE;
+class SYMBOL_ASYNC_LOADER;
 class SYMBOL_LIB_TABLE;
 class SCH_BASE_FRAME;
 
@@ -54,6 +60,27 @@ public:
      */
     bool AddLibraries( const std::vector<wxString>& aNicknames, SCH_BASE_FRAME* aFrame );
 
+    /**
+     * Start loading the libraries \a aNicknames in the background.  They are added to the tree
+     * by AddFinishedLibraries() as they finish loading, so that the tree can be used meanwhile.
+     *
+     * @param aNicknames is the list of library nicknames
+     * @param aFrame is the parent window of the load error dialog
+     */
+    void StartAddingLibraries( const std::vector<wxString>& aNicknames, SCH_BASE_FRAME* aFrame );
+
+    /**
+     * Add the libraries which finished loading in the background since the last call.
+     *
+     * @return true if any library was added to the tree.
+     */
+    bool AddFinishedLibraries();
+
+    /**
+     * @return true if libraries started by StartAddingLibraries() are still loading.
+     */
+    bool IsLoadingLibraries() const { return m_loader != nullptr; }
+
     void AddLibrary( wxString const& aLibNickname, bool pinned );
 
     wxString GenerateInfo( LIB_ID const& aLibId, int aUnit ) override;
@@ -67,6 +94,13 @@ protected:
     bool isSymbolModel() override { return true; }
 
 private:
+    /**
+     * Add the symbols \a aSymbols loaded from the library \a aNickname to the tree, as one
+     * node per sub-library if the library has sub-libraries.
+     */
+    void addLoadedLibrary( const wxString& aNickname, const std::vector<LIB_SYMBOL*>& aSymbols,
+                           SCH_BASE_FRAME* aFrame );
+
     friend class SYMBOL_ASYNC_LOADER;
     /**
      * Flag to only show the symbol library table load progress dialog the first time.
@@ -74,6 +108,11 @@ private:
     static bool        m_show_progress;
 
     SYMBOL_LIB_TABLE*  m_libs;
+
+    ///< The libraries loading in the background and the frame they are loaded for
+    std::unique_ptr<SYMBOL_ASYNC_LOADER>                   m_loader;
+    std::unordered_map<wxString, std::vector<LIB_SYMBOL*>> m_loaderOutput;
+    SCH_BASE_FRAME*                                        m_loaderFrame;
 };
 
 #endif // SYMBOL_TREE_MODEL_ADAPTER_H
@@ -1125,8 +1125,6 @@ void SCH_LINE_WIRE_BUS_TOOL::finishSegments()
     // Remove segments backtracking over others
     simplifyWireList();
 
-    // Collect the possible connection points for the new lines
-    std::vector<VECTOR2I> connections = screen->GetConnections();
     std::vector<VECTOR2I> new_ends;
 
     // Check each new segment for possible junctions and add/split if needed
@@ -1139,10 +1137,11 @@ void SCH_LINE_WIRE_BUS_TOOL::finishSegments()
 
         new_ends.insert( new_ends.end(), tmpends.begin(), tmpends.end() );
 
-        for( const VECTOR2I& pt : connections )
+        // Collect the possible connection points for the new lines
+        for( const VECTOR2I& pt : screen->GetConnectionsOnSegment( wire->GetStartPoint(),
+                                                                   wire->GetEndPoint() ) )
         {
-            if( IsPointOnSegment( wire->GetStartPoint(), wire->GetEndPoint(), pt ) )
-                new_ends.push_back( pt );
+            new_ends.push_back( pt );
         }
 
         commit.Added( wire, screen );
@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <set>
+
 #include <pgm_base.h>
 #include <symbol_library.h>         // For SYMBOL_LIBRARY_FILTER
 #include <panel_symbol_chooser.h>
@@ -178,11 +180,43 @@ PANEL_SYMBOL_CHOOSER::PANEL_SYMBOL_CHOOSER( SCH_BASE_FRAME* aFrame, wxWindow* aP
 
     if( !loaded )
     {
-        if( !adapter->AddLibraries( libNicknames, m_frame ) )
+        // Load the libraries the user is most likely to pick from first: those of the recently
+        // used and already placed symbols, the pinned ones and the ones of the project table.
+        // The others are loaded in the background and added to the tree as they finish.
+        std::set<wxString> priority;
+
+        for( const std::vector<PICKED_SYMBOL>* list : { &aHistoryList, &aAlreadyPlaced } )
+        {
+            for( const PICKED_SYMBOL& picked : *list )
+                priority.insert( picked.LibId.GetLibNickname() );
+        }
+
+        priority.insert( session.pinned_symbol_libs.begin(), session.pinned_symbol_libs.end() );
+        priority.insert( project.m_PinnedSymbolLibs.begin(), project.m_PinnedSymbolLibs.end() );
+
+        for( unsigned ii = 0; ii < libs->GetCount(); ++ii )
+            priority.insert( libs->At( ii ).GetNickName() );
+
+        std::vector<wxString> firstNicknames;
+        std::vector<wxString> otherNicknames;
+
+        for( const wxString& nickname : libNicknames )
+        {
+            if( priority.count( nickname ) )
+                firstNicknames.push_back( nickname );
+            else
+                otherNicknames.push_back( nickname );
+        }
+
+        if( !firstNicknames.empty() && !adapter->AddLibraries( firstNicknames, m_frame ) )
         {
             // loading cancelled by user
             m_acceptHandler();
         }
+        else
+        {
+            adapter->StartAddingLibraries( otherNicknames, m_frame );
+        }
     }
 
     // -------------------------------------------------------------------------------------
@@ -255,6 +289,7 @@ PANEL_SYMBOL_CHOOSER::PANEL_SYMBOL_CHOOSER( SCH_BASE_FRAME* aFrame, wxWindow* aP
 
     m_dbl_click_timer = new wxTimer( this );
     m_open_libs_timer = new wxTimer( this );
+    m_load_libs_timer = new wxTimer( this );
 
     SetSizer( sizer );
 
@@ -262,6 +297,7 @@ PANEL_SYMBOL_CHOOSER::PANEL_SYMBOL_CHOOSER( SCH_BASE_FRAME* aFrame, wxWindow* aP
 
     Bind( wxEVT_TIMER, &PANEL_SYMBOL_CHOOSER::onCloseTimer, this, m_dbl_click_timer->GetId() );
     Bind( wxEVT_TIMER, &PANEL_SYMBOL_CHOOSER::onOpenLibsTimer, this, m_open_libs_timer->GetId() );
+    Bind( wxEVT_TIMER, &PANEL_SYMBOL_CHOOSER::onLoadLibsTimer, this, m_load_libs_timer->GetId() );
     Bind( EVT_LIBITEM_SELECTED, &PANEL_SYMBOL_CHOOSER::onSymbolSelected, this );
     Bind( EVT_LIBITEM_CHOSEN, &PANEL_SYMBOL_CHOOSER::onSymbolChosen, this );
     Bind( wxEVT_CHAR_HOOK, &PANEL_SYMBOL_CHOOSER::OnChar, this );
@@ -283,6 +319,10 @@ PANEL_SYMBOL_CHOOSER::PANEL_SYMBOL_CHOOSER( SCH_BASE_FRAME* aFrame, wxWindow* aP
     // This is done on a timer because we need a gross hack to keep GTK from garbling the
     // display. Must be longer than the search debounce timer.
     m_open_libs_timer->StartOnce( 300 );
+
+    // Add the libraries loading in the background to the tree as they finish
+    if( adapter->IsLoadingLibraries() )
+        m_load_libs_timer->Start( 100 );
 }
 
 
@@ -296,8 +336,10 @@ PANEL_SYMBOL_CHOOSER::~PANEL_SYMBOL_CHOOSER()
     // Stop the timer during destruction early to avoid potential race conditions (that do happen)
     m_dbl_click_timer->Stop();
     m_open_libs_timer->Stop();
+    m_load_libs_timer->Stop();
     delete m_dbl_click_timer;
     delete m_open_libs_timer;
+    delete m_load_libs_timer;
 
     if( m_showPower )
         g_powerSearchString = m_tree->GetSearchString();
@@ -523,6 +565,21 @@ void PANEL_SYMBOL_CHOOSER::onOpenLibsTimer( wxTimerEvent& aEvent )
 }
 
 
+void PANEL_SYMBOL_CHOOSER::onLoadLibsTimer( wxTimerEvent& aEvent )
+{
+    SYMBOL_TREE_MODEL_ADAPTER* adapter = static_cast<SYMBOL_TREE_MODEL_ADAPTER*>( m_adapter.get() );
+
+    if( !adapter->IsLoadingLibraries() )
+    {
+        m_load_libs_timer->Stop();
+        return;
+    }
+
+    if( adapter->AddFinishedLibraries() )
+        m_tree->Regenerate( true );
+}
+
+
 void PANEL_SYMBOL_CHOOSER::showFootprintFor( LIB_ID const& aLibId )
 {
     if( !m_fp_preview || !m_fp_preview->IsInitialized() )
@@ -106,6 +106,7 @@ protected:
     void OnDetailsCharHook( wxKeyEvent& aEvt );
     void onCloseTimer( wxTimerEvent& aEvent );
     void onOpenLibsTimer( wxTimerEvent& aEvent );
+    void onLoadLibsTimer( wxTimerEvent& aEvent );
 
     void onFootprintSelected( wxCommandEvent& aEvent );
     void onSymbolSelected( wxCommandEvent& aEvent );
@@ -144,6 +145,7 @@ protected:
 
     wxTimer*                  m_dbl_click_timer;
     wxTimer*                  m_open_libs_timer;
+    wxTimer*                  m_load_libs_timer;
     SYMBOL_PREVIEW_WIDGET*    m_symbol_preview;
     wxSplitterWindow*         m_hsplitter;
     wxSplitterWindow*         m_vsplitter;
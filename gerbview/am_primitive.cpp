@@ -93,8 +93,9 @@ void AM_PRIMITIVE::ConvertBasicShapeToPolygon( APERTURE_MACRO* aApertMacro,
 {
     // Draw the primitive shape for flashed items.
     // Note: rotation of primitives inside a macro must be always done around the macro origin.
-    // Create a static buffer to avoid a lot of memory reallocation.
-    static std::vector<VECTOR2I> polybuffer;
+    // Create a static buffer to avoid a lot of memory reallocation.  Files are loaded in
+    // parallel, so each thread has its own.
+    thread_local std::vector<VECTOR2I> polybuffer;
     polybuffer.clear();
 
     aApertMacro->EvalLocalParams( *this );
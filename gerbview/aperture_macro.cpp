@@ -100,43 +100,68 @@ AM_PARAM& APERTURE_MACRO::GetLastLocalParamDefFromStack()
 }
 
 
-SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
-                                                       const VECTOR2I& aShapePos )
+const SHAPE_POLY_SET& APERTURE_MACRO::GetShape( D_CODE* aDcode )
 {
-    SHAPE_POLY_SET holeBuffer;
+    if( aDcode->m_MacroShape.OutlineCount() > 0 )
+        return aDcode->m_MacroShape;
+
+    // Tools often define a D_CODE per pad, with the same parameters: evaluate the shape once
+    // for each set of parameter values (which include the rotation of the macro)
+    std::vector<double> params;
 
-    m_shape.RemoveAllContours();
-    D_CODE* dcode = aParent->GetDcodeDescr();
-    InitLocalParams( dcode );
+    for( unsigned ii = 1; ii <= aDcode->GetParamCount(); ++ii )
+        params.push_back( aDcode->GetParam( ii ) );
 
-    for( AM_PRIMITIVE& prim_macro : m_primitivesList )
+    auto it = m_shapeCache.find( params );
+
+    if( it == m_shapeCache.end() )
     {
-        if( prim_macro.m_Primitive_id == AMP_COMMENT )
-            continue;
+        SHAPE_POLY_SET holeBuffer;
+        SHAPE_POLY_SET shape;
 
-        if( prim_macro.IsAMPrimitiveExposureOn( this ) )
-        {
-            prim_macro.ConvertBasicShapeToPolygon( this, m_shape );
-        }
-        else
+        InitLocalParams( aDcode );
+
+        for( AM_PRIMITIVE& prim_macro : m_primitivesList )
         {
-            prim_macro.ConvertBasicShapeToPolygon( this, holeBuffer );
+            if( prim_macro.m_Primitive_id == AMP_COMMENT )
+                continue;
 
-            if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
+            if( prim_macro.IsAMPrimitiveExposureOn( this ) )
+            {
+                prim_macro.ConvertBasicShapeToPolygon( this, shape );
+            }
+            else
             {
-                m_shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
-                holeBuffer.RemoveAllContours();
+                prim_macro.ConvertBasicShapeToPolygon( this, holeBuffer );
+
+                if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
+                {
+                    shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                    holeBuffer.RemoveAllContours();
+                }
             }
         }
+
+        // Merge and cleanup basic shape polygons
+        shape.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+        // A hole can be is defined inside a polygon, or the polygons themselve can create
+        // a hole when merged, so we must fracture the polygon to be able to drawn it
+        // (i.e link holes by overlapping edges)
+        shape.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        it = m_shapeCache.emplace( std::move( params ), std::move( shape ) ).first;
     }
 
-    // Merge and cleanup basic shape polygons
-    m_shape.Simplify( SHAPE_POLY_SET::PM_FAST );
+    aDcode->m_MacroShape = it->second;
+    return aDcode->m_MacroShape;
+}
 
-    // A hole can be is defined inside a polygon, or the polygons themselve can create
-    // a hole when merged, so we must fracture the polygon to be able to drawn it
-    // (i.e link holes by overlapping edges)
-    m_shape.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
+                                                       const VECTOR2I& aShapePos )
+{
+    m_shape = GetShape( aParent->GetDcodeDescr() );
 
     // Move m_shape to the actual draw position:
     for( int icnt = 0; icnt < m_shape.OutlineCount(); icnt++ )
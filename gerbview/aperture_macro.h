@@ -31,6 +31,7 @@
 #define APERTURE_MACRO_H
 
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -120,6 +121,15 @@ public:
     SHAPE_POLY_SET* GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
                                            const VECTOR2I& aShapePos );
 
+    /**
+     * Return the shape of the macro for the parameters of a D_CODE, in X,Y axis and at (0,0).
+     *
+     * The shape is evaluated once for each set of parameter values, and kept by \a aDcode.
+     *
+     * @param aDcode is the D_CODE that uses this aperture macro and define deferred parameters.
+     */
+    const SHAPE_POLY_SET& GetShape( D_CODE* aDcode );
+
     /**
      * The name of the aperture macro as defined like %AMVB_RECTANGLE* (name is VB_RECTANGLE)
      */
@@ -166,6 +176,9 @@ private:
     int m_paramLevelEval;
 
     SHAPE_POLY_SET m_shape;         ///< The shape of the item, calculated by GetApertureMacroShape
+
+    ///< The shapes already evaluated, by parameter values of the D_CODEs
+    std::map<std::vector<double>, SHAPE_POLY_SET> m_shapeCache;
 };
 
 
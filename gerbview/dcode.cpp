@@ -80,6 +80,9 @@ void D_CODE::Clear_D_CODE_Data()
     m_Rotation   = ANGLE_0;
     m_EdgesCount = 0;
     m_Polygon.RemoveAllContours();
+    m_MacroShape.RemoveAllContours();
+    m_FlashedMacroShape.RemoveAllContours();
+    m_FlashedMacroAxes = 0;
 }
 
 
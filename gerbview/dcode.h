@@ -91,6 +91,8 @@ public:
     void AppendParam( double aValue )
     {
         m_am_params.push_back( aValue );
+        m_MacroShape.RemoveAllContours();
+        m_FlashedMacroShape.RemoveAllContours();
     }
 
     /**
@@ -120,6 +122,8 @@ public:
     void SetMacro( APERTURE_MACRO* aMacro )
     {
         m_Macro = aMacro;
+        m_MacroShape.RemoveAllContours();
+        m_FlashedMacroShape.RemoveAllContours();
     }
 
     APERTURE_MACRO* GetMacro() const { return m_Macro; }
@@ -207,6 +211,14 @@ public:
                                              * complex shapes which are converted to polygon
                                              * (shapes with hole )
                                              */
+    SHAPE_POLY_SET        m_MacroShape;     /* The shape of the aperture macro for the parameters
+                                             * of this D_CODE, at (0,0).  Built on the first
+                                             * flash and shared by all the flashes of the D_CODE
+                                             */
+    SHAPE_POLY_SET        m_FlashedMacroShape; /* m_MacroShape in A,B axis and triangulated, for
+                                                * the flashes which are not rotated nor scaled
+                                                */
+    int                   m_FlashedMacroAxes;  ///< The axis swap and mirrors of m_FlashedMacroShape
 
 private:
     APERTURE_MACRO* m_Macro;    ///< no ownership, points to GERBER.m_aperture_macros element.
@@ -274,32 +274,36 @@ bool GERBVIEW_FRAME::Read_EXCELLON_File( const wxString& aFullFileName )
         return false;
     }
 
-    EXCELLON_IMAGE* drill_layer = drill_layer_uptr.release();
+    return AddExcellonImage( drill_layer_uptr.release(), layerId );
+}
+
 
-    layerId = images->AddGbrImage( drill_layer, layerId );
+bool GERBVIEW_FRAME::AddExcellonImage( EXCELLON_IMAGE* aDrill, int aLayer )
+{
+    GERBER_FILE_IMAGE_LIST* images = GetGerberLayout()->GetImagesList();
 
-    if( layerId < 0 )
+    if( images->AddGbrImage( aDrill, aLayer ) < 0 )
     {
-        delete drill_layer;
+        delete aDrill;
         ShowInfoBarError( _( "No empty layers to load file into." ) );
         return false;
     }
 
     // Display errors list
-    if( drill_layer->GetMessages().size() > 0 )
+    if( aDrill->GetMessages().size() > 0 )
     {
         HTML_MESSAGE_BOX dlg( this, _( "Error reading EXCELLON drill file" ) );
-        dlg.ListSet( drill_layer->GetMessages() );
+        dlg.ListSet( aDrill->GetMessages() );
         dlg.ShowModal();
     }
 
     if( GetCanvas() )
     {
-        for( GERBER_DRAW_ITEM* item : drill_layer->GetItems() )
+        for( GERBER_DRAW_ITEM* item : aDrill->GetItems() )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
 
-    return success;
+    return true;
 }
 
 
@@ -22,10 +22,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <future>
+#include <set>
+
 #include <wx/debug.h>
 #include <wx/filedlg.h>
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
+#include <core/thread_pool.h>
+#include <locale_io.h>
 #include <reporter.h>
 #include <dialogs/html_message_box.h>
 #include <gerbview_frame.h>
@@ -33,6 +38,7 @@
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
 #include <excellon_image.h>
+#include <gerbview_settings.h>
 #include <wildcards_and_files_ext.h>
 #include <view/view.h>
 #include <widgets/wx_progress_reporters.h>
@@ -253,7 +259,6 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
 
     // Read gerber files: each file is loaded on a new GerbView layer
     bool success = true;
-    int layer = GetActiveLayer();
     int  firstLoadedLayer = NO_AVAILABLE_LAYERS;
     LSET visibility = GetVisibleLayers();
 
@@ -261,8 +266,21 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
     wxString msg;
     WX_STRING_REPORTER reporter( &msg );
 
-    // Create progress dialog (only used if more than 1 file to load
-    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    // The files are parsed in parallel, each one into its own image, and the images are then
+    // installed in the frame in the order of the list
+    struct LOAD_JOB
+    {
+        wxString                           m_fullPath;
+        wxString                           m_fullName;
+        int                                m_index;
+        int                                m_layer;
+        bool                               m_loaded = false;
+        bool                               m_outOfMemory = false;
+        std::unique_ptr<GERBER_FILE_IMAGE> m_image;
+    };
+
+    std::vector<LOAD_JOB> jobs;
+    std::set<int>         reservedLayers;
 
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
@@ -295,32 +313,21 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             continue;
         }
 
-
         m_lastFileName = filename.GetFullPath();
 
-        if( !progress && ( aFilenameList.GetCount() > 1 ) )
-        {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Loading files..." ), 1,
-                                                               false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
-        }
-        else if( progress )
+        // Make sure we have a layer available to load into, which is not already reserved
+        // for a previous file of the list
+        int layer = NO_AVAILABLE_LAYERS;
+
+        for( int jj = 0; jj < (int) ImagesMaxCount(); ++jj )
         {
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
-            progress->KeepRefreshing();
+            if( GetGbrImage( jj ) == nullptr && !reservedLayers.count( jj ) )
+            {
+                layer = jj;
+                break;
+            }
         }
 
-
-        // Make sure we have a layer available to load into
-        layer = getNextAvailableLayer();
-
         if( layer == NO_AVAILABLE_LAYERS )
         {
             success = false;
@@ -336,65 +343,153 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             break;
         }
 
-        SetActiveLayer( layer, false );
+        reservedLayers.insert( layer );
         visibility[ layer ] = true;
 
-        try
-        {
-            // 2 = Autodetect
-            if( ( *aFileType )[ii] == 2 )
-            {
-                if( EXCELLON_IMAGE::TestFileIsExcellon( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 1;
-                else if( GERBER_FILE_IMAGE::TestFileIsRS274( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 0;
-            }
+        LOAD_JOB& job = jobs.emplace_back();
+        job.m_fullPath = filename.GetFullPath();
+        job.m_fullName = filename.GetFullName();
+        job.m_index = ii;
+        job.m_layer = layer;
+    }
+
+    // Create progress dialog (only used if more than 1 file to load
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+
+    if( jobs.size() > 1 )
+    {
+        progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Loading files..." ), 1,
+                                                           false );
+        progress->SetMaxProgress( (int) jobs.size() );
+        progress->Report( wxString::Format( _( "Loading %zu files..." ), jobs.size() ) );
+    }
 
-            switch( ( *aFileType )[ii] )
+    EXCELLON_DEFAULTS  nc_defaults;
+    GERBVIEW_SETTINGS* cfg = static_cast<GERBVIEW_SETTINGS*>( config() );
+    cfg->GetExcellonDefaults( nc_defaults );
+
+    // The worker threads rely on the C locale being set for the whole load
+    LOCALE_IO toggle;
+
+    auto loadFile =
+            [&]( LOAD_JOB& aJob )
             {
-            case 0:
+                int& fileType = ( *aFileType )[aJob.m_index];
 
-                if( Read_GERBER_File( filename.GetFullPath() ) )
+                try
                 {
-                    UpdateFileHistory( filename.GetFullPath() );
+                    // 2 = Autodetect
+                    if( fileType == 2 )
+                    {
+                        if( EXCELLON_IMAGE::TestFileIsExcellon( aJob.m_fullPath ) )
+                            fileType = 1;
+                        else if( GERBER_FILE_IMAGE::TestFileIsRS274( aJob.m_fullPath ) )
+                            fileType = 0;
+                    }
 
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
+                    if( fileType == 0 )
                     {
-                        firstLoadedLayer = layer;
+                        aJob.m_image = std::make_unique<GERBER_FILE_IMAGE>( aJob.m_layer );
+                        aJob.m_loaded = aJob.m_image->LoadGerberFile( aJob.m_fullPath );
+                    }
+                    else if( fileType == 1 )
+                    {
+                        auto drill = std::make_unique<EXCELLON_IMAGE>( aJob.m_layer );
+                        aJob.m_loaded = drill->LoadFile( aJob.m_fullPath, &nc_defaults );
+                        aJob.m_image = std::move( drill );
                     }
                 }
+                catch( const std::bad_alloc& )
+                {
+                    aJob.m_image.reset();
+                    aJob.m_loaded = false;
+                    aJob.m_outOfMemory = true;
+                }
 
-                break;
+                if( progress )
+                    progress->AdvanceProgress();
+            };
 
-            case 1:
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<void>> returns;
 
-                if( Read_EXCELLON_File( filename.GetFullPath() ) )
-                {
-                    UpdateFileHistory( filename.GetFullPath(), &m_drillFileHistory );
+    returns.reserve( jobs.size() );
 
-                    // Select the first added layer by default when done loading
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
-                    {
-                        firstLoadedLayer = layer;
-                    }
-                }
+    for( LOAD_JOB& job : jobs )
+        returns.emplace_back( tp.submit( loadFile, std::ref( job ) ) );
 
-                break;
-            default:
-                wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
-                reporter.Report( txt, RPT_SEVERITY_ERROR );
-            }
+    for( const std::future<void>& ret : returns )
+    {
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+        while( status != std::future_status::ready )
+        {
+            if( progress )
+                progress->KeepRefreshing();
+
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
         }
-        catch( const std::bad_alloc& )
+    }
+
+    for( LOAD_JOB& job : jobs )
+    {
+        if( job.m_outOfMemory )
         {
-            wxString txt = wxString::Format( MSG_OOM, filename.GetFullName() );
+            wxString txt = wxString::Format( MSG_OOM, job.m_fullName );
             reporter.Report( txt, RPT_SEVERITY_ERROR );
             success = false;
             continue;
         }
 
-        if( progress )
-            progress->AdvanceProgress();
+        int  fileType = ( *aFileType )[job.m_index];
+        bool added = false;
+
+        switch( fileType )
+        {
+        case 0:
+            if( job.m_loaded )
+            {
+                SetActiveLayer( job.m_layer, false );
+                AddGerberImage( job.m_image.release(), job.m_layer );
+                UpdateFileHistory( job.m_fullPath );
+                added = true;
+            }
+            else
+            {
+                ShowInfoBarError( wxString::Format( _( "File '%s' not found" ),
+                                                    job.m_fullPath ) );
+            }
+
+            break;
+
+        case 1:
+            if( job.m_loaded )
+            {
+                SetActiveLayer( job.m_layer, false );
+
+                if( AddExcellonImage( static_cast<EXCELLON_IMAGE*>( job.m_image.release() ),
+                                      job.m_layer ) )
+                {
+                    UpdateFileHistory( job.m_fullPath, &m_drillFileHistory );
+                    added = true;
+                }
+            }
+            else
+            {
+                ShowInfoBarError( wxString::Format( _( "File %s not found." ),
+                                                    job.m_fullPath ) );
+            }
+
+            break;
+
+        default:
+            wxString txt = wxString::Format( MSG_NOT_LOADED, job.m_fullName );
+            reporter.Report( txt, RPT_SEVERITY_ERROR );
+        }
+
+        // Select the first added layer by default when done loading
+        if( added && firstLoadedLayer == NO_AVAILABLE_LAYERS )
+            firstLoadedLayer = job.m_layer;
     }
 
     if( !success )
@@ -17,7 +17,13 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "gerber_collectors.h"
+#include <base_units.h>
+#include <gbr_layout.h>
+#include <gerber_file_image.h>
+#include <gerber_file_image_list.h>
 
 
 /**
@@ -47,5 +53,33 @@ void GERBER_COLLECTOR::Collect( EDA_ITEM* aItem, const std::vector<KICAD_T>& aSc
     // the Inspect() function.
     SetRefPos( aRefPos );
 
-    aItem->Visit( m_inspector, nullptr, m_scanTypes );
+    if( aItem->Type() != GERBER_LAYOUT_T
+        || std::find( m_scanTypes.begin(), m_scanTypes.end(), GERBER_DRAW_ITEM_T )
+                   == m_scanTypes.end() )
+    {
+        aItem->Visit( m_inspector, nullptr, m_scanTypes );
+        return;
+    }
+
+    // Only hit-test the items found around aRefPos in the spatial index of each image.  The
+    // margin is the smallest hit test radius of GERBER_DRAW_ITEM::HitTest()
+    GERBER_FILE_IMAGE_LIST*        images = static_cast<GBR_LAYOUT*>( aItem )->GetImagesList();
+    std::vector<GERBER_DRAW_ITEM*> candidates;
+    BOX2I                          area( aRefPos, VECTOR2I( 1, 1 ) );
+
+    area.Inflate( gerbIUScale.mmToIU( 0.01 ) );
+
+    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+
+        if( gerber == nullptr )    // Graphic layer not yet used
+            continue;
+
+        candidates.clear();
+        gerber->QueryItems( area, candidates );
+
+        for( GERBER_DRAW_ITEM* item : candidates )
+            Inspect( item, nullptr );
+    }
 }
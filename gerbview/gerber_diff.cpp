@@ -0,0 +1,417 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <future>
+
+#include <base_units.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <core/thread_pool.h>
+#include <geometry/shape_arc.h>
+#include <progress_reporter.h>
+#include <trigo.h>
+#include <gerber_diff.h>
+#include <gerber_draw_item.h>
+#include <gerber_file_image.h>
+
+
+// The size of the tiles compared at once
+static const int TILE_SIZE = gerbIUScale.mmToIU( 10.0 );
+
+// The max error of the arcs approximations, the same as the one used for drawing
+static const int ARC_ERROR = gerbIUScale.mmToIU( 0.005 );
+
+
+/**
+ * Append the polygon \a aShape given in X,Y axis of \a aItem, moved by \a aOffset, to
+ * \a aBuffer in A,B axis.
+ */
+static void appendABPolygon( const GERBER_DRAW_ITEM* aItem, const SHAPE_POLY_SET& aShape,
+                             const VECTOR2I& aOffset, SHAPE_POLY_SET& aBuffer )
+{
+    for( int ii = 0; ii < aShape.OutlineCount(); ++ii )
+    {
+        SHAPE_POLY_SET::POLYGON poly = aShape.CPolygon( ii );
+
+        for( SHAPE_LINE_CHAIN& chain : poly )
+        {
+            for( int jj = 0; jj < chain.PointCount(); ++jj )
+                chain.SetPoint( jj, aItem->GetABPosition( chain.CPoint( jj ) + aOffset ) );
+        }
+
+        aBuffer.AddPolygon( poly );
+    }
+}
+
+
+/**
+ * Append the shape of \a aItem to \a aBuffer, in A,B axis.
+ *
+ * The polygons cached by the D_CODEs must have been built: see prepareImage().
+ */
+static void transformItemToPolygon( const GERBER_DRAW_ITEM* aItem, SHAPE_POLY_SET& aBuffer )
+{
+    D_CODE*  code = aItem->GetDcodeDescr();
+    VECTOR2I start = aItem->GetABPosition( aItem->m_Start );
+    VECTOR2I end = aItem->GetABPosition( aItem->m_End );
+
+    switch( aItem->m_ShapeType )
+    {
+    case GBR_POLYGON:
+    {
+        if( aItem->m_ShapeAsPolygon.OutlineCount() == 0
+            || aItem->m_ShapeAsPolygon.COutline( 0 ).PointCount() < 3 )
+        {
+            break;
+        }
+
+        SHAPE_POLY_SET poly;
+        poly.AddOutline( aItem->m_ShapeAsPolygon.COutline( 0 ) );
+        appendABPolygon( aItem, poly, VECTOR2I( 0, 0 ), aBuffer );
+        break;
+    }
+
+    case GBR_SEGMENT:
+        if( code && code->m_ApertType == APT_RECT )
+        {
+            SHAPE_POLY_SET poly;
+            aItem->ConvertSegmentToPolygon( &poly );
+            appendABPolygon( aItem, poly, VECTOR2I( 0, 0 ), aBuffer );
+        }
+        else
+        {
+            TransformOvalToPolygon( aBuffer, start, end, aItem->m_Size.x, ARC_ERROR,
+                                    ERROR_INSIDE );
+        }
+
+        break;
+
+    case GBR_CIRCLE:
+    {
+        int radius = KiROUND( GetLineLength( aItem->m_Start, aItem->m_End ) );
+        TransformRingToPolygon( aBuffer, start, radius, aItem->m_Size.x, ARC_ERROR,
+                                ERROR_INSIDE );
+        break;
+    }
+
+    case GBR_ARC:
+    {
+        VECTOR2I center = aItem->GetABPosition( aItem->m_ArcCentre );
+        int      radius = KiROUND( GetLineLength( aItem->m_Start, aItem->m_ArcCentre ) );
+
+        // In Gerber, 360-degree arcs are stored in the file with start equal to end
+        if( aItem->m_Start == aItem->m_End )
+        {
+            TransformRingToPolygon( aBuffer, center, radius, aItem->m_Size.x, ARC_ERROR,
+                                    ERROR_INSIDE );
+            break;
+        }
+
+        EDA_ANGLE angle( atan2( double( aItem->m_End.y - aItem->m_ArcCentre.y ),
+                                double( aItem->m_End.x - aItem->m_ArcCentre.x ) )
+                         - atan2( double( aItem->m_Start.y - aItem->m_ArcCentre.y ),
+                                  double( aItem->m_Start.x - aItem->m_ArcCentre.x ) ),
+                         RADIANS_T );
+        angle.Normalize();
+
+        SHAPE_ARC arc( aItem->m_ArcCentre, aItem->m_Start, angle );
+        VECTOR2I  mid = aItem->GetABPosition( arc.GetArcMid() );
+
+        TransformArcToPolygon( aBuffer, start, mid, end, aItem->m_Size.x, ARC_ERROR,
+                               ERROR_INSIDE );
+        break;
+    }
+
+    case GBR_SPOT_CIRCLE:
+    case GBR_SPOT_RECT:
+    case GBR_SPOT_OVAL:
+    case GBR_SPOT_POLY:
+    {
+        if( !code )
+            break;
+
+        if( aItem->m_ShapeType == GBR_SPOT_POLY || code->m_DrillShape != APT_DEF_NO_HOLE )
+        {
+            appendABPolygon( aItem, code->m_Polygon, aItem->m_Start, aBuffer );
+        }
+        else if( aItem->m_ShapeType == GBR_SPOT_CIRCLE )
+        {
+            TransformCircleToPolygon( aBuffer, start, code->m_Size.x / 2, ARC_ERROR,
+                                      ERROR_INSIDE );
+        }
+        else if( aItem->m_ShapeType == GBR_SPOT_RECT )
+        {
+            SHAPE_POLY_SET poly;
+            VECTOR2I       half = code->m_Size / 2;
+
+            poly.NewOutline();
+            poly.Append( -half.x, -half.y );
+            poly.Append( half.x, -half.y );
+            poly.Append( half.x, half.y );
+            poly.Append( -half.x, half.y );
+            appendABPolygon( aItem, poly, aItem->m_Start, aBuffer );
+        }
+        else
+        {
+            VECTOR2I delta;
+
+            if( code->m_Size.x > code->m_Size.y )   // horizontal oval
+                delta.x = ( code->m_Size.x - code->m_Size.y ) / 2;
+            else                                    // vertical oval
+                delta.y = ( code->m_Size.y - code->m_Size.x ) / 2;
+
+            TransformOvalToPolygon( aBuffer, aItem->GetABPosition( aItem->m_Start - delta ),
+                                    aItem->GetABPosition( aItem->m_Start + delta ),
+                                    std::min( code->m_Size.x, code->m_Size.y ), ARC_ERROR,
+                                    ERROR_INSIDE );
+        }
+
+        break;
+    }
+
+    case GBR_SPOT_MACRO:
+        if( code && code->m_MacroShape.OutlineCount() )
+            appendABPolygon( aItem, code->m_MacroShape, aItem->m_Start, aBuffer );
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+/**
+ * Build the index of the items of \a aImage and the polygons cached by its D_CODEs, which are
+ * then only read by the comparison threads.
+ */
+static void prepareImage( GERBER_FILE_IMAGE* aImage )
+{
+    // A first query builds the index
+    std::vector<GERBER_DRAW_ITEM*> dummy;
+    aImage->QueryItems( BOX2I(), dummy );
+
+    for( GERBER_DRAW_ITEM* item : aImage->GetItems() )
+    {
+        D_CODE* code = item->GetDcodeDescr();
+
+        if( !item->m_Flashed || !code )
+            continue;
+
+        if( item->m_ShapeType == GBR_SPOT_MACRO )
+        {
+            if( code->GetMacro() )
+                code->GetMacro()->GetShape( code );
+        }
+        else if( code->m_Polygon.OutlineCount() == 0 )
+        {
+            code->ConvertShapeToPolygon( item );
+        }
+    }
+}
+
+
+/**
+ * @return the artwork of the items of \a aImage found in \a aTile, clipped to the tile.
+ */
+static SHAPE_POLY_SET tileArtwork( GERBER_FILE_IMAGE* aImage, const BOX2I& aTile )
+{
+    std::vector<GERBER_DRAW_ITEM*> items;
+    aImage->QueryItems( aTile, items );
+
+    SHAPE_POLY_SET artwork;
+
+    if( items.empty() )
+        return artwork;
+
+    // The items are merged in their order in the file: a clear (negative) item only removes
+    // the artwork of the dark items before it.  The consecutive items of same polarity are
+    // merged at once.
+    SHAPE_POLY_SET group;
+    bool           groupIsClear = false;
+
+    auto flushGroup =
+            [&]()
+            {
+                if( group.OutlineCount() == 0 )
+                    return;
+
+                if( groupIsClear )
+                    artwork.BooleanSubtract( group, SHAPE_POLY_SET::PM_FAST );
+                else
+                    artwork.BooleanAdd( group, SHAPE_POLY_SET::PM_FAST );
+
+                group.RemoveAllContours();
+            };
+
+    for( GERBER_DRAW_ITEM* item : items )
+    {
+        bool isClear = item->GetLayerPolarity();
+
+        if( isClear != groupIsClear )
+        {
+            flushGroup();
+            groupIsClear = isClear;
+        }
+
+        transformItemToPolygon( item, group );
+    }
+
+    flushGroup();
+
+    SHAPE_POLY_SET tile;
+    tile.NewOutline();
+    tile.Append( aTile.GetLeft(), aTile.GetTop() );
+    tile.Append( aTile.GetRight(), aTile.GetTop() );
+    tile.Append( aTile.GetRight(), aTile.GetBottom() );
+    tile.Append( aTile.GetLeft(), aTile.GetBottom() );
+
+    artwork.BooleanIntersection( tile, SHAPE_POLY_SET::PM_FAST );
+
+    // A negative image is dark everywhere but on its artwork
+    if( aImage->m_ImageNegative )
+    {
+        tile.BooleanSubtract( artwork, SHAPE_POLY_SET::PM_FAST );
+        return tile;
+    }
+
+    return artwork;
+}
+
+
+GERBER_DIFF::GERBER_DIFF( GERBER_FILE_IMAGE* aReference, GERBER_FILE_IMAGE* aCompared ) :
+        m_reference( aReference ),
+        m_compared( aCompared )
+{
+}
+
+
+bool GERBER_DIFF::Run( PROGRESS_REPORTER* aReporter )
+{
+    m_differences.RemoveAllContours();
+
+    prepareImage( m_reference );
+    prepareImage( m_compared );
+
+    BOX2I area;
+    bool  empty = true;
+
+    for( GERBER_FILE_IMAGE* image : { m_reference, m_compared } )
+    {
+        for( GERBER_DRAW_ITEM* item : image->GetItems() )
+        {
+            BOX2I bbox = item->GetBoundingBox();
+            bbox.Normalize();
+
+            if( empty )
+                area = bbox;
+            else
+                area.Merge( bbox );
+
+            empty = false;
+        }
+    }
+
+    if( empty )
+        return true;
+
+    int columns = (int) ( area.GetWidth() / TILE_SIZE ) + 1;
+    int rows = (int) ( area.GetHeight() / TILE_SIZE ) + 1;
+
+    std::vector<BOX2I> tiles;
+
+    for( int row = 0; row < rows; ++row )
+    {
+        for( int col = 0; col < columns; ++col )
+        {
+            tiles.emplace_back( VECTOR2I( area.GetX() + col * TILE_SIZE,
+                                          area.GetY() + row * TILE_SIZE ),
+                                VECTOR2I( TILE_SIZE, TILE_SIZE ) );
+        }
+    }
+
+    if( aReporter )
+        aReporter->SetMaxProgress( (int) tiles.size() );
+
+    std::vector<SHAPE_POLY_SET> tileDifferences( tiles.size() );
+    std::atomic<bool>           cancelled( false );
+    thread_pool&                tp = GetKiCadThreadPool();
+    std::vector<std::future<void>> returns;
+
+    returns.reserve( tiles.size() );
+
+    for( size_t ii = 0; ii < tiles.size(); ++ii )
+    {
+        returns.emplace_back( tp.submit(
+                [&, ii]()
+                {
+                    if( cancelled )
+                        return;
+
+                    SHAPE_POLY_SET diff = tileArtwork( m_reference, tiles[ii] );
+                    SHAPE_POLY_SET compared = tileArtwork( m_compared, tiles[ii] );
+
+                    diff.BooleanXor( compared, SHAPE_POLY_SET::PM_FAST );
+                    tileDifferences[ii] = std::move( diff );
+
+                    if( aReporter )
+                        aReporter->AdvanceProgress();
+                } ) );
+    }
+
+    for( const std::future<void>& ret : returns )
+    {
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+        while( status != std::future_status::ready )
+        {
+            if( aReporter && !aReporter->KeepRefreshing() )
+                cancelled = true;
+
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        }
+    }
+
+    if( cancelled )
+        return false;
+
+    // Merge the regions cut by the tile borders
+    SHAPE_POLY_SET differences;
+
+    for( SHAPE_POLY_SET& diff : tileDifferences )
+    {
+        for( int ii = 0; ii < diff.OutlineCount(); ++ii )
+            differences.AddPolygon( diff.CPolygon( ii ) );
+    }
+
+    differences.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    // Leave out the slivers left by the different approximations of a same arc
+    for( int ii = 0; ii < differences.OutlineCount(); ++ii )
+    {
+        BOX2I bbox = differences.COutline( ii ).BBox();
+
+        if( bbox.GetWidth() > 2 * ARC_ERROR && bbox.GetHeight() > 2 * ARC_ERROR )
+            m_differences.AddPolygon( differences.CPolygon( ii ) );
+    }
+
+    m_differences.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    return true;
+}
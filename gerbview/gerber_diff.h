@@ -0,0 +1,63 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GERBER_DIFF_H
+#define GERBER_DIFF_H
+
+#include <geometry/shape_poly_set.h>
+
+class GERBER_FILE_IMAGE;
+class PROGRESS_REPORTER;
+
+
+/**
+ * Compare the artwork of two gerber images.
+ *
+ * The shapes of the items of both images, with their polarity, are converted to polygons and
+ * compared with a xor.  The board area is split in tiles which are compared in parallel, so
+ * that only the items of a tile are merged at once.  The comparison does not use the frame
+ * or the view, so that it can be run without a GUI.
+ */
+class GERBER_DIFF
+{
+public:
+    GERBER_DIFF( GERBER_FILE_IMAGE* aReference, GERBER_FILE_IMAGE* aCompared );
+
+    /**
+     * Compare the images.
+     *
+     * @param aReporter is an optional progress reporter; the comparison is cancelled if the
+     *                  user cancels it.
+     * @return false if the comparison was cancelled.
+     */
+    bool Run( PROGRESS_REPORTER* aReporter = nullptr );
+
+    /**
+     * @return the areas covered by only one of the images, as fractured polygons in A,B axis.
+     *         Each outline is a changed region.
+     */
+    const SHAPE_POLY_SET& GetDifferences() const { return m_differences; }
+
+private:
+    GERBER_FILE_IMAGE* m_reference;
+    GERBER_FILE_IMAGE* m_compared;
+    SHAPE_POLY_SET     m_differences;
+};
+
+#endif  // GERBER_DIFF_H
@@ -440,6 +440,38 @@ void GERBER_DRAW_ITEM::MoveXY( const VECTOR2I& aMoveVector )
 }
 
 
+void GERBER_DRAW_ITEM::ConvertFlashedMacroToPolygon()
+{
+    D_CODE*         code = GetDcodeDescr();
+    APERTURE_MACRO* macro = code->GetMacro();
+    EDA_ANGLE       rotation( m_lyrRotation + m_GerberImageFile->m_ImageRotation, DEGREES_T );
+
+    if( !rotation.IsZero() || !m_GerberImageFile->m_DisplayRotation.IsZero()
+        || m_drawScale != VECTOR2I( 1, 1 ) )
+    {
+        m_AbsolutePolygon = *macro->GetApertureMacroShape( this, m_Start );
+        return;
+    }
+
+    // Without rotation nor scaling, the A,B position of a point of the shape is the point
+    // with swapped and mirrored axis, moved to the A,B position of the flash
+    int axes = ( m_swapAxis ? 1 : 0 ) | ( m_mirrorA ? 2 : 0 ) | ( m_mirrorB ? 4 : 0 );
+
+    if( code->m_FlashedMacroShape.OutlineCount() == 0 || code->m_FlashedMacroAxes != axes )
+    {
+        SHAPE_POLY_SET& shape = code->m_FlashedMacroShape;
+
+        shape = *macro->GetApertureMacroShape( this, VECTOR2I( 0, 0 ) );
+        shape.Move( -GetABPosition( VECTOR2I( 0, 0 ) ) );
+        shape.CacheTriangulation( false );
+        code->m_FlashedMacroAxes = axes;
+    }
+
+    m_AbsolutePolygon = code->m_FlashedMacroShape;
+    m_AbsolutePolygon.Move( GetABPosition( m_Start ) );
+}
+
+
 bool GERBER_DRAW_ITEM::HasNegativeItems()
 {
     bool isClear = m_LayerNegative ^ m_GerberImageFile->m_ImageNegative;
@@ -907,7 +939,17 @@ bool GERBER_DRAW_ITEM::HitTest( const VECTOR2I& aRefPos, int aAccuracy ) const
     }
 
     case GBR_SPOT_MACRO:
-        return m_AbsolutePolygon.Contains( VECTOR2I( aRefPos ), -1, aAccuracy );
+    {
+        // Test the shape of the D_CODE, in X,Y axis, rather than m_AbsolutePolygon which is
+        // not built until the item is drawn
+        D_CODE* code = GetDcodeDescr();
+
+        if( !code || !code->GetMacro() )
+            return false;
+
+        const SHAPE_POLY_SET& shape = code->GetMacro()->GetShape( code );
+        return shape.Contains( ref_pos - m_Start, -1, aAccuracy );
+    }
 
     case GBR_SEGMENT:
     case GBR_CIRCLE:
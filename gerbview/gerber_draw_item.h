@@ -165,6 +165,14 @@ public:
     void ConvertSegmentToPolygon();
     void ConvertSegmentToPolygon( SHAPE_POLY_SET* aPolygon ) const;
 
+    /**
+     * Set m_AbsolutePolygon to the shape of the aperture macro flashed by this item.
+     *
+     * When the item is neither rotated nor scaled, the shape and its triangulation are built
+     * once for the D_CODE and only moved to the position of each flash.
+     */
+    void ConvertFlashedMacroToPolygon();
+
     /**
      * Print the polygon stored in m_PolyCorners.
      */
@@ -122,6 +122,55 @@ void GERBER_FILE_IMAGE::SetDrawOffetAndRotation( VECTOR2D aOffsetMM, EDA_ANGLE a
     // are now outdated
     for( GERBER_DRAW_ITEM* item : GetItems() )
         item->m_AbsolutePolygon.RemoveAllContours();
+
+    // The bounding boxes too
+    m_itemsIndex.reset();
+}
+
+
+void GERBER_FILE_IMAGE::QueryItems( const BOX2I& aArea, std::vector<GERBER_DRAW_ITEM*>& aItems )
+{
+    using ITEMS_RTREE = RTree<int, int, 2, double>;
+
+    if( !m_itemsIndex )
+    {
+        std::vector<std::pair<ITEMS_RTREE::Rect, int>> entries;
+        entries.reserve( m_drawings.size() );
+
+        for( int ii = 0; ii < (int) m_drawings.size(); ++ii )
+        {
+            BOX2I bbox = m_drawings[ii]->GetBoundingBox();
+            bbox.Normalize();
+
+            ITEMS_RTREE::Rect rect = { { bbox.GetX(), bbox.GetY() },
+                                       { bbox.GetRight(), bbox.GetBottom() } };
+            entries.emplace_back( rect, ii );
+        }
+
+        m_itemsIndex = std::make_unique<ITEMS_RTREE>();
+        m_itemsIndex->BulkLoad( entries );
+    }
+
+    BOX2I area = aArea;
+    area.Normalize();
+
+    const int        min[2] = { area.GetX(), area.GetY() };
+    const int        max[2] = { area.GetRight(), area.GetBottom() };
+    std::vector<int> found;
+
+    auto visitor =
+            [&]( int aIndex ) -> bool
+            {
+                found.push_back( aIndex );
+                return true;
+            };
+
+    m_itemsIndex->Search( min, max, visitor );
+
+    std::sort( found.begin(), found.end() );
+
+    for( int index : found )
+        aItems.push_back( m_drawings[index] );
 }
 
 
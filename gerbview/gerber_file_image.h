@@ -25,9 +25,11 @@
 #ifndef GERBER_FILE_IMAGE_H
 #define GERBER_FILE_IMAGE_H
 
+#include <memory>
 #include <vector>
 #include <set>
 
+#include <geometry/rtree.h>
 #include <dcode.h>
 #include <gerber_draw_item.h>
 #include <am_primitive.h>
@@ -171,8 +173,18 @@ public:
     void AddItemToList( GERBER_DRAW_ITEM* aItem )
     {
         m_drawings.push_back( aItem );
+        m_itemsIndex.reset();
     }
 
+    /**
+     * Append to \a aItems the items whose bounding box intersects \a aArea, in the order of
+     * the items list.
+     *
+     * The items are searched in a R-tree, built on the first query after the items list or
+     * the draw offset and rotation were changed.
+     */
+    void QueryItems( const BOX2I& aArea, std::vector<GERBER_DRAW_ITEM*>& aItems );
+
     /**
      * @return the last GERBER_DRAW_ITEM* item of the items list
      */
@@ -468,13 +480,17 @@ public:
     GERBER_LAYER       m_GBRLayerParams;                 // hold params for the current gerber layer
     GERBER_DRAW_ITEMS  m_drawings;                       // linked list of Gerber Items to draw
 
+    ///< The bounding boxes of m_drawings, which are stored by index in the list
+    std::unique_ptr<RTree<int, int, 2, double>> m_itemsIndex;
+
     ///< Parameters used only to draw (display) items on this layer.
     ///< Do not change actual coordinates/orientation
     VECTOR2I           m_DisplayOffset;
     EDA_ANGLE          m_DisplayRotation;
 
-    // A large buffer to store one line
-    static char m_LineBuffer[GERBER_BUFZ+1];
+    // A large buffer to store one line, only allocated while a file is read.  Not shared
+    // between the images, so that several files can be read at once.
+    char*              m_LineBuffer = nullptr;
 
 private:
     wxArrayString      m_messagesList;         // A list of messages created when reading a file
@@ -33,6 +33,7 @@
 #define NO_AVAILABLE_LAYERS UNDEFINED_LAYER
 
 class DCODE_SELECTION_BOX;
+class EXCELLON_IMAGE;
 class GERBER_LAYER_WIDGET;
 class GBR_LAYER_BOX_SELECTOR;
 class GERBER_DRAW_ITEM;
@@ -311,6 +312,12 @@ public:
     bool LoadGerberFiles( const wxString& aFileName );
     bool Read_GERBER_File( const wxString& GERBER_FullFileName );
 
+    /**
+     * Add a Gerber image which was just read to \a aLayer, show the messages of its reading
+     * and add its items to the view.
+     */
+    void AddGerberImage( GERBER_FILE_IMAGE* aGerber, int aLayer );
+
     /**
      * Load a drill (EXCELLON) file or many files.
      *
@@ -322,6 +329,14 @@ public:
     bool LoadExcellonFiles( const wxString& aFileName );
     bool Read_EXCELLON_File( const wxString& aFullFileName );
 
+    /**
+     * Add a drill image which was just read to \a aLayer, show the messages of its reading
+     * and add its items to the view.
+     *
+     * @return false if there was no room for the image, which is then deleted.
+     */
+    bool AddExcellonImage( EXCELLON_IMAGE* aDrill, int aLayer );
+
     /**
      * Load a zipped archive file.
      *
@@ -568,11 +568,7 @@ void GERBVIEW_PAINTER::drawFlashedShape( GERBER_DRAW_ITEM* aItem, bool aFilled )
 void GERBVIEW_PAINTER::drawApertureMacro( GERBER_DRAW_ITEM* aParent, bool aFilled )
 {
     if( aParent->m_AbsolutePolygon.OutlineCount() == 0 )
-    {
-        D_CODE* code = aParent->GetDcodeDescr();
-        APERTURE_MACRO* macro = code->GetMacro();
-        aParent->m_AbsolutePolygon = *macro->GetApertureMacroShape( aParent, aParent->m_Start );
-    }
+        aParent->ConvertFlashedMacroToPolygon();
 
     SHAPE_POLY_SET& polyset = aParent->m_AbsolutePolygon;
 
@@ -209,6 +209,7 @@ void GERBVIEW_FRAME::doReCreateMenuBar()
 
     toolsMenu->Add( GERBVIEW_ACTIONS::showDCodes );
     toolsMenu->Add( GERBVIEW_ACTIONS::showSource );
+    toolsMenu->Add( GERBVIEW_ACTIONS::compareLayers );
 
     toolsMenu->Add( ACTIONS::measureTool );
 
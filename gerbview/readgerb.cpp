@@ -44,7 +44,6 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
     wxString msg;
 
     int layer = GetActiveLayer();
-    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
     GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
 
     if( gerber != nullptr )
@@ -67,15 +66,24 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
         return false;
     }
 
-    gerber = gerber_uptr.release();
-    wxASSERT( gerber != nullptr );
-    images->AddGbrImage( gerber, layer );
+    AddGerberImage( gerber_uptr.release(), layer );
+
+    return true;
+}
+
+
+void GERBVIEW_FRAME::AddGerberImage( GERBER_FILE_IMAGE* aGerber, int aLayer )
+{
+    wxString msg;
+
+    wxASSERT( aGerber != nullptr );
+    GetImagesList()->AddGbrImage( aGerber, aLayer );
 
     // Display errors list
-    if( gerber->GetMessages().size() > 0 )
+    if( aGerber->GetMessages().size() > 0 )
     {
         HTML_MESSAGE_BOX dlg( this, _( "Errors" ) );
-        dlg.ListSet( gerber->GetMessages() );
+        dlg.ListSet( aGerber->GetMessages() );
         dlg.ShowModal();
     }
 
@@ -84,9 +92,9 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
      * or has missing definitions,
      * warn the user:
      */
-    if( gerber->GetItemsCount() && gerber->m_Has_MissingDCode )
+    if( aGerber->GetItemsCount() && aGerber->m_Has_MissingDCode )
     {
-        if( !gerber->m_Has_DCode )
+        if( !aGerber->m_Has_DCode )
             msg = _("Warning: this file has no D-Code definition\n"
                     "Therefore the size of some items is undefined");
         else
@@ -98,17 +106,15 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 
     if( GetCanvas() )
     {
-        if( gerber->m_ImageNegative )
+        if( aGerber->m_ImageNegative )
         {
             // TODO: find a way to handle negative images
             // (maybe convert geometry into positives?)
         }
 
-        for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
+        for( GERBER_DRAW_ITEM* item : aGerber->GetItems() )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
-
-    return true;
 }
 
 
@@ -225,9 +231,6 @@ bool GERBER_FILE_IMAGE::TestFileIsRS274( const wxString& aFullFileName )
 }
 
 
-// A large buffer to store one line
-char GERBER_FILE_IMAGE::m_LineBuffer[GERBER_BUFZ+1];
-
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
     int      G_command = 0;        // command number for G commands like G04
@@ -249,6 +252,9 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     wxString msg;
 
+    std::vector<char> lineBuffer( GERBER_BUFZ + 1 );
+    m_LineBuffer = lineBuffer.data();
+
     while( true )
     {
         if( fgets( m_LineBuffer, GERBER_BUFZ, m_Current_File ) == nullptr )
@@ -332,6 +338,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     }
 
     fclose( m_Current_File );
+    m_LineBuffer = nullptr;
 
     m_InUse = true;
 
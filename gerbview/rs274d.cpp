@@ -332,7 +332,7 @@ static void fillArcPOLY( GERBER_DRAW_ITEM* aGbrItem, const VECTOR2I& aStart, con
     /* in order to calculate arc parameters, we use fillArcGBRITEM
      * so we muse create a dummy track and use its geometric parameters
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( nullptr );
+    thread_local GERBER_DRAW_ITEM dummyGbrItem( nullptr );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
@@ -91,6 +91,13 @@ TOOL_ACTION GERBVIEW_ACTIONS::showSource( TOOL_ACTION_ARGS()
         .Tooltip( _( "Show source file for the current layer" ) )
         .Icon( BITMAPS::tools ) );
 
+TOOL_ACTION GERBVIEW_ACTIONS::compareLayers( TOOL_ACTION_ARGS()
+        .Name( "gerbview.Inspection.compareLayers" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Compare Layers..." ) )
+        .Tooltip( _( "Load the differences between the current layer and another layer on a "
+                     "new layer" ) ) );
+
 TOOL_ACTION GERBVIEW_ACTIONS::exportToPcbnew( TOOL_ACTION_ARGS()
         .Name( "gerbview.Control.exportToPcbnew" )
         .Scope( AS_GLOBAL )
@@ -54,6 +54,7 @@ public:
     static TOOL_ACTION properties;
     static TOOL_ACTION showDCodes;
     static TOOL_ACTION showSource;
+    static TOOL_ACTION compareLayers;
 
     static TOOL_ACTION exportToPcbnew;
 
@@ -24,7 +24,9 @@
 #include <class_draw_panel_gal.h>
 #include <dialogs/dialog_layers_select_to_pcb.h>
 #include <gestfich.h>
+#include <gerber_diff.h>
 #include <gerber_file_image.h>
+#include <gerber_file_image_list.h>
 #include <gerbview_id.h>
 #include "gerbview_inspection_tool.h"
 #include "gerbview_actions.h"
@@ -37,6 +39,7 @@
 #include <view/view.h>
 #include <view/view_controls.h>
 #include <view/view_group.h>
+#include <widgets/wx_progress_reporters.h>
 #include <wx/msgdlg.h>
 #include <wx/textdlg.h>
 #include <wx/choicdlg.h>
@@ -196,6 +199,109 @@ int GERBVIEW_INSPECTION_TOOL::ShowSource( const TOOL_EVENT& aEvent )
 }
 
 
+int GERBVIEW_INSPECTION_TOOL::CompareLayers( const TOOL_EVENT& aEvent )
+{
+    int                     layer = m_frame->GetActiveLayer();
+    GERBER_FILE_IMAGE_LIST* images = m_frame->GetImagesList();
+    GERBER_FILE_IMAGE*      reference = images->GetGbrImage( layer );
+    wxString                msg;
+
+    if( !reference )
+    {
+        msg.Printf( _( "No file loaded on the active layer %d." ), layer + 1 );
+        wxMessageBox( msg );
+        return 0;
+    }
+
+    wxArrayString    names;
+    std::vector<int> layers;
+
+    for( int ii = 0; ii < (int) images->ImagesMaxCount(); ++ii )
+    {
+        if( ii != layer && images->GetGbrImage( ii ) )
+        {
+            names.Add( images->GetDisplayName( ii, false, true ) );
+            layers.push_back( ii );
+        }
+    }
+
+    if( names.IsEmpty() )
+    {
+        wxMessageBox( _( "No other layer to compare the active layer with." ) );
+        return 0;
+    }
+
+    wxSingleChoiceDialog dlg( m_frame, _( "Compare the active layer with:" ),
+                              _( "Compare Layers" ), names );
+
+    if( dlg.ShowModal() != wxID_OK )
+        return 0;
+
+    GERBER_FILE_IMAGE* compared = images->GetGbrImage( layers[dlg.GetSelection()] );
+    int                diffLayer = m_frame->getNextAvailableLayer();
+
+    if( diffLayer == NO_AVAILABLE_LAYERS )
+    {
+        m_frame->ShowInfoBarError( _( "No empty layers to load the differences into." ) );
+        return 0;
+    }
+
+    GERBER_DIFF diff( reference, compared );
+
+    {
+        WX_PROGRESS_REPORTER reporter( m_frame, _( "Compare Layers" ), 1, true );
+
+        if( !diff.Run( &reporter ) )
+            return 0;
+    }
+
+    const SHAPE_POLY_SET& differences = diff.GetDifferences();
+
+    if( differences.OutlineCount() == 0 )
+    {
+        m_frame->ShowInfoBarMsg( _( "No differences found." ) );
+        return 0;
+    }
+
+    // Each changed region is a polygon item of the new layer, so it can be selected
+    GERBER_FILE_IMAGE* image = new GERBER_FILE_IMAGE( diffLayer );
+
+    image->m_FileName = wxFileName( reference->m_FileName ).GetName() + wxT( "-" )
+                        + wxFileName( compared->m_FileName ).GetName() + wxT( ".diff" );
+    image->m_InUse = true;
+
+    for( int ii = 0; ii < differences.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN& outline = differences.COutline( ii );
+        GERBER_DRAW_ITEM*       item = new GERBER_DRAW_ITEM( image );
+
+        item->m_ShapeType = GBR_POLYGON;
+        item->m_ShapeAsPolygon.NewOutline();
+
+        for( int jj = 0; jj < outline.PointCount(); ++jj )
+            item->m_ShapeAsPolygon.Append( item->GetXYPosition( outline.CPoint( jj ) ) );
+
+        item->m_Start = item->m_ShapeAsPolygon.CVertex( 0 );
+        image->AddItemToList( item );
+    }
+
+    m_frame->AddGerberImage( image, diffLayer );
+
+    LSET visibility = m_frame->GetVisibleLayers();
+    visibility[ diffLayer ] = true;
+    m_frame->SetVisibleLayers( visibility );
+    m_frame->SetActiveLayer( diffLayer, true );
+    m_frame->ReFillLayerWidget();
+    m_frame->syncLayerBox( true );
+    m_frame->GetCanvas()->Refresh();
+
+    msg.Printf( _( "%d changed regions found." ), differences.OutlineCount() );
+    m_frame->ShowInfoBarMsg( msg );
+
+    return 0;
+}
+
+
 using KIGFX::PREVIEW::TWO_POINT_GEOMETRY_MANAGER;
 
 
@@ -326,5 +432,6 @@ void GERBVIEW_INSPECTION_TOOL::setTransitions()
 {
     Go( &GERBVIEW_INSPECTION_TOOL::ShowSource,     GERBVIEW_ACTIONS::showSource.MakeEvent() );
     Go( &GERBVIEW_INSPECTION_TOOL::ShowDCodes,     GERBVIEW_ACTIONS::showDCodes.MakeEvent() );
+    Go( &GERBVIEW_INSPECTION_TOOL::CompareLayers,  GERBVIEW_ACTIONS::compareLayers.MakeEvent() );
     Go( &GERBVIEW_INSPECTION_TOOL::MeasureTool,    ACTIONS::measureTool.MakeEvent() );
 }
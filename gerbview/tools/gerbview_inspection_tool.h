@@ -46,6 +46,9 @@ public:
     ///< Show the source for the gerber file
     int ShowSource( const TOOL_EVENT& aEvent );
 
+    ///< Load the differences between the active layer and another layer on a new layer
+    int CompareLayers( const TOOL_EVENT& aEvent );
+
     ///< Set up handlers for various events.
     void setTransitions() override;
 
@@ -25,6 +25,7 @@
 #define ADVANCED_CFG__H
 
 #include <kicommon.h>
+#include <wx/string.h>
 
 class wxConfigBase;
 
@@ -227,6 +228,40 @@ public:
      */
     bool m_EnableRouterDump;
 
+    /**
+     * Cell size of the spatial hash used by the PNS router to index the routing world, in mm.
+     * The router makes very many small queries around the items it moves, which a grid a
+     * little larger than the usual clearances answers faster than the R-tree.
+     *
+     * 0 keeps the R-tree.
+     *
+     * Setting name: "RouterIndexGridSize"
+     * Valid values: 0 to 100
+     * Default value: 0
+     */
+    double m_RouterIndexGridSize;
+
+    /**
+     * Let the PNS router walk around obstacles clockwise and counter-clockwise at the same time,
+     * and check the pad exits tried by its optimizer, on the thread pool.
+     *
+     * Setting name: "ParallelRouter"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelRouter;
+
+    /**
+     * Keep the PNS router world between runs of the router tools and update it with the board
+     * changes made since, instead of syncing it from the whole board each time.  The world is
+     * still synced anew after rule, stackup or board outline changes.
+     *
+     * Setting name: "IncrementalRouterSync"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_IncrementalRouterSync;
+
     /**
      * Slide the zoom steps over for debugging things "up close".
      *
@@ -567,6 +602,424 @@ public:
      */
     bool m_EnableCacheFriendlyFracture;
 
+    /**
+     * Restrict automatic zone refills to the areas touched by an edit (when the existing fill
+     * allows it) rather than refilling whole zones.
+     *
+     * Setting name: "EnableRegionZoneRefill"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_EnableRegionZoneRefill;
+
+    /**
+     * Zones larger than this (in either direction) are filled in tiles of about this size,
+     * which can be computed in parallel.  Units are mm; 0 disables tiling.
+     *
+     * Setting name: "ZoneFillTileSize"
+     * Valid values: 0 to 1000
+     * Default value: 30
+     */
+    double m_ZoneFillTileSize;
+
+    /**
+     * Keep the existing fill of zones whose inputs (outline, settings, nearby items and rules)
+     * hash to the same value as when they were last filled.
+     *
+     * Setting name: "SkipUnchangedZoneFills"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_SkipUnchangedZoneFills;
+
+    /**
+     * Run automatic zone refills on a copy of the board in the background, so that the editor
+     * stays responsive.  The result is discarded (and the fill restarted) if the board changes
+     * before it completes.
+     *
+     * Setting name: "BackgroundZoneFill"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_BackgroundZoneFill;
+
+    /**
+     * When only a few anchors of a net have changed, update its ratsnest by re-triangulating the
+     * neighbourhood of the changes rather than the whole net.
+     *
+     * Setting name: "IncrementalRatsnest"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_IncrementalRatsnest;
+
+    /**
+     * Recompute the ratsnest on a worker thread after each commit, displaying the previous
+     * ratsnest of the affected nets until it is ready.
+     *
+     * Setting name: "AsyncRatsnest"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_AsyncRatsnest;
+
+    /**
+     * Time allowed (in ms) for updating the ratsnest of the items being moved on each frame.
+     * Nets which don't fit in the budget keep their previous line, following the move, and are
+     * updated first on the next frame.  0 updates every net on every frame.
+     *
+     * Setting name: "LocalRatsnestBudget"
+     * Valid values: 0 to 1000
+     * Default value: 15
+     */
+    int m_LocalRatsnestBudget;
+
+    /**
+     * Re-run DRC only around the items changed since the previous run, keeping the markers of
+     * violations which are away from the changes.  Falls back to a full run whenever the
+     * rules, the options or the board setup change.
+     *
+     * Setting name: "IncrementalDRC"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_IncrementalDRC;
+
+    /**
+     * During a DRC run, share the rule resolution of a constraint type between item pairs with
+     * the same nets, types and layer when all its rule conditions read nothing else.
+     *
+     * Setting name: "MemoizeDRCConstraints"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_MemoizeDRCConstraints;
+
+    /**
+     * Run the single-threaded DRC test providers which don't depend on each other concurrently
+     * on the thread pool, instead of one after another.
+     *
+     * Setting name: "ConcurrentDRCProviders"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ConcurrentDRCProviders;
+
+    /**
+     * Build the effective shapes of the copper items once per DRC run, and share them between
+     * the test providers.
+     *
+     * Setting name: "CacheDRCShapes"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_CacheDRCShapes;
+
+    /**
+     * Keep the compiled programs of DRC rule conditions, and reuse them for the conditions with
+     * the same expression when the rules are loaded again.
+     *
+     * Setting name: "CacheDRCRulePrograms"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_CacheDRCRulePrograms;
+
+    /**
+     * Run the ERC checks of the connection graph subgraphs and of the nets for the pin to pin
+     * test on the thread pool.
+     *
+     * Setting name: "ParallelERC"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelERC;
+
+    /**
+     * Save the triangulations of the zone fills in a cache file next to the board file when
+     * saving it, and restore them from there when opening the board instead of triangulating
+     * the fills again.
+     *
+     * Setting name: "CacheZoneTriangulation"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_CacheZoneTriangulation;
+
+    /**
+     * Inflate sets of disjoint convex outlines, such as track segments and vias, with round
+     * corners directly instead of going through the general Clipper offset.
+     *
+     * Setting name: "EnableConvexInflateFastPath"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_EnableConvexInflateFastPath;
+
+    /**
+     * Let the callers which inflate the same outlines over and over, such as custom pad and
+     * zone clearances, reuse the results through an INFLATE_CACHE.
+     *
+     * Setting name: "CacheInflatedOutlines"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_CacheInflatedOutlines;
+
+    /**
+     * Parse the footprints, tracks and zones of a .kicad_pcb file in parallel worker parsers
+     * rather than one after the other.
+     *
+     * Setting name: "ParallelBoardLoad"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelBoardLoad;
+
+    /**
+     * Write a binary snapshot of the zone fills of a board to the user cache directory when
+     * saving it, and restore the fills from the snapshot instead of reading them when the
+     * unchanged board file is opened again.
+     *
+     * Setting name: "BoardSnapshots"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_BoardSnapshots;
+
+    /**
+     * Format the footprints, tracks and zones of a board on the thread pool when saving it,
+     * and prettify large files in parallel parts.  Also writes the files of a footprint
+     * library in parallel.
+     *
+     * Setting name: "ParallelBoardSave"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelBoardSave;
+
+    /**
+     * Only list the files of a footprint library when it is opened, and read each footprint
+     * the first time it is asked for.
+     *
+     * Setting name: "LazyFootprintLibraries"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_LazyFootprintLibraries;
+
+    /**
+     * Parse the sheet files of a schematic hierarchy on the thread pool, a level of the
+     * hierarchy at a time, when loading it.
+     *
+     * Setting name: "ParallelSchematicLoad"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelSchematicLoad;
+
+    /**
+     * Only scan symbol library files for the extent of their symbols when opening them, and
+     * parse each symbol from the mapped file the first time it is asked for.
+     *
+     * Setting name: "LazySymbolLibraries"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_LazySymbolLibraries;
+
+    /**
+     * Decode the records of the independent streams of an Altium board (polygons, arcs, pads,
+     * vias, tracks and regions) on the thread pool before converting them to board items.
+     *
+     * Setting name: "ParallelAltiumImport"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelAltiumImport;
+
+    /**
+     * Read Eagle boards one section at a time from the mapped file, parsing each into a small
+     * document which is released once it has been converted, and parse the independent
+     * libraries of the board on the thread pool.
+     *
+     * Setting name: "StreamingEagleImport"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_StreamingEagleImport;
+
+    /**
+     * How long, in milliseconds, the timestamps generated for the footprint libraries are
+     * reused before the libraries are stat'ed again.  The editors ask for them several times
+     * as they open, which is slow for libraries on network file systems.  Changes made through
+     * the library table are always seen at once.
+     *
+     * Setting name: "LibraryTimestampCacheMs"
+     * Valid values: 0 to 3600000
+     * Default value: 5000
+     */
+    int m_LibraryTimestampCacheMs;
+
+    /**
+     * Start the Python interpreter on the first use of Python (e.g. by the scripting console,
+     * the action plugins or the footprint wizards) instead of when the program starts.
+     *
+     * Setting name: "DeferPythonInit"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_DeferPythonInit;
+
+    /**
+     * Load the schematic and board editor libraries on a worker thread once the project
+     * manager is shown, so that the editors open faster the first time.
+     *
+     * Setting name: "PreloadKifaces"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_PreloadKifaces;
+
+    /**
+     * Keep the file text of the footprints, drawings, tracks and zones of the board being
+     * edited, so that saving it again only formats the items changed since the last save.
+     *
+     * Setting name: "IncrementalBoardSave"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_IncrementalBoardSave;
+
+    /**
+     * Compute polygon triangulations, text render caches and the like on the thread pool when
+     * a large number of items are redrawn at once (e.g. when changing the color theme or the
+     * visible layers), leaving only the upload to the graphics layer to the GUI thread.
+     *
+     * Setting name: "ParallelViewUpdate"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelViewUpdate;
+
+    /**
+     * Draw the net names of pads, vias and tracks every frame from the items in view rather
+     * than caching them for the whole board.  They are only shown when zoomed in, and their
+     * text is most of the vertices cached for a board with many vias.
+     *
+     * Setting name: "UncachedNetnameLayers"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_UncachedNetnameLayers;
+
+    /**
+     * Draw large zone fills from a decimated copy of their outlines when zoomed out far enough
+     * for the decimation to be smaller than a pixel.
+     *
+     * Setting name: "ZoneFillProxies"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ZoneFillProxies;
+
+    /**
+     * Draw stroke font text in OpenGL as one quad per glyph, shaded from a distance field atlas
+     * of the font glyphs, rather than as one line quad per stroke segment.  Italic text, text
+     * with a very thick pen and glyphs missing from the atlas are still drawn from segments.
+     *
+     * Setting name: "StrokeGlyphAtlas"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_StrokeGlyphAtlas;
+
+    /**
+     * Only cache the graphics of an item on a layer once the zoom level shows it there, e.g.
+     * the pad numbers of a board shown whole are not laid out until zoomed in on the pads.
+     *
+     * Setting name: "LazyLodGroups"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_LazyLodGroups;
+
+    /**
+     * Show the render statistics of the canvas in its top left corner: the times of the last
+     * frame, the cache use and the items and vertices drawn on the busiest layers.  They are
+     * also appended, one line per frame, to render_statistics.log in the user cache directory.
+     *
+     * Setting name: "ShowRenderStatistics"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_ShowRenderStatistics;
+
+    /**
+     * Draw the cached layers of the Cairo canvas in horizontal tiles, one per thread of the
+     * thread pool, instead of rasterizing the whole viewport on one thread.
+     *
+     * Setting name: "CairoTiledRendering"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_CairoTiledRendering;
+
+    /**
+     * Recolor the cached groups of the OpenGL canvas, for instance when highlighting a net,
+     * through a table of group colors read by the shaders instead of rewriting the colors of
+     * their vertices.
+     *
+     * Setting name: "GroupColorTable"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_GroupColorTable;
+
+    /**
+     * Time in milliseconds spent at most updating the graphics of modified items before a frame
+     * of the canvas is drawn.  The remaining items keep their previous graphics and are updated
+     * over the next frames, so large changes don't freeze the canvas.  0 updates all the items
+     * before drawing.
+     *
+     * Setting name: "ViewUpdateTimeBudget"
+     * Valid values: 0 to 1000
+     * Default value: 40
+     */
+    double m_ViewUpdateTimeBudget;
+
+    /**
+     * Memory in megabytes the 3D model memory cache may use for the models which aren't needed by
+     * the board being viewed.  The least recently used models are freed beyond that size and are
+     * read again from the 3D model file cache when needed.  0 keeps all the models in memory.
+     *
+     * Setting name: "3DModelMemoryCacheSize"
+     * Valid values: 0 to 1000000
+     * Default value: 2048
+     */
+    int m_3DModelMemoryCacheSize;
+
+    /**
+     * Memory in megabytes the board and footprint editors may keep in their undo lists, as
+     * estimated from the copies they hold.  The oldest commands are dropped beyond that size,
+     * but the newest one is always kept.  0 only limits the number of commands.
+     *
+     * Setting name: "UndoMemoryLimit"
+     * Valid values: 0 to 1000000
+     * Default value: 1024
+     */
+    int m_UndoMemoryLimit;
+
+    /**
+     * File the trace of the session is written to when KiCad exits, in the Chrome trace event
+     * format, to find out where the time goes on a given machine.  Empty disables the trace.
+     *
+     * Setting name: "PerfTraceFile"
+     * Valid values: a file path
+     * Default value: ""
+     */
+    wxString m_PerfTraceFile;
+
     ///@}
 
 
@@ -37,6 +37,8 @@
 #include <memory>
 #include <mutex>
 
+class wxFFile;
+
 #include <gal/cursors.h>
 
 class BOARD;
@@ -265,6 +267,12 @@ protected:
     void onRefreshTimer( wxTimerEvent& aEvent );
     void onShowTimer( wxTimerEvent& aEvent );
 
+    /// Draw the render statistics overlay enabled by the ShowRenderStatistics advanced setting.
+    void drawStatistics();
+
+    /// Append the statistics of the last frame to the render statistics log.
+    void logStatistics();
+
     wxWindow*                m_parent;           ///< Pointer to the parent window
     EDA_DRAW_FRAME*          m_edaFrame;         ///< Parent EDA_DRAW_FRAME (if available)
 
@@ -272,6 +280,18 @@ protected:
     wxLongLong               m_lastRepaintEnd;   ///< Timestamp of the last repaint end
     wxTimer                  m_refreshTimer;     ///< Timer to prevent too-frequent refreshing
 
+    /// Times of the last frame, in milliseconds, for the render statistics
+    struct FRAME_STATISTICS
+    {
+        double m_frameTime = 0.0;
+        double m_updateTime = 0.0;
+        double m_redrawTime = 0.0;
+        double m_endTime = 0.0;
+    };
+
+    FRAME_STATISTICS         m_statistics;
+    std::unique_ptr<wxFFile> m_statisticsLog;    ///< Render statistics log, opened on first use
+
     std::mutex               m_refreshMutex;     ///< Blocks multiple calls to the draw
 
     /// True if GAL is currently redrawing the view
@@ -116,7 +116,10 @@ private:
 
     char m_quoteChar;
 
-    typedef DATABASE_CACHE<std::map<std::string, ROW>> DB_CACHE_TYPE;
+    /// The rows of a table by key, shared so that reading them from the cache doesn't copy them
+    typedef std::shared_ptr<const std::map<std::string, ROW>> TABLE_ROWS;
+
+    typedef DATABASE_CACHE<TABLE_ROWS> DB_CACHE_TYPE;
 
     std::unique_ptr<DB_CACHE_TYPE> m_cache;
 };
@@ -50,6 +50,15 @@ struct KICOMMON_API KEYWORD
 //#define TOKDEF(x)    { #x, T_##x }
 
 
+/**
+ * A keyword lookup function, generated for each grammar by TokenList2DsnLexer.cmake.
+ *
+ * @return the token of the keyword \a aToken of \a aLength characters, or #DSN_SYMBOL if
+ *         it isn't a keyword of the grammar.
+ */
+typedef int ( *KEYWORD_LOOKUP )( const char* aToken, size_t aLength );
+
+
 /**
  * List all the DSN lexer's tokens that are supported in lexing.
  *
@@ -87,10 +96,11 @@ public:
      * @param aKeywordTable is an array of KEYWORDS holding \a aKeywordCount.  This
      *  token table need not contain the lexer separators such as '(' ')', etc.
      * @param aKeywordCount is the count of tokens in aKeywordTable.
+     * @param aKeywordLookup finds the token of a keyword of aKeywordTable.
      * @param aFile is an open file, which will be closed when this is destructed.
      * @param aFileName is the name of the file
      */
-    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const KEYWORD_MAP* aKeywordMap,
+    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, KEYWORD_LOOKUP aKeywordLookup,
               FILE* aFile, const wxString& aFileName );
 
     /**
@@ -99,10 +109,11 @@ public:
      * @param aKeywordTable is an array of KEYWORDS holding \a aKeywordCount.  This
      *  token table need not contain the lexer separators such as '(' ')', etc.
      * @param aKeywordCount is the count of tokens in aKeywordTable.
+     * @param aKeywordLookup finds the token of a keyword of aKeywordTable.
      * @param aSExpression is text to feed through a STRING_LINE_READER
      * @param aSource is a description of aSExpression, used for error reporting.
      */
-    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const KEYWORD_MAP* aKeywordMap,
+    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, KEYWORD_LOOKUP aKeywordLookup,
               const std::string& aSExpression, const wxString& aSource = wxEmptyString );
 
     /**
@@ -124,10 +135,11 @@ public:
      * @param aKeywordTable is an array of #KEYWORDS holding \a aKeywordCount.  This
      *  token table need not contain the lexer separators such as '(' ')', etc.
      * @param aKeywordCount is the count of tokens in aKeywordTable.
+     * @param aKeywordLookup finds the token of a keyword of aKeywordTable.
      * @param aLineReader is any subclassed instance of LINE_READER, such as
      *  #STRING_LINE_READER or #FILE_LINE_READER.  No ownership is taken.
      */
-    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const KEYWORD_MAP* aKeywordMap,
+    DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, KEYWORD_LOOKUP aKeywordLookup,
               LINE_READER* aLineReader = nullptr );
 
     virtual ~DSNLEXER();
@@ -207,6 +219,15 @@ public:
      */
     int NextTok();
 
+    /**
+     * Skip the rest of the current list, up to and including its closing #DSN_RIGHT, without
+     * tokenizing it.  This is much faster than reading the tokens when the parser doesn't need
+     * them.  Quoted strings are skipped using the KiCad quoting protocol.
+     *
+     * @throw IO_ERROR if the end of the file is reached first.
+     */
+    void SkipSection();
+
     /**
      * Call #NextTok() and then verifies that the token read in satisfies #IsSymbol().
      *
@@ -552,7 +573,7 @@ protected:
 
     const KEYWORD*      keywords;               ///< table sorted by CMake for bsearch()
     unsigned            keywordCount;           ///< count of keywords table
-    const KEYWORD_MAP*  keywordsLookup;         ///< fast, specialized "C string" hashtable
+    KEYWORD_LOOKUP      keywordsLookup;         ///< generated switch over the keywords
 #endif // SWIG
 };
 
@@ -30,6 +30,8 @@
 #define EDA_PATTERN_MATCH_H
 
 #include <kicommon.h>
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <memory>
@@ -58,6 +60,31 @@ struct KICOMMON_API SEARCH_TERM
 };
 
 
+/*
+ * A fixed size signature of the (case folded) character trigrams found in some search terms.
+ *
+ * It is built once for the terms of an item and lets a matcher rule out, with a few bitwise
+ * operations, the items which can't contain its pattern.  The signature may have trigrams the
+ * terms don't have, but never lacks one they do, so no match is ever ruled out.
+ */
+struct KICOMMON_API SEARCH_TRIGRAMS
+{
+    SEARCH_TRIGRAMS() : m_bits() {}
+
+    explicit SEARCH_TRIGRAMS( const std::vector<SEARCH_TERM>& aTerms );
+
+    void Add( const wxString& aText );
+
+    ///< True if no text of at least three characters was added
+    bool IsEmpty() const;
+
+    ///< False if \a aOther has a trigram which isn't in this signature
+    bool Contains( const SEARCH_TRIGRAMS& aOther ) const;
+
+    std::array<uint64_t, 4> m_bits;
+};
+
+
 /*
  * Interface for a pattern matcher, for which there are several implementations
  */
@@ -244,12 +271,24 @@ public:
 
     int ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms );
 
+    /*
+     * Score the terms as above, but return 0 straight away when \a aTermTrigrams show that
+     * the terms can't contain the pattern.
+     *
+     * @param aTermTrigrams the trigram signature of \a aWeightedTerms
+     */
+    int ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms,
+                    const SEARCH_TRIGRAMS& aTermTrigrams );
+
 private:
     // Add matcher if it can compile the pattern.
     void AddMatcher( const wxString& aPattern, std::unique_ptr<EDA_PATTERN_MATCH> aMatcher );
 
     std::vector<std::unique_ptr<EDA_PATTERN_MATCH>> m_matchers;
     wxString m_pattern;
+
+    ///< Trigrams of the pattern, if all the matchers look for it as a literal substring
+    SEARCH_TRIGRAMS m_literalTrigrams;
 };
 
 #endif  // EDA_PATTERN_MATCH_H
@@ -255,6 +255,9 @@ public:
      * @param aTriangulate: true to build also the triangulation of each shape
      * @param aUseTextRotation: true to use the actual text draw rotation.
      * false to build a list of shape for a not rotated text ("native" shapes).
+     *
+     * The triangulated shape of the text as drawn is cached (like the render cache) and shared
+     * between callers, so it must not be modified.
      */
     std::shared_ptr<SHAPE_COMPOUND> GetEffectiveTextShape( bool aTriangulate = true,
                                                            const BOX2I& aBBox = BOX2I(),
@@ -349,6 +352,11 @@ public:
                            const EDA_ANGLE& aAngle, const VECTOR2I& aOffset );
     void AddRenderCacheGlyph( const SHAPE_POLY_SET& aPoly );
 
+    /**
+     * @return an estimate of the memory held by the render and shape caches, for reports.
+     */
+    size_t GetRenderCacheMemoryUsage() const;
+
     int Compare( const EDA_TEXT* aOther ) const;
 
     bool operator==( const EDA_TEXT& aRhs ) const { return Compare( &aRhs ) == 0; }
@@ -425,6 +433,13 @@ private:
     mutable VECTOR2I                                    m_render_cache_offset;
     mutable std::vector<std::unique_ptr<KIFONT::GLYPH>> m_render_cache;
 
+    mutable std::shared_ptr<SHAPE_COMPOUND>             m_shape_cache;
+    mutable wxString                                    m_shape_cache_text;
+    mutable const KIFONT::FONT*                         m_shape_cache_font;
+    mutable EDA_ANGLE                                   m_shape_cache_angle;
+    mutable VECTOR2I                                    m_shape_cache_pos;
+    mutable int                                         m_shape_cache_pen_width;
+
     mutable bool     m_bounding_box_cache_valid;
     mutable VECTOR2I m_bounding_box_cache_pos;
     mutable int      m_bounding_box_cache_line;
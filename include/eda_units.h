@@ -31,6 +31,8 @@
 #include <base_units.h>
 #include <core/minoptmax.h>
 
+#include <string_view>
+
 /**
  * The type of unit.
  */
@@ -126,6 +128,18 @@ namespace EDA_UNIT_UTILS
     KICOMMON_API std::string FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                   const VECTOR2I&     aPoint );
 
+    /**
+     * Convert a plain decimal millimetre string, such as "-12.5", to internal units without
+     * going through floating point.
+     *
+     * This should only be used for reading from files as it ignores locale.
+     *
+     * @return false if @a aInput is not a plain decimal, needs rounding to fit the internal
+     *         units or is out of range; the caller should fall back to parsing it as a double.
+     */
+    KICOMMON_API bool ParseInternalUnitsExact( std::string_view aInput,
+                                               const EDA_IU_SCALE& aIuScale, int& aOut );
+
 #if 0   // No support for std::from_chars on MacOS yet
     /**
      * Converts \a aInput string to internal units when reading from a file.
@@ -27,6 +27,7 @@
 #include <wx/string.h>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <font/fontinfo.h>
 
@@ -57,12 +58,17 @@ public:
      * Given a fully-qualified font name ("Times:Bold:Italic") find the closest matching font
      * and return its filepath in \a aFontFile.
      *
+     * The exact matches are kept in a cache file between sessions, so that the fonts of a
+     * document are usually found without fontconfig, which is only initialized for the others.
+     *
      * A return value of false indicates a serious error in the font system.
      */
     FF_RESULT FindFont( const wxString& aFontName, wxString& aFontFile, int& aFaceIndex, bool aBold, bool aItalic );
 
     /**
-     * List the current available font families.
+     * List the current available font families.  This initializes fontconfig, which can take
+     * seconds on systems with many fonts the first time, so it is done in the background at
+     * startup.
      *
      * @param aDesiredLang The desired language of font name to report back if available, otherwise it will fallback
      */
@@ -76,10 +82,35 @@ public:
     static void SetReporter( REPORTER* aReporter );
 
 private:
+    struct FONT_MATCH
+    {
+        wxString  m_file;
+        int       m_faceIndex = 0;
+        long long m_modTime = 0;        ///< Modification time of m_file, in seconds
+        bool      m_checked = false;    ///< m_modTime was checked during this session
+    };
+
     std::map<std::string, FONTINFO> m_fontInfoCache;
     wxString                        m_fontCacheLastLang;
+    std::mutex                      m_fontInfoMutex;
     static REPORTER*                s_reporter;
 
+    /// The exact matches of FindFont(), by font name and style, also kept in a cache file
+    std::map<std::string, FONT_MATCH> m_matchCache;
+    std::mutex                        m_matchCacheMutex;
+
+    /**
+     * Fetch the cached match of \a aKey, dropping it if its font file changed.
+     *
+     * @return true if there was a valid match.
+     */
+    bool findCachedMatch( const std::string& aKey, wxString& aFontFile, int& aFaceIndex );
+
+    void addCachedMatch( const std::string& aKey, const wxString& aFontFile, int aFaceIndex );
+
+    void loadMatchCache();
+    void saveMatchCache();
+
     /**
      * Matches the two rfc 3306 language entries, used for when searching for matching family names
      *
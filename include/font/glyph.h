@@ -122,9 +122,36 @@ public:
 
     void Move( const VECTOR2I& aOffset );
 
+    /**
+     * Mark this glyph as one of the glyphs of a stroke font, which live as long as the program.
+     */
+    void SetIsFontGlyph() { m_fontGlyph = this; }
+
+    /**
+     * @return the stroke font glyph this glyph was copied or transformed from, or nullptr if it
+     *         wasn't made from one (an overbar for instance).
+     */
+    const STROKE_GLYPH* GetFontGlyph() const { return m_fontGlyph; }
+
+    /**
+     * Get the affine transform from the coordinates of GetFontGlyph() to the ones of this
+     * glyph: a point \a p of the font glyph is at aOrigin + p.x * aXAxis + p.y * aYAxis.
+     */
+    void GetFontTransform( VECTOR2D& aOrigin, VECTOR2D& aXAxis, VECTOR2D& aYAxis ) const
+    {
+        aOrigin = m_origin;
+        aXAxis = m_xAxis;
+        aYAxis = m_yAxis;
+    }
+
 private:
     bool  m_penIsDown = false;
     BOX2D m_boundingBox;
+
+    const STROKE_GLYPH* m_fontGlyph = nullptr;
+    VECTOR2D            m_origin = { 0.0, 0.0 };
+    VECTOR2D            m_xAxis = { 1.0, 0.0 };
+    VECTOR2D            m_yAxis = { 0.0, 1.0 };
 };
 
 
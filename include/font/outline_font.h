@@ -57,12 +57,14 @@ public:
 
     bool IsBold() const override
     {
-        return m_face && ( m_fakeBold || ( m_face->style_flags & FT_STYLE_FLAG_BOLD ) );
+        FT_Face face = GetFace();
+        return face && ( m_fakeBold || ( face->style_flags & FT_STYLE_FLAG_BOLD ) );
     }
 
     bool IsItalic() const override
     {
-        return m_face && ( m_fakeItal || ( m_face->style_flags & FT_STYLE_FLAG_ITALIC ) );
+        FT_Face face = GetFace();
+        return face && ( m_fakeItal || ( face->style_flags & FT_STYLE_FLAG_ITALIC ) );
     }
 
     void SetFakeBold()
@@ -77,6 +79,10 @@ public:
 
     /**
      * Load an outline font. TrueType (.ttf) and OpenType (.otf) are supported.
+     *
+     * The font file is only opened by FreeType when the font is first used, so the fonts of
+     * texts which are drawn from their render cache are never loaded.
+     *
      * @param aFontFileName is the (platform-specific) fully qualified name of the font file
      */
     static OUTLINE_FONT* LoadFont( const wxString& aFontFileName, bool aBold, bool aItalic );
@@ -96,7 +102,11 @@ public:
                            const VECTOR2I& aPosition, const TEXT_ATTRIBUTES& aAttrs,
                            const METRICS& aFontMetrics ) const;
 
-    const FT_Face& GetFace() const { return m_face; }
+    /**
+     * @return the FreeType face of the font, loading it first if it hasn't been yet, or nullptr
+     *         if the font file couldn't be read.
+     */
+    const FT_Face& GetFace() const;
 
 #if 0
     void RenderToOpenGLCanvas( KIGFX::OPENGL_FREETYPE& aTarget, const wxString& aString,
@@ -105,7 +115,11 @@ public:
 #endif
 
 protected:
-    FT_Error loadFace( const wxString& aFontFileName, int aFaceIndex );
+    /**
+     * Load the face of the font file, if that wasn't tried yet.  The FreeType mutex must be
+     * held.
+     */
+    FT_Error loadFace() const;
 
     BOX2I getBoundingBox( const std::vector<std::unique_ptr<GLYPH>>& aGlyphs ) const;
 
@@ -122,6 +136,17 @@ private:
                                       bool aMirror, const VECTOR2I& aOrigin,
                                       TEXT_STYLE_FLAGS aTextStyle ) const;
 
+    /**
+     * Build a glyph of the current face as placed at the origin of its text, decomposing its
+     * outline into \a aGlyphData first if that wasn't done yet.  The face mutex must be held.
+     *
+     * @param aAdvance is the advance of the glyph, used to draw a box for missing glyphs.
+     */
+    std::shared_ptr<const OUTLINE_GLYPH>
+    buildGlyphShape( GLYPH_DATA& aGlyphData, unsigned int aCodepoint, double aAdvance,
+                     double aScaler, const VECTOR2D& aScaleFactor, const EDA_ANGLE& aAngle,
+                     bool aMirror, TEXT_STYLE_FLAGS aTextStyle ) const;
+
 private:
     // FreeType variables
 
@@ -130,7 +155,9 @@ private:
      */
     static std::mutex m_freeTypeMutex;
     static FT_Library m_freeType;
-    FT_Face           m_face;
+    mutable FT_Face   m_face;
+    mutable bool      m_faceLoaded;     // Loading the face was tried
+    int               m_faceIndex;
 
     const int         m_faceSize;
     bool              m_fakeBold;
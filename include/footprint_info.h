@@ -35,6 +35,7 @@
 #include <ki_exception.h>
 #include <core/sync_queue.h>
 #include <lib_tree_item.h>
+#include <math/box2.h>
 #include <atomic>
 #include <functional>
 #include <memory>
@@ -111,6 +112,15 @@ public:
         return m_num;
     }
 
+    /**
+     * @return the bounding box of the footprint, not including its texts.
+     */
+    const BOX2I& GetBoundingBox()
+    {
+        ensure_loaded();
+        return m_bbox;
+    }
+
     /**
      * Test if the #FOOTPRINT_INFO object was loaded from \a aLibrary.
      *
@@ -147,6 +157,7 @@ protected:
     unsigned        m_unique_pad_count; ///< Number of unique pads
     wxString        m_doc;              ///< Footprint description.
     wxString        m_keywords;         ///< Footprint keywords.
+    BOX2I           m_bbox;             ///< Bounding box, not including texts.
 };
 
 
@@ -26,6 +26,10 @@
 #ifndef FP_LIB_TABLE_H_
 #define FP_LIB_TABLE_H_
 
+#include <chrono>
+#include <map>
+#include <vector>
+
 #include <lib_table_base.h>
 #include <pcb_io/pcb_io.h>
 #include <pcb_io/pcb_io_mgr.h>
@@ -153,6 +157,19 @@ public:
      */
     long long GenerateTimestamp( const wxString* aNickname );
 
+    /**
+     * Generate the hashed timestamps of the enabled libraries \a aNicknames all at once,
+     * stat'ing the libraries on the thread pool.
+     *
+     * Timestamps are reused for ADVANCED_CFG::m_LibraryTimestampCacheMs, so the lookups made
+     * while the editors open only stat each library once.  Changes made through this table
+     * discard the timestamp of the library they change.
+     *
+     * @return the timestamp of each library, by nickname.  Libraries which can't be found or
+     *         stat'ed are left out.
+     */
+    std::map<wxString, long long> GenerateTimestamps( const std::vector<wxString>& aNicknames );
+
     /**
      * If possible, prefetches the specified library (e.g. performing downloads). Does not parse.
      * Threadsafe.
@@ -290,6 +307,20 @@ public:
     static const wxString GlobalPathEnvVariableName();
 
 private:
+    /// Forget the cached timestamp of \a aNickname, whose library is being changed.
+    void invalidateTimestamp( const wxString& aNickname );
+
+    /// A generated library timestamp, and the library path and time it was generated for.
+    struct CACHED_TIMESTAMP
+    {
+        wxString                              m_uri;
+        long long                             m_timestamp;
+        std::chrono::steady_clock::time_point m_time;
+    };
+
+    std::mutex                              m_timestampsMutex;
+    std::map<wxString, CACHED_TIMESTAMP>    m_timestamps;     ///< by library nickname
+
     friend class FP_LIB_TABLE_GRID;
 };
 
@@ -205,9 +205,18 @@ public:
     /// @copydoc GAL::EndGroup()
     void EndGroup() override;
 
+    /// @copydoc GAL::IsGrouping()
+    bool IsGrouping() const override { return m_isGrouping; }
+
     /// @copydoc GAL::DrawGroup()
     void DrawGroup( int aGroupNumber ) override;
 
+    /// @copydoc GAL::BeginGroupBatch()
+    void BeginGroupBatch() override;
+
+    /// @copydoc GAL::EndGroupBatch()
+    void EndGroupBatch() override;
+
     /// @copydoc GAL::ChangeGroupColor()
     void ChangeGroupColor( int aGroupNumber, const COLOR4D& aNewColor ) override;
 
@@ -347,12 +356,33 @@ protected:
 
     typedef std::deque<GROUP_ELEMENT> GROUP;        ///< A graphic group type definition
 
+    /// The drawing state changed by the commands of the groups
+    struct GROUP_STATE
+    {
+        bool    m_IsFillEnabled;
+        bool    m_IsStrokeEnabled;
+        COLOR4D m_FillColor;
+        COLOR4D m_StrokeColor;
+    };
+
+    /// Execute the commands of a group, and of the groups it calls, on \a aContext.
+    void drawGroup( cairo_t* aContext, int aGroupNumber, GROUP_STATE& aState ) const;
+
+    /**
+     * Draw the batched groups in horizontal bands of the current target, one per thread.
+     *
+     * @return false if the batch is too small or the target can't be split in bands.
+     */
+    bool drawGroupBatchTiled();
+
     // Variables for the grouping function
     bool                  m_isGrouping;             ///< Is grouping enabled ?
     bool                  m_isElementAdded;         ///< Was an graphic element added ?
     std::map<int, GROUP>  m_groups;                 ///< List of graphic groups
     unsigned int          m_groupCounter;           ///< Counter used for generating group keys
     GROUP*                m_currentGroup;           ///< Currently used group
+    bool                  m_isBatchingGroups;       ///< Are the drawn groups batched ?
+    std::vector<int>      m_groupBatch;             ///< Groups to draw at the end of the batch
 
     double                m_lineWidthInPixels;
     bool                  m_lineWidthIsOdd;
@@ -47,6 +47,21 @@ class BITMAP_BASE;
 
 namespace KIGFX
 {
+/**
+ * Rendering statistics of a GAL, shown by the render statistics overlay of the draw panels.
+ */
+struct GAL_STATISTICS
+{
+    double       m_flushTime = 0.0;         ///< Drawing the vertex containers in the last frame
+    double       m_compositeTime = 0.0;     ///< Compositing the targets in the last frame
+    double       m_swapTime = 0.0;          ///< Swapping the buffers in the last frame
+    unsigned int m_cachedVertices = 0;      ///< Vertices stored in the cache
+    unsigned int m_cachedCapacity = 0;      ///< Vertices the cache can store without growing
+    unsigned int m_defragmentations = 0;    ///< Defragmentations of the cache so far
+    unsigned int m_nonCachedVertices = 0;   ///< Vertices drawn without caching
+};
+
+
 /**
  * Abstract interface for drawing on a 2D-surface.
  *
@@ -477,6 +492,12 @@ public:
     /// End the group.
     virtual void EndGroup() {};
 
+    /**
+     * @return true between BeginGroup() and EndGroup().  A group is drawn at any zoom level,
+     *         so what is drawn into it must not depend on the current one.
+     */
+    virtual bool IsGrouping() const { return false; }
+
     /**
      * Draw the stored group.
      *
@@ -484,6 +505,15 @@ public:
      */
     virtual void DrawGroup( int aGroupNumber ) {};
 
+    /**
+     * Begin a batch of DrawGroup() calls, which the GAL may defer until EndGroupBatch() to
+     * draw them all at once.  Nothing but groups may be drawn until the batch is ended.
+     */
+    virtual void BeginGroupBatch() {};
+
+    /// Draw the groups of the current batch.
+    virtual void EndGroupBatch() {};
+
     /**
      * Change the color used to draw the group.
      *
@@ -512,6 +542,18 @@ public:
      */
     virtual void ClearCache() {};
 
+    /**
+     * Return the number of vertices stored for a group, or 0 if the GAL doesn't store vertices.
+     *
+     * @param aGroupNumber is the group number.
+     */
+    virtual unsigned int GetGroupVertexCount( int aGroupNumber ) const { return 0; }
+
+    /**
+     * Return the rendering statistics of the GAL (times are in milliseconds).
+     */
+    virtual GAL_STATISTICS GetStatistics() const { return GAL_STATISTICS(); }
+
     // --------------------------------------------------------
     // Handling the world <-> screen transformation
     // --------------------------------------------------------
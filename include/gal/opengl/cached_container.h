@@ -28,7 +28,9 @@
 #define CACHED_CONTAINER_H_
 
 #include <gal/opengl/vertex_container.h>
+#include <memory_accounting.h>
 #include <map>
+#include <memory>
 #include <set>
 
 namespace KIGFX
@@ -96,10 +98,15 @@ public:
 
     virtual unsigned int AllItemsSize() const { return 0; }
 
+    /**
+     * Return the number of times the container was defragmented to make room for an item.
+     */
+    unsigned int GetDefragmentCount() const { return m_defragmentCount; }
+
 protected:
-    ///< Maps size of free memory chunks to their offsets
+    ///< Size & offset of a free memory chunk, free chunks are ordered by size
     typedef std::pair<unsigned int, unsigned int> CHUNK;
-    typedef std::multimap<unsigned int, unsigned int> FREE_CHUNK_MAP;
+    typedef std::set<CHUNK> FREE_CHUNK_MAP;
 
     /// List of all the stored items
     typedef std::set<VERTEX_ITEM*> ITEMS;
@@ -133,12 +140,6 @@ protected:
      */
     void defragment( VERTEX* aTarget );
 
-    /**
-     * Look for consecutive free memory chunks and merges them, decreasing fragmentation of
-     * memory.
-     */
-    void mergeFreeChunks();
-
     /**
      * Return the size of a chunk.
      *
@@ -160,13 +161,27 @@ protected:
     }
 
     /**
-     * Add a chunk marked as a free space.
+     * Add a chunk marked as a free space, merged with the free chunks right before and after it.
      */
     void addFreeChunk( unsigned int aOffset, unsigned int aSize );
 
+    /**
+     * Take a chunk out of the free space, e.g. for storing an item.
+     */
+    void removeFreeChunk( FREE_CHUNK_MAP::iterator aChunk );
+
+    /**
+     * Make the chunk at \a aOffset the only free one, e.g. after a defragmentation.  This does
+     * not change m_freeSpace.
+     */
+    void resetFreeChunks( unsigned int aOffset, unsigned int aSize );
+
     ///< Store size & offset of free chunks.
     FREE_CHUNK_MAP  m_freeChunks;
 
+    ///< Size of the free chunks by their offset, to find the neighbours of a freed chunk
+    std::map<unsigned int, unsigned int> m_freeChunkOffsets;
+
     ///< Stored VERTEX_ITEMs
     ITEMS m_items;
 
@@ -180,6 +195,11 @@ protected:
     ///< Maximal vertex index number stored in the container
     unsigned int m_maxIndex;
 
+    ///< Number of defragmentations done by reallocate()
+    unsigned int m_defragmentCount = 0;
+
+    std::unique_ptr<MEMORY_ACCOUNT> m_memoryAccount;
+
 private:
     /// Debug & test functions
     void showFreeChunks();
@@ -94,6 +94,9 @@ protected:
     ///< Location of shader attributes (for glVertexAttribPointer)
     int m_shaderAttrib;
 
+    ///< Location of the group color slot attribute, -1 if the shader doesn't use it
+    int m_colorSlotAttrib;
+
     ///< true: enable Z test when drawing
     bool m_enableDepthTest;
 };
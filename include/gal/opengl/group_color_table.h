@@ -0,0 +1,104 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GROUP_COLOR_TABLE_H
+#define GROUP_COLOR_TABLE_H
+
+#include <vector>
+
+#include <gal/color4d.h>
+
+namespace KIGFX
+{
+
+/**
+ * A table of the colors which override the vertex colors of cached groups, read by the
+ * shaders of OPENGL_GAL from a texture.
+ *
+ * Each cached group gets a slot of the table, which its vertices refer to.  Changing the color
+ * of a group then only changes one texel instead of all its vertices, so highlighting a net or
+ * selecting items doesn't have to rewrite and upload their geometry again.  Slot 0 is never
+ * allocated and is used for the vertices which don't belong to a slot; an empty texel means
+ * that the vertex colors are used.
+ */
+class GROUP_COLOR_TABLE
+{
+public:
+    ///< Number of slots in a row of the table
+    static constexpr int WIDTH = 1024;
+
+    ///< Maximum number of rows of the table
+    static constexpr int MAX_HEIGHT = 2048;
+
+    GROUP_COLOR_TABLE();
+
+    /**
+     * Return a slot with no color set.
+     *
+     * @return 0 if the table is full.
+     */
+    unsigned int Allocate();
+
+    ///< Clear the color of \a aSlot and make it available again.
+    void Free( unsigned int aSlot );
+
+    ///< Set the color drawn instead of the vertex colors of the group of \a aSlot.
+    void SetColor( unsigned int aSlot, const COLOR4D& aColor );
+
+    ///< Free all the slots.
+    void Clear();
+
+    ///< Number of rows of the table, which grows as slots are allocated
+    int GetHeight() const { return m_height; }
+
+    ///< Texels of the table, four RGBA bytes each and row by row
+    const std::vector<unsigned char>& GetPixels() const { return m_pixels; }
+
+    /**
+     * Get the range of rows modified since the last call to ClearDirtyRows().
+     *
+     * @return false if no row was modified.
+     */
+    bool GetDirtyRows( int& aFirst, int& aLast ) const;
+
+    void ClearDirtyRows();
+
+    ///< Mark every row as modified, for instance after the texture was recreated.
+    void MarkAllDirty();
+
+private:
+    void setTexel( unsigned int aSlot, unsigned char aR, unsigned char aG, unsigned char aB,
+                   unsigned char aA );
+
+    std::vector<unsigned char> m_pixels;
+    std::vector<unsigned int>  m_freeSlots;
+
+    unsigned int m_nextSlot;
+    int          m_height;
+    int          m_dirtyFirst;
+    int          m_dirtyLast;
+};
+
+} // namespace KIGFX
+
+#endif /* GROUP_COLOR_TABLE_H */
@@ -39,6 +39,7 @@
 #include <gal/opengl/cached_container.h>
 #include <gal/opengl/noncached_container.h>
 #include <gal/opengl/opengl_compositor.h>
+#include <gal/opengl/group_color_table.h>
 #include <gal/hidpi_gl_canvas.h>
 
 #include <unordered_map>
@@ -229,6 +230,9 @@ public:
     /// @copydoc GAL::EndGroup()
     void EndGroup() override;
 
+    /// @copydoc GAL::IsGrouping()
+    bool IsGrouping() const override { return m_isGrouping; }
+
     /// @copydoc GAL::DrawGroup()
     void DrawGroup( int aGroupNumber ) override;
 
@@ -244,6 +248,12 @@ public:
     /// @copydoc GAL::ClearCache()
     void ClearCache() override;
 
+    /// @copydoc GAL::GetGroupVertexCount()
+    unsigned int GetGroupVertexCount( int aGroupNumber ) const override;
+
+    /// @copydoc GAL::GetStatistics()
+    GAL_STATISTICS GetStatistics() const override;
+
     // --------------------------------------------------------
     // Handling the world <-> screen transformation
     // --------------------------------------------------------
@@ -338,12 +348,14 @@ private:
     wxEvtHandler*           m_paintListener;
 
     static GLuint           g_fontTexture;      ///< Bitmap font texture handle (shared)
+    static GLuint           g_strokeGlyphTexture; ///< Stroke glyph atlas texture handle (shared)
 
     // Vertex buffer objects related fields
     typedef std::unordered_map< unsigned int, std::shared_ptr<VERTEX_ITEM> > GROUPS_MAP;
 
     GROUPS_MAP              m_groups;           ///< Stores information about VBO objects (groups)
     unsigned int            m_groupCounter;     ///< Counter used for generating keys for groups
+    GAL_STATISTICS          m_statistics;       ///< Timings of the last frame
     VERTEX_MANAGER*         m_currentManager;   ///< Currently used VERTEX_MANAGER (for storing
                                                 ///< VERTEX_ITEMs).
     VERTEX_MANAGER*         m_cachedManager;    ///< Container for storing cached VERTEX_ITEMs
@@ -351,6 +363,11 @@ private:
     VERTEX_MANAGER*         m_overlayManager;   ///< Container for storing overlaid VERTEX_ITEMs
     VERTEX_MANAGER*         m_tempManager;      ///< Container for storing temp (diff mode) VERTEX_ITEMs
 
+    GROUP_COLOR_TABLE       m_groupColors;      ///< Colors of the cached groups
+    bool                    m_useGroupColors;   ///< Are group colors read by the shader?
+    GLuint                  m_groupColorTexture;       ///< Group color table texture handle
+    int                     m_groupColorTextureHeight; ///< Rows of the group color texture
+
     // Framebuffer & compositing
     OPENGL_COMPOSITOR*      m_compositor;       ///< Handles multiple rendering targets
     unsigned int            m_mainBuffer;       ///< Main rendering target
@@ -375,6 +392,7 @@ private:
     GLint                   ufm_screenPixelSize;
     GLint                   ufm_pixelSizeMultiplier;
     GLint                   ufm_antialiasingOffset;
+    GLint                   ufm_groupColorTextureSize;
 
     wxCursor                m_currentwxCursor;          ///< wxCursor showing the current native cursor
 
@@ -411,6 +429,19 @@ private:
      */
     void reserveLineQuads( const int aLineCount );
 
+    /**
+     * Draw stroke font glyphs as textured quads from the stroke glyph atlas.
+     *
+     * @return false, without drawing anything, if any of the glyphs can't be drawn that way.
+     */
+    bool drawGlyphsFromAtlas( const std::vector<std::unique_ptr<KIFONT::GLYPH>>& aGlyphs );
+
+    ///< Upload the modified part of the stroke glyph atlas to its texture.
+    void updateStrokeGlyphTexture();
+
+    ///< Upload the modified part of the group color table to its texture.
+    void updateGroupColorTexture();
+
     /**
      * Draw a semicircle.
      *
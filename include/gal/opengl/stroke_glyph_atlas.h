@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef STROKE_GLYPH_ATLAS_H
+#define STROKE_GLYPH_ATLAS_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <math/vector2d.h>
+
+namespace KIFONT
+{
+class STROKE_GLYPH;
+}
+
+namespace KIGFX
+{
+
+/**
+ * An atlas of the distance fields of stroke font glyphs, from which OPENGL_GAL draws stroke
+ * text as one textured quad per glyph instead of one line quad per stroke segment.
+ *
+ * Each texel of the cell of a glyph holds the distance from its center to the nearest stroke
+ * of the glyph, so the same cell serves every pen width up to MAX_DISTANCE.  Cells are filled
+ * when a glyph is first drawn and are never moved, as cached vertex groups refer to them.
+ */
+class STROKE_GLYPH_ATLAS
+{
+public:
+    ///< Width and height of the atlas, in texels
+    static constexpr int ATLAS_SIZE = 2048;
+
+    ///< Width and height of the cell of a glyph, in texels
+    static constexpr int CELL_SIZE = 64;
+
+    ///< Width and height of the cell of a glyph, in font units (the cap height is about 1)
+    static constexpr double CELL_EXTENT = 2.0;
+
+    ///< Distance from the strokes at which the distance field saturates, in font units
+    static constexpr double MAX_DISTANCE = 0.2;
+
+    struct CELL
+    {
+        VECTOR2D m_origin;   ///< Lower corner of the cell, in font glyph coordinates
+        VECTOR2D m_texture;  ///< Lower corner of the cell, in texture coordinates
+        VECTOR2D m_quadMin;  ///< Lower corner of the area to draw, in font glyph coordinates
+        VECTOR2D m_quadMax;  ///< Upper corner of the area to draw, in font glyph coordinates
+
+        ///< @return the texture coordinates of \a aPoint, in font glyph coordinates
+        VECTOR2D TextureCoords( const VECTOR2D& aPoint ) const
+        {
+            return m_texture + ( aPoint - m_origin ) * ( CELL_SIZE / CELL_EXTENT / ATLAS_SIZE );
+        }
+    };
+
+    STROKE_GLYPH_ATLAS();
+
+    /**
+     * Return the cell of \a aFontGlyph, computing its distance field the first time.
+     *
+     * @return nullptr if the glyph is too large for a cell or the atlas is full.
+     */
+    const CELL* GetCell( const KIFONT::STROKE_GLYPH* aFontGlyph );
+
+    ///< Texels of the atlas, one byte each and row by row (empty until the first cell is made)
+    const std::vector<unsigned char>& GetPixels() const { return m_pixels; }
+
+    /**
+     * Get the range of texel rows modified since the last call to ClearDirtyRows().
+     *
+     * @return false if no row was modified.
+     */
+    bool GetDirtyRows( int& aFirst, int& aLast ) const;
+
+    void ClearDirtyRows();
+
+    ///< Mark every row as modified, for instance after the texture was recreated.
+    void MarkAllDirty();
+
+private:
+    void fillCell( const KIFONT::STROKE_GLYPH& aGlyph, const VECTOR2D& aOrigin, int aCellX,
+                   int aCellY );
+
+    std::vector<unsigned char> m_pixels;
+
+    ///< Cells by font glyph; nullptr marks glyphs which don't fit in a cell
+    std::unordered_map<const KIFONT::STROKE_GLYPH*, std::unique_ptr<CELL>> m_cells;
+
+    int m_cellCount;
+    int m_dirtyFirst;
+    int m_dirtyLast;
+};
+
+} // namespace KIGFX
+
+#endif /* STROKE_GLYPH_ATLAS_H */
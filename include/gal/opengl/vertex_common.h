@@ -53,15 +53,17 @@ enum SHADER_MODE
     SHADER_LINE_C = 7,
     SHADER_LINE_D = 8,
     SHADER_LINE_E = 9,
-    SHADER_LINE_F = 10
+    SHADER_LINE_F = 10,
+    SHADER_STROKE_GLYPH = 11
 };
 
-///< Data structure for vertices {X,Y,Z,R,G,B,A,shader&param}
+///< Data structure for vertices {X,Y,Z,R,G,B,A,shader&param,color slot}
 struct VERTEX
 {
     GLfloat x, y, z;        // Coordinates
     GLubyte r, g, b, a;     // Color
     GLfloat shader[4];      // Shader type & params
+    GLfloat colorSlot;      // Slot of the group in the GROUP_COLOR_TABLE, 0 for none
 };
 
 static constexpr size_t VERTEX_SIZE   = sizeof(VERTEX);
@@ -80,6 +82,8 @@ static constexpr size_t SHADER_OFFSET = offsetof(VERTEX, shader);
 static constexpr size_t SHADER_SIZE   = sizeof(VERTEX::shader);
 static constexpr size_t SHADER_STRIDE = SHADER_SIZE / sizeof(GLfloat);
 
+static constexpr size_t COLOR_SLOT_OFFSET = offsetof(VERTEX, colorSlot);
+
 static constexpr size_t INDEX_SIZE    = sizeof(GLuint);
 
 } // namespace KIGFX
@@ -127,6 +127,14 @@ public:
         return m_currentSize;
     }
 
+    /**
+     * Return amount of vertices actually used in the container.
+     */
+    unsigned int GetUsedSize() const
+    {
+        return usedSpace();
+    }
+
     /**
      * Return information about the container cache state.
      *
@@ -75,6 +75,21 @@ public:
      */
     VERTEX* GetVertices() const;
 
+    /**
+     * Return the slot of the item in the group color table.
+     *
+     * @return 0 if the item has no slot.
+     */
+    inline unsigned int GetColorSlot() const
+    {
+        return m_colorSlot;
+    }
+
+    inline void SetColorSlot( unsigned int aSlot )
+    {
+        m_colorSlot = aSlot;
+    }
+
 private:
     /**
      * Set data offset in the container.
@@ -99,6 +114,7 @@ private:
     const VERTEX_MANAGER&   m_manager;
     unsigned int            m_offset;
     unsigned int            m_size;
+    unsigned int            m_colorSlot;
 };
 } // namespace KIGFX
 
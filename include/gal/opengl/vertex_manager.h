@@ -185,6 +185,16 @@ public:
         m_shader[3] = aParam3;
     }
 
+    /**
+     * Set the slot of the GROUP_COLOR_TABLE stored in newly added vertices.
+     *
+     * @param aSlot is the slot of the group being drawn, or 0 for none.
+     */
+    inline void ColorSlot( unsigned int aSlot )
+    {
+        m_colorSlot = aSlot;
+    }
+
     /**
      * Multiply the current matrix by a translation matrix, so newly vertices will be
      * translated by the given vector.
@@ -347,6 +357,14 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Return the container storing the vertices.
+     */
+    const VERTEX_CONTAINER& GetContainer() const
+    {
+        return *m_container;
+    }
+
 protected:
     /**
      * Apply all transformation to the given coordinates and store them at the specified target.
@@ -375,6 +393,8 @@ protected:
     GLubyte                 m_color[COLOR_STRIDE];
     /// Currently used shader and its parameters
     GLfloat                 m_shader[SHADER_STRIDE];
+    /// Currently used slot of the group color table
+    GLfloat                 m_colorSlot;
 
     /// Currently reserved chunk to store vertices
     VERTEX*                 m_reserved;
@@ -96,6 +96,27 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Compute and cache the parts of drawing an instance of VIEW_ITEM which don't need the GAL,
+     * such as polygon triangulations, so that Draw() is mostly left with sending them to it.
+     *
+     * This is called from several threads at once, for different items, before a large number
+     * of them are redrawn.  It must not draw anything nor change the painter itself.
+     *
+     * @param aItem is the item which is going to be drawn.
+     */
+    virtual void PrepareItem( const VIEW_ITEM* aItem ) {}
+
+    /**
+     * Draw a simplified version of an item, used instead of the one drawn by Draw() while the
+     * view is zoomed out below VIEW_ITEM::ViewGetProxyScale().
+     *
+     * @param aItem is the item to be drawn.
+     * @param aLayer is the layer that should be drawn.
+     * @return true if the item has a proxy on \a aLayer and it was drawn.
+     */
+    virtual bool DrawProxy( const VIEW_ITEM* aItem, int aLayer ) { return false; }
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
@@ -56,11 +56,21 @@ public:
      */
     bool SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts );
 
+    /**
+     * Download the parts of several categories at once, one request per thread, for the next
+     * calls to SelectAll() with these categories.
+     * @param aCategories are the categories which will be selected
+     */
+    void PrefetchCategories( const std::vector<HTTP_LIB_CATEGORY>& aCategories );
+
     std::string GetLastError() const { return m_lastError; }
 
     std::vector<HTTP_LIB_CATEGORY> getCategories() const { return m_categories; }
 
-    auto getCachedParts() { return m_cache; }
+    const std::map<std::string, std::tuple<std::string, std::string>>& getCachedParts() const
+    {
+        return m_cache;
+    }
 
 private:
 
@@ -80,6 +90,13 @@ private:
 
     bool ValidateHTTPLibraryEndpoints();
 
+    /**
+     * Download the parts of \a aCategory.  Can be called from several threads at once.
+     * @return the response of the server.
+     * @throw std::exception if the request failed.
+     */
+    std::string fetchCategory( const HTTP_LIB_CATEGORY& aCategory );
+
     bool syncCategories();
 
     bool checkServerResponse( std::unique_ptr<KICAD_CURL_EASY>& aCurl );
@@ -104,6 +121,15 @@ private:
 
     std::map<std::string, std::string> m_parts;
 
+    struct PREFETCHED_CATEGORY
+    {
+        std::string m_response;
+        std::string m_error;    ///< The reason the request failed, if it did
+    };
+
+    //          category.id  response
+    std::map<std::string, PREFETCHED_CATEGORY> m_prefetchedCategories;
+
     const std::string http_endpoint_categories = "categories";
     const std::string http_endpoint_parts = "parts";
     const std::string http_endpoint_settings = "settings";
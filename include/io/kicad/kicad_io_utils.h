@@ -43,6 +43,13 @@ KICOMMON_API void FormatUuid( OUTPUTFORMATTER* aOut, const KIID& aUuid, char aSu
 
 KICOMMON_API void Prettify( std::string& aSource, char aQuoteChar = '"' );
 
+/**
+ * Prettify \a aSource like Prettify(), with parts of about \a aPartSize bytes of the lists at
+ * the top level of \a aSource formatted in parallel.  Smaller inputs are prettified serially.
+ */
+KICOMMON_API void PrettifyInParallel( std::string& aSource, char aQuoteChar = '"',
+                                      size_t aPartSize = 1 << 20 );
+
 } // namespace KICAD_FORMAT
 
 #endif //KICAD_IO_UTILS_H
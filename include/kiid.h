@@ -134,6 +134,17 @@ extern KICOMMON_API KIID niluuid;
 
 KICOMMON_API KIID& NilUuid();
 
+#ifndef SWIG
+namespace std
+{
+    template <>
+    struct hash<KIID>
+    {
+        size_t operator()( const KIID& aId ) const { return aId.Hash(); }
+    };
+}
+#endif
+
 // declare KIID_VECT_LIST as std::vector<KIID> both for c++ and swig:
 DECL_VEC_FOR_SWIG( KIID_VECT_LIST, KIID )
 
@@ -207,6 +218,25 @@ public:
     }
 };
 
+#ifndef SWIG
+namespace std
+{
+    template <>
+    struct hash<KIID_PATH>
+    {
+        size_t operator()( const KIID_PATH& aPath ) const
+        {
+            size_t seed = aPath.size();
+
+            for( const KIID& id : aPath )
+                seed ^= id.Hash() + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+
+            return seed;
+        }
+    };
+}
+#endif
+
 /**
  * RAII class to safely set/reset nil KIIDs for use in footprint/symbol loading
  */
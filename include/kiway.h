@@ -96,6 +96,8 @@
 
 
 #include <atomic>
+#include <future>
+#include <vector>
 #include <wx/defs.h>
 #include <wx/event.h>
 #include <import_export.h>
@@ -424,6 +426,14 @@ public:
 
     void OnKiwayEnd();
 
+    /**
+     * Load the DSOs of the KIFACEs \a aFaceIds one after the other on a worker thread, so that
+     * KiFACE() finds them already mapped and relocated when they are first needed.
+     *
+     * Only the DSOs are loaded; KiFACE() still starts the KIFACEs on the main thread.
+     */
+    void PreloadKiFACEs( const std::vector<FACE_T>& aFaceIds );
+
     bool ProcessEvent( wxEvent& aEvent ) override;
 
     int ProcessJob( KIWAY::FACE_T aFace, JOB* job );
@@ -473,6 +483,8 @@ private:
     // Call: wxWindow::FindWindowById( m_playerFrameId[aFrameType] )
     // to know if still exists (or GetPlayerFrame( FRAME_T aFrameType )
     std::atomic<wxWindowID> m_playerFrameId[KIWAY_PLAYER_COUNT];
+
+    std::future<void>       m_preload;      // The worker of PreloadKiFACEs()
 };
 
 
@@ -142,6 +142,7 @@ public:
     int         m_PinCount;    // Pin count from symbol, or unique pad count from footprint
 
     std::vector<SEARCH_TERM>     m_SearchTerms;    /// List of weighted search terms
+    SEARCH_TRIGRAMS              m_SearchTrigrams; /// Trigram signature of m_SearchTerms
     std::map<wxString, wxString> m_Fields;         /// @see LIB_TREE_ITEMS::GetChooserFields
 
     LIB_ID      m_LibId;       // LIB_ID determined by the parent library nickname and alias name.
@@ -55,6 +55,9 @@
 #define TR_OP_METHOD_CALL 25
 #define TR_UOP_PUSH_VAR 1
 #define TR_UOP_PUSH_VALUE 2
+#define TR_UOP_JUMP_IF_FALSE 3
+#define TR_UOP_JUMP_IF_TRUE 4
+#define TR_UOP_COMPARE_VAR 5
 
 // This namespace is used for the lemon parser
 namespace LIBEVAL
@@ -136,6 +139,7 @@ public:
     int        op;
     TREE_NODE* leaf[2];
     UOP*       uop;
+    UOP*       jump;        // short-circuit of a boolean operator, once its left side is emitted
     bool       valid;
     bool       isTerminal;
     bool       isVisited;
@@ -241,6 +245,8 @@ public:
 
     VAR_TYPE_T GetType() const { return m_type; };
 
+    bool StringIsWildcard() const { return m_stringIsWildcard; }
+
     void Set( double aValue )
     {
         m_type = VT_NUMERIC;
@@ -297,6 +303,17 @@ public:
 
     virtual VAR_TYPE_T GetType() const = 0;
     virtual VALUE* GetValue( CONTEXT* aCtx ) = 0;
+
+    /**
+     * References which can return their string without building a VALUE get comparisons with
+     * string constants compiled to a single operation.
+     */
+    virtual bool HasStringRef() const { return false; }
+
+    /**
+     * @return the referenced string, or nullptr if the value is undefined.
+     */
+    virtual const wxString* GetStringRef( CONTEXT* aCtx ) { return nullptr; }
 };
 
 
@@ -374,10 +391,14 @@ class UCODE
 public:
     virtual ~UCODE();
 
-    void AddOp( UOP* uop )
-    {
-        m_ucode.push_back(uop);
-    }
+    /**
+     * Append an operation, folding it into the previous ones where possible: operators on
+     * numeric constants are replaced by their result, and comparisons of a reference with a
+     * string constant by a single TR_UOP_COMPARE_VAR.
+     */
+    void AddOp( UOP* uop );
+
+    size_t GetOpCount() const { return m_ucode.size(); }
 
     VALUE* Run( CONTEXT* ctx );
     wxString Dump() const;
@@ -401,23 +422,37 @@ protected:
 class UOP
 {
 public:
+    UOP( int op ) :
+        m_op( op ),
+        m_ref(nullptr),
+        m_value(nullptr),
+        m_compareOp( 0 ),
+        m_target( 0 )
+    {};
+
     UOP( int op, std::unique_ptr<VALUE> value ) :
         m_op( op ),
         m_ref(nullptr),
-        m_value( std::move( value ) )
+        m_value( std::move( value ) ),
+        m_compareOp( 0 ),
+        m_target( 0 )
     {};
 
     UOP( int op, std::unique_ptr<VAR_REF> vref ) :
         m_op( op ),
         m_ref( std::move( vref ) ),
-        m_value(nullptr)
+        m_value(nullptr),
+        m_compareOp( 0 ),
+        m_target( 0 )
     {};
 
     UOP( int op, FUNC_CALL_REF func, std::unique_ptr<VAR_REF> vref = nullptr ) :
         m_op( op ),
         m_func( std::move( func ) ),
         m_ref( std::move( vref ) ),
-        m_value(nullptr)
+        m_value(nullptr),
+        m_compareOp( 0 ),
+        m_target( 0 )
     {};
 
     ~UOP()
@@ -426,14 +461,26 @@ public:
 
     void Exec( CONTEXT* ctx );
 
+    /**
+     * For jumps: whether the value on the top of the stack already decides the result of the
+     * boolean operator, in which case it is replaced by that result.
+     */
+    bool ShortCircuits( CONTEXT* ctx );
+
+    void SetTarget( size_t aTarget ) { m_target = aTarget; }
+
     wxString Format() const;
 
 private:
+    friend class UCODE;
+
     int                      m_op;
 
     FUNC_CALL_REF            m_func;
     std::unique_ptr<VAR_REF> m_ref;
     std::unique_ptr<VALUE>   m_value;
+    int                      m_compareOp;  // TR_OP_EQUAL or TR_OP_NOT_EQUAL, for compare ops
+    size_t                   m_target;     // for jumps, the index of the next op if taken
 };
 
 class TOKENIZER
@@ -0,0 +1,114 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <kicommon.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+#include <wx/string.h>
+
+/**
+ * The large caches whose memory is accounted for.
+ */
+enum class MEMORY_CATEGORY
+{
+    ZONE_FILLS,         ///< Filled areas of the zones
+    TRIANGULATION,      ///< Triangulation caches of the polygons
+    MODELS_3D,          ///< 3D models held by the 3D model caches
+    UNDO_HISTORY,       ///< Copies of the items held by the undo and redo lists
+    VERTEX_BUFFERS,     ///< Cached vertex buffers of the OpenGL canvases
+    FOOTPRINT_CACHE,    ///< Footprints read from the footprint libraries
+    TEXT_CACHE,         ///< Rendered glyphs cached by the texts
+    COUNT
+};
+
+
+/**
+ * The approximate amount of memory held by each #MEMORY_CATEGORY.
+ */
+class KICOMMON_API MEMORY_REPORT
+{
+public:
+    MEMORY_REPORT();
+
+    void Add( MEMORY_CATEGORY aCategory, size_t aBytes )
+    {
+        m_bytes[static_cast<size_t>( aCategory )] += aBytes;
+    }
+
+    size_t Get( MEMORY_CATEGORY aCategory ) const
+    {
+        return m_bytes[static_cast<size_t>( aCategory )];
+    }
+
+    size_t GetTotal() const;
+
+    static wxString GetCategoryName( MEMORY_CATEGORY aCategory );
+
+    /**
+     * @return the report as one "name: size" line per category.
+     */
+    wxString Format() const;
+
+private:
+    std::array<size_t, static_cast<size_t>( MEMORY_CATEGORY::COUNT )> m_bytes;
+};
+
+
+/**
+ * Register an object holding some of the accounted memory for as long as the MEMORY_ACCOUNT
+ * exists.
+ *
+ * The callback is only run by Collect(), typically from the main thread when the user asks for
+ * a report, so the accounting costs nothing the rest of the time.  It must add an estimate of
+ * the memory held by the object to the report, and must not create or destroy accounts.
+ *
+ * Owners usually hold the account as their last member, so that it is removed before the rest
+ * of the object is destroyed.
+ */
+class KICOMMON_API MEMORY_ACCOUNT
+{
+public:
+    using COLLECTOR = std::function<void( MEMORY_REPORT& )>;
+
+    MEMORY_ACCOUNT( COLLECTOR aCollector );
+    ~MEMORY_ACCOUNT();
+
+    MEMORY_ACCOUNT( const MEMORY_ACCOUNT& ) = delete;
+    MEMORY_ACCOUNT& operator=( const MEMORY_ACCOUNT& ) = delete;
+
+    /**
+     * Run the callbacks of all the accounts.
+     */
+    static MEMORY_REPORT Collect();
+
+private:
+    COLLECTOR m_collector;
+};
+
+#endif  // MEMORY_ACCOUNTING_H
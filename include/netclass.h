@@ -59,7 +59,7 @@ public:
         return wxT( "NETCLASS" );
     }
 
-    const wxString GetName() const { return m_Name; }
+    const wxString& GetName() const { return m_Name; }
     void SetName( const wxString& aName ) { m_Name = aName; }
 
     const wxString& GetDescription() const  { return m_Description; }
@@ -101,6 +101,17 @@ public:
      */
     FOOTPRINT* LoadFootprint( const LIB_ID& aFootprintId );
 
+    /**
+     * Load a batch of footprints from the footprint library table, like LoadFootprint().
+     *
+     * The footprints of different libraries are loaded in parallel.  A footprint named twice
+     * is loaded twice, so that each copy has its own UUIDs.
+     *
+     * @return the loaded footprints, in the order of \a aFootprintIds; an entry is NULL if its
+     *         footprint was not found.
+     */
+    std::vector<FOOTPRINT*> LoadLibraryFootprints( const std::vector<LIB_ID>& aFootprintIds );
+
     /**
      * Calculate the bounding box containing all board items (or board edge segments).
      *
@@ -425,6 +436,11 @@ protected:
      */
     FOOTPRINT* loadFootprint( const LIB_ID& aFootprintId );
 
+    /**
+     * Clear the nets of a footprint loaded from a library and apply the board defaults to it.
+     */
+    void prepareLoadedFootprint( FOOTPRINT* aFootprint );
+
     virtual void unitsChangeRefresh() override;
 
     void rebuildConnectivity();
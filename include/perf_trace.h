@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PERF_TRACE_H
+#define PERF_TRACE_H
+
+#include <kicommon.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <wx/string.h>
+
+/**
+ * A trace of the time spent in the main operations of KiCad, written in the Chrome trace event
+ * format, which chrome://tracing and https://ui.perfetto.dev display.
+ *
+ * Nothing is recorded until Start() is called: a #SCOPED_TRACE_ZONE then only costs the test
+ * of a flag.  The events are kept per thread and are only gathered by Write().
+ */
+class KICOMMON_API PERF_TRACE
+{
+public:
+    static bool IsEnabled() { return s_enabled.load( std::memory_order_relaxed ); }
+
+    /**
+     * Start recording, dropping the events recorded before.
+     */
+    static void Start();
+
+    /**
+     * Stop recording and write the events to \a aFileName.
+     *
+     * @return false if the file could not be written.
+     */
+    static bool Write( const wxString& aFileName );
+
+    /**
+     * Record the value of the counter \a aName, which must be a string literal.
+     */
+    static void Counter( const char* aName, int64_t aValue );
+
+    /**
+     * Set the name of the calling thread in the trace.
+     */
+    static void SetThreadName( const wxString& aName );
+
+    /// @return the time in microseconds since the start of the program.
+    static int64_t Now();
+
+    static void AddZone( const char* aName, std::string&& aDetail, int64_t aStart, int64_t aEnd );
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+
+/**
+ * Record the time spent in a scope in the #PERF_TRACE.
+ *
+ * The name must be a string literal; the optional detail, such as the name of a file or of a DRC
+ * test, is only copied when tracing.
+ */
+class SCOPED_TRACE_ZONE
+{
+public:
+    explicit SCOPED_TRACE_ZONE( const char* aName ) :
+            m_name( aName ),
+            m_start( PERF_TRACE::IsEnabled() ? PERF_TRACE::Now() : -1 )
+    {
+    }
+
+    SCOPED_TRACE_ZONE( const char* aName, const wxString& aDetail ) :
+            SCOPED_TRACE_ZONE( aName )
+    {
+        if( m_start >= 0 )
+            m_detail = aDetail.ToStdString( wxConvUTF8 );
+    }
+
+    ~SCOPED_TRACE_ZONE()
+    {
+        if( m_start >= 0 )
+            PERF_TRACE::AddZone( m_name, std::move( m_detail ), m_start, PERF_TRACE::Now() );
+    }
+
+    SCOPED_TRACE_ZONE( const SCOPED_TRACE_ZONE& ) = delete;
+    SCOPED_TRACE_ZONE& operator=( const SCOPED_TRACE_ZONE& ) = delete;
+
+private:
+    const char* m_name;
+    int64_t     m_start;
+    std::string m_detail;
+};
+
+#endif // PERF_TRACE_H
@@ -272,6 +272,13 @@ public:
      */
     virtual wxApp&   App();
 
+    /**
+     * Start the Python interpreter, if InitPgm() deferred it and it hasn't been started yet.
+     *
+     * This is called on the first use of Python, and must be called from the main thread.
+     */
+    virtual void StartPythonScripting();
+
     static const wxChar workingDirKey[];
 
     /**
@@ -398,6 +405,7 @@ protected:
     std::unique_ptr<NOTIFICATIONS_MANAGER> m_notifications_manager;
 
     std::unique_ptr<SCRIPTING> m_python_scripting;
+    bool                       m_python_deferred;    ///< Python is started on first use
 
     /// Checks if there is another copy of Kicad running at the same time
     std::unique_ptr<wxSingleInstanceChecker> m_pgm_checker;
@@ -25,6 +25,11 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
+#include <string>
+#include <unordered_map>
+
 #include "plotter.h"
 
 
@@ -115,6 +120,18 @@ protected:
                                 double                   *ctm_f,
                                 double                   *heightFactor );
 
+    /**
+     * Plot a text like PLOTTER::Text, but with the consecutive segments of the stroke font
+     * chained in a single path, which is several times smaller than a path per segment.
+     *
+     * PenTo() must start a new subpath for a move inside a path.
+     */
+    void plotChainedText( const VECTOR2I& aPos, const wxString& aText, const EDA_ANGLE& aOrient,
+                          const VECTOR2I& aSize, enum GR_TEXT_H_ALIGN_T aH_justify,
+                          enum GR_TEXT_V_ALIGN_T aV_justify, int aWidth, bool aItalic,
+                          bool aBold, KIFONT::FONT* aFont, const KIFONT::METRICS& aFontMetrics,
+                          void* aData );
+
     /// convert a wxString unicode string to a char string compatible with the accepted
     /// string plotter format (convert special chars and non ascii7 chars)
     virtual std::string encodeStringForPlotter( const wxString& aUnicode );
@@ -244,7 +261,7 @@ public:
             m_imgResDictHandle( 0 ),
             m_jsNamesHandle( 0 ),
             m_pageStreamHandle( 0 ),
-            m_streamLengthHandle( 0 ),
+            m_streamHandle( 0 ),
             m_workFile( nullptr ),
             m_totalOutlineNodes( 0 )
     {
@@ -461,10 +478,21 @@ protected:
     int startPdfStream(int handle = -1);
 
     /**
-     * Finish the current PDF stream (writes the deferred length, too)
+     * Finish the current PDF stream.  Its content is compressed on the thread pool and the
+     * stream object is written later, by writePendingStreams().
      */
     void closePdfStream();
 
+    /**
+     * Write the stream objects whose content is compressed.
+     *
+     * Must be called between objects only.
+     *
+     * @param aMaxPending is the number of streams left pending, waiting for the oldest ones if
+     *                    there are more.  0 writes all the streams.
+     */
+    void writePendingStreams( size_t aMaxPending );
+
     /**
      * Starts emitting the outline object
      */
@@ -489,12 +517,22 @@ protected:
     int m_jsNamesHandle;            ///< Handle for Names dictionary with JS
     std::vector<int> m_pageHandles; ///< Handles to the page objects
     int m_pageStreamHandle;         ///< Handle of the page content object
-    int m_streamLengthHandle;       ///< Handle to the deferred stream length
+    int m_streamHandle;             ///< Handle of the stream being built
     wxString m_workFilename;
     wxString m_pageName;
     FILE* m_workFile;               ///< Temporary file to construct the stream before zipping
     std::vector<long> m_xrefTable;  ///< The PDF xref offset table
 
+    struct PENDING_STREAM
+    {
+        int                      m_handle;
+        bool                     m_compressed;
+        std::future<std::string> m_content;
+    };
+
+    ///< The streams being compressed, in order
+    std::deque<PENDING_STREAM> m_pendingStreams;
+
     ///< List of user-space page numbers for resolving internal hyperlinks
     std::vector<wxString>                                  m_pageNumbers;
 
@@ -530,6 +568,11 @@ public:
         return PLOT_FORMAT::SVG;
     }
 
+    /**
+     * Open the plot file with a large output buffer: the file is written in tiny pieces.
+     */
+    virtual bool OpenFile( const wxString& aFullFilename ) override;
+
     /**
      * Create SVG file header.
      */
@@ -564,6 +607,23 @@ public:
     virtual void PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFill,
                            int aWidth = USE_DEFAULT_LINE_WIDTH, void * aData = nullptr ) override;
 
+    /**
+     * The filled pads are defined once per shape in the \<defs\> of the file, and each pad is
+     * a \<use\> of its shape.
+     */
+    virtual void FlashPadRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                               const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                               void* aData ) override;
+    virtual void FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                    int aCornerRadius, const EDA_ANGLE& aOrient,
+                                    OUTLINE_MODE aTraceMode, void* aData ) override;
+    virtual void FlashPadCustom( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                 const EDA_ANGLE& aOrient, SHAPE_POLY_SET* aPolygons,
+                                 OUTLINE_MODE aTraceMode, void* aData ) override;
+    virtual void FlashPadTrapez( const VECTOR2I& aPadPos, const VECTOR2I* aCorners,
+                                 const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                 void* aData ) override;
+
     /**
      * PostScript-likes at the moment are the only plot engines supporting bitmaps.
      */
@@ -643,6 +703,14 @@ protected:
      */
     void setFillMode( FILL_T fill );
 
+    /**
+     * Plot the filled outlines of a pad as a \<use\> of their shape, relative to \a aPadPos.
+     */
+    void flashOutlines( const VECTOR2I& aPadPos, const SHAPE_POLY_SET& aOutlines );
+
+    /// Append a device coordinate to \a aOut, in the format given by m_precision
+    void appendCoord( std::string& aOut, double aValue ) const;
+
     FILL_T     m_fillMode;          // true if the current contour rect, arc, circle, polygon must
                                     // be filled
     long       m_pen_rgb_color;     // current rgb color value: each color has a value 0 ... 255,
@@ -657,4 +725,7 @@ protected:
                                     // Use 3-6 (3 means um precision, 6 nm precision) in PcbNew
                                     // 3-4 in other modules (avoid values >4 to avoid overflow)
                                     // see also comment for m_useInch.
+
+    std::unordered_map<std::string, int> m_padShapes; // the id of each pad shape, by content
+    std::string                          m_defs;      // the pad shapes, written by EndPlot()
 };
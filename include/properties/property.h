@@ -281,6 +281,25 @@ PROPERTY_BASE( const wxString& aName, PROPERTY_DISPLAY aDisplay = PT_DEFAULT,
      */
     virtual size_t TypeHash() const = 0;
 
+    /**
+     * Read the value of an int, bool or enum property straight from its getter, without
+     * boxing it in a wxAny.  Used by the hot paths (rule evaluation, the properties panel on
+     * large selections).
+     *
+     * @param aObject is the object already cast to the owner type (see
+     *                PROPERTY_MANAGER::TypeCast()).
+     * @return false if the property has another type; the caller then uses the wxAny getter.
+     */
+    virtual bool GetInt( const void* aObject, int& aValue ) const { return false; }
+
+    /**
+     * Read the value of a wxString property, or the name of the value of an enum property,
+     * without boxing it in a wxAny.
+     *
+     * @return false if the property has another type, or the enum value has no name.
+     */
+    virtual bool GetString( const void* aObject, wxString& aValue ) const { return false; }
+
     PROPERTY_DISPLAY Display() const { return m_display; }
     PROPERTY_BASE& SetDisplay( PROPERTY_DISPLAY aDisplay ) { m_display = aDisplay; return *this; }
 
@@ -505,6 +524,48 @@ protected:
         return res;
     }
 
+    bool GetInt( const void* aObject, int& aValue ) const override
+    {
+        if constexpr( std::is_same<BASE_TYPE, int>::value || std::is_same<BASE_TYPE, bool>::value
+                      || std::is_enum<BASE_TYPE>::value )
+        {
+            const Owner* o = reinterpret_cast<const Owner*>( aObject );
+            aValue = static_cast<int>( (*m_getter)( o ) );
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool GetString( const void* aObject, wxString& aValue ) const override
+    {
+        if constexpr( std::is_same<BASE_TYPE, wxString>::value )
+        {
+            const Owner* o = reinterpret_cast<const Owner*>( aObject );
+            aValue = (*m_getter)( o );
+            return true;
+        }
+        else if constexpr( std::is_enum<BASE_TYPE>::value )
+        {
+            // Same names as the wxAny conversion of DECLARE_ENUM_TO_WXANY
+            const Owner*         o = reinterpret_cast<const Owner*>( aObject );
+            BASE_TYPE            value = (*m_getter)( o );
+            ENUM_MAP<BASE_TYPE>& conv = ENUM_MAP<BASE_TYPE>::Instance();
+
+            if( !conv.IsValueDefined( value ) )
+                return false;
+
+            aValue = conv.ToString( value );
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     ///< Set method
     std::unique_ptr<SETTER_BASE<Owner, T>> m_setter;
 
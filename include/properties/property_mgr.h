@@ -147,6 +147,14 @@ public:
         return const_cast<void*>( TypeCast( (const void*) aSource, aBase, aTarget ) );
     }
 
+    /**
+     * Return the converter TypeCast() uses between two types, so that a caller casting many
+     * objects of the same type looks it up once.
+     *
+     * @return the converter, or nullptr if the pointer is used as is.
+     */
+    const TYPE_CAST_BASE* GetTypeCast( TYPE_ID aBase, TYPE_ID aTarget ) const;
+
     /**
      * Register a property.
      * Properties for a given item will be shown in the order they are added.
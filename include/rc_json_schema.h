@@ -76,6 +76,28 @@ inline void from_json( const nlohmann::json& aJson, VIOLATION& aViolation )
     aJson.at( "excluded" ).get_to( aViolation.excluded );
 }
 
+struct RULE_HITS
+{
+    wxString rule;
+    int      hits;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( RULE_HITS, rule, hits )
+
+struct DRC_PROVIDER_PROFILE
+{
+    wxString               provider;
+    double                 time_ms;
+    int64_t                items_tested;
+    int64_t                rtree_queries;
+    int64_t                collision_tests;
+    int64_t                rule_evaluations;
+    std::vector<RULE_HITS> rules;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( DRC_PROVIDER_PROFILE, provider, time_ms, items_tested,
+                                    rtree_queries, collision_tests, rule_evaluations, rules )
+
 struct REPORT_BASE
 {
     wxString $schema;
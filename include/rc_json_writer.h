@@ -0,0 +1,151 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RC_JSON_WRITER_H
+#define RC_JSON_WRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+
+namespace RC_JSON
+{
+
+/**
+ * Write a JSON document to a stream piece by piece, so that a report with a very large number
+ * of violations never has to be held in memory as a whole.
+ *
+ * The output is formatted as nlohmann::json::dump( 4 ) would format the complete document.
+ * Keys are written in the order they are given: callers must give them in alphabetical order
+ * to match the ordering of a nlohmann::json object.
+ */
+class STREAM_WRITER
+{
+public:
+    STREAM_WRITER( std::ostream& aStream ) :
+            m_stream( aStream )
+    {
+    }
+
+    void BeginObject() { begin( '{' ); }
+    void EndObject() { end( '}' ); }
+
+    void BeginArray() { begin( '[' ); }
+    void EndArray() { end( ']' ); }
+
+    /**
+     * Write the key of the next member of the current object.
+     */
+    void Key( const std::string& aKey )
+    {
+        separate();
+        m_stream << nlohmann::json( aKey ).dump() << ": ";
+        m_afterKey = true;
+    }
+
+    /**
+     * Write a complete value, serialized with its nlohmann to_json().
+     */
+    template <typename T>
+    void Value( const T& aValue )
+    {
+        std::string text = nlohmann::json( aValue ).dump( INDENT );
+        std::string indent = "\n" + std::string( m_open.size() * INDENT, ' ' );
+
+        separate();
+
+        for( char c : text )
+        {
+            if( c == '\n' )
+                m_stream << indent;
+            else
+                m_stream << c;
+        }
+    }
+
+    template <typename T>
+    void Member( const std::string& aKey, const T& aValue )
+    {
+        Key( aKey );
+        Value( aValue );
+    }
+
+    /**
+     * End the document.  All the objects and arrays must have been closed.
+     */
+    void Finish() { m_stream << std::endl; }
+
+private:
+    static constexpr int INDENT = 4;
+
+    void begin( char aBracket )
+    {
+        separate();
+        m_stream << aBracket;
+        m_open.push_back( true );
+    }
+
+    void end( char aBracket )
+    {
+        bool empty = m_open.back();
+
+        m_open.pop_back();
+
+        if( !empty )
+            newline();
+
+        m_stream << aBracket;
+    }
+
+    /**
+     * Start a new value or key: after a key it follows on the same line, otherwise it goes on
+     * a line of its own after the previous one in the current object or array.
+     */
+    void separate()
+    {
+        if( m_afterKey )
+        {
+            m_afterKey = false;
+            return;
+        }
+
+        if( m_open.empty() )
+            return;
+
+        if( !m_open.back() )
+            m_stream << ',';
+
+        m_open.back() = false;
+        newline();
+    }
+
+    void newline() { m_stream << '\n' << std::string( m_open.size() * INDENT, ' ' ); }
+
+private:
+    std::ostream&     m_stream;
+    std::vector<bool> m_open;     ///< Per open object or array: true until it has a member
+    bool              m_afterKey = false;
+};
+
+} // namespace RC_JSON
+
+#endif // RC_JSON_WRITER_H
@@ -29,12 +29,17 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <core/utf8.h>
 
 // I really did not want to be dependent on wxWidgets in richio
 // but the errorText needs to be wide char so wxString rules.
 #include <cstdio>
+#include <string_view>
 #include <wx/string.h>
 #include <wx/stream.h>
 
@@ -82,6 +87,15 @@ KICOMMON_API std::string
 KICOMMON_API wxString SafeReadFile( const wxString& aFilePath, const wxString& aReadType );
 
 
+/**
+ * @return true if \a aFileName names a gzip compressed file, e.g. "board.kicad_pcb.gz".
+ */
+KICOMMON_API bool IsGzipFileName( const wxString& aFileName );
+
+
+struct gzFile_s;
+
+
 #define LINE_READER_LINE_DEFAULT_MAX        1000000
 #define LINE_READER_LINE_INITIAL_SIZE       5000
 
@@ -246,6 +260,106 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER that reads from a file mapped into memory.
+ *
+ * This saves #FILE_LINE_READER's character-at-a-time stdio reads, and gives access to the
+ * whole file for callers which can make use of it.  Files which can't be mapped are read
+ * into memory instead.
+ */
+class KICOMMON_API MAPPED_FILE_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * @param aFileName is the name of the file to map and to use for error reporting purposes.
+     * @param aStartingLineNumber is the initial line number to report on error.
+     * @param aMaxLineLength is the number of bytes to use in the line buffer.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName, unsigned aStartingLineNumber = 0,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    /**
+     * Go back to the start of the file and reset the line number back to zero.
+     */
+    void Rewind()
+    {
+        m_pos = 0;
+        m_lineNum = 0;
+    }
+
+    /**
+     * Return the complete contents of the file.
+     */
+    std::string_view Contents() const
+    {
+        return std::string_view( m_data, m_size );
+    }
+
+protected:
+    const char*  m_data;      ///< the mapped file, or m_fallback
+    size_t       m_size;
+    size_t       m_pos;       ///< offset of the next line in m_data
+    void*        m_handle;    ///< platform data needed to unmap the file
+    bool         m_mapped;
+    std::string  m_fallback;  ///< the file contents when it could not be mapped
+};
+
+
+/**
+ * A #LINE_READER that decompresses a gzip file as it reads it.
+ *
+ * Only a small window of the decompressed text is held in memory at any time, so large
+ * compressed boards can be fed to the lexer without inflating them first.  Files which are
+ * not compressed are read as they are.
+ */
+class KICOMMON_API GZIP_FILE_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * @param aFileName is the name of the file to open and to use for error reporting purposes.
+     * @param aStartingLineNumber is the initial line number to report on error.
+     * @param aMaxLineLength is the number of bytes to use in the line buffer.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened.
+     */
+    GZIP_FILE_LINE_READER( const wxString& aFileName, unsigned aStartingLineNumber = 0,
+                           unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~GZIP_FILE_LINE_READER();
+
+    /**
+     * @throw IO_ERROR if the compressed data is damaged.
+     */
+    char* ReadLine() override;
+
+    /**
+     * Go back to the start of the file and reset the line number back to zero.
+     *
+     * This decompresses the file again from its beginning.
+     */
+    void Rewind();
+
+protected:
+    /**
+     * Decompress the next chunk of the file into m_chunk.
+     *
+     * @return false at the end of the file.
+     */
+    bool fill();
+
+    struct gzFile_s*  m_file;
+    std::vector<char> m_chunk;    ///< decompressed text not yet returned by ReadLine()
+    size_t            m_pos;      ///< offset of the next line in m_chunk
+    size_t            m_end;      ///< no. valid bytes in m_chunk
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -375,6 +489,17 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Write \a aText, which is already formatted, to the output stream as is.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void WriteFormatted( const std::string& aText )
+    {
+        if( !aText.empty() )
+            write( aText.data(), aText.size() );
+    }
+
     /**
      * Perform quote character need determination.
      *
@@ -496,6 +621,57 @@ protected:
 };
 
 
+/**
+ * An #OUTPUTFORMATTER which writes a gzip compressed file.
+ *
+ * The formatted text is collected in blocks which are compressed and written by a worker
+ * thread, so the compression overlaps the formatting of the rest of the file.  The output
+ * is not prettified.
+ */
+class KICOMMON_API GZIP_FILE_OUTPUTFORMATTER : public OUTPUTFORMATTER
+{
+public:
+    /**
+     * @param aFileName is the full filename to create.
+     * @param aQuoteChar is a char used for quoting problematic strings (with whitespace or
+     *                   special characters in them).
+     * @throw IO_ERROR if the file cannot be opened.
+     */
+    GZIP_FILE_OUTPUTFORMATTER( const wxString& aFileName, char aQuoteChar = '"' );
+
+    ~GZIP_FILE_OUTPUTFORMATTER();
+
+    /**
+     * Compress the remaining text and close the file.
+     *
+     * @return true if the write succeeded.
+     * @throw IO_ERROR if the file could not be written.
+     */
+    bool Finish() override;
+
+protected:
+    void write( const char* aOutBuf, int aCount ) override;
+
+private:
+    /// Hand the current block to the worker thread, waiting for it if it has fallen behind.
+    void submit();
+
+    /// The worker thread: compress and write the queued blocks until Finish() is called.
+    void compress();
+
+    struct gzFile_s*        m_file;
+    wxString                m_filename;
+    std::string             m_block;      ///< text not yet handed to the worker
+
+    std::thread             m_worker;
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+    std::deque<std::string> m_queue;      ///< blocks waiting to be compressed
+    bool                    m_done;       ///< no more blocks will be queued
+    wxString                m_error;      ///< set by the worker if a write failed
+};
+
+
 class KICOMMON_API PRETTIFIED_FILE_OUTPUTFORMATTER : public OUTPUTFORMATTER
 {
 public:
@@ -196,6 +196,7 @@ public:
     static TOOL_ACTION donate;
     static TOOL_ACTION getInvolved;
     static TOOL_ACTION reportBug;
+    static TOOL_ACTION showMemoryUsage;
 
     ///< Cursor control event types
     enum CURSOR_EVENT_TYPE
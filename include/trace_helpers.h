@@ -220,6 +220,13 @@ extern KICOMMON_API const wxChar* const traceGalProfile;
  */
 extern KICOMMON_API const wxChar* const traceKiCad2Step;
 
+/**
+ * Flag to enable debug output of connectivity and ratsnest profiling counters.
+ *
+ * Use "KICAD_CONNECTIVITY" to enable.
+ */
+extern KICOMMON_API const wxChar* const traceConnectivity;
+
 ///@}
 
 /**
@@ -29,6 +29,7 @@
 
 #include <gal/gal.h>
 #include <vector>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <memory>
@@ -104,6 +105,22 @@ public:
      */
     virtual void Remove( VIEW_ITEM* aItem );
 
+    /**
+     * Add many items to the view at once, with sequential draw priorities.  The trees of the
+     * layers are repacked in one pass rather than growing one item at a time, which is much
+     * faster when populating a view.
+     *
+     * @param aItems: items to be added. No ownership is given
+     */
+    virtual void AddItems( const std::vector<VIEW_ITEM*>& aItems );
+
+    /**
+     * Remove many items from the view at once.
+     *
+     * @param aItems: items to be removed. Caller must dispose the removed items if necessary
+     */
+    virtual void RemoveItems( const std::vector<VIEW_ITEM*>& aItems );
+
 
     /**
      * Find all visible items that touch or are within the rectangle \a aRect.
@@ -182,12 +199,6 @@ public:
      */
     void CopySettings( const VIEW* aOtherView );
 
-    /*
-     *  Convenience wrappers for adding multiple items
-     *  template <class T> void AddItems( const T& aItems );
-     *  template <class T> void RemoveItems( const T& aItems );
-     */
-
     /**
      * Assign a rendering device for the VIEW.
      *
@@ -663,8 +674,19 @@ public:
 
     /**
      * Iterate through the list of items that asked for updating and updates them.
+     *
+     * @param aTimeBudget if positive, is the time in milliseconds after which the remaining
+     *                    items are left for the next call.  They keep their previous graphics
+     *                    until then, and the items in the viewport are updated first.
+     */
+    void UpdateItems( double aTimeBudget = 0.0 );
+
+    /**
+     * @return true if the last call to UpdateItems() ran out of time before updating all items,
+     *         or if the last redraw reached items whose groups were left for the zoom level
+     *         showing them.
      */
-    void UpdateItems();
+    bool HasPendingUpdates() const { return m_hasPendingUpdates || m_hasDeferredGroups; }
 
     /**
      * Update all items in the view according to the given flags.
@@ -715,6 +737,30 @@ public:
         m_reverseDrawOrder = aFlag;
     }
 
+    /// Statistics of the last redraw, for the render statistics overlay of the draw panels.
+    struct REDRAW_STATISTICS
+    {
+        double                        m_redrawTime = 0.0;  ///< In milliseconds
+        std::map<int, unsigned int>   m_layerItems;        ///< Items drawn, by layer
+        std::map<int, unsigned int>   m_layerVertices;     ///< Cached vertices drawn, by layer
+    };
+
+    /**
+     * @param aFlag is true if Redraw() should collect the statistics of what it draws.
+     */
+    void CollectStatistics( bool aFlag )
+    {
+        m_collectStatistics = aFlag;
+    }
+
+    /**
+     * @return the statistics of the last Redraw() done while collecting them.
+     */
+    const REDRAW_STATISTICS& GetStatistics() const
+    {
+        return m_statistics;
+    }
+
     std::shared_ptr<VIEW_OVERLAY> MakeOverlay();
 
     void InitPreview();
@@ -811,12 +857,28 @@ protected:
      */
     void invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags );
 
+    ///< Set up the view data of an item being added and return the layers it goes on
+    void addItemData( VIEW_ITEM* aItem, int aDrawPriority, int aLayers[], int& aCount );
+
+    ///< Take an item out of the trees of its layers and free its cached groups
+    void removeItemData( VIEW_ITEM* aItem );
+
+    ///< Let the painter prepare, on the thread pool, the items about to be redrawn if there
+    ///< are many of them
+    void prepareItems();
+
+    ///< Update the items waiting for it until \a aTimeBudget milliseconds have passed
+    void updateItemsWithinBudget( double aTimeBudget );
+
     ///< Update colors that are used for an item to be drawn
     void updateItemColor( VIEW_ITEM* aItem, int aLayer );
 
     ///< Update all information needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
+    ///< Free the cached groups of an item on a layer, until it is drawn there again
+    void deleteItemGroups( VIEW_ITEM* aItem, int aLayer );
+
     ///< Update bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
 
@@ -889,6 +951,17 @@ protected:
 
     ///< Flag to reverse the draw order when using draw priority.
     bool m_reverseDrawOrder;
+
+    ///< Flag to collect m_statistics while redrawing.
+    bool m_collectStatistics = false;
+
+    ///< Flag telling that UpdateItems() left items to update for its next call.
+    bool m_hasPendingUpdates = false;
+
+    ///< Flag telling that a redraw asked for the groups of items left by UpdateItems().
+    bool m_hasDeferredGroups = false;
+
+    REDRAW_STATISTICS m_statistics;
 };
 } // namespace KIGFX
 
@@ -144,6 +144,19 @@ public:
         return 0.0;
     }
 
+    /**
+     * Return the #VIEW scale below which the item is drawn on a cached layer from a simplified
+     * proxy made by PAINTER::DrawProxy() instead of from its full geometry.
+     *
+     * @param aLayer is the current drawing layer.
+     * @param aView is a pointer to the #VIEW device we are drawing on.
+     * @return the scale below which the proxy is used, or 0 if the item has no proxy.
+     */
+    virtual double ViewGetProxyScale( int aLayer, VIEW* aView ) const
+    {
+        return 0.0;
+    }
+
     VIEW_ITEM_DATA* viewPrivData() const
     {
         return m_viewPrivData;
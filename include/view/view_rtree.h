@@ -28,6 +28,8 @@
 #define __VIEW_RTREE_H
 
 #include <math/box2.h>
+#include <utility>
+#include <vector>
 
 #include <geometry/rtree.h>
 
@@ -54,6 +56,28 @@ public:
         VIEW_RTREE_BASE::Insert( mmin, mmax, aItem );
     }
 
+    /**
+     * Insert many items into the tree at once, repacking it.  This is much faster than inserting
+     * them one by one.
+     */
+    void BulkInsert( const std::vector<std::pair<VIEW_ITEM*, BOX2I>>& aItems )
+    {
+        std::vector<std::pair<Rect, VIEW_ITEM*>> entries;
+        entries.reserve( aItems.size() );
+
+        for( const auto& [item, bbox] : aItems )
+        {
+            Rect rect;
+            rect.m_min[0] = bbox.GetX();
+            rect.m_min[1] = bbox.GetY();
+            rect.m_max[0] = bbox.GetRight();
+            rect.m_max[1] = bbox.GetBottom();
+            entries.emplace_back( rect, item );
+        }
+
+        VIEW_RTREE_BASE::BulkLoad( entries );
+    }
+
     /**
      * Remove an item from the tree.
      *
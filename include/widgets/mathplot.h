@@ -562,6 +562,12 @@ public:
     virtual size_t GetCount() const = 0;
     virtual int GetSweepCount() const { return 1; }
 
+    /** Tell the enumeration which part of the data is visible, as a range of X values spread
+     *  over \a aPixels columns, so it can skip the points which can't change the drawing.
+     *  It holds until the next Rewind().  The default implementation does nothing.
+     */
+    virtual void SetVisibleRange( double aMinX, double aMaxX, int aPixels ) {}
+
     /** Layer plot handler.
      *  This implementation will plot the locus in the visible area and put a label according to
      *  the alignment specified.
@@ -1376,6 +1382,13 @@ public:
      */
     virtual void SetData( const std::vector<double>& xs, const std::vector<double>& ys );
 
+    /** Appends points to the internal data, extending the bounding box by the new points only.
+     *  Both vectors MUST be of the same length. This method DOES NOT refresh the mpWindow; do it
+     *  manually.
+     * @sa SetData
+     */
+    virtual void AppendData( const std::vector<double>& xs, const std::vector<double>& ys );
+
     void SetSweepCount( int aSweepCount ) { m_sweepCount = aSweepCount; }
     void SetSweepSize( size_t aSweepSize ) { m_sweepSize = aSweepSize; }
 
@@ -1384,6 +1397,12 @@ public:
      */
     void Clear();
 
+    /** Restricts the enumeration to the visible points and, when there are many points per
+     *  pixel column, to the lowest and highest point of each group of points sharing a column.
+     *  Only done for data with a single sweep and increasing X values.
+     */
+    void SetVisibleRange( double aMinX, double aMaxX, int aPixels ) override;
+
 protected:
     /** The internal copy of the set of data to draw.
      */
@@ -1392,6 +1411,36 @@ protected:
     size_t m_index;           // internal counter for the "GetNextXY" interface
     size_t m_sweepWindow;     // last m_index of the current sweep
 
+    /** Number of points of the blocks of the first level of the min/max pyramid.  The blocks
+     *  of each following level are twice as large.
+     */
+    static constexpr size_t DECIMATION_BLOCK = 32;
+
+    struct MIN_MAX
+    {
+        size_t m_min;         // index of the lowest point of the block
+        size_t m_max;         // index of the highest point of the block
+    };
+
+    /** The min/max pyramid, extended as data is appended.  Empty if the X values aren't
+     *  increasing.
+     */
+    std::vector<std::vector<MIN_MAX>> m_minMax;
+    bool   m_increasingX = true;
+
+    /** The visible points, set by SetVisibleRange() and enumerated instead of the sweep.
+     */
+    bool                m_visibleOnly = false;
+    size_t              m_visibleBegin = 0;
+    size_t              m_visibleEnd = 0;
+    std::vector<size_t> m_decimated;      // the points to enumerate, if decimated
+    bool                m_decimating = false;
+    size_t              m_decimatedIndex = 0;
+
+    /** Rebuild the min/max pyramid from the point \a aFirst on.
+     */
+    void updateMinMax( size_t aFirst );
+
     /** Loaded at SetData
      */
     double m_minX, m_maxX, m_minY, m_maxY;
@@ -35,6 +35,7 @@
 #define ARG_DRAWING_SHEET "--drawing-sheet"
 #define ARG_DEFINE_VAR_SHORT "-D"
 #define ARG_DEFINE_VAR_LONG "--define-var"
+#define ARG_TRACE "--trace"
 
 namespace CLI
 {
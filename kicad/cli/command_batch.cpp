@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_batch.h"
+#include <cli/exit_codes.h>
+#include <wx/cmdline.h>
+#include <wx/crt.h>
+#include <wx/filename.h>
+#include <wx/textfile.h>
+
+#include <string_utils.h>
+
+
+#define ARG_STOP_ON_ERROR "--stop-on-error"
+
+
+CLI::BATCH_COMMAND::BATCH_COMMAND() : COMMAND( "batch" )
+{
+    addCommonArgs( true, false, false, false );
+
+    m_argParser.add_description( UTF8STDSTR( _( "Runs the commands listed in a file, one per "
+                                                "line, loading the libraries, the settings and "
+                                                "the boards once" ) ) );
+
+    m_argParser.add_argument( ARG_STOP_ON_ERROR )
+            .help( UTF8STDSTR( _( "Stop at the first command that fails" ) ) )
+            .implicit_value( true )
+            .default_value( false );
+}
+
+
+int CLI::BATCH_COMMAND::doPerform( KIWAY& aKiway )
+{
+    if( !m_runner )
+    {
+        wxFprintf( stderr, _( "A batch file cannot run a batch\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    bool       stopOnError = m_argParser.get<bool>( ARG_STOP_ON_ERROR );
+    wxTextFile file( m_argInput );
+
+    if( !wxFileName::FileExists( m_argInput ) || !file.Open() )
+    {
+        wxFprintf( stderr, _( "Batch file does not exist or is not accessible\n" ) );
+        return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    int exitCode = EXIT_CODES::OK;
+
+    for( size_t ii = 0; ii < file.GetLineCount(); ++ii )
+    {
+        wxString line = file[ii];
+        line.Trim( true ).Trim( false );
+
+        if( line.IsEmpty() || line.StartsWith( wxS( "#" ) ) )
+            continue;
+
+        wxArrayString            args = wxCmdLineParser::ConvertStringToArgs( line );
+        std::vector<std::string> argsUtf8;
+
+        for( const wxString& arg : args )
+            argsUtf8.emplace_back( arg.utf8_str() );
+
+        wxPrintf( _( "Running '%s'\n" ), line );
+
+        int result = m_runner( argsUtf8 );
+
+        if( result == EXIT_CODES::AVOID_CLOSING )
+            result = EXIT_CODES::OK;
+
+        if( result != EXIT_CODES::OK )
+        {
+            wxFprintf( stderr, _( "Line %d failed with exit code %d\n" ), (int) ii + 1, result );
+
+            // Report the first failure
+            if( exitCode == EXIT_CODES::OK )
+                exitCode = result;
+
+            if( stopOnError )
+                break;
+        }
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,57 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMAND_BATCH_H
+#define COMMAND_BATCH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "command.h"
+
+namespace CLI
+{
+/**
+ * Run the commands listed in a file in a single kicad-cli process.
+ *
+ * Each line of the file holds one command with its arguments, as they would follow kicad-cli
+ * on the command line.  Empty lines and lines starting with # are skipped.  The kifaces, the
+ * settings and the libraries are loaded once, and consecutive jobs on the same board share
+ * the loaded board.
+ */
+class BATCH_COMMAND : public COMMAND
+{
+public:
+    /// Run one command line, given without the program name, and return its exit code
+    using RUNNER = std::function<int( const std::vector<std::string>& aArgs )>;
+
+    BATCH_COMMAND();
+
+    void SetRunner( const RUNNER& aRunner ) { m_runner = aRunner; }
+
+protected:
+    int doPerform( KIWAY& aKiway ) override;
+
+private:
+    RUNNER m_runner;
+};
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include <wx/tokenzr.h>
 
 #define ARG_FOOTPRINT "--footprint"
+#define ARG_SKIP_UNCHANGED "--skip-unchanged"
 
 CLI::FP_EXPORT_SVG_COMMAND::FP_EXPORT_SVG_COMMAND() : PCB_EXPORT_BASE_COMMAND( "svg", true, true )
 {
@@ -53,6 +54,11 @@ CLI::FP_EXPORT_SVG_COMMAND::FP_EXPORT_SVG_COMMAND() : PCB_EXPORT_BASE_COMMAND( "
     m_argParser.add_argument( ARG_BLACKANDWHITE )
             .help( UTF8STDSTR( _( ARG_BLACKANDWHITE_DESC ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_SKIP_UNCHANGED )
+            .help( UTF8STDSTR( _( "Skip the footprints which did not change since the last "
+                                  "export to the output directory" ) ) )
+            .flag();
 }
 
 
@@ -68,6 +74,7 @@ int CLI::FP_EXPORT_SVG_COMMAND::doPerform( KIWAY& aKiway )
     svgJob->m_outputDirectory = m_argOutput;
     svgJob->m_blackAndWhite = m_argParser.get<bool>( ARG_BLACKANDWHITE );
     svgJob->m_footprint = From_UTF8( m_argParser.get<std::string>( ARG_FOOTPRINT ).c_str() );
+    svgJob->m_skipUnchanged = m_argParser.get<bool>( ARG_SKIP_UNCHANGED );
     svgJob->SetVarOverrides( m_argDefineVars );
 
     if( !wxDir::Exists( svgJob->m_libraryPath ) )
@@ -0,0 +1,82 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_benchmark.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_pcb_benchmark.h"
+#include <kiface_base.h>
+#include <string_utils.h>
+#include <wx/crt.h>
+
+#include <macros.h>
+
+#define ARG_OUTPUT_DIR "--output-dir"
+#define ARG_ITERATIONS "--iterations"
+#define ARG_SKIP_STEP "--skip-step"
+
+
+CLI::PCB_BENCHMARK_COMMAND::PCB_BENCHMARK_COMMAND() : COMMAND( "benchmark" )
+{
+    addCommonArgs( true, true, false, false );
+
+    m_argParser.add_description( UTF8STDSTR( _( "Loads the PCB, then runs connectivity, "
+                                                "ratsnest, zone fill, DRC, gerber plot, STEP "
+                                                "export and save, and writes the wall time, CPU "
+                                                "time, peak memory and thread utilization of "
+                                                "each stage as JSON" ) ) );
+
+    m_argParser.add_argument( ARG_OUTPUT_DIR )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Directory receiving the files written by the stages; by "
+                                  "default they are written to a temporary directory which is "
+                                  "removed afterwards" ) ) )
+            .metavar( "DIR" );
+
+    m_argParser.add_argument( ARG_ITERATIONS )
+            .default_value( 1 )
+            .scan<'i', int>()
+            .help( UTF8STDSTR( _( "Number of times the pipeline is run" ) ) )
+            .metavar( "COUNT" );
+
+    m_argParser.add_argument( ARG_SKIP_STEP )
+            .help( UTF8STDSTR( _( "Skip the STEP export stage" ) ) )
+            .flag();
+}
+
+
+int CLI::PCB_BENCHMARK_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_BENCHMARK> benchmarkJob( new JOB_PCB_BENCHMARK( true ) );
+
+    benchmarkJob->m_filename = m_argInput;
+    benchmarkJob->m_outputFile = m_argOutput;
+    benchmarkJob->m_outputDir = From_UTF8( m_argParser.get<std::string>( ARG_OUTPUT_DIR ).c_str() );
+    benchmarkJob->m_iterations = m_argParser.get<int>( ARG_ITERATIONS );
+    benchmarkJob->m_skipStep = m_argParser.get<bool>( ARG_SKIP_STEP );
+
+    if( benchmarkJob->m_iterations < 1 )
+    {
+        wxFprintf( stderr, _( "Invalid iteration count\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, benchmarkJob.get() );
+
+    return exitCode;
+}
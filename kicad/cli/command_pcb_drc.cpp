@@ -38,15 +38,23 @@
 #define ARG_SEVERITY_EXCLUSIONS "--severity-exclusions"
 #define ARG_EXIT_CODE_VIOLATIONS "--exit-code-violations"
 #define ARG_PARITY "--schematic-parity"
+#define ARG_PROFILE "--profile"
 
 CLI::PCB_DRC_COMMAND::PCB_DRC_COMMAND() : COMMAND( "drc" )
 {
-    addCommonArgs( true, true, false, false );
+    addCommonArgs( false, true, false, false );
     addDefineArg();
 
     m_argParser.add_description( UTF8STDSTR( _( "Runs the Design Rules Check (DRC) on the PCB "
                                                 "and creates a report" ) ) );
 
+    m_argParser.add_argument( ARG_INPUT )
+            .help( UTF8STDSTR( _( "Input file(s); when several boards are given, they are "
+                                  "checked in one run and the output is a directory receiving "
+                                  "one report per board" ) ) )
+            .nargs( argparse::nargs_pattern::at_least_one )
+            .metavar( "INPUT_FILE" );
+
     m_argParser.add_argument( ARG_FORMAT )
             .default_value( std::string( "report" ) )
             .help( UTF8STDSTR( _( "Output file format, options: json, report" ) ) )
@@ -88,6 +96,11 @@ CLI::PCB_DRC_COMMAND::PCB_DRC_COMMAND() : COMMAND( "drc" )
     m_argParser.add_argument( ARG_EXIT_CODE_VIOLATIONS )
             .help( UTF8STDSTR( _( "Return a nonzero exit code if DRC violations exist" ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_PROFILE )
+            .help( UTF8STDSTR( _( "Add the run time and work counters of each test to the "
+                                  "report, and print the estimated memory usage" ) ) )
+            .flag();
 }
 
 
@@ -95,8 +108,13 @@ int CLI::PCB_DRC_COMMAND::doPerform( KIWAY& aKiway )
 {
     std::unique_ptr<JOB_PCB_DRC> drcJob( new JOB_PCB_DRC( true ) );
 
+    std::vector<std::string> inputs = m_argParser.get<std::vector<std::string>>( ARG_INPUT );
+
+    for( const std::string& input : inputs )
+        drcJob->m_filenames.push_back( From_UTF8( input.c_str() ) );
+
     drcJob->m_outputFile = m_argOutput;
-    drcJob->m_filename = m_argInput;
+    drcJob->m_filename = drcJob->m_filenames.front();
     drcJob->SetVarOverrides( m_argDefineVars );
     drcJob->m_reportAllTrackErrors = m_argParser.get<bool>( ARG_ALL_TRACK_ERRORS );
     drcJob->m_exitCodeViolations = m_argParser.get<bool>( ARG_EXIT_CODE_VIOLATIONS );
@@ -163,6 +181,7 @@ int CLI::PCB_DRC_COMMAND::doPerform( KIWAY& aKiway )
     }
 
     drcJob->m_parity = m_argParser.get<bool>( ARG_PARITY );
+    drcJob->m_profile = m_argParser.get<bool>( ARG_PROFILE );
 
     int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, drcJob.get() );
 
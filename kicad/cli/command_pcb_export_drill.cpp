@@ -40,6 +40,7 @@
 #define ARG_GENERATE_MAP "--generate-map"
 #define ARG_MAP_FORMAT "--map-format"
 #define ARG_DRILL_ORIGIN "--drill-origin"
+#define ARG_OPTIMIZE_HOLE_ORDER "--optimize-hole-order"
 
 
 CLI::PCB_EXPORT_DRILL_COMMAND::PCB_EXPORT_DRILL_COMMAND() : PCB_EXPORT_BASE_COMMAND( "drill",
@@ -89,6 +90,10 @@ CLI::PCB_EXPORT_DRILL_COMMAND::PCB_EXPORT_DRILL_COMMAND() : PCB_EXPORT_BASE_COMM
             .help( UTF8STDSTR( _( "Generate map / summary of drill hits" ) ) )
             .flag();
 
+    m_argParser.add_argument( ARG_OPTIMIZE_HOLE_ORDER )
+            .help( UTF8STDSTR( _( "Order the holes of each tool to shorten the drill travel" ) ) )
+            .flag();
+
     m_argParser.add_argument( ARG_MAP_FORMAT )
             .default_value( std::string( "pdf" ) )
             .help( UTF8STDSTR( _( "Valid options: pdf,gerberx2,ps,dxf,svg" ) ) )
@@ -240,6 +245,7 @@ int CLI::PCB_EXPORT_DRILL_COMMAND::doPerform( KIWAY& aKiway )
     drillJob->m_excellonMinimalHeader = m_argParser.get<bool>( ARG_EXCELLON_MINIMALHEAD );
     drillJob->m_excellonCombinePTHNPTH = !m_argParser.get<bool>( ARG_EXCELLON_SEPARATE_TH );
     drillJob->m_generateMap = m_argParser.get<bool>( ARG_GENERATE_MAP );
+    drillJob->m_optimizeHoleOrder = m_argParser.get<bool>( ARG_OPTIMIZE_HOLE_ORDER );
     drillJob->m_gerberPrecision = m_argParser.get<int>( ARG_GERBER_PRECISION );
 
     if( drillJob->m_gerberPrecision != 5 && drillJob->m_gerberPrecision != 6 )
@@ -0,0 +1,187 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_render.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_pcb_render.h"
+#include <kiface_base.h>
+#include <string_utils.h>
+#include <wx/crt.h>
+#include <wx/tokenzr.h>
+
+#include <macros.h>
+
+#define ARG_WIDTH "--width"
+#define ARG_HEIGHT "--height"
+#define ARG_SIDE "--side"
+#define ARG_QUALITY "--quality"
+#define ARG_ZOOM "--zoom"
+#define ARG_ROTATE "--rotate"
+#define ARG_PERSPECTIVE "--perspective"
+#define ARG_PRESET "--preset"
+
+
+CLI::PCB_RENDER_COMMAND::PCB_RENDER_COMMAND() : COMMAND( "render" )
+{
+    addCommonArgs( true, true, false, false );
+    addDefineArg();
+
+    m_argParser.add_description( UTF8STDSTR( _( "Renders the PCB in 3D view to PNG or JPEG "
+                                                "image with the raytracer, without a display" ) ) );
+
+    m_argParser.add_argument( ARG_WIDTH )
+            .default_value( 1600 )
+            .scan<'i', int>()
+            .help( UTF8STDSTR( _( "Image width" ) ) )
+            .metavar( "WIDTH" );
+
+    m_argParser.add_argument( ARG_HEIGHT )
+            .default_value( 900 )
+            .scan<'i', int>()
+            .help( UTF8STDSTR( _( "Image height" ) ) )
+            .metavar( "HEIGHT" );
+
+    m_argParser.add_argument( ARG_SIDE )
+            .default_value( std::string( "top" ) )
+            .help( UTF8STDSTR( _( "Render from side(s), separated by commas; options: top, "
+                                  "bottom, left, right, front, back.  With several sides, the "
+                                  "side is appended to the output file name" ) ) )
+            .metavar( "SIDES" );
+
+    m_argParser.add_argument( ARG_QUALITY )
+            .default_value( std::string( "basic" ) )
+            .help( UTF8STDSTR( _( "Render quality; options: basic, high, user" ) ) )
+            .metavar( "QUALITY" );
+
+    m_argParser.add_argument( ARG_ZOOM )
+            .default_value( 1.0 )
+            .scan<'g', double>()
+            .help( UTF8STDSTR( _( "Camera zoom" ) ) )
+            .metavar( "ZOOM" );
+
+    m_argParser.add_argument( ARG_ROTATE )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Rotate the board around its X, Y and Z axes after the side "
+                                  "preset, in degrees, e.g. '-45,0,45'" ) ) )
+            .metavar( "ANGLES" );
+
+    m_argParser.add_argument( ARG_PERSPECTIVE )
+            .help( UTF8STDSTR( _( "Use perspective projection instead of orthogonal" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_PRESET )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "3D viewer layer preset to render" ) ) )
+            .metavar( "PRESET" );
+}
+
+
+int CLI::PCB_RENDER_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_RENDER> renderJob( new JOB_PCB_RENDER( true ) );
+
+    renderJob->m_filename = m_argInput;
+    renderJob->m_outputFile = m_argOutput;
+    renderJob->SetVarOverrides( m_argDefineVars );
+
+    renderJob->m_width = m_argParser.get<int>( ARG_WIDTH );
+    renderJob->m_height = m_argParser.get<int>( ARG_HEIGHT );
+    renderJob->m_zoom = m_argParser.get<double>( ARG_ZOOM );
+    renderJob->m_perspective = m_argParser.get<bool>( ARG_PERSPECTIVE );
+    renderJob->m_preset = From_UTF8( m_argParser.get<std::string>( ARG_PRESET ).c_str() );
+
+    if( renderJob->m_width <= 0 || renderJob->m_height <= 0 )
+    {
+        wxFprintf( stderr, _( "Invalid image size\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    if( renderJob->m_zoom <= 0.0 )
+    {
+        wxFprintf( stderr, _( "Invalid zoom\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString quality = From_UTF8( m_argParser.get<std::string>( ARG_QUALITY ).c_str() );
+
+    if( quality == wxS( "basic" ) )
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::BASIC;
+    else if( quality == wxS( "high" ) )
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::HIGH;
+    else if( quality == wxS( "user" ) )
+        renderJob->m_quality = JOB_PCB_RENDER::QUALITY::USER;
+    else
+    {
+        wxFprintf( stderr, _( "Invalid quality\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString          sides = From_UTF8( m_argParser.get<std::string>( ARG_SIDE ).c_str() );
+    wxStringTokenizer sideTokens( sides, wxS( "," ), wxTOKEN_STRTOK );
+
+    renderJob->m_sides.clear();
+
+    while( sideTokens.HasMoreTokens() )
+    {
+        wxString side = sideTokens.GetNextToken().Trim( true ).Trim( false );
+
+        if( side == wxS( "top" ) )
+            renderJob->m_sides.push_back( JOB_PCB_RENDER::SIDE::TOP );
+        else if( side == wxS( "bottom" ) )
+            renderJob->m_sides.push_back( JOB_PCB_RENDER::SIDE::BOTTOM );
+        else if( side == wxS( "left" ) )
+            renderJob->m_sides.push_back( JOB_PCB_RENDER::SIDE::LEFT );
+        else if( side == wxS( "right" ) )
+            renderJob->m_sides.push_back( JOB_PCB_RENDER::SIDE::RIGHT );
+        else if( side == wxS( "front" ) )
+            renderJob->m_sides.push_back( JOB_PCB_RENDER::SIDE::FRONT );
+        else if( side == wxS( "back" ) )
+            renderJob->m_sides.push_back( JOB_PCB_RENDER::SIDE::BACK );
+        else
+        {
+            wxFprintf( stderr, _( "Invalid side '%s'\n" ), side );
+            return EXIT_CODES::ERR_ARGS;
+        }
+    }
+
+    if( renderJob->m_sides.empty() )
+    {
+        wxFprintf( stderr, _( "No side to render\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString rotate = From_UTF8( m_argParser.get<std::string>( ARG_ROTATE ).c_str() );
+
+    if( !rotate.IsEmpty() )
+    {
+        wxArrayString angles = wxSplit( rotate, ',' );
+
+        if( angles.size() != 3 || !angles[0].ToCDouble( &renderJob->m_rotX )
+            || !angles[1].ToCDouble( &renderJob->m_rotY )
+            || !angles[2].ToCDouble( &renderJob->m_rotZ ) )
+        {
+            wxFprintf( stderr, _( "Invalid rotation, expected three angles X,Y,Z\n" ) );
+            return EXIT_CODES::ERR_ARGS;
+        }
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, renderJob.get() );
+
+    return exitCode;
+}
@@ -39,12 +39,19 @@
 
 CLI::SCH_ERC_COMMAND::SCH_ERC_COMMAND() : COMMAND( "erc" )
 {
-    addCommonArgs( true, true, false, false );
+    addCommonArgs( false, true, false, false );
     addDefineArg();
 
     m_argParser.add_description( UTF8STDSTR( _( "Runs the Electrical Rules Check (ERC) on the "
                                                 "schematic and creates a report" ) ) );
 
+    m_argParser.add_argument( ARG_INPUT )
+            .help( UTF8STDSTR( _( "Input file(s); when several schematics are given, they are "
+                                  "checked in one run and the output is a directory receiving "
+                                  "one report per schematic" ) ) )
+            .nargs( argparse::nargs_pattern::at_least_one )
+            .metavar( "INPUT_FILE" );
+
     m_argParser.add_argument( ARG_FORMAT )
             .default_value( std::string( "report" ) )
             .help( UTF8STDSTR( _( "Output file format, options: json, report" ) ) );
@@ -85,8 +92,13 @@ int CLI::SCH_ERC_COMMAND::doPerform( KIWAY& aKiway )
 {
     std::unique_ptr<JOB_SCH_ERC> ercJob( new JOB_SCH_ERC( true ) );
 
+    std::vector<std::string> inputs = m_argParser.get<std::vector<std::string>>( ARG_INPUT );
+
+    for( const std::string& input : inputs )
+        ercJob->m_filenames.push_back( From_UTF8( input.c_str() ) );
+
     ercJob->m_outputFile = m_argOutput;
-    ercJob->m_filename = m_argInput;
+    ercJob->m_filename = ercJob->m_filenames.front();
     ercJob->m_exitCodeViolations = m_argParser.get<bool>( ARG_EXIT_CODE_VIOLATIONS );
     ercJob->SetVarOverrides( m_argDefineVars );
 
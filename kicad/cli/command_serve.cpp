@@ -0,0 +1,126 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_serve.h"
+#include <cli/exit_codes.h>
+#include <wx/crt.h>
+
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include <string_utils.h>
+
+
+CLI::SERVE_COMMAND::SERVE_COMMAND() : COMMAND( "serve" )
+{
+    m_argParser.add_description( UTF8STDSTR( _( "Runs the job requests read from the standard "
+                                                "input, one JSON object per line, keeping the "
+                                                "libraries, the settings and the last board "
+                                                "loaded" ) ) );
+}
+
+
+int CLI::SERVE_COMMAND::doPerform( KIWAY& aKiway )
+{
+    if( !m_runner )
+    {
+        wxFprintf( stderr, _( "A server cannot be started by a batch or a server request\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    auto respond =
+            []( const nlohmann::json& aId, int aExitCode, const wxString& aError )
+            {
+                nlohmann::json response = { { "id", aId }, { "exit_code", aExitCode } };
+
+                if( !aError.IsEmpty() )
+                    response["error"] = std::string( aError.utf8_str() );
+
+                wxPrintf( "%s\n", From_UTF8( response.dump().c_str() ) );
+                fflush( stdout );
+            };
+
+    std::string line;
+
+    while( std::getline( std::cin, line ) )
+    {
+        if( line.find_first_not_of( " \t\r" ) == std::string::npos )
+            continue;
+
+        nlohmann::json request = nlohmann::json::parse( line, nullptr, false );
+
+        if( request.is_discarded() || !request.is_object() )
+        {
+            respond( nullptr, EXIT_CODES::ERR_ARGS, _( "The request is not a JSON object" ) );
+            continue;
+        }
+
+        nlohmann::json id = request.contains( "id" ) ? request["id"] : nlohmann::json();
+
+        if( request.contains( "quit" ) && request["quit"] == true )
+        {
+            respond( id, EXIT_CODES::OK, wxEmptyString );
+            break;
+        }
+
+        std::vector<std::string> args;
+
+        if( request.contains( "args" ) && request["args"].is_array() )
+        {
+            for( const nlohmann::json& arg : request["args"] )
+            {
+                if( arg.is_string() )
+                    args.push_back( arg.get<std::string>() );
+            }
+
+            if( args.size() != request["args"].size() )
+                args.clear();
+        }
+
+        if( args.empty() )
+        {
+            respond( id, EXIT_CODES::ERR_ARGS, _( "The request has no args array of strings" ) );
+            continue;
+        }
+
+        int      result = EXIT_CODES::ERR_UNKNOWN;
+        wxString error;
+
+        // A failed job must not stop the server
+        try
+        {
+            result = m_runner( args );
+        }
+        catch( const std::exception& e )
+        {
+            error = From_UTF8( e.what() );
+        }
+        catch( ... )
+        {
+            error = _( "Unhandled exception" );
+        }
+
+        if( result == EXIT_CODES::AVOID_CLOSING )
+            result = EXIT_CODES::OK;
+
+        respond( id, result, error );
+    }
+
+    return EXIT_CODES::OK;
+}
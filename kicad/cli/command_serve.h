@@ -0,0 +1,58 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMAND_SERVE_H
+#define COMMAND_SERVE_H
+
+#include "command_batch.h"
+
+namespace CLI
+{
+/**
+ * Keep kicad-cli running and read job requests from the standard input.
+ *
+ * Each request is a JSON object on its own line:
+ *
+ *     {"id": 1, "args": ["pcb", "export", "gerbers", "-o", "out/", "board.kicad_pcb"]}
+ *
+ * where args are the arguments that would follow kicad-cli on the command line.  Once the job
+ * is done, its messages are followed by one JSON line on the standard output:
+ *
+ *     {"id": 1, "exit_code": 0}
+ *
+ * The server stops at the end of the input or on a {"quit": true} request.  The kifaces, the
+ * settings and the libraries stay loaded, and the board of the previous job is reused until its
+ * file changes.
+ */
+class SERVE_COMMAND : public COMMAND
+{
+public:
+    SERVE_COMMAND();
+
+    void SetRunner( const BATCH_COMMAND::RUNNER& aRunner ) { m_runner = aRunner; }
+
+protected:
+    int doPerform( KIWAY& aKiway ) override;
+
+private:
+    BATCH_COMMAND::RUNNER m_runner;
+};
+}
+
+#endif
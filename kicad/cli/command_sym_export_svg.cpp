@@ -34,6 +34,7 @@
 #define ARG_SYMBOL "--symbol"
 #define ARG_INC_HIDDEN_PINS "--include-hidden-pins"
 #define ARG_INC_HIDDEN_FIELDS "--include-hidden-fields"
+#define ARG_SKIP_UNCHANGED "--skip-unchanged"
 
 
 CLI::SYM_EXPORT_SVG_COMMAND::SYM_EXPORT_SVG_COMMAND() : COMMAND( "svg" )
@@ -65,6 +66,11 @@ CLI::SYM_EXPORT_SVG_COMMAND::SYM_EXPORT_SVG_COMMAND() : COMMAND( "svg" )
     m_argParser.add_argument( ARG_INC_HIDDEN_FIELDS )
             .help( UTF8STDSTR( _( "Include hidden fields" ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_SKIP_UNCHANGED )
+            .help( UTF8STDSTR( _( "Skip the symbols which did not change since the last "
+                                  "export to the output directory" ) ) )
+            .flag();
 }
 
 
@@ -78,6 +84,7 @@ int CLI::SYM_EXPORT_SVG_COMMAND::doPerform( KIWAY& aKiway )
     svgJob->m_symbol = From_UTF8( m_argParser.get<std::string>( ARG_SYMBOL ).c_str() );
     svgJob->m_includeHiddenFields = m_argParser.get<bool>( ARG_INC_HIDDEN_FIELDS );
     svgJob->m_includeHiddenPins = m_argParser.get<bool>( ARG_INC_HIDDEN_PINS );
+    svgJob->m_skipUnchanged = m_argParser.get<bool>( ARG_SKIP_UNCHANGED );
 
     if( !wxFile::Exists( svgJob->m_libraryPath ) )
     {
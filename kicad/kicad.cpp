@@ -35,6 +35,7 @@
 #include <wx/msgdlg.h>
 #include <wx/cmdline.h>
 
+#include <advanced_config.h>
 #include <env_vars.h>
 #include <file_history.h>
 #include <hotkeys_basic.h>
@@ -362,6 +363,10 @@ bool PGM_KICAD::OnPgmInit()
     frame->Show( true );
     frame->Raise();
 
+    // Load the editors in the background while the user looks at the project
+    if( managerFrame && ADVANCED_CFG::GetCfg().m_PreloadKifaces )
+        Kiway.PreloadKiFACEs( { KIWAY::FACE_SCH, KIWAY::FACE_PCB } );
+
     return true;
 }
 
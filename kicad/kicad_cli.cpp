@@ -31,6 +31,7 @@
 #include <kiway.h>
 #include <string_utils.h>
 #include <paths.h>
+#include <perf_trace.h>
 #include <settings/settings_manager.h>
 #include <settings/kicad_settings.h>
 #include <systemdirsappend.h>
@@ -58,6 +59,8 @@
 #include "cli/command_pcb_export_pdf.h"
 #include "cli/command_pcb_export_pos.h"
 #include "cli/command_pcb_export_svg.h"
+#include "cli/command_pcb_render.h"
+#include "cli/command_pcb_benchmark.h"
 #include "cli/command_sch_export_bom.h"
 #include "cli/command_sch_export_pythonbom.h"
 #include "cli/command_sch_export_netlist.h"
@@ -74,6 +77,8 @@
 #include "cli/command_sym_export_svg.h"
 #include "cli/command_sym_upgrade.h"
 #include "cli/command_version.h"
+#include "cli/command_batch.h"
+#include "cli/command_serve.h"
 #include "cli/exit_codes.h"
 
 // Add this header after all others, to avoid a collision name in a Windows header
@@ -126,119 +131,148 @@ struct COMMAND_ENTRY
             handler( aHandler ), subCommands( aSub ){};
 };
 
-static CLI::PCB_COMMAND                  pcbCmd{};
-static CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
-static CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
-static CLI::PCB_EXPORT_DXF_COMMAND       exportPcbDxfCmd{};
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbGlbCmd{ "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ), JOB_EXPORT_PCB_3D::FORMAT::GLB };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbStepCmd{ "step", UTF8STDSTR( _( "Export STEP" ) ), JOB_EXPORT_PCB_3D::FORMAT::STEP };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbVrmlCmd{ "vrml", UTF8STDSTR( _( "Export VRML" ) ), JOB_EXPORT_PCB_3D::FORMAT::VRML };
-static CLI::PCB_EXPORT_SVG_COMMAND       exportPcbSvgCmd{};
-static CLI::PCB_EXPORT_PDF_COMMAND       exportPcbPdfCmd{};
-static CLI::PCB_EXPORT_POS_COMMAND       exportPcbPosCmd{};
-static CLI::PCB_EXPORT_GERBER_COMMAND    exportPcbGerberCmd{};
-static CLI::PCB_EXPORT_GERBERS_COMMAND   exportPcbGerbersCmd{};
-static CLI::PCB_EXPORT_IPC2581_COMMAND   exportPcbIpc2581Cmd{};
-static CLI::PCB_EXPORT_COMMAND           exportPcbCmd{};
-static CLI::SCH_EXPORT_COMMAND           exportSchCmd{};
-static CLI::SCH_COMMAND                  schCmd{};
-static CLI::SCH_ERC_COMMAND              schErcCmd{};
-static CLI::SCH_EXPORT_BOM_COMMAND       exportSchBomCmd{};
-static CLI::SCH_EXPORT_PYTHONBOM_COMMAND exportSchPythonBomCmd{};
-static CLI::SCH_EXPORT_NETLIST_COMMAND   exportSchNetlistCmd{};
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchDxfCmd{ "dxf", UTF8STDSTR( _( "Export DXF" ) ), SCH_PLOT_FORMAT::DXF };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchHpglCmd{ "hpgl", UTF8STDSTR( _( "Export HPGL" ) ), SCH_PLOT_FORMAT::HPGL };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPdfCmd{ "pdf", UTF8STDSTR( _( "Export PDF" ) ), SCH_PLOT_FORMAT::PDF, false };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPostscriptCmd{ "ps", UTF8STDSTR( _( "Export PS" ) ), SCH_PLOT_FORMAT::POST };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchSvgCmd{ "svg", UTF8STDSTR( _( "Export SVG" ) ), SCH_PLOT_FORMAT::SVG };
-static CLI::FP_COMMAND                   fpCmd{};
-static CLI::FP_EXPORT_COMMAND            fpExportCmd{};
-static CLI::FP_EXPORT_SVG_COMMAND        fpExportSvgCmd{};
-static CLI::FP_UPGRADE_COMMAND           fpUpgradeCmd{};
-static CLI::SYM_COMMAND                  symCmd{};
-static CLI::SYM_EXPORT_COMMAND           symExportCmd{};
-static CLI::SYM_EXPORT_SVG_COMMAND       symExportSvgCmd{};
-static CLI::SYM_UPGRADE_COMMAND          symUpgradeCmd{};
-static CLI::VERSION_COMMAND              versionCmd{};
-
-
-static std::vector<COMMAND_ENTRY> commandStack = {
-    {
-        &fpCmd,
-        {
-            {
-                &fpExportCmd,
+/**
+ * The commands of kicad-cli.
+ *
+ * The argument parsers keep the arguments they parsed, so each command line of a batch is
+ * parsed by its own set of commands.
+ */
+struct CLI_COMMANDS
+{
+    CLI_COMMANDS() :
+            commandStack( {
                 {
-                    &fpExportSvgCmd
-                }
-            },
-            {
-                &fpUpgradeCmd
-            }
-        }
-    },
-    {
-        &pcbCmd,
-        {
-            {
-                &pcbDrcCmd
-            },
-            {
-                &exportPcbCmd,
+                    &fpCmd,
+                    {
+                        {
+                            &fpExportCmd,
+                            {
+                                &fpExportSvgCmd
+                            }
+                        },
+                        {
+                            &fpUpgradeCmd
+                        }
+                    }
+                },
                 {
-                    &exportPcbDrillCmd,
-                    &exportPcbDxfCmd,
-                    &exportPcbGerberCmd,
-                    &exportPcbGerbersCmd,
-                    &exportPcbGlbCmd,
-                    &exportPcbIpc2581Cmd,
-                    &exportPcbPdfCmd,
-                    &exportPcbPosCmd,
-                    &exportPcbStepCmd,
-                    &exportPcbSvgCmd,
-                    &exportPcbVrmlCmd
-                }
-            }
-        }
-    },
-    {
-        &schCmd,
-        {
-            {
-                &schErcCmd
-            },
-            {
-                &exportSchCmd,
+                    &pcbCmd,
+                    {
+                        {
+                            &pcbDrcCmd
+                        },
+                        {
+                            &pcbRenderCmd
+                        },
+                        {
+                            &pcbBenchmarkCmd
+                        },
+                        {
+                            &exportPcbCmd,
+                            {
+                                &exportPcbDrillCmd,
+                                &exportPcbDxfCmd,
+                                &exportPcbGerberCmd,
+                                &exportPcbGerbersCmd,
+                                &exportPcbGlbCmd,
+                                &exportPcbIpc2581Cmd,
+                                &exportPcbPdfCmd,
+                                &exportPcbPosCmd,
+                                &exportPcbStepCmd,
+                                &exportPcbSvgCmd,
+                                &exportPcbVrmlCmd
+                            }
+                        }
+                    }
+                },
                 {
-                    &exportSchDxfCmd,
-                    &exportSchHpglCmd,
-                    &exportSchNetlistCmd,
-                    &exportSchPdfCmd,
-                    &exportSchPostscriptCmd,
-                    &exportSchBomCmd,
-                    &exportSchPythonBomCmd,
-                    &exportSchSvgCmd
-                }
-            }
-        }
-    },
-    {
-        &symCmd,
-        {
-            {
-                &symExportCmd,
+                    &schCmd,
+                    {
+                        {
+                            &schErcCmd
+                        },
+                        {
+                            &exportSchCmd,
+                            {
+                                &exportSchDxfCmd,
+                                &exportSchHpglCmd,
+                                &exportSchNetlistCmd,
+                                &exportSchPdfCmd,
+                                &exportSchPostscriptCmd,
+                                &exportSchBomCmd,
+                                &exportSchPythonBomCmd,
+                                &exportSchSvgCmd
+                            }
+                        }
+                    }
+                },
                 {
-                    &symExportSvgCmd
+                    &symCmd,
+                    {
+                        {
+                            &symExportCmd,
+                            {
+                                &symExportSvgCmd
+                            }
+                        },
+                        {
+                            &symUpgradeCmd
+                        }
+                    }
+                },
+                {
+                        &batchCmd,
+                },
+                {
+                        &serveCmd,
+                },
+                {
+                        &versionCmd,
                 }
-            },
-            {
-                &symUpgradeCmd
-            }
-        }
-    },
+            } )
     {
-            &versionCmd,
     }
+
+    CLI::PCB_COMMAND                  pcbCmd{};
+    CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
+    CLI::PCB_RENDER_COMMAND           pcbRenderCmd{};
+    CLI::PCB_BENCHMARK_COMMAND        pcbBenchmarkCmd{};
+    CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
+    CLI::PCB_EXPORT_DXF_COMMAND       exportPcbDxfCmd{};
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbGlbCmd{ "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ), JOB_EXPORT_PCB_3D::FORMAT::GLB };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbStepCmd{ "step", UTF8STDSTR( _( "Export STEP" ) ), JOB_EXPORT_PCB_3D::FORMAT::STEP };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbVrmlCmd{ "vrml", UTF8STDSTR( _( "Export VRML" ) ), JOB_EXPORT_PCB_3D::FORMAT::VRML };
+    CLI::PCB_EXPORT_SVG_COMMAND       exportPcbSvgCmd{};
+    CLI::PCB_EXPORT_PDF_COMMAND       exportPcbPdfCmd{};
+    CLI::PCB_EXPORT_POS_COMMAND       exportPcbPosCmd{};
+    CLI::PCB_EXPORT_GERBER_COMMAND    exportPcbGerberCmd{};
+    CLI::PCB_EXPORT_GERBERS_COMMAND   exportPcbGerbersCmd{};
+    CLI::PCB_EXPORT_IPC2581_COMMAND   exportPcbIpc2581Cmd{};
+    CLI::PCB_EXPORT_COMMAND           exportPcbCmd{};
+    CLI::SCH_EXPORT_COMMAND           exportSchCmd{};
+    CLI::SCH_COMMAND                  schCmd{};
+    CLI::SCH_ERC_COMMAND              schErcCmd{};
+    CLI::SCH_EXPORT_BOM_COMMAND       exportSchBomCmd{};
+    CLI::SCH_EXPORT_PYTHONBOM_COMMAND exportSchPythonBomCmd{};
+    CLI::SCH_EXPORT_NETLIST_COMMAND   exportSchNetlistCmd{};
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchDxfCmd{ "dxf", UTF8STDSTR( _( "Export DXF" ) ), SCH_PLOT_FORMAT::DXF };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchHpglCmd{ "hpgl", UTF8STDSTR( _( "Export HPGL" ) ), SCH_PLOT_FORMAT::HPGL };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPdfCmd{ "pdf", UTF8STDSTR( _( "Export PDF" ) ), SCH_PLOT_FORMAT::PDF, false };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPostscriptCmd{ "ps", UTF8STDSTR( _( "Export PS" ) ), SCH_PLOT_FORMAT::POST };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchSvgCmd{ "svg", UTF8STDSTR( _( "Export SVG" ) ), SCH_PLOT_FORMAT::SVG };
+    CLI::FP_COMMAND                   fpCmd{};
+    CLI::FP_EXPORT_COMMAND            fpExportCmd{};
+    CLI::FP_EXPORT_SVG_COMMAND        fpExportSvgCmd{};
+    CLI::FP_UPGRADE_COMMAND           fpUpgradeCmd{};
+    CLI::SYM_COMMAND                  symCmd{};
+    CLI::SYM_EXPORT_COMMAND           symExportCmd{};
+    CLI::SYM_EXPORT_SVG_COMMAND       symExportSvgCmd{};
+    CLI::SYM_UPGRADE_COMMAND          symUpgradeCmd{};
+    CLI::BATCH_COMMAND                batchCmd{};
+    CLI::SERVE_COMMAND                serveCmd{};
+    CLI::VERSION_COMMAND              versionCmd{};
+
+    std::vector<COMMAND_ENTRY> commandStack;
 };
 
 
@@ -310,7 +344,7 @@ bool PGM_KICAD::OnPgmInit()
 }
 
 
-int PGM_KICAD::OnPgmRun()
+static int runCommandLine( CLI_COMMANDS& aCommands, int aArgc, char** aArgv )
 {
     argparse::ArgumentParser argParser( std::string( "kicad-cli" ), GetMajorMinorVersion().ToStdString(),
                                         argparse::default_arguments::none );
@@ -327,7 +361,13 @@ int PGM_KICAD::OnPgmRun()
             .implicit_value( true )
             .nargs( 0 );
 
-    for( COMMAND_ENTRY& entry : commandStack )
+    argParser.add_argument( ARG_TRACE )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Writes a trace of the time spent by the command to the "
+                                  "given file, in the Chrome trace event format" ) ) )
+            .metavar( "TRACE_FILE" );
+
+    for( COMMAND_ENTRY& entry : aCommands.commandStack )
     {
         recurseArgParserBuild( argParser, entry );
     }
@@ -337,7 +377,7 @@ int PGM_KICAD::OnPgmRun()
         // Use the C locale to parse arguments
         // Otherwise the decimal separator for the locale will be applied
         LOCALE_IO dummy;
-        argParser.parse_args( m_argcUtf8, m_argvUtf8 );
+        argParser.parse_args( aArgc, aArgv );
     }
     // std::runtime_error doesn't seem to be enough for the scan<>()
     catch( const std::exception& err )
@@ -346,7 +386,7 @@ int PGM_KICAD::OnPgmRun()
 
         // find the correct argparser object to output the command usage info
         COMMAND_ENTRY* cliCmd = nullptr;
-        for( COMMAND_ENTRY& entry : commandStack )
+        for( COMMAND_ENTRY& entry : aCommands.commandStack )
         {
             if( argParser.is_subcommand_used( entry.handler->GetName() ) )
             {
@@ -381,12 +421,12 @@ int PGM_KICAD::OnPgmRun()
     // the version arg gets redirected to the version subcommand
     if( argParser[ARG_VERSION] == true )
     {
-        cliCmd = &versionCmd;
+        cliCmd = &aCommands.versionCmd;
     }
 
     if( !cliCmd )
     {
-        for( COMMAND_ENTRY& entry : commandStack )
+        for( COMMAND_ENTRY& entry : aCommands.commandStack )
         {
             if( argParser.is_subcommand_used( entry.handler->GetName() ) )
             {
@@ -402,7 +442,22 @@ int PGM_KICAD::OnPgmRun()
 
     if( cliCmd )
     {
-        int exitCode = cliCmd->Perform( Kiway );
+        wxString traceFile = From_UTF8( argParser.get<std::string>( ARG_TRACE ).c_str() );
+        int      exitCode;
+
+        if( !traceFile.IsEmpty() )
+        {
+            PERF_TRACE::Start();
+            PERF_TRACE::SetThreadName( wxS( "Main" ) );
+        }
+
+        {
+            SCOPED_TRACE_ZONE traceZone( "CLI command", From_UTF8( cliCmd->GetName().c_str() ) );
+            exitCode = cliCmd->Perform( Kiway );
+        }
+
+        if( !traceFile.IsEmpty() && !PERF_TRACE::Write( traceFile ) )
+            wxFprintf( stderr, _( "Failed to write the trace file '%s'.\n" ), traceFile );
 
         if( exitCode != CLI::EXIT_CODES::AVOID_CLOSING )
         {
@@ -422,6 +477,32 @@ int PGM_KICAD::OnPgmRun()
 }
 
 
+int PGM_KICAD::OnPgmRun()
+{
+    CLI_COMMANDS commands;
+
+    CLI::BATCH_COMMAND::RUNNER runner =
+            []( const std::vector<std::string>& aArgs ) -> int
+            {
+                // The commands of a batch or a server share the loaded kifaces, settings and boards
+                CLI_COMMANDS             lineCommands;
+                std::vector<std::string> args = aArgs;
+                std::string              program( "kicad-cli" );
+                std::vector<char*>       argv = { program.data() };
+
+                for( std::string& arg : args )
+                    argv.push_back( arg.data() );
+
+                return runCommandLine( lineCommands, (int) argv.size(), argv.data() );
+            };
+
+    commands.batchCmd.SetRunner( runner );
+    commands.serveCmd.SetRunner( runner );
+
+    return runCommandLine( commands, m_argcUtf8, m_argvUtf8 );
+}
+
+
 void PGM_KICAD::OnPgmExit()
 {
     Kiway.OnKiwayEnd();
@@ -260,6 +260,5 @@ void UPDATE_MANAGER::CheckForUpdate( wxWindow* aNoticeParent )
         m_working = false;
     };
 
-    thread_pool& tp = GetKiCadThreadPool();
-    tp.push_task( update_check );
+    ScheduleTask( TASK_PRIORITY::BACKGROUND, update_check );
 }
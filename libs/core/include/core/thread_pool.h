@@ -25,6 +25,11 @@
 #ifndef INCLUDE_THREAD_POOL_H_
 #define INCLUDE_THREAD_POOL_H_
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+
 #include <bs_thread_pool.hpp>
 
 using thread_pool = BS::thread_pool;
@@ -39,4 +44,81 @@ using thread_pool = BS::thread_pool;
 thread_pool& GetKiCadThreadPool();
 
 
+/**
+ * The classes of the tasks run by ScheduleTask(), from the most to the least urgent.
+ *
+ * A free thread always starts the most urgent task queued, and the background tasks never
+ * use the last thread of the pool, so that the other tasks don't wait for them.
+ */
+enum class TASK_PRIORITY
+{
+    INTERACTIVE,    ///< Needed to answer the user, such as the ratsnest or the router
+    FOREGROUND,     ///< Batch work the user waits for, such as zone filling or DRC
+    BACKGROUND      ///< Work nobody waits for yet, such as loading the libraries
+};
+
+
+/**
+ * A flag shared by a group of tasks to cancel them.
+ *
+ * The tasks not started yet when it is set are dropped; the running ones may poll it.
+ */
+class CANCELLATION_TOKEN
+{
+public:
+    CANCELLATION_TOKEN() :
+            m_cancelled( std::make_shared<std::atomic<bool>>( false ) )
+    {
+    }
+
+    void Cancel() { m_cancelled->store( true ); }
+
+    bool IsCancelled() const { return m_cancelled->load(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+
+/**
+ * Queue \a aTask to run on the pool, before the less urgent tasks queued.
+ *
+ * @param aToken is an optional token; the task is dropped if it is cancelled before the task
+ *               starts.
+ */
+void ScheduleTask( TASK_PRIORITY aPriority, std::function<void()> aTask,
+                   const CANCELLATION_TOKEN* aToken = nullptr );
+
+
+/**
+ * Queue \a aTask to run on the pool, like ScheduleTask(), and return its result.
+ *
+ * The future of a task dropped by \a aToken holds a std::future_error (broken promise).
+ */
+template <typename F, typename R = std::invoke_result_t<std::decay_t<F>>>
+std::future<R> SubmitTask( TASK_PRIORITY aPriority, F&& aTask,
+                           const CANCELLATION_TOKEN* aToken = nullptr )
+{
+    auto           task = std::make_shared<std::packaged_task<R()>>( std::forward<F>( aTask ) );
+    std::future<R> future = task->get_future();
+
+    ScheduleTask( aPriority, [task]() { ( *task )(); }, aToken );
+
+    return future;
+}
+
+
+/**
+ * Call \a aFunction( ii ) for each ii in [0, \a aCount), on the calling thread and on the free
+ * threads of the pool.
+ *
+ * Unlike thread_pool::parallelize_loop(), this only waits for the calls already running, not
+ * for tasks still queued behind others, so it can be used from a task of the pool as well.
+ * When it is, only the idle threads are asked to help, so nested loops don't queue more
+ * tasks than the pool can run.
+ */
+void ParallelForEachIndex( size_t aCount, const std::function<void( size_t )>& aFunction,
+                           TASK_PRIORITY aPriority = TASK_PRIORITY::FOREGROUND );
+
+
 #endif /* INCLUDE_THREAD_POOL_H_ */
@@ -24,6 +24,14 @@
 
 #include <core/thread_pool.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
 // Under mingw, there is a problem with the destructor when creating a static instance
 // of a thread_pool: probably the DTOR is called too late, and the application hangs.
 // so we create it on the heap.
@@ -39,3 +47,176 @@ thread_pool& GetKiCadThreadPool()
 
     return *tp;
 }
+
+
+namespace
+{
+
+struct SCHEDULED_TASK
+{
+    std::function<void()>             m_task;
+    std::optional<CANCELLATION_TOKEN> m_token;
+};
+
+
+/**
+ * The queues of ScheduleTask().  Each task pushes one runner on the pool, which starts the most
+ * urgent task queued when it gets a thread, so the FIFO order of the pool doesn't matter.
+ */
+struct SCHEDULER
+{
+    std::mutex                 m_mutex;
+    std::deque<SCHEDULED_TASK> m_queues[3];
+    size_t                     m_runningBackground = 0;
+};
+
+
+// Never destroyed, for the same reason as the pool
+SCHEDULER& getScheduler()
+{
+    static SCHEDULER* scheduler = new SCHEDULER;
+    return *scheduler;
+}
+
+
+// Set on the threads running a scheduled task, to tell the nested parallel loops
+thread_local bool inScheduledTask = false;
+
+
+void runNextTask()
+{
+    SCHEDULER&     scheduler = getScheduler();
+    thread_pool&   pool = GetKiCadThreadPool();
+    SCHEDULED_TASK task;
+    bool           background = false;
+
+    {
+        std::lock_guard<std::mutex> lock( scheduler.m_mutex );
+
+        size_t maxBackground = std::max<size_t>( 1, pool.get_thread_count() - 1 );
+        bool   found = false;
+
+        for( int ii = 0; ii < 3 && !found; ++ii )
+        {
+            std::deque<SCHEDULED_TASK>& queue = scheduler.m_queues[ii];
+
+            background = ( ii == static_cast<int>( TASK_PRIORITY::BACKGROUND ) );
+
+            if( queue.empty() || ( background && scheduler.m_runningBackground >= maxBackground ) )
+                continue;
+
+            task = std::move( queue.front() );
+            queue.pop_front();
+            found = true;
+        }
+
+        // The task of this runner was started by another one, or is a background task held
+        // back by the limit, which a finishing background task will start
+        if( !found )
+            return;
+
+        if( background )
+            scheduler.m_runningBackground++;
+    }
+
+    if( !task.m_token || !task.m_token->IsCancelled() )
+    {
+        bool wasInScheduledTask = inScheduledTask;
+
+        inScheduledTask = true;
+        task.m_task();
+        inScheduledTask = wasInScheduledTask;
+    }
+
+    if( background )
+    {
+        std::lock_guard<std::mutex> lock( scheduler.m_mutex );
+
+        scheduler.m_runningBackground--;
+
+        if( !scheduler.m_queues[static_cast<int>( TASK_PRIORITY::BACKGROUND )].empty() )
+            pool.push_task( runNextTask );
+    }
+}
+
+} // namespace
+
+
+void ScheduleTask( TASK_PRIORITY aPriority, std::function<void()> aTask,
+                   const CANCELLATION_TOKEN* aToken )
+{
+    SCHEDULER& scheduler = getScheduler();
+
+    {
+        std::lock_guard<std::mutex> lock( scheduler.m_mutex );
+
+        SCHEDULED_TASK& task = scheduler.m_queues[static_cast<int>( aPriority )].emplace_back();
+        task.m_task = std::move( aTask );
+
+        if( aToken )
+            task.m_token = *aToken;
+    }
+
+    GetKiCadThreadPool().push_task( runNextTask );
+}
+
+
+void ParallelForEachIndex( size_t aCount, const std::function<void( size_t )>& aFunction,
+                           TASK_PRIORITY aPriority )
+{
+    if( aCount == 0 )
+        return;
+
+    // Shared with the helper tasks, which may only start after we've returned
+    struct STATE
+    {
+        size_t                               m_count;
+        const std::function<void( size_t )>* m_function;
+        std::atomic<size_t>                  m_next = 0;
+        std::atomic<size_t>                  m_running = 0;
+        std::mutex                           m_mutex;
+        std::condition_variable              m_done;
+    };
+
+    std::shared_ptr<STATE> state = std::make_shared<STATE>();
+    state->m_count = aCount;
+    state->m_function = &aFunction;
+
+    // Only indices claimed before the last one is taken call aFunction, so once the calling
+    // thread has found nothing left to claim it only has to wait for the running helpers.
+    auto run =
+            []( STATE& aState )
+            {
+                for( size_t ii = aState.m_next++; ii < aState.m_count; ii = aState.m_next++ )
+                    ( *aState.m_function )( ii );
+            };
+
+    thread_pool& pool = GetKiCadThreadPool();
+    size_t       threads = pool.get_thread_count();
+
+    if( inScheduledTask )
+        threads -= std::min<size_t>( threads, pool.get_tasks_running() );
+
+    size_t helpers = std::min<size_t>( threads, aCount - 1 );
+
+    for( size_t ii = 0; ii < helpers; ++ii )
+    {
+        ScheduleTask( aPriority,
+                [state, run]()
+                {
+                    state->m_running++;
+                    run( *state );
+
+                    if( --state->m_running == 0 )
+                    {
+                        std::lock_guard<std::mutex> lock( state->m_mutex );
+                        state->m_done.notify_all();
+                    }
+                } );
+    }
+
+    run( *state );
+
+    std::unique_lock<std::mutex> lock( state->m_mutex );
+    state->m_done.wait( lock, [&]() { return state->m_running == 0; } );
+}
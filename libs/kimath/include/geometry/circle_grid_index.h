@@ -0,0 +1,241 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef CIRCLE_GRID_INDEX_H
+#define CIRCLE_GRID_INDEX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <math/vector2d.h>
+
+
+/**
+ * A uniform grid of small circles (typically drill holes), for finding the circles closer
+ * than a clearance to each other.
+ *
+ * The circles are all added first and the grid is then built in one go.  Their centres and
+ * radii are stored as separate arrays sorted by grid cell, so scanning a cell touches
+ * contiguous memory only.  The cells are sized after the largest circle and clearance, so
+ * that a query only needs to look at the neighbouring cells when the radii are similar.
+ *
+ * Circles are identified by the order in which they were added.
+ */
+template <class DATA>
+class CIRCLE_GRID_INDEX
+{
+public:
+    void Reserve( size_t aCount )
+    {
+        m_addedCenters.reserve( aCount );
+        m_addedRadii.reserve( aCount );
+        m_data.reserve( aCount );
+    }
+
+    void Add( const VECTOR2I& aCenter, int aRadius, const DATA& aData )
+    {
+        m_addedCenters.push_back( aCenter );
+        m_addedRadii.push_back( aRadius );
+        m_data.push_back( aData );
+    }
+
+    void Clear()
+    {
+        m_addedCenters.clear();
+        m_addedRadii.clear();
+        m_data.clear();
+        m_x.clear();
+        m_y.clear();
+        m_r.clear();
+        m_index.clear();
+        m_cellStart.clear();
+        m_maxRadius = 0;
+    }
+
+    /**
+     * Sort the circles into the grid.  \a aClearance is the largest clearance which will be
+     * queried.
+     */
+    void Build( int aClearance )
+    {
+        const size_t count = m_data.size();
+
+        m_x.clear();
+        m_y.clear();
+        m_r.clear();
+        m_index.clear();
+        m_cellStart.clear();
+        m_maxRadius = 0;
+
+        if( count == 0 )
+            return;
+
+        int64_t minX = m_addedCenters[0].x;
+        int64_t minY = m_addedCenters[0].y;
+        int64_t maxX = minX;
+        int64_t maxY = minY;
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            minX = std::min<int64_t>( minX, m_addedCenters[ii].x );
+            minY = std::min<int64_t>( minY, m_addedCenters[ii].y );
+            maxX = std::max<int64_t>( maxX, m_addedCenters[ii].x );
+            maxY = std::max<int64_t>( maxY, m_addedCenters[ii].y );
+            m_maxRadius = std::max( m_maxRadius, m_addedRadii[ii] );
+        }
+
+        // Two of the largest circles at the clearance fit in a cell...
+        double cellSize = std::max( 1.0, 2.0 * m_maxRadius + std::max( 0, aClearance ) );
+
+        // ... unless that would make a very sparse grid
+        double cells = ( ( maxX - minX ) / cellSize + 1 ) * ( ( maxY - minY ) / cellSize + 1 );
+        double maxCells = 4.0 * count + 1024;
+
+        if( cells > maxCells )
+            cellSize *= std::sqrt( cells / maxCells );
+
+        m_originX = minX;
+        m_originY = minY;
+        m_cellSize = cellSize;
+        m_cols = (int) ( ( maxX - minX ) / cellSize ) + 1;
+        m_rows = (int) ( ( maxY - minY ) / cellSize ) + 1;
+
+        // Counting sort of the circles by cell, keeping the insertion order within each cell
+        std::vector<size_t> cellOf( count );
+        m_cellStart.assign( (size_t) m_cols * m_rows + 1, 0 );
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            cellOf[ii] = cellIndex( col( m_addedCenters[ii].x ), row( m_addedCenters[ii].y ) );
+            m_cellStart[cellOf[ii] + 1]++;
+        }
+
+        for( size_t cell = 1; cell < m_cellStart.size(); ++cell )
+            m_cellStart[cell] += m_cellStart[cell - 1];
+
+        std::vector<size_t> next( m_cellStart.begin(), m_cellStart.end() - 1 );
+
+        m_x.resize( count );
+        m_y.resize( count );
+        m_r.resize( count );
+        m_index.resize( count );
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            size_t slot = next[cellOf[ii]]++;
+
+            m_x[slot] = m_addedCenters[ii].x;
+            m_y[slot] = m_addedCenters[ii].y;
+            m_r[slot] = m_addedRadii[ii];
+            m_index[slot] = ii;
+        }
+    }
+
+    /**
+     * Find the circles closer than \a aClearance to the given one (or concentric with it),
+     * which includes the given circle itself if it was added.
+     *
+     * @param aResults receives the indices of the circles found, in insertion order.
+     */
+    void Query( const VECTOR2I& aCenter, int aRadius, int aClearance,
+                std::vector<size_t>& aResults ) const
+    {
+        aResults.clear();
+
+        if( m_index.empty() )
+            return;
+
+        const int64_t reach = (int64_t) std::max( 0, aClearance ) + aRadius + m_maxRadius;
+        const int     col0 = col( aCenter.x - reach );
+        const int     col1 = col( aCenter.x + reach );
+        const int     row0 = row( aCenter.y - reach );
+        const int     row1 = row( aCenter.y + reach );
+
+        for( int r = row0; r <= row1; ++r )
+        {
+            for( int c = col0; c <= col1; ++c )
+            {
+                size_t cell = cellIndex( c, r );
+
+                for( size_t ii = m_cellStart[cell]; ii < m_cellStart[cell + 1]; ++ii )
+                {
+                    int64_t dx = m_x[ii] - aCenter.x;
+                    int64_t dy = m_y[ii] - aCenter.y;
+                    int64_t distSq = dx * dx + dy * dy;
+                    int64_t minDist = (int64_t) aClearance + aRadius + m_r[ii];
+
+                    if( distSq == 0 || distSq < minDist * minDist )
+                        aResults.push_back( m_index[ii] );
+                }
+            }
+        }
+
+        std::sort( aResults.begin(), aResults.end() );
+    }
+
+    size_t size() const { return m_data.size(); }
+    bool   empty() const { return m_data.empty(); }
+
+    const DATA&     Data( size_t aIndex ) const { return m_data[aIndex]; }
+    const VECTOR2I& Center( size_t aIndex ) const { return m_addedCenters[aIndex]; }
+    int             Radius( size_t aIndex ) const { return m_addedRadii[aIndex]; }
+
+private:
+    int col( int64_t aX ) const
+    {
+        double c = std::floor( ( aX - m_originX ) / m_cellSize );
+        return (int) std::clamp( c, 0.0, (double) m_cols - 1 );
+    }
+
+    int row( int64_t aY ) const
+    {
+        double r = std::floor( ( aY - m_originY ) / m_cellSize );
+        return (int) std::clamp( r, 0.0, (double) m_rows - 1 );
+    }
+
+    size_t cellIndex( int aCol, int aRow ) const { return (size_t) aRow * m_cols + aCol; }
+
+private:
+    // As added
+    std::vector<VECTOR2I> m_addedCenters;
+    std::vector<int>      m_addedRadii;
+    std::vector<DATA>     m_data;
+
+    // Sorted by cell
+    std::vector<int>      m_x;
+    std::vector<int>      m_y;
+    std::vector<int>      m_r;
+    std::vector<size_t>   m_index;
+    std::vector<size_t>   m_cellStart;
+
+    int64_t               m_originX = 0;
+    int64_t               m_originY = 0;
+    double                m_cellSize = 1.0;
+    int                   m_cols = 0;
+    int                   m_rows = 0;
+    int                   m_maxRadius = 0;
+};
+
+#endif // CIRCLE_GRID_INDEX_H
@@ -0,0 +1,82 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef INFLATE_CACHE_H
+#define INFLATE_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include <geometry/corner_strategy.h>
+#include <geometry/shape_poly_set.h>
+
+
+/**
+ * A bounded memo of SHAPE_POLY_SET::Inflate() results.
+ *
+ * The same outlines are often inflated by the same amounts over and over (pad clearances seen
+ * by every zone, DRC, plotting...).  Callers that know this can opt in by inflating through a
+ * cache rather than calling SHAPE_POLY_SET::Inflate() directly.  Entries are keyed by the hash
+ * of the geometry and the inflate parameters, so they never go stale; the least recently used
+ * entries are dropped once the cache is full.
+ *
+ * The cache is thread safe.
+ */
+class INFLATE_CACHE
+{
+public:
+    INFLATE_CACHE( size_t aCapacity = 256 ) :
+            m_capacity( aCapacity ),
+            m_hits( 0 )
+    {}
+
+    /**
+     * Same as SHAPE_POLY_SET::Inflate(), but reuse the result of an earlier identical call if
+     * there is one.
+     */
+    void Inflate( SHAPE_POLY_SET& aPolySet, int aAmount, CORNER_STRATEGY aCornerStrategy,
+                  int aMaxError, bool aSimplify = false );
+
+    void Clear();
+
+    size_t Size() const;
+
+    /// @return the number of Inflate() calls answered from the cache.
+    size_t Hits() const;
+
+private:
+    typedef std::tuple<std::string, int, int, int, bool> KEY;
+    typedef std::list<std::pair<KEY, SHAPE_POLY_SET>>     LRU_LIST;
+
+    size_t                            m_capacity;
+    size_t                            m_hits;
+    LRU_LIST                          m_lru;          ///< Most recently used first
+    std::map<KEY, LRU_LIST::iterator> m_entries;
+    mutable std::mutex                m_mutex;
+};
+
+#endif // INFLATE_CACHE_H
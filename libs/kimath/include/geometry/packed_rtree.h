@@ -0,0 +1,322 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PACKED_RTREE_H
+#define PACKED_RTREE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <wx/debug.h>
+
+
+/**
+ * A static R-tree bulk-loaded with Sort-Tile-Recursive packing.
+ *
+ * All the items are added first and the tree is then built in one go, which is much faster
+ * than inserting them one by one into a dynamic R-tree and gives fully packed nodes.  Bounding
+ * boxes are stored as separate arrays of coordinates (leaves in tree order), so scanning the
+ * children of a node touches contiguous memory only.
+ *
+ * Items added after Build() are not searchable until the next Build().  Boxes are inclusive,
+ * as in the dynamic RTree.
+ */
+template <class DATA, int NODE_SIZE = 16>
+class PACKED_RTREE
+{
+public:
+    PACKED_RTREE() :
+            m_built( true )
+    { }
+
+    void Reserve( size_t aCount )
+    {
+        m_minX.reserve( aCount );
+        m_minY.reserve( aCount );
+        m_maxX.reserve( aCount );
+        m_maxY.reserve( aCount );
+        m_data.reserve( aCount );
+    }
+
+    void Add( const int aMin[2], const int aMax[2], const DATA& aData )
+    {
+        m_minX.push_back( aMin[0] );
+        m_minY.push_back( aMin[1] );
+        m_maxX.push_back( aMax[0] );
+        m_maxY.push_back( aMax[1] );
+        m_data.push_back( aData );
+        m_built = false;
+    }
+
+    void Clear()
+    {
+        m_minX.clear();
+        m_minY.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_data.clear();
+        m_nodeMinX.clear();
+        m_nodeMinY.clear();
+        m_nodeMaxX.clear();
+        m_nodeMaxY.clear();
+        m_levelStart.clear();
+        m_built = true;
+    }
+
+    /**
+     * Sort the items into tiles and build the node levels above them.
+     */
+    void Build()
+    {
+        if( m_built )
+            return;
+
+        m_built = true;
+        m_nodeMinX.clear();
+        m_nodeMinY.clear();
+        m_nodeMaxX.clear();
+        m_nodeMaxY.clear();
+        m_levelStart.clear();
+
+        const size_t count = m_data.size();
+
+        if( count == 0 )
+            return;
+
+        // Sort-Tile-Recursive: sort by x into vertical slices of whole nodes, then each slice
+        // by y, so that consecutive runs of NODE_SIZE items are compact tiles.
+        const size_t leafNodes = ( count + NODE_SIZE - 1 ) / NODE_SIZE;
+        const size_t slices = (size_t) std::ceil( std::sqrt( (double) leafNodes ) );
+        const size_t sliceSize = slices * NODE_SIZE;
+
+        std::vector<size_t> order( count );
+        std::iota( order.begin(), order.end(), 0 );
+
+        auto centerX =
+                [&]( size_t ii )
+                {
+                    return (int64_t) m_minX[ii] + m_maxX[ii];
+                };
+
+        auto centerY =
+                [&]( size_t ii )
+                {
+                    return (int64_t) m_minY[ii] + m_maxY[ii];
+                };
+
+        std::sort( order.begin(), order.end(),
+                   [&]( size_t a, size_t b )
+                   {
+                       return centerX( a ) < centerX( b );
+                   } );
+
+        for( size_t start = 0; start < count; start += sliceSize )
+        {
+            size_t end = std::min( count, start + sliceSize );
+
+            std::sort( order.begin() + start, order.begin() + end,
+                       [&]( size_t a, size_t b )
+                       {
+                           return centerY( a ) < centerY( b );
+                       } );
+        }
+
+        permute( m_minX, order );
+        permute( m_minY, order );
+        permute( m_maxX, order );
+        permute( m_maxY, order );
+        permute( m_data, order );
+
+        // Build the node levels bottom-up, each node covering NODE_SIZE consecutive children
+        // of the level below
+        size_t childCount = count;
+        bool   leafLevel = true;
+
+        while( true )
+        {
+            size_t childStart = leafLevel ? 0 : m_levelStart.back();
+            size_t nodeCount = ( childCount + NODE_SIZE - 1 ) / NODE_SIZE;
+
+            m_levelStart.push_back( m_nodeMinX.size() );
+
+            for( size_t node = 0; node < nodeCount; ++node )
+            {
+                size_t first = childStart + node * NODE_SIZE;
+                size_t last = std::min( childStart + childCount, first + NODE_SIZE );
+
+                const std::vector<int>& minX = leafLevel ? m_minX : m_nodeMinX;
+                const std::vector<int>& minY = leafLevel ? m_minY : m_nodeMinY;
+                const std::vector<int>& maxX = leafLevel ? m_maxX : m_nodeMaxX;
+                const std::vector<int>& maxY = leafLevel ? m_maxY : m_nodeMaxY;
+
+                int x0 = minX[first];
+                int y0 = minY[first];
+                int x1 = maxX[first];
+                int y1 = maxY[first];
+
+                for( size_t ii = first + 1; ii < last; ++ii )
+                {
+                    x0 = std::min( x0, minX[ii] );
+                    y0 = std::min( y0, minY[ii] );
+                    x1 = std::max( x1, maxX[ii] );
+                    y1 = std::max( y1, maxY[ii] );
+                }
+
+                m_nodeMinX.push_back( x0 );
+                m_nodeMinY.push_back( y0 );
+                m_nodeMaxX.push_back( x1 );
+                m_nodeMaxY.push_back( y1 );
+            }
+
+            if( nodeCount == 1 )
+                break;
+
+            childCount = nodeCount;
+            leafLevel = false;
+        }
+
+        wxASSERT( m_levelStart.size() <= MAX_DEPTH );
+    }
+
+    /**
+     * Visit the items whose boxes overlap the given one, until \a aVisitor returns false.
+     *
+     * @return false if the search was stopped by the visitor.
+     */
+    template <class VISITOR>
+    bool Search( const int aMin[2], const int aMax[2], VISITOR& aVisitor ) const
+    {
+        wxASSERT_MSG( m_built, wxT( "PACKED_RTREE searched before Build()" ) );
+
+        if( m_levelStart.empty() )
+            return true;
+
+        struct STACK_ENTRY
+        {
+            int    m_level;
+            size_t m_node;
+        };
+
+        STACK_ENTRY stack[MAX_DEPTH * NODE_SIZE];
+        int         top = 0;
+        const int   rootLevel = (int) m_levelStart.size() - 1;
+
+        if( overlaps( m_nodeMinX, m_nodeMinY, m_nodeMaxX, m_nodeMaxY, m_levelStart[rootLevel],
+                      aMin, aMax ) )
+        {
+            stack[top++] = { rootLevel, m_levelStart[rootLevel] };
+        }
+
+        while( top > 0 )
+        {
+            STACK_ENTRY entry = stack[--top];
+            size_t      local = entry.m_node - m_levelStart[entry.m_level];
+
+            if( entry.m_level == 0 )
+            {
+                size_t first = local * NODE_SIZE;
+                size_t last = std::min( m_data.size(), first + NODE_SIZE );
+
+                for( size_t ii = first; ii < last; ++ii )
+                {
+                    if( overlaps( m_minX, m_minY, m_maxX, m_maxY, ii, aMin, aMax ) )
+                    {
+                        if( !aVisitor( m_data[ii] ) )
+                            return false;
+                    }
+                }
+            }
+            else
+            {
+                size_t childStart = m_levelStart[entry.m_level - 1];
+                size_t first = childStart + local * NODE_SIZE;
+                size_t last = std::min( m_levelStart[entry.m_level], first + NODE_SIZE );
+
+                for( size_t ii = first; ii < last; ++ii )
+                {
+                    if( overlaps( m_nodeMinX, m_nodeMinY, m_nodeMaxX, m_nodeMaxY, ii, aMin,
+                                  aMax ) )
+                    {
+                        stack[top++] = { entry.m_level - 1, ii };
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    size_t size() const { return m_data.size(); }
+    bool   empty() const { return m_data.empty(); }
+
+    /**
+     * @return all the items, in tree order once built.
+     */
+    const std::vector<DATA>& Data() const { return m_data; }
+
+private:
+    // A 16-wide tree this deep would hold 16^16 items
+    static constexpr int MAX_DEPTH = 16;
+
+    template <class T>
+    static void permute( std::vector<T>& aValues, const std::vector<size_t>& aOrder )
+    {
+        std::vector<T> sorted;
+        sorted.reserve( aValues.size() );
+
+        for( size_t ii : aOrder )
+            sorted.push_back( std::move( aValues[ii] ) );
+
+        aValues = std::move( sorted );
+    }
+
+    static bool overlaps( const std::vector<int>& aMinX, const std::vector<int>& aMinY,
+                          const std::vector<int>& aMaxX, const std::vector<int>& aMaxY, size_t aIdx,
+                          const int aMin[2], const int aMax[2] )
+    {
+        return aMin[0] <= aMaxX[aIdx] && aMax[0] >= aMinX[aIdx]
+                && aMin[1] <= aMaxY[aIdx] && aMax[1] >= aMinY[aIdx];
+    }
+
+private:
+    bool                m_built;
+
+    // Leaves
+    std::vector<int>    m_minX;
+    std::vector<int>    m_minY;
+    std::vector<int>    m_maxX;
+    std::vector<int>    m_maxY;
+    std::vector<DATA>   m_data;
+
+    // Nodes of all levels, leaf parents first and root last
+    std::vector<int>    m_nodeMinX;
+    std::vector<int>    m_nodeMinY;
+    std::vector<int>    m_nodeMaxX;
+    std::vector<int>    m_nodeMaxY;
+    std::vector<size_t> m_levelStart;
+};
+
+#endif // PACKED_RTREE_H
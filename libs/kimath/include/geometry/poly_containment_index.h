@@ -0,0 +1,89 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef POLY_CONTAINMENT_INDEX_H
+#define POLY_CONTAINMENT_INDEX_H
+
+#include <vector>
+
+#include <math/vector2d.h>
+
+class SHAPE_POLY_SET;
+
+
+/**
+ * A spatial index for answering many point-in-polygon queries against a single #SHAPE_POLY_SET.
+ *
+ * The edges of all outlines and holes are bucketed into horizontal strips once, so that each
+ * query only has to ray-cast against the edges crossing its own strip rather than against every
+ * edge of the set.  Results are identical to SHAPE_POLY_SET::Contains( aPt, -1, 1 ).
+ *
+ * The index keeps a copy of the edges, so the source set may be modified or destroyed after
+ * the index has been built.
+ */
+class POLY_CONTAINMENT_INDEX
+{
+public:
+    /**
+     * @param aStripCount is the number of horizontal strips to use, or -1 to pick one based on
+     *                    the number of edges.
+     */
+    POLY_CONTAINMENT_INDEX( const SHAPE_POLY_SET& aPolySet, int aStripCount = -1 );
+
+    /**
+     * @return true if \a aPt is inside one of the outlines of the set and not inside any of
+     *         that outline's holes.
+     */
+    bool Contains( const VECTOR2I& aPt ) const;
+
+    /**
+     * Test a batch of points.  The points are swept strip-by-strip, which keeps each strip's
+     * edges hot in the cache.
+     *
+     * @return a vector of results in the same order as \a aPoints.
+     */
+    std::vector<bool> Contains( const std::vector<VECTOR2I>& aPoints ) const;
+
+private:
+    struct EDGE
+    {
+        VECTOR2I m_p1;
+        VECTOR2I m_p2;
+        int      m_contour;
+    };
+
+    int stripIndex( int aY ) const;
+
+    bool containsInStrip( const VECTOR2I& aPt, int aStrip, std::vector<int>& aCrossings ) const;
+
+private:
+    int                            m_top;
+    int                            m_bottom;
+    int                            m_stripHeight;
+    std::vector<std::vector<EDGE>> m_strips;
+
+    ///< For each contour, the index of its polygon's outline contour
+    std::vector<int>               m_outlineOf;
+};
+
+#endif // POLY_CONTAINMENT_INDEX_H
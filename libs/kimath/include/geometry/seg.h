@@ -27,6 +27,7 @@
 #ifndef __SEG_H
 #define __SEG_H
 
+#include <algorithm>                    // for min, max
 #include <math.h>                       // for sqrt
 #include <stdlib.h>                     // for abs
 #include <optional>
@@ -245,6 +246,33 @@ public:
         return ( NearestPoint( aP ) - aP ).SquaredEuclideanNorm();
     }
 
+    /**
+     * Compute the squared distance from the bounding box of the segment to point \a aP.
+     *
+     * This is never more than SquaredDistance( aP ), and a lot cheaper: loops over many
+     * segments use it to skip those which can't be closer than the best one found so far.
+     */
+    ecoord SquaredBoxDistance( const VECTOR2I& aP ) const
+    {
+        ecoord dx = boxGap( A.x, B.x, aP.x, aP.x );
+        ecoord dy = boxGap( A.y, B.y, aP.y, aP.y );
+
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     * Compute the squared distance between the bounding boxes of this segment and \a aSeg.
+     *
+     * This is never more than SquaredDistance( aSeg ); see SquaredBoxDistance( aP ).
+     */
+    ecoord SquaredBoxDistance( const SEG& aSeg ) const
+    {
+        ecoord dx = boxGap( A.x, B.x, aSeg.A.x, aSeg.B.x );
+        ecoord dy = boxGap( A.y, B.y, aSeg.A.y, aSeg.B.y );
+
+        return dx * dx + dy * dy;
+    }
+
     /**
      * Compute minimum Euclidean distance to point \a aP.
      *
@@ -380,6 +408,19 @@ private:
 
     bool mutualDistanceSquared( const SEG& aSeg, ecoord& aD1, ecoord& aD2 ) const;
 
+    ///< Gap between the ranges [aA1, aA2] and [aB1, aB2], in any order, or 0 if they overlap
+    static ecoord boxGap( int aA1, int aA2, int aB1, int aB2 )
+    {
+        ecoord gap = ecoord{ std::min( aB1, aB2 ) } - std::max( aA1, aA2 );
+
+        if( gap > 0 )
+            return gap;
+
+        gap = ecoord{ std::min( aA1, aA2 ) } - std::max( aB1, aB2 );
+
+        return gap > 0 ? gap : 0;
+    }
+
 private:
     ///< index within the parent shape (used when m_is_local == false)
     int m_index;
@@ -0,0 +1,269 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __SHAPE_GRID_INDEX_H
+#define __SHAPE_GRID_INDEX_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <geometry/shape_index.h>
+
+/**
+ * A hierarchical spatial hash with the same interface as #SHAPE_INDEX.
+ *
+ * Each object is stored once, in the cell holding the corner of its bounding box at the finest
+ * level whose cells are at least as large as the object.  A query then only looks at the few
+ * cells around the searched box at each level in use, which is much cheaper than descending
+ * the R-tree when the queries are small and localized.
+ */
+template <class T = SHAPE*>
+class SHAPE_GRID_INDEX
+{
+public:
+    /**
+     * @param aCellSize is the size of the cells of the finest level.  Objects of about that
+     *                  size and queries of a few cells are the fastest.
+     */
+    explicit SHAPE_GRID_INDEX( int aCellSize ) :
+            m_cellSize( std::max( aCellSize, 1 ) )
+    {
+    }
+
+    /**
+     * Add a #SHAPE to the index.
+     */
+    void Add( T aShape ) { Add( aShape, boundingBox( aShape ) ); }
+
+    /**
+     * Add a shape with alternate BBox.  It must be removed with the same BBox.
+     */
+    void Add( T aShape, const BOX2I& aBbox )
+    {
+        int    level = levelFor( aBbox );
+        LEVEL& lvl = m_levels[level];
+
+        lvl.m_cells[cellKey( aBbox.GetX(), aBbox.GetY(), level )].push_back( { aBbox, aShape } );
+        lvl.m_maxExtent = std::max( lvl.m_maxExtent, extent( aBbox ) );
+        lvl.m_count++;
+    }
+
+    /**
+     * Remove a #SHAPE from the index.
+     */
+    void Remove( T aShape ) { Remove( aShape, boundingBox( aShape ) ); }
+
+    void Remove( T aShape, const BOX2I& aBbox )
+    {
+        int    level = levelFor( aBbox );
+        LEVEL& lvl = m_levels[level];
+        auto   cell = lvl.m_cells.find( cellKey( aBbox.GetX(), aBbox.GetY(), level ) );
+
+        if( cell == lvl.m_cells.end() )
+            return;
+
+        std::vector<ENTRY>& entries = cell->second;
+
+        for( size_t ii = 0; ii < entries.size(); ++ii )
+        {
+            if( entries[ii].m_object == aShape )
+            {
+                entries[ii] = entries.back();
+                entries.pop_back();
+                lvl.m_count--;
+
+                if( entries.empty() )
+                    lvl.m_cells.erase( cell );
+
+                return;
+            }
+        }
+    }
+
+    /**
+     * Remove all the contents of the index.
+     */
+    void RemoveAll()
+    {
+        for( LEVEL& lvl : m_levels )
+            lvl = LEVEL();
+    }
+
+    /**
+     * Run a callback on every object whose bounding box overlaps the bounding box of \a aShape
+     * inflated by \a aMinDistance.  The search stops when the visitor returns false.
+     *
+     * @return the number of objects visited.
+     */
+    template <class V>
+    int Query( const SHAPE* aShape, int aMinDistance, V& aVisitor ) const
+    {
+        BOX2I box = aShape->BBox();
+        box.Inflate( aMinDistance );
+
+        int cnt = 0;
+
+        for( int level = 0; level < LEVEL_COUNT; ++level )
+        {
+            const LEVEL& lvl = m_levels[level];
+
+            if( lvl.m_count == 0 )
+                continue;
+
+            auto visitEntries =
+                    [&]( const std::vector<ENTRY>& aEntries ) -> bool
+                    {
+                        for( const ENTRY& entry : aEntries )
+                        {
+                            if( !overlap( entry.m_bbox, box ) )
+                                continue;
+
+                            if( !aVisitor( entry.m_object ) )
+                                return false;
+
+                            cnt++;
+                        }
+
+                        return true;
+                    };
+
+            // The objects are stored at the corner of their box, so the cells before the
+            // searched box hold the objects reaching into it
+            int64_t cellSize = cellSizeAt( level );
+            int64_t x0 = floorDiv( (int64_t) box.GetX() - lvl.m_maxExtent, cellSize );
+            int64_t y0 = floorDiv( (int64_t) box.GetY() - lvl.m_maxExtent, cellSize );
+            int64_t x1 = floorDiv( box.GetRight(), cellSize );
+            int64_t y1 = floorDiv( box.GetBottom(), cellSize );
+
+            int64_t used = (int64_t) lvl.m_cells.size();
+            int64_t nx = x1 - x0 + 1;
+            int64_t ny = y1 - y0 + 1;
+
+            if( nx > used || ny > used || nx * ny > used )
+            {
+                // A large query on a sparse level: the cells in use are fewer than the cells
+                // covered
+                for( const auto& [key, entries] : lvl.m_cells )
+                {
+                    if( !visitEntries( entries ) )
+                        return cnt;
+                }
+
+                continue;
+            }
+
+            for( int64_t x = x0; x <= x1; ++x )
+            {
+                for( int64_t y = y0; y <= y1; ++y )
+                {
+                    auto cell = lvl.m_cells.find( packKey( x, y ) );
+
+                    if( cell != lvl.m_cells.end() && !visitEntries( cell->second ) )
+                        return cnt;
+                }
+            }
+        }
+
+        return cnt;
+    }
+
+private:
+    static constexpr int LEVEL_COUNT = 24;
+
+    struct ENTRY
+    {
+        BOX2I m_bbox;
+        T     m_object;
+    };
+
+    struct CELL_HASH
+    {
+        size_t operator()( uint64_t aKey ) const
+        {
+            // A 64-bit mix, so neighbouring cells don't share buckets
+            aKey ^= aKey >> 33;
+            aKey *= 0xff51afd7ed558ccdULL;
+            aKey ^= aKey >> 33;
+            return static_cast<size_t>( aKey );
+        }
+    };
+
+    struct LEVEL
+    {
+        std::unordered_map<uint64_t, std::vector<ENTRY>, CELL_HASH> m_cells;
+
+        /// The largest object stored at this level; it never shrinks, which is conservative
+        int64_t m_maxExtent = 0;
+        size_t  m_count = 0;
+    };
+
+    static int64_t extent( const BOX2I& aBox )
+    {
+        return std::max<int64_t>( { aBox.GetWidth(), aBox.GetHeight(), 0 } );
+    }
+
+    static int64_t floorDiv( int64_t aValue, int64_t aDivisor )
+    {
+        int64_t q = aValue / aDivisor;
+        return ( aValue % aDivisor < 0 ) ? q - 1 : q;
+    }
+
+    static uint64_t packKey( int64_t aX, int64_t aY )
+    {
+        return ( static_cast<uint64_t>( static_cast<uint32_t>( aX ) ) << 32 )
+               | static_cast<uint32_t>( aY );
+    }
+
+    static bool overlap( const BOX2I& aA, const BOX2I& aB )
+    {
+        // Same test as the R-tree of SHAPE_INDEX, on the raw box corners
+        return !( aA.GetX() > aB.GetRight() || aB.GetX() > aA.GetRight()
+                  || aA.GetY() > aB.GetBottom() || aB.GetY() > aA.GetBottom() );
+    }
+
+    int64_t cellSizeAt( int aLevel ) const { return (int64_t) m_cellSize << aLevel; }
+
+    int levelFor( const BOX2I& aBox ) const
+    {
+        int64_t size = extent( aBox );
+        int     level = 0;
+
+        while( level < LEVEL_COUNT - 1 && cellSizeAt( level ) < size )
+            level++;
+
+        return level;
+    }
+
+    uint64_t cellKey( int aX, int aY, int aLevel ) const
+    {
+        int64_t cellSize = cellSizeAt( aLevel );
+        return packKey( floorDiv( aX, cellSize ), floorDiv( aY, cellSize ) );
+    }
+
+    int                            m_cellSize;
+    std::array<LEVEL, LEVEL_COUNT> m_levels;
+};
+
+#endif
@@ -554,6 +554,23 @@ public:
 
     MD5_HASH GetHash() const;
 
+    /**
+     * Write the triangulation to \a aStream, along with the hash of the polygons it was made
+     * from, so that ReadTriangulation() can restore it instead of triangulating them again.
+     *
+     * @return false if the triangulation isn't up to date (nothing is written then).
+     */
+    bool WriteTriangulation( std::ostream& aStream ) const;
+
+    /**
+     * Restore a triangulation written by WriteTriangulation(), if it was made from the same
+     * polygons as the set's current ones.
+     *
+     * @return true if the triangulation was restored, false if it was made from other polygons
+     *         or couldn't be read (the current triangulation is left as is then).
+     */
+    bool ReadTriangulation( std::istream& aStream );
+
     virtual bool HasIndexableSubshapes() const override;
 
     virtual size_t GetIndexableSubshapeCount() const override;
@@ -710,6 +727,12 @@ public:
     /// mainly for reports
     int FullPointCount() const;
 
+    /// Return an estimate of the memory held by the outlines and holes, for reports
+    size_t GetMemoryUsage() const;
+
+    /// Return an estimate of the memory held by the triangulation cache, for reports
+    size_t GetTriangulationMemoryUsage() const;
+
     /// Returns the number of holes in a given outline
     int HoleCount( int aOutline ) const
     {
@@ -1035,6 +1058,82 @@ public:
     void BooleanXor( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                               POLYGON_MODE aFastMode );
 
+    /**
+     * A sequence of Clipper2 booleans and offsets applied to a polygon set, whose intermediate
+     * results stay in Clipper2's own path format.
+     *
+     * Each step of the equivalent sequence of SHAPE_POLY_SET calls converts its input to
+     * Clipper2 paths and its result back to polygons with holes; here the input polygons are
+     * converted once, the operands once per step, and the result once by Finish(), which is
+     * also where arcs are rebuilt.  Consecutive Add()s, or consecutive Subtract()s, are run
+     * as a single boolean with all their operands as clips.
+     *
+     * As with the SHAPE_POLY_SET booleans, arcs are only kept through booleans between a
+     * single polygon and arc-free operands.
+     *
+     * When Clipper2 is disabled, the steps are run one by one as PM_FAST SHAPE_POLY_SET calls.
+     */
+    class BOOLEAN_CHAIN
+    {
+    public:
+        BOOLEAN_CHAIN( const SHAPE_POLY_SET& aPolySet );
+
+        BOOLEAN_CHAIN& Add( const SHAPE_POLY_SET& aOther )
+        {
+            return boolean( Clipper2Lib::ClipType::Union, aOther );
+        }
+
+        BOOLEAN_CHAIN& Subtract( const SHAPE_POLY_SET& aOther )
+        {
+            return boolean( Clipper2Lib::ClipType::Difference, aOther );
+        }
+
+        BOOLEAN_CHAIN& Intersect( const SHAPE_POLY_SET& aOther )
+        {
+            return boolean( Clipper2Lib::ClipType::Intersection, aOther );
+        }
+
+        /**
+         * Same as SHAPE_POLY_SET::Inflate() (without simplification).
+         */
+        BOOLEAN_CHAIN& Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError );
+
+        BOOLEAN_CHAIN& Deflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError )
+        {
+            return Inflate( -aAmount, aCornerStrategy, aMaxError );
+        }
+
+        /**
+         * Store the result of the chain in \a aResult.  The chain can be continued afterwards.
+         */
+        void Finish( SHAPE_POLY_SET& aResult );
+
+    private:
+        BOOLEAN_CHAIN& boolean( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aOther );
+
+        /// Run the boolean waiting for its result, if there is one
+        void flush();
+
+        /// Set up \a aClipper to run the pending boolean, or a union of the current paths
+        void prepare( Clipper2Lib::Clipper64& aClipper );
+
+        void appendPaths( const SHAPE_POLY_SET& aPolySet, Clipper2Lib::Paths64& aPaths );
+
+    private:
+        Clipper2Lib::Paths64         m_paths;     ///< The current result, unless m_pending
+        Clipper2Lib::Paths64         m_clips;     ///< The operands of the pending boolean
+        Clipper2Lib::Paths64         m_scratch;
+        Clipper2Lib::ClipType        m_pendingType = Clipper2Lib::ClipType::None;
+        bool                         m_pending = false;
+
+        /// The shapes of the points, as indexed by their z value.  Entry 0 is a plain point.
+        std::vector<CLIPPER_Z_VALUE> m_zValues;
+        std::vector<SHAPE_ARC>       m_arcBuffer;
+
+        bool                         m_useClipper2;
+        std::unique_ptr<SHAPE_POLY_SET> m_clipper1Result;   ///< The result without Clipper2
+    };
+
     /**
     * Extract all contours from this polygon set, then recreate polygons with holes.
     * Essentially XOR'ing, but faster. Self-intersecting polygons are not supported.
@@ -1110,6 +1209,15 @@ public:
     /// For \a aFastMode meaning, see function booleanOp
     void Simplify( POLYGON_MODE aFastMode );
 
+    /**
+     * Same as Simplify(), for large sets of polygons: the polygons are sorted into a grid of
+     * buckets by their position, the buckets are simplified in parallel on the thread pool,
+     * and only the results which may overlap across buckets are simplified again together.
+     *
+     * This must not be called from a task of the thread pool.
+     */
+    void ParallelSimplify( POLYGON_MODE aFastMode );
+
     /**
      * Simplifies the lines in the polyset.  This checks intermediate points to see if they are
      * collinear with their neighbors, and removes them if they are.
@@ -1495,6 +1603,16 @@ private:
     void inflate1( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy );
     void inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy, bool aSimplify = false );
 
+    /**
+     * Fast path for a positive, round cornered inflation of a set of disjoint convex outlines
+     * without holes, such as the segments and circles of tracks and vias.  Each outline is
+     * offset on its own, as Clipper would, but without the general offset and union.
+     *
+     * @return false (and leave the set untouched) if the set is not made of convex outlines
+     *         that stay apart once inflated.
+     */
+    bool inflateConvex( int aAmount, int aCircleSegCount );
+
     void inflateLine2( const SHAPE_LINE_CHAIN& aLine, int aAmount, int aCircleSegCount,
                        CORNER_STRATEGY aCornerStrategy, bool aSimplify = false );
 
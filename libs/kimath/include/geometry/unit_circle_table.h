@@ -0,0 +1,69 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef UNIT_CIRCLE_TABLE_H
+#define UNIT_CIRCLE_TABLE_H
+
+#include <vector>
+
+#include <math/vector2d.h>
+
+
+/**
+ * Precomputed unit vectors for the vertices of polygonal circle approximations.
+ *
+ * Polygonizing circles, round pads and track ends needs the sine and cosine of the same few
+ * angles over and over.  The tables hold (cos, sin) of each vertex angle, computed exactly as
+ * the EDA_ANGLE loops of the polygonizers compute them, so the vertices built from them are
+ * identical to those built by rotating a point with RotatePoint().
+ *
+ * Tables of up to #MAX_CACHED_SEGCOUNT segments are built once and shared by all threads.
+ */
+class UNIT_CIRCLE_TABLE
+{
+public:
+    static constexpr int MAX_CACHED_SEGCOUNT = 1024;
+
+    /**
+     * @return (cos, sin) of the angles 0, 360 / aSegCount, 2 * 360 / aSegCount... below 360
+     *         degrees.  Tables larger than #MAX_CACHED_SEGCOUNT are only valid until the next
+     *         call from the same thread.
+     */
+    static const std::vector<VECTOR2D>& Circle( int aSegCount );
+
+    /**
+     * @return (cos, sin) of the angles 180 / aSegCount, 3 * 180 / aSegCount... below 180
+     *         degrees, for the rounded ends of ovals.  Same lifetime as Circle().
+     */
+    static const std::vector<VECTOR2D>& HalfStepSemicircle( int aSegCount );
+
+    /**
+     * Build the vertices of an arc by rotating a unit vector, rather than with a sine and a
+     * cosine per vertex.
+     *
+     * @return (cos, sin) of aStartAngle + ii * aStep for ii in [0, aCount), in radians.
+     */
+    static std::vector<VECTOR2D> Arc( double aStartAngle, double aStep, int aCount );
+};
+
+#endif // UNIT_CIRCLE_TABLE_H
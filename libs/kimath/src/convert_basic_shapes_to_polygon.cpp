@@ -30,6 +30,7 @@
 #include <geometry/geometry_utils.h>
 #include <geometry/shape_line_chain.h>  // for SHAPE_LINE_CHAIN
 #include <geometry/shape_poly_set.h>    // for SHAPE_POLY_SET, SHAPE_POLY_SE...
+#include <geometry/unit_circle_table.h>
 #include <math/util.h>
 #include <math/vector2d.h>              // for VECTOR2I
 #include <trigo.h>
@@ -49,8 +50,7 @@ void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer, const VECTOR2I& aCente
     if( numSegs & 1 )
         numSegs++;
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-    int       radius = aRadius;
+    int radius = aRadius;
 
     if( aErrorLoc == ERROR_OUTSIDE )
     {
@@ -61,11 +61,11 @@ void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer, const VECTOR2I& aCente
         radius += GetCircleToPolyCorrection( actual_delta_radius );
     }
 
-    for( EDA_ANGLE angle = ANGLE_0; angle < ANGLE_360; angle += delta )
+    // Same vertices as rotating ( radius, 0 ) by each angle with RotatePoint()
+    for( const VECTOR2D& dir : UNIT_CIRCLE_TABLE::Circle( numSegs ) )
     {
-        corner_position.x = radius;
-        corner_position.y = 0;
-        RotatePoint( corner_position, angle );
+        corner_position.x = KiROUND( radius * dir.x );
+        corner_position.y = KiROUND( -( radius * dir.y ) );
         corner_position += aCenter;
         aBuffer.Append( corner_position.x, corner_position.y );
     }
@@ -88,8 +88,7 @@ void TransformCircleToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aCenter,
     if( numSegs & 1 )
         numSegs++;
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-    int       radius = aRadius;
+    int radius = aRadius;
 
     if( aErrorLoc == ERROR_OUTSIDE )
     {
@@ -102,11 +101,11 @@ void TransformCircleToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aCenter,
 
     aBuffer.NewOutline();
 
-    for( EDA_ANGLE angle = ANGLE_0; angle < ANGLE_360; angle += delta )
+    // Same vertices as rotating ( radius, 0 ) by each angle with RotatePoint()
+    for( const VECTOR2D& dir : UNIT_CIRCLE_TABLE::Circle( numSegs ) )
     {
-        corner_position.x = radius;
-        corner_position.y = 0;
-        RotatePoint( corner_position, angle );
+        corner_position.x = KiROUND( radius * dir.x );
+        corner_position.y = KiROUND( -( radius * dir.y ) );
         corner_position += aCenter;
         aBuffer.Append( corner_position.x, corner_position.y );
     }
@@ -134,8 +133,6 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, co
     // Round up to 8 to make segment approximations align properly at 45-degrees
     numSegs = ( numSegs + 7 ) / 8 * 8;
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-
     if( aErrorLoc == ERROR_OUTSIDE )
     {
         // The outer radius should be radius+aError
@@ -175,11 +172,13 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, co
     corner = VECTOR2I( seg_len, radius );
     polyshape.Append( corner.x, corner.y );
 
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
+    // Same vertices as rotating ( 0, radius ) by each angle with RotatePoint()
+    const std::vector<VECTOR2D>& endDirs = UNIT_CIRCLE_TABLE::HalfStepSemicircle( numSegs );
+
+    for( const VECTOR2D& dir : endDirs )
     {
-        corner = VECTOR2I( 0, radius );
-        RotatePoint( corner, angle );
-        corner.x += seg_len;
+        corner.x = KiROUND( radius * dir.y ) + seg_len;
+        corner.y = KiROUND( radius * dir.x );
         polyshape.Append( corner.x, corner.y );
     }
 
@@ -192,10 +191,10 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, co
     polyshape.Append( corner.x, corner.y );
 
     // add left rounded end:
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
+    for( const VECTOR2D& dir : endDirs )
     {
-        corner = VECTOR2I( 0, -radius );
-        RotatePoint( corner, angle );
+        corner.x = KiROUND( -radius * dir.y );
+        corner.y = KiROUND( -radius * dir.x );
         polyshape.Append( corner.x, corner.y );
     }
 
@@ -539,12 +538,11 @@ int ConvertArcToPolyline( SHAPE_LINE_CHAIN& aPolyline, VECTOR2I aCenter, int aRa
         // This is the easy case: with the error on the inside the endpoints of each segment
         // are error-free.
 
-        EDA_ANGLE rot = aStartAngle;
-
-        for( int i = 0; i <= n; i++, rot += delta )
+        for( const VECTOR2D& dir : UNIT_CIRCLE_TABLE::Arc( aStartAngle.AsRadians(),
+                                                           delta.AsRadians(), n + 1 ) )
         {
-            double x = aCenter.x + aRadius * rot.Cos();
-            double y = aCenter.y + aRadius * rot.Sin();
+            double x = aCenter.x + aRadius * dir.x;
+            double y = aCenter.y + aRadius * dir.y;
 
             aPolyline.Append( KiROUND( x ), KiROUND( y ) );
         }
@@ -564,12 +562,13 @@ int ConvertArcToPolyline( SHAPE_LINE_CHAIN& aPolyline, VECTOR2I aCenter, int aRa
 
         aPolyline.Append( KiROUND( x ), KiROUND( y ) );
 
-        EDA_ANGLE rot = aStartAngle + delta / 2;
+        EDA_ANGLE first = aStartAngle + delta / 2;
 
-        for( int i = 0; i < n; i++, rot += delta )
+        for( const VECTOR2D& dir : UNIT_CIRCLE_TABLE::Arc( first.AsRadians(), delta.AsRadians(),
+                                                           n ) )
         {
-            x = aCenter.x + errorRadius * rot.Cos();
-            y = aCenter.y + errorRadius * rot.Sin();
+            x = aCenter.x + errorRadius * dir.x;
+            y = aCenter.y + errorRadius * dir.y;
 
             aPolyline.Append( KiROUND( x ), KiROUND( y ) );
         }
@@ -27,6 +27,7 @@
  * @brief a few functions useful in geometry calculations.
  */
 
+#include <array>
 #include <cstdint>
 #include <algorithm>         // for max, min
 
@@ -48,14 +49,35 @@ int GetArcToSegmentCount( int aRadius, int aErrorMax, const EDA_ANGLE& aArcAngle
     aRadius = std::max( 1, aRadius );
     aErrorMax = std::max( 1, aErrorMax );
 
-    // error relative to the radius value:
-    double rel_error = (double)aErrorMax / aRadius;
-    // minimal arc increment in degrees:
-    double arc_increment = 180 / M_PI * acos( 1.0 - rel_error ) * 2;
+    // Only a few (radius, error) pairs are used over and over (pads, vias, track widths), so
+    // remember the last increments rather than calling acos() for each of them
+    struct ARC_INCREMENT
+    {
+        int    m_radius = 0;
+        int    m_errorMax = 0;
+        double m_increment = 0.0;
+    };
+
+    thread_local std::array<ARC_INCREMENT, 64> s_increments;
+
+    unsigned       slot = ( unsigned( aRadius ) * 31u + unsigned( aErrorMax ) ) & 63u;
+    ARC_INCREMENT& cached = s_increments[slot];
+
+    if( cached.m_radius != aRadius || cached.m_errorMax != aErrorMax )
+    {
+        // error relative to the radius value:
+        double rel_error = (double)aErrorMax / aRadius;
+        // minimal arc increment in degrees:
+        double arc_increment = 180 / M_PI * acos( 1.0 - rel_error ) * 2;
+
+        // Ensure a minimal arc increment reasonable value for a circle
+        // (360.0 degrees). For very small radius values, this is mandatory.
+        cached.m_radius = aRadius;
+        cached.m_errorMax = aErrorMax;
+        cached.m_increment = std::min( 360.0/MIN_SEGCOUNT_FOR_CIRCLE, arc_increment );
+    }
 
-    // Ensure a minimal arc increment reasonable value for a circle
-    // (360.0 degrees). For very small radius values, this is mandatory.
-    arc_increment = std::min( 360.0/MIN_SEGCOUNT_FOR_CIRCLE, arc_increment );
+    double arc_increment = cached.m_increment;
 
     int segCount = KiROUND( fabs( aArcAngle.AsDegrees() ) / arc_increment );
 
@@ -0,0 +1,96 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <advanced_config.h>
+#include <geometry/inflate_cache.h>
+
+
+void INFLATE_CACHE::Inflate( SHAPE_POLY_SET& aPolySet, int aAmount,
+                             CORNER_STRATEGY aCornerStrategy, int aMaxError, bool aSimplify )
+{
+    if( !ADVANCED_CFG::GetCfg().m_CacheInflatedOutlines )
+    {
+        aPolySet.Inflate( aAmount, aCornerStrategy, aMaxError, aSimplify );
+        return;
+    }
+
+    KEY key( aPolySet.GetHash().Format( true ), aAmount, static_cast<int>( aCornerStrategy ),
+             aMaxError, aSimplify );
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_entries.find( key );
+
+        if( it != m_entries.end() )
+        {
+            m_lru.splice( m_lru.begin(), m_lru, it->second );
+            aPolySet = it->second->second;
+            m_hits++;
+            return;
+        }
+    }
+
+    // Inflate outside the lock; two threads missing on the same key just do the work twice
+    aPolySet.Inflate( aAmount, aCornerStrategy, aMaxError, aSimplify );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( m_capacity == 0 || m_entries.count( key ) )
+        return;
+
+    m_lru.emplace_front( key, aPolySet );
+    m_entries[key] = m_lru.begin();
+
+    while( m_entries.size() > m_capacity )
+    {
+        m_entries.erase( m_lru.back().first );
+        m_lru.pop_back();
+    }
+}
+
+
+void INFLATE_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_entries.clear();
+    m_lru.clear();
+    m_hits = 0;
+}
+
+
+size_t INFLATE_CACHE::Size() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_entries.size();
+}
+
+
+size_t INFLATE_CACHE::Hits() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_hits;
+}
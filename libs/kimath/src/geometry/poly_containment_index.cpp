@@ -0,0 +1,198 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include <geometry/poly_containment_index.h>
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+
+POLY_CONTAINMENT_INDEX::POLY_CONTAINMENT_INDEX( const SHAPE_POLY_SET& aPolySet,
+                                                int aStripCount ) :
+        m_top( INT_MAX ),
+        m_bottom( INT_MIN ),
+        m_stripHeight( 1 )
+{
+    std::vector<EDGE> edges;
+
+    for( int ii = 0; ii < aPolySet.OutlineCount(); ii++ )
+    {
+        int outlineIdx = (int) m_outlineOf.size();
+
+        for( int jj = 0; jj <= aPolySet.HoleCount( ii ); jj++ )
+        {
+            const SHAPE_LINE_CHAIN& contour = jj == 0 ? aPolySet.COutline( ii )
+                                                      : aPolySet.CHole( ii, jj - 1 );
+            int                     contourIdx = (int) m_outlineOf.size();
+
+            m_outlineOf.push_back( outlineIdx );
+
+            // SHAPE_LINE_CHAIN::PointInside() treats open and degenerate chains as empty
+            if( !contour.IsClosed() || contour.PointCount() < 3 )
+                continue;
+
+            int pointCount = contour.PointCount();
+
+            for( int kk = 0; kk < pointCount; kk++ )
+            {
+                const VECTOR2I& p1 = contour.CPoint( kk );
+                const VECTOR2I& p2 = contour.CPoint( kk + 1 == pointCount ? 0 : kk + 1 );
+
+                // Horizontal edges can never cross the ray
+                if( p1.y == p2.y )
+                    continue;
+
+                edges.push_back( { p1, p2, contourIdx } );
+                m_top = std::min( { m_top, p1.y, p2.y } );
+                m_bottom = std::max( { m_bottom, p1.y, p2.y } );
+            }
+        }
+    }
+
+    if( edges.empty() )
+        return;
+
+    if( aStripCount <= 0 )
+        aStripCount = std::clamp( (int) std::sqrt( (double) edges.size() ), 1, 1024 );
+
+    int64_t height = (int64_t) m_bottom - m_top;
+    m_stripHeight = (int) std::max<int64_t>( 1, height / aStripCount + 1 );
+
+    m_strips.resize( stripIndex( m_bottom ) + 1 );
+
+    for( const EDGE& edge : edges )
+    {
+        int first = stripIndex( std::min( edge.m_p1.y, edge.m_p2.y ) );
+        int last = stripIndex( std::max( edge.m_p1.y, edge.m_p2.y ) );
+
+        for( int strip = first; strip <= last; strip++ )
+            m_strips[strip].push_back( edge );
+    }
+}
+
+
+int POLY_CONTAINMENT_INDEX::stripIndex( int aY ) const
+{
+    return (int) ( ( (int64_t) aY - m_top ) / m_stripHeight );
+}
+
+
+bool POLY_CONTAINMENT_INDEX::containsInStrip( const VECTOR2I& aPt, int aStrip,
+                                              std::vector<int>& aCrossings ) const
+{
+    aCrossings.clear();
+
+    // Same ray-cast as SHAPE_LINE_CHAIN::PointInside(), so that points on or very near an
+    // edge get the same answer.
+    for( const EDGE& edge : m_strips[aStrip] )
+    {
+        if( ( edge.m_p1.y > aPt.y ) != ( edge.m_p2.y > aPt.y ) )
+        {
+            const VECTOR2I diff = edge.m_p2 - edge.m_p1;
+            const int      d = rescale( diff.x, ( aPt.y - edge.m_p1.y ), diff.y );
+
+            if( aPt.x - edge.m_p1.x < d )
+                aCrossings.push_back( edge.m_contour );
+        }
+    }
+
+    // A contour contains the point if the ray crosses it an odd number of times.  Contours are
+    // numbered polygon-by-polygon with the outline first, so after sorting each polygon's
+    // contours are grouped together and its outline (if crossed) leads the group.
+    std::sort( aCrossings.begin(), aCrossings.end() );
+
+    int  polygonOutline = -1;
+    bool inside = false;
+
+    for( size_t ii = 0; ii < aCrossings.size(); )
+    {
+        int    contour = aCrossings[ii];
+        size_t jj = ii;
+
+        while( jj < aCrossings.size() && aCrossings[jj] == contour )
+            jj++;
+
+        bool odd = ( jj - ii ) % 2;
+        ii = jj;
+
+        if( !odd )
+            continue;
+
+        if( m_outlineOf[contour] != polygonOutline )
+        {
+            if( inside )
+                return true;
+
+            polygonOutline = m_outlineOf[contour];
+            inside = ( contour == polygonOutline );
+        }
+        else
+        {
+            // Inside one of the polygon's holes
+            inside = false;
+        }
+    }
+
+    return inside;
+}
+
+
+bool POLY_CONTAINMENT_INDEX::Contains( const VECTOR2I& aPt ) const
+{
+    if( m_strips.empty() || aPt.y < m_top || aPt.y > m_bottom )
+        return false;
+
+    std::vector<int> crossings;
+
+    return containsInStrip( aPt, stripIndex( aPt.y ), crossings );
+}
+
+
+std::vector<bool> POLY_CONTAINMENT_INDEX::Contains( const std::vector<VECTOR2I>& aPoints ) const
+{
+    std::vector<bool> results( aPoints.size(), false );
+
+    if( m_strips.empty() )
+        return results;
+
+    std::vector<std::pair<int, size_t>> order;
+    order.reserve( aPoints.size() );
+
+    for( size_t ii = 0; ii < aPoints.size(); ii++ )
+    {
+        if( aPoints[ii].y >= m_top && aPoints[ii].y <= m_bottom )
+            order.emplace_back( stripIndex( aPoints[ii].y ), ii );
+    }
+
+    std::sort( order.begin(), order.end() );
+
+    std::vector<int> crossings;
+
+    for( const auto& [strip, idx] : order )
+        results[idx] = containsInStrip( aPoints[idx], strip, crossings );
+
+    return results;
+}
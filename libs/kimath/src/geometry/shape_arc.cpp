@@ -29,6 +29,7 @@
 #include <geometry/seg.h>               // for SEG
 #include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
+#include <geometry/unit_circle_table.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
 
@@ -537,17 +538,20 @@ const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( double aAccuracy,
 
     rv.Append( m_start );
 
-    for( int i = 1; i < n ; i += 2 )
+    if( n != 0 )
     {
-        EDA_ANGLE a = sa;
+        // The odd vertices of the 2n subdivision: the middles of the n segments
+        EDA_ANGLE first = sa + ca / n;
+        EDA_ANGLE step = ( ca * 2 ) / n;
 
-        if( n != 0 )
-            a += ( ca * i ) / n;
-
-        double x = c.x + r * a.Cos();
-        double y = c.y + r * a.Sin();
+        for( const VECTOR2D& dir : UNIT_CIRCLE_TABLE::Arc( first.AsRadians(), step.AsRadians(),
+                                                           n / 2 ) )
+        {
+            double x = c.x + r * dir.x;
+            double y = c.y + r * dir.y;
 
-        rv.Append( KiROUND( x ), KiROUND( y ) );
+            rv.Append( KiROUND( x ), KiROUND( y ) );
+        }
     }
 
     rv.Append( m_end );
@@ -332,16 +332,36 @@ static inline bool Collide( const SHAPE_LINE_CHAIN_BASE& aA, const SHAPE_LINE_CH
 
         auto seg_sort = []( const SEG& a, const SEG& b )
         {
-            return a.A.x < b.A.x || ( a.A.x == b.A.x && a.A.y < b.A.y );
+            return std::min( a.A.x, a.B.x ) < std::min( b.A.x, b.B.x );
         };
 
-        std::sort( a_segs.begin(), a_segs.end(), seg_sort );
         std::sort( b_segs.begin(), b_segs.end(), seg_sort );
 
+        // Nothing further apart than this can collide
+        SEG::ecoord limit_sq = std::max<SEG::ecoord>( SEG::Square( aClearance ), 1 );
+        bool        done = false;
+
         for( const SEG& a_seg : a_segs )
         {
+            int a_right = std::max( a_seg.A.x, a_seg.B.x );
+
             for( const SEG& b_seg : b_segs )
             {
+                // b_segs are sorted by their left end, so the rest are all too far right
+                SEG::ecoord gap = SEG::ecoord{ std::min( b_seg.A.x, b_seg.B.x ) } - a_right;
+
+                if( gap > 0 && gap * gap >= limit_sq )
+                    break;
+
+                SEG::ecoord box_dist_sq = a_seg.SquaredBoxDistance( b_seg );
+
+                if( box_dist_sq >= limit_sq
+                        || ( closest_dist < std::numeric_limits<int>::max()
+                             && box_dist_sq > SEG::Square( closest_dist ) ) )
+                {
+                    continue;
+                }
+
                 int dist = 0;
 
                 if( a_seg.Collide( b_seg, aClearance, aActual || aLocation ? &dist : nullptr ) )
@@ -352,14 +372,17 @@ static inline bool Collide( const SHAPE_LINE_CHAIN_BASE& aA, const SHAPE_LINE_CH
                         closest_dist = dist;
                     }
 
-                    if( closest_dist == 0 )
-                        break;
-
                     // If we're not looking for aActual then any collision will do
-                    if( !aActual )
+                    if( closest_dist == 0 || !aActual )
+                    {
+                        done = true;
                         break;
+                    }
                 }
             }
+
+            if( done )
+                break;
         }
     }
 
@@ -208,6 +208,27 @@ Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientati
     bool             orientation = Area( false ) >= 0;
     ssize_t          shape_offset = aArcBuffer.size();
 
+    if( m_arcs.empty() )
+    {
+        // No arc indices to remap: read the points in the required order instead of copying
+        // the chain
+        int  pointCount = PointCount();
+        bool reverse = orientation != aRequiredOrientation;
+
+        c_path.reserve( pointCount );
+
+        for( int i = 0; i < pointCount; i++ )
+        {
+            const VECTOR2I& vertex = m_points[reverse ? pointCount - 1 - i : i];
+            size_t          z_value_ptr = aZValueBuffer.size();
+
+            aZValueBuffer.emplace_back();
+            c_path.emplace_back( vertex.x, vertex.y, z_value_ptr );
+        }
+
+        return c_path;
+    }
+
     if( orientation != aRequiredOrientation )
         input = Reverse();
     else
@@ -431,11 +452,18 @@ bool SHAPE_LINE_CHAIN_BASE::Collide( const VECTOR2I& aP, int aClearance, int* aA
 
     SEG::ecoord closest_dist_sq = VECTOR2I::ECOORD_MAX;
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
+    SEG::ecoord limit_sq = aActual ? VECTOR2I::ECOORD_MAX
+                                   : std::max<SEG::ecoord>( clearance_sq, 1 );
     VECTOR2I nearest;
 
     for( size_t i = 0; i < GetSegmentCount(); i++ )
     {
         const SEG& s = GetSegment( i );
+
+        // Skip the segments which can't be closer than the closest one so far
+        if( s.SquaredBoxDistance( aP ) >= std::min( closest_dist_sq, limit_sq ) )
+            continue;
+
         VECTOR2I pn = s.NearestPoint( aP );
         SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
@@ -484,6 +512,8 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
 
     SEG::ecoord closest_dist_sq = VECTOR2I::ECOORD_MAX;
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
+    SEG::ecoord limit_sq = aActual ? VECTOR2I::ECOORD_MAX
+                                   : std::max<SEG::ecoord>( clearance_sq, 1 );
     VECTOR2I    nearest;
 
     // Collide line segments
@@ -493,6 +523,11 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
             continue;
 
         const SEG&  s = GetSegment( i );
+
+        // Skip the segments which can't be closer than the closest one so far
+        if( s.SquaredBoxDistance( aP ) >= std::min( closest_dist_sq, limit_sq ) )
+            continue;
+
         VECTOR2I    pn = s.NearestPoint( aP );
         SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
@@ -563,11 +598,18 @@ bool SHAPE_LINE_CHAIN_BASE::Collide( const SEG& aSeg, int aClearance, int* aActu
 
     SEG::ecoord closest_dist_sq = VECTOR2I::ECOORD_MAX;
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
+    SEG::ecoord limit_sq = aActual ? VECTOR2I::ECOORD_MAX
+                                   : std::max<SEG::ecoord>( clearance_sq, 1 );
     VECTOR2I nearest;
 
     for( size_t i = 0; i < GetSegmentCount(); i++ )
     {
         const SEG& s = GetSegment( i );
+
+        // Skip the segments which can't be closer than the closest one so far
+        if( s.SquaredBoxDistance( aSeg ) >= std::min( closest_dist_sq, limit_sq ) )
+            continue;
+
         SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
         if( dist_sq < closest_dist_sq )
@@ -617,6 +659,8 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
 
     SEG::ecoord closest_dist_sq = VECTOR2I::ECOORD_MAX;
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
+    SEG::ecoord limit_sq = aActual ? VECTOR2I::ECOORD_MAX
+                                   : std::max<SEG::ecoord>( clearance_sq, 1 );
     VECTOR2I    nearest;
 
     // Collide line segments
@@ -626,6 +670,11 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
             continue;
 
         const SEG&  s = GetSegment( i );
+
+        // Skip the segments which can't be closer than the closest one so far
+        if( s.SquaredBoxDistance( aSeg ) >= std::min( closest_dist_sq, limit_sq ) )
+            continue;
+
         SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
         if( dist_sq < closest_dist_sq )
@@ -962,7 +1011,12 @@ SEG::ecoord SHAPE_LINE_CHAIN_BASE::SquaredDistance( const VECTOR2I& aP, bool aOu
         return 0;
 
     for( size_t s = 0; s < GetSegmentCount(); s++ )
-        d = std::min( d, GetSegment( s ).SquaredDistance( aP ) );
+    {
+        const SEG& seg = GetSegment( s );
+
+        if( seg.SquaredBoxDistance( aP ) < d )
+            d = std::min( d, seg.SquaredDistance( aP ) );
+    }
 
     return d;
 }
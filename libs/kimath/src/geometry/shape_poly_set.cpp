@@ -34,6 +34,7 @@
 #include <cstdio>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
+#include <ostream>
 #include <map>
 #include <memory>
 #include <set>
@@ -57,6 +58,7 @@
 #include <hash.h>
 #include <geometry/shape_segment.h>
 #include <geometry/shape_circle.h>
+#include <core/thread_pool.h>
 
 // Do not keep this for release.  Only for testing clipper
 #include <advanced_config.h>
@@ -371,6 +373,41 @@ int SHAPE_POLY_SET::FullPointCount() const
 }
 
 
+size_t SHAPE_POLY_SET::GetMemoryUsage() const
+{
+    size_t size = m_polys.capacity() * sizeof( POLYGON );
+
+    for( const POLYGON& poly : m_polys )
+    {
+        size += poly.capacity() * sizeof( SHAPE_LINE_CHAIN );
+
+        for( const SHAPE_LINE_CHAIN& chain : poly )
+        {
+            size += chain.CPoints().capacity() * sizeof( VECTOR2I );
+            size += chain.CShapes().capacity() * sizeof( std::pair<ssize_t, ssize_t> );
+            size += chain.CArcs().capacity() * sizeof( SHAPE_ARC );
+        }
+    }
+
+    return size;
+}
+
+
+size_t SHAPE_POLY_SET::GetTriangulationMemoryUsage() const
+{
+    size_t size = m_triangulatedPolys.capacity() * sizeof( void* );
+
+    for( const std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
+    {
+        size += sizeof( TRIANGULATED_POLYGON );
+        size += tri->GetTriangleCount() * sizeof( TRIANGULATED_POLYGON::TRI );
+        size += tri->GetVertexCount() * sizeof( VECTOR2I );
+    }
+
+    return size;
+}
+
+
 SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
 {
     assert( aFirstPolygon >= 0 && aLastPolygon <= OutlineCount() );
@@ -848,6 +885,77 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
 }
 
 
+/**
+ * @return a Clipper2 callback giving each intersection point of a boolean a new z value in
+ *         \a aZValues, telling which arcs it belongs to.  The intersection points on arcs are
+ *         also added to \a aNewIntersectPoints, if not null.
+ */
+static Clipper2Lib::ZCallback64
+arcZCallback( std::vector<CLIPPER_Z_VALUE>& aZValues,
+              std::map<VECTOR2I, CLIPPER_Z_VALUE>* aNewIntersectPoints )
+{
+    return [&aZValues, aNewIntersectPoints]( const Clipper2Lib::Point64 & e1bot,
+                                             const Clipper2Lib::Point64 & e1top,
+                                             const Clipper2Lib::Point64 & e2bot,
+                                             const Clipper2Lib::Point64 & e2top,
+                                             Clipper2Lib::Point64 & pt )
+            {
+                auto arcIndex =
+                    [&]( const ssize_t& aZvalue, const ssize_t& aCompareVal = -1 ) -> ssize_t
+                    {
+                        ssize_t retval;
+
+                        retval = aZValues.at( aZvalue ).m_SecondArcIdx;
+
+                        if( retval == -1 || ( aCompareVal > 0 && retval != aCompareVal ) )
+                            retval = aZValues.at( aZvalue ).m_FirstArcIdx;
+
+                        return retval;
+                    };
+
+                auto arcSegment =
+                    [&]( const ssize_t& aBottomZ, const ssize_t aTopZ ) -> ssize_t
+                    {
+                        ssize_t retval = arcIndex( aBottomZ );
+
+                        if( retval != -1 )
+                        {
+                            if( retval != arcIndex( aTopZ, retval ) )
+                                retval = -1; // Not an arc segment as the two indices do not match
+                        }
+
+                        return retval;
+                    };
+
+                ssize_t e1ArcSegmentIndex = arcSegment( e1bot.z, e1top.z );
+                ssize_t e2ArcSegmentIndex = arcSegment( e2bot.z, e2top.z );
+
+                CLIPPER_Z_VALUE newZval;
+
+                if( e1ArcSegmentIndex != -1 )
+                {
+                    newZval.m_FirstArcIdx = e1ArcSegmentIndex;
+                    newZval.m_SecondArcIdx = e2ArcSegmentIndex;
+                }
+                else
+                {
+                    newZval.m_FirstArcIdx = e2ArcSegmentIndex;
+                    newZval.m_SecondArcIdx = -1;
+                }
+
+                size_t z_value_ptr = aZValues.size();
+                aZValues.push_back( newZval );
+
+                // Only worry about arc segments for later processing
+                if( newZval.m_FirstArcIdx != -1 && aNewIntersectPoints )
+                    aNewIntersectPoints->insert( { VECTOR2I( pt.x, pt.y ), newZval } );
+
+                pt.z = z_value_ptr;
+                //@todo amend X,Y values to true intersection between arcs or arc and segment
+            };
+}
+
+
 void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
                                 const SHAPE_POLY_SET& aOtherShape )
 {
@@ -888,74 +996,234 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
 
     Clipper2Lib::PolyTree64 solution;
 
-    Clipper2Lib::ZCallback64 callback =
-            [&]( const Clipper2Lib::Point64 & e1bot, const Clipper2Lib::Point64 & e1top,
-                 const Clipper2Lib::Point64 & e2bot, const Clipper2Lib::Point64 & e2top,
-                 Clipper2Lib::Point64 & pt )
+    c.SetZCallback( arcZCallback( zValues, &newIntersectPoints ) );
+
+    c.Execute( aType, Clipper2Lib::FillRule::NonZero, solution );
+
+    importTree( solution, zValues, arcBuffer );
+    solution.Clear(); // Free used memory (not done in dtor)
+}
+
+
+/**
+ * @return the Clipper2 join type to offset corners with \a aCornerStrategy, and its miter limit
+ *         in \a aMiterLimit.
+ */
+static Clipper2Lib::JoinType clipper2JoinType( CORNER_STRATEGY aCornerStrategy,
+                                               double& aMiterLimit )
+{
+    using namespace Clipper2Lib;
+
+    // N.B. see the Clipper documentation for jtSquare/jtMiter/jtRound.  They are poorly named
+    // and are not what you'd think they are.
+    // http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Types/JoinType.htm
+    JoinType joinType = JoinType::Round;    // The way corners are offsetted
+    aMiterLimit = 2.0;                      // Smaller value when using jtMiter for joinType
+
+    switch( aCornerStrategy )
+    {
+    case CORNER_STRATEGY::ALLOW_ACUTE_CORNERS:
+        joinType = JoinType::Miter;
+        aMiterLimit = 10;       // Allows large spikes
+        break;
+
+    case CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS: // Acute angles are chamfered
+        joinType = JoinType::Miter;
+        break;
+
+    case CORNER_STRATEGY::ROUND_ACUTE_CORNERS: // Acute angles are rounded
+        joinType = JoinType::Miter;
+        break;
+
+    case CORNER_STRATEGY::CHAMFER_ALL_CORNERS: // All angles are chamfered.
+        joinType = JoinType::Square;
+        break;
+
+    case CORNER_STRATEGY::ROUND_ALL_CORNERS: // All angles are rounded.
+        joinType = JoinType::Round;
+        break;
+    }
+
+    return joinType;
+}
+
+
+SHAPE_POLY_SET::BOOLEAN_CHAIN::BOOLEAN_CHAIN( const SHAPE_POLY_SET& aPolySet ) :
+        m_zValues( 1 ),
+        m_useClipper2( ADVANCED_CFG::GetCfg().m_UseClipper2 )
+{
+    if( m_useClipper2 )
+        appendPaths( aPolySet, m_paths );
+    else
+        m_clipper1Result = std::make_unique<SHAPE_POLY_SET>( aPolySet.CloneDropTriangulation() );
+}
+
+
+void SHAPE_POLY_SET::BOOLEAN_CHAIN::appendPaths( const SHAPE_POLY_SET& aPolySet,
+                                                 Clipper2Lib::Paths64& aPaths )
+{
+    for( const POLYGON& poly : aPolySet.m_polys )
+    {
+        for( size_t ii = 0; ii < poly.size(); ++ii )
+        {
+            const SHAPE_LINE_CHAIN& chain = poly[ii];
+
+            // Outlines are positive and holes negative for the NonZero fill rule
+            if( chain.ArcCount() )
             {
-                auto arcIndex =
-                    [&]( const ssize_t& aZvalue, const ssize_t& aCompareVal = -1 ) -> ssize_t
-                    {
-                        ssize_t retval;
+                aPaths.push_back( chain.convertToClipper2( ii == 0, m_zValues, m_arcBuffer ) );
+                continue;
+            }
 
-                        retval = zValues.at( aZvalue ).m_SecondArcIdx;
+            const std::vector<VECTOR2I>& points = chain.CPoints();
+            Clipper2Lib::Path64&         path = aPaths.emplace_back();
+            bool reverse = ( chain.Area( false ) >= 0 ) != ( ii == 0 );
 
-                        if( retval == -1 || ( aCompareVal > 0 && retval != aCompareVal ) )
-                            retval = zValues.at( aZvalue ).m_FirstArcIdx;
+            // The points of arc-free chains all share the plain point z value
+            path.reserve( points.size() );
 
-                        return retval;
-                    };
+            if( reverse )
+            {
+                for( auto it = points.rbegin(); it != points.rend(); ++it )
+                    path.emplace_back( it->x, it->y, 0 );
+            }
+            else
+            {
+                for( const VECTOR2I& pt : points )
+                    path.emplace_back( pt.x, pt.y, 0 );
+            }
+        }
+    }
+}
 
-                auto arcSegment =
-                    [&]( const ssize_t& aBottomZ, const ssize_t aTopZ ) -> ssize_t
-                    {
-                        ssize_t retval = arcIndex( aBottomZ );
 
-                        if( retval != -1 )
-                        {
-                            if( retval != arcIndex( aTopZ, retval ) )
-                                retval = -1; // Not an arc segment as the two indices do not match
-                        }
+void SHAPE_POLY_SET::BOOLEAN_CHAIN::prepare( Clipper2Lib::Clipper64& aClipper )
+{
+    // Intersections only need their own z value when they can be on an arc
+    if( !m_arcBuffer.empty() )
+        aClipper.SetZCallback( arcZCallback( m_zValues, nullptr ) );
 
-                        return retval;
-                    };
+    aClipper.AddSubject( m_paths );
 
-                ssize_t e1ArcSegmentIndex = arcSegment( e1bot.z, e1top.z );
-                ssize_t e2ArcSegmentIndex = arcSegment( e2bot.z, e2top.z );
+    if( m_pending )
+        aClipper.AddClip( m_clips );
+}
 
-                CLIPPER_Z_VALUE newZval;
 
-                if( e1ArcSegmentIndex != -1 )
-                {
-                    newZval.m_FirstArcIdx = e1ArcSegmentIndex;
-                    newZval.m_SecondArcIdx = e2ArcSegmentIndex;
-                }
-                else
-                {
-                    newZval.m_FirstArcIdx = e2ArcSegmentIndex;
-                    newZval.m_SecondArcIdx = -1;
-                }
+void SHAPE_POLY_SET::BOOLEAN_CHAIN::flush()
+{
+    if( !m_pending )
+        return;
 
-                size_t z_value_ptr = zValues.size();
-                zValues.push_back( newZval );
+    Clipper2Lib::Clipper64 c;
 
-                // Only worry about arc segments for later processing
-                if( newZval.m_FirstArcIdx != -1 )
-                    newIntersectPoints.insert( { VECTOR2I( pt.x, pt.y ), newZval } );
+    prepare( c );
 
-                pt.z = z_value_ptr;
-                //@todo amend X,Y values to true intersection between arcs or arc and segment
-            };
+    m_scratch.clear();
+    c.Execute( m_pendingType, Clipper2Lib::FillRule::NonZero, m_scratch );
 
-    c.SetZCallback( std::move( callback ) ); // register callback
+    std::swap( m_paths, m_scratch );
+    m_clips.clear();
+    m_pending = false;
+}
 
-    c.Execute( aType, Clipper2Lib::FillRule::NonZero, solution );
 
-    importTree( solution, zValues, arcBuffer );
-    solution.Clear(); // Free used memory (not done in dtor)
+SHAPE_POLY_SET::BOOLEAN_CHAIN&
+SHAPE_POLY_SET::BOOLEAN_CHAIN::boolean( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aOther )
+{
+    // With the NonZero fill rule, clips add up to their union: A - B - C is A - ( B + C ) and
+    // A + B + C is a single union.  Other sequences need the result of the pending boolean.
+    if( !m_useClipper2 )
+    {
+        switch( aType )
+        {
+        case Clipper2Lib::ClipType::Union:
+            m_clipper1Result->BooleanAdd( aOther, PM_FAST );
+            break;
+
+        case Clipper2Lib::ClipType::Difference:
+            m_clipper1Result->BooleanSubtract( aOther, PM_FAST );
+            break;
+
+        default:
+            m_clipper1Result->BooleanIntersection( aOther, PM_FAST );
+            break;
+        }
+
+        return *this;
+    }
+
+    bool merge = m_pending && aType == m_pendingType
+                 && ( aType == Clipper2Lib::ClipType::Union
+                      || aType == Clipper2Lib::ClipType::Difference );
+
+    if( !merge )
+        flush();
+
+    appendPaths( aOther, m_clips );
+    m_pendingType = aType;
+    m_pending = true;
+
+    return *this;
 }
 
 
+SHAPE_POLY_SET::BOOLEAN_CHAIN&
+SHAPE_POLY_SET::BOOLEAN_CHAIN::Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy,
+                                        int aMaxError )
+{
+    using namespace Clipper2Lib;
+
+    if( !m_useClipper2 )
+    {
+        m_clipper1Result->Inflate( aAmount, aCornerStrategy, aMaxError );
+        return *this;
+    }
+
+    flush();
+
+    int segCount = std::max( 6, GetArcToSegmentCount( std::abs( aAmount ), aMaxError,
+                                                      FULL_CIRCLE ) );
+
+    double        miterLimit;
+    JoinType      joinType = clipper2JoinType( aCornerStrategy, miterLimit );
+    ClipperOffset c;
+
+    c.AddPaths( m_paths, joinType, EndType::Polygon );
+    c.ArcTolerance( std::abs( aAmount ) * ( 1.0 - cos( M_PI / segCount ) ) );
+    c.MiterLimit( miterLimit );
+
+    m_scratch.clear();
+    c.Execute( aAmount, m_scratch );
+
+    std::swap( m_paths, m_scratch );
+
+    return *this;
+}
+
+
+void SHAPE_POLY_SET::BOOLEAN_CHAIN::Finish( SHAPE_POLY_SET& aResult )
+{
+    if( !m_useClipper2 )
+    {
+        aResult = m_clipper1Result->CloneDropTriangulation();
+        return;
+    }
+
+    Clipper2Lib::Clipper64  c;
+    Clipper2Lib::PolyTree64 tree;
+
+    // The pending boolean (or a union, if there is none) builds the tree of outlines and holes
+    prepare( c );
+
+    c.Execute( m_pending ? m_pendingType : Clipper2Lib::ClipType::Union,
+               Clipper2Lib::FillRule::NonZero, tree );
+
+    aResult.importTree( tree, m_zValues, m_arcBuffer );
+    aResult.m_triangulationValid = false;
+    tree.Clear();
+}
+
 void SHAPE_POLY_SET::BooleanAdd( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
     if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
@@ -1144,35 +1412,8 @@ void SHAPE_POLY_SET::inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY
 
     ClipperOffset c;
 
-    // N.B. see the Clipper documentation for jtSquare/jtMiter/jtRound.  They are poorly named
-    // and are not what you'd think they are.
-    // http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Types/JoinType.htm
-    JoinType joinType = JoinType::Round;    // The way corners are offsetted
-    double   miterLimit = 2.0;      // Smaller value when using jtMiter for joinType
-
-    switch( aCornerStrategy )
-    {
-    case CORNER_STRATEGY::ALLOW_ACUTE_CORNERS:
-        joinType = JoinType::Miter;
-        miterLimit = 10;        // Allows large spikes
-        break;
-
-    case CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS: // Acute angles are chamfered
-        joinType = JoinType::Miter;
-        break;
-
-    case CORNER_STRATEGY::ROUND_ACUTE_CORNERS: // Acute angles are rounded
-        joinType = JoinType::Miter;
-        break;
-
-    case CORNER_STRATEGY::CHAMFER_ALL_CORNERS: // All angles are chamfered.
-        joinType = JoinType::Square;
-        break;
-
-    case CORNER_STRATEGY::ROUND_ALL_CORNERS: // All angles are rounded.
-        joinType = JoinType::Round;
-        break;
-    }
+    double   miterLimit;
+    JoinType joinType = clipper2JoinType( aCornerStrategy, miterLimit );
 
     std::vector<CLIPPER_Z_VALUE> zValues;
     std::vector<SHAPE_ARC>       arcBuffer;
@@ -1246,37 +1487,10 @@ void SHAPE_POLY_SET::inflateLine2( const SHAPE_LINE_CHAIN& aLine, int aAmount, i
     #define SEG_CNT_MAX 64
     static double arc_tolerance_factor[SEG_CNT_MAX + 1];
 
-    ClipperOffset c;
-
-    // N.B. see the Clipper documentation for jtSquare/jtMiter/jtRound.  They are poorly named
-    // and are not what you'd think they are.
-    // http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Types/JoinType.htm
-    JoinType joinType = JoinType::Round; // The way corners are offsetted
-    double   miterLimit = 2.0;           // Smaller value when using jtMiter for joinType
-
-    switch( aCornerStrategy )
-    {
-    case CORNER_STRATEGY::ALLOW_ACUTE_CORNERS:
-        joinType = JoinType::Miter;
-        miterLimit = 10; // Allows large spikes
-        break;
-
-    case CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS: // Acute angles are chamfered
-        joinType = JoinType::Miter;
-        break;
-
-    case CORNER_STRATEGY::ROUND_ACUTE_CORNERS: // Acute angles are rounded
-        joinType = JoinType::Miter;
-        break;
-
-    case CORNER_STRATEGY::CHAMFER_ALL_CORNERS: // All angles are chamfered.
-        joinType = JoinType::Square;
-        break;
+    ClipperOffset c;
 
-    case CORNER_STRATEGY::ROUND_ALL_CORNERS: // All angles are rounded.
-        joinType = JoinType::Round;
-        break;
-    }
+    double   miterLimit;
+    JoinType joinType = clipper2JoinType( aCornerStrategy, miterLimit );
 
     std::vector<CLIPPER_Z_VALUE> zValues;
     std::vector<SHAPE_ARC>       arcBuffer;
@@ -1333,11 +1547,174 @@ void SHAPE_POLY_SET::inflateLine2( const SHAPE_LINE_CHAIN& aLine, int aAmount, i
 }
 
 
+bool SHAPE_POLY_SET::inflateConvex( int aAmount, int aCircleSegCount )
+{
+    if( aAmount <= 0 || m_polys.empty() )
+        return false;
+
+    std::vector<std::vector<VECTOR2I>> rings;
+    std::vector<BOX2I>                 boxes;
+
+    rings.reserve( m_polys.size() );
+    boxes.reserve( m_polys.size() );
+
+    for( const POLYGON& poly : m_polys )
+    {
+        if( poly.size() != 1 )
+            return false;
+
+        const SHAPE_LINE_CHAIN& outline = poly.front();
+        std::vector<VECTOR2I>   ring;
+
+        ring.reserve( outline.PointCount() );
+
+        for( int ii = 0; ii < outline.PointCount(); ++ii )
+        {
+            if( ring.empty() || outline.CPoint( ii ) != ring.back() )
+                ring.push_back( outline.CPoint( ii ) );
+        }
+
+        while( ring.size() > 1 && ring.back() == ring.front() )
+            ring.pop_back();
+
+        if( ring.size() < 2 )
+            return false;
+
+        // All the turns must have the same sign; a ring of more than 2 collinear points is
+        // degenerate and is left to Clipper
+        SEG::ecoord area = 0;
+        bool        turnsLeft = false;
+        bool        turnsRight = false;
+
+        for( size_t ii = 0; ii < ring.size(); ++ii )
+        {
+            const VECTOR2I& prev = ring[( ii + ring.size() - 1 ) % ring.size()];
+            const VECTOR2I& next = ring[( ii + 1 ) % ring.size()];
+            SEG::ecoord     cross = ( ring[ii] - prev ).Cross( next - ring[ii] );
+
+            turnsLeft |= cross > 0;
+            turnsRight |= cross < 0;
+            area += SEG::ecoord( prev.x ) * ring[ii].y - SEG::ecoord( ring[ii].x ) * prev.y;
+        }
+
+        if( turnsLeft && turnsRight )
+            return false;
+
+        if( ring.size() > 2 && !turnsLeft && !turnsRight )
+            return false;
+
+        if( area < 0 )
+            std::reverse( ring.begin(), ring.end() );
+
+        BOX2I box = outline.BBox();
+        box.Inflate( aAmount + 1 );
+
+        rings.push_back( std::move( ring ) );
+        boxes.push_back( box );
+    }
+
+    // The outlines must not touch once inflated, or their offsets would need to be merged
+    if( boxes.size() > 1 )
+    {
+        std::vector<size_t> order( boxes.size() );
+
+        for( size_t ii = 0; ii < order.size(); ++ii )
+            order[ii] = ii;
+
+        std::sort( order.begin(), order.end(),
+                   [&]( size_t a, size_t b )
+                   {
+                       return boxes[a].GetLeft() < boxes[b].GetLeft();
+                   } );
+
+        for( size_t ii = 0; ii < order.size(); ++ii )
+        {
+            const BOX2I& box = boxes[order[ii]];
+
+            for( size_t jj = ii + 1; jj < order.size(); ++jj )
+            {
+                const BOX2I& other = boxes[order[jj]];
+
+                if( other.GetLeft() > box.GetRight() )
+                    break;
+
+                if( box.Intersects( other ) )
+                    return false;
+            }
+        }
+    }
+
+    const double stepsPerRadian = std::max( aCircleSegCount, 6 ) / ( 2.0 * M_PI );
+    std::vector<POLYGON> result;
+
+    result.reserve( rings.size() );
+
+    for( const std::vector<VECTOR2I>& ring : rings )
+    {
+        SHAPE_LINE_CHAIN offset;
+        double           totalTurn = 0.0;
+
+        auto normalAngle =
+                []( const VECTOR2I& aFrom, const VECTOR2I& aTo )
+                {
+                    // Outward normal of an edge of a counter-clockwise ring
+                    return atan2( -double( aTo.x - aFrom.x ), double( aTo.y - aFrom.y ) );
+                };
+
+        for( size_t ii = 0; ii < ring.size(); ++ii )
+        {
+            const VECTOR2I& pt = ring[ii];
+            double startAngle = normalAngle( ring[( ii + ring.size() - 1 ) % ring.size()], pt );
+            double endAngle = normalAngle( pt, ring[( ii + 1 ) % ring.size()] );
+            double turn = endAngle - startAngle;
+
+            while( turn < 0.0 )
+                turn += 2.0 * M_PI;
+
+            // A straight angle at both ends of a segment, or a collinear vertex
+            if( ring.size() == 2 )
+                turn = M_PI;
+            else if( turn > 2.0 * M_PI - 1e-9 )
+                turn = 0.0;
+
+            totalTurn += turn;
+
+            int steps = turn > 1e-9 ? KiROUND( std::ceil( turn * stepsPerRadian ) ) : 0;
+
+            for( int step = 0; step <= steps; ++step )
+            {
+                double angle = startAngle + ( steps ? turn * step / steps : 0.0 );
+
+                offset.Append( pt.x + KiROUND( aAmount * cos( angle ) ),
+                               pt.y + KiROUND( aAmount * sin( angle ) ) );
+            }
+        }
+
+        // A ring turning around more than once is self-intersecting, not convex
+        if( totalTurn > 2.0 * M_PI + 1e-6 )
+            return false;
+
+        offset.SetClosed( true );
+        result.emplace_back( POLYGON{ std::move( offset ) } );
+    }
+
+    m_polys = std::move( result );
+    return true;
+}
+
+
 void SHAPE_POLY_SET::Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError,
                               bool aSimplify )
 {
     int segCount = GetArcToSegmentCount( std::abs( aAmount ), aMaxError, FULL_CIRCLE );
 
+    if( aCornerStrategy == CORNER_STRATEGY::ROUND_ALL_CORNERS
+            && ADVANCED_CFG::GetCfg().m_EnableConvexInflateFastPath
+            && inflateConvex( aAmount, segCount ) )
+    {
+        return;
+    }
+
     if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
         inflate2( aAmount, segCount, aCornerStrategy, aSimplify );
     else
@@ -1466,7 +1843,54 @@ struct FractureEdge
 typedef std::vector<FractureEdge> FractureEdgeSet;
 
 
-static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdge::Index provokingIndex,
+/**
+ * The edges of the processed paths of a polygon being fractured, by the horizontal bands of
+ * the polygon their Y range covers, so that finding the edge to bridge a hole to only has to
+ * go through the edges of one band instead of all of them.
+ */
+class FractureEdgeBands
+{
+public:
+    FractureEdgeBands( int aMinY, int aMaxY, size_t aEdgeCount ) :
+            m_minY( aMinY ),
+            m_bandCount( std::clamp<int64_t>( aEdgeCount / 16, 1, 4096 ) ),
+            m_bandHeight( ( (int64_t) aMaxY - aMinY ) / m_bandCount + 1 ),
+            m_bands( m_bandCount )
+    {
+    }
+
+    void Add( const FractureEdgeSet& aEdges, FractureEdge::Index aIndex )
+    {
+        const FractureEdge& edge = aEdges[aIndex];
+        int                 last = band( std::max( edge.m_p1.y, edge.m_p2.y ) );
+
+        for( int ii = band( std::min( edge.m_p1.y, edge.m_p2.y ) ); ii <= last; ++ii )
+            m_bands[ii].push_back( aIndex );
+    }
+
+    /**
+     * @return the edges which may cover \a aY.  Edges shortened by a split may not cover it
+     *         any more.
+     */
+    const std::vector<FractureEdge::Index>& EdgesAt( int aY ) const
+    {
+        return m_bands[band( aY )];
+    }
+
+private:
+    int band( int aY ) const
+    {
+        return std::clamp<int64_t>( ( (int64_t) aY - m_minY ) / m_bandHeight, 0, m_bandCount - 1 );
+    }
+
+    int                                           m_minY;
+    int64_t                                       m_bandCount;
+    int64_t                                       m_bandHeight;
+    std::vector<std::vector<FractureEdge::Index>> m_bands;
+};
+
+
+static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdgeBands& bands,
                                   FractureEdge::Index edgeIndex, FractureEdge::Index bridgeIndex )
 {
     FractureEdge& edge = edges[edgeIndex];
@@ -1475,12 +1899,13 @@ static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdge::Index pr
     int           min_dist = std::numeric_limits<int>::max();
     int           x_nearest = 0;
 
-    FractureEdge* e_nearest = nullptr;
+    FractureEdge*       e_nearest = nullptr;
+    FractureEdge::Index i_nearest = 0;
 
-    // Since this function is run for all holes left to right, no need to
-    // check for any edge beyond the provoking one because they will always be
-    // further to the right, and unconnected to the outline anyway.
-    for( FractureEdge::Index i = 0; i < provokingIndex; i++ )
+    // Since this function is run for all holes left to right, only the edges of the paths
+    // processed before are in the bands: the others will always be further to the right, and
+    // unconnected to the outline anyway.
+    for( FractureEdge::Index i : bands.EdgesAt( y ) )
     {
         FractureEdge& e = edges[i];
         // Don't consider this edge if it can't be bridged to, or faces left.
@@ -1501,11 +1926,13 @@ static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdge::Index pr
 
         int dist = ( x - x_intersect );
 
-        if( dist >= 0 && dist < min_dist )
+        // On a tie, take the first edge, as the bands aren't sorted
+        if( dist >= 0 && ( dist < min_dist || ( dist == min_dist && i < i_nearest ) ) )
         {
             min_dist = dist;
             x_nearest = x_intersect;
             e_nearest = &e;
+            i_nearest = i;
         }
     }
 
@@ -1529,8 +1956,14 @@ static FractureEdge* processHole( FractureEdgeSet& edges, FractureEdge::Index pr
 
         FractureEdge* last = &edge;
         for( ; last->m_next != edgeIndex; last = &edges[last->m_next] )
-            ;
+            bands.Add( edges, last - edges.data() );
+
+        bands.Add( edges, last - edges.data() );
         last->m_next = hole2outline_index;
+
+        bands.Add( edges, outline2hole_index );
+        bands.Add( edges, hole2outline_index );
+        bands.Add( edges, split_index );
     }
 
     return e_nearest;
@@ -1644,10 +2077,17 @@ static void fractureSingleCacheFriendly( SHAPE_POLY_SET::POLYGON& paths )
         outline = false; // first path is always the outline
     }
 
+    // The holes are inside the outline, which is always the first path
+    BOX2I             outlineBox = paths[0].BBox();
+    FractureEdgeBands bands( outlineBox.GetTop(), outlineBox.GetBottom(), edges.size() );
+
+    for( FractureEdge::Index ii = 0; ii < paths[0].PointCount(); ii++ )
+        bands.Add( edges, ii );
+
     for( auto it = sorted_paths.begin() + 1; it != sorted_paths.end(); it++ )
     {
-        auto edge = processHole( edges, it->path_or_provoking_index,
-                                 it->path_or_provoking_index + it->leftmost, it->y_or_bridge );
+        auto edge = processHole( edges, bands, it->path_or_provoking_index + it->leftmost,
+                                 it->y_or_bridge );
 
         // If we can't handle the hole, the zone is broken (maybe)
         if( !edge )
@@ -2110,6 +2550,164 @@ void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 }
 
 
+void SHAPE_POLY_SET::ParallelSimplify( POLYGON_MODE aFastMode )
+{
+    // Below this, the cost of sorting the polygons and of the seam pass isn't worth it
+    static const size_t MIN_OUTLINES_PER_BUCKET = 256;
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       bucketCount = std::min<size_t>( tp.get_thread_count() * 4,
+                                                 m_polys.size() / MIN_OUTLINES_PER_BUCKET );
+
+    if( bucketCount < 2 )
+    {
+        Simplify( aFastMode );
+        return;
+    }
+
+    std::vector<BOX2I> polyBoxes( m_polys.size() );
+    BOX2I              bbox;
+
+    for( size_t ii = 0; ii < m_polys.size(); ++ii )
+    {
+        polyBoxes[ii] = m_polys[ii].front().BBox();
+
+        if( ii == 0 )
+            bbox = polyBoxes[ii];
+        else
+            bbox.Merge( polyBoxes[ii] );
+    }
+
+    // Pick a grid of cells of about the same size in both directions
+    int64_t width = std::max<int64_t>( bbox.GetWidth(), 1 );
+    int64_t height = std::max<int64_t>( bbox.GetHeight(), 1 );
+    int     cols = std::clamp( KiROUND( std::sqrt( bucketCount * (double) width / height ) ), 1,
+                               (int) bucketCount );
+    int     rows = std::max( 1, (int) bucketCount / cols );
+
+    auto cellBox =
+            [&]( int aCol, int aRow )
+            {
+                VECTOR2I start( bbox.GetX() + width * aCol / cols,
+                                bbox.GetY() + height * aRow / rows );
+                VECTOR2I end( bbox.GetX() + width * ( aCol + 1 ) / cols,
+                              bbox.GetY() + height * ( aRow + 1 ) / rows );
+
+                return BOX2I( start, end - start );
+            };
+
+    auto cellCol =
+            [&]( int aX )
+            {
+                return std::clamp<int>( ( aX - (int64_t) bbox.GetX() ) * cols / width, 0,
+                                        cols - 1 );
+            };
+
+    auto cellRow =
+            [&]( int aY )
+            {
+                return std::clamp<int>( ( aY - (int64_t) bbox.GetY() ) * rows / height, 0,
+                                        rows - 1 );
+            };
+
+    // Move each polygon to the cell holding the centre of its bounding box
+    std::vector<SHAPE_POLY_SET> buckets( cols * rows );
+
+    for( size_t ii = 0; ii < m_polys.size(); ++ii )
+    {
+        VECTOR2I centre = polyBoxes[ii].Centre();
+
+        buckets[cellRow( centre.y ) * cols + cellCol( centre.x )].m_polys.push_back(
+                std::move( m_polys[ii] ) );
+    }
+
+    m_polys.clear();
+
+    tp.parallelize_loop( 0, buckets.size(),
+            [&]( size_t aStart, size_t aEnd )
+            {
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                    buckets[ii].Simplify( aFastMode );
+            } ).wait();
+
+    // The results of a bucket don't overlap each other, and can only overlap the results of
+    // other buckets if they cross the edges of their cell.  Those, and whatever they may
+    // overlap, are merged again in a last pass; everything else is already final.
+    struct RESULT
+    {
+        size_t m_bucket;
+        size_t m_index;
+        BOX2I  m_bbox;
+        bool   m_seam;
+    };
+
+    std::vector<RESULT>              results;
+    std::vector<std::vector<size_t>> crossingByCell( buckets.size() );
+
+    for( size_t ii = 0; ii < buckets.size(); ++ii )
+    {
+        BOX2I cell = cellBox( ii % cols, ii / cols );
+
+        for( size_t jj = 0; jj < buckets[ii].m_polys.size(); ++jj )
+        {
+            // Inflated so that results touching the edge of their cell count as crossing it
+            BOX2I polyBox = buckets[ii].m_polys[jj].front().BBox( 1 );
+            bool  crossing = !cell.Contains( polyBox );
+
+            if( crossing )
+            {
+                // One more cell on each side, as cellCol() and cellRow() round differently
+                // from cellBox()
+                int firstRow = std::max( 0, cellRow( polyBox.GetTop() ) - 1 );
+                int lastRow = std::min( rows - 1, cellRow( polyBox.GetBottom() ) + 1 );
+                int firstCol = std::max( 0, cellCol( polyBox.GetLeft() ) - 1 );
+                int lastCol = std::min( cols - 1, cellCol( polyBox.GetRight() ) + 1 );
+
+                for( int row = firstRow; row <= lastRow; ++row )
+                {
+                    for( int col = firstCol; col <= lastCol; ++col )
+                        crossingByCell[row * cols + col].push_back( results.size() );
+                }
+            }
+
+            results.push_back( { ii, jj, polyBox, crossing } );
+        }
+    }
+
+    for( RESULT& result : results )
+    {
+        if( result.m_seam )
+            continue;
+
+        for( size_t crossing : crossingByCell[result.m_bucket] )
+        {
+            if( results[crossing].m_bbox.Intersects( result.m_bbox ) )
+            {
+                result.m_seam = true;
+                break;
+            }
+        }
+    }
+
+    SHAPE_POLY_SET seam;
+
+    for( const RESULT& result : results )
+    {
+        POLYGON& poly = buckets[result.m_bucket].m_polys[result.m_index];
+
+        if( result.m_seam )
+            seam.m_polys.push_back( std::move( poly ) );
+        else
+            m_polys.push_back( std::move( poly ) );
+    }
+
+    seam.Simplify( aFastMode );
+
+    for( POLYGON& poly : seam.m_polys )
+        m_polys.push_back( std::move( poly ) );
+}
+
+
 void SHAPE_POLY_SET::SimplifyOutlines( int aMaxError )
 {
     for( POLYGON& paths : m_polys )
@@ -3146,6 +3744,135 @@ MD5_HASH SHAPE_POLY_SET::GetHash() const
 }
 
 
+// Version of the WriteTriangulation() format; bump it when the format or the triangulation
+// algorithms change, to drop the triangulations written before
+static const int32_t TRIANGULATION_FORMAT_VERSION = 1;
+
+
+bool SHAPE_POLY_SET::WriteTriangulation( std::ostream& aStream ) const
+{
+    if( !IsTriangulationUpToDate() )
+        return false;
+
+    auto write =
+            [&]( int32_t aValue )
+            {
+                aStream.write( reinterpret_cast<const char*>( &aValue ), sizeof( aValue ) );
+            };
+
+    MD5_HASH    hash = m_hash;
+    std::string hashString = hash.Format( true );
+
+    aStream.write( hashString.data(), hashString.size() );
+    write( TRIANGULATION_FORMAT_VERSION );
+    write( m_triangulatedPolys.size() );
+
+    for( const std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
+    {
+        write( tri->GetSourceOutlineIndex() );
+        write( tri->GetVertexCount() );
+
+        for( const VECTOR2I& vertex : tri->Vertices() )
+        {
+            write( vertex.x );
+            write( vertex.y );
+        }
+
+        write( tri->GetTriangleCount() );
+
+        for( const TRIANGULATED_POLYGON::TRI& triangle : tri->Triangles() )
+        {
+            write( triangle.a );
+            write( triangle.b );
+            write( triangle.c );
+        }
+    }
+
+    return aStream.good();
+}
+
+
+bool SHAPE_POLY_SET::ReadTriangulation( std::istream& aStream )
+{
+    auto read =
+            [&]( int32_t& aValue )
+            {
+                aStream.read( reinterpret_cast<char*>( &aValue ), sizeof( aValue ) );
+                return aStream.good();
+            };
+
+    MD5_HASH    hash = checksum();
+    std::string hashString = hash.Format( true );
+    std::string readHash( hashString.size(), '\0' );
+
+    aStream.read( readHash.data(), readHash.size() );
+
+    if( !aStream.good() || readHash != hashString )
+        return false;
+
+    int32_t version = 0;
+    int32_t polyCount = 0;
+
+    if( !read( version ) || version != TRIANGULATION_FORMAT_VERSION || !read( polyCount ) )
+        return false;
+
+    std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> triangulatedPolys;
+
+    for( int32_t ii = 0; ii < polyCount; ++ii )
+    {
+        int32_t sourceOutline = 0;
+        int32_t vertexCount = 0;
+        int32_t triangleCount = 0;
+
+        if( !read( sourceOutline ) || sourceOutline < -1 || sourceOutline >= OutlineCount() )
+            return false;
+
+        if( !read( vertexCount ) || vertexCount < 0 )
+            return false;
+
+        triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>( sourceOutline ) );
+        TRIANGULATED_POLYGON* tri = triangulatedPolys.back().get();
+
+        for( int32_t jj = 0; jj < vertexCount; ++jj )
+        {
+            int32_t x, y;
+
+            if( !read( x ) || !read( y ) )
+                return false;
+
+            tri->AddVertex( VECTOR2I( x, y ) );
+        }
+
+        if( !read( triangleCount ) || triangleCount < 0 )
+            return false;
+
+        for( int32_t jj = 0; jj < triangleCount; ++jj )
+        {
+            int32_t a, b, c;
+
+            if( !read( a ) || !read( b ) || !read( c ) )
+                return false;
+
+            if( a < 0 || a >= vertexCount || b < 0 || b >= vertexCount || c < 0
+                    || c >= vertexCount )
+            {
+                return false;
+            }
+
+            tri->AddTriangle( a, b, c );
+        }
+    }
+
+    std::unique_lock<std::mutex> lock( m_triangulationMutex );
+
+    m_triangulatedPolys = std::move( triangulatedPolys );
+    m_hash = hash;
+    m_triangulationValid = true;
+
+    return true;
+}
+
+
 bool SHAPE_POLY_SET::IsTriangulationUpToDate() const
 {
     if( !m_triangulationValid )
@@ -3308,35 +4035,62 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
 
     if( aPartition )
     {
-        for( int ii = 0; ii < OutlineCount(); ++ii )
-        {
-            // This partitions into regularly-sized grids (1cm in Pcbnew)
-            SHAPE_POLY_SET flattened( Outline( ii ) );
+        using TRIANGULATED_POLYGONS = std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>;
+
+        // The outlines are triangulated in parallel, and their triangulations appended in order
+        std::vector<TRIANGULATED_POLYGONS> outlineTris( OutlineCount() );
+        std::vector<char>                  outlineValid( OutlineCount(), false );
+
+        auto triangulateOutline =
+                [&]( size_t ii )
+                {
+                    // This partitions into regularly-sized grids (1cm in Pcbnew)
+                    SHAPE_POLY_SET flattened( Outline( ii ) );
 
-            for( int jj = 0; jj < HoleCount( ii ); ++jj )
-                flattened.AddHole( Hole( ii, jj ) );
+                    for( int jj = 0; jj < HoleCount( ii ); ++jj )
+                        flattened.AddHole( Hole( ii, jj ) );
 
-            flattened.ClearArcs();
+                    flattened.ClearArcs();
 
-            if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
-                flattened.Fracture( PM_FAST );
-            else if( aSimplify )
-                flattened.Simplify( PM_FAST );
+                    if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
+                        flattened.Fracture( PM_FAST );
+                    else if( aSimplify )
+                        flattened.Simplify( PM_FAST );
 
-            SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
+                    SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
 
-            // This pushes the triangulation for all polys in partitions
-            // to be referenced to the ii-th polygon
-            if( !triangulate( partitions, ii , m_triangulatedPolys, aHintData ) )
+                    // This pushes the triangulation for all polys in partitions
+                    // to be referenced to the ii-th polygon
+                    outlineValid[ii] = triangulate( partitions, ii, outlineTris[ii], aHintData );
+                };
+
+        if( OutlineCount() > 1 )
+            ParallelForEachIndex( OutlineCount(), triangulateOutline );
+        else if( OutlineCount() == 1 )
+            triangulateOutline( 0 );
+
+        bool anyValid = false;
+
+        for( int ii = 0; ii < OutlineCount(); ++ii )
+        {
+            for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : outlineTris[ii] )
             {
-                wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d", ii );
+                // Left over by a failed pass
+                if( tri->GetTriangleCount() > 0 )
+                    m_triangulatedPolys.push_back( std::move( tri ) );
             }
+
+            if( outlineValid[ii] )
+                anyValid = true;
             else
-            {
-                m_hash = checksum();
-                // Set valid flag only after everything has been updated
-                m_triangulationValid = true;
-            }
+                wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d", ii );
+        }
+
+        if( anyValid )
+        {
+            m_hash = checksum();
+            // Set valid flag only after everything has been updated
+            m_triangulationValid = true;
         }
     }
     else
@@ -0,0 +1,134 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <mutex>
+
+#include <geometry/eda_angle.h>
+#include <geometry/unit_circle_table.h>
+
+
+static std::vector<VECTOR2D> buildTable( int aSegCount, bool aHalfStep )
+{
+    std::vector<VECTOR2D> table;
+    EDA_ANGLE             delta = ANGLE_360 / aSegCount;
+
+    // Walk the angles the same way TransformCircleToPolygon() and TransformOvalToPolygon()
+    // do, accumulated rounding included, so that the tables give the very same vertices
+    if( aHalfStep )
+    {
+        for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
+            table.emplace_back( angle.Cos(), angle.Sin() );
+    }
+    else
+    {
+        for( EDA_ANGLE angle = ANGLE_0; angle < ANGLE_360; angle += delta )
+            table.emplace_back( angle.Cos(), angle.Sin() );
+    }
+
+    return table;
+}
+
+
+static const std::vector<VECTOR2D>& getTable( int aSegCount, bool aHalfStep )
+{
+    typedef std::array<std::atomic<const std::vector<VECTOR2D>*>,
+                       UNIT_CIRCLE_TABLE::MAX_CACHED_SEGCOUNT + 1> TABLE_CACHE;
+
+    static TABLE_CACHE                       s_circles;
+    static TABLE_CACHE                       s_semicircles;
+    static std::deque<std::vector<VECTOR2D>> s_storage;
+    static std::mutex                        s_storageMutex;
+
+    aSegCount = std::max( aSegCount, 1 );
+
+    if( aSegCount > UNIT_CIRCLE_TABLE::MAX_CACHED_SEGCOUNT )
+    {
+        thread_local std::vector<VECTOR2D> s_uncached;
+
+        s_uncached = buildTable( aSegCount, aHalfStep );
+        return s_uncached;
+    }
+
+    std::atomic<const std::vector<VECTOR2D>*>& slot = aHalfStep ? s_semicircles[aSegCount]
+                                                                : s_circles[aSegCount];
+
+    if( const std::vector<VECTOR2D>* table = slot.load( std::memory_order_acquire ) )
+        return *table;
+
+    std::lock_guard<std::mutex> lock( s_storageMutex );
+
+    if( const std::vector<VECTOR2D>* table = slot.load( std::memory_order_acquire ) )
+        return *table;
+
+    s_storage.push_back( buildTable( aSegCount, aHalfStep ) );
+    slot.store( &s_storage.back(), std::memory_order_release );
+
+    return s_storage.back();
+}
+
+
+const std::vector<VECTOR2D>& UNIT_CIRCLE_TABLE::Circle( int aSegCount )
+{
+    return getTable( aSegCount, false );
+}
+
+
+const std::vector<VECTOR2D>& UNIT_CIRCLE_TABLE::HalfStepSemicircle( int aSegCount )
+{
+    return getTable( aSegCount, true );
+}
+
+
+std::vector<VECTOR2D> UNIT_CIRCLE_TABLE::Arc( double aStartAngle, double aStep, int aCount )
+{
+    std::vector<VECTOR2D> vertices;
+
+    if( aCount <= 0 )
+        return vertices;
+
+    vertices.reserve( aCount );
+
+    const double stepCos = cos( aStep );
+    const double stepSin = sin( aStep );
+    VECTOR2D     dir( cos( aStartAngle ), sin( aStartAngle ) );
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        // Re-anchor now and then so that the rounding errors of the rotations don't add up
+        if( ii > 0 && ii % 64 == 0 )
+        {
+            double angle = aStartAngle + ii * aStep;
+            dir = VECTOR2D( cos( angle ), sin( angle ) );
+        }
+
+        vertices.push_back( dir );
+        dir = VECTOR2D( dir.x * stepCos - dir.y * stepSin, dir.x * stepSin + dir.y * stepCos );
+    }
+
+    return vertices;
+}
@@ -24,6 +24,7 @@
 #include <wx/filename.h>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -66,3 +67,38 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 
     return fn.GetName().StartsWith( wxT( "." ) );
 }
+
+
+const char* KIPLATFORM::IO::MapFile( const wxString& aPath, size_t& aSize, void*& aHandle )
+{
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return nullptr;
+
+    struct stat fileStat;
+    void*       data = MAP_FAILED;
+
+    if( fstat( fd, &fileStat ) == 0 && fileStat.st_size > 0 )
+        data = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    // The mapping keeps its own reference to the file
+    close( fd );
+
+    if( data == MAP_FAILED )
+        return nullptr;
+
+    madvise( data, fileStat.st_size, MADV_SEQUENTIAL );
+
+    aSize = fileStat.st_size;
+    aHandle = nullptr;
+
+    return static_cast<const char*>( data );
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize, void* aHandle )
+{
+    if( aData )
+        munmap( const_cast<char*>( aData ), aSize );
+}
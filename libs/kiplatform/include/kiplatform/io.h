@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <stddef.h>
 #include <stdio.h>
 
 class wxString;
@@ -50,6 +51,21 @@ namespace IO
     * @return true if the file attribut is set.
     */
     bool IsFileHidden( const wxString& aFileName );
+
+    /**
+     * Map a file read-only into memory.
+     *
+     * @param aSize receives the length of the file.
+     * @param aHandle receives what UnmapFile() needs to release the mapping.
+     * @return the start of the file contents, or nullptr if the file could not be mapped (which
+     *         includes empty files).
+     */
+    const char* MapFile( const wxString& aPath, size_t& aSize, void*& aHandle );
+
+    /**
+     * Release a mapping made by MapFile().
+     */
+    void UnmapFile( const char* aData, size_t aSize, void* aHandle );
 } // namespace IO
 } // namespace KIPLATFORM
 
@@ -123,4 +123,50 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
         result = true;
 
     return result;
-}
\ No newline at end of file
+}
+
+
+const char* KIPLATFORM::IO::MapFile( const wxString& aPath, size_t& aSize, void*& aHandle )
+{
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+    HANDLE        hMapping = NULL;
+
+    if( GetFileSizeEx( hFile, &fileSize ) && fileSize.QuadPart > 0 )
+        hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+    // The mapping keeps its own reference to the file
+    CloseHandle( hFile );
+
+    if( !hMapping )
+        return nullptr;
+
+    const char* data = static_cast<const char*>( MapViewOfFile( hMapping, FILE_MAP_READ,
+                                                                0, 0, 0 ) );
+
+    if( !data )
+    {
+        CloseHandle( hMapping );
+        return nullptr;
+    }
+
+    aSize = static_cast<size_t>( fileSize.QuadPart );
+    aHandle = hMapping;
+
+    return data;
+}
+
+
+void KIPLATFORM::IO::UnmapFile( const char* aData, size_t aSize, void* aHandle )
+{
+    if( aData )
+        UnmapViewOfFile( aData );
+
+    if( aHandle )
+        CloseHandle( static_cast<HANDLE>( aHandle ) );
+}
@@ -25,8 +25,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cstring>
 #include <iterator>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 
+#include <wx/ffile.h>
 #include <wx/log.h>
 
 #include <drc/drc_rtree.h>
@@ -36,8 +42,10 @@
 #include <core/arraydim.h>
 #include <core/kicad_algo.h>
 #include <connectivity/connectivity_data.h>
+#include <connectivity/net_length_cache.h>
 #include <convert_shape_list_to_polygon.h>
 #include <footprint.h>
+#include <memory_accounting.h>
 #include <pcb_base_frame.h>
 #include <pcb_track.h>
 #include <pcb_marker.h>
@@ -76,6 +84,7 @@ BOARD::BOARD() :
         m_LegacyNetclassesLoaded( false ),
         m_boardUse( BOARD_USE::NORMAL ),
         m_timeStamp( 1 ),
+        m_netItemsDirty( true ),
         m_paper( PAGE_INFO::A4 ),
         m_project( nullptr ),
         m_userUnits( EDA_UNITS::MILLIMETRES ),
@@ -126,11 +135,20 @@ BOARD::BOARD() :
     // Set flag bits on these that will only be cleared if these are loaded from a legacy file
     m_LegacyVisibleLayers.reset().set( Rescue );
     m_LegacyVisibleItems.reset().set( GAL_LAYER_INDEX( GAL_LAYER_ID_BITMASK_END ) );
+
+    m_memoryAccount = std::make_unique<MEMORY_ACCOUNT>(
+            [this]( MEMORY_REPORT& aReport )
+            {
+                ReportMemoryUsage( aReport );
+            } );
 }
 
 
 BOARD::~BOARD()
 {
+    // Stop reporting before the items are deleted
+    m_memoryAccount.reset();
+
     // Untangle group parents before doing any deleting
     for( PCB_GROUP* group : m_groups )
     {
@@ -250,9 +268,39 @@ void BOARD::ClearProject()
 }
 
 
+void BOARD::EnableSavedTextCache( bool aEnable )
+{
+    if( !aEnable )
+        m_savedText.reset();
+    else if( !m_savedText )
+        m_savedText = std::make_unique<BOARD_SAVED_TEXT>();
+}
+
+
+void BOARD::InvalidateSavedText( const BOARD_ITEM* aItem )
+{
+    if( !m_savedText || !aItem )
+        return;
+
+    // Footprints are saved as a whole, with their pads, fields, shapes and zones
+    if( const FOOTPRINT* parentFP = aItem->GetParentFootprint() )
+        aItem = parentFP;
+
+    m_savedText->m_entries.erase( aItem );
+}
+
+
+void BOARD::ClearSavedText()
+{
+    if( m_savedText )
+        m_savedText->m_entries.clear();
+}
+
+
 void BOARD::IncrementTimeStamp()
 {
     m_timeStamp++;
+    InvalidateNetItems();
 
     if( !m_IntersectsAreaCache.empty()
         || !m_EnclosedByAreaCache.empty()
@@ -324,8 +372,19 @@ void BOARD::UpdateRatsnestExclusions()
 
 std::vector<PCB_MARKER*> BOARD::ResolveDRCExclusions( bool aCreateMarkers )
 {
+    std::unordered_set<PCB_MARKER::VIOLATION_ID, PCB_MARKER::VIOLATION_ID_HASH> excluded;
+
     for( PCB_MARKER* marker : GetBoard()->Markers() )
     {
+        // Markers kept from an earlier DRC run already carry their exclusion
+        if( marker->IsExcluded() )
+        {
+            if( aCreateMarkers )
+                excluded.insert( marker->GetViolationId() );
+
+            continue;
+        }
+
         wxString                     serialized = marker->Serialize();
         std::set<wxString>::iterator it = m_designSettings->m_DrcExclusions.find( serialized );
 
@@ -347,6 +406,12 @@ std::vector<PCB_MARKER*> BOARD::ResolveDRCExclusions( bool aCreateMarkers )
             if( !marker )
                 continue;
 
+            if( excluded.count( marker->GetViolationId() ) )
+            {
+                delete marker;
+                continue;
+            }
+
             // Check to see if items still exist
             for( const KIID& guid : marker->GetRCItem()->GetIDs() )
             {
@@ -489,21 +554,79 @@ TRACKS BOARD::TracksInNet( int aNetCode )
 {
     TRACKS ret;
 
-    INSPECTOR_FUNC inspector = [aNetCode, &ret]( EDA_ITEM* item, void* testData )
-                               {
-                                   PCB_TRACK* t = static_cast<PCB_TRACK*>( item );
+    for( BOARD_CONNECTED_ITEM* item : GetNetItems( aNetCode ) )
+    {
+        if( item->Type() == PCB_TRACE_T || item->Type() == PCB_ARC_T || item->Type() == PCB_VIA_T )
+            ret.push_back( static_cast<PCB_TRACK*>( item ) );
+    }
 
-                                   if( t->GetNetCode() == aNetCode )
-                                       ret.push_back( t );
+    return ret;
+}
 
-                                   return INSPECT_RESULT::CONTINUE;
-                               };
 
-    // visit this BOARD's PCB_TRACKs and PCB_VIAs with above TRACK INSPECTOR which
-    // appends all in aNetCode to ret.
-    Visit( inspector, nullptr, GENERAL_COLLECTOR::Tracks );
+std::vector<BOARD_CONNECTED_ITEM*> BOARD::GetNetItems( int aNetCode ) const
+{
+    std::unique_lock<std::mutex> lock( m_netItemsMutex );
 
-    return ret;
+    if( m_netItemsDirty.exchange( false ) )
+    {
+        m_netItems.clear();
+
+        auto addItem =
+                [&]( BOARD_CONNECTED_ITEM* aItem )
+                {
+                    m_netItems[aItem->GetNet()].push_back( aItem );
+                };
+
+        for( PCB_TRACK* track : m_tracks )
+            addItem( track );
+
+        for( FOOTPRINT* footprint : m_footprints )
+        {
+            for( PAD* pad : footprint->Pads() )
+                addItem( pad );
+
+            for( ZONE* zone : footprint->Zones() )
+                addItem( zone );
+        }
+
+        for( ZONE* zone : m_zones )
+            addItem( zone );
+    }
+
+    NETINFO_ITEM* net = FindNet( aNetCode );
+    auto          it = net ? m_netItems.find( net ) : m_netItems.end();
+
+    if( it == m_netItems.end() )
+        return {};
+
+    return it->second;
+}
+
+
+void BOARD::ReportMemoryUsage( MEMORY_REPORT& aReport ) const
+{
+    for( const ZONE* zone : m_zones )
+    {
+        aReport.Add( MEMORY_CATEGORY::ZONE_FILLS, zone->GetFillMemoryUsage() );
+        aReport.Add( MEMORY_CATEGORY::TRIANGULATION, zone->GetTriangulationMemoryUsage() );
+    }
+
+    for( const BOARD_ITEM* item : m_drawings )
+    {
+        if( const EDA_TEXT* text = dynamic_cast<const EDA_TEXT*>( item ) )
+        {
+            aReport.Add( MEMORY_CATEGORY::TEXT_CACHE, text->GetRenderCacheMemoryUsage() );
+        }
+        else if( item->Type() == PCB_SHAPE_T )
+        {
+            const SHAPE_POLY_SET& poly = static_cast<const PCB_SHAPE*>( item )->GetPolyShape();
+            aReport.Add( MEMORY_CATEGORY::TRIANGULATION, poly.GetTriangulationMemoryUsage() );
+        }
+    }
+
+    for( const FOOTPRINT* footprint : m_footprints )
+        footprint->ReportMemoryUsage( aReport );
 }
 
 
@@ -854,6 +977,133 @@ void BOARD::CacheTriangulation( PROGRESS_REPORTER* aReporter, const std::vector<
 }
 
 
+void BOARD::PrebuildPadShapes() const
+{
+    std::vector<PAD*> pads;
+
+    for( FOOTPRINT* footprint : m_footprints )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->IsDirty() )
+                pads.push_back( pad );
+        }
+    }
+
+    ParallelForEachIndex( pads.size(),
+            [&]( size_t ii )
+            {
+                pads[ii]->BuildEffectiveShapes( UNDEFINED_LAYER );
+                pads[ii]->BuildEffectivePolygon( ERROR_INSIDE );
+                pads[ii]->BuildEffectivePolygon( ERROR_OUTSIDE );
+            } );
+}
+
+
+// Start of the triangulation cache files, followed by (hash, size, triangulation) entries
+static const std::string triangulationCacheHeader = "KiCad zone triangulation cache\n";
+
+
+bool BOARD::SaveTriangulationCache( const wxString& aFileName ) const
+{
+    std::ostringstream out( std::ios::binary );
+
+    out << triangulationCacheHeader;
+
+    for( ZONE* zone : m_zones )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+            std::ostringstream                     triangulation( std::ios::binary );
+
+            if( !fill->WriteTriangulation( triangulation ) )
+                continue;
+
+            std::string hash = fill->GetHash().Format( true );
+            std::string data = triangulation.str();
+            uint32_t    size = data.size();
+
+            out << hash;
+            out.write( reinterpret_cast<const char*>( &size ), sizeof( size ) );
+            out << data;
+        }
+    }
+
+    wxFFile     file( aFileName, wxT( "wb" ) );
+    std::string data = out.str();
+
+    return file.IsOpened() && file.Write( data.data(), data.size() ) == data.size();
+}
+
+
+void BOARD::RestoreTriangulationCache( const wxString& aFileName )
+{
+    if( !wxFileExists( aFileName ) )
+        return;
+
+    wxFFile     file( aFileName, wxT( "rb" ) );
+    std::string data;
+
+    if( !file.IsOpened() )
+        return;
+
+    data.resize( file.Length() );
+
+    if( file.Read( data.data(), data.size() ) != data.size()
+            || data.compare( 0, triangulationCacheHeader.size(), triangulationCacheHeader ) != 0 )
+    {
+        return;
+    }
+
+    std::unordered_map<std::string, std::string_view> triangulations;
+    std::string_view                                  entries( data );
+    size_t                                            hashSize = MD5_HASH().Format( true ).size();
+
+    entries.remove_prefix( triangulationCacheHeader.size() );
+
+    while( entries.size() >= hashSize + sizeof( uint32_t ) )
+    {
+        std::string hash( entries.substr( 0, hashSize ) );
+        uint32_t    size;
+
+        memcpy( &size, entries.data() + hashSize, sizeof( size ) );
+        entries.remove_prefix( hashSize + sizeof( size ) );
+
+        if( size > entries.size() )
+            break;
+
+        triangulations[hash] = entries.substr( 0, size );
+        entries.remove_prefix( size );
+    }
+
+    for( ZONE* zone : m_zones )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+
+            if( fill->OutlineCount() == 0 || fill->IsTriangulationUpToDate() )
+                continue;
+
+            auto it = triangulations.find( fill->GetHash().Format( true ) );
+
+            if( it != triangulations.end() )
+            {
+                std::istringstream in( std::string( it->second ), std::ios::binary );
+                fill->ReadTriangulation( in );
+            }
+        }
+    }
+}
+
+
 void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode, bool aSkipConnectivity )
 {
     if( aBoardItem == nullptr )
@@ -947,6 +1197,11 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode, bool aSkipConnectivity
     aBoardItem->SetParent( this );
     aBoardItem->ClearEditFlags();
 
+    if( aBoardItem->Type() != PCB_NETINFO_T )
+        CacheItemById( aBoardItem );
+
+    InvalidateNetItems();
+
     if( !aSkipConnectivity )
         m_connectivity->Add( aBoardItem );
 
@@ -1038,6 +1293,9 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
 
     aBoardItem->SetFlags( STRUCT_DELETED );
 
+    UncacheItemById( aBoardItem );
+    InvalidateNetItems();
+
     PCB_GROUP* parentGroup = aBoardItem->GetParentGroup();
 
     if( parentGroup && !( parentGroup->GetFlags() & STRUCT_DELETED ) )
@@ -1086,7 +1344,10 @@ void BOARD::DeleteMARKERs()
 {
     // the vector does not know how to delete the PCB_MARKER, it holds pointers
     for( PCB_MARKER* marker : m_markers )
+    {
+        UncacheItemById( marker );
         delete marker;
+    }
 
     m_markers.clear();
 }
@@ -1102,6 +1363,28 @@ void BOARD::DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions )
         if( ( marker->GetSeverity() == RPT_SEVERITY_EXCLUSION && aExclusions )
                 || ( marker->GetSeverity() != RPT_SEVERITY_EXCLUSION && aWarningsAndErrors ) )
         {
+            UncacheItemById( marker );
+            delete marker;
+        }
+        else
+        {
+            remaining.push_back( marker );
+        }
+    }
+
+    m_markers = remaining;
+}
+
+
+void BOARD::DeleteMARKERs( const std::unordered_set<PCB_MARKER*>& aMarkers )
+{
+    MARKERS remaining;
+
+    for( PCB_MARKER* marker : m_markers )
+    {
+        if( aMarkers.count( marker ) )
+        {
+            UncacheItemById( marker );
             delete marker;
         }
         else
@@ -1117,60 +1400,148 @@ void BOARD::DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions )
 void BOARD::DeleteAllFootprints()
 {
     for( FOOTPRINT* footprint : m_footprints )
+    {
+        UncacheItemById( footprint );
         delete footprint;
+    }
 
     m_footprints.clear();
     IncrementTimeStamp();
 }
 
 
-BOARD_ITEM* BOARD::GetItem( const KIID& aID ) const
+/**
+ * @return the item of \a aFootprint or of its children having \a aID, or nullptr.
+ */
+static BOARD_ITEM* findFootprintItem( FOOTPRINT* aFootprint, const KIID& aID )
 {
-    if( aID == niluuid )
-        return nullptr;
+    if( aFootprint->m_Uuid == aID )
+        return aFootprint;
 
-    for( PCB_TRACK* track : Tracks() )
+    for( PAD* pad : aFootprint->Pads() )
     {
-        if( track->m_Uuid == aID )
-            return track;
+        if( pad->m_Uuid == aID )
+            return pad;
     }
 
-    for( FOOTPRINT* footprint : Footprints() )
+    for( PCB_FIELD* field : aFootprint->Fields() )
     {
-        if( footprint->m_Uuid == aID )
-            return footprint;
+        if( field->m_Uuid == aID )
+            return field;
+    }
 
-        for( PAD* pad : footprint->Pads() )
-        {
-            if( pad->m_Uuid == aID )
-                return pad;
-        }
+    for( BOARD_ITEM* drawing : aFootprint->GraphicalItems() )
+    {
+        if( drawing->m_Uuid == aID )
+            return drawing;
+    }
 
-        for( PCB_FIELD* field : footprint->Fields() )
-        {
-            if( field->m_Uuid == aID )
-                return field;
-        }
+    for( BOARD_ITEM* zone : aFootprint->Zones() )
+    {
+        if( zone->m_Uuid == aID )
+            return zone;
+    }
 
-        for( BOARD_ITEM* drawing : footprint->GraphicalItems() )
-        {
-            if( drawing->m_Uuid == aID )
-                return drawing;
-        }
+    for( PCB_GROUP* group : aFootprint->Groups() )
+    {
+        if( group->m_Uuid == aID )
+            return group;
+    }
+
+    return nullptr;
+}
+
+
+void BOARD::CacheItemById( BOARD_ITEM* aItem )
+{
+    BOARD_ITEM* owner = aItem;
+
+    if( FOOTPRINT* parentFootprint = aItem->GetParentFootprint() )
+        owner = parentFootprint;
+    else
+        m_cachedItems.insert( aItem );
+
+    if( aItem->m_Uuid != niluuid )
+        m_itemByIdCache[aItem->m_Uuid] = owner;
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        static_cast<FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    if( aChild->m_Uuid != niluuid )
+                        m_itemByIdCache[aChild->m_Uuid] = aItem;
+                } );
+    }
+}
 
-        for( BOARD_ITEM* zone : footprint->Zones() )
-        {
-            if( zone->m_Uuid == aID )
-                return zone;
-        }
 
-        for( PCB_GROUP* group : footprint->Groups() )
+void BOARD::UncacheItemById( BOARD_ITEM* aItem )
+{
+    BOARD_ITEM* owner = aItem->GetParentFootprint();
+
+    if( !owner )
+    {
+        owner = aItem;
+        m_cachedItems.erase( aItem );
+    }
+
+    auto uncache =
+            [&]( const KIID& aId )
+            {
+                auto it = m_itemByIdCache.find( aId );
+
+                if( it != m_itemByIdCache.end() && it->second == owner )
+                    m_itemByIdCache.erase( it );
+            };
+
+    uncache( aItem->m_Uuid );
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        static_cast<FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    uncache( aChild->m_Uuid );
+                } );
+    }
+}
+
+
+BOARD_ITEM* BOARD::GetItem( const KIID& aID ) const
+{
+    if( aID == niluuid )
+        return nullptr;
+
+    auto cached = m_itemByIdCache.find( aID );
+
+    if( cached != m_itemByIdCache.end() && m_cachedItems.count( cached->second ) )
+    {
+        BOARD_ITEM* item = cached->second;
+
+        if( item->m_Uuid == aID )
+            return item;
+
+        if( item->Type() == PCB_FOOTPRINT_T )
         {
-            if( group->m_Uuid == aID )
-                return group;
+            if( BOARD_ITEM* child = findFootprintItem( static_cast<FOOTPRINT*>( item ), aID ) )
+                return child;
         }
     }
 
+    // Not indexed, or indexed under a previous KIID: search all the items
+    for( PCB_TRACK* track : Tracks() )
+    {
+        if( track->m_Uuid == aID )
+            return track;
+    }
+
+    for( FOOTPRINT* footprint : Footprints() )
+    {
+        if( BOARD_ITEM* item = findFootprintItem( footprint, aID ) )
+            return item;
+    }
+
     for( ZONE* zone : Zones() )
     {
         if( zone->m_Uuid == aID )
@@ -1978,11 +2349,19 @@ bool sortPadsByXthenYCoord( PAD* const & aLH, PAD* const & aRH )
 
 void BOARD::GetSortedPadListByXthenYCoord( std::vector<PAD*>& aVector, int aNetCode ) const
 {
-    for( FOOTPRINT* footprint : Footprints() )
+    if( aNetCode >= 0 )
     {
-        for( PAD* pad : footprint->Pads( ) )
+        for( BOARD_CONNECTED_ITEM* item : GetNetItems( aNetCode ) )
         {
-            if( aNetCode < 0 || pad->GetNetCode() == aNetCode )
+            if( item->Type() == PCB_PAD_T )
+                aVector.push_back( static_cast<PAD*>( item ) );
+        }
+    }
+    else
+    {
+        for( FOOTPRINT* footprint : Footprints() )
+        {
+            for( PAD* pad : footprint->Pads( ) )
                 aVector.push_back( pad );
         }
     }
@@ -1997,77 +2376,24 @@ std::tuple<int, double, double> BOARD::GetTrackLength( const PCB_TRACK& aTrack )
     double length = 0.0;
     double package_length = 0.0;
 
-    auto              connectivity = GetBoard()->GetConnectivity();
-    BOARD_STACKUP&    stackup      = GetDesignSettings().GetStackupDescriptor();
-    bool              useHeight    = GetDesignSettings().m_UseHeightForLengthCalcs;
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = GetBoard()->GetConnectivity();
+    std::shared_ptr<NET_LENGTH_CACHE>  lengthCache = connectivity->GetNetLengthCache();
+    bool                               useHeight = GetDesignSettings().m_UseHeightForLengthCalcs;
+
+    lengthCache->Update( this, { aTrack.GetNetCode() } );
 
     for( BOARD_CONNECTED_ITEM* item : connectivity->GetConnectedItems(
             static_cast<const BOARD_CONNECTED_ITEM*>( &aTrack ),
             { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, PCB_PAD_T } ) )
     {
-        count++;
-
-        if( PCB_TRACK* track = dynamic_cast<PCB_TRACK*>( item ) )
-        {
-            if( track->Type() == PCB_VIA_T && useHeight )
-            {
-                PCB_VIA* via = static_cast<PCB_VIA*>( track );
-                length += stackup.GetLayerDistance( via->TopLayer(), via->BottomLayer() );
-                continue;
-            }
-            else if( track->Type() == PCB_ARC_T )
-            {
-                // Note: we don't apply the clip-to-pad optimization if an arc ends in a pad
-                // Room for future improvement.
-                length += track->GetLength();
-                continue;
-            }
+        NET_LENGTH_CACHE::ITEM_LENGTH itemLength = lengthCache->GetItemLength( item );
 
-            bool   inPad = false;
-            SEG    trackSeg( track->GetStart(), track->GetEnd() );
-            double segLen      = trackSeg.Length();
-            double segInPadLen = 0;
-
-            for( auto pad_it : connectivity->GetConnectedPads( item ) )
-            {
-                PAD* pad = static_cast<PAD*>( pad_it );
-
-                bool hitStart = pad->HitTest( track->GetStart(), track->GetWidth() / 2 );
-                bool hitEnd   = pad->HitTest( track->GetEnd(), track->GetWidth() / 2 );
-
-                if( hitStart && hitEnd )
-                {
-                    inPad = true;
-                    break;
-                }
-                else if( hitStart || hitEnd )
-                {
-                    VECTOR2I loc;
-
-                    // We may not collide even if we passed the bounding-box hit test
-                    if( pad->GetEffectivePolygon( ERROR_INSIDE )->Collide( trackSeg, 0, nullptr, &loc ) )
-                    {
-                        // Part 1: length of the seg to the intersection with the pad poly
-                        if( hitStart )
-                            trackSeg.A = loc;
-                        else
-                            trackSeg.B = loc;
-
-                        segLen = trackSeg.Length();
-
-                        // Part 2: length from the intersection to the pad anchor
-                        segInPadLen += ( loc - pad->GetPosition() ).EuclideanNorm();
-                    }
-                }
-            }
+        count++;
+        length += itemLength.m_track;
+        package_length += itemLength.m_padToDie;
 
-            if( !inPad )
-                length += segLen + segInPadLen;
-        }
-        else if( PAD* pad = dynamic_cast<PAD*>( item ) )
-        {
-            package_length += pad->GetPadToDieLength();
-        }
+        if( useHeight )
+            length += itemLength.m_via;
     }
 
     return std::make_tuple( count, length, package_length );
@@ -35,8 +35,12 @@
 #include <pcb_plot_params.h>
 #include <title_block.h>
 #include <tools/pcb_selection.h>
+#include <atomic>
 #include <mutex>
 #include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 class BOARD_DESIGN_SETTINGS;
 class BOARD_CONNECTED_ITEM;
@@ -61,6 +65,8 @@ class CONNECTIVITY_DATA;
 class COMPONENT;
 class PROJECT;
 class PROGRESS_REPORTER;
+class MEMORY_ACCOUNT;
+class MEMORY_REPORT;
 struct ISOLATED_ISLANDS;
 
 // The default value for m_outlinesChainingEpsilon to convert a board outlines to polygons
@@ -254,6 +260,22 @@ public:
     virtual void OnBoardRatsnestChanged( BOARD& aBoard ) { }
 };
 
+/**
+ * The file text of the top level items of a board as they were last saved, so that a save only
+ * has to format the items changed since.  See BOARD::EnableSavedTextCache().
+ */
+struct BOARD_SAVED_TEXT
+{
+    struct ENTRY
+    {
+        KIID        m_uuid;     ///< The item the text was made from, in case its address got reused
+        std::string m_text;
+    };
+
+    size_t                                        m_context = 0;    ///< Hash of the save settings
+    std::unordered_map<const BOARD_ITEM*, ENTRY>  m_entries;
+};
+
 /**
  * Set of BOARD_ITEMs ordered by UUID.
  */
@@ -298,6 +320,24 @@ public:
 
     int GetTimeStamp() const { return m_timeStamp; }
 
+    /**
+     * Keep the file text of the top level items as they are saved, so that the next saves only
+     * format the items changed since.  All changes must then go through BOARD_COMMIT or the
+     * undo list, which call InvalidateSavedText() for the items they change.
+     */
+    void EnableSavedTextCache( bool aEnable );
+
+    ///< The saved text cache, or nullptr if it isn't enabled
+    BOARD_SAVED_TEXT* GetSavedTextCache() const { return m_savedText.get(); }
+
+    /**
+     * Drop the saved text of the top level item \a aItem belongs to, after it was changed.
+     */
+    void InvalidateSavedText( const BOARD_ITEM* aItem );
+
+    ///< Drop the saved text of all the items, after changes which weren't tracked
+    void ClearSavedText();
+
     /**
      * Find out if the board is being used to hold a single footprint for editing/viewing.
      *
@@ -404,6 +444,29 @@ public:
     void CacheTriangulation( PROGRESS_REPORTER* aReporter = nullptr,
                              const std::vector<ZONE*>& aZones = {} );
 
+    /**
+     * Build the effective shapes and polygons of all the dirty pads, in parallel.
+     *
+     * Run before the multithreaded stages (DRC, zone fill, connectivity) so that their threads
+     * read the published caches instead of waiting for the first one to build them.
+     */
+    void PrebuildPadShapes() const;
+
+    /**
+     * Write the up to date triangulations of the zone fills to \a aFileName, so that
+     * RestoreTriangulationCache() can restore them when the board is opened again.
+     *
+     * @return false if the file couldn't be written.
+     */
+    bool SaveTriangulationCache( const wxString& aFileName ) const;
+
+    /**
+     * Restore the triangulations of the zone fills from a file written by
+     * SaveTriangulationCache().  Only the triangulations made from the same polygons as the
+     * current fills are restored; CacheTriangulation() triangulates the others.
+     */
+    void RestoreTriangulationCache( const wxString& aFileName );
+
     /**
      * Get the first footprint on the board or nullptr.
      *
@@ -426,6 +489,24 @@ public:
      */
     BOARD_ITEM* GetItem( const KIID& aID ) const;
 
+    /**
+     * Add \a aItem to the index used by GetItem(), with the children of a footprint.
+     *
+     * BOARD::Add() and BOARD_COMMIT keep the index up to date: this is only needed for items
+     * inserted in the board lists directly.  FOOTPRINT::Add() does not update it, as boards
+     * are parsed in parallel into footprints already parented to the board.  Items missing
+     * from the index are still found by GetItem(), only slower.
+     */
+    void CacheItemById( BOARD_ITEM* aItem );
+
+    /**
+     * Remove \a aItem from the index used by GetItem().
+     *
+     * This must be called for items removed from the board lists without BOARD::Remove()
+     * before they are deleted.
+     */
+    void UncacheItemById( BOARD_ITEM* aItem );
+
     void FillItemMap( std::map<KIID, EDA_ITEM*>& aMap );
 
     /**
@@ -454,6 +535,11 @@ public:
 
     void DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions );
 
+    /**
+     * Delete the given markers from the board, in a single pass over its markers.
+     */
+    void DeleteMARKERs( const std::unordered_set<PCB_MARKER*>& aMarkers );
+
     PROJECT* GetProject() const { return m_project; }
 
     /**
@@ -1113,6 +1199,33 @@ public:
      */
     TRACKS TracksInNet( int aNetCode );
 
+    /**
+     * Return the tracks, vias, pads and zones of a net, in the order of the board lists.
+     *
+     * The items are taken from a per-net index, rebuilt after the board or the net of one of
+     * its items has changed, so that asking for the items of every net is not quadratic.
+     *
+     * @param aNetCode gives the id of the net.
+     */
+    std::vector<BOARD_CONNECTED_ITEM*> GetNetItems( int aNetCode ) const;
+
+    /**
+     * Mark the per-net index of GetNetItems() as outdated.
+     *
+     * This is done by the board and its items when the nets of the items change; it can be
+     * called from several threads.
+     */
+    void InvalidateNetItems() { m_netItemsDirty.store( true, std::memory_order_relaxed ); }
+
+    /**
+     * Add an estimate of the memory held by the zone fills, the triangulations and the text
+     * render caches of the board items to \a aReport.
+     *
+     * Every board reports this to MEMORY_ACCOUNT::Collect(), which must be called from the
+     * thread modifying the board.
+     */
+    void ReportMemoryUsage( MEMORY_REPORT& aReport ) const;
+
     /**
      * Get a footprint by its bounding rectangle at \a aPosition on \a aLayer.
      *
@@ -1280,6 +1393,20 @@ private:
     ZONES               m_zones;
     GENERATORS          m_generators;
 
+    /**
+     * The index of GetItem().  The children of a footprint are indexed by their footprint, as
+     * they are changed in many ways while the footprint is on the board.  An entry is only
+     * used if its item is in m_cachedItems, so an entry left by an item whose KIID changed
+     * is never followed after the item is deleted.
+     */
+    std::unordered_map<KIID, BOARD_ITEM*> m_itemByIdCache;
+    std::unordered_set<const BOARD_ITEM*> m_cachedItems;
+
+    /// The index of GetNetItems(), by net
+    mutable std::unordered_map<const NETINFO_ITEM*, std::vector<BOARD_CONNECTED_ITEM*>> m_netItems;
+    mutable std::atomic<bool> m_netItemsDirty;
+    mutable std::mutex        m_netItemsMutex;
+
     LAYER               m_layers[PCB_LAYER_ID_COUNT];
 
     HIGH_LIGHT_INFO     m_highLight;                // current high light data
@@ -1318,6 +1445,10 @@ private:
     NETINFO_LIST                 m_NetInfo;         // net info list (name, design constraints...
 
     std::vector<BOARD_LISTENER*> m_listeners;
+
+    std::unique_ptr<BOARD_SAVED_TEXT> m_savedText;
+
+    std::unique_ptr<MEMORY_ACCOUNT> m_memoryAccount;
 };
 
 
@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <macros.h>
 #include <board.h>
 #include <footprint.h>
@@ -38,14 +39,17 @@
 #include <connectivity/connectivity_data.h>
 #include <teardrop/teardrop.h>
 
+#include <algorithm>
 #include <functional>
+#include <unordered_map>
 using namespace std::placeholders;
 
 
 BOARD_COMMIT::BOARD_COMMIT( TOOL_BASE* aTool ) :
         m_toolMgr( aTool->GetManager() ),
         m_isBoardEditor( false ),
-        m_isFootprintEditor( false )
+        m_isFootprintEditor( false ),
+        m_zoneIndexValid( false )
 {
     if( PCB_TOOL_BASE* pcb_tool = dynamic_cast<PCB_TOOL_BASE*>( aTool ) )
     {
@@ -58,7 +62,8 @@ BOARD_COMMIT::BOARD_COMMIT( TOOL_BASE* aTool ) :
 BOARD_COMMIT::BOARD_COMMIT( EDA_DRAW_FRAME* aFrame ) :
         m_toolMgr( aFrame->GetToolManager() ),
         m_isBoardEditor( aFrame->IsType( FRAME_PCB_EDITOR ) ),
-        m_isFootprintEditor( aFrame->IsType( FRAME_FOOTPRINT_EDITOR ) )
+        m_isFootprintEditor( aFrame->IsType( FRAME_FOOTPRINT_EDITOR ) ),
+        m_zoneIndexValid( false )
 {
 }
 
@@ -66,7 +71,8 @@ BOARD_COMMIT::BOARD_COMMIT( EDA_DRAW_FRAME* aFrame ) :
 BOARD_COMMIT::BOARD_COMMIT( TOOL_MANAGER* aMgr ) :
         m_toolMgr( aMgr ),
         m_isBoardEditor( false ),
-        m_isFootprintEditor( false )
+        m_isFootprintEditor( false ),
+        m_zoneIndexValid( false )
 {
     EDA_DRAW_FRAME* frame = dynamic_cast<EDA_DRAW_FRAME*>( aMgr->GetToolHolder() );
 
@@ -134,22 +140,45 @@ void BOARD_COMMIT::dirtyIntersectingZones( BOARD_ITEM* item, int aChangeType )
     BOX2I  bbox = item->GetBoundingBox();
     LSET   layers = item->GetLayerSet();
 
-    if( layers.test( Edge_Cuts ) || layers.test( Margin ) )
+    // Board outline changes can affect a fill anywhere, so they dirty the whole zone.  Other
+    // changes only dirty the area they cover.
+    bool boardOutline = layers.test( Edge_Cuts ) || layers.test( Margin );
+
+    if( boardOutline )
         layers = LSET::PhysicalLayersMask();
     else
         layers &= LSET::AllCuMask();
 
     if( layers.any() )
     {
-        for( ZONE* zone : board->Zones() )
+        auto dirtyZone =
+                [&]( ZONE* zone ) -> bool
+                {
+                    if( ( zone->GetLayerSet() & layers ).any()
+                            && zone->GetBoundingBox().Intersects( bbox ) )
+                    {
+                        if( boardOutline || item->Type() == PCB_ZONE_T )
+                            zoneFillerTool->DirtyZone( zone );
+                        else
+                            zoneFillerTool->DirtyZoneArea( zone, bbox );
+                    }
+
+                    return true;
+                };
+
+        if( m_zoneIndexValid )
         {
-            if( zone->GetIsRuleArea() )
-                continue;
+            const int min[2] = { bbox.GetLeft(), bbox.GetTop() };
+            const int max[2] = { bbox.GetRight(), bbox.GetBottom() };
 
-            if( ( zone->GetLayerSet() & layers ).any()
-                    && zone->GetBoundingBox().Intersects( bbox ) )
+            m_zoneIndex.Search( min, max, dirtyZone );
+        }
+        else
+        {
+            for( ZONE* zone : board->Zones() )
             {
-                zoneFillerTool->DirtyZone( zone );
+                if( !zone->GetIsRuleArea() )
+                    dirtyZone( zone );
             }
         }
     }
@@ -162,6 +191,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     BOARD*              board = static_cast<BOARD*>( m_toolMgr->GetModel() );
     PCB_BASE_FRAME*     frame = dynamic_cast<PCB_BASE_FRAME*>( m_toolMgr->GetToolHolder() );
     PCB_SELECTION_TOOL* selTool = m_toolMgr->GetTool<PCB_SELECTION_TOOL>();
+    ZONE_FILLER_TOOL*   zoneFillerTool = m_toolMgr->GetTool<ZONE_FILLER_TOOL>();
 
     // Notification info
     PICKED_ITEMS_LIST   undoList;
@@ -195,8 +225,26 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     {
         autofillZones = true;
 
+        // Large commits would otherwise test every zone for every item they change
+        m_zoneIndex.Clear();
+        m_zoneIndex.Reserve( board->Zones().size() );
+
         for( ZONE* zone : board->Zones() )
+        {
             zone->CacheBoundingBox();
+
+            if( zone->GetIsRuleArea() )
+                continue;
+
+            BOX2I     bbox = zone->GetBoundingBox();
+            const int min[2] = { bbox.GetLeft(), bbox.GetTop() };
+            const int max[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+            m_zoneIndex.Add( min, max, zone );
+        }
+
+        m_zoneIndex.Build();
+        m_zoneIndexValid = true;
     }
 
     for( COMMIT_LINE& ent : m_changes )
@@ -211,6 +259,11 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 solderMaskDirty = true;
             }
 
+            // Cached zone knockouts are validated against the item geometry anyway; dropping
+            // them here just keeps the cache from accumulating stale entries.
+            if( zoneFillerTool && ( ent.m_type & CHT_TYPE ) != CHT_ADD )
+                zoneFillerTool->InvalidateKnockouts( boardItem );
+
             if( !( aCommitFlags & SKIP_TEARDROPS ) )
             {
                 if( boardItem->Type() == PCB_FOOTPRINT_T )
@@ -250,6 +303,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     if( !staleTeardropPadsAndVias.empty() || !staleTeardropTracks.empty() )
         teardropMgr.RemoveTeardrops( *this, &staleTeardropPadsAndVias, &staleTeardropTracks );
 
+    // The view is updated in one go once all the changes are applied; removing items one by
+    // one means searching the whole view for each of them
+    std::vector<KIGFX::VIEW_ITEM*>                viewAddedItems;
+    std::vector<KIGFX::VIEW_ITEM*>                viewRemovedItems;
+    std::unordered_map<KIGFX::VIEW_ITEM*, size_t> viewAddedIndex;
+
     for( COMMIT_LINE& ent : m_changes )
     {
         int changeType = ent.m_type & CHT_TYPE;
@@ -259,6 +318,16 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
         wxASSERT( ent.m_item );
         wxCHECK2( boardItem, continue );
 
+        // The zone index doesn't know about zones added or removed since Push() began
+        if( boardItem->Type() == PCB_ZONE_T
+                && ( changeType == CHT_ADD || changeType == CHT_REMOVE ) )
+        {
+            m_zoneIndexValid = false;
+        }
+
+        // Before the item can be deleted below
+        board->InvalidateSavedText( boardItem );
+
         switch( changeType )
         {
         case CHT_ADD:
@@ -283,6 +352,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 else if( FOOTPRINT* parentFP = boardItem->GetParentFootprint() )
                 {
                     parentFP->Add( boardItem );
+                    board->CacheItemById( boardItem );
                 }
                 else
                 {
@@ -298,7 +368,10 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 dirtyIntersectingZones( boardItem, changeType );
 
             if( view && boardItem->Type() != PCB_NETINFO_T )
-                view->Add( boardItem );
+            {
+                viewAddedIndex[boardItem] = viewAddedItems.size();
+                viewAddedItems.push_back( boardItem );
+            }
 
             break;
 
@@ -353,7 +426,20 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             case PCB_FOOTPRINT_T:
             case PCB_GROUP_T:
                 if( view )
-                    view->Remove( boardItem );
+                {
+                    auto added = viewAddedIndex.find( boardItem );
+
+                    // Added by this same commit, so not in the view yet
+                    if( added != viewAddedIndex.end() )
+                    {
+                        viewAddedItems[added->second] = nullptr;
+                        viewAddedIndex.erase( added );
+                    }
+                    else
+                    {
+                        viewRemovedItems.push_back( boardItem );
+                    }
+                }
 
                 if( !( changeFlags & CHT_DONE ) )
                 {
@@ -433,6 +519,10 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 connectivity->Update( boardItem );
             }
 
+            // The children of a footprint may have been added or replaced
+            if( boardItem->Type() == PCB_FOOTPRINT_T && boardItem->GetParent() == board )
+                board->CacheItemById( boardItem );
+
             if( m_isBoardEditor && autofillZones )
             {
                 dirtyIntersectingZones( boardItemCopy, changeType );   // before
@@ -464,6 +554,19 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 } );
     }
 
+    if( view )
+    {
+        // Removed first, as an item can be removed and then added back by the same commit
+        view->RemoveItems( viewRemovedItems );
+
+        viewAddedItems.erase( std::remove( viewAddedItems.begin(), viewAddedItems.end(), nullptr ),
+                              viewAddedItems.end() );
+        view->AddItems( viewAddedItems );
+    }
+
+    m_zoneIndex.Clear();
+    m_zoneIndexValid = false;
+
     if( m_isBoardEditor )
     {
         size_t num_changes = m_changes.size();
@@ -473,6 +576,36 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             connectivity->ClearRatsnest();
             connectivity->ClearLocalRatsnest();
         }
+        else if( frame && ADVANCED_CFG::GetCfg().m_AsyncRatsnest )
+        {
+            std::weak_ptr<CONNECTIVITY_DATA> weakConnectivity = connectivity;
+
+            // Finish the ratsnest-dependent updates on the UI thread once it is ready
+            auto onRatsnestReady =
+                    [frame, weakConnectivity]()
+                    {
+                        std::shared_ptr<CONNECTIVITY_DATA> conn = weakConnectivity.lock();
+                        BOARD*                             brd = frame->GetBoard();
+
+                        // The board may have been reloaded in the meantime
+                        if( !conn || !brd || brd->GetConnectivity() != conn )
+                            return;
+
+                        conn->WaitForRatsnest();
+                        brd->UpdateRatsnestExclusions();
+                        frame->GetCanvas()->RedrawRatsnest();
+                        brd->OnRatsnestChanged();
+                    };
+
+            connectivity->RecalculateRatsnestAsync( this,
+                    [frame, onRatsnestReady]()
+                    {
+                        frame->CallAfter( onRatsnestReady );
+                    } );
+
+            connectivity->ClearLocalRatsnest();
+            frame->GetCanvas()->RedrawRatsnest();
+        }
         else
         {
             connectivity->RecalculateRatsnest( this );
@@ -508,6 +641,8 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
 
             wxCHECK2( boardItem, continue );
 
+            board->InvalidateSavedText( boardItem );
+
             if( !( aCommitFlags & SKIP_UNDO ) )
             {
                 ITEM_PICKER itemWrapper( nullptr, boardItem, convert( ent.m_type & CHT_TYPE ) );
@@ -617,6 +752,9 @@ void BOARD_COMMIT::Revert()
 
     board->IncrementTimeStamp();   // clear caches
 
+    // Rebuilding the connectivity below can change nets without going through a commit
+    board->ClearSavedText();
+
     std::vector<BOARD_ITEM*> bulkAddedItems;
     std::vector<BOARD_ITEM*> bulkRemovedItems;
     std::vector<BOARD_ITEM*> itemsChanged;
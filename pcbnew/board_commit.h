@@ -27,9 +27,11 @@
 #define BOARD_COMMIT_H
 
 #include <commit.h>
+#include <geometry/packed_rtree.h>
 
 class BOARD_ITEM;
 class BOARD;
+class ZONE;
 class PICKED_ITEMS_LIST;
 class PCB_TOOL_BASE;
 class TOOL_MANAGER;
@@ -78,6 +80,11 @@ private:
     TOOL_MANAGER*  m_toolMgr;
     bool           m_isBoardEditor;
     bool           m_isFootprintEditor;
+
+    /// The fillable zones of the board by bounding box, for dirtyIntersectingZones() during
+    /// Push().  No longer valid once the commit adds or removes a zone.
+    PACKED_RTREE<ZONE*> m_zoneIndex;
+    bool                m_zoneIndexValid;
 };
 
 #endif
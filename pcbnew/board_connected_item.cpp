@@ -42,6 +42,15 @@ BOARD_CONNECTED_ITEM::BOARD_CONNECTED_ITEM( BOARD_ITEM* aParent, KICAD_T idtype
 }
 
 
+void BOARD_CONNECTED_ITEM::SetNet( NETINFO_ITEM* aNetInfo )
+{
+    m_netinfo = aNetInfo;
+
+    if( BOARD* board = GetBoard() )
+        board->InvalidateNetItems();
+}
+
+
 bool BOARD_CONNECTED_ITEM::SetNetCode( int aNetCode, bool aNoAssert )
 {
     if( !IsOnCopperLayer() )
@@ -57,6 +66,9 @@ bool BOARD_CONNECTED_ITEM::SetNetCode( int aNetCode, bool aNoAssert )
     else
         m_netinfo = NETINFO_LIST::OrphanedItem();
 
+    if( board )
+        board->InvalidateNetItems();
+
     if( !aNoAssert )
         wxASSERT( m_netinfo );
 
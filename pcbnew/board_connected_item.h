@@ -82,10 +82,7 @@ public:
     /**
      * Set a NET_INFO object for the item.
      */
-    void SetNet( NETINFO_ITEM* aNetInfo )
-    {
-        m_netinfo = aNetInfo;
-    }
+    void SetNet( NETINFO_ITEM* aNetInfo );
 
     /**
      * @return the net code.
@@ -187,6 +187,13 @@ void BOARD_ITEM::SwapItemData( BOARD_ITEM* aImage )
     // Restore pointers to be sure they are not broken
     SetParent( parent );
     SetParentGroup( group );
+
+    // The children of a footprint are swapped with the footprint data
+    if( parent && parent->Type() == PCB_T && Type() == PCB_FOOTPRINT_T )
+        static_cast<BOARD*>( parent )->CacheItemById( this );
+
+    if( BOARD* board = GetBoard() )
+        board->InvalidateNetItems();
 }
 
 
@@ -496,6 +496,30 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const std::vector<KICAD_T>&
 }
 
 
+void GENERAL_COLLECTOR::Collect( const std::vector<BOARD_ITEM*>& aItems,
+                                 const std::vector<KICAD_T>& aScanTypes,
+                                 const VECTOR2I& aRefPos, const COLLECTORS_GUIDE& aGuide )
+{
+    Empty();
+    Empty2nd();
+
+    SetGuide( &aGuide );
+    SetScanTypes( aScanTypes );
+    SetRefPos( aRefPos );
+
+    for( BOARD_ITEM* item : aItems )
+    {
+        if( item->Visit( m_inspector, nullptr, m_scanTypes ) == INSPECT_RESULT::QUIT )
+            break;
+    }
+
+    for( unsigned i = 0;  i<m_List2nd.size();  ++i )
+        Append( m_List2nd[i] );
+
+    Empty2nd();
+}
+
+
 INSPECT_RESULT PCB_TYPE_COLLECTOR::Inspect( EDA_ITEM* testItem, void* testData )
 {
     // The Visit() function only visits the testItem if its type was in the the scanList,
@@ -312,6 +312,16 @@ public:
      */
     void Collect( BOARD_ITEM* aItem, const std::vector<KICAD_T>& aScanList,
                   const VECTOR2I& aRefPos, const COLLECTORS_GUIDE& aGuide );
+
+    /**
+     * Scan only \a aItems (and their children), typically the top level items found near
+     * \a aRefPos in a spatial index, rather than a whole BOARD.
+     *
+     * @param aItems The BOARD_ITEMs to scan.  Each one must appear once, and none may be the
+     *               child of another.
+     */
+    void Collect( const std::vector<BOARD_ITEM*>& aItems, const std::vector<KICAD_T>& aScanList,
+                  const VECTOR2I& aRefPos, const COLLECTORS_GUIDE& aGuide );
 };
 
 
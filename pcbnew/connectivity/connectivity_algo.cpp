@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <future>
+#include <map>
 #include <mutex>
 
 #include <connectivity/connectivity_algo.h>
@@ -34,6 +35,9 @@
 #include <geometry/geometry_utils.h>
 #include <board_commit.h>
 #include <core/thread_pool.h>
+#include <perf_trace.h>
+#include <hash.h>
+#include <hash_eda.h>
 #include <pcb_shape.h>
 
 #include <wx/log.h>
@@ -213,6 +217,107 @@ bool CN_CONNECTIVITY_ALGO::Add( BOARD_ITEM* aItem )
 }
 
 
+size_t CN_CONNECTIVITY_ALGO::connectionHash( const BOARD_CONNECTED_ITEM* aItem )
+{
+    size_t hash;
+
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+        hash = hash_fp_item( aItem, HASH_POS | HASH_ROT | HASH_LAYER | HASH_NET );
+        break;
+
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+        hash = hash_fp_item( aItem, HASH_POS | HASH_LAYER | HASH_NET );
+        break;
+
+    case PCB_VIA_T:
+        // Free vias don't take part in net propagation
+        hash = hash_fp_item( aItem, HASH_POS | HASH_LAYER | HASH_NET );
+        hash_combine( hash, static_cast<const PCB_VIA*>( aItem )->GetIsFree() );
+        break;
+
+    default:
+        return 0;
+    }
+
+    // Zero is reserved for "always rebuild"
+    return hash ? hash : 1;
+}
+
+
+bool CN_CONNECTIVITY_ALGO::isUnchanged( const BOARD_CONNECTED_ITEM* aItem ) const
+{
+    auto it = m_itemMap.find( aItem );
+
+    if( it == m_itemMap.end() || it->second.GetItems().size() != 1 )
+        return false;
+
+    const CN_ITEM* item = it->second.GetItems().front();
+
+    return item->Valid() && item->ConnectionHash() != 0
+            && item->ConnectionHash() == connectionHash( aItem );
+}
+
+
+bool CN_CONNECTIVITY_ALGO::Update( BOARD_ITEM* aItem )
+{
+    auto update =
+            [this]( BOARD_CONNECTED_ITEM* aConnItem )
+            {
+                if( isUnchanged( aConnItem ) )
+                {
+                    // The connections are still good, but the ratsnest may depend on whatever
+                    // else changed in the item.
+                    markItemNetAsDirty( aConnItem );
+                    return;
+                }
+
+                Remove( aConnItem );
+                Add( aConnItem );
+            };
+
+    switch( aItem->Type() )
+    {
+    case PCB_FOOTPRINT_T:
+    {
+        FOOTPRINT* footprint = static_cast<FOOTPRINT*>( aItem );
+
+        if( footprint->GetAttributes() & FP_JUST_ADDED )
+            break;
+
+        for( PAD* pad : footprint->Pads() )
+            update( pad );
+
+        return true;
+    }
+
+    case PCB_PAD_T:
+        if( FOOTPRINT* footprint = aItem->GetParentFootprint() )
+        {
+            if( footprint->GetAttributes() & FP_JUST_ADDED )
+                break;
+        }
+
+        update( static_cast<PAD*>( aItem ) );
+        return true;
+
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+        update( static_cast<PCB_TRACK*>( aItem ) );
+        return true;
+
+    default:
+        break;
+    }
+
+    Remove( aItem );
+    return Add( aItem );
+}
+
+
 void CN_CONNECTIVITY_ALGO::RemoveInvalidRefs()
 {
     for( CN_ITEM* item : m_itemList )
@@ -235,6 +340,12 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 
     m_itemList.RemoveInvalidItems( garbage );
 
+    if( !garbage.empty() )
+    {
+        std::lock_guard<std::mutex> lock( m_netItemsLock );
+        m_netItemsValid = false;
+    }
+
     for( CN_ITEM* item : garbage )
         delete item;
 
@@ -243,13 +354,7 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     PROF_TIMER search_basic( "search-basic" );
 #endif
 
-    thread_pool& tp = GetKiCadThreadPool();
-    std::vector<CN_ITEM*> dirtyItems;
-    std::copy_if( m_itemList.begin(), m_itemList.end(), std::back_inserter( dirtyItems ),
-                  [] ( CN_ITEM* aItem )
-                  {
-                      return aItem->Dirty();
-                  } );
+    const std::vector<CN_ITEM*>& dirtyItems = m_itemList.DirtyItems();
 
     if( m_progressReporter )
     {
@@ -261,18 +366,27 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 
     if( m_itemList.IsDirty() )
     {
+        CN_STATS&       stats = m_parentConnectivityData->Stats();
+        CN_STATS::TIMER searchTimer( stats.m_searchTime );
+
+        stats.m_itemsSearched += dirtyItems.size();
+
+        SCOPED_TRACE_ZONE traceZone( "Connectivity search" );
+        PERF_TRACE::Counter( "Connectivity dirty items",
+                             static_cast<int64_t>( dirtyItems.size() ) );
 
         std::vector<std::future<size_t>> returns( dirtyItems.size() );
 
         auto conn_lambda =
-                [&dirtyItems]( size_t aItem, CN_LIST* aItemList,
-                               PROGRESS_REPORTER* aReporter) -> size_t
+                [&dirtyItems, &stats]( size_t aItem, CN_LIST* aItemList,
+                                       PROGRESS_REPORTER* aReporter) -> size_t
                 {
                     if( aReporter && aReporter->IsCancelled() )
                         return 0;
 
                     CN_VISITOR visitor( dirtyItems[aItem] );
                     aItemList->FindNearby( dirtyItems[aItem], visitor );
+                    stats.m_candidatesTested += visitor.CandidateCount();
 
                     if( aReporter )
                         aReporter->AdvanceProgress();
@@ -281,7 +395,13 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
                 };
 
         for( size_t ii = 0; ii < dirtyItems.size(); ++ii )
-            returns[ii] = tp.submit( conn_lambda, ii, &m_itemList, m_progressReporter );
+        {
+            returns[ii] = SubmitTask( TASK_PRIORITY::INTERACTIVE,
+                                      [&, ii]()
+                                      {
+                                          return conn_lambda( ii, &m_itemList, m_progressReporter );
+                                      } );
+        }
 
         for( const std::future<size_t>& ret : returns )
         {
@@ -332,19 +452,52 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS
 CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
                                       const std::initializer_list<KICAD_T>& aTypes,
                                       int aSingleNet, CN_ITEM* rootItem )
+{
+    return searchClusters( aMode, aTypes,
+                           [aSingleNet]( int aNet )
+                           {
+                               return aSingleNet < 0 || aNet == aSingleNet;
+                           },
+                           rootItem );
+}
+
+
+const CN_CONNECTIVITY_ALGO::CLUSTERS
+CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
+                                      const std::initializer_list<KICAD_T>& aTypes,
+                                      const std::set<int>& aNets )
+{
+    return searchClusters( aMode, aTypes,
+                           [&aNets]( int aNet )
+                           {
+                               return aNets.count( aNet ) > 0;
+                           },
+                           nullptr );
+}
+
+
+const CN_CONNECTIVITY_ALGO::CLUSTERS
+CN_CONNECTIVITY_ALGO::searchClusters( CLUSTER_SEARCH_MODE aMode,
+                                      const std::initializer_list<KICAD_T>& aTypes,
+                                      const std::function<bool( int aNet )>& aNetFilter,
+                                      CN_ITEM* rootItem )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
-    std::deque<CN_ITEM*> Q;
-    std::set<CN_ITEM*> item_set;
+    std::vector<CN_ITEM*> items;
 
     CLUSTERS clusters;
 
     if( m_itemList.IsDirty() )
         searchConnections();
 
+    CN_STATS&       stats = m_parentConnectivityData->Stats();
+    CN_STATS::TIMER clusterTimer( stats.m_clusterTime );
+
+    stats.m_clusterSearches++;
+
     auto addToSearchList =
-            [&item_set, withinAnyNet, aSingleNet, &aTypes, rootItem ]( CN_ITEM *aItem )
+            [&items, withinAnyNet, &aNetFilter, &aTypes, rootItem ]( CN_ITEM *aItem )
             {
                 if( withinAnyNet && aItem->Net() <= 0 )
                     return;
@@ -352,7 +505,7 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
                 if( !aItem->Valid() )
                     return;
 
-                if( aSingleNet >=0 && aItem->Net() != aSingleNet )
+                if( !aNetFilter( aItem->Net() ) )
                     return;
 
                 bool found = false;
@@ -371,63 +524,113 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
 
                 aItem->SetVisited( false );
 
-                item_set.insert( aItem );
+                items.push_back( aItem );
             };
 
     std::for_each( m_itemList.begin(), m_itemList.end(), addToSearchList );
 
+    stats.m_clusterItems += items.size();
+
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return CLUSTERS();
 
-    while( !item_set.empty() )
-    {
-        std::shared_ptr<CN_CLUSTER> cluster = std::make_shared<CN_CLUSTER>();
-        CN_ITEM*                    root;
-        auto                        it = item_set.begin();
+    // Breadth-first search from each unvisited item in turn.  Unless we're propagating nets,
+    // the search never leaves the root's net, so only items of the same net are ever touched.
+    auto search =
+            [withinAnyNet]( const std::vector<CN_ITEM*>& aItems, CLUSTERS& aClusters )
+            {
+                std::deque<CN_ITEM*> Q;
 
-        while( it != item_set.end() && (*it)->Visited() )
-            it = item_set.erase( item_set.begin() );
+                for( CN_ITEM* root : aItems )
+                {
+                    if( root->Visited() )
+                        continue;
 
-        if( it == item_set.end() )
-            break;
+                    std::shared_ptr<CN_CLUSTER> cluster = std::make_shared<CN_CLUSTER>();
 
-        root = *it;
-        root->SetVisited( true );
+                    root->SetVisited( true );
+                    Q.push_back( root );
 
-        Q.clear();
-        Q.push_back( root );
+                    while( Q.size() )
+                    {
+                        CN_ITEM* current = Q.front();
+
+                        Q.pop_front();
+                        cluster->Add( current );
+
+                        for( CN_ITEM* n : current->ConnectedItems() )
+                        {
+                            if( withinAnyNet && n->Net() != root->Net() )
+                                continue;
+
+                            if( !n->Visited() && n->Valid() )
+                            {
+                                n->SetVisited( true );
+                                Q.push_back( n );
+                            }
+                        }
+                    }
 
-        while( Q.size() )
-        {
-            CN_ITEM* current = Q.front();
+                    aClusters.push_back( cluster );
+                }
+            };
 
-            Q.pop_front();
-            cluster->Add( current );
+    if( !withinAnyNet )
+    {
+        search( items, clusters );
+    }
+    else
+    {
+        // Clusters can't span nets, so search each net on its own thread.  Nets are merged back
+        // in ascending order so that the result doesn't depend on thread scheduling.
+        std::map<int, std::vector<CN_ITEM*>> netItems;
 
-            for( CN_ITEM* n : current->ConnectedItems() )
-            {
-                if( withinAnyNet && n->Net() != root->Net() )
-                    continue;
+        for( CN_ITEM* item : items )
+            netItems[ item->Net() ].push_back( item );
 
-                if( !n->Visited() && n->Valid() )
+        std::vector<std::vector<CN_ITEM*>*> nets;
+
+        for( auto& [ net, netItemList ] : netItems )
+            nets.push_back( &netItemList );
+
+        std::vector<CLUSTERS> netClusters( nets.size() );
+
+        auto search_lambda =
+                [&]( size_t aFirst, size_t aLast )
                 {
-                    n->SetVisited( true );
-                    Q.push_back( n );
-                }
-            }
+                    for( size_t ii = aFirst; ii < aLast; ++ii )
+                        search( *nets[ii], netClusters[ii] );
+                };
+
+        // Single-net searches (such as GetConnectedItems()) stay on the calling thread, which
+        // may itself be one of the pool's workers.
+        if( nets.size() == 1 )
+        {
+            search_lambda( 0, 1 );
+        }
+        else
+        {
+            ParallelForEachIndex( nets.size(),
+                    [&]( size_t ii )
+                    {
+                        search_lambda( ii, ii + 1 );
+                    },
+                    TASK_PRIORITY::INTERACTIVE );
         }
 
-        clusters.push_back( cluster );
+        for( CLUSTERS& netClusterList : netClusters )
+            clusters.insert( clusters.end(), netClusterList.begin(), netClusterList.end() );
     }
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return CLUSTERS();
 
-    std::sort( clusters.begin(), clusters.end(),
-               []( const std::shared_ptr<CN_CLUSTER>& a, const std::shared_ptr<CN_CLUSTER>& b )
-               {
-                   return a->OriginNet() < b->OriginNet();
-               } );
+    std::stable_sort( clusters.begin(), clusters.end(),
+                      []( const std::shared_ptr<CN_CLUSTER>& a,
+                          const std::shared_ptr<CN_CLUSTER>& b )
+                      {
+                          return a->OriginNet() < b->OriginNet();
+                      } );
 
     return clusters;
 }
@@ -435,6 +638,8 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
 
 void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
+    CN_STATS::TIMER buildTimer( m_parentConnectivityData->Stats().m_buildTime );
+
     // Generate CN_ZONE_LAYERs for each island on each layer of each zone
     //
     std::vector<CN_ZONE_LAYER*> zitems;
@@ -486,7 +691,6 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
     // Generate RTrees for CN_ZONE_LAYER items (in parallel)
     //
-    thread_pool& tp = GetKiCadThreadPool();
     std::vector<std::future<size_t>> returns( zitems.size() );
 
     auto cache_zones =
@@ -504,7 +708,13 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
             };
 
     for( size_t ii = 0; ii < zitems.size(); ++ii )
-        returns[ii] = tp.submit( cache_zones, zitems[ii] );
+    {
+        returns[ii] = SubmitTask( TASK_PRIORITY::INTERACTIVE,
+                                  [&, ii]()
+                                  {
+                                      return cache_zones( zitems[ii] );
+                                  } );
+    }
 
     for( const std::future<size_t>& ret : returns )
     {
@@ -562,6 +772,8 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
         aReporter->SetCurrentProgress( (double) ii / (double) size );
         aReporter->KeepRefreshing( false );
     }
+
+    m_parentConnectivityData->Stats().m_itemsBuilt += m_itemList.Size();
 }
 
 
@@ -681,30 +893,45 @@ void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap(
         }
     }
 
-    m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
+    // Islands are classified net by net, so only the nets of the zones being checked need to
+    // be searched.  The other nets' clusters can't have changed.
+    std::set<int>                                                  nets;
+    std::map<std::pair<const BOARD_ITEM*, int>, ISOLATED_ISLANDS*> islandsByZoneLayer;
 
     for( auto& [ zone, zoneIslands ] : aMap )
     {
+        nets.insert( zone->GetNetCode() );
+
         for( auto& [ layer, layerIslands ] : zoneIslands )
         {
-            if( zone->GetFilledPolysList( layer )->IsEmpty() )
+            if( !zone->GetFilledPolysList( layer )->IsEmpty() )
+                islandsByZoneLayer[ { zone, layer } ] = &layerIslands;
+        }
+    }
+
+    m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK,
+                                     { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T, PCB_VIA_T, PCB_ZONE_T,
+                                       PCB_FOOTPRINT_T, PCB_SHAPE_T },
+                                     nets );
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : m_connClusters )
+    {
+        for( CN_ITEM* item : *cluster )
+        {
+            if( item->Parent()->Type() != PCB_ZONE_T )
                 continue;
 
-            for( const std::shared_ptr<CN_CLUSTER>& cluster : m_connClusters )
-            {
-                for( CN_ITEM* item : *cluster )
-                {
-                    if( item->Parent() == zone && item->Layer() == layer )
-                    {
-                        CN_ZONE_LAYER* z = static_cast<CN_ZONE_LAYER*>( item );
+            auto it = islandsByZoneLayer.find( { item->Parent(), item->Layer() } );
 
-                        if( cluster->IsOrphaned() )
-                            layerIslands.m_IsolatedOutlines.push_back( z->SubpolyIndex() );
-                        else if( z->HasSingleConnection() )
-                            layerIslands.m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
-                    }
-                }
-            }
+            if( it == islandsByZoneLayer.end() )
+                continue;
+
+            CN_ZONE_LAYER* z = static_cast<CN_ZONE_LAYER*>( item );
+
+            if( cluster->IsOrphaned() )
+                it->second->m_IsolatedOutlines.push_back( z->SubpolyIndex() );
+            else if( z->HasSingleConnection() )
+                it->second->m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
         }
     }
 }
@@ -736,6 +963,42 @@ void CN_CONNECTIVITY_ALGO::MarkNetAsDirty( int aNet )
     }
 
     m_dirtyNets[aNet] = true;
+
+    std::lock_guard<std::mutex> lock( m_netItemsLock );
+
+    if( m_netItemsValid )
+        m_staleNetItems.insert( aNet );
+}
+
+
+void CN_CONNECTIVITY_ALGO::updateNetItems()
+{
+    if( !m_netItemsValid )
+    {
+        m_netItems.clear();
+
+        for( CN_ITEM* item : m_itemList )
+        {
+            if( item->Valid() )
+                m_netItems[ item->Net() ].push_back( item );
+        }
+
+        m_netItemsValid = true;
+    }
+    else if( !m_staleNetItems.empty() )
+    {
+        // Re-index all the stale nets in a single pass over the items
+        for( int net : m_staleNetItems )
+            m_netItems.erase( net );
+
+        for( CN_ITEM* item : m_itemList )
+        {
+            if( item->Valid() && m_staleNetItems.count( item->Net() ) )
+                m_netItems[ item->Net() ].push_back( item );
+        }
+    }
+
+    m_staleNetItems.clear();
 }
 
 
@@ -851,6 +1114,8 @@ void CN_VISITOR::checkZoneZoneConnection( CN_ZONE_LAYER* aZoneLayerA, CN_ZONE_LA
 
 bool CN_VISITOR::operator()( CN_ITEM* aCandidate )
 {
+    m_candidateCount++;
+
     const BOARD_CONNECTED_ITEM* parentA = aCandidate->Parent();
     const BOARD_CONNECTED_ITEM* parentB = m_item->Parent();
 
@@ -939,6 +1204,10 @@ void CN_CONNECTIVITY_ALGO::Clear()
     m_itemMap.clear();
     m_itemList.Clear();
 
+    std::lock_guard<std::mutex> lock( m_netItemsLock );
+    m_netItems.clear();
+    m_staleNetItems.clear();
+    m_netItemsValid = false;
 }
 
 void CN_CONNECTIVITY_ALGO::SetProgressReporter( PROGRESS_REPORTER* aReporter )
@@ -40,8 +40,11 @@
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <mutex>
 #include <vector>
 #include <deque>
+#include <set>
+#include <unordered_map>
 
 #include <connectivity/connectivity_rtree.h>
 #include <connectivity/connectivity_data.h>
@@ -226,11 +229,28 @@ public:
     bool Remove( BOARD_ITEM* aItem );
     bool Add( BOARD_ITEM* aItem );
 
+    /**
+     * Update the connectivity items of a modified board item.
+     *
+     * Pads, tracks and vias whose position, shape, layers and net are unchanged keep their
+     * existing items and connections, so only the items which actually moved are searched
+     * again by the next searchConnections().
+     */
+    bool Update( BOARD_ITEM* aItem );
+
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode,
                                    const std::initializer_list<KICAD_T>& aTypes,
                                    int aSingleNet, CN_ITEM* rootItem = nullptr );
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode );
 
+    /**
+     * Search for the clusters of the given nets only (clusters never span nets outside of
+     * CSM_PROPAGATE mode, so this is much cheaper than searching the whole board).
+     */
+    const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode,
+                                   const std::initializer_list<KICAD_T>& aTypes,
+                                   const std::set<int>& aNets );
+
     /**
      * Propagate nets from pads to other items in clusters.
      * @param aCommit is used to store undo information for items modified by the call.
@@ -267,6 +287,32 @@ public:
             aFunc( *item );
     }
 
+    /**
+     * Call \a aFunc for each valid item on \a aNet.
+     *
+     * The items are indexed by net on first use, and only the nets which have been marked
+     * dirty since are re-indexed, so repeated lookups don't have to scan the whole board.
+     */
+    template <typename Func>
+    void ForEachNetItem( int aNet, Func&& aFunc )
+    {
+        std::lock_guard<std::mutex> lock( m_netItemsLock );
+
+        updateNetItems();
+
+        auto it = m_netItems.find( aNet );
+
+        if( it == m_netItems.end() )
+            return;
+
+        for( CN_ITEM* item : it->second )
+        {
+            // Nets can be changed without the connectivity being told
+            if( item->Valid() && item->Net() == aNet )
+                aFunc( *item );
+        }
+    }
+
     void MarkNetAsDirty( int aNet );
     void RemoveInvalidRefs();
 
@@ -275,6 +321,11 @@ public:
 private:
     void searchConnections();
 
+    const CLUSTERS searchClusters( CLUSTER_SEARCH_MODE aMode,
+                                   const std::initializer_list<KICAD_T>& aTypes,
+                                   const std::function<bool( int aNet )>& aNetFilter,
+                                   CN_ITEM* rootItem );
+
     void propagateConnections( BOARD_COMMIT* aCommit = nullptr );
 
     template <class Container, class BItem>
@@ -282,11 +333,31 @@ private:
     {
         CN_ITEM* item = c.Add( brditem );
 
+        if( item )
+            item->SetConnectionHash( connectionHash( brditem ) );
+
         m_itemMap[ brditem ] = ITEM_MAP_ENTRY( item );
     }
 
+    /**
+     * @return a hash of everything about \a aItem that its connections depend on, or 0 for
+     *         items which are always rebuilt by Update().
+     */
+    static size_t connectionHash( const BOARD_CONNECTED_ITEM* aItem );
+
+    /**
+     * @return true if \a aItem already has a single valid connectivity item which was built for
+     *         its current geometry.
+     */
+    bool isUnchanged( const BOARD_CONNECTED_ITEM* aItem ) const;
+
     void markItemNetAsDirty( const BOARD_ITEM* aItem );
 
+    /**
+     * Bring the items-by-net index up to date.  Must be called with m_netItemsLock held.
+     */
+    void updateNetItems();
+
 private:
     CONNECTIVITY_DATA*                                    m_parentConnectivityData;
     CN_LIST                                               m_itemList;
@@ -296,6 +367,11 @@ private:
     std::vector<std::shared_ptr<CN_CLUSTER>>              m_ratsnestClusters;
     std::vector<bool>                                     m_dirtyNets;
 
+    std::mutex                                            m_netItemsLock;
+    std::unordered_map<int, std::vector<CN_ITEM*>>        m_netItems;
+    std::set<int>                                         m_staleNetItems;
+    bool                                                  m_netItemsValid = false;
+
     bool                                                  m_isLocal;
     std::shared_ptr<CONNECTIVITY_DATA>                    m_globalConnectivityData;
 
@@ -312,6 +388,11 @@ public:
 
     bool operator()( CN_ITEM* aCandidate );
 
+    /**
+     * @return the number of candidates which have been tested for a connection.
+     */
+    int64_t CandidateCount() const { return m_candidateCount; }
+
 protected:
     void checkZoneItemConnection( CN_ZONE_LAYER* aZoneLayer, CN_ITEM* aItem );
 
@@ -319,6 +400,7 @@ protected:
 
 protected:
     CN_ITEM* m_item;        ///< The item we are looking for connections to.
+    int64_t  m_candidateCount = 0;
 };
 
 #endif
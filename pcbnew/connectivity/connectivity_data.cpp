@@ -28,12 +28,16 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <initializer_list>
 
+#include <advanced_config.h>
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
 #include <connectivity/from_to_cache.h>
+#include <connectivity/net_length_cache.h>
 #include <project/net_settings.h>
 #include <board_design_settings.h>
 #include <geometry/shape_segment.h>
@@ -41,7 +45,9 @@
 #include <ratsnest/ratsnest_data.h>
 #include <progress_reporter.h>
 #include <core/thread_pool.h>
+#include <perf_trace.h>
 #include <trigo.h>
+#include <trace_helpers.h>
 #include <drc/drc_rtree.h>
 
 CONNECTIVITY_DATA::CONNECTIVITY_DATA() :
@@ -50,6 +56,7 @@ CONNECTIVITY_DATA::CONNECTIVITY_DATA() :
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO( this ) );
     m_progressReporter = nullptr;
     m_fromToCache.reset( new FROM_TO_CACHE );
+    m_netLengthCache.reset( new NET_LENGTH_CACHE );
 }
 
 
@@ -61,11 +68,14 @@ CONNECTIVITY_DATA::CONNECTIVITY_DATA( std::shared_ptr<CONNECTIVITY_DATA> aGlobal
     Build( aGlobalConnectivity, aLocalItems );
     m_progressReporter = nullptr;
     m_fromToCache.reset( new FROM_TO_CACHE );
+    m_netLengthCache.reset( new NET_LENGTH_CACHE );
 }
 
 
 CONNECTIVITY_DATA::~CONNECTIVITY_DATA()
 {
+    WaitForRatsnest();
+
     for( RN_NET* net : m_nets )
         delete net;
 
@@ -75,6 +85,8 @@ CONNECTIVITY_DATA::~CONNECTIVITY_DATA()
 
 bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 {
+    WaitForRatsnest();
+
     m_connAlgo->Add( aItem );
     return true;
 }
@@ -82,6 +94,8 @@ bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 
 bool CONNECTIVITY_DATA::Remove( BOARD_ITEM* aItem )
 {
+    WaitForRatsnest();
+
     m_connAlgo->Remove( aItem );
     return true;
 }
@@ -89,21 +103,27 @@ bool CONNECTIVITY_DATA::Remove( BOARD_ITEM* aItem )
 
 bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 {
-    m_connAlgo->Remove( aItem );
-    m_connAlgo->Add( aItem );
+    WaitForRatsnest();
+
+    m_connAlgo->Update( aItem );
     return true;
 }
 
 
 bool CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
+    SCOPED_TRACE_ZONE traceZone( "Connectivity build" );
+
     aBoard->CacheTriangulation( aReporter );
+    aBoard->PrebuildPadShapes();
 
     std::unique_lock<KISPINLOCK> lock( m_lock, std::try_to_lock );
 
     if( !lock )
         return false;
 
+    WaitForRatsnest();
+
     if( aReporter )
     {
         aReporter->Report( _( "Updating nets..." ) );
@@ -151,6 +171,8 @@ void CONNECTIVITY_DATA::Build( std::shared_ptr<CONNECTIVITY_DATA>& aGlobalConnec
     if( !lock )
         return;
 
+    WaitForRatsnest();
+
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO( this ) );
     m_connAlgo->LocalBuild( aGlobalConnectivity, aLocalItems );
 
@@ -160,6 +182,8 @@ void CONNECTIVITY_DATA::Build( std::shared_ptr<CONNECTIVITY_DATA>& aGlobalConnec
 
 void CONNECTIVITY_DATA::Move( const VECTOR2I& aDelta )
 {
+    WaitForRatsnest();
+
     m_connAlgo->ForEachAnchor( [&aDelta]( CN_ANCHOR& anchor )
                                {
                                    anchor.Move( aDelta );
@@ -183,27 +207,63 @@ void CONNECTIVITY_DATA::updateRatsnest()
                 return aNet->IsDirty() && aNet->GetNodeCount() > 0;
             } );
 
-    thread_pool& tp = GetKiCadThreadPool();
+    m_stats.m_ratsnestNets += dirty_nets.size();
 
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
-            {
-                for( int ii = a; ii < b; ++ii )
+    // Only wait for our own tasks: this may run on a worker thread (see
+    // RecalculateRatsnestAsync()) while the pool is busy with unrelated work.
+    {
+        CN_STATS::TIMER timer( m_stats.m_ratsnestTime );
+
+        ParallelForEachIndex( dirty_nets.size(),
+                [&]( size_t ii )
+                {
                     dirty_nets[ii]->UpdateNet();
-            } );
-    tp.wait_for_tasks();
+                },
+                TASK_PRIORITY::INTERACTIVE );
+    }
 
-    tp.push_loop( dirty_nets.size(),
-            [&]( const int a, const int b )
-            {
-                for( int ii = a; ii < b; ++ii )
+    {
+        CN_STATS::TIMER timer( m_stats.m_optimizeTime );
+
+        ParallelForEachIndex( dirty_nets.size(),
+                [&]( size_t ii )
+                {
                     dirty_nets[ii]->OptimizeRNEdges();
-            } );
-    tp.wait_for_tasks();
+                },
+                TASK_PRIORITY::INTERACTIVE );
+    }
 
 #ifdef PROFILE
     rnUpdate.Show();
 #endif
+
+    wxLogTrace( traceConnectivity, wxT( "%s" ), m_stats.Format() );
+}
+
+
+void CN_STATS::Reset()
+{
+    for( std::atomic<int64_t>* counter : { &m_itemsBuilt, &m_itemsSearched, &m_candidatesTested,
+                                           &m_clusterSearches, &m_clusterItems, &m_ratsnestNets,
+                                           &m_buildTime, &m_searchTime, &m_clusterTime,
+                                           &m_ratsnestTime, &m_optimizeTime } )
+    {
+        *counter = 0;
+    }
+}
+
+
+wxString CN_STATS::Format() const
+{
+    return wxString::Format( wxT( "Connectivity: %lld items built, %lld searched, %lld candidates "
+                                  "tested, %lld cluster searches (%lld items), %lld ratsnest nets; "
+                                  "build %.1f ms, search %.1f ms, clusters %.1f ms, "
+                                  "ratsnest %.1f ms, optimize %.1f ms" ),
+                             (long long) m_itemsBuilt, (long long) m_itemsSearched,
+                             (long long) m_candidatesTested, (long long) m_clusterSearches,
+                             (long long) m_clusterItems, (long long) m_ratsnestNets,
+                             m_buildTime / 1000.0, m_searchTime / 1000.0, m_clusterTime / 1000.0,
+                             m_ratsnestTime / 1000.0, m_optimizeTime / 1000.0 );
 }
 
 
@@ -222,12 +282,49 @@ void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
     // This is to prevent redraw during a RecalculateRatsnets process
     std::unique_lock<KISPINLOCK> lock( m_lock );
 
+    WaitForRatsnest();
     internalRecalculateRatsnest( aCommit );
 
 }
 
-void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
+void CONNECTIVITY_DATA::RecalculateRatsnestAsync( BOARD_COMMIT* aCommit,
+                                                  std::function<void()> aOnComplete )
 {
+    std::unique_lock<KISPINLOCK> lock( m_lock );
+
+    WaitForRatsnest();
+    internalRecalculateRatsnest( aCommit, std::move( aOnComplete ) );
+}
+
+
+void CONNECTIVITY_DATA::WaitForRatsnest() const
+{
+    if( m_ratsnestJob.valid() )
+        m_ratsnestJob.get();
+
+    m_displayedRatsnest.clear();
+}
+
+
+const std::vector<CN_EDGE>* CONNECTIVITY_DATA::GetDisplayedRatsnest( int aNet ) const
+{
+    auto it = m_displayedRatsnest.find( aNet );
+
+    if( it != m_displayedRatsnest.end() )
+        return &it->second;
+
+    if( aNet < 0 || aNet >= (int) m_nets.size() )
+        return nullptr;
+
+    return &m_nets[aNet]->GetEdges();
+}
+
+
+void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit,
+                                                     std::function<void()> aOnComplete )
+{
+    SCOPED_TRACE_ZONE traceZone( "Ratsnest" );
+
     m_connAlgo->PropagateNets( aCommit );
 
     int lastNet = m_connAlgo->NetCount();
@@ -254,6 +351,10 @@ void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
     {
         if( m_connAlgo->IsNetDirty( net ) )
         {
+            // Keep displaying the old ratsnest until the new one is ready
+            if( aOnComplete )
+                m_displayedRatsnest[net] = m_nets[net]->GetEdges();
+
             m_nets[net]->Clear();
             dirtyNets++;
         }
@@ -276,13 +377,33 @@ void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
 
     m_connAlgo->ClearDirtyFlags();
 
-    if( !m_skipRatsnestUpdate )
+    if( m_skipRatsnestUpdate )
+    {
+        if( aOnComplete )
+            aOnComplete();
+    }
+    else if( aOnComplete )
+    {
+        // Everything the update reads is left alone until it has finished: the connectivity
+        // can't change without waiting for it first.
+        m_ratsnestJob = std::async( std::launch::async,
+                                    [this, aOnComplete]()
+                                    {
+                                        updateRatsnest();
+                                        aOnComplete();
+                                    } );
+    }
+    else
+    {
         updateRatsnest();
+    }
 }
 
 
 void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aItems )
 {
+    WaitForRatsnest();
+
     std::vector<BOARD_CONNECTED_ITEM*> citems;
 
     for( BOARD_ITEM* item : aItems )
@@ -312,6 +433,11 @@ void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aIte
             }
         }
     }
+
+    // A new set of items is being moved
+    clearLineNodes();
+    m_localRatsnestLines.clear();
+    m_staleLocalNets.clear();
 }
 
 
@@ -335,48 +461,105 @@ void CONNECTIVITY_DATA::ComputeLocalRatsnest( const std::vector<BOARD_ITEM*>& aI
     if( !aDynamicData )
         return;
 
+    WaitForRatsnest();
+
     m_dynamicRatsnest.clear();
     std::mutex dynamic_ratsnest_mutex;
 
+    using CLOCK = std::chrono::steady_clock;
+
+    int               budget = ADVANCED_CFG::GetCfg().m_LocalRatsnestBudget;
+    CLOCK::time_point deadline = CLOCK::now() + std::chrono::milliseconds( budget );
+    size_t            num_nets = std::min( m_nets.size(), aDynamicData->m_nets.size() );
+    std::vector<int>  order;
+
+    /// We don't need to compute the dynamic ratsnest in two cases:
+    /// 1) We are not moving any net elements
+    /// 2) We are moving all net elements
+    auto needsLine =
+            [&]( int nc )
+            {
+                unsigned int dynamicCount = aDynamicData->m_nets[nc]->GetNodeCount();
+
+                return dynamicCount != 0 && dynamicCount != m_nets[nc]->GetNodeCount();
+            };
+
+    // Nets which didn't fit in the last frame's budget go first
+    for( int nc : m_staleLocalNets )
+    {
+        if( nc < (int) num_nets && needsLine( nc ) )
+            order.push_back( nc );
+    }
+
+    for( int nc = 1; nc < (int) num_nets; ++nc )
+    {
+        if( !m_staleLocalNets.count( nc ) && needsLine( nc ) )
+            order.push_back( nc );
+    }
+
+    std::map<int, LOCAL_RATSNEST_LINE> newLines;
+    std::set<int>                      newStaleNets;
+
+    auto addLine =
+            [&]( int nc, const VECTOR2I& aPos1, const VECTOR2I& aPos2 )
+            {
+                RN_DYNAMIC_LINE l;
+                l.a = aPos1;
+                l.b = aPos2;
+                l.netCode = nc;
+                m_dynamicRatsnest.push_back( l );
+            };
+
     // This gets connections between the stationary board and the
     // moving selection
 
     auto update_lambda = [&]( int nc )
     {
-        RN_NET* dynamicNet = aDynamicData->m_nets[nc];
-        RN_NET* staticNet  = m_nets[nc];
-
-        /// We don't need to compute the dynamic ratsnest in two cases:
-        /// 1) We are not moving any net elements
-        /// 2) We are moving all net elements
-        if( dynamicNet->GetNodeCount() != 0
-                && dynamicNet->GetNodeCount() != staticNet->GetNodeCount() )
+        auto previous = m_localRatsnestLines.find( nc );
+
+        // Out of time: redraw the previous line from wherever its moving end is now
+        if( budget > 0 && previous != m_localRatsnestLines.end() && CLOCK::now() > deadline )
         {
-            VECTOR2I pos1, pos2;
+            std::lock_guard<std::mutex> lock( dynamic_ratsnest_mutex );
 
-            if( staticNet->NearestBicoloredPair( dynamicNet, pos1, pos2 ) )
-            {
-                RN_DYNAMIC_LINE l;
-                l.a = pos1;
-                l.b = pos2;
-                l.netCode = nc;
+            if( previous->second.m_movingNode )
+                addLine( nc, previous->second.m_movingNode->Pos(), previous->second.m_staticPos );
 
-                std::lock_guard<std::mutex> lock( dynamic_ratsnest_mutex );
-                m_dynamicRatsnest.push_back( l );
-            }
+            newStaleNets.insert( nc );
+            return;
         }
-    };
 
-    thread_pool& tp = GetKiCadThreadPool();
-    size_t num_nets = std::min( m_nets.size(), aDynamicData->m_nets.size() );
+        LOCAL_RATSNEST_LINE line;
+        VECTOR2I            pos1, pos2;
+
+        if( !m_nets[nc]->NearestBicoloredPair( aDynamicData->m_nets[nc], pos1, pos2,
+                                               &line.m_movingNode ) )
+        {
+            line.m_movingNode = nullptr;
+        }
+
+        line.m_staticPos = pos2;
+
+        std::lock_guard<std::mutex> lock( dynamic_ratsnest_mutex );
+
+        if( line.m_movingNode )
+            addLine( nc, pos1, pos2 );
 
-    tp.push_loop( 1, num_nets,
-            [&]( const int a, const int b)
+        newLines[nc] = line;
+    };
+
+    // Each thread takes the next net in order, so the stale nets really are done first
+    ParallelForEachIndex( order.size(),
+            [&]( size_t ii )
             {
-                for( int ii = a; ii < b; ++ii )
-                    update_lambda( ii );
-            });
-    tp.wait_for_tasks();
+                update_lambda( order[ii] );
+            },
+            TASK_PRIORITY::INTERACTIVE );
+
+    for( auto& [ nc, line ] : newLines )
+        m_localRatsnestLines[nc] = std::move( line );
+
+    m_staleLocalNets = std::move( newStaleNets );
 
     // This gets the ratsnest for internal connections in the moving set
     const std::vector<CN_EDGE>& edges = GetRatsnestForItems( aItems );
@@ -406,6 +589,7 @@ void CONNECTIVITY_DATA::ClearLocalRatsnest()
                                {
                                    anchor.SetNoLine( false );
                                } );
+    clearLineNodes();
     HideLocalRatsnest();
 }
 
@@ -413,11 +597,25 @@ void CONNECTIVITY_DATA::ClearLocalRatsnest()
 void CONNECTIVITY_DATA::HideLocalRatsnest()
 {
     m_dynamicRatsnest.clear();
+    m_localRatsnestLines.clear();
+    m_staleLocalNets.clear();
+}
+
+
+void CONNECTIVITY_DATA::clearLineNodes()
+{
+    for( RN_NET* net : m_nets )
+    {
+        if( net )
+            net->ClearLineNodes();
+    }
 }
 
 
 void CONNECTIVITY_DATA::PropagateNets( BOARD_COMMIT* aCommit )
 {
+    WaitForRatsnest();
+
     m_connAlgo->PropagateNets( aCommit );
 }
 
@@ -436,67 +634,87 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
                 return alg::contains( aTypes, aItemType);
             };
 
+    bool                        isPadOrVia = aItem->Type() == PCB_PAD_T
+                                                     || aItem->Type() == PCB_VIA_T;
+    std::vector<CN_ZONE_LAYER*> zoneLayers;
+
     for( CN_ITEM* citem : entry.GetItems() )
     {
         for( CN_ITEM* connected : citem->ConnectedItems() )
         {
-            CN_ZONE_LAYER* zoneLayer = dynamic_cast<CN_ZONE_LAYER*>( connected );
-
             if( connected->Valid()
                     && connected->Layers().Overlaps( aLayer )
                     && matchType( connected->Parent()->Type() )
                     && connected->Net() == aItem->GetNetCode() )
             {
-                if( aItem->Type() == PCB_PAD_T && zoneLayer )
-                {
-                    const PAD*    pad = static_cast<const PAD*>( aItem );
-                    ZONE*         zone = static_cast<ZONE*>( zoneLayer->Parent() );
-                    int           islandIdx = zoneLayer->SubpolyIndex();
+                CN_ZONE_LAYER* zoneLayer = isPadOrVia ? dynamic_cast<CN_ZONE_LAYER*>( connected )
+                                                      : nullptr;
 
-                    if( zone->IsFilled() )
-                    {
-                        const SHAPE_POLY_SET*   zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
-                        const SHAPE_LINE_CHAIN& padHull = pad->GetEffectivePolygon( ERROR_INSIDE )->Outline( 0 );
+                // Zone connections of pads and vias need their islands checking, which is
+                // expensive, so only do it if there are no other connections.
+                if( !zoneLayer )
+                    return true;
 
-                        for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
-                        {
-                            // If the entire island is inside the pad's flashing then the pad
-                            // won't actually connect to anything else, so only return true if
-                            // part of the island is *outside* the pad's flashing.
+                zoneLayers.push_back( zoneLayer );
+            }
+        }
+    }
 
-                            if( !padHull.PointInside( pt ) )
-                                return true;
-                        }
-                    }
+    if( zoneLayers.empty() )
+        return false;
 
-                    continue;
-                }
-                else if( aItem->Type() == PCB_VIA_T && zoneLayer )
-                {
-                    const PCB_VIA* via = static_cast<const PCB_VIA*>( aItem );
-                    ZONE*          zone = static_cast<ZONE*>( zoneLayer->Parent() );
-                    int            islandIdx = zoneLayer->SubpolyIndex();
+    if( aItem->Type() == PCB_PAD_T )
+    {
+        const PAD*              pad = static_cast<const PAD*>( aItem );
+        const SHAPE_LINE_CHAIN* padHull = nullptr;
 
-                    if( zone->IsFilled() )
-                    {
-                        const SHAPE_POLY_SET* zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
-                        SHAPE_CIRCLE          viaHull( via->GetCenter(), via->GetWidth() / 2 );
+        for( CN_ZONE_LAYER* zoneLayer : zoneLayers )
+        {
+            ZONE* zone = static_cast<ZONE*>( zoneLayer->Parent() );
+            int   islandIdx = zoneLayer->SubpolyIndex();
 
-                        for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
-                        {
-                            // If the entire island is inside the via's flashing then the via
-                            // won't actually connect to anything else, so only return true if
-                            // part of the island is *outside* the via's flashing.
+            if( !zone->IsFilled() )
+                continue;
 
-                            if( !viaHull.SHAPE::Collide( pt ) )
-                                return true;
-                        }
-                    }
+            const SHAPE_POLY_SET* zoneFill = zone->GetFilledPolysList( ToLAYER_ID( aLayer ) ).get();
 
-                    continue;
-                }
+            if( !padHull )
+                padHull = &pad->GetEffectivePolygon( ERROR_INSIDE )->Outline( 0 );
+
+            for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
+            {
+                // If the entire island is inside the pad's flashing then the pad won't
+                // actually connect to anything else, so only return true if part of the
+                // island is *outside* the pad's flashing.
 
-                return true;
+                if( !padHull->PointInside( pt ) )
+                    return true;
+            }
+        }
+    }
+    else
+    {
+        const PCB_VIA* via = static_cast<const PCB_VIA*>( aItem );
+        SHAPE_CIRCLE   viaHull( via->GetCenter(), via->GetWidth() / 2 );
+
+        for( CN_ZONE_LAYER* zoneLayer : zoneLayers )
+        {
+            ZONE* zone = static_cast<ZONE*>( zoneLayer->Parent() );
+            int   islandIdx = zoneLayer->SubpolyIndex();
+
+            if( !zone->IsFilled() )
+                continue;
+
+            const SHAPE_POLY_SET* zoneFill = zone->GetFilledPolysList( ToLAYER_ID( aLayer ) ).get();
+
+            for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
+            {
+                // If the entire island is inside the via's flashing then the via won't
+                // actually connect to anything else, so only return true if part of the
+                // island is *outside* the via's flashing.
+
+                if( !viaHull.SHAPE::Collide( pt ) )
+                    return true;
             }
         }
     }
@@ -507,6 +725,8 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
 unsigned int CONNECTIVITY_DATA::GetUnconnectedCount( bool aVisibleOnly ) const
 {
+    WaitForRatsnest();
+
     unsigned int unconnected = 0;
 
     for( RN_NET* net : m_nets )
@@ -527,6 +747,8 @@ unsigned int CONNECTIVITY_DATA::GetUnconnectedCount( bool aVisibleOnly ) const
 
 void CONNECTIVITY_DATA::ClearRatsnest()
 {
+    WaitForRatsnest();
+
     for( RN_NET* net : m_nets )
         net->Clear();
 }
@@ -578,10 +800,10 @@ CONNECTIVITY_DATA::GetNetItems( int aNetCode, const std::initializer_list<KICAD_
         type_bits.set( scanType );
     }
 
-    m_connAlgo->ForEachItem(
+    m_connAlgo->ForEachNetItem( aNetCode,
             [&]( CN_ITEM& aItem )
             {
-                if( aItem.Valid() && ( aItem.Net() == aNetCode ) && type_bits[aItem.Parent()->Type()] )
+                if( type_bits[aItem.Parent()->Type()] )
                     items.push_back( aItem.Parent() );
             } );
 
@@ -635,12 +857,20 @@ void CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem,
 const std::vector<PAD*> CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem )
 const
 {
-    std::set<PAD*>    pads;
     std::vector<PAD*> rv;
 
-    GetConnectedPads( aItem, &pads );
+    for( CN_ITEM* citem : m_connAlgo->ItemEntry( aItem ).GetItems() )
+    {
+        for( CN_ITEM* connected : citem->ConnectedItems() )
+        {
+            if( connected->Valid() && connected->Parent()->Type() == PCB_PAD_T )
+                rv.push_back( static_cast<PAD*>( connected->Parent() ) );
+        }
+    }
 
-    std::copy( pads.begin(), pads.end(), std::back_inserter( rv ) );
+    // Same order as the std::set<> version, without its allocations
+    std::sort( rv.begin(), rv.end() );
+    rv.erase( std::unique( rv.begin(), rv.end() ), rv.end() );
     return rv;
 }
 
@@ -689,6 +919,18 @@ unsigned int CONNECTIVITY_DATA::GetPadCount( int aNet ) const
 {
     int n = 0;
 
+    if( aNet >= 0 )
+    {
+        m_connAlgo->ForEachNetItem( aNet,
+                [&]( CN_ITEM& aItem )
+                {
+                    if( aItem.Parent()->Type() == PCB_PAD_T )
+                        n++;
+                } );
+
+        return n;
+    }
+
     for( CN_ITEM* pad : m_connAlgo->ItemList() )
     {
         if( !pad->Valid() || pad->Parent()->Type() != PCB_PAD_T)
@@ -706,6 +948,8 @@ unsigned int CONNECTIVITY_DATA::GetPadCount( int aNet ) const
 
 void CONNECTIVITY_DATA::RunOnUnconnectedEdges( std::function<bool( CN_EDGE& )> aFunc )
 {
+    WaitForRatsnest();
+
     for( RN_NET* rnNet : m_nets )
     {
         if( rnNet )
@@ -792,10 +1036,21 @@ bool CONNECTIVITY_DATA::TestTrackEndpointDangling( PCB_TRACK* aTrack, bool aIgno
             }
             else
             {
-                std::shared_ptr<SHAPE> shape = item->GetEffectiveShape( layer );
+                // Most connected items are only near one end (or neither), so reject on the
+                // bounding box before building the effective shape
+                BOX2I bbox = item->GetBoundingBox();
+                bbox.Inflate( accuracy );
+
+                bool nearStart = bbox.Contains( aTrack->GetStart() );
+                bool nearEnd = bbox.Contains( aTrack->GetEnd() );
+
+                if( nearStart || nearEnd )
+                {
+                    std::shared_ptr<SHAPE> shape = item->GetEffectiveShape( layer );
 
-                hitStart = shape->Collide( aTrack->GetStart(), accuracy );
-                hitEnd = shape->Collide( aTrack->GetEnd(), accuracy );
+                    hitStart = nearStart && shape->Collide( aTrack->GetStart(), accuracy );
+                    hitEnd = nearEnd && shape->Collide( aTrack->GetEnd(), accuracy );
+                }
             }
 
             if( hitStart && hitEnd )
@@ -916,6 +1171,8 @@ CONNECTIVITY_DATA::GetConnectedItemsAtAnchor( const BOARD_CONNECTED_ITEM* aItem,
 
 RN_NET* CONNECTIVITY_DATA::GetRatsnestForNet( int aNet )
 {
+    WaitForRatsnest();
+
     if ( aNet < 0 || aNet >= (int) m_nets.size() )
         return nullptr;
 
@@ -938,6 +1195,8 @@ void CONNECTIVITY_DATA::MarkItemNetAsDirty( BOARD_ITEM *aItem )
 
 void CONNECTIVITY_DATA::RemoveInvalidRefs()
 {
+    WaitForRatsnest();
+
     m_connAlgo->RemoveInvalidRefs();
 
     for( RN_NET* rnNet : m_nets )
@@ -1012,6 +1271,8 @@ CONNECTIVITY_DATA::GetRatsnestForItems( const std::vector<BOARD_ITEM*>& aItems )
 
 const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForPad( const PAD* aPad )
 {
+    WaitForRatsnest();
+
     std::vector<CN_EDGE> edges;
     RN_NET* net = GetRatsnestForNet( aPad->GetNetCode() );
 
@@ -1037,6 +1298,8 @@ const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForPad( const PAD* aPad
 const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForComponent( FOOTPRINT* aComponent,
                                                                        bool aSkipInternalConnections )
 {
+    WaitForRatsnest();
+
     std::set<int> nets;
     std::set<const PAD*> pads;
     std::vector<CN_EDGE> edges;
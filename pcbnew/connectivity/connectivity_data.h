@@ -28,10 +28,16 @@
 #define __CONNECTIVITY_DATA_H
 
 #include <core/typeinfo.h>
+#include <core/profile.h>
 #include <core/spinlock.h>
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <vector>
 #include <wx/string.h>
 
@@ -40,6 +46,8 @@
 #include <zone.h>
 
 class FROM_TO_CACHE;
+class NET_LENGTH_CACHE;
+class CN_ANCHOR;
 class CN_CLUSTER;
 class CN_CONNECTIVITY_ALGO;
 class CN_EDGE;
@@ -82,6 +90,54 @@ enum class PROPAGATE_MODE
 };
 
 
+#ifndef SWIG
+/**
+ * Profiling counters for the connectivity and ratsnest updates (see CONNECTIVITY_DATA::Stats()).
+ *
+ * The counters accumulate until Reset(), and are logged after each ratsnest update when the
+ * KICAD_CONNECTIVITY trace mask is enabled.  Times are in microseconds.
+ */
+struct CN_STATS
+{
+    std::atomic<int64_t> m_itemsBuilt{ 0 };       ///< Items added by full builds
+    std::atomic<int64_t> m_itemsSearched{ 0 };    ///< Dirty items searched (one R-tree query each)
+    std::atomic<int64_t> m_candidatesTested{ 0 }; ///< R-tree candidates tested for a connection
+    std::atomic<int64_t> m_clusterSearches{ 0 };
+    std::atomic<int64_t> m_clusterItems{ 0 };     ///< Items visited by the cluster searches
+    std::atomic<int64_t> m_ratsnestNets{ 0 };     ///< Nets whose ratsnest was recomputed
+
+    std::atomic<int64_t> m_buildTime{ 0 };        ///< CN_CONNECTIVITY_ALGO::Build()
+    std::atomic<int64_t> m_searchTime{ 0 };       ///< Searching dirty items for connections
+    std::atomic<int64_t> m_clusterTime{ 0 };      ///< CN_CONNECTIVITY_ALGO::SearchClusters()
+    std::atomic<int64_t> m_ratsnestTime{ 0 };     ///< RN_NET::UpdateNet() (triangulation and MST)
+    std::atomic<int64_t> m_optimizeTime{ 0 };     ///< RN_NET::OptimizeRNEdges()
+
+    void Reset();
+    wxString Format() const;
+
+    /**
+     * Add the time from construction to destruction to a counter.
+     */
+    class TIMER
+    {
+    public:
+        TIMER( std::atomic<int64_t>& aTotal ) :
+                m_total( aTotal )
+        {}
+
+        ~TIMER()
+        {
+            m_total += m_timer.SinceStart<std::chrono::microseconds>().count();
+        }
+
+    private:
+        std::atomic<int64_t>& m_total;
+        PROF_TIMER            m_timer;
+    };
+};
+#endif
+
+
 // a wrapper class encompassing the connectivity computation algorithm and the
 class CONNECTIVITY_DATA
 {
@@ -156,6 +212,13 @@ public:
      */
     RN_NET* GetRatsnestForNet( int aNet );
 
+    /**
+     * Return the ratsnest edges of a net for display.  Unlike GetRatsnestForNet() this never
+     * waits: while an asynchronous update is running, nets being recomputed return the edges
+     * of their last completed ratsnest.
+     */
+    const std::vector<CN_EDGE>* GetDisplayedRatsnest( int aNet ) const;
+
     /**
      * Propagates the net codes from the source pads to the tracks/vias.
      * @param aCommit is used to save the undo state of items modified by this call
@@ -177,6 +240,21 @@ public:
      */
     void RecalculateRatsnest( BOARD_COMMIT* aCommit = nullptr );
 
+    /**
+     * Like RecalculateRatsnest(), but the ratsnest of the dirty nets is computed on a worker
+     * thread.  Until it completes the last completed ratsnest of those nets is displayed, and
+     * anything else needing the ratsnest (or changing the connectivity) waits for it.
+     *
+     * @param aOnComplete is called from the worker thread once the new ratsnest is ready.
+     */
+    void RecalculateRatsnestAsync( BOARD_COMMIT* aCommit, std::function<void()> aOnComplete );
+
+    /**
+     * Wait for an asynchronous ratsnest update (if any) to finish, and make it the displayed
+     * ratsnest.
+     */
+    void WaitForRatsnest() const;
+
     /**
      * @param aVisibleOnly include only visbile edges in the count
      * @return the number of remaining edges in the ratsnest
@@ -285,22 +363,46 @@ public:
 
     std::shared_ptr<FROM_TO_CACHE> GetFromToCache() { return m_fromToCache; }
 
+    std::shared_ptr<NET_LENGTH_CACHE> GetNetLengthCache() { return m_netLengthCache; }
+
+#ifndef SWIG
+    CN_STATS& Stats() { return m_stats; }
+#endif
+
 private:
 
     /**
      * Updates the ratsnest for the board without locking the connectivity mutex.
      * @param aCommit is used to save the undo state of items modified by this call
      */
-    void internalRecalculateRatsnest( BOARD_COMMIT* aCommit = nullptr );
+    void internalRecalculateRatsnest( BOARD_COMMIT* aCommit = nullptr,
+                                      std::function<void()> aOnComplete = nullptr );
     void updateRatsnest();
 
     void addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& aCluster );
 
+    ///< Forget the anchors each net has cached for the local ratsnest
+    void clearLineNodes();
+
 private:
+    /**
+     * A line of the local ratsnest, kept so that it can be redrawn on the next frame if there's
+     * no time to recompute it.
+     */
+    struct LOCAL_RATSNEST_LINE
+    {
+        std::shared_ptr<const CN_ANCHOR> m_movingNode;  ///< null if the net had no line
+        VECTOR2I                         m_staticPos;
+    };
+
     std::shared_ptr<CN_CONNECTIVITY_ALGO> m_connAlgo;
 
     std::shared_ptr<FROM_TO_CACHE>  m_fromToCache;
+    std::shared_ptr<NET_LENGTH_CACHE> m_netLengthCache;
     std::vector<RN_DYNAMIC_LINE>    m_dynamicRatsnest;
+
+    std::map<int, LOCAL_RATSNEST_LINE> m_localRatsnestLines;
+    std::set<int>                      m_staleLocalNets;   ///< Lines reused on the last frame
     std::vector<RN_NET*>            m_nets;
 
     /// Used to suppress ratsnest calculations on dynamic ratsnests
@@ -308,10 +410,20 @@ private:
 
     KISPINLOCK                      m_lock;
 
+    /// Pending asynchronous ratsnest update
+    mutable std::future<void>       m_ratsnestJob;
+
+    /// Last completed ratsnest of each net being recomputed by m_ratsnestJob
+    mutable std::map<int, std::vector<CN_EDGE>> m_displayedRatsnest;
+
     /// Map of netcode -> netclass the net is a member of; used for ratsnest painting
     std::map<int, wxString>         m_netclassMap;
 
     PROGRESS_REPORTER*              m_progressReporter;
+
+#ifndef SWIG
+    CN_STATS                        m_stats;
+#endif
 };
 
 #endif
@@ -82,6 +82,25 @@ const VECTOR2I CN_ITEM::GetAnchor( int n ) const
 }
 
 
+void CN_ITEM::AddAnchors( const std::vector<VECTOR2I>& aPositions )
+{
+    if( aPositions.empty() )
+        return;
+
+    // Each anchor's shared_ptr aliases (and keeps alive) the whole block
+    std::shared_ptr<std::vector<CN_ANCHOR>> block = std::make_shared<std::vector<CN_ANCHOR>>();
+    block->reserve( aPositions.size() );
+
+    for( const VECTOR2I& pos : aPositions )
+        block->emplace_back( pos, this );
+
+    m_anchors.reserve( m_anchors.size() + block->size() );
+
+    for( CN_ANCHOR& anchor : *block )
+        m_anchors.emplace_back( block, &anchor );
+}
+
+
 void CN_ITEM::Dump()
 {
     wxLogDebug("    valid: %d, connected: \n", !!Valid());
@@ -187,8 +206,7 @@ CN_ITEM* CN_LIST::Add( PCB_TRACK* track )
 {
     CN_ITEM* item = new CN_ITEM( track, true );
     m_items.push_back( item );
-    item->AddAnchor( track->GetStart() );
-    item->AddAnchor( track->GetEnd() );
+    item->AddAnchors( { track->GetStart(), track->GetEnd() } );
     item->SetLayer( track->GetLayer() );
     addItemtoTree( item );
     SetDirty();
@@ -200,8 +218,7 @@ CN_ITEM* CN_LIST::Add( PCB_ARC* aArc )
 {
     CN_ITEM* item = new CN_ITEM( aArc, true );
     m_items.push_back( item );
-    item->AddAnchor( aArc->GetStart() );
-    item->AddAnchor( aArc->GetEnd() );
+    item->AddAnchors( { aArc->GetStart(), aArc->GetEnd() } );
     item->SetLayer( aArc->GetLayer() );
     addItemtoTree( item );
     SetDirty();
@@ -235,8 +252,7 @@ const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 
         zitem->BuildRTree();
 
-        for( const VECTOR2I& pt : zone->GetFilledPolysList( aLayer )->COutline( j ).CPoints() )
-            zitem->AddAnchor( pt );
+        zitem->AddAnchors( polys->COutline( j ).CPoints() );
 
         rv.push_back( Add( zitem ) );
     }
@@ -259,8 +275,7 @@ CN_ITEM* CN_LIST::Add( PCB_SHAPE* shape )
     CN_ITEM* item = new CN_ITEM( shape, true );
     m_items.push_back( item );
 
-    for( const VECTOR2I& point : shape->GetConnectionPoints() )
-        item->AddAnchor( point );
+    item->AddAnchors( shape->GetConnectionPoints() );
 
     item->SetLayer( shape->GetLayer() );
     addItemtoTree( item );
@@ -288,6 +303,12 @@ void CN_LIST::RemoveInvalidItems( std::vector<CN_ITEM*>& aGarbage )
 
     m_items.resize( lastItem - m_items.begin() );
 
+    alg::delete_if( m_dirtyItems,
+                    []( CN_ITEM* item )
+                    {
+                        return !item->Valid();
+                    } );
+
     for( CN_ITEM* item : aGarbage )
         m_index.Remove( item );
 
@@ -141,6 +141,7 @@ public:
         m_visited = false;
         m_valid = true;
         m_dirty = true;
+        m_connectionHash = 0;
         m_anchors.reserve( std::max( 6, aAnchorCount ) );
         m_layers = LAYER_RANGE( 0, PCB_LAYER_ID_COUNT );
         m_connected.reserve( 8 );
@@ -158,6 +159,12 @@ public:
         return m_anchors.at( m_anchors.size() - 1 );
     }
 
+    /**
+     * Add several anchors at once.  The anchors share a single allocation, so they are contiguous
+     * in memory and cost one heap allocation rather than one each.
+     */
+    void AddAnchors( const std::vector<VECTOR2I>& aPositions );
+
     std::vector<std::shared_ptr<CN_ANCHOR>>& Anchors() { return m_anchors; }
 
     void SetValid( bool aValid ) { m_valid = aValid; }
@@ -229,6 +236,13 @@ public:
         return ( !m_parent || !m_valid ) ? -1 : m_parent->GetNetCode();
     }
 
+    /**
+     * The hash of the parent's position, shape, layers and net at the time the item was added,
+     * or 0 if the item must always be rebuilt when its parent changes.
+     */
+    void SetConnectionHash( size_t aHash ) { m_connectionHash = aHash; }
+    size_t ConnectionHash() const { return m_connectionHash; }
+
 protected:
     bool            m_dirty;         ///< used to identify recently added item not yet
                                      ///< scanned into the connectivity search
@@ -245,6 +259,7 @@ private:
 
     bool            m_visited;       ///< visited flag for the BFS scan
     bool            m_valid;         ///< used to identify garbage items (we use lazy removal)
+    size_t          m_connectionHash; ///< parent state the connections were searched for
 
     std::mutex      m_listLock;      ///< mutex protecting this item's connected_items set to
 };
@@ -385,6 +400,7 @@ public:
             delete item;
 
         m_items.clear();
+        m_dirtyItems.clear();
         m_index.RemoveAll();
     }
 
@@ -409,11 +425,17 @@ public:
 
     void RemoveInvalidItems( std::vector<CN_ITEM*>& aGarbage );
 
+    /**
+     * @return the items added since the last ClearDirtyFlags(), in the order they were added.
+     */
+    const std::vector<CN_ITEM*>& DirtyItems() const { return m_dirtyItems; }
+
     void ClearDirtyFlags()
     {
-        for( CN_ITEM* item : m_items )
+        for( CN_ITEM* item : m_dirtyItems )
             item->SetDirty( false );
 
+        m_dirtyItems.clear();
         SetDirty( false );
     }
 
@@ -432,10 +454,12 @@ protected:
     void addItemtoTree( CN_ITEM* item )
     {
         m_index.Insert( item );
+        m_dirtyItems.push_back( item );
     }
 
 protected:
     std::vector<CN_ITEM*> m_items;
+    std::vector<CN_ITEM*> m_dirtyItems;   ///< items not yet scanned by searchConnections()
 
 private:
     bool                  m_dirty;
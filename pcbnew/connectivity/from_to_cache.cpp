@@ -21,7 +21,12 @@
 #include <memory>
 #include <reporter.h>
 #include <board.h>
+#include <hash.h>
+#include <hash_eda.h>
+#include <pcb_track.h>
 #include <string_utils.h>
+#include <zone.h>
+#include <core/kicad_algo.h>
 
 #include <pcbexpr_evaluator.h>
 
@@ -33,6 +38,7 @@
 void FROM_TO_CACHE::buildEndpointList( )
 {
     m_ftEndpoints.clear();
+    m_endpointsHash = 0;
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
@@ -42,6 +48,7 @@ void FROM_TO_CACHE::buildEndpointList( )
             ent.name = footprint->GetReference() + wxT( "-" ) + pad->GetNumber();
             ent.parent = pad;
             m_ftEndpoints.push_back( ent );
+            hash_combine( m_endpointsHash, ent.name, ent.parent );
             ent.name = footprint->GetReference();
             ent.parent = pad;
             m_ftEndpoints.push_back( ent );
@@ -50,6 +57,53 @@ void FROM_TO_CACHE::buildEndpointList( )
 }
 
 
+const std::map<int, size_t>& FROM_TO_CACHE::netHashes()
+{
+    if( m_netHashesValid )
+        return m_netHashes;
+
+    m_netHashes.clear();
+
+    // Sum the item hashes so that the result doesn't depend on the order of the items
+    auto addItem =
+            [&]( BOARD_CONNECTED_ITEM* aItem )
+            {
+                size_t hash = hash_fp_item( aItem, HASH_POS | HASH_ROT | HASH_LAYER );
+                hash_combine( hash, aItem );
+
+                m_netHashes[ aItem->GetNetCode() ] += hash;
+            };
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+        addItem( track );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            addItem( pad );
+    }
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( zone->GetIsRuleArea() || !zone->IsOnCopperLayer() )
+            continue;
+
+        size_t hash = hash_val( zone );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( zone->HasFilledPolysForLayer( layer ) )
+                hash_combine( hash, layer, zone->GetFilledPolysList( layer )->GetHash().Format() );
+        }
+
+        m_netHashes[ zone->GetNetCode() ] += hash;
+    }
+
+    m_netHashesValid = true;
+    return m_netHashes;
+}
+
+
 enum PATH_STATUS {
     PS_OK = 0,
     PS_MULTIPLE_PATHS = -1,
@@ -218,6 +272,21 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
         newPaths++;
     }
 
+    // Remember which nets were searched, so that the paths can be kept until one of them changes
+    FT_QUERY                     query;
+    const std::map<int, size_t>& hashes = netHashes();
+
+    query.fromWildcard = aFrom;
+    query.toWildcard = aTo;
+
+    for( const FT_PATH& path : paths )
+    {
+        auto it = hashes.find( path.net );
+        query.netHashes[ path.net ] = it != hashes.end() ? it->second : 0;
+    }
+
+    m_ftQueries.push_back( query );
+
     // reportAux( _("Cached %d paths\n"), newPaths );
 
     return newPaths;
@@ -225,29 +294,26 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
 
 bool  FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo )
 {
-    int nFromTosFound = 0;
-
     if( !m_board )
         return false;
 
-    for( int attempt = 0; attempt < 2; attempt++ )
-    {
-        // item already belongs to path
-        for( FT_PATH& ftPath : m_ftPaths )
-        {
-            if( aFrom == ftPath.fromWildcard && aTo == ftPath.toWildcard )
+    auto isQuery =
+            [&]( const FT_QUERY& aQuery )
             {
-                nFromTosFound++;
+                return aFrom == aQuery.fromWildcard && aTo == aQuery.toWildcard;
+            };
 
-                if( ftPath.pathItems.count( aItem ) )
-                    return true;
-            }
-        }
+    // Wildcard pairs without any paths are cached too, so they don't get searched again
+    if( !std::any_of( m_ftQueries.begin(), m_ftQueries.end(), isQuery ) )
+        cacheFromToPaths( aFrom, aTo );
 
-        if( !nFromTosFound )
-            cacheFromToPaths( aFrom, aTo );
-        else
-            return false;
+    for( FT_PATH& ftPath : m_ftPaths )
+    {
+        if( aFrom == ftPath.fromWildcard && aTo == ftPath.toWildcard )
+        {
+            if( ftPath.pathItems.count( aItem ) )
+                return true;
+        }
     }
 
     return false;
@@ -256,9 +322,48 @@ bool  FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString
 
 void FROM_TO_CACHE::Rebuild( BOARD* aBoard )
 {
+    bool   sameBoard = ( aBoard == m_board );
+    size_t oldEndpointsHash = m_endpointsHash;
+
     m_board = aBoard;
+    m_netHashesValid = false;
     buildEndpointList();
-    m_ftPaths.clear();
+
+    if( !sameBoard || m_endpointsHash != oldEndpointsHash )
+    {
+        m_ftPaths.clear();
+        m_ftQueries.clear();
+        return;
+    }
+
+    if( m_ftQueries.empty() )
+        return;
+
+    const std::map<int, size_t>&           hashes = netHashes();
+    std::set<std::pair<wxString, wxString>> staleQueries;
+
+    alg::delete_if( m_ftQueries,
+            [&]( const FT_QUERY& aQuery )
+            {
+                for( const auto& [ net, hash ] : aQuery.netHashes )
+                {
+                    auto it = hashes.find( net );
+
+                    if( ( it != hashes.end() ? it->second : 0 ) != hash )
+                    {
+                        staleQueries.emplace( aQuery.fromWildcard, aQuery.toWildcard );
+                        return true;
+                    }
+                }
+
+                return false;
+            } );
+
+    alg::delete_if( m_ftPaths,
+            [&]( const FT_PATH& aPath )
+            {
+                return staleQueries.count( { aPath.fromWildcard, aPath.toWildcard } ) > 0;
+            } );
 }
 
 
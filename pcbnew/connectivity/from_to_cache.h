@@ -20,6 +20,7 @@
 #ifndef FROM_TO_CACHE_H
 #define FROM_TO_CACHE_H
 
+#include <map>
 #include <set>
 
 class PAD;
@@ -55,18 +56,45 @@ public:
     {
     }
 
+    /**
+     * Prepare the cache for a new set of queries on \a aBoard.
+     *
+     * Paths are kept from one rebuild to the next unless one of the nets searched for them has
+     * changed, or the pads (or their names) have.
+     */
     void Rebuild( BOARD* aBoard );
     bool IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo );
 
     FT_PATH* QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems );
 
 private:
+    /**
+     * A from/to wildcard pair whose paths have been cached, along with the hashes of the nets
+     * which were searched for them at the time.
+     */
+    struct FT_QUERY
+    {
+        wxString              fromWildcard, toWildcard;
+        std::map<int, size_t> netHashes;
+    };
+
     int cacheFromToPaths( const wxString& aFrom, const wxString& aTo );
     void buildEndpointList();
 
+    /**
+     * Hash the position, shape and layers of each net's copper, in a single pass over the
+     * board.  Only done once per rebuild, and only when there are paths to check.
+     */
+    const std::map<int, size_t>& netHashes();
+
 private:
     std::vector<FT_ENDPOINT> m_ftEndpoints;
     std::vector<FT_PATH>     m_ftPaths;
+    std::vector<FT_QUERY>    m_ftQueries;
+
+    size_t                   m_endpointsHash = 0;
+    std::map<int, size_t>    m_netHashes;
+    bool                     m_netHashesValid = false;
 
     BOARD*                   m_board;
 };
@@ -0,0 +1,371 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <connectivity/net_length_cache.h>
+
+#include <algorithm>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <hash.h>
+#include <hash_eda.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <connectivity/connectivity_data.h>
+#include <core/thread_pool.h>
+#include <geometry/shape_poly_set.h>
+
+
+static const std::initializer_list<KICAD_T> lengthTypes = { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T,
+                                                            PCB_PAD_T };
+
+
+size_t NET_LENGTH_CACHE::hashBoardSettings( const BOARD* aBoard )
+{
+    const BOARD_DESIGN_SETTINGS& bds = aBoard->GetDesignSettings();
+    size_t                       hash = 0;
+
+    hash_combine( hash, bds.m_HasStackup, bds.GetBoardThickness(), bds.GetCopperLayerCount() );
+
+    if( bds.m_HasStackup )
+    {
+        const BOARD_STACKUP& stackup = bds.GetStackupDescriptor();
+
+        for( PCB_LAYER_ID layer : LSET::AllCuMask().Seq() )
+            hash_combine( hash, stackup.GetLayerDistance( F_Cu, layer ) );
+    }
+
+    return hash;
+}
+
+
+NET_LENGTH_CACHE::ITEM_LENGTH NET_LENGTH_CACHE::measureItem( const BOARD* aBoard,
+                                                             const BOARD_CONNECTED_ITEM* aItem )
+{
+    ITEM_LENGTH length;
+
+    if( !aBoard )
+        return length;
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = aBoard->GetConnectivity();
+
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+        length.m_padToDie = static_cast<const PAD*>( aItem )->GetPadToDieLength();
+        break;
+
+    case PCB_ARC_T:
+        // Note: we don't apply the clip-to-pad optimization if an arc ends in a pad.
+        // Room for future improvement.
+        length.m_track = static_cast<const PCB_ARC*>( aItem )->GetLength();
+        break;
+
+    case PCB_VIA_T:
+    {
+        const PCB_VIA*               via = static_cast<const PCB_VIA*>( aItem );
+        const BOARD_DESIGN_SETTINGS& bds = aBoard->GetDesignSettings();
+        PCB_LAYER_ID                 topmost;
+        PCB_LAYER_ID                 bottommost;
+
+        via->GetOutermostConnectedLayers( &topmost, &bottommost );
+
+        if( topmost == UNDEFINED_LAYER || topmost == bottommost )
+            break;
+
+        if( bds.m_HasStackup )
+        {
+            const BOARD_STACKUP& stackup = bds.GetStackupDescriptor();
+            length.m_via = stackup.GetLayerDistance( topmost, bottommost );
+        }
+        else
+        {
+            // FIXME: not all dielectric layers are the same thickness!
+            int dielectricLayers = std::max( 1, bds.GetCopperLayerCount() - 1 );
+            int layerThickness = bds.GetBoardThickness() / dielectricLayers;
+
+            auto stackupIndex =
+                    [&]( PCB_LAYER_ID aLayer )
+                    {
+                        return aLayer == B_Cu ? dielectricLayers : static_cast<int>( aLayer );
+                    };
+
+            length.m_via = ( stackupIndex( bottommost ) - stackupIndex( topmost ) )
+                            * layerThickness;
+        }
+
+        break;
+    }
+
+    case PCB_TRACE_T:
+    {
+        const PCB_TRACK* track = static_cast<const PCB_TRACK*>( aItem );
+        SEG              trackSeg( track->GetStart(), track->GetEnd() );
+        double           segLen = trackSeg.Length();
+        double           segInPadLen = 0;
+
+        for( PAD* pad : connectivity->GetConnectedPads( aItem ) )
+        {
+            bool hitStart = pad->HitTest( track->GetStart(), track->GetWidth() / 2 );
+            bool hitEnd = pad->HitTest( track->GetEnd(), track->GetWidth() / 2 );
+
+            if( hitStart && hitEnd )
+            {
+                // Entirely inside the pad
+                return length;
+            }
+            else if( hitStart || hitEnd )
+            {
+                VECTOR2I loc;
+
+                // We may not collide even if we passed the bounding-box hit test
+                if( pad->GetEffectivePolygon( ERROR_INSIDE )->Collide( trackSeg, 0, nullptr, &loc ) )
+                {
+                    // Part 1: length of the seg to the intersection with the pad poly
+                    if( hitStart )
+                        trackSeg.A = loc;
+                    else
+                        trackSeg.B = loc;
+
+                    segLen = trackSeg.Length();
+
+                    // Part 2: length from the intersection to the pad anchor
+                    segInPadLen += ( loc - pad->GetPosition() ).EuclideanNorm();
+                }
+            }
+        }
+
+        length.m_track = segLen + segInPadLen;
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    return length;
+}
+
+
+void NET_LENGTH_CACHE::Update( const BOARD* aBoard, const std::vector<int>& aNetCodes )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    size_t settingsHash = hashBoardSettings( aBoard );
+
+    if( aBoard != m_board || settingsHash != m_boardSettingsHash )
+    {
+        m_nets.clear();
+        m_itemNets.clear();
+        m_board = aBoard;
+        m_boardSettingsHash = settingsHash;
+    }
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = aBoard->GetConnectivity();
+
+    struct STALE_NET
+    {
+        int                                m_netCode;
+        size_t                             m_hash;
+        std::vector<BOARD_CONNECTED_ITEM*> m_items;
+        NET_ENTRY                          m_entry;
+    };
+
+    std::vector<STALE_NET> staleNets;
+
+    for( int netCode : aNetCodes )
+    {
+        if( netCode <= 0 )
+            continue;
+
+        std::vector<BOARD_CONNECTED_ITEM*> items = connectivity->GetNetItems( netCode, lengthTypes );
+
+        // Sum the item hashes so that the result doesn't depend on the order of the items
+        size_t hash = items.size();
+
+        for( BOARD_CONNECTED_ITEM* item : items )
+        {
+            size_t itemHash = hash_fp_item( item, HASH_POS | HASH_ROT | HASH_LAYER );
+            hash_combine( itemHash, item );
+
+            if( item->Type() == PCB_PAD_T )
+            {
+                hash_combine( itemHash, static_cast<PAD*>( item )->GetPadToDieLength() );
+            }
+            else if( item->Type() == PCB_VIA_T )
+            {
+                PCB_VIA* via = static_cast<PCB_VIA*>( item );
+
+                for( PCB_LAYER_ID layer : LSET::AllCuMask().Seq() )
+                    hash_combine( itemHash, static_cast<int>( via->GetZoneLayerOverride( layer ) ) );
+            }
+
+            hash += itemHash;
+        }
+
+        auto it = m_nets.find( netCode );
+
+        if( it != m_nets.end() && it->second.m_hash == hash )
+            continue;
+
+        staleNets.push_back( { netCode, hash, std::move( items ), NET_ENTRY() } );
+    }
+
+    if( staleNets.empty() )
+        return;
+
+    auto measureNet =
+            [&]( STALE_NET& aNet )
+            {
+                NET_ENTRY& entry = aNet.m_entry;
+
+                entry.m_hash = aNet.m_hash;
+
+                for( BOARD_CONNECTED_ITEM* item : aNet.m_items )
+                {
+                    ITEM_LENGTH itemLength = measureItem( aBoard, item );
+
+                    entry.m_items[item] = itemLength;
+                    entry.m_length.m_itemCount++;
+                    entry.m_length.m_track += itemLength.m_track;
+                    entry.m_length.m_via += itemLength.m_via;
+                    entry.m_length.m_padToDie += itemLength.m_padToDie;
+
+                    if( item->Type() == PCB_PAD_T )
+                        entry.m_length.m_padCount++;
+                    else if( item->Type() == PCB_VIA_T )
+                        entry.m_length.m_viaCount++;
+                    else if( item->Type() != PCB_PAD_T && IsCopperLayer( item->GetLayer() ) )
+                        entry.m_length.m_layerTrack[item->GetLayer()] += itemLength.m_track;
+                }
+            };
+
+    if( staleNets.size() == 1 )
+    {
+        measureNet( staleNets.front() );
+    }
+    else
+    {
+        ParallelForEachIndex( staleNets.size(),
+                [&]( size_t ii )
+                {
+                    measureNet( staleNets[ii] );
+                },
+                TASK_PRIORITY::INTERACTIVE );
+    }
+
+    m_generation++;
+
+    for( STALE_NET& net : staleNets )
+    {
+        NET_ENTRY& entry = m_nets[net.m_netCode];
+
+        for( const auto& [item, length] : entry.m_items )
+        {
+            auto itemNet = m_itemNets.find( item );
+
+            if( itemNet != m_itemNets.end() && itemNet->second == net.m_netCode )
+                m_itemNets.erase( itemNet );
+        }
+
+        entry = std::move( net.m_entry );
+        entry.m_generation = m_generation;
+
+        for( const auto& [item, length] : entry.m_items )
+            m_itemNets[item] = net.m_netCode;
+    }
+}
+
+
+NET_LENGTH_CACHE::NET_LENGTH NET_LENGTH_CACHE::GetNetLength( int aNetCode ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    auto it = m_nets.find( aNetCode );
+
+    if( it != m_nets.end() )
+        return it->second.m_length;
+
+    return NET_LENGTH();
+}
+
+
+NET_LENGTH_CACHE::ITEM_LENGTH NET_LENGTH_CACHE::GetItemLength( const BOARD_CONNECTED_ITEM* aItem ) const
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto netIt = m_nets.find( aItem->GetNetCode() );
+
+        if( netIt != m_nets.end() )
+        {
+            auto itemIt = netIt->second.m_items.find( aItem );
+
+            if( itemIt != netIt->second.m_items.end() )
+                return itemIt->second;
+        }
+    }
+
+    return measureItem( aItem->GetBoard(), aItem );
+}
+
+
+int NET_LENGTH_CACHE::GetCountedNet( const BOARD_CONNECTED_ITEM* aItem ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    auto it = m_itemNets.find( aItem );
+
+    return it != m_itemNets.end() ? it->second : -1;
+}
+
+
+uint64_t NET_LENGTH_CACHE::GetGeneration() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_generation;
+}
+
+
+std::vector<int> NET_LENGTH_CACHE::GetNetsUpdatedSince( uint64_t aGeneration ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    std::vector<int> netCodes;
+
+    for( const auto& [netCode, entry] : m_nets )
+    {
+        if( entry.m_generation > aGeneration )
+            netCodes.push_back( netCode );
+    }
+
+    return netCodes;
+}
+
+
+void NET_LENGTH_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_nets.clear();
+    m_itemNets.clear();
+    m_board = nullptr;
+    m_boardSettingsHash = 0;
+}
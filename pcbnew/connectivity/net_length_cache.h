@@ -0,0 +1,132 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_LENGTH_CACHE_H
+#define NET_LENGTH_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <layer_ids.h>
+
+class BOARD;
+class BOARD_CONNECTED_ITEM;
+
+
+/**
+ * The lengths of the copper items of the nets of a board, shared by the matched length DRC
+ * test, the net inspector and the length displays of tracks, nets and tuning patterns, so that
+ * they all agree and don't each measure the nets again.
+ *
+ * The lengths of a net are kept until its copper changes: Update() hashes the items of the nets
+ * asked for, and only measures again (in parallel) the nets whose hash changed.
+ */
+class NET_LENGTH_CACHE
+{
+public:
+    /**
+     * The length an item adds to its net.
+     */
+    struct ITEM_LENGTH
+    {
+        double m_track = 0.0;      ///< Tracks and arcs; tracks ending in a pad up to its anchor
+        int    m_via = 0;          ///< Vias: height between their outermost connected layers
+        int    m_padToDie = 0;     ///< Pads
+    };
+
+    struct NET_LENGTH
+    {
+        int                                m_itemCount = 0;
+        int                                m_padCount = 0;
+        int                                m_viaCount = 0;
+        double                             m_track = 0.0;
+        std::array<double, MAX_CU_LAYERS> m_layerTrack{};   ///< m_track per copper layer
+        int64_t                            m_via = 0;
+        int64_t                            m_padToDie = 0;
+    };
+
+    /**
+     * Bring the lengths of \a aNetCodes up to date with \a aBoard, measuring the nets whose
+     * copper changed since they were last measured.
+     *
+     * Several nets are measured in parallel on the thread pool, so this must not be called
+     * from a task of the pool.  The connectivity of \a aBoard must be up to date.
+     */
+    void Update( const BOARD* aBoard, const std::vector<int>& aNetCodes );
+
+    /**
+     * @return the length of \a aNetCode as of its last Update() (empty if never updated).
+     */
+    NET_LENGTH GetNetLength( int aNetCode ) const;
+
+    /**
+     * @return the length \a aItem added to its net as of the last Update() of the net, or
+     *         its current length if it wasn't counted then.
+     */
+    ITEM_LENGTH GetItemLength( const BOARD_CONNECTED_ITEM* aItem ) const;
+
+    /**
+     * @return the net \a aItem was counted in by the last Update() of that net, or -1 if it
+     *         wasn't counted.  The pointer is only compared, so it may be to a removed item.
+     */
+    int GetCountedNet( const BOARD_CONNECTED_ITEM* aItem ) const;
+
+    /**
+     * @return a number which increases each time Update() measures some nets.
+     */
+    uint64_t GetGeneration() const;
+
+    /**
+     * @return the nets measured again since GetGeneration() returned \a aGeneration, so that
+     *         a user keeping a copy of the lengths can refresh only those.
+     */
+    std::vector<int> GetNetsUpdatedSince( uint64_t aGeneration ) const;
+
+    void Clear();
+
+private:
+    struct NET_ENTRY
+    {
+        size_t                                                         m_hash = 0;
+        uint64_t                                                       m_generation = 0;
+        NET_LENGTH                                                     m_length;
+        std::unordered_map<const BOARD_CONNECTED_ITEM*, ITEM_LENGTH> m_items;
+    };
+
+    static ITEM_LENGTH measureItem( const BOARD* aBoard, const BOARD_CONNECTED_ITEM* aItem );
+
+    /**
+     * Hash the settings all the lengths depend on: the stackup and board thickness.
+     */
+    static size_t hashBoardSettings( const BOARD* aBoard );
+
+    mutable std::mutex                 m_mutex;
+    const BOARD*                       m_board = nullptr;
+    size_t                             m_boardSettingsHash = 0;
+    uint64_t                           m_generation = 0;
+    std::unordered_map<int, NET_ENTRY> m_nets;
+
+    /// The net each item was counted in, to find the net an item left
+    std::unordered_map<const BOARD_CONNECTED_ITEM*, int> m_itemNets;
+};
+
+#endif // NET_LENGTH_CACHE_H
@@ -303,7 +303,13 @@ void DIALOG_DRC::OnRunDRCClick( wxCommandEvent& aEvent )
     m_cancelled = false;
 
     m_frame->GetBoard()->RecordDRCExclusions();
-    deleteAllMarkers( true );
+
+    // The DRC tool replaces the stale markers itself; just let go of them until it's done
+    m_frame->GetToolManager()->RunAction( PCB_ACTIONS::selectionClear );
+
+    m_markersTreeModel->Update( nullptr, m_severities );
+    m_unconnectedTreeModel->Update( nullptr, m_severities );
+    m_fpWarningsTreeModel->Update( nullptr, m_severities );
 
     std::vector<std::reference_wrapper<RC_ITEM>> violations = DRC_ITEM::GetItemsWithSeverities();
     m_ignoredList->DeleteAllItems();
@@ -327,6 +327,9 @@ void DIALOG_EXCHANGE_FOOTPRINTS::processMatchingFootprints()
             return;
     }
 
+    std::vector<FOOTPRINT*> matches;
+    std::vector<LIB_ID>     newFPIDs;
+
     /*
      * NB: the change is done from the last footprint because processFootprint() modifies the
      * last item in the list.
@@ -339,15 +342,20 @@ void DIALOG_EXCHANGE_FOOTPRINTS::processMatchingFootprints()
         if( !isMatch( footprint ) )
             continue;
 
-        if( m_updateMode )
-            processFootprint( footprint, footprint->GetFPID() );
-        else
-            processFootprint( footprint, newFPID );
+        matches.push_back( footprint );
+        newFPIDs.push_back( m_updateMode ? footprint->GetFPID() : newFPID );
     }
+
+    // The library footprints are all loaded at once, in parallel, before being swapped in
+    std::vector<FOOTPRINT*> newFootprints = m_parent->LoadLibraryFootprints( newFPIDs );
+
+    for( size_t ii = 0; ii < matches.size(); ++ii )
+        processFootprint( matches[ii], newFPIDs[ii], newFootprints[ii] );
 }
 
 
-void DIALOG_EXCHANGE_FOOTPRINTS::processFootprint( FOOTPRINT* aFootprint, const LIB_ID& aNewFPID )
+void DIALOG_EXCHANGE_FOOTPRINTS::processFootprint( FOOTPRINT* aFootprint, const LIB_ID& aNewFPID,
+                                                   FOOTPRINT* aNewFootprint )
 {
     LIB_ID    oldFPID = aFootprint->GetFPID();
     wxString  msg;
@@ -367,7 +375,7 @@ void DIALOG_EXCHANGE_FOOTPRINTS::processFootprint( FOOTPRINT* aFootprint, const
                     aNewFPID.Format().c_str() );
     }
 
-    FOOTPRINT* newFootprint = m_parent->LoadFootprint( aNewFPID );
+    FOOTPRINT* newFootprint = aNewFootprint;
 
     if( !newFootprint )
     {
@@ -35,7 +35,8 @@
 #include <view/view_controls.h>
 #include <pcb_painter.h>
 #include <kiplatform/ui.h>
-#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+#include <connectivity/net_length_cache.h>
 #include <dialogs/dialog_text_entry.h>
 #include <validators.h>
 #include <bitmaps.h>
@@ -49,7 +50,7 @@
 #include <wx/dcclient.h>
 #include <wx/wupdlock.h>
 
-#include <bitset>
+#include <set>
 #include <vector>
 
 
@@ -1264,52 +1265,6 @@ bool DIALOG_NET_INSPECTOR::netFilterMatches( NETINFO_ITEM* aNet ) const
 }
 
 
-struct NETCODE_CMP_LESS
-{
-    bool operator()( const CN_ITEM* a, const CN_ITEM* b ) const
-    {
-        return a->Net() < b->Net();
-    }
-
-    bool operator()( const CN_ITEM* a, int b ) const
-    {
-        return a->Net() < b;
-    }
-
-    bool operator()( int a, const CN_ITEM* b ) const
-    {
-        return a < b->Net();
-    }
-};
-
-
-std::vector<CN_ITEM*> DIALOG_NET_INSPECTOR::relevantConnectivityItems() const
-{
-    // pre-filter the connectivity items and sort them by netcode.
-    // this avoids quadratic runtime when building the whole net list and
-    // calculating the total length for each net.
-
-    const auto type_bits = std::bitset<MAX_STRUCT_TYPE_ID>()
-            .set( PCB_TRACE_T )
-            .set( PCB_ARC_T )
-            .set( PCB_VIA_T )
-            .set( PCB_PAD_T );
-
-    std::vector<CN_ITEM*> cn_items;
-    cn_items.reserve( 1024 );
-
-    for( CN_ITEM* cn_item : m_brd->GetConnectivity()->GetConnectivityAlgo()->ItemList() )
-    {
-        if( cn_item->Valid() && type_bits[cn_item->Parent()->Type()] )
-            cn_items.push_back( cn_item );
-    }
-
-    std::sort( cn_items.begin(), cn_items.end(), NETCODE_CMP_LESS() );
-
-    return cn_items;
-}
-
-
 void DIALOG_NET_INSPECTOR::updateDisplayedRowValues( const std::optional<LIST_ITEM_ITER>& aRow )
 {
     if( !aRow )
@@ -1355,81 +1310,15 @@ wxString DIALOG_NET_INSPECTOR::formatLength( int64_t aValue ) const
 
 void DIALOG_NET_INSPECTOR::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
 {
-    if( NETINFO_ITEM* net = dynamic_cast<NETINFO_ITEM*>( aBoardItem ) )
-    {
-        // a new net has been added to the board.  add it to our list if it
-        // passes the netname filter test.
-
-        if( netFilterMatches( net ) )
-        {
-            std::unique_ptr<LIST_ITEM> new_item = std::make_unique<LIST_ITEM>( net );
-
-            // the new net could have some pads already assigned, count them.
-            new_item->SetPadCount( m_brd->GetNodesCount( net->GetNetCode() ) );
-
-            m_data_model->addItem( std::move( new_item ) );
-        }
-    }
-    else if( BOARD_CONNECTED_ITEM* i = dynamic_cast<BOARD_CONNECTED_ITEM*>( aBoardItem ) )
-    {
-        std::optional<LIST_ITEM_ITER> r = m_data_model->findItem( i->GetNet() );
-
-        if( r )
-        {
-            // try to handle frequent operations quickly.
-            if( PCB_TRACK* track = dynamic_cast<PCB_TRACK*>( i ) )
-            {
-                const std::unique_ptr<LIST_ITEM>& list_item = *r.value();
-                int len = track->GetLength();
-
-                list_item->AddLayerWireLength( len, static_cast<int>( track->GetLayer() ) );
-
-                if( track->Type() == PCB_VIA_T )
-                {
-                    list_item->AddViaCount( 1 );
-                    list_item->AddViaLength( calculateViaLength( track ) );
-                }
-
-                updateDisplayedRowValues( r );
-                return;
-            }
-        }
-
-        // resort to generic slower net update otherwise.
-        updateNet( i->GetNet() );
-    }
-    else if( FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( aBoardItem ) )
-    {
-        for( const PAD* pad : footprint->Pads() )
-        {
-            std::optional<LIST_ITEM_ITER> r = m_data_model->findItem( pad->GetNet() );
-
-            if( !r )
-            {
-                // if show-zero-pads is off, we might not have this net
-                // in our list yet, so add it first.
-                // notice that at this point we are very certain that this net
-                // will have at least one pad.
-
-                if( netFilterMatches( pad->GetNet() ) )
-                    r = m_data_model->addItem( std::make_unique<LIST_ITEM>( pad->GetNet() ) );
-            }
+    std::set<int> netCodes;
 
-            if( r )
-            {
-                const std::unique_ptr<LIST_ITEM>& list_item = *r.value();
-                int len = pad->GetPadToDieLength();
-
-                list_item->AddPadCount( 1 );
-                list_item->AddChipWireLength( len );
+    // a new net could have some pads already assigned, so it is updated like a changed one.
+    if( NETINFO_ITEM* net = dynamic_cast<NETINFO_ITEM*>( aBoardItem ) )
+        netCodes.insert( net->GetNetCode() );
+    else
+        collectNets( aBoardItem, netCodes );
 
-                if( list_item->GetPadCount() == 0 && !m_cbShowZeroPad->IsChecked() )
-                    m_data_model->deleteItem( r );
-                else
-                    updateDisplayedRowValues( r );
-            }
-        }
-    }
+    updateNets( netCodes );
 }
 
 
@@ -1437,70 +1326,27 @@ void DIALOG_NET_INSPECTOR::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_I
 {
     m_in_bulk_update = true;
 
+    std::set<int> netCodes;
+
     for( BOARD_ITEM* item : aBoardItem )
     {
-        OnBoardItemAdded( aBoard, item );
+        if( NETINFO_ITEM* net = dynamic_cast<NETINFO_ITEM*>( item ) )
+            netCodes.insert( net->GetNetCode() );
+        else
+            collectNets( item, netCodes );
     }
 
+    updateNets( netCodes );
+
     m_in_bulk_update = false;
 }
 
 
 void DIALOG_NET_INSPECTOR::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
 {
-    if( NETINFO_ITEM* net = dynamic_cast<NETINFO_ITEM*>( aBoardItem ) )
-    {
-        m_data_model->deleteItem( m_data_model->findItem( net ) );
-    }
-    else if( FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( aBoardItem ) )
-    {
-        for( const PAD* pad : footprint->Pads() )
-        {
-            std::optional<LIST_ITEM_ITER> r = m_data_model->findItem( pad->GetNet() );
-
-            if( r )
-            {
-                const std::unique_ptr<LIST_ITEM>& list_item = *r.value();
-                int len = pad->GetPadToDieLength();
+    std::vector<BOARD_ITEM*> items{ aBoardItem };
 
-                list_item->SubPadCount( 1 );
-                list_item->SubChipWireLength( len );
-
-                if( list_item->GetPadCount() == 0 && !m_cbShowZeroPad->IsChecked() )
-                    m_data_model->deleteItem( r );
-                else
-                    updateDisplayedRowValues( r );
-            }
-        }
-    }
-    else if( BOARD_CONNECTED_ITEM* i = dynamic_cast<BOARD_CONNECTED_ITEM*>( aBoardItem ) )
-    {
-        std::optional<LIST_ITEM_ITER> r = m_data_model->findItem( i->GetNet() );
-
-        if( r )
-        {
-            // try to handle frequent operations quickly.
-            if( PCB_TRACK* track = dynamic_cast<PCB_TRACK*>( i ) )
-            {
-                const std::unique_ptr<LIST_ITEM>& list_item = *r.value();
-                int len = track->GetLength();
-
-                list_item->SubLayerWireLength( len, static_cast<int>( track->GetLayer() ) );
-
-                if( track->Type() == PCB_VIA_T )
-                {
-                    list_item->SubViaCount( 1 );
-                    list_item->SubViaLength( calculateViaLength( track ) );
-                }
-
-                updateDisplayedRowValues( r );
-                return;
-            }
-
-            // resort to generic slower net update otherwise.
-            updateNet( i->GetNet() );
-        }
-    }
+    OnBoardItemsRemoved( aBoard, items );
 }
 
 
@@ -1509,31 +1355,44 @@ void DIALOG_NET_INSPECTOR::OnBoardItemsRemoved( BOARD& aBoard,
 {
     m_in_bulk_update = true;
 
+    std::set<int> netCodes;
+
     for( BOARD_ITEM* item : aBoardItems )
     {
-        OnBoardItemRemoved( aBoard, item );
+        if( NETINFO_ITEM* net = dynamic_cast<NETINFO_ITEM*>( item ) )
+            m_data_model->deleteItem( m_data_model->findItem( net ) );
+        else
+            collectNets( item, netCodes );
     }
 
+    updateNets( netCodes );
+
     m_in_bulk_update = false;
 }
 
 
 void DIALOG_NET_INSPECTOR::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
 {
-    if( dynamic_cast<BOARD_CONNECTED_ITEM*>( aBoardItem ) != nullptr
-            || dynamic_cast<FOOTPRINT*>( aBoardItem ) != nullptr )
-    {
-        buildNetsList();
-        m_netsList->Refresh();
-    }
+    std::set<int> netCodes;
+
+    collectNets( aBoardItem, netCodes );
+    updateNets( netCodes );
 }
 
 
 void DIALOG_NET_INSPECTOR::OnBoardItemsChanged( BOARD& aBoard,
                                                 std::vector<BOARD_ITEM*>& aBoardItems )
 {
-    buildNetsList();
-    m_netsList->Refresh();
+    m_in_bulk_update = true;
+
+    std::set<int> netCodes;
+
+    for( BOARD_ITEM* item : aBoardItems )
+        collectNets( item, netCodes );
+
+    updateNets( netCodes );
+
+    m_in_bulk_update = false;
 }
 
 
@@ -1571,6 +1430,70 @@ void DIALOG_NET_INSPECTOR::OnBoardNetSettingsChanged( BOARD& aBoard )
 }
 
 
+void DIALOG_NET_INSPECTOR::collectNets( BOARD_ITEM* aItem, std::set<int>& aNetCodes ) const
+{
+    std::shared_ptr<NET_LENGTH_CACHE> cache = lengthCache();
+
+    auto collect =
+            [&]( const BOARD_CONNECTED_ITEM* aConnectedItem )
+            {
+                aNetCodes.insert( aConnectedItem->GetNetCode() );
+
+                // the item may have left the net it was counted in.
+                int countedNet = cache->GetCountedNet( aConnectedItem );
+
+                if( countedNet >= 0 )
+                    aNetCodes.insert( countedNet );
+            };
+
+    if( FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( aItem ) )
+    {
+        for( const PAD* pad : footprint->Pads() )
+            collect( pad );
+    }
+    else if( BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( aItem ) )
+    {
+        collect( item );
+    }
+}
+
+
+void DIALOG_NET_INSPECTOR::updateNets( const std::set<int>& aNetCodes )
+{
+    std::shared_ptr<NET_LENGTH_CACHE> cache = lengthCache();
+    std::set<int>                     netCodes = aNetCodes;
+
+    // the nets measured again by the other users of the cache are stale here too.
+    for( int netCode : cache->GetNetsUpdatedSince( m_lengthGeneration ) )
+        netCodes.insert( netCode );
+
+    if( netCodes.empty() )
+        return;
+
+    // only the nets whose copper changed are measured again, in parallel.
+    cache->Update( m_brd, std::vector<int>( netCodes.begin(), netCodes.end() ) );
+    m_lengthGeneration = cache->GetGeneration();
+
+    for( int netCode : netCodes )
+    {
+        if( NETINFO_ITEM* net = m_brd->FindNet( netCode ) )
+            updateNet( net );
+        else
+            m_data_model->deleteItem( m_data_model->findItem( netCode ) );
+    }
+}
+
+
+unsigned int DIALOG_NET_INSPECTOR::padCount( int aNetCode ) const
+{
+    // the length cache counts the pads of the nets it measures, but not the unconnected ones.
+    if( aNetCode > 0 )
+        return lengthCache()->GetNetLength( aNetCode ).m_padCount;
+
+    return m_brd->GetNodesCount( aNetCode );
+}
+
+
 void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
 {
     // something for the specified net has changed, update that row.
@@ -1587,7 +1510,7 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
 
     std::optional<LIST_ITEM_ITER> cur_net_row = m_data_model->findItem( aNet );
 
-    const unsigned int node_count = m_brd->GetNodesCount( aNet->GetNetCode() );
+    const unsigned int node_count = padCount( aNet->GetNetCode() );
 
     if( node_count == 0 && !m_cbShowZeroPad->IsChecked() )
     {
@@ -1595,8 +1518,7 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
         return;
     }
 
-    std::unique_ptr<LIST_ITEM> new_list_item = buildNewItem( aNet, node_count,
-                                                             relevantConnectivityItems() );
+    std::unique_ptr<LIST_ITEM> new_list_item = buildNewItem( aNet, node_count );
 
     if( !cur_net_row )
     {
@@ -1618,6 +1540,7 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
         // update fields only
         cur_list_item->SetPadCount( new_list_item->GetPadCount() );
         cur_list_item->SetViaCount( new_list_item->GetViaCount() );
+        cur_list_item->SetViaLength( new_list_item->GetViaLength() );
 
         for( size_t ii = 0; ii < MAX_CU_LAYERS; ++ii )
             cur_list_item->SetLayerWireLength( new_list_item->GetLayerWireLength( ii ), ii );
@@ -1629,92 +1552,25 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
 }
 
 
-unsigned int DIALOG_NET_INSPECTOR::calculateViaLength( const PCB_TRACK* aTrack ) const
+std::shared_ptr<NET_LENGTH_CACHE> DIALOG_NET_INSPECTOR::lengthCache() const
 {
-    const PCB_VIA* via = dynamic_cast<const PCB_VIA*>( aTrack );
-
-    if( !via )
-        return 0;
-
-    BOARD_DESIGN_SETTINGS& bds = m_brd->GetDesignSettings();
-
-    // Must be static to keep from raising its ugly head in performance profiles
-    static std::initializer_list<KICAD_T> traceAndPadTypes = { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T };
-
-    // calculate the via length individually from the board stackup and via's start and end layer.
-    if( bds.m_HasStackup )
-    {
-        PCB_LAYER_ID top_layer = UNDEFINED_LAYER;
-        PCB_LAYER_ID bottom_layer = UNDEFINED_LAYER;
-
-        for( int layer = via->TopLayer(); layer <= via->BottomLayer(); ++layer )
-        {
-            if( m_brd->GetConnectivity()->IsConnectedOnLayer( via, layer, traceAndPadTypes ) )
-            {
-                if( top_layer == UNDEFINED_LAYER )
-                    top_layer = PCB_LAYER_ID( layer );
-                else
-                    bottom_layer = PCB_LAYER_ID( layer );
-            }
-        }
-
-        if( top_layer == UNDEFINED_LAYER )
-            top_layer = via->TopLayer();
-        if( bottom_layer == UNDEFINED_LAYER )
-            bottom_layer = via->BottomLayer();
-
-        const BOARD_STACKUP& stackup = bds.GetStackupDescriptor();
-        return stackup.GetLayerDistance( top_layer, bottom_layer );
-    }
-    else
-    {
-        int dielectricLayers = bds.GetCopperLayerCount() - 1;
-        // FIXME: not all dielectric layers are the same thickness!
-        int layerThickness = bds.GetBoardThickness() / dielectricLayers;
-        int effectiveBottomLayer;
-
-        if( via->BottomLayer() == B_Cu )
-            effectiveBottomLayer = F_Cu + dielectricLayers;
-        else
-            effectiveBottomLayer = via->BottomLayer();
-
-        int layerCount = effectiveBottomLayer - via->TopLayer();
-
-        return layerCount * layerThickness;
-    }
+    return m_brd->GetConnectivity()->GetNetLengthCache();
 }
 
 
 std::unique_ptr<DIALOG_NET_INSPECTOR::LIST_ITEM>
-DIALOG_NET_INSPECTOR::buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount,
-                                    const std::vector<CN_ITEM*>& aCNItems )
+DIALOG_NET_INSPECTOR::buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount )
 {
-    std::unique_ptr<LIST_ITEM> new_item = std::make_unique<LIST_ITEM>( aNet );
+    std::unique_ptr<LIST_ITEM>   new_item = std::make_unique<LIST_ITEM>( aNet );
+    NET_LENGTH_CACHE::NET_LENGTH length = lengthCache()->GetNetLength( aNet->GetNetCode() );
 
     new_item->SetPadCount( aPadCount );
+    new_item->AddChipWireLength( length.m_padToDie );
+    new_item->AddViaCount( length.m_viaCount );
+    new_item->AddViaLength( length.m_via );
 
-    const auto cn_items = std::equal_range( aCNItems.begin(), aCNItems.end(), aNet->GetNetCode(),
-                                            NETCODE_CMP_LESS() );
-
-    for( auto i = cn_items.first; i != cn_items.second; ++i )
-    {
-        BOARD_CONNECTED_ITEM* item = ( *i )->Parent();
-
-        if( item->Type() == PCB_PAD_T )
-            new_item->AddChipWireLength( static_cast<PAD*>( item )->GetPadToDieLength() );
-
-        else if( PCB_TRACK* track = dynamic_cast<PCB_TRACK*>( item ) )
-        {
-            new_item->AddLayerWireLength( track->GetLength(),
-                                          static_cast<int>( track->GetLayer() ) );
-
-            if( item->Type() == PCB_VIA_T )
-            {
-                new_item->AddViaCount( 1 );
-                new_item->AddViaLength( calculateViaLength( track ) );
-            }
-        }
-    }
+    for( size_t layer = 0; layer < length.m_layerTrack.size(); ++layer )
+        new_item->AddLayerWireLength( KiROUND( length.m_layerTrack[layer] ), layer );
 
     return new_item;
 }
@@ -1779,8 +1635,6 @@ void DIALOG_NET_INSPECTOR::buildNetsList()
         }
     }
 
-    std::vector<CN_ITEM*> prefiltered_cn_items = relevantConnectivityItems();
-
 
     // collect all nets which pass the filter string and also remember the
     // suffix after the filter match, if any.
@@ -1791,22 +1645,6 @@ void DIALOG_NET_INSPECTOR::buildNetsList()
         unsigned int  pad_count;
     };
 
-    struct NET_INFO_CMP_LESS
-    {
-        bool operator()( const NET_INFO& a, const NET_INFO& b ) const
-        {
-            return a.netcode < b.netcode;
-        }
-        bool operator()( const NET_INFO& a, int b ) const
-        {
-            return a.netcode < b;
-        }
-        bool operator()( int a, const NET_INFO& b ) const
-        {
-            return a < b.netcode;
-        }
-    };
-
     std::vector<NET_INFO> nets;
     nets.reserve( m_brd->GetNetInfo().NetsByNetcode().size() );
 
@@ -1819,25 +1657,24 @@ void DIALOG_NET_INSPECTOR::buildNetsList()
             nets.emplace_back( NET_INFO{ ni.first, ni.second, 0 } );
     }
 
-    // count the pads for each net.  since the nets are sorted by netcode
-    // iterating over the footprints' pads is faster.
+    std::vector<int> netCodes;
+    netCodes.reserve( nets.size() );
 
-    for( FOOTPRINT* footprint : m_brd->Footprints() )
-    {
-        for( PAD* pad : footprint->Pads() )
-        {
-            auto i = std::lower_bound( nets.begin(), nets.end(), pad->GetNetCode(),
-                                       NET_INFO_CMP_LESS() );
+    for( NET_INFO& ni : nets )
+        netCodes.push_back( ni.netcode );
 
-            if( i != nets.end() && i->netcode == pad->GetNetCode() )
-                i->pad_count += 1;
-        }
-    }
+    // Measure the nets which changed since they were last shown, in parallel.  This also
+    // counts their pads.
+    lengthCache()->Update( m_brd, netCodes );
+    m_lengthGeneration = lengthCache()->GetGeneration();
+
+    for( NET_INFO& ni : nets )
+        ni.pad_count = padCount( ni.netcode );
 
     for( NET_INFO& ni : nets )
     {
         if( m_cbShowZeroPad->IsChecked() || ni.pad_count > 0 )
-            new_items.emplace_back( buildNewItem( ni.net, ni.pad_count, prefiltered_cn_items ) );
+            new_items.emplace_back( buildNewItem( ni.net, ni.pad_count ) );
     }
 
 
@@ -27,13 +27,14 @@
 
 #include <board.h>
 #include <optional>
+#include <set>
 #include <dialog_net_inspector_base.h>
 
 class PCB_EDIT_FRAME;
 class NETINFO_ITEM;
 class BOARD;
 class BOARD_ITEM;
-class CN_ITEM;
+class NET_LENGTH_CACHE;
 class EDA_PATTERN_MATCH;
 class PCB_TRACK;
 
@@ -75,10 +76,24 @@ private:
     wxString formatCount( unsigned int aValue ) const;
     wxString formatLength( int64_t aValue ) const;
 
-    std::vector<CN_ITEM*> relevantConnectivityItems() const;
     bool                  netFilterMatches( NETINFO_ITEM* aNet ) const;
     void                  updateNet( NETINFO_ITEM* aNet );
-    unsigned int          calculateViaLength( const PCB_TRACK* ) const;
+
+    /**
+     * Add the nets \a aItem is in, and the nets the length cache counted it in, to
+     * \a aNetCodes.
+     */
+    void collectNets( BOARD_ITEM* aItem, std::set<int>& aNetCodes ) const;
+
+    /**
+     * Bring the rows of \a aNetCodes, and of the nets measured again by the other users of the
+     * length cache, up to date.
+     */
+    void updateNets( const std::set<int>& aNetCodes );
+
+    unsigned int padCount( int aNetCode ) const;
+
+    std::shared_ptr<NET_LENGTH_CACHE> lengthCache() const;
 
     void onSelChanged( wxDataViewEvent& event ) override;
     void onSelChanged();
@@ -89,8 +104,7 @@ private:
     void onDeleteNet( wxCommandEvent& event ) override;
     void onReport( wxCommandEvent& event ) override;
 
-    std::unique_ptr<LIST_ITEM> buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount,
-                                             const std::vector<CN_ITEM*>& aCNItems );
+    std::unique_ptr<LIST_ITEM> buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount );
 
     void buildNetsList();
     void setColumnWidths();
@@ -115,6 +129,7 @@ private:
     bool            m_in_build_nets_list = false;
     bool            m_in_bulk_update = false;
     bool            m_filter_change_no_rebuild = false;
+    uint64_t        m_lengthGeneration = 0;
     wxSize          m_size;
 
     std::vector<COLUMN_DESC> m_columns;
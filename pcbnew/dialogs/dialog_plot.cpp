@@ -35,7 +35,6 @@
 #include <reporter.h>
 #include <wildcards_and_files_ext.h>
 #include <layer_ids.h>
-#include <locale_io.h>
 #include <bitmaps.h>
 #include <dialog_plot.h>
 #include <dialog_gendrill.h>
@@ -1173,6 +1172,8 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    std::vector<PLOT_LAYER_FILE> plotFiles;
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         LSEQ plotSequence;
@@ -1228,34 +1229,38 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
         wxString fullname = fn.GetFullName();
         jobfile_writer.AddGbrFile( layer, fullname );
 
-        LOCALE_IO toggle;
+        PLOT_LAYER_FILE plotFile;
+
+        plotFile.m_Layer = layer;
+        plotFile.m_PlotSequence = plotSequence;
+        plotFile.m_LayerName = layerName;
+        plotFile.m_FullFileName = fn.GetFullPath();
+        plotFile.m_SheetName = sheetName;
+        plotFile.m_SheetPath = sheetPath;
+        plotFiles.push_back( plotFile );
+    }
 
-        PLOTTER* plotter = StartPlotBoard( board, &m_plotOpts, layer, layerName, fn.GetFullPath(),
-                                           sheetName, sheetPath );
+    PlotLayerFiles( board, m_plotOpts, plotFiles );
 
-        // Print diags in messages box:
+    // Print diags in messages box:
+    for( const PLOT_LAYER_FILE& plotFile : plotFiles )
+    {
         wxString msg;
 
-        if( plotter )
+        if( plotFile.m_Plotted )
         {
-            PlotBoardLayers( board, plotter, plotSequence, m_plotOpts );
-            PlotInteractiveLayer( board, plotter, m_plotOpts );
-            plotter->EndPlot();
-            delete plotter->RenderSettings();
-            delete plotter;
-
-            msg.Printf( _( "Plotted to '%s'." ), fn.GetFullPath() );
+            msg.Printf( _( "Plotted to '%s'." ), plotFile.m_FullFileName );
             reporter.Report( msg, RPT_SEVERITY_ACTION );
         }
         else
         {
-            msg.Printf( _( "Failed to create file '%s'." ), fn.GetFullPath() );
+            msg.Printf( _( "Failed to create file '%s'." ), plotFile.m_FullFileName );
             reporter.Report( msg, RPT_SEVERITY_ERROR );
         }
-
-        wxSafeYield();      // displays report message.
     }
 
+    wxSafeYield();      // displays report messages.
+
     if( m_plotOpts.GetFormat() == PLOT_FORMAT::GERBER && m_plotOpts.GetCreateGerberJobFile() )
     {
         // Pick the basename from the board file
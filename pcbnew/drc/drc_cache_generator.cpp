@@ -21,6 +21,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <common.h>
 #include <board_design_settings.h>
 #include <footprint.h>
@@ -51,6 +52,9 @@ bool DRC_CACHE_GENERATOR::Run()
     if( m_drcEngine->QueryWorstConstraint( PHYSICAL_HOLE_CLEARANCE_CONSTRAINT, worstConstraint ) )
         largestPhysicalClearance = std::max( largestPhysicalClearance, worstConstraint.GetValue().Min() );
 
+    // The providers read the pad shapes from all the threads
+    m_board->PrebuildPadShapes();
+
     std::set<ZONE*> allZones;
 
     for( ZONE* zone : m_board->Zones() )
@@ -114,7 +118,7 @@ bool DRC_CACHE_GENERATOR::Run()
                 for( PCB_LAYER_ID layer : copperLayers.Seq() )
                 {
                     if( IsCopperLayer( layer ) )
-                        m_board->m_CopperItemRTreeCache->Insert( item, layer, largestClearance );
+                        m_board->m_CopperItemRTreeCache->BulkInsert( item, layer, largestClearance );
                 }
 
                 done.fetch_add( 1 );
@@ -143,6 +147,7 @@ bool DRC_CACHE_GENERATOR::Run()
                     m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>();
 
                 forEachGeometryItem( itemTypes, LSET::AllCuMask(), addToCopperTree );
+                m_board->m_CopperItemRTreeCache->Pack();
             } );
 
     std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
@@ -182,9 +187,11 @@ bool DRC_CACHE_GENERATOR::Run()
                    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
                    {
                        if( IsCopperLayer( layer ) )
-                           rtree->Insert( aZone, layer );
+                           rtree->BulkInsert( aZone, layer );
                    }
 
+                   rtree->Pack();
+
                    {
                        std::unique_lock<std::mutex> writeLock( m_board->m_CachesMutex );
                        m_board->m_CopperZoneRTreeCache[ aZone ] = std::move( rtree );
@@ -229,6 +236,23 @@ bool DRC_CACHE_GENERATOR::Run()
     connectivity->Build( m_board, m_drcEngine->GetProgressReporter() );
     connectivity->FillIsolatedIslandsMap( m_board->m_ZoneIsolatedIslandsMap, true );
 
+    // Whether pads and vias are flashed on a layer may depend on the connectivity, so the
+    // shapes are cached once it's rebuilt
+    if( ADVANCED_CFG::GetCfg().m_CacheDRCShapes && !m_drcEngine->IsCancelled() )
+    {
+        std::vector<BOARD_ITEM*> shapeItems;
+
+        forEachGeometryItem( { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, PCB_PAD_T, PCB_SHAPE_T },
+                             LSET::AllCuMask(),
+                             [&]( BOARD_ITEM* item ) -> bool
+                             {
+                                 shapeItems.push_back( item );
+                                 return true;
+                             } );
+
+        m_drcEngine->GetShapeCache().Build( shapeItems, boardCopperLayers );
+    }
+
     return !m_drcEngine->IsCancelled();
 }
 
@@ -24,6 +24,9 @@
  */
 
 #include <atomic>
+#include <chrono>
+#include <future>
+#include <advanced_config.h>
 #include <reporter.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
@@ -39,7 +42,10 @@
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_track.h>
+#include <core/kicad_algo.h>
+#include <core/profile.h>
 #include <core/thread_pool.h>
+#include <perf_trace.h>
 #include <zone.h>
 
 
@@ -73,7 +79,10 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
     m_reportAllTrackErrors( false ),
     m_testFootprints( false ),
     m_reporter( nullptr ),
-    m_progressReporter( nullptr )
+    m_progressReporter( nullptr ),
+    m_memoizeConstraints( false ),
+    m_profiling( false ),
+    m_incremental( false )
 {
     m_errorLimits.resize( DRCE_LAST + 1 );
 
@@ -514,6 +523,31 @@ void DRC_ENGINE::compileRules()
             m_constraintMap[ constraint.m_Type ]->push_back( engineConstraint );
         }
     }
+
+    // Resolutions can be shared between item pairs when every condition of a constraint type
+    // reads only nets, net classes and types.  Disallow constraints also depend on the items'
+    // layers and flags, and assertions are tested for each item.
+    m_memoizableConstraints.clear();
+
+    for( const auto& [ constraintType, ruleset ] : m_constraintMap )
+    {
+        if( constraintType == DISALLOW_CONSTRAINT || constraintType == ASSERTION_CONSTRAINT )
+            continue;
+
+        bool memoizable = true;
+
+        for( const DRC_ENGINE_CONSTRAINT* c : *ruleset )
+        {
+            if( c->condition && !c->condition->ReadsNetAndTypeOnly() )
+            {
+                memoizable = false;
+                break;
+            }
+        }
+
+        if( memoizable )
+            m_memoizableConstraints.insert( constraintType );
+    }
 }
 
 
@@ -572,10 +606,13 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
 
 void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aTestFootprints )
 {
+    SCOPED_TRACE_ZONE traceZone( "DRC" );
+
     SetUserUnits( aUnits );
 
     m_reportAllTrackErrors = aReportAllTrackErrors;
     m_testFootprints = aTestFootprints;
+    m_runThread = std::this_thread::get_id();
 
     for( int ii = DRCE_FIRST; ii < DRCE_LAST; ++ii )
     {
@@ -590,29 +627,251 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
     DRC_TEST_PROVIDER::Init();
 
     m_board->IncrementTimeStamp();      // Invalidate all caches...
+    m_shapeCache.Clear();
 
     DRC_CACHE_GENERATOR cacheGenerator;
     cacheGenerator.SetDRCEngine( this );
 
     if( !cacheGenerator.Run() )         // ... and regenerate them.
+    {
+        m_shapeCache.Clear();
+        m_runThread = std::thread::id();
         return;
+    }
 
     int timestamp = m_board->GetTimeStamp();
 
+    // Nets and net classes don't change while the providers run
+    m_constraintCache.clear();
+    m_memoizeConstraints = ADVANCED_CFG::GetCfg().m_MemoizeDRCConstraints;
+
+    // The single-threaded providers which don't depend on the others run concurrently on the
+    // thread pool, while the others run here one after another (and use the rest of the pool).
+    std::vector<DRC_TEST_PROVIDER*> concurrentProviders;
+    std::vector<std::future<bool>>  concurrentResults;
+    thread_pool&                    tp = GetKiCadThreadPool();
+
+    if( ADVANCED_CFG::GetCfg().m_ConcurrentDRCProviders && !m_profiling )
+    {
+        for( DRC_TEST_PROVIDER* provider : m_testProviders )
+        {
+            if( !provider->RunsConcurrently() )
+                continue;
+
+            ReportAux( wxString::Format( wxT( "Run DRC provider concurrently: '%s'" ),
+                                         provider->GetName() ) );
+
+            provider->SetDeferViolations( true );
+            concurrentProviders.push_back( provider );
+            concurrentResults.push_back( tp.submit(
+                    [provider, aUnits]() -> bool
+                    {
+                        SCOPED_TRACE_ZONE providerZone( "DRC provider", provider->GetName() );
+
+                        return provider->RunTests( aUnits );
+                    } ) );
+        }
+    }
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
+        if( alg::contains( concurrentProviders, provider ) )
+            continue;
+
         ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
 
-        if( !provider->RunTests( aUnits ) )
+        DRC_PROFILE_COUNTERS& profile = provider->Profile();
+        PROF_TIMER            timer;
+        bool                  ok;
+
+        profile.Reset();
+
+        if( m_profiling )
+            DRC_PROFILE_COUNTERS::SetActive( &profile );
+
+        {
+            SCOPED_TRACE_ZONE providerZone( "DRC provider", provider->GetName() );
+            ok = provider->RunTests( aUnits );
+        }
+
+        DRC_PROFILE_COUNTERS::SetActive( nullptr );
+        profile.m_wallTime = timer.SinceStart<std::chrono::microseconds>().count();
+
+        if( !ok )
             break;
     }
 
+    for( std::future<bool>& result : concurrentResults )
+    {
+        while( result.wait_for( std::chrono::milliseconds( 250 ) ) != std::future_status::ready )
+            KeepRefreshing();
+
+        result.get();
+    }
+
+    flushPendingPhases();
+
+    // Report in provider order, whichever finished first
+    for( DRC_TEST_PROVIDER* provider : concurrentProviders )
+    {
+        provider->SetDeferViolations( false );
+        provider->FlushViolations();
+    }
+
+    m_memoizeConstraints = false;
+    m_constraintCache.clear();
+    m_shapeCache.Clear();
+    m_runThread = std::thread::id();
+
     // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
     // caches while DRC is running is problematic.
     wxASSERT( timestamp == m_board->GetTimeStamp() );
 }
 
 
+void DRC_ENGINE::SetIncrementalAreas( const std::vector<BOX2I>& aChangedAreas )
+{
+    ClearIncrementalAreas();
+    m_incremental = true;
+
+    // An item further than the worst clearance from every change can't have gained or lost a
+    // violation with a changed item.
+    DRC_CONSTRAINT worstConstraint;
+    int            margin = m_board->GetMaxClearanceValue();
+
+    for( DRC_CONSTRAINT_T constraintType : { HOLE_CLEARANCE_CONSTRAINT,
+                                             EDGE_CLEARANCE_CONSTRAINT,
+                                             PHYSICAL_CLEARANCE_CONSTRAINT,
+                                             PHYSICAL_HOLE_CLEARANCE_CONSTRAINT,
+                                             HOLE_TO_HOLE_CONSTRAINT,
+                                             COURTYARD_CLEARANCE_CONSTRAINT,
+                                             SILK_CLEARANCE_CONSTRAINT } )
+    {
+        if( QueryWorstConstraint( constraintType, worstConstraint ) )
+            margin = std::max( margin, worstConstraint.GetValue().Min() );
+    }
+
+    // The items near a change are re-tested against all their neighbours, so the neighbours
+    // (up to one more clearance away) must be tested too.
+    std::vector<BOX2I> scopeAreas;
+
+    for( const BOX2I& area : aChangedAreas )
+    {
+        m_incrementalAreas.push_back( BOX2I( area ).Inflate( margin ) );
+        scopeAreas.push_back( BOX2I( area ).Inflate( 2 * margin ) );
+    }
+
+    auto intersects =
+            []( const std::vector<BOX2I>& aAreas, const BOX2I& aBBox )
+            {
+                for( const BOX2I& area : aAreas )
+                {
+                    if( area.Intersects( aBBox ) )
+                        return true;
+                }
+
+                return false;
+            };
+
+    auto visit =
+            [&]( BOARD_ITEM* aItem )
+            {
+                BOX2I bbox = aItem->GetBoundingBox();
+
+                m_boardItems.insert( aItem->m_Uuid );
+
+                if( !intersects( scopeAreas, bbox ) )
+                    return;
+
+                m_incrementalScope.insert( aItem );
+
+                // Zones are too large to tell whether one of their violations is near a change;
+                // IsIncrementalViolation() falls back to the violation's position for them.
+                if( aItem->Type() != PCB_ZONE_T && intersects( m_incrementalAreas, bbox ) )
+                    m_incrementalItems.insert( aItem->m_Uuid );
+            };
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+        visit( track );
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        visit( item );
+
+    for( ZONE* zone : m_board->Zones() )
+        visit( zone );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        visit( footprint );
+        footprint->RunOnChildren( visit );
+    }
+}
+
+
+void DRC_ENGINE::ClearIncrementalAreas()
+{
+    m_incremental = false;
+    m_incrementalAreas.clear();
+    m_incrementalScope.clear();
+    m_incrementalItems.clear();
+    m_boardItems.clear();
+}
+
+
+bool DRC_ENGINE::IsInIncrementalScope( const BOARD_ITEM* aItem ) const
+{
+    return !m_incremental || m_incrementalScope.count( aItem );
+}
+
+
+bool DRC_ENGINE::IsIncrementalViolation( const RC_ITEM* aItem, const VECTOR2I& aPos ) const
+{
+    if( !m_incremental )
+        return true;
+
+    switch( aItem->GetErrorCode() )
+    {
+    // Net-wide, board-wide and schematic parity violations can be affected by any change, and
+    // are always reported in full.
+    case DRCE_UNCONNECTED_ITEMS:
+    case DRCE_INVALID_OUTLINE:
+    case DRCE_MISSING_FOOTPRINT:
+    case DRCE_DUPLICATE_FOOTPRINT:
+    case DRCE_EXTRA_FOOTPRINT:
+    case DRCE_NET_CONFLICT:
+    case DRCE_SCHEMATIC_PARITY_ISSUES:
+    case DRCE_LIB_FOOTPRINT_ISSUES:
+    case DRCE_LIB_FOOTPRINT_MISMATCH:
+    case DRCE_LENGTH_OUT_OF_RANGE:
+    case DRCE_SKEW_OUT_OF_RANGE:
+    case DRCE_VIA_COUNT_OUT_OF_RANGE:
+    case DRCE_DIFF_PAIR_UNCOUPLED_LENGTH_TOO_LONG:
+        return true;
+
+    default:
+        break;
+    }
+
+    for( const KIID& id : aItem->GetIDs() )
+    {
+        if( id == niluuid )
+            continue;
+
+        // Violations of deleted (or non-board) items are stale
+        if( m_incrementalItems.count( id ) || !m_boardItems.count( id ) )
+            return true;
+    }
+
+    for( const BOX2I& area : m_incrementalAreas )
+    {
+        if( area.Contains( aPos ) )
+            return true;
+    }
+
+    return false;
+}
+
+
 #define REPORT( s ) { if( aReporter ) { aReporter->Report( s ); } }
 
 DRC_CONSTRAINT DRC_ENGINE::EvalZoneConnection( const BOARD_ITEM* a, const BOARD_ITEM* b,
@@ -672,6 +931,37 @@ bool hasDrilledHole( const BOARD_ITEM* aItem )
 }
 
 
+/**
+ * Pack everything a net-and-type-only rule resolution can depend on for an item.
+ */
+static uint64_t constraintSignature( const BOARD_ITEM* aItem, bool aNonCopper, bool aWithHole )
+{
+    if( !aItem )
+        return 0;
+
+    uint64_t signature = (uint64_t) aItem->Type() + 1;
+
+    if( aItem->Type() == PCB_VIA_T )
+        signature |= (uint64_t) static_cast<const PCB_VIA*>( aItem )->GetViaType() << 16;
+
+    if( aNonCopper )
+        signature |= 1ULL << 24;
+
+    if( aWithHole && hasDrilledHole( aItem ) )
+        signature |= 1ULL << 25;
+
+    if( aItem->IsConnected() )
+    {
+        int netCode = static_cast<const BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode();
+
+        signature |= 1ULL << 26;
+        signature |= (uint64_t) (uint32_t) netCode << 32;
+    }
+
+    return signature;
+}
+
+
 DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
                                       const BOARD_ITEM* b, PCB_LAYER_ID aLayer,
                                       REPORTER* aReporter )
@@ -681,6 +971,8 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
      * kills performance when running bulk DRC tests (where aReporter is nullptr).
      */
 
+    DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_ruleEvaluations );
+
     const BOARD_CONNECTED_ITEM* ac = a && a->IsConnected() ?
                                          static_cast<const BOARD_CONNECTED_ITEM*>( a ) : nullptr;
     const BOARD_CONNECTED_ITEM* bc = b && b->IsConnected() ?
@@ -1288,8 +1580,42 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
     {
         std::vector<DRC_ENGINE_CONSTRAINT*>* ruleset = m_constraintMap[ aConstraintType ];
 
-        for( int ii = 0; ii < (int) ruleset->size(); ++ii )
-            processConstraint( ruleset->at( ii ) );
+        // The resolution from the rules depends only on the signature of the items when no
+        // condition reads anything else (and we're not reporting how it was reached)
+        bool                     memoize = m_memoizeConstraints && !aReporter
+                                               && m_memoizableConstraints.count( aConstraintType );
+        DRC_CONSTRAINT_SIGNATURE signature = {};
+        bool                     cached = false;
+
+        if( memoize )
+        {
+            bool withHoles = aConstraintType == HOLE_TO_HOLE_CONSTRAINT;
+
+            signature = { aConstraintType, aLayer,
+                          constraintSignature( a, a_is_non_copper, withHoles ),
+                          constraintSignature( b, b_is_non_copper, withHoles ) };
+
+            std::shared_lock<std::shared_mutex> readLock( m_constraintCacheMutex );
+            auto                                it = m_constraintCache.find( signature );
+
+            if( it != m_constraintCache.end() )
+            {
+                constraint = it->second;
+                cached = true;
+            }
+        }
+
+        if( !cached )
+        {
+            for( int ii = 0; ii < (int) ruleset->size(); ++ii )
+                processConstraint( ruleset->at( ii ) );
+
+            if( memoize )
+            {
+                std::unique_lock<std::shared_mutex> writeLock( m_constraintCacheMutex );
+                m_constraintCache.emplace( signature, constraint );
+            }
+        }
     }
 
     if( constraint.GetParentRule() && !constraint.GetParentRule()->m_Implicit )
@@ -1576,15 +1902,16 @@ bool DRC_ENGINE::IsErrorLimitExceeded( int error_code )
 void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
                                   int aMarkerLayer )
 {
-    static std::mutex globalLock;
+    // Violations away from the changes are still flagged by the markers of the previous run
+    if( m_incremental && !IsIncrementalViolation( aItem.get(), aPos ) )
+        return;
+
+    std::lock_guard<std::mutex> guard( m_reportMutex );
 
     m_errorLimits[ aItem->GetErrorCode() ] -= 1;
 
     if( m_violationHandler )
-    {
-        std::lock_guard<std::mutex> guard( globalLock );
         m_violationHandler( aItem, aPos, aMarkerLayer );
-    }
 
     if( m_reporter )
     {
@@ -1614,15 +1941,37 @@ void DRC_ENGINE::ReportAux ( const wxString& aStr )
     if( !m_reporter )
         return;
 
+    std::lock_guard<std::mutex> guard( m_reportMutex );
     m_reporter->Report( aStr, RPT_SEVERITY_INFO );
 }
 
 
+void DRC_ENGINE::flushPendingPhases()
+{
+    std::vector<wxString> phases;
+
+    if( !m_progressReporter )
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard( m_pendingPhasesMutex );
+        phases.swap( m_pendingPhases );
+    }
+
+    for( const wxString& phase : phases )
+        m_progressReporter->AdvancePhase( phase );
+}
+
+
 bool DRC_ENGINE::KeepRefreshing( bool aWait )
 {
     if( !m_progressReporter )
         return true;
 
+    if( !isRunThread() )
+        return !IsCancelled();
+
+    flushPendingPhases();
     return m_progressReporter->KeepRefreshing( aWait );
 }
 
@@ -1646,6 +1995,11 @@ bool DRC_ENGINE::ReportProgress( double aProgress )
     if( !m_progressReporter )
         return true;
 
+    // The progress bar follows the provider running on the main thread
+    if( !isRunThread() )
+        return !IsCancelled();
+
+    flushPendingPhases();
     m_progressReporter->SetCurrentProgress( aProgress );
     return m_progressReporter->KeepRefreshing( false );
 }
@@ -1656,6 +2010,14 @@ bool DRC_ENGINE::ReportPhase( const wxString& aMessage )
     if( !m_progressReporter )
         return true;
 
+    if( !isRunThread() )
+    {
+        std::lock_guard<std::mutex> guard( m_pendingPhasesMutex );
+        m_pendingPhases.push_back( aMessage );
+        return !IsCancelled();
+    }
+
+    flushPendingPhases();
     m_progressReporter->AdvancePhase( aMessage );
     return m_progressReporter->KeepRefreshing( false );
 }
@@ -25,13 +25,22 @@
 #define DRC_ENGINE_H
 
 #include <memory>
+#include <mutex>
 #include <vector>
+#include <set>
+#include <shared_mutex>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
+#include <hash.h>
 #include <units_provider.h>
+#include <kiid.h>
+#include <math/box2.h>
 #include <geometry/shape.h>
 
 #include <drc/drc_rule.h>
+#include <drc/drc_shape_cache.h>
 
 
 class BOARD_DESIGN_SETTINGS;
@@ -41,6 +50,7 @@ class DS_PROXY_VIEW_ITEM;
 class BOARD_ITEM;
 class BOARD;
 class PCB_MARKER;
+class RC_ITEM;
 class NETCLASS;
 class NETLIST;
 class NETINFO_ITEM;
@@ -64,6 +74,40 @@ class DRC_RULE;
 class DRC_CONSTRAINT;
 
 
+/**
+ * What the rule conditions of a constraint type can depend on when they read only nets, net
+ * classes and item types: see DRC_RULE_CONDITION::ReadsNetAndTypeOnly().
+ */
+struct DRC_CONSTRAINT_SIGNATURE
+{
+    int      m_constraintType;
+    int      m_layer;
+    uint64_t m_itemA;
+    uint64_t m_itemB;
+
+    bool operator==( const DRC_CONSTRAINT_SIGNATURE& aOther ) const
+    {
+        return m_constraintType == aOther.m_constraintType && m_layer == aOther.m_layer
+                && m_itemA == aOther.m_itemA && m_itemB == aOther.m_itemB;
+    }
+};
+
+
+namespace std
+{
+    template <>
+    struct hash<DRC_CONSTRAINT_SIGNATURE>
+    {
+        std::size_t operator()( const DRC_CONSTRAINT_SIGNATURE& k ) const
+        {
+            std::size_t seed = 0xd5a1c0de;
+            hash_combine( seed, k.m_constraintType, k.m_layer, k.m_itemA, k.m_itemB );
+            return seed;
+        }
+    };
+}
+
+
 typedef std::function<void( const std::shared_ptr<DRC_ITEM>& aItem,
                             const VECTOR2I& aPos,
                             int aLayer )> DRC_VIOLATION_HANDLER;
@@ -144,6 +188,47 @@ public:
      */
     void RunTests( EDA_UNITS aUnits,  bool aReportAllTrackErrors, bool aTestFootprints );
 
+    /**
+     * Time each test provider and count its work (see DRC_TEST_PROVIDER::Profile()).  The
+     * providers are then run one after another so that the counters can be told apart.
+     */
+    void SetProfiling( bool aProfiling ) { m_profiling = aProfiling; }
+    bool IsProfiling() const { return m_profiling; }
+
+    /**
+     * The effective shapes of the copper items, shared by the test providers during a run.
+     */
+    const DRC_SHAPE_CACHE& GetShapeCache() const { return m_shapeCache; }
+    DRC_SHAPE_CACHE& GetShapeCache() { return m_shapeCache; }
+
+    /**
+     * Restrict the following runs to the neighbourhood of \a aChangedAreas (typically the
+     * bounding boxes, old and new, of the items changed since the previous run).  Only the
+     * violations near a change are then reported: the caller keeps its markers for the others.
+     *
+     * Must be called again whenever the board changes.
+     */
+    void SetIncrementalAreas( const std::vector<BOX2I>& aChangedAreas );
+
+    /**
+     * Restore full runs.
+     */
+    void ClearIncrementalAreas();
+
+    bool IsIncremental() const { return m_incremental; }
+
+    /**
+     * @return true if \a aItem must be tested by an incremental run: either it is near a
+     *         change, or it could be in violation with an item which is.
+     */
+    bool IsInIncrementalScope( const BOARD_ITEM* aItem ) const;
+
+    /**
+     * @return true if a violation belongs to the current incremental run, ie: it is either
+     *         reported by this run (if it still exists) or its marker is stale.
+     */
+    bool IsIncrementalViolation( const RC_ITEM* aItem, const VECTOR2I& aPos ) const;
+
     bool IsErrorLimitExceeded( int error_code );
 
     DRC_CONSTRAINT EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
@@ -159,6 +244,16 @@ public:
 
     bool HasRulesForConstraintType( DRC_CONSTRAINT_T constraintID );
 
+    /**
+     * @return true if every rule condition of \a aConstraintType reads only nets, net classes
+     *         and item types, so that its resolution can be shared between item pairs which
+     *         agree on those (and have no local overrides).
+     */
+    bool IsMemoizable( DRC_CONSTRAINT_T aConstraintType ) const
+    {
+        return m_memoizableConstraints.count( aConstraintType ) > 0;
+    }
+
     bool GetReportAllTrackErrors() const { return m_reportAllTrackErrors; }
     bool GetTestFootprints() const { return m_testFootprints; }
 
@@ -227,6 +322,17 @@ private:
     void loadImplicitRules();
     std::shared_ptr<DRC_RULE> createImplicitRule( const wxString& name );
 
+    /**
+     * Progress can only be shown from the thread running the tests; the phases reported by
+     * providers running concurrently are queued until then.
+     */
+    bool isRunThread() const
+    {
+        return m_runThread == std::thread::id() || std::this_thread::get_id() == m_runThread;
+    }
+
+    void flushPendingPhases();
+
 protected:
     BOARD_DESIGN_SETTINGS*     m_designSettings;
     BOARD*                     m_board;
@@ -247,8 +353,30 @@ protected:
     DRC_VIOLATION_HANDLER      m_violationHandler;
     REPORTER*                  m_reporter;
     PROGRESS_REPORTER*         m_progressReporter;
+    std::mutex                 m_reportMutex;
+
+    std::thread::id            m_runThread;
+    std::vector<wxString>      m_pendingPhases;
+    std::mutex                 m_pendingPhasesMutex;
 
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
+
+    // Rule resolutions shared by item pairs with the same signature, during a DRC run.  Only
+    // used for the constraint types whose rule conditions allow it.
+    bool                                                         m_memoizeConstraints;
+    std::set<DRC_CONSTRAINT_T>                                   m_memoizableConstraints;
+    std::unordered_map<DRC_CONSTRAINT_SIGNATURE, DRC_CONSTRAINT> m_constraintCache;
+    std::shared_mutex                                            m_constraintCacheMutex;
+
+    bool                                  m_profiling;
+
+    DRC_SHAPE_CACHE                       m_shapeCache;
+
+    bool                                  m_incremental;
+    std::vector<BOX2I>                    m_incrementalAreas;
+    std::unordered_set<const BOARD_ITEM*> m_incrementalScope;  // items to test
+    std::set<KIID>                        m_incrementalItems;  // items near a change
+    std::set<KIID>                        m_boardItems;
 };
 
 #endif // DRC_H
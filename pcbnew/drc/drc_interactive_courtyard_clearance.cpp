@@ -30,185 +30,211 @@
 #include <geometry/shape_segment.h>
 #include <footprint.h>
 
-void DRC_INTERACTIVE_COURTYARD_CLEARANCE::testCourtyardClearances()
+bool DRC_INTERACTIVE_COURTYARD_CLEARANCE::testFootprints( const STATIC_FOOTPRINT& aStatic,
+                                                          FOOTPRINT* aMoved,
+                                                          const BOX2I& aMovedBBox )
 {
-    std::vector<BOX2I> fpBBBoxes( m_FpInMove.size() );
-    BOX2I              movingBBox;
-
-    for( size_t i = 0; i < m_FpInMove.size(); i++ )
+    FOOTPRINT*            fpA = aStatic.m_footprint;
+    const SHAPE_POLY_SET& frontA = *aStatic.m_front;
+    const SHAPE_POLY_SET& backA = *aStatic.m_back;
+    const BOX2I&          fpABBox = aStatic.m_bbox;
+    const BOX2I&          frontABBox = aStatic.m_frontBBox;
+    const BOX2I&          backABBox = aStatic.m_backBBox;
+
+    FOOTPRINT*            fpB = aMoved;
+    const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
+    const BOX2I&          fpBBBox = aMovedBBox;
+    const BOX2I           frontBBBox = frontB.BBoxFromCaches();
+    const BOX2I           backBBBox = backB.BBoxFromCaches();
+
+    int      clearance;
+    int      actual;
+    VECTOR2I pos;
+
+    if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
+            && frontABBox.Intersects( frontBBBox ) )
     {
-        FOOTPRINT* fpB = m_FpInMove[i];
+        // Currently, do not use DRC engine for calculation time reasons
+        // DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
+        // constraint.GetValue().Min();
+        clearance = 0;
 
-        BOX2I bbox = fpB->GetBoundingBox( true, false );
-        movingBBox.Merge( bbox );
-        fpBBBoxes[i] = bbox;
+        if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
+            return true;
     }
 
-    movingBBox.Inflate( m_largestCourtyardClearance );
-
-    for( FOOTPRINT* fpA: m_board->Footprints() )
+    if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
+            && backABBox.Intersects( backBBBox ) )
     {
-        if( fpA->IsSelected() )
-            continue;
+        // Currently, do not use DRC engine for calculation time reasons
+        // DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
+        // constraint.GetValue().Min();
+        clearance = 0;
 
-        BOX2I fpABBox = fpA->GetBoundingBox( true, false );
+        if( backA.Collide( &backB, clearance, &actual, &pos ) )
+            return true;
+    }
 
-        if( !movingBBox.Intersects( fpABBox ) )
-            continue;
+    // Now test if a pad hole of some other footprint is inside the courtyard area
+    // of the moved footprint
+    auto testPadAgainstCourtyards =
+            [&]( const PAD* pad, FOOTPRINT* footprint ) -> bool
+            {
+                if( pad->HasHole() )
+                {
+                    std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
+                    const SHAPE_POLY_SET& front = footprint->GetCachedCourtyard( F_CrtYd );
+                    const SHAPE_POLY_SET& back = footprint->GetCachedCourtyard( B_CrtYd );
+
+                    if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
+                        return true;
+                    else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
+                        return true;
+                }
 
-        const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
-        const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
+                return false;
+            };
 
-        if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0 )
-             // No courtyards defined and no hole testing against other footprint's courtyards
-            continue;
+    if( ( frontA.OutlineCount() > 0 && frontABBox.Intersects( fpBBBox ) )
+        || ( backA.OutlineCount() > 0 && backABBox.Intersects( fpBBBox ) ) )
+    {
+        for( const PAD* padB : fpB->Pads() )
+        {
+            if( testPadAgainstCourtyards( padB, fpA ) )
+                return true;
+        }
+    }
 
-        BOX2I frontABBox = frontA.BBoxFromCaches();
-        BOX2I backABBox = backA.BBoxFromCaches();
+    if( ( frontB.OutlineCount() > 0 && frontBBBox.Intersects( fpABBox ) )
+        || ( backB.OutlineCount() > 0 && backBBBox.Intersects( fpABBox ) ) )
+    {
+        for( const PAD* padA : fpA->Pads() )
+        {
+            if( testPadAgainstCourtyards( padA, fpB ) )
+                return true;
+        }
+    }
 
-        frontABBox.Inflate( m_largestCourtyardClearance );
-        backABBox.Inflate( m_largestCourtyardClearance );
+    return false;
+}
 
-        for( size_t inMoveId = 0; inMoveId < m_FpInMove.size(); inMoveId++ )
-        {
-            FOOTPRINT*            fpB = m_FpInMove[inMoveId];
-            const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
-            const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
 
-            const BOX2I fpBBBox = fpBBBoxes[inMoveId];
-            const BOX2I frontBBBox = frontB.BBoxFromCaches();
-            const BOX2I backBBBox = backB.BBoxFromCaches();
+void DRC_INTERACTIVE_COURTYARD_CLEARANCE::testMovedFootprint( FOOTPRINT* aFootprint,
+                                                              const BOX2I& aBBox,
+                                                              std::vector<BOARD_ITEM*>& aConflicts )
+{
+    const SHAPE_POLY_SET& front = aFootprint->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET& back = aFootprint->GetCourtyard( B_CrtYd );
 
-            int      clearance;
-            int      actual;
-            VECTOR2I pos;
+    BOX2I searchBox = aBBox;
 
-            if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
-                    && frontABBox.Intersects( frontBBBox ) )
-            {
-                // Currently, do not use DRC engine for calculation time reasons
-                // DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
-                // constraint.GetValue().Min();
-                clearance = 0;
+    if( front.OutlineCount() > 0 )
+        searchBox.Merge( front.BBoxFromCaches() );
 
-                if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
-                {
-                    m_itemsInConflict.insert( fpA );
-                    m_itemsInConflict.insert( fpB );
-                 }
-            }
+    if( back.OutlineCount() > 0 )
+        searchBox.Merge( back.BBoxFromCaches() );
+
+    int min[2] = { searchBox.GetX(), searchBox.GetY() };
+    int max[2] = { searchBox.GetRight(), searchBox.GetBottom() };
 
-            if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
-                    && backABBox.Intersects( backBBBox ) )
+    auto visitor =
+            [&]( size_t aIndex ) -> bool
             {
-                // Currently, do not use DRC engine for calculation time reasons
-                // DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
-                // constraint.GetValue().Min();
-                clearance = 0;
+                const STATIC_FOOTPRINT& candidate = m_staticFootprints[aIndex];
 
-                if( backA.Collide( &backB, clearance, &actual, &pos ) )
-                {
-                    m_itemsInConflict.insert( fpA );
-                    m_itemsInConflict.insert( fpB );
-                }
-            }
+                if( testFootprints( candidate, aFootprint, aBBox ) )
+                    aConflicts.push_back( candidate.m_footprint );
 
-            // Now test if a pad hole of some other footprint is inside the courtyard area
-            // of the moved footprint
-            auto testPadAgainstCourtyards =
-                    [&]( const PAD* pad, FOOTPRINT* footprint ) -> bool
-                    {
-                        if( pad->HasHole() )
-                        {
-                            std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
-                            const SHAPE_POLY_SET& front = footprint->GetCachedCourtyard( F_CrtYd );
-                            const SHAPE_POLY_SET& back = footprint->GetCachedCourtyard( B_CrtYd );
-
-                            if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
-                                return true;
-                            else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
-                                return true;
-                        }
-
-                        return false;
-                    };
-
-            bool skipNextCmp = false;
-
-            if( ( frontA.OutlineCount() > 0 && frontABBox.Intersects( fpBBBox ) )
-                || ( backA.OutlineCount() > 0 && backABBox.Intersects( fpBBBox ) ) )
-            {
-                for( const PAD* padB : fpB->Pads() )
-                {
-                    if( testPadAgainstCourtyards( padB, fpA ) )
-                    {
-                        m_itemsInConflict.insert( fpA );
-                        m_itemsInConflict.insert( fpB );
-                        skipNextCmp = true;
-                        break;
-                    }
-                }
-            }
+                return true;
+            };
 
-            if( skipNextCmp )
-                continue;       // fpA and fpB are already in list
+    m_staticIndex.Search( min, max, visitor );
 
-            if( ( frontB.OutlineCount() > 0 && frontBBBox.Intersects( fpABBox ) )
-                || ( backB.OutlineCount() > 0 && backBBBox.Intersects( fpABBox ) ) )
-            {
-                for( const PAD* padA : fpA->Pads() )
-                {
-                    if( testPadAgainstCourtyards( padA, fpB ) )
-                    {
-                        m_itemsInConflict.insert( fpA );
-                        m_itemsInConflict.insert( fpB );
-                        break;
-                    }
-                }
-            }
+    for( const KEEPOUT& keepout : m_keepouts )
+    {
+        if( keepout.m_front && front.OutlineCount() > 0
+                && keepout.m_bbox.Intersects( front.BBoxFromCaches() )
+                && keepout.m_zone->Outline()->Collide( &front.Outline( 0 ) ) )
+        {
+            aConflicts.push_back( keepout.m_zone );
+        }
+        else if( keepout.m_back && back.OutlineCount() > 0
+                && keepout.m_bbox.Intersects( back.BBoxFromCaches() )
+                && keepout.m_zone->Outline()->Collide( &back.Outline( 0 ) ) )
+        {
+            aConflicts.push_back( keepout.m_zone );
         }
     }
+}
 
-    for( ZONE* zone : m_board->Zones() )
+
+void DRC_INTERACTIVE_COURTYARD_CLEARANCE::buildIndex()
+{
+    m_indexBuilt = true;
+    m_largestCourtyardClearance = 0;
+    m_staticFootprints.clear();
+    m_staticIndex.Clear();
+    m_keepouts.clear();
+
+    DRC_CONSTRAINT constraint;
+
+    if( m_drcEngine->QueryWorstConstraint( COURTYARD_CLEARANCE_CONSTRAINT, constraint ) )
+        m_largestCourtyardClearance = constraint.GetValue().Min();
+
+    std::set<FOOTPRINT*> moving( m_FpInMove.begin(), m_FpInMove.end() );
+
+    for( FOOTPRINT* fp : m_board->Footprints() )
     {
-        if( !zone->GetIsRuleArea() || !zone->GetDoNotAllowFootprints() )
+        if( fp->IsSelected() || moving.count( fp ) )
             continue;
 
-        bool disallowFront = ( zone->GetLayerSet() & LSET::FrontMask() ).any();
-        bool disallowBack = ( zone->GetLayerSet() & LSET::BackMask() ).any();
+        STATIC_FOOTPRINT entry;
+        entry.m_footprint = fp;
+        entry.m_front = &fp->GetCourtyard( F_CrtYd );
+        entry.m_back = &fp->GetCourtyard( B_CrtYd );
 
-        for( FOOTPRINT* fp : m_FpInMove )
-        {
-            if( disallowFront )
-            {
-                const SHAPE_POLY_SET& frontCourtyard = fp->GetCourtyard( F_CrtYd );
+        if( entry.m_front->OutlineCount() == 0 && entry.m_back->OutlineCount() == 0 )
+             // No courtyards defined and no hole testing against other footprint's courtyards
+            continue;
 
-                if( !frontCourtyard.IsEmpty() )
-                {
-                    if( zone->Outline()->Collide( &frontCourtyard.Outline( 0 ) ) )
-                    {
-                        m_itemsInConflict.insert( fp );
-                        m_itemsInConflict.insert( zone );
-                        break;
-                    }
-                }
-            }
+        entry.m_bbox = fp->GetBoundingBox( true, false );
+        entry.m_frontBBox = entry.m_front->BBoxFromCaches();
+        entry.m_backBBox = entry.m_back->BBoxFromCaches();
 
-            if( disallowBack )
-            {
-                const SHAPE_POLY_SET& backCourtyard = fp->GetCourtyard( B_CrtYd );
+        entry.m_frontBBox.Inflate( m_largestCourtyardClearance );
+        entry.m_backBBox.Inflate( m_largestCourtyardClearance );
 
-                if( !backCourtyard.IsEmpty() )
-                {
-                    if( zone->Outline()->Collide( &backCourtyard.Outline( 0 ) ) )
-                    {
-                        m_itemsInConflict.insert( fp );
-                        m_itemsInConflict.insert( zone );
-                        break;
-                    }
-                }
-            }
-        }
+        BOX2I indexBox = entry.m_bbox;
+        indexBox.Inflate( m_largestCourtyardClearance );
+
+        if( entry.m_front->OutlineCount() > 0 )
+            indexBox.Merge( entry.m_frontBBox );
+
+        if( entry.m_back->OutlineCount() > 0 )
+            indexBox.Merge( entry.m_backBBox );
+
+        int min[2] = { indexBox.GetX(), indexBox.GetY() };
+        int max[2] = { indexBox.GetRight(), indexBox.GetBottom() };
+
+        m_staticIndex.Add( min, max, m_staticFootprints.size() );
+        m_staticFootprints.push_back( entry );
+    }
+
+    m_staticIndex.Build();
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( !zone->GetIsRuleArea() || !zone->GetDoNotAllowFootprints() )
+            continue;
+
+        KEEPOUT keepout;
+        keepout.m_zone = zone;
+        keepout.m_bbox = zone->Outline()->BBox();
+        keepout.m_front = ( zone->GetLayerSet() & LSET::FrontMask() ).any();
+        keepout.m_back = ( zone->GetLayerSet() & LSET::BackMask() ).any();
+
+        m_keepouts.push_back( keepout );
     }
 }
 
@@ -216,6 +242,8 @@ void DRC_INTERACTIVE_COURTYARD_CLEARANCE::testCourtyardClearances()
 void DRC_INTERACTIVE_COURTYARD_CLEARANCE::Init( BOARD* aBoard )
 {
     m_board = aBoard;
+    m_indexBuilt = false;
+    m_movedFootprints.clear();
 
     // Update courtyard data and clear the COURTYARD_CONFLICT flag
     for( FOOTPRINT* fp: m_board->Footprints() )
@@ -228,15 +256,38 @@ void DRC_INTERACTIVE_COURTYARD_CLEARANCE::Init( BOARD* aBoard )
 
 bool DRC_INTERACTIVE_COURTYARD_CLEARANCE::Run()
 {
+    // The footprints which don't move are indexed once; a moving footprint is only tested
+    // again when its placement has changed since the last run.
+    if( !m_indexBuilt )
+        buildIndex();
+
     m_itemsInConflict.clear();
-    m_largestCourtyardClearance = 0;
 
-    DRC_CONSTRAINT constraint;
+    for( FOOTPRINT* fp : m_FpInMove )
+    {
+        MOVED_FOOTPRINT& moved = m_movedFootprints[fp];
+        BOX2I            bbox = fp->GetBoundingBox( true, false );
 
-    if( m_drcEngine->QueryWorstConstraint( COURTYARD_CLEARANCE_CONSTRAINT, constraint ) )
-        m_largestCourtyardClearance = constraint.GetValue().Min();
+        if( !moved.m_tested || moved.m_position != fp->GetPosition()
+                || moved.m_orientation != fp->GetOrientation()
+                || moved.m_flipped != fp->IsFlipped() || moved.m_bbox != bbox )
+        {
+            moved.m_tested = true;
+            moved.m_position = fp->GetPosition();
+            moved.m_orientation = fp->GetOrientation();
+            moved.m_flipped = fp->IsFlipped();
+            moved.m_bbox = bbox;
+            moved.m_conflicts.clear();
+
+            testMovedFootprint( fp, bbox, moved.m_conflicts );
+        }
 
-    testCourtyardClearances();
+        if( !moved.m_conflicts.empty() )
+        {
+            m_itemsInConflict.insert( fp );
+            m_itemsInConflict.insert( moved.m_conflicts.begin(), moved.m_conflicts.end() );
+        }
+    }
 
     return true;
 }
@@ -26,7 +26,11 @@
 #ifndef DRC_INTERACTIVE_COURTYARD_CLEARANCE_H
 #define DRC_INTERACTIVE_COURTYARD_CLEARANCE_H
 
+#include <unordered_map>
+
 #include <drc/drc_test_provider_clearance_base.h>
+#include <geometry/eda_angle.h>
+#include <geometry/packed_rtree.h>
 
 
 class DRC_INTERACTIVE_COURTYARD_CLEARANCE : public DRC_TEST_PROVIDER_CLEARANCE_BASE
@@ -34,7 +38,8 @@ class DRC_INTERACTIVE_COURTYARD_CLEARANCE : public DRC_TEST_PROVIDER_CLEARANCE_B
 public:
     DRC_INTERACTIVE_COURTYARD_CLEARANCE( const std::shared_ptr<DRC_ENGINE>& aDRCEngine ) :
             DRC_TEST_PROVIDER_CLEARANCE_BASE(),
-            m_largestCourtyardClearance( 0 )
+            m_largestCourtyardClearance( 0 ),
+            m_indexBuilt( false )
     {
         m_isRuleDriven = false;
         SetDRCEngine( aDRCEngine.get() );
@@ -65,13 +70,63 @@ public:
     std::vector<FOOTPRINT*>   m_FpInMove;             // The list of moved footprints
 
 private:
-    void testCourtyardClearances();
+    /// A footprint which doesn't move, with the boxes the moving footprints are tested against
+    struct STATIC_FOOTPRINT
+    {
+        FOOTPRINT*            m_footprint;
+        const SHAPE_POLY_SET* m_front;
+        const SHAPE_POLY_SET* m_back;
+        BOX2I                 m_bbox;
+        BOX2I                 m_frontBBox;    ///< Inflated by the largest courtyard clearance
+        BOX2I                 m_backBBox;     ///< Inflated by the largest courtyard clearance
+    };
+
+    /// A rule area which doesn't allow footprints
+    struct KEEPOUT
+    {
+        ZONE* m_zone;
+        BOX2I m_bbox;
+        bool  m_front;
+        bool  m_back;
+    };
+
+    /// The placement last tested of a moving footprint, and the items it conflicted with
+    struct MOVED_FOOTPRINT
+    {
+        bool                     m_tested = false;
+        VECTOR2I                 m_position;
+        EDA_ANGLE                m_orientation;
+        bool                     m_flipped = false;
+        BOX2I                    m_bbox;
+        std::vector<BOARD_ITEM*> m_conflicts;
+    };
+
+    /**
+     * Index the footprints which are not moving, and the footprint keepouts.  This is done
+     * once per move, on the first Run() after the moving footprints are known.
+     */
+    void buildIndex();
+
+    /**
+     * Find the footprints and keepouts in conflict with \a aFootprint at its current placement.
+     */
+    void testMovedFootprint( FOOTPRINT* aFootprint, const BOX2I& aBBox,
+                             std::vector<BOARD_ITEM*>& aConflicts );
+
+    bool testFootprints( const STATIC_FOOTPRINT& aStatic, FOOTPRINT* aMoved,
+                         const BOX2I& aMovedBBox );
 
 private:
     int m_largestCourtyardClearance;
 
     std::set<BOARD_ITEM*>     m_itemsInConflict;      // The list of items in conflict
     std::vector<BOARD_ITEM*>  m_lastItemsInConflict;  // The list of items last highlighted
+
+    bool                                            m_indexBuilt;
+    std::vector<STATIC_FOOTPRINT>                   m_staticFootprints;
+    PACKED_RTREE<size_t>                            m_staticIndex;  // Into m_staticFootprints
+    std::vector<KEEPOUT>                            m_keepouts;
+    std::unordered_map<FOOTPRINT*, MOVED_FOOTPRINT> m_movedFootprints;
 };
 
 #endif // DRC_INTERACTIVE_COURTYARD_CLEARANCE_H
@@ -0,0 +1,68 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef DRC_PROFILE_H
+#define DRC_PROFILE_H
+
+#include <atomic>
+#include <cstdint>
+
+
+/**
+ * Work counters of a DRC test provider, filled in when the DRC engine is profiling (see
+ * DRC_ENGINE::SetProfiling()).
+ *
+ * The engine makes the counters of the running provider active; the DRC code counts into
+ * whichever counters are active, from any thread, and skips counting when none are.
+ */
+struct DRC_PROFILE_COUNTERS
+{
+    std::atomic<int64_t> m_itemsTested{ 0 };     ///< Items handed to the provider's tests
+    std::atomic<int64_t> m_rtreeQueries{ 0 };    ///< DRC_RTREE searches
+    std::atomic<int64_t> m_collisionTests{ 0 };  ///< Shape collisions tested by DRC_RTREE
+    std::atomic<int64_t> m_ruleEvaluations{ 0 }; ///< DRC_ENGINE::EvalRules() calls
+    int64_t              m_wallTime = 0;         ///< Microseconds
+
+    void Reset()
+    {
+        m_itemsTested = 0;
+        m_rtreeQueries = 0;
+        m_collisionTests = 0;
+        m_ruleEvaluations = 0;
+        m_wallTime = 0;
+    }
+
+    static DRC_PROFILE_COUNTERS* Active() { return s_active.load( std::memory_order_relaxed ); }
+    static void SetActive( DRC_PROFILE_COUNTERS* aCounters ) { s_active.store( aCounters ); }
+
+    static void Count( std::atomic<int64_t> DRC_PROFILE_COUNTERS::*aCounter, int64_t aCount = 1 )
+    {
+        if( DRC_PROFILE_COUNTERS* active = Active() )
+            ( active->*aCounter ).fetch_add( aCount, std::memory_order_relaxed );
+    }
+
+private:
+    static inline std::atomic<DRC_PROFILE_COUNTERS*> s_active{ nullptr };
+};
+
+#endif // DRC_PROFILE_H
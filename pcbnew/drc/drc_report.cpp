@@ -24,10 +24,13 @@
 #include <build_version.h>
 #include "drc_report.h"
 #include <drc/drc_item.h>
+#include <drc/drc_rule.h>
+#include <drc/drc_test_provider.h>
 #include <fstream>
 #include <macros.h>
 #include <nlohmann/json.hpp>
 #include <rc_json_schema.h>
+#include <rc_json_writer.h>
 
 
 DRC_REPORT::DRC_REPORT( BOARD* aBoard, EDA_UNITS aReportUnits,
@@ -44,6 +47,39 @@ DRC_REPORT::DRC_REPORT( BOARD* aBoard, EDA_UNITS aReportUnits,
 }
 
 
+void DRC_REPORT::SetProviderProfiles( const std::vector<DRC_TEST_PROVIDER*>& aProviders )
+{
+    m_profiles.clear();
+
+    for( DRC_TEST_PROVIDER* provider : aProviders )
+    {
+        DRC_PROFILE_COUNTERS&         counters = provider->Profile();
+        RC_JSON::DRC_PROVIDER_PROFILE profile;
+
+        profile.provider = provider->GetName();
+        profile.time_ms = counters.m_wallTime / 1000.0;
+        profile.items_tested = counters.m_itemsTested;
+        profile.rtree_queries = counters.m_rtreeQueries;
+        profile.collision_tests = counters.m_collisionTests;
+        profile.rule_evaluations = counters.m_ruleEvaluations;
+
+        for( const auto& [ rule, hits ] : provider->GetRuleStatistics() )
+        {
+            if( rule )
+                profile.rules.push_back( { rule->m_Name, hits } );
+        }
+
+        std::sort( profile.rules.begin(), profile.rules.end(),
+                   []( const RC_JSON::RULE_HITS& a, const RC_JSON::RULE_HITS& b )
+                   {
+                       return a.hits > b.hits || ( a.hits == b.hits && a.rule < b.rule );
+                   } );
+
+        m_profiles.push_back( profile );
+    }
+}
+
+
 bool DRC_REPORT::WriteTextReport( const wxString& aFullFileName )
 {
     FILE* fp = wxFopen( aFullFileName, wxT( "w" ) );
@@ -102,6 +138,22 @@ bool DRC_REPORT::WriteTextReport( const wxString& aFullFileName )
         fprintf( fp, "%s", TO_UTF8( item->ShowReport( &unitsProvider, severity, itemMap ) ) );
     }
 
+    if( !m_profiles.empty() )
+    {
+        fprintf( fp, "\n** DRC provider profile **\n" );
+
+        for( const RC_JSON::DRC_PROVIDER_PROFILE& profile : m_profiles )
+        {
+            fprintf( fp, "%s: %.1f ms, %lld items, %lld R-tree queries, %lld collision tests, "
+                         "%lld rule evaluations\n",
+                     TO_UTF8( profile.provider ), profile.time_ms,
+                     (long long) profile.items_tested, (long long) profile.rtree_queries,
+                     (long long) profile.collision_tests, (long long) profile.rule_evaluations );
+
+            for( const RC_JSON::RULE_HITS& rule : profile.rules )
+                fprintf( fp, "    rule '%s': %d hits\n", TO_UTF8( rule.rule ), rule.hits );
+        }
+    }
 
     fprintf( fp, "\n** End of Report **\n" );
 
@@ -115,62 +167,67 @@ bool DRC_REPORT::WriteJsonReport( const wxString& aFullFileName )
 {
     std::ofstream jsonFileStream( aFullFileName.fn_str() );
 
+    if( !jsonFileStream.is_open() )
+        return false;
+
     UNITS_PROVIDER            unitsProvider( pcbIUScale, m_reportUnits );
     BOARD_DESIGN_SETTINGS&    bds = m_board->GetDesignSettings();
     std::map<KIID, EDA_ITEM*> itemMap;
     m_board->FillItemMap( itemMap );
 
-    RC_JSON::DRC_REPORT reportHead;
+    // The violations are serialized one at a time as they are written, so that the report of
+    // a board with a huge number of violations is never held in memory as a whole.
+    RC_JSON::STREAM_WRITER writer( jsonFileStream );
 
-    wxFileName fn( m_board->GetFileName() );
-    reportHead.$schema = "https://schemas.kicad.org/drc.v1.json";
-    reportHead.source = fn.GetFullName();
-    reportHead.date = GetISO8601CurrentDateTime();
-    reportHead.kicad_version = GetMajorMinorPatchVersion();
-    reportHead.coordinate_units = EDA_UNIT_UTILS::GetLabel( m_reportUnits );
+    auto writeViolations =
+            [&]( const std::string& aKey, RC_ITEMS_PROVIDER* aProvider, bool aMarkers )
+            {
+                writer.Key( aKey );
+                writer.BeginArray();
 
-    for( int i = 0; i < m_markersProvider->GetCount(); ++i )
-    {
-        const std::shared_ptr<RC_ITEM>& item = m_markersProvider->GetItem( i );
-        SEVERITY                        severity = item->GetParent()->GetSeverity();
+                for( int i = 0; i < aProvider->GetCount(); ++i )
+                {
+                    const std::shared_ptr<RC_ITEM>& item = aProvider->GetItem( i );
+                    SEVERITY severity = bds.GetSeverity( item->GetErrorCode() );
 
-        if( severity == RPT_SEVERITY_EXCLUSION )
-            severity = bds.GetSeverity( item->GetErrorCode() );
-
-        RC_JSON::VIOLATION violation;
-        item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
-
-        reportHead.violations.push_back( violation );
-    }
+                    if( aMarkers )
+                    {
+                        severity = item->GetParent()->GetSeverity();
 
-    for( int i = 0; i < m_ratsnestProvider->GetCount(); ++i )
-    {
-        const std::shared_ptr<RC_ITEM>& item = m_ratsnestProvider->GetItem( i );
-        SEVERITY                        severity = bds.GetSeverity( item->GetErrorCode() );
+                        if( severity == RPT_SEVERITY_EXCLUSION )
+                            severity = bds.GetSeverity( item->GetErrorCode() );
+                    }
 
-        RC_JSON::VIOLATION violation;
-        item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
+                    RC_JSON::VIOLATION violation;
+                    item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
 
-        reportHead.unconnected_items.push_back( violation );
-    }
+                    writer.Value( violation );
+                }
 
+                writer.EndArray();
+            };
 
-    for( int i = 0; i < m_fpWarningsProvider->GetCount(); ++i )
-    {
-        const std::shared_ptr<RC_ITEM>& item = m_fpWarningsProvider->GetItem( i );
-        SEVERITY                        severity = bds.GetSeverity( item->GetErrorCode() );
+    wxFileName fn( m_board->GetFileName() );
 
-        RC_JSON::VIOLATION violation;
-        item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
+    // Members in alphabetical order, as nlohmann::json would write them
+    writer.BeginObject();
+    writer.Member( "$schema", wxString( "https://schemas.kicad.org/drc.v1.json" ) );
+    writer.Member( "coordinate_units", EDA_UNIT_UTILS::GetLabel( m_reportUnits ) );
+    writer.Member( "date", GetISO8601CurrentDateTime() );
+    writer.Member( "kicad_version", GetMajorMinorPatchVersion() );
 
-        reportHead.schematic_parity.push_back( violation );
-    }
+    if( !m_profiles.empty() )
+        writer.Member( "profile", m_profiles );
 
+    writeViolations( "schematic_parity", m_fpWarningsProvider.get(), false );
+    writer.Member( "source", fn.GetFullName() );
+    writeViolations( "unconnected_items", m_ratsnestProvider.get(), false );
+    writeViolations( "violations", m_markersProvider.get(), true );
+    writer.EndObject();
+    writer.Finish();
 
-    nlohmann::json saveJson = nlohmann::json( reportHead );
-    jsonFileStream << std::setw( 4 ) << saveJson << std::endl;
     jsonFileStream.flush();
     jsonFileStream.close();
 
-    return true;
-}
\ No newline at end of file
+    return !jsonFileStream.fail();
+}
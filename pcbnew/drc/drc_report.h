@@ -21,10 +21,13 @@
 #define DRC_REPORT_H
 
 #include <memory>
+#include <vector>
 #include <eda_units.h>
+#include <rc_json_schema.h>
 #include <wx/string.h>
 
 class BOARD;
+class DRC_TEST_PROVIDER;
 class RC_ITEMS_PROVIDER;
 
 class DRC_REPORT
@@ -36,6 +39,11 @@ public:
                 std::shared_ptr<RC_ITEMS_PROVIDER> aRatsnestProvider,
                 std::shared_ptr<RC_ITEMS_PROVIDER> aFpWarningsProvider );
 
+    /**
+     * Add the profiling counters of the providers of a profiled DRC run to the report.
+     */
+    void SetProviderProfiles( const std::vector<DRC_TEST_PROVIDER*>& aProviders );
+
     bool WriteTextReport( const wxString& aFullFileName );
     bool WriteJsonReport( const wxString& aFullFileName );
 
@@ -45,6 +53,8 @@ private:
     std::shared_ptr<RC_ITEMS_PROVIDER> m_markersProvider;
     std::shared_ptr<RC_ITEMS_PROVIDER> m_ratsnestProvider;
     std::shared_ptr<RC_ITEMS_PROVIDER> m_fpWarningsProvider;
+
+    std::vector<RC_JSON::DRC_PROVIDER_PROFILE> m_profiles;
 };
 
 
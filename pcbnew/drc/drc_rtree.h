@@ -28,11 +28,18 @@
 #include <board_item.h>
 #include <pad.h>
 #include <pcb_text.h>
+#include <atomic>
+#include <future>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <set>
 #include <vector>
 
+#include <core/thread_pool.h>
+
+#include <drc/drc_profile.h>
+#include <geometry/packed_rtree.h>
 #include <geometry/rtree.h>
 #include <geometry/shape.h>
 #include <geometry/shape_segment.h>
@@ -76,6 +83,7 @@ public:
 private:
 
     using drc_rtree = RTree<ITEM_WITH_SHAPE*, int, 2, double>;
+    using packed_rtree = PACKED_RTREE<ITEM_WITH_SHAPE*>;
 
 public:
 
@@ -96,6 +104,12 @@ public:
 
             delete tree;
         }
+
+        for( const packed_rtree& tree : m_packedTree )
+        {
+            for( DRC_RTREE::ITEM_WITH_SHAPE* el : tree.Data() )
+                delete el;
+        }
     }
 
     /**
@@ -112,6 +126,32 @@ public:
      */
     void Insert( BOARD_ITEM* aItem, PCB_LAYER_ID aRefLayer, PCB_LAYER_ID aTargetLayer,
                  int aWorstClearance )
+    {
+        insert( aItem, aRefLayer, aTargetLayer, aWorstClearance, false );
+    }
+
+    /**
+     * Stage an item for a bulk load.  Staged items are not searchable until Pack() is called;
+     * this is much faster than Insert() when adding a whole board, and gives a tighter tree.
+     */
+    void BulkInsert( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, int aWorstClearance = 0 )
+    {
+        insert( aItem, aLayer, aLayer, aWorstClearance, true );
+    }
+
+    /**
+     * Build the packed trees of all the items staged by BulkInsert() (along with any packed
+     * before).
+     */
+    void Pack()
+    {
+        for( packed_rtree& tree : m_packedTree )
+            tree.Build();
+    }
+
+private:
+    void insert( BOARD_ITEM* aItem, PCB_LAYER_ID aRefLayer, PCB_LAYER_ID aTargetLayer,
+                 int aWorstClearance, bool aBulk )
     {
         wxCHECK( aTargetLayer != UNDEFINED_LAYER, /* void */ );
 
@@ -142,8 +182,7 @@ public:
             const int        mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
             ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( aItem, subshape, shape );
 
-            m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
-            m_count++;
+            insertShape( aTargetLayer, mmin, mmax, itemShape, aBulk );
         }
 
         if( aItem->Type() == PCB_PAD_T && aItem->HasHole() )
@@ -157,19 +196,55 @@ public:
             const int        mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
             ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( aItem, hole, shape );
 
-            m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
-            m_count++;
-
+            insertShape( aTargetLayer, mmin, mmax, itemShape, aBulk );
         }
     }
 
+    void insertShape( PCB_LAYER_ID aLayer, const int aMin[2], const int aMax[2],
+                      ITEM_WITH_SHAPE* aItemShape, bool aBulk )
+    {
+        if( aBulk )
+            m_packedTree[aLayer].Add( aMin, aMax, aItemShape );
+        else
+            m_tree[aLayer]->Insert( aMin, aMax, aItemShape );
+
+        m_count++;
+    }
+
+    /**
+     * Search both the packed and the dynamic trees of a layer.
+     */
+    template <class VISITOR>
+    void search( PCB_LAYER_ID aLayer, const int aMin[2], const int aMax[2],
+                 VISITOR& aVisitor ) const
+    {
+        DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_rtreeQueries );
+
+        if( m_packedTree[aLayer].Search( aMin, aMax, aVisitor ) )
+            m_tree[aLayer]->Search( aMin, aMax, aVisitor );
+    }
+
+public:
     /**
      * Remove all items from the RTree.
      */
     void clear()
     {
         for( auto tree : m_tree )
+        {
+            for( DRC_RTREE::ITEM_WITH_SHAPE* el : *tree )
+                delete el;
+
             tree->RemoveAll();
+        }
+
+        for( packed_rtree& tree : m_packedTree )
+        {
+            for( DRC_RTREE::ITEM_WITH_SHAPE* el : tree.Data() )
+                delete el;
+
+            tree.Clear();
+        }
 
         m_count = 0;
     }
@@ -192,6 +267,8 @@ public:
                     {
                         int actual;
 
+                        DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                         if( aRefShape->Collide( aItem->shape, aClearance, &actual ) )
                         {
                             count++;
@@ -202,7 +279,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        search( aTargetLayer, min, max, visit );
         return count > 0;
     }
 
@@ -260,6 +337,8 @@ public:
                     if( filtered )
                         return true;
 
+                    DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                     if( refShape->Collide( aItem->shape, aClearance ) )
                     {
                         collidingCompounds.insert( aItem->parent );
@@ -272,7 +351,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        search( aTargetLayer, min, max, visit );
         return count;
     }
 
@@ -301,6 +380,8 @@ public:
                     int      curActual;
                     VECTOR2I curPos;
 
+                    DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                     if( aRefShape->Collide( aItem->shape, aClearance, &curActual, &curPos ) )
                     {
                         collision = true;
@@ -319,7 +400,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aLayer]->Search( min, max, visit );
+        search( aLayer, min, max, visit );
 
         if( collision )
         {
@@ -358,6 +439,8 @@ public:
 
                     const SHAPE_LINE_CHAIN& outline = poly->Outline( 0 );
 
+                    DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                     for( int ii = 0; ii < (int) tri->GetSegmentCount(); ++ii )
                     {
                         if( outline.Collide( tri->GetSegment( ii ) ) )
@@ -380,6 +463,8 @@ public:
         auto visitor =
                 [&]( ITEM_WITH_SHAPE* aItem ) -> bool
                 {
+                    DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                     if( aRefShape->Collide( aItem->shape, 0 ) )
                     {
                         collision = true;
@@ -390,9 +475,9 @@ public:
                 };
 
         if( poly && poly->OutlineCount() == 1 && poly->HoleCount( 0 ) == 0 )
-            this->m_tree[aLayer]->Search( min, max, polyVisitor );
+            search( aLayer, min, max, polyVisitor );
         else
-            this->m_tree[aLayer]->Search( min, max, visitor );
+            search( aLayer, min, max, visitor );
 
         return collision;
     }
@@ -417,7 +502,7 @@ public:
                     return true;
                 };
 
-        m_tree[aLayer]->Search( min, max, visitor );
+        search( aLayer, min, max, visitor );
 
         return retval;
     }
@@ -469,7 +554,7 @@ public:
                             return true;
                         };
 
-                this->m_tree[targetLayer]->Search( min, max, visit );
+                search( targetLayer, min, max, visit );
             };
         }
 
@@ -509,6 +594,196 @@ public:
         return 0;
     }
 
+    /**
+     * A parallel QueryCollidingPairs().
+     *
+     * The candidate pairs are gathered in parallel over layer pairs and runs of reference items
+     * (which, in a packed tree, are spatial tiles).  Candidates of the same pair of BOARD_ITEMs
+     * are then tested by a single thread in order, so the first collision found for a compound
+     * or triangulated shape is the same as in a serial scan.
+     *
+     * @param aVisitor is called concurrently from several threads; it sets \a aResult when it
+     *                 finds a collision, and returns false to stop the search.
+     * @return the results in the order a serial scan would have found them.
+     */
+    template <class RESULT>
+    std::vector<RESULT> QueryCollidingPairsParallel(
+            DRC_RTREE* aRefTree, const std::vector<LAYER_PAIR>& aLayerPairs,
+            const std::function<bool( const LAYER_PAIR&, ITEM_WITH_SHAPE*, ITEM_WITH_SHAPE*,
+                                      std::optional<RESULT>& aResult )>& aVisitor,
+            int aMaxClearance,
+            const std::function<bool( int, int )>& aProgressReporter ) const
+    {
+        static constexpr size_t REF_ITEMS_PER_TASK = 256;
+
+        thread_pool& tp = GetKiCadThreadPool();
+
+        struct WORK_UNIT
+        {
+            size_t m_layerPair;
+            size_t m_first;
+            size_t m_last;
+        };
+
+        std::vector<std::vector<ITEM_WITH_SHAPE*>> refItems;
+        std::vector<WORK_UNIT>                     units;
+
+        for( size_t ii = 0; ii < aLayerPairs.size(); ++ii )
+        {
+            refItems.push_back( aRefTree->OnLayer( aLayerPairs[ii].first ).m_items );
+
+            for( size_t first = 0; first < refItems.back().size(); first += REF_ITEMS_PER_TASK )
+            {
+                units.push_back( { ii, first,
+                                   std::min( refItems.back().size(),
+                                             first + REF_ITEMS_PER_TASK ) } );
+            }
+        }
+
+        std::vector<std::vector<PAIR_INFO>> unitPairs( units.size() );
+
+        tp.parallelize_loop( 0, units.size(),
+                [&]( size_t aStart, size_t aEnd )
+                {
+                    for( size_t ii = aStart; ii < aEnd; ++ii )
+                    {
+                        const WORK_UNIT&  unit = units[ii];
+                        const LAYER_PAIR& layerPair = aLayerPairs[unit.m_layerPair];
+
+                        for( size_t jj = unit.m_first; jj < unit.m_last; ++jj )
+                        {
+                            ITEM_WITH_SHAPE* refItem = refItems[unit.m_layerPair][jj];
+                            BOX2I            box = refItem->shape->BBox();
+                            box.Inflate( aMaxClearance );
+
+                            int min[2] = { box.GetX(),     box.GetY() };
+                            int max[2] = { box.GetRight(), box.GetBottom() };
+
+                            auto visit =
+                                    [&]( ITEM_WITH_SHAPE* aItemToTest ) -> bool
+                                    {
+                                        // don't collide items against themselves
+                                        if( aItemToTest->parent != refItem->parent )
+                                            unitPairs[ii].emplace_back( layerPair, refItem,
+                                                                        aItemToTest );
+
+                                        return true;
+                                    };
+
+                            search( layerPair.second, min, max, visit );
+                        }
+                    }
+                } ).wait();
+
+        std::vector<PAIR_INFO> pairsToVisit;
+
+        for( std::vector<PAIR_INFO>& pairs : unitPairs )
+            pairsToVisit.insert( pairsToVisit.end(), pairs.begin(), pairs.end() );
+
+        unitPairs.clear();
+
+        // Group the candidates by (canonically ordered) pair of BOARD_ITEMs, keeping the scan
+        // order within each group
+        std::unordered_map<PTR_PTR_CACHE_KEY, size_t> groupIndex;
+        std::vector<std::vector<size_t>>              groups;
+
+        for( size_t ii = 0; ii < pairsToVisit.size(); ++ii )
+        {
+            BOARD_ITEM* a = pairsToVisit[ii].refItem->parent;
+            BOARD_ITEM* b = pairsToVisit[ii].testItem->parent;
+
+            if( static_cast<void*>( a ) > static_cast<void*>( b ) )
+                std::swap( a, b );
+
+            auto [ it, inserted ] = groupIndex.emplace( PTR_PTR_CACHE_KEY{ a, b }, groups.size() );
+
+            if( inserted )
+                groups.emplace_back();
+
+            groups[it->second].push_back( ii );
+        }
+
+        groupIndex.clear();
+
+        // Each thread collects its results in its own buffer, keyed by scan order
+        size_t threads = tp.get_thread_count();
+        std::vector<std::vector<std::pair<size_t, RESULT>>> threadResults( threads );
+
+        std::vector<std::future<void>> returns;
+        std::atomic<size_t>            next( 0 );
+        std::atomic<size_t>            done( 0 );
+        std::atomic<bool>              stop( false );
+
+        for( size_t thread = 0; thread < threads; ++thread )
+        {
+            returns.emplace_back( tp.submit(
+                    [&, thread]()
+                    {
+                        for( size_t ii = next++; ii < groups.size() && !stop; ii = next++ )
+                        {
+                            for( size_t pairIdx : groups[ii] )
+                            {
+                                const PAIR_INFO&      pair = pairsToVisit[pairIdx];
+                                std::optional<RESULT> result;
+
+                                if( !aVisitor( pair.layerPair, pair.refItem, pair.testItem,
+                                               result ) )
+                                {
+                                    stop = true;
+                                    break;
+                                }
+
+                                // don't report multiple collisions for compound or
+                                // triangulated shapes
+                                if( result )
+                                {
+                                    threadResults[thread].emplace_back( pairIdx,
+                                                                        std::move( *result ) );
+                                    break;
+                                }
+                            }
+
+                            done++;
+                        }
+                    } ) );
+        }
+
+        for( const std::future<void>& ret : returns )
+        {
+            std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+            while( status != std::future_status::ready )
+            {
+                if( !aProgressReporter( done, groups.size() ) )
+                    stop = true;
+
+                status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+            }
+        }
+
+        std::vector<std::pair<size_t, RESULT>> merged;
+
+        for( std::vector<std::pair<size_t, RESULT>>& results : threadResults )
+        {
+            for( std::pair<size_t, RESULT>& result : results )
+                merged.push_back( std::move( result ) );
+        }
+
+        std::sort( merged.begin(), merged.end(),
+                   []( const std::pair<size_t, RESULT>& a, const std::pair<size_t, RESULT>& b )
+                   {
+                       return a.first < b.first;
+                   } );
+
+        std::vector<RESULT> results;
+        results.reserve( merged.size() );
+
+        for( std::pair<size_t, RESULT>& result : merged )
+            results.push_back( std::move( result.second ) );
+
+        return results;
+    }
+
     /**
      * Return the number of items in the tree.
      *
@@ -524,7 +799,7 @@ public:
         return m_count == 0;
     }
 
-    using iterator = typename drc_rtree::Iterator;
+    using iterator = typename std::vector<ITEM_WITH_SHAPE*>::const_iterator;
 
     /**
      * The DRC_LAYER struct provides a layer-specific auto-range iterator to the RTree.  Using
@@ -532,56 +807,65 @@ public:
      *
      * for( auto item : rtree.OnLayer( In1_Cu ) )
      *
-     * and iterate over only the RTree items that are on In1
+     * and iterate over only the RTree items that are on In1.  The items of both the packed and
+     * the dynamic trees are collected up front.
      */
     struct DRC_LAYER
     {
-        DRC_LAYER( drc_rtree* aTree ) : layer_tree( aTree )
+        DRC_LAYER( const DRC_RTREE* aTree, PCB_LAYER_ID aLayer, const int aMin[2],
+                   const int aMax[2] )
         {
-            m_rect = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
-        };
+            auto visit =
+                    [&]( ITEM_WITH_SHAPE* aItem ) -> bool
+                    {
+                        m_items.push_back( aItem );
+                        return true;
+                    };
 
-        DRC_LAYER( drc_rtree* aTree, const BOX2I& aRect ) : layer_tree( aTree )
-        {
-            m_rect = { { aRect.GetX(), aRect.GetY() },
-                       { aRect.GetRight(), aRect.GetBottom() } };
+            aTree->search( aLayer, aMin, aMax, visit );
         };
 
-        drc_rtree::Rect m_rect;
-        drc_rtree*      layer_tree;
+        std::vector<ITEM_WITH_SHAPE*> m_items;
 
-        iterator begin()
+        iterator begin() const
         {
-            return layer_tree->begin( m_rect );
+            return m_items.begin();
         }
 
-        iterator end()
+        iterator end() const
         {
-            return layer_tree->end( m_rect );
+            return m_items.end();
         }
     };
 
     DRC_LAYER OnLayer( PCB_LAYER_ID aLayer ) const
     {
-        return DRC_LAYER( m_tree[int( aLayer )] );
+        const int min[2] = { INT_MIN, INT_MIN };
+        const int max[2] = { INT_MAX, INT_MAX };
+
+        return DRC_LAYER( this, aLayer, min, max );
     }
 
     DRC_LAYER Overlapping( PCB_LAYER_ID aLayer, const VECTOR2I& aPoint, int aAccuracy = 0 ) const
     {
         BOX2I rect( aPoint, VECTOR2I( 0, 0 ) );
         rect.Inflate( aAccuracy );
-        return DRC_LAYER( m_tree[int( aLayer )], rect );
+        return Overlapping( aLayer, rect );
     }
 
     DRC_LAYER Overlapping( PCB_LAYER_ID aLayer, const BOX2I& aRect ) const
     {
-        return DRC_LAYER( m_tree[int( aLayer )], aRect );
+        const int min[2] = { aRect.GetX(), aRect.GetY() };
+        const int max[2] = { aRect.GetRight(), aRect.GetBottom() };
+
+        return DRC_LAYER( this, aLayer, min, max );
     }
 
 
 private:
-    drc_rtree*  m_tree[PCB_LAYER_ID_COUNT];
-    size_t      m_count;
+    drc_rtree*   m_tree[PCB_LAYER_ID_COUNT];
+    packed_rtree m_packedTree[PCB_LAYER_ID_COUNT];
+    size_t       m_count;
 };
 
 
@@ -22,12 +22,45 @@
  */
 
 
+#include <mutex>
+#include <unordered_map>
+
+#include <advanced_config.h>
 #include <board_item.h>
 #include <reporter.h>
 #include <drc/drc_rule_condition.h>
 #include <pcbexpr_evaluator.h>
 
 
+namespace
+{
+
+/**
+ * The programs of the rule conditions compiled so far, by expression.  A program depends only
+ * on the text of its expression, so it is shared by all the conditions with the same expression:
+ * the parser and the DRC engine both compile each condition, and the rules are reloaded for each
+ * DRC run, by the router, the zone filler and the inspection tools.
+ *
+ * Programs are only run with a context of their own, so sharing them between threads is safe.
+ */
+struct PROGRAM_CACHE
+{
+    static constexpr size_t MAX_PROGRAMS = 10000;
+
+    std::mutex                                                    m_mutex;
+    std::unordered_map<wxString, std::shared_ptr<PCBEXPR_UCODE>> m_programs;
+};
+
+
+PROGRAM_CACHE& programCache()
+{
+    static PROGRAM_CACHE cache;
+    return cache;
+}
+
+} // namespace
+
+
 DRC_RULE_CONDITION::DRC_RULE_CONDITION( const wxString& aExpression ) :
     m_expression( aExpression ),
     m_ucode ( nullptr )
@@ -88,31 +121,73 @@ bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM
 
 bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSourceOffset )
 {
-    PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+    const bool     useCache = ADVANCED_CFG::GetCfg().m_CacheDRCRulePrograms;
+    PROGRAM_CACHE& cache = programCache();
 
-    if( aReporter )
+    if( useCache )
     {
-        compiler.SetErrorCallback(
-                [&]( const wxString& aMessage, int aOffset )
-                {
-                    wxString rest;
-                    wxString first = aMessage.BeforeFirst( '|', &rest );
-                    wxString msg = wxString::Format( _( "ERROR: <a href='%d:%d'>%s</a>%s" ),
-                                                     aSourceLine,
-                                                     aSourceOffset + aOffset,
-                                                     first,
-                                                     rest );
-
-                    aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                } );
+        std::lock_guard<std::mutex> lock( cache.m_mutex );
+        auto                        it = cache.m_programs.find( GetExpression() );
+
+        if( it != cache.m_programs.end() )
+        {
+            m_ucode = it->second;
+            return true;
+        }
     }
 
-    m_ucode = std::make_unique<PCBEXPR_UCODE>();
+    PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+    bool             reported = false;
+
+    compiler.SetErrorCallback(
+            [&]( const wxString& aMessage, int aOffset )
+            {
+                reported = true;
+
+                if( !aReporter )
+                    return;
+
+                wxString rest;
+                wxString first = aMessage.BeforeFirst( '|', &rest );
+                wxString msg = wxString::Format( _( "ERROR: <a href='%d:%d'>%s</a>%s" ),
+                                                 aSourceLine,
+                                                 aSourceOffset + aOffset,
+                                                 first,
+                                                 rest );
+
+                aReporter->Report( msg, RPT_SEVERITY_ERROR );
+            } );
+
+    std::shared_ptr<PCBEXPR_UCODE> ucode = std::make_shared<PCBEXPR_UCODE>();
 
     PCBEXPR_CONTEXT preflightContext( 0, F_Cu );
 
-    bool ok = compiler.Compile( GetExpression().ToUTF8().data(), m_ucode.get(), &preflightContext );
+    bool ok = compiler.Compile( GetExpression().ToUTF8().data(), ucode.get(), &preflightContext );
+
+    m_ucode = ucode;
+
+    // Expressions with errors are compiled again each time, so that their errors are reported
+    // each time they are loaded
+    if( useCache && ok && !reported )
+    {
+        std::lock_guard<std::mutex> lock( cache.m_mutex );
+
+        if( cache.m_programs.size() >= PROGRAM_CACHE::MAX_PROGRAMS )
+            cache.m_programs.clear();
+
+        cache.m_programs.emplace( GetExpression(), std::move( ucode ) );
+    }
+
     return ok;
 }
 
 
+bool DRC_RULE_CONDITION::ReadsNetAndTypeOnly() const
+{
+    if( GetExpression().IsEmpty() )
+        return true;
+
+    return m_ucode && m_ucode->ReadsNetAndTypeOnly();
+}
+
+
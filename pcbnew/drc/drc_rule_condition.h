@@ -24,6 +24,8 @@
 #ifndef DRC_RULE_CONDITION_H
 #define DRC_RULE_CONDITION_H
 
+#include <memory>
+
 #include <core/typeinfo.h>
 #include <layer_ids.h>
 
@@ -46,9 +48,17 @@ public:
     void SetExpression( const wxString& aExpression ) { m_expression = aExpression; }
     wxString GetExpression() const { return m_expression; }
 
+    /**
+     * @return true if the condition is compiled and depends only on the nets, net classes and
+     *         types of the items (and the layer), so that its result can be shared between item
+     *         pairs which agree on those.
+     */
+    bool ReadsNetAndTypeOnly() const;
+
 private:
     wxString                       m_expression;
-    std::unique_ptr<PCBEXPR_UCODE> m_ucode;
+    std::shared_ptr<PCBEXPR_UCODE> m_ucode;     ///< May be shared with the conditions with the
+                                                ///< same expression
 };
 
 
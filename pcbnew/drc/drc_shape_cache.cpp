@@ -0,0 +1,123 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <drc/drc_shape_cache.h>
+
+#include <core/thread_pool.h>
+#include <geometry/shape.h>
+#include <geometry/shape_segment.h>
+
+
+bool DRC_SHAPE_CACHE::IsCacheable( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+    case PCB_PAD_T:
+    case PCB_SHAPE_T:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+void DRC_SHAPE_CACHE::Build( const std::vector<BOARD_ITEM*>& aItems, const LSET& aCopperLayers )
+{
+    struct ITEM_SHAPES
+    {
+        std::vector<std::pair<PCB_LAYER_ID, std::shared_ptr<SHAPE>>> m_shapes;
+        std::shared_ptr<SHAPE_SEGMENT>                               m_hole;
+    };
+
+    std::vector<ITEM_SHAPES> results( aItems.size() );
+    thread_pool&             tp = GetKiCadThreadPool();
+
+    tp.parallelize_loop( 0, aItems.size(),
+            [&]( size_t aStart, size_t aEnd )
+            {
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                {
+                    const BOARD_ITEM* item = aItems[ii];
+                    LSET              layers = item->GetLayerSet() & aCopperLayers;
+
+                    if( !IsCacheable( item ) )
+                        continue;
+
+                    // Items with a hole are on all the layers they pierce
+                    if( item->HasHole() )
+                    {
+                        if( item->Type() == PCB_PAD_T )
+                            layers = aCopperLayers;
+
+                        results[ii].m_hole = item->GetEffectiveHoleShape();
+                    }
+
+                    for( PCB_LAYER_ID layer : layers.Seq() )
+                        results[ii].m_shapes.emplace_back( layer, item->GetEffectiveShape( layer ) );
+                }
+            } ).wait();
+
+    for( size_t ii = 0; ii < aItems.size(); ++ii )
+    {
+        for( auto& [ layer, shape ] : results[ii].m_shapes )
+            m_shapes[ { aItems[ii], layer, FLASHING::DEFAULT } ] = std::move( shape );
+
+        if( results[ii].m_hole )
+            m_holes[ aItems[ii] ] = std::move( results[ii].m_hole );
+    }
+}
+
+
+void DRC_SHAPE_CACHE::Clear()
+{
+    m_shapes.clear();
+    m_holes.clear();
+}
+
+
+std::shared_ptr<SHAPE> DRC_SHAPE_CACHE::GetEffectiveShape( const BOARD_ITEM* aItem,
+                                                           PCB_LAYER_ID aLayer,
+                                                           FLASHING aFlash ) const
+{
+    auto it = m_shapes.find( { aItem, aLayer, aFlash } );
+
+    if( it != m_shapes.end() )
+        return it->second;
+
+    return aItem->GetEffectiveShape( aLayer, aFlash );
+}
+
+
+std::shared_ptr<SHAPE_SEGMENT> DRC_SHAPE_CACHE::GetEffectiveHoleShape( const BOARD_ITEM* aItem ) const
+{
+    auto it = m_holes.find( aItem );
+
+    if( it != m_holes.end() )
+        return it->second;
+
+    return aItem->GetEffectiveHoleShape();
+}
@@ -0,0 +1,97 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef DRC_SHAPE_CACHE_H
+#define DRC_SHAPE_CACHE_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <board_item.h>
+#include <hash.h>
+#include <layer_ids.h>
+
+class SHAPE;
+class SHAPE_SEGMENT;
+
+
+/**
+ * The effective shapes of the copper items of a board, built once per DRC run (in parallel,
+ * by the DRC_CACHE_GENERATOR) and shared by all the test providers.
+ *
+ * The cache is not modified between Build() and Clear(), so it may be read from any thread.
+ * Shapes which were not cached are built by the item itself.
+ */
+class DRC_SHAPE_CACHE
+{
+public:
+    /**
+     * Cache the effective shapes of \a aItems on each of their copper layers (all of
+     * \a aCopperLayers for items with a hole), and their hole shapes.
+     *
+     * Only tracks, arcs, vias, pads and graphic shapes are cached: the shapes of texts depend
+     * on their render caches, which can't be built from several threads.
+     */
+    void Build( const std::vector<BOARD_ITEM*>& aItems, const LSET& aCopperLayers );
+
+    void Clear();
+
+    bool IsEmpty() const { return m_shapes.empty() && m_holes.empty(); }
+
+    std::shared_ptr<SHAPE> GetEffectiveShape( const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer,
+                                              FLASHING aFlash = FLASHING::DEFAULT ) const;
+
+    std::shared_ptr<SHAPE_SEGMENT> GetEffectiveHoleShape( const BOARD_ITEM* aItem ) const;
+
+    static bool IsCacheable( const BOARD_ITEM* aItem );
+
+private:
+    struct KEY
+    {
+        const BOARD_ITEM* m_item;
+        PCB_LAYER_ID      m_layer;
+        FLASHING          m_flash;
+
+        bool operator==( const KEY& aOther ) const
+        {
+            return m_item == aOther.m_item && m_layer == aOther.m_layer
+                    && m_flash == aOther.m_flash;
+        }
+    };
+
+    struct KEY_HASH
+    {
+        std::size_t operator()( const KEY& aKey ) const
+        {
+            std::size_t seed = 0xa82de1c0;
+            hash_combine( seed, aKey.m_item, aKey.m_layer, static_cast<int>( aKey.m_flash ) );
+            return seed;
+        }
+    };
+
+    std::unordered_map<KEY, std::shared_ptr<SHAPE>, KEY_HASH>               m_shapes;
+    std::unordered_map<const BOARD_ITEM*, std::shared_ptr<SHAPE_SEGMENT>> m_holes;
+};
+
+#endif // DRC_SHAPE_CACHE_H
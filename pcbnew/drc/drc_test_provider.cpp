@@ -80,7 +80,24 @@ void DRC_TEST_PROVIDER::reportViolation( std::shared_ptr<DRC_ITEM>& item,
         accountCheck( item->GetViolatingRule() );
 
     item->SetViolatingTest( this );
-    m_drcEngine->ReportViolation( item, aMarkerPos, aMarkerLayer );
+
+    if( m_deferViolations )
+        m_deferredViolations.push_back( { item, aMarkerPos, aMarkerLayer } );
+    else
+        m_drcEngine->ReportViolation( item, aMarkerPos, aMarkerLayer );
+}
+
+
+void DRC_TEST_PROVIDER::FlushViolations()
+{
+    for( const DEFERRED_VIOLATION& violation : m_deferredViolations )
+    {
+        // The limit may have been reached by the providers flushed before this one
+        if( !m_drcEngine->IsErrorLimitExceeded( violation.m_item->GetErrorCode() ) )
+            m_drcEngine->ReportViolation( violation.m_item, violation.m_pos, violation.m_layer );
+    }
+
+    m_deferredViolations.clear();
 }
 
 
@@ -157,6 +174,13 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
     std::bitset<MAX_STRUCT_TYPE_ID> typeMask;
     int n = 0;
 
+    auto visit =
+            [&]( BOARD_ITEM* aItem ) -> bool
+            {
+                DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_itemsTested );
+                return aFunc( aItem );
+            };
+
     if( aTypes.size() == 0 )
     {
         for( int i = 0; i < MAX_STRUCT_TYPE_ID; i++ )
@@ -174,17 +198,17 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             if( typeMask[ PCB_TRACE_T ] && item->Type() == PCB_TRACE_T )
             {
-                aFunc( item );
+                visit( item );
                 n++;
             }
             else if( typeMask[ PCB_VIA_T ] && item->Type() == PCB_VIA_T )
             {
-                aFunc( item );
+                visit( item );
                 n++;
             }
             else if( typeMask[ PCB_ARC_T ] && item->Type() == PCB_ARC_T )
             {
-                aFunc( item );
+                visit( item );
                 n++;
             }
         }
@@ -196,35 +220,35 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             if( typeMask[ PCB_DIMENSION_T ] && BaseType( item->Type() ) == PCB_DIMENSION_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
             }
             else if( typeMask[ PCB_SHAPE_T ] && item->Type() == PCB_SHAPE_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
             }
             else if( typeMask[ PCB_TEXT_T ] && item->Type() == PCB_TEXT_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
             }
             else if( typeMask[ PCB_TEXTBOX_T ] && item->Type() == PCB_TEXTBOX_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
             }
             else if( typeMask[ PCB_TARGET_T ] && item->Type() == PCB_TARGET_T )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
@@ -238,7 +262,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             if( ( item->GetLayerSet() & aLayers ).any() )
             {
-                if( !aFunc( item ) )
+                if( !visit( item ) )
                     return n;
 
                 n++;
@@ -254,7 +278,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             {
                 if( ( field->GetLayerSet() & aLayers ).any() )
                 {
-                    if( !aFunc( field ) )
+                    if( !visit( field ) )
                         return n;
 
                     n++;
@@ -269,7 +293,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
                 // Careful: if a pad has a hole then it pierces all layers
                 if( pad->HasHole() || ( pad->GetLayerSet() & aLayers ).any() )
                 {
-                    if( !aFunc( pad ) )
+                    if( !visit( pad ) )
                         return n;
 
                     n++;
@@ -283,28 +307,28 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             {
                 if( typeMask[ PCB_DIMENSION_T ] && BaseType( dwg->Type() ) == PCB_DIMENSION_T )
                 {
-                    if( !aFunc( dwg ) )
+                    if( !visit( dwg ) )
                         return n;
 
                     n++;
                 }
                 else if( typeMask[ PCB_TEXT_T ] && dwg->Type() == PCB_TEXT_T )
                 {
-                    if( !aFunc( dwg ) )
+                    if( !visit( dwg ) )
                         return n;
 
                     n++;
                 }
                 else if( typeMask[ PCB_TEXTBOX_T ] && dwg->Type() == PCB_TEXTBOX_T )
                 {
-                    if( !aFunc( dwg ) )
+                    if( !visit( dwg ) )
                         return n;
 
                     n++;
                 }
                 else if( typeMask[ PCB_SHAPE_T ] && dwg->Type() == PCB_SHAPE_T )
                 {
-                    if( !aFunc( dwg ) )
+                    if( !visit( dwg ) )
                         return n;
 
                     n++;
@@ -318,7 +342,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             {
                 if( (zone->GetLayerSet() & aLayers).any() )
                 {
-                    if( !aFunc( zone ) )
+                    if( !visit( zone ) )
                         return n;
 
                     n++;
@@ -328,7 +352,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
 
         if( typeMask[ PCB_FOOTPRINT_T ] )
         {
-            if( !aFunc( footprint ) )
+            if( !visit( footprint ) )
                 return n;
 
             n++;
@@ -351,6 +375,20 @@ bool DRC_TEST_PROVIDER::isInvisibleText( const BOARD_ITEM* aItem ) const
 }
 
 
+std::shared_ptr<SHAPE> DRC_TEST_PROVIDER::getEffectiveShape( const BOARD_ITEM* aItem,
+                                                             PCB_LAYER_ID aLayer,
+                                                             FLASHING aFlash ) const
+{
+    return m_drcEngine->GetShapeCache().GetEffectiveShape( aItem, aLayer, aFlash );
+}
+
+
+std::shared_ptr<SHAPE_SEGMENT> DRC_TEST_PROVIDER::getEffectiveHoleShape( const BOARD_ITEM* aItem ) const
+{
+    return m_drcEngine->GetShapeCache().GetEffectiveHoleShape( aItem );
+}
+
+
 wxString DRC_TEST_PROVIDER::formatMsg( const wxString& aFormatString, const wxString& aSource,
                                        double aConstraint, double aActual )
 {
@@ -27,6 +27,7 @@
 
 #include <board.h>
 #include <pcb_marker.h>
+#include <drc/drc_profile.h>
 
 #include <functional>
 #include <set>
@@ -35,6 +36,8 @@ class DRC_ENGINE;
 class DRC_TEST_PROVIDER;
 class DRC_RULE;
 class DRC_CONSTRAINT;
+class SHAPE;
+class SHAPE_SEGMENT;
 
 class DRC_TEST_PROVIDER_REGISTRY
 {
@@ -99,6 +102,29 @@ public:
     virtual const wxString GetName() const;
     virtual const wxString GetDescription() const;
 
+    /**
+     * Providers which are single-threaded, and share no state with the other providers
+     * besides the DRC engine's, may be run concurrently with each other.
+     */
+    virtual bool RunsConcurrently() const { return false; }
+
+    /**
+     * Hold the violations back until FlushViolations(), so that providers run concurrently
+     * still report in a stable order.
+     */
+    void SetDeferViolations( bool aDefer ) { m_deferViolations = aDefer; }
+    void FlushViolations();
+
+    /**
+     * The counters of the last run, when the DRC engine was profiling.
+     */
+    DRC_PROFILE_COUNTERS& Profile() { return m_profile; }
+
+    /**
+     * @return the number of checks (or violations, depending on the provider) of each rule.
+     */
+    const std::unordered_map<const DRC_RULE*, int>& GetRuleStatistics() const { return m_stats; }
+
 protected:
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, LSET aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
@@ -119,6 +145,13 @@ protected:
 
     bool isInvisibleText( const BOARD_ITEM* aItem ) const;
 
+    /**
+     * The effective shapes of \a aItem, from the DRC engine's shape cache when they are cached.
+     */
+    std::shared_ptr<SHAPE> getEffectiveShape( const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer,
+                                              FLASHING aFlash = FLASHING::DEFAULT ) const;
+    std::shared_ptr<SHAPE_SEGMENT> getEffectiveHoleShape( const BOARD_ITEM* aItem ) const;
+
     wxString formatMsg( const wxString& aFormatString, const wxString& aSource, double aConstraint,
                         double aActual );
 
@@ -133,6 +166,19 @@ protected:
     std::unordered_map<const DRC_RULE*, int> m_stats;
     bool        m_isRuleDriven = true;
     std::mutex  m_statsMutex;
+
+private:
+    struct DEFERRED_VIOLATION
+    {
+        std::shared_ptr<DRC_ITEM> m_item;
+        VECTOR2I                  m_pos;
+        int                       m_layer;
+    };
+
+    bool                            m_deferViolations = false;
+    std::vector<DEFERRED_VIOLATION> m_deferredViolations;
+
+    DRC_PROFILE_COUNTERS            m_profile;
 };
 
 #endif // DRC_TEST_PROVIDER__H
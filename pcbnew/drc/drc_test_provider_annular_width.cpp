@@ -168,6 +168,8 @@ public:
     {
         return wxT( "Tests pad/via annular rings" );
     }
+
+    bool RunsConcurrently() const override { return true; }
 };
 
 
@@ -25,6 +25,7 @@
 #include <atomic>
 #include <deque>
 #include <optional>
+#include <unordered_set>
 #include <utility>
 
 #include <wx/debug.h>
@@ -130,7 +131,7 @@ public:
         m_vertices.front().updateList();
 
         Vertex* p = m_vertices.front().next;
-        std::set<Vertex*> all_hits;
+        std::unordered_set<Vertex*> all_hits;
 
         while( p != &m_vertices.front() )
         {
@@ -266,13 +267,26 @@ private:
 
             Vertex* prev_elem = nullptr;
 
+            parent->m_zVertices.clear();
+            parent->m_zX.clear();
+            parent->m_zY.clear();
+            parent->m_zZ.clear();
+            parent->m_zI.clear();
+
             for( Vertex* elem : queue )
             {
                 if( prev_elem )
                     prev_elem->nextZ = elem;
 
                 elem->prevZ = prev_elem;
+                elem->zIndex = parent->m_zVertices.size();
                 prev_elem = elem;
+
+                parent->m_zVertices.push_back( elem );
+                parent->m_zX.push_back( elem->x );
+                parent->m_zY.push_back( elem->y );
+                parent->m_zZ.push_back( elem->z );
+                parent->m_zI.push_back( elem->i );
             }
 
             prev_elem->nextZ = nullptr;
@@ -293,6 +307,9 @@ private:
         // previous and next nodes in z-order
         Vertex* prevZ = nullptr;
         Vertex* nextZ = nullptr;
+
+        // position in the z-ordered arrays
+        size_t zIndex = 0;
     };
 
     /**
@@ -504,46 +521,53 @@ private:
         const int32_t     maxZ = zOrder( aPt->x + m_limit, aPt->y + m_limit );
         const int32_t     minZ = zOrder( aPt->x - m_limit, aPt->y - m_limit );
         const SEG::ecoord limit2 = SEG::Square( m_limit );
+        const size_t      self = aPt->zIndex;
 
-        // first look for points in increasing z-order
-        Vertex* p = aPt->nextZ;
-        SEG::ecoord min_dist = std::numeric_limits<SEG::ecoord>::max();
-        Vertex* retval = nullptr;
+        // The z-ordered coordinates are contiguous, so the distance filter runs over flat
+        // arrays.  Only the candidates close enough get the (much more expensive) shape tests,
+        // nearest first, so that the search stops at the first one which passes.
+        m_candidates.clear();
 
-        while( p && p->z <= maxZ )
-        {
-            int delta_i = std::abs( p->i - aPt->i );
-            VECTOR2D diff( p->x - aPt->x, p->y - aPt->y );
-            SEG::ecoord dist2 = diff.SquaredEuclideanNorm();
+        auto collect =
+                [&]( size_t aIdx )
+                {
+                    int      delta_i = std::abs( m_zI[aIdx] - aPt->i );
+                    VECTOR2D diff( m_zX[aIdx] - aPt->x, m_zY[aIdx] - aPt->y );
+                    SEG::ecoord dist2 = diff.SquaredEuclideanNorm();
 
-            if( delta_i > 1 && dist2 < limit2 && dist2 < min_dist && dist2 > 0
-                    && locallyInside( p, aPt ) && isSubstantial( p, aPt ) && isSubstantial( aPt, p ) )
-            {
-                min_dist = dist2;
-                retval = p;
-            }
+                    if( delta_i > 1 && dist2 < limit2 && dist2 > 0 )
+                        m_candidates.emplace_back( dist2, aIdx );
+                };
 
-            p = p->nextZ;
-        }
+        // first look for points in increasing z-order...
+        size_t last = std::upper_bound( m_zZ.begin() + self, m_zZ.end(), maxZ ) - m_zZ.begin();
 
-        p = aPt->prevZ;
+        for( size_t ii = self + 1; ii < last; ++ii )
+            collect( ii );
 
-        while( p && p->z >= minZ )
-        {
-            int delta_i = std::abs( p->i - aPt->i );
-            VECTOR2D diff( p->x - aPt->x, p->y - aPt->y );
-            SEG::ecoord dist2 = diff.SquaredEuclideanNorm();
+        // ... then in decreasing z-order
+        size_t first = std::lower_bound( m_zZ.begin(), m_zZ.begin() + self, minZ ) - m_zZ.begin();
 
-            if( delta_i > 1 && dist2 < limit2 && dist2 < min_dist && dist2 > 0
-                    && locallyInside( p, aPt ) && isSubstantial( p, aPt ) && isSubstantial( aPt, p ) )
-            {
-                min_dist = dist2;
-                retval = p;
-            }
+        for( size_t ii = self; ii-- > first; )
+            collect( ii );
+
+        // Keep the scan order between candidates at the same distance
+        std::stable_sort( m_candidates.begin(), m_candidates.end(),
+                          []( const std::pair<SEG::ecoord, size_t>& a,
+                              const std::pair<SEG::ecoord, size_t>& b )
+                          {
+                              return a.first < b.first;
+                          } );
+
+        for( const auto& [ dist2, idx ] : m_candidates )
+        {
+            Vertex* p = m_zVertices[idx];
 
-            p = p->prevZ;
+            if( locallyInside( p, aPt ) && isSubstantial( p, aPt ) && isSubstantial( aPt, p ) )
+                return p;
         }
-        return retval;
+
+        return nullptr;
     }
 
 
@@ -608,6 +632,15 @@ private:
     BOX2I                           m_bbox;
     std::deque<Vertex>              m_vertices;
     std::set<std::pair<int, int>>   m_hits;
+
+    // The vertices in z-order, with their coordinates, z-order values and outline indices
+    std::vector<Vertex*>            m_zVertices;
+    std::vector<double>             m_zX;
+    std::vector<double>             m_zY;
+    std::vector<int32_t>            m_zZ;
+    std::vector<int>                m_zI;
+
+    mutable std::vector<std::pair<SEG::ecoord, size_t>> m_candidates;
 };
 
 
@@ -699,16 +732,16 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
      * Examine all necks in a given polygonSet which fail a given minWidth.
      */
     auto min_checker =
-            [&]( const ITEMS_POLY& aItemsPoly, const PCB_LAYER_ID aLayer, int aMinWidth ) -> size_t
+            [&]( const ITEMS_POLY* aItemsPoly, const PCB_LAYER_ID aLayer, int aMinWidth ) -> size_t
             {
                 if( m_drcEngine->IsCancelled() )
                     return 0;
 
                 POLYGON_TEST test( aMinWidth );
 
-                for( int ii = 0; ii < aItemsPoly.Poly.OutlineCount(); ++ii )
+                for( int ii = 0; ii < aItemsPoly->Poly.OutlineCount(); ++ii )
                 {
-                    const SHAPE_LINE_CHAIN& chain = aItemsPoly.Poly.COutline( ii );
+                    const SHAPE_LINE_CHAIN& chain = aItemsPoly->Poly.COutline( ii );
 
                     test.FindPairs( chain );
                     auto& ret = test.GetVertices();
@@ -784,7 +817,7 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
                     }
                 }
 
-                done.fetch_add( calc_effort( aItemsPoly.Items, aLayer ) );
+                done.fetch_add( calc_effort( aItemsPoly->Items, aLayer ) );
 
                 return 1;
             };
@@ -860,7 +893,8 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
             if( ( minWidth -= epsilon ) <= 0 )
                 continue;
 
-            returns.emplace_back( tp.submit( min_checker, itemsPoly, netLayer.Layer, minWidth ) );
+            // The polygons are shared by all the minimum widths: don't copy them
+            returns.emplace_back( tp.submit( min_checker, &itemsPoly, netLayer.Layer, minWidth ) );
         }
     }
 
@@ -31,6 +31,7 @@
 #include <core/thread_pool.h>
 #include <zone.h>
 
+#include <geometry/packed_rtree.h>
 #include <geometry/seg.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
@@ -43,6 +44,7 @@
 #include <pcb_dimension.h>
 
 #include <future>
+#include <optional>
 
 /*
     Copper clearance test. Checks all copper items (pads, vias, tracks, drawings, zones) for their
@@ -214,7 +216,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testSingleLayerItemAgainstItem( BOARD_C
     if( BOARD_CONNECTED_ITEM* connectedItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( other ) )
         otherNet = connectedItem->GetNetCode();
 
-    std::shared_ptr<SHAPE> otherShape = other->GetEffectiveShape( layer );
+    std::shared_ptr<SHAPE> otherShape = getEffectiveShape( other, layer );
 
     if( other->Type() == PCB_PAD_T )
     {
@@ -253,6 +255,8 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testSingleLayerItemAgainstItem( BOARD_C
             }
         }
 
+        DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
         if( itemShape->Collide( otherShape.get(), clearance - m_drcEpsilon, &actual, &pos ) )
         {
             if( m_drcEngine->IsNetTieExclusion( item->GetNetCode(), layer, pos, other ) )
@@ -317,11 +321,11 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::testSingleLayerItemAgainstItem( BOARD_C
             if( b[ii]->Type() == PCB_VIA_T )
             {
                 if( b[ii]->GetLayerSet().Contains( layer ) )
-                    holeShape = b[ii]->GetEffectiveHoleShape();
+                    holeShape = getEffectiveHoleShape( b[ii] );
             }
             else
             {
-                holeShape = b[ii]->GetEffectiveHoleShape();
+                holeShape = getEffectiveHoleShape( b[ii] );
             }
 
             constraint = m_drcEngine->EvalRules( HOLE_CLEARANCE_CONSTRAINT, b[ii], a[ii], layer );
@@ -447,7 +451,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
 
     if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance > 0 )
     {
-        std::shared_ptr<SHAPE> itemShape = aItem->GetEffectiveShape( aLayer, FLASHING::DEFAULT );
+        std::shared_ptr<SHAPE> itemShape = getEffectiveShape( aItem, aLayer, FLASHING::DEFAULT );
 
         if( zoneTree->QueryColliding( itemBBox, itemShape.get(), aLayer,
                                       std::max( 0, clearance - m_drcEpsilon ), &actual, &pos ) )
@@ -473,11 +477,11 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testItemAgainstZone( BOARD_ITEM* aItem,
         if( aItem->Type() == PCB_VIA_T )
         {
             if( aItem->GetLayerSet().Contains( aLayer ) )
-                holeShape = aItem->GetEffectiveHoleShape();
+                holeShape = getEffectiveHoleShape( aItem );
         }
         else
         {
-            holeShape = aItem->GetEffectiveHoleShape();
+            holeShape = getEffectiveHoleShape( aItem );
         }
 
         if( holeShape )
@@ -611,9 +615,15 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
         {
             PCB_TRACK* track = m_board->Tracks()[trackIdx];
 
+            if( !m_drcEngine->IsInIncrementalScope( track ) )
+            {
+                done.fetch_add( 1 );
+                continue;
+            }
+
             for( PCB_LAYER_ID layer : LSET( track->GetLayerSet() & boardCopperLayers ).Seq() )
             {
-                std::shared_ptr<SHAPE> trackShape = track->GetEffectiveShape( layer );
+                std::shared_ptr<SHAPE> trackShape = getEffectiveShape( track, layer );
 
                 m_board->m_CopperItemRTreeCache->QueryColliding( track, layer, layer,
                         // Filter:
@@ -654,7 +664,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 
                             if( other->Type() == PCB_PAD_T && static_cast<PAD*>( other )->IsFreePad() )
                             {
-                                if( other->GetEffectiveShape( layer )->Collide( trackShape.get() ) )
+                                if( getEffectiveShape( other, layer )->Collide( trackShape.get() ) )
                                 {
                                     std::lock_guard<std::mutex> lock( freePadsUsageMapMutex );
                                     auto it = freePadsUsageMap.find( other );
@@ -804,7 +814,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
     if( !testClearance && !testShorting && !testHoles )
         return;
 
-    std::shared_ptr<SHAPE> otherShape = other->GetEffectiveShape( aLayer );
+    std::shared_ptr<SHAPE> otherShape = getEffectiveShape( other, aLayer );
     DRC_CONSTRAINT         constraint;
     int                    clearance = 0;
     int                    actual = 0;
@@ -849,6 +859,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
 
         if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance > 0 )
         {
+            DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
             if( padShape->Collide( otherShape.get(), std::max( 0, clearance - m_drcEpsilon ),
                                    &actual, &pos ) )
             {
@@ -902,7 +914,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
 
     if( testHoles && otherPad && pad->FlashLayer( aLayer ) && otherPad->HasHole() )
     {
-        if( clearance > 0 && padShape->Collide( otherPad->GetEffectiveHoleShape().get(),
+        if( clearance > 0 && padShape->Collide( getEffectiveHoleShape( otherPad ).get(),
                                                 std::max( 0, clearance - m_drcEpsilon ),
                                                 &actual, &pos ) )
         {
@@ -923,7 +935,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
 
     if( testHoles && otherPad && otherPad->FlashLayer( aLayer ) && pad->HasHole() )
     {
-        if( clearance > 0 && otherShape->Collide( pad->GetEffectiveHoleShape().get(),
+        if( clearance > 0 && otherShape->Collide( getEffectiveHoleShape( pad ).get(),
                                                   std::max( 0, clearance - m_drcEpsilon ),
                                                   &actual, &pos ) )
         {
@@ -944,7 +956,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadAgainstItem( PAD* pad, SHAPE* pa
 
     if( testHoles && otherVia && otherVia->IsOnLayer( aLayer ) )
     {
-        if( clearance > 0 && padShape->Collide( otherVia->GetEffectiveHoleShape().get(),
+        if( clearance > 0 && padShape->Collide( getEffectiveHoleShape( otherVia ).get(),
                                                 std::max( 0, clearance - m_drcEpsilon ),
                                                 &actual, &pos ) )
         {
@@ -986,12 +998,18 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
                 {
                     for( PAD* pad : footprint->Pads() )
                     {
+                        if( !m_drcEngine->IsInIncrementalScope( pad ) )
+                        {
+                            done.fetch_add( 1 );
+                            continue;
+                        }
+
                         for( PCB_LAYER_ID layer : LSET( pad->GetLayerSet() & boardCopperLayers ).Seq() )
                         {
                             if( m_drcEngine->IsCancelled() )
                                 return;
 
-                            std::shared_ptr<SHAPE> padShape = pad->GetEffectiveShape( layer );
+                            std::shared_ptr<SHAPE> padShape = getEffectiveShape( pad, layer );
 
                             m_board->m_CopperItemRTreeCache->QueryColliding( pad, layer, layer,
                                     // Filter:
@@ -1165,10 +1183,13 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
             {
                 for( BOARD_ITEM* item : m_board->Drawings() )
                 {
-                    testGraphicAgainstZone( item );
+                    if( m_drcEngine->IsInIncrementalScope( item ) )
+                    {
+                        testGraphicAgainstZone( item );
 
-                    if( item->Type() == PCB_SHAPE_T && item->IsOnCopperLayer() )
-                        testCopperGraphic( static_cast<PCB_SHAPE*>( item ) );
+                        if( item->Type() == PCB_SHAPE_T && item->IsOnCopperLayer() )
+                            testCopperGraphic( static_cast<PCB_SHAPE*>( item ) );
+                    }
 
                     done.fetch_add( 1 );
 
@@ -1180,7 +1201,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
                 {
                     for( BOARD_ITEM* item : footprint->GraphicalItems() )
                     {
-                        testGraphicAgainstZone( item );
+                        if( m_drcEngine->IsInIncrementalScope( item ) )
+                            testGraphicAgainstZone( item );
 
                         done.fetch_add( 1 );
 
@@ -1209,6 +1231,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
     std::vector<std::map<PCB_LAYER_ID, std::vector<SEG>>> poly_segments;
     poly_segments.resize( m_board->m_DRCCopperZones.size() );
 
+    // The segments of each fill, bulk-loaded into packed R-trees: their leaves are compact
+    // tiles of the fill outline, so a segment is only tested against the nearby fragments of
+    // the other fill rather than against the whole of it
+    std::vector<std::map<PCB_LAYER_ID, PACKED_RTREE<size_t>>> poly_tiles;
+    poly_tiles.resize( m_board->m_DRCCopperZones.size() );
+
     // Contains the index for zoneA, zoneB, the conflict point, the actual clearance, the
     // required clearance, and the layer
     using report_data = std::tuple<int, int, VECTOR2I, int, int, PCB_LAYER_ID>;
@@ -1218,66 +1246,71 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
     std::atomic<size_t>                   done( 1 );
 
     auto checkZones =
-            [this, testClearance, testIntersects, &poly_segments, &done]
+            [this, testClearance, testIntersects, &poly_segments, &poly_tiles, &done]
             ( int zoneA, int zoneB, int clearance, PCB_LAYER_ID layer ) -> report_data
             {
-                // Iterate through all the segments of refSmoothedPoly
-                std::map<VECTOR2I, int> conflictPoints;
-
-                std::vector<SEG>& refSegments = poly_segments[zoneA][layer];
-                std::vector<SEG>& testSegments = poly_segments[zoneB][layer];
-                bool reported = false;
+                const std::vector<SEG>& refSegments = poly_segments[zoneA].at( layer );
+                const std::vector<SEG>& testSegments = poly_segments[zoneB].at( layer );
                 auto invalid_result = std::make_tuple( -1, -1, VECTOR2I(), 0, 0, F_Cu );
 
-                for( SEG& refSegment : refSegments )
-                {
-                    int ax1 = refSegment.A.x;
-                    int ay1 = refSegment.A.y;
-                    int ax2 = refSegment.B.x;
-                    int ay2 = refSegment.B.y;
+                // Walk the fill with fewer segments, and look up the nearby segments of the
+                // other one in its tiles
+                const bool              walkRef = refSegments.size() <= testSegments.size();
+                const std::vector<SEG>& walked = walkRef ? refSegments : testSegments;
+                const std::vector<SEG>& others = walkRef ? testSegments : refSegments;
+                const PACKED_RTREE<size_t>& otherTiles =
+                        poly_tiles[walkRef ? zoneB : zoneA].at( layer );
 
-                    // Iterate through all the segments in smoothed_polys[ia2]
-                    for( SEG& testSegment : testSegments )
-                    {
-                        // Build test segment
-                        VECTOR2I pt;
-
-                        int bx1 = testSegment.A.x;
-                        int by1 = testSegment.A.y;
-                        int bx2 = testSegment.B.x;
-                        int by2 = testSegment.B.y;
-
-                        // We have ensured that the 'A' segment starts before the 'B' segment,
-                        // so if the 'A' segment ends before the 'B' segment starts, we can skip
-                        // to the next 'A'
-                        if( ax2 < bx1 )
-                            break;
+                std::optional<report_data> conflict;
 
-                        int d = GetClearanceBetweenSegments( bx1, by1, bx2, by2, 0,
-                                                             ax1, ay1, ax2, ay2, 0,
-                                                             clearance, &pt.x, &pt.y );
+                for( const SEG& walkedSegment : walked )
+                {
+                    BOX2I bbox( walkedSegment.A );
+                    bbox.Merge( walkedSegment.B );
+                    bbox.Inflate( clearance );
 
-                        if( d < clearance )
-                        {
-                            if( d == 0 && testIntersects )
-                                reported = true;
-                            else if( testClearance )
-                                reported = true;
+                    const int min[2] = { bbox.GetX(), bbox.GetY() };
+                    const int max[2] = { bbox.GetRight(), bbox.GetBottom() };
 
-                            if( reported )
+                    auto visitor =
+                            [&]( size_t aIndex ) -> bool
                             {
-                                done.fetch_add( 1 );
-                                return std::make_tuple( zoneA, zoneB, pt, d, clearance, layer );
-                            }
-                        }
+                                const SEG& refSegment = walkRef ? walkedSegment : others[aIndex];
+                                const SEG& testSegment = walkRef ? others[aIndex] : walkedSegment;
+                                VECTOR2I   pt;
+
+                                int d = GetClearanceBetweenSegments( testSegment.A.x,
+                                                                     testSegment.A.y,
+                                                                     testSegment.B.x,
+                                                                     testSegment.B.y, 0,
+                                                                     refSegment.A.x,
+                                                                     refSegment.A.y,
+                                                                     refSegment.B.x,
+                                                                     refSegment.B.y, 0,
+                                                                     clearance, &pt.x, &pt.y );
+
+                                if( d < clearance
+                                        && ( ( d == 0 && testIntersects ) || testClearance ) )
+                                {
+                                    conflict = std::make_tuple( zoneA, zoneB, pt, d, clearance,
+                                                                layer );
+                                    return false;
+                                }
 
-                        if( m_drcEngine->IsCancelled() )
-                            return invalid_result;
-                    }
+                                return true;
+                            };
+
+                    otherTiles.Search( min, max, visitor );
+
+                    if( conflict )
+                        break;
+
+                    if( m_drcEngine->IsCancelled() )
+                        return invalid_result;
                 }
 
                 done.fetch_add( 1 );
-                return invalid_result;
+                return conflict ? *conflict : invalid_result;
             };
 
     for( int layer_id = F_Cu; layer_id <= B_Cu; ++layer_id )
@@ -1293,23 +1326,30 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
         {
             if( m_board->m_DRCCopperZones[ii]->IsOnLayer( layer ) )
             {
-                SHAPE_POLY_SET poly = *m_board->m_DRCCopperZones[ii]->GetFilledPolysList( layer );
-                std::vector<SEG>& zone_layer_poly_segs = poly_segments[ii][layer];
+                const std::shared_ptr<SHAPE_POLY_SET>& poly =
+                        m_board->m_DRCCopperZones[ii]->GetFilledPolysList( layer );
+                std::vector<SEG>&     zone_layer_poly_segs = poly_segments[ii][layer];
+                PACKED_RTREE<size_t>& zone_layer_poly_tiles = poly_tiles[ii][layer];
 
-                poly.BuildBBoxCaches();
-                zone_layer_poly_segs.reserve( poly.FullPointCount() );
+                zone_layer_poly_segs.reserve( poly->FullPointCount() );
 
-                for( auto it = poly.IterateSegmentsWithHoles(); it; it++ )
-                {
-                    SEG seg = *it;
+                for( auto it = poly->CIterateSegmentsWithHoles(); it; it++ )
+                    zone_layer_poly_segs.push_back( *it );
 
-                    if( seg.A.x > seg.B.x )
-                        seg.Reverse();
+                zone_layer_poly_tiles.Reserve( zone_layer_poly_segs.size() );
+
+                for( size_t jj = 0; jj < zone_layer_poly_segs.size(); ++jj )
+                {
+                    const SEG& seg = zone_layer_poly_segs[jj];
+                    const int  min[2] = { std::min( seg.A.x, seg.B.x ),
+                                          std::min( seg.A.y, seg.B.y ) };
+                    const int  max[2] = { std::max( seg.A.x, seg.B.x ),
+                                          std::max( seg.A.y, seg.B.y ) };
 
-                    zone_layer_poly_segs.push_back( seg );
+                    zone_layer_poly_tiles.Add( min, max, jj );
                 }
 
-                std::sort( zone_layer_poly_segs.begin(), zone_layer_poly_segs.end() );
+                zone_layer_poly_tiles.Build();
             }
         }
 
@@ -1339,8 +1379,10 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                     continue;
 
                 // Examine a candidate zone: compare zoneB to zoneA
-                SHAPE_POLY_SET* polyA = m_board->m_DRCCopperZones[ia]->GetFill( layer );
-                SHAPE_POLY_SET* polyB = m_board->m_DRCCopperZones[ia2]->GetFill( layer );
+                const SHAPE_POLY_SET* polyA =
+                        m_board->m_DRCCopperZones[ia]->GetFilledPolysList( layer ).get();
+                const SHAPE_POLY_SET* polyB =
+                        m_board->m_DRCCopperZones[ia2]->GetFilledPolysList( layer ).get();
 
                 if( !polyA->BBoxFromCaches().Intersects( polyB->BBoxFromCaches() ) )
                     continue;
@@ -223,6 +223,8 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
 
                 if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
                 {
+                    DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                     if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
                     {
                         auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
@@ -255,6 +257,8 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
 
                 if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
                 {
+                    DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                     if( backA.Collide( &backB, clearance, &actual, &pos ) )
                     {
                         auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
@@ -290,7 +290,7 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                 if( !reportProgress( ii++, count, progressDelta ) )
                     return false;       // DRC cancelled; we're done
 
-                if( isInvisibleText( item ) )
+                if( isInvisibleText( item ) || !m_drcEngine->IsInIncrementalScope( item ) )
                     return true;        // Continue with other items
 
                 if( item->Type() == PCB_PAD_T )
@@ -62,6 +62,8 @@ public:
         return wxT( "Tests sizes of drilled holes (via/pad drills)" );
     }
 
+    bool RunsConcurrently() const override { return true; }
+
 private:
     void checkViaHole( PCB_VIA* via, bool aExceedMicro, bool aExceedStd );
     void checkPadHole( PAD* aPad );
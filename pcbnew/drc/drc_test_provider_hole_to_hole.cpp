@@ -28,11 +28,11 @@
 #include <pcb_track.h>
 #include <geometry/shape_segment.h>
 #include <geometry/shape_circle.h>
+#include <geometry/circle_grid_index.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <drc/drc_rule.h>
 #include <drc/drc_test_provider_clearance_base.h>
-#include "drc_rtree.h"
 
 /*
     Holes clearance test. Checks pad and via holes for their mechanical clearances.
@@ -67,12 +67,14 @@ public:
         return wxT( "Tests hole to hole spacing" );
     }
 
+    bool RunsConcurrently() const override { return true; }
+
 private:
     bool testHoleAgainstHole( BOARD_ITEM* aItem, SHAPE_CIRCLE* aHole, BOARD_ITEM* aOther );
 
-    BOARD*    m_board;
-    DRC_RTREE m_holeTree;
-    int       m_largestHoleToHoleClearance;
+    BOARD*                          m_board;
+    CIRCLE_GRID_INDEX<BOARD_ITEM*>  m_drillIndex;
+    int                             m_largestHoleToHoleClearance;
 };
 
 
@@ -124,7 +126,7 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
     size_t       count = 0;
     size_t       ii = 0;
 
-    m_holeTree.clear();
+    m_drillIndex.Clear();
 
     forEachGeometryItem( { PCB_PAD_T, PCB_VIA_T }, LSET::AllLayersMask(),
             [&]( BOARD_ITEM* item ) -> bool
@@ -133,8 +135,11 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
                 return true;
             } );
 
-    count *= 2;  // One for adding to the rtree; one for checking
+    m_drillIndex.Reserve( count );
+    count *= 2;  // One for adding to the index; one for checking
 
+    // Drills are circles of similar sizes, so a uniform grid finds the neighbours of each one
+    // faster than an R-tree.  Vias are added before pads, in board order.
     forEachGeometryItem( { PCB_PAD_T, PCB_VIA_T }, LSET::AllLayersMask(),
             [&]( BOARD_ITEM* item ) -> bool
             {
@@ -147,26 +152,61 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
 
                     // Slots are generally milled _after_ drilling, so we ignore them.
                     if( pad->GetDrillSize().x && pad->GetDrillSize().x == pad->GetDrillSize().y )
-                        m_holeTree.Insert( item, Edge_Cuts, m_largestHoleToHoleClearance );
+                    {
+                        std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
+                        m_drillIndex.Add( hole->GetSeg().A, hole->GetWidth() / 2, item );
+                    }
                 }
                 else if( item->Type() == PCB_VIA_T )
                 {
                     // Blind/buried/microvias will be drilled/burned _prior_ to lamination, so
                     // subsequently drilled holes need to avoid them.
-                    m_holeTree.Insert( item, Edge_Cuts, m_largestHoleToHoleClearance );
+                    PCB_VIA* via = static_cast<PCB_VIA*>( item );
+                    m_drillIndex.Add( via->GetStart(), via->GetDrillValue() / 2, item );
                 }
 
                 return true;
             } );
 
-    std::unordered_map<PTR_PTR_CACHE_KEY, int> checkedPairs;
+    if( m_drcEngine->IsCancelled() )
+        return false;
+
+    m_drillIndex.Build( m_largestHoleToHoleClearance );
+
+    // Each pair is reported once by the via pass (when one of its holes is a via), and once by
+    // the pad pass (when one of its holes is a pad).
+    std::vector<bool>   tested( m_drillIndex.size(), false );
+    std::vector<size_t> neighbours;
+
+    auto testDrill =
+            [&]( size_t aIdx ) -> bool
+            {
+                BOARD_ITEM*                   item = m_drillIndex.Data( aIdx );
+                std::shared_ptr<SHAPE_CIRCLE> holeShape = getDrilledHoleShape( item );
+
+                m_drillIndex.Query( m_drillIndex.Center( aIdx ), m_drillIndex.Radius( aIdx ),
+                                    m_largestHoleToHoleClearance, neighbours );
+
+                tested[ aIdx ] = true;
+
+                for( size_t other : neighbours )
+                {
+                    if( other == aIdx || tested[ other ] )
+                        continue;
 
-    for( PCB_TRACK* track : m_board->Tracks() )
+                    if( !testHoleAgainstHole( item, holeShape.get(), m_drillIndex.Data( other ) ) )
+                        return false;
+                }
+
+                return true;
+            };
+
+    for( size_t idx = 0; idx < m_drillIndex.size(); ++idx )
     {
-        if( track->Type() != PCB_VIA_T )
+        if( m_drillIndex.Data( idx )->Type() != PCB_VIA_T )
             continue;
 
-        PCB_VIA* via = static_cast<PCB_VIA*>( track );
+        PCB_VIA* via = static_cast<PCB_VIA*>( m_drillIndex.Data( idx ) );
 
         if( !reportProgress( ii++, count, progressDelta ) )
             return false;   // DRC cancelled
@@ -174,85 +214,22 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
         // We only care about mechanically drilled (ie: non-laser) holes.  These include both
         // blind/buried via holes (drilled prior to lamination) and through-via and drilled pad
         // holes (which are generally drilled post laminataion).
-        if( via->GetViaType() != VIATYPE::MICROVIA )
-        {
-            std::shared_ptr<SHAPE_CIRCLE> holeShape = getDrilledHoleShape( via );
-
-            m_holeTree.QueryColliding( via, Edge_Cuts, Edge_Cuts,
-                    // Filter:
-                    [&]( BOARD_ITEM* other ) -> bool
-                    {
-                        BOARD_ITEM* a = via;
-                        BOARD_ITEM* b = other;
-
-                        // store canonical order so we don't collide in both directions
-                        // (a:b and b:a)
-                        if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                            std::swap( a, b );
-
-                        if( checkedPairs.find( { a, b } ) != checkedPairs.end() )
-                        {
-                            return false;
-                        }
-                        else
-                        {
-                            checkedPairs[ { a, b } ] = 1;
-                            return true;
-                        }
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* other ) -> bool
-                    {
-                        return testHoleAgainstHole( via, holeShape.get(), other );
-                    },
-                    m_largestHoleToHoleClearance );
-        }
+        if( via->GetViaType() != VIATYPE::MICROVIA && m_drcEngine->IsInIncrementalScope( via ) )
+            testDrill( idx );
     }
 
-    checkedPairs.clear();
+    tested.assign( m_drillIndex.size(), false );
 
-    for( FOOTPRINT* footprint : m_board->Footprints() )
+    for( size_t idx = 0; idx < m_drillIndex.size(); ++idx )
     {
-        for( PAD* pad : footprint->Pads() )
-        {
-            if( !reportProgress( ii++, count, progressDelta ) )
-                return false;   // DRC cancelled
+        if( m_drillIndex.Data( idx )->Type() != PCB_PAD_T )
+            continue;
 
-            // We only care about drilled (ie: round) holes
-            if( pad->GetDrillSize().x && pad->GetDrillSize().x == pad->GetDrillSize().y )
-            {
-                std::shared_ptr<SHAPE_CIRCLE> holeShape = getDrilledHoleShape( pad );
-
-                m_holeTree.QueryColliding( pad, Edge_Cuts, Edge_Cuts,
-                        // Filter:
-                        [&]( BOARD_ITEM* other ) -> bool
-                        {
-                            BOARD_ITEM* a = pad;
-                            BOARD_ITEM* b = other;
-
-                            // store canonical order so we don't collide in both directions
-                            // (a:b and b:a)
-                            if( static_cast<void*>( a ) > static_cast<void*>( b ) )
-                                std::swap( a, b );
-
-                            if( checkedPairs.find( { a, b } ) != checkedPairs.end() )
-                            {
-                                return false;
-                            }
-                            else
-                            {
-                                checkedPairs[ { a, b } ] = 1;
-                                return true;
-                            }
-                        },
-                        // Visitor:
-                        [&]( BOARD_ITEM* other ) -> bool
-                        {
-                            return testHoleAgainstHole( pad, holeShape.get(), other );
-                        },
-                        m_largestHoleToHoleClearance );
-            }
-        }
+        if( !reportProgress( ii++, count, progressDelta ) )
+            return false;   // DRC cancelled
+
+        if( m_drcEngine->IsInIncrementalScope( m_drillIndex.Data( idx ) ) )
+            testDrill( idx );
 
         if( m_drcEngine->IsCancelled() )
             return false;
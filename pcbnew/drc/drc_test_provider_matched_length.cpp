@@ -30,6 +30,7 @@
 
 #include <connectivity/connectivity_data.h>
 #include <connectivity/from_to_cache.h>
+#include <connectivity/net_length_cache.h>
 
 
 /*
@@ -282,6 +283,20 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
 
     std::map< DRC_RULE*, std::vector<CONNECTION> > matches;
 
+    // Measure all the constrained nets up front, in parallel
+    std::shared_ptr<NET_LENGTH_CACHE> lengthCache = m_board->GetConnectivity()->GetNetLengthCache();
+    std::set<int>                     netCodes;
+
+    for( const auto& [ rule, items ] : itemSets )
+    {
+        for( BOARD_CONNECTED_ITEM* citem : items )
+            netCodes.insert( citem->GetNetCode() );
+    }
+
+    lengthCache->Update( m_board, std::vector<int>( netCodes.begin(), netCodes.end() ) );
+
+    const bool useHeight = m_board->GetDesignSettings().m_UseHeightForLengthCalcs;
+
     for( const std::pair< DRC_RULE* const, std::set<BOARD_CONNECTED_ITEM*> >& it : itemSets )
     {
         std::map<int, std::set<BOARD_CONNECTED_ITEM*> > netMap;
@@ -305,37 +320,16 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
 
             for( BOARD_CONNECTED_ITEM* citem : nitem.second )
             {
-                if( citem->Type() == PCB_VIA_T )
-                {
-                    const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
-                    const BOARD_STACKUP&         stackup = bds.GetStackupDescriptor();
+                NET_LENGTH_CACHE::ITEM_LENGTH itemLength = lengthCache->GetItemLength( citem );
 
+                if( citem->Type() == PCB_VIA_T )
                     ent.viaCount++;
 
-                    if( bds.m_UseHeightForLengthCalcs )
-                    {
-                        const PCB_VIA* v = static_cast<PCB_VIA*>( citem );
-                        PCB_LAYER_ID   topmost;
-                        PCB_LAYER_ID   bottommost;
+                ent.totalRoute += itemLength.m_track;
+                ent.totalPadToDie += itemLength.m_padToDie;
 
-                        v->GetOutermostConnectedLayers( &topmost, &bottommost );
-
-                        if( topmost != UNDEFINED_LAYER && topmost != bottommost )
-                            ent.totalVia += stackup.GetLayerDistance( topmost, bottommost );
-                    }
-                }
-                else if( citem->Type() == PCB_TRACE_T )
-                {
-                    ent.totalRoute += static_cast<PCB_TRACK*>( citem )->GetLength();
-                }
-                else if ( citem->Type() == PCB_ARC_T )
-                {
-                    ent.totalRoute += static_cast<PCB_ARC*>( citem )->GetLength();
-                }
-                else if( citem->Type() == PCB_PAD_T )
-                {
-                    ent.totalPadToDie += static_cast<PAD*>( citem )->GetPadToDieLength();
-                }
+                if( useHeight )
+                    ent.totalVia += itemLength.m_via;
             }
 
             ent.total = ent.totalRoute + ent.totalVia + ent.totalPadToDie;
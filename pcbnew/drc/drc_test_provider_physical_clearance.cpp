@@ -189,6 +189,9 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
                     if( !reportProgress( ii++, count, progressDelta ) )
                         return false;
 
+                    if( !m_drcEngine->IsInIncrementalScope( item ) )
+                        return true;
+
                     LSET layers = item->GetLayerSet();
 
                     if( item->Type() == PCB_FOOTPRINT_T )
@@ -196,7 +199,7 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
 
                     for( PCB_LAYER_ID layer : layers.Seq() )
                     {
-                        std::shared_ptr<SHAPE> itemShape = item->GetEffectiveShape( layer );
+                        std::shared_ptr<SHAPE> itemShape = getEffectiveShape( item, layer );
 
                         m_itemTree.QueryColliding( item, layer, layer,
                                 // Filter:
@@ -622,7 +625,7 @@ int DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstItem( BOARD_ITEM* aItem
     int            violations = 0;
     VECTOR2I       pos;
 
-    std::shared_ptr<SHAPE> otherShape = other->GetEffectiveShape( aLayer );
+    std::shared_ptr<SHAPE> otherShape = getEffectiveShape( other, aLayer );
 
     if( testClearance )
     {
@@ -632,6 +635,8 @@ int DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstItem( BOARD_ITEM* aItem
 
     if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance > 0 )
     {
+        DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
         if( aItemShape->Collide( otherShape.get(), clearance, &actual, &pos ) )
         {
             std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_CLEARANCE );
@@ -671,11 +676,11 @@ int DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstItem( BOARD_ITEM* aItem
             wxCHECK_MSG( layers.Contains( aLayer ), violations,
                     wxT( "Bug!  Vias should only be checked for layers on which they exist" ) );
 
-            itemHoleShape = aItem->GetEffectiveHoleShape();
+            itemHoleShape = getEffectiveHoleShape( aItem );
         }
         else if( aItem->HasHole() )
         {
-            itemHoleShape = aItem->GetEffectiveHoleShape();
+            itemHoleShape = getEffectiveHoleShape( aItem );
         }
 
         if( other->Type() == PCB_VIA_T )
@@ -694,11 +699,11 @@ int DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstItem( BOARD_ITEM* aItem
             wxCHECK_MSG( layers.Contains( aLayer ), violations,
                     wxT( "Bug!  Vias should only be checked for layers on which they exist" ) );
 
-            otherHoleShape = other->GetEffectiveHoleShape();
+            otherHoleShape = getEffectiveHoleShape( other );
         }
         else if( other->HasHole() )
         {
-            otherHoleShape = other->GetEffectiveHoleShape();
+            otherHoleShape = getEffectiveHoleShape( other );
         }
 
         if( itemHoleShape || otherHoleShape )
@@ -786,7 +791,7 @@ void DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstZones( BOARD_ITEM* aIt
 
         if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance > 0 )
         {
-            std::shared_ptr<SHAPE> itemShape = aItem->GetEffectiveShape( aLayer );
+            std::shared_ptr<SHAPE> itemShape = getEffectiveShape( aItem, aLayer );
 
             if( aItem->Type() == PCB_PAD_T )
             {
@@ -797,7 +802,7 @@ void DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstZones( BOARD_ITEM* aIt
                     if( pad->GetDrillSize().x == 0 && pad->GetDrillSize().y == 0 )
                         continue;
 
-                    std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
+                    std::shared_ptr<SHAPE_SEGMENT> hole = getEffectiveHoleShape( pad );
                     int                            size = hole->GetWidth();
 
                     itemShape = std::make_shared<SHAPE_SEGMENT>( hole->GetSeg(), size );
@@ -837,11 +842,11 @@ void DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::testItemAgainstZones( BOARD_ITEM* aIt
             if( aItem->Type() == PCB_VIA_T )
             {
                 if( aItem->GetLayerSet().Contains( aLayer ) )
-                    holeShape = aItem->GetEffectiveHoleShape();
+                    holeShape = getEffectiveHoleShape( aItem );
             }
             else if( aItem->HasHole() )
             {
-                holeShape = aItem->GetEffectiveHoleShape();
+                holeShape = getEffectiveHoleShape( aItem );
             }
 
             if( holeShape )
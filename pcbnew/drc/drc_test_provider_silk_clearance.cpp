@@ -114,6 +114,10 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                 if( !reportProgress( ii++, items, progressDelta ) )
                     return false;
 
+                // Incremental runs only test the silk near the changes, against everything
+                if( !m_drcEngine->IsInIncrementalScope( item ) )
+                    return true;
+
                 for( PCB_LAYER_ID layer : { F_SilkS, B_SilkS } )
                 {
                     if( item->IsOnLayer( layer ) )
@@ -173,9 +177,20 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
         DRC_RTREE::LAYER_PAIR( B_SilkS, Margin )
     };
 
-    targetTree.QueryCollidingPairs( &silkTree, layerPairs,
+    struct SILK_VIOLATION
+    {
+        std::shared_ptr<DRC_ITEM> m_item;
+        VECTOR2I                  m_pos;
+        PCB_LAYER_ID              m_layer;
+    };
+
+    // The pairs are tested in parallel; the violations come back in scan order
+    std::vector<SILK_VIOLATION> violations;
+
+    violations = targetTree.QueryCollidingPairsParallel<SILK_VIOLATION>( &silkTree, layerPairs,
             [&]( const DRC_RTREE::LAYER_PAIR& aLayers, DRC_RTREE::ITEM_WITH_SHAPE* aRefItemShape,
-                 DRC_RTREE::ITEM_WITH_SHAPE* aTestItemShape, bool* aCollisionDetected ) -> bool
+                 DRC_RTREE::ITEM_WITH_SHAPE* aTestItemShape,
+                 std::optional<SILK_VIOLATION>& aViolation ) -> bool
             {
                 BOARD_ITEM*  refItem = aRefItemShape->parent;
                 const SHAPE* refShape = aRefItemShape->shape;
@@ -226,6 +241,8 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                     return true;
                 }
 
+                DRC_PROFILE_COUNTERS::Count( &DRC_PROFILE_COUNTERS::m_collisionTests );
+
                 if( refShape->Collide( testShape, minClearance, &actual, &pos ) )
                 {
                     std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_OVERLAPPING_SILK );
@@ -243,9 +260,7 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                     drcItem->SetItems( refItem, testItem );
                     drcItem->SetViolatingRule( constraint.GetParentRule() );
 
-                    reportViolation( drcItem, pos, aLayers.second );
-
-                    *aCollisionDetected = true;
+                    aViolation = SILK_VIOLATION{ drcItem, pos, aLayers.second };
                 }
 
                 return true;
@@ -253,9 +268,17 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
             m_largestClearance,
             [&]( int aCount, int aSize ) -> bool
             {
-                return reportProgress( aCount, aSize, progressDelta );
+                return reportProgress( aCount, aSize );
             } );
 
+    for( const SILK_VIOLATION& violation : violations )
+    {
+        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
+            break;
+
+        reportViolation( violation.m_item, violation.m_pos, violation.m_layer );
+    }
+
     reportRuleStatistics();
 
     return !m_drcEngine->IsCancelled();
@@ -131,7 +131,7 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
                             {
                                 if( !zone->GetIsRuleArea() )
                                 {
-                                    fill = zone->GetFill( layer )->CloneDropTriangulation();
+                                    fill = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
                                     poly.Append( fill );
 
                                     // Report progress on board zones only.  Everything else is
@@ -54,6 +54,8 @@ public:
     {
         return wxT( "Tests track widths" );
     }
+
+    bool RunsConcurrently() const override { return true; }
 };
 
 
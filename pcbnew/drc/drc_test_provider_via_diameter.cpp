@@ -54,6 +54,8 @@ public:
     {
         return wxT( "Tests via diameters" );
     }
+
+    bool RunsConcurrently() const override { return true; }
 };
 
 
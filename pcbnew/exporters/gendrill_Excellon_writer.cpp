@@ -35,6 +35,7 @@
  * and the CNC-7 manual.
  */
 
+#include <core/thread_pool.h>
 #include <plotters/plotter.h>
 #include <string_utils.h>
 #include <locale_io.h>
@@ -86,64 +87,91 @@ bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     if( !m_merge_PTH_NPTH )
         hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    collectHoles();
+
+    if( aGenDrill )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file to be
-        // sure the NPTH file is up to date in separate files mode.
-        // Also a PTH drill/map file is always created, to be sure at least one plated hole
-        // drill file is created (do not create any PTH drill file can be seen as not working
-        // drill generator).
-        if( getHolesCount() > 0 || doing_npth || pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+        // The files are written in parallel, each one by a copy of the writer.  The locale is
+        // set here for all the threads.
+        LOCALE_IO                             toggle;
+        thread_pool&                          tp = GetKiCadThreadPool();
+        std::vector<wxString>                 filenames;
+        std::vector<std::future<FILE_STATUS>> results;
+
+        for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
+             it != hole_sets.end();  ++it )
         {
+            DRILL_LAYER_PAIR  pair = *it;
+            // For separate drill files, the last layer pair is the NPTH drill file.
+            bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
+
             fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
             fn.SetPath( aPlotDirectory );
+            filenames.push_back( fn.GetFullPath() );
 
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
-
-                FILE* file = wxFopen( fullFilename, wxT( "w" ) );
-
-                if( file == nullptr )
-                {
-                    if( aReporter )
+            results.push_back( tp.submit(
+                    [this, pair, doing_npth, fullFilename = filenames.back()]() -> FILE_STATUS
                     {
-                        msg.Printf( _( "Failed to create file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                        success = false;
-                    }
+                        EXCELLON_WRITER writer( *this );
+
+                        writer.buildHolesList( pair, doing_npth );
+
+                        // The file is created if it has holes, or if it is the non plated drill
+                        // file to be sure the NPTH file is up to date in separate files mode.
+                        // Also a PTH drill/map file is always created, to be sure at least one
+                        // plated hole drill file is created (do not create any PTH drill file
+                        // can be seen as not working drill generator).
+                        if( writer.getHolesCount() == 0 && !doing_npth
+                                && pair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+                        {
+                            return FILE_STATUS::SKIPPED;
+                        }
+
+                        FILE* file = wxFopen( fullFilename, wxT( "w" ) );
+
+                        if( file == nullptr )
+                            return FILE_STATUS::FAILED;
+
+                        TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
+
+                        // Only external layer pair can have non plated hole
+                        // internal layers have only plated via holes
+                        if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+                        {
+                            if( writer.m_merge_PTH_NPTH )
+                                file_type = TYPE_FILE::MIXED_FILE;
+                            else if( doing_npth )
+                                file_type = TYPE_FILE::NPTH_FILE;
+                        }
+
+                        writer.createDrillFile( file, pair, file_type );
+                        return FILE_STATUS::CREATED;
+                    } ) );
+        }
 
-                    break;
-                }
-                else
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Created file '%s'" ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ACTION );
-                    }
-                }
+        std::vector<FILE_STATUS> statuses;
 
-                TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
+        for( std::future<FILE_STATUS>& result : results )
+            statuses.push_back( result.get() );
 
-                // Only external layer pair can have non plated hole
-                // internal layers have only plated via holes
-                if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+        // Report in the order of the set, up to the first failure
+        for( size_t ii = 0; ii < statuses.size(); ++ii )
+        {
+            if( statuses[ii] == FILE_STATUS::FAILED )
+            {
+                if( aReporter )
                 {
-                    if( m_merge_PTH_NPTH )
-                        file_type = TYPE_FILE::MIXED_FILE;
-                    else if( doing_npth )
-                        file_type = TYPE_FILE::NPTH_FILE;
+                    msg.Printf( _( "Failed to create file '%s'." ), filenames[ii] );
+                    aReporter->Report( msg, RPT_SEVERITY_ERROR );
                 }
 
-                createDrillFile( file, pair, file_type );
+                success = false;
+                break;
+            }
+            else if( statuses[ii] == FILE_STATUS::CREATED && aReporter )
+            {
+                msg.Printf( _( "Created file '%s'" ), filenames[ii] );
+                aReporter->Report( msg, RPT_SEVERITY_ACTION );
             }
         }
     }
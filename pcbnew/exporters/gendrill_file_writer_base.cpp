@@ -63,108 +63,218 @@ static bool cmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
 }
 
 
-void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
-                                           bool aGenerateNPTH_list )
+/* Helper function for the optimized hole order.
+ * Return the index of aPos along a Hilbert curve covering aBox, on a 2^16 x 2^16 grid.
+ * Consecutive indices are neighbour cells, so following the indices keeps the moves short.
+ */
+static uint64_t hilbertIndex( const BOX2I& aBox, const VECTOR2I& aPos )
 {
-    HOLE_INFO new_hole;
+    const uint32_t n = 1 << 16;
+    double         scale = ( n - 1 ) / std::max( { (double) aBox.GetWidth(),
+                                                   (double) aBox.GetHeight(), 1.0 } );
+    uint32_t       x = KiROUND( ( aPos.x - aBox.GetX() ) * scale );
+    uint32_t       y = KiROUND( ( aPos.y - aBox.GetY() ) * scale );
+    uint64_t       d = 0;
+
+    for( uint32_t s = n / 2; s > 0; s /= 2 )
+    {
+        uint32_t rx = ( x & s ) ? 1 : 0;
+        uint32_t ry = ( y & s ) ? 1 : 0;
 
-    m_holeListBuffer.clear();
-    m_toolListBuffer.clear();
+        d += (uint64_t) s * s * ( ( 3 * rx ) ^ ry );
 
-    wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
+        // Rotate the quadrant so the curve of the next level starts and ends at the right place
+        if( ry == 0 )
+        {
+            if( rx == 1 )
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+
+            std::swap( x, y );
+        }
+    }
+
+    return d;
+}
+
+
+void GENDRILL_WRITER_BASE::collectHoles()
+{
+    std::shared_ptr<BOARD_HOLES> holes = std::make_shared<BOARD_HOLES>();
+    HOLE_INFO                    new_hole;
 
     // build hole list for vias
-    if( ! aGenerateNPTH_list )  // vias are always plated !
+    for( PCB_TRACK* track : m_pcb->Tracks() )
     {
-        for( auto track : m_pcb->Tracks() )
-        {
-            if( track->Type() != PCB_VIA_T )
-                continue;
+        if( track->Type() != PCB_VIA_T )
+            continue;
 
-            PCB_VIA* via = static_cast<PCB_VIA*>( track );
-            int      hole_sz = via->GetDrillValue();
+        PCB_VIA* via = static_cast<PCB_VIA*>( track );
+        int      hole_sz = via->GetDrillValue();
 
-            if( hole_sz == 0 )   // Should not occur.
-                continue;
+        if( hole_sz == 0 )   // Should not occur.
+            continue;
 
-            new_hole.m_ItemParent = via;
+        new_hole.m_ItemParent = via;
 
-            if( aLayerPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-                new_hole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_THROUGH;
-            else
-                new_hole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_BURIED;
+        via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
+
+        // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
+        // Remember: top layer = 0 and bottom layer = 31 for through hole vias
+        DRILL_LAYER_PAIR layer_pair( new_hole.m_Hole_Top_Layer, new_hole.m_Hole_Bottom_Layer );
+
+        if( layer_pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+            new_hole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_THROUGH;
+        else
+            new_hole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_BURIED;
 
-            new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
-            new_hole.m_Hole_Orient    = ANGLE_0;
-            new_hole.m_Hole_Diameter  = hole_sz;
-            new_hole.m_Hole_NotPlated = false;
-            new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+        new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
+        new_hole.m_Hole_Orient    = ANGLE_0;
+        new_hole.m_Hole_Diameter  = hole_sz;
+        new_hole.m_Hole_NotPlated = false;
+        new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
 
-            new_hole.m_Hole_Shape = 0;              // hole shape: round
-            new_hole.m_Hole_Pos = via->GetStart();
+        new_hole.m_Hole_Shape = 0;              // hole shape: round
+        new_hole.m_Hole_Pos = via->GetStart();
 
-            via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
+        holes->m_vias[layer_pair].push_back( new_hole );
+    }
 
-            // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
-            // Remember: top layer = 0 and bottom layer = 31 for through hole vias
-            // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
-            if( new_hole.m_Hole_Top_Layer    != aLayerPair.first ||
-                new_hole.m_Hole_Bottom_Layer != aLayerPair.second )
+    // add holes for thru hole pads
+    for( FOOTPRINT* footprint : m_pcb->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->GetDrillSize().x == 0 )
                 continue;
 
-            m_holeListBuffer.push_back( new_hole );
+            new_hole.m_ItemParent     = pad;
+            new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB::NPTH);
+            new_hole.m_HoleAttribute  = new_hole.m_Hole_NotPlated
+                                            ? HOLE_ATTRIBUTE::HOLE_MECHANICAL
+                                            : HOLE_ATTRIBUTE::HOLE_PAD;
+            new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
+            new_hole.m_Hole_Orient    = pad->GetOrientation();
+            new_hole.m_Hole_Shape     = 0;           // hole shape: round
+            new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
+            new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+
+            // Convert oblong holes that are actually circular into drill hits
+            if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE &&
+                    pad->GetDrillSizeX() != pad->GetDrillSizeY() )
+            {
+                new_hole.m_Hole_Shape = 1; // oval flag set
+            }
+
+            new_hole.m_Hole_Size         = pad->GetDrillSize();
+            new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
+            new_hole.m_Hole_Bottom_Layer = B_Cu;
+            new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
+
+            if( new_hole.m_Hole_NotPlated )
+                holes->m_nonPlatedPads.push_back( new_hole );
+            else
+                holes->m_platedPads.push_back( new_hole );
         }
     }
 
-    if( aLayerPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+    m_boardHoles = std::move( holes );
+}
+
+
+void GENDRILL_WRITER_BASE::optimizeHoleOrder()
+{
+    if( m_holeListBuffer.size() < 3 )
+        return;
+
+    BOX2I bbox( m_holeListBuffer[0].m_Hole_Pos, VECTOR2I( 0, 0 ) );
+
+    for( const HOLE_INFO& hole : m_holeListBuffer )
+        bbox.Merge( hole.m_Hole_Pos );
+
+    auto sameTool =
+            []( const HOLE_INFO& a, const HOLE_INFO& b )
+            {
+                return a.m_Hole_NotPlated == b.m_Hole_NotPlated
+                       && a.m_Hole_Diameter == b.m_Hole_Diameter
+                       && a.m_HoleAttribute == b.m_HoleAttribute;
+            };
+
+    std::vector<std::pair<uint64_t, size_t>> keys;
+    std::vector<HOLE_INFO>                   ordered;
+
+    // The holes are already grouped by tool: reorder each group.  Equal indices keep the
+    // X then Y order, so the result does not depend on the board item order.
+    for( size_t first = 0; first < m_holeListBuffer.size(); )
     {
-        // add holes for thru hole pads
-        for( FOOTPRINT* footprint : m_pcb->Footprints() )
+        size_t last = first + 1;
+
+        while( last < m_holeListBuffer.size()
+                && sameTool( m_holeListBuffer[first], m_holeListBuffer[last] ) )
         {
-            for( PAD* pad : footprint->Pads() )
+            last++;
+        }
+
+        keys.clear();
+        ordered.clear();
+
+        for( size_t ii = first; ii < last; ++ii )
+            keys.emplace_back( hilbertIndex( bbox, m_holeListBuffer[ii].m_Hole_Pos ), ii );
+
+        std::sort( keys.begin(), keys.end() );
+
+        for( const auto& [index, ii] : keys )
+            ordered.push_back( m_holeListBuffer[ii] );
+
+        std::copy( ordered.begin(), ordered.end(), m_holeListBuffer.begin() + first );
+        first = last;
+    }
+}
+
+
+void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
+                                           bool aGenerateNPTH_list )
+{
+    m_holeListBuffer.clear();
+    m_toolListBuffer.clear();
+
+    wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
+
+    if( !m_boardHoles )
+        collectHoles();
+
+    auto append =
+            [&]( const std::vector<HOLE_INFO>& aHoles )
             {
-                if( !m_merge_PTH_NPTH )
-                {
-                    if( !aGenerateNPTH_list && pad->GetAttribute() == PAD_ATTRIB::NPTH )
-                        continue;
+                m_holeListBuffer.insert( m_holeListBuffer.end(), aHoles.begin(), aHoles.end() );
+            };
 
-                    if( aGenerateNPTH_list && pad->GetAttribute() != PAD_ATTRIB::NPTH )
-                        continue;
-                }
+    // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
+    if( ! aGenerateNPTH_list )  // vias are always plated !
+    {
+        auto vias = m_boardHoles->m_vias.find( aLayerPair );
 
-                if( pad->GetDrillSize().x == 0 )
-                    continue;
-
-                new_hole.m_ItemParent     = pad;
-                new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB::NPTH);
-                new_hole.m_HoleAttribute  = new_hole.m_Hole_NotPlated
-                                                ? HOLE_ATTRIBUTE::HOLE_MECHANICAL
-                                                : HOLE_ATTRIBUTE::HOLE_PAD;
-                new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
-                new_hole.m_Hole_Orient    = pad->GetOrientation();
-                new_hole.m_Hole_Shape     = 0;           // hole shape: round
-                new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
-                new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
-
-                // Convert oblong holes that are actually circular into drill hits
-                if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE &&
-                        pad->GetDrillSizeX() != pad->GetDrillSizeY() )
-                {
-                    new_hole.m_Hole_Shape = 1; // oval flag set
-                }
+        if( vias != m_boardHoles->m_vias.end() )
+            append( vias->second );
+    }
 
-                new_hole.m_Hole_Size         = pad->GetDrillSize();
-                new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
-                new_hole.m_Hole_Bottom_Layer = B_Cu;
-                new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
-                m_holeListBuffer.push_back( new_hole );
-            }
-        }
+    if( aLayerPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+    {
+        if( m_merge_PTH_NPTH || !aGenerateNPTH_list )
+            append( m_boardHoles->m_platedPads );
+
+        if( m_merge_PTH_NPTH || aGenerateNPTH_list )
+            append( m_boardHoles->m_nonPlatedPads );
     }
 
     // Sort holes per increasing diameter value (and for each dimater, by position)
     sort( m_holeListBuffer.begin(), m_holeListBuffer.end(), cmpHoleSorting );
 
+    if( m_optimizeHoleOrder )
+        optimizeHoleOrder();
+
     // build the tool list
     int last_hole = -1;     // Set to not initialized (this is a value not used
                             // for m_holeListBuffer[ii].m_Hole_Diameter)
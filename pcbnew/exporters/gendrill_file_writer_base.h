@@ -35,6 +35,8 @@
 // Set to 1 to add these comments and 0 to not use these comments
 #define USE_ATTRIB_FOR_HOLES 1
 
+#include <map>
+#include <memory>
 #include <vector>
 
 class BOARD_ITEM;
@@ -177,6 +179,15 @@ public:
      */
     void SetMergeOption( bool aMerge ) { m_merge_PTH_NPTH = aMerge; }
 
+    /**
+     * Set the option to order the holes of each tool along a space filling curve, which
+     * shortens the travel of the drill head.
+     *
+     * @param aOptimize set to true to use the optimized order or false to sort the holes of
+     *                  each tool by X then Y position.
+     */
+    void SetHoleOrderOptimization( bool aOptimize ) { m_optimizeHoleOrder = aOptimize; }
+
     /**
      * Return the plot offset (usually the position of the drill/place origin).
      */
@@ -299,6 +310,19 @@ protected:
 
     int  getHolesCount() const { return m_holeListBuffer.size(); }
 
+    /**
+     * Collect the holes of the board for all the files of the set, so that buildHolesList()
+     * only has to sort the holes of one file.
+     *
+     * Copies of the writer share the collected holes.  They are collected again at each call.
+     */
+    void collectHoles();
+
+    /**
+     * Order the holes of each tool of m_holeListBuffer along a Hilbert curve.
+     */
+    void optimizeHoleOrder();
+
     /**
      * Write the drill marks in HPGL, POSTSCRIPT or other supported formats/
      *
@@ -364,6 +388,22 @@ protected:
 
 
 protected:
+    /// The state of a file of the drill files set after its generation
+    enum class FILE_STATUS
+    {
+        SKIPPED,                // the file has no hole and is not required
+        CREATED,
+        FAILED
+    };
+
+    /// The holes of the board, by drill file
+    struct BOARD_HOLES
+    {
+        std::map<DRILL_LAYER_PAIR, std::vector<HOLE_INFO>> m_vias;
+        std::vector<HOLE_INFO>                             m_platedPads;
+        std::vector<HOLE_INFO>                             m_nonPlatedPads;
+    };
+
     // Use derived classes to build a fully initialized GENDRILL_WRITER_BASE class.
     GENDRILL_WRITER_BASE( BOARD* aPcb )
     {
@@ -373,6 +413,7 @@ protected:
         m_mapFileFmt      = PLOT_FORMAT::PDF;
         m_pageInfo        = nullptr;
         m_merge_PTH_NPTH  = false;
+        m_optimizeHoleOrder = false;
         m_zeroFormat      = DECIMAL_FORMAT;
     }
 
@@ -389,6 +430,9 @@ protected:
     bool                     m_merge_PTH_NPTH;          // True to generate only one drill file
     std::vector<HOLE_INFO>   m_holeListBuffer;          // Buffer containing holes
     std::vector<DRILL_TOOL>  m_toolListBuffer;          // Buffer containing tools
+    std::shared_ptr<const BOARD_HOLES> m_boardHoles;    // Holes collected by collectHoles()
+    bool                     m_optimizeHoleOrder;       // True to order the holes of a tool
+                                                        // along a Hilbert curve
 
     PLOT_FORMAT m_mapFileFmt;                           // the format of the map drill file,
                                                         // if this map is needed
@@ -27,6 +27,7 @@
  * @brief Functions to create drill files in gerber X2 format.
  */
 
+#include <core/thread_pool.h>
 #include <plotters/plotter_gerber.h>
 #include <string_utils.h>
 #include <locale_io.h>
@@ -73,51 +74,77 @@ bool GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory, b
     // (Gerber drill files are separate files for PTH and NPTH)
     hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    collectHoles();
+
+    if( aGenDrill )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file
-        // to be sure the NPTH file is up to date in separate files mode.
-        // Also a PTH drill/map file is always created, to be sure at least one plated hole drill
-        // file is created (do not create any PTH drill file can be seen as not working drill
-        // generator).
-        if( getHolesCount() > 0 || doing_npth || pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+        // The files are written in parallel, each one by a copy of the writer.  The locale is
+        // set here for all the threads.
+        LOCALE_IO                             toggle;
+        thread_pool&                          tp = GetKiCadThreadPool();
+        std::vector<wxString>                 filenames;
+        std::vector<std::future<FILE_STATUS>> results;
+
+        for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
+             it != hole_sets.end();  ++it )
         {
+            DRILL_LAYER_PAIR  pair = *it;
+            // For separate drill files, the last layer pair is the NPTH drill file.
+            bool doing_npth = ( it == hole_sets.end() - 1 );
+
             fn = getDrillFileName( pair, doing_npth, false );
             fn.SetPath( aPlotDirectory );
+            filenames.push_back( fn.GetFullPath() );
 
-            if( aGenDrill )
-            {
-                wxString fullFilename = fn.GetFullPath();
+            results.push_back( tp.submit(
+                    [this, pair, doing_npth, fullFilename = filenames.back()]() -> FILE_STATUS
+                    {
+                        GERBER_WRITER writer( *this );
+                        wxString      filename = fullFilename;
+
+                        writer.buildHolesList( pair, doing_npth );
+
+                        // The file is created if it has holes, or if it is the non plated drill
+                        // file to be sure the NPTH file is up to date in separate files mode.
+                        // Also a PTH drill/map file is always created, to be sure at least one
+                        // plated hole drill file is created (do not create any PTH drill file
+                        // can be seen as not working drill generator).
+                        if( writer.getHolesCount() == 0 && !doing_npth
+                                && pair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+                        {
+                            return FILE_STATUS::SKIPPED;
+                        }
+
+                        if( writer.createDrillFile( filename, doing_npth, pair ) < 0 )
+                            return FILE_STATUS::FAILED;
+
+                        return FILE_STATUS::CREATED;
+                    } ) );
+        }
 
-                int result = createDrillFile( fullFilename, doing_npth, pair );
+        std::vector<FILE_STATUS> statuses;
 
-                if( result < 0 )
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Failed to create file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                        success = false;
-                    }
+        for( std::future<FILE_STATUS>& result : results )
+            statuses.push_back( result.get() );
 
-                    break;
-                }
-                else
+        // Report in the order of the set, up to the first failure
+        for( size_t ii = 0; ii < statuses.size(); ++ii )
+        {
+            if( statuses[ii] == FILE_STATUS::FAILED )
+            {
+                if( aReporter )
                 {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Created file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ACTION );
-                    }
+                    msg.Printf( _( "Failed to create file '%s'." ), filenames[ii] );
+                    aReporter->Report( msg, RPT_SEVERITY_ERROR );
                 }
 
+                success = false;
+                break;
+            }
+            else if( statuses[ii] == FILE_STATUS::CREATED && aReporter )
+            {
+                msg.Printf( _( "Created file '%s'." ), filenames[ii] );
+                aReporter->Report( msg, RPT_SEVERITY_ACTION );
             }
         }
     }
@@ -46,6 +46,8 @@
 
 #include <Standard_Version.hxx>
 
+#include <mutex>
+
 #include <wx/crt.h>
 #include <wx/log.h>
 #include <core/profile.h>        // To use GetRunningMicroSecs or another profiling utility
@@ -59,6 +61,10 @@
 
 void ReportMessage( const wxString& aMessage )
 {
+    // Messages can come from the thread pool while the copper shapes are built and cut
+    static std::mutex           s_reportMutex;
+    std::lock_guard<std::mutex> lock( s_reportMutex );
+
     wxPrintf( aMessage );
     fflush( stdout ); // Force immediate printing (needed on mingw)
 }
@@ -24,6 +24,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <sstream>
 #include <string>
@@ -43,6 +44,7 @@
 #include <string_utils.h>
 #include <build_version.h>
 #include <geometry/shape_segment.h>
+#include <core/thread_pool.h>
 
 #include "step_pcb_model.h"
 #include "streamwrapper.h"
@@ -695,7 +697,10 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
 
     gp_Pln basePlane( gp_Pnt( 0.0, 0.0, aZposition ), gp::DZ() );
 
-    for( const SHAPE_POLY_SET::POLYGON& polygon : simplified.CPolygons() )
+    // Each polygon gives its own prism, so they are built on the thread pool and appended
+    // in polygon order afterwards.
+    auto makePolygonShape = [&]( const SHAPE_POLY_SET::POLYGON& polygon,
+                                 TopoDS_Shape& aPrism ) -> bool
     {
         auto makeWireFromChain = [&]( BRepLib_MakeWire&       aMkWire,
                                       const SHAPE_LINE_CHAIN& aChain ) -> bool
@@ -926,10 +931,9 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
 
         if( mkFace.IsDone() )
         {
-            TopoDS_Shape prism = BRepPrimAPI_MakePrism( mkFace, gp_Vec( 0, 0, aThickness ) );
-            aShapes.push_back( prism );
+            aPrism = BRepPrimAPI_MakePrism( mkFace, gp_Vec( 0, 0, aThickness ) );
 
-            if( prism.IsNull() )
+            if( aPrism.IsNull() )
             {
                 ReportMessage( wxT( "Failed to create a prismatic shape\n" ) );
                 return false;
@@ -940,6 +944,26 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
             wxASSERT( false );
             return false;
         }
+
+        return true;
+    };
+
+    const std::vector<SHAPE_POLY_SET::POLYGON>& polygons = simplified.CPolygons();
+    std::vector<TopoDS_Shape>                   prisms( polygons.size() );
+    std::vector<uint8_t>                        built( polygons.size(), 0 );
+
+    ParallelForEachIndex( polygons.size(),
+                          [&]( size_t aIdx )
+                          {
+                              built[aIdx] = makePolygonShape( polygons[aIdx], prisms[aIdx] );
+                          } );
+
+    for( size_t ii = 0; ii < polygons.size(); ii++ )
+    {
+        if( !built[ii] )
+            return false;
+
+        aShapes.push_back( prisms[ii] );
     }
 
     return true;
@@ -1031,46 +1055,56 @@ bool STEP_PCB_MODEL::CreatePCB( SHAPE_POLY_SET& aOutline, VECTOR2D aOrigin )
     auto subtractShapes = []( const wxString& aWhat, std::vector<TopoDS_Shape>& aShapesList,
                               std::vector<TopoDS_Shape>& aHolesList, Bnd_BoundSortBox& aBSBHoles )
     {
-        // Remove holes for each item (board body or bodies, one can have more than one board)
-        int cnt = 0;
-        for( TopoDS_Shape& shape : aShapesList )
-        {
-            Bnd_Box shapeBbox;
-            BRepBndLib::Add( shape, shapeBbox );
+        if( aShapesList.empty() )
+            return;
 
-            const TColStd_ListOfInteger& indices = aBSBHoles.Compare( shapeBbox );
+        ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
 
-            TopTools_ListOfShape holelist;
+        // Bnd_BoundSortBox::Compare() returns its internal list, so the holes of each item
+        // (board body or bodies, one can have more than one board) are collected here first.
+        std::vector<TopTools_ListOfShape> holeLists( aShapesList.size() );
 
-            for( const Standard_Integer& index : indices )
-                holelist.Append( aHolesList[index] );
+        for( size_t ii = 0; ii < aShapesList.size(); ii++ )
+        {
+            Bnd_Box shapeBbox;
+            BRepBndLib::Add( aShapesList[ii], shapeBbox );
 
-            if( cnt == 0 )
-                ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
+            for( const Standard_Integer& index : aBSBHoles.Compare( shapeBbox ) )
+                holeLists[ii].Append( aHolesList[index] );
+        }
 
-            cnt++;
+        // Each item is cut independently of the others, so the cuts run on the thread pool
+        std::atomic<int> cnt( 0 );
 
-            if( cnt % 10 == 0 )
-                ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), cnt,
-                                                 (int) aShapesList.size(), aWhat ) );
+        ParallelForEachIndex( aShapesList.size(),
+                [&]( size_t aIdx )
+                {
+                    if( !holeLists[aIdx].IsEmpty() )
+                    {
+                        TopTools_ListOfShape cutArgs;
+                        cutArgs.Append( aShapesList[aIdx] );
 
-            if( holelist.IsEmpty() )
-                continue;
+                        BRepAlgoAPI_Cut cut;
 
-            TopTools_ListOfShape cutArgs;
-            cutArgs.Append( shape );
+                        // This helps cutting circular holes in zones where a hole is already cut
+                        // in Clipper
+                        cut.SetFuzzyValue( 0.0005 );
+                        cut.SetArguments( cutArgs );
 
-            BRepAlgoAPI_Cut cut;
+                        cut.SetTools( holeLists[aIdx] );
+                        cut.Build();
 
-            // This helps cutting circular holes in zones where a hole is already cut in Clipper
-            cut.SetFuzzyValue( 0.0005 );
-            cut.SetArguments( cutArgs );
+                        aShapesList[aIdx] = cut.Shape();
+                    }
 
-            cut.SetTools( holelist );
-            cut.Build();
+                    int done = ++cnt;
 
-            shape = cut.Shape();
-        }
+                    if( done % 10 == 0 )
+                    {
+                        ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), done,
+                                                         (int) aShapesList.size(), aWhat ) );
+                    }
+                } );
     };
 
     if( m_boardCutouts.size() )
@@ -26,6 +26,7 @@
 
 #include <string>
 
+#include <advanced_config.h>
 #include <confirm.h>
 #include <core/arraydim.h>
 #include <core/thread_pool.h>
@@ -52,6 +53,7 @@
 #include <settings/settings_manager.h>
 #include <string_utf8_map.h>
 #include <paths.h>
+#include <perf_trace.h>
 #include <pgm_base.h>
 #include <project/project_file.h>
 #include <project_pcb.h>
@@ -500,6 +502,20 @@ int PCB_EDIT_FRAME::inferLegacyEdgeClearance( BOARD* aBoard, bool aShowUserMsg )
 }
 
 
+/**
+ * @return the name of the file where the zone fill triangulations of \a aBoardFileName are
+ *         cached, next to it.
+ */
+static wxString triangulationCacheFileName( const wxFileName& aBoardFileName )
+{
+    wxFileName fn = aBoardFileName;
+
+    fn.SetFullName( aBoardFileName.GetName() + wxT( "-triangulation-cache" ) );
+
+    return fn.GetFullPath();
+}
+
+
 bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, int aCtl )
 {
     // This is for python:
@@ -701,6 +717,8 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
                 pi->SetReporter( &NULL_REPORTER::GetInstance() );
 
             pi->SetProgressReporter( &progressReporter );
+
+            SCOPED_TRACE_ZONE traceZone( "Load board", fullFileName );
             loadedBoard = pi->LoadBoard( fullFileName, nullptr, &props, &Prj() );
 
 #if USE_INSTRUMENTATION
@@ -755,6 +773,10 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
             errorReporter.ShowModal();
         }
 
+        // Restore the fill triangulations saved with the board before they are needed below
+        if( ADVANCED_CFG::GetCfg().m_CacheZoneTriangulation )
+            loadedBoard->RestoreTriangulationCache( triangulationCacheFileName( fullFileName ) );
+
         // Skip (possibly expensive) connectivity build here; we build it below after load
         SetBoard( loadedBoard, false, &progressReporter );
 
@@ -1028,6 +1050,14 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool addToHistory,
     {
         IO_RELEASER<PCB_IO> pi( PCB_IO_MGR::PluginFind( PCB_IO_MGR::KICAD_SEXP ) );
 
+        // Every change made in the editor goes through a commit or the undo list, so the text
+        // of the items which weren't changed since the last save can be reused.  Changes made
+        // from the scripting console aren't tracked.
+        GetBoard()->EnableSavedTextCache( ADVANCED_CFG::GetCfg().m_IncrementalBoardSave );
+
+        if( IsScriptingConsoleVisible() )
+            GetBoard()->ClearSavedText();
+
         pi->SaveBoard( tempFile, GetBoard(), nullptr );
     }
     catch( const IO_ERROR& ioe )
@@ -1073,6 +1103,9 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool addToHistory,
             upperTxt.clear();
     }
 
+    if( ADVANCED_CFG::GetCfg().m_CacheZoneTriangulation )
+        GetBoard()->SaveTriangulationCache( triangulationCacheFileName( pcbFileName ) );
+
     GetBoard()->SetFileName( pcbFileName.GetFullPath() );
 
     // Update the lock in case it was a Save As
@@ -34,6 +34,7 @@
 #include <board.h>
 #include <board_design_settings.h>
 #include <macros.h>
+#include <memory_accounting.h>
 #include <pad.h>
 #include <pcb_marker.h>
 #include <pcb_group.h>
@@ -780,6 +781,9 @@ void FOOTPRINT::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode, bool aSkipConnectiv
 
     aBoardItem->ClearEditFlags();
     aBoardItem->SetParent( this );
+
+    if( BOARD* board = GetBoard() )
+        board->InvalidateNetItems();
 }
 
 
@@ -867,6 +871,9 @@ void FOOTPRINT::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aMode )
 
     aBoardItem->SetFlags( STRUCT_DELETED );
 
+    if( BOARD* board = GetBoard() )
+        board->InvalidateNetItems();
+
     PCB_GROUP* parentGroup = aBoardItem->GetParentGroup();
 
     if( parentGroup && !( parentGroup->GetFlags() & STRUCT_DELETED ) )
@@ -2496,6 +2503,67 @@ double FOOTPRINT::GetCoverageArea( const BOARD_ITEM* aItem, const GENERAL_COLLEC
 }
 
 
+size_t FOOTPRINT::GetMemoryUsage() const
+{
+    size_t size = sizeof( FOOTPRINT ) + m_3D_Drawings.capacity() * sizeof( FP_3DMODEL );
+
+    size += m_fields.size() * sizeof( PCB_FIELD );
+    size += m_pads.size() * sizeof( PAD );
+
+    for( const BOARD_ITEM* item : m_drawings )
+    {
+        switch( item->Type() )
+        {
+        case PCB_SHAPE_T:
+            size += sizeof( PCB_SHAPE );
+            size += static_cast<const PCB_SHAPE*>( item )->GetPolyShape().GetMemoryUsage();
+            break;
+
+        case PCB_TEXT_T:    size += sizeof( PCB_TEXT );        break;
+        case PCB_TEXTBOX_T: size += sizeof( PCB_TEXTBOX );     break;
+        default:            size += sizeof( PCB_DIM_ALIGNED ); break;   // Mostly dimensions
+        }
+    }
+
+    for( const ZONE* zone : m_zones )
+        size += sizeof( ZONE ) + zone->Outline()->GetMemoryUsage() + zone->GetFillMemoryUsage();
+
+    size += m_courtyard_cache_front.GetMemoryUsage() + m_courtyard_cache_back.GetMemoryUsage();
+
+    return size;
+}
+
+
+void FOOTPRINT::ReportMemoryUsage( MEMORY_REPORT& aReport ) const
+{
+    for( const PCB_FIELD* field : m_fields )
+        aReport.Add( MEMORY_CATEGORY::TEXT_CACHE, field->GetRenderCacheMemoryUsage() );
+
+    for( const BOARD_ITEM* item : m_drawings )
+    {
+        if( const EDA_TEXT* text = dynamic_cast<const EDA_TEXT*>( item ) )
+        {
+            aReport.Add( MEMORY_CATEGORY::TEXT_CACHE, text->GetRenderCacheMemoryUsage() );
+        }
+        else if( item->Type() == PCB_SHAPE_T )
+        {
+            const SHAPE_POLY_SET& poly = static_cast<const PCB_SHAPE*>( item )->GetPolyShape();
+            aReport.Add( MEMORY_CATEGORY::TRIANGULATION, poly.GetTriangulationMemoryUsage() );
+        }
+    }
+
+    for( const ZONE* zone : m_zones )
+    {
+        aReport.Add( MEMORY_CATEGORY::ZONE_FILLS, zone->GetFillMemoryUsage() );
+        aReport.Add( MEMORY_CATEGORY::TRIANGULATION, zone->GetTriangulationMemoryUsage() );
+    }
+
+    aReport.Add( MEMORY_CATEGORY::TRIANGULATION,
+                 m_courtyard_cache_front.GetTriangulationMemoryUsage()
+                         + m_courtyard_cache_back.GetTriangulationMemoryUsage() );
+}
+
+
 double FOOTPRINT::CoverageRatio( const GENERAL_COLLECTOR& aCollector ) const
 {
     int textMargin = aCollector.GetGuide()->Accuracy();
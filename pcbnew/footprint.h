@@ -46,6 +46,7 @@
 
 class LINE_READER;
 class EDA_3D_CANVAS;
+class MEMORY_REPORT;
 class PAD;
 class BOARD;
 class MSG_PANEL_ITEM;
@@ -925,6 +926,17 @@ public:
 
     static double GetCoverageArea( const BOARD_ITEM* aItem, const GENERAL_COLLECTOR& aCollector );
 
+    /**
+     * @return an estimate of the memory held by the footprint and its items, for reports.
+     */
+    size_t GetMemoryUsage() const;
+
+    /**
+     * Add an estimate of the memory held by the zone fills, the triangulations and the text
+     * render caches of the footprint items to \a aReport.
+     */
+    void ReportMemoryUsage( MEMORY_REPORT& aReport ) const;
+
     /// Return the initial comments block or NULL if none, without transfer of ownership.
     const wxArrayString* GetInitialComments() const { return m_initial_comments; }
 
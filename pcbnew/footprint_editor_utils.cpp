@@ -141,6 +141,7 @@ public:
         m_unique_pad_count = aFootprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
         m_keywords = aFootprint->GetKeywords();
         m_doc = aFootprint->GetLibDescription();
+        m_bbox = aFootprint->GetBoundingBox( false, false );
         m_loaded = true;
     }
 };
@@ -60,6 +60,7 @@ void FOOTPRINT_INFO_IMPL::load()
         m_unique_pad_count = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
         m_keywords = footprint->GetKeywords();
         m_doc = footprint->GetLibDescription();
+        m_bbox = footprint->GetBoundingBox( false, false );
     }
 
     m_loaded = true;
@@ -70,6 +71,7 @@ void FOOTPRINT_LIST_IMPL::Clear()
 {
     m_list.clear();
     m_list_timestamp = 0;
+    m_lib_timestamps.clear();
 }
 
 
@@ -107,14 +109,40 @@ bool FOOTPRINT_LIST_IMPL::CatchErrors( const std::function<void()>& aFunc )
 bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxString* aNickname,
                                               PROGRESS_REPORTER* aProgressReporter )
 {
-    long long int generatedTimestamp = 0;
+    std::vector<wxString>         nicknames;
+    std::map<wxString, long long> libTimestamps;
+    long long int                 generatedTimestamp = 0;
 
-    if( !CatchErrors( [&]()
-                 {
-                     generatedTimestamp = aTable->GenerateTimestamp( aNickname );
-                 } ) )
+    if( aNickname )
     {
-        return false;
+        if( !CatchErrors( [&]()
+                     {
+                         generatedTimestamp = aTable->GenerateTimestamp( aNickname );
+                     } ) )
+        {
+            return false;
+        }
+
+        nicknames.push_back( *aNickname );
+        libTimestamps[*aNickname] = generatedTimestamp;
+    }
+    else
+    {
+        std::vector<wxString> logicalLibs = aTable->GetLogicalLibs();
+
+        // Libraries which aren't found are left out, as FP_LIB_TABLE::GenerateTimestamp() does
+        libTimestamps = aTable->GenerateTimestamps( logicalLibs );
+
+        for( const wxString& nickname : logicalLibs )
+        {
+            auto it = libTimestamps.find( nickname );
+
+            if( it == libTimestamps.end() )
+                continue;
+
+            nicknames.push_back( nickname );
+            generatedTimestamp += it->second;
+        }
     }
 
     if( generatedTimestamp == m_list_timestamp )
@@ -124,32 +152,50 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
     KIID_NIL_SET_RESET reset_kiid;
 
     m_progress_reporter = aProgressReporter;
-
-    if( m_progress_reporter )
-    {
-        m_progress_reporter->SetMaxProgress( m_queue_in.size() );
-        m_progress_reporter->Report( _( "Fetching footprint libraries..." ) );
-    }
-
     m_cancelled = false;
     m_lib_table = aTable;
 
     // Clear data before reading files
     m_errors.clear();
-    m_list.clear();
     m_queue_in.clear();
     m_queue_out.clear();
 
-    if( aNickname )
+    // Keep the footprints of the libraries which didn't change, and only read the others again
+    auto isUnchanged =
+            [&]( const wxString& aLib )
+            {
+                auto it = m_lib_timestamps.find( aLib );
+
+                return it != m_lib_timestamps.end() && it->second == libTimestamps[aLib];
+            };
+
+    std::map<wxString, long long> unchangedTimestamps;
+    FPILIST                       unchanged;
+
+    for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : m_list )
     {
-        m_queue_in.push( *aNickname );
+        if( libTimestamps.count( fpinfo->GetLibNickname() )
+                && isUnchanged( fpinfo->GetLibNickname() ) )
+        {
+            unchanged.push_back( std::move( fpinfo ) );
+        }
     }
-    else
+
+    m_list = std::move( unchanged );
+
+    for( const wxString& nickname : nicknames )
     {
-        for( const wxString& nickname : aTable->GetLogicalLibs() )
+        if( isUnchanged( nickname ) )
+            unchangedTimestamps[nickname] = libTimestamps[nickname];
+        else
             m_queue_in.push( nickname );
     }
 
+    if( m_progress_reporter )
+    {
+        m_progress_reporter->SetMaxProgress( m_queue_in.size() );
+        m_progress_reporter->Report( _( "Fetching footprint libraries..." ) );
+    }
 
     loadLibs();
 
@@ -169,9 +215,16 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
     }
 
     if( m_cancelled )
-        m_list_timestamp = 0;       // God knows what we got before we were canceled
+    {
+        // God knows what we got before we were canceled, except for the libraries we kept
+        m_list_timestamp = 0;
+        m_lib_timestamps = std::move( unchangedTimestamps );
+    }
     else
+    {
         m_list_timestamp = generatedTimestamp;
+        m_lib_timestamps = std::move( libTimestamps );
+    }
 
     return m_errors.empty();
 }
@@ -179,7 +232,6 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FP_LIB_TABLE* aTable, const wxStri
 
 void FOOTPRINT_LIST_IMPL::loadLibs()
 {
-    thread_pool& tp = GetKiCadThreadPool();
     size_t num_returns = m_queue_in.size();
     std::vector<std::future<size_t>> returns( num_returns );
 
@@ -207,7 +259,7 @@ void FOOTPRINT_LIST_IMPL::loadLibs()
             };
 
     for( size_t ii = 0; ii < num_returns; ++ii )
-        returns[ii] = tp.submit( loader_job );
+        returns[ii] = SubmitTask( TASK_PRIORITY::BACKGROUND, loader_job );
 
     for( const std::future<size_t>& ret : returns )
     {
@@ -236,7 +288,6 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
     // TODO: blast LOCALE_IO into the sun
 
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
-    thread_pool&                                tp = GetKiCadThreadPool();
     size_t                                      num_elements = m_queue_out.size();
     std::vector<std::future<size_t>>            returns( num_elements );
 
@@ -276,7 +327,7 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
             };
 
     for( size_t ii = 0; ii < num_elements; ++ii )
-        returns[ii] = tp.submit( fp_thread );
+        returns[ii] = SubmitTask( TASK_PRIORITY::BACKGROUND, fp_thread );
 
     for( const std::future<size_t>& ret : returns )
     {
@@ -313,6 +364,12 @@ FOOTPRINT_LIST_IMPL::FOOTPRINT_LIST_IMPL() :
 }
 
 
+/// Written where older versions read the timestamp of the whole list, so that they never take
+/// this format for theirs and just read the libraries again.
+static const wxChar* const CACHE_LEGACY_TIMESTAMP = wxT( "0" );
+static const wxChar* const CACHE_FORMAT = wxT( "fp-info-cache 2" );
+
+
 void FOOTPRINT_LIST_IMPL::WriteCacheToFile( const wxString& aFilePath )
 {
     wxFileName          tmpFileName = wxFileName::CreateTempFileName( aFilePath );
@@ -324,10 +381,24 @@ void FOOTPRINT_LIST_IMPL::WriteCacheToFile( const wxString& aFilePath )
         return;
     }
 
+    txtStream << CACHE_LEGACY_TIMESTAMP << endl;
+    txtStream << CACHE_FORMAT << endl;
     txtStream << wxString::Format( wxT( "%lld" ), m_list_timestamp ) << endl;
 
+    // The timestamps of the libraries, so that a change in one of them only invalidates its own
+    // footprints
+    txtStream << wxString::Format( wxT( "%zu" ), m_lib_timestamps.size() ) << endl;
+
+    for( const auto& [nickname, timestamp] : m_lib_timestamps )
+    {
+        txtStream << nickname << endl;
+        txtStream << wxString::Format( wxT( "%lld" ), timestamp ) << endl;
+    }
+
     for( std::unique_ptr<FOOTPRINT_INFO>& fpinfo : m_list )
     {
+        const BOX2I& bbox = fpinfo->GetBoundingBox();
+
         txtStream << fpinfo->GetLibNickname() << endl;
         txtStream << fpinfo->GetName() << endl;
         txtStream << EscapeString( fpinfo->GetDescription(), CTX_LINE ) << endl;
@@ -335,6 +406,8 @@ void FOOTPRINT_LIST_IMPL::WriteCacheToFile( const wxString& aFilePath )
         txtStream << wxString::Format( wxT( "%d" ), fpinfo->GetOrderNum() ) << endl;
         txtStream << wxString::Format( wxT( "%u" ), fpinfo->GetPadCount() ) << endl;
         txtStream << wxString::Format( wxT( "%u" ), fpinfo->GetUniquePadCount() ) << endl;
+        txtStream << wxString::Format( wxT( "%d %d %d %d" ), bbox.GetX(), bbox.GetY(),
+                                       bbox.GetWidth(), bbox.GetHeight() ) << endl;
     }
 
     txtStream.Flush();
@@ -358,14 +431,33 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
 
     m_list_timestamp = 0;
     m_list.clear();
+    m_lib_timestamps.clear();
 
     try
     {
-        if( cacheFile.Exists() && cacheFile.Open() )
+        // A cache in another format is just ignored and the libraries are read again
+        if( cacheFile.Exists() && cacheFile.Open() && cacheFile.GetLineCount() > 3
+                && cacheFile.GetFirstLine() == CACHE_LEGACY_TIMESTAMP
+                && cacheFile.GetNextLine() == CACHE_FORMAT )
         {
-            cacheFile.GetFirstLine().ToLongLong( &m_list_timestamp );
+            cacheFile.GetNextLine().ToLongLong( &m_list_timestamp );
 
-            while( cacheFile.GetCurrentLine() + 6 < cacheFile.GetLineCount() )
+            unsigned long libCount = 0;
+            cacheFile.GetNextLine().ToULong( &libCount );
+
+            for( unsigned long ii = 0; ii < libCount; ++ii )
+            {
+                if( cacheFile.GetCurrentLine() + 2 >= cacheFile.GetLineCount() )
+                    THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
+
+                wxString  libNickname = cacheFile.GetNextLine();
+                long long timestamp = 0;
+
+                cacheFile.GetNextLine().ToLongLong( &timestamp );
+                m_lib_timestamps[libNickname] = timestamp;
+            }
+
+            while( cacheFile.GetCurrentLine() + 8 < cacheFile.GetLineCount() )
             {
                 wxString             libNickname    = cacheFile.GetNextLine();
                 wxString             name           = cacheFile.GetNextLine();
@@ -374,10 +466,15 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
                 int                  orderNum       = wxAtoi( cacheFile.GetNextLine() );
                 unsigned int         padCount       = (unsigned) wxAtoi( cacheFile.GetNextLine() );
                 unsigned int         uniquePadCount = (unsigned) wxAtoi( cacheFile.GetNextLine() );
+                int                  x = 0, y = 0, w = 0, h = 0;
+
+                wxSscanf( cacheFile.GetNextLine(), wxT( "%d %d %d %d" ), &x, &y, &w, &h );
 
                 FOOTPRINT_INFO_IMPL* fpinfo = new FOOTPRINT_INFO_IMPL( libNickname, name, desc,
                                                                        keywords, orderNum,
-                                                                       padCount,  uniquePadCount );
+                                                                       padCount,  uniquePadCount,
+                                                                       BOX2I( VECTOR2I( x, y ),
+                                                                              VECTOR2I( w, h ) ) );
 
                 m_list.emplace_back( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
             }
@@ -387,11 +484,15 @@ void FOOTPRINT_LIST_IMPL::ReadCacheFromFile( const wxString& aFilePath )
     {
         // whatever went wrong, invalidate the cache
         m_list_timestamp = 0;
+        m_lib_timestamps.clear();
     }
 
     // Sanity check: an empty list is very unlikely to be correct.
     if( m_list.size() == 0 )
+    {
         m_list_timestamp = 0;
+        m_lib_timestamps.clear();
+    }
 
     if( cacheFile.IsOpened() )
         cacheFile.Close();
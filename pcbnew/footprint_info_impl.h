@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -51,7 +52,8 @@ public:
     // A constructor for cached items
     FOOTPRINT_INFO_IMPL( const wxString& aNickname, const wxString& aFootprintName,
                          const wxString& aDescription, const wxString& aKeywords,
-                         int aOrderNum, unsigned int aPadCount, unsigned int aUniquePadCount )
+                         int aOrderNum, unsigned int aPadCount, unsigned int aUniquePadCount,
+                         const BOX2I& aBoundingBox )
     {
         m_nickname = aNickname;
         m_fpname = aFootprintName;
@@ -60,6 +62,7 @@ public:
         m_unique_pad_count = aUniquePadCount;
         m_doc = aDescription;
         m_keywords = aKeywords;
+        m_bbox = aBoundingBox;
 
         m_owner = nullptr;
         m_loaded = true;
@@ -110,6 +113,10 @@ private:
     SYNC_QUEUE<wxString>     m_queue_in;
     SYNC_QUEUE<wxString>     m_queue_out;
     long long                m_list_timestamp;
+
+    /// The timestamps of the libraries whose footprints are in the list, by nickname.  Only
+    /// the libraries whose timestamp changed are read again.
+    std::map<wxString, long long> m_lib_timestamps;
     PROGRESS_REPORTER*       m_progress_reporter;
     std::atomic_bool         m_cancelled;
     std::mutex               m_join;
@@ -23,6 +23,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cstring>
+
 #include <wx/clipbrd.h>
 #include <wx/log.h>
 
@@ -44,6 +46,129 @@
 #include <kicad_clipboard.h>
 #include "confirm.h"
 
+/**
+ * The items of the last copy made by this process, held as they are parsed back from the
+ * clipboard text.  A paste in this process clones them instead of parsing the text, as long as
+ * the clipboard still holds that copy.
+ */
+struct CLIPBOARD_SNAPSHOT
+{
+    std::string                 m_id;       ///< Also placed on the clipboard to recognize it
+    std::unique_ptr<BOARD_ITEM> m_item;     ///< A BOARD or a FOOTPRINT
+    std::vector<BOARD_ITEM*>    m_items;    ///< The items of a BOARD, in the order of the text
+};
+
+
+static std::unique_ptr<CLIPBOARD_SNAPSHOT> s_snapshot;
+
+
+static const wxDataFormat& snapshotFormat()
+{
+    static const wxDataFormat format( wxS( "application/x-kicad-pcbnew-copy" ) );
+    return format;
+}
+
+
+static void copyLayerSetup( const BOARD* aSource, BOARD* aDest )
+{
+    aDest->SetCopperLayerCount( aSource->GetCopperLayerCount() );
+    aDest->SetEnabledLayers( aSource->GetEnabledLayers() );
+
+    for( LSEQ seq = aSource->GetEnabledLayers().Seq(); seq; ++seq )
+    {
+        aDest->SetLayerName( *seq, aSource->GetLayerName( *seq ) );
+
+        if( IsCopperLayer( *seq ) )
+            aDest->SetLayerType( *seq, aSource->GetLayerType( *seq ) );
+    }
+}
+
+
+/**
+ * Add an item to a clipboard board, with the descendants of a group at the top level too, as
+ * the parser does.
+ */
+static void addToBoard( BOARD* aBoard, BOARD_ITEM* aItem, std::vector<BOARD_ITEM*>& aItems )
+{
+    aBoard->Add( aItem, ADD_MODE::BULK_APPEND, true );
+    aItems.push_back( aItem );
+
+    if( aItem->Type() == PCB_GROUP_T || aItem->Type() == PCB_GENERATOR_T )
+    {
+        aItem->RunOnDescendants(
+                [&]( BOARD_ITEM* aDescendant )
+                {
+                    aBoard->Add( aDescendant, ADD_MODE::BULK_APPEND, true );
+                    aItems.push_back( aDescendant );
+                } );
+    }
+}
+
+
+/**
+ * Point the connected items of a clipboard board to nets of that board with the names of
+ * the nets they had.
+ */
+static void mapNetsByName( BOARD* aBoard )
+{
+    for( BOARD_CONNECTED_ITEM* item : aBoard->AllConnectedItems() )
+    {
+        wxString netname = item->GetNetname();
+
+        if( netname.IsEmpty() )
+        {
+            item->SetNet( aBoard->FindNet( NETINFO_LIST::UNCONNECTED ) );
+            continue;
+        }
+
+        NETINFO_ITEM* net = aBoard->FindNet( netname );
+
+        if( !net )
+        {
+            net = new NETINFO_ITEM( aBoard, netname );
+            aBoard->Add( net, ADD_MODE::INSERT, true );
+        }
+
+        item->SetNet( net );
+    }
+}
+
+
+static BOARD_ITEM* cloneItem( const BOARD_ITEM* aItem )
+{
+    if( aItem->Type() == PCB_GROUP_T )
+        return static_cast<const PCB_GROUP*>( aItem )->DeepClone();
+    else if( aItem->Type() == PCB_GENERATOR_T )
+        return static_cast<const PCB_GENERATOR*>( aItem )->DeepClone();
+    else
+        return static_cast<BOARD_ITEM*>( aItem->Clone() );
+}
+
+
+static BOARD_ITEM* cloneSnapshot()
+{
+    if( s_snapshot->m_item->Type() == PCB_FOOTPRINT_T )
+        return static_cast<BOARD_ITEM*>( s_snapshot->m_item->Clone() );
+
+    const BOARD*             source = static_cast<const BOARD*>( s_snapshot->m_item.get() );
+    BOARD*                   board = new BOARD();
+    std::vector<BOARD_ITEM*> items;
+
+    copyLayerSetup( source, board );
+
+    // The group members are cloned with their groups
+    for( const BOARD_ITEM* item : s_snapshot->m_items )
+    {
+        if( !item->GetParentGroup() )
+            addToBoard( board, cloneItem( item ), items );
+    }
+
+    mapNetsByName( board );
+
+    return board;
+}
+
+
 CLIPBOARD_IO::CLIPBOARD_IO():
         PCB_IO_KICAD_SEXPR(CTL_FOR_CLIPBOARD ),
         m_formatter()
@@ -63,6 +188,12 @@ void CLIPBOARD_IO::SetBoard( BOARD* aBoard )
 }
 
 
+void CLIPBOARD_IO::ClearSnapshot()
+{
+    s_snapshot.reset();
+}
+
+
 void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootprintEditor )
 {
     VECTOR2I refPoint( 0, 0 );
@@ -77,37 +208,45 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
     // Prepare net mapping that assures that net codes saved in a file are consecutive integers
     m_mapping->SetBoard( m_board );
 
+    // The copied items are kept as they would be parsed back from the text
+    std::unique_ptr<CLIPBOARD_SNAPSHOT> snapshot = std::make_unique<CLIPBOARD_SNAPSHOT>();
+    snapshot->m_id = KIID().AsStdString();
+
     if( aSelected.Size() == 1 && aSelected.Front()->Type() == PCB_FOOTPRINT_T )
     {
         // make the footprint safe to transfer to other pcbs
         const FOOTPRINT* footprint = static_cast<FOOTPRINT*>( aSelected.Front() );
         // Do not modify existing board
-        FOOTPRINT newFootprint( *footprint );
+        FOOTPRINT* newFootprint = new FOOTPRINT( *footprint );
 
-        for( PAD* pad : newFootprint.Pads() )
+        snapshot->m_item.reset( newFootprint );
+
+        for( PAD* pad : newFootprint->Pads() )
             pad->SetNetCode( 0 );
 
         // locked means "locked in place"; copied items therefore can't be locked
-        newFootprint.SetLocked( false );
+        newFootprint->SetLocked( false );
 
         // locate the reference point at (0, 0) in the copied items
-        newFootprint.Move( VECTOR2I( -refPoint.x, -refPoint.y ) );
+        newFootprint->Move( VECTOR2I( -refPoint.x, -refPoint.y ) );
 
-        Format( static_cast<BOARD_ITEM*>( &newFootprint ) );
+        Format( static_cast<BOARD_ITEM*>( newFootprint ) );
 
-        newFootprint.SetParent( nullptr );
-        newFootprint.SetParentGroup( nullptr );
+        newFootprint->SetParent( nullptr );
+        newFootprint->SetParentGroup( nullptr );
     }
     else if( isFootprintEditor )
     {
-        FOOTPRINT partialFootprint( m_board );
+        FOOTPRINT* partialFootprint = new FOOTPRINT( m_board );
+
+        snapshot->m_item.reset( partialFootprint );
 
         // Useful to copy the selection to the board editor (if any), and provides
         // a dummy lib id.
         // Perhaps not a good Id, but better than a empty id
         KIID dummy;
         LIB_ID id( "clipboard", dummy.AsString() );
-        partialFootprint.SetFPID( id );
+        partialFootprint->SetFPID( id );
 
         for( const EDA_ITEM* item : aSelected )
         {
@@ -138,7 +277,7 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
 
             // Add the pad to the new footprint before moving to ensure the local coords are
             // correct
-            partialFootprint.Add( clone );
+            partialFootprint->Add( clone );
 
             // A list of not added items, when adding items to the footprint
             // some PCB_TEXT (reference and value) cannot be added to the footprint
@@ -160,7 +299,7 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
                             }
 
                             if( can_add )
-                                partialFootprint.Add( descendant );
+                                partialFootprint->Add( descendant );
                             else
                                 skipped_items.push_back( descendant );
                         } );
@@ -180,29 +319,22 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
 
         // Set the new relative internal local coordinates of copied items
         FOOTPRINT* editedFootprint = m_board->Footprints().front();
-        VECTOR2I   moveVector = partialFootprint.GetPosition() + editedFootprint->GetPosition();
+        VECTOR2I   moveVector = partialFootprint->GetPosition() + editedFootprint->GetPosition();
 
-        partialFootprint.MoveAnchorPosition( moveVector );
+        partialFootprint->MoveAnchorPosition( moveVector );
 
-        Format( &partialFootprint, 0 );
+        Format( partialFootprint, 0 );
 
-        partialFootprint.SetParent( nullptr );
+        partialFootprint->SetParent( nullptr );
     }
     else
     {
-        // we will fake being a .kicad_pcb to get the full parser kicking
-        // This means we also need layers and nets
-        LOCALE_IO io;
+        // We fake being a .kicad_pcb to get the full parser kicking on external pastes.  The
+        // snapshot holds the same layers, nets and items as the board parsed from the text.
+        BOARD* snapshotBoard = new BOARD();
 
-        m_formatter.Print( 0, "(kicad_pcb (version %d) (generator \"pcbnew\") (generator_version \"%s\")\n",
-                           SEXPR_BOARD_FILE_VERSION, GetMajorMinorVersion().c_str().AsChar() );
-
-        m_formatter.Print( 0, "\n" );
-
-        formatBoardLayers( m_board );
-        formatNetInformation( m_board );
-
-        m_formatter.Print( 0, "\n" );
+        snapshot->m_item.reset( snapshotBoard );
+        copyLayerSetup( m_board, snapshotBoard );
 
         for( EDA_ITEM* item : aSelected )
         {
@@ -241,17 +373,9 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
                 else if( textItem->GetText() == wxT( "${REFERENCE}" ) )
                     textItem->SetText( boardItem->GetParentFootprint()->GetReference() );
             }
-            else if( boardItem->Type() == PCB_GROUP_T )
-            {
-                copy = static_cast<PCB_GROUP*>( boardItem )->DeepClone();
-            }
-            else if( boardItem->Type() == PCB_GENERATOR_T )
-            {
-                copy = static_cast<PCB_GENERATOR*>( boardItem )->DeepClone();
-            }
             else
             {
-                copy = static_cast<BOARD_ITEM*>( boardItem->Clone() );
+                copy = cloneItem( boardItem );
             }
 
             if( copy )
@@ -276,27 +400,50 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
                 }
 
                 copy->SetLocked( false );
+                copy->SetParentGroup( nullptr );
 
                 // locate the reference point at (0, 0) in the copied items
                 copy->Move( -refPoint );
 
-                Format( copy, 1 );
-
                 if( copy->Type() == PCB_GROUP_T || copy->Type() == PCB_GENERATOR_T )
                 {
                     copy->RunOnDescendants(
                             [&]( BOARD_ITEM* titem )
                             {
                                 titem->SetLocked( false );
-                                Format( titem, 1 );
                             } );
                 }
 
-                copy->SetParentGroup( nullptr );
-                delete copy;
+                addToBoard( snapshotBoard, copy, snapshot->m_items );
             }
         }
+
+        // Only the nets of the copied items are kept, under their names
+        mapNetsByName( snapshotBoard );
+
+        LOCALE_IO io;
+        BOARD*    board = m_board;
+
+        m_board = snapshotBoard;
+        m_mapping->SetBoard( snapshotBoard );
+
+        m_formatter.Print( 0, "(kicad_pcb (version %d) (generator \"pcbnew\") (generator_version \"%s\")\n",
+                           SEXPR_BOARD_FILE_VERSION, GetMajorMinorVersion().c_str().AsChar() );
+
+        m_formatter.Print( 0, "\n" );
+
+        formatBoardLayers( snapshotBoard );
+        formatNetInformation( snapshotBoard );
+
+        m_formatter.Print( 0, "\n" );
+
+        for( BOARD_ITEM* item : snapshot->m_items )
+            Format( item, 1 );
+
         m_formatter.Print( 0, "\n)" );
+
+        m_board = board;
+        m_mapping->SetBoard( board );
     }
 
     // These are placed at the end to minimize the open time of the clipboard
@@ -307,8 +454,17 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
     if( !clipboardLock || !clipboard->IsOpened() )
         return;
 
-    clipboard->SetData( new wxTextDataObject( wxString( m_formatter.GetString().c_str(),
-                                                        wxConvUTF8 ) ) );
+    wxDataObjectComposite* data = new wxDataObjectComposite();
+    wxCustomDataObject*    idData = new wxCustomDataObject( snapshotFormat() );
+
+    data->Add( new wxTextDataObject( wxString( m_formatter.GetString().c_str(), wxConvUTF8 ) ),
+               true );
+
+    idData->SetData( snapshot->m_id.size(), snapshot->m_id.data() );
+    data->Add( idData );
+
+    clipboard->SetData( data );
+    s_snapshot = std::move( snapshot );
 
     clipboard->Flush();
 
@@ -343,6 +499,20 @@ BOARD_ITEM* CLIPBOARD_IO::Parse()
     if( !clipboardLock )
         return nullptr;
 
+    // A copy made by this process is cloned rather than parsed back from its text
+    if( s_snapshot && clipboard->IsSupported( snapshotFormat() ) )
+    {
+        wxCustomDataObject idData( snapshotFormat() );
+        const std::string& id = s_snapshot->m_id;
+
+        // Some platforms round the size of the custom data up
+        if( clipboard->GetData( idData ) && idData.GetSize() >= id.size()
+                && std::memcmp( idData.GetData(), id.data(), id.size() ) == 0 )
+        {
+            return cloneSnapshot();
+        }
+    }
+
     if( clipboard->IsSupported( wxDF_TEXT ) || clipboard->IsSupported( wxDF_UNICODETEXT ) )
     {
         wxTextDataObject data;
@@ -63,6 +63,12 @@ public:
 
     void SetBoard( BOARD* aBoard );
 
+    /**
+     * Free the items kept from the last copy, which a paste in this process clones instead of
+     * parsing the clipboard text.  Must be called before the board data is torn down.
+     */
+    static void ClearSnapshot();
+
 private:
     STRING_FORMATTER m_formatter;
 };
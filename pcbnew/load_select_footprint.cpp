@@ -24,12 +24,14 @@
  */
 
 #include <functional>
+#include <map>
 using namespace std::placeholders;
 
 #include <board.h>
 #include <footprint.h>
 #include <confirm.h>
 #include <connectivity/connectivity_data.h>
+#include <core/thread_pool.h>
 #include <dialog_footprint_chooser.h>
 #include <dialog_get_footprint_by_name.h>
 #include <eda_list_dialog.h>
@@ -41,6 +43,7 @@ using namespace std::placeholders;
 #include <string_utils.h>
 #include <kiway.h>
 #include <lib_id.h>
+#include <locale_io.h>
 #include <macros.h>
 #include <pcb_edit_frame.h>
 #include <pcbnew_settings.h>
@@ -253,21 +256,93 @@ FOOTPRINT* PCB_BASE_FRAME::loadFootprint( const LIB_ID& aFootprintId )
     }
 
     if( footprint )
+        prepareLoadedFootprint( footprint );
+
+    return footprint;
+}
+
+
+void PCB_BASE_FRAME::prepareLoadedFootprint( FOOTPRINT* aFootprint )
+{
+    // If the footprint is found, clear all net info to be sure there are no broken links to
+    // any netinfo list (should be not needed, but it can be edited from the footprint editor )
+    aFootprint->ClearAllNets();
+
+    if( m_pcb && !m_pcb->IsFootprintHolder() )
     {
-        // If the footprint is found, clear all net info to be sure there are no broken links to
-        // any netinfo list (should be not needed, but it can be edited from the footprint editor )
-        footprint->ClearAllNets();
+        BOARD_DESIGN_SETTINGS& bds = m_pcb->GetDesignSettings();
 
-        if( m_pcb && !m_pcb->IsFootprintHolder() )
-        {
-            BOARD_DESIGN_SETTINGS& bds = m_pcb->GetDesignSettings();
+        aFootprint->ApplyDefaultSettings( *m_pcb, bds.m_StyleFPFields, bds.m_StyleFPText,
+                                          bds.m_StyleFPShapes );
+    }
+}
 
-            footprint->ApplyDefaultSettings( *m_pcb, bds.m_StyleFPFields, bds.m_StyleFPText,
-                                             bds.m_StyleFPShapes );
-        }
+
+std::vector<FOOTPRINT*>
+PCB_BASE_FRAME::LoadLibraryFootprints( const std::vector<LIB_ID>& aFootprintIds )
+{
+    FP_LIB_TABLE*           fptbl = PROJECT_PCB::PcbFootprintLibs( &Prj() );
+    std::vector<FOOTPRINT*> footprints( aFootprintIds.size(), nullptr );
+
+    wxCHECK_MSG( fptbl, footprints, wxT( "Cannot look up LIB_ID in NULL FP_LIB_TABLE." ) );
+
+    bool keepUUID = IsType( FRAME_FOOTPRINT_EDITOR );
+
+    // A library plugin can only be used by one thread at a time, so each library is loaded by
+    // a single task.  The footprints without a nickname are searched in every library, so they
+    // are loaded once the tasks are done.
+    std::map<wxString, std::vector<size_t>> byLibrary;
+    std::vector<size_t>                     unnamed;
+
+    for( size_t ii = 0; ii < aFootprintIds.size(); ++ii )
+    {
+        if( aFootprintIds[ii].GetLibNickname().empty() )
+            unnamed.push_back( ii );
+        else
+            byLibrary[aFootprintIds[ii].GetLibNickname()].push_back( ii );
     }
 
-    return footprint;
+    std::vector<const std::vector<size_t>*> libraries;
+
+    for( const auto& [nickname, indices] : byLibrary )
+        libraries.push_back( &indices );
+
+    auto load =
+            [&]( size_t aIndex )
+            {
+                try
+                {
+                    footprints[aIndex] = fptbl->FootprintLoadWithOptionalNickname(
+                            aFootprintIds[aIndex], keepUUID );
+                }
+                catch( const IO_ERROR& )
+                {
+                }
+            };
+
+    {
+        // The locale is global: it is only safe to switch it before the tasks start and to
+        // restore it after they finish, while this thread waits for them.
+        LOCALE_IO toggle;
+
+        ParallelForEachIndex( libraries.size(),
+                [&]( size_t aLibrary )
+                {
+                    for( size_t index : *libraries[aLibrary] )
+                        load( index );
+                } );
+
+        for( size_t index : unnamed )
+            load( index );
+    }
+
+    for( FOOTPRINT* footprint : footprints )
+    {
+        if( footprint )
+            prepareLoadedFootprint( footprint );
+    }
+
+    return footprints;
 }
 
 
@@ -93,33 +93,35 @@ void NETINFO_ITEM::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANE
 
     if( board )
     {
+        int        padCount   = 0;
         int        count      = 0;
         PCB_TRACK* startTrack = nullptr;
 
-        for( FOOTPRINT* footprint : board->Footprints() )
+        for( BOARD_CONNECTED_ITEM* item : board->GetNetItems( GetNetCode() ) )
         {
-            for( PAD* pad : footprint->Pads() )
+            switch( item->Type() )
             {
-                if( pad->GetNetCode() == GetNetCode() )
-                    count++;
-            }
-        }
+            case PCB_PAD_T:
+                padCount++;
+                break;
 
-        aList.emplace_back( _( "Pads" ), wxString::Format( wxT( "%d" ), count ) );
+            case PCB_VIA_T:
+                count++;
+                break;
 
-        count = 0;
+            case PCB_TRACE_T:
+            case PCB_ARC_T:
+                if( !startTrack )
+                    startTrack = static_cast<PCB_TRACK*>( item );
 
-        for( PCB_TRACK* track : board->Tracks() )
-        {
-            if( track->GetNetCode() == GetNetCode() )
-            {
-                if( track->Type() == PCB_VIA_T )
-                    count++;
-                else if( !startTrack )
-                    startTrack = track;
+                break;
+
+            default:
+                break;
             }
         }
 
+        aList.emplace_back( _( "Pads" ), wxString::Format( wxT( "%d" ), padCount ) );
         aList.emplace_back( _( "Vias" ), wxString::Format( wxT( "%d" ), count ) );
 
         if( startTrack )
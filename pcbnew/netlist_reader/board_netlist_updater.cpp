@@ -28,6 +28,8 @@
 
 
 #include <common.h>                         // for PAGE_INFO
+#include <core/thread_pool.h>
+#include <locale_io.h>
 
 #include <base_units.h>
 #include <board.h>
@@ -40,6 +42,7 @@
 #include <string_utils.h>
 #include <pcbnew_settings.h>
 #include <pcb_edit_frame.h>
+#include <project_pcb.h>
 #include <netlist_reader/pcb_netlist.h>
 #include <connectivity/connectivity_data.h>
 #include <reporter.h>
@@ -67,6 +70,8 @@ BOARD_NETLIST_UPDATER::BOARD_NETLIST_UPDATER( PCB_EDIT_FRAME* aFrame, BOARD* aBo
 
 BOARD_NETLIST_UPDATER::~BOARD_NETLIST_UPDATER()
 {
+    for( const auto& [component, footprint] : m_prefetchedFootprints )
+        delete footprint;
 }
 
 
@@ -131,6 +136,79 @@ VECTOR2I BOARD_NETLIST_UPDATER::estimateFootprintInsertionPosition()
 }
 
 
+void BOARD_NETLIST_UPDATER::prefetchFootprints( const std::vector<COMPONENT*>& aComponents )
+{
+    // The footprints of a library share the cache of its plugin, so only the libraries are
+    // loaded in parallel.  The footprints without a library nickname are searched in all the
+    // libraries and are left to loadFootprint().
+    std::map<wxString, std::vector<COMPONENT*>> componentsByLibrary;
+
+    for( COMPONENT* component : aComponents )
+    {
+        const LIB_ID& fpid = component->GetFPID();
+
+        if( !fpid.empty() && !fpid.GetLibNickname().empty() )
+            componentsByLibrary[fpid.GetLibNickname()].push_back( component );
+    }
+
+    if( componentsByLibrary.size() < 2 )
+        return;
+
+    // Create the library table before the threads use it
+    PROJECT_PCB::PcbFootprintLibs( &m_frame->Prj() );
+
+    // The locale is global: it is only changed here, while the workers are parsing
+    LOCALE_IO    toggle;
+    thread_pool& tp = GetKiCadThreadPool();
+
+    std::vector<std::future<std::vector<FOOTPRINT*>>> results;
+
+    for( const auto& entry : componentsByLibrary )
+    {
+        const std::vector<COMPONENT*>* components = &entry.second;
+
+        results.push_back( tp.submit(
+                [this, components]() -> std::vector<FOOTPRINT*>
+                {
+                    std::vector<FOOTPRINT*> footprints;
+
+                    for( COMPONENT* component : *components )
+                        footprints.push_back( m_frame->LoadFootprint( component->GetFPID() ) );
+
+                    return footprints;
+                } ) );
+    }
+
+    size_t ii = 0;
+
+    for( const auto& entry : componentsByLibrary )
+    {
+        std::vector<FOOTPRINT*> footprints = results[ii++].get();
+
+        for( size_t jj = 0; jj < footprints.size(); ++jj )
+        {
+            if( footprints[jj] )
+                m_prefetchedFootprints[entry.second[jj]] = footprints[jj];
+        }
+    }
+}
+
+
+FOOTPRINT* BOARD_NETLIST_UPDATER::loadFootprint( COMPONENT* aComponent )
+{
+    auto it = m_prefetchedFootprints.find( aComponent );
+
+    if( it != m_prefetchedFootprints.end() )
+    {
+        FOOTPRINT* footprint = it->second;
+        m_prefetchedFootprints.erase( it );
+        return footprint;
+    }
+
+    return m_frame->LoadFootprint( aComponent->GetFPID() );
+}
+
+
 FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent )
 {
     wxString msg;
@@ -145,7 +223,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent )
         return nullptr;
     }
 
-    FOOTPRINT* footprint = m_frame->LoadFootprint( aComponent->GetFPID() );
+    FOOTPRINT* footprint = loadFootprint( aComponent );
 
     if( footprint == nullptr )
     {
@@ -215,7 +293,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::replaceFootprint( NETLIST& aNetlist, FOOTPRINT
         return nullptr;
     }
 
-    FOOTPRINT* newFootprint = m_frame->LoadFootprint( aNewComponent->GetFPID() );
+    FOOTPRINT* newFootprint = loadFootprint( aNewComponent );
 
     if( newFootprint == nullptr )
     {
@@ -1095,7 +1173,6 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
 
 bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 {
-    FOOTPRINT* lastPreexistingFootprint = nullptr;
     COMPONENT* component = nullptr;
     wxString   msg;
 
@@ -1105,9 +1182,6 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     std::map<COMPONENT*, FOOTPRINT*> footprintMap;
 
-    if( !m_board->Footprints().empty() )
-        lastPreexistingFootprint = m_board->Footprints().back();
-
     cacheCopperZoneConnections();
 
     // First mark all nets (except <no net>) as stale; we'll update those which are current
@@ -1119,6 +1193,63 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
             net->SetIsCurrent( net->GetNetCode() == 0 );
     }
 
+    // Index the board footprints, so that matching them to the components is not quadratic
+    std::unordered_map<KIID_PATH, std::vector<FOOTPRINT*>> footprintsByPath;
+    std::unordered_map<wxString, std::vector<FOOTPRINT*>>  footprintsByReference;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        if( m_lookupByTimestamp )
+            footprintsByPath[footprint->GetPath()].push_back( footprint );
+        else
+            footprintsByReference[footprint->GetReference().Lower()].push_back( footprint );
+    }
+
+    std::vector<std::vector<FOOTPRINT*>> matches( aNetlist.GetCount() );
+    std::vector<COMPONENT*>              componentsToLoad;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        if( component->GetProperties().count( wxT( "exclude_from_board" ) ) )
+            continue;
+
+        if( m_lookupByTimestamp )
+        {
+            for( const KIID& uuid : component->GetKIIDs() )
+            {
+                KIID_PATH base = component->GetPath();
+                base.push_back( uuid );
+
+                auto it = footprintsByPath.find( base );
+
+                if( it != footprintsByPath.end() )
+                    matches[i].insert( matches[i].end(), it->second.begin(), it->second.end() );
+            }
+        }
+        else
+        {
+            auto it = footprintsByReference.find( component->GetReference().Lower() );
+
+            if( it != footprintsByReference.end() )
+                matches[i] = it->second;
+        }
+
+        bool needsFootprint = matches[i].empty();
+
+        for( FOOTPRINT* footprint : matches[i] )
+        {
+            if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
+                needsFootprint = true;
+        }
+
+        if( needsFootprint )
+            componentsToLoad.push_back( component );
+    }
+
+    prefetchFootprints( componentsToLoad );
+
     // Next go through the netlist updating all board footprints which have matching component
     // entries and adding new footprints for those that don't.
     //
@@ -1136,52 +1267,22 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
         int matchCount = 0;
 
-        for( FOOTPRINT* footprint : m_board->Footprints() )
+        for( FOOTPRINT* footprint : matches[i] )
         {
-            bool match = false;
+            FOOTPRINT* tmp = footprint;
 
-            if( m_lookupByTimestamp )
-            {
-                for( const KIID& uuid : component->GetKIIDs() )
-                {
-                    KIID_PATH base = component->GetPath();
-                    base.push_back( uuid );
+            if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
+                tmp = replaceFootprint( aNetlist, footprint, component );
 
-                    if( footprint->GetPath() == base )
-                    {
-                        match = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
-            }
-
-            if( match )
+            if( tmp )
             {
-                FOOTPRINT* tmp = footprint;
-
-                if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
-                    tmp = replaceFootprint( aNetlist, footprint, component );
-
-                if( tmp )
-                {
-                    footprintMap[ component ] = tmp;
-
-                    updateFootprintParameters( tmp, component );
-                    updateComponentPadConnections( tmp, component );
-                }
+                footprintMap[ component ] = tmp;
 
-                matchCount++;
+                updateFootprintParameters( tmp, component );
+                updateComponentPadConnections( tmp, component );
             }
 
-            if( footprint == lastPreexistingFootprint )
-            {
-                // No sense going through the newly-created footprints: end of loop
-                break;
-            }
+            matchCount++;
         }
 
         if( matchCount == 0 )
@@ -1206,6 +1307,29 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     updateCopperZoneNets( aNetlist );
 
+    // Same lookups as NETLIST::GetComponentByPath() and GetComponentByReference()
+    std::unordered_map<KIID_PATH, COMPONENT*> componentsByPath;
+    std::unordered_map<wxString, COMPONENT*>  componentsByReference;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        if( m_lookupByTimestamp )
+        {
+            for( const KIID& uuid : component->GetKIIDs() )
+            {
+                KIID_PATH path = component->GetPath();
+                path.push_back( uuid );
+                componentsByPath.emplace( path, component );
+            }
+        }
+        else
+        {
+            componentsByReference.emplace( component->GetReference(), component );
+        }
+    }
+
     // Finally go through the board footprints and update all those that *don't* have matching
     // component entries.
     //
@@ -1217,10 +1341,22 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         if( ( footprint->GetAttributes() & FP_BOARD_ONLY ) > 0 )
             doDelete = false;
 
+        component = nullptr;
+
         if( m_lookupByTimestamp )
-            component = aNetlist.GetComponentByPath( footprint->GetPath() );
+        {
+            auto it = componentsByPath.find( footprint->GetPath() );
+
+            if( it != componentsByPath.end() )
+                component = it->second;
+        }
         else
-            component = aNetlist.GetComponentByReference( footprint->GetReference() );
+        {
+            auto it = componentsByReference.find( footprint->GetReference() );
+
+            if( it != componentsByReference.end() )
+                component = it->second;
+        }
 
         if( component && component->GetProperties().count( wxT( "exclude_from_board" ) ) == 0 )
             matched = true;
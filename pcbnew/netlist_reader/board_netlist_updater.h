@@ -100,6 +100,16 @@ private:
 
     VECTOR2I estimateFootprintInsertionPosition();
 
+    /**
+     * Load the library footprints of \a aComponents in parallel, one library per thread.
+     */
+    void prefetchFootprints( const std::vector<COMPONENT*>& aComponents );
+
+    /**
+     * @return a new footprint for \a aComponent, prefetched or loaded from the libraries.
+     */
+    FOOTPRINT* loadFootprint( COMPONENT* aComponent );
+
     FOOTPRINT* addNewFootprint( COMPONENT* aComponent );
 
     FOOTPRINT* replaceFootprint( NETLIST& aNetlist, FOOTPRINT* aFootprint,
@@ -126,6 +136,7 @@ private:
     std::map<PAD*, wxString>           m_padPinFunctions;
     std::vector<FOOTPRINT*>            m_addedFootprints;
     std::map<wxString, NETINFO_ITEM*>  m_addedNets;
+    std::map<COMPONENT*, FOOTPRINT*>   m_prefetchedFootprints;
 
     bool m_deleteUnusedFootprints;
     bool m_isDryRun;
@@ -28,6 +28,7 @@
 #include <core/mirror.h>
 #include <math/util.h>      // for KiROUND
 #include <eda_draw_frame.h>
+#include <geometry/inflate_cache.h>
 #include <geometry/shape_circle.h>
 #include <geometry/shape_segment.h>
 #include <geometry/shape_simple.h>
@@ -103,7 +104,6 @@ PAD::PAD( FOOTPRINT* parent ) :
     SetSubRatsnest( 0 );                       // used in ratsnest calculations
 
     SetDirty();
-    m_effectiveBoundingRadius = 0;
     m_removeUnconnectedLayer = false;
     m_keepTopBottomLayer = true;
 
@@ -131,7 +131,6 @@ PAD& PAD::operator=( const PAD &aOther )
     SetPinType( aOther.GetPinType() );
     SetPinFunction( aOther.GetPinFunction() );
     SetSubRatsnest( aOther.GetSubRatsnest() );
-    m_effectiveBoundingRadius = aOther.m_effectiveBoundingRadius;
     m_removeUnconnectedLayer = aOther.m_removeUnconnectedLayer;
     m_keepTopBottomLayer = aOther.m_keepTopBottomLayer;
 
@@ -344,7 +343,7 @@ void PAD::SetDrillShape( PAD_DRILL_SHAPE_T aShape )
     if( aShape == PAD_DRILL_SHAPE_CIRCLE )
         SetDrillSizeY( GetDrillSizeX() );
 
-    m_shapesDirty = true;
+    std::atomic_store( &m_effectiveShapes, std::shared_ptr<const EFFECTIVE_SHAPES>() );
 }
 
 
@@ -379,12 +378,38 @@ void PAD::SetChamferRectRatio( double aChamferScale )
 }
 
 
-const std::shared_ptr<SHAPE_POLY_SET>& PAD::GetEffectivePolygon( ERROR_LOC aErrorLoc ) const
+std::shared_ptr<const PAD::EFFECTIVE_SHAPES> PAD::getEffectiveShapes() const
 {
-    if( m_polyDirty[ aErrorLoc ] )
+    std::shared_ptr<const EFFECTIVE_SHAPES> shapes = std::atomic_load( &m_effectiveShapes );
+
+    if( !shapes )
+    {
+        BuildEffectiveShapes( UNDEFINED_LAYER );
+        shapes = std::atomic_load( &m_effectiveShapes );
+    }
+
+    return shapes;
+}
+
+
+std::shared_ptr<const PAD::EFFECTIVE_POLYGON> PAD::getEffectivePolygon( ERROR_LOC aErrorLoc ) const
+{
+    std::shared_ptr<const EFFECTIVE_POLYGON> poly =
+            std::atomic_load( &m_effectivePolygons[ aErrorLoc ] );
+
+    if( !poly )
+    {
         BuildEffectivePolygon( aErrorLoc );
+        poly = std::atomic_load( &m_effectivePolygons[ aErrorLoc ] );
+    }
 
-    return m_effectivePolygon[ aErrorLoc ];
+    return poly;
+}
+
+
+std::shared_ptr<SHAPE_POLY_SET> PAD::GetEffectivePolygon( ERROR_LOC aErrorLoc ) const
+{
+    return getEffectivePolygon( aErrorLoc )->m_polygon;
 }
 
 
@@ -418,28 +443,19 @@ std::shared_ptr<SHAPE> PAD::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHING fla
         }
     }
 
-    if( m_shapesDirty )
-        BuildEffectiveShapes( aLayer );
-
-    return m_effectiveShape;
+    return getEffectiveShapes()->m_shape;
 }
 
 
 std::shared_ptr<SHAPE_SEGMENT> PAD::GetEffectiveHoleShape() const
 {
-    if( m_shapesDirty )
-        BuildEffectiveShapes( UNDEFINED_LAYER );
-
-    return m_effectiveHoleShape;
+    return getEffectiveShapes()->m_holeShape;
 }
 
 
 int PAD::GetBoundingRadius() const
 {
-    if( m_polyDirty[ ERROR_OUTSIDE ] )
-        BuildEffectivePolygon( ERROR_OUTSIDE );
-
-    return m_effectiveBoundingRadius;
+    return getEffectivePolygon( ERROR_OUTSIDE )->m_boundingRadius;
 }
 
 
@@ -449,18 +465,18 @@ void PAD::BuildEffectiveShapes( PCB_LAYER_ID aLayer ) const
 
     // If we had to wait for the lock then we were probably waiting for someone else to
     // finish rebuilding the shapes.  So check to see if they're clean now.
-    if( !m_shapesDirty )
+    if( std::atomic_load( &m_effectiveShapes ) )
         return;
 
     const BOARD* board = GetBoard();
     int          maxError = board ? board->GetDesignSettings().m_MaxError : ARC_HIGH_DEF;
 
-    m_effectiveShape = std::make_shared<SHAPE_COMPOUND>();
-    m_effectiveHoleShape = nullptr;
+    std::shared_ptr<EFFECTIVE_SHAPES> shapes = std::make_shared<EFFECTIVE_SHAPES>();
+    shapes->m_shape = std::make_shared<SHAPE_COMPOUND>();
 
-    auto add = [this]( SHAPE* aShape )
+    auto add = [&shapes]( SHAPE* aShape )
                {
-                   m_effectiveShape->AddShape( aShape );
+                   shapes->m_shape->AddShape( aShape );
                };
 
     VECTOR2I  shapePos = ShapePos(); // Fetch only once; rotation involves trig
@@ -600,7 +616,7 @@ void PAD::BuildEffectiveShapes( PCB_LAYER_ID aLayer ) const
         }
     }
 
-    m_effectiveBoundingBox = m_effectiveShape->BBox();
+    shapes->m_boundingBox = shapes->m_shape->BBox();
 
     // Hole shape
     VECTOR2I half_size = m_drill / 2;
@@ -609,12 +625,12 @@ void PAD::BuildEffectiveShapes( PCB_LAYER_ID aLayer ) const
 
     RotatePoint( half_len, m_orient );
 
-    m_effectiveHoleShape = std::make_shared<SHAPE_SEGMENT>( m_pos - half_len, m_pos + half_len,
-                                                            half_width * 2 );
-    m_effectiveBoundingBox.Merge( m_effectiveHoleShape->BBox() );
+    shapes->m_holeShape = std::make_shared<SHAPE_SEGMENT>( m_pos - half_len, m_pos + half_len,
+                                                           half_width * 2 );
+    shapes->m_boundingBox.Merge( shapes->m_holeShape->BBox() );
 
     // All done
-    m_shapesDirty = false;
+    std::atomic_store( &m_effectiveShapes, std::shared_ptr<const EFFECTIVE_SHAPES>( shapes ) );
 }
 
 
@@ -624,14 +640,15 @@ void PAD::BuildEffectivePolygon( ERROR_LOC aErrorLoc ) const
 
     // If we had to wait for the lock then we were probably waiting for someone else to
     // finish rebuilding the shapes.  So check to see if they're clean now.
-    if( !m_polyDirty[ aErrorLoc ] )
+    if( std::atomic_load( &m_effectivePolygons[ aErrorLoc ] ) )
         return;
 
     const BOARD* board = GetBoard();
     int          maxError = board ? board->GetDesignSettings().m_MaxError : ARC_HIGH_DEF;
 
     // Polygon
-    std::shared_ptr<SHAPE_POLY_SET>& effectivePolygon = m_effectivePolygon[ aErrorLoc ];
+    std::shared_ptr<EFFECTIVE_POLYGON> poly = std::make_shared<EFFECTIVE_POLYGON>();
+    std::shared_ptr<SHAPE_POLY_SET>&   effectivePolygon = poly->m_polygon;
 
     effectivePolygon = std::make_shared<SHAPE_POLY_SET>();
     TransformShapeToPolygon( *effectivePolygon, UNDEFINED_LAYER, 0, maxError, aErrorLoc );
@@ -642,8 +659,6 @@ void PAD::BuildEffectivePolygon( ERROR_LOC aErrorLoc ) const
     // values....
     if( aErrorLoc == ERROR_OUTSIDE )
     {
-        m_effectiveBoundingRadius = 0;
-
         for( int cnt = 0; cnt < effectivePolygon->OutlineCount(); ++cnt )
         {
             const SHAPE_LINE_CHAIN& poly = effectivePolygon->COutline( cnt );
@@ -651,22 +666,20 @@ void PAD::BuildEffectivePolygon( ERROR_LOC aErrorLoc ) const
             for( int ii = 0; ii < poly.PointCount(); ++ii )
             {
                 int dist = KiROUND( ( poly.CPoint( ii ) - m_pos ).EuclideanNorm() );
-                m_effectiveBoundingRadius = std::max( m_effectiveBoundingRadius, dist );
+                poly->m_boundingRadius = std::max( poly->m_boundingRadius, dist );
             }
         }
     }
 
     // All done
-    m_polyDirty[ aErrorLoc ] = false;
+    std::atomic_store( &m_effectivePolygons[ aErrorLoc ],
+                       std::shared_ptr<const EFFECTIVE_POLYGON>( poly ) );
 }
 
 
 const BOX2I PAD::GetBoundingBox() const
 {
-    if( m_shapesDirty )
-        BuildEffectiveShapes( UNDEFINED_LAYER );
-
-    return m_effectiveBoundingBox;
+    return getEffectiveShapes()->m_boundingBox;
 }
 
 
@@ -1723,7 +1736,11 @@ void PAD::TransformShapeToPolygon( SHAPE_POLY_SET& aBuffer, PCB_LAYER_ID aLayer,
             if( aErrorLoc == ERROR_OUTSIDE )
                 aClearance += aMaxError;
 
-            outline.Inflate( aClearance, CORNER_STRATEGY::ROUND_ALL_CORNERS, aMaxError );
+            // Every zone asks for the clearance outlines of the pads it knocks out
+            static INFLATE_CACHE s_clearanceCache;
+
+            s_clearanceCache.Inflate( outline, aClearance, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                      aMaxError );
             outline.Fracture( SHAPE_POLY_SET::PM_FAST );
         }
         else if( aClearance < 0 )
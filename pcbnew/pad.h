@@ -357,14 +357,19 @@ public:
 
     bool IsDirty() const
     {
-        return m_shapesDirty || m_polyDirty[ERROR_INSIDE] || m_polyDirty[ERROR_OUTSIDE];
+        return !std::atomic_load( &m_effectiveShapes )
+                || !std::atomic_load( &m_effectivePolygons[ERROR_INSIDE] )
+                || !std::atomic_load( &m_effectivePolygons[ERROR_OUTSIDE] );
     }
 
     void SetDirty()
     {
-        m_shapesDirty = true;
-        m_polyDirty[ERROR_INSIDE] = true;
-        m_polyDirty[ERROR_OUTSIDE] = true;
+        // The readers still holding the previous caches keep them alive
+        std::atomic_store( &m_effectiveShapes, std::shared_ptr<const EFFECTIVE_SHAPES>() );
+        std::atomic_store( &m_effectivePolygons[ERROR_INSIDE],
+                           std::shared_ptr<const EFFECTIVE_POLYGON>() );
+        std::atomic_store( &m_effectivePolygons[ERROR_OUTSIDE],
+                           std::shared_ptr<const EFFECTIVE_POLYGON>() );
     }
 
     void SetLayerSet( LSET aLayers ) override   { m_layerMask = aLayers; }
@@ -445,7 +450,7 @@ public:
     GetEffectiveShape( PCB_LAYER_ID aLayer = UNDEFINED_LAYER,
                        FLASHING flashPTHPads = FLASHING::DEFAULT ) const override;
 
-    const std::shared_ptr<SHAPE_POLY_SET>& GetEffectivePolygon( ERROR_LOC aErrorLoc = ERROR_INSIDE ) const;
+    std::shared_ptr<SHAPE_POLY_SET> GetEffectivePolygon( ERROR_LOC aErrorLoc = ERROR_INSIDE ) const;
 
     /**
      * Return a SHAPE_SEGMENT object representing the pad's hole.
@@ -703,8 +708,9 @@ public:
     }
 
     /**
-     * Rebuild the effective shape cache (and bounding box and radius) for the pad and clears
-     * the dirty bit.
+     * Rebuild the effective shape cache (and bounding box and radius) for the pad if it is
+     * dirty.  The caches are published whole once built, so that they can be read from several
+     * threads without a lock.
      */
     void BuildEffectiveShapes( PCB_LAYER_ID aLayer ) const;
     void BuildEffectivePolygon( ERROR_LOC aErrorLoc = ERROR_INSIDE ) const;
@@ -748,6 +754,23 @@ protected:
     virtual void swapData( BOARD_ITEM* aImage ) override;
 
 private:
+    struct EFFECTIVE_SHAPES
+    {
+        std::shared_ptr<SHAPE_COMPOUND> m_shape;
+        std::shared_ptr<SHAPE_SEGMENT>  m_holeShape;
+        BOX2I                           m_boundingBox;
+    };
+
+    struct EFFECTIVE_POLYGON
+    {
+        std::shared_ptr<SHAPE_POLY_SET> m_polygon;
+        int                             m_boundingRadius = 0;   // Only for ERROR_OUTSIDE
+    };
+
+    /// @return the shape caches, built if needed.
+    std::shared_ptr<const EFFECTIVE_SHAPES> getEffectiveShapes() const;
+    std::shared_ptr<const EFFECTIVE_POLYGON> getEffectivePolygon( ERROR_LOC aErrorLoc ) const;
+
     void addPadPrimitivesToPolygon( SHAPE_POLY_SET* aMergedPolygon, int aError,
                                     ERROR_LOC aErrorLoc ) const;
 
@@ -768,17 +791,14 @@ private:
      */
     std::vector<std::shared_ptr<PCB_SHAPE>>   m_editPrimitives;
 
-    // Must be set to true to force rebuild shapes to draw (after geometry change for instance)
-    mutable bool                              m_shapesDirty;
-    mutable std::mutex                        m_shapesBuildingLock;
-    mutable BOX2I                             m_effectiveBoundingBox;
-    mutable std::shared_ptr<SHAPE_COMPOUND>   m_effectiveShape;
-    mutable std::shared_ptr<SHAPE_SEGMENT>    m_effectiveHoleShape;
-
-    mutable bool                              m_polyDirty[2];
-    mutable std::mutex                        m_polyBuildingLock;
-    mutable std::shared_ptr<SHAPE_POLY_SET>   m_effectivePolygon[2];
-    mutable int                               m_effectiveBoundingRadius;
+    // The caches are immutable once published, and null when they must be rebuilt (after a
+    // geometry change for instance).  They are only accessed through std::atomic_load() and
+    // std::atomic_store(); the locks only keep two threads from building the same cache.
+    mutable std::shared_ptr<const EFFECTIVE_SHAPES>  m_effectiveShapes;
+    mutable std::mutex                               m_shapesBuildingLock;
+
+    mutable std::shared_ptr<const EFFECTIVE_POLYGON> m_effectivePolygons[2];
+    mutable std::mutex                               m_polyBuildingLock;
 
     int               m_subRatsnest;        // Variable used to handle subnet (block) number in
                                             //   ratsnest computations
@@ -37,6 +37,10 @@
 #include <pcb_dimension.h>
 #include <footprint.h>
 #include <footprint_info_impl.h>
+#include <memory_accounting.h>
+#include <pad.h>
+#include <pcb_shape.h>
+#include <pcb_track.h>
 #include <project.h>
 #include <settings/color_settings.h>
 #include <settings/settings_manager.h>
@@ -45,6 +49,7 @@
 #include <dialogs/eda_view_switcher.h>
 #include <wildcards_and_files_ext.h>
 #include <widgets/wx_aui_utils.h>
+#include <zone.h>
 
 
 PCB_BASE_EDIT_FRAME::PCB_BASE_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent,
@@ -78,15 +83,82 @@ PCB_BASE_EDIT_FRAME::PCB_BASE_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent,
                   m_darkMode = KIPLATFORM::UI::IsDarkTheme();
               }
           } );
+
+    m_memoryAccount = std::make_unique<MEMORY_ACCOUNT>(
+            [this]( MEMORY_REPORT& aReport )
+            {
+                reportUndoMemoryUsage( aReport );
+            } );
 }
 
 
 PCB_BASE_EDIT_FRAME::~PCB_BASE_EDIT_FRAME()
 {
+    m_memoryAccount.reset();
     GetCanvas()->GetView()->Clear();
 }
 
 
+/**
+ * @return an estimate of the memory held by a copy of \a aItem kept for undo.  The zone fills
+ *         are shared with the board until they change, but are counted anyway.
+ */
+static size_t undoItemMemoryUsage( const EDA_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_FOOTPRINT_T:
+        return static_cast<const FOOTPRINT*>( aItem )->GetMemoryUsage();
+
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( aItem );
+        return sizeof( ZONE ) + zone->Outline()->GetMemoryUsage() + zone->GetFillMemoryUsage();
+    }
+
+    case PCB_SHAPE_T:
+        return sizeof( PCB_SHAPE )
+               + static_cast<const PCB_SHAPE*>( aItem )->GetPolyShape().GetMemoryUsage();
+
+    case PCB_TRACE_T: return sizeof( PCB_TRACK );
+    case PCB_ARC_T:   return sizeof( PCB_ARC );
+    case PCB_VIA_T:   return sizeof( PCB_VIA );
+    case PCB_PAD_T:   return sizeof( PAD );
+    default:          return sizeof( PCB_DIM_ALIGNED );   // The largest of the other items
+    }
+}
+
+
+void PCB_BASE_EDIT_FRAME::reportUndoMemoryUsage( MEMORY_REPORT& aReport ) const
+{
+    size_t size = 0;
+
+    for( const UNDO_REDO_CONTAINER* container : { &m_undoList, &m_redoList } )
+    {
+        for( const PICKED_ITEMS_LIST* list : container->m_CommandsList )
+        {
+            size += sizeof( PICKED_ITEMS_LIST ) + list->GetCount() * sizeof( ITEM_PICKER );
+
+            for( unsigned ii = 0; ii < list->GetCount(); ++ii )
+            {
+                // The list owns the copies of the changed items and the deleted items
+                const EDA_ITEM* item = nullptr;
+
+                if( list->GetPickedItemStatus( ii ) == UNDO_REDO::CHANGED )
+                    item = list->GetPickedItemLink( ii );
+                else if( list->GetPickedItemStatus( ii ) == UNDO_REDO::DELETED )
+                    item = list->GetPickedItem( ii );
+
+                if( item )
+                    size += undoItemMemoryUsage( item );
+            }
+        }
+    }
+
+    aReport.Add( MEMORY_CATEGORY::UNDO_HISTORY, size );
+}
+
+
 void PCB_BASE_EDIT_FRAME::doCloseWindow()
 {
     SETTINGS_MANAGER* mgr = GetSettingsManager();
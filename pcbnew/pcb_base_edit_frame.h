@@ -35,6 +35,8 @@ class PANEL_SELECTION_FILTER;
 class PCB_TEXTBOX;
 class PCB_TEXT;
 class PCB_SHAPE;
+class MEMORY_ACCOUNT;
+class MEMORY_REPORT;
 
 /**
  * Common, abstract interface for edit frames.
@@ -191,9 +193,14 @@ public:
     /* full undo redo management : */
 
     // use EDA_BASE_FRAME::ClearUndoRedoList()
-    // use EDA_BASE_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
     // use EDA_BASE_FRAME::PushCommandToRedoList( PICKED_ITEMS_LIST* aItem )
 
+    /**
+     * Push \a aItem on the undo list, then drop the oldest commands while the copies held by
+     * the list are estimated to take more than the UndoMemoryLimit advanced setting.
+     */
+    void PushCommandToUndoList( PICKED_ITEMS_LIST* aItem ) override;
+
     /**
      * Free the undo or redo list from List element.
      *
@@ -248,6 +255,11 @@ protected:
 
     virtual void onDarkModeToggle();
 
+    /**
+     * Add an estimate of the memory held by the undo and redo lists to \a aReport.
+     */
+    void reportUndoMemoryUsage( MEMORY_REPORT& aReport ) const;
+
 protected:
     bool                    m_undoRedoBlocked;
 
@@ -257,6 +269,8 @@ protected:
     wxAuiNotebook*          m_tabbedPanel;        /// Panel with Layers and Object Inspector tabs
 
     bool                    m_darkMode;
+
+    std::unique_ptr<MEMORY_ACCOUNT> m_memoryAccount;
 };
 
 #endif
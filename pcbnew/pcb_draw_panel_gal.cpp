@@ -24,6 +24,7 @@
  */
 
 #include "pcb_draw_panel_gal.h"
+#include <advanced_config.h>
 #include <pcb_view.h>
 #include <view/wx_view_controls.h>
 #include <pcb_painter.h>
@@ -271,28 +272,37 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard, PROGRESS_REPORTER* aReport
     if( m_drawingSheet )
         m_drawingSheet->SetFileName( TO_UTF8( aBoard->GetFileName() ) );
 
+    std::vector<KIGFX::VIEW_ITEM*> items;
+
+    items.reserve( aBoard->Drawings().size() + aBoard->Tracks().size()
+                   + aBoard->Footprints().size() + aBoard->Markers().size()
+                   + aBoard->Zones().size() + aBoard->Generators().size() );
+
     // Load drawings
     for( BOARD_ITEM* drawing : aBoard->Drawings() )
-        m_view->Add( drawing );
+        items.push_back( drawing );
 
     // Load tracks
     for( PCB_TRACK* track : aBoard->Tracks() )
-        m_view->Add( track );
+        items.push_back( track );
 
     // Load footprints and its additional elements
     for( FOOTPRINT* footprint : aBoard->Footprints() )
-        m_view->Add( footprint );
+        items.push_back( footprint );
 
     // DRC markers
     for( PCB_MARKER* marker : aBoard->Markers() )
-        m_view->Add( marker );
+        items.push_back( marker );
 
     // Load zones
     for( ZONE* zone : aBoard->Zones() )
-        m_view->Add( zone );
+        items.push_back( zone );
 
     for( PCB_GENERATOR* generator : aBoard->Generators() )
-        m_view->Add( generator );
+        items.push_back( generator );
+
+    // The trees of the view are packed once for the whole board
+    m_view->AddItems( items );
 
     // Ratsnest
     if( !aBoard->IsFootprintHolder() )
@@ -671,6 +681,11 @@ void PCB_DRAW_PANEL_GAL::setDefaultLayerDeps()
         else if( IsNetnameLayer( layer ) )
         {
             m_view->SetLayerDisplayOnly( layer );
+
+            // Net names are only drawn when zoomed in, i.e. for the few items in view, so
+            // there is no point in tessellating and caching them for the whole board
+            if( ADVANCED_CFG::GetCfg().m_UncachedNetnameLayers )
+                m_view->SetLayerTarget( layer, KIGFX::TARGET_NONCACHED );
         }
     }
 
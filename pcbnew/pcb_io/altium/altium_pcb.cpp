@@ -27,6 +27,7 @@
 #include <io/altium/altium_binary_parser.h>
 #include <io/altium/altium_parser_utils.h>
 
+#include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <pcb_dimension.h>
@@ -36,6 +37,7 @@
 #include <pcb_textbox.h>
 #include <pcb_track.h>
 #include <core/profile.h>
+#include <core/thread_pool.h>
 #include <pad_shapes.h>
 #include <string_utils.h>
 #include <tools/pad_tool.h>
@@ -288,6 +290,56 @@ ALTIUM_PCB::~ALTIUM_PCB()
 {
 }
 
+/**
+ * Decode all the records of the stream \a aEntry into \a aRecords.
+ */
+template <typename RECORD, typename... ARGS>
+static void decodeRecords( const ALTIUM_COMPOUND_FILE&     aFile,
+                           const CFB::COMPOUND_FILE_ENTRY* aEntry, const char* aStreamName,
+                           std::vector<RECORD>& aRecords, ARGS... aArgs )
+{
+    ALTIUM_BINARY_PARSER reader( aFile, aEntry );
+
+    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+        aRecords.emplace_back( reader, aArgs... );
+
+    if( reader.GetRemainingBytes() != 0 )
+        THROW_IO_ERROR( wxString::Format( wxT( "%s stream is not fully parsed" ), aStreamName ) );
+}
+
+
+/**
+ * @return the records of the stream \a aEntry, from \a aPrefetched if they were decoded ahead
+ *         of time and by decoding the stream otherwise.
+ */
+template <typename RECORD, typename... ARGS>
+static std::vector<RECORD> takeRecords( ALTIUM_PREFETCHED_STREAM<RECORD>& aPrefetched,
+                                        const ALTIUM_COMPOUND_FILE&       aFile,
+                                        const CFB::COMPOUND_FILE_ENTRY*   aEntry,
+                                        const char* aStreamName, ARGS... aArgs )
+{
+    std::vector<RECORD> records;
+
+    if( aPrefetched.m_valid )
+    {
+        aPrefetched.m_valid = false;
+
+        // Report the error now rather than from prefetchStreams(), so that the errors of the
+        // streams parsed before this one still come first.
+        if( !aPrefetched.m_error.IsEmpty() )
+            THROW_IO_ERROR( aPrefetched.m_error );
+
+        records = std::move( aPrefetched.m_records );
+    }
+    else
+    {
+        decodeRecords( aFile, aEntry, aStreamName, records, aArgs... );
+    }
+
+    return records;
+}
+
+
 void ALTIUM_PCB::checkpoint()
 {
     const unsigned PROGRESS_DELTA = 250;
@@ -307,6 +359,76 @@ void ALTIUM_PCB::checkpoint()
     }
 }
 
+void ALTIUM_PCB::prefetchStreams( const ALTIUM_COMPOUND_FILE&                  aAltiumPcbFile,
+                                  const std::map<ALTIUM_PCB_DIR, std::string>& aFileMapping )
+{
+    std::vector<std::function<void()>> jobs;
+
+    auto queue =
+            [&]( ALTIUM_PCB_DIR aDirectory, const char* aStreamName, auto& aPrefetched,
+                 auto... aArgs )
+            {
+                const auto& mappedDirectory = aFileMapping.find( aDirectory );
+
+                if( mappedDirectory == aFileMapping.end() )
+                    return;
+
+                const CFB::COMPOUND_FILE_ENTRY* entry =
+                        aAltiumPcbFile.FindStream( { mappedDirectory->second, "Data" } );
+
+                if( entry == nullptr )
+                    return;
+
+                jobs.emplace_back(
+                        [&aAltiumPcbFile, entry, aStreamName, &aPrefetched, aArgs...]()
+                        {
+                            // The compound file is only read from, so streams can be decoded
+                            // concurrently.  Nothing may escape to the pool.
+                            try
+                            {
+                                decodeRecords( aAltiumPcbFile, entry, aStreamName,
+                                               aPrefetched.m_records, aArgs... );
+                            }
+                            catch( const IO_ERROR& e )
+                            {
+                                aPrefetched.m_error = e.What();
+                            }
+                            catch( const std::exception& e )
+                            {
+                                aPrefetched.m_error = wxString::Format( wxT( "%s stream: %s" ),
+                                                                        aStreamName, e.what() );
+                            }
+
+                            if( !aPrefetched.m_error.IsEmpty() )
+                                aPrefetched.m_records.clear();
+
+                            aPrefetched.m_valid = true;
+                        } );
+            };
+
+    queue( ALTIUM_PCB_DIR::POLYGONS6, "Polygons6", m_prefetchedPolygons );
+    queue( ALTIUM_PCB_DIR::ARCS6, "Arcs6", m_prefetchedArcs );
+    queue( ALTIUM_PCB_DIR::PADS6, "Pads6", m_prefetchedPads );
+    queue( ALTIUM_PCB_DIR::VIAS6, "Vias6", m_prefetchedVias );
+    queue( ALTIUM_PCB_DIR::TRACKS6, "Tracks6", m_prefetchedTracks );
+    queue( ALTIUM_PCB_DIR::SHAPEBASEDREGIONS6, "ShapeBasedRegions6",
+           m_prefetchedShapeBasedRegions, true );
+    queue( ALTIUM_PCB_DIR::REGIONS6, "Regions6", m_prefetchedRegions, false );
+
+    if( jobs.size() < 2 )
+        return;
+
+    if( m_progressReporter )
+        m_progressReporter->Report( _( "Reading board primitives..." ) );
+
+    ParallelForEachIndex( jobs.size(),
+                          [&]( size_t aIndex )
+                          {
+                              jobs[aIndex]();
+                          } );
+}
+
+
 void ALTIUM_PCB::Parse( const ALTIUM_COMPOUND_FILE&                  altiumPcbFile,
                         const std::map<ALTIUM_PCB_DIR, std::string>& aFileMapping )
 {
@@ -492,6 +614,9 @@ void ALTIUM_PCB::Parse( const ALTIUM_COMPOUND_FILE&                  altiumPcbFi
         }
     }
 
+    if( ADVANCED_CFG::GetCfg().m_ParallelAltiumImport )
+        prefetchStreams( altiumPcbFile, aFileMapping );
+
     // Parse data in specified order
     for( const std::tuple<bool, ALTIUM_PCB_DIR, PARSE_FUNCTION_POINTER_fp>& cur : parserOrder )
     {
@@ -570,7 +695,7 @@ void ALTIUM_PCB::Parse( const ALTIUM_COMPOUND_FILE&                  altiumPcbFi
             if( !zone->HasFilledPolysForLayer( layer ) )
                 continue;
 
-            zone->GetFilledPolysList( layer )->Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+            zone->GetFill( layer )->Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
         }
     }
 
@@ -1886,12 +2011,12 @@ void ALTIUM_PCB::ParsePolygons6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbF
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading polygons..." ) );
 
-    ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<APOLYGON6> polygons =
+            takeRecords( m_prefetchedPolygons, aAltiumPcbFile, aEntry, "Polygons6" );
 
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const APOLYGON6& elem : polygons )
     {
         checkpoint();
-        APOLYGON6 elem( reader );
 
         SHAPE_LINE_CHAIN linechain;
         HelperShapeLineChainFromAltiumVertices( linechain, elem.vertices );
@@ -2041,9 +2166,6 @@ void ALTIUM_PCB::ParsePolygons6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbF
         zone->SetBorderDisplayStyle( ZONE_BORDER_DISPLAY_STYLE::DIAGONAL_EDGE,
                                      ZONE::GetDefaultHatchPitch(), true );
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Polygons6 stream is not fully parsed" ) );
 }
 
 void ALTIUM_PCB::ParseRules6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
@@ -2140,13 +2262,14 @@ void ALTIUM_PCB::ParseShapeBasedRegions6Data( const ALTIUM_COMPOUND_FILE&     aA
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading polygons..." ) );
 
-    ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AREGION6> regions =
+            takeRecords( m_prefetchedShapeBasedRegions, aAltiumPcbFile, aEntry,
+                         "ShapeBasedRegions6", true );
 
-    /* TODO: use Header section of file */
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) regions.size(); primitiveIndex++ )
     {
         checkpoint();
-        AREGION6 elem( reader, true );
+        const AREGION6& elem = regions[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE
             || elem.kind == ALTIUM_REGION_KIND::BOARD_CUTOUT )
@@ -2160,9 +2283,6 @@ void ALTIUM_PCB::ParseShapeBasedRegions6Data( const ALTIUM_COMPOUND_FILE&     aA
             ConvertShapeBasedRegions6ToFootprintItem( footprint, elem, primitiveIndex );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "ShapeBasedRegions6 stream is not fully parsed" );
 }
 
 
@@ -2573,12 +2693,12 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFi
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading zone fills..." ) );
 
-    ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AREGION6> regions =
+            takeRecords( m_prefetchedRegions, aAltiumPcbFile, aEntry, "Regions6", false );
 
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AREGION6& elem : regions )
     {
         checkpoint();
-        AREGION6 elem( reader, false );
 
         if( elem.polygon != ALTIUM_POLYGON_NONE )
         {
@@ -2636,9 +2756,6 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFi
             zone->SetNeedRefill( false );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Regions6 stream is not fully parsed" ) );
 }
 
 
@@ -2648,12 +2765,12 @@ void ALTIUM_PCB::ParseArcs6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading arcs..." ) );
 
-    ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AARC6> arcs = takeRecords( m_prefetchedArcs, aAltiumPcbFile, aEntry, "Arcs6" );
 
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) arcs.size(); primitiveIndex++ )
     {
         checkpoint();
-        AARC6 elem( reader );
+        const AARC6& elem = arcs[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -2665,9 +2782,6 @@ void ALTIUM_PCB::ParseArcs6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
             ConvertArcs6ToFootprintItem( footprint, elem, primitiveIndex, true );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "Arcs6 stream is not fully parsed" );
 }
 
 
@@ -2918,12 +3032,11 @@ void ALTIUM_PCB::ParsePads6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading pads..." ) );
 
-    ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<APAD6> pads = takeRecords( m_prefetchedPads, aAltiumPcbFile, aEntry, "Pads6" );
 
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const APAD6& elem : pads )
     {
         checkpoint();
-        APAD6 elem( reader );
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -2935,9 +3048,6 @@ void ALTIUM_PCB::ParsePads6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
             ConvertPads6ToFootprintItem( footprint, elem );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Pads6 stream is not fully parsed" ) );
 }
 
 
@@ -3603,12 +3713,11 @@ void ALTIUM_PCB::ParseVias6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading vias..." ) );
 
-    ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AVIA6> vias = takeRecords( m_prefetchedVias, aAltiumPcbFile, aEntry, "Vias6" );
 
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AVIA6& elem : vias )
     {
         checkpoint();
-        AVIA6 elem( reader );
 
         PCB_VIA* via = new PCB_VIA( m_board );
         m_board->Add( via, ADD_MODE::APPEND );
@@ -3658,9 +3767,6 @@ void ALTIUM_PCB::ParseVias6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
         // we need VIATYPE set!
         via->SetLayerPair( start_klayer, end_klayer );
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Vias6 stream is not fully parsed" ) );
 }
 
 void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
@@ -3669,12 +3775,13 @@ void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFil
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading tracks..." ) );
 
-    ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<ATRACK6> tracks =
+            takeRecords( m_prefetchedTracks, aAltiumPcbFile, aEntry, "Tracks6" );
 
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) tracks.size(); primitiveIndex++ )
     {
         checkpoint();
-        ATRACK6 elem( reader );
+        const ATRACK6& elem = tracks[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -3686,9 +3793,6 @@ void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFil
             ConvertTracks6ToFootprintItem( footprint, elem, primitiveIndex, true );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "Tracks6 stream is not fully parsed" );
 }
 
 
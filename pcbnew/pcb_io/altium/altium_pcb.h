@@ -104,6 +104,17 @@ class ALTIUM_PCB;
 typedef std::function<void( const ALTIUM_COMPOUND_FILE&, const CFB::COMPOUND_FILE_ENTRY* )>
         PARSE_FUNCTION_POINTER_fp;
 
+/**
+ * The records of a stream, decoded ahead of the pass which converts them to board items.
+ */
+template <typename RECORD>
+struct ALTIUM_PREFETCHED_STREAM
+{
+    bool                m_valid = false;   ///< the stream was decoded, maybe unsuccessfully
+    std::vector<RECORD> m_records;
+    wxString            m_error;           ///< why the stream couldn't be decoded, if it couldn't
+};
+
 class ALTIUM_PCB
 {
 public:
@@ -122,6 +133,13 @@ public:
 private:
     void checkpoint();
 
+    /**
+     * Decode the records of the streams which don't depend on each other on the thread pool, so
+     * that the serial pass of Parse() only has to convert them to board items.
+     */
+    void prefetchStreams( const ALTIUM_COMPOUND_FILE&                  aAltiumPcbFile,
+                          const std::map<ALTIUM_PCB_DIR, std::string>& aFileMapping );
+
     PCB_LAYER_ID  GetKicadLayer( ALTIUM_LAYER aAltiumLayer ) const;
     std::vector<PCB_LAYER_ID> GetKicadLayersToIterate( ALTIUM_LAYER aAltiumLayer ) const;
     int           GetNetCode( uint16_t aId ) const;
@@ -258,6 +276,14 @@ private:
 
     std::map<ALTIUM_LAYER, ZONE*>        m_outer_plane;
 
+    ALTIUM_PREFETCHED_STREAM<APOLYGON6>  m_prefetchedPolygons;
+    ALTIUM_PREFETCHED_STREAM<AARC6>      m_prefetchedArcs;
+    ALTIUM_PREFETCHED_STREAM<APAD6>      m_prefetchedPads;
+    ALTIUM_PREFETCHED_STREAM<AVIA6>      m_prefetchedVias;
+    ALTIUM_PREFETCHED_STREAM<ATRACK6>    m_prefetchedTracks;
+    ALTIUM_PREFETCHED_STREAM<AREGION6>   m_prefetchedShapeBasedRegions;
+    ALTIUM_PREFETCHED_STREAM<AREGION6>   m_prefetchedRegions;
+
     PROGRESS_REPORTER* m_progressReporter;   ///< optional; may be nullptr
     REPORTER*          m_reporter;           ///< optional; may be nullptr
     unsigned           m_doneCount;
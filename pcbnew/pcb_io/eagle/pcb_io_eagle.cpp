@@ -60,7 +60,9 @@ Load() TODO's
 #include <wx/txtstrm.h>
 #include <wx/window.h>
 
+#include <advanced_config.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <core/thread_pool.h>
 #include <font/fontconfig.h>
 #include <string_utils.h>
 #include <locale_io.h>
@@ -68,6 +70,7 @@ Load() TODO's
 #include <trigo.h>
 #include <progress_reporter.h>
 #include <project.h>
+#include <richio.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <footprint.h>
@@ -322,6 +325,33 @@ VECTOR2I inline PCB_IO_EAGLE::kicad_fontsize( const ECOORD& d, int aTextThicknes
 }
 
 
+/**
+ * @return true unless the XML declaration of \a aDocument names an encoding other than UTF-8.
+ */
+static bool isUtf8Document( std::string_view aDocument )
+{
+    if( aDocument.compare( 0, 5, "<?xml" ) != 0 )
+        return true;
+
+    std::string_view decl = aDocument.substr( 0, aDocument.find( "?>" ) );
+    size_t           pos = decl.find( "encoding" );
+
+    if( pos == std::string_view::npos )
+        return true;
+
+    pos = decl.find_first_of( "\"'", pos );
+
+    if( pos == std::string_view::npos )
+        return false;
+
+    std::string_view value = decl.substr( pos + 1, decl.find( decl[pos], pos + 1 ) - pos - 1 );
+    wxString         encoding = wxString::FromUTF8( value.data(), value.size() );
+
+    return encoding.IsSameAs( wxS( "UTF-8" ), false )
+           || encoding.IsSameAs( wxS( "US-ASCII" ), false );
+}
+
+
 BOARD* PCB_IO_EAGLE::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                                 const STRING_UTF8_MAP* aProperties, PROJECT* aProject )
 {
@@ -353,24 +383,43 @@ BOARD* PCB_IO_EAGLE::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
 
         wxFileName fn = aFileName;
 
-        // Load the document
-        wxFFileInputStream stream( fn.GetFullPath() );
-        wxXmlDocument xmlDocument;
+        m_min_trace    = INT_MAX;
+        m_min_hole     = INT_MAX;
+        m_min_via      = INT_MAX;
+        m_min_annulus  = INT_MAX;
+
+        std::unique_ptr<MAPPED_FILE_LINE_READER> mapped;
 
-        if( !stream.IsOk() || !xmlDocument.Load( stream ) )
+        if( ADVANCED_CFG::GetCfg().m_StreamingEagleImport )
         {
-            THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
-                                              fn.GetFullPath() ) );
+            mapped = std::make_unique<MAPPED_FILE_LINE_READER>( fn.GetFullPath() );
+
+            // The sections are parsed on their own, without the declaration naming any other
+            // encoding, so those files are left to the regular reader.
+            if( !isUtf8Document( mapped->Contents() ) )
+                mapped.reset();
         }
 
-        doc = xmlDocument.GetRoot();
+        if( mapped )
+        {
+            loadStreamedSections( mapped->Contents() );
+        }
+        else
+        {
+            // Load the document
+            wxFFileInputStream stream( fn.GetFullPath() );
+            wxXmlDocument xmlDocument;
 
-        m_min_trace    = INT_MAX;
-        m_min_hole     = INT_MAX;
-        m_min_via      = INT_MAX;
-        m_min_annulus  = INT_MAX;
+            if( !stream.IsOk() || !xmlDocument.Load( stream ) )
+            {
+                THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
+                                                  fn.GetFullPath() ) );
+            }
 
-        loadAllSections( doc );
+            doc = xmlDocument.GetRoot();
+
+            loadAllSections( doc );
+        }
 
         BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
 
@@ -570,6 +619,145 @@ void PCB_IO_EAGLE::loadAllSections( wxXmlNode* aDoc )
 }
 
 
+void PCB_IO_EAGLE::loadStreamedSections( std::string_view aDocument )
+{
+    auto mapChildren =
+            []( std::string_view aElement )
+            {
+                std::unordered_map<std::string, std::string_view> spans;
+
+                // As in MapChildren(), the last of several children of the same name wins
+                for( const XML_ELEMENT_SPAN& child : SplitXmlChildren( aElement ) )
+                    spans[child.name] = child.text;
+
+                return spans;
+            };
+
+    std::unordered_map<std::string, std::string_view> drawingChildren =
+            mapChildren( mapChildren( FindXmlRootElement( aDocument ).text )["drawing"] );
+    std::unordered_map<std::string, std::string_view> boardChildren =
+            mapChildren( drawingChildren["board"] );
+
+    std::string_view designrules = boardChildren["designrules"];
+    std::string_view layers = drawingChildren["layers"];
+    std::string_view plain = boardChildren["plain"];
+    std::string_view classes = boardChildren["classes"];
+    std::string_view signals = boardChildren["signals"];
+    std::string_view libs = boardChildren["libraries"];
+    std::string_view elems = boardChildren["elements"];
+
+    if( m_progressReporter )
+    {
+        m_totalCount = 0;
+        m_doneCount = 0;
+
+        for( std::string_view section : { designrules, layers, plain, signals, elems } )
+            m_totalCount += SplitXmlChildren( section ).size();
+
+        for( const XML_ELEMENT_SPAN& library : SplitXmlChildren( libs ) )
+            m_totalCount += SplitXmlChildren( mapChildren( library.text )["packages"] ).size();
+    }
+
+    // Parse a section into a document which only lives while the section is being converted
+    auto load =
+            [&]( std::string_view aSection, const std::function<void( wxXmlNode* )>& aLoader )
+            {
+                if( aSection.empty() )
+                {
+                    aLoader( nullptr );
+                    return;
+                }
+
+                std::unique_ptr<wxXmlDocument> doc = ParseXmlElement( aSection );
+
+                aLoader( doc->GetRoot() );
+            };
+
+    m_xpath->push( "eagle.drawing" );
+
+    {
+        m_xpath->push( "board" );
+
+        load( designrules, [&]( wxXmlNode* aNode ) { loadDesignRules( aNode ); } );
+
+        m_xpath->pop();
+    }
+
+    {
+        m_xpath->push( "layers" );
+
+        load( layers, [&]( wxXmlNode* aNode ) { loadLayerDefs( aNode ); } );
+        mapEagleLayersToKicad();
+
+        m_xpath->pop();
+    }
+
+    {
+        m_xpath->push( "board" );
+
+        load( plain, [&]( wxXmlNode* aNode ) { loadPlain( aNode ); } );
+        load( classes, [&]( wxXmlNode* aNode ) { loadClasses( aNode ); } );
+        load( signals, [&]( wxXmlNode* aNode ) { loadSignals( aNode ); } );
+        loadStreamedLibraries( libs );
+        load( elems, [&]( wxXmlNode* aNode ) { loadElements( aNode ); } );
+
+        m_xpath->pop();
+    }
+
+    m_xpath->pop();     // "eagle.drawing"
+}
+
+
+void PCB_IO_EAGLE::loadStreamedLibraries( std::string_view aLibs )
+{
+    if( aLibs.empty() )
+        return;
+
+    std::vector<XML_ELEMENT_SPAN> libraries = SplitXmlChildren( aLibs );
+
+    // Parse a batch of libraries at a time, so only a few of their documents are ever held
+    // at once, and convert them in order so the footprint templates come out as before.
+    const size_t batchSize = std::max<size_t>( 1, 2 * GetKiCadThreadPool().get_thread_count() );
+
+    m_xpath->push( "libraries.library", "name" );
+
+    for( size_t first = 0; first < libraries.size(); first += batchSize )
+    {
+        size_t count = std::min( batchSize, libraries.size() - first );
+
+        std::vector<std::unique_ptr<wxXmlDocument>> docs( count );
+        std::vector<std::string>                    errors( count );
+
+        ParallelForEachIndex( count,
+                [&]( size_t ii )
+                {
+                    try
+                    {
+                        docs[ii] = ParseXmlElement( libraries[first + ii].text );
+                    }
+                    catch( const std::exception& e )
+                    {
+                        errors[ii] = e.what();
+                    }
+                } );
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            if( !docs[ii] )
+                throw XML_PARSER_ERROR( errors[ii] );
+
+            wxXmlNode*      library = docs[ii]->GetRoot();
+            const wxString& lib_name = library->GetAttribute( "name" );
+
+            m_xpath->Value( lib_name.c_str() );
+            loadLibrary( library, &lib_name );
+        }
+    }
+
+    m_xpath->pop();
+}
+
+
 void PCB_IO_EAGLE::loadDesignRules( wxXmlNode* aDesignRules )
 {
     if( aDesignRules )
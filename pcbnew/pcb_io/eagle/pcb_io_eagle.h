@@ -258,6 +258,16 @@ private:
     // all these loadXXX() throw IO_ERROR or ptree_error exceptions:
 
     void loadAllSections( wxXmlNode* aDocument );
+
+    /**
+     * Load the sections of the document \a aDocument one at a time, parsing each into a
+     * document of its own only while it is being converted.
+     */
+    void loadStreamedSections( std::string_view aDocument );
+
+    /// Load the libraries in \a aLibs, parsing batches of them on the thread pool.
+    void loadStreamedLibraries( std::string_view aLibs );
+
     void loadDesignRules( wxXmlNode* aDesignRules );
     void loadLayerDefs( wxXmlNode* aLayers );
     void loadPlain( wxXmlNode* aPlain );
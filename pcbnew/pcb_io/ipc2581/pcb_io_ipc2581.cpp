@@ -50,11 +50,167 @@
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
 
+#include <core/thread_pool.h>
+
+#include <fmt/core.h>
+
 #include <wx/log.h>
 #include <wx/numformatter.h>
 #include <wx/mstream.h>
 #include <wx/xml/xml.h>
 
+
+/**
+ * Write node trees as indented UTF-8 XML, in the layout of wxXmlDocument::Save().
+ *
+ * The text is written to a buffer flushed to the output stream in large blocks.  Without a
+ * stream, the buffer holds the text of the written nodes.
+ */
+class XML_STREAM_WRITER
+{
+public:
+    XML_STREAM_WRITER( wxOutputStream* aStream = nullptr,
+                       std::map<const wxXmlNode*, std::future<std::string>>* aSerialized =
+                               nullptr ) :
+            m_stream( aStream ),
+            m_serialized( aSerialized ),
+            m_ok( true )
+    {
+    }
+
+    void WriteDeclaration()
+    {
+        m_buffer += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    }
+
+    void WriteNode( const wxXmlNode* aNode, int aDepth )
+    {
+        if( m_serialized )
+        {
+            auto it = m_serialized->find( aNode );
+
+            if( it != m_serialized->end() )
+            {
+                m_buffer += it->second.get();
+                flushIfFull();
+                return;
+            }
+        }
+
+        if( aNode->GetType() == wxXML_TEXT_NODE )
+        {
+            appendEscaped( aNode->GetContent() );
+            return;
+        }
+
+        if( aNode->GetType() != wxXML_ELEMENT_NODE )
+            return;
+
+        m_buffer.append( 2 * aDepth, ' ' );
+        m_buffer += '<';
+        appendUtf8( aNode->GetName() );
+
+        for( wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+        {
+            m_buffer += ' ';
+            appendUtf8( attr->GetName() );
+            m_buffer += "=\"";
+            appendEscaped( attr->GetValue() );
+            m_buffer += '"';
+        }
+
+        const wxXmlNode* child = aNode->GetChildren();
+
+        if( !child )
+        {
+            m_buffer += "/>\n";
+        }
+        else if( child->GetType() == wxXML_TEXT_NODE && !child->GetNext() )
+        {
+            m_buffer += '>';
+            appendEscaped( child->GetContent() );
+            m_buffer += "</";
+            appendUtf8( aNode->GetName() );
+            m_buffer += ">\n";
+        }
+        else
+        {
+            m_buffer += ">\n";
+
+            for( ; child; child = child->GetNext() )
+                WriteNode( child, aDepth + 1 );
+
+            m_buffer.append( 2 * aDepth, ' ' );
+            m_buffer += "</";
+            appendUtf8( aNode->GetName() );
+            m_buffer += ">\n";
+        }
+
+        flushIfFull();
+    }
+
+    /**
+     * Write the rest of the buffer to the stream.
+     *
+     * @return false if the stream failed.
+     */
+    bool Flush()
+    {
+        if( m_stream && !m_buffer.empty() )
+        {
+            m_ok &= m_stream->Write( m_buffer.data(), m_buffer.size() ).IsOk();
+            m_buffer.clear();
+        }
+
+        return m_ok;
+    }
+
+    std::string TakeBuffer() { return std::move( m_buffer ); }
+
+private:
+    void flushIfFull()
+    {
+        if( m_stream && m_buffer.size() >= FLUSH_SIZE )
+            Flush();
+    }
+
+    void appendUtf8( const wxString& aText )
+    {
+        const wxScopedCharBuffer utf8 = aText.utf8_str();
+        m_buffer.append( utf8.data(), utf8.length() );
+    }
+
+    void appendEscaped( const wxString& aText )
+    {
+        const wxScopedCharBuffer utf8 = aText.utf8_str();
+
+        for( size_t ii = 0; ii < utf8.length(); ++ii )
+        {
+            char c = utf8.data()[ii];
+
+            switch( c )
+            {
+            case '&':  m_buffer += "&amp;";  break;
+            case '<':  m_buffer += "&lt;";   break;
+            case '>':  m_buffer += "&gt;";   break;
+            case '"':  m_buffer += "&quot;"; break;
+            case '\t': m_buffer += "&#x9;";  break;
+            case '\n': m_buffer += "&#xA;";  break;
+            case '\r': m_buffer += "&#xD;";  break;
+            default:   m_buffer += c;        break;
+            }
+        }
+    }
+
+    static constexpr size_t FLUSH_SIZE = 1 << 20;
+
+    wxOutputStream*                                       m_stream;
+    std::map<const wxXmlNode*, std::future<std::string>>* m_serialized;
+    std::string                                           m_buffer;
+    bool                                                  m_ok;
+};
+
+
 PCB_IO_IPC2581::~PCB_IO_IPC2581()
 {
     clearLoadedFootprints();
@@ -125,7 +281,7 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
     // that if possible.  When we share a parent and our next sibling is null,
     // then we are the last child and can just append to the end of the list.
 
-    static wxXmlNode* lastNode = nullptr;
+    wxXmlNode* lastNode = m_last_appended_node;
     wxXmlNode* node = new wxXmlNode( wxXML_ELEMENT_NODE, aName );
 
     if( lastNode && lastNode->GetParent() == aParent && lastNode->GetNext() == nullptr )
@@ -138,7 +294,7 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
         aParent->AddChild( node );
     }
 
-    lastNode = node;
+    m_last_appended_node = node;
 
     // Opening tag, closing tag, brackets and the closing slash
     m_total_bytes += 2 * aName.size() + 5;
@@ -149,29 +305,36 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
 
 wxString PCB_IO_IPC2581::genString( const wxString& aStr, const char* aPrefix ) const
 {
+    // Called for every net, pin and component reference: build the result in one pass
     wxString str;
 
     if( m_version == 'C' )
     {
-        str = aStr;
-        str.Replace( wxT( ":" ), wxT( "_" ) );
+        str = aPrefix ? aPrefix : "KI";
+        str += ':';
+        str.reserve( str.length() + aStr.length() );
 
-        if( aPrefix )
-            str.Prepend( wxString( aPrefix ) + wxT( ":" ) );
-        else
-            str.Prepend( wxT( "KI:" ) );
+        for( wxUniChar c : aStr )
+            str += ( c == ':' ) ? wxUniChar( '_' ) : c;
     }
     else
     {
         if( aPrefix )
-            str = wxString::Format( "%s_", aPrefix );
+        {
+            str = aPrefix;
+            str += '_';
+        }
 
-        for( wxString::const_iterator iter = aStr.begin(); iter != aStr.end(); ++iter )
+        str.reserve( str.length() + aStr.length() );
+
+        for( wxUniChar c : aStr )
         {
-            if( !m_acceptable_chars.count( *iter ) )
-                str.Append( '_' );
+            wxUint32 code = c.GetValue();
+
+            if( code < m_acceptable_chars.size() && m_acceptable_chars.test( code ) )
+                str += c;
             else
-                str.Append( *iter );
+                str += '_';
         }
     }
 
@@ -244,17 +407,21 @@ wxString PCB_IO_IPC2581::componentName( FOOTPRINT* aFootprint )
 
 wxString PCB_IO_IPC2581::floatVal( double aVal )
 {
-    wxString str = wxString::FromCDouble( aVal, m_sigfig );
+    // Called for every coordinate: format without the locale and without intermediate wxStrings
+    std::string str = fmt::format( "{:.{}f}", aVal, m_sigfig );
 
     // Remove all but the last trailing zeros from str
-    while( str.EndsWith( wxT( "00" ) ) )
-        str.RemoveLast();
+    if( str.find( '.' ) != std::string::npos )
+    {
+        while( str.size() > 2 && str[str.size() - 1] == '0' && str[str.size() - 2] == '0' )
+            str.pop_back();
+    }
 
     // We don't want to output -0.0 as this value is just 0 for fabs
-    if( str == wxT( "-0.0" ) )
+    if( str == "-0.0" )
         return wxT( "0.0" );
 
-    return str;
+    return wxString::FromAscii( str.c_str(), str.size() );
 }
 
 
@@ -2399,10 +2566,43 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
             aStepNode->RemoveChild( layerNode );
             delete layerNode;
         }
+        else
+        {
+            serializeInBackground( layerNode );
+        }
     }
 }
 
 
+void PCB_IO_IPC2581::serializeInBackground( wxXmlNode* aNode )
+{
+    wxXmlNode* parent = aNode->GetParent();
+    wxXmlNode* placeholder = new wxXmlNode( wxXML_ELEMENT_NODE, aNode->GetName() );
+    int        depth = 0;
+
+    for( wxXmlNode* ancestor = parent; ancestor; ancestor = ancestor->GetParent() )
+        depth++;
+
+    parent->InsertChildAfter( placeholder, aNode );
+    parent->RemoveChild( aNode );
+
+    // The node may be freed before the next append
+    m_last_appended_node = nullptr;
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    m_serialized_nodes[placeholder] = tp.submit(
+            [aNode, depth]() -> std::string
+            {
+                XML_STREAM_WRITER writer;
+                writer.WriteNode( aNode, depth );
+                delete aNode;
+
+                return writer.TakeBuffer();
+            } );
+}
+
+
 void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
 {
     int hole_count = 1;
@@ -2889,19 +3089,19 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
     if( m_version == 'B' )
     {
         for( char c = 'a'; c <= 'z'; ++c )
-            m_acceptable_chars.insert( c );
+            m_acceptable_chars.set( c );
 
         for( char c = 'A'; c <= 'Z'; ++c )
-            m_acceptable_chars.insert( c );
+            m_acceptable_chars.set( c );
 
         for( char c = '0'; c <= '9'; ++c )
-            m_acceptable_chars.insert( c );
+            m_acceptable_chars.set( c );
 
         // Add special characters
         std::string specialChars = "_\\-.+><";
 
         for( char c : specialChars )
-            m_acceptable_chars.insert( c );
+            m_acceptable_chars.set( c );
     }
 
     m_xml_doc = new wxXmlDocument();
@@ -2955,12 +3155,19 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
 
     out_stream.SetProgressCallback( update_progress );
 
-    if( !m_xml_doc->Save( out_stream ) )
-    {
-        wxLogError( _( "Failed to save file to buffer" ) );
-        return;
-    }
+    XML_STREAM_WRITER writer( &out_stream, &m_serialized_nodes );
 
-    size_t size = out_stream.GetSize();
+    writer.WriteDeclaration();
+    writer.WriteNode( m_xml_root, 0 );
 
+    bool ok = writer.Flush();
+
+    m_serialized_nodes.clear();
+    delete m_xml_doc;
+    m_xml_doc = nullptr;
+    m_xml_root = nullptr;
+    m_last_appended_node = nullptr;
+
+    if( !ok )
+        wxLogError( _( "Failed to save file to buffer" ) );
 }
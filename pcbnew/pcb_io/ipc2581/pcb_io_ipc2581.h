@@ -31,6 +31,8 @@
 #include <stroke_params.h>
 
 #include <wx/xml/xml.h>
+#include <bitset>
+#include <future>
 #include <memory>
 
 class BOARD;
@@ -71,6 +73,7 @@ public:
         m_progress_reporter = nullptr;
         m_xml_doc = nullptr;
         m_xml_root = nullptr;
+        m_last_appended_node = nullptr;
     }
 
     ~PCB_IO_IPC2581() override;
@@ -282,6 +285,15 @@ private:
 
     void insertNodeAfter( wxXmlNode* aPrev, wxXmlNode* aNode );
 
+    /**
+     * Replace \a aNode by a placeholder and serialize it on the thread pool.
+     *
+     * The node tree of a layer is the largest part of the document, so it is freed as soon as
+     * the layer is generated instead of being kept until the file is written.  The placeholder
+     * is replaced by the serialized text when the document is saved.
+     */
+    void serializeInBackground( wxXmlNode* aNode );
+
     void addLayerAttributes( wxXmlNode* aNode, PCB_LAYER_ID aLayer );
 
     bool isValidLayerFor2581( PCB_LAYER_ID aLayer );
@@ -348,10 +360,14 @@ private:
 
     PROGRESS_REPORTER*      m_progress_reporter;
 
-    std::set<wxUniChar>     m_acceptable_chars;     //<! IPC2581B and C have differing sets of allowed characters in names
+    std::bitset<128>        m_acceptable_chars;     //<! IPC2581B and C have differing sets of allowed characters in names
 
     wxXmlDocument*          m_xml_doc;
     wxXmlNode*              m_xml_root;
+    wxXmlNode*              m_last_appended_node;   //<! Last node added by appendNode()
+
+    ///< The text of the nodes serialized in the background, by placeholder
+    std::map<const wxXmlNode*, std::future<std::string>> m_serialized_nodes;
 };
 
 #endif // PCB_IO_IPC2581_H_
\ No newline at end of file
@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+
 // base64 code. Needed for PCB_REFERENCE_IMAGE
 #define wxUSE_BASE64 1
 #include <wx/base64.h>
@@ -37,6 +39,7 @@
 #include <callback_gal.h>
 #include <confirm.h>
 #include <convert_basic_shapes_to_polygon.h> // for enum RECT_CHAMFER_POSITIONS definition
+#include <core/thread_pool.h>
 #include <fmt/core.h>
 #include <font/fontconfig.h>
 #include <footprint.h>
@@ -44,12 +47,14 @@
 #include <kiface_base.h>
 #include <locale_io.h>
 #include <macros.h>
+#include <memory_accounting.h>
 #include <pad.h>
 #include <pcb_dimension.h>
 #include <pcb_generator.h>
 #include <pcb_group.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_snapshot.h>
 #include <pcb_reference_image.h>
 #include <pcb_shape.h>
 #include <pcb_target.h>
@@ -73,12 +78,92 @@
 using namespace PCB_KEYS_T;
 
 
+/// The memory held by the footprints of all the caches.  The caches are read from the library
+/// loading threads, so they update a total rather than being walked by the report.
+static std::atomic<size_t> s_cachedFootprintsMemory( 0 );
+
+static MEMORY_ACCOUNT s_cachedFootprintsAccount(
+        []( MEMORY_REPORT& aReport )
+        {
+            aReport.Add( MEMORY_CATEGORY::FOOTPRINT_CACHE, s_cachedFootprintsMemory.load() );
+        } );
+
+
 FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
         m_filename( aFileName ),
-        m_footprint( aFootprint )
+        m_footprint( aFootprint ),
+        m_parsed( true ),
+        m_memoryUsage( aFootprint ? aFootprint->GetMemoryUsage() : 0 )
+{
+    s_cachedFootprintsMemory += m_memoryUsage;
+}
+
+
+FP_CACHE_ITEM::FP_CACHE_ITEM( const WX_FILENAME& aFileName ) :
+        m_filename( aFileName ),
+        m_parsed( false ),
+        m_memoryUsage( 0 )
 { }
 
 
+FP_CACHE_ITEM::~FP_CACHE_ITEM()
+{
+    s_cachedFootprintsMemory -= m_memoryUsage;
+}
+
+
+const FOOTPRINT* FP_CACHE_ITEM::GetFootprint() const
+{
+    Parse();
+
+    return m_footprint.get();
+}
+
+
+bool FP_CACHE_ITEM::IsParsed() const
+{
+    std::lock_guard<std::mutex> lock( m_parseMutex );
+
+    return m_parsed;
+}
+
+
+wxString FP_CACHE_ITEM::Parse() const
+{
+    std::lock_guard<std::mutex> lock( m_parseMutex );
+
+    if( m_parsed )
+        return m_parseError;
+
+    m_parsed = true;
+
+    try
+    {
+        MAPPED_FILE_LINE_READER   reader( m_filename.GetFullPath() );
+        PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+        FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
+
+        if( !footprint )
+            THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
+
+        footprint->SetFPID( LIB_ID( wxEmptyString, m_filename.GetName() ) );
+        m_footprint.reset( footprint );
+
+        m_memoryUsage = footprint->GetMemoryUsage();
+        s_cachedFootprintsMemory += m_memoryUsage;
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        m_parseError = wxString::Format( _( "Unable to read file '%s'" ) + '\n',
+                                         m_filename.GetFullPath() );
+        m_parseError += ioe.What();
+    }
+
+    return m_parseError;
+}
+
+
 FP_CACHE::FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath )
 {
     m_owner = aOwner;
@@ -105,49 +190,98 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
                                           m_lib_raw_path ) );
     }
 
+    std::vector<FP_CACHE_ITEM*> pending;
+
     for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        if( aFootprint && aFootprint != it->second->GetFootprint() )
+        // Footprints which haven't been read yet are unchanged, and the ones which couldn't be
+        // read must not overwrite their files.
+        if( aFootprint && ( !it->second->IsParsed() || aFootprint != it->second->GetFootprint() ) )
+            continue;
+
+        if( !it->second->GetFootprint() )
             continue;
 
-        WX_FILENAME fn = it->second->GetFileName();
+        pending.push_back( it->second );
+    }
+
+    // Each file is written by its own formatter, so the files are independent
+    std::vector<wxString> errors( pending.size() );
+
+    auto saveFootprint =
+            [&]( size_t ii )
+            {
+                const FP_CACHE_ITEM* item = pending[ii];
+                WX_FILENAME          fn = item->GetFileName();
 
-        wxString tempFileName =
+                try
+                {
+                    wxString tempFileName =
 #ifdef USE_TMP_FILE
-        wxFileName::CreateTempFileName( fn.GetPath() );
+                    wxFileName::CreateTempFileName( fn.GetPath() );
 #else
-        fn.GetFullPath();
+                    fn.GetFullPath();
 #endif
-        // Allow file output stream to go out of scope to close the file stream before
-        // renaming the file.
-        {
-            wxLogTrace( traceKicadPcbPlugin, wxT( "Creating temporary library file '%s'." ),
-                    tempFileName );
+                    // Allow file output stream to go out of scope to close the file stream
+                    // before renaming the file.
+                    {
+                        wxLogTrace( traceKicadPcbPlugin,
+                                    wxT( "Creating temporary library file '%s'." ),
+                                    tempFileName );
 
-            PRETTIFIED_FILE_OUTPUTFORMATTER formatter( tempFileName );
+                        PRETTIFIED_FILE_OUTPUTFORMATTER formatter( tempFileName );
+                        PCB_IO_KICAD_SEXPR              io( m_owner->m_ctl );
 
-            m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( (BOARD_ITEM*) it->second->GetFootprint() );
-        }
+                        io.SetOutputFormatter( &formatter );
+                        io.Format( (BOARD_ITEM*) item->GetFootprint() );
+                    }
 
 #ifdef USE_TMP_FILE
-        wxRemove( fn.GetFullPath() );     // it is not an error if this does not exist
-
-        // Even on Linux you can see an _intermittent_ error when calling wxRename(),
-        // and it is fully inexplicable.  See if this dodges the error.
-        wxMilliSleep( 250L );
+                    wxRemove( fn.GetFullPath() );     // it is not an error if this does not exist
+
+                    // Even on Linux you can see an _intermittent_ error when calling wxRename(),
+                    // and it is fully inexplicable.  See if this dodges the error.
+                    wxMilliSleep( 250L );
+
+                    // Preserve the permissions of the current file
+                    KIPLATFORM::IO::DuplicatePermissions( fn.GetFullPath(), tempFileName );
+
+                    if( !wxRenameFile( tempFileName, fn.GetFullPath() ) )
+                    {
+                        errors[ii] = wxString::Format( _( "Cannot rename temporary file '%s' to "
+                                                          "'%s'" ),
+                                                       tempFileName,
+                                                       fn.GetFullPath() );
+                    }
+#endif
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    errors[ii] = ioe.What();
+                }
+            };
 
-        // Preserve the permissions of the current file
-        KIPLATFORM::IO::DuplicatePermissions( fn.GetFullPath(), tempFileName );
+    {
+        // The locale is global: switch it once for all the tasks, while this thread waits
+        LOCALE_IO toggle;
 
-        if( !wxRenameFile( tempFileName, fn.GetFullPath() ) )
+        if( ADVANCED_CFG::GetCfg().m_ParallelBoardSave )
         {
-            wxString msg = wxString::Format( _( "Cannot rename temporary file '%s' to '%s'" ),
-                                             tempFileName,
-                                             fn.GetFullPath() );
-            THROW_IO_ERROR( msg );
+            ParallelForEachIndex( pending.size(), saveFootprint );
         }
-#endif
+        else
+        {
+            for( size_t ii = 0; ii < pending.size(); ++ii )
+                saveFootprint( ii );
+        }
+    }
+
+    for( size_t ii = 0; ii < pending.size(); ++ii )
+    {
+        if( !errors[ii].IsEmpty() )
+            THROW_IO_ERROR( errors[ii] );
+
+        WX_FILENAME fn = pending[ii]->GetFileName();
         m_cache_timestamp += fn.GetTimestamp();
     }
 
@@ -182,43 +316,60 @@ void FP_CACHE::Load()
 
     if( dir.GetFirst( &fullName, fileSpec ) )
     {
-        wxString cacheError;
-
         do
         {
             fn.SetFullName( fullName );
+            m_footprints.insert( fn.GetName(), new FP_CACHE_ITEM( fn ) );
+        } while( dir.GetNext( &fullName ) );
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
-            {
-                FILE_LINE_READER reader( fn.GetFullPath() );
-                PCB_IO_KICAD_SEXPR_PARSER       parser( &reader, nullptr, nullptr );
+        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
 
-                FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
-                wxString fpName = fn.GetName();
+        if( !ADVANCED_CFG::GetCfg().m_LazyFootprintLibraries )
+            ParseAll();
+    }
+}
 
-                if( !footprint )
-                    THROW_IO_ERROR( wxEmptyString );   // caught locally, just below...
 
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
-            }
-            catch( const IO_ERROR& ioe )
+void FP_CACHE::ParseAll()
+{
+    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+
+    std::vector<FP_CACHE_FOOTPRINT_MAP::iterator> pending;
+
+    for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); ++it )
+    {
+        if( !it->second->IsParsed() )
+            pending.push_back( it );
+    }
+
+    ParallelForEachIndex( pending.size(),
+            [&]( size_t ii )
             {
-                if( !cacheError.IsEmpty() )
-                    cacheError += wxT( "\n\n" );
+                pending[ii]->second->Parse();
+            } );
 
-                cacheError += wxString::Format( _( "Unable to read file '%s'" ) + '\n',
-                                                fn.GetFullPath() );
-                cacheError += ioe.What();
-            }
-        } while( dir.GetNext( &fullName ) );
+    // Queue I/O errors so only files that fail to parse don't get loaded.
+    wxString cacheError;
 
-        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+    for( FP_CACHE_FOOTPRINT_MAP::iterator it = m_footprints.begin(); it != m_footprints.end(); )
+    {
+        wxString error = it->second->Parse();
+
+        if( error.IsEmpty() )
+        {
+            ++it;
+            continue;
+        }
 
         if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
+            cacheError += wxT( "\n\n" );
+
+        cacheError += error;
+        m_footprints.erase( it++ );
     }
+
+    if( !cacheError.IsEmpty() )
+        THROW_IO_ERROR( cacheError );
 }
 
 
@@ -278,13 +429,22 @@ long long FP_CACHE::GetTimestamp( const wxString& aLibPath )
 
 bool PCB_IO_KICAD_SEXPR::CanReadBoard( const wxString& aFileName ) const
 {
-    if( !PCB_IO::CanReadBoard( aFileName ) )
+    bool compressed = IsGzipFileName( aFileName );
+
+    // A compressed board is named for the board file it holds, e.g. "name.kicad_pcb.gz"
+    if( !PCB_IO::CanReadBoard( compressed ? aFileName.BeforeLast( '.' ) : aFileName ) )
         return false;
 
     try
     {
-        FILE_LINE_READER reader( aFileName );
-        PCB_IO_KICAD_SEXPR_PARSER       parser( &reader, nullptr, m_queryUserCallback );
+        std::unique_ptr<LINE_READER> reader;
+
+        if( compressed )
+            reader = std::make_unique<GZIP_FILE_LINE_READER>( aFileName );
+        else
+            reader = std::make_unique<FILE_LINE_READER>( aFileName );
+
+        PCB_IO_KICAD_SEXPR_PARSER parser( reader.get(), nullptr, m_queryUserCallback );
 
         return parser.IsValidBoardHeader();
     }
@@ -322,9 +482,29 @@ void PCB_IO_KICAD_SEXPR::SaveBoard( const wxString& aFileName, BOARD* aBoard,
     // Prepare net mapping that assures that net codes saved in a file are consecutive integers
     m_mapping->SetBoard( aBoard );
 
-    PRETTIFIED_FILE_OUTPUTFORMATTER formatter( aFileName );
+    if( BOARD_SAVED_TEXT* savedText = aBoard->GetSavedTextCache() )
+    {
+        size_t context = savedTextContext( aBoard );
+
+        // A renamed layer or renumbered net can change the text of any item
+        if( savedText->m_context != context )
+        {
+            savedText->m_entries.clear();
+            savedText->m_context = context;
+        }
 
-    m_out = &formatter;     // no ownership
+        m_savedText = savedText;
+    }
+
+    bool                             compressed = IsGzipFileName( aFileName );
+    std::unique_ptr<OUTPUTFORMATTER> formatter;
+
+    if( compressed )
+        formatter = std::make_unique<GZIP_FILE_OUTPUTFORMATTER>( aFileName );
+    else
+        formatter = std::make_unique<PRETTIFIED_FILE_OUTPUTFORMATTER>( aFileName );
+
+    m_out = formatter.get();     // no ownership
 
     m_out->Print( 0, "(kicad_pcb (version %d) (generator \"pcbnew\") (generator_version \"%s\")\n",
                   SEXPR_BOARD_FILE_VERSION, GetMajorMinorVersion().c_str().AsChar() );
@@ -335,6 +515,24 @@ void PCB_IO_KICAD_SEXPR::SaveBoard( const wxString& aFileName, BOARD* aBoard,
     m_out->Finish();
 
     m_out = nullptr;
+    m_savedText = nullptr;
+
+    // Compressed boards are streamed when loaded, so they never use a snapshot
+    if( !compressed && ADVANCED_CFG::GetCfg().m_BoardSnapshots )
+    {
+        // The snapshot is only an optimisation; the board has been saved either way
+        try
+        {
+            // Hash what actually landed on disk, since that is what the snapshot must match
+            MAPPED_FILE_LINE_READER written( aFileName );
+
+            BOARD_SNAPSHOT::Write( *aBoard, written.Contents(),
+                                   BOARD_SNAPSHOT::FileName( aFileName ) );
+        }
+        catch( const IO_ERROR& )
+        {
+        }
+    }
 }
 
 
@@ -784,6 +982,190 @@ void PCB_IO_KICAD_SEXPR::formatTeardropParameters( const TEARDROP_PARAMETERS& td
 }
 
 
+size_t PCB_IO_KICAD_SEXPR::savedTextContext( const BOARD* aBoard ) const
+{
+    size_t context = 0;
+
+    hash_combine( context, m_ctl, std::string( aBoard->GetEnabledLayers().FmtHex() ) );
+
+    for( PCB_LAYER_ID layer : aBoard->GetEnabledLayers().Seq() )
+        hash_combine( context, std::string( TO_UTF8( aBoard->GetLayerName( layer ) ) ) );
+
+    // Pads, tracks and zones are written with their translated net codes and pads with their
+    // net names as well
+    for( NETINFO_ITEM* net : *m_mapping )
+    {
+        hash_combine( context, net->GetNetCode(), m_mapping->Translate( net->GetNetCode() ),
+                      std::string( TO_UTF8( net->GetNetname() ) ) );
+    }
+
+    return context;
+}
+
+
+void PCB_IO_KICAD_SEXPR::formatSavedItems( const std::vector<const BOARD_ITEM*>& aItems,
+                                           int aNestLevel, const char* aSeparator ) const
+{
+    // Below this, formatting on the thread pool costs more than it saves
+    const size_t MIN_PARALLEL_ITEMS = 64;
+
+    std::vector<const std::string*> texts( aItems.size(), nullptr );
+    std::vector<size_t>             changed;
+
+    for( size_t ii = 0; ii < aItems.size(); ++ii )
+    {
+        auto it = m_savedText->m_entries.find( aItems[ii] );
+
+        if( it != m_savedText->m_entries.end() && it->second.m_uuid == aItems[ii]->m_Uuid )
+            texts[ii] = &it->second.m_text;
+        else
+            changed.push_back( ii );
+    }
+
+    // Each changed item is formatted on its own, so that its text can be saved for next time
+    std::vector<std::string> changedTexts( changed.size() );
+
+    auto formatChanged =
+            [&]( size_t aBegin, size_t aEnd )
+            {
+                PCB_IO_KICAD_SEXPR worker( m_ctl );
+                STRING_FORMATTER   buffer;
+
+                worker.m_board = m_board;
+                *worker.m_mapping = *m_mapping;
+                worker.m_out = &buffer;
+
+                for( size_t ii = aBegin; ii < aEnd; ++ii )
+                {
+                    worker.Format( aItems[changed[ii]], aNestLevel );
+                    changedTexts[ii] = buffer.GetString();
+                    buffer.Clear();
+                }
+            };
+
+    if( changed.size() < MIN_PARALLEL_ITEMS || !ADVANCED_CFG::GetCfg().m_ParallelBoardSave )
+    {
+        formatChanged( 0, changed.size() );
+    }
+    else
+    {
+        size_t chunkCount = std::min<size_t>( changed.size(),
+                                              GetKiCadThreadPool().get_thread_count() * 4 );
+        std::vector<std::exception_ptr> errors( chunkCount );
+
+        ParallelForEachIndex( chunkCount,
+                [&]( size_t aChunk )
+                {
+                    try
+                    {
+                        formatChanged( changed.size() * aChunk / chunkCount,
+                                       changed.size() * ( aChunk + 1 ) / chunkCount );
+                    }
+                    catch( ... )
+                    {
+                        errors[aChunk] = std::current_exception();
+                    }
+                } );
+
+        for( const std::exception_ptr& error : errors )
+        {
+            if( error )
+                std::rethrow_exception( error );
+        }
+    }
+
+    for( size_t ii = 0, next = 0; ii < aItems.size(); ++ii )
+    {
+        if( texts[ii] )
+            m_out->WriteFormatted( *texts[ii] );
+        else
+            m_out->WriteFormatted( changedTexts[next++] );
+
+        if( aSeparator )
+            m_out->Print( 0, "%s", aSeparator );
+    }
+
+    for( size_t ii = 0; ii < changed.size(); ++ii )
+    {
+        const BOARD_ITEM* item = aItems[changed[ii]];
+
+        m_savedText->m_entries[item] = { item->m_Uuid, std::move( changedTexts[ii] ) };
+    }
+}
+
+
+void PCB_IO_KICAD_SEXPR::formatItems( const std::vector<const BOARD_ITEM*>& aItems,
+                                      int aNestLevel, const char* aSeparator ) const
+{
+    // Below this, formatting on the thread pool costs more than it saves
+    const size_t MIN_PARALLEL_ITEMS = 64;
+
+    if( m_savedText )
+    {
+        formatSavedItems( aItems, aNestLevel, aSeparator );
+        return;
+    }
+
+    if( aItems.size() < MIN_PARALLEL_ITEMS || !ADVANCED_CFG::GetCfg().m_ParallelBoardSave )
+    {
+        for( const BOARD_ITEM* item : aItems )
+        {
+            Format( item, aNestLevel );
+
+            if( aSeparator )
+                m_out->Print( 0, "%s", aSeparator );
+        }
+
+        return;
+    }
+
+    // Each chunk is formatted by its own formatter into its own buffer.  The chunks are then
+    // written out in order, so the file is the same as when formatting them one by one.
+    size_t chunkCount = std::min<size_t>( aItems.size(),
+                                          GetKiCadThreadPool().get_thread_count() * 4 );
+    std::vector<std::unique_ptr<STRING_FORMATTER>> buffers( chunkCount );
+    std::vector<std::exception_ptr>                errors( chunkCount );
+
+    ParallelForEachIndex( chunkCount,
+            [&]( size_t aChunk )
+            {
+                size_t begin = aItems.size() * aChunk / chunkCount;
+                size_t end = aItems.size() * ( aChunk + 1 ) / chunkCount;
+
+                try
+                {
+                    PCB_IO_KICAD_SEXPR worker( m_ctl );
+
+                    buffers[aChunk] = std::make_unique<STRING_FORMATTER>();
+
+                    worker.m_board = m_board;
+                    *worker.m_mapping = *m_mapping;
+                    worker.m_out = buffers[aChunk].get();
+
+                    for( size_t ii = begin; ii < end; ++ii )
+                    {
+                        worker.Format( aItems[ii], aNestLevel );
+
+                        if( aSeparator )
+                            worker.m_out->Print( 0, "%s", aSeparator );
+                    }
+                }
+                catch( ... )
+                {
+                    errors[aChunk] = std::current_exception();
+                }
+            } );
+
+    for( size_t ii = 0; ii < chunkCount; ++ii )
+    {
+        if( errors[ii] )
+            std::rethrow_exception( errors[ii] );
+
+        m_out->WriteFormatted( buffers[ii]->GetString() );
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard, int aNestLevel ) const
 {
     std::set<BOARD_ITEM*, BOARD_ITEM::ptr_cmp> sorted_footprints( aBoard->Footprints().begin(),
@@ -801,15 +1183,13 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard, int aNestLevel ) const
     formatHeader( aBoard, aNestLevel );
 
     // Save the footprints.
-    for( BOARD_ITEM* footprint : sorted_footprints )
-    {
-        Format( footprint, aNestLevel );
-        m_out->Print( 0, "\n" );
-    }
+    formatItems( std::vector<const BOARD_ITEM*>( sorted_footprints.begin(),
+                                                 sorted_footprints.end() ),
+                 aNestLevel, "\n" );
 
     // Save the graphical items on the board (not owned by a footprint)
-    for( BOARD_ITEM* item : sorted_drawings )
-        Format( item, aNestLevel );
+    formatItems( std::vector<const BOARD_ITEM*>( sorted_drawings.begin(), sorted_drawings.end() ),
+                 aNestLevel );
 
     if( sorted_drawings.size() )
         m_out->Print( 0, "\n" );
@@ -817,15 +1197,15 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard, int aNestLevel ) const
     // Do not save PCB_MARKERs, they can be regenerated easily.
 
     // Save the tracks and vias.
-    for( PCB_TRACK* track : sorted_tracks )
-        Format( track, aNestLevel );
+    formatItems( std::vector<const BOARD_ITEM*>( sorted_tracks.begin(), sorted_tracks.end() ),
+                 aNestLevel );
 
     if( sorted_tracks.size() )
         m_out->Print( 0, "\n" );
 
     // Save the polygon (which are the newer technology) zones.
-    for( auto zone : sorted_zones )
-        Format( zone, aNestLevel );
+    formatItems( std::vector<const BOARD_ITEM*>( sorted_zones.begin(), sorted_zones.end() ),
+                 aNestLevel );
 
     // Save the groups
     for( BOARD_ITEM* group : sorted_groups )
@@ -2407,6 +2787,18 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE* aZone, int aNestLevel ) const
         }
     }
 
+    // Save the hashes of the inputs of the filled areas, so that unchanged zones don't need
+    // to be refilled after reloading
+    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+    {
+        if( size_t hash = aZone->GetFillInputHash( layer ) )
+        {
+            m_out->Print( aNestLevel + 1, "(fill_hash (layer %s) \"%llx\")\n",
+                          m_out->Quotew( LSET::Name( layer ) ).c_str(),
+                          (unsigned long long) hash );
+        }
+    }
+
     m_out->Print( aNestLevel, ")\n" );
 }
 
@@ -2414,7 +2806,8 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE* aZone, int aNestLevel ) const
 PCB_IO_KICAD_SEXPR::PCB_IO_KICAD_SEXPR( int aControlFlags ) : PCB_IO( wxS( "KiCad" ) ),
     m_cache( nullptr ),
     m_ctl( aControlFlags ),
-    m_mapping( new NETINFO_MAPPING() )
+    m_mapping( new NETINFO_MAPPING() ),
+    m_savedText( nullptr )
 {
     init( nullptr );
     m_out = &m_sf;
@@ -2431,7 +2824,24 @@ PCB_IO_KICAD_SEXPR::~PCB_IO_KICAD_SEXPR()
 BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                               const STRING_UTF8_MAP* aProperties, PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
+    if( IsGzipFileName( aFileName ) )
+        return loadCompressedBoard( aFileName, aAppendToMe, aProperties );
+
+    MAPPED_FILE_LINE_READER reader( aFileName );
+    BOARD_SNAPSHOT          snapshot;
+    const BOARD_SNAPSHOT*   validSnapshot = nullptr;
+
+    if( !aAppendToMe && ADVANCED_CFG::GetCfg().m_BoardSnapshots
+            && snapshot.Open( BOARD_SNAPSHOT::FileName( aFileName ), reader.Contents() ) )
+    {
+        validSnapshot = &snapshot;
+    }
+
+    if( !aAppendToMe && ADVANCED_CFG::GetCfg().m_ParallelBoardLoad )
+    {
+        if( BOARD* board = loadBoardInParallel( reader, aProperties, validSnapshot ) )
+            return board;
+    }
 
     unsigned lineCount = 0;
 
@@ -2450,7 +2860,14 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
         reader.Rewind();
     }
 
-    BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
+    init( aProperties );
+
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, aAppendToMe, m_queryUserCallback,
+                                      m_progressReporter, lineCount );
+
+    parser.SetSnapshot( validSnapshot );
+
+    BOARD* board = parseBoard( parser );
 
     // Give the filename to the board if it's new
     if( !aAppendToMe )
@@ -2460,17 +2877,106 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
 }
 
 
+BOARD* PCB_IO_KICAD_SEXPR::loadCompressedBoard( const wxString& aFileName, BOARD* aAppendToMe,
+                                                const STRING_UTF8_MAP* aProperties )
+{
+    // The board is decompressed as it is parsed, so there is no text to split between threads
+    // or to match against a snapshot.
+    GZIP_FILE_LINE_READER reader( aFileName );
+    unsigned              lineCount = 0;
+
+    fontconfig::FONTCONFIG::SetReporter( &WXLOG_REPORTER::GetInstance() );
+
+    if( m_progressReporter )
+    {
+        m_progressReporter->Report( wxString::Format( _( "Loading %s..." ), aFileName ) );
+
+        if( !m_progressReporter->KeepRefreshing() )
+            THROW_IO_ERROR( _( "Open cancelled by user." ) );
+
+        while( reader.ReadLine() )
+            lineCount++;
+
+        reader.Rewind();
+    }
+
+    init( aProperties );
+
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, aAppendToMe, m_queryUserCallback,
+                                      m_progressReporter, lineCount );
+
+    BOARD* board = parseBoard( parser );
+
+    if( !aAppendToMe )
+        board->SetFileName( aFileName );
+
+    return board;
+}
+
+
+BOARD* PCB_IO_KICAD_SEXPR::loadBoardInParallel( MAPPED_FILE_LINE_READER& aFileReader,
+                                                const STRING_UTF8_MAP*   aProperties,
+                                                const BOARD_SNAPSHOT*    aSnapshot )
+{
+    const wxString& fileName = aFileReader.GetSource();
+
+    std::string                                            header;
+    std::vector<PCB_IO_KICAD_SEXPR_PARSER::DEFERRED_BLOCK> blocks;
+
+    // Not a board, or too small to bother: let the regular reader deal with it
+    if( !PCB_IO_KICAD_SEXPR_PARSER::SplitBoardText( aFileReader.Contents(), header, blocks ) )
+        return nullptr;
+
+    unsigned lineCount = 0;
+
+    fontconfig::FONTCONFIG::SetReporter( &WXLOG_REPORTER::GetInstance() );
+
+    if( m_progressReporter )
+    {
+        m_progressReporter->Report( wxString::Format( _( "Loading %s..." ), fileName ) );
+
+        if( !m_progressReporter->KeepRefreshing() )
+            THROW_IO_ERROR( _( "Open cancelled by user." ) );
+
+        lineCount = std::count( header.begin(), header.end(), '\n' ) + 1;
+    }
+
+    STRING_LINE_READER reader( header, fileName );
+
+    init( aProperties );
+
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, m_queryUserCallback, m_progressReporter,
+                                      lineCount );
+
+    parser.SetDeferredBlocks( aFileReader.Contents(), std::move( blocks ) );
+    parser.SetSnapshot( aSnapshot );
+
+    BOARD* board = parseBoard( parser );
+
+    board->SetFileName( fileName );
+
+    return board;
+}
+
+
 BOARD* PCB_IO_KICAD_SEXPR::DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, const STRING_UTF8_MAP* aProperties,
                            PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount)
 {
     init( aProperties );
 
     PCB_IO_KICAD_SEXPR_PARSER parser( &aReader, aAppendToMe, m_queryUserCallback, aProgressReporter, aLineCount );
-    BOARD*     board;
+
+    return parseBoard( parser );
+}
+
+
+BOARD* PCB_IO_KICAD_SEXPR::parseBoard( PCB_IO_KICAD_SEXPR_PARSER& aParser )
+{
+    BOARD* board;
 
     try
     {
-        board = dynamic_cast<BOARD*>( parser.Parse() );
+        board = dynamic_cast<BOARD*>( aParser.Parse() );
     }
     catch( const FUTURE_FORMAT_ERROR& )
     {
@@ -2479,8 +2985,8 @@ BOARD* PCB_IO_KICAD_SEXPR::DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, con
     }
     catch( const PARSE_ERROR& parse_error )
     {
-        if( parser.IsTooRecent() )
-            throw FUTURE_FORMAT_ERROR( parse_error, parser.GetRequiredVersion() );
+        if( aParser.IsTooRecent() )
+            throw FUTURE_FORMAT_ERROR( parse_error, aParser.GetRequiredVersion() );
         else
             throw;
     }
@@ -2488,8 +2994,8 @@ BOARD* PCB_IO_KICAD_SEXPR::DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, con
     if( !board )
     {
         // The parser loaded something that was valid, but wasn't a board.
-        THROW_PARSE_ERROR( _( "This file does not contain a PCB." ), parser.CurSource(),
-                           parser.CurLine(), parser.CurLineNumber(), parser.CurOffset() );
+        THROW_PARSE_ERROR( _( "This file does not contain a PCB." ), aParser.CurSource(),
+                           aParser.CurLine(), aParser.CurLineNumber(), aParser.CurOffset() );
     }
 
     return board;
@@ -30,7 +30,9 @@
 #include <ctl_flags.h>
 
 #include <richio.h>
+#include <mutex>
 #include <string>
+#include <vector>
 #include <layer_ids.h>
 #include <boost/ptr_container/ptr_map.hpp>
 #include <wx_filename.h>
@@ -38,6 +40,8 @@
 
 class BOARD;
 class BOARD_ITEM;
+class BOARD_SNAPSHOT;
+struct BOARD_SAVED_TEXT;
 class FP_CACHE;
 class PCB_IO_KICAD_SEXPR_PARSER;
 class NETINFO_MAPPING;
@@ -149,7 +153,8 @@ class PCB_IO_KICAD_SEXPR;   // forward decl
 //#define SEXPR_BOARD_FILE_VERSION    20231014  // V8 file format normalization
 //#define SEXPR_BOARD_FILE_VERSION    20231212  // Reference image locking/UUIDs, footprint boolean format
 //#define SEXPR_BOARD_FILE_VERSION    20231231  // Use 'uuid' rather than 'id' for generators and groups
-#define SEXPR_BOARD_FILE_VERSION      20240108  // Convert teardrop parameters to explicit bools
+//#define SEXPR_BOARD_FILE_VERSION    20240108  // Convert teardrop parameters to explicit bools
+#define SEXPR_BOARD_FILE_VERSION      20240310  // Zone fill input hashes
 
 #define BOARD_FILE_HOST_VERSION       20200825  ///< Earlier files than this include the host tag
 #define LEGACY_ARC_FORMATTING         20210925  ///< These were the last to use old arc formatting
@@ -181,15 +186,44 @@ class PCB_IO_KICAD_SEXPR;   // forward decl
  */
 class FP_CACHE_ITEM
 {
-    WX_FILENAME                m_filename;
-    std::unique_ptr<FOOTPRINT> m_footprint;
+    WX_FILENAME                        m_filename;
+    mutable std::unique_ptr<FOOTPRINT> m_footprint;
+
+    mutable std::mutex                 m_parseMutex;
+    mutable bool                       m_parsed;     // The file has been read, or tried to be.
+    mutable wxString                   m_parseError; // Why reading the file failed.
+    mutable size_t                     m_memoryUsage; // Accounted for the footprint
 
 public:
     FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
+    /**
+     * Create an item for the footprint file \aFileName which is only read the first time its
+     * footprint is asked for.
+     */
+    FP_CACHE_ITEM( const WX_FILENAME& aFileName );
+
+    ~FP_CACHE_ITEM();
+
     const WX_FILENAME& GetFileName() const { return m_filename; }
     void               SetFilePath( const wxString& aFilePath ) { m_filename.SetPath( aFilePath ); }
-    const FOOTPRINT*   GetFootprint() const { return m_footprint.get(); }
+
+    /**
+     * Return the footprint, reading its file first if that hasn't been done yet.  Different
+     * items can be read from several threads at once.
+     *
+     * @return the footprint or nullptr if its file couldn't be read.
+     */
+    const FOOTPRINT*   GetFootprint() const;
+
+    /**
+     * Read the footprint file if that hasn't been done yet.
+     *
+     * @return the error message if the file couldn't be read or an empty string.
+     */
+    wxString           Parse() const;
+
+    bool               IsParsed() const;
 };
 
 typedef boost::ptr_map<wxString, FP_CACHE_ITEM> FP_CACHE_FOOTPRINT_MAP;
@@ -228,8 +262,19 @@ public:
      */
     void Save( FOOTPRINT* aFootprint = nullptr );
 
+    /**
+     * Read the library folder.  If lazy footprint libraries are enabled only the footprint file
+     * names are listed, and the files are read when their footprint is first asked for.
+     */
     void Load();
 
+    /**
+     * Read every footprint file of the library which hasn't been read yet, on the thread pool.
+     *
+     * @throw IO_ERROR listing the files which couldn't be read.
+     */
+    void ParseAll();
+
     void Remove( const wxString& aFootprintName );
 
     /**
@@ -394,6 +439,40 @@ protected:
     void formatTeardropParameters( const TEARDROP_PARAMETERS& tdParams, int aNestLevel = 0 ) const;
 
 private:
+    /**
+     * Read a board whose footprints, tracks and zones are parsed in parallel.
+     *
+     * @param aSnapshot is an optional snapshot of the zone fills made from the file.
+     * @return nullptr if the file should be read by the regular reader instead.
+     */
+    BOARD* loadBoardInParallel( MAPPED_FILE_LINE_READER& aFileReader,
+                                const STRING_UTF8_MAP* aProperties,
+                                const BOARD_SNAPSHOT* aSnapshot );
+
+    /// Read a gzip compressed board, decompressing it as it is parsed.
+    BOARD* loadCompressedBoard( const wxString& aFileName, BOARD* aAppendToMe,
+                                const STRING_UTF8_MAP* aProperties );
+
+    /// Run @a aParser, which is expected to produce a board
+    BOARD* parseBoard( PCB_IO_KICAD_SEXPR_PARSER& aParser );
+
+    /**
+     * Format @a aItems in order, each followed by @a aSeparator if not null.  Long lists are
+     * formatted on the thread pool, in chunks which are then written out in order.
+     */
+    void formatItems( const std::vector<const BOARD_ITEM*>& aItems, int aNestLevel,
+                      const char* aSeparator = nullptr ) const;
+
+    /**
+     * Write @a aItems like formatItems(), reusing the text saved in m_savedText for the items
+     * which haven't changed since the last save and saving the text of the others.
+     */
+    void formatSavedItems( const std::vector<const BOARD_ITEM*>& aItems, int aNestLevel,
+                           const char* aSeparator ) const;
+
+    /// @return a hash of everything other than the items themselves their text depends on
+    size_t savedTextContext( const BOARD* aBoard ) const;
+
     void format( const BOARD* aBoard, int aNestLevel = 0 ) const;
 
     void format( const PCB_DIMENSION_BASE* aDimension, int aNestLevel = 0 ) const;
@@ -443,6 +522,8 @@ protected:
     int                    m_ctl;
     NETINFO_MAPPING*       m_mapping;    ///< mapping for net codes, so only not empty net codes
                                          ///< are stored with consecutive integers as net codes
+    BOARD_SAVED_TEXT*      m_savedText;  ///< text of the items of the board being saved, if
+                                         ///< it keeps it, no ownership
 
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
 };
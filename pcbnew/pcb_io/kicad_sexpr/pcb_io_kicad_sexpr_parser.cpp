@@ -27,8 +27,11 @@
  * @brief Pcbnew s-expression file format parser implementation.
  */
 
+#include <algorithm>
 #include <cerrno>
 #include <charconv>
+#include <future>
+#include <string_view>
 #include <confirm.h>
 #include <macros.h>
 #include <fmt/format.h>
@@ -59,6 +62,7 @@
 #include <locale_io.h>
 #include <zones.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_snapshot.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
 #include <math/util.h>                           // KiROUND, Clamp
 #include <string_utils.h>
@@ -66,6 +70,7 @@
 #include <progress_reporter.h>
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <pgm_base.h>
+#include <core/thread_pool.h>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code. Needed for PCB_REFERENCE_IMAGE
@@ -85,6 +90,205 @@ constexpr double INT_LIMIT = std::numeric_limits<int>::max() - 10;
 using namespace PCB_KEYS_T;
 
 
+/// Don't bother with worker parsers for boards with fewer top-level items than this.
+static const size_t MIN_PARALLEL_BLOCKS = 32;
+
+
+/**
+ * A #LINE_READER that reads a run of #DEFERRED_BLOCKs out of the text of a board file,
+ * reporting the line numbers of the file.
+ */
+class DEFERRED_BLOCK_READER : public LINE_READER
+{
+public:
+    using DEFERRED_BLOCK = PCB_IO_KICAD_SEXPR_PARSER::DEFERRED_BLOCK;
+
+    DEFERRED_BLOCK_READER( std::string_view aText, const DEFERRED_BLOCK* aBegin,
+                           const DEFERRED_BLOCK* aEnd, const wxString& aSource ) :
+            m_text( aText ),
+            m_block( aBegin ),
+            m_blockEnd( aEnd ),
+            m_pos( aBegin->m_start )
+    {
+        m_source = aSource;
+        m_lineNum = aBegin->m_line - 1;
+    }
+
+    char* ReadLine() override
+    {
+        while( m_block != m_blockEnd && m_pos >= m_block->m_end )
+        {
+            if( ++m_block != m_blockEnd )
+            {
+                m_pos = m_block->m_start;
+                m_lineNum = m_block->m_line - 1;
+            }
+        }
+
+        unsigned new_length = 0;
+
+        if( m_block != m_blockEnd )
+        {
+            const char* start = m_text.data() + m_pos;
+            const char* nl = static_cast<const char*>( memchr( start, '\n',
+                                                               m_block->m_end - m_pos ) );
+
+            if( !nl )
+                new_length = m_block->m_end - m_pos;
+            else
+                new_length = nl - start + 1;     // include the newline, so +1
+
+            if( new_length >= m_maxLineLength )
+                THROW_IO_ERROR( _( "Line length exceeded" ) );
+
+            if( new_length + 1 > m_capacity )   // +1 for terminating nul
+                expandCapacity( new_length + 1 );
+
+            memcpy( m_line, start, new_length );
+            m_pos += new_length;
+        }
+
+        m_length = new_length;
+        ++m_lineNum;
+        m_line[m_length] = 0;
+
+        return m_length ? m_line : nullptr;
+    }
+
+private:
+    std::string_view      m_text;
+    const DEFERRED_BLOCK* m_block;
+    const DEFERRED_BLOCK* m_blockEnd;
+    size_t                m_pos;
+};
+
+
+PCB_IO_KICAD_SEXPR_PARSER::PCB_IO_KICAD_SEXPR_PARSER( LINE_READER* aReader,
+                                                      const PCB_IO_KICAD_SEXPR_PARSER& aMaster ) :
+        PCB_LEXER( aReader ),
+        m_board( aMaster.m_board ),
+        m_appendToExisting( false ),
+        m_progressReporter( nullptr ),
+        m_lastProgressTime( std::chrono::steady_clock::now() ),
+        m_lineCount( 0 ),
+        m_queryUserCallback( aMaster.m_queryUserCallback ),
+        m_deferredLines( 0 ),
+        m_isWorker( true ),
+        m_legacyTeardrops( false ),
+        m_snapshot( aMaster.m_snapshot )
+{
+    init();
+
+    m_layerIndices = aMaster.m_layerIndices;
+    m_layerMasks = aMaster.m_layerMasks;
+    m_netCodes = aMaster.m_netCodes;
+    m_tooRecent = aMaster.m_tooRecent;
+    m_requiredVersion = aMaster.m_requiredVersion;
+    m_generatorVersion = aMaster.m_generatorVersion;
+    m_showLegacySegmentZoneWarning = aMaster.m_showLegacySegmentZoneWarning;
+    m_showLegacy5ZoneWarning = aMaster.m_showLegacy5ZoneWarning;
+}
+
+
+bool PCB_IO_KICAD_SEXPR_PARSER::SplitBoardText( std::string_view aText, std::string& aHeader,
+                                                std::vector<DEFERRED_BLOCK>& aBlocks )
+{
+    static const std::string_view deferredTokens[] = { "footprint", "module", "segment",
+                                                       "arc", "via", "zone" };
+
+    const size_t len = aText.size();
+    size_t       pos = aText.find_first_not_of( " \t\r\n" );
+
+    if( pos == std::string::npos || aText.compare( pos, 10, "(kicad_pcb" ) != 0 )
+        return false;
+
+    aBlocks.clear();
+
+    unsigned line = 1 + std::count( aText.begin(), aText.begin() + pos, '\n' );
+    int      depth = 0;
+    bool     inString = false;
+    size_t   blockStart = 0;
+    unsigned blockLine = 0;
+    bool     deferred = false;
+
+    for( ; pos < len; ++pos )
+    {
+        char c = aText[pos];
+
+        if( c == '\n' )
+        {
+            line++;
+        }
+        else if( inString )
+        {
+            if( c == '\\' && pos + 1 < len && aText[pos + 1] != '\n' )
+                ++pos;
+            else if( c == '"' )
+                inString = false;
+        }
+        else if( c == '"' )
+        {
+            inString = true;
+        }
+        else if( c == '(' )
+        {
+            if( ++depth == 2 )
+            {
+                size_t keyEnd = aText.find_first_of( " \t\r\n()\"", pos + 1 );
+                std::string_view key( aText.data() + pos + 1,
+                                      std::min( keyEnd, len ) - ( pos + 1 ) );
+
+                deferred = std::find( std::begin( deferredTokens ), std::end( deferredTokens ),
+                                      key ) != std::end( deferredTokens );
+                blockStart = pos;
+                blockLine = line;
+            }
+        }
+        else if( c == ')' )
+        {
+            if( depth == 2 && deferred )
+                aBlocks.push_back( { blockStart, pos + 1, blockLine, line - blockLine + 1 } );
+
+            if( --depth == 0 )
+                break;
+        }
+    }
+
+    if( depth != 0 || inString || aBlocks.size() < MIN_PARALLEL_BLOCKS )
+    {
+        aBlocks.clear();
+        return false;
+    }
+
+    aHeader.clear();
+
+    size_t copied = 0;
+
+    for( const DEFERRED_BLOCK& block : aBlocks )
+    {
+        aHeader.append( aText, copied, block.m_start - copied );
+        aHeader.append( block.m_lines - 1, '\n' );
+        copied = block.m_end;
+    }
+
+    aHeader.append( aText, copied, std::string::npos );
+
+    return true;
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::SetDeferredBlocks( std::string_view aText,
+                                                   std::vector<DEFERRED_BLOCK> aBlocks )
+{
+    m_deferredText = aText;
+    m_deferredBlocks = std::move( aBlocks );
+    m_deferredLines = 0;
+
+    for( const DEFERRED_BLOCK& block : m_deferredBlocks )
+        m_deferredLines += block.m_lines;
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::init()
 {
     m_showLegacySegmentZoneWarning = true;
@@ -141,7 +345,11 @@ void PCB_IO_KICAD_SEXPR_PARSER::checkpoint()
 
         if( delta > std::chrono::milliseconds( 250 ) )
         {
-            m_progressReporter->SetCurrentProgress( ( (double) curLine )
+            // Deferred blocks are only blank lines in the reader; leave their share of the
+            // progress to parseDeferredBlocks()
+            double headerShare = 1.0 - (double) m_deferredLines / std::max( 1U, m_lineCount );
+
+            m_progressReporter->SetCurrentProgress( headerShare * curLine
                                                             / std::max( 1U, m_lineCount ) );
 
             if( !m_progressReporter->KeepRefreshing() )
@@ -194,6 +402,16 @@ int PCB_IO_KICAD_SEXPR_PARSER::parseBoardUnits()
     // to confirm or experiment.  Use a similar strategy in both places, here
     // and in the test program. Make that program with:
     // $ make test-nm-biu-to-ascii-mm-round-tripping
+    int value;
+
+    // Values written by the formatter are plain decimals which convert exactly without
+    // going through a double.
+    if( EDA_UNIT_UTILS::ParseInternalUnitsExact( CurStr(), pcbIUScale, value )
+            && value >= -INT_LIMIT && value <= INT_LIMIT )
+    {
+        return value;
+    }
+
     auto retval = parseDouble() * pcbIUScale.IU_PER_MM;
 
     // N.B. we currently represent board units as integers.  Any values that are
@@ -205,12 +423,8 @@ int PCB_IO_KICAD_SEXPR_PARSER::parseBoardUnits()
 
 int PCB_IO_KICAD_SEXPR_PARSER::parseBoardUnits( const char* aExpected )
 {
-    auto retval = parseDouble( aExpected ) * pcbIUScale.IU_PER_MM;
-
-    // N.B. we currently represent board units as integers.  Any values that are
-    // larger or smaller than those board units represent undefined behavior for
-    // the system.  We limit values to the largest that is visible on the screen
-    return KiROUND( Clamp<double>( -INT_LIMIT, retval, INT_LIMIT ) );
+    NeedNUMBER( aExpected );
+    return parseBoardUnits();
 }
 
 
@@ -1064,6 +1278,9 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         }
     }
 
+    if( !m_deferredBlocks.empty() )
+        parseDeferredBlocks( bulkAddedItems );
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -1160,6 +1377,185 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::parseDeferredBlocks( std::vector<BOARD_ITEM*>& aBulkAddedItems )
+{
+    struct CHUNK
+    {
+        std::unique_ptr<DEFERRED_BLOCK_READER>     m_reader;
+        std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER> m_parser;
+        std::vector<std::unique_ptr<BOARD_ITEM>>   m_items;
+        unsigned                                   m_lines = 0;
+    };
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    // A few chunks per thread so that a cluster of large zones doesn't hold up the others
+    size_t chunkCount = std::min<size_t>( m_deferredBlocks.size(), tp.get_thread_count() * 4 );
+    size_t totalSize = 0;
+
+    for( const DEFERRED_BLOCK& block : m_deferredBlocks )
+        totalSize += block.m_end - block.m_start;
+
+    std::vector<CHUNK> chunks;
+    size_t             chunkSize = totalSize / std::max<size_t>( 1, chunkCount ) + 1;
+    size_t             first = 0;
+
+    chunks.reserve( chunkCount + 1 );
+
+    while( first < m_deferredBlocks.size() )
+    {
+        size_t   last = first;
+        size_t   size = 0;
+        unsigned lines = 0;
+
+        while( last < m_deferredBlocks.size() && ( last == first || size < chunkSize ) )
+        {
+            size += m_deferredBlocks[last].m_end - m_deferredBlocks[last].m_start;
+            lines += m_deferredBlocks[last].m_lines;
+            last++;
+        }
+
+        CHUNK& chunk = chunks.emplace_back();
+
+        chunk.m_reader = std::make_unique<DEFERRED_BLOCK_READER>( m_deferredText,
+                                                                  &m_deferredBlocks[first],
+                                                                  m_deferredBlocks.data() + last,
+                                                                  CurSource() );
+        chunk.m_parser = std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER>(
+                new PCB_IO_KICAD_SEXPR_PARSER( chunk.m_reader.get(), *this ) );
+        chunk.m_lines = lines;
+        first = last;
+    }
+
+    std::atomic<bool>     cancelled( false );
+    std::atomic<unsigned> linesDone( 0 );
+    std::vector<std::future<void>> returns;
+
+    for( CHUNK& chunk : chunks )
+    {
+        returns.emplace_back( tp.submit(
+                [&chunk, &cancelled, &linesDone]()
+                {
+                    try
+                    {
+                        chunk.m_parser->parseDeferredItems( chunk.m_items, cancelled );
+                    }
+                    catch( ... )
+                    {
+                        // No point in parsing the rest of the file
+                        cancelled = true;
+                        throw;
+                    }
+
+                    linesDone += chunk.m_lines;
+                } ) );
+    }
+
+    // Wait for every worker before looking at the results; they all refer to our state
+    for( std::future<void>& ret : returns )
+    {
+        while( ret.wait_for( std::chrono::milliseconds( 100 ) ) != std::future_status::ready )
+        {
+            if( m_progressReporter && !cancelled )
+            {
+                unsigned total = std::max( 1U, m_lineCount );
+                double   headerShare = 1.0 - (double) m_deferredLines / total;
+
+                m_progressReporter->SetCurrentProgress( headerShare
+                                                        + (double) linesDone / total );
+
+                if( !m_progressReporter->KeepRefreshing() )
+                    cancelled = true;
+            }
+        }
+    }
+
+    for( CHUNK& chunk : chunks )
+    {
+        m_requiredVersion = std::max( m_requiredVersion, chunk.m_parser->m_requiredVersion );
+        m_tooRecent |= chunk.m_parser->m_tooRecent;
+    }
+
+    // Report the first error in file order
+    for( std::future<void>& ret : returns )
+        ret.get();
+
+    if( cancelled )
+        THROW_IO_ERROR( _( "Open cancelled by user." ) );
+
+    for( CHUNK& chunk : chunks )
+    {
+        PCB_IO_KICAD_SEXPR_PARSER& worker = *chunk.m_parser;
+
+        for( std::unique_ptr<BOARD_ITEM>& item : chunk.m_items )
+        {
+            m_board->Add( item.get(), ADD_MODE::BULK_APPEND, true );
+            aBulkAddedItems.push_back( item.release() );
+        }
+
+        for( const auto& [zone, netName] : worker.m_unresolvedZoneNets )
+            resolveZoneNet( zone, netName );
+
+        if( worker.m_legacyTeardrops )
+            m_board->SetLegacyTeardrops( true );
+
+        m_undefinedLayers.insert( worker.m_undefinedLayers.begin(),
+                                  worker.m_undefinedLayers.end() );
+
+        std::move( worker.m_groupInfos.begin(), worker.m_groupInfos.end(),
+                   std::back_inserter( m_groupInfos ) );
+        std::move( worker.m_generatorInfos.begin(), worker.m_generatorInfos.end(),
+                   std::back_inserter( m_generatorInfos ) );
+
+        m_showLegacySegmentZoneWarning &= worker.m_showLegacySegmentZoneWarning;
+        m_showLegacy5ZoneWarning &= worker.m_showLegacy5ZoneWarning;
+    }
+
+    m_deferredBlocks.clear();
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseDeferredItems( std::vector<std::unique_ptr<BOARD_ITEM>>& aItems,
+                                                    const std::atomic<bool>& aCancelled )
+{
+    for( T token = NextTok(); token != T_EOF; token = NextTok() )
+    {
+        if( aCancelled )
+            return;
+
+        if( token != T_LEFT )
+            Expecting( T_LEFT );
+
+        switch( NextTok() )
+        {
+        case T_module:      // legacy token
+        case T_footprint:
+            aItems.emplace_back( parseFOOTPRINT() );
+            break;
+
+        case T_segment:
+            aItems.emplace_back( parsePCB_TRACK() );
+            break;
+
+        case T_arc:
+            aItems.emplace_back( parseARC() );
+            break;
+
+        case T_via:
+            aItems.emplace_back( parsePCB_VIA() );
+            break;
+
+        case T_zone:
+            aItems.emplace_back( parseZONE( m_board ) );
+            break;
+
+        default:
+            Expecting( "footprint, segment, arc, via or zone" );
+        }
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem = [&]( const KIID& aId )
@@ -5571,9 +5967,11 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 
     // bigger scope since each filled_polygon is concatenated in here
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> pts;
+    std::map<PCB_LAYER_ID, size_t>         fillHashes;
     std::map<PCB_LAYER_ID, std::vector<SEG>> legacySegs;
     PCB_LAYER_ID filledLayer;
     bool         addedFilledPolygons = false;
+    bool         fillsFromSnapshot = false;
     bool         isStrokedFill = true;
 
     std::unique_ptr<ZONE> zone = std::make_unique<ZONE>( aParent );
@@ -5957,6 +6355,14 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         }
 
         case T_filled_polygon:
+            if( fillsFromSnapshot || ( m_snapshot && m_snapshot->HasFills( zone->m_Uuid ) ) )
+            {
+                // Restored below from the snapshot made from this very file
+                SkipSection();
+                fillsFromSnapshot = true;
+                break;
+            }
+
             {
                 // "(filled_polygon (pts"
                 NeedLEFT();
@@ -6013,6 +6419,22 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 
             break;
 
+        case T_fill_hash:
+        {
+            NeedLEFT();
+
+            if( NextTok() != T_layer )
+                Expecting( T_layer );
+
+            PCB_LAYER_ID layer = parseBoardItemLayer();
+            NeedRIGHT();
+            NeedSYMBOL();
+
+            fillHashes[layer] = (size_t) std::strtoull( CurText(), nullptr, 16 );
+            NeedRIGHT();
+            break;
+        }
+
         case T_fill_segments:
         {
             // Legacy segment fill
@@ -6098,7 +6520,8 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 
         default:
             Expecting( "net, layer/layers, tstamp, hatch, priority, connect_pads, min_thickness, "
-                       "fill, polygon, filled_polygon, fill_segments, attr, locked, uuid, or name" );
+                       "fill, polygon, filled_polygon, fill_hash, fill_segments, attr, locked, "
+                       "uuid, or name" );
         }
     }
 
@@ -6114,6 +6537,12 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         zone->SetBorderDisplayStyle( hatchStyle, hatchPitch, true );
     }
 
+    if( fillsFromSnapshot && !m_snapshot->RestoreFills( zone.get() ) )
+    {
+        THROW_PARSE_ERROR( _( "Invalid board snapshot" ), CurSource(), CurLine(),
+                           CurLineNumber(), CurOffset() );
+    }
+
     if( addedFilledPolygons )
     {
         if( isStrokedFill && !zone->GetIsRuleArea() )
@@ -6164,7 +6593,7 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
             SHAPE_POLY_SET layerFill;
 
             if( zone->HasFilledPolysForLayer( layer ) )
-                layerFill = SHAPE_POLY_SET( *zone->GetFill( layer ) );
+                layerFill = SHAPE_POLY_SET( *zone->GetFilledPolysList( layer ) );
 
             for( const auto& seg : segments )
             {
@@ -6182,6 +6611,9 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         }
     }
 
+    // Must come after the fills, which forget any previous hash
+    for( const auto& [layer, hash] : fillHashes )
+        zone->SetFillInputHash( layer, hash );
 
     // Ensure keepout and non copper zones do not have a net
     // (which have no sense for these zones)
@@ -6198,28 +6630,19 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         // Can happens which old boards, with nonexistent nets ...
         // or after being edited by hand
         // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
-
-        if( net )   // An existing net has the same net name. use it for the zone
-        {
-            zone->SetNetCode( net->GetNetCode() );
-        }
-        else    // Not existing net: add a new net to keep trace of the zone netname
-        {
-            int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
-            m_board->Add( net, ADD_MODE::INSERT, true );
-
-            // Store the new code mapping
-            pushValueIntoMap( newnetcode, net->GetNetCode() );
-
-            // and update the zone netcode
-            zone->SetNetCode( net->GetNetCode() );
-        }
+        if( m_isWorker )
+            m_unresolvedZoneNets.emplace_back( zone.get(), netnameFromfile );
+        else
+            resolveZoneNet( zone.get(), netnameFromfile );
     }
 
     if( zone->IsTeardropArea() && m_requiredVersion < 20230517 )
-        m_board->SetLegacyTeardrops( true );
+    {
+        if( m_isWorker )
+            m_legacyTeardrops = true;
+        else
+            m_board->SetLegacyTeardrops( true );
+    }
 
     // Clear flags used in zone edition:
     zone->SetNeedRefill( false );
@@ -6291,6 +6714,29 @@ PCB_TARGET* PCB_IO_KICAD_SEXPR_PARSER::parsePCB_TARGET()
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::resolveZoneNet( ZONE* aZone, const wxString& aNetName )
+{
+    NETINFO_ITEM* net = m_board->FindNet( aNetName );
+
+    if( net )   // An existing net has the same net name. use it for the zone
+    {
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+    else    // Not existing net: add a new net to keep trace of the zone netname
+    {
+        int newnetcode = m_board->GetNetCount();
+        net = new NETINFO_ITEM( m_board, aNetName, newnetcode );
+        m_board->Add( net, ADD_MODE::INSERT, true );
+
+        // Store the new code mapping
+        pushValueIntoMap( newnetcode, net->GetNetCode() );
+
+        // and update the zone netcode
+        aZone->SetNetCode( net->GetNetCode() );
+    }
+}
+
+
 KIID PCB_IO_KICAD_SEXPR_PARSER::CurStrToKIID()
 {
     KIID aId;
@@ -38,13 +38,17 @@
 #include <math/box2.h>
 #include <string_any_map.h>
 
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <string_view>
 #include <unordered_map>
 
 
 class PCB_ARC;
 class BOARD;
 class BOARD_ITEM;
+class BOARD_SNAPSHOT;
 class BOARD_ITEM_CONTAINER;
 class PAD;
 class BOARD_DESIGN_SETTINGS;
@@ -83,7 +87,11 @@ public:
         m_progressReporter( aProgressReporter ),
         m_lastProgressTime( std::chrono::steady_clock::now() ),
         m_lineCount( aLineCount ),
-        m_queryUserCallback( std::move( aQueryUserCallback ) )
+        m_queryUserCallback( std::move( aQueryUserCallback ) ),
+        m_deferredLines( 0 ),
+        m_isWorker( false ),
+        m_legacyTeardrops( false ),
+        m_snapshot( nullptr )
     {
         init();
     }
@@ -120,7 +128,49 @@ public:
      */
     bool IsValidBoardHeader();
 
+    /**
+     * A top-level footprint, track, via or zone cut out of the text of a board file so that
+     * it can be parsed by a worker parser.
+     */
+    struct DEFERRED_BLOCK
+    {
+        size_t   m_start;   ///< offset of the opening parenthesis in the file text
+        size_t   m_end;     ///< offset one past the closing parenthesis
+        unsigned m_line;    ///< line number of m_start, starting from 1
+        unsigned m_lines;   ///< number of lines spanned by the block
+    };
+
+    /**
+     * Split the text of a board file into its header and the blocks which can be parsed in
+     * parallel.
+     *
+     * Each deferred block is replaced by its line breaks in @a aHeader, so line numbers
+     * reported while parsing the header still refer to the file.
+     *
+     * @return false if the text is not a well-formed board or has too few blocks to be worth
+     *         parsing in parallel.
+     */
+    static bool SplitBoardText( std::string_view aText, std::string& aHeader,
+                                std::vector<DEFERRED_BLOCK>& aBlocks );
+
+    /**
+     * Parse @a aBlocks of @a aText on the thread pool once the rest of the board read from
+     * the reader has been parsed.  @a aText must outlive the call to Parse().
+     */
+    void SetDeferredBlocks( std::string_view aText, std::vector<DEFERRED_BLOCK> aBlocks );
+
+    /**
+     * Restore the zone fills held by @a aSnapshot, which must have been made from the text
+     * being parsed, instead of reading them.  @a aSnapshot must outlive the call to Parse().
+     */
+    void SetSnapshot( const BOARD_SNAPSHOT* aSnapshot ) { m_snapshot = aSnapshot; }
+
 private:
+    /**
+     * Build a worker parser which shares the layer and net mappings read from the header of
+     * @a aMaster.
+     */
+    PCB_IO_KICAD_SEXPR_PARSER( LINE_READER* aReader, const PCB_IO_KICAD_SEXPR_PARSER& aMaster );
 
     // Group membership info refers to other Uuids in the file.
     // We don't want to rely on group declarations being last in the file, so
@@ -235,6 +285,24 @@ private:
     // Parse a board, but do not replace PARSE_ERROR with FUTURE_FORMAT_ERROR automatically.
     BOARD*      parseBOARD_unchecked();
 
+    /**
+     * Parse the deferred blocks in worker parsers and append them to the board in file order.
+     */
+    void parseDeferredBlocks( std::vector<BOARD_ITEM*>& aBulkAddedItems );
+
+    /**
+     * Parse the footprints, tracks, vias and zones read by a worker parser until the end of
+     * its input, or until @a aCancelled is set.
+     */
+    void parseDeferredItems( std::vector<std::unique_ptr<BOARD_ITEM>>& aItems,
+                             const std::atomic<bool>& aCancelled );
+
+    /**
+     * Give a copper zone whose net code doesn't match @a aNetName the net with that name,
+     * adding it to the board if needed.
+     */
+    void resolveZoneNet( ZONE* aZone, const wxString& aNetName );
+
     /**
      * Parse the current token for the layer definition of a #BOARD_ITEM object.
      *
@@ -403,6 +471,17 @@ private:
     std::vector<GENERATOR_INFO> m_generatorInfos;
 
     std::function<bool( wxString aTitle, int aIcon, wxString aMsg, wxString aAction )> m_queryUserCallback;
+
+    std::string_view            m_deferredText;     ///< file text holding m_deferredBlocks
+    std::vector<DEFERRED_BLOCK> m_deferredBlocks;
+    unsigned                    m_deferredLines;    ///< lines spanned by m_deferredBlocks
+
+    ///< Worker parsers leave the board alone; their board updates are applied by the master
+    bool                        m_isWorker;
+    bool                        m_legacyTeardrops;
+    std::vector<std::pair<ZONE*, wxString>> m_unresolvedZoneNets;
+
+    const BOARD_SNAPSHOT*       m_snapshot;         ///< optional source of the zone fills
 };
 
 
@@ -0,0 +1,436 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_snapshot.h>
+
+#include <cstring>
+#include <sstream>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <zone.h>
+#include <kiplatform/io.h>
+#include <md5_hash.h>
+#include <paths.h>
+
+
+// Start of the snapshot files.  Bump the version when the layout below changes.
+//
+// The layout is a flat sequence of native endian fields, so that it can be read in place
+// from the mapped file:
+//
+//   header, version, board file size, board file hash, zone count,
+//   zone count * ( zone id, entry size, entry )
+//
+// where an entry is
+//
+//   layer count * ( layer, outline count,
+//                   outline count * ( island flag, point count, point count * ( x, y ) ),
+//                   triangulation size, triangulation )
+static const std::string snapshotHeader = "KiCad board snapshot\n";
+static const uint32_t    snapshotVersion = 1;
+
+
+namespace
+{
+
+/**
+ * Bounds checked reads from a snapshot.  Reading past the end returns zeros and clears m_ok.
+ */
+struct SNAPSHOT_CURSOR
+{
+    SNAPSHOT_CURSOR( std::string_view aData ) :
+            m_data( aData ),
+            m_ok( true )
+    {}
+
+    template <typename T>
+    T Read()
+    {
+        T value{};
+
+        if( m_data.size() < sizeof( T ) )
+        {
+            m_ok = false;
+            return value;
+        }
+
+        memcpy( &value, m_data.data(), sizeof( T ) );
+        m_data.remove_prefix( sizeof( T ) );
+        return value;
+    }
+
+    std::string_view ReadBytes( size_t aSize )
+    {
+        if( m_data.size() < aSize )
+        {
+            m_ok = false;
+            return std::string_view();
+        }
+
+        std::string_view bytes = m_data.substr( 0, aSize );
+        m_data.remove_prefix( aSize );
+        return bytes;
+    }
+
+    std::string_view ReadString() { return ReadBytes( Read<uint32_t>() ); }
+
+    std::string_view m_data;
+    bool             m_ok;
+};
+
+
+template <typename T>
+void write( std::ostream& aOut, T aValue )
+{
+    aOut.write( reinterpret_cast<const char*>( &aValue ), sizeof( T ) );
+}
+
+
+void writeString( std::ostream& aOut, std::string_view aString )
+{
+    write<uint32_t>( aOut, aString.size() );
+    aOut.write( aString.data(), aString.size() );
+}
+
+
+std::string hashBoardText( std::string_view aText )
+{
+    MD5_HASH hash;
+
+    // MD5_HASH::Hash() takes a 32 bit length
+    for( size_t offset = 0; offset < aText.size(); offset += 0x40000000 )
+    {
+        size_t length = std::min<size_t>( aText.size() - offset, 0x40000000 );
+
+        hash.Hash( reinterpret_cast<uint8_t*>( const_cast<char*>( aText.data() + offset ) ),
+                   length );
+    }
+
+    hash.Finalize();
+
+    return hash.Format( true );
+}
+
+
+/**
+ * @return true if the fills of \a aZone are written as plain polygons by the board formatter,
+ *         which is all a snapshot entry can hold.
+ */
+bool canSnapshotFills( const ZONE* aZone )
+{
+    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+    {
+        if( !aZone->HasFilledPolysForLayer( layer ) )
+            continue;
+
+        const std::shared_ptr<SHAPE_POLY_SET>& fill = aZone->GetFilledPolysList( layer );
+
+        for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+        {
+            if( fill->COutline( ii ).ArcCount() > 0 )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+void writeFills( std::ostream& aOut, const ZONE* aZone )
+{
+    std::vector<PCB_LAYER_ID> layers;
+
+    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+    {
+        if( aZone->HasFilledPolysForLayer( layer )
+                && aZone->GetFilledPolysList( layer )->OutlineCount() > 0 )
+        {
+            layers.push_back( layer );
+        }
+    }
+
+    write<uint32_t>( aOut, layers.size() );
+
+    for( PCB_LAYER_ID layer : layers )
+    {
+        const std::shared_ptr<SHAPE_POLY_SET>& fill = aZone->GetFilledPolysList( layer );
+
+        write<int32_t>( aOut, layer );
+        write<uint32_t>( aOut, fill->OutlineCount() );
+
+        // Only the outlines, like the board formatter
+        for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+        {
+            const SHAPE_LINE_CHAIN& chain = fill->COutline( ii );
+
+            write<uint8_t>( aOut, aZone->IsIsland( layer, ii ) );
+            write<uint32_t>( aOut, chain.PointCount() );
+
+            for( const VECTOR2I& pt : chain.CPoints() )
+            {
+                write<int32_t>( aOut, pt.x );
+                write<int32_t>( aOut, pt.y );
+            }
+        }
+
+        std::ostringstream triangulation( std::ios::binary );
+
+        if( fill->WriteTriangulation( triangulation ) )
+            writeString( aOut, triangulation.str() );
+        else
+            writeString( aOut, std::string_view() );
+    }
+}
+
+
+/**
+ * Check that \a aEntry is a complete fill entry, without reading the points.
+ */
+bool validateFills( std::string_view aEntry )
+{
+    SNAPSHOT_CURSOR cursor( aEntry );
+    uint32_t        layerCount = cursor.Read<uint32_t>();
+
+    for( uint32_t ii = 0; ii < layerCount && cursor.m_ok; ++ii )
+    {
+        int32_t  layer = cursor.Read<int32_t>();
+        uint32_t outlineCount = cursor.Read<uint32_t>();
+
+        if( layer < 0 || layer >= PCB_LAYER_ID_COUNT )
+            return false;
+
+        for( uint32_t jj = 0; jj < outlineCount && cursor.m_ok; ++jj )
+        {
+            cursor.Read<uint8_t>();
+            cursor.ReadBytes( size_t( cursor.Read<uint32_t>() ) * 2 * sizeof( int32_t ) );
+        }
+
+        cursor.ReadString();
+    }
+
+    return cursor.m_ok && cursor.m_data.empty();
+}
+
+} // namespace
+
+
+BOARD_SNAPSHOT::~BOARD_SNAPSHOT()
+{
+    close();
+}
+
+
+void BOARD_SNAPSHOT::close()
+{
+    if( m_data )
+        KIPLATFORM::IO::UnmapFile( m_data, m_size, m_handle );
+
+    m_data = nullptr;
+    m_size = 0;
+    m_handle = nullptr;
+    m_zones.clear();
+}
+
+
+wxString BOARD_SNAPSHOT::FileName( const wxString& aBoardFileName )
+{
+    wxFileName fn( aBoardFileName );
+    MD5_HASH   hash;
+
+    fn.MakeAbsolute();
+
+    // One snapshot per board file, named after the hash of its path
+    wxScopedCharBuffer path = fn.GetFullPath().ToUTF8();
+
+    hash.Hash( reinterpret_cast<uint8_t*>( path.data() ), path.length() );
+    hash.Finalize();
+
+    wxFileName snapshot( PATHS::GetUserCachePath(), wxEmptyString );
+
+    snapshot.AppendDir( wxT( "board-snapshots" ) );
+    snapshot.SetFullName( wxString::FromUTF8( hash.Format( true ) ) + wxT( ".snapshot" ) );
+
+    return snapshot.GetFullPath();
+}
+
+
+bool BOARD_SNAPSHOT::Write( const BOARD& aBoard, std::string_view aBoardText,
+                            const wxString& aFileName )
+{
+    std::vector<const ZONE*> zones( aBoard.Zones().begin(), aBoard.Zones().end() );
+
+    for( const FOOTPRINT* footprint : aBoard.Footprints() )
+        zones.insert( zones.end(), footprint->Zones().begin(), footprint->Zones().end() );
+
+    std::ostringstream out( std::ios::binary );
+    std::ostringstream entry( std::ios::binary );
+    uint32_t           zoneCount = 0;
+
+    for( const ZONE* zone : zones )
+    {
+        if( canSnapshotFills( zone ) )
+            zoneCount++;
+    }
+
+    out << snapshotHeader;
+    write<uint32_t>( out, snapshotVersion );
+    write<uint64_t>( out, aBoardText.size() );
+    writeString( out, hashBoardText( aBoardText ) );
+    write<uint32_t>( out, zoneCount );
+
+    for( const ZONE* zone : zones )
+    {
+        if( !canSnapshotFills( zone ) )
+            continue;
+
+        entry.str( std::string() );
+        writeFills( entry, zone );
+
+        writeString( out, zone->m_Uuid.AsString().ToStdString() );
+        writeString( out, entry.str() );
+    }
+
+    wxFileName fn( aFileName );
+
+    if( !PATHS::EnsurePathExists( fn.GetPath() ) )
+        return false;
+
+    wxFFile     file( aFileName, wxT( "wb" ) );
+    std::string data = out.str();
+
+    return file.IsOpened() && file.Write( data.data(), data.size() ) == data.size();
+}
+
+
+bool BOARD_SNAPSHOT::Open( const wxString& aFileName, std::string_view aBoardText )
+{
+    close();
+
+    if( !wxFileExists( aFileName ) )
+        return false;
+
+    m_data = KIPLATFORM::IO::MapFile( aFileName, m_size, m_handle );
+
+    if( !m_data )
+        return false;
+
+    SNAPSHOT_CURSOR cursor( std::string_view( m_data, m_size ) );
+
+    if( cursor.ReadBytes( snapshotHeader.size() ) != snapshotHeader
+            || cursor.Read<uint32_t>() != snapshotVersion
+            || cursor.Read<uint64_t>() != aBoardText.size()
+            || cursor.ReadString() != hashBoardText( aBoardText ) )
+    {
+        close();
+        return false;
+    }
+
+    uint32_t zoneCount = cursor.Read<uint32_t>();
+
+    for( uint32_t ii = 0; ii < zoneCount && cursor.m_ok; ++ii )
+    {
+        std::string_view id = cursor.ReadString();
+        std::string_view entry = cursor.ReadString();
+
+        if( !cursor.m_ok || !validateFills( entry ) )
+        {
+            close();
+            return false;
+        }
+
+        m_zones[std::string( id )] = entry;
+    }
+
+    if( !cursor.m_ok )
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool BOARD_SNAPSHOT::HasFills( const KIID& aZoneId ) const
+{
+    return m_zones.count( aZoneId.AsString().ToStdString() ) > 0;
+}
+
+
+bool BOARD_SNAPSHOT::RestoreFills( ZONE* aZone ) const
+{
+    auto it = m_zones.find( aZone->m_Uuid.AsString().ToStdString() );
+
+    if( it == m_zones.end() )
+        return false;
+
+    // Open() checked the entry is complete
+    SNAPSHOT_CURSOR cursor( it->second );
+    uint32_t        layerCount = cursor.Read<uint32_t>();
+
+    for( uint32_t ii = 0; ii < layerCount; ++ii )
+    {
+        PCB_LAYER_ID   layer = static_cast<PCB_LAYER_ID>( cursor.Read<int32_t>() );
+        uint32_t       outlineCount = cursor.Read<uint32_t>();
+        SHAPE_POLY_SET fill;
+
+        if( !aZone->GetLayerSet().test( layer ) )
+            return false;
+
+        for( uint32_t jj = 0; jj < outlineCount; ++jj )
+        {
+            bool              island = cursor.Read<uint8_t>();
+            uint32_t          pointCount = cursor.Read<uint32_t>();
+            int               idx = fill.NewOutline();
+            SHAPE_LINE_CHAIN& chain = fill.Outline( idx );
+
+            if( island )
+                aZone->SetIsIsland( layer, idx );
+
+            for( uint32_t kk = 0; kk < pointCount; ++kk )
+            {
+                int x = cursor.Read<int32_t>();
+                int y = cursor.Read<int32_t>();
+
+                chain.Append( x, y );
+            }
+        }
+
+        aZone->SetFilledPolysList( layer, fill );
+
+        std::string_view triangulation = cursor.ReadString();
+
+        if( !triangulation.empty() )
+        {
+            std::istringstream in( std::string( triangulation ), std::ios::binary );
+
+            // Left to be triangulated again if it doesn't match the fill
+            aZone->GetFilledPolysList( layer )->ReadTriangulation( in );
+        }
+    }
+
+    if( layerCount > 0 )
+        aZone->CalculateFilledArea();
+
+    return true;
+}
@@ -0,0 +1,97 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PCB_IO_KICAD_SEXPR_SNAPSHOT_H_
+#define PCB_IO_KICAD_SEXPR_SNAPSHOT_H_
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <wx/string.h>
+
+class BOARD;
+class KIID;
+class ZONE;
+
+
+/**
+ * A binary snapshot of the zone fills of a board file, which are usually most of its size and
+ * of the time spent reading it.
+ *
+ * A snapshot is written to the user cache directory when a board is saved, together with the
+ * size and MD5 hash of the file it was made from.  When that same file is opened again, the
+ * parser skips the fill sections of its zones and restores them and their triangulations from
+ * the memory mapped snapshot instead.  The board file stays the source of truth: a snapshot
+ * which is missing, damaged or was made from another version of the file is ignored.
+ */
+class BOARD_SNAPSHOT
+{
+public:
+    BOARD_SNAPSHOT() = default;
+    ~BOARD_SNAPSHOT();
+
+    BOARD_SNAPSHOT( const BOARD_SNAPSHOT& ) = delete;
+    BOARD_SNAPSHOT& operator=( const BOARD_SNAPSHOT& ) = delete;
+
+    /**
+     * @return the name of the snapshot file of \a aBoardFileName in the user cache directory.
+     */
+    static wxString FileName( const wxString& aBoardFileName );
+
+    /**
+     * Write the zone fills of \a aBoard, which was just saved as \a aBoardText, to \a aFileName.
+     *
+     * @return false if the file couldn't be written.
+     */
+    static bool Write( const BOARD& aBoard, std::string_view aBoardText,
+                       const wxString& aFileName );
+
+    /**
+     * Map the snapshot \a aFileName and check that it was made from \a aBoardText.
+     *
+     * @return false if \a aFileName isn't a valid snapshot of \a aBoardText.
+     */
+    bool Open( const wxString& aFileName, std::string_view aBoardText );
+
+    /**
+     * @return true if the snapshot holds the fills of the zone \a aZoneId.
+     */
+    bool HasFills( const KIID& aZoneId ) const;
+
+    /**
+     * Set the fills of \a aZone, and their triangulations, from the snapshot.  Different zones
+     * can be restored from several threads at once.
+     *
+     * @return false if the snapshot doesn't hold the fills of \a aZone.
+     */
+    bool RestoreFills( ZONE* aZone ) const;
+
+private:
+    void close();
+
+    const char*   m_data = nullptr;
+    size_t        m_size = 0;
+    void*         m_handle = nullptr;
+
+    /// The fill entries of the zones, by zone id.
+    std::unordered_map<std::string, std::string_view> m_zones;
+};
+
+#endif // PCB_IO_KICAD_SEXPR_SNAPSHOT_H_
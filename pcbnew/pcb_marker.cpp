@@ -36,6 +36,7 @@
 #include <widgets/ui_common.h>
 #include <pgm_base.h>
 #include <drc/drc_item.h>
+#include <hash.h>
 #include <trigo.h>
 
 
@@ -137,6 +138,48 @@ wxString PCB_MARKER::Serialize() const
 }
 
 
+PCB_MARKER::VIOLATION_ID PCB_MARKER::GetViolationId() const
+{
+    // Keep in sync with Serialize()
+    VIOLATION_ID id{ m_rcItem->GetErrorCode(), UNDEFINED_LAYER, m_Pos, niluuid, niluuid };
+
+    if( m_rcItem->GetErrorCode() == DRCE_COPPER_SLIVER )
+    {
+        id.m_mainItem = m_rcItem->GetMainItemID();
+        id.m_layer = m_layer;
+    }
+    else if( m_rcItem->GetErrorCode() == DRCE_STARVED_THERMAL )
+    {
+        id.m_mainItem = m_rcItem->GetMainItemID();
+        id.m_auxItem = m_rcItem->GetAuxItemID();
+        id.m_layer = m_layer;
+    }
+    else if( m_rcItem->GetErrorCode() == DRCE_UNRESOLVED_VARIABLE
+            && m_rcItem->GetParent()->GetMarkerType() == MARKER_DRAWING_SHEET )
+    {
+        // Drawing sheet KIIDs aren't preserved between runs
+    }
+    else
+    {
+        id.m_mainItem = m_rcItem->GetMainItemID();
+        id.m_auxItem = m_rcItem->GetAuxItemID();
+    }
+
+    return id;
+}
+
+
+std::size_t PCB_MARKER::VIOLATION_ID_HASH::operator()( const VIOLATION_ID& aId ) const
+{
+    std::size_t seed = 0x3c7b2d91;
+
+    hash_combine( seed, aId.m_errorCode, aId.m_layer, aId.m_position.x, aId.m_position.y,
+                  aId.m_mainItem.Hash(), aId.m_auxItem.Hash() );
+
+    return seed;
+}
+
+
 PCB_MARKER* PCB_MARKER::Deserialize( const wxString& data )
 {
     auto getMarkerLayer =
@@ -56,6 +56,34 @@ public:
 
     static PCB_MARKER* Deserialize( const wxString& data );
 
+    /**
+     * Identifies a violation as Serialize() does (by error, position, items and, for some
+     * errors, layer), without building a string.  Lets the markers of successive DRC runs be
+     * matched up, so that the markers of unchanged violations can be kept as they are.
+     */
+    struct VIOLATION_ID
+    {
+        int      m_errorCode;
+        int      m_layer;
+        VECTOR2I m_position;
+        KIID     m_mainItem;
+        KIID     m_auxItem;
+
+        bool operator==( const VIOLATION_ID& aOther ) const
+        {
+            return m_errorCode == aOther.m_errorCode && m_layer == aOther.m_layer
+                    && m_position == aOther.m_position && m_mainItem == aOther.m_mainItem
+                    && m_auxItem == aOther.m_auxItem;
+        }
+    };
+
+    struct VIOLATION_ID_HASH
+    {
+        std::size_t operator()( const VIOLATION_ID& aId ) const;
+    };
+
+    VIOLATION_ID GetViolationId() const;
+
     void Move( const VECTOR2I& aMoveVector ) override
     {
         m_Pos += aMoveVector;
@@ -25,6 +25,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <pcb_track.h>
@@ -531,6 +532,122 @@ int PCB_PAINTER::getViaDrillSize( const PCB_VIA* aVia ) const
 }
 
 
+void PCB_PAINTER::PrepareItem( const VIEW_ITEM* aItem )
+{
+    const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( aItem );
+
+    if( !item )
+        return;
+
+    // Only the OpenGL GAL draws filled polygons from their triangulations
+    bool triangulate = m_gal->IsOpenGlEngine();
+
+    switch( item->Type() )
+    {
+    case PCB_PAD_T:
+        static_cast<const PAD*>( item )->GetEffectiveShape();
+        break;
+
+    case PCB_SHAPE_T:
+    {
+        PCB_SHAPE* shape = const_cast<PCB_SHAPE*>( static_cast<const PCB_SHAPE*>( item ) );
+
+        if( triangulate && shape->GetShape() == SHAPE_T::POLY && shape->IsFilled() )
+        {
+            SHAPE_POLY_SET& poly = shape->GetPolyShape();
+
+            if( poly.OutlineCount() > 0 && !poly.IsTriangulationUpToDate() )
+                poly.CacheTriangulation( true, true );
+        }
+
+        break;
+    }
+
+    case PCB_FIELD_T:
+    case PCB_TEXT_T:
+    {
+        const PCB_TEXT* text = static_cast<const PCB_TEXT*>( item );
+        KIFONT::FONT*   font = text->GetFont();
+
+        // Knockout text and text in the default font aren't drawn from a render cache
+        if( font && font->IsOutline() && !text->IsKnockout() )
+        {
+            wxString resolvedText( text->GetShownText( true ) );
+
+            if( !resolvedText.IsEmpty() )
+                text->GetRenderCache( font, resolvedText );
+        }
+
+        break;
+    }
+
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( item );
+
+        if( !triangulate )
+            break;
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+
+            if( fill->OutlineCount() > 0 && !fill->IsTriangulationUpToDate() )
+                fill->CacheTriangulation( true, true );
+
+            if( ADVANCED_CFG::GetCfg().m_ZoneFillProxies )
+                zone->GetFillProxy( layer );
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+
+bool PCB_PAINTER::DrawProxy( const VIEW_ITEM* aItem, int aLayer )
+{
+    const ZONE* zone = dynamic_cast<const ZONE*>( aItem );
+
+    // Footprint zones are few and small, and are drawn under more conditions than board zones
+    if( !zone || zone->GetParentFootprint() || !IsZoneFillLayer( aLayer ) )
+        return false;
+
+    // The other display modes are for inspecting the fill, which the proxy would misrepresent
+    if( m_pcbSettings.m_ZoneDisplayMode != ZONE_DISPLAY_MODE::SHOW_FILLED )
+        return false;
+
+    PCB_LAYER_ID layer = ToLAYER_ID( aLayer - LAYER_ZONE_START );
+
+    if( !zone->IsOnLayer( layer ) || !m_gal->IsOpenGlEngine() )
+        return false;
+
+    std::shared_ptr<SHAPE_POLY_SET> proxy = zone->GetFillProxy( layer );
+
+    if( !proxy )
+        return false;
+
+    COLOR4D color = m_pcbSettings.GetColor( zone, layer );
+
+    m_gal->SetStrokeColor( color );
+    m_gal->SetFillColor( color );
+    m_gal->SetLineWidth( 0 );
+    m_gal->SetIsFill( true );
+    m_gal->SetIsStroke( false );
+
+    if( proxy->OutlineCount() > 0 )
+        m_gal->DrawPolygon( *proxy );
+
+    return true;
+}
+
+
 bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 {
     const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( aItem );
@@ -753,6 +870,18 @@ void PCB_PAINTER::draw( const PCB_TRACK* aTrack, int aLayer )
 }
 
 
+bool PCB_PAINTER::isIllegible( double aTextHeight ) const
+{
+    // Below this, the strokes of the glyphs merge into a smudge
+    const double MIN_LEGIBLE_TEXT_PIXELS = 3.0;
+
+    if( m_gal->IsGrouping() || m_pcbSettings.m_isPrinting )
+        return false;
+
+    return aTextHeight * m_gal->GetWorldScale() < MIN_LEGIBLE_TEXT_PIXELS;
+}
+
+
 void PCB_PAINTER::renderNetNameForSegment( const SHAPE_SEGMENT& aSeg, const COLOR4D& aColor,
                                            const wxString& aNetName ) const
 {
@@ -1255,6 +1384,10 @@ void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
         double maxSize = PCB_RENDER_SETTINGS::MAX_FONT_SIZE;
         double size = padsize.y;
 
+        // Skip the layout of texts which would not be readable anyway
+        if( isIllegible( std::min( std::max( padsize.x, padsize.y ), maxSize ) ) )
+            return;
+
         m_gal->Save();
         m_gal->Translate( position );
 
@@ -1324,10 +1457,13 @@ void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
             VECTOR2D namesize( tsize*Xscale_for_stroked_font, tsize );
             textpos.y = std::min( tsize * 1.4, double( Y_offset_netname ) );
 
-            m_gal->SetGlyphSize( namesize );
-            m_gal->SetLineWidth( namesize.x / 6.0 );
-            m_gal->SetFontBold( true );
-            m_gal->BitmapText( netname, textpos, ANGLE_HORIZONTAL );
+            if( !isIllegible( tsize ) )
+            {
+                m_gal->SetGlyphSize( namesize );
+                m_gal->SetLineWidth( namesize.x / 6.0 );
+                m_gal->SetFontBold( true );
+                m_gal->BitmapText( netname, textpos, ANGLE_HORIZONTAL );
+            }
         }
 
         if( !padNumber.IsEmpty() )
@@ -1343,10 +1479,13 @@ void PCB_PAINTER::draw( const PAD* aPad, int aLayer )
             VECTOR2D numsize( tsize*Xscale_for_stroked_font, tsize );
             textpos.y = -Y_offset_numpad;
 
-            m_gal->SetGlyphSize( numsize );
-            m_gal->SetLineWidth( numsize.x / 6.0 );
-            m_gal->SetFontBold( true );
-            m_gal->BitmapText( padNumber, textpos, ANGLE_HORIZONTAL );
+            if( !isIllegible( tsize ) )
+            {
+                m_gal->SetGlyphSize( numsize );
+                m_gal->SetLineWidth( numsize.x / 6.0 );
+                m_gal->SetFontBold( true );
+                m_gal->BitmapText( padNumber, textpos, ANGLE_HORIZONTAL );
+            }
         }
 
         m_gal->Restore();
@@ -173,6 +173,12 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::PrepareItem()
+    virtual void PrepareItem( const VIEW_ITEM* aItem ) override;
+
+    /// @copydoc PAINTER::DrawProxy()
+    virtual bool DrawProxy( const VIEW_ITEM* aItem, int aLayer ) override;
+
 protected:
     PCB_VIEWERS_SETTINGS_BASE* viewer_settings();
 
@@ -200,6 +206,13 @@ protected:
      */
     int getLineThickness( int aActualThickness ) const;
 
+    /**
+     * @return true if text of \a aTextHeight (internal units) is too small to be read at the
+     *         current zoom level.  Always false while drawing into a cached group, which is
+     *         drawn at any zoom level.
+     */
+    bool isIllegible( double aTextHeight ) const;
+
     /**
      * Return drill shape of a pad.
      */
@@ -504,7 +504,11 @@ std::shared_ptr<SHAPE> PCB_TEXTBOX::GetEffectiveShape( PCB_LAYER_ID aLayer, FLAS
     std::shared_ptr<SHAPE_COMPOUND> shape = GetEffectiveTextShape();
 
     if( PCB_SHAPE::GetStroke().GetWidth() >= 0 )
+    {
+        // The text shape is cached: add the border to a copy
+        shape = std::make_shared<SHAPE_COMPOUND>( *shape );
         shape->AddShape( PCB_SHAPE::GetEffectiveShape( aLayer, aFlash ) );
+    }
 
     return shape;
 }
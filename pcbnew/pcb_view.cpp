@@ -72,6 +72,44 @@ void PCB_VIEW::Remove( KIGFX::VIEW_ITEM* aItem )
 }
 
 
+/**
+ * Add the children of the footprints of \a aItems before them, as PCB_VIEW::Add() does.
+ */
+static std::vector<KIGFX::VIEW_ITEM*> withChildren( const std::vector<KIGFX::VIEW_ITEM*>& aItems )
+{
+    std::vector<KIGFX::VIEW_ITEM*> items;
+    items.reserve( aItems.size() );
+
+    for( KIGFX::VIEW_ITEM* item : aItems )
+    {
+        if( FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( item ) )
+        {
+            footprint->RunOnChildren(
+                    [&]( BOARD_ITEM* aChild )
+                    {
+                        items.push_back( aChild );
+                    } );
+        }
+
+        items.push_back( item );
+    }
+
+    return items;
+}
+
+
+void PCB_VIEW::AddItems( const std::vector<KIGFX::VIEW_ITEM*>& aItems )
+{
+    VIEW::AddItems( withChildren( aItems ) );
+}
+
+
+void PCB_VIEW::RemoveItems( const std::vector<KIGFX::VIEW_ITEM*>& aItems )
+{
+    VIEW::RemoveItems( withChildren( aItems ) );
+}
+
+
 void PCB_VIEW::Update( const KIGFX::VIEW_ITEM* aItem, int aUpdateFlags ) const
 {
     if( const BOARD_ITEM* boardItem = dynamic_cast<const BOARD_ITEM*>( aItem ) )
@@ -45,6 +45,12 @@ public:
     /// @copydoc VIEW::Remove()
     virtual void Remove( VIEW_ITEM* aItem ) override;
 
+    /// @copydoc VIEW::AddItems()
+    virtual void AddItems( const std::vector<VIEW_ITEM*>& aItems ) override;
+
+    /// @copydoc VIEW::RemoveItems()
+    virtual void RemoveItems( const std::vector<VIEW_ITEM*>& aItems ) override;
+
     /// @copydoc VIEW::Update()
     virtual void Update( const VIEW_ITEM* aItem, int aUpdateFlags ) const override;
 
@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <board.h>
 #include <board_connected_item.h>
 #include <pcbexpr_evaluator.h>
@@ -197,6 +198,19 @@ protected:
 };
 
 
+void PCBEXPR_VAR_REF::AddAllowedClass( TYPE_ID type_hash, PROPERTY_BASE* prop )
+{
+    PROPERTY_BINDING& binding = m_matchingTypes[type_hash];
+
+    binding.m_property = prop;
+    binding.m_cast = PROPERTY_MANAGER::Instance().GetTypeCast( type_hash, prop->OwnerHash() );
+    binding.m_isLayer = prop->Name() == wxT( "Layer" )
+                        || prop->Name() == wxT( "Layer Top" )
+                        || prop->Name() == wxT( "Layer Bottom" );
+    binding.m_isPinType = prop->Name() == wxT( "Pin Type" );
+}
+
+
 LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 {
     PCBEXPR_CONTEXT* context = static_cast<PCBEXPR_CONTEXT*>( aCtx );
@@ -219,49 +233,85 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 
         return new LIBEVAL::VALUE();
     }
-    else
+
+    // Read the value straight from the getter when the property type allows it
+    const PROPERTY_BINDING& binding = it->second;
+    const void*             object = static_cast<const INSPECTABLE*>( item );
+    int                     intValue;
+    wxString                str;
+
+    if( binding.m_cast )
+        object = ( *binding.m_cast )( object );
+
+    if( m_type == LIBEVAL::VT_NUMERIC )
+    {
+        if( binding.m_property->GetInt( object, intValue ) )
+            return new LIBEVAL::VALUE( (double) intValue );
+    }
+    else if( !m_isEnum )
     {
-        if( m_type == LIBEVAL::VT_NUMERIC )
+        if( binding.m_property->GetString( object, str ) )
         {
-            return new LIBEVAL::VALUE( (double) item->Get<int>( it->second ) );
+            if( binding.m_isPinType )
+                return new PCBEXPR_PINTYPE_VALUE( str );
+            else
+                return new LIBEVAL::VALUE( str );
         }
-        else
+    }
+    else if( binding.m_isLayer )
+    {
+        if( binding.m_property->TypeHash() == TYPE_HASH( PCB_LAYER_ID )
+                && binding.m_property->GetInt( object, intValue ) )
         {
-            wxString str;
+            return new PCBEXPR_LAYER_VALUE( static_cast<PCB_LAYER_ID>( intValue ) );
+        }
+    }
+    else if( binding.m_property->GetString( object, str ) )
+    {
+        return new LIBEVAL::VALUE( str );
+    }
 
-            if( !m_isEnum )
-            {
-                str = item->Get<wxString>( it->second );
+    return getAnyValue( context, item, binding );
+}
 
-                if( it->second->Name() == wxT( "Pin Type" ) )
-                    return new PCBEXPR_PINTYPE_VALUE( str );
-                else
-                    return new LIBEVAL::VALUE( str );
-            }
-            else
-            {
-                const wxAny& any = item->Get( it->second );
-                PCB_LAYER_ID layer;
 
-                if( it->second->Name() == wxT( "Layer" )
-                        || it->second->Name() == wxT( "Layer Top" )
-                        || it->second->Name() == wxT( "Layer Bottom" ) )
-                {
-                    if( any.GetAs<PCB_LAYER_ID>( &layer ) )
-                        return new PCBEXPR_LAYER_VALUE( layer );
-                    else if( any.GetAs<wxString>( &str ) )
-                        return new PCBEXPR_LAYER_VALUE( context->GetBoard()->GetLayerID( str ) );
-                }
-                else
-                {
-                    if( any.GetAs<wxString>( &str ) )
-                        return new LIBEVAL::VALUE( str );
-                }
-            }
+LIBEVAL::VALUE* PCBEXPR_VAR_REF::getAnyValue( PCBEXPR_CONTEXT* aCtx, BOARD_ITEM* aItem,
+                                              const PROPERTY_BINDING& aBinding )
+{
+    PROPERTY_BASE* prop = aBinding.m_property;
 
-            return new LIBEVAL::VALUE();
-        }
+    if( m_type == LIBEVAL::VT_NUMERIC )
+        return new LIBEVAL::VALUE( (double) aItem->Get<int>( prop ) );
+
+    wxString str;
+
+    if( !m_isEnum )
+    {
+        str = aItem->Get<wxString>( prop );
+
+        if( aBinding.m_isPinType )
+            return new PCBEXPR_PINTYPE_VALUE( str );
+        else
+            return new LIBEVAL::VALUE( str );
+    }
+
+    const wxAny& any = aItem->Get( prop );
+    PCB_LAYER_ID layer;
+
+    if( aBinding.m_isLayer )
+    {
+        if( any.GetAs<PCB_LAYER_ID>( &layer ) )
+            return new PCBEXPR_LAYER_VALUE( layer );
+        else if( any.GetAs<wxString>( &str ) )
+            return new PCBEXPR_LAYER_VALUE( aCtx->GetBoard()->GetLayerID( str ) );
+    }
+    else
+    {
+        if( any.GetAs<wxString>( &str ) )
+            return new LIBEVAL::VALUE( str );
     }
+
+    return new LIBEVAL::VALUE();
 }
 
 
@@ -298,10 +348,56 @@ LIBEVAL::VALUE* PCBEXPR_TYPE_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 }
 
 
+const wxString* PCBEXPR_NETCLASS_REF::GetStringRef( LIBEVAL::CONTEXT* aCtx )
+{
+    BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
+
+    if( !item )
+        return nullptr;
+
+    return &item->GetEffectiveNetClass()->GetName();
+}
+
+
+const wxString* PCBEXPR_NETNAME_REF::GetStringRef( LIBEVAL::CONTEXT* aCtx )
+{
+    static const wxString s_noNet;
+
+    BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
+
+    if( !item )
+        return nullptr;
+
+    return item->GetNet() ? &item->GetNet()->GetNetname() : &s_noNet;
+}
+
+
+const wxString* PCBEXPR_TYPE_REF::GetStringRef( LIBEVAL::CONTEXT* aCtx )
+{
+    BOARD_ITEM* item = GetObject( aCtx );
+
+    if( !item )
+        return nullptr;
+
+    return &ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() );
+}
+
+
 LIBEVAL::FUNC_CALL_REF PCBEXPR_UCODE::CreateFuncCall( const wxString& aName )
 {
     PCBEXPR_BUILTIN_FUNCTIONS& registry = PCBEXPR_BUILTIN_FUNCTIONS::Instance();
 
+    // Functions which depend only on nets and via types
+    static const std::set<wxString> netAndTypeFuncs = { wxT( "iscoupleddiffpair" ),
+                                                        wxT( "indiffpair" ),
+                                                        wxT( "ismicrovia" ),
+                                                        wxT( "isblindburiedvia" ) };
+
+    if( netAndTypeFuncs.count( aName.Lower() ) && m_pendingObjectRefs > 0 )
+        m_pendingObjectRefs--;
+    else
+        m_netAndTypeOnly = false;
+
     return registry.Get( aName.Lower() );
 }
 
@@ -312,6 +408,17 @@ std::unique_ptr<LIBEVAL::VAR_REF> PCBEXPR_UCODE::CreateVarRef( const wxString& a
     PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
     std::unique_ptr<PCBEXPR_VAR_REF> vref;
 
+    bool netOrType = aField.CmpNoCase( wxT( "NetClass" ) ) == 0
+                        || aField.CmpNoCase( wxT( "NetName" ) ) == 0
+                        || aField.CmpNoCase( wxT( "Type" ) ) == 0;
+
+    // Objects are referenced for the functions called on them; the layer is known to every
+    // evaluation
+    if( aField.IsEmpty() && ( aVar == wxT( "A" ) || aVar == wxT( "B" ) ) )
+        m_pendingObjectRefs++;
+    else if( !netOrType && !( aField.IsEmpty() && aVar == wxT( "L" ) ) )
+        m_netAndTypeOnly = false;
+
     // Check for a couple of very common cases and compile them straight to "object code".
 
     if( aField.CmpNoCase( wxT( "NetClass" ) ) == 0 )
@@ -40,12 +40,30 @@ class PCBEXPR_VAR_REF;
 class PCBEXPR_UCODE final : public LIBEVAL::UCODE
 {
 public:
-    PCBEXPR_UCODE() {};
+    PCBEXPR_UCODE() :
+            m_netAndTypeOnly( true ),
+            m_pendingObjectRefs( 0 )
+    {};
+
     virtual ~PCBEXPR_UCODE() {};
 
     virtual std::unique_ptr<LIBEVAL::VAR_REF> CreateVarRef( const wxString& aVar,
                                                             const wxString& aField ) override;
     virtual LIBEVAL::FUNC_CALL_REF CreateFuncCall( const wxString& aName ) override;
+
+    /**
+     * @return true if the compiled expression reads nothing but the nets, net classes and
+     *         types (including via types) of the items, and the layer.  Its result is then the
+     *         same for all the item pairs which agree on those.
+     */
+    bool ReadsNetAndTypeOnly() const
+    {
+        return m_netAndTypeOnly && m_pendingObjectRefs == 0;
+    }
+
+private:
+    bool m_netAndTypeOnly;
+    int  m_pendingObjectRefs;   // object references not (yet) used by a net or type function
 };
 
 
@@ -96,17 +114,27 @@ public:
     void SetType( LIBEVAL::VAR_TYPE_T type ) { m_type = type; }
     LIBEVAL::VAR_TYPE_T GetType() const override { return m_type; }
 
-    void AddAllowedClass( TYPE_ID type_hash, PROPERTY_BASE* prop )
-    {
-        m_matchingTypes[type_hash] = prop;
-    }
+    void AddAllowedClass( TYPE_ID type_hash, PROPERTY_BASE* prop );
 
     LIBEVAL::VALUE* GetValue( LIBEVAL::CONTEXT* aCtx ) override;
 
     BOARD_ITEM* GetObject( const LIBEVAL::CONTEXT* aCtx ) const;
 
 private:
-    std::unordered_map<TYPE_ID, PROPERTY_BASE*> m_matchingTypes;
+    /// A property bound, when the rule is compiled, to one of the classes offering it
+    struct PROPERTY_BINDING
+    {
+        PROPERTY_BASE*        m_property;
+        const TYPE_CAST_BASE* m_cast;       ///< nullptr when the item pointer is used as is
+        bool                  m_isLayer;
+        bool                  m_isPinType;
+    };
+
+    LIBEVAL::VALUE* getAnyValue( PCBEXPR_CONTEXT* aCtx, BOARD_ITEM* aItem,
+                                 const PROPERTY_BINDING& aBinding );
+
+private:
+    std::unordered_map<TYPE_ID, PROPERTY_BINDING> m_matchingTypes;
     int                                         m_itemIndex;
     LIBEVAL::VAR_TYPE_T                         m_type;
     bool                                        m_isEnum;
@@ -124,6 +152,9 @@ public:
     }
 
     LIBEVAL::VALUE* GetValue( LIBEVAL::CONTEXT* aCtx ) override;
+
+    bool HasStringRef() const override { return true; }
+    const wxString* GetStringRef( LIBEVAL::CONTEXT* aCtx ) override;
 };
 
 
@@ -138,6 +169,9 @@ public:
     }
 
     LIBEVAL::VALUE* GetValue( LIBEVAL::CONTEXT* aCtx ) override;
+
+    bool HasStringRef() const override { return true; }
+    const wxString* GetStringRef( LIBEVAL::CONTEXT* aCtx ) override;
 };
 
 
@@ -151,6 +185,9 @@ public:
     }
 
     LIBEVAL::VALUE* GetValue( LIBEVAL::CONTEXT* aCtx ) override;
+
+    bool HasStringRef() const override { return true; }
+    const wxString* GetStringRef( LIBEVAL::CONTEXT* aCtx ) override;
 };
 
 
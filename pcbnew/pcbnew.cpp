@@ -64,6 +64,7 @@
 #include "invoke_pcb_dialog.h"
 #include <wildcards_and_files_ext.h>
 #include "pcbnew_jobs_handler.h"
+#include <kicad_clipboard.h>
 
 #include <wx/crt.h>
 
@@ -495,6 +496,11 @@ bool IFACE::loadGlobalLibTable()
 
 void IFACE::OnKifaceEnd()
 {
+    // Free the board kept by the job handler while the project and the settings are alive
+    m_jobHandler.reset();
+
+    CLIPBOARD_IO::ClearSnapshot();
+
     end_common();
 }
 
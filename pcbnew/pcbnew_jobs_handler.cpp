@@ -18,14 +18,23 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <gal/opengl/kiglew.h>    // Must be included first
+
+#include <deque>
+#include <fstream>
+#include <set>
 #include <wx/dir.h>
 #include "pcbnew_jobs_handler.h"
 #include <board_commit.h>
 #include <board_design_settings.h>
+#include <build_version.h>
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
 #include <drc/drc_item.h>
 #include <drc/drc_report.h>
 #include <drawing_sheet/ds_data_model.h>
 #include <drawing_sheet/ds_proxy_view_item.h>
+#include <jobs/job_export_cache.h>
 #include <jobs/job_fp_export_svg.h>
 #include <jobs/job_fp_upgrade.h>
 #include <jobs/job_export_pcb_ipc2581.h>
@@ -37,8 +46,12 @@
 #include <jobs/job_export_pcb_pos.h>
 #include <jobs/job_export_pcb_svg.h>
 #include <jobs/job_export_pcb_3d.h>
+#include <jobs/job_pcb_benchmark.h>
 #include <jobs/job_pcb_drc.h>
+#include <jobs/job_pcb_render.h>
 #include <cli/exit_codes.h>
+#include <core/profile.h>
+#include <core/thread_pool.h>
 #include <exporters/place_file_exporter.h>
 #include <exporters/step/exporter_step.h>
 #include <plotters/plotter_dxf.h>
@@ -51,9 +64,12 @@
 #include <gendrill_Excellon_writer.h>
 #include <gendrill_gerber_writer.h>
 #include <kiface_base.h>
+#include <locale_io.h>
 #include <macros.h>
+#include <memory_accounting.h>
 #include <pad.h>
 #include <pcb_marker.h>
+#include <perf_trace.h>
 #include <project/project_file.h>
 #include <exporters/export_svg.h>
 #include <kiface_ids.h>
@@ -63,12 +79,29 @@
 #include <pcbplot.h>
 #include <pgm_base.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/pcb_io_mgr.h>
+#include <project_pcb.h>
 #include <reporter.h>
 #include <string_utf8_map.h>
 #include <wildcards_and_files_ext.h>
 #include <export_vrml.h>
+#include <3d_rendering/raytracing/render_3d_raytrace.h>
+#include <3d_rendering/track_ball.h>
+#include <settings/settings_manager.h>
+#include <wx/image.h>
+#include <wx/utils.h>
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
+#include <zone.h>
+#include <zone_filler.h>
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
 
 #include "pcbnew_scripting_helpers.h"
 
@@ -92,6 +125,10 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
     Register( "fpsvg",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportFpSvg, this, std::placeholders::_1 ) );
     Register( "drc", std::bind( &PCBNEW_JOBS_HANDLER::JobExportDrc, this, std::placeholders::_1 ) );
+    Register( "render",
+              std::bind( &PCBNEW_JOBS_HANDLER::JobRender, this, std::placeholders::_1 ) );
+    Register( "benchmark",
+              std::bind( &PCBNEW_JOBS_HANDLER::JobBenchmark, this, std::placeholders::_1 ) );
     Register( "ipc2581",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportIpc2581, this, std::placeholders::_1 ) );
 }
@@ -107,7 +144,7 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aStepJob->m_filename, true );
+    BOARD* brd = getBoard( aStepJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
@@ -211,6 +248,519 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
 }
 
 
+int PCBNEW_JOBS_HANDLER::JobRender( JOB* aJob )
+{
+    JOB_PCB_RENDER* aRenderJob = dynamic_cast<JOB_PCB_RENDER*>( aJob );
+
+    if( aRenderJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
+
+    BOARD* brd = getBoard( aRenderJob->m_filename );
+    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
+    brd->SynchronizeProperties();
+
+    wxFileName outputFn = aRenderJob->m_outputFile;
+
+    if( aRenderJob->m_outputFile.IsEmpty() )
+    {
+        outputFn = brd->GetFileName();
+        outputFn.SetExt( FILEEXT::PngFileExtension );
+        outputFn = outputFn.GetFullName();
+    }
+
+    wxBitmapType bitmapType = wxBITMAP_TYPE_PNG;
+    wxString     ext = outputFn.GetExt().Lower();
+
+    if( ext == FILEEXT::JpegFileExtension || ext == wxS( "jpeg" ) )
+    {
+        bitmapType = wxBITMAP_TYPE_JPEG;
+    }
+    else if( ext != FILEEXT::PngFileExtension )
+    {
+        m_reporter->Report( _( "Output file must have a png or jpg extension\n" ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_ARGS;
+    }
+
+    EDA_3D_VIEWER_SETTINGS* cfg =
+            Pgm().GetSettingsManager().GetAppSettings<EDA_3D_VIEWER_SETTINGS>();
+
+    // The render options are changed only for this job, the user settings are put back after
+    EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS userRender = cfg->m_Render;
+    wxString                                userPreset = cfg->m_CurrentPreset;
+
+    EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& render = cfg->m_Render;
+    render.engine = RENDER_ENGINE::RAYTRACING;
+
+    if( aRenderJob->m_quality != JOB_PCB_RENDER::QUALITY::USER )
+    {
+        bool high = aRenderJob->m_quality == JOB_PCB_RENDER::QUALITY::HIGH;
+
+        render.raytrace_shadows = true;
+        render.raytrace_anti_aliasing = high;
+        render.raytrace_backfloor = false;
+        render.raytrace_post_processing = high;
+        render.raytrace_procedural_textures = high;
+        render.raytrace_reflections = high;
+        render.raytrace_refractions = high;
+    }
+
+    BOARD_ADAPTER boardAdapter;
+    boardAdapter.SetBoard( brd );
+    boardAdapter.Set3dCacheManager( PROJECT_PCB::Get3DCacheManager( brd->GetProject() ) );
+    boardAdapter.m_Cfg = cfg;
+
+    if( !aRenderJob->m_preset.IsEmpty() )
+    {
+        LAYER_PRESET_3D* preset = cfg->FindPreset( aRenderJob->m_preset );
+
+        if( !preset )
+        {
+            m_reporter->Report( wxString::Format( _( "Layer preset '%s' not found\n" ),
+                                                  aRenderJob->m_preset ),
+                                RPT_SEVERITY_ERROR );
+
+            cfg->m_Render = userRender;
+            return CLI::EXIT_CODES::ERR_ARGS;
+        }
+
+        cfg->m_CurrentPreset = aRenderJob->m_preset;
+        boardAdapter.SetVisibleLayers( preset->layers );
+    }
+
+    boardAdapter.ReloadColorSettings();
+
+    TRACK_BALL         camera( 2 * RANGE_SCALE_3D );
+    RENDER_3D_RAYTRACE raytrace( nullptr, boardAdapter, camera );
+
+    raytrace.Reload( nullptr, m_reporter, false );
+
+    const wxSize         size( aRenderJob->m_width, aRenderJob->m_height );
+    std::vector<uint8_t> rgba;
+    int                  exitCode = CLI::EXIT_CODES::OK;
+
+    for( JOB_PCB_RENDER::SIDE side : aRenderJob->m_sides )
+    {
+        wxFileName sideFn = outputFn;
+        wxString   sideName;
+
+        camera.SetProjection( aRenderJob->m_perspective ? PROJECTION_TYPE::PERSPECTIVE
+                                                         : PROJECTION_TYPE::ORTHO );
+        camera.SetCurWindowSize( size );
+        camera.Reset();
+
+        // The same rotations as the view commands of the 3D viewer
+        switch( side )
+        {
+        case JOB_PCB_RENDER::SIDE::TOP:
+            sideName = wxS( "top" );
+            break;
+
+        case JOB_PCB_RENDER::SIDE::BOTTOM:
+            sideName = wxS( "bottom" );
+            camera.RotateY( glm::radians( 179.999f ) );
+            break;
+
+        case JOB_PCB_RENDER::SIDE::LEFT:
+            sideName = wxS( "left" );
+            camera.RotateZ( glm::radians( 90.0f ) );
+            camera.RotateX( glm::radians( -90.0f ) );
+            break;
+
+        case JOB_PCB_RENDER::SIDE::RIGHT:
+            sideName = wxS( "right" );
+            camera.RotateZ( glm::radians( -90.0f ) );
+            camera.RotateX( glm::radians( -90.0f ) );
+            break;
+
+        case JOB_PCB_RENDER::SIDE::FRONT:
+            sideName = wxS( "front" );
+            camera.RotateX( glm::radians( -90.0f ) );
+            break;
+
+        case JOB_PCB_RENDER::SIDE::BACK:
+            sideName = wxS( "back" );
+            camera.RotateX( glm::radians( -90.0f ) );
+            camera.RotateZ( glm::radians( 179.999f ) );
+            break;
+        }
+
+        camera.RotateX( glm::radians( (float) aRenderJob->m_rotX ) );
+        camera.RotateY( glm::radians( (float) aRenderJob->m_rotY ) );
+        camera.RotateZ( glm::radians( (float) aRenderJob->m_rotZ ) );
+        camera.Zoom( (float) aRenderJob->m_zoom );
+
+        if( aRenderJob->m_sides.size() > 1 )
+            sideFn.SetName( sideFn.GetName() + wxS( "-" ) + sideName );
+
+        if( aJob->IsCli() )
+        {
+            m_reporter->Report( wxString::Format( _( "Rendering %s\n" ), sideFn.GetFullName() ),
+                                RPT_SEVERITY_INFO );
+        }
+
+        int64_t startTime = GetRunningMicroSecs();
+
+        raytrace.RenderOffscreen( size, rgba, nullptr, m_reporter );
+
+        wxImage image( size.x, size.y, false );
+        unsigned char* rgb = image.GetData();
+
+        for( size_t ii = 0; ii < (size_t) size.x * size.y; ++ii )
+        {
+            rgb[ii * 3 + 0] = rgba[ii * 4 + 0];
+            rgb[ii * 3 + 1] = rgba[ii * 4 + 1];
+            rgb[ii * 3 + 2] = rgba[ii * 4 + 2];
+        }
+
+        if( !image.SaveFile( sideFn.GetFullPath(), bitmapType ) )
+        {
+            m_reporter->Report( wxString::Format( _( "Failed to write %s\n" ),
+                                                  sideFn.GetFullPath() ),
+                                RPT_SEVERITY_ERROR );
+            exitCode = CLI::EXIT_CODES::ERR_UNKNOWN;
+            break;
+        }
+
+        if( aJob->IsCli() )
+        {
+            double elapsed = (double) ( GetRunningMicroSecs() - startTime ) / 1e6;
+
+            m_reporter->Report( wxString::Format( _( "Rendered in %.3f s\n" ), elapsed ),
+                                RPT_SEVERITY_INFO );
+        }
+    }
+
+    cfg->m_Render = userRender;
+    cfg->m_CurrentPreset = userPreset;
+
+    return exitCode;
+}
+
+
+/**
+ * @return the CPU time used by all the threads of the process, in milliseconds.
+ */
+static double processCpuTime()
+{
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user;
+
+    if( !GetProcessTimes( GetCurrentProcess(), &creation, &exitTime, &kernel, &user ) )
+        return 0.0;
+
+    auto toMs =
+            []( const FILETIME& aTime )
+            {
+                ULARGE_INTEGER value;
+                value.LowPart = aTime.dwLowDateTime;
+                value.HighPart = aTime.dwHighDateTime;
+
+                return value.QuadPart / 10000.0;    // 100 ns units
+            };
+
+    return toMs( kernel ) + toMs( user );
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return 0.0;
+
+    return ( usage.ru_utime.tv_sec + usage.ru_stime.tv_sec ) * 1000.0
+           + ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) / 1000.0;
+#endif
+}
+
+
+/**
+ * @return the largest resident memory of the process since it started, in bytes.
+ */
+static size_t processPeakRss()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+        return counters.PeakWorkingSetSize;
+
+    return 0;
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return 0;
+
+#ifdef __APPLE__
+    return static_cast<size_t>( usage.ru_maxrss );          // bytes
+#else
+    return static_cast<size_t>( usage.ru_maxrss ) * 1024;   // kilobytes
+#endif
+#endif
+}
+
+
+int PCBNEW_JOBS_HANDLER::JobBenchmark( JOB* aJob )
+{
+    JOB_PCB_BENCHMARK* benchmarkJob = dynamic_cast<JOB_PCB_BENCHMARK*>( aJob );
+
+    if( benchmarkJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    wxFileName boardFn( benchmarkJob->m_filename );
+    boardFn.MakeAbsolute();
+
+    if( !boardFn.FileExists() )
+    {
+        m_reporter->Report( wxString::Format( _( "Board file '%s' does not exist\n" ),
+                                              boardFn.GetFullPath() ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    wxString reportFile = benchmarkJob->m_outputFile;
+
+    if( reportFile.IsEmpty() )
+    {
+        wxFileName fn = boardFn;
+        fn.SetName( fn.GetName() + wxS( "-benchmark" ) );
+        fn.SetExt( FILEEXT::JsonFileExtension );
+
+        reportFile = fn.GetFullName();
+    }
+
+    // The stages write their files, as the other jobs do, so that the time spent formatting
+    // and writing them is measured too
+    bool       removeOutputDir = benchmarkJob->m_outputDir.IsEmpty();
+    wxFileName outputDir;
+
+    if( removeOutputDir )
+    {
+        outputDir.AssignDir( wxFileName::GetTempDir() );
+        outputDir.AppendDir( wxString::Format( wxS( "kicad_benchmark_%lu" ), wxGetProcessId() ) );
+    }
+    else
+    {
+        outputDir.AssignDir( benchmarkJob->m_outputDir );
+    }
+
+    if( !outputDir.DirExists() && !outputDir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to create output directory %s\n" ),
+                                              outputDir.GetPath() ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    // The pool threads and the calling thread, which runs the serial parts
+    size_t threads = GetKiCadThreadPool().get_thread_count() + 1;
+    int    exitCode = CLI::EXIT_CODES::SUCCESS;
+    BOARD* brd = nullptr;
+
+    nlohmann::ordered_json report;
+    report["board"] = TO_UTF8( boardFn.GetFullPath() );
+    report["version"] = TO_UTF8( GetBuildVersion() );
+    report["threads"] = threads;
+    report["iterations"] = nlohmann::ordered_json::array();
+
+    auto runStage =
+            [&]( nlohmann::ordered_json& aStages, const char* aName,
+                 const std::function<int()>& aStage ) -> bool
+            {
+                m_reporter->Report( wxString::Format( _( "Running %s\n" ), aName ),
+                                    RPT_SEVERITY_INFO );
+
+                SCOPED_TRACE_ZONE traceZone( "Benchmark stage", wxString::FromUTF8( aName ) );
+                double            cpuStart = processCpuTime();
+                PROF_TIMER        timer;
+                int               result = aStage();
+                double            wall = timer.msecs();
+                double            cpu = processCpuTime() - cpuStart;
+
+                // The share of the threads kept busy by the stage, the main thread included
+                double utilization = wall > 0.0 ? cpu / ( wall * threads ) : 0.0;
+
+                aStages.push_back( { { "name", aName },
+                                     { "wall_ms", wall },
+                                     { "cpu_ms", cpu },
+                                     { "thread_utilization", utilization },
+                                     { "peak_rss_bytes", processPeakRss() },
+                                     { "exit_code", result } } );
+
+                m_reporter->Report( wxString::Format( _( "%s: %.1f ms wall, %.1f ms CPU\n" ),
+                                                      aName, wall, cpu ),
+                                    RPT_SEVERITY_INFO );
+
+                // Keep the first failure, but go on with the other stages
+                if( result != CLI::EXIT_CODES::SUCCESS && exitCode == CLI::EXIT_CODES::SUCCESS )
+                    exitCode = result;
+
+                return result == CLI::EXIT_CODES::SUCCESS;
+            };
+
+    for( int ii = 0; ii < benchmarkJob->m_iterations; ++ii )
+    {
+        nlohmann::ordered_json stages = nlohmann::ordered_json::array();
+        PROF_TIMER             iterationTimer;
+        double                 iterationCpuStart = processCpuTime();
+
+        // Drop the board cached by the previous jobs, so that it is parsed again.  Loading a
+        // board also builds its connectivity, which the next stage then rebuilds alone.
+        m_board.reset();
+
+        bool loaded = runStage( stages, "load",
+                [&]() -> int
+                {
+                    try
+                    {
+                        brd = getBoard( benchmarkJob->m_filename );
+                    }
+                    catch( const IO_ERROR& ioe )
+                    {
+                        m_reporter->Report( ioe.What() + wxS( "\n" ), RPT_SEVERITY_ERROR );
+                        brd = nullptr;
+                    }
+
+                    if( !brd )
+                        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+
+                    return CLI::EXIT_CODES::SUCCESS;
+                } );
+
+        if( loaded )
+        {
+            runStage( stages, "connectivity",
+                    [&]() -> int
+                    {
+                        brd->BuildConnectivity();
+                        return CLI::EXIT_CODES::SUCCESS;
+                    } );
+
+            runStage( stages, "ratsnest",
+                    [&]() -> int
+                    {
+                        std::shared_ptr<CONNECTIVITY_DATA> connectivity = brd->GetConnectivity();
+                        std::shared_ptr<CN_CONNECTIVITY_ALGO> algo =
+                                connectivity->GetConnectivityAlgo();
+
+                        // Building the connectivity computed the ratsnest already, so compute
+                        // it again for every net
+                        for( NETINFO_ITEM* net : brd->GetNetInfo() )
+                            algo->MarkNetAsDirty( net->GetNetCode() );
+
+                        connectivity->RecalculateRatsnest();
+                        return CLI::EXIT_CODES::SUCCESS;
+                    } );
+
+            runStage( stages, "zone_fill",
+                    [&]() -> int
+                    {
+                        std::vector<ZONE*> zones( brd->Zones().begin(), brd->Zones().end() );
+                        ZONE_FILLER        filler( brd, nullptr );
+
+                        if( !filler.Fill( zones ) )
+                            return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+                        // As the zone filler tool does once the fills are committed
+                        brd->BuildConnectivity();
+                        return CLI::EXIT_CODES::SUCCESS;
+                    } );
+
+            runStage( stages, "drc",
+                    [&]() -> int
+                    {
+                        JOB_PCB_DRC drcJob( false );
+                        drcJob.m_filename = benchmarkJob->m_filename;
+                        drcJob.m_format = JOB_PCB_DRC::OUTPUT_FORMAT::JSON;
+
+                        wxFileName fn( outputDir.GetPath(), boardFn.GetName(),
+                                       FILEEXT::JsonFileExtension );
+
+                        return doDrc( &drcJob, brd, fn.GetFullPath() );
+                    } );
+
+            runStage( stages, "gerber",
+                    [&]() -> int
+                    {
+                        JOB_EXPORT_PCB_GERBERS gerbersJob( false );
+                        gerbersJob.m_filename = benchmarkJob->m_filename;
+                        gerbersJob.m_outputFile = outputDir.GetPath();
+
+                        return JobExportGerbers( &gerbersJob );
+                    } );
+
+            if( !benchmarkJob->m_skipStep )
+            {
+                runStage( stages, "step",
+                        [&]() -> int
+                        {
+                            JOB_EXPORT_PCB_3D stepJob( false );
+                            stepJob.m_filename = benchmarkJob->m_filename;
+                            stepJob.m_format = JOB_EXPORT_PCB_3D::FORMAT::STEP;
+                            stepJob.m_overwrite = true;
+                            stepJob.m_outputFile = wxFileName( outputDir.GetPath(),
+                                                               boardFn.GetName(),
+                                                               FILEEXT::StepFileExtension )
+                                                           .GetFullPath();
+
+                            return JobExportStep( &stepJob );
+                        } );
+            }
+
+            runStage( stages, "save",
+                    [&]() -> int
+                    {
+                        wxFileName fn( outputDir.GetPath(), boardFn.GetName(),
+                                       FILEEXT::KiCadPcbFileExtension );
+                        LOCALE_IO  dummy;
+
+                        try
+                        {
+                            PCB_IO_MGR::Save( PCB_IO_MGR::KICAD_SEXP, fn.GetFullPath(), brd );
+                        }
+                        catch( const IO_ERROR& ioe )
+                        {
+                            m_reporter->Report( ioe.What() + wxS( "\n" ), RPT_SEVERITY_ERROR );
+                            return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+                        }
+
+                        return CLI::EXIT_CODES::SUCCESS;
+                    } );
+        }
+
+        report["iterations"].push_back( { { "wall_ms", iterationTimer.msecs() },
+                                          { "cpu_ms", processCpuTime() - iterationCpuStart },
+                                          { "stages", std::move( stages ) } } );
+
+        if( !loaded )
+            break;
+    }
+
+    if( removeOutputDir )
+        wxFileName::Rmdir( outputDir.GetPath(), wxPATH_RMDIR_RECURSIVE );
+
+    std::ofstream file( reportFile.fn_str() );
+
+    if( file.is_open() )
+        file << report.dump( 4 ) << std::endl;
+
+    if( !file.is_open() || file.fail() )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to save the benchmark report to %s\n" ),
+                                              reportFile ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    m_reporter->Report( wxString::Format( _( "Saved the benchmark report to %s\n" ), reportFile ),
+                        RPT_SEVERITY_INFO );
+
+    return exitCode;
+}
+
+
 int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
 {
     JOB_EXPORT_PCB_SVG* aSvgJob = dynamic_cast<JOB_EXPORT_PCB_SVG*>( aJob );
@@ -232,7 +782,7 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aSvgJob->m_filename, true );
+    BOARD* brd = getBoard( aSvgJob->m_filename );
     loadOverrideDrawingSheet( brd, aSvgJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -259,7 +809,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDxf( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aDxfJob->m_filename, true );
+    BOARD* brd = getBoard( aDxfJob->m_filename );
     loadOverrideDrawingSheet( brd, aDxfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -338,7 +888,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPdf( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aPdfJob->m_filename, true );
+    BOARD* brd = getBoard( aPdfJob->m_filename );
     loadOverrideDrawingSheet( brd, aPdfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -431,7 +981,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aGerberJob->m_filename, true );
+    BOARD* brd = getBoard( aGerberJob->m_filename );
     loadOverrideDrawingSheet( brd, aGerberJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
@@ -463,9 +1013,19 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             aGerberJob->m_layersIncludeOnAll = plotOnAllLayersSelection;
     }
 
+    PCB_PLOT_PARAMS plotOpts;
+
+    if( aGerberJob->m_useBoardPlotParams )
+        plotOpts = boardPlotOptions;
+    else
+        populateGerberPlotOptionsFromJob( plotOpts, aGerberJob );
+
+    std::vector<PLOT_LAYER_FILE> plotFiles;
+
     for( LSEQ seq = LSET( aGerberJob->m_printMaskLayer ).UIOrder(); seq; ++seq )
     {
-        LSEQ plotSequence;
+        PLOT_LAYER_FILE plotFile;
+        LSEQ            plotSequence;
 
         // Base layer always gets plotted first.
         plotSequence.push_back( *seq );
@@ -481,17 +1041,9 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
         }
 
         // Pick the basename from the board file
-        wxFileName      fn( brd->GetFileName() );
-        PCB_LAYER_ID    layer = *seq;
-        wxString        layerName = brd->GetLayerName( layer );
-        wxString        sheetName;
-        wxString        sheetPath;
-        PCB_PLOT_PARAMS plotOpts;
-
-        if( aGerberJob->m_useBoardPlotParams )
-            plotOpts = boardPlotOptions;
-        else
-            populateGerberPlotOptionsFromJob( plotOpts, aGerberJob );
+        wxFileName   fn( brd->GetFileName() );
+        PCB_LAYER_ID layer = *seq;
+        wxString     layerName = brd->GetLayerName( layer );
 
         if( plotOpts.GetUseGerberProtelExtensions() )
             fileExt = GetGerberProtelExtension( layer );
@@ -507,32 +1059,35 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             layerName = aJob->GetVarOverrides().at( wxT( "LAYER" ) );
 
         if( aJob->GetVarOverrides().count( wxT( "SHEETNAME" ) ) > 0 )
-            sheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
+            plotFile.m_SheetName = aJob->GetVarOverrides().at( wxT( "SHEETNAME" ) );
 
         if( aJob->GetVarOverrides().count( wxT( "SHEETPATH" ) ) > 0 )
-            sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
+            plotFile.m_SheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
 
-        // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer,
-                                                                    layerName, fn.GetFullPath(),
-                                                                    sheetName, sheetPath );
+        plotFile.m_Layer = layer;
+        plotFile.m_PlotSequence = plotSequence;
+        plotFile.m_LayerName = layerName;
+        plotFile.m_FullFileName = fn.GetFullPath();
+        plotFiles.push_back( plotFile );
+    }
 
-        if( plotter )
+    PlotLayerFiles( brd, plotOpts, plotFiles );
+
+    for( const PLOT_LAYER_FILE& plotFile : plotFiles )
+    {
+        if( plotFile.m_Plotted )
         {
-            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
+            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ),
+                                                  plotFile.m_FullFileName ),
                                 RPT_SEVERITY_ACTION );
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
         }
         else
         {
             m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
-                                                  fn.GetFullPath() ),
+                                                  plotFile.m_FullFileName ),
                                 RPT_SEVERITY_ERROR );
             exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
         }
-
-        delete plotter;
     }
 
     wxFileName fn( aGerberJob->m_filename );
@@ -580,7 +1135,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerber( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aGerberJob->m_filename, true );
+    BOARD* brd = getBoard( aGerberJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
@@ -654,7 +1209,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aDrillJob->m_filename, true );
+    BOARD* brd = getBoard( aDrillJob->m_filename );
 
     // ensure output dir exists
     wxFileName fn( aDrillJob->m_outputDir + wxT( "/" ) );
@@ -675,6 +1230,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
         drillWriter = std::make_unique<GERBER_WRITER>( brd );
     }
 
+    drillWriter->SetHoleOrderOptimization( aDrillJob->m_optimizeHoleOrder );
+
     VECTOR2I offset;
 
     if( aDrillJob->m_drillOrigin == JOB_EXPORT_PCB_DRILL::DRILL_ORIGIN::ABS )
@@ -776,7 +1333,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPos( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aPosJob->m_filename, true );
+    BOARD* brd = getBoard( aPosJob->m_filename );
 
     if( aPosJob->m_outputFile.IsEmpty() )
     {
@@ -888,6 +1445,7 @@ int PCBNEW_JOBS_HANDLER::JobExportFpUpgrade( JOB* aJob )
         try
         {
             fpLib.Load();
+            fpLib.ParseAll();
         }
         catch( ... )
         {
@@ -959,6 +1517,7 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
     try
     {
         fpLib.Load();
+        fpLib.ParseAll();
     }
     catch( ... )
     {
@@ -971,9 +1530,53 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
         wxFileName::Mkdir( svgJob->m_outputDirectory );
     }
 
-    int exitCode = CLI::EXIT_CODES::OK;
+    // The text variables and the color theme are shared by all the footprints: set them up
+    // once, so that the plots running in parallel only read them
+    GetDefaultProject()->ApplyTextVars( svgJob->GetVarOverrides() );
+    Pgm().GetSettingsManager().GetColorSettings( svgJob->m_colorTheme );
+
+    JOB_EXPORT_CACHE cache( svgJob->m_outputDirectory );
+    wxString         options = wxString::Format( wxS( "%s %d" ), svgJob->m_colorTheme,
+                                                 svgJob->m_blackAndWhite ? 1 : 0 );
+
+    for( PCB_LAYER_ID layer : svgJob->m_printMaskLayer )
+        options << wxS( " " ) << (int) layer;
 
-    // Just plot all the symbols we can
+    for( const auto& [name, value] : svgJob->GetVarOverrides() )
+        options << wxS( " " ) << name << wxS( "=" ) << value;
+
+    if( svgJob->m_skipUnchanged )
+        cache.Load();
+
+    struct PENDING_PLOT
+    {
+        std::unique_ptr<BOARD> m_board;
+        wxString               m_name;
+        std::string            m_hash;
+        std::future<bool>      m_result;
+    };
+
+    // The boards are created and deleted on this thread, as they are registered in the
+    // shared project.  Only the plots run in parallel, with a few of them pending at a time.
+    LOCALE_IO                toggle;
+    thread_pool&             tp = GetKiCadThreadPool();
+    std::deque<PENDING_PLOT> pending;
+
+    auto finishPlot =
+            [&]()
+            {
+                PENDING_PLOT& plot = pending.front();
+
+                if( plot.m_result.get() )
+                    cache.SetHash( plot.m_name, plot.m_hash );
+                else
+                    m_reporter->Report( _( "Error creating svg file" ) + wxS( "\n" ),
+                                        RPT_SEVERITY_ERROR );
+
+                pending.pop_front();
+            };
+
+    // Just plot all the footprints we can
     FP_CACHE_FOOTPRINT_MAP& footprintMap = fpLib.GetFootprints();
 
     bool singleFpPlotted = false;
@@ -994,9 +1597,64 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
             }
         }
 
-        exitCode = doFpExportSvg( svgJob, fp );
-        if( exitCode != CLI::EXIT_CODES::OK )
-            break;
+        wxString   fpName = fp->GetFPID().GetLibItemName().wx_str();
+        wxFileName outputFile;
+        outputFile.SetPath( svgJob->m_outputDirectory );
+        outputFile.SetName( fpName );
+        outputFile.SetExt( FILEEXT::SVGFileExtension );
+
+        std::string hash;
+
+        if( svgJob->m_skipUnchanged )
+        {
+            pcb_io.Format( fp );
+            hash = JOB_EXPORT_CACHE::Hash( options, pcb_io.GetStringOutput( true ) );
+
+            if( cache.IsUpToDate( fpName, hash ) && outputFile.FileExists() )
+                continue;
+        }
+
+        std::unique_ptr<BOARD> brd( createFootprintBoard( fp ) );
+
+        if( !brd )
+            continue;
+
+        m_reporter->Report( wxString::Format( _( "Plotting footprint '%s' to '%s'\n" ),
+                                              fpName, outputFile.GetFullPath() ),
+                            RPT_SEVERITY_ACTION );
+
+        PCB_PLOT_SVG_OPTIONS svgPlotOptions;
+        svgPlotOptions.m_blackAndWhite = svgJob->m_blackAndWhite;
+        svgPlotOptions.m_colorTheme = svgJob->m_colorTheme;
+        svgPlotOptions.m_outputFile = outputFile.GetFullPath();
+        svgPlotOptions.m_mirror = false;
+        svgPlotOptions.m_pageSizeMode = 2; // board bounding box
+        svgPlotOptions.m_printMaskLayer = svgJob->m_printMaskLayer;
+        svgPlotOptions.m_plotFrame = false;
+
+        // Fill the bounding box caches before the plot thread reads them
+        brd->ComputeBoundingBox();
+
+        BOARD* board = brd.get();
+
+        pending.push_back( { std::move( brd ), fpName, hash,
+                             tp.submit(
+                                     [board, svgPlotOptions]() -> bool
+                                     {
+                                         return EXPORT_SVG::Plot( board, svgPlotOptions );
+                                     } ) } );
+
+        if( pending.size() > 2 * tp.get_thread_count() )
+            finishPlot();
+    }
+
+    while( !pending.empty() )
+        finishPlot();
+
+    if( svgJob->m_skipUnchanged && !cache.Save() )
+    {
+        m_reporter->Report( _( "Unable to save the footprint hashes" ) + wxS( "\n" ),
+                            RPT_SEVERITY_WARNING );
     }
 
     if( !svgJob->m_footprint.IsEmpty() && !singleFpPlotted )
@@ -1009,19 +1667,18 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
 }
 
 
-int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint )
+BOARD* PCBNEW_JOBS_HANDLER::createFootprintBoard( const FOOTPRINT* aFootprint )
 {
     // the hack for now is we create fake boards containing the footprint and plot the board
     // until we refactor better plot api later
     std::unique_ptr<BOARD> brd;
     brd.reset( CreateEmptyBoard() );
-    brd->GetProject()->ApplyTextVars( aSvgJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
     FOOTPRINT* fp = dynamic_cast<FOOTPRINT*>( aFootprint->Clone() );
 
     if( fp == nullptr )
-        return CLI::EXIT_CODES::ERR_UNKNOWN;
+        return nullptr;
 
     fp->SetLink( niluuid );
     fp->SetFlags( IS_NEW );
@@ -1038,31 +1695,7 @@ int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPR
 
     brd->Add( fp, ADD_MODE::INSERT, true );
 
-    wxFileName outputFile;
-    outputFile.SetPath( aSvgJob->m_outputDirectory );
-    outputFile.SetName( aFootprint->GetFPID().GetLibItemName().wx_str() );
-    outputFile.SetExt( FILEEXT::SVGFileExtension );
-
-    m_reporter->Report( wxString::Format( _( "Plotting footprint '%s' to '%s'\n" ),
-                                          aFootprint->GetFPID().GetLibItemName().wx_str(),
-                                          outputFile.GetFullPath() ),
-                        RPT_SEVERITY_ACTION );
-
-
-    PCB_PLOT_SVG_OPTIONS svgPlotOptions;
-    svgPlotOptions.m_blackAndWhite = aSvgJob->m_blackAndWhite;
-    svgPlotOptions.m_colorTheme = aSvgJob->m_colorTheme;
-    svgPlotOptions.m_outputFile = outputFile.GetFullPath();
-    svgPlotOptions.m_mirror = false;
-    svgPlotOptions.m_pageSizeMode = 2; // board bounding box
-    svgPlotOptions.m_printMaskLayer = aSvgJob->m_printMaskLayer;
-    svgPlotOptions.m_plotFrame = false;
-
-    if( !EXPORT_SVG::Plot( brd.get(), svgPlotOptions ) )
-        m_reporter->Report( _( "Error creating svg file" ) + wxS( "\n" ), RPT_SEVERITY_ERROR );
-
-
-    return CLI::EXIT_CODES::OK;
+    return brd.release();
 }
 
 
@@ -1073,12 +1706,13 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
     if( drcJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
+    if( drcJob->m_filenames.size() > 1 )
+        return doBatchDrc( drcJob );
+
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( drcJob->m_filename, true );
-    brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
-    brd->SynchronizeProperties();
+    BOARD* brd = getBoard( drcJob->m_filename );
 
     if( drcJob->m_outputFile.IsEmpty() )
     {
@@ -1093,8 +1727,99 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
         drcJob->m_outputFile = fn.GetFullName();
     }
 
+    return doDrc( drcJob, brd, drcJob->m_outputFile );
+}
+
+
+int PCBNEW_JOBS_HANDLER::doBatchDrc( JOB_PCB_DRC* aDrcJob )
+{
+    // The kifaces, the global library tables and the settings are loaded once for all the
+    // boards.  Boards are checked one after the other: loading one sets up global state (the
+    // drawing sheet and the layer names), and each DRC run already uses all the worker threads.
+    std::set<wxString> reports;
+    int                exitCode = CLI::EXIT_CODES::SUCCESS;
+
+    auto addResult =
+            [&]( int aResult )
+            {
+                // Keep the first hard error, which outranks rule violations
+                if( aResult != CLI::EXIT_CODES::SUCCESS
+                        && ( exitCode == CLI::EXIT_CODES::SUCCESS
+                             || exitCode == CLI::EXIT_CODES::ERR_RC_VIOLATIONS ) )
+                {
+                    exitCode = aResult;
+                }
+            };
+
+    if( !aDrcJob->m_outputFile.IsEmpty() && !wxFileName::DirExists( aDrcJob->m_outputFile )
+            && !wxFileName::Mkdir( aDrcJob->m_outputFile, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to create output directory %s\n" ),
+                                              aDrcJob->m_outputFile ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    // Loading the boards replaces the active project, which the shared board belongs to
+    m_board.reset();
+
+    for( wxString filename : aDrcJob->m_filenames )
+    {
+        wxFileName reportFn( aDrcJob->m_outputFile, wxFileName( filename ).GetName() );
+
+        if( aDrcJob->m_format == JOB_PCB_DRC::OUTPUT_FORMAT::JSON )
+            reportFn.SetExt( FILEEXT::JsonFileExtension );
+        else
+            reportFn.SetExt( FILEEXT::ReportFileExtension );
+
+        if( !reports.insert( reportFn.GetFullPath() ).second )
+        {
+            m_reporter->Report( wxString::Format( _( "Skipping %s: another board has the same "
+                                                     "report file %s\n" ),
+                                                  filename, reportFn.GetFullPath() ),
+                                RPT_SEVERITY_ERROR );
+            addResult( CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT );
+            continue;
+        }
+
+        m_reporter->Report( wxString::Format( _( "Loading board %s\n" ), filename ),
+                            RPT_SEVERITY_INFO );
+
+        std::unique_ptr<BOARD> brd;
+
+        try
+        {
+            brd.reset( LoadBoard( filename, true ) );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            m_reporter->Report( ioe.What() + wxS( "\n" ), RPT_SEVERITY_ERROR );
+        }
+
+        if( !brd )
+        {
+            m_reporter->Report( wxString::Format( _( "Failed to load board %s\n" ), filename ),
+                                RPT_SEVERITY_ERROR );
+            addResult( CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE );
+            continue;
+        }
+
+        // The board is freed before the next one is loaded, as loading a board replaces the
+        // active project
+        addResult( doDrc( aDrcJob, brd.get(), reportFn.GetFullPath() ) );
+    }
+
+    return exitCode;
+}
+
+
+int PCBNEW_JOBS_HANDLER::doDrc( JOB_PCB_DRC* aDrcJob, BOARD* aBoard, const wxString& aOutputFile )
+{
+    aBoard->GetProject()->ApplyTextVars( aDrcJob->GetVarOverrides() );
+    aBoard->SynchronizeProperties();
+
     EDA_UNITS units;
-    switch( drcJob->m_units )
+    switch( aDrcJob->m_units )
     {
     case JOB_PCB_DRC::UNITS::INCHES:
         units = EDA_UNITS::INCHES;
@@ -1107,25 +1832,26 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
         units = EDA_UNITS::MILLIMETRES; break;
     }
 
-    std::shared_ptr<DRC_ENGINE> drcEngine = brd->GetDesignSettings().m_DRCEngine;
+    std::shared_ptr<DRC_ENGINE> drcEngine = aBoard->GetDesignSettings().m_DRCEngine;
     std::unique_ptr<NETLIST>    netlist = std::make_unique<NETLIST>();
 
-    drcEngine->SetDrawingSheet( getDrawingSheetProxyView( brd ) );
+    std::unique_ptr<DS_PROXY_VIEW_ITEM> drawingSheet( getDrawingSheetProxyView( aBoard ) );
+    drcEngine->SetDrawingSheet( drawingSheet.get() );
 
     // BOARD_COMMIT uses TOOL_MANAGER to grab the board internally so we must give it one
-    TOOL_MANAGER* toolManager = new TOOL_MANAGER;
-    toolManager->SetEnvironment( brd, nullptr, nullptr, Kiface().KifaceSettings(), nullptr );
+    std::unique_ptr<TOOL_MANAGER> toolManager = std::make_unique<TOOL_MANAGER>();
+    toolManager->SetEnvironment( aBoard, nullptr, nullptr, Kiface().KifaceSettings(), nullptr );
 
-    BOARD_COMMIT commit( toolManager );
+    BOARD_COMMIT commit( toolManager.get() );
 
     m_reporter->Report( _( "Running DRC...\n" ), RPT_SEVERITY_INFO );
 
-    if( drcJob->m_parity )
+    if( aDrcJob->m_parity )
     {
         typedef bool (*NETLIST_FN_PTR)( const wxString&, std::string& );
 
         KIFACE*        eeschema = m_kiway->KiFACE( KIWAY::FACE_SCH );
-        wxFileName     schematicPath( drcJob->m_filename );
+        wxFileName     schematicPath( aBoard->GetFileName() );
         NETLIST_FN_PTR netlister = (NETLIST_FN_PTR) eeschema->IfaceOrAddress( KIFACE_NETLIST_SCHEMATIC );
         std::string    netlist_str;
 
@@ -1167,30 +1893,33 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
                 commit.Add( marker );
             } );
 
-    brd->RecordDRCExclusions();
-    brd->DeleteMARKERs( true, true );
-    drcEngine->RunTests( units, drcJob->m_reportAllTrackErrors, drcJob->m_parity );
+    aBoard->RecordDRCExclusions();
+    aBoard->DeleteMARKERs( true, true );
+    drcEngine->SetProfiling( aDrcJob->m_profile );
+    drcEngine->RunTests( units, aDrcJob->m_reportAllTrackErrors, aDrcJob->m_parity );
+    drcEngine->SetProfiling( false );
+    drcEngine->SetDrawingSheet( nullptr );
     drcEngine->ClearViolationHandler();
 
     commit.Push( _( "DRC" ), SKIP_UNDO | SKIP_SET_DIRTY );
 
     // now "resolve" the drc exclusions again because its the only way to set exclusion status on
     // a marker
-    for( PCB_MARKER* marker : brd->ResolveDRCExclusions( false ) )
-        brd->Add( marker );
+    for( PCB_MARKER* marker : aBoard->ResolveDRCExclusions( false ) )
+        aBoard->Add( marker );
 
     std::shared_ptr<DRC_ITEMS_PROVIDER> markersProvider = std::make_shared<DRC_ITEMS_PROVIDER>(
-            brd, MARKER_BASE::MARKER_DRC, MARKER_BASE::MARKER_DRAWING_SHEET );
+            aBoard, MARKER_BASE::MARKER_DRC, MARKER_BASE::MARKER_DRAWING_SHEET );
 
     std::shared_ptr<DRC_ITEMS_PROVIDER> ratsnestProvider =
-            std::make_shared<DRC_ITEMS_PROVIDER>( brd, MARKER_BASE::MARKER_RATSNEST );
+            std::make_shared<DRC_ITEMS_PROVIDER>( aBoard, MARKER_BASE::MARKER_RATSNEST );
 
     std::shared_ptr<DRC_ITEMS_PROVIDER> fpWarningsProvider =
-            std::make_shared<DRC_ITEMS_PROVIDER>( brd, MARKER_BASE::MARKER_PARITY );
+            std::make_shared<DRC_ITEMS_PROVIDER>( aBoard, MARKER_BASE::MARKER_PARITY );
 
-    markersProvider->SetSeverities( drcJob->m_severity );
-    ratsnestProvider->SetSeverities( drcJob->m_severity );
-    fpWarningsProvider->SetSeverities( drcJob->m_severity );
+    markersProvider->SetSeverities( aDrcJob->m_severity );
+    ratsnestProvider->SetSeverities( aDrcJob->m_severity );
+    fpWarningsProvider->SetSeverities( aDrcJob->m_severity );
 
     m_reporter->Report( wxString::Format( _( "Found %d violations\n" ),
                                           markersProvider->GetCount() ),
@@ -1199,32 +1928,41 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
                                           ratsnestProvider->GetCount() ),
                         RPT_SEVERITY_INFO );
 
-    if( drcJob->m_parity )
+    if( aDrcJob->m_parity )
     {
         m_reporter->Report( wxString::Format( _( "Found %d schematic parity issues\n" ),
                                               fpWarningsProvider->GetCount() ),
                             RPT_SEVERITY_INFO );
     }
 
-    DRC_REPORT reportWriter( brd, units, markersProvider, ratsnestProvider, fpWarningsProvider );
+    DRC_REPORT reportWriter( aBoard, units, markersProvider, ratsnestProvider, fpWarningsProvider );
+
+    if( aDrcJob->m_profile )
+        reportWriter.SetProviderProfiles( drcEngine->GetTestProviders() );
 
     bool wroteReport = false;
-    if( drcJob->m_format == JOB_PCB_DRC::OUTPUT_FORMAT::JSON )
-        wroteReport = reportWriter.WriteJsonReport( drcJob->m_outputFile );
+    if( aDrcJob->m_format == JOB_PCB_DRC::OUTPUT_FORMAT::JSON )
+        wroteReport = reportWriter.WriteJsonReport( aOutputFile );
     else
-        wroteReport = reportWriter.WriteTextReport( drcJob->m_outputFile );
+        wroteReport = reportWriter.WriteTextReport( aOutputFile );
 
     if( !wroteReport )
     {
-        m_reporter->Report( wxString::Format( _( "Unable to save DRC report to %s\n" ), drcJob->m_outputFile ),
+        m_reporter->Report( wxString::Format( _( "Unable to save DRC report to %s\n" ), aOutputFile ),
                             RPT_SEVERITY_INFO );
         return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
     }
 
-    m_reporter->Report( wxString::Format( _( "Saved DRC Report to %s\n" ), drcJob->m_outputFile ),
+    m_reporter->Report( wxString::Format( _( "Saved DRC Report to %s\n" ), aOutputFile ),
                         RPT_SEVERITY_INFO );
 
-    if( drcJob->m_exitCodeViolations )
+    if( aDrcJob->m_profile )
+    {
+        m_reporter->Report( _( "Estimated memory usage:\n" ) + MEMORY_ACCOUNT::Collect().Format(),
+                            RPT_SEVERITY_INFO );
+    }
+
+    if( aDrcJob->m_exitCodeViolations )
     {
         if( markersProvider->GetCount() > 0 || ratsnestProvider->GetCount() > 0
             || fpWarningsProvider->GetCount() > 0 )
@@ -1247,7 +1985,7 @@ int PCBNEW_JOBS_HANDLER::JobExportIpc2581( JOB* aJob )
     if( job->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( job->m_filename, true );
+    BOARD* brd = getBoard( job->m_filename );
 
     if( job->m_outputFile.IsEmpty() )
     {
@@ -1339,6 +2077,48 @@ DS_PROXY_VIEW_ITEM* PCBNEW_JOBS_HANDLER::getDrawingSheetProxyView( BOARD* aBrd )
 }
 
 
+BOARD* PCBNEW_JOBS_HANDLER::getBoard( wxString& aFileName )
+{
+    wxFileName fn( aFileName );
+    fn.MakeAbsolute();
+
+    wxDateTime modified = fn.FileExists() ? fn.GetModificationTime() : wxDateTime();
+
+    if( m_board && fn.GetFullPath() == m_boardFileName && modified.IsValid()
+            && modified == m_boardModified )
+    {
+        // Undo the variable overrides and the drawing sheet of the previous jobs
+        PROJECT* project = m_board->GetProject();
+
+        project->GetTextVars() = m_boardTextVars;
+
+        BASE_SCREEN::m_DrawingSheetFileName =
+                project->GetProjectFile().m_BoardDrawingSheetFile;
+        wxString filename = DS_DATA_MODEL::ResolvePath( BASE_SCREEN::m_DrawingSheetFileName,
+                                                        project->GetProjectPath() );
+
+        if( !DS_DATA_MODEL::GetTheInstance().LoadDrawingSheet( filename ) )
+            m_reporter->Report( _( "Error loading drawing sheet." ) + wxS( "\n" ),
+                                RPT_SEVERITY_ERROR );
+
+        return m_board.get();
+    }
+
+    // Loading a board replaces the active project, which the previous board belongs to
+    m_board.reset();
+    m_board.reset( LoadBoard( aFileName, true ) );
+
+    if( m_board )
+    {
+        m_boardFileName = fn.GetFullPath();
+        m_boardModified = modified;
+        m_boardTextVars = m_board->GetProject()->GetTextVars();
+    }
+
+    return m_board.get();
+}
+
+
 void PCBNEW_JOBS_HANDLER::loadOverrideDrawingSheet( BOARD* aBrd, const wxString& aSheetPath )
 {
     // dont bother attempting to load a empty path, if there was one
@@ -21,15 +21,18 @@
 #ifndef PCBNEW_JOBS_HANDLER_H
 #define PCBNEW_JOBS_HANDLER_H
 
+#include <memory>
+#include <wx/datetime.h>
 #include <jobs/job_dispatcher.h>
 #include <pcb_plot_params.h>
+#include <board.h>
 
 class KIWAY;
-class BOARD;
 class DS_PROXY_VIEW_ITEM;
 class FOOTPRINT;
 class JOB_EXPORT_PCB_GERBER;
 class JOB_FP_EXPORT_SVG;
+class JOB_PCB_DRC;
 
 class PCBNEW_JOBS_HANDLER : public JOB_DISPATCHER
 {
@@ -47,14 +50,46 @@ public:
     int JobExportFpSvg( JOB* aJob );
     int JobExportDrc( JOB* aJob );
     int JobExportIpc2581( JOB* aJob );
+    int JobRender( JOB* aJob );
+    int JobBenchmark( JOB* aJob );
 
 private:
     void populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS&       aPlotOpts,
                                            JOB_EXPORT_PCB_GERBER* aJob );
-    int  doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint );
+
+    /**
+     * Create a board holding a copy of \a aFootprint, to plot the footprint.
+     */
+    BOARD* createFootprintBoard( const FOOTPRINT* aFootprint );
+
     void loadOverrideDrawingSheet( BOARD* brd, const wxString& aSheetPath );
 
+    /**
+     * Return the board of \a aFileName, loading it unless it is the board of the previous job
+     * and its file did not change since.
+     *
+     * The jobs of a kicad-cli batch then share the loaded board and its connectivity.  The
+     * project variables and the drawing sheet changed by the previous jobs are restored.
+     */
+    BOARD* getBoard( wxString& aFileName );
+
+    /**
+     * Run the DRC of \a aDrcJob on \a aBoard and write its report to \a aOutputFile.
+     */
+    int  doDrc( JOB_PCB_DRC* aDrcJob, BOARD* aBoard, const wxString& aOutputFile );
+
+    /**
+     * Check each of the boards of \a aDrcJob in turn, writing their reports to the output
+     * directory.  Returns the first hard error, or else whether any board had violations.
+     */
+    int  doBatchDrc( JOB_PCB_DRC* aDrcJob );
+
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( BOARD* aBrd );
+
+    std::unique_ptr<BOARD>       m_board;          ///< The board shared by the jobs
+    wxString                     m_boardFileName;
+    wxDateTime                   m_boardModified;
+    std::map<wxString, wxString> m_boardTextVars;  ///< The project variables, before overrides
 };
 
 #endif
\ No newline at end of file
@@ -159,6 +159,33 @@ void PlotBoardLayers( BOARD* aBoard, PLOTTER* aPlotter, const LSEQ& aLayerSequen
  */
 void PlotInteractiveLayer( BOARD* aBoard, PLOTTER* aPlotter, const PCB_PLOT_PARAMS& aPlotOpt );
 
+/**
+ * A board layer plotted in its own file by PlotLayerFiles().
+ */
+struct PLOT_LAYER_FILE
+{
+    PCB_LAYER_ID m_Layer = UNDEFINED_LAYER;
+    LSEQ         m_PlotSequence;      ///< The layer followed by the "plot on all layers" layers
+    wxString     m_LayerName;
+    wxString     m_FullFileName;
+    wxString     m_SheetName;
+    wxString     m_SheetPath;
+    bool         m_Plotted = false;   ///< Set when the file was created
+};
+
+/**
+ * Plot each layer of \a aFiles in its own file.
+ *
+ * The files are independent, so the Gerber files are plotted in parallel, each with its own
+ * plotter.  The other formats are plotted one after the other.
+ *
+ * @param aBoard is the board to plot.
+ * @param aPlotOpts are the plot options, common to all the files.
+ * @param aFiles are the files to plot; their m_Plotted member is set on return.
+ */
+void PlotLayerFiles( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts,
+                     std::vector<PLOT_LAYER_FILE>& aFiles );
+
 /**
  * Plot one copper or technical layer.
  *
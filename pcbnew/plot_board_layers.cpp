@@ -21,6 +21,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+
 #include <wx/log.h>
 #include <eda_item.h>
 #include <layer_ids.h>
@@ -44,6 +50,9 @@
 #include <pcb_painter.h>
 #include <gbr_metadata.h>
 #include <advanced_config.h>
+#include <locale_io.h>
+#include <project.h>
+#include <core/thread_pool.h>
 
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
@@ -376,13 +385,8 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             // Now offset the pad size by margin + width_adj
             VECTOR2I padPlotsSize = pad->GetSize() + margin * 2 + VECTOR2I( width_adj, width_adj );
 
-            // Store these parameters that can be modified to plot inflated/deflated pads shape
-            PAD_SHAPE padShape = pad->GetShape();
-            VECTOR2I  padSize = pad->GetSize();
-            VECTOR2I  padDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
-            // CornerRadius and CornerRadiusRatio can be modified
-            // the radius is built from the ratio, so saving/restoring the ratio is enough
-            double    padCornerRadiusRatio = pad->GetRoundRectRadiusRatio();
+            VECTOR2I padSize = pad->GetSize();
+            VECTOR2I padDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
 
             // Don't draw a 0 sized pad.
             // Note: a custom pad can have its pad anchor with size = 0
@@ -392,34 +396,54 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 continue;
             }
 
+            // The board pads are shared by the layers plotted in parallel, so a pad plotted
+            // inflated/deflated is plotted through a copy
+            std::optional<PAD> resized;
+
+            auto resizedPad =
+                    [&]() -> PAD*
+                    {
+                        resized.emplace( *pad );
+                        resized->SetParentGroup( nullptr );
+                        resized->SetSize( padPlotsSize );
+                        return &resized.value();
+                    };
+
             switch( pad->GetShape() )
             {
             case PAD_SHAPE::CIRCLE:
             case PAD_SHAPE::OVAL:
-                pad->SetSize( padPlotsSize );
+            {
+                PAD* plotPad = padPlotsSize != padSize ? resizedPad() : pad;
 
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == DRILL_MARKS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
+                    ( plotPad->GetSize() == pad->GetDrillSize() ) &&
                     ( pad->GetAttribute() == PAD_ATTRIB::NPTH ) )
                 {
                     break;
                 }
 
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                itemplotter.PlotPad( plotPad, color, padPlotMode );
                 break;
+            }
 
             case PAD_SHAPE::RECTANGLE:
-                pad->SetSize( padPlotsSize );
+            {
+                PAD* plotPad = pad;
+
+                if( padPlotsSize != padSize || mask_clearance > 0 )
+                    plotPad = resizedPad();
 
                 if( mask_clearance > 0 )
                 {
-                    pad->SetShape( PAD_SHAPE::ROUNDRECT );
-                    pad->SetRoundRectCornerRadius( mask_clearance );
+                    plotPad->SetShape( PAD_SHAPE::ROUNDRECT );
+                    plotPad->SetRoundRectCornerRadius( mask_clearance );
                 }
 
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                itemplotter.PlotPad( plotPad, color, padPlotMode );
                 break;
+            }
 
             case PAD_SHAPE::TRAPEZOID:
                 // inflate/deflate a trapezoid is a bit complex.
@@ -471,11 +495,15 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 // rounding is stored as a percent, but we have to update this ratio
                 // to force recalculation of other values after size changing (we do not
                 // really change the rounding percent value)
-                double radius_ratio = pad->GetRoundRectRadiusRatio();
-                pad->SetSize( padPlotsSize );
-                pad->SetRoundRectRadiusRatio( radius_ratio );
+                PAD* plotPad = pad;
+
+                if( padPlotsSize != padSize )
+                {
+                    plotPad = resizedPad();
+                    plotPad->SetRoundRectRadiusRatio( pad->GetRoundRectRadiusRatio() );
+                }
 
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                itemplotter.PlotPad( plotPad, color, padPlotMode );
                 break;
             }
 
@@ -483,8 +511,8 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 if( mask_clearance == 0 )
                 {
                     // the size can be slightly inflated by width_adj (PS/PDF only)
-                    pad->SetSize( padPlotsSize );
-                    itemplotter.PlotPad( pad, color, padPlotMode );
+                    itemplotter.PlotPad( padPlotsSize != padSize ? resizedPad() : pad, color,
+                                         padPlotMode );
                 }
                 else
                 {
@@ -553,12 +581,6 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 break;
             }
             }
-
-            // Restore the pad parameters modified by the plot code
-            pad->SetSize( padSize );
-            pad->SetDelta( padDelta );
-            pad->SetShape( padShape );
-            pad->SetRoundRectRadiusRatio( padCornerRadiusRatio );
         }
 
         aPlotter->EndBlock( nullptr );
@@ -738,7 +760,7 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         outlines.RemoveAllContours();
         aBoard->ConvertBrdLayerToPolygonalContours( layer, outlines );
 
-        outlines.Simplify( SHAPE_POLY_SET::PM_FAST );
+        outlines.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
 
         // Plot outlines
         std::vector<VECTOR2I> cornerList;
@@ -819,11 +841,13 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
  * 5 - plot remaining polygons from (2) (witout any Gerber attributes)
  */
 
-void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
-                          const PCB_PLOT_PARAMS& aPlotOpt, int aMinThickness )
+/**
+ * Build the merged solder mask shapes of \a aLayer, see PlotSolderMaskLayer().
+ */
+static SHAPE_POLY_SET buildSolderMask( BOARD* aBoard, PCB_LAYER_ID aLayer,
+                                       const BRDITEMS_PLOTTER& aItemPlotter, int aMinThickness )
 {
     int             maxError = aBoard->GetDesignSettings().m_MaxError;
-    PCB_LAYER_ID    layer = aLayerMask[B_Mask] ? B_Mask : F_Mask;
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
 
@@ -834,9 +858,6 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     // than or equal comparison in the shape separation (boolean add)
     int inflate = aMinThickness / 2 - 1;
 
-    BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
-    itemplotter.SetLayerSet( aLayerMask );
-
     // Build polygons for each pad shape.  The size of the shape on solder mask should be size
     // of pad + clearance around the pad, where clearance = solder mask clearance + extra margin.
     // Extra margin is half the min width for solder mask, which is used to merge too-close shapes
@@ -852,16 +873,16 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     auto plotFPTextItem =
             [&]( const PCB_TEXT& aText )
             {
-                if( !itemplotter.GetPlotFPText() )
+                if( !aItemPlotter.GetPlotFPText() )
                     return;
 
-                if( !aText.IsVisible() && !itemplotter.GetPlotInvisibleText()  )
+                if( !aText.IsVisible() && !aItemPlotter.GetPlotInvisibleText()  )
                     return;
 
-                if( aText.GetText() == wxT( "${REFERENCE}" ) && !itemplotter.GetPlotReference() )
+                if( aText.GetText() == wxT( "${REFERENCE}" ) && !aItemPlotter.GetPlotReference() )
                     return;
 
-                if( aText.GetText() == wxT( "${VALUE}" ) && !itemplotter.GetPlotValue() )
+                if( aText.GetText() == wxT( "${VALUE}" ) && !aItemPlotter.GetPlotValue() )
                     return;
 
                 // add shapes with their exact mask layer size in initialPolys
@@ -879,25 +900,25 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         for( const FOOTPRINT* footprint : aBoard->Footprints() )
         {
             // add shapes with their exact mask layer size in initialPolys
-            footprint->TransformPadsToPolySet( initialPolys, layer, 0, maxError, ERROR_OUTSIDE );
+            footprint->TransformPadsToPolySet( initialPolys, aLayer, 0, maxError, ERROR_OUTSIDE );
             // add shapes inflated by aMinThickness/2 in areas
-            footprint->TransformPadsToPolySet( areas, layer, inflate, maxError, ERROR_OUTSIDE );
+            footprint->TransformPadsToPolySet( areas, aLayer, inflate, maxError, ERROR_OUTSIDE );
 
             for( const PCB_FIELD* field : footprint->Fields() )
             {
-                if( field->IsReference() && !itemplotter.GetPlotReference() )
+                if( field->IsReference() && !aItemPlotter.GetPlotReference() )
                     continue;
 
-                if( field->IsValue() && !itemplotter.GetPlotValue() )
+                if( field->IsValue() && !aItemPlotter.GetPlotValue() )
                     continue;
 
-                if( field->IsOnLayer( layer ) )
+                if( field->IsOnLayer( aLayer ) )
                     plotFPTextItem( static_cast<const PCB_TEXT&>( *field ) );
             }
 
             for( const BOARD_ITEM* item : footprint->GraphicalItems() )
             {
-                if( item->IsOnLayer( layer ) )
+                if( item->IsOnLayer( aLayer ) )
                 {
                     if( item->Type() == PCB_TEXT_T )
                     {
@@ -906,11 +927,11 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                     else
                     {
                         // add shapes with their exact mask layer size in initialPolys
-                        item->TransformShapeToPolygon( initialPolys, layer, 0, maxError,
+                        item->TransformShapeToPolygon( initialPolys, aLayer, 0, maxError,
                                                        ERROR_OUTSIDE );
 
                         // add shapes inflated by aMinThickness/2 in areas
-                        item->TransformShapeToPolygon( areas, layer, inflate, maxError,
+                        item->TransformShapeToPolygon( areas, aLayer, inflate, maxError,
                                                        ERROR_OUTSIDE );
                     }
                 }
@@ -926,17 +947,18 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             const PCB_VIA* via = static_cast<const PCB_VIA*>( track );
 
             // Note: IsOnLayer() checks relevant mask layers of untented vias
-            if( !via->IsOnLayer( layer ) )
+            if( !via->IsOnLayer( aLayer ) )
                 continue;
 
             int clearance = via->GetSolderMaskExpansion();
 
             // add shapes with their exact mask layer size in initialPolys
-            via->TransformShapeToPolygon( initialPolys, layer, clearance, maxError, ERROR_OUTSIDE );
+            via->TransformShapeToPolygon( initialPolys, aLayer, clearance, maxError,
+                                          ERROR_OUTSIDE );
 
             // add shapes inflated by aMinThickness/2 in areas
             clearance += inflate;
-            via->TransformShapeToPolygon( areas, layer, clearance, maxError, ERROR_OUTSIDE );
+            via->TransformShapeToPolygon( areas, aLayer, clearance, maxError, ERROR_OUTSIDE );
         }
 
         // Add filled zone areas.
@@ -948,7 +970,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
         for( const BOARD_ITEM* item : aBoard->Drawings() )
         {
-            if( item->IsOnLayer( layer ) )
+            if( item->IsOnLayer( aLayer ) )
             {
                 if( item->Type() == PCB_TEXT_T )
                 {
@@ -963,11 +985,11 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 else
                 {
                     // add shapes with their exact mask layer size in initialPolys
-                    item->TransformShapeToPolygon( initialPolys, layer, 0, maxError,
+                    item->TransformShapeToPolygon( initialPolys, aLayer, 0, maxError,
                                                    ERROR_OUTSIDE );
 
                     // add shapes inflated by aMinThickness/2 in areas
-                    item->TransformShapeToPolygon( areas, layer, inflate, maxError,
+                    item->TransformShapeToPolygon( areas, aLayer, inflate, maxError,
                                                    ERROR_OUTSIDE );
                 }
             }
@@ -978,7 +1000,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             if( zone->GetIsRuleArea() )
                 continue;
 
-            if( !zone->IsOnLayer( layer ) )
+            if( !zone->IsOnLayer( aLayer ) )
                 continue;
 
             // add shapes inflated by aMinThickness/2 in areas
@@ -996,6 +1018,102 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     areas.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
     areas.Deflate( inflate, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
 
+    // Combine the current areas to initial areas. This is mandatory because inflate/deflate
+    // transform is not perfect, and we want the initial areas perfectly kept
+    areas.BooleanAdd( initialPolys, SHAPE_POLY_SET::PM_FAST );
+    areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+    return areas;
+}
+
+
+/**
+ * What the merged solder mask of a layer depends on.  The board time stamp is incremented by
+ * the changes made in the editor, and the text variables can be overridden by each job.
+ */
+struct SOLDER_MASK_KEY
+{
+    KIID                         m_board;
+    int                          m_timeStamp;
+    PCB_LAYER_ID                 m_layer;
+    int                          m_minThickness;
+    int                          m_maxError;
+    bool                         m_plotFPText;
+    bool                         m_plotInvisibleText;
+    bool                         m_plotReference;
+    bool                         m_plotValue;
+    std::map<wxString, wxString> m_textVars;
+
+    bool operator==( const SOLDER_MASK_KEY& aOther ) const
+    {
+        return m_board == aOther.m_board && m_timeStamp == aOther.m_timeStamp
+               && m_layer == aOther.m_layer && m_minThickness == aOther.m_minThickness
+               && m_maxError == aOther.m_maxError && m_plotFPText == aOther.m_plotFPText
+               && m_plotInvisibleText == aOther.m_plotInvisibleText
+               && m_plotReference == aOther.m_plotReference && m_plotValue == aOther.m_plotValue
+               && m_textVars == aOther.m_textVars;
+    }
+};
+
+
+/**
+ * Merging the solder mask is the slowest part of plotting a board, and the same layer is
+ * often plotted to several formats in a row (a kicad-cli batch, or the plot dialog), so the last
+ * few results are kept.  The cache is shared by the threads plotting the layers in parallel.
+ */
+static std::mutex                                              s_solderMaskCacheMutex;
+static std::deque<std::pair<SOLDER_MASK_KEY, SHAPE_POLY_SET>> s_solderMaskCache;
+
+
+void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
+                          const PCB_PLOT_PARAMS& aPlotOpt, int aMinThickness )
+{
+    // Only a few masks are kept: the front and back ones of a board or two
+    const size_t MAX_CACHED_MASKS = 4;
+
+    PCB_LAYER_ID     layer = aLayerMask[B_Mask] ? B_Mask : F_Mask;
+    BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
+    itemplotter.SetLayerSet( aLayerMask );
+
+    SOLDER_MASK_KEY key{ aBoard->m_Uuid,
+                         aBoard->GetTimeStamp(),
+                         layer,
+                         aMinThickness,
+                         aBoard->GetDesignSettings().m_MaxError,
+                         itemplotter.GetPlotFPText(),
+                         itemplotter.GetPlotInvisibleText(),
+                         itemplotter.GetPlotReference(),
+                         itemplotter.GetPlotValue(),
+                         aBoard->GetProject() ? aBoard->GetProject()->GetTextVars()
+                                              : std::map<wxString, wxString>() };
+
+    std::optional<SHAPE_POLY_SET> areas;
+
+    {
+        std::lock_guard<std::mutex> lock( s_solderMaskCacheMutex );
+
+        for( const auto& [cachedKey, cachedAreas] : s_solderMaskCache )
+        {
+            if( cachedKey == key )
+            {
+                areas = cachedAreas;
+                break;
+            }
+        }
+    }
+
+    if( !areas )
+    {
+        areas = buildSolderMask( aBoard, layer, itemplotter, aMinThickness );
+
+        std::lock_guard<std::mutex> lock( s_solderMaskCacheMutex );
+
+        s_solderMaskCache.emplace_front( key, *areas );
+
+        if( s_solderMaskCache.size() > MAX_CACHED_MASKS )
+            s_solderMaskCache.pop_back();
+    }
+
     // To avoid a lot of code, use a ZONE to handle and plot polygons, because our polygons look
     // exactly like filled areas in zones.
     // Note, also this code is not optimized: it creates a lot of copy/duplicate data.
@@ -1005,12 +1123,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     zone.SetMinThickness( 0 );      // trace polygons only
     zone.SetLayer( layer );
 
-    // Combine the current areas to initial areas. This is mandatory because inflate/deflate
-    // transform is not perfect, and we want the initial areas perfectly kept
-    areas.BooleanAdd( initialPolys, SHAPE_POLY_SET::PM_FAST );
-    areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-
-    itemplotter.PlotZone( &zone, layer, areas );
+    itemplotter.PlotZone( &zone, layer, *areas );
 }
 
 
@@ -1268,3 +1381,71 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, const PCB_PLOT_PARAMS *aPlotOpts, int aL
     delete plotter;
     return nullptr;
 }
+
+
+void PlotLayerFiles( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts,
+                     std::vector<PLOT_LAYER_FILE>& aFiles )
+{
+    auto plotFile =
+            [&]( PLOT_LAYER_FILE& aFile ) -> size_t
+            {
+                PLOTTER* plotter = StartPlotBoard( aBoard, &aPlotOpts, aFile.m_Layer,
+                                                   aFile.m_LayerName, aFile.m_FullFileName,
+                                                   aFile.m_SheetName, aFile.m_SheetPath );
+
+                if( !plotter )
+                    return 0;
+
+                PlotBoardLayers( aBoard, plotter, aFile.m_PlotSequence, aPlotOpts );
+
+                if( aPlotOpts.GetFormat() == PLOT_FORMAT::PDF )
+                    PlotInteractiveLayer( aBoard, plotter, aPlotOpts );
+
+                plotter->EndPlot();
+                delete plotter->RenderSettings();
+                delete plotter;
+
+                aFile.m_Plotted = true;
+                return 1;
+            };
+
+    // The locale is process-wide: it is switched once for all the plot threads
+    LOCALE_IO toggle;
+
+    if( aPlotOpts.GetFormat() != PLOT_FORMAT::GERBER || aFiles.size() < 2 )
+    {
+        for( PLOT_LAYER_FILE& file : aFiles )
+            plotFile( file );
+
+        return;
+    }
+
+    // Fill the bounding box caches now, so they are only read by the plot threads
+    aBoard->ComputeBoundingBox();
+
+    for( ZONE* zone : aBoard->Zones() )
+        zone->CacheBoundingBox();
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( ZONE* zone : footprint->Zones() )
+            zone->CacheBoundingBox();
+    }
+
+    thread_pool&                     tp = GetKiCadThreadPool();
+    std::vector<std::future<size_t>> returns;
+
+    returns.reserve( aFiles.size() );
+
+    for( PLOT_LAYER_FILE& file : aFiles )
+    {
+        returns.emplace_back( tp.submit(
+                [&plotFile, &file]() -> size_t
+                {
+                    return plotFile( file );
+                } ) );
+    }
+
+    for( const std::future<size_t>& ret : returns )
+        ret.wait();
+}
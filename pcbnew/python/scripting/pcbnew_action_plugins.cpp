@@ -274,6 +274,9 @@ void PCB_EDIT_FRAME::RunActionPlugin( ACTION_PLUGIN* aActionPlugin )
     BOARD*  currentPcb  = GetBoard();
     bool    fromEmpty   = false;
 
+    // The plugin changes the board directly, so the text saved for its items can't be trusted
+    currentPcb->ClearSavedText();
+
     // Append tracks:
     for( PCB_TRACK* item : currentPcb->Tracks() )
     {
@@ -0,0 +1,174 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <stdexcept>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <geometry/shape_poly_set.h>
+
+#include "pcbnew_bulk_access.h"
+
+
+namespace BULK_ACCESS
+{
+
+static TRACK_TYPE trackType( const PCB_TRACK* aTrack )
+{
+    switch( aTrack->Type() )
+    {
+    case PCB_ARC_T: return TRACK_ARC;
+    case PCB_VIA_T: return TRACK_VIA;
+    default:        return TRACK_SEGMENT;
+    }
+}
+
+
+std::vector<int> GetTrackData( const BOARD* aBoard )
+{
+    std::vector<int> data;
+    data.reserve( aBoard->Tracks().size() * TRACK_FIELDS );
+
+    for( const PCB_TRACK* track : aBoard->Tracks() )
+    {
+        TRACK_TYPE type = trackType( track );
+        VECTOR2I   start = track->GetStart();
+        VECTOR2I   end = track->GetEnd();
+        VECTOR2I   mid = ( start + end ) / 2;
+        int        layer = track->GetLayer();
+
+        if( type == TRACK_ARC )
+        {
+            mid = static_cast<const PCB_ARC*>( track )->GetMid();
+        }
+        else if( type == TRACK_VIA )
+        {
+            start = end = mid = track->GetPosition();
+            layer = static_cast<const PCB_VIA*>( track )->TopLayer();
+        }
+
+        data.insert( data.end(), { type, start.x, start.y, mid.x, mid.y, end.x, end.y,
+                                   track->GetWidth(), layer, track->GetNetCode() } );
+    }
+
+    return data;
+}
+
+
+void SetTrackData( BOARD* aBoard, const int* aData, size_t aCount )
+{
+    if( aCount != aBoard->Tracks().size() * TRACK_FIELDS )
+        throw std::invalid_argument( "the array does not have one row per track" );
+
+    // Check everything first so that a bad array leaves the board untouched
+    const int* row = aData;
+
+    for( const PCB_TRACK* track : aBoard->Tracks() )
+    {
+        if( row[0] != trackType( track ) )
+            throw std::invalid_argument( "the array does not match the types of the tracks" );
+
+        if( row[0] != TRACK_VIA && !IsCopperLayer( row[8] ) )
+            throw std::invalid_argument( "a track is not on a copper layer" );
+
+        row += TRACK_FIELDS;
+    }
+
+    row = aData;
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        if( row[0] == TRACK_VIA )
+        {
+            track->SetPosition( VECTOR2I( row[1], row[2] ) );
+        }
+        else
+        {
+            track->SetStart( VECTOR2I( row[1], row[2] ) );
+            track->SetEnd( VECTOR2I( row[5], row[6] ) );
+            track->SetLayer( ToLAYER_ID( row[8] ) );
+
+            if( row[0] == TRACK_ARC )
+                static_cast<PCB_ARC*>( track )->SetMid( VECTOR2I( row[3], row[4] ) );
+        }
+
+        track->SetWidth( row[7] );
+        track->SetNetCode( row[9], true );
+        row += TRACK_FIELDS;
+    }
+}
+
+
+std::vector<int> GetPadData( const BOARD* aBoard )
+{
+    std::vector<int> data;
+
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( const PAD* pad : footprint->Pads() )
+        {
+            VECTOR2I pos = pad->GetPosition();
+            data.insert( data.end(), { pos.x, pos.y, pad->GetNetCode() } );
+        }
+    }
+
+    return data;
+}
+
+
+std::vector<int> GetPolySetPoints( const SHAPE_POLY_SET& aPolySet )
+{
+    std::vector<int> data;
+    data.reserve( aPolySet.FullPointCount() * 2 );
+
+    for( int ii = 0; ii < aPolySet.OutlineCount(); ++ii )
+    {
+        for( const SHAPE_LINE_CHAIN& contour : aPolySet.CPolygon( ii ) )
+        {
+            for( const VECTOR2I& pt : contour.CPoints() )
+                data.insert( data.end(), { pt.x, pt.y } );
+        }
+    }
+
+    return data;
+}
+
+
+std::vector<int> GetPolySetContours( const SHAPE_POLY_SET& aPolySet )
+{
+    std::vector<int> data;
+
+    for( int ii = 0; ii < aPolySet.OutlineCount(); ++ii )
+    {
+        const SHAPE_POLY_SET::POLYGON& poly = aPolySet.CPolygon( ii );
+
+        for( size_t jj = 0; jj < poly.size(); ++jj )
+            data.insert( data.end(), { ii, (int) jj - 1, poly[jj].PointCount() } );
+    }
+
+    return data;
+}
+
+} // namespace BULK_ACCESS
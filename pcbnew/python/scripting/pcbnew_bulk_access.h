@@ -0,0 +1,95 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PCBNEW_BULK_ACCESS_H
+#define PCBNEW_BULK_ACCESS_H
+
+#include <cstddef>
+#include <vector>
+
+class BOARD;
+class SHAPE_POLY_SET;
+
+/**
+ * Flat integer arrays holding the geometry of many board items at once.
+ *
+ * The scripting bindings return them as buffers of C ints, which numpy reads with
+ * numpy.frombuffer() instead of one Python call per item and per property.
+ */
+namespace BULK_ACCESS
+{
+
+/// Values of the type column of the track arrays
+enum TRACK_TYPE
+{
+    TRACK_SEGMENT = 0,
+    TRACK_ARC = 1,
+    TRACK_VIA = 2
+};
+
+/// Columns of the track arrays: type, start x, start y, mid x, mid y, end x, end y, width,
+/// layer, net code
+constexpr size_t TRACK_FIELDS = 10;
+
+/// Columns of the pad arrays: position x, position y, net code
+constexpr size_t PAD_FIELDS = 3;
+
+/// Columns of the contour arrays: polygon index, hole index or -1 for the outline, point count
+constexpr size_t CONTOUR_FIELDS = 3;
+
+/**
+ * @return one row of #TRACK_FIELDS values per track, arc and via, in the order of
+ *         BOARD::Tracks().  The mid point of a straight segment is its middle; a via has its
+ *         start and end on its position, and its top layer.
+ */
+std::vector<int> GetTrackData( const BOARD* aBoard );
+
+/**
+ * Apply an array laid out as returned by GetTrackData() to the tracks of a board.
+ *
+ * The array must hold one row per track, with the same types, in the same order.  The layer
+ * column of the vias is ignored.  The connectivity is not rebuilt.
+ *
+ * @throw std::invalid_argument if the array does not match the tracks of the board.
+ */
+void SetTrackData( BOARD* aBoard, const int* aData, size_t aCount );
+
+/**
+ * @return one row of #PAD_FIELDS values per pad, footprint after footprint.
+ */
+std::vector<int> GetPadData( const BOARD* aBoard );
+
+/**
+ * @return the x, y coordinates of the points of all the contours of a polygon set, each
+ *         polygon giving its outline then its holes.
+ */
+std::vector<int> GetPolySetPoints( const SHAPE_POLY_SET& aPolySet );
+
+/**
+ * @return one row of #CONTOUR_FIELDS values per contour, in the order of GetPolySetPoints().
+ */
+std::vector<int> GetPolySetContours( const SHAPE_POLY_SET& aPolySet );
+
+} // namespace BULK_ACCESS
+
+#endif // PCBNEW_BULK_ACCESS_H
@@ -0,0 +1,135 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file bulk_access.i
+ * @brief Bulk access to the geometry of the board items, as buffers of C ints
+ *
+ * The arrays are copied once from the items, which are not stored contiguously, and are
+ * returned as memoryviews of format 'i'.  numpy wraps them without another copy:
+ *
+ *     tracks = numpy.frombuffer( board.GetTracksArray(), dtype=numpy.intc ).reshape( -1, 10 )
+ */
+
+%{
+#include <cstring>
+#include <stdexcept>
+#include <pcbnew_bulk_access.h>
+
+static PyObject* bulkArrayToBuffer( const std::vector<int>& aData )
+{
+    PyObject* bytes = PyByteArray_FromStringAndSize( (const char*) aData.data(),
+                                                     aData.size() * sizeof( int ) );
+
+    if( !bytes )
+        return nullptr;
+
+    PyObject* view = PyMemoryView_FromObject( bytes );
+    Py_DECREF( bytes );
+
+    if( !view )
+        return nullptr;
+
+    PyObject* ints = PyObject_CallMethod( view, "cast", "s", "i" );
+    Py_DECREF( view );
+    return ints;
+}
+%}
+
+%extend BOARD
+{
+    /**
+     * @return a buffer of BULK_ACCESS::TRACK_FIELDS ints per track, arc and via.
+     */
+    PyObject* GetTracksArray()
+    {
+        return bulkArrayToBuffer( BULK_ACCESS::GetTrackData( $self ) );
+    }
+
+    /**
+     * Update all the tracks at once from a buffer laid out as GetTracksArray().
+     *
+     * Run from an action plugin, the change is undone as a single step with the other changes
+     * of the plugin.  The connectivity must be rebuilt by the caller if net codes changed.
+     */
+    PyObject* SetTracksArray( PyObject* aBuffer )
+    {
+        Py_buffer view;
+
+        if( PyObject_GetBuffer( aBuffer, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT ) != 0 )
+            return nullptr;
+
+        size_t fmtLen = view.format ? std::strlen( view.format ) : 0;
+
+        if( view.itemsize != sizeof( int ) || fmtLen == 0
+                || !std::strchr( "il", view.format[fmtLen - 1] ) )
+        {
+            PyBuffer_Release( &view );
+            PyErr_SetString( PyExc_TypeError, "the buffer must hold C ints" );
+            return nullptr;
+        }
+
+        try
+        {
+            BULK_ACCESS::SetTrackData( $self, static_cast<const int*>( view.buf ),
+                                       view.len / sizeof( int ) );
+        }
+        catch( const std::exception& e )
+        {
+            PyBuffer_Release( &view );
+            PyErr_SetString( PyExc_ValueError, e.what() );
+            return nullptr;
+        }
+
+        PyBuffer_Release( &view );
+        Py_RETURN_NONE;
+    }
+
+    /**
+     * @return a buffer of BULK_ACCESS::PAD_FIELDS ints per pad.
+     */
+    PyObject* GetPadsArray()
+    {
+        return bulkArrayToBuffer( BULK_ACCESS::GetPadData( $self ) );
+    }
+}
+
+%extend SHAPE_POLY_SET
+{
+    /**
+     * @return a buffer of the x, y coordinates of the points of all the contours.
+     */
+    PyObject* GetPointsArray()
+    {
+        return bulkArrayToBuffer( BULK_ACCESS::GetPolySetPoints( *$self ) );
+    }
+
+    /**
+     * @return a buffer of BULK_ACCESS::CONTOUR_FIELDS ints per contour, in the order of the
+     *         points of GetPointsArray().
+     */
+    PyObject* GetContoursArray()
+    {
+        return bulkArrayToBuffer( BULK_ACCESS::GetPolySetContours( *$self ) );
+    }
+}
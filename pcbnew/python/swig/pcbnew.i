@@ -132,6 +132,7 @@ HANDLE_EXCEPTIONS(WriteDRCReport)
 
 %include board.i
 %include footprint.i
+%include bulk_access.i
 %include plugins.i
 %include units.i
 %include version.i
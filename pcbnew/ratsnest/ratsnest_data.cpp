@@ -35,12 +35,14 @@
 #endif
 
 #include <ratsnest/ratsnest_data.h>
+#include <advanced_config.h>
 #include <functional>
 using namespace std::placeholders;
 
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <unordered_map>
 
 #include <delaunator.hpp>
 
@@ -107,13 +109,14 @@ private:
 };
 
 
-void RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
+bool RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
 {
     disjoint_set dset( m_nodes.size() );
 
     m_rnEdges.clear();
 
-    int i = 0;
+    int    i = 0;
+    size_t unions = 0;
 
     for( const std::shared_ptr<CN_ANCHOR>& node : m_nodes )
         node->SetTag( i++ );
@@ -127,10 +130,14 @@ void RN_NET::kruskalMST( const std::vector<CN_EDGE> &aEdges )
 
         if( dset.unite( source->GetTag(), target->GetTag() ) )
         {
+            unions++;
+
             if( tmp.GetWeight() > 0 )
                 m_rnEdges.push_back( tmp );
         }
     }
+
+    return unions + 1 == m_nodes.size();
 }
 
 
@@ -139,20 +146,34 @@ class RN_NET::TRIANGULATOR_STATE
 private:
     std::multiset<std::shared_ptr<CN_ANCHOR>, CN_PTR_CMP> m_allNodes;
 
+    ///< Unique node positions of the last triangulation, in CN_PTR_CMP order
+    std::vector<VECTOR2I>            m_points;
+
+    ///< Edges of the last triangulation, as pairs of indices into m_points
+    std::vector<std::pair<int, int>> m_edges;
+
+    ///< Number of points added or removed by incremental updates since the last full rebuild
+    size_t                           m_drift = 0;
+
+    static bool pointLess( const VECTOR2I& a, const VECTOR2I& b )
+    {
+        return a.x < b.x || ( a.x == b.x && a.y < b.y );
+    }
 
     // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
     // have unique coordinates!
-    bool areNodesColinear( const std::vector<std::shared_ptr<CN_ANCHOR>>& aNodes ) const
+    static bool arePointsColinear( const std::vector<VECTOR2I>& aPoints,
+                                   const std::vector<int>& aSubset )
     {
-        if ( aNodes.size() <= 2 )
+        if ( aSubset.size() <= 2 )
             return true;
 
-        const VECTOR2I p0( aNodes[0]->Pos() );
-        const VECTOR2I v0( aNodes[1]->Pos() - p0 );
+        const VECTOR2I p0( aPoints[aSubset[0]] );
+        const VECTOR2I v0( aPoints[aSubset[1]] - p0 );
 
-        for( unsigned i = 2; i < aNodes.size(); i++ )
+        for( unsigned i = 2; i < aSubset.size(); i++ )
         {
-            const VECTOR2I v1 = aNodes[i]->Pos() - p0;
+            const VECTOR2I v1 = aPoints[aSubset[i]] - p0;
 
             if( v0.Cross( v1 ) != 0 )
                 return false;
@@ -161,6 +182,182 @@ private:
         return true;
     }
 
+    /**
+     * Append the edges of the Delaunay triangulation of the points in \a aSubset (which must be
+     * in ascending order) to \a aEdges.
+     */
+    static void triangulate( const std::vector<VECTOR2I>& aPoints, const std::vector<int>& aSubset,
+                             std::vector<std::pair<int, int>>& aEdges )
+    {
+        if( aSubset.size() < 2 )
+        {
+            return;
+        }
+        else if( arePointsColinear( aPoints, aSubset ) )
+        {
+            // special case: all nodes are on the same line - there's no
+            // triangulation for such set. In this case, we sort along any coordinate
+            // and chain the nodes together.
+            for( size_t i = 0; i < aSubset.size() - 1; i++ )
+                aEdges.emplace_back( aSubset[i], aSubset[i + 1] );
+        }
+        else
+        {
+            std::vector<double> node_pts;
+            node_pts.reserve( 2 * aSubset.size() );
+
+            for( int idx : aSubset )
+            {
+                node_pts.push_back( aPoints[idx].x );
+                node_pts.push_back( aPoints[idx].y );
+            }
+
+            delaunator::Delaunator delaunator( node_pts );
+            auto& triangles = delaunator.triangles;
+
+            for( size_t i = 0; i < triangles.size(); i += 3 )
+            {
+                aEdges.emplace_back( aSubset[triangles[i]],     aSubset[triangles[i + 1]] );
+                aEdges.emplace_back( aSubset[triangles[i + 1]], aSubset[triangles[i + 2]] );
+                aEdges.emplace_back( aSubset[triangles[i + 2]], aSubset[triangles[i]]     );
+            }
+        }
+    }
+
+    /**
+     * @return the index of the surviving point of the last triangulation closest to \a aPt, or
+     *         -1 if there is none.
+     */
+    int nearestSurvivor( const VECTOR2I& aPt, const std::vector<int>& aOldToNew ) const
+    {
+        SEG::ecoord bestDist_sq = VECTOR2I::ECOORD_MAX;
+        int         best = -1;
+
+        auto check =
+                [&]( int aIdx )
+                {
+                    SEG::ecoord distX_sq = SEG::Square( (SEG::ecoord) aPt.x - m_points[aIdx].x );
+
+                    // Like NearestBicoloredPair(), stop once the x distance alone is too far
+                    if( distX_sq > bestDist_sq )
+                        return false;
+
+                    SEG::ecoord dist_sq = ( m_points[aIdx] - aPt ).SquaredEuclideanNorm();
+
+                    if( aOldToNew[aIdx] >= 0 && dist_sq < bestDist_sq )
+                    {
+                        bestDist_sq = dist_sq;
+                        best = aIdx;
+                    }
+
+                    return true;
+                };
+
+        int start = std::lower_bound( m_points.begin(), m_points.end(), aPt, pointLess )
+                    - m_points.begin();
+
+        for( int ii = start; ii < (int) m_points.size() && check( ii ); ii++ )
+            ;
+
+        for( int ii = start - 1; ii >= 0 && check( ii ); ii-- )
+            ;
+
+        return best;
+    }
+
+    /**
+     * Build the edges for \a aPoints from the last triangulation, re-triangulating only the
+     * neighbourhood of the points which have been added or removed since.
+     *
+     * @return false if the last triangulation can't be reused and a full rebuild is needed.
+     */
+    bool updateEdges( const std::vector<VECTOR2I>& aPoints,
+                      std::vector<std::pair<int, int>>& aEdges )
+    {
+        if( m_points.empty() || aPoints.size() < 3 )
+            return false;
+
+        std::vector<int> oldToNew( m_points.size(), -1 );
+        std::vector<int> added;
+        size_t           removed = 0;
+        size_t           ii = 0;
+        size_t           jj = 0;
+
+        // Both sets are sorted, so a merge walk matches up the unchanged points
+        while( ii < m_points.size() || jj < aPoints.size() )
+        {
+            if( jj == aPoints.size()
+                    || ( ii < m_points.size() && pointLess( m_points[ii], aPoints[jj] ) ) )
+            {
+                removed++;
+                ii++;
+            }
+            else if( ii == m_points.size() || pointLess( aPoints[jj], m_points[ii] ) )
+            {
+                added.push_back( jj++ );
+            }
+            else
+            {
+                oldToNew[ii++] = jj++;
+            }
+        }
+
+        // The reused edges drift away from a true Delaunay triangulation (and so the ratsnest
+        // from a true minimum spanning tree) with each update, so rebuild once too much of the
+        // net has changed.
+        m_drift += removed + added.size();
+
+        if( m_drift * 10 > aPoints.size() )
+            return false;
+
+        // Re-triangulate the added points along with the neighbours of the removed points, and
+        // the nearest unchanged point to each added point along with its neighbours.
+        std::vector<bool> seed( m_points.size(), false );
+        std::vector<bool> local( aPoints.size(), false );
+
+        for( size_t oldIdx = 0; oldIdx < m_points.size(); oldIdx++ )
+        {
+            if( oldToNew[oldIdx] < 0 )
+                seed[oldIdx] = true;
+        }
+
+        for( int newIdx : added )
+        {
+            local[newIdx] = true;
+
+            int nearest = nearestSurvivor( aPoints[newIdx], oldToNew );
+
+            if( nearest >= 0 )
+            {
+                seed[nearest] = true;
+                local[oldToNew[nearest]] = true;
+            }
+        }
+
+        for( const auto& [a, b] : m_edges )
+        {
+            if( oldToNew[a] >= 0 && oldToNew[b] >= 0 )
+                aEdges.emplace_back( oldToNew[a], oldToNew[b] );
+
+            if( seed[a] && oldToNew[b] >= 0 )
+                local[oldToNew[b]] = true;
+
+            if( seed[b] && oldToNew[a] >= 0 )
+                local[oldToNew[a]] = true;
+        }
+
+        std::vector<int> subset;
+
+        for( size_t newIdx = 0; newIdx < aPoints.size(); newIdx++ )
+        {
+            if( local[newIdx] )
+                subset.push_back( newIdx );
+        }
+
+        triangulate( aPoints, subset, aEdges );
+        return true;
+    }
+
 public:
 
     void Clear()
@@ -173,29 +370,26 @@ public:
         m_allNodes.insert( aNode );
     }
 
-    void Triangulate( std::vector<CN_EDGE>& mstEdges )
+    /**
+     * @param aIncremental allows reusing the previous triangulation when few nodes have changed.
+     * @return true if the previous triangulation was reused.
+     */
+    bool Triangulate( std::vector<CN_EDGE>& mstEdges, bool aIncremental )
     {
-        std::vector<double>                                    node_pts;
+        std::vector<VECTOR2I>                                  points;
         std::vector<std::shared_ptr<CN_ANCHOR>>                anchors;
         std::vector< std::vector<std::shared_ptr<CN_ANCHOR>> > anchorChains( m_allNodes.size() );
 
-        node_pts.reserve( 2 * m_allNodes.size() );
+        points.reserve( m_allNodes.size() );
         anchors.reserve( m_allNodes.size() );
 
-        auto addEdge =
-                [&]( const std::shared_ptr<CN_ANCHOR>& src, const std::shared_ptr<CN_ANCHOR>& dst )
-                {
-                    mstEdges.emplace_back( src, dst, src->Dist( *dst ) );
-                };
-
         std::shared_ptr<CN_ANCHOR> prev = nullptr;
 
         for( const std::shared_ptr<CN_ANCHOR>& n : m_allNodes )
         {
             if( !prev || prev->Pos() != n->Pos() )
             {
-                node_pts.push_back( n->Pos().x );
-                node_pts.push_back( n->Pos().y );
+                points.push_back( n->Pos() );
                 anchors.push_back( n );
                 prev = n;
             }
@@ -205,36 +399,40 @@ public:
 
         if( anchors.size() < 2 )
         {
-            return;
+            m_points.clear();
+            m_edges.clear();
+            return false;
         }
-        else if( areNodesColinear( anchors ) )
+
+        std::vector<std::pair<int, int>> edges;
+        bool incremental = aIncremental && updateEdges( points, edges );
+
+        if( !incremental )
         {
-            // special case: all nodes are on the same line - there's no
-            // triangulation for such set. In this case, we sort along any coordinate
-            // and chain the nodes together.
-            for( size_t i = 0; i < anchors.size() - 1; i++ )
-                addEdge( anchors[i], anchors[i + 1] );
+            std::vector<int> all( points.size() );
+
+            for( size_t i = 0; i < all.size(); i++ )
+                all[i] = i;
+
+            edges.clear();
+            triangulate( points, all, edges );
+            m_drift = 0;
         }
-        else
+
+        for( std::pair<int, int>& edge : edges )
         {
-            delaunator::Delaunator delaunator( node_pts );
-            auto& triangles = delaunator.triangles;
+            if( edge.first > edge.second )
+                std::swap( edge.first, edge.second );
+        }
 
-            for( size_t i = 0; i < triangles.size(); i += 3 )
-            {
-                addEdge( anchors[triangles[i]],     anchors[triangles[i + 1]] );
-                addEdge( anchors[triangles[i + 1]], anchors[triangles[i + 2]] );
-                addEdge( anchors[triangles[i + 2]], anchors[triangles[i]]     );
-            }
+        std::sort( edges.begin(), edges.end() );
+        edges.erase( std::unique( edges.begin(), edges.end() ), edges.end() );
 
-            for( size_t i = 0; i < delaunator.halfedges.size(); i++ )
-            {
-                if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
-                    continue;
+        for( const auto& [a, b] : edges )
+            mstEdges.emplace_back( anchors[a], anchors[b], anchors[a]->Dist( *anchors[b] ) );
 
-                addEdge( anchors[triangles[i]], anchors[triangles[delaunator.halfedges[i]]] );
-            }
-        }
+        m_points = std::move( points );
+        m_edges = std::move( edges );
 
         for( size_t i = 0; i < anchorChains.size(); i++ )
         {
@@ -257,6 +455,8 @@ public:
                 mstEdges.emplace_back( prevNode, curNode, weight );
             }
         }
+
+        return incremental;
     }
 };
 
@@ -303,35 +503,133 @@ void RN_NET::compute()
     for( const std::shared_ptr<CN_ANCHOR>& n : m_nodes )
         m_triangulator->AddNode( n );
 
-    std::vector<CN_EDGE> triangEdges;
-    triangEdges.reserve( m_nodes.size() + m_boardEdges.size() );
+    auto computeMST =
+            [&]( bool aIncremental ) -> bool
+            {
+                std::vector<CN_EDGE> triangEdges;
+                triangEdges.reserve( m_nodes.size() + m_boardEdges.size() );
 
 #ifdef PROFILE
-    PROF_TIMER cnt( "triangulate" );
+                PROF_TIMER cnt( "triangulate" );
 #endif
-    m_triangulator->Triangulate( triangEdges );
+                bool incremental = m_triangulator->Triangulate( triangEdges, aIncremental );
 #ifdef PROFILE
-    cnt.Show();
+                cnt.Show();
 #endif
 
-    for( const CN_EDGE& e : m_boardEdges )
-        triangEdges.emplace_back( e );
+                for( const CN_EDGE& e : m_boardEdges )
+                    triangEdges.emplace_back( e );
 
-    std::sort( triangEdges.begin(), triangEdges.end() );
+                std::sort( triangEdges.begin(), triangEdges.end() );
 
-// Get the minimal spanning tree
+                // Get the minimal spanning tree
 #ifdef PROFILE
-    PROF_TIMER cnt2( "mst" );
+                PROF_TIMER cnt2( "mst" );
 #endif
-    kruskalMST( triangEdges );
+                bool spanning = kruskalMST( triangEdges );
 #ifdef PROFILE
-    cnt2.Show();
+                cnt2.Show();
 #endif
+
+                // A full triangulation always yields a spanning tree; a reused one might not
+                return spanning || !incremental;
+            };
+
+    if( !computeMST( ADVANCED_CFG::GetCfg().m_IncrementalRatsnest ) )
+        computeMST( false );
 }
 
 
+/**
+ * Nearest point search over the points of a zone island outline.  The points are sorted by x,
+ * so a search only visits the points whose x is within the best distance found so far.
+ */
+class OUTLINE_POINT_INDEX
+{
+public:
+    OUTLINE_POINT_INDEX( const std::vector<VECTOR2I>& aPoints ) :
+            m_points( aPoints )
+    {
+        m_order.resize( m_points.size() );
+
+        for( size_t ii = 0; ii < m_order.size(); ii++ )
+            m_order[ii] = (int) ii;
+
+        std::sort( m_order.begin(), m_order.end(),
+                   [&]( int a, int b )
+                   {
+                       return m_points[a].x < m_points[b].x;
+                   } );
+    }
+
+    /**
+     * Find the closest point to \a aPos which is nearer than \a aDistSq, updating \a aDistSq.
+     * Ties go to the earliest point in the outline, as with a linear search.
+     *
+     * @return the point's index in the outline, or -1 if there isn't one.
+     */
+    int Nearest( const VECTOR2I& aPos, SEG::ecoord& aDistSq ) const
+    {
+        int best = -1;
+
+        auto visit =
+                [&]( int aIdx )
+                {
+                    SEG::ecoord dx = (SEG::ecoord) m_points[aIdx].x - aPos.x;
+
+                    if( dx * dx > aDistSq )
+                        return false;
+
+                    SEG::ecoord dist_sq = ( m_points[aIdx] - aPos ).SquaredEuclideanNorm();
+
+                    if( dist_sq < aDistSq || ( best >= 0 && dist_sq == aDistSq && aIdx < best ) )
+                    {
+                        aDistSq = dist_sq;
+                        best = aIdx;
+                    }
+
+                    return true;
+                };
+
+        auto it = std::lower_bound( m_order.begin(), m_order.end(), aPos.x,
+                                    [&]( int aIdx, int aX )
+                                    {
+                                        return m_points[aIdx].x < aX;
+                                    } );
+
+        for( auto fwd = it; fwd != m_order.end(); ++fwd )
+        {
+            if( !visit( *fwd ) )
+                break;
+        }
+
+        for( auto rev = it; rev != m_order.begin(); --rev )
+        {
+            if( !visit( *( rev - 1 ) ) )
+                break;
+        }
+
+        return best;
+    }
+
+private:
+    const std::vector<VECTOR2I>& m_points;
+    std::vector<int>             m_order;
+};
+
+
 void RN_NET::OptimizeRNEdges()
 {
+    // Zone islands of a big pour are typically the closest item to many ratsnest lines.  Index
+    // their outlines the second time they're searched (a single search is cheaper without).
+    struct OUTLINE_SEARCH
+    {
+        int                                  m_searchCount = 0;
+        std::unique_ptr<OUTLINE_POINT_INDEX> m_index;
+    };
+
+    std::unordered_map<const CN_ZONE_LAYER*, OUTLINE_SEARCH> outlineSearches;
+
     auto optimizeZoneAnchor =
             [&]( const VECTOR2I& aPos, const LSET& aLayerSet,
                  const std::shared_ptr<const CN_ANCHOR>& aAnchor,
@@ -352,6 +650,23 @@ void RN_NET::OptimizeRNEdges()
                     if( zoneLayer && aLayerSet.test( zoneLayer->Layer() ) )
                     {
                         const std::vector<VECTOR2I>& pts = zoneLayer->GetOutline().CPoints();
+                        OUTLINE_SEARCH&              search = outlineSearches[zoneLayer];
+
+                        if( ++search.m_searchCount == 2 )
+                            search.m_index = std::make_unique<OUTLINE_POINT_INDEX>( pts );
+
+                        if( search.m_index )
+                        {
+                            int nearest = search.m_index->Nearest( aPos, closest_dist_sq );
+
+                            if( nearest >= 0 )
+                            {
+                                closest_pt = pts[nearest];
+                                closest_item = zoneLayer;
+                            }
+
+                            continue;
+                        }
 
                         for( const VECTOR2I& pt : pts )
                         {
@@ -478,6 +793,7 @@ void RN_NET::Clear()
     m_rnEdges.clear();
     m_boardEdges.clear();
     m_nodes.clear();
+    ClearLineNodes();
 
     m_dirty = true;
 }
@@ -485,6 +801,8 @@ void RN_NET::Clear()
 
 void RN_NET::AddCluster( std::shared_ptr<CN_CLUSTER> aCluster )
 {
+    ClearLineNodes();
+
     std::shared_ptr<CN_ANCHOR> firstAnchor;
 
     for( CN_ITEM* item : *aCluster )
@@ -514,7 +832,8 @@ void RN_NET::AddCluster( std::shared_ptr<CN_CLUSTER> aCluster )
 }
 
 
-bool RN_NET::NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I& aPos2 ) const
+bool RN_NET::NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I& aPos2,
+                                   std::shared_ptr<const CN_ANCHOR>* aOtherNode ) const
 {
     bool rv = false;
 
@@ -533,14 +852,26 @@ bool RN_NET::NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I&
                     distMax_sq = dist_sq;
                     aPos1     = aTestNode1->Pos();
                     aPos2     = aTestNode2->Pos();
+
+                    if( aOtherNode )
+                        *aOtherNode = aTestNode1;
                 }
             };
 
-    std::multiset<std::shared_ptr<CN_ANCHOR>, CN_PTR_CMP> nodes_b;
+    // This net's nodes don't change during a move, so only filter them (keeping them sorted)
+    // on the first frame
+    if( !m_lineNodesValid )
+    {
+        m_lineNodes.clear();
+
+        std::copy_if( m_nodes.begin(), m_nodes.end(), std::back_inserter( m_lineNodes ),
+                []( const std::shared_ptr<CN_ANCHOR> &aVal )
+                { return !aVal->GetNoLine(); } );
+
+        m_lineNodesValid = true;
+    }
 
-    std::copy_if( m_nodes.begin(), m_nodes.end(), std::inserter( nodes_b, nodes_b.end() ),
-            []( const std::shared_ptr<CN_ANCHOR> &aVal )
-            { return !aVal->GetNoLine(); } );
+    const std::vector<std::shared_ptr<CN_ANCHOR>>& nodes_b = m_lineNodes;
 
     /// Sweep-line algorithm to cut the number of comparisons to find the closest point
     ///
@@ -554,7 +885,7 @@ bool RN_NET::NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I&
         /// Step 2: O( log n ) search to identify a close element ordered by x
         /// The fwd_it iterator will move forward through the elements while
         /// the rev_it iterator will move backward through the same set
-        auto fwd_it = nodes_b.lower_bound( nodeA );
+        auto fwd_it = std::lower_bound( nodes_b.begin(), nodes_b.end(), nodeA, CN_PTR_CMP() );
         auto rev_it = std::make_reverse_iterator( fwd_it );
 
         for( ; fwd_it != nodes_b.end(); ++fwd_it )
@@ -96,14 +96,35 @@ public:
     const std::vector<CN_EDGE>& GetEdges() const { return m_rnEdges; }
     std::vector<CN_EDGE>& GetEdges() { return m_rnEdges; }
 
-    bool NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I& aPos2 ) const;
+    /**
+     * Find the closest pair of anchors between \a aOtherNet (at \a aPos1) and this net (at
+     * \a aPos2), ignoring anchors which mustn't have ratsnest lines.
+     *
+     * @param aOtherNode if not null, receives the anchor of \a aOtherNet at \a aPos1.
+     */
+    bool NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I& aPos2,
+                               std::shared_ptr<const CN_ANCHOR>* aOtherNode = nullptr ) const;
+
+    /**
+     * Forget the anchors cached by NearestBicoloredPair().  Must be called whenever anchors
+     * are blocked from (or unblocked from) having ratsnest lines.
+     */
+    void ClearLineNodes()
+    {
+        m_lineNodes.clear();
+        m_lineNodesValid = false;
+    }
 
 protected:
-    ///< Recompute ratsnest from scratch.
+    ///< Recompute ratsnest, reusing the previous triangulation when only a few nodes changed.
     void compute();
 
-    ///< Compute the minimum spanning tree using Kruskal's algorithm
-    void kruskalMST( const std::vector<CN_EDGE> &aEdges );
+    /**
+     * Compute the minimum spanning tree using Kruskal's algorithm.
+     *
+     * @return true if the edges connected all the nodes.
+     */
+    bool kruskalMST( const std::vector<CN_EDGE> &aEdges );
 
 protected:
     ///< Vector of nodes
@@ -118,6 +139,11 @@ protected:
     ///< Flag indicating necessity of recalculation of ratsnest for a net.
     bool m_dirty;
 
+    ///< The nodes which can have ratsnest lines, in the same order as m_nodes.  Cached for
+    ///< NearestBicoloredPair(), which is called on every frame of a move.
+    mutable std::vector<std::shared_ptr<CN_ANCHOR>> m_lineNodes;
+    mutable bool                                    m_lineNodesValid = false;
+
     class TRIANGULATOR_STATE;
 
     std::shared_ptr<TRIANGULATOR_STATE> m_triangulator;
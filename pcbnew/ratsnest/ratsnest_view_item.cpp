@@ -167,9 +167,10 @@ void RATSNEST_VIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
         if( hiddenNets.count( i ) )
             continue;
 
-        RN_NET* net = m_data->GetRatsnestForNet( i );
+        // Don't wait for an asynchronous ratsnest update; draw the last completed one instead
+        const std::vector<CN_EDGE>* edges = m_data->GetDisplayedRatsnest( i );
 
-        if( !net || m_data->GetConnectivityAlgo()->IsNetDirty( i ) )
+        if( !edges || m_data->GetConnectivityAlgo()->IsNetDirty( i ) )
             continue;
 
         if( colorByNet && netColors.count( i ) )
@@ -191,7 +192,7 @@ void RATSNEST_VIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
         else
             gal->SetStrokeColor( color );  // using the default ratsnest color for not highlighted
 
-        for( const CN_EDGE& edge : net->GetEdges() )
+        for( const CN_EDGE& edge : *edges )
         {
             if( !edge.IsVisible() )
                 continue;
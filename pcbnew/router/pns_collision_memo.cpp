@@ -0,0 +1,187 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+
+#include <geometry/shape_circle.h>
+#include <geometry/shape_rect.h>
+#include <geometry/shape_segment.h>
+
+#include "pns_collision_memo.h"
+#include "pns_item.h"
+
+namespace PNS {
+
+namespace
+{
+
+struct MEMO_KEY
+{
+    const ITEM*        m_item;
+    const ITEM*        m_head;     ///< The head, if owned by a node; null otherwise
+    int                m_headType; ///< The shape type of a head not owned by a node
+    std::array<int, 5> m_headGeometry;
+    int                m_distance;
+
+    bool operator==( const MEMO_KEY& aOther ) const
+    {
+        return m_item == aOther.m_item && m_head == aOther.m_head
+               && m_headType == aOther.m_headType && m_headGeometry == aOther.m_headGeometry
+               && m_distance == aOther.m_distance;
+    }
+};
+
+
+struct MEMO_KEY_HASH
+{
+    size_t operator()( const MEMO_KEY& aKey ) const
+    {
+        size_t seed = std::hash<const void*>()( aKey.m_item );
+
+        auto combine =
+                [&]( size_t aValue )
+                {
+                    seed ^= aValue + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+                };
+
+        combine( std::hash<const void*>()( aKey.m_head ) );
+        combine( aKey.m_headType );
+
+        for( int value : aKey.m_headGeometry )
+            combine( std::hash<int>()( value ) );
+
+        combine( std::hash<int>()( aKey.m_distance ) );
+        return seed;
+    }
+};
+
+
+struct MEMO
+{
+    uint64_t                                          m_generation = 0;
+    std::unordered_map<MEMO_KEY, bool, MEMO_KEY_HASH> m_entries;
+};
+
+
+/// A routing step doesn't need more; past that the table is just restarted
+const size_t MAX_ENTRIES = 1 << 16;
+
+std::atomic<uint64_t> s_generation( 1 );
+
+thread_local MEMO t_memo;
+
+
+/**
+ * Fill the head part of \a aKey.
+ *
+ * @return false if \a aHead can't be told apart from other items, in which case its tests can't
+ *         be remembered.
+ */
+bool describeHead( const ITEM* aHead, MEMO_KEY& aKey )
+{
+    aKey.m_head = nullptr;
+    aKey.m_headType = -1;
+    aKey.m_headGeometry.fill( 0 );
+
+    if( aHead->OwningNode() )
+    {
+        aKey.m_head = aHead;
+        return true;
+    }
+
+    const SHAPE* shape = aHead->Shape();
+
+    if( !shape )
+        return false;
+
+    aKey.m_headType = shape->Type();
+
+    switch( shape->Type() )
+    {
+    case SH_SEGMENT:
+    {
+        const SHAPE_SEGMENT* seg = static_cast<const SHAPE_SEGMENT*>( shape );
+        aKey.m_headGeometry = { seg->GetSeg().A.x, seg->GetSeg().A.y, seg->GetSeg().B.x,
+                                seg->GetSeg().B.y, seg->GetWidth() };
+        return true;
+    }
+
+    case SH_CIRCLE:
+    {
+        const SHAPE_CIRCLE* circle = static_cast<const SHAPE_CIRCLE*>( shape );
+        aKey.m_headGeometry = { circle->GetCenter().x, circle->GetCenter().y,
+                                circle->GetRadius(), 0, 0 };
+        return true;
+    }
+
+    case SH_RECT:
+    {
+        const SHAPE_RECT* rect = static_cast<const SHAPE_RECT*>( shape );
+        aKey.m_headGeometry = { rect->GetPosition().x, rect->GetPosition().y, rect->GetWidth(),
+                                rect->GetHeight(), 0 };
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+
+bool COLLISION_MEMO::Collide( const ITEM* aItem, const ITEM* aHead, int aDistance )
+{
+    MEMO_KEY key;
+
+    if( !aItem->OwningNode() || !describeHead( aHead, key ) )
+        return aHead->Shape()->Collide( aItem->Shape(), aDistance );
+
+    key.m_item = aItem;
+    key.m_distance = aDistance;
+
+    MEMO&    memo = t_memo;
+    uint64_t generation = s_generation.load( std::memory_order_relaxed );
+
+    if( memo.m_generation != generation || memo.m_entries.size() >= MAX_ENTRIES )
+    {
+        memo.m_entries.clear();
+        memo.m_generation = generation;
+    }
+
+    auto it = memo.m_entries.find( key );
+
+    if( it != memo.m_entries.end() )
+        return it->second;
+
+    bool collides = aHead->Shape()->Collide( aItem->Shape(), aDistance );
+    memo.m_entries.emplace( key, collides );
+    return collides;
+}
+
+
+void COLLISION_MEMO::Invalidate()
+{
+    s_generation.fetch_add( 1, std::memory_order_relaxed );
+}
+
+}
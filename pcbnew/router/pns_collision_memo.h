@@ -0,0 +1,54 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_COLLISION_MEMO_H
+#define __PNS_COLLISION_MEMO_H
+
+namespace PNS {
+
+class ITEM;
+
+/**
+ * Remembers the outcome of the shape tests between the items of the world and the items being
+ * routed, which the line placer, the shove and the optimizer repeat many times in a single
+ * routing step.
+ *
+ * Items owned by a node are told apart by their address; the temporary segments and vias the
+ * collision queries are made of are told apart by their geometry.  The entries are kept per
+ * thread and dropped by Invalidate(), which the router calls at each step and the nodes call
+ * before they delete items, whose addresses may then be reused.
+ */
+class COLLISION_MEMO
+{
+public:
+    /**
+     * @return true if the shape of \a aHead collides with the shape of \a aItem within
+     *         \a aDistance, as SHAPE::Collide() would tell.
+     */
+    static bool Collide( const ITEM* aItem, const ITEM* aHead, int aDistance );
+
+    /**
+     * Forget all the remembered tests, in all threads.
+     */
+    static void Invalidate();
+};
+
+}
+
+#endif    // __PNS_COLLISION_MEMO_H
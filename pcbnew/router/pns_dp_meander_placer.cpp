@@ -44,6 +44,7 @@ DP_MEANDER_PLACER::DP_MEANDER_PLACER( ROUTER* aRouter ) :
     m_initialSegment = nullptr;
     m_lastLength     = 0;
     m_lastStatus     = TOO_SHORT;
+    m_tunedPathLength = 0;
 }
 
 
@@ -124,6 +125,10 @@ bool DP_MEANDER_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
     if( m_endPad_n )
         m_padToDieN += m_endPad_n->GetPadToDie();
 
+    long long int totalP = m_padToDieP + lineLength( m_tunedPathP, m_startPad_p, m_endPad_p );
+    long long int totalN = m_padToDieN + lineLength( m_tunedPathN, m_startPad_n, m_endPad_n );
+    m_tunedPathLength = std::max( totalP, totalN );
+
     m_world->Remove( m_originPair.PLine() );
     m_world->Remove( m_originPair.NLine() );
 
@@ -140,9 +145,7 @@ void DP_MEANDER_PLACER::release()
 
 long long int DP_MEANDER_PLACER::origPathLength() const
 {
-    long long int totalP = m_padToDieP + lineLength( m_tunedPathP, m_startPad_p, m_endPad_p );
-    long long int totalN = m_padToDieN + lineLength( m_tunedPathN, m_startPad_n, m_endPad_n );
-    return std::max( totalP, totalN );
+    return m_tunedPathLength;
 }
 
 
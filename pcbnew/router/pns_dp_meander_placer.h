@@ -150,6 +150,10 @@ private:
     int           m_padToDieP;
     int           m_padToDieN;
     TUNING_STATUS m_lastStatus;
+
+    ///< Length of the longer of the tuned paths, pad to die included.  Measured once in
+    ///< Start(): the paths don't change while tuning.
+    long long int m_tunedPathLength;
 };
 
 }
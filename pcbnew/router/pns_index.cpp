@@ -22,19 +22,41 @@
 #include "pns_index.h"
 #include "pns_router.h"
 
+#include <advanced_config.h>
+#include <base_units.h>
+
 namespace PNS {
 
 
+INDEX::INDEX() :
+        m_gridCellSize( pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_RouterIndexGridSize ) )
+{
+}
+
+
 void INDEX::Add( ITEM* aItem )
 {
     const LAYER_RANGE& range = aItem->Layers();
     assert( range.Start() != -1 && range.End() != -1 );
 
-    if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
-        m_subIndices.resize( 2 * range.End() + 1 ); // +1 handles the 0 case
+    if( m_gridCellSize > 0 )
+    {
+        if( m_gridSubIndices.size() <= static_cast<size_t>( range.End() ) )
+            m_gridSubIndices.resize( 2 * range.End() + 1, ITEM_GRID_INDEX( m_gridCellSize ) );
 
-    for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i].Add( aItem );
+        BOX2I bbox = aItem->Shape()->BBox();
+
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_gridSubIndices[i].Add( aItem, bbox );
+    }
+    else
+    {
+        if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
+            m_subIndices.resize( 2 * range.End() + 1 ); // +1 handles the 0 case
+
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_subIndices[i].Add( aItem );
+    }
 
     m_allItems.insert( aItem );
     NET_HANDLE net = aItem->Net();
@@ -49,11 +71,24 @@ void INDEX::Remove( ITEM* aItem )
     const LAYER_RANGE& range = aItem->Layers();
     assert( range.Start() != -1 && range.End() != -1 );
 
-    if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
-        return;
+    if( m_gridCellSize > 0 )
+    {
+        if( m_gridSubIndices.size() <= static_cast<size_t>( range.End() ) )
+            return;
+
+        BOX2I bbox = aItem->Shape()->BBox();
+
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_gridSubIndices[i].Remove( aItem, bbox );
+    }
+    else
+    {
+        if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
+            return;
 
-    for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i].Remove( aItem );
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_subIndices[i].Remove( aItem );
+    }
 
     m_allItems.erase( aItem );
     NET_HANDLE net = aItem->Net();
@@ -28,6 +28,7 @@
 #include <unordered_set>
 
 #include <layer_ids.h>
+#include <geometry/shape_grid_index.h>
 #include <geometry/shape_index.h>
 
 #include "pns_item.h"
@@ -41,15 +42,29 @@ namespace PNS {
  * Custom spatial index, holding our board items and allowing for very fast searches. Items
  * are assigned to separate R-Tree subindices depending on their type and spanned layers, reducing
  * overlap and improving search time.
+ *
+ * When the RouterIndexGridSize advanced setting is set, the subindices are spatial hashes
+ * instead of R-Trees.
  **/
 class INDEX
 {
 public:
     typedef std::list<ITEM*>            NET_ITEMS_LIST;
     typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
+    typedef SHAPE_GRID_INDEX<ITEM*>     ITEM_GRID_INDEX;
     typedef std::unordered_set<ITEM*>   ITEM_SET;
 
-    INDEX(){};
+    /**
+     * Create an index of the kind selected by the RouterIndexGridSize advanced setting.
+     */
+    INDEX();
+
+    /**
+     * @param aGridCellSize is the cell size of the spatial hash subindices, or 0 to use R-Trees.
+     */
+    explicit INDEX( int aGridCellSize ) :
+            m_gridCellSize( aGridCellSize )
+    {}
 
     /**
      * Adds item to the spatial index.
@@ -122,7 +137,9 @@ private:
     int querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
 
 private:
+    int                                  m_gridCellSize;
     std::deque<ITEM_SHAPE_INDEX>         m_subIndices;
+    std::deque<ITEM_GRID_INDEX>          m_gridSubIndices;
     std::map<NET_HANDLE, NET_ITEMS_LIST> m_netMap;
     ITEM_SET                             m_allItems;
 };
@@ -131,6 +148,14 @@ private:
 template<class Visitor>
 int INDEX::querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const
 {
+    if( m_gridCellSize > 0 )
+    {
+        if( aIndex >= m_gridSubIndices.size() )
+            return 0;
+
+        return m_gridSubIndices[aIndex].Query( aShape, aMinDistance, aVisitor );
+    }
+
     if( aIndex >= m_subIndices.size() )
         return 0;
 
@@ -157,7 +182,9 @@ int INDEX::Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) con
 {
     int total = 0;
 
-    for( std::size_t i = 0; i < m_subIndices.size(); ++i )
+    std::size_t count = m_gridCellSize > 0 ? m_gridSubIndices.size() : m_subIndices.size();
+
+    for( std::size_t i = 0; i < count; ++i )
         total += querySingle( i, aShape, aMinDistance, aVisitor );
 
     return total;
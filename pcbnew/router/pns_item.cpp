@@ -19,6 +19,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "pns_collision_memo.h"
 #include "pns_node.h"
 #include "pns_item.h"
 #include "pns_line.h"
@@ -245,7 +246,7 @@ bool ITEM::collideSimple( const ITEM* aHead, const NODE* aNode,
             // The extra "1" here is to account for the fact that the hulls are built to exactly
             // the clearance distance, so we need to allow for no collision when exactly at the
             // clearance distance.
-            if( shapeH->Collide( shapeI, clearance + lineWidthH + lineWidthI - 1 ) )
+            if( COLLISION_MEMO::Collide( this, aHead, clearance + lineWidthH + lineWidthI - 1 ) )
             {
                 if( aCtx )
                 {
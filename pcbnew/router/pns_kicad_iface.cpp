@@ -54,6 +54,7 @@
 #include <wx/log.h>
 
 #include <memory>
+#include <mutex>
 
 #include <advanced_config.h>
 #include <pcbnew_settings.h>
@@ -154,6 +155,16 @@ private:
 
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_clearanceCache;
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_tempClearanceCache;
+
+    /// Rule resolutions shared by the item pairs with the same nets, types and layer.  They
+    /// don't depend on the items themselves, so they outlive the caches above and are only
+    /// dropped when the board or its rules change (see m_ruleCacheTimeStamp).
+    std::unordered_map<DRC_CONSTRAINT_SIGNATURE, DRC_CONSTRAINT> m_ruleCache;
+    int                                                          m_ruleCacheTimeStamp;
+
+    /// The router may check collisions from several threads; this guards the dummy items
+    /// and the caches above.  Recursive because Clearance() calls QueryConstraint().
+    std::recursive_mutex m_mutex;
 };
 
 
@@ -163,7 +174,8 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard,
     m_board( aBoard ),
     m_dummyTracks{ { aBoard }, { aBoard } },
     m_dummyArcs{ { aBoard }, { aBoard } },
-    m_dummyVias{ { aBoard }, { aBoard } }
+    m_dummyVias{ { aBoard }, { aBoard } },
+    m_ruleCacheTimeStamp( -1 )
 {
     for( PCB_TRACK& track : m_dummyTracks )
         track.SetFlags( ROUTER_TRANSIENT );
@@ -200,6 +212,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::IsNetTieExclusion( const PNS::ITEM* aItem,
 {
     wxCHECK( aItem && aCollidingItem, false );
 
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     std::shared_ptr<DRC_ENGINE> drcEngine = m_board->GetDesignSettings().m_DRCEngine;
     BOARD_ITEM*                 item = aItem->BoardItem();
     BOARD_ITEM*                 collidingItem = aCollidingItem->BoardItem();
@@ -226,6 +240,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::IsNetTieExclusion( const PNS::ITEM* aItem,
 bool PNS_PCBNEW_RULE_RESOLVER::IsKeepout( const PNS::ITEM* aObstacle, const PNS::ITEM* aItem,
                                           bool* aEnforce )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     auto checkKeepout =
             []( const ZONE* aKeepout, const BOARD_ITEM* aOther )
             {
@@ -370,10 +386,52 @@ BOARD_ITEM* PNS_PCBNEW_RULE_RESOLVER::getBoardItem( const PNS::ITEM* aItem, int
 }
 
 
+/**
+ * Pack everything a net-and-type-only rule resolution can depend on for \a aItem into
+ * \a aSignature.
+ *
+ * @return false if the resolution for \a aItem can't be shared with other items.  Only tracks,
+ *         arcs and vias qualify, as pads, footprints and zones can carry local overrides.
+ */
+static bool ruleSignature( const BOARD_ITEM* aItem, uint64_t& aSignature )
+{
+    if( !aItem )
+    {
+        aSignature = 0;
+        return true;
+    }
+
+    aSignature = (uint64_t) aItem->Type() + 1;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+        // Copper or not, as far as the rules are concerned
+        aSignature |= (uint64_t) ( ( aItem->GetLayer() + 1 ) & 0xFF ) << 16;
+        break;
+
+    case PCB_VIA_T:
+        aSignature |= (uint64_t) static_cast<const PCB_VIA*>( aItem )->GetViaType() << 16;
+        break;
+
+    default:
+        return false;
+    }
+
+    int netCode = static_cast<const BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode();
+
+    aSignature |= (uint64_t) (uint32_t) netCode << 32;
+    return true;
+}
+
+
 bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
                                                 const PNS::ITEM* aItemA, const PNS::ITEM* aItemB,
                                                 int aLayer, PNS::CONSTRAINT* aConstraint )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     std::shared_ptr<DRC_ENGINE> drcEngine = m_board->GetDesignSettings().m_DRCEngine;
 
     if( !drcEngine )
@@ -410,7 +468,41 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
         parentB = getBoardItem( aItemB, aLayer, 1 );
 
     if( parentA )
-        hostConstraint = drcEngine->EvalRules( hostType, parentA, parentB, ToLAYER_ID( aLayer ) );
+    {
+        DRC_CONSTRAINT_SIGNATURE signature = { hostType, aLayer, 0, 0 };
+        bool                     shared = ADVANCED_CFG::GetCfg().m_MemoizeDRCConstraints
+                                          && drcEngine->IsMemoizable( hostType )
+                                          && ruleSignature( parentA, signature.m_itemA )
+                                          && ruleSignature( parentB, signature.m_itemB );
+
+        if( shared )
+        {
+            // The board time stamp moves with every commit and every change of the rules
+            if( m_ruleCacheTimeStamp != m_board->GetTimeStamp() )
+            {
+                m_ruleCache.clear();
+                m_ruleCacheTimeStamp = m_board->GetTimeStamp();
+            }
+
+            auto it = m_ruleCache.find( signature );
+
+            if( it != m_ruleCache.end() )
+            {
+                hostConstraint = it->second;
+            }
+            else
+            {
+                hostConstraint = drcEngine->EvalRules( hostType, parentA, parentB,
+                                                       ToLAYER_ID( aLayer ) );
+                m_ruleCache.emplace( signature, hostConstraint );
+            }
+        }
+        else
+        {
+            hostConstraint = drcEngine->EvalRules( hostType, parentA, parentB,
+                                                   ToLAYER_ID( aLayer ) );
+        }
+    }
 
     if( hostConstraint.IsNull() )
         return false;
@@ -450,6 +542,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItems( std::vector<const PNS::ITEM*>& aItems )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     int n_pruned = 0;
     std::set<const PNS::ITEM*> remainingItems( aItems.begin(), aItems.end() );
 
@@ -477,6 +571,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItems( std::vector<const PNS::ITEM*>
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     m_clearanceCache.clear();
     m_tempClearanceCache.clear();
 }
@@ -484,6 +580,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearTemporaryCaches()
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     m_tempClearanceCache.clear();
 }
 
@@ -491,6 +589,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearTemporaryCaches()
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                          bool aUseClearanceEpsilon )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     CLEARANCE_CACHE_KEY key = { aA, aB, aUseClearanceEpsilon };
 
     // Search cache (used for actual board items)
@@ -1653,6 +1753,130 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
 }
 
 
+bool PNS_KICAD_IFACE_BASE::UpdateWorld( PNS::NODE* aWorld,
+                                        const std::unordered_set<const BOARD_ITEM*>& aChanged )
+{
+    if( !m_board || !m_ruleResolver || aWorld != m_world )
+        return false;
+
+    // Items removed from the board may be gone already, so the stale items of the world are
+    // found by the parents it doesn't have anymore rather than by what it was told
+    std::unordered_set<const BOARD_ITEM*> live;
+    std::vector<BOARD_ITEM*>              toSync;
+
+    auto visit =
+            [&]( BOARD_ITEM* aItem, bool aParentChanged )
+            {
+                live.insert( aItem );
+
+                if( aParentChanged || aChanged.count( aItem ) )
+                    toSync.push_back( aItem );
+            };
+
+    for( BOARD_ITEM* gitem : m_board->Drawings() )
+        visit( gitem, false );
+
+    for( ZONE* zone : m_board->Zones() )
+        visit( zone, false );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        bool changed = aChanged.count( footprint ) > 0;
+
+        footprint->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    visit( aChild, changed );
+                } );
+    }
+
+    for( PCB_TRACK* t : m_board->Tracks() )
+        visit( t, false );
+
+    for( PNS::ITEM* item : aWorld->FindItemsByParent(
+                 [&]( const BOARD_ITEM* aParent )
+                 {
+                     return !live.count( aParent ) || aChanged.count( aParent )
+                            || ( aParent->GetParentFootprint()
+                                 && aChanged.count( aParent->GetParentFootprint() ) );
+                 } ) )
+    {
+        aWorld->Remove( item );
+    }
+
+    int             worstClearance = aWorld->GetMaxClearance() - m_ruleResolver->ClearanceEpsilon();
+    SHAPE_POLY_SET  buffer;
+    SHAPE_POLY_SET* boardOutline = nullptr;
+    bool            outlineBuilt = false;
+
+    for( BOARD_ITEM* item : toSync )
+    {
+        switch( item->Type() )
+        {
+        case PCB_SHAPE_T:
+        case PCB_TEXTBOX_T:
+            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( item ) );
+            break;
+
+        case PCB_TEXT_T:
+        case PCB_FIELD_T:
+            syncTextItem( aWorld, static_cast<PCB_TEXT*>( item ), item->GetLayer() );
+            break;
+
+        case PCB_ZONE_T:
+            if( !outlineBuilt )
+            {
+                if( m_board->GetBoardPolygonOutlines( buffer ) )
+                    boardOutline = &buffer;
+
+                outlineBuilt = true;
+            }
+
+            syncZone( aWorld, static_cast<ZONE*>( item ), boardOutline );
+            break;
+
+        case PCB_PAD_T:
+        {
+            PAD* pad = static_cast<PAD*>( item );
+
+            if( std::unique_ptr<PNS::SOLID> solid = syncPad( pad ) )
+                aWorld->Add( std::move( solid ) );
+
+            worstClearance = std::max( worstClearance, pad->GetLocalClearance() );
+            break;
+        }
+
+        case PCB_TRACE_T:
+            if( std::unique_ptr<PNS::SEGMENT> seg = syncTrack( static_cast<PCB_TRACK*>( item ) ) )
+                aWorld->Add( std::move( seg ) );
+
+            break;
+
+        case PCB_ARC_T:
+            if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( item ) ) )
+                aWorld->Add( std::move( arc ) );
+
+            break;
+
+        case PCB_VIA_T:
+            if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( item ) ) )
+                aWorld->Add( std::move( via ) );
+
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // The clearance cache is keyed by item address, which the removed items may hand down
+    m_ruleResolver->ClearCaches();
+
+    aWorld->SetMaxClearance( worstClearance + m_ruleResolver->ClearanceEpsilon() );
+    return true;
+}
+
+
 void PNS_KICAD_IFACE::EraseView()
 {
     for( BOARD_ITEM* item : m_hiddenItems )
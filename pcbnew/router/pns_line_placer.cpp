@@ -918,6 +918,7 @@ bool LINE_PLACER::rhShoveOnly( const VECTOR2I& aP, LINE& aNewHead, LINE& aNewTai
 
     m_shove->SetLogger( Logger() );
     m_shove->SetDebugDecorator( Dbg() );
+    m_shove->SetFrameTimeLimit( Settings().ShoveFrameTimeLimit() );
 
     if( m_endItem )
     {
@@ -2051,6 +2052,12 @@ void LINE_PLACER::GetModifiedNets( std::vector<NET_HANDLE>& aNets ) const
 }
 
 
+bool LINE_PLACER::HasPendingWork() const
+{
+    return m_shove && m_shove->IsSuspended();
+}
+
+
 bool LINE_PLACER::AbortPlacement()
 {
     m_world->KillChildren();
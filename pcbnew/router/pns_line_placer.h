@@ -205,6 +205,8 @@ public:
 
     void GetModifiedNets( std::vector<NET_HANDLE>& aNets ) const override;
 
+    bool HasPendingWork() const override;
+
     /**
      * Snaps the point \a aP to segment \a aSeg. Splits the segment in two, forming a
      * joint at \a aP and stores updated topology in node \a aNode.
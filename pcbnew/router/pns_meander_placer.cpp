@@ -39,6 +39,7 @@ MEANDER_PLACER::MEANDER_PLACER( ROUTER* aRouter ) :
     m_lastLength = 0;
     m_lastStatus = TOO_SHORT;
     m_padToDieLength = 0;
+    m_tunedPathLength = 0;
 }
 
 
@@ -82,6 +83,8 @@ bool MEANDER_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
     if( m_endPad_n )
         m_padToDieLength += m_endPad_n->GetPadToDie();
 
+    m_tunedPathLength = m_padToDieLength + lineLength( m_tunedPath, m_startPad_n, m_endPad_n );
+
     m_world->Remove( m_originLine );
 
     m_currentWidth = m_originLine.Width();
@@ -93,7 +96,7 @@ bool MEANDER_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
 
 long long int MEANDER_PLACER::origPathLength() const
 {
-    return m_padToDieLength + lineLength( m_tunedPath, m_startPad_n, m_endPad_n );
+    return m_tunedPathLength;
 }
 
 
@@ -123,6 +123,10 @@ protected:
     ///< Total length added by pad to die size.
     int m_padToDieLength;
 
+    ///< Length of m_tunedPath, pad to die included.  Measured once in Start(): the tuned path
+    ///< doesn't change while tuning, only the part being meandered is measured on each move.
+    long long int m_tunedPathLength;
+
     long long int m_lastLength;
     TUNING_STATUS m_lastStatus;
 };
@@ -116,17 +116,9 @@ bool MEANDER_SKEW_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
         m_tunedPath = m_tunedPathN;
     }
 
-    return true;
-}
-
-
-long long int MEANDER_SKEW_PLACER::origPathLength() const
-{
-    if ( m_originPair.NetP() == m_originLine.Net() )
-        return m_padToDieP + lineLength( m_tunedPath, m_startPad_p, m_endPad_p );
-
-    return m_padToDieN + lineLength( m_tunedPath, m_startPad_n, m_endPad_n );
+    m_tunedPathLength = m_lastLength;
 
+    return true;
 }
 
 
@@ -54,8 +54,6 @@ public:
     long long int CurrentSkew() const;
 
 private:
-    long long int origPathLength() const override;
-
     DIFF_PAIR m_originPair;
     ITEM_SET  m_tunedPathP, m_tunedPathN;
 
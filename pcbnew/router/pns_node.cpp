@@ -33,6 +33,7 @@
 #include <wx/log.h>
 
 #include "pns_arc.h"
+#include "pns_collision_memo.h"
 #include "pns_item.h"
 #include "pns_itemset.h"
 #include "pns_line.h"
@@ -44,6 +45,7 @@
 #include "pns_debug_decorator.h"
 #include "pns_router.h"
 #include "pns_utils.h"
+#include "pns_profile.h"
 
 
 namespace PNS {
@@ -59,7 +61,10 @@ NODE::NODE()
     m_parent = nullptr;
     m_maxClearance = 800000;    // fixme: depends on how thick traces are.
     m_ruleResolver = nullptr;
-    m_index = new INDEX;
+    m_index = std::make_shared<INDEX>();
+    m_joints = std::make_shared<JOINT_MAP>();
+    m_override = std::make_shared<std::unordered_set<ITEM*>>();
+    m_ownsBranchData = true;
 
 #ifdef DEBUG
     allocNodes.insert( this );
@@ -85,8 +90,6 @@ NODE::~NODE()
     allocNodes.erase( this );
 #endif
 
-    m_joints.clear();
-
     std::vector<const ITEM*> toDelete;
 
     toDelete.reserve( m_index->Size() );
@@ -108,6 +111,8 @@ NODE::~NODE()
         }
     }
 
+    COLLISION_MEMO::Invalidate();
+
     for( const ITEM* item : toDelete )
     {
         wxLogTrace( wxT( "PNS" ), wxT( "del item %p type %s" ), item, item->KindStr().c_str() );
@@ -121,8 +126,6 @@ NODE::~NODE()
 
     releaseGarbage();
     unlinkParent();
-
-    delete m_index;
 }
 
 
@@ -142,6 +145,8 @@ int NODE::GetClearance( const ITEM* aA, const ITEM* aB, bool aUseClearanceEpsilo
 
 NODE* NODE::Branch()
 {
+    PROFILE::Count( PROFILE::BRANCHES );
+
     NODE* child = new NODE;
 
     m_children.insert( child );
@@ -152,30 +157,71 @@ NODE* NODE::Branch()
     child->m_root = isRoot() ? this : m_root;
     child->m_maxClearance = m_maxClearance;
 
-    // Immediate offspring of the root branch needs not copy anything. For the rest, deep-copy
-    // joints, overridden item maps and pointers to stored items.
+    // Immediate offspring of the root branch needs not copy anything. The rest share the
+    // joints, overridden item maps and pointers to stored items of this branch, and copy them
+    // when either branch is first changed.
     if( !isRoot() )
     {
-        JOINT_MAP::iterator j;
-
-        for( ITEM* item : *m_index )
-            child->m_index->Add( item );
-
+        child->m_index = m_index;
         child->m_joints = m_joints;
         child->m_override = m_override;
+        child->m_ownsBranchData = false;
     }
 
 #if 0
     wxLogTrace( wxT( "PNS" ), wxT( "%d items, %d joints, %d overrides" ),
                 child->m_index->Size(),
-                (int) child->m_joints.size(),
-                (int) child->m_override.size() );
+                (int) child->m_joints->size(),
+                (int) child->m_override->size() );
 #endif
 
     return child;
 }
 
 
+void NODE::unshare()
+{
+    // The index, joints and overrides are always shared together
+    if( m_index.use_count() == 1 )
+        return;
+
+    if( !m_ownsBranchData )
+    {
+        takePrivateCopy();
+        return;
+    }
+
+    // The branches still sharing the data of this node must not see it change
+    for( NODE* child : m_children )
+        child->detachFrom( m_index.get() );
+}
+
+
+void NODE::takePrivateCopy()
+{
+    std::shared_ptr<INDEX> index = std::make_shared<INDEX>();
+
+    for( ITEM* item : *m_index )
+        index->Add( item );
+
+    m_index = std::move( index );
+    m_joints = std::make_shared<JOINT_MAP>( *m_joints );
+    m_override = std::make_shared<std::unordered_set<ITEM*>>( *m_override );
+    m_ownsBranchData = true;
+}
+
+
+void NODE::detachFrom( const INDEX* aShared )
+{
+    if( m_index.get() == aShared )
+        takePrivateCopy();
+
+    // A branch which copied its data may still have kids sharing the old one
+    for( NODE* child : m_children )
+        child->detachFrom( aShared );
+}
+
+
 void NODE::unlinkParent()
 {
     if( isRoot() )
@@ -252,6 +298,8 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
 int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
                           const COLLISION_SEARCH_OPTIONS& aOpts ) const
 {
+    PROFILE::Count( PROFILE::COLLISION_QUERIES );
+
     COLLISION_SEARCH_CONTEXT ctx( aObstacles, aOpts );
 
     /// By default, virtual items cannot collide
@@ -517,6 +565,8 @@ const ITEM_SET NODE::HitTest( const VECTOR2I& aPoint ) const
 
 void NODE::addSolid( SOLID* aSolid )
 {
+    unshare();
+
     if( aSolid->HasHole() )
     {
         assert( aSolid->Hole()->BelongsTo( aSolid ) );
@@ -540,6 +590,8 @@ void NODE::Add( std::unique_ptr< SOLID > aSolid )
 
 void NODE::addVia( VIA* aVia )
 {
+    unshare();
+
     if( aVia->HasHole() )
     {
         if( ! aVia->Hole()->BelongsTo( aVia ) )
@@ -558,6 +610,8 @@ void NODE::addVia( VIA* aVia )
 
 void NODE::addHole( HOLE* aHole )
 {
+    unshare();
+
     // do we need holes in the connection graph?
     //linkJoint( aHole->Pos(), aHole->Layers(), aHole->Net(), aHole );
 
@@ -651,6 +705,8 @@ void NODE::Add( LINE& aLine, bool aAllowRedundant )
 
 void NODE::addSegment( SEGMENT* aSeg )
 {
+    unshare();
+
     aSeg->SetOwner( this );
 
     linkJoint( aSeg->Seg().A, aSeg->Layers(), aSeg->Net(), aSeg );
@@ -680,6 +736,8 @@ bool NODE::Add( std::unique_ptr< SEGMENT > aSegment, bool aAllowRedundant )
 
 void NODE::addArc( ARC* aArc )
 {
+    unshare();
+
     aArc->SetOwner( this );
 
     linkJoint( aArc->Anchor( 0 ), aArc->Layers(), aArc->Net(), aArc );
@@ -724,14 +782,16 @@ bool NODE::QueryEdgeExclusions( const VECTOR2I& aPos ) const
 
 void NODE::doRemove( ITEM* aItem )
 {
+    unshare();
+
     // case 1: removing an item that is stored in the root node from any branch:
     // mark it as overridden, but do not remove
     if( aItem->BelongsTo( m_root ) && !isRoot() )
     {
-        m_override.insert( aItem );
+        m_override->insert( aItem );
 
         if( aItem->HasHole() )
-            m_override.insert( aItem->Hole() );
+            m_override->insert( aItem->Hole() );
     }
 
     // case 2: the item belongs to this branch or a parent, non-root branch,
@@ -778,6 +838,8 @@ void NODE::removeArcIndex( ARC* aArc )
 
 void NODE::rebuildJoint( const JOINT* aJoint, const ITEM* aItem )
 {
+    unshare();
+
     // We have to split a single joint (associated with a via or a pad, binding together multiple
     // layers) into multiple independent joints. As I'm a lazy bastard, I simply delete the
     // via/solid and all its links and re-insert them.
@@ -794,9 +856,9 @@ void NODE::rebuildJoint( const JOINT* aJoint, const ITEM* aItem )
     do
     {
         split = false;
-        auto range = m_joints.equal_range( tag );
+        auto range = m_joints->equal_range( tag );
 
-        if( range.first == m_joints.end() )
+        if( range.first == m_joints->end() )
             break;
 
         // find and remove all joints containing the via to be removed
@@ -805,7 +867,7 @@ void NODE::rebuildJoint( const JOINT* aJoint, const ITEM* aItem )
         {
             if( aItem->LayersOverlap( &f->second ) )
             {
-                m_joints.erase( f );
+                m_joints->erase( f );
                 split = true;
                 break;
             }
@@ -1142,8 +1204,19 @@ void NODE::FixupVirtualVias()
 {
     const SEGMENT* locked_seg = nullptr;
     std::vector<VVIA*> vvias;
+    std::vector<ITEM*> oldVvias;
+
+    // The world may be updated in place, with the virtual vias of its previous state
+    for( ITEM* item : *m_index )
+    {
+        if( item->OfKind( ITEM::VIA_T ) && item->IsVirtual() )
+            oldVvias.push_back( item );
+    }
+
+    for( ITEM* item : oldVvias )
+        Remove( item );
 
-    for( auto& jointPair : m_joints )
+    for( auto& jointPair : *m_joints )
     {
         JOINT joint = jointPair.second;
 
@@ -1216,12 +1289,12 @@ const JOINT* NODE::FindJoint( const VECTOR2I& aPos, int aLayer, NET_HANDLE aNet
     tag.net = aNet;
     tag.pos = aPos;
 
-    JOINT_MAP::const_iterator f = m_joints.find( tag ), end = m_joints.end();
+    JOINT_MAP::const_iterator f = m_joints->find( tag ), end = m_joints->end();
 
     if( f == end && !isRoot() )
     {
-        end = m_root->m_joints.end();
-        f = m_root->m_joints.find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
+        end = m_root->m_joints->end();
+        f = m_root->m_joints->find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
     }
 
     if( f == end )
@@ -1248,23 +1321,25 @@ void NODE::LockJoint( const VECTOR2I& aPos, const ITEM* aItem, bool aLock )
 
 JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, NET_HANDLE aNet )
 {
+    unshare();
+
     JOINT::HASH_TAG tag;
 
     tag.pos = aPos;
     tag.net = aNet;
 
     // try to find the joint in this node.
-    JOINT_MAP::iterator f = m_joints.find( tag );
+    JOINT_MAP::iterator f = m_joints->find( tag );
 
     std::pair<JOINT_MAP::iterator, JOINT_MAP::iterator> range;
 
     // not found and we are not root? find in the root and copy results here.
-    if( f == m_joints.end() && !isRoot() )
+    if( f == m_joints->end() && !isRoot() )
     {
-        range = m_root->m_joints.equal_range( tag );
+        range = m_root->m_joints->equal_range( tag );
 
         for( f = range.first; f != range.second; ++f )
-            m_joints.insert( *f );
+            m_joints->insert( *f );
     }
 
     // now insert and combine overlapping joints
@@ -1275,9 +1350,9 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, NET_H
     do
     {
         merged  = false;
-        range   = m_joints.equal_range( tag );
+        range   = m_joints->equal_range( tag );
 
-        if( range.first == m_joints.end() )
+        if( range.first == m_joints->end() )
             break;
 
         for( f = range.first; f != range.second; ++f )
@@ -1285,14 +1360,14 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, NET_H
             if( aLayers.Overlaps( f->second.Layers() ) )
             {
                 jt.Merge( f->second );
-                m_joints.erase( f );
+                m_joints->erase( f );
                 merged = true;
                 break;
             }
         }
     } while( merged );
 
-    return m_joints.insert( TagJointPair( tag, jt ) )->second;
+    return m_joints->insert( TagJointPair( tag, jt ) )->second;
 }
 
 
@@ -1351,7 +1426,7 @@ void NODE::Dump( bool aLong )
 
     if( aLong )
     {
-        for( j = m_joints.begin(); j != m_joints.end(); ++j )
+        for( j = m_joints->begin(); j != m_joints->end(); ++j )
         {
             wxLogTrace( wxT( "PNS" ), wxT( "joint : %s, links : %d\n" ),
                         j->second.GetPos().Format().c_str(), j->second.LinkCount() );
@@ -1408,7 +1483,7 @@ void NODE::Dump( bool aLong )
     }
 
     wxLogTrace( wxT( "PNS" ), wxT( "Local joints: %d, lines : %d \n" ),
-                m_joints.size(), lines_count );
+                m_joints->size(), lines_count );
 #endif
 }
 
@@ -1418,13 +1493,13 @@ void NODE::GetUpdatedItems( ITEM_VECTOR& aRemoved, ITEM_VECTOR& aAdded )
     if( isRoot() )
         return;
 
-    if( m_override.size() )
-        aRemoved.reserve( m_override.size() );
+    if( m_override->size() )
+        aRemoved.reserve( m_override->size() );
 
     if( m_index->Size() )
         aAdded.reserve( m_index->Size() );
 
-    for( ITEM* item : m_override )
+    for( ITEM* item : *m_override )
         aRemoved.push_back( item );
 
     for( ITEM* item : *m_index )
@@ -1453,6 +1528,8 @@ void NODE::releaseGarbage()
     std::vector<const ITEM*> cacheCheckItems;
     cacheCheckItems.reserve( m_garbageItems.size() );
 
+    COLLISION_MEMO::Invalidate();
+
     for( ITEM* item : m_garbageItems )
     {
         if( !item->BelongsTo( this ) )
@@ -1473,7 +1550,7 @@ void NODE::Commit( NODE* aNode )
     if( aNode->isRoot() )
         return;
 
-    for( ITEM* item : aNode->m_override )
+    for( ITEM* item : *aNode->m_override )
         Remove( item );
 
     for( ITEM* item : *aNode->m_index )
@@ -1630,7 +1707,7 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, LAYER_RA
 
     aJoints.clear();
 
-    for( JOINT_MAP::value_type& j : m_joints )
+    for( JOINT_MAP::value_type& j : *m_joints )
     {
         if( !j.second.Layers().Overlaps( aLayerMask ) )
             continue;
@@ -1645,7 +1722,7 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, LAYER_RA
     if( isRoot() )
         return n;
 
-    for( JOINT_MAP::value_type& j : m_root->m_joints )
+    for( JOINT_MAP::value_type& j : *m_root->m_joints )
     {
         if( !Overrides( &j.second ) && j.second.Layers().Overlaps( aLayerMask ) )
         {
@@ -1693,4 +1770,19 @@ std::vector<ITEM*> NODE::FindItemsByZone( const ZONE* aParent )
 
     return ret;
 }
+
+
+std::vector<ITEM*> NODE::FindItemsByParent(
+        const std::function<bool( const BOARD_ITEM* )>& aFilter )
+{
+    std::vector<ITEM*> ret;
+
+    for( ITEM* item : *m_index )
+    {
+        if( item->Parent() && !item->OfKind( ITEM::HOLE_T ) && aFilter( item->Parent() ) )
+            ret.push_back( item );
+    }
+
+    return ret;
+}
 }
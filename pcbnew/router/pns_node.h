@@ -24,7 +24,9 @@
 #define __PNS_NODE_H
 
 #include <vector>
+#include <functional>
 #include <list>
+#include <memory>
 #include <set>
 #include <core/minoptmax.h>
 
@@ -202,6 +204,9 @@ protected:
  * - collision search & clearance checking.
  * - assembly of lines connecting joints, finding loops and unique paths.
  * - lightweight cloning/branching (for recursive optimization and shove springback).
+ *
+ * A branch of a non-root node shares the index, joints and overrides of its parent until one of
+ * them changes, so branching is cheap however many items the parent branch holds.
  **/
 class NODE : public ITEM_OWNER
 {
@@ -250,7 +255,7 @@ public:
     ///< Return the number of joints.
     int JointCount() const
     {
-        return m_joints.size();
+        return m_joints->size();
     }
 
     ///< Return the number of nodes in the inheritance chain (wrs to the root node).
@@ -451,6 +456,10 @@ public:
 
     std::vector<ITEM*> FindItemsByZone( const ZONE* aParent );
 
+    ///< Find the items whose parent board item matches \a aFilter.  Holes are left out, as they
+    ///< go with their pad or via, and so are the items without a parent.
+    std::vector<ITEM*> FindItemsByParent( const std::function<bool( const BOARD_ITEM* )>& aFilter );
+
     bool HasChildren() const
     {
         return !m_children.empty();
@@ -464,9 +473,10 @@ public:
     ///< Check if this branch contains an updated version of the m_item from the root branch.
     bool Overrides( ITEM* aItem ) const
     {
-        return m_override.find( aItem ) != m_override.end();
+        return m_override->find( aItem ) != m_override->end();
     }
 
+    ///< Replace the virtual vias with new ones at the joints that need them.
     void FixupVirtualVias();
 
     void AddRaw( ITEM* aItem, bool aAllowRedundant = false )
@@ -510,6 +520,11 @@ private:
     void releaseGarbage();
     void rebuildJoint( const JOINT* aJoint, const ITEM* aItem );
 
+    ///< Make the index, joints and overrides of this node its own before changing them.
+    void unshare();
+    void takePrivateCopy();
+    void detachFrom( const INDEX* aShared );
+
     bool isRoot() const
     {
         return m_parent == nullptr;
@@ -533,19 +548,24 @@ private:
     typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
     typedef JOINT_MAP::value_type TagJointPair;
 
-    JOINT_MAP       m_joints;           ///< hash table with the joints, linking the items. Joints
-                                        ///< are hashed by their position, layer set and net.
+    std::shared_ptr<JOINT_MAP> m_joints; ///< hash table with the joints, linking the items.
+                                         ///< Joints are hashed by their position, layer set
+                                         ///< and net.
 
     NODE*           m_parent;           ///< node this node was branched from
     NODE*           m_root;             ///< root node of the whole hierarchy
     std::set<NODE*> m_children;         ///< list of nodes branched from this one
 
-    std::unordered_set<ITEM*> m_override;   ///< hash of root's items that have been changed
-                                            ///< in this node
+    std::shared_ptr<std::unordered_set<ITEM*>> m_override; ///< hash of root's items that have
+                                                           ///< been changed in this node
 
     int             m_maxClearance;     ///< worst case item-item clearance
     RULE_RESOLVER*  m_ruleResolver;     ///< Design rules resolver
-    INDEX*          m_index;            ///< Geometric/Net index of the items
+    std::shared_ptr<INDEX> m_index;     ///< Geometric/Net index of the items
+
+    ///< False while the index, joints and overrides are the ones of the node this node was
+    ///< branched from, which are copied on the first change.
+    bool            m_ownsBranchData;
     int             m_depth;            ///< depth of the node (number of parent nodes in the
                                         ///< inheritance chain)
 
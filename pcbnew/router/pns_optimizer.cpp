@@ -19,6 +19,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <advanced_config.h>
+#include <core/thread_pool.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_rect.h>
 #include <geometry/shape_simple.h>
@@ -35,6 +37,7 @@
 #include "pns_utils.h"
 #include "pns_router.h"
 #include "pns_debug_decorator.h"
+#include "pns_profile.h"
 
 
 namespace PNS {
@@ -602,6 +605,8 @@ bool OPTIMIZER::mergeColinear( LINE* aLine )
 
 bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
 {
+    PROFILE::SCOPE profile( PROFILE::OPTIMIZE_PHASE );
+
     DEBUG_DECORATOR* dbg = ROUTER::GetInstance()->GetInterface()->GetDebugDecorator();
 
     if( aRoot )
@@ -1036,13 +1041,34 @@ int OPTIMIZER::smartPadsSingle( LINE* aLine, ITEM* aPad, bool aEnd, int aEndVert
     int              p_best     = -1;
     SHAPE_LINE_CHAIN l_best;
 
-    for( RtVariant& vp : variants )
+    // The collision checks are the expensive part and don't depend on each other; the choice
+    // is still made in order below so that it doesn't depend on the threads.
+    std::vector<uint8_t> clear( variants.size(), 0 );
+
+    auto checkVariant =
+            [&]( size_t aIdx )
+            {
+                LINE tmp( *aLine, std::get<2>( variants[aIdx] ) );
+                clear[aIdx] = !checkColliding( &tmp );
+            };
+
+    if( variants.size() > 1 && ADVANCED_CFG::GetCfg().m_ParallelRouter )
+    {
+        ParallelForEachIndex( variants.size(), checkVariant, TASK_PRIORITY::INTERACTIVE );
+    }
+    else
+    {
+        for( size_t ii = 0; ii < variants.size(); ++ii )
+            checkVariant( ii );
+    }
+
+    for( size_t ii = 0; ii < variants.size(); ++ii )
     {
-        LINE tmp( *aLine, std::get<2>( vp ) );
+        RtVariant& vp = variants[ii];
         int cost = COST_ESTIMATOR::CornerCost( std::get<2>( vp ) );
         long long int len = std::get<1>( vp );
 
-        if( !checkColliding( &tmp ) )
+        if( clear[ii] )
         {
             if( cost < min_cost || ( cost == min_cost && len > max_length ) )
             {
@@ -1097,6 +1123,8 @@ bool OPTIMIZER::runSmartPads( LINE* aLine )
 
 bool OPTIMIZER::Optimize( LINE* aLine, int aEffortLevel, NODE* aWorld, const VECTOR2I& aV )
 {
+    PROFILE::SCOPE profile( PROFILE::OPTIMIZE_PHASE );
+
     OPTIMIZER opt( aWorld );
 
     opt.SetEffortLevel( aEffortLevel );
@@ -1376,6 +1404,8 @@ bool OPTIMIZER::mergeDpSegments( DIFF_PAIR* aPair )
 
 bool OPTIMIZER::Optimize( DIFF_PAIR* aPair )
 {
+    PROFILE::SCOPE profile( PROFILE::OPTIMIZE_PHASE );
+
     return mergeDpSegments( aPair );
 }
 
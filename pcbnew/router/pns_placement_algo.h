@@ -198,6 +198,17 @@ public:
     virtual void GetModifiedNets( std::vector<NET_HANDLE> &aNets ) const
     {
     }
+
+    /**
+     * Function HasPendingWork
+     *
+     * Returns true if the last Move() stopped before it was done and should be called again
+     * with the same position to carry on.
+     */
+    virtual bool HasPendingWork() const
+    {
+        return false;
+    }
 };
 
 }
@@ -0,0 +1,73 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pns_profile.h"
+
+namespace PNS {
+
+std::atomic<bool>     PROFILE::s_enabled( false );
+std::atomic<uint64_t> PROFILE::s_counters[PROFILE::COUNTER_COUNT];
+std::atomic<int64_t>  PROFILE::s_phaseTimes[PROFILE::PHASE_COUNT];
+
+static thread_local int t_phaseDepth[PROFILE::PHASE_COUNT];
+
+
+PROFILE::SCOPE::SCOPE( PHASE aPhase ) :
+        m_phase( aPhase ),
+        m_tracked( s_enabled ),
+        m_active( false )
+{
+    if( !m_tracked )
+        return;
+
+    m_active = t_phaseDepth[aPhase]++ == 0;
+
+    if( m_active )
+        m_start = std::chrono::steady_clock::now();
+}
+
+
+PROFILE::SCOPE::~SCOPE()
+{
+    if( !m_tracked )
+        return;
+
+    t_phaseDepth[m_phase]--;
+
+    if( m_active )
+    {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+
+        s_phaseTimes[m_phase].fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count(),
+                std::memory_order_relaxed );
+    }
+}
+
+
+void PROFILE::Reset()
+{
+    for( std::atomic<uint64_t>& counter : s_counters )
+        counter = 0;
+
+    for( std::atomic<int64_t>& phaseTime : s_phaseTimes )
+        phaseTime = 0;
+}
+
+}
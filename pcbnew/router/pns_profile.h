@@ -0,0 +1,94 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PNS_PROFILE_H
+#define __PNS_PROFILE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace PNS {
+
+/**
+ * Counters and timers of the router's main phases, read by the benchmark mode of the log
+ * player.  They are off by default and cost a test of a flag when off.
+ *
+ * Phase times are inclusive: an optimization run by the shove counts in both phases.
+ */
+class PROFILE
+{
+public:
+    enum COUNTER
+    {
+        COLLISION_QUERIES = 0,
+        BRANCHES,
+        COUNTER_COUNT
+    };
+
+    enum PHASE
+    {
+        SHOVE_PHASE = 0,
+        WALKAROUND_PHASE,
+        OPTIMIZE_PHASE,
+        PHASE_COUNT
+    };
+
+    /**
+     * Add the time between its construction and its destruction to a phase.  Nested scopes
+     * of the same phase count once.
+     */
+    class SCOPE
+    {
+    public:
+        SCOPE( PHASE aPhase );
+        ~SCOPE();
+
+    private:
+        PHASE                                 m_phase;
+        bool                                  m_tracked;
+        bool                                  m_active;    ///< The outermost scope of its phase
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    static void Enable( bool aEnable ) { s_enabled = aEnable; }
+    static bool IsEnabled() { return s_enabled; }
+
+    static void Count( COUNTER aCounter )
+    {
+        if( s_enabled )
+            s_counters[aCounter].fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    static uint64_t Counter( COUNTER aCounter ) { return s_counters[aCounter].load(); }
+
+    /// @return the time spent in \a aPhase since the last Reset(), in microseconds.
+    static int64_t PhaseTime( PHASE aPhase ) { return s_phaseTimes[aPhase].load() / 1000; }
+
+    static void Reset();
+
+private:
+    static std::atomic<bool>     s_enabled;
+    static std::atomic<uint64_t> s_counters[COUNTER_COUNT];
+    static std::atomic<int64_t>  s_phaseTimes[PHASE_COUNT];    ///< In nanoseconds
+};
+
+}
+
+#endif    // __PNS_PROFILE_H
@@ -21,11 +21,14 @@
 
 #include <cstdio>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include <gal/graphics_abstraction_layer.h>
 
 #include <advanced_config.h>
+#include <core/thread_pool.h>
+#include <perf_trace.h>
 #include <settings/settings_manager.h>
 
 #include <pcb_painter.h>
@@ -34,6 +37,7 @@
 
 #include <geometry/shape.h>
 
+#include "pns_collision_memo.h"
 #include "pns_node.h"
 #include "pns_line_placer.h"
 #include "pns_line.h"
@@ -101,6 +105,22 @@ void ROUTER::SyncWorld()
 }
 
 
+bool ROUTER::UpdateWorld( const std::unordered_set<const BOARD_ITEM*>& aChanged )
+{
+    if( !m_world || RoutingInProgress() )
+        return false;
+
+    m_world->KillChildren();
+    m_placer.reset();
+
+    if( !m_iface->UpdateWorld( m_world.get(), aChanged ) )
+        return false;
+
+    m_world->FixupVirtualVias();
+    return true;
+}
+
+
 void ROUTER::ClearWorld()
 {
     if( m_world )
@@ -389,6 +409,8 @@ bool ROUTER::isStartingPointRoutable( const VECTOR2I& aWhere, ITEM* aStartItem,
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    SCOPED_TRACE_ZONE traceZone( "Router start" );
+
     GetRuleResolver()->ClearCaches();
 
     if( !isStartingPointRoutable( aP, aStartItem, aLayer ) )
@@ -449,6 +471,10 @@ bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 
 bool ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
+    SCOPED_TRACE_ZONE traceZone( "Router move" );
+
+    COLLISION_MEMO::Invalidate();
+
     if( m_logger )
         m_logger->Log( LOGGER::EVT_MOVE, aP, endItem );
 
@@ -649,32 +675,56 @@ void ROUTER::markViolations( NODE* aNode, ITEM_SET& aCurrent, NODE::ITEM_VECTOR&
                     aRemoved.push_back( itemToMark );
             };
 
-    for( ITEM* item : aCurrent.Items() )
-    {
-        NODE::OBSTACLES obstacles;
+    std::vector<ITEM*>&          items = aCurrent.Items();
+    std::vector<NODE::OBSTACLES> obstacles( items.size() );
 
-        aNode->QueryColliding( item, obstacles );
+    auto queryColliding =
+            [&]( size_t aIdx )
+            {
+                ITEM* item = items[aIdx];
 
-        if( item->OfKind( ITEM::LINE_T ) )
-        {
-            LINE* l = static_cast<LINE*>( item );
+                aNode->QueryColliding( item, obstacles[aIdx] );
 
-            if( l->EndsWithVia() )
-            {
-                VIA v( l->Via() );
-                aNode->QueryColliding( &v, obstacles );
-            }
-        }
+                if( item->OfKind( ITEM::LINE_T ) )
+                {
+                    LINE* l = static_cast<LINE*>( item );
+
+                    if( l->EndsWithVia() )
+                    {
+                        VIA v( l->Via() );
+                        aNode->QueryColliding( &v, obstacles[aIdx] );
+                    }
+                }
+            };
+
+    // The queries only read the node, so the lines of a large drag can be checked side by side.
+    // Marking and displaying the obstacles stays serial.
+    if( items.size() > 1 && ADVANCED_CFG::GetCfg().m_ParallelRouter )
+    {
+        ParallelForEachIndex( items.size(), queryColliding, TASK_PRIORITY::INTERACTIVE );
+    }
+    else
+    {
+        for( size_t ii = 0; ii < items.size(); ++ii )
+            queryColliding( ii );
+    }
 
-        ITEM_SET draggedItems;
+    std::unordered_set<const ITEM*> draggedItems;
 
-        if( GetDragger() )
-            draggedItems = GetDragger()->Traces();
+    if( GetDragger() )
+    {
+        for( const ITEM* dragged : GetDragger()->Traces().CItems() )
+            draggedItems.insert( dragged );
+    }
+
+    for( size_t ii = 0; ii < items.size(); ++ii )
+    {
+        ITEM* item = items[ii];
 
-        for( const OBSTACLE& obs : obstacles )
+        for( const OBSTACLE& obs : obstacles[ii] )
         {
             // Don't mark items being dragged; only board items they collide with
-            if( draggedItems.Contains( obs.m_item ) )
+            if( draggedItems.count( obs.m_item ) )
                 continue;
 
             obs.m_item->Mark( obs.m_item->Marker() | MK_VIOLATION );
@@ -857,6 +907,8 @@ void ROUTER::CommitRouting( NODE* aNode )
 
 bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForceFinish, bool aForceCommit )
 {
+    SCOPED_TRACE_ZONE traceZone( "Router fix" );
+
     bool rv = false;
 
     if( m_logger )
@@ -25,6 +25,7 @@
 #include <list>
 #include <memory>
 #include <optional>
+#include <unordered_set>
 #include <math/box2.h>
 
 #include "pns_routing_settings.h"
@@ -90,6 +91,18 @@ enum DRAG_MODE
     virtual ~ROUTER_IFACE() {};
 
     virtual void SyncWorld( NODE* aNode ) = 0;
+
+    /**
+     * Bring \a aNode up to date with the board after the items \a aChanged were added or
+     * changed, and others maybe removed, instead of syncing it anew.
+     *
+     * @return false if that can't be done, leaving \a aNode to be synced anew.
+     */
+    virtual bool UpdateWorld( NODE* aNode, const std::unordered_set<const BOARD_ITEM*>& aChanged )
+    {
+        return false;
+    }
+
     virtual void AddItem( ITEM* aItem ) = 0;
     virtual void UpdateItem( ITEM* aItem ) = 0;
     virtual void RemoveItem( ITEM* aItem ) = 0;
@@ -144,6 +157,14 @@ public:
     void ClearWorld();
     void SyncWorld();
 
+    /**
+     * Update the world with the board changes since it was synced, see
+     * ROUTER_IFACE::UpdateWorld().
+     *
+     * @return false if the world has to be synced anew.
+     */
+    bool UpdateWorld( const std::unordered_set<const BOARD_ITEM*>& aChanged );
+
     bool RoutingInProgress() const;
     bool StartRouting( const VECTOR2I& aP, ITEM* aItem, int aLayer );
     bool Move( const VECTOR2I& aP, ITEM* aItem );
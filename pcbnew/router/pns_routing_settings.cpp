@@ -42,6 +42,7 @@ ROUTING_SETTINGS::ROUTING_SETTINGS( JSON_SETTINGS* aParent, const std::string& a
     m_startDiagonal = false;
     m_shoveIterationLimit = 250;
     m_shoveTimeLimit = 1000;
+    m_shoveFrameTimeLimit = 0;
     m_walkaroundIterationLimit = 40;
     m_jumpOverObstacles = false;
     m_smoothDraggedSegments = true;
@@ -82,6 +83,8 @@ ROUTING_SETTINGS::ROUTING_SETTINGS( JSON_SETTINGS* aParent, const std::string& a
             },
             1000 ) );
 
+    m_params.emplace_back( new PARAM<int>( "shove_frame_time_limit", &m_shoveFrameTimeLimit, 0 ) );
+
     m_params.emplace_back( new PARAM<int>( "walkaround_iteration_limit", &m_walkaroundIterationLimit, 40 ) );
     m_params.emplace_back( new PARAM<bool>( "jump_over_obstacles",       &m_jumpOverObstacles, false ) );
 
@@ -131,6 +131,10 @@ public:
     int ShoveIterationLimit() const;
     TIME_LIMIT ShoveTimeLimit() const;
 
+    ///< Time a shove may take per mouse move before it carries on at the next one, or 0 when a
+    ///< shove must complete within a single move.
+    int ShoveFrameTimeLimit() const { return m_shoveFrameTimeLimit; }
+
     int WalkaroundIterationLimit() const { return m_walkaroundIterationLimit; };
     TIME_LIMIT WalkaroundTimeLimit() const;
 
@@ -181,6 +185,7 @@ private:
 
     int m_walkaroundIterationLimit;
     int m_shoveIterationLimit;
+    int m_shoveFrameTimeLimit;
     int m_viaForcePropIterationLimit;
     double m_walkaroundHugLengthThreshold;
 
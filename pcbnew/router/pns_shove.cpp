@@ -37,6 +37,7 @@
 #include "pns_utils.h"
 #include "pns_router.h"
 #include "pns_topology.h"
+#include "pns_profile.h"
 
 #include "time_limit.h"
 
@@ -158,6 +159,7 @@ SHOVE::SHOVE( NODE* aWorld, ROUTER* aRouter ) :
     m_multiLineMode = false;
     m_restrictSpringbackTagId = 0;
     m_springbackDoNotTouchNode = nullptr;
+    m_frameTimeLimit = 0;
 }
 
 
@@ -1486,20 +1488,28 @@ SHOVE::SHOVE_STATUS SHOVE::shoveIteration( int aIter )
  * long as they propagate further collisions, or until the iteration timeout or max iteration
  * count is reached.
  */
-SHOVE::SHOVE_STATUS SHOVE::shoveMainLoop()
+SHOVE::SHOVE_STATUS SHOVE::shoveMainLoop( bool aAllowSuspend, bool aResume )
 {
     SHOVE_STATUS st = SH_OK;
 
-    m_affectedArea = OPT_BOX2I();
-
     PNS_DBG( Dbg(), Message, wxString::Format( "ShoveStart [root: %d jts, current: %d jts]",
                                                m_root->JointCount(),
                                                m_currentNode->JointCount() ) );
 
     int iterLimit = Settings().ShoveIterationLimit();
     TIME_LIMIT timeLimit = Settings().ShoveTimeLimit();
+    TIME_LIMIT frameLimit( m_frameTimeLimit );
 
-    m_iter = 0;
+    // A resumed shove carries on with the iterations and time left over from the previous calls
+    if( aResume )
+    {
+        timeLimit.Set( std::max( 0, timeLimit.Get() - m_suspended.m_elapsed ) );
+    }
+    else
+    {
+        m_affectedArea = OPT_BOX2I();
+        m_iter = 0;
+    }
 
     timeLimit.Restart();
 
@@ -1526,12 +1536,31 @@ SHOVE::SHOVE_STATUS SHOVE::shoveMainLoop()
             st = SH_INCOMPLETE;
             break;
         }
+
+        if( aAllowSuspend && m_frameTimeLimit > 0 && frameLimit.Expired()
+                && !m_lineStack.empty() )
+        {
+            PNS_DBG( Dbg(), Message, wxString::Format( "Suspend [iter %d]", m_iter ) );
+            m_suspended.m_node = m_currentNode;
+            m_suspended.m_elapsed += timeLimit.Elapsed();
+            st = SH_INCOMPLETE;
+            break;
+        }
     }
 
     return st;
 }
 
 
+void SHOVE::dropSuspended()
+{
+    if( m_suspended.m_node )
+        delete m_suspended.m_node;
+
+    m_suspended = SUSPENDED_SHOVE();
+}
+
+
 OPT_BOX2I SHOVE::totalAffectedArea() const
 {
     OPT_BOX2I area;
@@ -1550,6 +1579,8 @@ OPT_BOX2I SHOVE::totalAffectedArea() const
 
 SHOVE::SHOVE_STATUS SHOVE::ShoveLines( const LINE& aCurrentHead )
 {
+    PROFILE::SCOPE profile( PROFILE::SHOVE_PHASE );
+
     SHOVE_STATUS st = SH_OK;
 
     m_multiLineMode = false;
@@ -1557,59 +1588,93 @@ SHOVE::SHOVE_STATUS SHOVE::ShoveLines( const LINE& aCurrentHead )
     PNS_DBG( Dbg(), Message,
              wxString::Format( "Shove start, lc = %d", aCurrentHead.SegmentCount() ) )
 
+    // A shove stopped at the frame time limit is resumed as long as the head doesn't change
+    bool resume = m_suspended.m_node && m_suspended.m_head.CLine() == aCurrentHead.CLine()
+                  && m_suspended.m_head.EndsWithVia() == aCurrentHead.EndsWithVia()
+                  && ( !aCurrentHead.EndsWithVia()
+                       || m_suspended.m_head.Via().Pos() == aCurrentHead.Via().Pos() );
+
+    if( !resume )
+        dropSuspended();
+
     // empty head? nothing to shove...
     if( !aCurrentHead.SegmentCount() && !aCurrentHead.EndsWithVia() )
         return SH_INCOMPLETE;
 
-    LINE head( aCurrentHead );
-    head.ClearLinks();
+    LINE  head( aCurrentHead );
+    NODE* parent;
 
-    m_lineStack.clear();
-    m_optimizerQueue.clear();
-    m_newHead = OPT_LINE();
+    if( resume )
+    {
+        PNS_DBG( Dbg(), Message, wxString::Format( "Resume [iter %d]", m_iter ) );
 
-    // Pop NODEs containing previous shoves which are no longer necessary
-    //
-    ITEM_SET headSet;
-    headSet.Add( aCurrentHead );
+        head = m_suspended.m_shovedHead;
+        parent = m_suspended.m_parent;
+        m_currentNode = m_suspended.m_node;
+        m_suspended.m_node = nullptr;
+    }
+    else
+    {
+        head.ClearLinks();
 
-    VIA_HANDLE dummyVia;
+        m_lineStack.clear();
+        m_optimizerQueue.clear();
+        m_newHead = OPT_LINE();
 
-    NODE* parent = reduceSpringback( headSet, dummyVia );
+        // Pop NODEs containing previous shoves which are no longer necessary
+        //
+        ITEM_SET headSet;
+        headSet.Add( aCurrentHead );
 
-    // Create a new NODE to store this version of the world
-    m_currentNode = parent->Branch();
-    m_currentNode->ClearRanks();
-    m_currentNode->Add( head );
+        VIA_HANDLE dummyVia;
 
-    m_currentNode->LockJoint( head.CPoint(0), &head, true );
+        parent = reduceSpringback( headSet, dummyVia );
 
-    if( !head.EndsWithVia() )
-        m_currentNode->LockJoint( head.CPoint( -1 ), &head, true );
+        // Create a new NODE to store this version of the world
+        m_currentNode = parent->Branch();
+        m_currentNode->ClearRanks();
+        m_currentNode->Add( head );
 
-    head.Mark( MK_HEAD );
-    head.SetRank( 100000 );
+        m_currentNode->LockJoint( head.CPoint(0), &head, true );
 
-    PNS_DBG( Dbg(), AddItem, &head, CYAN, 0, wxT( "head, after shove" ) );
+        if( !head.EndsWithVia() )
+            m_currentNode->LockJoint( head.CPoint( -1 ), &head, true );
 
-    if( head.EndsWithVia() )
-    {
-        std::unique_ptr< VIA >headVia = Clone( head.Via() );
-        headVia->Mark( MK_HEAD );
-        headVia->SetRank( 100000 );
-        m_currentNode->Add( std::move( headVia ) );
+        head.Mark( MK_HEAD );
+        head.SetRank( 100000 );
+
+        PNS_DBG( Dbg(), AddItem, &head, CYAN, 0, wxT( "head, after shove" ) );
+
+        if( head.EndsWithVia() )
+        {
+            std::unique_ptr< VIA >headVia = Clone( head.Via() );
+            headVia->Mark( MK_HEAD );
+            headVia->SetRank( 100000 );
+            m_currentNode->Add( std::move( headVia ) );
+        }
+
+        if( !pushLineStack( head ) )
+        {
+            delete m_currentNode;
+            m_currentNode = parent;
+
+            return SH_INCOMPLETE;
+        }
     }
 
-    if( !pushLineStack( head ) )
+    st = shoveMainLoop( true, resume );
+
+    if( IsSuspended() )
     {
-        delete m_currentNode;
+        // Keep the branch out of sight until the next call; the caller sees a failed shove
+        m_suspended.m_parent = parent;
+        m_suspended.m_head = aCurrentHead;
+        m_suspended.m_shovedHead = head;
         m_currentNode = parent;
 
         return SH_INCOMPLETE;
     }
 
-    st = shoveMainLoop();
-
     if( st == SH_OK )
     {
         runOptimizer( m_currentNode );
@@ -1653,8 +1718,12 @@ SHOVE::SHOVE_STATUS SHOVE::ShoveLines( const LINE& aCurrentHead )
 
 SHOVE::SHOVE_STATUS SHOVE::ShoveMultiLines( const ITEM_SET& aHeadSet )
 {
+    PROFILE::SCOPE profile( PROFILE::SHOVE_PHASE );
+
     SHOVE_STATUS st = SH_OK;
 
+    dropSuspended();
+
     m_multiLineMode = true;
 
     ITEM_SET headSet;
@@ -1752,8 +1821,12 @@ static VIA* findViaByHandle ( NODE *aNode, const VIA_HANDLE& handle )
 SHOVE::SHOVE_STATUS SHOVE::ShoveDraggingVia( const VIA_HANDLE aOldVia, const VECTOR2I& aWhere,
                                              VIA_HANDLE& aNewVia )
 {
+    PROFILE::SCOPE profile( PROFILE::SHOVE_PHASE );
+
     SHOVE_STATUS st = SH_OK;
 
+    dropSuspended();
+
     m_lineStack.clear();
     m_optimizerQueue.clear();
     m_newHead = OPT_LINE();
@@ -1957,6 +2030,8 @@ const LINE SHOVE::NewHead() const
 
 void SHOVE::SetInitialLine( LINE& aInitial )
 {
+    dropSuspended();
+
     m_root = m_root->Branch();
     m_root->Remove( aInitial );
 }
@@ -1964,6 +2039,8 @@ void SHOVE::SetInitialLine( LINE& aInitial )
 
 bool SHOVE::AddLockedSpringbackNode( NODE* aNode )
 {
+    dropSuspended();
+
     SPRINGBACK_TAG sp;
     sp.m_node = aNode;
     sp.m_locked = true;
@@ -1975,6 +2052,8 @@ bool SHOVE::AddLockedSpringbackNode( NODE* aNode )
 
 bool SHOVE::RewindSpringbackTo( NODE* aNode )
 {
+    dropSuspended();
+
     bool found = false;
 
     auto iter = m_nodeStack.begin();
@@ -2004,6 +2083,8 @@ bool SHOVE::RewindSpringbackTo( NODE* aNode )
 
 bool SHOVE::RewindToLastLockedNode()
 {
+    dropSuspended();
+
     if( m_nodeStack.empty() )
         return false;
 
@@ -2016,6 +2097,8 @@ bool SHOVE::RewindToLastLockedNode()
 
 void SHOVE::UnlockSpringbackNode( NODE* aNode )
 {
+    dropSuspended();
+
     auto iter = m_nodeStack.begin();
 
     while( iter != m_nodeStack.end() )
@@ -87,12 +87,32 @@ public:
     void DisablePostShoveOptimizations( int aMask );
     void SetSpringbackDoNotTouchNode( const NODE *aNode );
 
+    /**
+     * Let ShoveLines() stop after \a aMilliseconds and resume where it stopped when it is next
+     * called with the same head, until the shove iteration and time limits are used up.  Until
+     * then it fails, as if the shove didn't succeed.  0 disables this.
+     */
+    void SetFrameTimeLimit( int aMilliseconds ) { m_frameTimeLimit = aMilliseconds; }
+
+    ///< Return true if the last ShoveLines() call stopped at the frame time limit.
+    bool IsSuspended() const { return m_suspended.m_node != nullptr; }
+
 private:
     typedef std::vector<SHAPE_LINE_CHAIN> HULL_SET;
     typedef std::optional<LINE> OPT_LINE;
     typedef std::pair<LINE, LINE> LINE_PAIR;
     typedef std::vector<LINE_PAIR> LINE_PAIR_VEC;
 
+    ///< The state of a ShoveLines() call stopped at the frame time limit.
+    struct SUSPENDED_SHOVE
+    {
+        NODE* m_node = nullptr;     ///< the branch being shoved
+        NODE* m_parent = nullptr;   ///< the node it was branched from
+        LINE  m_head;               ///< the head passed to ShoveLines()
+        LINE  m_shovedHead;         ///< the marked copy of the head in m_node
+        int   m_elapsed = 0;        ///< time spent shoving so far, in ms
+    };
+
     struct SPRINGBACK_TAG
     {
         SPRINGBACK_TAG() :
@@ -153,7 +173,9 @@ private:
     OPT_BOX2I                   m_affectedArea;
 
     SHOVE_STATUS shoveIteration( int aIter );
-    SHOVE_STATUS shoveMainLoop();
+    SHOVE_STATUS shoveMainLoop( bool aAllowSuspend = false, bool aResume = false );
+
+    void dropSuspended();
 
     int getClearance( const ITEM* aA, const ITEM* aB ) const;
     bool fixupViaCollisions( const LINE* aCurrent, OBSTACLE& obs );
@@ -178,6 +200,9 @@ private:
     bool m_multiLineMode;
 
     int m_optFlagDisableMask;
+
+    int                         m_frameTimeLimit;
+    SUSPENDED_SHOVE             m_suspended;
 };
 
 }
@@ -23,7 +23,10 @@
 #include <functional>
 using namespace std::placeholders;
 
+#include <advanced_config.h>
+#include <footprint.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <pad.h>
 #include <pcb_painter.h>
 #include <pcbnew_settings.h>
 
@@ -56,6 +59,9 @@ TOOL_BASE::TOOL_BASE( const std::string& aToolName ) :
     m_gridHelper = nullptr;
 
     m_cancelled = false;
+
+    m_syncedBoard = nullptr;
+    m_incrementalSyncValid = false;
 }
 
 
@@ -69,6 +75,24 @@ TOOL_BASE::~TOOL_BASE()
 
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
+    if( m_syncedBoard != board() )
+    {
+        m_syncedBoard = board();
+        m_incrementalSyncValid = false;
+
+        if( m_syncedBoard )
+            m_syncedBoard->AddListener( this );
+    }
+
+    // Keep the world of the previous run if only board items changed since
+    if( aReason == RUN && m_router && m_incrementalSyncValid
+            && ADVANCED_CFG::GetCfg().m_IncrementalRouterSync )
+    {
+        syncWorld();
+        m_router->UpdateSizes( m_savedSizes );
+        return;
+    }
+
     delete m_gridHelper;
     delete m_router;
     delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
@@ -80,8 +104,8 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
 
     m_router = new ROUTER;
     m_router->SetInterface( m_iface );
-    m_router->ClearWorld();
-    m_router->SyncWorld();
+    m_incrementalSyncValid = false;
+    syncWorld();
 
     m_router->UpdateSizes( m_savedSizes );
 
@@ -96,6 +120,115 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
 }
 
 
+void TOOL_BASE::syncWorld()
+{
+    bool updated = m_incrementalSyncValid && ADVANCED_CFG::GetCfg().m_IncrementalRouterSync
+                   && m_router->UpdateWorld( m_changedItems );
+
+    if( !updated )
+    {
+        m_router->ClearWorld();
+        m_router->SyncWorld();
+    }
+
+    m_changedItems.clear();
+    m_incrementalSyncValid = true;
+}
+
+
+void TOOL_BASE::recordChange( BOARD_ITEM* aItem, bool aRemoved )
+{
+    if( !m_incrementalSyncValid )
+        return;
+
+    // Past a few thousand changes, syncing anew is about as fast
+    const size_t MAX_INCREMENTAL_CHANGES = 5000;
+
+    // The board outline shapes the keepouts of the world, and the edge exclusions of
+    // castellated pads can't be taken out one by one
+    auto needsFullSync =
+            []( const BOARD_ITEM* aChild )
+            {
+                if( const PAD* pad = dynamic_cast<const PAD*>( aChild ) )
+                    return pad->GetProperty() == PAD_PROP::CASTELLATED;
+
+                return aChild->Type() != PCB_FOOTPRINT_T && aChild->IsOnLayer( Edge_Cuts );
+            };
+
+    bool fullSync = aItem->Type() == PCB_NETINFO_T || needsFullSync( aItem )
+                    || m_changedItems.size() >= MAX_INCREMENTAL_CHANGES;
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        static_cast<FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    fullSync |= needsFullSync( aChild );
+                } );
+    }
+
+    if( fullSync )
+    {
+        m_incrementalSyncValid = false;
+        m_changedItems.clear();
+        return;
+    }
+
+    // The world finds the removed items by itself; it only has to know what to sync again
+    if( aRemoved )
+        m_changedItems.erase( aItem );
+    else
+        m_changedItems.insert( aItem );
+}
+
+
+void TOOL_BASE::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    recordChange( aBoardItem, false );
+}
+
+
+void TOOL_BASE::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        recordChange( item, false );
+}
+
+
+void TOOL_BASE::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    recordChange( aBoardItem, true );
+}
+
+
+void TOOL_BASE::OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        recordChange( item, true );
+}
+
+
+void TOOL_BASE::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    recordChange( aBoardItem, false );
+}
+
+
+void TOOL_BASE::OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        recordChange( item, false );
+}
+
+
+void TOOL_BASE::OnBoardNetSettingsChanged( BOARD& aBoard )
+{
+    // Net classes and rules may have changed the clearances anywhere
+    m_incrementalSyncValid = false;
+    m_changedItems.clear();
+}
+
+
 ITEM* TOOL_BASE::pickSingleItem( const VECTOR2I& aWhere, NET_HANDLE aNet, int aLayer,
                                  bool aIgnorePads, const std::vector<ITEM*> aAvoidItems )
 {
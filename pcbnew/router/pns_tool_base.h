@@ -24,9 +24,11 @@
 #define __PNS_TOOL_BASE_H
 
 #include <memory>
+#include <unordered_set>
 
 #include <math/vector2d.h>
 #include <tools/pcb_tool_base.h>
+#include <board.h>
 #include <board_commit.h>
 
 #include <widgets/msgpanel.h>
@@ -41,7 +43,7 @@ class PNS_TUNE_STATUS_POPUP;
 namespace PNS
 {
 
-class TOOL_BASE : public PCB_TOOL_BASE
+class TOOL_BASE : public PCB_TOOL_BASE, public BOARD_LISTENER
 {
 public:
     TOOL_BASE( const std::string& aToolName );
@@ -53,7 +55,26 @@ public:
 
     PNS_KICAD_IFACE* GetInterface() const;
 
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardNetSettingsChanged( BOARD& aBoard ) override;
+
 protected:
+    /**
+     * Bring the router world up to date with the board: incrementally when only items were
+     * changed since it was last synced, else from the whole board.
+     */
+    void syncWorld();
+
+    /**
+     * Record a board change for the next incremental sync of the world.
+     */
+    void recordChange( BOARD_ITEM* aItem, bool aRemoved );
+
     bool checkSnap( ITEM* aItem );
 
     const VECTOR2I snapToItem( ITEM* aSnapToItem, const VECTOR2I& aP);
@@ -80,6 +101,11 @@ protected:
     ROUTER*          m_router;
 
     bool             m_cancelled;
+
+    // The board the world was synced from, and the changes made to it since
+    BOARD*                                m_syncedBoard;
+    bool                                  m_incrementalSyncValid;
+    std::unordered_set<const BOARD_ITEM*> m_changedItems;
 };
 
 }
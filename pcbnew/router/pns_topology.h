@@ -76,7 +76,7 @@ public:
      * that are fully inside pads, and truncates segments that cross into a pad (adding a straight-
      * line segment from the intersection to the pad anchor).
      *
-     * @note When changing this, sync with BOARD::GetTrackLength()
+     * @note When changing this, sync with NET_LENGTH_CACHE::measureItem()
      *
      * @param aStart is the item to assemble a path from.
      * @param aStartPad will be filled with the starting pad of the path, if found.
@@ -21,6 +21,8 @@
 
 #include <optional>
 
+#include <advanced_config.h>
+#include <core/thread_pool.h>
 #include <geometry/shape_line_chain.h>
 
 #include "pns_walkaround.h"
@@ -28,6 +30,7 @@
 #include "pns_router.h"
 #include "pns_debug_decorator.h"
 #include "pns_solid.h"
+#include "pns_profile.h"
 
 
 namespace PNS {
@@ -145,8 +148,41 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath, bool aWinding
 }
 
 
+void WALKAROUND::stepPaths( LINE& aPathCw, WALKAROUND_STATUS& aStatusCw, bool aStepCw,
+                            LINE& aPathCcw, WALKAROUND_STATUS& aStatusCcw, bool aStepCcw )
+{
+    // The two walks only read the world and each has its own obstacle, so they can run side by
+    // side.  The debug decorator can't be fed from two threads though.
+    bool parallel = aStepCw && aStepCcw && ADVANCED_CFG::GetCfg().m_ParallelRouter
+                    && !( Dbg() && Dbg()->IsDebugEnabled() );
+
+    if( parallel )
+    {
+        ParallelForEachIndex( 2,
+                [&]( size_t aIdx )
+                {
+                    if( aIdx == 0 )
+                        aStatusCw = singleStep( aPathCw, true );
+                    else
+                        aStatusCcw = singleStep( aPathCcw, false );
+                },
+                TASK_PRIORITY::INTERACTIVE );
+
+        return;
+    }
+
+    if( aStepCw )
+        aStatusCw = singleStep( aPathCw, true );
+
+    if( aStepCcw )
+        aStatusCcw = singleStep( aPathCcw, false );
+}
+
+
 const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 {
+    PROFILE::SCOPE profile( PROFILE::WALKAROUND_PHASE );
+
     LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
     WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
     SHAPE_LINE_CHAIN best_path;
@@ -184,11 +220,8 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 
     while( m_iteration < m_iterationLimit )
     {
-        if( s_cw != STUCK && s_cw != ALMOST_DONE )
-            s_cw = singleStep( path_cw, true );
-
-        if( s_ccw != STUCK && s_ccw != ALMOST_DONE )
-            s_ccw = singleStep( path_ccw, false );
+        stepPaths( path_cw, s_cw, s_cw != STUCK && s_cw != ALMOST_DONE,
+                   path_ccw, s_ccw, s_ccw != STUCK && s_ccw != ALMOST_DONE );
 
         if( s_cw != IN_PROGRESS )
         {
@@ -268,6 +301,8 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath, LINE& aWalkPath,
                                                  bool aOptimize )
 {
+    PROFILE::SCOPE profile( PROFILE::WALKAROUND_PHASE );
+
     LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
     WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
     SHAPE_LINE_CHAIN best_path;
@@ -303,11 +338,7 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath, LINE&
         if( path_ccw.PointCount() == 0 )
             s_ccw = STUCK; // ccw path is empty, can't continue
 
-        if( s_cw != STUCK )
-            s_cw = singleStep( path_cw, true );
-
-        if( s_ccw != STUCK )
-            s_ccw = singleStep( path_ccw, false );
+        stepPaths( path_cw, s_cw, s_cw != STUCK, path_ccw, s_ccw, s_ccw != STUCK );
 
         if( ( s_cw == DONE && s_ccw == DONE ) || ( s_cw == STUCK && s_ccw == STUCK ) )
         {
@@ -121,6 +121,12 @@ private:
     void start( const LINE& aInitialPath );
 
     WALKAROUND_STATUS singleStep( LINE& aPath, bool aWindingDirection );
+
+    ///< Advance the clockwise and/or the counter-clockwise path by one step, concurrently
+    ///< when both are stepped.
+    void stepPaths( LINE& aPathCw, WALKAROUND_STATUS& aStatusCw, bool aStepCw, LINE& aPathCcw,
+                    WALKAROUND_STATUS& aStatusCcw, bool aStepCcw );
+
     NODE::OPT_OBSTACLE nearestObstacle( const LINE& aPath );
 
     NODE* m_world;
@@ -205,7 +205,8 @@ ROUTER_TOOL::ROUTER_TOOL() :
         TOOL_BASE( "pcbnew.InteractiveRouter" ),
         m_lastTargetLayer( UNDEFINED_LAYER ),
         m_originalActiveLayer( UNDEFINED_LAYER ),
-        m_inRouterTool( false )
+        m_inRouterTool( false ),
+        m_resumePending( false )
 {
 }
 
@@ -565,6 +566,8 @@ void ROUTER_TOOL::Reset( RESET_REASON aReason )
 
     if( aReason == RUN )
         TOOL_BASE::Reset( aReason );
+    else
+        m_syncedBoard = nullptr;    // New board, rules, stackup or view: sync the world anew
 }
 
 // Saves the complete event log and the dump of the PCB, allowing us to
@@ -1347,10 +1350,24 @@ void ROUTER_TOOL::performRouting()
 
         handleCommonEvents( *evt );
 
-        if( evt->IsMotion() )
+        if( evt->IsMotion() || evt->IsAction( &ACTIONS::refreshPreview ) )
         {
             updateEndItem( *evt );
             m_router->Move( m_endSnapPoint, m_endItem );
+
+            // A shove which ran out of time for this move carries on once the events that came
+            // in meanwhile have been handled and the canvas was repainted
+            if( m_router->Placer() && m_router->Placer()->HasPendingWork() && !m_resumePending )
+            {
+                m_resumePending = true;
+
+                frame()->CallAfter(
+                        [this]()
+                        {
+                            m_resumePending = false;
+                            m_toolMgr->RunAction( ACTIONS::refreshPreview );
+                        } );
+            }
         }
         else if( evt->IsAction( &PCB_ACTIONS::routerUndoLastSegment )
                     || evt->IsAction( &ACTIONS::doDelete )
@@ -1799,7 +1816,7 @@ int ROUTER_TOOL::MainLoop( const TOOL_EVENT& aEvent )
         }
         else if( evt->Action() == TA_UNDO_REDO_POST || evt->Action() == TA_MODEL_CHANGE )
         {
-            m_router->SyncWorld();
+            syncWorld();
         }
         else if( evt->IsMotion() )
         {
@@ -97,6 +97,7 @@ private:
     PCB_LAYER_ID                 m_originalActiveLayer;
 
     bool                         m_inRouterTool;         // Re-entrancy guard
+    bool                         m_resumePending;        // A shove resume is queued
 };
 
 #endif
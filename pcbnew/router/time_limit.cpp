@@ -42,6 +42,12 @@ bool TIME_LIMIT::Expired() const
 }
 
 
+int TIME_LIMIT::Elapsed() const
+{
+    return static_cast<int>( wxGetLocalTimeMillis().GetValue() - m_startTics );
+}
+
+
 void TIME_LIMIT::Restart()
 {
     m_startTics = wxGetLocalTimeMillis().GetValue();
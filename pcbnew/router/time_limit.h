@@ -35,6 +35,9 @@ public:
     bool Expired() const;
     void Restart();
 
+    ///< Return the time since the last restart, in milliseconds.
+    int Elapsed() const;
+
     void Set( int aMilliseconds );
     int Get() const { return m_limitMs; }
 
@@ -347,6 +347,7 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
     {
         PCB_TRACK* track = aBoard->Tracks().back();
         aBoard->Tracks().pop_back();
+        aBoard->UncacheItemById( track );
 
         if( track->IsLocked() )
         {
@@ -361,6 +362,7 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
         }
     }
 
+    aBoard->InvalidateNetItems();
     aBoard->DeleteMARKERs();
 
     buildLayerMaps( aBoard );
@@ -32,6 +32,7 @@
 #include <board_commit.h>
 
 #include <connectivity/connectivity_data.h>
+#include <core/thread_pool.h>
 #include <teardrop/teardrop.h>
 #include <drc/drc_rtree.h>
 #include <geometry/shape_line_chain.h>
@@ -180,6 +181,7 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
     }
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    std::vector<TEARDROP_JOB>          jobs;
 
     for( PCB_TRACK* track : m_board->Tracks() )
     {
@@ -221,21 +223,10 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
                 // The track is entirely inside the pad; cannot create a teardrop
                 continue;
 
-            // Skip case where pad and the track are within a copper zone with the same net
-            // (and the pad can be connected to the zone)
-            if( !tdParams.m_TdOnPadsInZones && areItemsInSameZone( pad, track ) )
-                continue;
-
-            std::vector<VECTOR2I> points;
-
-            if( computeTeardropPolygon( tdParams, points, track, pad, pad->GetPosition() ) )
-            {
-                ZONE* new_teardrop = createTeardrop( TD_TYPE_PADVIA, points, track );
-                m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                m_createdTdList.push_back( new_teardrop );
-
-                aCommit.Added( new_teardrop );
-            }
+            // The case where pad and the track are within a copper zone with the same net
+            // (and the pad can be connected to the zone) is skipped when the shape is built
+            jobs.push_back( { TD_TYPE_PADVIA, tdParams, track, pad, pad->GetPosition(),
+                              !tdParams.m_TdOnPadsInZones } );
         }
 
         for( PCB_VIA* via : connectedVias )
@@ -262,19 +253,12 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
                 // The track is entirely inside the via; cannot create a teardrop
                 continue;
 
-            std::vector<VECTOR2I> points;
-
-            if( computeTeardropPolygon( tdParams, points, track, via, via->GetPosition() ) )
-            {
-                ZONE* new_teardrop = createTeardrop( TD_TYPE_PADVIA, points, track );
-                m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                m_createdTdList.push_back( new_teardrop );
-
-                aCommit.Added( new_teardrop );
-            }
+            jobs.push_back( { TD_TYPE_PADVIA, tdParams, track, via, via->GetPosition(), false } );
         }
     }
 
+    buildTeardrops( aCommit, jobs );
+
     if( ( aForceFullUpdate || !dirtyTracks->empty() )
         && m_prmsList->GetParameters( TARGET_TRACK )->m_Enabled )
     {
@@ -350,6 +334,7 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
 {
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
     TEARDROP_PARAMETERS                params = *m_prmsList->GetParameters( TARGET_TRACK );
+    std::vector<TEARDROP_JOB>          jobs;
 
     // Explore groups (a group is a set of tracks on the same layer and the same net):
     for( auto& grp : m_trackLookupList.GetBuffer() )
@@ -443,19 +428,42 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
                 if( existingPadOrVia )
                     continue;
 
-                std::vector<VECTOR2I> points;
-
-                if( computeTeardropPolygon( params, points, track, candidate, pos ) )
-                {
-                    ZONE* new_teardrop = createTeardrop( TD_TYPE_TRACKEND, points, track );
-                    m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                    m_createdTdList.push_back( new_teardrop );
-
-                    aCommit.Added( new_teardrop );
-                }
+                jobs.push_back( { TD_TYPE_TRACKEND, params, track, candidate, pos, false } );
             }
         }
     }
+
+    buildTeardrops( aCommit, jobs );
+}
+
+
+void TEARDROP_MANAGER::buildTeardrops( BOARD_COMMIT& aCommit, std::vector<TEARDROP_JOB>& aJobs )
+{
+    // The shapes only depend on the items and on the track caches, which are not modified
+    // until all of them are computed
+    ParallelForEachIndex( aJobs.size(),
+            [&]( size_t ii )
+            {
+                TEARDROP_JOB& job = aJobs[ii];
+
+                if( job.m_skipInSameZone && areItemsInSameZone( job.m_other, job.m_track ) )
+                    return;
+
+                job.m_valid = computeTeardropPolygon( job.m_params, job.m_points, job.m_track,
+                                                      job.m_other, job.m_otherPos );
+            } );
+
+    for( TEARDROP_JOB& job : aJobs )
+    {
+        if( !job.m_valid )
+            continue;
+
+        ZONE* new_teardrop = createTeardrop( job.m_variant, job.m_points, job.m_track );
+        m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
+        m_createdTdList.push_back( new_teardrop );
+
+        aCommit.Added( new_teardrop );
+    }
 }
 
 
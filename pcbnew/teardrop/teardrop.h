@@ -230,6 +230,27 @@ private:
 
     void buildTrackCaches();
 
+    /**
+     * A teardrop to build between a track and a pad, a via or another track.
+     */
+    struct TEARDROP_JOB
+    {
+        TEARDROP_VARIANT      m_variant;
+        TEARDROP_PARAMETERS   m_params;
+        PCB_TRACK*            m_track;
+        BOARD_ITEM*           m_other;
+        VECTOR2I              m_otherPos;
+        bool                  m_skipInSameZone;  ///< skip it if both items are inside a zone
+        std::vector<VECTOR2I> m_points;
+        bool                  m_valid = false;
+    };
+
+    /**
+     * Compute the shapes of \a aJobs in parallel, then add the buildable ones to the board and
+     * to \a aCommit, in the order of \a aJobs.
+     */
+    void buildTeardrops( BOARD_COMMIT& aCommit, std::vector<TEARDROP_JOB>& aJobs );
+
 private:
     int                       m_tolerance;      // max dist between track end point and pad/via
                                                 //   center to see them connected to ut a teardrop
@@ -700,6 +700,8 @@ int BOARD_EDITOR_CONTROL::ToggleSearch( const TOOL_EVENT& aEvent )
 
 int BOARD_EDITOR_CONTROL::TogglePythonConsole( const TOOL_EVENT& aEvent )
 {
+    // The console may have changed the board without going through a commit
+    m_frame->GetBoard()->ClearSavedText();
     m_frame->ScriptingConsoleEnableDisable();
     return 0;
 }
@@ -1288,13 +1290,13 @@ static bool mergeZones( EDA_DRAW_FRAME* aFrame, BOARD_COMMIT& aCommit,
 {
     aCommit.Modify( aOriginZones[0] );
 
+    // A single union of all the outlines, which also simplifies the result
+    SHAPE_POLY_SET::BOOLEAN_CHAIN merged( *aOriginZones[0]->Outline() );
+
     for( unsigned int i = 1; i < aOriginZones.size(); i++ )
-    {
-        aOriginZones[0]->Outline()->BooleanAdd( *aOriginZones[i]->Outline(),
-                                                SHAPE_POLY_SET::PM_FAST );
-    }
+        merged.Add( *aOriginZones[i]->Outline() );
 
-    aOriginZones[0]->Outline()->Simplify( SHAPE_POLY_SET::PM_FAST );
+    merged.Finish( *aOriginZones[0]->Outline() );
 
     // We should have one polygon, possibly with holes.  If we end up with two polygons (either
     // because the intersection was a single point or because the intersection was within one of
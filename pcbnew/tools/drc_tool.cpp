@@ -37,13 +37,31 @@
 #include <drc/drc_item.h>
 #include <netlist_reader/pcb_netlist.h>
 #include <macros.h>
+#include <advanced_config.h>
+#include <footprint.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <view/view.h>
+#include <wx/filename.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+
+/// Beyond this many changed areas an incremental run isn't worth it
+static const size_t MAX_INCREMENTAL_AREAS = 500;
+
 
 DRC_TOOL::DRC_TOOL() :
         PCB_TOOL_BASE( "pcbnew.DRCTool" ),
         m_editFrame( nullptr ),
         m_pcb( nullptr ),
         m_drcDialog( nullptr ),
-        m_drcRunning( false )
+        m_drcRunning( false ),
+        m_incrementalValid( false ),
+        m_lastReportAllTrackErrors( false ),
+        m_lastTestFootprints( false ),
+        m_lastRulesTimestamp( 0 )
 {
 }
 
@@ -63,7 +81,9 @@ void DRC_TOOL::Reset( RESET_REASON aReason )
             DestroyDRCDialog();
 
         m_pcb = m_editFrame->GetBoard();
+        m_pcb->AddListener( this );
         m_drcEngine = m_pcb->GetDesignSettings().m_DRCEngine;
+        m_incrementalValid = false;
     }
 }
 
@@ -171,17 +191,75 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 
     m_drcEngine->SetProgressReporter( aProgressReporter );
 
+    KIGFX::VIEW* view = m_editFrame->GetCanvas()->GetView();
+
+    // The new markers are diffed against the existing ones: those reported again are kept as
+    // they are (along with their exclusions), and only the others are touched
+    std::unordered_multimap<PCB_MARKER::VIOLATION_ID, PCB_MARKER*,
+                            PCB_MARKER::VIOLATION_ID_HASH> previousMarkers;
+
+    // Note that any refilled zones have been recorded as changes by now
+    if( CanRunIncrementally( aReportAllTrackErrors, aTestFootprints ) )
+    {
+        m_drcEngine->SetIncrementalAreas( m_changedAreas );
+
+        // Only the markers the run will report again (if they still apply) are diffed; the
+        // others are kept
+        for( PCB_MARKER* marker : m_pcb->Markers() )
+        {
+            if( m_drcEngine->IsIncrementalViolation( marker->GetRCItem().get(),
+                                                     marker->GetPosition() ) )
+            {
+                previousMarkers.emplace( marker->GetViolationId(), marker );
+            }
+        }
+    }
+    else
+    {
+        m_drcEngine->ClearIncrementalAreas();
+
+        previousMarkers.reserve( m_pcb->Markers().size() );
+
+        for( PCB_MARKER* marker : m_pcb->Markers() )
+            previousMarkers.emplace( marker->GetViolationId(), marker );
+    }
+
     m_drcEngine->SetViolationHandler(
             [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
             {
                 PCB_MARKER* marker = new PCB_MARKER( aItem, aPos, aLayer );
+                auto        it = previousMarkers.find( marker->GetViolationId() );
+
+                if( it != previousMarkers.end() )
+                {
+                    previousMarkers.erase( it );
+                    delete marker;
+                    return;
+                }
+
                 commit.Add( marker );
             } );
 
     m_drcEngine->RunTests( m_editFrame->GetUserUnits(), aReportAllTrackErrors, aTestFootprints );
 
+    if( !previousMarkers.empty() )
+    {
+        std::unordered_set<PCB_MARKER*> staleMarkers;
+        std::vector<KIGFX::VIEW_ITEM*>  staleItems;
+
+        for( const auto& [ id, marker ] : previousMarkers )
+        {
+            staleMarkers.insert( marker );
+            staleItems.push_back( marker );
+        }
+
+        view->RemoveItems( staleItems );
+        m_pcb->DeleteMARKERs( staleMarkers );
+    }
+
     m_drcEngine->SetProgressReporter( nullptr );
     m_drcEngine->ClearViolationHandler();
+    m_drcEngine->ClearIncrementalAreas();
 
     if( m_drcDialog )
     {
@@ -193,6 +271,11 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 
     commit.Push( _( "DRC" ), SKIP_UNDO | SKIP_SET_DIRTY );
 
+    if( aProgressReporter->IsCancelled() )
+        m_incrementalValid = false;
+    else
+        recordCompletedRun( aReportAllTrackErrors, aTestFootprints );
+
     m_drcRunning = false;
 
     m_editFrame->ShowSolderMask();
@@ -202,6 +285,124 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 }
 
 
+bool DRC_TOOL::CanRunIncrementally( bool aReportAllTrackErrors, bool aTestFootprints ) const
+{
+    return ADVANCED_CFG::GetCfg().m_IncrementalDRC
+            && m_incrementalValid
+            && aReportAllTrackErrors == m_lastReportAllTrackErrors
+            && aTestFootprints == m_lastTestFootprints
+            && rulesTimestamp() == m_lastRulesTimestamp;
+}
+
+
+long long DRC_TOOL::rulesTimestamp() const
+{
+    wxFileName rulesFile( m_editFrame->GetDesignRulesPath() );
+
+    if( !rulesFile.FileExists() )
+        return 0;
+
+    return rulesFile.GetModificationTime().GetValue().GetValue();
+}
+
+
+void DRC_TOOL::recordCompletedRun( bool aReportAllTrackErrors, bool aTestFootprints )
+{
+    m_itemBoxes.clear();
+    m_changedAreas.clear();
+
+    auto record =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                m_itemBoxes[ aItem->m_Uuid ] = aItem->GetBoundingBox();
+            };
+
+    for( PCB_TRACK* track : m_pcb->Tracks() )
+        record( track );
+
+    for( FOOTPRINT* footprint : m_pcb->Footprints() )
+        record( footprint );
+
+    for( BOARD_ITEM* item : m_pcb->Drawings() )
+        record( item );
+
+    for( ZONE* zone : m_pcb->Zones() )
+        record( zone );
+
+    m_lastReportAllTrackErrors = aReportAllTrackErrors;
+    m_lastTestFootprints = aTestFootprints;
+    m_lastRulesTimestamp = rulesTimestamp();
+    m_incrementalValid = true;
+}
+
+
+void DRC_TOOL::recordChange( const BOARD_ITEM* aItem )
+{
+    if( !m_incrementalValid || aItem->Type() == PCB_MARKER_T )
+        return;
+
+    // Net changes can change which rules apply anywhere on the board
+    if( aItem->Type() == PCB_NETINFO_T || m_changedAreas.size() >= MAX_INCREMENTAL_AREAS )
+    {
+        m_incrementalValid = false;
+        return;
+    }
+
+    auto it = m_itemBoxes.find( aItem->m_Uuid );
+
+    if( it != m_itemBoxes.end() )
+        m_changedAreas.push_back( it->second );
+
+    m_changedAreas.push_back( aItem->GetBoundingBox() );
+}
+
+
+void DRC_TOOL::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    recordChange( aBoardItem );
+}
+
+
+void DRC_TOOL::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        recordChange( item );
+}
+
+
+void DRC_TOOL::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    recordChange( aBoardItem );
+}
+
+
+void DRC_TOOL::OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        recordChange( item );
+}
+
+
+void DRC_TOOL::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    recordChange( aBoardItem );
+}
+
+
+void DRC_TOOL::OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        recordChange( item );
+}
+
+
+void DRC_TOOL::OnBoardNetSettingsChanged( BOARD& aBoard )
+{
+    // Board setup changes (rules, severities, netclasses...) need a full run
+    m_incrementalValid = false;
+}
+
+
 void DRC_TOOL::updatePointers( bool aDRCWasCancelled )
 {
     // update my pointers, m_editFrame is the only unchangeable one
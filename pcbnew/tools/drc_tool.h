@@ -29,6 +29,7 @@
 #include <pcb_marker.h>
 #include <geometry/seg.h>
 #include <geometry/shape_poly_set.h>
+#include <map>
 #include <memory>
 #include <vector>
 #include <tools/pcb_tool_base.h>
@@ -41,7 +42,7 @@ class WX_PROGRESS_REPORTER;
 class DRC_ENGINE;
 
 
-class DRC_TOOL : public PCB_TOOL_BASE
+class DRC_TOOL : public PCB_TOOL_BASE, public BOARD_LISTENER
 {
 public:
     DRC_TOOL();
@@ -79,10 +80,29 @@ public:
 
     /**
      * Run the DRC tests.
+     *
+     * If CanRunIncrementally(), only the neighbourhood of the changes made since the previous
+     * run is re-tested, and only the stale markers are replaced.  Otherwise the caller must have
+     * deleted the markers of the previous run.
      */
     void RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones,
                    bool aReportAllTrackErrors, bool aTestFootprints );
 
+    /**
+     * @return true if the next run with the given options can be an incremental one: the
+     *         previous run completed with the same options and rules, and no more than a few
+     *         hundred items have changed since.
+     */
+    bool CanRunIncrementally( bool aReportAllTrackErrors, bool aTestFootprints ) const;
+
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardNetSettingsChanged( BOARD& aBoard ) override;
+
     int PrevMarker( const TOOL_EVENT& aEvent );
     int NextMarker( const TOOL_EVENT& aEvent );
     int CrossProbe( const TOOL_EVENT& aEvent );
@@ -106,12 +126,33 @@ private:
 
     EDA_UNITS userUnits() const { return m_editFrame->GetUserUnits(); }
 
+    /**
+     * Record the old and new areas of a changed item for the next incremental run.
+     */
+    void recordChange( const BOARD_ITEM* aItem );
+
+    /**
+     * Remember the items and options of a completed run, against which the following changes
+     * are recorded.
+     */
+    void recordCompletedRun( bool aReportAllTrackErrors, bool aTestFootprints );
+
+    long long rulesTimestamp() const;
+
 private:
     PCB_EDIT_FRAME*             m_editFrame;
     BOARD*                      m_pcb;
     DIALOG_DRC*                 m_drcDialog;
     bool                        m_drcRunning;
     std::shared_ptr<DRC_ENGINE> m_drcEngine;
+
+    // State of the last completed run, for incremental runs
+    bool                        m_incrementalValid;
+    bool                        m_lastReportAllTrackErrors;
+    bool                        m_lastTestFootprints;
+    long long                   m_lastRulesTimestamp;
+    std::map<KIID, BOX2I>       m_itemBoxes;      // top-level items at the last run
+    std::vector<BOX2I>          m_changedAreas;
 };
 
 
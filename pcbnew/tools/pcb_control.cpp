@@ -50,7 +50,6 @@
 #include <zone.h>
 #include <confirm.h>
 #include <connectivity/connectivity_data.h>
-#include <core/kicad_algo.h>
 #include <dialogs/hotkey_cycle_popup.h>
 #include <kicad_clipboard.h>
 #include <origin_viewitem.h>
@@ -59,6 +58,7 @@
 #include <string_utf8_map.h>
 #include <settings/color_settings.h>
 #include <string>
+#include <unordered_set>
 #include <tool/tool_manager.h>
 #include <footprint_edit_frame.h>
 #include <footprint_editor_settings.h>
@@ -1159,6 +1159,8 @@ bool PCB_CONTROL::placeBoardItems( BOARD_COMMIT* aCommit, std::vector<BOARD_ITEM
     std::vector<BOARD_ITEM*> itemsToSel;
     itemsToSel.reserve( aItems.size() );
 
+    std::unordered_set<BOARD_ITEM*> placedItems( aItems.begin(), aItems.end() );
+
     for( BOARD_ITEM* item : aItems )
     {
         if( aIsNew )
@@ -1197,7 +1199,7 @@ bool PCB_CONTROL::placeBoardItems( BOARD_COMMIT* aCommit, std::vector<BOARD_ITEM
         // We only need to add the items that aren't inside a group currently selected
         // to the selection. If an item is inside a group and that group is selected,
         // then the selection tool will select it for us.
-        if( !item->GetParentGroup() || !alg::contains( aItems, item->GetParentGroup() ) )
+        if( !item->GetParentGroup() || !placedItems.count( item->GetParentGroup() ) )
             itemsToSel.push_back( item );
     }
 
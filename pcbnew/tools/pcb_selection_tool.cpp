@@ -749,8 +749,10 @@ bool PCB_SELECTION_TOOL::selectPoint( const VECTOR2I& aWhere, bool aOnDrag,
     if( m_enteredGroup && !m_enteredGroup->GetBoundingBox().Contains( aWhere ) )
         ExitGroup();
 
-    collector.Collect( board(), m_isFootprintEditor ? GENERAL_COLLECTOR::FootprintItems
-                                                    : GENERAL_COLLECTOR::AllBoardItems,
+    // Only hit-test the items near the cursor rather than the whole board
+    collector.Collect( hitTestCandidates( aWhere, guide.Accuracy() ),
+                       m_isFootprintEditor ? GENERAL_COLLECTOR::FootprintItems
+                                           : GENERAL_COLLECTOR::AllBoardItems,
                        aWhere, guide );
 
     // Remove unselectable items
@@ -863,6 +865,44 @@ bool PCB_SELECTION_TOOL::selectPoint( const VECTOR2I& aWhere, bool aOnDrag,
 }
 
 
+std::vector<BOARD_ITEM*> PCB_SELECTION_TOOL::hitTestCandidates( const VECTOR2I& aWhere,
+                                                                int aAccuracy ) const
+{
+    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> viewItems;
+    std::vector<BOARD_ITEM*>                  candidates;
+    std::unordered_set<BOARD_ITEM*>           seen;
+    BOX2I                                     area( aWhere, VECTOR2I( 1, 1 ) );
+
+    area.Inflate( std::max( aAccuracy, 1 ) );
+    view()->Query( area, viewItems );
+
+    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& viewItem : viewItems )
+    {
+        BOARD_ITEM* item = dynamic_cast<BOARD_ITEM*>( viewItem.first );
+
+        if( !item )
+            continue;
+
+        // The footprint is visited with all its children
+        if( FOOTPRINT* footprint = item->GetParentFootprint() )
+            item = footprint;
+
+        // Skip the previews and other items which aren't part of the board
+        if( item->GetParent() != board() )
+            continue;
+
+        if( seen.insert( item ).second )
+            candidates.push_back( item );
+    }
+
+    // Groups aren't in the view, and are hit anywhere within their bounding box
+    for( PCB_GROUP* group : board()->Groups() )
+        candidates.push_back( group );
+
+    return candidates;
+}
+
+
 bool PCB_SELECTION_TOOL::selectCursor( bool aForceSelect, CLIENT_SELECTION_FILTER aClientFilter )
 {
     if( aForceSelect || m_selection.Empty() )
@@ -275,6 +275,15 @@ private:
                       bool* aSelectionCancelledFlag = nullptr,
                       CLIENT_SELECTION_FILTER aClientFilter = nullptr );
 
+    /**
+     * Find the top level board items (footprints rather than their children) whose view
+     * bounding box is within \a aAccuracy of \a aWhere, from the R-tree of the view, along
+     * with the groups of the board.
+     *
+     * Only these can be hit at \a aWhere, so they are all that selectPoint() has to test.
+     */
+    std::vector<BOARD_ITEM*> hitTestCandidates( const VECTOR2I& aWhere, int aAccuracy ) const;
+
     /**
      * Select an item under the cursor unless there is something already selected.
      *
@@ -23,10 +23,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 #include <cstdint>
+#include <future>
 #include <thread>
 #include <zone.h>
+#include <advanced_config.h>
+#include <background_jobs_monitor.h>
 #include <connectivity/connectivity_data.h>
 #include <board_commit.h>
+#include <drc/drc_engine.h>
+#include <pgm_base.h>
 #include <footprint.h>
 #include <pcb_track.h>
 #include <pad.h>
@@ -45,21 +50,156 @@
 #include "zone_filler.h"
 #include "teardrop/teardrop.h"
 #include <core/profile.h>
+#include <core/thread_pool.h>
+
+
+/**
+ * An automatic zone refill running on a snapshot of the board.
+ */
+struct BACKGROUND_ZONE_FILL
+{
+    int                                m_id = 0;
+    std::unique_ptr<BOARD>             m_snapshot;
+    std::vector<ZONE*>                 m_zones;           ///< Zones to fill (on the snapshot)
+    std::map<KIID, std::vector<BOX2I>> m_dirtyAreas;
+    int                                m_boardTimeStamp = 0;
+    std::shared_ptr<BACKGROUND_JOB>    m_job;
+    std::future<bool>                  m_result;
+};
+
+
+/**
+ * Background fills get a pool of their own so that the editor's own tasks (ratsnest updates,
+ * etc.) don't queue up behind them.  As with the KiCad thread pool, it is created on the heap
+ * and never destroyed.
+ */
+static thread_pool& backgroundFillPool()
+{
+    static thread_pool* pool = nullptr;
+
+    if( !pool )
+        pool = new thread_pool;
+
+    return *pool;
+}
+
+
+static std::map<KIID, ZONE*> zonesById( BOARD* aBoard )
+{
+    std::map<KIID, ZONE*> zones;
+
+    for( ZONE* zone : aBoard->Zones() )
+        zones[ zone->m_Uuid ] = zone;
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( ZONE* zone : footprint->Zones() )
+            zones[ zone->m_Uuid ] = zone;
+    }
+
+    return zones;
+}
+
+
+/**
+ * Copy everything the zone filler looks at onto a new board, so that it can be filled on
+ * another thread while \a aBoard is being edited.  Items keep their KIIDs, and nets their names
+ * and netclasses (but not necessarily their codes).
+ *
+ * The snapshot is not given the project: a board releases its project's design settings when
+ * it is destroyed, and those belong to \a aBoard.  The design settings (which include the
+ * project's net settings) are copied instead.
+ */
+static std::unique_ptr<BOARD> makeFillSnapshot( BOARD* aBoard )
+{
+    std::unique_ptr<BOARD>                       snapshot = std::make_unique<BOARD>();
+    std::map<const NETINFO_ITEM*, NETINFO_ITEM*> nets;
+
+    snapshot->GetDesignSettings() = aBoard->GetDesignSettings();
+    snapshot->SetProperties( aBoard->GetProperties() );
+
+    for( NETINFO_ITEM* net : aBoard->GetNetInfo() )
+    {
+        NETINFO_ITEM* copy = snapshot->FindNet( net->GetNetname() );
+
+        if( !copy )
+        {
+            copy = new NETINFO_ITEM( snapshot.get(), net->GetNetname(), net->GetNetCode() );
+            snapshot->Add( copy, ADD_MODE::APPEND );
+        }
+
+        copy->SetNetClass( net->GetNetClassSlow() );
+        nets[ net ] = copy;
+    }
+
+    auto relink =
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( aItem ) )
+                {
+                    auto it = nets.find( item->GetNet() );
+
+                    item->SetNet( it != nets.end() ? it->second : NETINFO_LIST::OrphanedItem() );
+                }
+            };
+
+    auto addCopy =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                BOARD_ITEM* copy = static_cast<BOARD_ITEM*>( aItem->Clone() );
+
+                // Groups aren't copied
+                copy->SetParentGroup( nullptr );
+
+                snapshot->Add( copy, ADD_MODE::APPEND, true );
+                relink( copy );
+                copy->RunOnChildren( relink );
+            };
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+        addCopy( footprint );
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+        addCopy( track );
+
+    for( BOARD_ITEM* drawing : aBoard->Drawings() )
+        addCopy( drawing );
+
+    for( ZONE* zone : aBoard->Zones() )
+        addCopy( zone );
+
+    return snapshot;
+}
+
 
 ZONE_FILLER_TOOL::ZONE_FILLER_TOOL() :
     PCB_TOOL_BASE( "pcbnew.ZoneFiller" ),
-    m_fillInProgress( false )
+    m_fillInProgress( false ),
+    m_knockoutCache( std::make_shared<ZONE_KNOCKOUT_CACHE>() ),
+    m_lastBackgroundFillId( 0 )
 {
 }
 
 
 ZONE_FILLER_TOOL::~ZONE_FILLER_TOOL()
 {
+    cancelBackgroundFill( false );
 }
 
 
 void ZONE_FILLER_TOOL::Reset( RESET_REASON aReason )
 {
+    if( aReason == MODEL_RELOAD )
+    {
+        cancelBackgroundFill( false );
+        m_knockoutCache->Clear();
+    }
+}
+
+
+void ZONE_FILLER_TOOL::InvalidateKnockouts( BOARD_ITEM* aItem )
+{
+    m_knockoutCache->Invalidate( aItem );
 }
 
 
@@ -68,6 +208,7 @@ void ZONE_FILLER_TOOL::CheckAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRep
     if( !getEditFrame<PCB_EDIT_FRAME>()->m_ZoneFillsDirty || m_fillInProgress )
         return;
 
+    cancelBackgroundFill( true );
     m_fillInProgress = true;
 
     std::vector<ZONE*> toFill;
@@ -80,6 +221,8 @@ void ZONE_FILLER_TOOL::CheckAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRep
 
     m_filler = std::make_unique<ZONE_FILLER>( frame()->GetBoard(), &commit );
 
+    m_filler->SetKnockoutCache( m_knockoutCache );
+
     if( aReporter )
     {
         m_filler->SetProgressReporter( aReporter );
@@ -120,6 +263,8 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
     if( m_fillInProgress )
         return;
 
+    // Everything is about to be filled anyway
+    cancelBackgroundFill( false );
     m_fillInProgress = true;
 
     PCB_EDIT_FRAME*                       frame = getEditFrame<PCB_EDIT_FRAME>();
@@ -137,6 +282,8 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    m_filler->SetKnockoutCache( m_knockoutCache );
+
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
         WX_INFOBAR* infobar = frame->GetInfoBar();
@@ -199,10 +346,19 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     PCB_EDIT_FRAME*    frame = getEditFrame<PCB_EDIT_FRAME>();
     std::vector<ZONE*> toFill;
 
+    std::map<KIID, std::vector<BOX2I>> dirtyAreas;
+
     for( ZONE* zone : board()->Zones() )
     {
         if( !zone->IsFilled() || m_dirtyZoneIDs.count( zone->m_Uuid ) )
+        {
             toFill.push_back( zone );
+        }
+        else if( m_dirtyZoneAreas.count( zone->m_Uuid ) )
+        {
+            toFill.push_back( zone );
+            dirtyAreas[ zone->m_Uuid ] = m_dirtyZoneAreas[ zone->m_Uuid ];
+        }
     }
 
     if( toFill.empty() )
@@ -211,18 +367,13 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     if( m_fillInProgress )
         return 0;
 
-    int64_t startTime = GetRunningMicroSecs();
-    m_fillInProgress = true;
-
-    m_dirtyZoneIDs.clear();
-
-    board()->IncrementTimeStamp();    // Clear caches
-
-    BOARD_COMMIT                          commit( this );
-    std::unique_ptr<WX_PROGRESS_REPORTER> reporter;
-    int                                   pts = 0;
-
-    m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
+    if( ADVANCED_CFG::GetCfg().m_BackgroundZoneFill && m_backgroundFill )
+    {
+        // The board has changed under the running fill.  Cancel it; once it has wound down it
+        // restarts itself, taking in these zones too.
+        m_backgroundFill->m_job->m_reporter->Cancel();
+        return 0;
+    }
 
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
@@ -244,6 +395,29 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
                                  10000, wxICON_WARNING );
     }
 
+    if( ADVANCED_CFG::GetCfg().m_BackgroundZoneFill )
+    {
+        startBackgroundFill( toFill, dirtyAreas );
+        return 0;
+    }
+
+    int64_t startTime = GetRunningMicroSecs();
+    m_fillInProgress = true;
+
+    m_dirtyZoneIDs.clear();
+    m_dirtyZoneAreas.clear();
+
+    board()->IncrementTimeStamp();    // Clear caches
+
+    BOARD_COMMIT                          commit( this );
+    std::unique_ptr<WX_PROGRESS_REPORTER> reporter;
+    int                                   pts = 0;
+
+    m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
+
+    m_filler->SetKnockoutCache( m_knockoutCache );
+    m_filler->SetDirtyAreas( dirtyAreas );
+
     for( ZONE* zone : toFill )
     {
         for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
@@ -302,6 +476,224 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 }
 
 
+void ZONE_FILLER_TOOL::startBackgroundFill( const std::vector<ZONE*>& aToFill,
+                                            const std::map<KIID, std::vector<BOX2I>>& aDirtyAreas )
+{
+    PCB_EDIT_FRAME*                       frame = getEditFrame<PCB_EDIT_FRAME>();
+    std::shared_ptr<BACKGROUND_ZONE_FILL> fill = std::make_shared<BACKGROUND_ZONE_FILL>();
+
+    m_dirtyZoneIDs.clear();
+    m_dirtyZoneAreas.clear();
+
+    fill->m_id = ++m_lastBackgroundFillId;
+    fill->m_boardTimeStamp = board()->GetTimeStamp();
+    fill->m_snapshot = makeFillSnapshot( board() );
+    fill->m_dirtyAreas = aDirtyAreas;
+
+    std::map<KIID, ZONE*> snapshotZones = zonesById( fill->m_snapshot.get() );
+
+    for( ZONE* zone : aToFill )
+    {
+        auto it = snapshotZones.find( zone->m_Uuid );
+
+        if( it != snapshotZones.end() )
+            fill->m_zones.push_back( it->second );
+    }
+
+    BOARD_DESIGN_SETTINGS&      bds = fill->m_snapshot->GetDesignSettings();
+    std::shared_ptr<DRC_ENGINE> drcEngine = std::make_shared<DRC_ENGINE>( fill->m_snapshot.get(),
+                                                                         &bds );
+
+    try
+    {
+        drcEngine->InitEngine( frame->GetDesignRulesPath() );
+    }
+    catch( PARSE_ERROR& )
+    {
+        // Already reported; fill with whatever rules could be loaded, as a foreground fill would
+    }
+
+    bds.m_DRCEngine = drcEngine;
+
+    fill->m_job = Pgm().GetBackgroundJobMonitor().Create( _( "Zone Fill" ) );
+
+    BOARD*                               snapshot = fill->m_snapshot.get();
+    std::vector<ZONE*>                   zones = fill->m_zones;
+    std::shared_ptr<ZONE_KNOCKOUT_CACHE> knockoutCache = m_knockoutCache;
+    PROGRESS_REPORTER*                   reporter = fill->m_job->m_reporter.get();
+    int                                  fillId = fill->m_id;
+
+    // The knockout cache is shared with the editor's fills; it does its own locking
+    fill->m_result = std::async( std::launch::async,
+            [this, frame, snapshot, zones, aDirtyAreas, knockoutCache, reporter, fillId]() mutable
+            {
+                ZONE_FILLER filler( snapshot, nullptr );
+
+                filler.SetKnockoutCache( knockoutCache );
+                filler.SetDirtyAreas( aDirtyAreas );
+                filler.SetThreadPool( &backgroundFillPool() );
+                filler.SetProgressReporter( reporter );
+
+                bool filled = filler.Fill( zones );
+
+                frame->CallAfter(
+                        [this, fillId]()
+                        {
+                            finishBackgroundFill( fillId );
+                        } );
+
+                return filled;
+            } );
+
+    m_backgroundFill = std::move( fill );
+}
+
+
+void ZONE_FILLER_TOOL::finishBackgroundFill( int aFillId )
+{
+    // A fill which was cancelled and waited for has already been dealt with
+    if( !m_backgroundFill || m_backgroundFill->m_id != aFillId )
+        return;
+
+    std::shared_ptr<BACKGROUND_ZONE_FILL> fill = std::move( m_backgroundFill );
+    bool                                  filled = fill->m_result.get();
+
+    Pgm().GetBackgroundJobMonitor().Remove( fill->m_job );
+
+    // Any change to the board since the snapshot was taken may have made the fill stale.  No
+    // attempt is made to tell which changes matter: the fill is simply run again.
+    if( !filled || fill->m_job->m_reporter->IsCancelled()
+            || board()->GetTimeStamp() != fill->m_boardTimeStamp )
+    {
+        requeueBackgroundFill( *fill );
+        m_toolMgr->PostAction( PCB_ACTIONS::zoneFillDirty );
+        return;
+    }
+
+    BOARD_COMMIT          commit( this );
+    std::map<KIID, ZONE*> zones = zonesById( board() );
+
+    for( ZONE* filledZone : fill->m_zones )
+    {
+        auto it = zones.find( filledZone->m_Uuid );
+
+        if( it == zones.end() )
+            continue;
+
+        ZONE* zone = it->second;
+        bool  unchanged = zone->IsFilled() == filledZone->IsFilled();
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            size_t hash = filledZone->GetFillInputHash( layer );
+            unchanged &= hash != 0 && hash == zone->GetFillInputHash( layer );
+        }
+
+        if( unchanged )
+            continue;
+
+        commit.Modify( zone );
+        zone->CopyFillFrom( *filledZone );
+    }
+
+    // The filler also decides which pads and vias get flashed on which layers
+    std::map<KIID, BOARD_CONNECTED_ITEM*> flashedItems;
+    LSET                                  copperLayers = board()->GetEnabledLayers()
+                                                         & LSET::AllCuMask();
+
+    for( FOOTPRINT* footprint : fill->m_snapshot->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            flashedItems[ pad->m_Uuid ] = pad;
+    }
+
+    for( PCB_TRACK* track : fill->m_snapshot->Tracks() )
+    {
+        if( track->Type() == PCB_VIA_T )
+            flashedItems[ track->m_Uuid ] = track;
+    }
+
+    for( FOOTPRINT* footprint : board()->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            auto it = flashedItems.find( pad->m_Uuid );
+
+            if( it == flashedItems.end() )
+                continue;
+
+            PAD* filledPad = static_cast<PAD*>( it->second );
+
+            for( PCB_LAYER_ID layer : copperLayers.Seq() )
+                pad->SetZoneLayerOverride( layer, filledPad->GetZoneLayerOverride( layer ) );
+        }
+    }
+
+    for( PCB_TRACK* track : board()->Tracks() )
+    {
+        if( track->Type() != PCB_VIA_T )
+            continue;
+
+        auto it = flashedItems.find( track->m_Uuid );
+
+        if( it == flashedItems.end() )
+            continue;
+
+        PCB_VIA* via = static_cast<PCB_VIA*>( track );
+        PCB_VIA* filledVia = static_cast<PCB_VIA*>( it->second );
+
+        for( PCB_LAYER_ID layer : copperLayers.Seq() )
+            via->SetZoneLayerOverride( layer, filledVia->GetZoneLayerOverride( layer ) );
+    }
+
+    if( !commit.Empty() )
+        commit.Push( _( "Auto-fill Zone(s)" ), APPEND_UNDO | SKIP_CONNECTIVITY | ZONE_FILL_OP );
+
+    rebuildConnectivity();
+    refresh();
+
+    // Zones dirtied by edits which didn't change the board (and so didn't cancel this fill)
+    if( !m_dirtyZoneIDs.empty() || !m_dirtyZoneAreas.empty() )
+        m_toolMgr->PostAction( PCB_ACTIONS::zoneFillDirty );
+}
+
+
+void ZONE_FILLER_TOOL::cancelBackgroundFill( bool aRequeue )
+{
+    if( !m_backgroundFill )
+        return;
+
+    std::shared_ptr<BACKGROUND_ZONE_FILL> fill = std::move( m_backgroundFill );
+
+    fill->m_job->m_reporter->Cancel();
+    fill->m_result.wait();
+
+    Pgm().GetBackgroundJobMonitor().Remove( fill->m_job );
+
+    if( aRequeue )
+        requeueBackgroundFill( *fill );
+}
+
+
+void ZONE_FILLER_TOOL::requeueBackgroundFill( const BACKGROUND_ZONE_FILL& aFill )
+{
+    for( ZONE* zone : aFill.m_zones )
+    {
+        auto it = aFill.m_dirtyAreas.find( zone->m_Uuid );
+
+        if( it == aFill.m_dirtyAreas.end() )
+        {
+            m_dirtyZoneIDs.insert( zone->m_Uuid );
+        }
+        else
+        {
+            std::vector<BOX2I>& areas = m_dirtyZoneAreas[ zone->m_Uuid ];
+            areas.insert( areas.end(), it->second.begin(), it->second.end() );
+        }
+    }
+}
+
+
 int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
 {
     if( m_fillInProgress )
@@ -337,6 +729,7 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
         return -1;
     }
 
+    cancelBackgroundFill( true );
     m_fillInProgress = true;
 
     BOARD_COMMIT                          commit( this );
@@ -344,6 +737,8 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    m_filler->SetKnockoutCache( m_knockoutCache );
+
     reporter = std::make_unique<WX_PROGRESS_REPORTER>( frame(), _( "Fill Zone" ), 5 );
     m_filler->SetProgressReporter( reporter.get() );
 
@@ -33,8 +33,10 @@
 
 class PCB_EDIT_FRAME;
 class PROGRESS_REPORTER;
+struct BACKGROUND_ZONE_FILL;
 class WX_PROGRESS_REPORTER;
 class ZONE_FILLER;
+class ZONE_KNOCKOUT_CACHE;
 
 
 /**
@@ -67,6 +69,20 @@ public:
         m_dirtyZoneIDs.insert( aZone->m_Uuid );
     }
 
+    /**
+     * Mark an area of a zone as needing a refill.  Unless the whole zone is also dirty, an
+     * automatic refill may restrict itself to the dirty areas of the zone.
+     */
+    void DirtyZoneArea( ZONE* aZone, const BOX2I& aArea )
+    {
+        m_dirtyZoneAreas[ aZone->m_Uuid ].push_back( aArea );
+    }
+
+    /**
+     * Drop any cached zone knockouts of an item which has been modified or deleted.
+     */
+    void InvalidateKnockouts( BOARD_ITEM* aItem );
+
     static bool IsZoneFillAction( const TOOL_EVENT* aEvent );
 
 private:
@@ -76,6 +92,26 @@ private:
     void rebuildConnectivity();
     void refresh();
 
+    /**
+     * Fill \a aToFill on a snapshot of the board, on a worker thread.  The fill is applied to the
+     * board once it completes, provided the board hasn't been modified in the meantime.
+     */
+    void startBackgroundFill( const std::vector<ZONE*>& aToFill,
+                              const std::map<KIID, std::vector<BOX2I>>& aDirtyAreas );
+
+    ///< Apply (or, if it is stale, restart) a background fill once its worker has finished.
+    void finishBackgroundFill( int aFillId );
+
+    /**
+     * Cancel any background fill in progress and wait for its worker to wind down.
+     *
+     * @param aRequeue puts the zones being filled back onto the dirty list.
+     */
+    void cancelBackgroundFill( bool aRequeue );
+
+    ///< Put the zones of a background fill which didn't make it back onto the dirty list.
+    void requeueBackgroundFill( const BACKGROUND_ZONE_FILL& aFill );
+
     ///< Set up handlers for various events.
     void setTransitions() override;
 
@@ -83,7 +119,15 @@ private:
     std::unique_ptr<ZONE_FILLER> m_filler;
     bool                         m_fillInProgress;
 
+    /// Knockout shapes kept from one fill to the next
+    std::shared_ptr<ZONE_KNOCKOUT_CACHE> m_knockoutCache;
+
     std::set<KIID>               m_dirtyZoneIDs;
+    std::map<KIID, std::vector<BOX2I>> m_dirtyZoneAreas;
+
+    /// An automatic refill running in the background (see ADVANCED_CFG::m_BackgroundZoneFill)
+    std::shared_ptr<BACKGROUND_ZONE_FILL> m_backgroundFill;
+    int                                   m_lastBackgroundFillId;
 };
 
 #endif
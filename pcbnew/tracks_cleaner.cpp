@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <core/thread_pool.h>
 #include <reporter.h>
 #include <board_commit.h>
 #include <cleanup_item.h>
@@ -163,48 +164,52 @@ void TRACKS_CLEANER::removeShortingTrackSegments()
 {
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
 
-    std::set<BOARD_ITEM *> toRemove;
-
-    for( PCB_TRACK* segment : m_brd->Tracks() )
-    {
-        // Assume that the user knows what they are doing
-        if( segment->IsLocked() )
-            continue;
+    std::vector<PCB_TRACK*> tracks( m_brd->Tracks().begin(), m_brd->Tracks().end() );
+    std::vector<int>        shortCounts( tracks.size(), 0 );
 
-        for( PAD* testedPad : connectivity->GetConnectedPads( segment ) )
-        {
-            if( segment->GetNetCode() != testedPad->GetNetCode() )
+    // The connectivity is only read here, so the segments can be tested in parallel.  There is
+    // one report per shorted item, as before.
+    ParallelForEachIndex( tracks.size(),
+            [&]( size_t ii )
             {
-                std::shared_ptr<CLEANUP_ITEM> item;
+                PCB_TRACK* segment = tracks[ii];
 
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
+                // Assume that the user knows what they are doing
+                if( segment->IsLocked() )
+                    return;
 
-                item->SetItems( segment );
-                m_itemsList->push_back( item );
+                for( PAD* testedPad : connectivity->GetConnectedPads( segment ) )
+                {
+                    if( segment->GetNetCode() != testedPad->GetNetCode() )
+                        shortCounts[ii]++;
+                }
 
-                toRemove.insert( segment );
-            }
-        }
+                for( PCB_TRACK* testedTrack : connectivity->GetConnectedTracks( segment ) )
+                {
+                    if( segment->GetNetCode() != testedTrack->GetNetCode() )
+                        shortCounts[ii]++;
+                }
+            } );
+
+    std::set<BOARD_ITEM *> toRemove;
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+    {
+        PCB_TRACK* segment = tracks[ii];
 
-        for( PCB_TRACK* testedTrack : connectivity->GetConnectedTracks( segment ) )
+        for( int jj = 0; jj < shortCounts[ii]; ++jj )
         {
-            if( segment->GetNetCode() != testedTrack->GetNetCode() )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item;
+            std::shared_ptr<CLEANUP_ITEM> item;
 
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
+            if( segment->Type() == PCB_VIA_T )
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
+            else
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
 
-                item->SetItems( segment );
-                m_itemsList->push_back( item );
+            item->SetItems( segment );
+            m_itemsList->push_back( item );
 
-                toRemove.insert( segment );
-            }
+            toRemove.insert( segment );
         }
     }
 
@@ -308,41 +313,57 @@ bool TRACKS_CLEANER::deleteDanglingTracks( bool aTrack, bool aVia )
 
 void TRACKS_CLEANER::deleteTracksInPads()
 {
-    std::set<BOARD_ITEM*> toRemove;
-
     // Delete tracks that start and end on the same pad
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
 
-    for( PCB_TRACK* track : m_brd->Tracks() )
-    {
-        if( track->IsLocked() )
-            continue;
-
-        if( track->Type() == PCB_VIA_T )
-            continue;
+    std::vector<PCB_TRACK*> tracks( m_brd->Tracks().begin(), m_brd->Tracks().end() );
+    std::vector<int>        padCounts( tracks.size(), 0 );
 
-        // Mark track if connected to pads
-        for( PAD* pad : connectivity->GetConnectedPads( track ) )
-        {
-            if( pad->HitTest( track->GetStart() ) && pad->HitTest( track->GetEnd() ) )
+    // The polygon tests are the expensive part and don't modify anything, so they are run in
+    // parallel and the tracks are marked afterwards
+    ParallelForEachIndex( tracks.size(),
+            [&]( size_t ii )
             {
-                SHAPE_POLY_SET poly;
-                track->TransformShapeToPolygon( poly, track->GetLayer(), 0, ARC_HIGH_DEF,
-                                                ERROR_INSIDE );
+                PCB_TRACK* track = tracks[ii];
 
-                poly.BooleanSubtract( *pad->GetEffectivePolygon( ERROR_INSIDE ),
-                                      SHAPE_POLY_SET::PM_FAST );
+                if( track->IsLocked() )
+                    return;
 
-                if( poly.IsEmpty() )
+                if( track->Type() == PCB_VIA_T )
+                    return;
+
+                // Mark track if connected to pads
+                for( PAD* pad : connectivity->GetConnectedPads( track ) )
                 {
-                    auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_TRACK_IN_PAD );
-                    item->SetItems( track );
-                    m_itemsList->push_back( item );
+                    if( pad->HitTest( track->GetStart() ) && pad->HitTest( track->GetEnd() ) )
+                    {
+                        SHAPE_POLY_SET poly;
+                        track->TransformShapeToPolygon( poly, track->GetLayer(), 0, ARC_HIGH_DEF,
+                                                        ERROR_INSIDE );
+
+                        poly.BooleanSubtract( *pad->GetEffectivePolygon( ERROR_INSIDE ),
+                                              SHAPE_POLY_SET::PM_FAST );
 
-                    toRemove.insert( track );
-                    track->SetFlags( IS_DELETED );
+                        if( poly.IsEmpty() )
+                            padCounts[ii]++;
+                    }
                 }
-            }
+            } );
+
+    std::set<BOARD_ITEM*> toRemove;
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+    {
+        PCB_TRACK* track = tracks[ii];
+
+        for( int jj = 0; jj < padCounts[ii]; ++jj )
+        {
+            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_TRACK_IN_PAD );
+            item->SetItems( track );
+            m_itemsList->push_back( item );
+
+            toRemove.insert( track );
+            track->SetFlags( IS_DELETED );
         }
     }
 
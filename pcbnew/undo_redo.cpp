@@ -33,7 +33,9 @@ using namespace std::placeholders;
 #include <pcb_group.h>
 #include <pcb_generator.h>
 #include <pcb_target.h>
+#include <pcb_shape.h>
 #include <footprint.h>
+#include <zone.h>
 #include <pad.h>
 #include <origin_viewitem.h>
 #include <connectivity/connectivity_data.h>
@@ -44,6 +46,7 @@ using namespace std::placeholders;
 #include <tools/board_editor_control.h>
 #include <board_commit.h>
 #include <drawing_sheet/ds_proxy_undo_item.h>
+#include <advanced_config.h>
 #include <wx/msgdlg.h>
 
 /* Functions to undo and redo edit commands.
@@ -376,6 +379,9 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
             }
         }
 
+        if( BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>( eda_item ) )
+            GetBoard()->InvalidateSavedText( boardItem );
+
         // see if we must rebuild ratsnets and pointers lists
         switch( eda_item->Type() )
         {
@@ -564,6 +570,9 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
             // Connectivity may have changed; rebuild internal caches to remove stale items
             GetBoard()->BuildConnectivity();
             Compile_Ratsnest( false );
+
+            // Rebuilding the connectivity can change nets without going through a commit
+            GetBoard()->ClearSavedText();
         }
 
         if( solder_mask_dirty )
@@ -611,6 +620,113 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
 }
 
 
+/**
+ * A rough estimate of the memory held by an item copy of the undo list.  Only the bulky data is
+ * counted: the outlines of zones and shapes, and the zone fills which aren't shared with the
+ * board.
+ */
+static size_t undoItemMemory( const EDA_ITEM* aItem )
+{
+    size_t size = 256;
+
+    switch( aItem->Type() )
+    {
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( aItem );
+
+        size += zone->Outline()->FullPointCount() * sizeof( VECTOR2I );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+
+            // A fill shared with the zone on the board costs nothing more
+            if( fill && fill.use_count() == 1 )
+                size += fill->FullPointCount() * sizeof( VECTOR2I );
+        }
+
+        break;
+    }
+
+    case PCB_SHAPE_T:
+    {
+        const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
+
+        if( shape->GetShape() == SHAPE_T::POLY )
+            size += shape->GetPolyShape().FullPointCount() * sizeof( VECTOR2I );
+
+        break;
+    }
+
+    case PCB_FOOTPRINT_T:
+        static_cast<const FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    size += undoItemMemory( aChild );
+                } );
+        break;
+
+    default:
+        break;
+    }
+
+    return size;
+}
+
+
+/**
+ * @return the estimated memory held by the copies of \a aList.  New items belong to the board
+ *         and are not counted.
+ */
+static size_t undoCommandMemory( const PICKED_ITEMS_LIST* aList )
+{
+    size_t size = 0;
+
+    for( unsigned ii = 0; ii < aList->GetCount(); ++ii )
+    {
+        if( EDA_ITEM* link = aList->GetPickedItemLink( ii ) )
+            size += undoItemMemory( link );
+        else if( aList->GetPickedItemStatus( ii ) == UNDO_REDO::DELETED )
+            size += undoItemMemory( aList->GetPickedItem( ii ) );
+    }
+
+    return size;
+}
+
+
+void PCB_BASE_EDIT_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aItem )
+{
+    EDA_BASE_FRAME::PushCommandToUndoList( aItem );
+
+    if( ADVANCED_CFG::GetCfg().m_UndoMemoryLimit <= 0 )
+        return;
+
+    const std::vector<PICKED_ITEMS_LIST*>& commands = m_undoList.m_CommandsList;
+
+    size_t limit = (size_t) ADVANCED_CFG::GetCfg().m_UndoMemoryLimit * 1024 * 1024;
+    size_t total = 0;
+    int    keep = 0;
+
+    // The newest command is always kept, whatever its size
+    for( auto it = commands.rbegin(); it != commands.rend(); ++it )
+    {
+        total += undoCommandMemory( *it );
+
+        if( keep > 0 && total > limit )
+            break;
+
+        keep++;
+    }
+
+    if( keep < (int) commands.size() )
+        ClearUndoORRedoList( UNDO_LIST, (int) commands.size() - keep );
+}
+
+
 void PCB_BASE_EDIT_FRAME::ClearUndoORRedoList( UNDO_REDO_LIST whichList, int aItemCount )
 {
     if( aItemCount == 0 )
@@ -23,8 +23,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <bitmaps.h>
+#include <gal/graphics_abstraction_layer.h>
 #include <geometry/geometry_utils.h>
+#include <geometry/inflate_cache.h>
 #include <geometry/shape_null.h>
 #include <pcb_edit_frame.h>
 #include <pcb_screen.h>
@@ -150,12 +153,13 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
     delete m_CornerSelection;
     m_CornerSelection         = nullptr;
 
+    // Fills are shared with the source zone until one of them is modified
     for( PCB_LAYER_ID layer : aZone.GetLayerSet().Seq() )
     {
         std::shared_ptr<SHAPE_POLY_SET> fill = aZone.m_FilledPolysList.at( layer );
 
         if( fill )
-            m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>( *fill );
+            m_FilledPolysList[layer] = fill;
         else
             m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>();
 
@@ -163,6 +167,9 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
         m_insulatedIslands[layer] = aZone.m_insulatedIslands.at( layer );
     }
 
+    m_removedIslands          = aZone.m_removedIslands;
+    m_fillInputHashes         = aZone.m_fillInputHashes;
+
     m_borderStyle             = aZone.m_borderStyle;
     m_borderHatchPitch        = aZone.m_borderHatchPitch;
     m_borderHatchLines        = aZone.m_borderHatchLines;
@@ -212,16 +219,54 @@ bool ZONE::UnFill()
     {
         change |= !pair.second->IsEmpty();
         m_insulatedIslands[pair.first].clear();
-        pair.second->RemoveAllContours();
+
+        // Don't empty a fill which copies of the zone may still be using
+        pair.second = std::make_shared<SHAPE_POLY_SET>();
     }
 
     m_isFilled = false;
     m_fillFlags.reset();
+    m_fillInputHashes.clear();
 
     return change;
 }
 
 
+void ZONE::CopyFillFrom( const ZONE& aOther )
+{
+    for( PCB_LAYER_ID layer : GetLayerSet().Seq() )
+    {
+        auto fillIt = aOther.m_FilledPolysList.find( layer );
+
+        if( fillIt != aOther.m_FilledPolysList.end() && fillIt->second )
+            m_FilledPolysList[layer] = fillIt->second;
+        else
+            m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>();
+
+        auto hashIt = aOther.m_filledPolysHash.find( layer );
+
+        if( hashIt != aOther.m_filledPolysHash.end() )
+            m_filledPolysHash[layer] = hashIt->second;
+        else
+            m_filledPolysHash.erase( layer );
+
+        auto islandIt = aOther.m_insulatedIslands.find( layer );
+
+        if( islandIt != aOther.m_insulatedIslands.end() )
+            m_insulatedIslands[layer] = islandIt->second;
+        else
+            m_insulatedIslands[layer].clear();
+    }
+
+    m_removedIslands  = aOther.m_removedIslands;
+    m_fillInputHashes = aOther.m_fillInputHashes;
+    m_fillFlags       = aOther.m_fillFlags;
+    m_isFilled        = aOther.m_isFilled;
+    m_needRefill      = aOther.m_needRefill;
+    m_area            = aOther.m_area;
+}
+
+
 bool ZONE::IsConflicting() const
 {
     return HasFlag( COURTYARD_CONFLICT );
@@ -278,6 +323,8 @@ void ZONE::SetLayerSet( LSET aLayerSet )
         m_FilledPolysList.clear();
         m_filledPolysHash.clear();
         m_insulatedIslands.clear();
+        m_removedIslands.clear();
+        m_fillInputHashes.clear();
 
         for( PCB_LAYER_ID layer : aLayerSet.Seq() )
         {
@@ -334,6 +381,25 @@ double ZONE::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
 }
 
 
+double ZONE::ViewGetProxyScale( int aLayer, KIGFX::VIEW* aView ) const
+{
+    if( !aView || !IsZoneFillLayer( aLayer ) || !ADVANCED_CFG::GetCfg().m_ZoneFillProxies )
+        return 0.0;
+
+    PCB_LAYER_ID layer = ToLAYER_ID( aLayer - LAYER_ZONE_START );
+    auto         it = m_FilledPolysList.find( layer );
+
+    if( it == m_FilledPolysList.end() || it->second->FullPointCount() < FILL_PROXY_MIN_POINTS )
+        return 0.0;
+
+    // Use the proxy while its error stays below half a pixel
+    const KIGFX::GAL* gal = aView->GetGAL();
+    double            pixelsPerIU = gal->GetWorldScale() / gal->GetZoomFactor();
+
+    return 0.5 / ( FILL_PROXY_MAX_ERROR * pixelsPerIU );
+}
+
+
 bool ZONE::IsOnLayer( PCB_LAYER_ID aLayer ) const
 {
     return m_layerSet.test( aLayer );
@@ -669,7 +735,10 @@ void ZONE::Move( const VECTOR2I& offset )
 
     /* move fills */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
+    {
+        unshareFill( pair.second );
         pair.second->Move( offset );
+    }
 
     /*
      * move boundingbox cache
@@ -722,7 +791,10 @@ void ZONE::Rotate( const VECTOR2I& aCentre, const EDA_ANGLE& aAngle )
 
     /* rotate filled areas: */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
+    {
+        unshareFill( pair.second );
         pair.second->Rotate( aAngle, aCentre );
+    }
 }
 
 
@@ -754,7 +826,10 @@ void ZONE::Mirror( const VECTOR2I& aMirrorRef, bool aMirrorLeftRight )
     HatchBorder();
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
+    {
+        unshareFill( pair.second );
         pair.second->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
+    }
 }
 
 
@@ -1091,6 +1166,58 @@ void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
 }
 
 
+size_t ZONE::GetFillMemoryUsage() const
+{
+    size_t size = 0;
+
+    for( const auto& [layer, poly] : m_FilledPolysList )
+        size += sizeof( SHAPE_POLY_SET ) + poly->GetMemoryUsage();
+
+    for( const auto& [layer, proxy] : m_fillProxies )
+        size += sizeof( SHAPE_POLY_SET ) + proxy.second->GetMemoryUsage();
+
+    return size;
+}
+
+
+size_t ZONE::GetTriangulationMemoryUsage() const
+{
+    size_t size = m_Poly->GetTriangulationMemoryUsage();
+
+    for( const auto& [layer, poly] : m_FilledPolysList )
+        size += poly->GetTriangulationMemoryUsage();
+
+    for( const auto& [layer, proxy] : m_fillProxies )
+        size += proxy.second->GetTriangulationMemoryUsage();
+
+    return size;
+}
+
+
+std::shared_ptr<SHAPE_POLY_SET> ZONE::GetFillProxy( PCB_LAYER_ID aLayer ) const
+{
+    auto it = m_FilledPolysList.find( aLayer );
+
+    if( it == m_FilledPolysList.end() || it->second->FullPointCount() < FILL_PROXY_MIN_POINTS )
+        return nullptr;
+
+    const SHAPE_POLY_SET& fill = *it->second;
+    MD5_HASH              hash = fill.GetHash();
+    auto                  cached = m_fillProxies.find( aLayer );
+
+    if( cached != m_fillProxies.end() && cached->second.first == hash )
+        return cached->second.second;
+
+    std::shared_ptr<SHAPE_POLY_SET> proxy = std::make_shared<SHAPE_POLY_SET>( fill );
+
+    proxy->SimplifyOutlines( FILL_PROXY_MAX_ERROR );
+    proxy->CacheTriangulation( true, true );
+
+    m_fillProxies[aLayer] = { hash, proxy };
+    return proxy;
+}
+
+
 bool ZONE::IsIsland( PCB_LAYER_ID aLayer, int aPolyIdx ) const
 {
     if( GetNetCode() < 1 )
@@ -1224,51 +1351,66 @@ bool ZONE::BuildSmoothedPoly( SHAPE_POLY_SET& aSmoothedPoly, PCB_LAYER_ID aLayer
     std::vector<ZONE*> diffNetIntersectingZones;
     GetInteractingZones( aLayer, &sameNetCollidingZones, &diffNetIntersectingZones );
 
-    for( ZONE* sameNetZone : sameNetCollidingZones )
+    // The same-net zones are all added in a single boolean
+    if( !sameNetCollidingZones.empty() || aBoardOutline )
     {
-        BOX2I sameNetBoundingBox = sameNetZone->GetBoundingBox();
+        SHAPE_POLY_SET::BOOLEAN_CHAIN smoothedChain( aSmoothedPoly );
 
-        // Note: a two-pass algorithm could use sameNetZone's actual fill instead of its outline.
-        // This would obviate the need for the below wrinkles, in addition to fixing both issues
-        // in #16095.
-        // (And we wouldn't need to collect all the diffNetIntersectingZones either.)
+        for( ZONE* sameNetZone : sameNetCollidingZones )
+        {
+            BOX2I sameNetBoundingBox = sameNetZone->GetBoundingBox();
 
-        SHAPE_POLY_SET sameNetPoly = sameNetZone->Outline()->CloneDropTriangulation();
-        SHAPE_POLY_SET diffNetPoly;
+            // Note: a two-pass algorithm could use sameNetZone's actual fill instead of its
+            // outline.  This would obviate the need for the below wrinkles, in addition to fixing
+            // both issues in #16095.
+            // (And we wouldn't need to collect all the diffNetIntersectingZones either.)
 
-        // Of course there's always a wrinkle.  The same-net intersecting zone *might* get knocked
-        // out along the border by a higher-priority, different-net zone.  #12797
-        for( ZONE* diffNetZone : diffNetIntersectingZones )
-        {
-            if( diffNetZone->HigherPriority( sameNetZone )
-                    && diffNetZone->GetBoundingBox().Intersects( sameNetBoundingBox ) )
+            SHAPE_POLY_SET sameNetPoly = sameNetZone->Outline()->CloneDropTriangulation();
+            std::vector<const SHAPE_POLY_SET*> diffNetPolys;
+
+            // Of course there's always a wrinkle.  The same-net intersecting zone *might* get
+            // knocked out along the border by a higher-priority, different-net zone.  #12797
+            for( ZONE* diffNetZone : diffNetIntersectingZones )
             {
-                diffNetPoly.BooleanAdd( *diffNetZone->Outline(), SHAPE_POLY_SET::PM_FAST );
+                if( diffNetZone->HigherPriority( sameNetZone )
+                        && diffNetZone->GetBoundingBox().Intersects( sameNetBoundingBox ) )
+                {
+                    diffNetPolys.push_back( diffNetZone->Outline() );
+                }
             }
-        }
 
-        // Second wrinkle.  After unioning the higher priority, different net zones together, we
-        // need to check to see if they completely enclose our zone.  If they do, then we need to
-        // treat the enclosed zone as isolated, not connected to the outer zone.  #13915
-        bool isolated = false;
+            // Second wrinkle.  After unioning the higher priority, different net zones together,
+            // we need to check to see if they completely enclose our zone.  If they do, then we
+            // need to treat the enclosed zone as isolated, not connected to the outer zone.
+            // #13915
+            bool isolated = false;
 
-        if( diffNetPoly.OutlineCount() )
-        {
-            SHAPE_POLY_SET thisPoly = Outline()->CloneDropTriangulation();
+            if( !diffNetPolys.empty() )
+            {
+                // Subtracting the zones one after the other is subtracting their union, and
+                // the chain runs it as a single boolean
+                SHAPE_POLY_SET::BOOLEAN_CHAIN thisChain( *Outline() );
+                SHAPE_POLY_SET                thisPoly;
 
-            thisPoly.BooleanSubtract( diffNetPoly, SHAPE_POLY_SET::PM_FAST );
-            isolated = thisPoly.OutlineCount() == 0;
-        }
+                for( const SHAPE_POLY_SET* diffNetPoly : diffNetPolys )
+                    thisChain.Subtract( *diffNetPoly );
 
-        if( !isolated )
-        {
-            sameNetPoly.ClearArcs();
-            aSmoothedPoly.BooleanAdd( sameNetPoly, SHAPE_POLY_SET::PM_FAST );
+                thisChain.Finish( thisPoly );
+                isolated = thisPoly.OutlineCount() == 0;
+            }
+
+            if( !isolated )
+            {
+                sameNetPoly.ClearArcs();
+                smoothedChain.Add( sameNetPoly );
+            }
         }
-    }
 
-    if( aBoardOutline )
-        aSmoothedPoly.BooleanIntersection( *aBoardOutline, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+        if( aBoardOutline )
+            smoothedChain.Intersect( *aBoardOutline );
+
+        smoothedChain.Finish( aSmoothedPoly );
+    }
 
     smooth( aSmoothedPoly );
 
@@ -1339,7 +1481,11 @@ void ZONE::TransformSmoothedOutlineToPolygon( SHAPE_POLY_SET& aBuffer, int aClea
         if( aErrorLoc == ERROR_OUTSIDE )
             aClearance += maxError;
 
-        polybuffer.Inflate( aClearance, CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError );
+        // The filler knocks the outline of each zone out of all the zones below it
+        static INFLATE_CACHE s_clearanceCache;
+
+        s_clearanceCache.Inflate( polybuffer, aClearance, CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                  maxError );
     }
 
     polybuffer.Fracture( SHAPE_POLY_SET::PM_FAST );
@@ -177,6 +177,12 @@ public:
 
     double ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const override;
 
+    /**
+     * Large fills are drawn from a decimated copy when zoomed out far enough for the removed
+     * detail to be smaller than a pixel.
+     */
+    double ViewGetProxyScale( int aLayer, KIGFX::VIEW* aView ) const override;
+
     void SetFillMode( ZONE_FILL_MODE aFillMode ) { m_fillMode = aFillMode; }
     ZONE_FILL_MODE GetFillMode() const { return m_fillMode; }
 
@@ -600,6 +606,9 @@ public:
 
     /**
      * @return a reference to the list of filled polygons.
+     *
+     * The polygons may be shared with copies of this zone, so they must not be modified through
+     * this reference; use GetFill() for that.
      */
     const std::shared_ptr<SHAPE_POLY_SET>& GetFilledPolysList( PCB_LAYER_ID aLayer ) const
     {
@@ -607,10 +616,17 @@ public:
         return m_FilledPolysList.at( aLayer );
     }
 
+    /**
+     * @return the filled polygons of \a aLayer, for modification.  If they are shared with
+     *         copies of this zone they are copied first.
+     */
     SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer )
     {
         wxASSERT( m_FilledPolysList.count( aLayer ) );
-        return m_FilledPolysList.at( aLayer ).get();
+
+        std::shared_ptr<SHAPE_POLY_SET>& fill = m_FilledPolysList.at( aLayer );
+        unshareFill( fill );
+        return fill.get();
     }
 
     /**
@@ -619,12 +635,40 @@ public:
      */
     void CacheTriangulation( PCB_LAYER_ID aLayer = UNDEFINED_LAYER );
 
+    /**
+     * @return an estimate of the memory held by the filled polygons and the fill proxies, for
+     *         reports.  A fill shared with copies of the zone is counted by each of them.
+     */
+    size_t GetFillMemoryUsage() const;
+
+    /**
+     * @return an estimate of the memory held by the triangulations of the outline, the filled
+     *         polygons and the fill proxies, for reports.
+     */
+    size_t GetTriangulationMemoryUsage() const;
+
+    /**
+     * Return a triangulated copy of the fill of \a aLayer with its outlines decimated to
+     * FILL_PROXY_MAX_ERROR, used to draw the zone when zoomed out.  The copy is cached until
+     * the fill changes.  Different zones can build their proxies from several threads at once.
+     *
+     * @return the proxy, or nullptr if the fill of \a aLayer is too small to need one.
+     */
+    std::shared_ptr<SHAPE_POLY_SET> GetFillProxy( PCB_LAYER_ID aLayer ) const;
+
+    /// The maximum deviation of the outlines of a fill proxy from the fill, in IU
+    static constexpr int FILL_PROXY_MAX_ERROR = 50000;
+
+    /// Fills with fewer points than this are always drawn in full
+    static constexpr int FILL_PROXY_MIN_POINTS = 2000;
+
     /**
      * Set the list of filled polygons.
      */
     void SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList )
     {
         m_FilledPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
+        m_fillInputHashes.erase( aLayer );
     }
 
     /**
@@ -641,6 +685,32 @@ public:
         m_insulatedIslands[aLayer].insert( aPolyIdx );
     }
 
+    /**
+     * Record the bounding box of a fill polygon which was removed as an isolated island.
+     *
+     * Region-scoped refills use these to decide whether an edit might reconnect an island
+     * which is no longer present in the fill.
+     */
+    void AddRemovedIsland( PCB_LAYER_ID aLayer, const BOX2I& aBBox )
+    {
+        m_removedIslands[aLayer].push_back( aBBox );
+    }
+
+    void ClearRemovedIslands( PCB_LAYER_ID aLayer )
+    {
+        m_removedIslands[aLayer].clear();
+    }
+
+    /**
+     * @return the bounding boxes of the islands removed from the fill on  aLayer, or nullptr
+     *         if they are not known (for instance when the fill was loaded from a file).
+     */
+    const std::vector<BOX2I>* GetRemovedIslands( PCB_LAYER_ID aLayer ) const
+    {
+        auto it = m_removedIslands.find( aLayer );
+        return it == m_removedIslands.end() ? nullptr : &it->second;
+    }
+
     bool BuildSmoothedPoly( SHAPE_POLY_SET& aSmoothedPoly, PCB_LAYER_ID aLayer,
                             SHAPE_POLY_SET* aBoardOutline,
                             SHAPE_POLY_SET* aSmoothedPolyWithApron = nullptr ) const;
@@ -773,6 +843,32 @@ public:
      */
     MD5_HASH GetHashValue( PCB_LAYER_ID aLayer );
 
+    /**
+     * Record the hash of everything the fill of \a aLayer was built from (the zone's own
+     * outline and settings, and the board items and rules around it).
+     *
+     * The zone filler skips layers whose inputs hash to the same value as last time.  Setting
+     * the fill by any other means forgets the hash.
+     */
+    void SetFillInputHash( PCB_LAYER_ID aLayer, size_t aHash ) { m_fillInputHashes[aLayer] = aHash; }
+
+    /**
+     * @return the hash recorded by SetFillInputHash(), or 0 if there is none.
+     */
+    size_t GetFillInputHash( PCB_LAYER_ID aLayer ) const
+    {
+        auto it = m_fillInputHashes.find( aLayer );
+        return it == m_fillInputHashes.end() ? 0 : it->second;
+    }
+
+    /**
+     * Take over the fill of \a aOther, which must be a copy of this zone (for instance one which
+     * was filled on a snapshot of the board).  Filled polygons (which end up shared between the
+     * two zones), islands, fill flags and fill input hashes are copied; the outline and settings
+     * are left alone.
+     */
+    void CopyFillFrom( const ZONE& aOther );
+
     double Similarity( const BOARD_ITEM& aOther ) const override;
 
     bool operator==( const BOARD_ITEM& aOther ) const override;
@@ -827,6 +923,16 @@ protected:
     bool                  m_doNotAllowPads;
     bool                  m_doNotAllowFootprints;
 
+    /**
+     * Give \a aFill a buffer of its own if it is shared with other copies of the zone, so that
+     * it can be modified in place.
+     */
+    static void unshareFill( std::shared_ptr<SHAPE_POLY_SET>& aFill )
+    {
+        if( aFill && aFill.use_count() > 1 )
+            aFill = std::make_shared<SHAPE_POLY_SET>( *aFill );
+    }
+
     ZONE_CONNECTION       m_PadConnection;
     int                   m_ZoneClearance;           // Clearance value in internal units.
     int                   m_ZoneMinThickness;        // Minimum thickness value in filled areas.
@@ -885,6 +991,10 @@ protected:
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
      * described by m_Poly can have many filled areas
+     *
+     * Copies of a zone (undo and redo images, duplicates, board snapshots) share their filled
+     * polygons and triangulations until one of them is modified.  The fill is never modified in
+     * place while it is shared; see unshareFill().
      */
     std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> m_FilledPolysList;
 
@@ -894,6 +1004,14 @@ protected:
     /// A hash value used in zone filling calculations to see if the filled areas are up to date
     std::map<PCB_LAYER_ID, MD5_HASH>       m_filledPolysHash;
 
+    /// For each layer, the hash of the inputs of its fill (see SetFillInputHash())
+    std::map<PCB_LAYER_ID, size_t>         m_fillInputHashes;
+
+    /// For each layer, the decimated fill drawn when zoomed out, and the hash of the fill it
+    /// was made from (see GetFillProxy())
+    mutable std::map<PCB_LAYER_ID, std::pair<MD5_HASH, std::shared_ptr<SHAPE_POLY_SET>>>
+                                           m_fillProxies;
+
     ZONE_BORDER_DISPLAY_STYLE m_borderStyle;       // border display style, see enum above
     int                       m_borderHatchPitch;  // for DIAGONAL_EDGE, distance between 2 lines
     std::vector<SEG>          m_borderHatchLines;  // hatch lines
@@ -901,6 +1019,9 @@ protected:
     /// For each layer, a set of insulated islands that were not removed
     std::map<PCB_LAYER_ID, std::set<int>> m_insulatedIslands;
 
+    /// For each layer, the bounding boxes of the isolated islands removed by the last fill
+    std::map<PCB_LAYER_ID, std::vector<BOX2I>> m_removedIslands;
+
     double                    m_area;              // The filled zone area
     double                    m_outlinearea;       // The outline zone area
 
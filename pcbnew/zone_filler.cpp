@@ -23,7 +23,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <set>
 #include <future>
+#include <numeric>
 #include <core/kicad_algo.h>
 #include <advanced_config.h>
 #include <board.h>
@@ -40,22 +43,61 @@
 #include <board_commit.h>
 #include <progress_reporter.h>
 #include <geometry/shape_poly_set.h>
+#include <geometry/shape_rect.h>
 #include <geometry/convex_hull.h>
+#include <geometry/poly_containment_index.h>
 #include <geometry/geometry_utils.h>
+#include <hash.h>
+#include <hash_eda.h>
+#include <build_version.h>
 #include <confirm.h>
 #include <core/thread_pool.h>
+#include <core/profile.h>
+#include <perf_trace.h>
 #include <math/util.h>      // for KiROUND
 #include "zone_filler.h"
 #include "pcb_dimension.h"
 
 
+/**
+ * Add the time spent in its scope to one of the filler's phase totals.
+ */
+class PHASE_TIMER
+{
+public:
+    PHASE_TIMER( std::atomic<int64_t>& aTotal ) :
+            m_total( aTotal )
+    {}
+
+    ~PHASE_TIMER()
+    {
+        Stop();
+    }
+
+    void Stop()
+    {
+        if( m_running )
+            m_total += m_timer.SinceStart<std::chrono::microseconds>().count();
+
+        m_running = false;
+    }
+
+private:
+    std::atomic<int64_t>& m_total;
+    PROF_TIMER            m_timer;
+    bool                  m_running = true;
+};
+
+
 ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
         m_board( aBoard ),
         m_brdOutlinesValid( false ),
         m_commit( aCommit ),
         m_progressReporter( nullptr ),
+        m_threadPool( nullptr ),
         m_maxError( ARC_HIGH_DEF ),
-        m_worstClearance( 0 )
+        m_worstClearance( 0 ),
+        m_knockoutCache( std::make_shared<ZONE_KNOCKOUT_CACHE>() )
 {
     // To enable add "DebugZoneFiller=1" to kicad_advanced settings file.
     m_debugZoneFiller = ADVANCED_CFG::GetCfg().m_DebugZoneFiller;
@@ -70,8 +112,6 @@ ZONE_FILLER::~ZONE_FILLER()
 void ZONE_FILLER::SetProgressReporter( PROGRESS_REPORTER* aReporter )
 {
     m_progressReporter = aReporter;
-    wxASSERT_MSG( m_commit, wxT( "ZONE_FILLER must have a valid commit to call "
-                                 "SetProgressReporter" ) );
 }
 
 
@@ -87,14 +127,20 @@ void ZONE_FILLER::SetProgressReporter( PROGRESS_REPORTER* aReporter )
  */
 bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aParent )
 {
+    SCOPED_TRACE_ZONE           traceZone( "Zone fill" );
     std::lock_guard<KISPINLOCK> lock( m_board->GetConnectivity()->GetLock() );
 
+    PERF_TRACE::Counter( "Zones to fill", static_cast<int64_t>( aZones.size() ) );
+
     std::vector<std::pair<ZONE*, PCB_LAYER_ID>>               toFill;
     std::map<std::pair<ZONE*, PCB_LAYER_ID>, MD5_HASH>        oldFillHashes;
     std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>> isolatedIslandsMap;
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
 
+    for( std::atomic<int64_t>& phaseTotal : m_phaseTimes )
+        phaseTotal = 0;
+
     // Rebuild (from scratch, ignoring dirty flags) just in case. This really needs to be reliable.
     connectivity->ClearRatsnest();
     connectivity->Build( m_board, m_progressReporter );
@@ -119,17 +165,10 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
     for( ZONE* zone : m_board->Zones() )
         zone->CacheBoundingBox();
 
+    m_board->PrebuildPadShapes();
+
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
-        for( PAD* pad : footprint->Pads() )
-        {
-            if( pad->IsDirty() )
-            {
-                pad->BuildEffectiveShapes( UNDEFINED_LAYER );
-                pad->BuildEffectivePolygon( ERROR_OUTSIDE );
-            }
-        }
-
         for( ZONE* zone : footprint->Zones() )
             zone->CacheBoundingBox();
 
@@ -295,6 +334,185 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         }
     }
 
+    thread_pool& tp = m_threadPool ? *m_threadPool : GetKiCadThreadPool();
+
+    // Zones whose inputs haven't changed since they were last filled can keep their fill.
+    // Refilling a zone can still change the fills of the lower-priority zones it knocks out and
+    // the islands of same-net zones it overlaps, so those have to be refilled along with it.
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, size_t> fillInputHashes;
+    std::set<ZONE*>                                  unchangedZones;
+
+    if( !m_debugZoneFiller && ADVANCED_CFG::GetCfg().m_SkipUnchangedZoneFills )
+    {
+        const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+        const ADVANCED_CFG&          cfg = ADVANCED_CFG::GetCfg();
+
+        size_t boardHash = hash_val( GetBuildVersion().ToStdString(), m_brdOutlinesValid,
+                                     bds.m_MaxError, bds.m_ZoneKeepExternalFillets,
+                                     m_worstClearance, cfg.m_ExtraClearance,
+                                     cfg.m_ZoneFillTileSize );
+
+        for( auto it = m_boardOutline.CIterateWithHoles(); it; it++ )
+            hash_combine( boardHash, it->x, it->y );
+
+        std::vector<std::pair<ZONE*, PCB_LAYER_ID>> zoneLayers;
+
+        for( ZONE* zone : aZones )
+        {
+            if( zone->GetIsRuleArea() || zone->GetNumCorners() <= 2 )
+                continue;
+
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                zoneLayers.emplace_back( zone, layer );
+        }
+
+        std::vector<size_t> hashes( zoneLayers.size() );
+
+        tp.parallelize_loop( 0, zoneLayers.size(),
+                             [&]( size_t aStart, size_t aEnd )
+                             {
+                                 for( size_t ii = aStart; ii < aEnd; ++ii )
+                                 {
+                                     hashes[ii] = fillInputHash( zoneLayers[ii].first,
+                                                                 zoneLayers[ii].second,
+                                                                 boardHash );
+                                 }
+                             } ).wait();
+
+        std::set<ZONE*> changedZones;
+
+        for( size_t ii = 0; ii < zoneLayers.size(); ++ii )
+        {
+            auto [ zone, layer ] = zoneLayers[ii];
+
+            fillInputHashes[ zoneLayers[ii] ] = hashes[ii];
+
+            if( !zone->IsFilled() || zone->GetFillInputHash( layer ) != hashes[ii] )
+                changedZones.insert( zone );
+        }
+
+        for( bool grew = true; grew; )
+        {
+            grew = false;
+
+            for( const auto& [ zoneLayer, hash ] : fillInputHashes )
+            {
+                ZONE* zone = zoneLayer.first;
+
+                if( changedZones.count( zone ) )
+                    continue;
+
+                for( ZONE* changed : changedZones )
+                {
+                    if( ( changed->GetLayerSet() & zone->GetLayerSet() ).none() )
+                        continue;
+
+                    if( !changed->SameNet( zone ) && !changed->HigherPriority( zone ) )
+                        continue;
+
+                    BOX2I inflatedBBox = changed->GetBoundingBox();
+                    inflatedBBox.Inflate( m_worstClearance );
+
+                    if( inflatedBBox.Intersects( zone->GetBoundingBox() ) )
+                    {
+                        changedZones.insert( zone );
+                        grew = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        for( const auto& [ zoneLayer, hash ] : fillInputHashes )
+        {
+            if( !changedZones.count( zoneLayer.first ) )
+                unchangedZones.insert( zoneLayer.first );
+        }
+    }
+
+    // Work out which zone layers can be patched inside their dirty areas rather than refilled
+    // from scratch.  This is only possible if the existing fill can be trusted outside those
+    // areas, which rules out hatched fills (whose grid is anchored to the whole fill) and fills
+    // with removed islands which are unknown or which an edit might reconnect.
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, std::vector<BOX2I>> dirtyAreas;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET>     previousFills;
+
+    if( !aCheck && !m_debugZoneFiller && ADVANCED_CFG::GetCfg().m_EnableRegionZoneRefill )
+    {
+        for( ZONE* zone : aZones )
+        {
+            auto it = m_dirtyAreas.find( zone->m_Uuid );
+
+            if( it == m_dirtyAreas.end() || it->second.empty() )
+                continue;
+
+            if( zone->GetIsRuleArea() || zone->GetNumCorners() <= 2 || !zone->IsFilled()
+                    || !zone->IsOnCopperLayer()
+                    || zone->GetFillMode() != ZONE_FILL_MODE::POLYGONS )
+            {
+                continue;
+            }
+
+            int                margin = getDirtyAreaMargin( zone );
+            std::vector<BOX2I> areas;
+            double             totalArea = 0.0;
+
+            for( BOX2I area : it->second )
+            {
+                area.Inflate( margin );
+
+                // Merge with any overlapping areas (restarting each time as the merged area
+                // may now overlap areas which have already been visited).
+                for( auto ii = areas.begin(); ii != areas.end(); )
+                {
+                    if( ii->Intersects( area ) )
+                    {
+                        area.Merge( *ii );
+                        areas.erase( ii );
+                        ii = areas.begin();
+                    }
+                    else
+                    {
+                        ++ii;
+                    }
+                }
+
+                areas.push_back( area );
+            }
+
+            for( const BOX2I& area : areas )
+                totalArea += (double) area.GetArea();
+
+            // Past a certain point patching costs more than it saves
+            if( totalArea > (double) zone->GetBoundingBox().GetArea() / 2.0 )
+                continue;
+
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            {
+                const std::vector<BOX2I>* removedIslands = zone->GetRemovedIslands( layer );
+
+                if( !removedIslands || !zone->HasFilledPolysForLayer( layer ) )
+                    continue;
+
+                bool canPatch = true;
+
+                for( const BOX2I& island : *removedIslands )
+                {
+                    for( const BOX2I& area : areas )
+                    {
+                        if( island.Intersects( area ) )
+                            canPatch = false;
+                    }
+                }
+
+                if( canPatch )
+                    dirtyAreas[ { zone, layer } ] = areas;
+            }
+        }
+    }
+
+    m_dirtyAreas.clear();
+
     for( ZONE* zone : aZones )
     {
         // Rule areas are not filled
@@ -305,6 +523,9 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         if( zone->GetNumCorners() <= 2 )
             continue;
 
+        if( unchangedZones.count( zone ) )
+            continue;
+
         if( m_commit )
             m_commit->Modify( zone );
 
@@ -315,6 +536,18 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             zone->BuildHashValue( layer );
             oldFillHashes[ { zone, layer } ] = zone->GetHashValue( layer );
 
+            // Keep the existing fill of zones which are going to be patched (the islands it
+            // has already lost stay lost, so we keep their record too)
+            if( dirtyAreas.count( { zone, layer } ) )
+            {
+                previousFills[ { zone, layer } ] =
+                        zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+            }
+            else
+            {
+                zone->ClearRemovedIslands( layer );
+            }
+
             // Add the zone to the list of zones to test or refill
             toFill.emplace_back( std::make_pair( zone, layer ) );
 
@@ -367,120 +600,232 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                 return aZone->Outline()->Collide( aOtherZone->Outline(), m_worstClearance );
             };
 
-    auto fill_lambda =
-            [&]( std::pair<ZONE*, PCB_LAYER_ID> aFillItem ) -> int
+    // Split the fills of large zones into tiles which can be computed in parallel.  (Hatched
+    // fills can't be tiled as their grid is anchored to the whole fill, and patched fills are
+    // already limited to their dirty areas.)
+    struct FILL_STATE
+    {
+        std::vector<BOX2I>          m_tiles;
+        std::vector<SHAPE_POLY_SET> m_tileFills;
+        std::atomic<size_t>         m_pendingTiles = 0;
+        std::atomic<size_t>         m_pendingDeps = 0;
+        std::vector<size_t>         m_dependents;
+    };
+
+    std::vector<FILL_STATE> states( toFill.size() );
+    int                     tileSize = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ZoneFillTileSize );
+
+    if( tileSize > 0 && !m_debugZoneFiller )
+    {
+        for( size_t ii = 0; ii < toFill.size(); ++ii )
+        {
+            ZONE* zone = toFill[ii].first;
+
+            if( dirtyAreas.count( toFill[ii] ) || !zone->IsOnCopperLayer()
+                    || zone->GetFillMode() != ZONE_FILL_MODE::POLYGONS )
             {
-                PCB_LAYER_ID layer = aFillItem.second;
-                ZONE*        zone = aFillItem.first;
-                bool         canFill = true;
+                continue;
+            }
 
-                // Check for any fill dependencies.  If our zone needs to be clipped by
-                // another zone then we can't fill until that zone is filled.
-                for( ZONE* otherZone : aZones )
-                {
-                    if( otherZone == zone )
-                        continue;
+            // Each tile is computed over an area inflated by the margin; don't let that
+            // overhead dominate
+            int margin = getDirtyAreaMargin( zone );
+
+            if( tileSize < 8 * margin )
+                continue;
+
+            BOX2I bbox = zone->GetBoundingBox();
+            bbox.Inflate( margin );
 
-                    if( check_fill_dependency( zone, layer, otherZone ) )
+            int cols = std::max( 1, KiROUND( (double) bbox.GetWidth() / tileSize ) );
+            int rows = std::max( 1, KiROUND( (double) bbox.GetHeight() / tileSize ) );
+
+            if( cols * rows <= 1 )
+                continue;
+
+            auto tileEdge =
+                    []( int aStart, int aLength, int aIndex, int aCount ) -> int
                     {
-                        canFill = false;
-                        break;
-                    }
+                        return aStart + (int) ( (int64_t) aLength * aIndex / aCount );
+                    };
+
+            for( int row = 0; row < rows; ++row )
+            {
+                for( int col = 0; col < cols; ++col )
+                {
+                    VECTOR2I tileStart( tileEdge( bbox.GetX(), bbox.GetWidth(), col, cols ),
+                                        tileEdge( bbox.GetY(), bbox.GetHeight(), row, rows ) );
+                    VECTOR2I tileEnd( tileEdge( bbox.GetX(), bbox.GetWidth(), col + 1, cols ),
+                                      tileEdge( bbox.GetY(), bbox.GetHeight(), row + 1, rows ) );
+
+                    states[ii].m_tiles.emplace_back( tileStart, tileEnd - tileStart );
                 }
+            }
 
-                if( m_progressReporter && m_progressReporter->IsCancelled() )
-                    return 0;
+            states[ii].m_tileFills.resize( states[ii].m_tiles.size() );
+        }
+    }
 
-                if( !canFill )
-                    return 0;
+    // Work out the fill dependencies up front so that each zone layer can be queued as soon as
+    // the zones it has to knock out are filled, rather than polling for them.
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, size_t> fillIndices;
 
-                // Now we're ready to fill.
-                {
-                    std::unique_lock<std::mutex> zoneLock( zone->GetLock(), std::try_to_lock );
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+        fillIndices[ toFill[ii] ] = ii;
 
-                    if( !zoneLock.owns_lock() )
-                        return 0;
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+    {
+        auto [ zone, layer ] = toFill[ii];
 
-                    SHAPE_POLY_SET fillPolys;
+        for( ZONE* otherZone : aZones )
+        {
+            if( otherZone == zone || !check_fill_dependency( zone, layer, otherZone ) )
+                continue;
 
-                    if( !fillSingleZone( zone, layer, fillPolys ) )
-                        return 0;
+            auto it = fillIndices.find( { otherZone, layer } );
 
-                    zone->SetFilledPolysList( layer, fillPolys );
-                }
+            if( it != fillIndices.end() )
+            {
+                states[ it->second ].m_dependents.push_back( ii );
+                states[ii].m_pendingDeps++;
+            }
+        }
+    }
 
-                if( m_progressReporter )
-                    m_progressReporter->AdvanceProgress();
+    // Calculate the copper fills (NB: this is multi-threaded)
+    //
+    // Each task queues its successors itself: the tiles of a zone layer are stitched together
+    // by whichever tile finishes last, and a finished zone layer releases the zone layers which
+    // were waiting on it.
+    std::atomic<size_t> inFlight = 0;
+    std::atomic<bool>   cancelled = false;
 
-                return 1;
-            };
+    std::function<void( size_t )> queue_fill;
 
-    auto tesselate_lambda =
-            [&]( std::pair<ZONE*, PCB_LAYER_ID> aFillItem ) -> int
+    auto isCancelled =
+            [&]() -> bool
             {
-                if( m_progressReporter && m_progressReporter->IsCancelled() )
-                    return 0;
+                return cancelled || ( m_progressReporter && m_progressReporter->IsCancelled() );
+            };
 
-                PCB_LAYER_ID layer = aFillItem.second;
-                ZONE*        zone = aFillItem.first;
+    auto finish_fill =
+            [&]( size_t aIdx, const SHAPE_POLY_SET& aFillPolys )
+            {
+                ZONE*        zone = toFill[aIdx].first;
+                PCB_LAYER_ID layer = toFill[aIdx].second;
 
                 {
-                    std::unique_lock<std::mutex> zoneLock( zone->GetLock(), std::try_to_lock );
-
-                    if( !zoneLock.owns_lock() )
-                        return 0;
+                    std::lock_guard<std::mutex> zoneLock( zone->GetLock() );
 
+                    zone->SetFilledPolysList( layer, aFillPolys );
                     zone->CacheTriangulation( layer );
                     zone->SetFillFlag( layer, true );
                 }
 
-                return 1;
+                if( m_progressReporter )
+                    m_progressReporter->AdvanceProgress();
+
+                for( size_t dependent : states[aIdx].m_dependents )
+                {
+                    if( --states[dependent].m_pendingDeps == 0 )
+                        queue_fill( dependent );
+                }
             };
 
-    // Calculate the copper fills (NB: this is multi-threaded)
-    //
-    std::vector<std::pair<std::future<int>, int>> returns;
-    returns.reserve( toFill.size() );
-    size_t finished = 0;
-    bool cancelled = false;
+    auto fill_lambda =
+            [&]( size_t aIdx )
+            {
+                ZONE*          zone = toFill[aIdx].first;
+                PCB_LAYER_ID   layer = toFill[aIdx].second;
+                SHAPE_POLY_SET fillPolys;
+                auto           areasIt = dirtyAreas.find( toFill[aIdx] );
 
-    thread_pool& tp = GetKiCadThreadPool();
+                if( areasIt != dirtyAreas.end() )
+                {
+                    fillPolys = previousFills.at( toFill[aIdx] );
+                    refillZoneAreas( zone, layer, areasIt->second, fillPolys );
+                }
+                else
+                {
+                    fillSingleZone( zone, layer, fillPolys );
+                }
 
-    for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
-        returns.emplace_back( std::make_pair( tp.submit( fill_lambda, fillItem ), 0 ) );
+                if( !isCancelled() )
+                    finish_fill( aIdx, fillPolys );
+            };
 
-    while( !cancelled && finished != 2 * toFill.size() )
-    {
-        for( size_t ii = 0; ii < returns.size(); ++ii )
-        {
-            auto& ret = returns[ii];
+    auto fill_tile_lambda =
+            [&]( size_t aIdx, size_t aTile )
+            {
+                FILL_STATE& state = states[aIdx];
 
-            if( ret.second > 1 )
-                continue;
+                if( !isCancelled() )
+                {
+                    fillZoneTile( toFill[aIdx].first, toFill[aIdx].second, state.m_tiles[aTile],
+                                  state.m_tileFills[aTile] );
+                }
+
+                if( --state.m_pendingTiles == 0 && !isCancelled() )
+                {
+                    SHAPE_POLY_SET fillPolys;
 
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
+                    for( const SHAPE_POLY_SET& tileFill : state.m_tileFills )
+                        fillPolys.Append( tileFill );
 
-            if( status == std::future_status::ready )
+                    {
+                        PHASE_TIMER timer( phaseTime( ZONE_FILL_PHASE::FRACTURE ) );
+
+                        fillPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+                        fillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+                    }
+
+                    finish_fill( aIdx, fillPolys );
+                }
+            };
+
+    queue_fill =
+            [&]( size_t aIdx )
             {
-                if( ret.first.get() )   // lambda completed
+                FILL_STATE& state = states[aIdx];
+
+                if( state.m_tiles.empty() )
                 {
-                    ++finished;
-                    ret.second++;       // go to next step
+                    inFlight++;
+                    tp.push_task(
+                            [&, aIdx]()
+                            {
+                                fill_lambda( aIdx );
+                                inFlight--;
+                            } );
+
+                    return;
                 }
 
-                if( !cancelled )
+                state.m_pendingTiles = state.m_tiles.size();
+
+                for( size_t jj = 0; jj < state.m_tiles.size(); ++jj )
                 {
-                    // Queue the next step (will re-queue the existing step if it didn't complete)
-                    if( ret.second == 0 )
-                        returns[ii].first = tp.submit( fill_lambda, toFill[ii] );
-                    else if( ret.second == 1 )
-                        returns[ii].first = tp.submit( tesselate_lambda, toFill[ii] );
+                    inFlight++;
+                    tp.push_task(
+                            [&, aIdx, jj]()
+                            {
+                                fill_tile_lambda( aIdx, jj );
+                                inFlight--;
+                            } );
                 }
-            }
-        }
+            };
 
-        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+    {
+        if( states[ii].m_pendingDeps == 0 )
+            queue_fill( ii );
+    }
 
+    // Successors are queued before their predecessor's task is retired, so the fill is done
+    // when nothing is left in flight.
+    while( inFlight > 0 )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
 
         if( m_progressReporter )
         {
@@ -491,24 +836,6 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         }
     }
 
-    // Make sure that all futures have finished.
-    // This can happen when the user cancels the above operation
-    for( auto& ret : returns )
-    {
-        if( ret.first.valid() )
-        {
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
-
-            while( status != std::future_status::ready )
-            {
-                if( m_progressReporter )
-                    m_progressReporter->KeepRefreshing();
-
-                status = ret.first.wait_for( std::chrono::milliseconds( 100 ) );
-            }
-        }
-    }
-
     // Now update the connectivity to check for isolated copper islands
     // (NB: FindIsolatedCopperIslands() is multi-threaded)
     //
@@ -522,6 +849,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         m_progressReporter->KeepRefreshing();
     }
 
+    PHASE_TIMER islandTimer( phaseTime( ZONE_FILL_PHASE::ISLANDS ) );
+
     connectivity->SetProgressReporter( m_progressReporter );
     connectivity->FillIsolatedIslandsMap( isolatedIslandsMap );
     connectivity->SetProgressReporter( nullptr );
@@ -581,12 +910,16 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             {
                 SHAPE_LINE_CHAIN& outline = poly->Outline( idx );
 
-                if( mode == ISLAND_REMOVAL_MODE::ALWAYS )
-                    poly->DeletePolygonAndTriangulationData( idx, false );
-                else if ( mode == ISLAND_REMOVAL_MODE::AREA && outline.Area( true ) < minArea )
+                if( mode == ISLAND_REMOVAL_MODE::ALWAYS
+                        || ( mode == ISLAND_REMOVAL_MODE::AREA && outline.Area( true ) < minArea ) )
+                {
+                    zone->AddRemovedIsland( layer, outline.BBox() );
                     poly->DeletePolygonAndTriangulationData( idx, false );
+                }
                 else
+                {
                     zone->SetIsIsland( layer, idx );
+                }
             }
 
             poly->UpdateTriangulationDataHash();
@@ -608,6 +941,11 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
     for( ZONE* zone : aZones )
     {
+        // Unchanged zones had their islands outside the board removed when they were filled.
+        // (Their fills may also be shared with the undo copies, so must not be edited in place.)
+        if( unchangedZones.count( zone ) )
+            continue;
+
         LSET   zoneCopperLayers = zone->GetLayerSet() & LSET::AllCuMask( MAX_CU_LAYERS );
 
         // Min-thickness is the web thickness.  On the other hand, a blob min-thickness by
@@ -702,9 +1040,16 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         }
     }
 
+    islandTimer.Stop();
+
     for( ZONE* zone : aZones )
         zone->CalculateFilledArea();
 
+    for( const auto& [ zoneLayer, hash ] : fillInputHashes )
+    {
+        if( !unchangedZones.count( zoneLayer.first ) )
+            zoneLayer.first->SetFillInputHash( zoneLayer.second, hash );
+    }
 
     if( aCheck )
     {
@@ -713,7 +1058,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         for( ZONE* zone : aZones )
         {
             // Keepout zones are not filled
-            if( zone->GetIsRuleArea() )
+            if( zone->GetIsRuleArea() || unchangedZones.count( zone ) )
                 continue;
 
             for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
@@ -783,7 +1128,13 @@ void ZONE_FILLER::addKnockout( PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_P
     }
     else
     {
-        aPad->TransformShapeToPolygon( aHoles, aLayer, aGap, m_maxError, ERROR_OUTSIDE );
+        // Non-custom pads have the same shape on all layers
+        m_knockoutCache->Append( aPad, UNDEFINED_LAYER, false, aGap, m_maxError, aHoles,
+                [&]( SHAPE_POLY_SET& aBuffer )
+                {
+                    aPad->TransformShapeToPolygon( aBuffer, aLayer, aGap, m_maxError,
+                                                   ERROR_OUTSIDE );
+                } );
     }
 }
 
@@ -793,7 +1144,11 @@ void ZONE_FILLER::addKnockout( PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_P
  */
 void ZONE_FILLER::addHoleKnockout( PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles )
 {
-    aPad->TransformHoleToPolygon( aHoles, aGap, m_maxError, ERROR_OUTSIDE );
+    m_knockoutCache->Append( aPad, UNDEFINED_LAYER, true, aGap, m_maxError, aHoles,
+            [&]( SHAPE_POLY_SET& aBuffer )
+            {
+                aPad->TransformHoleToPolygon( aBuffer, aGap, m_maxError, ERROR_OUTSIDE );
+            } );
 }
 
 
@@ -870,7 +1225,7 @@ void ZONE_FILLER::addKnockout( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, int aGap,
  * in spokes, which must be done later.
  */
 void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                          SHAPE_POLY_SET& aFill,
+                                          const BOX2I& aFillBBox, SHAPE_POLY_SET& aFill,
                                           std::vector<PAD*>& aThermalConnectionPads,
                                           std::vector<PAD*>& aNoConnectionPads )
 {
@@ -889,7 +1244,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
             BOX2I padBBox = pad->GetBoundingBox();
             padBBox.Inflate( m_worstClearance );
 
-            if( !padBBox.Intersects( aZone->GetBoundingBox() ) )
+            if( !padBBox.Intersects( aFillBBox ) )
                 continue;
 
             bool noConnection = pad->GetNetCode() != aZone->GetNetCode();
@@ -963,7 +1318,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
                     else
                         holeClearance = padClearance;
 
-                    pad->TransformHoleToPolygon( holes, holeClearance, m_maxError, ERROR_OUTSIDE );
+                    addHoleKnockout( pad, holeClearance, holes );
                 }
 
                 break;
@@ -984,6 +1339,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
  * not connected to it.
  */
 void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                             const BOX2I& aFillBBox,
                                              const std::vector<PAD*> aNoConnectionPads,
                                              SHAPE_POLY_SET& aHoles )
 {
@@ -999,7 +1355,7 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
     // A small extra clearance to be sure actual track clearances are not smaller than
     // requested clearance due to many approximations in calculations, like arc to segment
     // approx, rounding issues, etc.
-    BOX2I zone_boundingbox = aZone->GetBoundingBox();
+    BOX2I zone_boundingbox = aFillBBox;
     int   extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
 
     // Items outside the zone bounding box are skipped, so it needs to be inflated by the
@@ -1094,8 +1450,15 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
 
                         if( via->FlashLayer( aLayer ) && gap > 0 )
                         {
-                            via->TransformShapeToPolygon( aHoles, aLayer, gap + extra_margin,
-                                                          m_maxError, ERROR_OUTSIDE );
+                            // Vias have the same shape on all the layers they flash
+                            m_knockoutCache->Append( via, UNDEFINED_LAYER, false,
+                                    gap + extra_margin, m_maxError, aHoles,
+                                    [&]( SHAPE_POLY_SET& aBuffer )
+                                    {
+                                        via->TransformShapeToPolygon( aBuffer, aLayer,
+                                                                      gap + extra_margin,
+                                                                      m_maxError, ERROR_OUTSIDE );
+                                    } );
                         }
 
                         gap = std::max( gap, evalRulesForItems( PHYSICAL_HOLE_CLEARANCE_CONSTRAINT,
@@ -1120,8 +1483,15 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                     {
                         if( gap > 0 )
                         {
-                            aTrack->TransformShapeToPolygon( aHoles, aLayer, gap + extra_margin,
-                                                             m_maxError, ERROR_OUTSIDE );
+                            m_knockoutCache->Append( aTrack, aLayer, false, gap + extra_margin,
+                                    m_maxError, aHoles,
+                                    [&]( SHAPE_POLY_SET& aBuffer )
+                                    {
+                                        aTrack->TransformShapeToPolygon( aBuffer, aLayer,
+                                                                         gap + extra_margin,
+                                                                         m_maxError,
+                                                                         ERROR_OUTSIDE );
+                                    } );
                         }
                     }
                 }
@@ -1417,7 +1787,7 @@ void ZONE_FILLER::subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID a
  * 6 - Adds in the remaining spokes
  */
 bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
-                                  const SHAPE_POLY_SET& aSmoothedOutline,
+                                  const BOX2I& aFillBBox, const SHAPE_POLY_SET& aSmoothedOutline,
                                   const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys )
 {
     m_maxError = m_board->GetDesignSettings().m_MaxError;
@@ -1456,7 +1826,13 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout thermal reliefs.
      */
 
-    knockoutThermalReliefs( aZone, aLayer, aFillPolys, thermalConnectionPads, noConnectionPads );
+    {
+        PHASE_TIMER timer( phaseTime( ZONE_FILL_PHASE::CLEARANCES ) );
+
+        knockoutThermalReliefs( aZone, aLayer, aFillBBox, aFillPolys, thermalConnectionPads,
+                                noConnectionPads );
+    }
+
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In2_Cu, wxT( "minus-thermal-reliefs" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1466,7 +1842,12 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout electrical clearances.
      */
 
-    buildCopperItemClearances( aZone, aLayer, noConnectionPads, clearanceHoles );
+    {
+        PHASE_TIMER timer( phaseTime( ZONE_FILL_PHASE::CLEARANCES ) );
+
+        buildCopperItemClearances( aZone, aLayer, aFillBBox, noConnectionPads, clearanceHoles );
+    }
+
     DUMP_POLYS_TO_COPPER_LAYER( clearanceHoles, In3_Cu, wxT( "clearance-holes" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1476,7 +1857,9 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Add thermal relief spokes.
      */
 
-    buildThermalSpokes( aZone, aLayer, thermalConnectionPads, thermalSpokes );
+    PHASE_TIMER spokeTimer( phaseTime( ZONE_FILL_PHASE::SPOKES ) );
+
+    buildThermalSpokes( aZone, aLayer, aFillBBox, thermalConnectionPads, thermalSpokes );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
@@ -1484,43 +1867,91 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     // Create a temporary zone that we can hit-test spoke-ends against.  It's only temporary
     // because the "real" subtract-clearance-holes has to be done after the spokes are added.
     static const bool USE_BBOX_CACHES = true;
-    SHAPE_POLY_SET testAreas = aFillPolys.CloneDropTriangulation();
-    testAreas.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
-    DUMP_POLYS_TO_COPPER_LAYER( testAreas, In4_Cu, wxT( "minus-clearance-holes" ) );
+    SHAPE_POLY_SET testAreas;
 
-    // Prune features that don't meet minimum-width criteria
-    if( half_min_width - epsilon > epsilon )
+    if( !m_debugZoneFiller )
+    {
+        // Nothing looks at the intermediate steps: keep them in Clipper2's format
+        SHAPE_POLY_SET::BOOLEAN_CHAIN chain( aFillPolys );
+
+        chain.Subtract( clearanceHoles );
+
+        // Prune features that don't meet minimum-width criteria
+        if( half_min_width - epsilon > epsilon )
+        {
+            chain.Deflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
+            chain.Inflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
+        }
+
+        chain.Finish( testAreas );
+    }
+    else
     {
-        testAreas.Deflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
-        DUMP_POLYS_TO_COPPER_LAYER( testAreas, In5_Cu, wxT( "spoke-test-deflated" ) );
+        testAreas = aFillPolys.CloneDropTriangulation();
+        testAreas.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+        DUMP_POLYS_TO_COPPER_LAYER( testAreas, In4_Cu, wxT( "minus-clearance-holes" ) );
+
+        // Prune features that don't meet minimum-width criteria
+        if( half_min_width - epsilon > epsilon )
+        {
+            testAreas.Deflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
+            DUMP_POLYS_TO_COPPER_LAYER( testAreas, In5_Cu, wxT( "spoke-test-deflated" ) );
 
-        testAreas.Inflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
-        DUMP_POLYS_TO_COPPER_LAYER( testAreas, In6_Cu, wxT( "spoke-test-reinflated" ) );
+            testAreas.Inflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
+            DUMP_POLYS_TO_COPPER_LAYER( testAreas, In6_Cu, wxT( "spoke-test-reinflated" ) );
+        }
     }
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    // Spoke-end-testing is hugely expensive so we generate cached bounding-boxes to speed
-    // things up a bit.
-    testAreas.BuildBBoxCaches();
-    int interval = 0;
+    // Spoke-end-testing is hugely expensive, so rather than hit-testing each spoke against the
+    // zone body we index the zone's edges once and test all the spoke ends in a single sweep.
+    POLY_CONTAINMENT_INDEX testIndex( testAreas );
+    std::vector<VECTOR2I>  testPts;
 
-    SHAPE_POLY_SET debugSpokes;
+    testPts.reserve( thermalSpokes.size() );
 
     for( const SHAPE_LINE_CHAIN& spoke : thermalSpokes )
+        testPts.push_back( spoke.CPoint( 3 ) );
+
+    std::vector<bool> connected = testIndex.Contains( testPts );
+
+    // Spokes which don't hit the zone body can still be connected by another spoke (ie: a pad
+    // in a narrow neck of the zone).  Sort the spokes on their left edge so that each test only
+    // visits spokes whose bounding box could contain the test point.
+    std::vector<BOX2I>  spokeBBoxes;
+    std::vector<size_t> byLeft;
+    int                 maxSpokeWidth = 0;
+
+    spokeBBoxes.reserve( thermalSpokes.size() );
+
+    for( size_t ii = 0; ii < thermalSpokes.size(); ii++ )
     {
-        const VECTOR2I& testPt = spoke.CPoint( 3 );
+        spokeBBoxes.push_back( thermalSpokes[ii].BBox() );
+        maxSpokeWidth = std::max( maxSpokeWidth, spokeBBoxes.back().GetWidth() );
 
-        // Hit-test against zone body
-        if( testAreas.Contains( testPt, -1, 1, USE_BBOX_CACHES ) )
-        {
-            if( m_debugZoneFiller )
-                debugSpokes.AddOutline( spoke );
+        if( !connected[ii] )
+            byLeft.push_back( ii );
+    }
+
+    if( !byLeft.empty() )
+    {
+        byLeft.resize( thermalSpokes.size() );
+        std::iota( byLeft.begin(), byLeft.end(), 0 );
+        std::sort( byLeft.begin(), byLeft.end(),
+                   [&]( size_t a, size_t b )
+                   {
+                       return spokeBBoxes[a].GetLeft() < spokeBBoxes[b].GetLeft();
+                   } );
+    }
+
+    int interval = 0;
 
-            aFillPolys.AddOutline( spoke );
+    for( size_t ii = 0; ii < thermalSpokes.size(); ii++ )
+    {
+        if( connected[ii] )
             continue;
-        }
 
         if( interval++ > 400 )
         {
@@ -1530,24 +1961,52 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
             interval = 0;
         }
 
+        const SHAPE_LINE_CHAIN& spoke = thermalSpokes[ii];
+        const VECTOR2I&         testPt = testPts[ii];
+
+        auto it = std::upper_bound( byLeft.begin(), byLeft.end(), testPt.x,
+                                    [&]( int x, size_t idx )
+                                    {
+                                        return x < spokeBBoxes[idx].GetLeft();
+                                    } );
+
         // Hit-test against other spokes
-        for( const SHAPE_LINE_CHAIN& other : thermalSpokes )
+        while( it != byLeft.begin() )
         {
+            size_t otherIdx = *--it;
+
+            if( spokeBBoxes[otherIdx].GetLeft() < testPt.x - maxSpokeWidth )
+                break;
+
+            const SHAPE_LINE_CHAIN& other = thermalSpokes[otherIdx];
+
             // Hit test in both directions to avoid interactions with round-off errors.
             // (See https://gitlab.com/kicad/code/kicad/-/issues/13316.)
-            if( &other != &spoke
-                && other.PointInside( testPt, 1, USE_BBOX_CACHES )
+            if( otherIdx != ii
+                && spokeBBoxes[otherIdx].Contains( testPt )
+                && other.PointInside( testPt, 1 )
                 && spoke.PointInside( other.CPoint( 3 ), 1, USE_BBOX_CACHES ) )
             {
-                if( m_debugZoneFiller )
-                    debugSpokes.AddOutline( spoke );
-
-                aFillPolys.AddOutline( spoke );
+                connected[ii] = true;
                 break;
             }
         }
     }
 
+    SHAPE_POLY_SET debugSpokes;
+
+    for( size_t ii = 0; ii < thermalSpokes.size(); ii++ )
+    {
+        if( !connected[ii] )
+            continue;
+
+        if( m_debugZoneFiller )
+            debugSpokes.AddOutline( thermalSpokes[ii] );
+
+        aFillPolys.AddOutline( thermalSpokes[ii] );
+    }
+
+    spokeTimer.Stop();
     DUMP_POLYS_TO_COPPER_LAYER( debugSpokes, In7_Cu, wxT( "spokes" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1629,9 +2088,16 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Lastly give any same-net but higher-priority zones control over their own area.
      */
 
-    subtractHigherPriorityZones( aZone, aLayer, aFillPolys );
+    {
+        PHASE_TIMER timer( phaseTime( ZONE_FILL_PHASE::PRIORITY ) );
+
+        subtractHigherPriorityZones( aZone, aLayer, aFillPolys );
+    }
+
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In18_Cu, wxT( "minus-higher-priority-zones" ) );
 
+    PHASE_TIMER fractureTimer( phaseTime( ZONE_FILL_PHASE::FRACTURE ) );
+
     aFillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
     return true;
 }
@@ -1685,8 +2151,7 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
         knockoutGraphicClearance( item );
     }
 
-    aFillPolys = aSmoothedOutline;
-    aFillPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    std::vector<const SHAPE_POLY_SET*> keepouts;
 
     for( ZONE* keepout : m_board->Zones() )
     {
@@ -1696,7 +2161,7 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
         if( keepout->GetDoNotAllowCopperPour() && keepout->IsOnLayer( aLayer ) )
         {
             if( keepout->GetBoundingBox().Intersects( zone_boundingbox ) )
-                aFillPolys.BooleanSubtract( *keepout->Outline(), SHAPE_POLY_SET::PM_FAST );
+                keepouts.push_back( keepout->Outline() );
         }
     }
 
@@ -1706,7 +2171,16 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
     int half_min_width = aZone->GetMinThickness() / 2;
     int epsilon = pcbIUScale.mmToIU( 0.001 );
 
-    aFillPolys.Deflate( half_min_width - epsilon, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError );
+    // The keepouts are subtracted along with the clearance holes, in a single boolean
+    SHAPE_POLY_SET::BOOLEAN_CHAIN chain( aSmoothedOutline );
+
+    chain.Subtract( clearanceHoles );
+
+    for( const SHAPE_POLY_SET* keepout : keepouts )
+        chain.Subtract( *keepout );
+
+    chain.Deflate( half_min_width - epsilon, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError );
+    chain.Finish( aFillPolys );
 
     // Remove the non filled areas due to the hatch pattern
     if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
@@ -1719,6 +2193,8 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
     if( half_min_width - epsilon > epsilon )
         aFillPolys.Inflate( half_min_width - epsilon, CORNER_STRATEGY::ROUND_ALL_CORNERS, m_maxError );
 
+    PHASE_TIMER fractureTimer( phaseTime( ZONE_FILL_PHASE::FRACTURE ) );
+
     aFillPolys.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
     return true;
 }
@@ -1729,12 +2205,14 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
  * The solid areas can be more than one on copper layers, and do not have holes
  * ( holes are linked by overlapping segments to the main outline)
  */
-bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys )
+bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys,
+                                  const BOX2I* aFillArea )
 {
     SHAPE_POLY_SET* boardOutline = m_brdOutlinesValid ? &m_boardOutline : nullptr;
     SHAPE_POLY_SET  maxExtents;
     SHAPE_POLY_SET  smoothedPoly;
     PCB_LAYER_ID    debugLayer = UNDEFINED_LAYER;
+    BOX2I           fillBBox = aZone->GetBoundingBox();
 
     if( m_debugZoneFiller && LSET::InternalCuMask().Contains( aLayer ) )
     {
@@ -1748,9 +2226,20 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
+    if( aFillArea )
+    {
+        SHAPE_POLY_SET clip;
+        clip.AddOutline( SHAPE_RECT( *aFillArea ).Outline() );
+
+        maxExtents.BooleanIntersection( clip, SHAPE_POLY_SET::PM_FAST );
+        smoothedPoly.BooleanIntersection( clip, SHAPE_POLY_SET::PM_FAST );
+        fillBBox = fillBBox.Intersect( *aFillArea );
+    }
+
     if( aZone->IsOnCopperLayer() )
     {
-        if( fillCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents, aFillPolys ) )
+        if( fillCopperZone( aZone, aLayer, debugLayer, fillBBox, smoothedPoly, maxExtents,
+                            aFillPolys ) )
             aZone->SetNeedRefill( false );
     }
     else
@@ -1763,15 +2252,280 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
 }
 
 
+/**
+ * Rebuild the fill inside each of the given areas and stitch the results into the existing fill.
+ */
+bool ZONE_FILLER::refillZoneAreas( ZONE* aZone, PCB_LAYER_ID aLayer,
+                                   const std::vector<BOX2I>& aAreas, SHAPE_POLY_SET& aFillPolys )
+{
+    SHAPE_POLY_SET windows;
+    SHAPE_POLY_SET patches;
+
+    for( const BOX2I& area : aAreas )
+    {
+        SHAPE_POLY_SET patch;
+
+        if( !fillZoneTile( aZone, aLayer, area, patch ) )
+            return false;
+
+        if( m_progressReporter && m_progressReporter->IsCancelled() )
+            return false;
+
+        windows.AddOutline( SHAPE_RECT( area ).Outline() );
+        patches.Append( patch );
+    }
+
+    aFillPolys.BooleanSubtract( windows, SHAPE_POLY_SET::PM_FAST );
+    aFillPolys.BooleanAdd( patches, SHAPE_POLY_SET::PM_FAST );
+
+    PHASE_TIMER fractureTimer( phaseTime( ZONE_FILL_PHASE::FRACTURE ) );
+
+    aFillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+    return true;
+}
+
+
+bool ZONE_FILLER::fillZoneTile( ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aTile,
+                                SHAPE_POLY_SET& aFillPolys )
+{
+    // The tile is computed over a larger area than the one it covers so that the edge effects
+    // at the limit of the computation (clipped clearances, min-width pruning, spoke hit-testing)
+    // all fall outside of it.
+    BOX2I          fillArea = aTile;
+    SHAPE_POLY_SET window;
+
+    fillArea.Inflate( getDirtyAreaMargin( aZone ) );
+
+    if( !fillSingleZone( aZone, aLayer, aFillPolys, &fillArea ) )
+        return false;
+
+    window.AddOutline( SHAPE_RECT( aTile ).Outline() );
+    aFillPolys.BooleanIntersection( window, SHAPE_POLY_SET::PM_FAST );
+    return true;
+}
+
+
+int ZONE_FILLER::getDirtyAreaMargin( const ZONE* aZone ) const
+{
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    DRC_CONSTRAINT         constraint;
+    int                    thermalReliefGap = aZone->GetThermalReliefGap();
+
+    if( bds.m_DRCEngine
+            && bds.m_DRCEngine->QueryWorstConstraint( THERMAL_RELIEF_GAP_CONSTRAINT, constraint ) )
+    {
+        thermalReliefGap = std::max( thermalReliefGap, constraint.Value().Min() );
+    }
+
+    // Clearances and thermal reliefs reach out from the changed items, and min-width pruning
+    // (a deflate followed by an inflate) can move the fill edge by up to the min thickness.
+    return m_worstClearance + thermalReliefGap + 2 * aZone->GetMinThickness() + bds.m_MaxError
+                + pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+}
+
+
+static void hashPolySet( size_t& aSeed, const SHAPE_POLY_SET& aPoly )
+{
+    hash_combine( aSeed, aPoly.TotalVertices() );
+
+    for( auto it = aPoly.CIterateWithHoles(); it; it++ )
+        hash_combine( aSeed, it->x, it->y );
+}
+
+
+size_t ZONE_FILLER::fillInputHash( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                   size_t aBoardHash ) const
+{
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    const int              itemFlags = HASH_POS | HASH_ROT | HASH_LAYER | HASH_REF | HASH_VALUE;
+    BOX2I                  bbox = aZone->GetBoundingBox();
+    size_t                 ret = aBoardHash;
+
+    // Anything which can reach the fill is within the same margin as for region refills
+    bbox.Inflate( getDirtyAreaMargin( aZone ) );
+
+    auto hashConstraint =
+            [&]( DRC_CONSTRAINT_T aConstraint, const BOARD_ITEM* aItem )
+            {
+                DRC_CONSTRAINT c = bds.m_DRCEngine->EvalRules( aConstraint, aZone, aItem, aLayer );
+                hash_combine( ret, aConstraint, c.GetValue().Min() );
+            };
+
+    auto hashItem =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                size_t itemHash = hash_fp_item( aItem, itemFlags );
+
+                if( itemHash )
+                {
+                    hash_combine( ret, itemHash );
+                }
+                else
+                {
+                    // Not something hash_fp_item() knows about; use its shape instead
+                    SHAPE_POLY_SET poly;
+                    aItem->TransformShapeToPolygon( poly, aLayer, 0, bds.m_MaxError,
+                                                    ERROR_OUTSIDE );
+                    hashPolySet( ret, poly );
+                }
+
+                if( const EDA_TEXT* text = dynamic_cast<const EDA_TEXT*>( aItem ) )
+                {
+                    hash_combine( ret, text->IsVisible(), text->GetTextThickness(),
+                                  text->GetFontName().ToStdString() );
+                }
+
+                // Net names rather than netcodes, which aren't preserved by saving and loading
+                if( auto cItem = dynamic_cast<const BOARD_CONNECTED_ITEM*>( aItem ) )
+                    hash_combine( ret, cItem->GetNetname().ToStdString() );
+
+                hash_combine( ret, aItem->Type(), aItem->IsKnockout() );
+                hashConstraint( CLEARANCE_CONSTRAINT, aItem );
+                hashConstraint( PHYSICAL_CLEARANCE_CONSTRAINT, aItem );
+            };
+
+    auto hashGraphic =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                if( !aItem->GetBoundingBox().Intersects( bbox ) )
+                    return;
+
+                if( aItem->IsOnLayer( Edge_Cuts ) || aItem->IsOnLayer( Margin ) )
+                {
+                    hashItem( aItem );
+                    hashConstraint( EDGE_CLEARANCE_CONSTRAINT, aItem );
+                }
+                else if( aItem->IsOnLayer( aLayer ) )
+                {
+                    hashItem( aItem );
+                }
+            };
+
+    auto hashHoles =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                hashConstraint( HOLE_CLEARANCE_CONSTRAINT, aItem );
+                hashConstraint( PHYSICAL_HOLE_CLEARANCE_CONSTRAINT, aItem );
+            };
+
+    auto hashZone =
+            [&]( const ZONE* aOther )
+            {
+                if( aOther == aZone || !aOther->IsOnLayer( aLayer )
+                        || !aOther->GetBoundingBox().Intersects( bbox ) )
+                {
+                    return;
+                }
+
+                hashPolySet( ret, *aOther->Outline() );
+                hash_combine( ret, aOther->GetNetname().ToStdString(), aOther->GetAssignedPriority(),
+                              aOther->GetTeardropAreaType(), aOther->GetIsRuleArea(),
+                              aOther->GetDoNotAllowCopperPour(), aOther->HigherPriority( aZone ) );
+                hashConstraint( CLEARANCE_CONSTRAINT, aOther );
+                hashConstraint( PHYSICAL_CLEARANCE_CONSTRAINT, aOther );
+            };
+
+    // The zone itself
+    hash_combine( ret, aZone->m_Uuid.Hash(), aLayer, aZone->GetNetname().ToStdString(),
+                  aZone->GetAssignedPriority(), aZone->GetTeardropAreaType(),
+                  aZone->GetLocalClearance(), aZone->GetMinThickness(), aZone->GetFillMode(),
+                  aZone->GetPadConnection(), aZone->GetThermalReliefGap(),
+                  aZone->GetThermalReliefSpokeWidth(), aZone->GetIslandRemovalMode(),
+                  aZone->GetMinIslandArea(), aZone->GetCornerSmoothingType(),
+                  aZone->GetCornerRadius() );
+
+    if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+    {
+        hash_combine( ret, aZone->GetHatchThickness(), aZone->GetHatchGap(),
+                      aZone->GetHatchOrientation().AsDegrees(), aZone->GetHatchSmoothingLevel(),
+                      aZone->GetHatchSmoothingValue(), aZone->GetHatchHoleMinArea(),
+                      aZone->GetHatchBorderAlgorithm() );
+    }
+
+    hashPolySet( ret, *aZone->Outline() );
+
+    // Everything around it
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        if( !footprint->GetBoundingBox().Intersects( bbox ) )
+            continue;
+
+        hash_combine( ret, footprint->IsNetTie() );
+
+        for( const wxString& group : footprint->GetNetTiePadGroups() )
+            hash_combine( ret, group.ToStdString() );
+
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( !pad->GetBoundingBox().Intersects( bbox ) )
+                continue;
+
+            hashItem( pad );
+            hashHoles( pad );
+            hashConstraint( THERMAL_RELIEF_GAP_CONSTRAINT, pad );
+            hashConstraint( THERMAL_SPOKE_WIDTH_CONSTRAINT, pad );
+
+            hash_combine( ret, pad->FlashLayer( aLayer ), pad->GetThermalSpokeAngle().AsDegrees(),
+                          pad->GetCustomShapeInZoneOpt(),
+                          bds.m_DRCEngine->EvalZoneConnection( pad, aZone, aLayer ).m_ZoneConnection );
+
+            if( IsCopperLayer( aLayer ) )
+                hash_combine( ret, pad->GetZoneLayerOverride( aLayer ) );
+        }
+
+        hashGraphic( &footprint->Reference() );
+        hashGraphic( &footprint->Value() );
+
+        for( BOARD_ITEM* item : footprint->GraphicalItems() )
+            hashGraphic( item );
+
+        for( ZONE* otherZone : footprint->Zones() )
+            hashZone( otherZone );
+    }
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( !track->GetBoundingBox().Intersects( bbox ) )
+            continue;
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            PCB_VIA* via = static_cast<PCB_VIA*>( track );
+
+            hashItem( via );
+            hashHoles( via );
+            hash_combine( ret, via->FlashLayer( aLayer ) );
+
+            if( IsCopperLayer( aLayer ) )
+                hash_combine( ret, via->GetZoneLayerOverride( aLayer ) );
+        }
+        else if( track->IsOnLayer( aLayer ) )
+        {
+            hashItem( track );
+        }
+    }
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        hashGraphic( item );
+
+    for( ZONE* otherZone : m_board->Zones() )
+        hashZone( otherZone );
+
+    // Zero is reserved for "unknown"
+    return ret ? ret : 1;
+}
+
+
 /**
  * Function buildThermalSpokes
  */
 void ZONE_FILLER::buildThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                      const BOX2I& aFillBBox,
                                       const std::vector<PAD*>& aSpokedPadsList,
                                       std::deque<SHAPE_LINE_CHAIN>& aSpokesList )
 {
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
-    BOX2I                  zoneBB = aZone->GetBoundingBox();
+    BOX2I                  zoneBB = aFillBBox;
     DRC_CONSTRAINT         constraint;
 
     zoneBB.Inflate( std::max( bds.GetBiggestClearanceValue(), aZone->GetLocalClearance() ) );
@@ -2036,6 +2790,8 @@ void ZONE_FILLER::buildThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer,
 bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                           PCB_LAYER_ID aDebugLayer, SHAPE_POLY_SET& aFillPolys )
 {
+    PHASE_TIMER hatchTimer( phaseTime( ZONE_FILL_PHASE::HATCH ) );
+
     // Build grid:
 
     // obviously line thickness must be > zone min thickness.
@@ -2134,55 +2890,23 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
         }
     }
 
-    // Build holes
-    SHAPE_POLY_SET holes;
-
-    for( int xx = 0; ; xx++ )
-    {
-        int xpos = xx * gridsize;
-
-        if( xpos > bbox.GetWidth() )
-            break;
-
-        for( int yy = 0; ; yy++ )
-        {
-            int ypos = yy * gridsize;
-
-            if( ypos > bbox.GetHeight() )
-                break;
-
-            // Generate hole
-            SHAPE_LINE_CHAIN hole( hole_base );
-            hole.Move( VECTOR2I( xpos, ypos ) );
-            holes.AddOutline( hole );
-        }
-    }
-
-    holes.Move( bbox.GetPosition() );
-
-    if( !aZone->GetHatchOrientation().IsZero() )
-        holes.Rotate( aZone->GetHatchOrientation() );
-
-    DUMP_POLYS_TO_COPPER_LAYER( holes, In10_Cu, wxT( "hatch-holes" ) );
-
     int outline_margin = aZone->GetMinThickness() * 1.1;
 
     // Using GetHatchThickness() can look more consistent than GetMinThickness().
     if( aZone->GetHatchBorderAlgorithm() && aZone->GetHatchThickness() > outline_margin )
         outline_margin = aZone->GetHatchThickness();
 
-    // The fill has already been deflated to ensure GetMinThickness() so we just have to
-    // account for anything beyond that.
-    SHAPE_POLY_SET deflatedFilledPolys = aFillPolys.CloneDropTriangulation();
-    deflatedFilledPolys.Deflate( outline_margin - aZone->GetMinThickness(),
-                                 CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
-    holes.BooleanIntersection( deflatedFilledPolys, SHAPE_POLY_SET::PM_FAST );
-    DUMP_POLYS_TO_COPPER_LAYER( holes, In11_Cu, wxT( "fill-clipped-hatch-holes" ) );
+    // Build the area the holes are clipped to.  The fill has already been deflated to ensure
+    // GetMinThickness() so we just have to account for anything beyond that.
+    SHAPE_POLY_SET clipArea = aFillPolys.CloneDropTriangulation();
+    clipArea.Deflate( outline_margin - aZone->GetMinThickness(),
+                      CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
+    DUMP_POLYS_TO_COPPER_LAYER( clipArea, In11_Cu, wxT( "deflated-fill" ) );
 
     SHAPE_POLY_SET deflatedOutline = aZone->Outline()->CloneDropTriangulation();
     deflatedOutline.Deflate( outline_margin, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
-    holes.BooleanIntersection( deflatedOutline, SHAPE_POLY_SET::PM_FAST );
-    DUMP_POLYS_TO_COPPER_LAYER( holes, In12_Cu, wxT( "outline-clipped-hatch-holes" ) );
+    clipArea.BooleanIntersection( deflatedOutline, SHAPE_POLY_SET::PM_FAST );
+    DUMP_POLYS_TO_COPPER_LAYER( clipArea, In12_Cu, wxT( "outline-clipped-fill" ) );
 
     if( aZone->GetNetCode() != 0 )
     {
@@ -2239,9 +2963,142 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
             }
         }
 
-        holes.BooleanSubtract( aprons, SHAPE_POLY_SET::PM_FAST );
+        clipArea.BooleanSubtract( aprons, SHAPE_POLY_SET::PM_FAST );
+    }
+
+    DUMP_POLYS_TO_COPPER_LAYER( clipArea, In13_Cu, wxT( "pad-via-clipped-fill" ) );
+
+    // The hatched fill depends only on the fill it is cut from, the clip area and the hole
+    // pattern, so an unchanged zone can reuse its previous hatching.
+    size_t hatchKey = hash_val( gridsize, hole_base.PointCount(), minimal_hole_area,
+                                aZone->GetHatchOrientation().AsDegrees() );
+
+    for( const VECTOR2I& pt : hole_base.CPoints() )
+        hash_combine( hatchKey, pt.x, pt.y );
+
+    hashPolySet( hatchKey, aFillPolys );
+    hashPolySet( hatchKey, clipArea );
+
+    if( m_knockoutCache->GetHatch( aZone, aLayer, hatchKey, aFillPolys ) )
+        return true;
+
+    // Build holes
+    //
+    // The grid of a large zone can run to many thousands of holes, and clipping all of them
+    // in a single boolean operation is very slow.  Instead the grid is split into tiles:
+    // holes in a tile which no clip area edge passes through are either kept as-is or
+    // dropped, and only the holes of the tiles straddling an edge need clipping.
+    const int  tileCells = 16;
+    const int  tileSize = tileCells * gridsize;
+    const int  cellsX = bbox.GetWidth() / gridsize + 1;
+    const int  cellsY = bbox.GetHeight() / gridsize + 1;
+    const int  tilesX = ( cellsX + tileCells - 1 ) / tileCells;
+    const int  tilesY = ( cellsY + tileCells - 1 ) / tileCells;
+
+    // The tiles are laid out in the (rotated) frame of the grid
+    SHAPE_POLY_SET gridClipArea = clipArea.CloneDropTriangulation();
+
+    if( !aZone->GetHatchOrientation().IsZero() )
+        gridClipArea.Rotate( - aZone->GetHatchOrientation() );
+
+    std::vector<bool> edgeTiles( (size_t) tilesX * tilesY, false );
+
+    auto markTiles =
+            [&]( const VECTOR2I& aStart, const VECTOR2I& aEnd )
+            {
+                auto tileIdx =
+                        []( int64_t aPos, int aCount ) -> int
+                        {
+                            return (int) std::clamp<int64_t>( aPos, 0, aCount - 1 );
+                        };
+
+                int64_t left = (int64_t) std::min( aStart.x, aEnd.x ) - 1 - bbox.GetX();
+                int64_t right = (int64_t) std::max( aStart.x, aEnd.x ) + 1 - bbox.GetX();
+                int64_t top = (int64_t) std::min( aStart.y, aEnd.y ) - 1 - bbox.GetY();
+                int64_t bottom = (int64_t) std::max( aStart.y, aEnd.y ) + 1 - bbox.GetY();
+
+                // Floor division, as the clip area can extend beyond the grid origin
+                auto floorDiv =
+                        [&]( int64_t aPos ) -> int64_t
+                        {
+                            return aPos >= 0 ? aPos / tileSize : ( aPos - tileSize + 1 ) / tileSize;
+                        };
+
+                for( int ty = tileIdx( floorDiv( top ), tilesY );
+                     ty <= tileIdx( floorDiv( bottom ), tilesY ); ty++ )
+                {
+                    for( int tx = tileIdx( floorDiv( left ), tilesX );
+                         tx <= tileIdx( floorDiv( right ), tilesX ); tx++ )
+                    {
+                        edgeTiles[ (size_t) ty * tilesX + tx ] = true;
+                    }
+                }
+            };
+
+    for( auto seg = gridClipArea.CIterateSegmentsWithHoles(); seg; seg++ )
+    {
+        // Walk long edges in pieces no longer than half a tile so that a diagonal edge only
+        // marks the tiles along it rather than all those in its bounding box.
+        const SEG& edge = *seg;
+        int        steps = std::max( 1, KiROUND( edge.Length() / ( tileSize / 2.0 ) ) + 1 );
+        VECTOR2D   delta = edge.B - edge.A;
+        VECTOR2I   prev = edge.A;
+
+        for( int ii = 1; ii <= steps; ii++ )
+        {
+            VECTOR2I next = ii == steps ? edge.B
+                                        : edge.A + KiROUND( delta * ( (double) ii / steps ) );
+
+            markTiles( prev, next );
+            prev = next;
+        }
+    }
+
+    POLY_CONTAINMENT_INDEX clipIndex( gridClipArea );
+    SHAPE_POLY_SET         holes;
+    SHAPE_POLY_SET         edgeHoles;
+
+    for( int ty = 0; ty < tilesY; ty++ )
+    {
+        for( int tx = 0; tx < tilesX; tx++ )
+        {
+            bool            edgeTile = edgeTiles[ (size_t) ty * tilesX + tx ];
+            SHAPE_POLY_SET* target = edgeTile ? &edgeHoles : &holes;
+
+            // No edge of the clip area passes through the tile, so it's either entirely
+            // inside or entirely outside
+            if( !edgeTile && !clipIndex.Contains( bbox.GetPosition()
+                                                  + VECTOR2I( tx * tileSize + tileSize / 2,
+                                                              ty * tileSize + tileSize / 2 ) ) )
+            {
+                continue;
+            }
+
+            for( int xx = tx * tileCells; xx < std::min( cellsX, ( tx + 1 ) * tileCells ); xx++ )
+            {
+                for( int yy = ty * tileCells; yy < std::min( cellsY, ( ty + 1 ) * tileCells );
+                     yy++ )
+                {
+                    // Generate hole
+                    SHAPE_LINE_CHAIN hole( hole_base );
+                    hole.Move( bbox.GetPosition() + VECTOR2I( xx * gridsize, yy * gridsize ) );
+                    target->AddOutline( hole );
+                }
+            }
+        }
+    }
+
+    if( !aZone->GetHatchOrientation().IsZero() )
+    {
+        holes.Rotate( aZone->GetHatchOrientation() );
+        edgeHoles.Rotate( aZone->GetHatchOrientation() );
     }
-    DUMP_POLYS_TO_COPPER_LAYER( holes, In13_Cu, wxT( "pad-via-clipped-hatch-holes" ) );
+
+    DUMP_POLYS_TO_COPPER_LAYER( edgeHoles, In10_Cu, wxT( "hatch-edge-holes" ) );
+
+    edgeHoles.BooleanIntersection( clipArea, SHAPE_POLY_SET::PM_FAST );
+    holes.Append( edgeHoles );
+    DUMP_POLYS_TO_COPPER_LAYER( holes, In14_Cu, wxT( "clipped-hatch-holes" ) );
 
     // Now filter truncated holes to avoid small holes in pattern
     // It happens for holes near the zone outline
@@ -2258,7 +3115,9 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
     // create grid. Use SHAPE_POLY_SET::PM_STRICTLY_SIMPLE to
     // generate strictly simple polygons needed by Gerber files and Fracture()
     aFillPolys.BooleanSubtract( aFillPolys, holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-    DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In14_Cu, wxT( "after-hatching" ) );
+    DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In15_Cu, wxT( "after-hatching" ) );
+
+    m_knockoutCache->SetHatch( aZone, aLayer, hatchKey, aFillPolys );
 
     return true;
 }
@@ -26,8 +26,14 @@
 #ifndef ZONE_FILLER_H
 #define ZONE_FILLER_H
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
 #include <vector>
+#include <core/thread_pool.h>
 #include <zone.h>
+#include "zone_knockout_cache.h"
 
 class PROGRESS_REPORTER;
 class BOARD;
@@ -36,6 +42,22 @@ class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
 
 
+/**
+ * The phases of a zone fill which are timed for profiling (see ZONE_FILLER::GetPhaseTime()).
+ */
+enum class ZONE_FILL_PHASE
+{
+    CLEARANCES,     ///< Knocking out thermal reliefs and item clearances
+    PRIORITY,       ///< Subtracting higher-priority zones
+    SPOKES,         ///< Building and hit-testing thermal spokes
+    HATCH,          ///< Cutting hatch patterns
+    ISLANDS,        ///< Finding and removing isolated islands
+    FRACTURE,       ///< Fracturing fills (and stitching tiled fills)
+
+    COUNT
+};
+
+
 class ZONE_FILLER
 {
 public:
@@ -57,9 +79,50 @@ public:
      */
     bool Fill( std::vector<ZONE*>& aZones, bool aCheck = false, wxWindow* aParent = nullptr );
 
+    /**
+     * Restrict the next Fill() of some zones to the given areas of the board.
+     *
+     * A zone with an entry in \a aDirtyAreas whose existing fill is suitable only has its fill
+     * rebuilt inside (a margin around) those areas, and the result is stitched into the
+     * existing fill.  Zones without an entry, or whose fill cannot be safely patched, are
+     * filled from scratch.
+     */
+    void SetDirtyAreas( const std::map<KIID, std::vector<BOX2I>>& aDirtyAreas )
+    {
+        m_dirtyAreas = aDirtyAreas;
+    }
+
     bool IsDebug() const { return m_debugZoneFiller; }
 
+    /**
+     * Use a knockout cache which outlives this filler (by default each filler has its own).
+     */
+    void SetKnockoutCache( std::shared_ptr<ZONE_KNOCKOUT_CACHE> aCache )
+    {
+        m_knockoutCache = std::move( aCache );
+    }
+
+    /**
+     * Run the fill's tasks on \a aPool rather than on the shared KiCad thread pool, so that a fill
+     * running in the background doesn't hold up tasks queued by the editor.
+     */
+    void SetThreadPool( thread_pool* aPool ) { m_threadPool = aPool; }
+
+    /**
+     * @return the time (in ms) spent in \a aPhase during the last Fill().  Phases which run on
+     *         the worker threads are summed over all the threads, so may exceed the wall-clock
+     *         time of the fill.
+     */
+    double GetPhaseTime( ZONE_FILL_PHASE aPhase ) const
+    {
+        return m_phaseTimes[ static_cast<size_t>( aPhase ) ] / 1000.0;
+    }
+
 private:
+    std::atomic<int64_t>& phaseTime( ZONE_FILL_PHASE aPhase )
+    {
+        return m_phaseTimes[ static_cast<size_t>( aPhase ) ];
+    }
 
     void addKnockout( PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_POLY_SET& aHoles );
 
@@ -68,11 +131,13 @@ private:
 
     void addHoleKnockout( PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
 
-    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFill,
+    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aFillBBox,
+                                 SHAPE_POLY_SET& aFill,
                                  std::vector<PAD*>& aThermalConnectionPads,
                                  std::vector<PAD*>& aNoConnectionPads );
 
     void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                    const BOX2I& aFillBBox,
                                     const std::vector<PAD*> aNoConnectionPads,
                                     SHAPE_POLY_SET& aHoles );
 
@@ -91,7 +156,7 @@ private:
      * @param aPcb: the current board
      */
     bool fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
-                         const SHAPE_POLY_SET& aSmoothedOutline,
+                         const BOX2I& aFillBBox, const SHAPE_POLY_SET& aSmoothedOutline,
                          const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys );
 
     bool fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
@@ -100,7 +165,7 @@ private:
      * Function buildThermalSpokes
      * Constructs a list of all thermal spokes for the given zone.
      */
-    void buildThermalSpokes( const ZONE* box, PCB_LAYER_ID aLayer,
+    void buildThermalSpokes( const ZONE* box, PCB_LAYER_ID aLayer, const BOX2I& aFillBBox,
                              const std::vector<PAD*>& aSpokedPadsList,
                              std::deque<SHAPE_LINE_CHAIN>& aSpokes );
 
@@ -115,8 +180,39 @@ private:
      * (holes are linked to main outline by overlapping segments, and these polygons are shrunk
      * by aZone->GetMinThickness() / 2 to be drawn with a outline thickness = aZone->GetMinThickness()
      * aFillPolys are polygons that will be drawn on screen and plotted
+     * @param aFillArea if not null, only the part of the zone inside this box is filled
+     */
+    bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys,
+                         const BOX2I* aFillArea = nullptr );
+
+    /**
+     * Rebuild the fill of a zone inside the given areas only, and stitch the result into the
+     * existing fill.
+     * @param aAreas are the (non-overlapping) areas to refill
+     * @param aFillPolys contains the existing fill on entry and the patched fill on exit
+     */
+    bool refillZoneAreas( ZONE* aZone, PCB_LAYER_ID aLayer, const std::vector<BOX2I>& aAreas,
+                          SHAPE_POLY_SET& aFillPolys );
+
+    /**
+     * Build the fill of a zone inside \a aTile only.
+     */
+    bool fillZoneTile( ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aTile,
+                       SHAPE_POLY_SET& aFillPolys );
+
+    /**
+     * @return the distance by which a change to the board can affect the fill of \a aZone (and
+     *         therefore the margin to add around dirty areas and tiles).
+     */
+    int getDirtyAreaMargin( const ZONE* aZone ) const;
+
+    /**
+     * @return a hash of everything which goes into the fill of \a aZone on \a aLayer: the zone
+     *         outline and settings, and the geometry and resolved rules of every item close
+     *         enough to affect it.
+     * @param aBoardHash is a hash of the board-wide inputs (board outline, fill settings).
      */
-    bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys );
+    size_t fillInputHash( const ZONE* aZone, PCB_LAYER_ID aLayer, size_t aBoardHash ) const;
 
     /**
      * for zones having the ZONE_FILL_MODE::ZONE_FILL_MODE::HATCH_PATTERN, create a grid pattern
@@ -133,11 +229,19 @@ private:
     bool                  m_brdOutlinesValid;   // true if m_boardOutline is well-formed
     COMMIT*               m_commit;
     PROGRESS_REPORTER*    m_progressReporter;
+    thread_pool*          m_threadPool;
 
     int                   m_maxError;
     int                   m_worstClearance;
 
     bool                  m_debugZoneFiller;
+
+    std::map<KIID, std::vector<BOX2I>> m_dirtyAreas;
+
+    std::shared_ptr<ZONE_KNOCKOUT_CACHE> m_knockoutCache;
+
+    ///< Time spent in each ZONE_FILL_PHASE, in microseconds
+    std::array<std::atomic<int64_t>, static_cast<size_t>( ZONE_FILL_PHASE::COUNT )> m_phaseTimes{};
 };
 
 #endif
@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <mutex>
+
+#include <hash_eda.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include "zone_knockout_cache.h"
+
+
+size_t ZONE_KNOCKOUT_CACHE::itemHash( const BOARD_ITEM* aItem )
+{
+    size_t hash = 0;
+
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+        // Custom pads hash their effective polygon, which isn't safe to build from the zone
+        // filler's worker threads (and they can be knocked out by their convex hull anyway).
+        if( static_cast<const PAD*>( aItem )->GetShape() != PAD_SHAPE::CUSTOM )
+            hash = hash_fp_item( aItem, HASH_POS | HASH_ROT | HASH_LAYER );
+
+        break;
+
+    case PCB_VIA_T:
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+        hash = hash_fp_item( aItem, HASH_POS | HASH_LAYER );
+        break;
+
+    default:
+        return 0;
+    }
+
+    // Zero is reserved for "not cacheable"
+    return hash ? hash : 1;
+}
+
+
+bool ZONE_KNOCKOUT_CACHE::Append( const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, bool aHole,
+                                  int aClearance, int aMaxError, SHAPE_POLY_SET& aHoles,
+                                  const std::function<void( SHAPE_POLY_SET& aBuffer )>& aBuilder )
+{
+    size_t hash = itemHash( aItem );
+
+    if( !hash )
+    {
+        aBuilder( aHoles );
+        return false;
+    }
+
+    KEY                                   key{ aItem->m_Uuid, aLayer, aHole, aClearance,
+                                               aMaxError };
+    std::shared_ptr<const SHAPE_POLY_SET> knockout;
+
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_mutex );
+
+        auto it = m_cache.find( key );
+
+        if( it != m_cache.end() && it->second.m_itemHash == hash )
+            knockout = it->second.m_knockout;
+    }
+
+    if( knockout )
+    {
+        m_hits++;
+        aHoles.Append( *knockout );
+        return true;
+    }
+
+    m_misses++;
+
+    std::shared_ptr<SHAPE_POLY_SET> newKnockout = std::make_shared<SHAPE_POLY_SET>();
+    aBuilder( *newKnockout );
+    aHoles.Append( *newKnockout );
+
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+        auto [it, inserted] = m_cache.insert_or_assign( key, ENTRY{ hash, newKnockout } );
+
+        if( inserted )
+            m_itemKeys[ key.m_item ].push_back( key );
+    }
+
+    return true;
+}
+
+
+bool ZONE_KNOCKOUT_CACHE::GetHatch( const ZONE* aZone, PCB_LAYER_ID aLayer, size_t aKey,
+                                    SHAPE_POLY_SET& aFill ) const
+{
+    std::shared_lock<std::shared_mutex> readLock( m_mutex );
+
+    auto zoneIt = m_hatches.find( aZone->m_Uuid );
+
+    if( zoneIt == m_hatches.end() )
+        return false;
+
+    auto layerIt = zoneIt->second.find( aLayer );
+
+    if( layerIt == zoneIt->second.end() || layerIt->second.m_key != aKey )
+        return false;
+
+    aFill = layerIt->second.m_fill;
+    return true;
+}
+
+
+void ZONE_KNOCKOUT_CACHE::SetHatch( const ZONE* aZone, PCB_LAYER_ID aLayer, size_t aKey,
+                                    const SHAPE_POLY_SET& aFill )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+    m_hatches[ aZone->m_Uuid ][ aLayer ] = HATCH_ENTRY{ aKey, aFill.CloneDropTriangulation() };
+}
+
+
+void ZONE_KNOCKOUT_CACHE::Invalidate( const BOARD_ITEM* aItem )
+{
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+        m_hatches.erase( aItem->m_Uuid );
+
+        auto it = m_itemKeys.find( aItem->m_Uuid );
+
+        if( it != m_itemKeys.end() )
+        {
+            for( const KEY& key : it->second )
+                m_cache.erase( key );
+
+            m_itemKeys.erase( it );
+        }
+    }
+
+    aItem->RunOnChildren(
+            [&]( BOARD_ITEM* aChild )
+            {
+                Invalidate( aChild );
+            } );
+}
+
+
+void ZONE_KNOCKOUT_CACHE::Clear()
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+    m_cache.clear();
+    m_itemKeys.clear();
+    m_hatches.clear();
+}
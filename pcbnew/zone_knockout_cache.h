@@ -0,0 +1,152 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef ZONE_KNOCKOUT_CACHE_H
+#define ZONE_KNOCKOUT_CACHE_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <hash.h>
+#include <kiid.h>
+#include <layer_ids.h>
+#include <geometry/shape_poly_set.h>
+
+class BOARD_ITEM;
+class ZONE;
+
+
+/**
+ * A cache of the clearance outlines ("knockouts") of pads, vias and tracks built by the zone
+ * filler.
+ *
+ * The same item is often knocked out of several zones, or of one zone on several layers, with
+ * identical parameters.  Entries are keyed on the item, layer, clearance and max error, and are
+ * validated against a hash of the item's geometry so that a stale entry is never used even if
+ * the item was changed behind the cache's back.  The commit path evicts the entries of changed
+ * items to keep the cache from growing without bound.
+ *
+ * It also keeps the hatch pattern of each hatched zone layer, keyed on a hash of the fill it
+ * was cut from, as cutting the holes is the slowest part of filling a hatched zone.
+ *
+ * The cache is thread-safe; the zone filler uses it from its worker threads.
+ */
+class ZONE_KNOCKOUT_CACHE
+{
+public:
+    /**
+     * Append the knockout of \a aItem to \a aHoles, calling \a aBuilder to produce it if there
+     * is no valid cached copy.
+     *
+     * @param aLayer is the layer of the knockout, or UNDEFINED_LAYER if it is the same on all
+     *               layers (which allows it to be shared between layers).
+     * @param aHole indicates a knockout of the item's hole rather than of its copper.
+     * @return false if the item cannot be cached (and \a aBuilder was called on \a aHoles).
+     */
+    bool Append( const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, bool aHole, int aClearance,
+                 int aMaxError, SHAPE_POLY_SET& aHoles,
+                 const std::function<void( SHAPE_POLY_SET& aBuffer )>& aBuilder );
+
+    /**
+     * Fetch the hatched fill of a zone layer into \a aFill.
+     *
+     * @param aKey is a hash of everything the hatched fill was built from.
+     * @return false if there is no hatched fill cached for \a aKey.
+     */
+    bool GetHatch( const ZONE* aZone, PCB_LAYER_ID aLayer, size_t aKey,
+                   SHAPE_POLY_SET& aFill ) const;
+
+    void SetHatch( const ZONE* aZone, PCB_LAYER_ID aLayer, size_t aKey,
+                   const SHAPE_POLY_SET& aFill );
+
+    /**
+     * Drop all cached knockouts (and hatching) of \a aItem (and of its children, if any).
+     */
+    void Invalidate( const BOARD_ITEM* aItem );
+
+    void Clear();
+
+    size_t GetHitCount() const  { return m_hits; }
+    size_t GetMissCount() const { return m_misses; }
+
+private:
+    struct KEY
+    {
+        KIID         m_item;
+        PCB_LAYER_ID m_layer;
+        bool         m_hole;
+        int          m_clearance;
+        int          m_maxError;
+
+        bool operator==( const KEY& aOther ) const
+        {
+            return m_item == aOther.m_item && m_layer == aOther.m_layer
+                    && m_hole == aOther.m_hole && m_clearance == aOther.m_clearance
+                    && m_maxError == aOther.m_maxError;
+        }
+    };
+
+    struct KEY_HASH
+    {
+        std::size_t operator()( const KEY& aKey ) const
+        {
+            std::size_t seed = aKey.m_item.Hash();
+            hash_combine( seed, aKey.m_layer, aKey.m_hole, aKey.m_clearance, aKey.m_maxError );
+            return seed;
+        }
+    };
+
+    struct ENTRY
+    {
+        size_t                                m_itemHash;
+        std::shared_ptr<const SHAPE_POLY_SET> m_knockout;
+    };
+
+    struct HATCH_ENTRY
+    {
+        size_t         m_key;
+        SHAPE_POLY_SET m_fill;
+    };
+
+    /**
+     * @return a hash of the geometry of \a aItem, or 0 if the item is not cacheable.
+     */
+    static size_t itemHash( const BOARD_ITEM* aItem );
+
+private:
+    mutable std::shared_mutex                  m_mutex;
+    std::unordered_map<KEY, ENTRY, KEY_HASH>   m_cache;
+    std::map<KIID, std::vector<KEY>>           m_itemKeys;
+
+    std::map<KIID, std::map<PCB_LAYER_ID, HATCH_ENTRY>> m_hatches;
+
+    std::atomic<size_t>                        m_hits = 0;
+    std::atomic<size_t>                        m_misses = 0;
+};
+
+#endif
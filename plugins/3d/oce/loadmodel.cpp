@@ -31,6 +31,7 @@
 #include <string>
 #include <cstring>
 #include <map>
+#include <tuple>
 #include <vector>
 #include <wx/filename.h>
 #include <wx/log.h>
@@ -62,6 +63,7 @@
 #include <XCAFDoc_ColorTool.hxx>
 #include <XCAFDoc_ShapeTool.hxx>
 
+#include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 
@@ -94,6 +96,10 @@ typedef std::map<std::string, SGNODE*>               FACEMAP;
 typedef std::map<std::string, std::vector<SGNODE*>>  NODEMAP;
 typedef std::pair<std::string, std::vector<SGNODE*>> NODEITEM;
 
+// SGSHAPE items of the front and back of a face, by TopoDS_TFace, orientation and color
+typedef std::pair<SGNODE*, SGNODE*>                                     FACENODES;
+typedef std::map<std::tuple<const TopoDS_TShape*, bool, SGNODE*>, FACENODES> FACEINSTANCEMAP;
+
 struct DATA;
 
 bool processLabel( const TDF_Label& aLabel, DATA& aData, SGNODE* aParent,
@@ -120,6 +126,7 @@ struct DATA
     NODEMAP  shapes;    // SGNODE lists representing a TopoDS_SOLID / COMPOUND
     COLORMAP colors;    // SGAPPEARANCE nodes
     FACEMAP  faces;     // SGSHAPE items representing a TopoDS_FACE
+    FACEINSTANCEMAP faceInstances; // SGSHAPE items shared by the instances of a TopoDS_FACE
     bool renderBoth;    // set TRUE if we're processing IGES
     bool hasSolid;      // set TRUE if there is no parent SOLID
 
@@ -680,6 +687,33 @@ bool readSTEPZ( Handle(TDocStd_Document)& m_doc, const char* aFileName )
 }
 
 
+/**
+ * Mesh the faces of all \a aShapes at once, in parallel.  The triangulation of a face is kept
+ * in its TopoDS_TFace, so the faces used by several instances of a part are meshed only once.
+ */
+static void meshShapes( DATA& aData, const TDF_LabelSequence& aShapes )
+{
+    TopoDS_Compound compound;
+    BRep_Builder    builder;
+
+    builder.MakeCompound( compound );
+
+    for( Standard_Integer i = 1; i <= aShapes.Length(); i++ )
+    {
+        TopoDS_Shape shape = aData.m_assy->GetShape( aShapes.Value( i ) );
+
+        if( !shape.IsNull() )
+            builder.Add( compound, shape );
+    }
+
+    const double linDeflection = ADVANCED_CFG::GetCfg().m_OcePluginLinearDeflection;
+    const double angDeflection = ADVANCED_CFG::GetCfg().m_OcePluginAngularDeflection;
+
+    BRepMesh_IncrementalMesh mesh( compound, linDeflection, Standard_False,
+                                   glm::radians( angDeflection ), Standard_True );
+}
+
+
 SCENEGRAPH* LoadModel( char const* filename )
 {
     DATA data;
@@ -732,6 +766,8 @@ SCENEGRAPH* LoadModel( char const* filename )
     TDF_LabelSequence frshapes;
     data.m_assy->GetFreeShapes( frshapes );
 
+    meshShapes( data, frshapes );
+
     bool ret = false;
 
     // create the top level SG node
@@ -1128,11 +1164,47 @@ bool processFace( const TopoDS_Face& face, DATA& data, SGNODE* parent, std::vect
         return true;
     }
 
+    Quantity_ColorRGBA lcolor;
+
+    // check for a face color; this has precedence over SOLID colors
+    if( data.m_color->GetColor( face, XCAFDoc_ColorSurf, lcolor )
+        || data.m_color->GetColor( face, XCAFDoc_ColorCurv, lcolor )
+        || data.m_color->GetColor( face, XCAFDoc_ColorGen, lcolor ) )
+    {
+        color = &lcolor;
+    }
+
+    SGNODE* ocolor = data.GetColor( color );
+
+    // The triangulation is held by the underlying TopoDS_TFace, so all the instances of a face
+    // with the same orientation and color share the same shapes
+    auto instanceKey = std::make_tuple( face.TShape().get(), reverse, ocolor );
+    auto instance = data.faceInstances.find( instanceKey );
+
+    if( instance != data.faceInstances.end() && ( !useBothSides || instance->second.second ) )
+    {
+        S3D::AddSGNodeRef( parent, instance->second.first );
+
+        if( nullptr != items )
+            items->push_back( instance->second.first );
+
+        if( useBothSides )
+        {
+            S3D::AddSGNodeRef( parent, instance->second.second );
+
+            if( nullptr != items )
+                items->push_back( instance->second.second );
+        }
+
+        return true;
+    }
+
     TopLoc_Location loc;
     Standard_Boolean isTessellate (Standard_False);
     Handle( Poly_Triangulation ) triangulation = BRep_Tool::Triangulation( face, loc );
     const double linDeflection = ADVANCED_CFG::GetCfg().m_OcePluginLinearDeflection;
 
+    // Normally already meshed by meshShapes()
     if( triangulation.IsNull() || triangulation->Deflection() > linDeflection + Precision::Confusion() )
         isTessellate = Standard_True;
 
@@ -1146,18 +1218,6 @@ bool processFace( const TopoDS_Face& face, DATA& data, SGNODE* parent, std::vect
     if( triangulation.IsNull() == Standard_True )
         return false;
 
-    Quantity_ColorRGBA lcolor;
-
-    // check for a face color; this has precedence over SOLID colors
-    if( data.m_color->GetColor( face, XCAFDoc_ColorSurf, lcolor )
-        || data.m_color->GetColor( face, XCAFDoc_ColorCurv, lcolor )
-        || data.m_color->GetColor( face, XCAFDoc_ColorGen, lcolor ) )
-    {
-        color = &lcolor;
-    }
-
-    SGNODE* ocolor = data.GetColor( color );
-
     // create a SHAPE and attach the color and data,
     // then attach the shape to the parent and return TRUE
     IFSG_SHAPE vshape( true );
@@ -1219,6 +1279,9 @@ bool processFace( const TopoDS_Face& face, DATA& data, SGNODE* parent, std::vect
     if( !partID.empty() )
         data.faces.emplace( partID, vshape.GetRawPtr() );
 
+    FACENODES& instanceNodes = data.faceInstances[instanceKey];
+    instanceNodes = FACENODES( vshape.GetRawPtr(), nullptr );
+
     // The outer surface of an IGES model is indeterminate so
     // we must render both sides of a surface.
     if( useBothSides )
@@ -1238,6 +1301,8 @@ bool processFace( const TopoDS_Face& face, DATA& data, SGNODE* parent, std::vect
 
         if( !partID.empty() )
             data.faces.emplace( id2, vshape2.GetRawPtr() );
+
+        instanceNodes.second = vshape2.GetRawPtr();
     }
 
     return true;
@@ -0,0 +1,130 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef QA_UTILS_IO_BENCH_H
+#define QA_UTILS_IO_BENCH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <dsnlexer.h>
+
+
+namespace KI_TEST
+{
+
+/**
+ * @return the peak resident set size of the process so far, in bytes, or 0 if it isn't known
+ *         on this platform.
+ */
+size_t GetPeakRSS();
+
+/**
+ * @return the number of calls to the global operator new so far.
+ *
+ * Linking this replaces the global operator new of the program by one which counts its calls.
+ * On Windows, allocations made inside DLLs such as kicommon are not counted.
+ */
+size_t GetAllocationCount();
+
+/**
+ * Read the whole file \a aPath.
+ *
+ * @throw IO_ERROR if it can't be read.
+ */
+std::string ReadFileContents( const std::string& aPath );
+
+/**
+ * @return the number of tokens \a aText is made of in the grammar of \a LEXER.
+ */
+template <typename LEXER>
+size_t CountTokens( const std::string& aText, const wxString& aSource )
+{
+    LEXER  lexer( aText, aSource );
+    size_t count = 0;
+
+    while( (int) lexer.NextTok() != DSN_EOF )
+        count++;
+
+    return count;
+}
+
+
+/**
+ * The wall time, allocations and memory use of the phases of loading and saving a file.
+ */
+class IO_BENCH_RESULT
+{
+public:
+    IO_BENCH_RESULT( const std::string& aFile, const std::string& aFormat ) :
+            m_file( aFile ),
+            m_format( aFormat ),
+            m_bytes( 0 ),
+            m_items( 0 ),
+            m_tokens( 0 )
+    {
+    }
+
+    /**
+     * Run \a aFunction as the phase \a aPhase, and record how long it took, how many
+     * allocations it made and the peak resident set size of the process once it is done.
+     */
+    void Measure( const std::string& aPhase, const std::function<void()>& aFunction );
+
+    /// Set the size of the file, in bytes.
+    void SetByteCount( size_t aCount ) { m_bytes = aCount; }
+
+    /// Set the number of items (board items, symbols, library rows...) of the file.
+    void SetItemCount( size_t aCount ) { m_items = aCount; }
+
+    /// Set the number of tokens of the file.
+    void SetTokenCount( size_t aCount ) { m_tokens = aCount; }
+
+    /**
+     * @return the result, with the throughput of each phase in MB/s and items/s.
+     */
+    nlohmann::json ToJson() const;
+
+private:
+    struct PHASE
+    {
+        std::string m_name;
+        double      m_ms;
+        size_t      m_allocations;
+        size_t      m_peakRSS;
+    };
+
+    std::string        m_file;
+    std::string        m_format;
+    size_t             m_bytes;
+    size_t             m_items;
+    size_t             m_tokens;
+    std::vector<PHASE> m_phases;
+};
+
+} // namespace KI_TEST
+
+#endif // QA_UTILS_IO_BENCH_H
@@ -0,0 +1,156 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/io_bench.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#include <core/profile.h>
+#include <ki_exception.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+static std::atomic<size_t> s_allocationCount( 0 );
+
+
+void* operator new( std::size_t aSize )
+{
+    s_allocationCount.fetch_add( 1, std::memory_order_relaxed );
+
+    if( void* ptr = std::malloc( aSize ? aSize : 1 ) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete( void* aPtr ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+void operator delete( void* aPtr, std::size_t ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+namespace KI_TEST
+{
+
+size_t GetPeakRSS()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+        return counters.PeakWorkingSetSize;
+
+    return 0;
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return 0;
+
+#ifdef __APPLE__
+    return static_cast<size_t>( usage.ru_maxrss );          // bytes
+#else
+    return static_cast<size_t>( usage.ru_maxrss ) * 1024;   // kilobytes
+#endif
+#endif
+}
+
+
+size_t GetAllocationCount()
+{
+    return s_allocationCount.load( std::memory_order_relaxed );
+}
+
+
+std::string ReadFileContents( const std::string& aPath )
+{
+    std::ifstream file( aPath, std::ios::binary );
+
+    if( !file )
+        THROW_IO_ERROR( wxString::Format( wxT( "Cannot read '%s'." ), aPath ) );
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    return contents.str();
+}
+
+
+void IO_BENCH_RESULT::Measure( const std::string& aPhase, const std::function<void()>& aFunction )
+{
+    size_t     allocations = GetAllocationCount();
+    PROF_TIMER timer;
+
+    aFunction();
+
+    timer.Stop();
+
+    m_phases.push_back( { aPhase, timer.msecs(), GetAllocationCount() - allocations,
+                          GetPeakRSS() } );
+}
+
+
+nlohmann::json IO_BENCH_RESULT::ToJson() const
+{
+    nlohmann::json result;
+
+    result["file"] = m_file;
+    result["format"] = m_format;
+    result["bytes"] = m_bytes;
+    result["items"] = m_items;
+    result["tokens"] = m_tokens;
+
+    for( const PHASE& phase : m_phases )
+    {
+        nlohmann::json& json = result["phases"][phase.m_name];
+        double          seconds = std::max( phase.m_ms, 1e-6 ) / 1000.0;
+
+        json["ms"] = phase.m_ms;
+        json["mb_per_s"] = m_bytes / 1e6 / seconds;
+        json["items_per_s"] = m_items / seconds;
+        json["allocations"] = phase.m_allocations;
+        json["peak_rss_mb"] = phase.m_peakRSS / 1e6;
+    }
+
+    return result;
+}
+
+} // namespace KI_TEST
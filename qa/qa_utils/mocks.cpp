@@ -465,7 +465,8 @@ ZONE_FILLER::~ZONE_FILLER()
 
 ZONE_FILLER_TOOL::ZONE_FILLER_TOOL() :
     PCB_TOOL_BASE( "pcbnew.ZoneFiller" ),
-    m_fillInProgress( false )
+    m_fillInProgress( false ),
+    m_lastBackgroundFillId( 0 )
 {
 }
 
@@ -480,6 +481,11 @@ void ZONE_FILLER_TOOL::Reset( RESET_REASON aReason )
 }
 
 
+void ZONE_FILLER_TOOL::InvalidateKnockouts( BOARD_ITEM* aItem )
+{
+}
+
+
 void ZONE_FILLER_TOOL::setTransitions()
 {
 }
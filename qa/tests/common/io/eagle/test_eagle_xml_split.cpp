@@ -0,0 +1,109 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_eagle_xml_split.cpp
+ * Test suite for splitting Eagle XML documents into their elements
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <io/eagle/eagle_parser.h>
+
+
+BOOST_AUTO_TEST_SUITE( EagleXmlSplit )
+
+
+static const std::string doc =
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<!DOCTYPE eagle SYSTEM \"eagle.dtd\">\n"
+        "<!-- a comment with <markup> -->\n"
+        "<eagle version=\"9.6.2\">\n"
+        "<drawing>\n"
+        "<settings><setting alwaysvectorfont=\"no\" text=\"a > b\"/></settings>\n"
+        "<grid distance=\"0.1\"/>\n"
+        "<board>\n"
+        "<libraries>\n"
+        "<library name=\"first\"><packages><package name=\"R0603\">"
+        "<description><![CDATA[<b>not</b> markup]]></description></package></packages></library>\n"
+        "<library name=\"second\"/>\n"
+        "</libraries>\n"
+        "</board>\n"
+        "</drawing>\n"
+        "</eagle>\n";
+
+
+/**
+ * Check that the elements of a document are found with their names and complete text.
+ */
+BOOST_AUTO_TEST_CASE( Split )
+{
+    XML_ELEMENT_SPAN root = FindXmlRootElement( doc );
+
+    BOOST_CHECK_EQUAL( root.name, "eagle" );
+    BOOST_CHECK( root.text.substr( 0, 7 ) == "<eagle " );
+    BOOST_CHECK( root.text.substr( root.text.size() - 8 ) == "</eagle>" );
+
+    std::vector<XML_ELEMENT_SPAN> drawing = SplitXmlChildren( root.text );
+
+    BOOST_REQUIRE_EQUAL( drawing.size(), 1 );
+    BOOST_CHECK_EQUAL( drawing[0].name, "drawing" );
+
+    std::vector<XML_ELEMENT_SPAN> sections = SplitXmlChildren( drawing[0].text );
+
+    BOOST_REQUIRE_EQUAL( sections.size(), 3 );
+    BOOST_CHECK_EQUAL( sections[0].name, "settings" );
+    BOOST_CHECK_EQUAL( sections[1].name, "grid" );
+    BOOST_CHECK( sections[1].text == "<grid distance=\"0.1\"/>" );
+    BOOST_CHECK_EQUAL( sections[2].name, "board" );
+
+    std::vector<XML_ELEMENT_SPAN> libraries =
+            SplitXmlChildren( SplitXmlChildren( sections[2].text ).at( 0 ).text );
+
+    BOOST_REQUIRE_EQUAL( libraries.size(), 2 );
+    BOOST_CHECK( SplitXmlChildren( libraries[1].text ).empty() );
+
+    // Each element can be parsed on its own
+    std::unique_ptr<wxXmlDocument> library = ParseXmlElement( libraries[0].text );
+
+    BOOST_CHECK_EQUAL( library->GetRoot()->GetName(), "library" );
+    BOOST_CHECK_EQUAL( library->GetRoot()->GetAttribute( "name" ), "first" );
+    BOOST_CHECK( MapChildren( library->GetRoot() )["packages"] != nullptr );
+
+    BOOST_CHECK( SplitXmlChildren( std::string_view() ).empty() );
+}
+
+
+/**
+ * Check that truncated markup is reported rather than silently split.
+ */
+BOOST_AUTO_TEST_CASE( Malformed )
+{
+    BOOST_CHECK_THROW( FindXmlRootElement( "<?xml version=\"1.0\"?>" ), XML_PARSER_ERROR );
+    BOOST_CHECK_THROW( SplitXmlChildren( "<a><b attr=\"x>" ), XML_PARSER_ERROR );
+    BOOST_CHECK_THROW( SplitXmlChildren( "<a><b><c/></a" ), XML_PARSER_ERROR );
+    BOOST_CHECK_THROW( SplitXmlChildren( "<a><!-- unterminated" ), XML_PARSER_ERROR );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <dsnlexer.h>
+
+
+BOOST_AUTO_TEST_SUITE( DsnLexer )
+
+
+BOOST_AUTO_TEST_CASE( Tokens )
+{
+    const std::string input = "(symbol 12.5 -3 \"plain string\" \"\"\n"
+                              "  \"esc \\\"quoted\\\" \\\\ \\n\\x41\\101 end\" tail)";
+
+    const std::vector<std::pair<int, std::string>> expected = {
+        { DSN_LEFT, "(" },
+        { DSN_SYMBOL, "symbol" },
+        { DSN_NUMBER, "12.5" },
+        { DSN_NUMBER, "-3" },
+        { DSN_STRING, "plain string" },
+        { DSN_STRING, "" },
+        { DSN_STRING, "esc \"quoted\" \\ \nAA end" },
+        { DSN_SYMBOL, "tail" },
+        { DSN_RIGHT, ")" },
+        { DSN_EOF, "" }
+    };
+
+    DSNLEXER lexer( input, wxT( "test" ) );
+
+    for( const auto& [tok, text] : expected )
+    {
+        BOOST_REQUIRE_EQUAL( lexer.NextTok(), tok );
+
+        if( tok != DSN_EOF )
+            BOOST_CHECK_EQUAL( lexer.CurStr(), text );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( UnterminatedString )
+{
+    DSNLEXER lexer( std::string( "(a \"no end" ), wxT( "test" ) );
+
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_LEFT );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_SYMBOL );
+    BOOST_CHECK_THROW( lexer.NextTok(), PARSE_ERROR );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
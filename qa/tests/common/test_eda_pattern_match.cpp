@@ -0,0 +1,89 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the pattern matchers used by the library choosers
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <eda_pattern_match.h>
+
+
+BOOST_AUTO_TEST_SUITE( EdaPatternMatch )
+
+
+/**
+ * Check that the trigram signature never rules out terms the matchers would score.
+ */
+BOOST_AUTO_TEST_CASE( TrigramsKeepMatches )
+{
+    const std::vector<wxString> texts = {
+        wxS( "Resistor_SMD:R_0603_1608Metric" ),
+        wxS( "Operational amplifier, DIP-8" ),
+        wxS( "LM358" ),
+        wxS( "Connector header 2x20 pins" ),
+        wxS( "R" ),
+    };
+
+    const std::vector<wxString> patterns = {
+        wxS( "0603" ), wxS( "metric" ), wxS( "amp" ), wxS( "lm3" ), wxS( "dip-8" ),
+        wxS( "2x20" ), wxS( "r" ), wxS( "r_06" ), wxS( "lm*8" ), wxS( "/^lm.*$/" ),
+        wxS( "xyz" ), wxS( "header2" ),
+    };
+
+    for( const wxString& pattern : patterns )
+    {
+        EDA_COMBINED_MATCHER matcher( pattern, CTX_LIBITEM );
+
+        for( const wxString& text : texts )
+        {
+            std::vector<SEARCH_TERM> terms = { SEARCH_TERM( text, 4 ) };
+            SEARCH_TRIGRAMS          trigrams( terms );
+
+            int expected = matcher.ScoreTerms( terms );
+
+            BOOST_CHECK_MESSAGE( matcher.ScoreTerms( terms, trigrams ) == expected,
+                                 "pattern " << pattern << " on " << text );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( TrigramsBasics )
+{
+    std::vector<SEARCH_TERM> terms = { SEARCH_TERM( wxS( "LM358" ), 4 ) };
+    SEARCH_TRIGRAMS          trigrams( terms );
+    SEARCH_TRIGRAMS          pattern;
+
+    pattern.Add( wxS( "lm3" ) );
+    BOOST_CHECK( trigrams.Contains( pattern ) );
+
+    // Too short to have a trigram
+    BOOST_CHECK( SEARCH_TRIGRAMS( { SEARCH_TERM( wxS( "ab" ), 1 ) } ).IsEmpty() );
+    BOOST_CHECK( !trigrams.IsEmpty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
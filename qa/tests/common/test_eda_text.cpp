@@ -21,6 +21,7 @@
 #include <boost/test/unit_test.hpp>
 #include <base_units.h>
 #include <eda_text.h>
+#include <geometry/shape_compound.h>
 
 
 BOOST_AUTO_TEST_SUITE( EdaText )
@@ -61,4 +62,39 @@ BOOST_AUTO_TEST_CASE( Compare )
 }
 
 
+/**
+ * The effective shape is cached until the text, its position or its attributes change.
+ */
+BOOST_AUTO_TEST_CASE( EffectiveShapeCache )
+{
+    EDA_TEXT text( unityScale, wxS( "R12" ) );
+
+    text.SetTextSize( VECTOR2I( 1000, 1000 ) );
+
+    std::shared_ptr<SHAPE_COMPOUND> shape = text.GetEffectiveTextShape();
+    BOX2I                           bbox = shape->BBox();
+
+    BOOST_CHECK( !shape->Empty() );
+    BOOST_CHECK( text.GetEffectiveTextShape() == shape );
+
+    // Shapes built for other purposes aren't cached
+    BOOST_CHECK( text.GetEffectiveTextShape( false ) != shape );
+
+    text.SetTextPos( VECTOR2I( 5000, 0 ) );
+    std::shared_ptr<SHAPE_COMPOUND> moved = text.GetEffectiveTextShape();
+
+    BOOST_CHECK( moved != shape );
+    BOOST_CHECK_GT( moved->BBox().GetX(), bbox.GetX() + 4000 );
+
+    text.SetText( wxS( "R123" ) );
+    BOOST_CHECK( text.GetEffectiveTextShape() != moved );
+    BOOST_CHECK_GT( text.GetEffectiveTextShape()->BBox().GetWidth(), moved->BBox().GetWidth() );
+
+    std::shared_ptr<SHAPE_COMPOUND> longer = text.GetEffectiveTextShape();
+
+    text.SetMirrored( true );
+    BOOST_CHECK( text.GetEffectiveTextShape() != longer );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,7 @@
 #include <base_units.h>
 #include <eda_units.h>
 #include <locale_io.h>
+#include <math/util.h>
 
 #include <algorithm>
 #include <iostream>
@@ -84,4 +85,52 @@ BOOST_AUTO_TEST_CASE( VECTOR2IUnitFormat )
 }
 
 
+/**
+ * Check that formatted values parse back exactly and that inputs needing rounding are left
+ * to the floating point parser
+ */
+BOOST_AUTO_TEST_CASE( ParseInternalUnitsExact )
+{
+#ifdef EESCHEMA
+    const EDA_IU_SCALE& iuScale = schIUScale;
+#elif GERBVIEW
+    const EDA_IU_SCALE& iuScale = gerbIUScale;
+#elif PCBNEW
+    const EDA_IU_SCALE& iuScale = pcbIUScale;
+#endif
+
+    const std::vector<int> values = { 0, 1, -1, 7, 10, -350000, 123456, 52525252, -52525252,
+                                      std::numeric_limits<int>::min(),
+                                      std::numeric_limits<int>::max() };
+
+    for( int value : values )
+    {
+        std::string str = EDA_UNIT_UTILS::FormatInternalUnits( iuScale, value );
+        int         parsed = 0;
+
+        BOOST_TEST_CONTEXT( str )
+        {
+            BOOST_CHECK( EDA_UNIT_UTILS::ParseInternalUnitsExact( str, iuScale, parsed ) );
+            BOOST_CHECK_EQUAL( parsed, value );
+        }
+    }
+
+    int parsed = 0;
+
+    BOOST_CHECK( EDA_UNIT_UTILS::ParseInternalUnitsExact( "+1.5000000000000", iuScale, parsed ) );
+    BOOST_CHECK_EQUAL( parsed, KiROUND( 1.5 * iuScale.IU_PER_MM ) );
+
+    BOOST_CHECK( EDA_UNIT_UTILS::ParseInternalUnitsExact( ".25", iuScale, parsed ) );
+    BOOST_CHECK_EQUAL( parsed, KiROUND( 0.25 * iuScale.IU_PER_MM ) );
+
+    BOOST_CHECK( !EDA_UNIT_UTILS::ParseInternalUnitsExact( "1e3", iuScale, parsed ) );
+    BOOST_CHECK( !EDA_UNIT_UTILS::ParseInternalUnitsExact( "0.0000000001", iuScale, parsed ) );
+    BOOST_CHECK( !EDA_UNIT_UTILS::ParseInternalUnitsExact( "99999999999", iuScale, parsed ) );
+    BOOST_CHECK( !EDA_UNIT_UTILS::ParseInternalUnitsExact( "-", iuScale, parsed ) );
+    BOOST_CHECK( !EDA_UNIT_UTILS::ParseInternalUnitsExact( ".", iuScale, parsed ) );
+    BOOST_CHECK( !EDA_UNIT_UTILS::ParseInternalUnitsExact( "1.2.3", iuScale, parsed ) );
+    BOOST_CHECK( !EDA_UNIT_UTILS::ParseInternalUnitsExact( "", iuScale, parsed ) );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
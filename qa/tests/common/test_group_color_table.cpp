@@ -0,0 +1,129 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <gal/opengl/group_color_table.h>
+
+using namespace KIGFX;
+
+
+BOOST_AUTO_TEST_SUITE( GroupColorTable )
+
+
+static const unsigned char* texel( const GROUP_COLOR_TABLE& aTable, unsigned int aSlot )
+{
+    return &aTable.GetPixels()[aSlot * 4];
+}
+
+
+/**
+ * Slot 0 is reserved for the vertices which don't belong to a slot, and freed slots are used
+ * again with no color set.
+ */
+BOOST_AUTO_TEST_CASE( AllocateAndFree )
+{
+    GROUP_COLOR_TABLE table;
+
+    unsigned int first = table.Allocate();
+    unsigned int second = table.Allocate();
+
+    BOOST_CHECK_EQUAL( first, 1 );
+    BOOST_CHECK_EQUAL( second, 2 );
+
+    table.SetColor( first, COLOR4D( 1.0, 0.0, 0.0, 1.0 ) );
+    BOOST_CHECK_EQUAL( texel( table, first )[0], 255 );
+    BOOST_CHECK_EQUAL( texel( table, first )[3], 255 );
+
+    table.Free( first );
+    BOOST_CHECK_EQUAL( texel( table, first )[0], 0 );
+    BOOST_CHECK_EQUAL( texel( table, first )[3], 0 );
+    BOOST_CHECK_EQUAL( table.Allocate(), first );
+
+    // Slot 0 can't be colored
+    table.SetColor( 0, COLOR4D( 1.0, 1.0, 1.0, 1.0 ) );
+    BOOST_CHECK_EQUAL( texel( table, 0 )[3], 0 );
+}
+
+
+/**
+ * A fully transparent black override must not read as an empty texel.
+ */
+BOOST_AUTO_TEST_CASE( TransparentBlack )
+{
+    GROUP_COLOR_TABLE table;
+    unsigned int      slot = table.Allocate();
+
+    table.SetColor( slot, COLOR4D( 0.0, 0.0, 0.0, 0.0 ) );
+
+    const unsigned char* color = texel( table, slot );
+    BOOST_CHECK( color[0] || color[1] || color[2] || color[3] );
+    BOOST_CHECK_EQUAL( color[3], 0 );
+}
+
+
+/**
+ * Only the rows of the modified slots are dirty, and the table grows when it is full.
+ */
+BOOST_AUTO_TEST_CASE( DirtyRowsAndGrowth )
+{
+    GROUP_COLOR_TABLE table;
+    int               first, last;
+
+    BOOST_CHECK( table.GetDirtyRows( first, last ) );
+    table.ClearDirtyRows();
+    BOOST_CHECK( !table.GetDirtyRows( first, last ) );
+
+    int          height = table.GetHeight();
+    unsigned int slot = 0;
+
+    for( int ii = 1; ii < GROUP_COLOR_TABLE::WIDTH * 3; ++ii )
+        slot = table.Allocate();
+
+    table.SetColor( slot, COLOR4D( 0.0, 1.0, 0.0, 1.0 ) );
+
+    BOOST_CHECK( table.GetDirtyRows( first, last ) );
+    BOOST_CHECK_EQUAL( first, 2 );
+    BOOST_CHECK_EQUAL( last, 2 );
+
+    table.ClearDirtyRows();
+
+    while( table.GetHeight() == height )
+        table.Allocate();
+
+    BOOST_CHECK_EQUAL( table.GetHeight(), 2 * height );
+    BOOST_CHECK_EQUAL( table.GetPixels().size(),
+                       (size_t) GROUP_COLOR_TABLE::WIDTH * table.GetHeight() * 4 );
+
+    // The texture has to be made again with the new size
+    BOOST_CHECK( table.GetDirtyRows( first, last ) );
+    BOOST_CHECK_EQUAL( first, 0 );
+    BOOST_CHECK_EQUAL( last, table.GetHeight() - 1 );
+
+    table.Clear();
+    BOOST_CHECK_EQUAL( table.GetHeight(), height );
+    BOOST_CHECK_EQUAL( table.Allocate(), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -82,4 +82,55 @@ BOOST_AUTO_TEST_CASE( TabCheck )
 }
 
 
+/**
+ * Check that the glyphs of a text know the font glyph they were made from and the transform
+ * from it, which the OpenGL GAL uses to draw them from its glyph atlas.
+ */
+BOOST_AUTO_TEST_CASE( FontGlyphTransform )
+{
+    KIFONT::STROKE_FONT* font = KIFONT::STROKE_FONT::LoadFont( wxEmptyString );
+
+    for( bool mirror : { false, true } )
+    {
+        std::vector<std::unique_ptr<KIFONT::GLYPH>> glyphs;
+
+        font->GetTextAsGlyphs( nullptr, &glyphs, wxS( "Ab?" ), VECTOR2I( 1000, 1200 ),
+                               VECTOR2I( 500, -300 ), EDA_ANGLE( 30.0, DEGREES_T ), mirror,
+                               VECTOR2I( 100, 200 ), 0 );
+
+        BOOST_REQUIRE_EQUAL( glyphs.size(), 3 );
+
+        for( const std::unique_ptr<KIFONT::GLYPH>& glyph : glyphs )
+        {
+            const auto& strokeGlyph = static_cast<const KIFONT::STROKE_GLYPH&>( *glyph );
+            const KIFONT::STROKE_GLYPH* fontGlyph = strokeGlyph.GetFontGlyph();
+
+            BOOST_REQUIRE( fontGlyph );
+            BOOST_REQUIRE_EQUAL( fontGlyph->size(), strokeGlyph.size() );
+
+            VECTOR2D origin, xAxis, yAxis;
+            strokeGlyph.GetFontTransform( origin, xAxis, yAxis );
+
+            BOOST_CHECK_CLOSE( xAxis.EuclideanNorm(), 1000.0, 1e-6 );
+            BOOST_CHECK_CLOSE( yAxis.EuclideanNorm(), 1200.0, 1e-6 );
+
+            for( size_t i = 0; i < strokeGlyph.size(); i++ )
+            {
+                BOOST_REQUIRE_EQUAL( ( *fontGlyph )[i].size(), strokeGlyph[i].size() );
+
+                for( size_t j = 0; j < strokeGlyph[i].size(); j++ )
+                {
+                    const VECTOR2D& fontPt = ( *fontGlyph )[i][j];
+                    VECTOR2D        expected = origin + xAxis * fontPt.x + yAxis * fontPt.y;
+
+                    BOOST_CHECK_SMALL( ( strokeGlyph[i][j] - expected ).EuclideanNorm(), 1e-6 );
+                }
+            }
+        }
+    }
+
+    delete font;
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
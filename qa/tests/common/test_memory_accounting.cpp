@@ -0,0 +1,64 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <memory_accounting.h>
+
+#include <memory>
+
+
+BOOST_AUTO_TEST_SUITE( MemoryAccounting )
+
+
+BOOST_AUTO_TEST_CASE( CollectAccounts )
+{
+    size_t before = MEMORY_ACCOUNT::Collect().Get( MEMORY_CATEGORY::UNDO_HISTORY );
+
+    auto first = std::make_unique<MEMORY_ACCOUNT>(
+            []( MEMORY_REPORT& aReport )
+            {
+                aReport.Add( MEMORY_CATEGORY::UNDO_HISTORY, 1000 );
+            } );
+
+    MEMORY_ACCOUNT second(
+            []( MEMORY_REPORT& aReport )
+            {
+                aReport.Add( MEMORY_CATEGORY::UNDO_HISTORY, 24 );
+                aReport.Add( MEMORY_CATEGORY::ZONE_FILLS, 3 );
+            } );
+
+    MEMORY_REPORT report = MEMORY_ACCOUNT::Collect();
+
+    BOOST_CHECK_EQUAL( report.Get( MEMORY_CATEGORY::UNDO_HISTORY ), before + 1024 );
+    BOOST_CHECK_GE( report.GetTotal(), before + 1027 );
+
+    // A destroyed account is no longer reported
+    first.reset();
+
+    report = MEMORY_ACCOUNT::Collect();
+    BOOST_CHECK_EQUAL( report.Get( MEMORY_CATEGORY::UNDO_HISTORY ), before + 24 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
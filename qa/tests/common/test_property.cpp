@@ -283,6 +283,48 @@ BOOST_AUTO_TEST_CASE( TypeCasting )
     BOOST_CHECK_EQUAL( D_to_C, dynamic_cast<C*>( ptr ) );
 }
 
+// Typed getters, which bypass the wxAny
+BOOST_AUTO_TEST_CASE( TypedGetters )
+{
+    ptr = &d;
+    ptr->Set( "A", 23 );
+    d.setBool( true );
+    d.setGlobEnum( enum_glob::TEST2 );
+
+    auto objectFor =
+            [&]( PROPERTY_BASE* aProp )
+            {
+                return propMgr.TypeCast( ptr, TYPE_HASH( D ), aProp->OwnerHash() );
+            };
+
+    BOOST_CHECK( propMgr.GetTypeCast( TYPE_HASH( D ), TYPE_HASH( C ) ) != nullptr );
+    BOOST_CHECK( propMgr.GetTypeCast( TYPE_HASH( D ), TYPE_HASH( D ) ) == nullptr );
+
+    int      value = 0;
+    wxString str;
+
+    PROPERTY_BASE* propA = propMgr.GetProperty( TYPE_HASH( D ), "A" );
+    BOOST_CHECK( propA->GetInt( objectFor( propA ), value ) );
+    BOOST_CHECK_EQUAL( value, 46 );
+    BOOST_CHECK( !propA->GetString( objectFor( propA ), str ) );
+
+    PROPERTY_BASE* propBool = propMgr.GetProperty( TYPE_HASH( D ), "bool" );
+    BOOST_CHECK( propBool->GetInt( objectFor( propBool ), value ) );
+    BOOST_CHECK_EQUAL( value, 1 );
+
+    PROPERTY_BASE* propEnum = propMgr.GetProperty( TYPE_HASH( D ), "enumGlob" );
+    BOOST_CHECK( propEnum->GetInt( objectFor( propEnum ), value ) );
+    BOOST_CHECK_EQUAL( value, static_cast<int>( enum_glob::TEST2 ) );
+    BOOST_CHECK( propEnum->GetString( objectFor( propEnum ), str ) );
+    BOOST_CHECK_EQUAL( str, wxString( "TEST2" ) );
+
+    d.setGlobEnum( static_cast<enum_glob>( -1 ) );
+    BOOST_CHECK( !propEnum->GetString( objectFor( propEnum ), str ) );
+
+    PROPERTY_BASE* propPoint = propMgr.GetProperty( TYPE_HASH( D ), "point" );
+    BOOST_CHECK( !propPoint->GetInt( objectFor( propPoint ), value ) );
+}
+
 BOOST_AUTO_TEST_CASE( EnumGlob )
 {
     PROPERTY_BASE* prop = propMgr.GetProperty( TYPE_HASH( D ), "enumGlob" );
@@ -0,0 +1,88 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <rc_json_writer.h>
+
+#include <iomanip>
+#include <sstream>
+
+
+BOOST_AUTO_TEST_SUITE( RcJsonWriter )
+
+
+/**
+ * The streamed document must be formatted exactly as the complete document is dumped.
+ */
+BOOST_AUTO_TEST_CASE( MatchesDump )
+{
+    nlohmann::json violation = { { "description", "Clearance \"violation\"" },
+                                 { "items", nlohmann::json::array(
+                                                    { { { "pos", { { "x", 1.5 }, { "y", -2 } } },
+                                                        { "uuid", "1234" } } } ) },
+                                 { "severity", "error" } };
+
+    nlohmann::json doc;
+    doc["$schema"] = "schema";
+    doc["empty"] = nlohmann::json::array();
+    doc["sheets"] = nlohmann::json::array(
+            { { { "path", "/" }, { "violations", nlohmann::json::array( { violation, violation } ) } },
+              { { "path", "/sub" }, { "violations", nlohmann::json::array() } } } );
+    doc["source"] = "board.kicad_pcb";
+
+    std::ostringstream expected;
+    expected << std::setw( 4 ) << doc << std::endl;
+
+    std::ostringstream     streamed;
+    RC_JSON::STREAM_WRITER writer( streamed );
+
+    writer.BeginObject();
+    writer.Member( "$schema", "schema" );
+    writer.Key( "empty" );
+    writer.BeginArray();
+    writer.EndArray();
+    writer.Key( "sheets" );
+    writer.BeginArray();
+
+    writer.BeginObject();
+    writer.Member( "path", "/" );
+    writer.Key( "violations" );
+    writer.BeginArray();
+    writer.Value( violation );
+    writer.Value( violation );
+    writer.EndArray();
+    writer.EndObject();
+
+    writer.BeginObject();
+    writer.Member( "path", "/sub" );
+    writer.Key( "violations" );
+    writer.BeginArray();
+    writer.EndArray();
+    writer.EndObject();
+
+    writer.EndArray();
+    writer.Member( "source", "board.kicad_pcb" );
+    writer.EndObject();
+    writer.Finish();
+
+    BOOST_CHECK_EQUAL( streamed.str(), expected.str() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
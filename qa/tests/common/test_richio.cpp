@@ -26,6 +26,9 @@
  * Test suite for general string functions
  */
 
+#include <filesystem>
+#include <fstream>
+
 #include <qa_utils/wx_utils/unit_test_utils.h>
 
 // Code under test
@@ -74,4 +77,138 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+
+/**
+ * Check that #MAPPED_FILE_LINE_READER returns the same lines as #FILE_LINE_READER.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLineReader )
+{
+    const std::string contents = "(first line)\n\n  (third \"line\")\nno trailing newline";
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "qa_mapped_reader.txt";
+
+    {
+        std::ofstream out( path, std::ios::binary );
+        out << contents;
+    }
+
+    MAPPED_FILE_LINE_READER mapped( path.string() );
+    FILE_LINE_READER        file( path.string() );
+
+    BOOST_CHECK_EQUAL( std::string( mapped.Contents() ), contents );
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        for( ;; )
+        {
+            char* mappedLine = mapped.ReadLine();
+            char* fileLine = file.ReadLine();
+
+            BOOST_CHECK_EQUAL( mapped.LineNumber(), file.LineNumber() );
+            BOOST_REQUIRE_EQUAL( mappedLine == nullptr, fileLine == nullptr );
+
+            if( !mappedLine )
+                break;
+
+            BOOST_CHECK_EQUAL( std::string( mappedLine ), std::string( fileLine ) );
+            BOOST_CHECK_EQUAL( mapped.Length(), file.Length() );
+        }
+
+        mapped.Rewind();
+        file.Rewind();
+    }
+
+    std::filesystem::remove( path );
+
+    // Empty files can't be mapped, and fall back to an empty read
+    {
+        std::ofstream out( path, std::ios::binary );
+    }
+
+    MAPPED_FILE_LINE_READER empty( path.string() );
+
+    BOOST_CHECK( empty.Contents().empty() );
+    BOOST_CHECK( empty.ReadLine() == nullptr );
+
+    std::filesystem::remove( path );
+
+    BOOST_CHECK_THROW( MAPPED_FILE_LINE_READER( path.string() ), IO_ERROR );
+}
+
+
+/**
+ * Check that text written by #GZIP_FILE_OUTPUTFORMATTER reads back line for line through
+ * #GZIP_FILE_LINE_READER, including lines which span the blocks the file is processed in.
+ */
+BOOST_AUTO_TEST_CASE( GzipRoundTrip )
+{
+    BOOST_CHECK( IsGzipFileName( wxS( "board.kicad_pcb.gz" ) ) );
+    BOOST_CHECK( IsGzipFileName( wxS( "BOARD.KICAD_PCB.GZ" ) ) );
+    BOOST_CHECK( !IsGzipFileName( wxS( "board.kicad_pcb" ) ) );
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "qa_gzip_reader.gz";
+    std::vector<std::string> lines;
+    size_t                   textSize = 0;
+
+    for( int ii = 0; ii < 50000; ++ii )
+    {
+        lines.push_back( "(line " + std::to_string( ii ) + " " + std::string( ii % 97, 'x' )
+                         + ")" );
+    }
+
+    // A long line which straddles a block boundary
+    lines.push_back( std::string( 900000, 'y' ) );
+    lines.push_back( "(last)" );
+
+    for( const std::string& line : lines )
+        textSize += line.size() + 1;
+
+    {
+        GZIP_FILE_OUTPUTFORMATTER formatter( path.string() );
+
+        for( const std::string& line : lines )
+            formatter.Print( 0, "%s\n", line.c_str() );
+
+        BOOST_CHECK( formatter.Finish() );
+    }
+
+    BOOST_CHECK_LT( std::filesystem::file_size( path ), textSize / 4 );
+
+    GZIP_FILE_LINE_READER reader( path.string() );
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        for( const std::string& line : lines )
+        {
+            BOOST_REQUIRE( reader.ReadLine() );
+            BOOST_CHECK_EQUAL( reader.Length(), line.size() + 1 );
+            BOOST_CHECK( std::string( reader.Line() ) == line + "\n" );
+        }
+
+        BOOST_CHECK( reader.ReadLine() == nullptr );
+        BOOST_CHECK_EQUAL( reader.LineNumber(), lines.size() + 1 );
+
+        reader.Rewind();
+    }
+
+    std::filesystem::remove( path );
+
+    // Files which aren't compressed are read as they are
+    {
+        std::ofstream out( path, std::ios::binary );
+        out << "(first line)\nno trailing newline";
+    }
+
+    GZIP_FILE_LINE_READER plain( path.string() );
+
+    BOOST_REQUIRE( plain.ReadLine() );
+    BOOST_CHECK_EQUAL( std::string( plain.Line() ), "(first line)\n" );
+    BOOST_REQUIRE( plain.ReadLine() );
+    BOOST_CHECK_EQUAL( std::string( plain.Line() ), "no trailing newline" );
+    BOOST_CHECK( plain.ReadLine() == nullptr );
+
+    std::filesystem::remove( path );
+
+    BOOST_CHECK_THROW( GZIP_FILE_LINE_READER( path.string() ), IO_ERROR );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
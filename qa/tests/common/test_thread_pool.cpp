@@ -0,0 +1,80 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <core/thread_pool.h>
+
+#include <atomic>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( ThreadPool )
+
+
+BOOST_AUTO_TEST_CASE( SubmitTaskResult )
+{
+    std::vector<std::future<int>> results;
+
+    for( int ii = 0; ii < 16; ++ii )
+    {
+        TASK_PRIORITY priority = static_cast<TASK_PRIORITY>( ii % 3 );
+        results.push_back( SubmitTask( priority, [ii]() { return ii * ii; } ) );
+    }
+
+    for( int ii = 0; ii < 16; ++ii )
+        BOOST_CHECK_EQUAL( results[ii].get(), ii * ii );
+}
+
+
+BOOST_AUTO_TEST_CASE( CancelledTask )
+{
+    CANCELLATION_TOKEN token;
+    token.Cancel();
+
+    std::future<int> result = SubmitTask( TASK_PRIORITY::FOREGROUND, []() { return 1; }, &token );
+
+    BOOST_CHECK_THROW( result.get(), std::future_error );
+}
+
+
+BOOST_AUTO_TEST_CASE( NestedParallelFor )
+{
+    std::atomic<size_t> count = 0;
+
+    // Each inner loop runs from a task of the outer one, which must not wait for queued helpers
+    ParallelForEachIndex( 64,
+            [&]( size_t )
+            {
+                ParallelForEachIndex( 64,
+                        [&]( size_t )
+                        {
+                            count++;
+                        } );
+            } );
+
+    BOOST_CHECK_EQUAL( count.load(), size_t( 64 * 64 ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
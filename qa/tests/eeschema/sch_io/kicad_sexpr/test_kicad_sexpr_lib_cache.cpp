@@ -0,0 +1,101 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_kicad_sexpr_lib_cache.cpp
+ * Test suite for #SCH_IO_KICAD_SEXPR_LIB_CACHE
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <eeschema/sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_cache.h>
+#include <eeschema/sch_io/kicad_sexpr/sch_io_kicad_sexpr_parser.h>
+#include <lib_symbol.h>
+#include <locale_io.h>
+#include <richio.h>
+
+
+struct KICAD_SEXPR_LIB_CACHE_FIXTURE
+{
+    KICAD_SEXPR_LIB_CACHE_FIXTURE() {}
+
+    wxString GetLibraryPath() const
+    {
+        return wxString( KI_TEST::GetEeschemaTestDataDir() )
+               + wxS( "spice_netlists/legacy_pspice/schematic_libspice.kicad_sym" );
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( KiCadSexprLibCache, KICAD_SEXPR_LIB_CACHE_FIXTURE )
+
+
+/**
+ * Symbols parsed on demand have to be the same as the ones of the whole library.
+ */
+BOOST_AUTO_TEST_CASE( OnDemandSymbols )
+{
+    SCH_IO_KICAD_SEXPR_LIB_CACHE lazy( GetLibraryPath() );
+    LIB_SYMBOL_MAP               full;
+    LOCALE_IO                    toggle;
+
+    lazy.Load();
+
+    FILE_LINE_READER          reader( GetLibraryPath() );
+    SCH_IO_KICAD_SEXPR_PARSER parser( &reader );
+
+    parser.ParseLib( full );
+
+    std::vector<wxString> names = lazy.GetSymbolNames( false );
+
+    BOOST_REQUIRE_EQUAL( names.size(), full.size() );
+    BOOST_CHECK_EQUAL( lazy.GetFileFormatVersionAtLoad(), parser.GetParsedRequiredVersion() );
+
+    // A derived symbol brings its parent along
+    LIB_SYMBOL* derived = lazy.GetSymbol( wxS( "C" ) );
+
+    BOOST_REQUIRE( derived );
+    BOOST_CHECK( derived->IsAlias() );
+    BOOST_REQUIRE( derived->GetParent().lock() );
+    BOOST_CHECK_EQUAL( derived->GetParent().lock()->GetName(), wxS( "CAP" ) );
+
+    for( const wxString& name : names )
+    {
+        BOOST_TEST_CONTEXT( name.ToStdString() )
+        {
+            LIB_SYMBOL* symbol = lazy.GetSymbol( name );
+
+            BOOST_REQUIRE( symbol );
+            BOOST_REQUIRE( full.count( name ) );
+            BOOST_CHECK( symbol->Compare( *full[name] ) == 0 );
+        }
+    }
+
+    BOOST_CHECK( lazy.GetSymbol( wxS( "not a symbol" ) ) == nullptr );
+
+    for( auto& [name, symbol] : full )
+        delete symbol;
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
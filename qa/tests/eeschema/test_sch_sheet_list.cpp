@@ -17,9 +17,13 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <set>
+
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include "eeschema_test_utils.h"
 
+#include <sch_screen.h>
+#include <sch_sheet.h>
 #include <sch_sheet_path.h>
 #include <wildcards_and_files_ext.h>
 
@@ -62,6 +66,34 @@ BOOST_AUTO_TEST_CASE( TestSheetListPageProperties )
 }
 
 
+BOOST_AUTO_TEST_CASE( TestPrefetchedHierarchy )
+{
+    // The sub-sheets are parsed ahead of the hierarchy, on placeholder sheets
+    LoadSchematic( "complex_hierarchy_shared/complex_hierarchy" );
+
+    SCH_SHEET_LIST        sheets = m_schematic.GetSheets();
+    std::set<SCH_SCREEN*> screens;
+
+    BOOST_REQUIRE_EQUAL( sheets.size(), 5 );
+
+    for( const SCH_SHEET_PATH& path : sheets )
+    {
+        SCH_SCREEN* screen = path.LastScreen();
+
+        BOOST_REQUIRE( screen );
+        BOOST_CHECK( !screen->Items().empty() );
+        screens.insert( screen );
+
+        // Sub-sheets have to know the sheet they were loaded on
+        for( SCH_ITEM* item : screen->Items().OfType( SCH_SHEET_T ) )
+            BOOST_CHECK( static_cast<SCH_SHEET*>( item->GetParent() )->GetScreen() == screen );
+    }
+
+    // The shared sub-sheet and its filter sheet are only loaded once
+    BOOST_CHECK_EQUAL( screens.size(), 3 );
+}
+
+
 BOOST_AUTO_TEST_CASE( TestEditPageNumbersInSharedDesign )
 {
     BOOST_TEST_CONTEXT( "Read Sub-Sheet, prior to modification" )
@@ -129,6 +129,29 @@ BOOST_AUTO_TEST_CASE( Compare )
 }
 
 
+BOOST_AUTO_TEST_CASE( IsPath )
+{
+    BOOST_CHECK( m_linear.IsPath( m_linear.Path() ) );
+    BOOST_CHECK( m_empty_path.IsPath( m_empty_path.Path() ) );
+    BOOST_CHECK( !m_empty_path.IsPath( m_linear.Path() ) );
+
+    // Same length and same end, but a different intermediate sheet
+    SCH_SHEET_PATH other;
+    other.push_back( &m_sheets[0] );
+    other.push_back( &m_sheets[3] );
+    other.push_back( &m_sheets[2] );
+
+    BOOST_CHECK( !m_linear.IsPath( other.Path() ) );
+    BOOST_CHECK( other.IsPath( other.Path() ) );
+
+    // A prefix of the path
+    KIID_PATH prefix = m_linear.Path();
+    prefix.pop_back();
+
+    BOOST_CHECK( !m_linear.IsPath( prefix ) );
+}
+
+
 /**
  * Test sheet path page number properties.
  */
@@ -0,0 +1,113 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/circle_grid_index.h>
+
+#include <random>
+
+
+BOOST_AUTO_TEST_SUITE( CircleGridIndex )
+
+
+/**
+ * Queries must find exactly the circles a brute-force scan finds, for dense and sparse grids
+ * and for radii much larger than the average.
+ */
+BOOST_AUTO_TEST_CASE( MatchesBruteForce )
+{
+    std::mt19937 rng( 42 );
+
+    for( int count : { 0, 1, 50, 2000 } )
+    {
+        for( int extent : { 1000000, 100000000 } )
+        {
+            BOOST_TEST_CONTEXT( count << " circles over " << extent )
+            {
+                std::uniform_int_distribution<int> pos( -extent, extent );
+                std::uniform_int_distribution<int> radius( 1000, 5000 );
+                std::uniform_int_distribution<int> bigRadius( 50000, 200000 );
+
+                CIRCLE_GRID_INDEX<int> index;
+                std::vector<VECTOR2I>  centers;
+                std::vector<int>       radii;
+
+                for( int ii = 0; ii < count; ++ii )
+                {
+                    centers.emplace_back( pos( rng ), pos( rng ) );
+                    radii.push_back( ii % 97 == 0 ? bigRadius( rng ) : radius( rng ) );
+                    index.Add( centers.back(), radii.back(), ii );
+                }
+
+                const int clearance = 20000;
+
+                index.Build( clearance );
+                BOOST_CHECK_EQUAL( index.size(), (size_t) count );
+
+                std::vector<size_t> found;
+
+                for( int ii = 0; ii < count; ++ii )
+                {
+                    std::vector<size_t> expected;
+
+                    for( int jj = 0; jj < count; ++jj )
+                    {
+                        int64_t distSq = ( centers[jj] - centers[ii] ).SquaredEuclideanNorm();
+                        int64_t minDist = (int64_t) clearance + radii[ii] + radii[jj];
+
+                        if( distSq < minDist * minDist )
+                            expected.push_back( jj );
+                    }
+
+                    index.Query( centers[ii], radii[ii], clearance, found );
+                    BOOST_CHECK( found == expected );
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * Concentric circles always collide, and a circle finds itself.
+ */
+BOOST_AUTO_TEST_CASE( Concentric )
+{
+    CIRCLE_GRID_INDEX<int> index;
+    std::vector<size_t>    found;
+
+    index.Add( VECTOR2I( 100, 100 ), 0, 0 );
+    index.Add( VECTOR2I( 100, 100 ), 0, 1 );
+    index.Add( VECTOR2I( 5000, 100 ), 10, 2 );
+    index.Build( 0 );
+
+    index.Query( VECTOR2I( 100, 100 ), 0, 0, found );
+    BOOST_CHECK( found == std::vector<size_t>( { 0, 1 } ) );
+
+    index.Query( VECTOR2I( 5000, 100 ), 10, 0, found );
+    BOOST_CHECK( found == std::vector<size_t>( { 2 } ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
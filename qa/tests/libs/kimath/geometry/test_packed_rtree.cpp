@@ -0,0 +1,142 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/packed_rtree.h>
+
+#include <random>
+
+
+BOOST_AUTO_TEST_SUITE( PackedRTree )
+
+
+struct BOX
+{
+    int m_min[2];
+    int m_max[2];
+};
+
+
+static bool overlaps( const BOX& aA, const BOX& aB )
+{
+    return aA.m_min[0] <= aB.m_max[0] && aA.m_max[0] >= aB.m_min[0]
+            && aA.m_min[1] <= aB.m_max[1] && aA.m_max[1] >= aB.m_min[1];
+}
+
+
+static BOX randomBox( std::mt19937& aRng, int aExtent, int aMaxSize )
+{
+    std::uniform_int_distribution<int> pos( -aExtent, aExtent );
+    std::uniform_int_distribution<int> size( 0, aMaxSize );
+
+    BOX box;
+    box.m_min[0] = pos( aRng );
+    box.m_min[1] = pos( aRng );
+    box.m_max[0] = box.m_min[0] + size( aRng );
+    box.m_max[1] = box.m_min[1] + size( aRng );
+
+    return box;
+}
+
+
+/**
+ * Searches must find exactly the items a brute-force scan finds, for tree sizes which don't
+ * fill their nodes and which need several levels.
+ */
+BOOST_AUTO_TEST_CASE( MatchesBruteForce )
+{
+    std::mt19937 rng( 42 );
+
+    for( int count : { 0, 1, 15, 16, 17, 300, 5000 } )
+    {
+        BOOST_TEST_CONTEXT( count << " items" )
+        {
+            PACKED_RTREE<int> tree;
+            std::vector<BOX>  boxes;
+
+            for( int ii = 0; ii < count; ++ii )
+            {
+                boxes.push_back( randomBox( rng, 100000, 5000 ) );
+                tree.Add( boxes.back().m_min, boxes.back().m_max, ii );
+            }
+
+            tree.Build();
+            BOOST_CHECK_EQUAL( tree.size(), (size_t) count );
+
+            for( int query = 0; query < 100; ++query )
+            {
+                BOX              area = randomBox( rng, 100000, 20000 );
+                std::vector<int> found;
+                std::vector<int> expected;
+
+                auto visit =
+                        [&]( int aItem ) -> bool
+                        {
+                            found.push_back( aItem );
+                            return true;
+                        };
+
+                BOOST_CHECK( tree.Search( area.m_min, area.m_max, visit ) );
+
+                for( int ii = 0; ii < count; ++ii )
+                {
+                    if( overlaps( boxes[ii], area ) )
+                        expected.push_back( ii );
+                }
+
+                std::sort( found.begin(), found.end() );
+                BOOST_CHECK( found == expected );
+            }
+        }
+    }
+}
+
+
+/**
+ * A visitor returning false must stop the search.
+ */
+BOOST_AUTO_TEST_CASE( VisitorStopsSearch )
+{
+    PACKED_RTREE<int> tree;
+    const int         min[2] = { 0, 0 };
+    const int         max[2] = { 10, 10 };
+
+    for( int ii = 0; ii < 100; ++ii )
+        tree.Add( min, max, ii );
+
+    tree.Build();
+
+    int  visited = 0;
+    auto visit =
+            [&]( int aItem ) -> bool
+            {
+                return ++visited < 5;
+            };
+
+    BOOST_CHECK( !tree.Search( min, max, visit ) );
+    BOOST_CHECK_EQUAL( visited, 5 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
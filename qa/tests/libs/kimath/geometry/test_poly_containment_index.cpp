@@ -0,0 +1,103 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/poly_containment_index.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/geometry/poly_set_construction.h>
+#include <qa_utils/geometry/line_chain_construction.h>
+
+
+BOOST_AUTO_TEST_SUITE( PolyContainmentIndex )
+
+
+static SHAPE_POLY_SET buildTestSet()
+{
+    namespace KT = KI_TEST;
+
+    // A hollow square with an island inside its hole, plus a separate triangle
+    SHAPE_POLY_SET polySet = KT::BuildHollowSquare( 20000, 10000 );
+
+    polySet.AddOutline( KT::BuildSquareChain( 4000 ) );
+
+    SHAPE_LINE_CHAIN triangle( { VECTOR2I( 20000, -5000 ), VECTOR2I( 30000, 5000 ),
+                                 VECTOR2I( 25000, -9000 ) } );
+    triangle.SetClosed( true );
+    polySet.AddOutline( triangle );
+
+    return polySet;
+}
+
+
+/**
+ * The index must agree with SHAPE_POLY_SET::Contains(), including for points on (or within
+ * rounding of) outline and hole edges.
+ */
+BOOST_AUTO_TEST_CASE( MatchesContains )
+{
+    SHAPE_POLY_SET        polySet = buildTestSet();
+    std::vector<VECTOR2I> points;
+
+    for( int x = -12000; x <= 32000; x += 500 )
+    {
+        for( int y = -12000; y <= 12000; y += 500 )
+        {
+            points.emplace_back( x, y );
+            points.emplace_back( x + 1, y - 1 );
+        }
+    }
+
+    for( int strips : { -1, 1, 7, 100 } )
+    {
+        POLY_CONTAINMENT_INDEX index( polySet, strips );
+        std::vector<bool>      results = index.Contains( points );
+
+        BOOST_REQUIRE_EQUAL( results.size(), points.size() );
+
+        for( size_t ii = 0; ii < points.size(); ii++ )
+        {
+            BOOST_TEST_CONTEXT( "Strips " << strips << ", point " << points[ii] )
+            {
+                bool expected = polySet.Contains( points[ii], -1, 1 );
+
+                BOOST_CHECK_EQUAL( results[ii], expected );
+                BOOST_CHECK_EQUAL( index.Contains( points[ii] ), expected );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    SHAPE_POLY_SET         polySet;
+    POLY_CONTAINMENT_INDEX index( polySet );
+
+    BOOST_CHECK( !index.Contains( VECTOR2I( 0, 0 ) ) );
+    BOOST_CHECK_EQUAL( index.Contains( std::vector<VECTOR2I>{ { 0, 0 }, { 1, 1 } } ).size(), 2 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
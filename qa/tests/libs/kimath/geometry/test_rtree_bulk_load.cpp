@@ -0,0 +1,172 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/rtree.h>
+
+#include <cstdint>
+#include <random>
+
+
+BOOST_AUTO_TEST_SUITE( RTreeBulkLoad )
+
+
+// Data must be the size of a pointer, as removal compares it as one
+using TREE = RTree<intptr_t, int, 2, double>;
+
+
+static TREE::Rect randomRect( std::mt19937& aRng, int aExtent, int aMaxSize )
+{
+    std::uniform_int_distribution<int> pos( -aExtent, aExtent );
+    std::uniform_int_distribution<int> size( 0, aMaxSize );
+
+    TREE::Rect rect;
+    rect.m_min[0] = pos( aRng );
+    rect.m_min[1] = pos( aRng );
+    rect.m_max[0] = rect.m_min[0] + size( aRng );
+    rect.m_max[1] = rect.m_min[1] + size( aRng );
+
+    return rect;
+}
+
+
+static bool overlaps( const TREE::Rect& aA, const TREE::Rect& aB )
+{
+    return aA.m_min[0] <= aB.m_max[0] && aA.m_max[0] >= aB.m_min[0]
+            && aA.m_min[1] <= aB.m_max[1] && aA.m_max[1] >= aB.m_min[1];
+}
+
+
+/**
+ * Check that searches of \a aTree find exactly the entries of \a aRects marked in \a aLive.
+ */
+static void checkSearches( std::mt19937& aRng, const TREE& aTree,
+                           const std::vector<TREE::Rect>& aRects, const std::vector<bool>& aLive )
+{
+    for( int query = 0; query < 50; ++query )
+    {
+        TREE::Rect       area = randomRect( aRng, 100000, 20000 );
+        std::vector<int> found;
+        std::vector<int> expected;
+
+        auto visit =
+                [&]( intptr_t aItem ) -> bool
+                {
+                    found.push_back( (int) aItem );
+                    return true;
+                };
+
+        aTree.Search( area.m_min, area.m_max, visit );
+
+        for( size_t ii = 0; ii < aRects.size(); ++ii )
+        {
+            if( aLive[ii] && overlaps( aRects[ii], area ) )
+                expected.push_back( (int) ii );
+        }
+
+        std::sort( found.begin(), found.end() );
+        BOOST_CHECK( found == expected );
+    }
+}
+
+
+/**
+ * A bulk loaded tree must find what a brute-force scan finds, and keep doing so as entries are
+ * inserted into and removed from it the usual way.
+ */
+BOOST_AUTO_TEST_CASE( MatchesBruteForce )
+{
+    std::mt19937 rng( 42 );
+
+    for( int count : { 1, 7, 8, 9, 64, 65, 5000 } )
+    {
+        BOOST_TEST_CONTEXT( count << " items" )
+        {
+            TREE                                         tree;
+            std::vector<TREE::Rect>                      rects;
+            std::vector<std::pair<TREE::Rect, intptr_t>> entries;
+
+            for( int ii = 0; ii < count; ++ii )
+            {
+                rects.push_back( randomRect( rng, 100000, 5000 ) );
+                entries.emplace_back( rects.back(), ii );
+            }
+
+            tree.BulkLoad( entries );
+
+            std::vector<bool> live( rects.size(), true );
+
+            BOOST_CHECK_EQUAL( tree.Count(), count );
+            checkSearches( rng, tree, rects, live );
+
+            // Remove every other entry and insert as many new ones
+            for( int ii = 0; ii < count; ii += 2 )
+            {
+                BOOST_CHECK( !tree.Remove( rects[ii].m_min, rects[ii].m_max, (intptr_t) ii ) );
+                live[ii] = false;
+            }
+
+            for( int ii = 0; ii < count / 2; ++ii )
+            {
+                rects.push_back( randomRect( rng, 100000, 5000 ) );
+                live.push_back( true );
+                tree.Insert( rects.back().m_min, rects.back().m_max, (intptr_t) rects.size() - 1 );
+            }
+
+            checkSearches( rng, tree, rects, live );
+        }
+    }
+}
+
+
+/**
+ * Bulk loading into a tree which isn't empty must keep the entries it already holds.
+ */
+BOOST_AUTO_TEST_CASE( LoadsIntoExistingTree )
+{
+    std::mt19937                                 rng( 7 );
+    TREE                                         tree;
+    std::vector<TREE::Rect>                      rects;
+    std::vector<std::pair<TREE::Rect, intptr_t>> entries;
+
+    for( int ii = 0; ii < 500; ++ii )
+    {
+        rects.push_back( randomRect( rng, 100000, 5000 ) );
+        tree.Insert( rects.back().m_min, rects.back().m_max, (intptr_t) ii );
+    }
+
+    for( int ii = 500; ii < 2000; ++ii )
+    {
+        rects.push_back( randomRect( rng, 100000, 5000 ) );
+        entries.emplace_back( rects.back(), ii );
+    }
+
+    tree.BulkLoad( entries );
+
+    BOOST_CHECK_EQUAL( tree.Count(), 2000 );
+    checkSearches( rng, tree, rects, std::vector<bool>( rects.size(), true ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -695,4 +695,26 @@ BOOST_AUTO_TEST_CASE( SegCreatePerpendicular )
     }
 }
 
+BOOST_AUTO_TEST_CASE( SegBoxDistance )
+{
+    for( const auto& c : segment_and_point_cases )
+    {
+        BOOST_TEST_CONTEXT( c.m_case_name )
+        {
+            BOOST_CHECK_LE( c.m_seg.SquaredBoxDistance( c.m_vec ),
+                            c.m_seg.SquaredDistance( c.m_vec ) );
+        }
+    }
+
+    const SEG diagonal( { 0, 0 }, { 100, 100 } );
+
+    // Inside the bounding box, but not on the segment
+    BOOST_CHECK_EQUAL( diagonal.SquaredBoxDistance( VECTOR2I( 100, 0 ) ), 0 );
+
+    BOOST_CHECK_EQUAL( diagonal.SquaredBoxDistance( VECTOR2I( 103, 104 ) ), 3 * 3 + 4 * 4 );
+    BOOST_CHECK_EQUAL( diagonal.SquaredBoxDistance( SEG( { -10, 150 }, { -20, 200 } ) ),
+                       10 * 10 + 50 * 50 );
+    BOOST_CHECK_EQUAL( diagonal.SquaredBoxDistance( SEG( { 50, -10 }, { 60, 200 } ) ), 0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
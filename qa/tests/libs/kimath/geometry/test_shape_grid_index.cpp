@@ -0,0 +1,163 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/shape_grid_index.h>
+#include <geometry/shape_index.h>
+#include <geometry/shape_rect.h>
+
+#include <memory>
+#include <random>
+
+
+BOOST_AUTO_TEST_SUITE( ShapeGridIndex )
+
+
+/**
+ * The indexes look the shapes of their objects up through Shape(), like the router items.
+ */
+struct ITEM
+{
+    ITEM( int aX, int aY, int aW, int aH ) : m_rect( aX, aY, aW, aH ) {}
+
+    const SHAPE* Shape() const { return &m_rect; }
+
+    SHAPE_RECT m_rect;
+};
+
+
+static std::unique_ptr<ITEM> randomItem( std::mt19937& aRng, int aExtent, int aMaxSize )
+{
+    std::uniform_int_distribution<int> pos( -aExtent, aExtent );
+    std::uniform_int_distribution<int> size( 0, aMaxSize );
+
+    return std::make_unique<ITEM>( pos( aRng ), pos( aRng ), size( aRng ), size( aRng ) );
+}
+
+
+template <class INDEX>
+static std::vector<ITEM*> query( const INDEX& aIndex, const SHAPE& aShape, int aMinDistance )
+{
+    std::vector<ITEM*> found;
+
+    auto visit =
+            [&]( ITEM* aItem ) -> bool
+            {
+                found.push_back( aItem );
+                return true;
+            };
+
+    aIndex.Query( &aShape, aMinDistance, visit );
+
+    std::sort( found.begin(), found.end() );
+    return found;
+}
+
+
+/**
+ * The spatial hash must find the same objects as the R-tree of SHAPE_INDEX, whatever the size
+ * of the objects and of the queries compared to its cells, and keep doing so as objects are
+ * removed from both.
+ */
+BOOST_AUTO_TEST_CASE( MatchesShapeIndex )
+{
+    std::mt19937 rng( 17 );
+
+    for( int cellSize : { 1, 250, 4000 } )
+    {
+        BOOST_TEST_CONTEXT( "cell size " << cellSize )
+        {
+            SHAPE_INDEX<ITEM*>                 tree;
+            SHAPE_GRID_INDEX<ITEM*>            grid( cellSize );
+            std::vector<std::unique_ptr<ITEM>> items;
+
+            // Mostly small objects, with a few large ones spanning many cells
+            for( int ii = 0; ii < 3000; ++ii )
+                items.push_back( randomItem( rng, 100000, ii % 50 == 0 ? 80000 : 2000 ) );
+
+            for( const std::unique_ptr<ITEM>& item : items )
+            {
+                tree.Add( item.get() );
+                grid.Add( item.get() );
+            }
+
+            for( int pass = 0; pass < 2; ++pass )
+            {
+                for( int ii = 0; ii < 200; ++ii )
+                {
+                    std::unique_ptr<ITEM> area =
+                            randomItem( rng, 110000, ii % 20 == 0 ? 150000 : 3000 );
+                    int clearance = ii % 3 == 0 ? 0 : 500;
+
+                    BOOST_CHECK( query( grid, area->m_rect, clearance )
+                                 == query( tree, area->m_rect, clearance ) );
+                }
+
+                // Remove every other object before the second pass
+                for( size_t ii = 0; ii < items.size(); ii += 2 )
+                {
+                    tree.Remove( items[ii].get() );
+                    grid.Remove( items[ii].get() );
+                }
+            }
+        }
+    }
+}
+
+
+/**
+ * The search stops when the visitor returns false, and only the accepted objects are counted.
+ */
+BOOST_AUTO_TEST_CASE( VisitorStops )
+{
+    SHAPE_GRID_INDEX<ITEM*>            grid( 100 );
+    std::vector<std::unique_ptr<ITEM>> items;
+
+    for( int ii = 0; ii < 10; ++ii )
+    {
+        items.push_back( std::make_unique<ITEM>( ii * 50, 0, 40, 40 ) );
+        grid.Add( items.back().get() );
+    }
+
+    SHAPE_RECT area( 0, 0, 1000, 1000 );
+    int        visited = 0;
+
+    auto visit =
+            [&]( ITEM* ) -> bool
+            {
+                return ++visited < 3;
+            };
+
+    BOOST_CHECK_EQUAL( grid.Query( &area, 0, visit ), 2 );
+    BOOST_CHECK_EQUAL( visited, 3 );
+
+    grid.RemoveAll();
+    visited = 0;
+
+    BOOST_CHECK_EQUAL( grid.Query( &area, 0, visit ), 0 );
+    BOOST_CHECK_EQUAL( visited, 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
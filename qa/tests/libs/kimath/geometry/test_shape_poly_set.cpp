@@ -15,6 +15,9 @@
  *
  */
 
+#include <sstream>
+
+#include <geometry/inflate_cache.h>
 #include <geometry/shape_poly_set.h>
 #include <trigo.h>
 
@@ -64,4 +67,367 @@ BOOST_AUTO_TEST_CASE( RemoveNullSegments )
 
 }
 
+/**
+ * A chain of booleans and offsets gives the same polygons as the equivalent SHAPE_POLY_SET calls
+ */
+BOOST_AUTO_TEST_CASE( BooleanChain )
+{
+    SHAPE_POLY_SET base;
+    SHAPE_POLY_SET holes;
+    SHAPE_POLY_SET extra;
+
+    base.NewOutline();
+    base.Append( 0, 0 );
+    base.Append( 100000, 0 );
+    base.Append( 100000, 100000 );
+    base.Append( 0, 100000 );
+
+    // Clockwise, to check the orientation is fixed
+    holes.NewOutline();
+    holes.Append( 20000, 20000 );
+    holes.Append( 20000, 40000 );
+    holes.Append( 40000, 40000 );
+    holes.Append( 40000, 20000 );
+
+    holes.NewOutline();
+    holes.Append( 60000, 60000 );
+    holes.Append( 80000, 60000 );
+    holes.Append( 80000, 80000 );
+    holes.Append( 60000, 80000 );
+
+    extra.NewOutline();
+    extra.Append( 90000, 40000 );
+    extra.Append( 150000, 40000 );
+    extra.Append( 150000, 60000 );
+    extra.Append( 90000, 60000 );
+
+    SHAPE_POLY_SET expected = base;
+    expected.BooleanSubtract( holes, SHAPE_POLY_SET::PM_FAST );
+    expected.Deflate( 1000, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, 100 );
+    expected.BooleanAdd( extra, SHAPE_POLY_SET::PM_FAST );
+    expected.Inflate( 1000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 100 );
+
+    SHAPE_POLY_SET result;
+    SHAPE_POLY_SET::BOOLEAN_CHAIN chain( base );
+
+    chain.Subtract( holes )
+         .Deflate( 1000, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, 100 )
+         .Add( extra )
+         .Inflate( 1000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 100 );
+    chain.Finish( result );
+
+    BOOST_CHECK_EQUAL( result.OutlineCount(), expected.OutlineCount() );
+    BOOST_CHECK_EQUAL( result.HoleCount( 0 ), expected.HoleCount( 0 ) );
+    BOOST_CHECK_CLOSE( result.Area(), expected.Area(), 1e-6 );
+
+    // Ending on a boolean
+    expected.BooleanIntersection( base, SHAPE_POLY_SET::PM_FAST );
+    chain.Intersect( base );
+    chain.Finish( result );
+
+    BOOST_CHECK_EQUAL( result.OutlineCount(), expected.OutlineCount() );
+    BOOST_CHECK_EQUAL( result.HoleCount( 0 ), expected.HoleCount( 0 ) );
+    BOOST_CHECK_CLOSE( result.Area(), expected.Area(), 1e-6 );
+}
+
+
+/**
+ * Consecutive adds, or consecutive subtracts, are run as one boolean with the same result
+ */
+BOOST_AUTO_TEST_CASE( BooleanChainMergedOperands )
+{
+    SHAPE_POLY_SET base;
+    SHAPE_POLY_SET expected;
+    SHAPE_POLY_SET result;
+
+    base.NewOutline();
+    base.Append( 0, 0 );
+    base.Append( 100000, 0 );
+    base.Append( 100000, 100000 );
+    base.Append( 0, 100000 );
+
+    auto square =
+            []( int aX, int aY, int aSize )
+            {
+                SHAPE_POLY_SET poly;
+
+                poly.NewOutline();
+                poly.Append( aX, aY );
+                poly.Append( aX + aSize, aY );
+                poly.Append( aX + aSize, aY + aSize );
+                poly.Append( aX, aY + aSize );
+
+                return poly;
+            };
+
+    // Overlapping operands, and one with a hole covered by another operand
+    std::vector<SHAPE_POLY_SET> cuts = { square( 10000, 10000, 30000 ),
+                                         square( 30000, 30000, 30000 ),
+                                         square( 50000, 0, 40000 ) };
+
+    cuts[2].AddHole( square( 60000, 10000, 10000 ).Outline( 0 ) );
+    cuts.push_back( square( 55000, 5000, 20000 ) );
+
+    expected = base;
+
+    for( const SHAPE_POLY_SET& cut : cuts )
+        expected.BooleanSubtract( cut, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET::BOOLEAN_CHAIN subtracted( base );
+
+    for( const SHAPE_POLY_SET& cut : cuts )
+        subtracted.Subtract( cut );
+
+    subtracted.Finish( result );
+
+    BOOST_CHECK_EQUAL( result.OutlineCount(), expected.OutlineCount() );
+    BOOST_CHECK_CLOSE( result.Area(), expected.Area(), 1e-6 );
+
+    expected = SHAPE_POLY_SET();
+
+    for( const SHAPE_POLY_SET& cut : cuts )
+        expected.BooleanAdd( cut, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET::BOOLEAN_CHAIN added( ( SHAPE_POLY_SET() ) );
+
+    for( const SHAPE_POLY_SET& cut : cuts )
+        added.Add( cut );
+
+    added.Finish( result );
+
+    BOOST_CHECK_EQUAL( result.OutlineCount(), expected.OutlineCount() );
+    BOOST_CHECK_CLOSE( result.Area(), expected.Area(), 1e-6 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ParallelSimplify )
+{
+    SHAPE_POLY_SET polys;
+
+    auto addRect =
+            [&]( int aX, int aY, int aWidth, int aHeight )
+            {
+                polys.NewOutline();
+                polys.Append( aX, aY );
+                polys.Append( aX + aWidth, aY );
+                polys.Append( aX + aWidth, aY + aHeight );
+                polys.Append( aX, aY + aHeight );
+            };
+
+    // Enough separate squares to be split into buckets, some of them overlapping their
+    // neighbours, and bars joining whole rows and columns across the buckets
+    for( int ii = 0; ii < 60; ++ii )
+    {
+        for( int jj = 0; jj < 60; ++jj )
+            addRect( ii * 2000, jj * 2000, ( ii + jj ) % 7 ? 1500 : 2500, 1500 );
+    }
+
+    for( int ii = 0; ii < 60; ii += 13 )
+    {
+        addRect( 0, ii * 2000 + 500, 120000, 500 );
+        addRect( ii * 2000 + 500, 0, 500, 120000 );
+    }
+
+    SHAPE_POLY_SET expected = polys;
+    expected.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    polys.ParallelSimplify( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( polys.OutlineCount(), expected.OutlineCount() );
+    BOOST_CHECK_EQUAL( polys.TotalVertices(), expected.TotalVertices() );
+    BOOST_CHECK_CLOSE( polys.Area(), expected.Area(), 1e-6 );
+
+    SHAPE_POLY_SET diff = polys;
+    diff.BooleanXor( expected, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( diff.OutlineCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( TriangulationRoundTrip )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( 0, 0 );
+    poly.Append( 30000000, 0 );
+    poly.Append( 30000000, 20000000 );
+    poly.Append( 0, 20000000 );
+    poly.NewHole();
+    poly.Append( 1000000, 1000000, 0, 0 );
+    poly.Append( 1000000, 5000000, 0, 0 );
+    poly.Append( 5000000, 5000000, 0, 0 );
+    poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET restored = poly;
+    std::stringstream stream;
+
+    // Nothing to write before triangulating
+    BOOST_CHECK( !poly.WriteTriangulation( stream ) );
+
+    poly.CacheTriangulation();
+    BOOST_REQUIRE( poly.WriteTriangulation( stream ) );
+
+    std::string data = stream.str();
+
+    BOOST_CHECK( !restored.IsTriangulationUpToDate() );
+    BOOST_CHECK( restored.ReadTriangulation( stream ) );
+    BOOST_CHECK( restored.IsTriangulationUpToDate() );
+    BOOST_REQUIRE_EQUAL( restored.TriangulatedPolyCount(), poly.TriangulatedPolyCount() );
+
+    for( unsigned int ii = 0; ii < poly.TriangulatedPolyCount(); ++ii )
+    {
+        BOOST_CHECK( restored.TriangulatedPolygon( ii )->Vertices()
+                     == poly.TriangulatedPolygon( ii )->Vertices() );
+        BOOST_CHECK_EQUAL( restored.TriangulatedPolygon( ii )->GetTriangleCount(),
+                           poly.TriangulatedPolygon( ii )->GetTriangleCount() );
+    }
+
+    // A triangulation of other polygons, or a truncated one, is not restored
+    SHAPE_POLY_SET moved = poly.CloneDropTriangulation();
+    moved.Move( VECTOR2I( 1, 0 ) );
+
+    std::stringstream movedStream( data );
+    BOOST_CHECK( !moved.ReadTriangulation( movedStream ) );
+    BOOST_CHECK( !moved.IsTriangulationUpToDate() );
+
+    SHAPE_POLY_SET    truncated = poly.CloneDropTriangulation();
+    std::stringstream truncatedStream( data.substr( 0, data.size() / 2 ) );
+
+    BOOST_CHECK( !truncated.ReadTriangulation( truncatedStream ) );
+    BOOST_CHECK( !truncated.IsTriangulationUpToDate() );
+}
+
+
+BOOST_AUTO_TEST_CASE( FractureManyHoles )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( 0, 0 );
+    poly.Append( 1000000, 0 );
+    poly.Append( 1000000, 1000000 );
+    poly.Append( 0, 1000000 );
+
+    // A via field: rows of holes, some of them sharing the row of another's leftmost point
+    for( int ii = 0; ii < 40; ++ii )
+    {
+        for( int jj = 0; jj < 40; ++jj )
+        {
+            int x = 10000 + ii * 24000;
+            int y = 10000 + jj * 24000 + ( ii % 2 ) * 5000;
+
+            SHAPE_LINE_CHAIN hole( { VECTOR2I( x, y ), VECTOR2I( x + 5000, y - 5000 ),
+                                     VECTOR2I( x + 10000, y ), VECTOR2I( x + 5000, y + 5000 ) },
+                                   true );
+
+            poly.AddHole( hole );
+        }
+    }
+
+    double area = poly.Area();
+
+    poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( poly.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( poly.HoleCount( 0 ), 0 );
+    BOOST_CHECK_CLOSE( poly.Area(), area, 1e-6 );
+
+    poly.Unfracture( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( poly.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( poly.HoleCount( 0 ), 40 * 40 );
+}
+
+
+BOOST_AUTO_TEST_CASE( InflateConvex )
+{
+    const int amount = 10000;
+    const int maxError = 5;
+
+    // Segments, as tracks are, spaced far enough apart to stay disjoint once inflated
+    SHAPE_POLY_SET tracks;
+
+    for( int ii = 0; ii < 10; ++ii )
+    {
+        SHAPE_LINE_CHAIN seg( { VECTOR2I( 0, ii * 50000 ), VECTOR2I( 100000, ii * 50000 ) }, true );
+        tracks.AddOutline( seg );
+    }
+
+    tracks.Inflate( amount, CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError );
+
+    double expected = M_PI * amount * amount + 2.0 * amount * 100000;
+
+    BOOST_CHECK_EQUAL( tracks.OutlineCount(), 10 );
+
+    for( int ii = 0; ii < tracks.OutlineCount(); ++ii )
+    {
+        BOOST_CHECK_CLOSE( tracks.Outline( ii ).Area(), expected, 0.1 );
+        BOOST_CHECK( tracks.Outline( ii ).BBox().GetWidth() <= 100000 + 2 * amount + 1 );
+    }
+
+    // Inflated outlines which overlap still have to be merged
+    SHAPE_POLY_SET overlapping;
+    overlapping.AddOutline( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 0 ), VECTOR2I( 100000, 0 ) }, true ) );
+    overlapping.AddOutline( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 15000 ), VECTOR2I( 100000, 15000 ) },
+                                              true ) );
+    overlapping.Inflate( amount, CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError );
+
+    BOOST_CHECK_EQUAL( overlapping.OutlineCount(), 1 );
+
+    // A concave outline goes through the general offset
+    SHAPE_POLY_SET concave;
+    concave.AddOutline( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 0 ), VECTOR2I( 100000, 0 ),
+                                            VECTOR2I( 100000, 100000 ), VECTOR2I( 50000, 20000 ),
+                                            VECTOR2I( 0, 100000 ) },
+                                          true ) );
+
+    double concaveArea = concave.Area();
+    concave.Inflate( 1000, CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError );
+
+    BOOST_CHECK_EQUAL( concave.OutlineCount(), 1 );
+    BOOST_CHECK_GT( concave.Area(), concaveArea );
+}
+
+
+BOOST_AUTO_TEST_CASE( InflateCache )
+{
+    INFLATE_CACHE  cache( 2 );
+    SHAPE_POLY_SET square;
+
+    square.AddOutline( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 0 ), VECTOR2I( 100000, 0 ),
+                                           VECTOR2I( 100000, 100000 ), VECTOR2I( 0, 100000 ) },
+                                         true ) );
+
+    SHAPE_POLY_SET direct = square.CloneDropTriangulation();
+    direct.Inflate( 5000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 5 );
+
+    SHAPE_POLY_SET first = square.CloneDropTriangulation();
+    SHAPE_POLY_SET second = square.CloneDropTriangulation();
+
+    cache.Inflate( first, 5000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 5 );
+    cache.Inflate( second, 5000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 5 );
+
+    BOOST_CHECK_EQUAL( cache.Hits(), 1 );
+    BOOST_CHECK_EQUAL( cache.Size(), 1 );
+    BOOST_CHECK( first.GetHash() == direct.GetHash() );
+    BOOST_CHECK( second.GetHash() == direct.GetHash() );
+
+    // Other parameters don't hit, and the oldest entries are dropped from a full cache
+    SHAPE_POLY_SET other = square.CloneDropTriangulation();
+    cache.Inflate( other, 6000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 5 );
+    other = square.CloneDropTriangulation();
+    cache.Inflate( other, 5000, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, 5 );
+
+    BOOST_CHECK_EQUAL( cache.Hits(), 1 );
+    BOOST_CHECK_EQUAL( cache.Size(), 2 );
+
+    SHAPE_POLY_SET third = square.CloneDropTriangulation();
+    cache.Inflate( third, 5000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 5 );
+
+    BOOST_CHECK_EQUAL( cache.Hits(), 1 );
+    BOOST_CHECK( third.GetHash() == direct.GetHash() );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <geometry/unit_circle_table.h>
+#include <math/util.h>
+#include <trigo.h>
+
+
+BOOST_AUTO_TEST_SUITE( UnitCircleTable )
+
+
+/**
+ * The table vertices must be the very ones RotatePoint() gives, so that polygonized circles
+ * don't change.
+ */
+BOOST_AUTO_TEST_CASE( MatchesRotatePoint )
+{
+    const int radius = 1234567;
+
+    for( int segCount : { 8, 12, 16, 30, 64, 360, 1000, 2000 } )
+    {
+        BOOST_TEST_CONTEXT( segCount << " segments" )
+        {
+            const std::vector<VECTOR2D>& table = UNIT_CIRCLE_TABLE::Circle( segCount );
+            EDA_ANGLE                    delta = ANGLE_360 / segCount;
+            size_t                       ii = 0;
+
+            for( EDA_ANGLE angle = ANGLE_0; angle < ANGLE_360; angle += delta, ++ii )
+            {
+                VECTOR2I expected( radius, 0 );
+                RotatePoint( expected, angle );
+
+                BOOST_REQUIRE( ii < table.size() );
+                BOOST_CHECK_EQUAL( VECTOR2I( KiROUND( radius * table[ii].x ),
+                                             KiROUND( -( radius * table[ii].y ) ) ),
+                                   expected );
+            }
+
+            BOOST_CHECK_EQUAL( ii, table.size() );
+
+            // Shared tables are built once
+            if( segCount <= UNIT_CIRCLE_TABLE::MAX_CACHED_SEGCOUNT )
+                BOOST_CHECK( &UNIT_CIRCLE_TABLE::Circle( segCount ) == &table );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( HalfStepSemicircle )
+{
+    const std::vector<VECTOR2D>& table = UNIT_CIRCLE_TABLE::HalfStepSemicircle( 16 );
+
+    BOOST_REQUIRE_EQUAL( table.size(), 8 );
+    BOOST_CHECK_CLOSE( table.front().x, cos( M_PI / 16 ), 1e-9 );
+    BOOST_CHECK_CLOSE( table.back().y, sin( 15 * M_PI / 16 ), 1e-9 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Arc )
+{
+    std::vector<VECTOR2D> arc = UNIT_CIRCLE_TABLE::Arc( 0.3, -0.01, 500 );
+
+    BOOST_REQUIRE_EQUAL( arc.size(), 500 );
+
+    for( size_t ii = 0; ii < arc.size(); ++ii )
+    {
+        BOOST_CHECK_SMALL( arc[ii].x - cos( 0.3 - 0.01 * ii ), 1e-12 );
+        BOOST_CHECK_SMALL( arc[ii].y - sin( 0.3 - 0.01 * ii ), 1e-12 );
+    }
+
+    BOOST_CHECK( UNIT_CIRCLE_TABLE::Arc( 0.0, 0.1, 0 ).empty() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <pcb_track.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <settings/settings_manager.h>
+
+
+struct DRC_INCREMENTAL_TEST_FIXTURE
+{
+    DRC_INCREMENTAL_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    struct VIOLATION
+    {
+        std::shared_ptr<DRC_ITEM> m_item;
+        VECTOR2I                  m_pos;
+    };
+
+    std::vector<VIOLATION> runDRC()
+    {
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+        std::vector<VIOLATION> violations;
+
+        bds.m_DRCEngine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+                {
+                    violations.push_back( { aItem, aPos } );
+                } );
+
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+        bds.m_DRCEngine->ClearViolationHandler();
+
+        return violations;
+    }
+
+    static std::multiset<wxString> keys( const std::vector<VIOLATION>& aViolations )
+    {
+        std::multiset<wxString> keys;
+
+        for( const VIOLATION& violation : aViolations )
+        {
+            wxString key = wxString::Format( wxT( "%d" ), violation.m_item->GetErrorCode() );
+
+            for( const KIID& id : violation.m_item->GetIDs() )
+                key << wxT( " " ) << id.AsString();
+
+            keys.insert( key );
+        }
+
+        return keys;
+    }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+/**
+ * The violations of an incremental run, plus those of the previous run which it doesn't own,
+ * must be the same as the violations of a full run.
+ */
+BOOST_FIXTURE_TEST_CASE( IncrementalMatchesFullRun, DRC_INCREMENTAL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue2512", m_board );
+
+    BOARD_DESIGN_SETTINGS&      bds = m_board->GetDesignSettings();
+    std::shared_ptr<DRC_ENGINE> drcEngine = bds.m_DRCEngine;
+
+    // These need a footprint library associated to the board
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_ISSUES ] = SEVERITY::RPT_SEVERITY_IGNORE;
+    bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_MISMATCH ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+    BOOST_REQUIRE( !m_board->Tracks().empty() );
+
+    for( int ii = 0; ii < 2; ++ii )
+    {
+        std::vector<VIOLATION> previous = runDRC();
+        PCB_TRACK*             track = m_board->Tracks()[ ii ];
+        std::vector<BOX2I>     changedAreas = { track->GetBoundingBox() };
+
+        if( ii == 0 )
+        {
+            track->Move( VECTOR2I( pcbIUScale.mmToIU( 0.5 ), pcbIUScale.mmToIU( 0.5 ) ) );
+            changedAreas.push_back( track->GetBoundingBox() );
+        }
+        else
+        {
+            m_board->Remove( track );
+            delete track;
+        }
+
+        m_board->BuildConnectivity();
+
+        std::vector<VIOLATION> expected = runDRC();
+
+        drcEngine->SetIncrementalAreas( changedAreas );
+
+        std::vector<VIOLATION> incremental = runDRC();
+
+        for( const VIOLATION& violation : previous )
+        {
+            if( !drcEngine->IsIncrementalViolation( violation.m_item.get(), violation.m_pos ) )
+                incremental.push_back( violation );
+        }
+
+        drcEngine->ClearIncrementalAreas();
+
+        BOOST_CHECK( keys( incremental ) == keys( expected ) );
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <drc/drc_item.h>
+#include <pcb_marker.h>
+
+
+static std::unique_ptr<PCB_MARKER> makeMarker( int aErrorCode, const KIID& aMain,
+                                               const KIID& aAux, const VECTOR2I& aPos,
+                                               int aLayer )
+{
+    std::shared_ptr<DRC_ITEM> item = DRC_ITEM::Create( aErrorCode );
+    item->SetItems( aMain, aAux );
+
+    return std::make_unique<PCB_MARKER>( item, aPos, aLayer );
+}
+
+
+BOOST_AUTO_TEST_SUITE( DRCViolationId )
+
+
+/**
+ * Markers which serialize alike must have the same id, and the id must survive the round
+ * trip through the exclusions' serialized form.
+ */
+BOOST_AUTO_TEST_CASE( MatchesSerialize )
+{
+    PCB_MARKER::VIOLATION_ID_HASH hash;
+    KIID                          a, b;
+
+    for( int code : { DRCE_CLEARANCE, DRCE_COPPER_SLIVER, DRCE_STARVED_THERMAL } )
+    {
+        BOOST_TEST_CONTEXT( "Error code " << code )
+        {
+            std::unique_ptr<PCB_MARKER> marker = makeMarker( code, a, b, { 1000, -2000 }, In1_Cu );
+            std::unique_ptr<PCB_MARKER> same = makeMarker( code, a, b, { 1000, -2000 }, In1_Cu );
+            std::unique_ptr<PCB_MARKER> moved = makeMarker( code, a, b, { 1001, -2000 }, In1_Cu );
+            std::unique_ptr<PCB_MARKER> copy( PCB_MARKER::Deserialize( marker->Serialize() ) );
+
+            BOOST_REQUIRE( copy );
+            BOOST_CHECK( marker->GetViolationId() == same->GetViolationId() );
+            BOOST_CHECK( marker->GetViolationId() == copy->GetViolationId() );
+            BOOST_CHECK_EQUAL( hash( marker->GetViolationId() ), hash( copy->GetViolationId() ) );
+            BOOST_CHECK( !( marker->GetViolationId() == moved->GetViolationId() ) );
+        }
+    }
+}
+
+
+/**
+ * The layer only tells violations apart for the errors whose serialized form includes it.
+ */
+BOOST_AUTO_TEST_CASE( Layers )
+{
+    KIID a, b;
+
+    std::unique_ptr<PCB_MARKER> clearanceF = makeMarker( DRCE_CLEARANCE, a, b, { 0, 0 }, F_Cu );
+    std::unique_ptr<PCB_MARKER> clearanceB = makeMarker( DRCE_CLEARANCE, a, b, { 0, 0 }, B_Cu );
+    std::unique_ptr<PCB_MARKER> sliverF = makeMarker( DRCE_COPPER_SLIVER, a, b, { 0, 0 }, F_Cu );
+    std::unique_ptr<PCB_MARKER> sliverB = makeMarker( DRCE_COPPER_SLIVER, a, b, { 0, 0 }, B_Cu );
+
+    BOOST_CHECK( clearanceF->GetViolationId() == clearanceB->GetViolationId() );
+    BOOST_CHECK( !( sliverF->GetViolationId() == sliverB->GetViolationId() ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
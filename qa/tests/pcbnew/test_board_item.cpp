@@ -307,4 +307,62 @@ BOOST_AUTO_TEST_CASE( FlipUpDown )
 }
 
 
+BOOST_AUTO_TEST_CASE( GetItemById )
+{
+    BOARD board;
+
+    PCB_TRACK* track = new PCB_TRACK( &board );
+    board.Add( track );
+
+    FOOTPRINT* footprint = new FOOTPRINT( &board );
+    PAD*       pad = new PAD( footprint );
+    footprint->Add( pad );
+    board.Add( footprint );
+
+    BOOST_CHECK_EQUAL( board.GetItem( track->m_Uuid ), track );
+    BOOST_CHECK_EQUAL( board.GetItem( footprint->m_Uuid ), footprint );
+    BOOST_CHECK_EQUAL( board.GetItem( pad->m_Uuid ), pad );
+
+    // A pad added outside of a commit is not indexed, but is still found
+    PAD* newPad = new PAD( footprint );
+    footprint->Add( newPad );
+    BOOST_CHECK_EQUAL( board.GetItem( newPad->m_Uuid ), newPad );
+
+    footprint->Remove( pad );
+    BOOST_CHECK_EQUAL( board.GetItem( pad->m_Uuid ), DELETED_BOARD_ITEM::GetInstance() );
+    delete pad;
+
+    board.Remove( track );
+    BOOST_CHECK_EQUAL( board.GetItem( track->m_Uuid ), DELETED_BOARD_ITEM::GetInstance() );
+    delete track;
+}
+
+
+BOOST_AUTO_TEST_CASE( NetItems )
+{
+    BOARD         board;
+    NETINFO_ITEM* net = new NETINFO_ITEM( &board, wxT( "Net-1" ), 1 );
+    board.Add( net );
+
+    PCB_TRACK* track = new PCB_TRACK( &board );
+    PCB_VIA*   via = new PCB_VIA( &board );
+    board.Add( track );
+    board.Add( via );
+    track->SetNetCode( 1 );
+    via->SetNetCode( 1 );
+
+    BOOST_CHECK_EQUAL( board.TracksInNet( 1 ).size(), 2 );
+    BOOST_CHECK_EQUAL( board.GetNetItems( 1 ).size(), 2 );
+
+    // Changing the net of an item outdates the index
+    via->SetNetCode( 0 );
+    BOOST_CHECK_EQUAL( board.TracksInNet( 1 ).size(), 1 );
+    BOOST_CHECK_EQUAL( board.TracksInNet( 0 ).size(), 1 );
+
+    board.Remove( track );
+    BOOST_CHECK( board.TracksInNet( 1 ).empty() );
+    delete track;
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
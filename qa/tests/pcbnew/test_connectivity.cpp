@@ -0,0 +1,174 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <core/kicad_algo.h>
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+#include <settings/settings_manager.h>
+
+
+struct CONNECTIVITY_TEST_FIXTURE
+{
+    CONNECTIVITY_TEST_FIXTURE() :
+            m_settingsManager( true /* headless */ )
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+/**
+ * Updating an item which hasn't moved must keep its connectivity item, while moving it must
+ * rebuild it.  Either way the connectivity must end up the same as a full rebuild.
+ */
+BOOST_FIXTURE_TEST_CASE( UpdateKeepsUnchangedItems, CONNECTIVITY_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    connectivity->RecalculateRatsnest();
+
+    unsigned   unconnected = connectivity->GetUnconnectedCount( false );
+    PCB_TRACK* track = nullptr;
+
+    for( PCB_TRACK* candidate : m_board->Tracks() )
+    {
+        if( candidate->Type() == PCB_TRACE_T && candidate->GetNetCode() > 0 )
+        {
+            track = candidate;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( track );
+
+    auto cnItem =
+            [&]()
+            {
+                return connectivity->GetConnectivityAlgo()->ItemEntry( track ).GetItems().front();
+            };
+
+    size_t   connections = connectivity->GetConnectedItems( track, { PCB_TRACE_T, PCB_ARC_T,
+                                                                     PCB_VIA_T, PCB_PAD_T } )
+                                   .size();
+    CN_ITEM* original = cnItem();
+
+    connectivity->Update( track );
+    BOOST_CHECK_EQUAL( cnItem(), original );
+    BOOST_CHECK( !original->Dirty() );
+
+    track->Move( VECTOR2I( pcbIUScale.mmToIU( 50 ), 0 ) );
+    connectivity->Update( track );
+    connectivity->RecalculateRatsnest();
+
+    BOOST_CHECK_NE( cnItem(), original );
+
+    track->Move( VECTOR2I( -pcbIUScale.mmToIU( 50 ), 0 ) );
+    connectivity->Update( track );
+    connectivity->RecalculateRatsnest();
+
+    BOOST_CHECK_EQUAL( connectivity->GetUnconnectedCount( false ), unconnected );
+    BOOST_CHECK_EQUAL( connectivity->GetConnectedItems( track, { PCB_TRACE_T, PCB_ARC_T,
+                                                                 PCB_VIA_T, PCB_PAD_T } )
+                               .size(),
+                       connections );
+}
+
+
+/**
+ * The items-by-net index must follow items which change nets, and agree with a scan of every
+ * item on the board.
+ */
+BOOST_FIXTURE_TEST_CASE( NetItemsFollowNetChanges, CONNECTIVITY_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+
+    auto scanNet =
+            [&]( int aNet )
+            {
+                std::vector<BOARD_CONNECTED_ITEM*> items;
+
+                for( PCB_TRACK* track : m_board->Tracks() )
+                {
+                    if( track->GetNetCode() == aNet )
+                        items.push_back( track );
+                }
+
+                for( FOOTPRINT* footprint : m_board->Footprints() )
+                {
+                    for( PAD* pad : footprint->Pads() )
+                    {
+                        if( pad->GetNetCode() == aNet )
+                            items.push_back( pad );
+                    }
+                }
+
+                std::sort( items.begin(), items.end() );
+                return items;
+            };
+
+    auto netItems =
+            [&]( int aNet )
+            {
+                return connectivity->GetNetItems( aNet, { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T,
+                                                          PCB_PAD_T } );
+            };
+
+    PCB_TRACK* track = nullptr;
+
+    for( PCB_TRACK* candidate : m_board->Tracks() )
+    {
+        if( candidate->GetNetCode() > 0 )
+        {
+            track = candidate;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( track );
+
+    int oldNet = track->GetNetCode();
+    int newNet = oldNet == 1 ? 2 : 1;
+
+    BOOST_CHECK( netItems( oldNet ) == scanNet( oldNet ) );
+    BOOST_CHECK( netItems( newNet ) == scanNet( newNet ) );
+
+    track->SetNetCode( newNet );
+    connectivity->Update( track );
+
+    BOOST_CHECK( !alg::contains( netItems( oldNet ), track ) );
+    BOOST_CHECK( alg::contains( netItems( newNet ), track ) );
+    BOOST_CHECK( netItems( oldNet ) == scanNet( oldNet ) );
+    BOOST_CHECK( netItems( newNet ) == scanNet( newNet ) );
+    BOOST_CHECK_EQUAL( connectivity->GetPadCount( newNet ), connectivity->GetNetItems( newNet,
+                                                                 { PCB_PAD_T } ).size() );
+}
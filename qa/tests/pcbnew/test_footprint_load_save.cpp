@@ -21,9 +21,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <filesystem>
+
 #include <board.h>
 #include <kiid.h>
 #include <footprint.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcbnew_utils/board_file_utils.h>
 #include <pcbnew_utils/board_test_utils.h>
 #include <qa_utils/wx_utils/unit_test_utils.h>
@@ -35,6 +38,9 @@ namespace
 struct FOOTPRINT_LOAD_TEST_FIXTURE
 {
     FOOTPRINT_LOAD_TEST_FIXTURE() {}
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
 };
 
 
@@ -98,4 +104,40 @@ BOOST_FIXTURE_TEST_CASE( FootprintLoadSave, FOOTPRINT_LOAD_TEST_FIXTURE )
 
         KI_TEST::LoadAndTestBoardFile( testCase.m_boardFileRelativePath, true, doBoardTest );
     }
-}
\ No newline at end of file
+}
+
+BOOST_FIXTURE_TEST_CASE( LazyFootprintLibrary, FOOTPRINT_LOAD_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "footprints_load_save", m_board );
+
+    std::filesystem::path libPath =
+            std::filesystem::temp_directory_path() / "qa_lazy_footprint_library.pretty";
+    std::filesystem::remove_all( libPath );
+
+    PCB_IO_KICAD_SEXPR io;
+    io.CreateLibrary( libPath.string() );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+        io.FootprintSave( libPath.string(), footprint );
+
+    FP_CACHE cache( &io, libPath.string() );
+    cache.Load();
+
+    BOOST_REQUIRE( !cache.GetFootprints().empty() );
+
+    // Nothing is read before it is asked for
+    for( const auto& footprint : cache.GetFootprints() )
+        BOOST_CHECK( !footprint.second->IsParsed() );
+
+    cache.ParseAll();
+
+    for( const auto& footprint : cache.GetFootprints() )
+    {
+        BOOST_REQUIRE( footprint.second->IsParsed() );
+        BOOST_REQUIRE( footprint.second->GetFootprint() );
+        BOOST_CHECK( footprint.second->GetFootprint()->GetFPID().GetLibItemName().wx_str()
+                     == footprint.first );
+    }
+
+    std::filesystem::remove_all( libPath );
+}
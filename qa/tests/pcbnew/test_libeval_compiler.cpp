@@ -82,7 +82,12 @@ const static std::vector<EXPR_TO_TEST> introspectionExpressions = {
     { "A.Netclass + 1.0", false, VAL( 1.0 ) },
     { "A.type == 'Track' && B.type == 'Track' && A.layer == 'F.Cu'", false, VAL( 1.0 ) },
     { "(A.type == 'Track') && (B.type == 'Track') && (A.layer == 'F.Cu')", false, VAL( 1.0 ) },
-    { "A.type == 'Via' && A.isMicroVia()", false, VAL(0.0) }
+    { "A.type == 'Via' && A.isMicroVia()", false, VAL(0.0) },
+    // Short-circuited boolean operators, and comparisons compiled to a single operation
+    { "A.Netclass == 'H*' || B.Netclass == 'HV'", false, VAL( 1.0 ) },
+    { "A.Netclass != 'hv' && A.NetName == 'net1'", false, VAL( 0.0 ) },
+    { "B.NetName == 'net?' && !( 2 * 3 == 7 )", false, VAL( 1.0 ) },
+    { "A.type == 'Pad' || A.type != 'Track' || B.Netclass == 'otherClass'", false, VAL( 1.0 ) }
 };
 
 
@@ -181,4 +186,38 @@ BOOST_AUTO_TEST_CASE( IntrospectedProperties )
     }
 }
 
+
+/**
+ * Only expressions reading nets, net classes and types may have their results shared between
+ * item pairs by the DRC engine.
+ */
+BOOST_AUTO_TEST_CASE( NetAndTypeOnlyExpressions )
+{
+    PROPERTY_MANAGER::Instance().Rebuild();
+
+    const std::vector<std::pair<wxString, bool>> expressions = {
+        { "A.NetClass == 'HV' && B.NetClass != 'HV'", true },
+        { "A.NetName == '/VCC' || A.Type == 'Pad'", true },
+        { "A.Type == 'Via' && A.isMicroVia()", true },
+        { "A.inDiffPair('/USB*') && B.isCoupledDiffPair()", true },
+        { "A.Width > B.Width", false },
+        { "A.Type == 'Track' && A.Layer == 'F.Cu'", false },
+        { "A.intersectsArea('zone')", false },
+        { "A.NetClass == 'HV' && A.memberOfFootprint('U1')", false },
+    };
+
+    for( const auto& [ expr, netAndTypeOnly ] : expressions )
+    {
+        PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+        PCBEXPR_UCODE    ucode;
+        PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+        BOOST_TEST_CONTEXT( expr.c_str() )
+        {
+            BOOST_CHECK( compiler.Compile( expr, &ucode, &preflightContext ) );
+            BOOST_CHECK_EQUAL( ucode.ReadsNetAndTypeOnly(), netAndTypeOnly );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
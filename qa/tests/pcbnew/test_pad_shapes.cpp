@@ -0,0 +1,90 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+
+
+struct PAD_SHAPES_FIXTURE
+{
+    PAD_SHAPES_FIXTURE()
+    {
+        m_footprint = new FOOTPRINT( &m_board );
+        m_board.Add( m_footprint );
+
+        for( int ii = 0; ii < 16; ++ii )
+        {
+            PAD* pad = new PAD( m_footprint );
+            pad->SetAttribute( PAD_ATTRIB::SMD );
+            pad->SetLayerSet( PAD::SMDMask() );
+            pad->SetShape( PAD_SHAPE::RECTANGLE );
+            pad->SetSize( VECTOR2I( 1000000, 500000 ) );
+            pad->SetPosition( VECTOR2I( ii * 2000000, 0 ) );
+            m_footprint->Add( pad );
+        }
+    }
+
+    BOARD      m_board;
+    FOOTPRINT* m_footprint;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PadShapes, PAD_SHAPES_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( Prebuild )
+{
+    m_board.PrebuildPadShapes();
+
+    for( PAD* pad : m_footprint->Pads() )
+        BOOST_CHECK( !pad->IsDirty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( InvalidateOnEdit )
+{
+    PAD* pad = m_footprint->Pads().front();
+
+    m_board.PrebuildPadShapes();
+
+    std::shared_ptr<SHAPE>          shape = pad->GetEffectiveShape();
+    std::shared_ptr<SHAPE_POLY_SET> poly = pad->GetEffectivePolygon( ERROR_INSIDE );
+    BOX2I                           bbox = pad->GetBoundingBox();
+
+    pad->SetSize( VECTOR2I( 2000000, 500000 ) );
+    BOOST_CHECK( pad->IsDirty() );
+
+    // The caches held by a reader outlive the edit
+    BOOST_CHECK_EQUAL( shape->BBox().GetWidth(), 1000000 );
+    BOOST_CHECK_EQUAL( poly->BBox().GetWidth(), 1000000 );
+
+    BOOST_CHECK_EQUAL( pad->GetBoundingBox().GetWidth(), 2000000 );
+    BOOST_CHECK_EQUAL( pad->GetEffectivePolygon( ERROR_INSIDE )->BBox().GetWidth(), 2000000 );
+    BOOST_CHECK( pad->GetEffectiveShape() != shape );
+    BOOST_CHECK_EQUAL( bbox.GetWidth(), 1000000 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
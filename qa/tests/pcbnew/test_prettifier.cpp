@@ -140,3 +140,40 @@ BOOST_FIXTURE_TEST_CASE( BoardAndFootprintPrettifier, PRETTIFIER_TEST_FIXTURE )
 
     std::filesystem::remove_all( tempLibPath );
 }
+
+
+BOOST_AUTO_TEST_CASE( PrettifyInParallelMatchesPrettify )
+{
+    std::vector<wxString> cases = {
+        "Reverb_BTDR-1V.kicad_mod",
+        "group_and_image.kicad_pcb"
+    };
+
+    for( const wxString& testCase : cases )
+    {
+        std::string testCaseName = testCase.ToStdString();
+
+        BOOST_TEST_CONTEXT( testCaseName )
+        {
+            std::string inPath = fmt::format( "{}prettifier/{}", KI_TEST::GetPcbnewTestDataDir(),
+                                              testCaseName );
+
+            std::ifstream inFp;
+            inFp.open( inPath );
+            BOOST_REQUIRE( inFp.is_open() );
+
+            std::stringstream inBuf;
+            inBuf << inFp.rdbuf();
+
+            std::string serial = inBuf.str();
+            std::string parallel = serial;
+
+            KICAD_FORMAT::Prettify( serial );
+
+            // Cut after every top level list, which is the hardest case for the joins
+            KICAD_FORMAT::PrettifyInParallel( parallel, '"', 1 );
+
+            BOOST_CHECK( parallel == serial );
+        }
+    }
+}
@@ -27,6 +27,13 @@
 #include <pcbnew_utils/board_test_utils.h>
 #include <pcbnew_utils/board_file_utils.h>
 #include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_snapshot.h>
+#include <richio.h>
 #include <settings/settings_manager.h>
 
 
@@ -64,3 +71,168 @@ BOOST_FIXTURE_TEST_CASE( RegressionSaveLoadTests, SAVE_LOAD_TEST_FIXTURE )
     }
 }
 
+
+BOOST_FIXTURE_TEST_CASE( ParallelLoadMatchesSerialLoad, SAVE_LOAD_TEST_FIXTURE )
+{
+    // Large enough for their footprints, tracks and zones to go to worker parsers
+    std::vector<wxString> tests = { "issue3812",
+                                    "issue8909",
+                                    "zone_filler" };
+
+    auto checkSameItems =
+            []( const auto& aParallel, const auto& aSerial )
+            {
+                BOOST_REQUIRE_EQUAL( aParallel.size(), aSerial.size() );
+
+                for( size_t ii = 0; ii < aParallel.size(); ++ii )
+                {
+                    BOOST_CHECK( aParallel[ii]->m_Uuid == aSerial[ii]->m_Uuid );
+                    BOOST_CHECK_EQUAL( aParallel[ii]->GetNetCode(), aSerial[ii]->GetNetCode() );
+                    BOOST_CHECK_EQUAL( aParallel[ii]->GetPosition(), aSerial[ii]->GetPosition() );
+                }
+            };
+
+    for( const wxString& relPath : tests )
+    {
+        std::string path = KI_TEST::GetPcbnewTestDataDir() + relPath.ToStdString() + ".kicad_pcb";
+
+        BOOST_TEST_CONTEXT( relPath.ToStdString() )
+        {
+            PCB_IO_KICAD_SEXPR     io;
+            std::unique_ptr<BOARD> parallel( io.LoadBoard( path, nullptr ) );
+            std::unique_ptr<BOARD> serial = KI_TEST::ReadBoardFromFileOrStream( path );
+
+            BOOST_REQUIRE( parallel );
+            BOOST_REQUIRE( serial );
+
+            BOOST_CHECK_EQUAL( parallel->GetNetCount(), serial->GetNetCount() );
+            BOOST_CHECK_EQUAL( parallel->Groups().size(), serial->Groups().size() );
+
+            checkSameItems( parallel->Tracks(), serial->Tracks() );
+            checkSameItems( parallel->Zones(), serial->Zones() );
+
+            BOOST_REQUIRE_EQUAL( parallel->Footprints().size(), serial->Footprints().size() );
+
+            for( size_t ii = 0; ii < parallel->Footprints().size(); ++ii )
+            {
+                FOOTPRINT* parallelFp = parallel->Footprints()[ii];
+                FOOTPRINT* serialFp = serial->Footprints()[ii];
+
+                BOOST_CHECK( parallelFp->m_Uuid == serialFp->m_Uuid );
+                BOOST_CHECK_EQUAL( parallelFp->GetPosition(), serialFp->GetPosition() );
+                checkSameItems( parallelFp->Pads(), serialFp->Pads() );
+            }
+        }
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( SnapshotLoadMatchesTextLoad, SAVE_LOAD_TEST_FIXTURE )
+{
+    std::vector<wxString> tests = { "issue8909",
+                                    "bad_triangulation_case" };
+
+    auto savePath = std::filesystem::temp_directory_path() / "snapshot_saveload_tst.kicad_pcb";
+
+    for( const wxString& relPath : tests )
+    {
+        BOOST_TEST_CONTEXT( relPath.ToStdString() )
+        {
+            KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+
+            PCB_IO_KICAD_SEXPR io;
+
+            // Saving writes the snapshot, which has to be the one of the saved file
+            io.SaveBoard( savePath.string(), m_board.get() );
+
+            wxString snapshotFile = BOARD_SNAPSHOT::FileName( savePath.string() );
+            std::string text;
+
+            {
+                MAPPED_FILE_LINE_READER reader( savePath.string() );
+                text = reader.Contents();
+            }
+
+            BOARD_SNAPSHOT snapshot;
+
+            BOOST_REQUIRE( snapshot.Open( snapshotFile, text ) );
+            BOOST_CHECK( !snapshot.Open( snapshotFile, text + "\n" ) );
+
+            std::unique_ptr<BOARD> restored( io.LoadBoard( savePath.string(), nullptr ) );
+
+            BOOST_REQUIRE( restored );
+            BOOST_REQUIRE_EQUAL( restored->Zones().size(), m_board->Zones().size() );
+
+            for( size_t ii = 0; ii < m_board->Zones().size(); ++ii )
+            {
+                ZONE* original = m_board->Zones()[ii];
+                ZONE* zone = restored->Zones()[ii];
+
+                BOOST_CHECK( zone->m_Uuid == original->m_Uuid );
+                BOOST_CHECK_EQUAL( zone->GetFilledArea(), original->GetFilledArea() );
+
+                for( PCB_LAYER_ID layer : original->GetLayerSet().Seq() )
+                {
+                    const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+                    const std::shared_ptr<SHAPE_POLY_SET>& originalFill =
+                            original->GetFilledPolysList( layer );
+
+                    BOOST_REQUIRE_EQUAL( fill->OutlineCount(), originalFill->OutlineCount() );
+                    BOOST_CHECK( fill->GetHash() == originalFill->GetHash() );
+
+                    for( int jj = 0; jj < fill->OutlineCount(); ++jj )
+                    {
+                        BOOST_CHECK_EQUAL( zone->IsIsland( layer, jj ),
+                                           original->IsIsland( layer, jj ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( IncrementalSaveMatchesFullSave, SAVE_LOAD_TEST_FIXTURE )
+{
+    auto savePath = std::filesystem::temp_directory_path() / "incremental_saveload_tst.kicad_pcb";
+
+    auto saveText =
+            [&]() -> std::string
+            {
+                PCB_IO_KICAD_SEXPR io;
+                io.SaveBoard( savePath.string(), m_board.get() );
+
+                MAPPED_FILE_LINE_READER reader( savePath.string() );
+                return std::string( reader.Contents() );
+            };
+
+    KI_TEST::LoadBoard( m_settingsManager, "issue8909", m_board );
+
+    BOOST_REQUIRE( !m_board->Tracks().empty() );
+    BOOST_REQUIRE( !m_board->Footprints().empty() );
+
+    std::string full = saveText();
+
+    m_board->EnableSavedTextCache( true );
+
+    // Once to fill the cache, once from it
+    BOOST_CHECK( saveText() == full );
+    BOOST_CHECK( saveText() == full );
+
+    PCB_TRACK* track = m_board->Tracks().front();
+    FOOTPRINT* footprint = m_board->Footprints().front();
+
+    track->Move( VECTOR2I( 100000, 0 ) );
+    m_board->InvalidateSavedText( track );
+
+    footprint->Pads().front()->SetNumber( wxS( "changed" ) );
+    m_board->InvalidateSavedText( footprint->Pads().front() );
+
+    std::string incremental = saveText();
+
+    BOOST_CHECK( incremental != full );
+
+    m_board->EnableSavedTextCache( false );
+
+    BOOST_CHECK( saveText() == incremental );
+}
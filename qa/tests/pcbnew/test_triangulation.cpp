@@ -110,3 +110,51 @@ BOOST_FIXTURE_TEST_CASE( RegressionTriangulationTests, TRIANGULATE_TEST_FIXTURE
     }
 }
 
+
+
+BOOST_FIXTURE_TEST_CASE( ZoneFillProxies, TRIANGULATE_TEST_FIXTURE )
+{
+    std::vector<wxString> tests = { "issue5313", "issue7086", "issue14294" };
+
+    for( const wxString& relPath : tests )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, relPath, m_board );
+
+        for( ZONE* zone : m_board->Zones() )
+        {
+            if( zone->GetIsRuleArea() )
+                continue;
+
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            {
+                const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+                std::shared_ptr<SHAPE_POLY_SET>        proxy = zone->GetFillProxy( layer );
+
+                if( fill->FullPointCount() < ZONE::FILL_PROXY_MIN_POINTS )
+                {
+                    BOOST_CHECK( !proxy );
+                    continue;
+                }
+
+                BOOST_REQUIRE( proxy );
+                BOOST_CHECK( proxy->IsTriangulationUpToDate() );
+                BOOST_CHECK_LE( proxy->FullPointCount(), fill->FullPointCount() );
+
+                // The proxy is kept until the fill changes
+                BOOST_CHECK( zone->GetFillProxy( layer ) == proxy );
+
+                // Each outline moves by at most the max error, so the area can't change by more
+                // than that times their length
+                double perimeter = 0.0;
+
+                for( int ii = 0; ii < fill->OutlineCount(); ii++ )
+                    perimeter += fill->COutline( ii ).Length();
+
+                BOOST_CHECK_MESSAGE( std::abs( fill->Area() - proxy->Area() )
+                                             <= perimeter * ZONE::FILL_PROXY_MAX_ERROR,
+                                     "Fill proxy area mismatch in " + relPath + " layer "
+                                             + LayerName( layer ) );
+            }
+        }
+    }
+}
@@ -29,6 +29,7 @@
 #include <pcb_track.h>
 #include <footprint.h>
 #include <zone.h>
+#include <zone_filler.h>
 #include <drc/drc_item.h>
 #include <settings/settings_manager.h>
 
@@ -299,3 +300,315 @@ BOOST_FIXTURE_TEST_CASE( RegressionTeardropFill, ZONE_FILL_TEST_FIXTURE )
     }
 }
 
+
+
+BOOST_FIXTURE_TEST_CASE( RegionZoneRefill, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    // Region refills need a full fill first (which records the islands it removed)
+    KI_TEST::FillZones( m_board.get() );
+
+    PCB_TRACK* track = nullptr;
+
+    for( PCB_TRACK* candidate : m_board->Tracks() )
+    {
+        if( candidate->Type() == PCB_TRACE_T )
+        {
+            track = candidate;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( track );
+
+    BOX2I dirtyArea = track->GetBoundingBox();
+    track->Move( VECTOR2I( delta * 5, delta * 5 ) );
+    dirtyArea.Merge( track->GetBoundingBox() );
+
+    std::vector<ZONE*>                 toFill;
+    std::map<KIID, std::vector<BOX2I>> dirtyAreas;
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        toFill.push_back( zone );
+
+        if( zone->GetBoundingBox().Intersects( dirtyArea ) )
+            dirtyAreas[ zone->m_Uuid ].push_back( dirtyArea );
+    }
+
+    ZONE_FILLER regionFiller( m_board.get(), nullptr );
+    regionFiller.SetDirtyAreas( dirtyAreas );
+    BOOST_REQUIRE( regionFiller.Fill( toFill ) );
+
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET> regionFills;
+
+    for( ZONE* zone : toFill )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            regionFills[ { zone, layer } ] = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+    }
+
+    // Forget the fills so that they are rebuilt from scratch
+    for( ZONE* zone : toFill )
+        zone->UnFill();
+
+    ZONE_FILLER fullFiller( m_board.get(), nullptr );
+    BOOST_REQUIRE( fullFiller.Fill( toFill ) );
+
+    // The patched fill must match a fill from scratch (give or take some rounding at the seams)
+    double tolerance = pcbIUScale.mmToIU( 1.0 ) * (double) pcbIUScale.mmToIU( 0.1 );
+
+    for( const auto& [ key, regionFill ] : regionFills )
+    {
+        const SHAPE_POLY_SET& fullFill = *key.first->GetFilledPolysList( key.second );
+        SHAPE_POLY_SET        missing;
+        SHAPE_POLY_SET        extra;
+
+        missing.BooleanSubtract( fullFill, regionFill, SHAPE_POLY_SET::PM_FAST );
+        extra.BooleanSubtract( regionFill, fullFill, SHAPE_POLY_SET::PM_FAST );
+
+        BOOST_CHECK_SMALL( missing.Area() + extra.Area(), tolerance );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( KnockoutCacheRefill, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    std::shared_ptr<ZONE_KNOCKOUT_CACHE> cache = std::make_shared<ZONE_KNOCKOUT_CACHE>();
+    std::vector<ZONE*>                   toFill;
+
+    for( ZONE* zone : m_board->Zones() )
+        toFill.push_back( zone );
+
+    ZONE_FILLER firstFiller( m_board.get(), nullptr );
+    firstFiller.SetKnockoutCache( cache );
+    BOOST_REQUIRE( firstFiller.Fill( toFill ) );
+
+    BOOST_CHECK_GT( cache->GetMissCount(), 0 );
+
+    // Move a track without telling the cache; its stale entry must not be used
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->Type() == PCB_TRACE_T )
+        {
+            track->Move( VECTOR2I( pcbIUScale.mmToIU( 0.5 ), 0 ) );
+            break;
+        }
+    }
+
+    size_t hits = cache->GetHitCount();
+
+    // Forget the fills so that they are rebuilt from scratch
+    for( ZONE* zone : toFill )
+        zone->UnFill();
+
+    ZONE_FILLER cachedFiller( m_board.get(), nullptr );
+    cachedFiller.SetKnockoutCache( cache );
+    BOOST_REQUIRE( cachedFiller.Fill( toFill ) );
+
+    BOOST_CHECK_GT( cache->GetHitCount(), hits );
+
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET> cachedFills;
+
+    for( ZONE* zone : toFill )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            cachedFills[ { zone, layer } ] = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+    }
+
+    for( ZONE* zone : toFill )
+        zone->UnFill();
+
+    ZONE_FILLER freshFiller( m_board.get(), nullptr );
+    BOOST_REQUIRE( freshFiller.Fill( toFill ) );
+
+    for( const auto& [ key, cachedFill ] : cachedFills )
+    {
+        const SHAPE_POLY_SET& freshFill = *key.first->GetFilledPolysList( key.second );
+        SHAPE_POLY_SET        diff;
+
+        diff.BooleanXor( freshFill, cachedFill, SHAPE_POLY_SET::PM_FAST );
+
+        BOOST_CHECK_EQUAL( diff.Area(), 0.0 );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( FillInputHashes, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    std::vector<ZONE*>                                toFill;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, size_t> hashes;
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        toFill.push_back( zone );
+
+        if( zone->GetIsRuleArea() )
+            continue;
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            BOOST_CHECK_NE( zone->GetFillInputHash( layer ), 0 );
+            hashes[ { zone, layer } ] = zone->GetFillInputHash( layer );
+        }
+    }
+
+    // Nothing has changed, so nothing should be refilled
+    ZONE_FILLER filler( m_board.get(), nullptr );
+    BOOST_REQUIRE( filler.Fill( toFill ) );
+
+    for( const auto& [ key, hash ] : hashes )
+        BOOST_CHECK_EQUAL( key.first->GetFillInputHash( key.second ), hash );
+
+    PCB_TRACK* track = nullptr;
+
+    for( PCB_TRACK* candidate : m_board->Tracks() )
+    {
+        if( candidate->Type() == PCB_TRACE_T )
+        {
+            track = candidate;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( track );
+    track->Move( VECTOR2I( pcbIUScale.mmToIU( 0.5 ), 0 ) );
+
+    ZONE_FILLER refiller( m_board.get(), nullptr );
+    BOOST_REQUIRE( refiller.Fill( toFill ) );
+
+    bool anyChanged = false;
+
+    for( const auto& [ key, hash ] : hashes )
+    {
+        if( key.first->GetFillInputHash( key.second ) != hash )
+            anyChanged = true;
+    }
+
+    BOOST_CHECK( anyChanged );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( HatchedZoneFill, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    std::vector<ZONE*>                                       toFill;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET> solidFills;
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( zone->GetIsRuleArea() || zone->IsTeardropArea() )
+            continue;
+
+        toFill.push_back( zone );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            solidFills[ { zone, layer } ] = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+
+        zone->SetFillMode( ZONE_FILL_MODE::HATCH_PATTERN );
+        zone->SetHatchThickness( pcbIUScale.mmToIU( 0.3 ) );
+        zone->SetHatchGap( pcbIUScale.mmToIU( 0.5 ) );
+        zone->SetHatchOrientation( ANGLE_45 );
+        zone->UnFill();
+    }
+
+    std::shared_ptr<ZONE_KNOCKOUT_CACHE> cache = std::make_shared<ZONE_KNOCKOUT_CACHE>();
+
+    ZONE_FILLER filler( m_board.get(), nullptr );
+    filler.SetKnockoutCache( cache );
+    BOOST_REQUIRE( filler.Fill( toFill ) );
+
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET> hatchedFills;
+
+    for( const auto& [ key, solidFill ] : solidFills )
+    {
+        SHAPE_POLY_SET hatchedFill = key.first->GetFilledPolysList( key.second )->CloneDropTriangulation();
+        SHAPE_POLY_SET extra;
+
+        // Hatching may only ever remove copper
+        extra.BooleanSubtract( hatchedFill, solidFill, SHAPE_POLY_SET::PM_FAST );
+        BOOST_CHECK_SMALL( extra.Area(), 1.0e6 );
+
+        if( solidFill.Area() > 0 )
+            BOOST_CHECK_LT( hatchedFill.Area(), solidFill.Area() );
+
+        hatchedFills[ key ] = hatchedFill;
+    }
+
+    // Refilling from scratch must reuse the cached hatching and give the same result
+    for( ZONE* zone : toFill )
+        zone->UnFill();
+
+    ZONE_FILLER cachedFiller( m_board.get(), nullptr );
+    cachedFiller.SetKnockoutCache( cache );
+    BOOST_REQUIRE( cachedFiller.Fill( toFill ) );
+
+    for( const auto& [ key, hatchedFill ] : hatchedFills )
+    {
+        SHAPE_POLY_SET diff;
+
+        diff.BooleanXor( *key.first->GetFilledPolysList( key.second ), hatchedFill,
+                         SHAPE_POLY_SET::PM_FAST );
+
+        BOOST_CHECK_EQUAL( diff.Area(), 0.0 );
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE( ZoneCopiesShareFills, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    ZONE* zone = nullptr;
+
+    for( ZONE* candidate : m_board->Zones() )
+    {
+        PCB_LAYER_ID layer = candidate->GetFirstLayer();
+
+        if( !candidate->GetIsRuleArea() && !candidate->GetFilledPolysList( layer )->IsEmpty() )
+        {
+            zone = candidate;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( zone );
+
+    auto makeCopy =
+            [&]()
+            {
+                std::unique_ptr<ZONE> copy( static_cast<ZONE*>( zone->Clone() ) );
+                copy->SetParentGroup( nullptr );
+                return copy;
+            };
+
+    PCB_LAYER_ID          layer = zone->GetFirstLayer();
+    std::unique_ptr<ZONE> copy = makeCopy();
+
+    // Copies share their fill until one of them changes it
+    BOOST_CHECK_EQUAL( copy->GetFilledPolysList( layer ), zone->GetFilledPolysList( layer ) );
+
+    VECTOR2I originalPt = zone->GetFilledPolysList( layer )->CVertex( 0 );
+    VECTOR2I offset( pcbIUScale.mmToIU( 1 ), 0 );
+
+    copy->Move( offset );
+
+    BOOST_CHECK_NE( copy->GetFilledPolysList( layer ), zone->GetFilledPolysList( layer ) );
+    BOOST_CHECK_EQUAL( zone->GetFilledPolysList( layer )->CVertex( 0 ), originalPt );
+    BOOST_CHECK_EQUAL( copy->GetFilledPolysList( layer )->CVertex( 0 ), originalPt + offset );
+
+    std::unique_ptr<ZONE> copy2 = makeCopy();
+
+    zone->UnFill();
+
+    BOOST_CHECK( zone->GetFilledPolysList( layer )->IsEmpty() );
+    BOOST_CHECK_EQUAL( copy2->GetFilledPolysList( layer )->CVertex( 0 ), originalPt );
+}
@@ -0,0 +1,329 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+#include <qa_utils/io_bench.h>
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <connection_graph.h>
+#include <lib_symbol.h>
+#include <lib_table_lexer.h>
+#include <locale_io.h>
+#include <pgm_base.h>
+#include <project.h>
+#include <richio.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_cache.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <schematic.h>
+#include <schematic_lexer.h>
+#include <settings/settings_manager.h>
+#include <symbol_lib_table.h>
+
+
+/**
+ * Files from the QA data directory which are used when no files are given.
+ */
+static const std::vector<std::string> DEFAULT_CORPUS = {
+    "spice_netlists/instance_params/instance_params.kicad_sch",
+    "netlists/video/video.kicad_sch",
+    "netlists/complex_hierarchy/complex_hierarchy.kicad_sch",
+    "spice_netlists/legacy_sources/v_i_sources.kicad_sym",
+    "spice_netlists/legacy_pspice/schematic_libspice.kicad_sym",
+    "netlists/complex_hierarchy/sym-lib-table",
+};
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "repeat", _( "number of runs per file" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input files" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum SCH_IO_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    UNKNOWN_FORMAT
+};
+
+
+static void benchSchematic( KI_TEST::IO_BENCH_RESULT& aResult, const wxString& aPath,
+                            const std::string& aText )
+{
+    SETTINGS_MANAGER& manager = Pgm().GetSettingsManager();
+    wxFileName        projectFile( aPath );
+
+    projectFile.SetExt( wxT( "kicad_pro" ) );
+    manager.LoadProject( projectFile.FileExists() ? projectFile.GetFullPath() : wxString() );
+
+    std::unique_ptr<SCHEMATIC> schematic = std::make_unique<SCHEMATIC>( &manager.Prj() );
+
+    aResult.Measure( "lex",
+            [&]()
+            {
+                aResult.SetTokenCount( KI_TEST::CountTokens<SCHEMATIC_LEXER>( aText, aPath ) );
+            } );
+
+    // The s-expression parser builds the schematic items as it parses them, so this is
+    // parsing and building the items of the whole hierarchy.
+    aResult.Measure( "load",
+            [&]()
+            {
+                SCH_IO_KICAD_SEXPR io;
+                schematic->SetRoot( io.LoadSchematicFile( aPath, schematic.get() ) );
+            } );
+
+    SCH_SCREENS screens( schematic->Root() );
+    size_t      itemCount = 0;
+
+    for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+        itemCount += screen->Items().size();
+
+    aResult.SetItemCount( itemCount );
+
+    SCH_SHEET_LIST sheets = schematic->GetSheets();
+
+    // What the schematic editor does with a schematic once it is read
+    aResult.Measure( "build",
+            [&]()
+            {
+                for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+                    screen->UpdateLocalLibSymbolLinks();
+
+                sheets.UpdateSheetInstanceData( schematic->RootScreen()->GetSheetInstances() );
+                sheets.AnnotatePowerSymbols();
+
+                for( SCH_SHEET_PATH& sheet : sheets )
+                    sheet.UpdateAllScreenReferences();
+            } );
+
+    aResult.Measure( "connectivity",
+            [&]()
+            {
+                schematic->ConnectionGraph()->Recalculate( sheets, true );
+            } );
+
+    wxString savePath = wxFileName::CreateTempFileName( wxT( "qa_sch_io_bench" ) );
+
+    aResult.Measure( "save",
+            [&]()
+            {
+                SCH_IO_KICAD_SEXPR io;
+                io.SaveSchematicFile( savePath, &schematic->Root(), schematic.get() );
+            } );
+
+    wxRemoveFile( savePath );
+
+    schematic->SetProject( nullptr );
+    schematic.reset();
+    manager.UnloadProject( &manager.Prj(), false );
+}
+
+
+static void benchSymbolLibrary( KI_TEST::IO_BENCH_RESULT& aResult, const wxString& aPath,
+                                const std::string& aText )
+{
+    SCH_IO_KICAD_SEXPR_LIB_CACHE cache( aPath );
+
+    aResult.Measure( "lex",
+            [&]()
+            {
+                aResult.SetTokenCount( KI_TEST::CountTokens<SCHEMATIC_LEXER>( aText, aPath ) );
+            } );
+
+    // Opening the library only finds its symbols, unless lazy symbol libraries are off
+    aResult.Measure( "index",
+            [&]()
+            {
+                cache.Load();
+            } );
+
+    aResult.Measure( "load",
+            [&]()
+            {
+                cache.ParseAll();
+            } );
+
+    aResult.SetItemCount( cache.GetSymbolMap().size() );
+
+    aResult.Measure( "save",
+            [&]()
+            {
+                LOCALE_IO        toggle;
+                STRING_FORMATTER formatter;
+
+                for( const auto& [name, symbol] : cache.GetSymbolMap() )
+                    SCH_IO_KICAD_SEXPR_LIB_CACHE::SaveSymbol( symbol, formatter, 1 );
+            } );
+}
+
+
+static void benchSymLibTable( KI_TEST::IO_BENCH_RESULT& aResult, const wxString& aPath,
+                              const std::string& aText )
+{
+    SYMBOL_LIB_TABLE table;
+
+    aResult.Measure( "lex",
+            [&]()
+            {
+                aResult.SetTokenCount( KI_TEST::CountTokens<LIB_TABLE_LEXER>( aText, aPath ) );
+            } );
+
+    aResult.Measure( "load",
+            [&]()
+            {
+                LIB_TABLE_LEXER lexer( aText, aPath );
+                table.Parse( &lexer );
+            } );
+
+    aResult.SetItemCount( table.GetLogicalLibs().size() );
+
+    aResult.Measure( "save",
+            [&]()
+            {
+                STRING_FORMATTER formatter;
+                table.Format( &formatter, 0 );
+            } );
+}
+
+
+int sch_io_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program loads and saves the given schematic, symbol "
+                               "library and symbol library table files (or a corpus of QA "
+                               "files), and prints the time, throughput, allocations and peak "
+                               "memory of each phase as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long repeat = 1;
+
+    cl_parser.Found( "repeat", &repeat );
+    repeat = std::max( 1L, repeat );
+
+    std::vector<wxString> paths;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ii++ )
+        paths.push_back( cl_parser.GetParam( ii ) );
+
+    if( paths.empty() )
+    {
+        for( const std::string& name : DEFAULT_CORPUS )
+            paths.push_back( KI_TEST::GetEeschemaTestDataDir() + name );
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+
+    for( const wxString& path : paths )
+    {
+        wxFileName  fileName( path );
+        std::string format = fileName.GetExt().ToStdString();
+
+        std::function<void( KI_TEST::IO_BENCH_RESULT&, const wxString&, const std::string& )>
+                bench;
+
+        if( format == "kicad_sch" )
+        {
+            bench = benchSchematic;
+        }
+        else if( format == "kicad_sym" )
+        {
+            bench = benchSymbolLibrary;
+        }
+        else if( fileName.GetFullName() == wxT( "sym-lib-table" ) )
+        {
+            format = "sym-lib-table";
+            bench = benchSymLibTable;
+        }
+
+        if( !bench )
+        {
+            std::cerr << "Unknown file format: " << path.ToStdString() << std::endl;
+            return SCH_IO_BENCH_RET_CODES::UNKNOWN_FORMAT;
+        }
+
+        fileName.MakeAbsolute();
+
+        for( long run = 0; run < repeat; run++ )
+        {
+            try
+            {
+                KI_TEST::IO_BENCH_RESULT result( fileName.GetFullName().ToStdString(), format );
+                std::string              text;
+
+                result.Measure( "read",
+                        [&]()
+                        {
+                            text = KI_TEST::ReadFileContents( path.ToStdString() );
+                        } );
+
+                result.SetByteCount( text.size() );
+                bench( result, fileName.GetFullPath(), text );
+
+                nlohmann::json json = result.ToJson();
+                json["run"] = run;
+                results.push_back( json );
+            }
+            catch( const IO_ERROR& e )
+            {
+                std::cerr << "Failed to load " << path.ToStdString() << ": "
+                          << e.What().ToStdString() << std::endl;
+                return SCH_IO_BENCH_RET_CODES::LOAD_FAILED;
+            }
+        }
+    }
+
+    std::cout << results.dump( 2 ) << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "sch_io_bench",
+                                                       "Benchmark loading and saving eeschema "
+                                                       "files",
+                                                       sch_io_bench_main_func } );
@@ -0,0 +1,171 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <connectivity/connectivity_data.h>
+#include <core/profile.h>
+
+
+/**
+ * Boards from the QA data directory which are used when no files are given.
+ */
+static const std::vector<std::string> DEFAULT_CORPUS = {
+    "zone_filler",
+    "issue5830",
+    "issue7086",
+    "issue14294",
+    "issue16182",
+};
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "repeat", _( "number of builds per board" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input boards" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum CONNECTIVITY_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    BUILD_FAILED
+};
+
+
+static nlohmann::json statsToJson( const CN_STATS& aStats )
+{
+    nlohmann::json stats;
+
+    stats["items_built"] = aStats.m_itemsBuilt.load();
+    stats["items_searched"] = aStats.m_itemsSearched.load();
+    stats["candidates_tested"] = aStats.m_candidatesTested.load();
+    stats["cluster_searches"] = aStats.m_clusterSearches.load();
+    stats["cluster_items"] = aStats.m_clusterItems.load();
+    stats["ratsnest_nets"] = aStats.m_ratsnestNets.load();
+    stats["phases_ms"]["build"] = aStats.m_buildTime / 1000.0;
+    stats["phases_ms"]["search"] = aStats.m_searchTime / 1000.0;
+    stats["phases_ms"]["clusters"] = aStats.m_clusterTime / 1000.0;
+    stats["phases_ms"]["ratsnest"] = aStats.m_ratsnestTime / 1000.0;
+    stats["phases_ms"]["optimize"] = aStats.m_optimizeTime / 1000.0;
+
+    return stats;
+}
+
+
+int connectivity_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program builds the connectivity and ratsnest of the given "
+                               "boards (or of a corpus of QA boards), and prints the "
+                               "connectivity profiling counters as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long repeat = 3;
+
+    cl_parser.Found( "repeat", &repeat );
+    repeat = std::max( 1L, repeat );
+
+    std::vector<wxString> boardPaths;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ii++ )
+        boardPaths.push_back( cl_parser.GetParam( ii ) );
+
+    if( boardPaths.empty() )
+    {
+        for( const std::string& name : DEFAULT_CORPUS )
+            boardPaths.push_back( KI_TEST::GetPcbnewTestDataDir() + name + ".kicad_pcb" );
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+
+    for( const wxString& boardPath : boardPaths )
+    {
+        std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+                std::string( boardPath.ToUTF8() ) );
+
+        if( !board )
+        {
+            std::cerr << "Failed to load " << boardPath.ToStdString() << std::endl;
+            return CONNECTIVITY_BENCH_RET_CODES::LOAD_FAILED;
+        }
+
+        board->BuildListOfNets();
+
+        for( long run = 0; run < repeat; run++ )
+        {
+            std::shared_ptr<CONNECTIVITY_DATA> connectivity = board->GetConnectivity();
+            PROF_TIMER                         timer;
+
+            connectivity->Stats().Reset();
+
+            if( !board->BuildConnectivity() )
+                return CONNECTIVITY_BENCH_RET_CODES::BUILD_FAILED;
+
+            connectivity->RecalculateRatsnest();
+
+            nlohmann::json result = statsToJson( connectivity->Stats() );
+
+            result["board"] = wxFileName( boardPath ).GetName().ToStdString();
+            result["run"] = run;
+            result["unconnected"] = connectivity->GetUnconnectedCount( false );
+            result["total_ms"] = timer.msecs();
+
+            results.push_back( result );
+        }
+    }
+
+    std::cout << results.dump( 2 ) << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "connectivity_bench",
+                                                       "Benchmark the connectivity and ratsnest",
+                                                       connectivity_bench_main_func } );
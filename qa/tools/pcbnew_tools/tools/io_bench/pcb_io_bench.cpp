@@ -0,0 +1,342 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+#include <qa_utils/io_bench.h>
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <board.h>
+#include <connectivity/connectivity_data.h>
+#include <drc/drc_rule.h>
+#include <drc/drc_rule_parser.h>
+#include <footprint.h>
+#include <fp_lib_table.h>
+#include <lib_table_lexer.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_snapshot.h>
+#include <pcb_lexer.h>
+#include <reporter.h>
+#include <richio.h>
+
+
+/**
+ * Files from the QA data directories which are used when no files are given.
+ */
+static const std::vector<std::string> DEFAULT_PCBNEW_CORPUS = {
+    "issue8909.kicad_pcb",
+    "issue5093.kicad_pcb",
+    "zone_filler.kicad_pcb",
+    "prettifier/Reverb_BTDR-1V.kicad_mod",
+    "prettifier/Samtec_HLE-133-02-xx-DV-PE-LC_2x33_P2.54mm_Horizontal.kicad_mod",
+    "issue11814.kicad_dru",
+    "connection_width_rules.kicad_dru",
+};
+
+static const std::vector<std::string> DEFAULT_EESCHEMA_CORPUS = {
+    "netlists/complex_hierarchy/fp-lib-table",
+};
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "repeat", _( "number of runs per file" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input files" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum PCB_IO_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    UNKNOWN_FORMAT
+};
+
+
+static size_t countItems( const BOARD& aBoard )
+{
+    size_t count = aBoard.Tracks().size() + aBoard.Drawings().size() + aBoard.Zones().size();
+
+    for( const FOOTPRINT* footprint : aBoard.Footprints() )
+        count += 1 + footprint->Pads().size() + footprint->GraphicalItems().size();
+
+    return count;
+}
+
+
+static void benchBoard( KI_TEST::IO_BENCH_RESULT& aResult, const wxString& aPath,
+                        const std::string& aText )
+{
+    std::unique_ptr<BOARD> board;
+
+    aResult.Measure( "lex",
+            [&]()
+            {
+                aResult.SetTokenCount( KI_TEST::CountTokens<PCB_LEXER>( aText, aPath ) );
+            } );
+
+    // The s-expression parser builds the board items as it parses them, so there is no
+    // separate build phase.
+    aResult.Measure( "load",
+            [&]()
+            {
+                PCB_IO_KICAD_SEXPR io;
+                board.reset( io.LoadBoard( aPath, nullptr ) );
+            } );
+
+    aResult.SetItemCount( countItems( *board ) );
+
+    aResult.Measure( "connectivity",
+            [&]()
+            {
+                board->BuildListOfNets();
+                board->BuildConnectivity();
+            } );
+
+    aResult.Measure( "ratsnest",
+            [&]()
+            {
+                board->GetConnectivity()->RecalculateRatsnest();
+            } );
+
+    wxString savePath = wxFileName::CreateTempFileName( wxT( "qa_pcb_io_bench" ) );
+
+    aResult.Measure( "save",
+            [&]()
+            {
+                PCB_IO_KICAD_SEXPR io;
+                io.SaveBoard( savePath, board.get() );
+            } );
+
+    wxRemoveFile( savePath );
+    wxRemoveFile( BOARD_SNAPSHOT::FileName( savePath ) );
+}
+
+
+static void benchFootprint( KI_TEST::IO_BENCH_RESULT& aResult, const wxString& aPath,
+                            const std::string& aText )
+{
+    std::unique_ptr<FOOTPRINT> footprint;
+
+    aResult.Measure( "lex",
+            [&]()
+            {
+                aResult.SetTokenCount( KI_TEST::CountTokens<PCB_LEXER>( aText, aPath ) );
+            } );
+
+    aResult.Measure( "load",
+            [&]()
+            {
+                PCB_IO_KICAD_SEXPR io( CTL_FOR_LIBRARY );
+                wxString           name;
+                footprint.reset( io.ImportFootprint( aPath, name ) );
+            } );
+
+    if( !footprint )
+        THROW_IO_ERROR( wxString::Format( wxT( "'%s' holds no footprint." ), aPath ) );
+
+    aResult.SetItemCount( 1 + footprint->Pads().size() + footprint->GraphicalItems().size() );
+
+    aResult.Measure( "save",
+            [&]()
+            {
+                PCB_IO_KICAD_SEXPR io( CTL_FOR_LIBRARY );
+                io.Format( footprint.get() );
+                io.GetStringOutput( true );
+            } );
+}
+
+
+static void benchFpLibTable( KI_TEST::IO_BENCH_RESULT& aResult, const wxString& aPath,
+                             const std::string& aText )
+{
+    FP_LIB_TABLE table;
+
+    aResult.Measure( "lex",
+            [&]()
+            {
+                aResult.SetTokenCount( KI_TEST::CountTokens<LIB_TABLE_LEXER>( aText, aPath ) );
+            } );
+
+    aResult.Measure( "load",
+            [&]()
+            {
+                LIB_TABLE_LEXER lexer( aText, aPath );
+                table.Parse( &lexer );
+            } );
+
+    aResult.SetItemCount( table.GetLogicalLibs().size() );
+
+    aResult.Measure( "save",
+            [&]()
+            {
+                STRING_FORMATTER formatter;
+                table.Format( &formatter, 0 );
+            } );
+}
+
+
+static void benchDrcRules( KI_TEST::IO_BENCH_RESULT& aResult, const wxString& aPath,
+                           const std::string& aText )
+{
+    std::vector<std::shared_ptr<DRC_RULE>> rules;
+
+    aResult.Measure( "lex",
+            [&]()
+            {
+                aResult.SetTokenCount( KI_TEST::CountTokens<DRC_RULES_LEXER>( aText, aPath ) );
+            } );
+
+    // Rules are written by hand, there is nothing to save them with.
+    aResult.Measure( "load",
+            [&]()
+            {
+                DRC_RULES_PARSER parser( wxString::FromUTF8( aText ), aPath );
+                parser.Parse( rules, &NULL_REPORTER::GetInstance() );
+            } );
+
+    aResult.SetItemCount( rules.size() );
+}
+
+
+int pcb_io_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program loads and saves the given board, footprint, "
+                               "footprint library table and DRC rule files (or a corpus of QA "
+                               "files), and prints the time, throughput, allocations and peak "
+                               "memory of each phase as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long repeat = 1;
+
+    cl_parser.Found( "repeat", &repeat );
+    repeat = std::max( 1L, repeat );
+
+    std::vector<wxString> paths;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ii++ )
+        paths.push_back( cl_parser.GetParam( ii ) );
+
+    if( paths.empty() )
+    {
+        for( const std::string& name : DEFAULT_PCBNEW_CORPUS )
+            paths.push_back( KI_TEST::GetPcbnewTestDataDir() + name );
+
+        for( const std::string& name : DEFAULT_EESCHEMA_CORPUS )
+            paths.push_back( KI_TEST::GetEeschemaTestDataDir() + name );
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+
+    for( const wxString& path : paths )
+    {
+        wxFileName  fileName( path );
+        std::string format = fileName.GetExt().ToStdString();
+
+        std::function<void( KI_TEST::IO_BENCH_RESULT&, const wxString&, const std::string& )>
+                bench;
+
+        if( format == "kicad_pcb" )
+        {
+            bench = benchBoard;
+        }
+        else if( format == "kicad_mod" )
+        {
+            bench = benchFootprint;
+        }
+        else if( fileName.GetFullName() == wxT( "fp-lib-table" ) )
+        {
+            format = "fp-lib-table";
+            bench = benchFpLibTable;
+        }
+        else if( format == "kicad_dru" )
+        {
+            bench = benchDrcRules;
+        }
+
+        if( !bench )
+        {
+            std::cerr << "Unknown file format: " << path.ToStdString() << std::endl;
+            return PCB_IO_BENCH_RET_CODES::UNKNOWN_FORMAT;
+        }
+
+        for( long run = 0; run < repeat; run++ )
+        {
+            try
+            {
+                KI_TEST::IO_BENCH_RESULT result( fileName.GetFullName().ToStdString(), format );
+                std::string              text;
+
+                result.Measure( "read",
+                        [&]()
+                        {
+                            text = KI_TEST::ReadFileContents( path.ToStdString() );
+                        } );
+
+                result.SetByteCount( text.size() );
+                bench( result, fileName.GetFullPath(), text );
+
+                nlohmann::json json = result.ToJson();
+                json["run"] = run;
+                results.push_back( json );
+            }
+            catch( const IO_ERROR& e )
+            {
+                std::cerr << "Failed to load " << path.ToStdString() << ": "
+                          << e.What().ToStdString() << std::endl;
+                return PCB_IO_BENCH_RET_CODES::LOAD_FAILED;
+            }
+        }
+    }
+
+    std::cout << results.dump( 2 ) << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "pcb_io_bench",
+                                                       "Benchmark loading and saving pcbnew files",
+                                                       pcb_io_bench_main_func } );
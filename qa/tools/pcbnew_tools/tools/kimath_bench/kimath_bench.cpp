@@ -0,0 +1,563 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <core/profile.h>
+#include <footprint.h>
+#include <geometry/seg.h>
+#include <geometry/shape_arc.h>
+#include <geometry/shape_circle.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_rect.h>
+#include <geometry/shape_segment.h>
+#include <math/box2.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <zone.h>
+
+
+/**
+ * Boards from the QA data directory which are measured when no files are given, on top of the
+ * synthetic input.
+ */
+static const std::vector<std::string> DEFAULT_CORPUS = {
+    "zone_filler",
+    "issue5320",
+    "issue16182",
+};
+
+
+static const int MAX_ERROR = 5000;      // The default board max error, in nm
+
+
+/**
+ * The geometry the benchmarks run on, either generated or extracted from a board.
+ */
+struct BENCH_INPUT
+{
+    std::string                         m_name;
+
+    ///< Large fractured regions, such as zone fills
+    std::vector<SHAPE_POLY_SET>         m_regions;
+
+    ///< The same regions with their holes as separate contours
+    std::vector<SHAPE_POLY_SET>         m_unfracturedRegions;
+
+    ///< Small outlines, such as pads and vias, gathered in one set
+    SHAPE_POLY_SET                      m_obstacles;
+
+    std::vector<SEG>                    m_segs;
+    std::vector<std::shared_ptr<SHAPE>> m_shapes;
+    std::vector<BOX2I>                  m_boxes;
+};
+
+
+/**
+ * A benchmark runs once over an input and returns a count of what it did, which is reported
+ * and keeps the compiler from optimising the work away.
+ */
+struct BENCHMARK
+{
+    std::string                                 m_name;
+    std::function<size_t( const BENCH_INPUT& )> m_func;
+};
+
+
+// Caps on the inputs of the quadratic benchmarks, so that big boards stay quick to measure
+static const size_t MAX_PAIRWISE_SEGS = 2000;
+static const size_t MAX_PAIRWISE_SHAPES = 500;
+static const size_t MAX_PAIRWISE_BOXES = 3000;
+
+
+static const std::vector<BENCHMARK> BENCHMARKS = {
+    { "poly_boolean_subtract",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = 0;
+
+          for( const SHAPE_POLY_SET& region : aInput.m_regions )
+          {
+              SHAPE_POLY_SET result = region.CloneDropTriangulation();
+              result.BooleanSubtract( aInput.m_obstacles, SHAPE_POLY_SET::PM_FAST );
+              count += result.FullPointCount();
+          }
+
+          return count;
+      } },
+    { "poly_boolean_union",
+      []( const BENCH_INPUT& aInput )
+      {
+          SHAPE_POLY_SET result = aInput.m_obstacles.CloneDropTriangulation();
+          result.Simplify( SHAPE_POLY_SET::PM_FAST );
+          return (size_t) result.FullPointCount();
+      } },
+    { "poly_boolean_intersection",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = 0;
+
+          for( const SHAPE_POLY_SET& region : aInput.m_regions )
+          {
+              SHAPE_POLY_SET result = region.CloneDropTriangulation();
+              result.BooleanIntersection( aInput.m_obstacles, SHAPE_POLY_SET::PM_FAST );
+              count += result.FullPointCount();
+          }
+
+          return count;
+      } },
+    { "poly_inflate_regions",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = 0;
+
+          for( const SHAPE_POLY_SET& region : aInput.m_unfracturedRegions )
+          {
+              SHAPE_POLY_SET result = region.CloneDropTriangulation();
+              result.Inflate( 100000, CORNER_STRATEGY::ROUND_ALL_CORNERS, MAX_ERROR );
+              count += result.FullPointCount();
+          }
+
+          return count;
+      } },
+    { "poly_inflate_obstacles",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = 0;
+
+          for( int ii = 0; ii < aInput.m_obstacles.OutlineCount(); ++ii )
+          {
+              SHAPE_POLY_SET result( aInput.m_obstacles.CPolygon( ii ) );
+              result.Inflate( 200000, CORNER_STRATEGY::ROUND_ALL_CORNERS, MAX_ERROR );
+              count += result.FullPointCount();
+          }
+
+          return count;
+      } },
+    { "poly_fracture",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = 0;
+
+          for( const SHAPE_POLY_SET& region : aInput.m_unfracturedRegions )
+          {
+              SHAPE_POLY_SET result = region.CloneDropTriangulation();
+              result.Fracture( SHAPE_POLY_SET::PM_FAST );
+              count += result.FullPointCount();
+          }
+
+          return count;
+      } },
+    { "poly_triangulate",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = 0;
+
+          for( const SHAPE_POLY_SET& region : aInput.m_regions )
+          {
+              SHAPE_POLY_SET result = region.CloneDropTriangulation();
+              result.CacheTriangulation();
+
+              for( unsigned int ii = 0; ii < result.TriangulatedPolyCount(); ++ii )
+                  count += result.TriangulatedPolygon( ii )->GetTriangleCount();
+          }
+
+          return count;
+      } },
+    { "line_chain_intersect",
+      []( const BENCH_INPUT& aInput )
+      {
+          int    count = std::min( aInput.m_obstacles.OutlineCount(), (int) MAX_PAIRWISE_SHAPES );
+          size_t hits = 0;
+
+          for( int ii = 0; ii < count; ++ii )
+          {
+              const SHAPE_LINE_CHAIN& outline = aInput.m_obstacles.COutline( ii );
+              BOX2I                   bbox = outline.BBox();
+
+              for( int jj = ii + 1; jj < count; ++jj )
+              {
+                  const SHAPE_LINE_CHAIN& other = aInput.m_obstacles.COutline( jj );
+
+                  if( !bbox.Intersects( other.BBox() ) )
+                      continue;
+
+                  SHAPE_LINE_CHAIN::INTERSECTIONS intersections;
+                  hits += outline.Intersect( other, intersections, false, &bbox );
+              }
+          }
+
+          return hits;
+      } },
+    { "seg_distance",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = std::min( aInput.m_segs.size(), MAX_PAIRWISE_SEGS );
+          size_t close = 0;
+
+          for( size_t ii = 0; ii < count; ++ii )
+          {
+              for( size_t jj = ii + 1; jj < count; ++jj )
+              {
+                  if( aInput.m_segs[ii].Distance( aInput.m_segs[jj] ) < 200000 )
+                      close++;
+              }
+          }
+
+          return close;
+      } },
+    { "box2_ops",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = std::min( aInput.m_boxes.size(), MAX_PAIRWISE_BOXES );
+          size_t hits = 0;
+          BOX2I  merged;
+
+          for( size_t ii = 0; ii < count; ++ii )
+          {
+              const BOX2I& box = aInput.m_boxes[ii];
+
+              merged = ii ? merged.Merge( box ) : box;
+
+              for( size_t jj = ii + 1; jj < count; ++jj )
+              {
+                  const BOX2I& other = aInput.m_boxes[jj];
+
+                  if( box.Intersects( other ) )
+                      hits++;
+
+                  if( box.Contains( other.GetCenter() ) )
+                      hits++;
+
+                  if( box.SquaredDistance( other ) < 1e10 )
+                      hits++;
+              }
+          }
+
+          return hits + ( merged.GetArea() > 0 ? 1 : 0 );
+      } },
+    { "shape_collide",
+      []( const BENCH_INPUT& aInput )
+      {
+          size_t count = std::min( aInput.m_shapes.size(), MAX_PAIRWISE_SHAPES );
+          size_t hits = 0;
+
+          for( size_t ii = 0; ii < count; ++ii )
+          {
+              for( size_t jj = ii + 1; jj < count; ++jj )
+              {
+                  int actual = 0;
+
+                  if( aInput.m_shapes[ii]->Collide( aInput.m_shapes[jj].get(), 200000, &actual ) )
+                      hits++;
+              }
+          }
+
+          return hits;
+      } },
+};
+
+
+static BENCH_INPUT buildSyntheticInput()
+{
+    BENCH_INPUT                        input;
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> coord( 0, 100000000 );
+    std::uniform_int_distribution<int> size( 100000, 2000000 );
+    std::uniform_int_distribution<int> offset( -3000000, 3000000 );
+
+    input.m_name = "synthetic";
+
+    // Four 50 mm copper pours, each pierced by a via field
+    for( int ii = 0; ii < 4; ++ii )
+    {
+        int            x0 = ( ii % 2 ) * 50000000;
+        int            y0 = ( ii / 2 ) * 50000000;
+        SHAPE_POLY_SET region;
+
+        region.NewOutline();
+        region.Append( x0, y0 );
+        region.Append( x0 + 49000000, y0 );
+        region.Append( x0 + 49000000, y0 + 49000000 );
+        region.Append( x0, y0 + 49000000 );
+
+        for( int jj = 0; jj < 400; ++jj )
+        {
+            SHAPE_LINE_CHAIN hole;
+            VECTOR2I         center( x0 + 1000000 + ( jj % 20 ) * 2400000,
+                                     y0 + 1000000 + ( jj / 20 ) * 2400000 );
+
+            TransformCircleToPolygon( hole, center, 400000, MAX_ERROR, ERROR_OUTSIDE );
+            region.AddHole( hole );
+        }
+
+        input.m_unfracturedRegions.push_back( region );
+        region.Fracture( SHAPE_POLY_SET::PM_FAST );
+        input.m_regions.push_back( std::move( region ) );
+    }
+
+    // Pads and track ends scattered over the pours
+    for( int ii = 0; ii < 2000; ++ii )
+    {
+        VECTOR2I pos( coord( rng ), coord( rng ) );
+        int      width = size( rng );
+
+        if( ii % 2 )
+            TransformCircleToPolygon( input.m_obstacles, pos, width / 2, MAX_ERROR, ERROR_INSIDE );
+        else
+            TransformOvalToPolygon( input.m_obstacles, pos, pos + VECTOR2I( offset( rng ), 0 ),
+                                    width, MAX_ERROR, ERROR_INSIDE );
+    }
+
+    for( int ii = 0; ii < 5000; ++ii )
+    {
+        VECTOR2I a( coord( rng ), coord( rng ) );
+        VECTOR2I b = a + VECTOR2I( offset( rng ), offset( rng ) );
+
+        input.m_segs.emplace_back( a, b );
+
+        BOX2I box( a, b - a );
+        box.Normalize();
+        input.m_boxes.push_back( box );
+
+        switch( ii % 5 )
+        {
+        case 0:
+            input.m_shapes.push_back( std::make_shared<SHAPE_CIRCLE>( a, size( rng ) ) );
+            break;
+
+        case 1:
+            input.m_shapes.push_back( std::make_shared<SHAPE_SEGMENT>( a, b, size( rng ) ) );
+            break;
+
+        case 2:
+            input.m_shapes.push_back( std::make_shared<SHAPE_RECT>( box ) );
+            break;
+
+        case 3:
+            input.m_shapes.push_back(
+                    std::make_shared<SHAPE_ARC>( a, b, EDA_ANGLE( 90.0, DEGREES_T ), size( rng ) ) );
+            break;
+
+        case 4:
+        {
+            SHAPE_POLY_SET oval;
+            TransformOvalToPolygon( oval, a, b, size( rng ), MAX_ERROR, ERROR_INSIDE );
+            input.m_shapes.push_back( std::make_shared<SHAPE_LINE_CHAIN>( oval.COutline( 0 ) ) );
+            break;
+        }
+        }
+    }
+
+    return input;
+}
+
+
+static bool buildBoardInput( const wxString& aBoardPath, BENCH_INPUT& aInput )
+{
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+            std::string( aBoardPath.ToUTF8() ) );
+
+    if( !board )
+        return false;
+
+    aInput.m_name = wxFileName( aBoardPath ).GetName().ToStdString();
+
+    for( ZONE* zone : board->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            SHAPE_POLY_SET fill = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+
+            if( fill.OutlineCount() == 0 )
+                continue;
+
+            aInput.m_regions.push_back( fill );
+            fill.Unfracture( SHAPE_POLY_SET::PM_FAST );
+            aInput.m_unfracturedRegions.push_back( std::move( fill ) );
+        }
+    }
+
+    for( FOOTPRINT* footprint : board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            aInput.m_obstacles.Append( *pad->GetEffectivePolygon( ERROR_INSIDE ) );
+            aInput.m_shapes.push_back( pad->GetEffectiveShape() );
+            aInput.m_boxes.push_back( pad->GetBoundingBox() );
+        }
+    }
+
+    for( PCB_TRACK* track : board->Tracks() )
+    {
+        if( track->Type() == PCB_TRACE_T )
+            aInput.m_segs.emplace_back( track->GetStart(), track->GetEnd() );
+
+        aInput.m_shapes.push_back( track->GetEffectiveShape() );
+        aInput.m_boxes.push_back( track->GetBoundingBox() );
+    }
+
+    return true;
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "r", "repeat", _( "number of runs of each benchmark" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "f", "filter", _( "only run the benchmarks whose name contains this" )
+            .mb_str(), wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_SWITCH, "s", "synthetic-only", _( "do not load any board" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input boards" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum KIMATH_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int kimath_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program times the kimath geometry operations on synthetic "
+                               "geometry and on the geometry of the given boards (or of a "
+                               "corpus of QA boards), and prints the timings as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long     repeat = 5;
+    wxString filter;
+
+    cl_parser.Found( "repeat", &repeat );
+    cl_parser.Found( "filter", &filter );
+    repeat = std::max( 1L, repeat );
+
+    std::vector<BENCH_INPUT> inputs;
+
+    inputs.push_back( buildSyntheticInput() );
+
+    if( !cl_parser.Found( "synthetic-only" ) )
+    {
+        std::vector<wxString> boardPaths;
+
+        for( size_t ii = 0; ii < cl_parser.GetParamCount(); ii++ )
+            boardPaths.push_back( cl_parser.GetParam( ii ) );
+
+        if( boardPaths.empty() )
+        {
+            for( const std::string& name : DEFAULT_CORPUS )
+                boardPaths.push_back( KI_TEST::GetPcbnewTestDataDir() + name + ".kicad_pcb" );
+        }
+
+        for( const wxString& boardPath : boardPaths )
+        {
+            inputs.emplace_back();
+
+            if( !buildBoardInput( boardPath, inputs.back() ) )
+            {
+                std::cerr << "Failed to load " << boardPath.ToStdString() << std::endl;
+                return KIMATH_BENCH_RET_CODES::LOAD_FAILED;
+            }
+        }
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+
+    for( const BENCH_INPUT& input : inputs )
+    {
+        for( const BENCHMARK& bench : BENCHMARKS )
+        {
+            if( !filter.IsEmpty() && !wxString( bench.m_name ).Contains( filter ) )
+                continue;
+
+            std::vector<double> runs;
+            size_t              count = 0;
+
+            for( long run = 0; run < repeat; run++ )
+            {
+                PROF_TIMER timer;
+
+                count = bench.m_func( input );
+                runs.push_back( timer.msecs() );
+            }
+
+            std::vector<double> sorted = runs;
+            std::sort( sorted.begin(), sorted.end() );
+
+            nlohmann::json result;
+
+            result["benchmark"] = bench.m_name;
+            result["input"] = input.m_name;
+            result["count"] = count;
+            result["runs_ms"] = runs;
+            result["min_ms"] = sorted.front();
+            result["median_ms"] = sorted[sorted.size() / 2];
+
+            results.push_back( result );
+        }
+    }
+
+    std::cout << results.dump( 2 ) << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "kimath_bench",
+                                                       "Benchmark the kimath geometry operations",
+                                                       kimath_bench_main_func } );
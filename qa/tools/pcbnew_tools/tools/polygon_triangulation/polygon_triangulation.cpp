@@ -35,8 +35,11 @@
 #include <core/ignore.h>
 #include <zone.h>
 #include <core/profile.h>
+#include <string_utils.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstdio>
 #include <thread>
 #include <unordered_set>
 #include <utility>
@@ -271,6 +274,56 @@ int polygon_triangulation_main( int argc, char *argv[] )
 
     cnt.Show();
 
+    // Benchmark the largest fills on their own, where only the outlines of a fill can be
+    // triangulated in parallel
+    std::vector<std::pair<ZONE*, PCB_LAYER_ID>> fills;
+
+    for( ZONE* zone : brd->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( zone->HasFilledPolysForLayer( layer ) )
+                fills.emplace_back( zone, layer );
+        }
+    }
+
+    auto vertexCount =
+            []( const std::pair<ZONE*, PCB_LAYER_ID>& aFill )
+            {
+                return aFill.first->GetFilledPolysList( aFill.second )->FullPointCount();
+            };
+
+    std::sort( fills.begin(), fills.end(),
+               [&]( const std::pair<ZONE*, PCB_LAYER_ID>& aA,
+                    const std::pair<ZONE*, PCB_LAYER_ID>& aB )
+               {
+                   return vertexCount( aA ) > vertexCount( aB );
+               } );
+
+    if( fills.size() > 10 )
+        fills.resize( 10 );
+
+    PROF_TIMER largest( "largestFills" );
+
+    for( const auto& [zone, layer] : fills )
+    {
+        SHAPE_POLY_SET poly = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+        PROF_TIMER     timer;
+
+        poly.CacheTriangulation();
+
+        size_t triangles = 0;
+
+        for( unsigned int ii = 0; ii < poly.TriangulatedPolyCount(); ++ii )
+            triangles += poly.TriangulatedPolygon( ii )->GetTriangleCount();
+
+        printf( "%s on %s: %d outlines, %d vertices, %zu triangles: %.1f ms\n",
+                TO_UTF8( zone->GetZoneName() ), TO_UTF8( LayerName( layer ) ), poly.OutlineCount(),
+                poly.FullPointCount(), triangles, timer.msecs() );
+    }
+
+    largest.Show();
+
     return KI_TEST::RET_CODES::OK;
 }
 
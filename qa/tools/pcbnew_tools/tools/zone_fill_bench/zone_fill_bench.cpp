@@ -0,0 +1,246 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/utility_registry.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wx/arrstr.h>
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <core/profile.h>
+#include <core/thread_pool.h>
+#include <drc/drc_engine.h>
+#include <pgm_base.h>
+#include <settings/settings_manager.h>
+#include <wildcards_and_files_ext.h>
+#include <zone.h>
+#include <zone_filler.h>
+
+
+/**
+ * Boards from the QA data directory which are filled when no files are given.  These are the
+ * zone filler regression boards, which between them cover most of the filler's code paths.
+ */
+static const std::vector<std::string> DEFAULT_CORPUS = {
+    "zone_filler",
+    "issue2568",
+    "issue5102",
+    "issue5320",
+    "issue5830",
+    "issue6260",
+    "issue7086",
+    "issue14294",
+    "issue16182",
+};
+
+
+static const std::vector<std::pair<ZONE_FILL_PHASE, std::string>> PHASE_NAMES = {
+    { ZONE_FILL_PHASE::CLEARANCES, "clearances" },
+    { ZONE_FILL_PHASE::PRIORITY,   "priority" },
+    { ZONE_FILL_PHASE::SPOKES,     "spokes" },
+    { ZONE_FILL_PHASE::HATCH,      "hatch" },
+    { ZONE_FILL_PHASE::ISLANDS,    "islands" },
+    { ZONE_FILL_PHASE::FRACTURE,   "fracture" },
+};
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "t", "threads",
+            _( "comma-separated list of thread counts to fill with (default 1 and all cores)" )
+                    .mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "r", "repeat", _( "number of fills per board and thread count" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "input boards" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum ZONE_FILL_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    FILL_FAILED
+};
+
+
+static std::unique_ptr<BOARD> loadBoard( const wxString& aBoardPath )
+{
+    wxFileName projectFile( aBoardPath );
+    wxFileName rulesFile( aBoardPath );
+
+    projectFile.SetExt( ProjectFileExtension );
+    rulesFile.SetExt( DesignRulesFileExtension );
+
+    SETTINGS_MANAGER& manager = Pgm().GetSettingsManager();
+
+    if( projectFile.Exists() )
+        manager.LoadProject( projectFile.GetFullPath() );
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream(
+            std::string( aBoardPath.ToUTF8() ) );
+
+    if( !board )
+        return nullptr;
+
+    if( projectFile.Exists() )
+        board->SetProject( &manager.Prj() );
+
+    auto drcEngine = std::make_shared<DRC_ENGINE>( board.get(), &board->GetDesignSettings() );
+    drcEngine->InitEngine( rulesFile.Exists() ? rulesFile : wxFileName() );
+
+    board->GetDesignSettings().m_DRCEngine = drcEngine;
+    board->BuildListOfNets();
+    board->BuildConnectivity();
+
+    return board;
+}
+
+
+int zone_fill_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program fills all the zones of the given boards (or of a "
+                               "corpus of QA boards), and prints the time taken by each phase "
+                               "of the fill as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::vector<unsigned> threadCounts = { 1, std::max( 1U, std::thread::hardware_concurrency() ) };
+    wxString              threadsArg;
+    long                  repeat = 3;
+
+    if( cl_parser.Found( "threads", &threadsArg ) )
+    {
+        threadCounts.clear();
+
+        for( const wxString& token : wxSplit( threadsArg, ',' ) )
+        {
+            unsigned long count = 0;
+
+            if( !token.ToULong( &count ) || count == 0 )
+                return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+            threadCounts.push_back( (unsigned) count );
+        }
+    }
+
+    cl_parser.Found( "repeat", &repeat );
+    repeat = std::max( 1L, repeat );
+
+    std::vector<wxString> boardPaths;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ii++ )
+        boardPaths.push_back( cl_parser.GetParam( ii ) );
+
+    if( boardPaths.empty() )
+    {
+        for( const std::string& name : DEFAULT_CORPUS )
+            boardPaths.push_back( KI_TEST::GetPcbnewTestDataDir() + name + ".kicad_pcb" );
+    }
+
+    thread_pool&   tp = GetKiCadThreadPool();
+    nlohmann::json results = nlohmann::json::array();
+
+    for( const wxString& boardPath : boardPaths )
+    {
+        std::unique_ptr<BOARD> board = loadBoard( boardPath );
+
+        if( !board )
+        {
+            std::cerr << "Failed to load " << boardPath.ToStdString() << std::endl;
+            return ZONE_FILL_BENCH_RET_CODES::LOAD_FAILED;
+        }
+
+        std::vector<ZONE*> toFill;
+
+        for( ZONE* zone : board->Zones() )
+            toFill.push_back( zone );
+
+        for( unsigned threads : threadCounts )
+        {
+            tp.reset( threads );
+
+            for( long run = 0; run < repeat; run++ )
+            {
+                // Fill from scratch every time; unchanged fills would otherwise be skipped
+                for( ZONE* zone : toFill )
+                    zone->UnFill();
+
+                ZONE_FILLER filler( board.get(), nullptr );
+                PROF_TIMER  timer;
+
+                if( !filler.Fill( toFill ) )
+                    return ZONE_FILL_BENCH_RET_CODES::FILL_FAILED;
+
+                nlohmann::json result;
+
+                result["board"] = wxFileName( boardPath ).GetName().ToStdString();
+                result["threads"] = threads;
+                result["run"] = run;
+                result["zones"] = toFill.size();
+                result["total_ms"] = timer.msecs();
+
+                for( const auto& [ phase, name ] : PHASE_NAMES )
+                    result["phases_ms"][name] = filler.GetPhaseTime( phase );
+
+                results.push_back( result );
+            }
+        }
+
+        board->GetDesignSettings().m_DRCEngine.reset();
+    }
+
+    // Restore the default pool size
+    tp.reset();
+
+    std::cout << results.dump( 2 ) << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "zone_fill_bench",
+                                                       "Benchmark the zone filler",
+                                                       zone_fill_bench_main_func } );
@@ -25,13 +25,18 @@
 #include "pns_log_file.h"
 #include "pns_log_player.h"
 
+#include <core/profile.h>
 #include <pcbnew_utils/board_test_utils.h>
+#include <router/pns_profile.h>
 
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
 
-PNS_LOG_PLAYER::PNS_LOG_PLAYER()
+PNS_LOG_PLAYER::PNS_LOG_PLAYER() :
+        m_debugDecorator( nullptr ),
+        m_timeLimitUs( 0 ),
+        m_benchmark( false )
 {
     SetReporter( &NULL_REPORTER::GetInstance() );
 }
@@ -96,6 +101,15 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
     m_router->LoadSettings( aLog->GetRoutingSettings() );
 
+    if( m_benchmark )
+    {
+        // Recording the debug shapes would cost more than the routing itself
+        m_debugDecorator->SetDebugEnabled( false );
+        PROFILE::Reset();
+    }
+
+    PROFILE::Enable( m_benchmark );
+
     int eventIdx = 0;
     int totalEvents = aLog->Events().size();
 
@@ -182,8 +196,38 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->Message( msg );
             m_reporter->Report( msg );
 
-            bool ret = m_router->Move( evt.p, ritem );
+            int64_t phaseTimes[PROFILE::PHASE_COUNT];
+
+            for( int ii = 0; ii < PROFILE::PHASE_COUNT; ii++ )
+                phaseTimes[ii] = PROFILE::PhaseTime( static_cast<PROFILE::PHASE>( ii ) );
+
+            PROF_TIMER timer;
+            bool       ret = m_router->Move( evt.p, ritem );
+
+            timer.Stop();
             m_debugDecorator->SetCurrentStageStatus( ret );
+
+            if( m_benchmark )
+            {
+                static const char* phaseNames[PROFILE::PHASE_COUNT] = { "shove", "walkaround",
+                                                                        "optimize" };
+
+                m_benchmarkResults.m_latencies["move"].push_back(
+                        timer.SinceStart<std::chrono::microseconds>().count() );
+
+                for( int ii = 0; ii < PROFILE::PHASE_COUNT; ii++ )
+                {
+                    int64_t t = PROFILE::PhaseTime( static_cast<PROFILE::PHASE>( ii ) );
+
+                    // Only the moves which went through a phase tell about its latency
+                    if( t > phaseTimes[ii] )
+                    {
+                        m_benchmarkResults.m_latencies[phaseNames[ii]].push_back(
+                                t - phaseTimes[ii] );
+                    }
+                }
+            }
+
             break;
         }
 
@@ -251,6 +295,13 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 #endif
     }
 
+    if( m_benchmark )
+    {
+        m_benchmarkResults.m_collisionQueries += PROFILE::Counter( PROFILE::COLLISION_QUERIES );
+        m_benchmarkResults.m_branches += PROFILE::Counter( PROFILE::BRANCHES );
+        PROFILE::Enable( false );
+    }
+
     wxASSERT_MSG( m_router->Mode() == aLog->GetMode(), "didn't set the router mode correctly?" );
 
     if( aUpdateExpectedResult )
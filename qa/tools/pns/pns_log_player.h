@@ -24,6 +24,8 @@
 #define __PNS_LOG_PLAYER_H
 
 #include <map>
+#include <string>
+#include <vector>
 #include <pcbnew/board.h>
 
 #include <router/pns_routing_settings.h>
@@ -83,6 +85,18 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    /**
+     * What a replay with benchmarking enabled measured: the latencies, in microseconds, of each
+     * ROUTER::Move() and of the shove, walkaround and optimize phases it went through, and the
+     * number of collision queries and node branches done by the router.
+     */
+    struct BENCHMARK
+    {
+        std::map<std::string, std::vector<int64_t>> m_latencies;
+        uint64_t                                    m_collisionQueries = 0;
+        uint64_t                                    m_branches = 0;
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -96,6 +110,13 @@ public:
 
     void SetTimeLimit( uint64_t microseconds ) { m_timeLimitUs = microseconds; }
 
+    /**
+     * Measure the router instead of recording its debug output.  The measurements of the
+     * following replays add up in GetBenchmark().
+     */
+    void SetBenchmark( bool aEnable ) { m_benchmark = aEnable; }
+    const BENCHMARK& GetBenchmark() const { return m_benchmarkResults; }
+
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
@@ -109,6 +130,8 @@ private:
     std::unique_ptr<PNS::ROUTER>          m_router;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    bool      m_benchmark;
+    BENCHMARK m_benchmarkResults;
 };
 
 #endif
@@ -32,8 +32,11 @@
 #include <pcbnew_utils/board_file_utils.h>
 
 #include "pns_log_file.h"
+#include "pns_log_player.h"
 #include "pns_log_viewer_frame.h"
 
+#include <algorithm>
+
 #include <boost/test/included/unit_test.hpp>
 
 using namespace boost::unit_test;
@@ -160,58 +163,153 @@ public:
 FIXTURE_LOGGER PNS_TEST_FIXTURE::m_logger;
 
 
-std::vector<PNS_TEST_CASE*> createTestCases()
+/**
+ * Read the names of the cases of the regression corpus in \a aDir.
+ *
+ * @return false if the list of cases couldn't be read.
+ */
+static bool readTestList( const std::string& aDir, std::vector<wxString>& aNames )
 {
-    std::string absPath = KI_TEST::GetPcbnewTestDataDir() + std::string( "/pns_regressions/" );
-    std::vector<PNS_TEST_CASE*> testCases;
-
-    wxFileName fnameList( absPath + "tests.lst" );
+    wxFileName fnameList( aDir + "tests.lst" );
     wxTextFile fp( fnameList.GetFullPath() );
 
     if( !fp.Open() )
-    {
-        wxString str =
-                wxString::Format( "Failed to load test list from '%s'.", fnameList.GetFullPath() );
-        BOOST_TEST_ERROR( str.c_str().AsChar() );
-        return testCases;
-    }
-
-    std::vector<wxString> lines;
+        return false;
 
     if( !fp.Eof() )
     {
-        lines.push_back( fp.GetFirstLine() );
+        aNames.push_back( fp.GetFirstLine() );
 
         while( !fp.Eof() )
         {
             auto l = fp.GetNextLine();
             if( l.Length() > 0 )
             {
-                lines.push_back( l );
+                aNames.push_back( l );
             }
         }
     }
 
     fp.Close();
+    return true;
+}
 
-    for( auto l : lines )
+
+static wxString testCasePath( const std::string& aDir, const wxString& aName )
+{
+    wxString fn( aDir );
+    fn = fn.Append( wxT( "/" ) );
+    fn = fn.Append( aName );
+    fn = fn.Append( wxT( "/pns" ) );
+    return fn;
+}
+
+
+std::vector<PNS_TEST_CASE*> createTestCases()
+{
+    std::string absPath = KI_TEST::GetPcbnewTestDataDir() + std::string( "/pns_regressions/" );
+    std::vector<PNS_TEST_CASE*> testCases;
+    std::vector<wxString>       lines;
+
+    if( !readTestList( absPath, lines ) )
     {
-        wxString fn( absPath );
-        fn = fn.Append( wxT( "/" ) );
-        fn = fn.Append( l );
-        fn = fn.Append( wxT( "/pns" ) );
+        wxString str = wxString::Format( "Failed to load test list from '%stests.lst'.", absPath );
+        BOOST_TEST_ERROR( str.c_str().AsChar() );
+        return testCases;
+    }
 
-        testCases.push_back( new PNS_TEST_CASE( l.ToStdString(), fn.ToStdString() ) );
+    for( auto l : lines )
+    {
+        testCases.push_back( new PNS_TEST_CASE( l.ToStdString(),
+                                                testCasePath( absPath, l ).ToStdString() ) );
     }
 
-    wxString str = wxString::Format( "Loaded %d test cases from '%s'.", (int) testCases.size(),
-                                     fnameList.GetFullPath() );
+    wxString str = wxString::Format( "Loaded %d test cases from '%stests.lst'.",
+                                     (int) testCases.size(), absPath );
 
     BOOST_TEST_MESSAGE( str.c_str().AsChar() );
 
     return testCases;
 }
 
+
+/**
+ * Replay logs and print the latency percentiles of the router and its counters, instead of
+ * checking the results.  Each argument is a log file name, without extension; the regression
+ * corpus is used when there are none.
+ */
+static int runBenchmark( int argc, char* argv[] )
+{
+    std::vector<wxString> logs;
+
+    for( int ii = 0; ii < argc; ii++ )
+        logs.push_back( wxString::FromUTF8( argv[ii] ) );
+
+    if( logs.empty() )
+    {
+        std::string           absPath = KI_TEST::GetPcbnewTestDataDir() + "/pns_regressions/";
+        std::vector<wxString> names;
+
+        if( !readTestList( absPath, names ) )
+        {
+            printf( "Failed to load test list from '%stests.lst'.\n", absPath.c_str() );
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+        }
+
+        for( const wxString& name : names )
+            logs.push_back( testCasePath( absPath, name ) );
+    }
+
+    PNS_LOG_PLAYER player;
+    int            failed = 0;
+
+    player.SetBenchmark( true );
+
+    for( const wxString& log : logs )
+    {
+        PNS_LOG_FILE logFile;
+
+        if( !logFile.Load( wxFileName( log ), &NULL_REPORTER::GetInstance() ) )
+        {
+            printf( "Failed to load log '%s'.\n", log.utf8_str().data() );
+            failed++;
+            continue;
+        }
+
+        player.ReplayLog( &logFile, 0 );
+    }
+
+    const PNS_LOG_PLAYER::BENCHMARK& results = player.GetBenchmark();
+
+    // Nearest-rank percentile of sorted samples
+    auto percentile =
+            []( const std::vector<int64_t>& aSorted, int aPercent ) -> int64_t
+            {
+                size_t rank = ( aSorted.size() * aPercent + 99 ) / 100;
+                return aSorted[std::max<size_t>( rank, 1 ) - 1];
+            };
+
+    printf( "%-12s %8s %10s %10s %10s %10s\n", "operation", "count", "p50 [us]", "p95 [us]",
+            "p99 [us]", "max [us]" );
+
+    for( const auto& [name, samples] : results.m_latencies )
+    {
+        std::vector<int64_t> sorted( samples );
+        std::sort( sorted.begin(), sorted.end() );
+
+        printf( "%-12s %8zu %10lld %10lld %10lld %10lld\n", name.c_str(), sorted.size(),
+                (long long) percentile( sorted, 50 ), (long long) percentile( sorted, 95 ),
+                (long long) percentile( sorted, 99 ), (long long) sorted.back() );
+    }
+
+    printf( "\n%d logs replayed, %d failed to load\n", (int) logs.size() - failed, failed );
+    printf( "collision queries: %llu\n", (unsigned long long) results.m_collisionQueries );
+    printf( "node branches:     %llu\n", (unsigned long long) results.m_branches );
+
+    return failed ? KI_TEST::RET_CODES::TOOL_SPECIFIC : KI_TEST::RET_CODES::OK;
+}
+
+
 static test_suite* init_pns_test_suite( int argc, char* argv[] )
 {
     test_suite* pnsTestSuite = BOOST_TEST_SUITE( "pns_regressions" );
@@ -230,5 +328,9 @@ static test_suite* init_pns_test_suite( int argc, char* argv[] )
 
 int main( int argc, char* argv[] )
 {
+    // "qa_pns_regressions --benchmark [log...]" measures the replays instead of checking them
+    if( argc > 1 && std::string( argv[1] ) == "--benchmark" )
+        return runBenchmark( argc - 2, argv + 2 );
+
     return unit_test_main( init_pns_test_suite, argc, argv );
-}
\ No newline at end of file
+}
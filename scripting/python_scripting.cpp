@@ -85,6 +85,12 @@ SCRIPTING::~SCRIPTING()
 }
 
 
+void StartPythonScripting()
+{
+    Pgm().StartPythonScripting();
+}
+
+
 bool SCRIPTING::IsWxAvailable()
 {
 #ifdef KICAD_SCRIPTING_WXPYTHON
@@ -89,11 +89,25 @@ wxWindow*   CreatePythonShellWindow( wxWindow* parent, const wxString& aFramenam
 bool InitPythonScripting( const char* aStockScriptingPath, const char* aUserScriptingPath );
 bool IsWxPythonLoaded();
 
+/**
+ * Start the Python interpreter of the program if its start was deferred.
+ */
+void StartPythonScripting();
+
 class PyLOCK
 {
     PyGILState_STATE gil_state;
 public:
-    PyLOCK()      { gil_state = PyGILState_Ensure(); }
+    PyLOCK()
+    {
+        // Start the interpreter on first use if InitPgm() deferred it.  Checking first also
+        // keeps this away from Pgm() when KiCad is run from a Python script.
+        if( !Py_IsInitialized() )
+            StartPythonScripting();
+
+        gil_state = PyGILState_Ensure();
+    }
+
     ~PyLOCK()     { PyGILState_Release( gil_state ); }
 };
 